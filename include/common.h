@@ -24,14 +24,24 @@
 #define CIV_VERSION_MINOR 1
 #define CIV_VERSION_PATCH 0
 
-/* Memory management macros */
+/* Memory management macros; with CIV_MEM_TAGS every block is counted
+   under the allocating thread's tag (see utils/mem_tags.h) */
+#include "utils/mem_tags.h"
+#ifdef CIV_MEM_TAGS
+#define CIV_MALLOC(size) civ_mem_alloc(size)
+#define CIV_CALLOC(count, size) civ_mem_calloc(count, size)
+#define CIV_REALLOC(ptr, size) civ_mem_realloc(ptr, size)
+#define CIV_RAW_FREE(ptr) civ_mem_free(ptr)
+#else
 #define CIV_MALLOC(size) malloc(size)
 #define CIV_CALLOC(count, size) calloc(count, size)
 #define CIV_REALLOC(ptr, size) realloc(ptr, size)
+#define CIV_RAW_FREE(ptr) free(ptr)
+#endif
 #define CIV_FREE(ptr)                                                          \
   do {                                                                         \
     if (ptr) {                                                                 \
-      free(ptr);                                                               \
+      CIV_RAW_FREE(ptr);                                                       \
       ptr = NULL;                                                              \
     }                                                                          \
   } while (0)
@@ -44,6 +54,14 @@
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
 #define CLAMP(val, min, max) (MAX(min, MIN(max, val)))
 
+/* Share of a gap that a step of rate per unit of time closes over dt, as
+   dt unit steps would: 1 - (1 - rate)^dt. Equal to rate at dt = 1 and
+   never past 1, so long banked steps do not overshoot. Also the chance
+   that an event with chance rate per unit of time happens within dt. */
+static inline float civ_compound(float rate, float dt) {
+  return 1.0f - powf(1.0f - CLAMP(rate, 0.0f, 1.0f), dt);
+}
+
 /* String utilities */
 #define STRING_MAX_LEN 256
 #define STRING_MEDIUM_LEN 128
@@ -89,8 +107,18 @@ typedef enum {
   CIV_LOG_FATAL = 4
 } civ_log_level_t;
 
-/* Logging function */
-void civ_log(civ_log_level_t level, const char *format, ...);
+/* Logging: each call site finds its subsystem once and is filtered before
+   anything is formatted; lines that pass are written by the logger thread
+   (see utils/logger.h) */
+bool civ_log_site_enabled(int *site, const char *file, civ_log_level_t level);
+void civ_log_write(int *site, civ_log_level_t level, const char *format, ...);
+
+#define civ_log(level, ...)                                                    \
+  do {                                                                         \
+    static int civ_log_site_;                                                  \
+    if (civ_log_site_enabled(&civ_log_site_, __FILE__, (level)))               \
+      civ_log_write(&civ_log_site_, (level), __VA_ARGS__);                     \
+  } while (0)
 
 /* Assertion macro */
 #ifdef DEBUG
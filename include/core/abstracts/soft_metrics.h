@@ -8,6 +8,7 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include "../../utils/arena.h"
 
 /* Mood enumeration */
 typedef enum {
@@ -19,14 +20,17 @@ typedef enum {
     CIV_MOOD_ECSTATIC = 5
 } civ_mood_t;
 
+#define CIV_HAPPINESS_WINDOW 10 /* recent changes kept */
+
 /* Happiness metrics structure */
 typedef struct {
     civ_float_t base_happiness;
     civ_float_t stability;
     civ_float_t loyalty;
-    civ_float_t* recent_changes;
-    size_t change_count;
-    size_t change_capacity;
+    /* Ring of the last CIV_HAPPINESS_WINDOW changes, oldest overwritten */
+    civ_float_t recent_changes[CIV_HAPPINESS_WINDOW];
+    size_t change_head;  /* next slot written */
+    size_t change_count; /* filled, up to the window */
 } civ_happiness_metrics_t;
 
 /* Legitimacy system structure */
@@ -69,6 +73,8 @@ void civ_soft_metrics_update_from_events(civ_soft_metrics_manager_t* sm, const v
 
 /* Serialization */
 char* civ_soft_metrics_to_dict(const civ_soft_metrics_manager_t* sm);
+/* The same string pushed on arena instead of the heap */
+char* civ_soft_metrics_to_dict_arena(const civ_soft_metrics_manager_t* sm, civ_arena_t* arena);
 
 #endif /* CIVILIZATION_SOFT_METRICS_H */
 
@@ -1,6 +1,26 @@
 /**
  * @file ai_system.h
  * @brief Main AI system header
+ *
+ * AIs think in time slices. Every AI owns a resumable think task: a
+ * strategic plan is a few steps (see civ_strategic_step_t) plus, once a
+ * turn, an expansion step; a tactical reaction is one step. Each slice
+ * ranks the tasks by importance — at war with the player, bordering the
+ * player, recently attacked, and how many slices it has waited — and hands
+ * out the slice's steps in that order. Whatever is left carries over, with
+ * the time it missed, so a slice costs about its budget however many AIs
+ * there are.
+ *
+ * A slice runs in two phases. Every task given steps proposes on the
+ * worker pool at once, each against the world as the last slice left it
+ * and with its own RNG stream; then, on the calling thread, the strategic
+ * AIs commit their proposals one at a time in rank order, so when two want
+ * the same site the higher ranked one gets it however the pool ran.
+ *
+ * The millisecond budget becomes a step count through the measured wall
+ * time per step, which falls as cores are added. Timing makes the outcome
+ * depend on the machine, so while a command log records the game slices
+ * spend a fixed number of steps instead and replays stay exact.
  */
 
 #ifndef CIVILIZATION_AI_SYSTEM_H
@@ -11,6 +31,39 @@
 #include "base_ai.h"
 #include "strategic_ai.h"
 #include "tactical_ai.h"
+#include "../../utils/rng.h"
+
+/* Slice budgets */
+typedef struct {
+  float    frame_budget_ms;   /* civ_ai_system_update */
+  float    turn_budget_ms;    /* civ_ai_system_end_turn */
+  uint32_t fixed_frame_steps; /* spent instead while deterministic */
+  uint32_t fixed_turn_steps;
+} civ_ai_budget_t;
+
+typedef enum {
+  CIV_AI_TASK_STRATEGIC,
+  CIV_AI_TASK_TACTICAL
+} civ_ai_task_kind_t;
+
+/* One AI's resumable think task */
+typedef struct {
+  uint8_t     kind;           /* civ_ai_task_kind_t */
+  uint8_t     step;           /* next step of the current cycle */
+  uint8_t     quota;          /* steps granted this slice */
+  uint32_t    index;          /* into strategic_ais or tactical_ais */
+  civ_float_t pending_dt;     /* time since its last completed cycle */
+  uint32_t    waited;         /* slices since it last ran a step */
+  int32_t     expansion_turn; /* turn whose expansion is still owed; -1 none */
+  int32_t     attacked_turn;  /* last turn it was attacked; -1 never */
+  float       priority;       /* from the last slice */
+  civ_rng_t   rng;            /* bound while it proposes and commits */
+} civ_ai_task_t;
+
+typedef struct {
+  float    priority;
+  uint32_t task;
+} civ_ai_rank_t;
 
 /* AI system */
 typedef struct {
@@ -21,6 +74,18 @@ typedef struct {
   size_t strategic_capacity;
   size_t tactical_capacity;
   void *game_ptr; /* Opaque pointer to civ_game_t */
+
+  civ_ai_task_t *tasks;     /* strategic then tactical, in add order */
+  civ_ai_rank_t *ranks;     /* slice scratch, highest priority first */
+  size_t         task_count;
+  size_t         task_capacity;
+  civ_ai_budget_t budget;
+  float          step_ns;   /* wall time per step, smoothed */
+
+  /* Last slice */
+  uint32_t last_steps;
+  float    last_ms;
+  uint32_t backlog;         /* tasks that wanted a step and did not get one */
 } civ_ai_system_t;
 
 /* Function declarations */
@@ -28,8 +93,17 @@ civ_ai_system_t *civ_ai_system_create(void);
 void civ_ai_system_destroy(civ_ai_system_t *ai_system);
 void civ_ai_system_init(civ_ai_system_t *ai_system);
 
+/* One frame slice: time_delta is added to every task's pending time */
 civ_result_t civ_ai_system_update(civ_ai_system_t *ai_system,
                                   civ_float_t time_delta);
+/* Owe every strategic AI one expansion for turn, then run a turn slice */
+civ_result_t civ_ai_system_end_turn(civ_ai_system_t *ai_system, int32_t turn);
+/* Wall-time slice budgets at scale times their defaults; deterministic
+   runs spend fixed steps and are unaffected */
+void civ_ai_system_set_budget_scale(civ_ai_system_t *ai_system, float scale);
+/* Rank the AI with this id as recently attacked */
+void civ_ai_system_note_attacked(civ_ai_system_t *ai_system, const char *id,
+                                 int32_t turn);
 civ_result_t civ_ai_system_add_strategic(civ_ai_system_t *ai_system,
                                          civ_strategic_ai_t *ai);
 civ_result_t civ_ai_system_add_tactical(civ_ai_system_t *ai_system,
@@ -0,0 +1,32 @@
+/**
+ * @file ai_utility.h
+ * @brief Batch utility scoring over SoA candidate arrays
+ *
+ * AIs keep their candidate actions as parallel float arrays; these score
+ * and pick from a whole array at once, several lanes at a time where the
+ * target has SIMD. Every lane does the same arithmetic as the scalar tail,
+ * so results do not depend on the instruction set.
+ */
+#ifndef CIV_AI_UTILITY_H
+#define CIV_AI_UTILITY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* out[i] = (benefit[i] - cost[i]) * urgency[i], or -INFINITY where
+   urgency[i] is below threshold */
+void civ_ai_utility_batch(const float *benefit, const float *cost,
+                          const float *urgency, float threshold, float *out,
+                          size_t n);
+
+/* Index of the first largest score, -1 when n is 0 */
+int32_t civ_ai_argmax(const float *score, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -8,6 +8,7 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include "../../utils/symbol.h"
 
 /* AI personality traits */
 typedef struct {
@@ -18,13 +19,24 @@ typedef struct {
     civ_float_t economic_focus;  /* 0.0 to 1.0 */
 } civ_ai_personality_t;
 
-/* AI decision */
+/* Decisions as parallel arrays; interned types and targets */
 typedef struct {
-    char action_type[STRING_SHORT_LEN];
-    char target[STRING_SHORT_LEN];
+    civ_symbol_t* type;
+    civ_symbol_t* target;
+    float* priority;    /* 0.0 to 1.0 */
+    float* confidence;  /* 0.0 to 1.0 */
+    civ_float_t* timestamp; /* game clock when made */
+    size_t count;
+    size_t capacity;
+} civ_ai_decisions_t;
+
+/* One decision, read back by civ_base_ai_get_decision */
+typedef struct {
+    const char* action_type;
+    const char* target;
     civ_float_t priority;  /* 0.0 to 1.0 */
     civ_float_t confidence; /* 0.0 to 1.0 */
-    time_t timestamp;
+    civ_float_t timestamp;
 } civ_ai_decision_t;
 
 /* Base AI entity */
@@ -34,15 +46,13 @@ typedef struct {
     
     civ_ai_personality_t personality;
     
-    civ_ai_decision_t* decisions;
-    size_t decision_count;
-    size_t decision_capacity;
+    civ_ai_decisions_t decisions;
     
     civ_float_t intelligence;  /* 0.0 to 1.0 */
     civ_float_t adaptability; /* 0.0 to 1.0 */
     
-    time_t last_think;
-    time_t creation_time;
+    civ_float_t clock;      /* game seconds since creation, advanced by think */
+    civ_float_t last_think;
 } civ_base_ai_t;
 
 /* Function declarations */
@@ -52,7 +62,9 @@ void civ_base_ai_init(civ_base_ai_t* ai, const char* id, const char* name);
 
 civ_result_t civ_base_ai_think(civ_base_ai_t* ai, civ_float_t time_delta);
 civ_result_t civ_base_ai_make_decision(civ_base_ai_t* ai, const char* action_type, const char* target, civ_float_t priority);
-civ_ai_decision_t* civ_base_ai_get_best_decision(const civ_base_ai_t* ai);
+/* Index of the highest-priority decision, -1 if none */
+int32_t civ_base_ai_get_best_decision(const civ_base_ai_t* ai);
+bool civ_base_ai_get_decision(const civ_base_ai_t* ai, size_t index, civ_ai_decision_t* out);
 void civ_base_ai_set_personality(civ_base_ai_t* ai, const civ_ai_personality_t* personality);
 
 #endif /* CIVILIZATION_BASE_AI_H */
@@ -0,0 +1,105 @@
+/**
+ * @file influence_map.h
+ * @brief Coarse-grid influence layers shared by every AI
+ *
+ * The map is covered by cells of CIV_INFLUENCE_CELL_SIZE tiles. Each layer
+ * keeps an integer source per cell — the sum of what stands in it — and a
+ * field: the source spread over neighbouring cells by a separable binomial
+ * blur, which is what AIs read. Sources change by deltas: ownership through
+ * the map's owner listener, units and settlements by comparing each one
+ * with the contribution it made at the last refresh, so nothing rescans
+ * the map. Integer sources make those deltas exact, so a field depends
+ * only on what is on the map, never on the order it got there.
+ *
+ * Refresh re-blurs only the rows a changed source can reach, on the worker
+ * pool when given one. Fields are plain floats; sample them anywhere.
+ */
+#ifndef CIV_AI_INFLUENCE_MAP_H
+#define CIV_AI_INFLUENCE_MAP_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include "../military/units.h"
+#include "../world/map_generator.h"
+#include "../world/settlement_manager.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct civ_worker_pool;
+
+#define CIV_INFLUENCE_CELL_SHIFT 3 /* 8x8-tile cells */
+#define CIV_INFLUENCE_CELL_SIZE  (1 << CIV_INFLUENCE_CELL_SHIFT)
+#define CIV_INFLUENCE_RADIUS     3 /* blur reach in cells */
+
+/* X(ID, scale): a source unit is 1/scale of the layer's natural unit */
+#define CIV_INFLUENCE_LAYERS(X)                                                \
+  X(THREAT, 1)    /* living unit strength x combat strength */                 \
+  X(ECONOMY, 1)   /* settlement population */                                  \
+  X(CULTURE, 100) /* settlement culture yield */                               \
+  X(TENSION, 1)   /* owned land tiles touching another owner */
+
+typedef enum {
+#define CIV_INFLUENCE_ENUM(id, scale) CIV_INFLUENCE_##id,
+  CIV_INFLUENCE_LAYERS(CIV_INFLUENCE_ENUM)
+#undef CIV_INFLUENCE_ENUM
+  CIV_INFLUENCE_LAYER_COUNT
+} civ_influence_layer_t;
+
+/* What one unit or settlement added at the last refresh */
+typedef struct {
+  uint32_t cell;   /* UINT32_MAX = nothing */
+  int64_t  value[2]; /* units: threat; settlements: economy, culture */
+} civ_influence_contribution_t;
+
+typedef struct {
+  civ_map_t *map;
+  int32_t    cols, rows;
+
+  int64_t  *source[CIV_INFLUENCE_LAYER_COUNT];
+  float    *across[CIV_INFLUENCE_LAYER_COUNT]; /* horizontal pass */
+  float    *field[CIV_INFLUENCE_LAYER_COUNT];
+  float    *row_max[CIV_INFLUENCE_LAYER_COUNT];
+  float     max[CIV_INFLUENCE_LAYER_COUNT];
+  uint8_t  *row_dirty[CIV_INFLUENCE_LAYER_COUNT]; /* source row changed */
+  uint8_t  *row_stale[CIV_INFLUENCE_LAYER_COUNT]; /* field row to redo */
+  float    *scratch;    /* one padded row per refresh job */
+
+  uint8_t  *tile_border; /* per tile: counted in TENSION */
+
+  civ_influence_contribution_t *units;
+  size_t unit_count, unit_capacity;
+  civ_influence_contribution_t *settlements;
+  size_t settlement_count, settlement_capacity;
+
+  uint64_t revision; /* bumped by every refresh that changed a field */
+} civ_influence_map_t;
+
+/* Built from map's ownership and attached to its owner listener; units
+   and settlements arrive with the first refresh */
+civ_influence_map_t *civ_influence_map_create(civ_map_t *map);
+void civ_influence_map_destroy(civ_influence_map_t *im);
+
+/* Apply unit, settlement and ownership changes since the last refresh and
+   re-blur what they reach. Either manager may be NULL. */
+void civ_influence_map_refresh(civ_influence_map_t *im,
+                               const civ_unit_manager_t *units,
+                               const civ_settlement_manager_t *settlements,
+                               struct civ_worker_pool *pool);
+
+/* Field at tile position (x, y), interpolated between cell centres */
+float civ_influence_map_sample(const civ_influence_map_t *im,
+                               civ_influence_layer_t layer, float x, float y);
+
+/* The same over the layer's current maximum: 0 to 1, 0 on an empty layer */
+float civ_influence_map_sample_norm(const civ_influence_map_t *im,
+                                    civ_influence_layer_t layer, float x,
+                                    float y);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -1,6 +1,15 @@
 /**
  * @file strategic_ai.h
  * @brief Strategic AI for long-term planning
+ *
+ * Planning is split in two. A propose step only reads the world and the
+ * AI's own state and appends what it wants done to the AI's pending
+ * actions, so any number of AIs can propose at once against the same
+ * world. Committing applies those actions and must run on the sim thread,
+ * one AI at a time, in an order that does not depend on scheduling: an
+ * action that no longer fits the world (a site someone settled first) is
+ * dropped there. Expansion picks its site at commit, from the game's site
+ * field, so AIs committing in turn never queue the same spot.
  */
 
 #ifndef CIVILIZATION_STRATEGIC_AI_H
@@ -10,17 +19,52 @@
 #include "../../types.h"
 #include "../diplomacy/relations.h"
 #include "base_ai.h"
+#include "../../utils/symbol.h"
 
 /* Strategic goal */
 typedef struct {
   char goal_type[STRING_SHORT_LEN];
+  civ_symbol_t goal_sym; /* goal_type interned */
   char description[STRING_MAX_LEN];
   civ_float_t priority;
   civ_float_t progress; /* 0.0 to 1.0 */
-  time_t deadline;
-  time_t created;
+  int32_t deadline_turn; /* 0 = none */
+  int32_t created_turn;
 } civ_strategic_goal_t;
 
+/* What a propose step wants done; see civ_strategic_ai_commit */
+typedef enum {
+  CIV_AI_ACTION_SET_RELATION,    /* opinion and stance toward a nation */
+  CIV_AI_ACTION_ADD_GOAL,
+  CIV_AI_ACTION_FOUND_SETTLEMENT /* the best site-field candidate clearing
+                                    threshold, chosen at commit */
+} civ_ai_action_kind_t;
+
+typedef struct {
+  uint8_t kind; /* civ_ai_action_kind_t */
+  union {
+    struct {
+      civ_relation_id_t id;
+      civ_float_t opinion;
+      uint8_t stance;
+    } relation;
+    struct {
+      const char *type; /* static strings; interned on commit */
+      const char *description;
+      civ_float_t priority;
+    } goal;
+    struct {
+      civ_float_t threshold; /* least fitness worth settling */
+    } site;
+  };
+} civ_ai_action_t;
+
+typedef struct {
+  civ_ai_action_t *items;
+  size_t count;
+  size_t capacity;
+} civ_ai_actions_t;
+
 /* Strategic AI */
 typedef struct {
   civ_base_ai_t *base_ai;
@@ -32,10 +76,14 @@ typedef struct {
   civ_float_t planning_horizon; /* Years ahead to plan */
   civ_float_t risk_tolerance;   /* 0.0 to 1.0 */
 
+  civ_float_t player_distance; /* nearest own city to a player city */
+
   int32_t last_expansion_turn;
   int32_t expansion_frequency;
   civ_personality_type_t personality;
 
+  civ_ai_actions_t pending; /* proposed, not yet committed */
+
   void *game_ptr; /* Opaque pointer to civ_game_t */
 } civ_strategic_ai_t;
 
@@ -45,8 +93,25 @@ void civ_strategic_ai_destroy(civ_strategic_ai_t *ai);
 void civ_strategic_ai_init(civ_strategic_ai_t *ai, const char *id,
                            const char *name);
 
+/* Planning in resumable pieces; plan proposes them all in order and commits */
+typedef enum {
+  CIV_STRATEGIC_STEP_THINK,   /* base AI decisions */
+  CIV_STRATEGIC_STEP_THREATS, /* border friction, opinion and stance */
+  CIV_STRATEGIC_STEP_GOALS,   /* add, age and retire goals */
+  CIV_STRATEGIC_STEP_COUNT
+} civ_strategic_step_t;
+
 civ_result_t civ_strategic_ai_plan(civ_strategic_ai_t *ai,
                                    civ_float_t time_delta);
+/* Propose one step into ai->pending; safe to run for many AIs at once */
+civ_result_t civ_strategic_ai_plan_step(civ_strategic_ai_t *ai,
+                                        civ_strategic_step_t step,
+                                        civ_float_t time_delta);
+/* Propose this turn's expansion, if it is off cooldown */
+civ_result_t civ_strategic_ai_propose_expansion(civ_strategic_ai_t *ai,
+                                                void *game_ptr);
+/* Apply and clear ai->pending in the order proposed; sim thread only */
+civ_result_t civ_strategic_ai_commit(civ_strategic_ai_t *ai, void *game_ptr);
 civ_result_t civ_strategic_ai_add_goal(civ_strategic_ai_t *ai,
                                        const char *goal_type,
                                        const char *description,
@@ -57,7 +122,8 @@ civ_result_t civ_strategic_ai_update_goal(civ_strategic_ai_t *ai,
                                           size_t goal_index,
                                           civ_float_t progress);
 
-/* Proactive Actions */
+/* Proactive Actions; evaluate_threats and process_expansion propose and
+   commit in one go */
 civ_result_t civ_strategic_ai_evaluate_threats(civ_strategic_ai_t *ai,
                                                void *game_ptr);
 bool civ_strategic_ai_should_declare_war(civ_strategic_ai_t *ai, void *game_ptr,
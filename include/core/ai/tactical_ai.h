@@ -10,24 +10,43 @@
 #include "../../types.h"
 #include "base_ai.h"
 
-/* Tactical action */
+/* Per-action numbers: X(name) */
+#define CIV_TACTICAL_ACTION_FIELDS(X) \
+    X(urgency)          /* 0.0 to 1.0 */ \
+    X(cost)                              \
+    X(expected_benefit)                  \
+    X(utility)          /* scratch for get_best_action */
+
+/* Pending actions as parallel arrays, oldest first; interned types and
+   targets so scoring never touches strings */
+typedef struct {
+#define CIV_TACTICAL_ACTION_DECL(name) float* name;
+    CIV_TACTICAL_ACTION_FIELDS(CIV_TACTICAL_ACTION_DECL)
+#undef CIV_TACTICAL_ACTION_DECL
+    civ_symbol_t* type;
+    civ_symbol_t* target;
+    civ_float_t* timestamp; /* game clock when added */
+    size_t count;
+    size_t capacity;
+} civ_tactical_actions_t;
+
+/* One action, read back by civ_tactical_ai_get_action */
 typedef struct {
-    char action_type[STRING_SHORT_LEN];
-    char target[STRING_SHORT_LEN];
+    const char* action_type;
+    const char* target;
     civ_float_t urgency;  /* 0.0 to 1.0 */
     civ_float_t cost;
     civ_float_t expected_benefit;
-    time_t timestamp;
+    civ_float_t timestamp;
 } civ_tactical_action_t;
 
 /* Tactical AI */
 typedef struct {
     civ_base_ai_t* base_ai;
     
-    civ_tactical_action_t* actions;
-    size_t action_count;
-    size_t action_capacity;
+    civ_tactical_actions_t actions;
     
+    civ_float_t clock;          /* game seconds, advanced by react */
     civ_float_t reaction_time;  /* Seconds to react */
     civ_float_t decision_threshold; /* Minimum urgency to act */
 } civ_tactical_ai_t;
@@ -39,7 +58,10 @@ void civ_tactical_ai_init(civ_tactical_ai_t* ai, const char* id, const char* nam
 
 civ_result_t civ_tactical_ai_react(civ_tactical_ai_t* ai, civ_float_t time_delta);
 civ_result_t civ_tactical_ai_add_action(civ_tactical_ai_t* ai, const char* action_type, const char* target, civ_float_t urgency);
-civ_tactical_action_t* civ_tactical_ai_get_best_action(const civ_tactical_ai_t* ai);
+/* Index of the highest-utility action at or above the decision threshold,
+   -1 if none */
+int32_t civ_tactical_ai_get_best_action(const civ_tactical_ai_t* ai);
+bool civ_tactical_ai_get_action(const civ_tactical_ai_t* ai, size_t index, civ_tactical_action_t* out);
 civ_float_t civ_tactical_ai_calculate_utility(const civ_tactical_action_t* action);
 
 #endif /* CIVILIZATION_TACTICAL_AI_H */
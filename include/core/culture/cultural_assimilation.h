@@ -1,6 +1,14 @@
 /**
  * @file cultural_assimilation.h
  * @brief Cultural assimilation and adoption tracking
+ *
+ * Each assimilation is a record of its ids, type and tools, while the
+ * state an update touches is kept in columns by event index: progress,
+ * resistance, adoption, stage, and the inputs its rate is built from. An
+ * update gathers the inputs from the two identities, advances every event
+ * in one pass over the columns, and then does the per-event work serially:
+ * trait adoption, stage transitions and removals. Only events that crossed
+ * a stage threshold leave a transition behind.
  */
 
 #ifndef CIVILIZATION_CULTURAL_ASSIMILATION_H
@@ -35,35 +43,58 @@ typedef enum {
   CIV_TOOL_RELIGIOUS_SYNCRETISM /* Merging beliefs */
 } civ_assimilation_tool_t;
 
-/* Assimilation event */
+/* Assimilation event; its state lives in the tracker's columns */
 typedef struct {
   char source_culture_id[STRING_SHORT_LEN];
   char target_culture_id[STRING_SHORT_LEN];
   char region_id[STRING_SHORT_LEN];
 
   civ_assimilation_type_t type;
-  civ_integration_stage_t stage;
-
-  civ_float_t progress;   /* 0.0 to 1.0 */
-  civ_float_t rate;       /* Assimilation rate per time unit */
-  civ_float_t resistance; /* 0.0 to 1.0 - how much target resists */
 
   civ_assimilation_tool_t active_tools[4];
   size_t tool_count;
 
   int32_t population_affected;
-  civ_float_t adoption_level; /* 0.0 to 1.0 */
 
   time_t start_time;
   time_t last_update;
 } civ_assimilation_event_t;
 
+/* An event's stage change during the last update */
+typedef struct {
+  char source_culture_id[STRING_SHORT_LEN];
+  char target_culture_id[STRING_SHORT_LEN];
+  char region_id[STRING_SHORT_LEN];
+  civ_integration_stage_t from;
+  civ_integration_stage_t to;
+} civ_assimilation_transition_t;
+
 /* Assimilation tracker */
 typedef struct {
   civ_assimilation_event_t *events;
   size_t event_count;
   size_t event_capacity;
 
+  /* Columns by event index */
+  civ_float_t *progress;         /* 0.0 to 1.0 */
+  civ_float_t *rate;             /* per time unit, last update */
+  civ_float_t *resistance;       /* 0.0 to 1.0 - how much target resists */
+  civ_float_t *adoption_level;   /* 0.0 to 1.0 */
+  civ_float_t *tool_multiplier;  /* rate bonus of the applied tools */
+  civ_float_t *type_scale;       /* rate inputs, gathered each update */
+  civ_float_t *source_influence;
+  civ_float_t *target_openness;
+  civ_float_t *similarity;
+  int32_t *source_index;         /* identity indices; -1 = gone */
+  int32_t *target_index;
+  uint8_t *stage;                /* civ_integration_stage_t */
+  uint8_t *crossed;              /* scratch: stage before it moved this
+                                    update + 1; 0 = it did not */
+
+  civ_assimilation_transition_t *transitions; /* last update's */
+  size_t transition_count;
+  size_t transition_capacity;
+
   civ_float_t base_assimilation_rate;
   civ_float_t forced_assimilation_multiplier;
 } civ_assimilation_tracker_t;
@@ -79,17 +110,18 @@ civ_result_t civ_assimilation_tracker_add_event(
 civ_result_t civ_assimilation_tracker_update(
     civ_assimilation_tracker_t *tracker,
     civ_cultural_identity_manager_t *identity_manager, civ_float_t time_delta);
-civ_assimilation_event_t *
-civ_assimilation_tracker_get_event(const civ_assimilation_tracker_t *tracker,
-                                   const char *source_id,
-                                   const char *target_id);
+/* Index of the event for source_id -> target_id, -1 if none */
+int32_t
+civ_assimilation_tracker_find_event(const civ_assimilation_tracker_t *tracker,
+                                    const char *source_id,
+                                    const char *target_id);
 civ_float_t civ_assimilation_calculate_rate(
     civ_assimilation_tracker_t *tracker, const civ_cultural_identity_t *source,
     const civ_cultural_identity_t *target, civ_assimilation_type_t type);
 
 /* Policy Management */
-civ_result_t civ_assimilation_apply_tool(civ_assimilation_event_t *event,
+civ_result_t civ_assimilation_apply_tool(civ_assimilation_tracker_t *tracker,
+                                         size_t event,
                                          civ_assimilation_tool_t tool);
-civ_result_t civ_assimilation_update_stage(civ_assimilation_event_t *event);
 
 #endif /* CIVILIZATION_CULTURAL_ASSIMILATION_H */
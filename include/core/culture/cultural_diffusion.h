@@ -1,6 +1,16 @@
 /**
  * @file cultural_diffusion.h
  * @brief Cultural diffusion system
+ *
+ * Identities spread traits only along links: shared land borders between
+ * the owners whose ids they carry, and trade routes between those owners.
+ * Links are rebuilt by civ_cultural_diffusion_link into a CSR graph, each
+ * weighted by exp(-distance_decay * distance), a border's distance
+ * shrinking as it lengthens. Trait names are interned into columns of a
+ * dense strength matrix, one row per identity with a bitset of the traits
+ * it holds, so a tick is one sparse matrix-vector product: every row sums
+ * its neighbours' weighted rows, reading the previous matrix and writing
+ * the next, rows spread across the worker pool.
  */
 
 #ifndef CIVILIZATION_CULTURAL_DIFFUSION_H
@@ -9,6 +19,17 @@
 #include "../../common.h"
 #include "../../types.h"
 #include "cultural_identity.h"
+#include "../economy/international_trade.h"
+#include "../world/border_frontier.h"
+#include "../world/map_generator.h"
+
+struct civ_worker_pool;
+
+/* Link distances: a border of CIV_CULTURE_FULL_BORDER tiles or more is
+   CIV_CULTURE_BORDER_DISTANCE away, shorter ones proportionally farther */
+#define CIV_CULTURE_BORDER_DISTANCE 1.0f
+#define CIV_CULTURE_FULL_BORDER     32
+#define CIV_CULTURE_TRADE_DISTANCE  2.0f
 
 /* Diffusion event */
 typedef struct {
@@ -30,6 +51,32 @@ typedef struct {
   civ_float_t distance_decay;
   civ_float_t resistance_factor;
 
+  /* Link graph over identity indices: row i is adj_target/adj_weight
+     [adj_start[i], adj_start[i + 1]) */
+  uint32_t *adj_start;
+  uint32_t *adj_target;
+  float *adj_weight;
+  size_t adj_count;
+  size_t adj_capacity;
+  size_t linked_identities; /* rows in adj_start */
+  civ_border_frontier_t *frontier;
+
+  /* Trait table: column by trait symbol, -1 = none yet */
+  civ_symbol_t *trait_syms;
+  int32_t *column_of;
+  uint32_t column_of_size;
+  uint32_t trait_count;
+  uint32_t trait_capacity;
+
+  /* Strength matrices, identity rows of trait_stride floats, and the
+     bitsets of held traits, identity rows of trait_words words */
+  float *strength;
+  float *next_strength;
+  uint64_t *held;
+  size_t matrix_rows;
+  uint32_t trait_stride;
+  uint32_t trait_words;
+
   /* Soft Power & Dominance */
   civ_float_t soft_power_prestige; /* Generated by achievements */
   civ_float_t dominance_threshold; /* Min prestige required to aggressively push
@@ -41,9 +88,18 @@ civ_cultural_diffusion_t *civ_cultural_diffusion_create(void);
 void civ_cultural_diffusion_destroy(civ_cultural_diffusion_t *diffusion);
 void civ_cultural_diffusion_init(civ_cultural_diffusion_t *diffusion);
 
+/* Rebuild the links from map's borders and trade's routes; either may be
+   NULL. Identities are matched to owners by id. */
+civ_result_t civ_cultural_diffusion_link(civ_cultural_diffusion_t *diffusion,
+                                         const civ_cultural_identity_manager_t *manager,
+                                         civ_map_t *map,
+                                         const civ_trade_manager_t *trade);
+
+/* One diffusion tick over the links; pool may be NULL */
 civ_result_t
 civ_cultural_diffusion_process(civ_cultural_diffusion_t *diffusion,
                                civ_cultural_identity_manager_t *manager,
+                               struct civ_worker_pool *pool,
                                civ_float_t time_delta);
 civ_result_t civ_cultural_diffusion_diffuse_trait(
     civ_cultural_diffusion_t *diffusion, const civ_cultural_identity_t *source,
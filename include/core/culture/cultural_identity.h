@@ -8,10 +8,12 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include "../../utils/symbol.h"
 
 /* Cultural trait */
 typedef struct {
   char name[STRING_SHORT_LEN];
+  civ_symbol_t sym; /* name interned */
   civ_float_t strength; /* 0.0 to 1.0 */
   civ_float_t influence;
 } civ_cultural_trait_t;
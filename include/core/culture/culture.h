@@ -13,6 +13,8 @@
 #include "cultural_assimilation.h"
 #include "language_evolution.h"
 
+struct civ_worker_pool;
+
 /* Culture system */
 typedef struct {
     civ_cultural_identity_manager_t* identity_manager;
@@ -27,7 +29,13 @@ civ_culture_system_t* civ_culture_system_create(void);
 void civ_culture_system_destroy(civ_culture_system_t* culture);
 void civ_culture_system_init(civ_culture_system_t* culture);
 
-civ_result_t civ_culture_system_update(civ_culture_system_t* culture, civ_float_t time_delta);
+/* Diffusion relinks along map's borders and trade's routes, either of which
+   may be NULL, and runs on pool (NULL = inline) */
+civ_result_t civ_culture_system_update(civ_culture_system_t* culture,
+                                       civ_map_t* map,
+                                       const civ_trade_manager_t* trade,
+                                       struct civ_worker_pool* pool,
+                                       civ_float_t time_delta);
 
 #endif /* CIVILIZATION_CULTURE_H */
 
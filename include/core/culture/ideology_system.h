@@ -4,6 +4,15 @@
  *
  * Allows for the dynamic creation and evolution of ideologies based on
  * value spectrums rather than predefined types.
+ *
+ * The system also keeps every ideology it holds as a dense row over all the
+ * axes any of them uses (0 where one holds none), with the pairwise
+ * distances between rows cached. A refresh re-reads the values. Only rows
+ * that moved more than CIV_IDEOLOGY_DRIFT_EPSILON since their distances
+ * were computed get them recomputed, so a cached distance is within
+ * 2 x epsilon of the exact one. Nearest-neighbour queries read a row's
+ * neighbours sorted by distance, sorted again only after a refresh changed
+ * that row.
  */
 
 #ifndef CIVILIZATION_IDEOLOGY_SYSTEM_H
@@ -11,6 +20,7 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include "../../utils/symbol.h"
 
 /* Ideology Value (Axis) */
 typedef struct {
@@ -49,11 +59,30 @@ typedef struct {
   civ_float_t radicalism; /* How extreme the values are */
 } civ_ideology_t;
 
+#define CIV_IDEOLOGY_DRIFT_EPSILON 0.02
+
 /* Ideology System */
 typedef struct {
   civ_ideology_t *ideologies;
   size_t ideology_count;
   size_t ideology_capacity;
+
+  /* Dense store, rows by ideology index, row stride axis_capacity */
+  civ_symbol_t *axes;
+  size_t axis_count;
+  size_t axis_capacity;
+  int32_t *axis_of;        /* by symbol handle; -1 = not an axis */
+  uint32_t axis_of_size;
+  civ_float_t *vectors;    /* values as of the last refresh */
+  civ_float_t *cached;     /* values the row's distances were computed from */
+  civ_float_t *distance;   /* row_capacity x row_capacity, symmetric */
+  uint32_t *order;         /* per row: the other rows, nearest first */
+  bool *order_stale;
+  uint32_t *dirty;         /* scratch: rows recomputed this refresh */
+  civ_float_t *probe;      /* scratch: a query's values over axes */
+  civ_float_t *probe_distance; /* scratch: every row's distance to it */
+  size_t row_count;        /* rows refreshed */
+  size_t row_capacity;
 } civ_ideology_system_t;
 
 /* Functions */
@@ -85,4 +114,30 @@ void civ_ideology_update_metrics(
 civ_float_t civ_ideology_distance(const civ_ideology_t *a,
                                   const civ_ideology_t *b);
 
+/* Move ideology into the system; the struct is freed, the stored copy is
+   returned (valid until the next add). NULL and nothing moved on failure. */
+civ_ideology_t *civ_ideology_system_add(civ_ideology_system_t *system,
+                                        civ_ideology_t *ideology);
+
+/* Re-read every ideology's values into the store and recompute the
+   distances of those that drifted. Interns axis names: simulation thread. */
+civ_result_t civ_ideology_system_refresh(civ_ideology_system_t *system);
+
+/* Cached distance between ideologies i and j as of the last refresh */
+civ_float_t civ_ideology_system_distance(const civ_ideology_system_t *system,
+                                         size_t i, size_t j);
+
+/* Up to k ideologies nearest ideology i, nearest first, i excluded; ties go
+   to the lower index. out_distance may be NULL. Returns how many. */
+size_t civ_ideology_system_nearest(civ_ideology_system_t *system, size_t i,
+                                   size_t k, uint32_t *out,
+                                   civ_float_t *out_distance);
+
+/* Up to k ideologies nearest probe (an actor's values, not held by the
+   system), against the last refresh; nearest first. */
+size_t civ_ideology_system_nearest_to(civ_ideology_system_t *system,
+                                      const civ_ideology_t *probe, size_t k,
+                                      uint32_t *out,
+                                      civ_float_t *out_distance);
+
 #endif /* CIVILIZATION_IDEOLOGY_SYSTEM_H */
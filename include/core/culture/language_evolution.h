@@ -1,6 +1,14 @@
 /**
  * @file language_evolution.h
  * @brief Language evolution system
+ *
+ * Concept ids are interned, and each language finds its words through a
+ * small hash from concept to vocabulary index. Sound change picks the
+ * words it alters by geometric skips over the vocabulary, so a tick costs
+ * the words that change rather than the words there are. Each language
+ * also keeps a MinHash sketch of its (concept, word) pairs: matching slots
+ * between two sketches estimate the share of words the languages have in
+ * common, in CIV_LANGUAGE_SKETCH_SIZE compares whatever their size.
  */
 
 #ifndef CIVILIZATION_LANGUAGE_EVOLUTION_H
@@ -8,8 +16,11 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include "../../utils/symbol.h"
 #include "writing_system.h"
 
+#define CIV_LANGUAGE_SKETCH_SIZE 32
+
 /* Phonology - sound system */
 typedef struct {
   char consonants[STRING_SHORT_LEN];
@@ -47,6 +58,7 @@ typedef struct {
 typedef struct {
   char concept_id[STRING_SHORT_LEN]; /* Universal ID like "WATER", "MOTH" */
   char word[STRING_SHORT_LEN];       /* The representation in this language */
+  civ_symbol_t concept;              /* concept_id interned */
 } civ_vocab_entry_t;
 
 /* Language - evolution-based, no predefined families */
@@ -60,9 +72,16 @@ typedef struct {
   civ_phonology_t phonology;
   civ_grammar_t grammar;
 
-  civ_vocab_entry_t *vocabulary;
+  civ_vocab_entry_t *vocabulary;  /* one entry per concept */
   size_t vocabulary_size;
   size_t vocabulary_capacity;
+  uint32_t *concept_slots;        /* vocabulary index + 1 by concept, 0 = empty */
+  size_t concept_capacity;        /* power of two */
+
+  /* Per slot, the least hash of any (concept, word) pair; rebuilt by the
+     next update once words change */
+  uint32_t sketch[CIV_LANGUAGE_SKETCH_SIZE];
+  bool sketch_dirty;
 
   civ_float_t complexity; /* 0.0 to 1.0 */
   civ_float_t prestige;   /* 0.0 to 1.0 */
@@ -117,17 +136,28 @@ civ_result_t civ_language_evolve_grammar(civ_language_t *language,
 civ_result_t civ_language_evolve_vocabulary(civ_language_t *language,
                                             civ_float_t intensity);
 
+/* Kinship, plus shared vocabulary from the sketches when both have words
+   (their complexity otherwise) */
 civ_float_t civ_language_calculate_similarity(const civ_language_t *a,
                                               const civ_language_t *b);
+/* Estimated share of (concept, word) pairs a and b have in common */
+civ_float_t civ_language_lexical_similarity(const civ_language_t *a,
+                                            const civ_language_t *b);
+/* out[i * language_count + j] for every pair of languages */
+void civ_language_similarity_matrix(const civ_language_evolution_t *evolution,
+                                    civ_float_t *out);
+void civ_language_refresh_sketch(civ_language_t *language);
 civ_result_t civ_language_evolution_add(civ_language_evolution_t *evolution,
                                         civ_language_t *language);
 civ_language_t *
 civ_language_evolution_find(const civ_language_evolution_t *evolution,
                             const char *id);
 
-/* Vocabulary helper */
+/* Vocabulary helper; adding a concept the language has replaces its word */
 const char *civ_language_get_word(const civ_language_t *language,
                                   const char *concept_id);
+const char *civ_language_word_for(const civ_language_t *language,
+                                  civ_symbol_t concept);
 civ_result_t civ_language_add_word(civ_language_t *language,
                                    const char *concept_id, const char *word);
 
@@ -0,0 +1,101 @@
+/**
+ * @file naming.h
+ * @brief Reproducible procedural names, unique across every named entity
+ *
+ * Names are drawn from a stream per culture and kind of name, keyed by
+ * (rng_seed, CIV_RNG_NAMING, kind, culture), so a culture's n-th city name
+ * is the same every run whatever else has been named in between. Each name
+ * is checked against one set holding every name in use, nations, cities,
+ * characters and dynasties alike, and a name already taken is drawn again;
+ * a crowded length range grows a letter every few collisions.
+ *
+ * Accepted names are interned into one growing pool and handed out as
+ * civ_name_t handles, so a batch of thousands costs a few allocations, not
+ * one per name. Names are never released: a dead ruler's name stays taken.
+ *
+ * The set and the stream positions go into the save, so a loaded game or a
+ * replay seek draws the same names the original run went on to draw.
+ *
+ * Owned by the simulation thread; there is no global state.
+ */
+#ifndef CIVILIZATION_NAMING_H
+#define CIVILIZATION_NAMING_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include "../../utils/rng.h"
+#include "../interfaces/iserializable.h"
+#include "writing_system.h"
+
+#define CIV_NAMING_MAX_LEN   31 /* letters */
+#define CIV_NAMING_ATTEMPTS  32 /* draws before a name is given up on */
+
+typedef uint32_t civ_name_t; /* offset + 1 into the pool; 0 = none */
+
+typedef enum {
+  CIV_NAME_NATION = 0,
+  CIV_NAME_CITY,
+  CIV_NAME_CHARACTER,
+  CIV_NAME_DYNASTY,
+  CIV_NAME_KIND_COUNT
+} civ_name_kind_t;
+
+typedef struct {
+  uint64_t culture; /* FNV-1a of the culture id */
+  civ_name_kind_t kind;
+  civ_rng_t rng;
+  uint64_t drawn;
+} civ_name_stream_t;
+
+typedef struct {
+  uint64_t rng_seed; /* set by the owner before the first draw */
+
+  char *pool; /* interned names, each NUL-terminated */
+  size_t pool_size;
+  size_t pool_capacity;
+
+  /* Open-addressed set over the pool; slots hold civ_name_t, 0 = empty */
+  civ_name_t *slots;
+  uint32_t *slot_hashes;
+  size_t slot_count;
+  size_t name_count;
+
+  civ_name_stream_t *streams;
+  size_t stream_count;
+  size_t stream_capacity;
+
+  uint64_t collisions; /* draws refused as already taken */
+} civ_naming_service_t;
+
+civ_naming_service_t *civ_naming_create(void);
+void civ_naming_destroy(civ_naming_service_t *naming);
+
+/* Take a name chosen elsewhere (data files, the player); 0 when it is
+   empty, already taken or out of memory */
+civ_name_t civ_naming_reserve(civ_naming_service_t *naming, const char *name);
+/* Handle of a name in use, or 0 */
+civ_name_t civ_naming_find(const civ_naming_service_t *naming, const char *name);
+/* Text of a handle; "" for 0. Good until the next name is added. */
+const char *civ_naming_text(const civ_naming_service_t *naming, civ_name_t name);
+
+/* A new name from culture's stream for kind, spelt with script's letters
+   (NULL = a plain Latin set); 0 when every attempt collided or out of
+   memory */
+civ_name_t civ_naming_generate(civ_naming_service_t *naming,
+                               const civ_writing_system_t *script,
+                               const char *culture, civ_name_kind_t kind,
+                               size_t min_length, size_t max_length);
+/* count names into out, with room made for all of them up front; how many
+   were made, the rest of out left 0 */
+size_t civ_naming_generate_batch(civ_naming_service_t *naming,
+                                 const civ_writing_system_t *script,
+                                 const char *culture, civ_name_kind_t kind,
+                                 size_t min_length, size_t max_length,
+                                 civ_name_t *out, size_t count);
+
+/* Save section: the pool, in order, and every stream's position; loading
+   replaces the set wholesale, so handles keep their values */
+#define CIV_NAMING_SAVE_VERSION 1
+civ_serializable_t civ_naming_serializable(civ_naming_service_t *naming);
+
+#endif /* CIVILIZATION_NAMING_H */
@@ -1,6 +1,16 @@
 /**
  * @file religion_system.h
  * @brief Emergent Religious System
+ *
+ * Religions spread over the trade network's settlement graph. Each node
+ * keeps its CIV_RELIGION_TOP_K largest faiths as 16-bit shares, largest
+ * first; what the slots do not hold is unaffiliated. Each religion keeps a
+ * frontier: the nodes where it is below saturation and that it already
+ * holds or borders. An update visits only frontier nodes. It works out
+ * every conversion from the state at the start of the update, then applies
+ * them. Pressure comes from the religion's share on the node and on its
+ * neighbours, weighted by edge cost, and is scaled by fervor and by the
+ * cultural influence field at the node's tile.
  */
 
 #ifndef CIVILIZATION_RELIGION_SYSTEM_H
@@ -8,6 +18,8 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include "../economy/trade_network.h"
+#include "../world/tile_field.h"
 
 /* Religious Tenet */
 typedef enum {
@@ -34,13 +46,43 @@ typedef struct {
   bool is_extinct;
 
   time_t creation_time;
+
+  /* Spread state, maintained by the system */
+  uint32_t *frontier;      /* nodes to visit */
+  uint32_t frontier_count;
+  uint32_t frontier_capacity;
+  uint64_t *in_frontier;   /* bit per node */
+  uint32_t frontier_words;
+  uint64_t adherent_mass;  /* sum of this religion's shares over nodes */
 } civ_religion_t;
 
+#define CIV_RELIGION_TOP_K       4
+#define CIV_RELIGION_MAX         255      /* religions a node slot can name */
+#define CIV_RELIGION_SHARE_ONE   65535u
+#define CIV_RELIGION_SATURATED   64224u   /* 98%: stops spreading there */
+#define CIV_RELIGION_SPREAD_RATE 0.05f    /* pressure per unit time at fervor 1 */
+#define CIV_RELIGION_REACH_COST  480u     /* edge cost at which weight halves */
+
+/* A node's faiths, largest share first; religion 0 = empty slot, else the
+   religion's index + 1 */
+typedef struct {
+  uint16_t share[CIV_RELIGION_TOP_K];
+  uint8_t religion[CIV_RELIGION_TOP_K];
+} civ_religion_adherence_t;
+
 /* Religion Manager */
 typedef struct {
   civ_religion_t *religions;
   size_t religion_count;
   size_t religion_capacity;
+
+  civ_religion_adherence_t *adherence; /* by trade network node */
+  uint32_t node_count;
+  uint32_t node_capacity;
+  uint32_t edges_seen;     /* network edge count the frontiers were built on */
+  bool frontiers_stale;
+  float *conversion;       /* scratch: per frontier entry, this update */
+  size_t conversion_capacity;
 } civ_religion_system_t;
 
 /* Functions */
@@ -53,4 +95,25 @@ civ_result_t civ_religion_spread(civ_religion_t *religion,
                                  const char *target_region_id,
                                  civ_float_t rate);
 
+/* Give religion (an index into religions) share of node's people, taken
+   evenly from everyone else there; the frontiers are rebuilt on the next
+   update */
+civ_result_t civ_religion_found(civ_religion_system_t *system,
+                                size_t religion, uint32_t node,
+                                civ_float_t share);
+
+/* Advance every frontier over dt. net supplies the graph; field may be
+   NULL (no cultural scaling). Cost follows the frontier sizes. */
+void civ_religion_system_update(civ_religion_system_t *system,
+                                const civ_trade_network_t *net,
+                                const civ_tile_field_t *field,
+                                civ_float_t dt);
+
+/* Religion index with the largest share at node, -1 if none */
+int32_t civ_religion_dominant(const civ_religion_system_t *system,
+                              uint32_t node);
+/* religion's share of node, 0 to 1 */
+civ_float_t civ_religion_share(const civ_religion_system_t *system,
+                               size_t religion, uint32_t node);
+
 #endif /* CIVILIZATION_RELIGION_SYSTEM_H */
@@ -8,6 +8,7 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include "../../utils/rng.h"
 
 /* Writing system type */
 typedef enum {
@@ -64,8 +65,16 @@ civ_result_t
 civ_writing_system_evolve_from(civ_writing_system_manager_t *manager,
                                const civ_writing_system_t *parent,
                                const char *new_id, const char *new_name);
+/* A name of min_length to max_length letters drawn from the bound stream
+   (see civ_rand); the caller frees it */
 char *civ_writing_system_generate_name(const civ_writing_system_t *script,
                                        size_t min_length, size_t max_length);
+/* Spell a capitalised name from script's characters into out, drawing from
+   rng; its length, cut to out_size - 1, or 0 when script has no letters */
+size_t civ_writing_system_spell_name(const civ_writing_system_t *script,
+                                     civ_rng_t *rng, size_t min_length,
+                                     size_t max_length, char *out,
+                                     size_t out_size);
 civ_result_t civ_writing_system_evolve_symbols(civ_writing_system_t *script,
                                                civ_float_t intensity);
 civ_result_t
@@ -1,6 +1,18 @@
 /**
  * @file history_db.h
  * @brief Masterpiece Journaling Database (Event-Sourced Chronicles)
+ *
+ * The journal is append-only. Events are encoded as variable-length records
+ * and written to numbered segment files beside db_path ("<db_path>.0000",
+ * "<db_path>.0001", ...). A segment that reaches CIV_JOURNAL_SEGMENT_BYTES is
+ * sealed with a footer holding a sparse sequence index and per-type counts,
+ * and the next one is started. Logging only queues the record; a background
+ * thread appends queued records and syncs them to disk in batches.
+ *
+ * Every record carries the turn set with civ_journal_set_turn and a hash of
+ * its context. The footer keeps a zone map (type bitmap, turn range,
+ * context filter) per block of records and for the whole segment, so
+ * civ_journal_query maps each segment and reads only blocks that can match.
  */
 
 #ifndef CIVILIZATION_HISTORY_DB_H
@@ -21,36 +33,85 @@ typedef enum {
   CIV_JOURNAL_SETTLEMENT_GROWTH,
   CIV_JOURNAL_POLICY_CHANGED,
   CIV_JOURNAL_NATURAL_DISASTER,
-  CIV_JOURNAL_GENERIC_LOG
+  CIV_JOURNAL_GENERIC_LOG,
+  CIV_JOURNAL_TYPE_COUNT
 } civ_journal_event_type_t;
 
+#define CIV_JOURNAL_SEGMENT_BYTES  (4u << 20)  /* rotate past this size */
+#define CIV_JOURNAL_SYNC_BYTES     (64u << 10) /* queued bytes that wake the writer */
+#define CIV_JOURNAL_SYNC_MS        1000        /* longest a record waits for disk */
+#define CIV_JOURNAL_INDEX_STRIDE   64          /* records per footer index entry */
+#define CIV_JOURNAL_CONTEXT_MAX    127
+#define CIV_JOURNAL_DATA_MAX       65535
+#define CIV_JOURNAL_TYPE_BIT(t)    (1u << (unsigned)(t))
+
+/* One event as read back; data points into the mapped segment, and both
+   it and context are valid only during the visit callback */
 typedef struct {
   uint64_t sequence_id;
   uint32_t timestamp;
+  int32_t turn;
   civ_journal_event_type_t type;
-  char context[128];
-  uint8_t data[256]; /* Generic binary blob for event-specific data */
+  const char *context;
+  const uint8_t *data;
   size_t data_size;
 } civ_event_t;
 
+/* Return false to stop the replay or query */
+typedef bool (*civ_journal_visit_fn_t)(const civ_event_t *event,
+                                       void *user_data);
+
+/* Filter for civ_journal_query; start from civ_journal_query_init */
+typedef struct {
+  uint32_t type_mask;        /* CIV_JOURNAL_TYPE_BIT per type, 0 = any */
+  int32_t turn_min;          /* inclusive */
+  int32_t turn_max;
+  const char *context;       /* exact context, NULL = any */
+  uint64_t from_sequence;
+} civ_journal_query_t;
+
+typedef struct civ_journal_sink civ_journal_sink_t;
+
 typedef struct {
-  civ_event_t *journal;
   size_t event_count;
-  size_t capacity;
+  uint64_t next_sequence;
+  size_t type_counts[CIV_JOURNAL_TYPE_COUNT];
   char db_path[256];
   uint32_t format_version;
+  int32_t current_turn;     /* stamped on each logged event */
+  civ_journal_sink_t *sink; /* background writer; NULL without a path */
 } civ_journal_t;
 
 /* Robust Journal Interface */
+/* Starts a fresh journal at path, removing segments an earlier one left */
 civ_journal_t *civ_journal_create(const char *path);
 void civ_journal_destroy(civ_journal_t *j);
 
+/* Queue an event; context is cut at CIV_JOURNAL_CONTEXT_MAX bytes and data
+   larger than CIV_JOURNAL_DATA_MAX is refused */
 civ_result_t civ_journal_log(civ_journal_t *j, civ_journal_event_type_t type,
                              const char *context, const void *data,
                              size_t size);
+/* Block until every queued event is written and synced */
 civ_result_t civ_journal_flush(civ_journal_t *j);
+/* Reopen the segments at path; later events go to a new segment. A torn
+   record at the end of the last segment is dropped. */
 civ_result_t civ_journal_load(civ_journal_t *j, const char *path);
 
+/* Turn stamped on events logged from now on */
+void civ_journal_set_turn(civ_journal_t *j, int32_t turn);
+
+/* Visit events in order from from_sequence on; flushes first */
+civ_result_t civ_journal_replay(civ_journal_t *j, uint64_t from_sequence,
+                                civ_journal_visit_fn_t fn, void *user_data);
+
+/* Match-anything filter: every type and turn, no context */
+void civ_journal_query_init(civ_journal_query_t *q);
+/* Visit matching events in order; flushes first */
+civ_result_t civ_journal_query(civ_journal_t *j, const civ_journal_query_t *q,
+                               civ_journal_visit_fn_t fn, void *user_data);
+size_t civ_journal_query_count(civ_journal_t *j, const civ_journal_query_t *q);
+
 /* Query helpers */
 size_t civ_journal_count_by_type(const civ_journal_t *j,
                                  civ_journal_event_type_t type);
@@ -0,0 +1,66 @@
+/**
+ * @file price_history.h
+ * @brief Fixed-size price history of one instrument at three resolutions
+ *
+ * Each level is a ring of CIV_PRICE_HISTORY_CAPACITY buckets holding the
+ * min, max and mean price over 1, 10 or 100 turns. Every sample goes into
+ * the open bucket of all three levels at once, so the coarse levels never
+ * re-read the fine ones. A read picks the finest level that covers the
+ * requested window in no more buckets than it was asked for points, so
+ * drawing costs O(points) whatever the window. The struct has no heap
+ * parts: memory per instrument is the same on turn 10 and turn 100000.
+ */
+
+#ifndef CIVILIZATION_PRICE_HISTORY_H
+#define CIVILIZATION_PRICE_HISTORY_H
+
+#include "../../common.h"
+#include "../../types.h"
+
+#define CIV_PRICE_HISTORY_LEVELS 3
+#define CIV_PRICE_HISTORY_CAPACITY 128 /* buckets per level */
+
+typedef struct {
+  int32_t start; /* first turn of the bucket, a multiple of its span */
+  uint16_t count;
+  float min, max;
+  float sum;
+} civ_price_bucket_t;
+
+typedef struct {
+  civ_price_bucket_t buckets[CIV_PRICE_HISTORY_CAPACITY];
+  uint32_t head;  /* ring slot the next closed bucket goes to */
+  uint32_t count; /* closed buckets held */
+  civ_price_bucket_t open;
+} civ_price_level_t;
+
+typedef struct {
+  civ_price_level_t levels[CIV_PRICE_HISTORY_LEVELS];
+  int32_t first_turn; /* oldest sample still held; both valid once one is */
+  int32_t last_turn;  /* newest sample */
+} civ_price_history_t;
+
+void civ_price_history_init(civ_price_history_t *h);
+
+/**
+ * Add a price for turn. Samples for the same turn fold into its bucket; a
+ * turn before the newest recorded one (a load or replay went back) first
+ * clears the history.
+ */
+void civ_price_history_record(civ_price_history_t *h, int32_t turn, float price);
+
+/**
+ * Buckets with turn_min <= turn <= turn_max, oldest first: the turn each
+ * starts at and its min, max and mean, in arrays that may each be NULL.
+ * Writes at most max_points, merging neighbouring buckets when even the
+ * coarsest level holds more, and returns how many it wrote.
+ */
+size_t civ_price_history_read(const civ_price_history_t *h, int32_t turn_min,
+                              int32_t turn_max, size_t max_points,
+                              float *turns, float *mins, float *maxs,
+                              float *avgs);
+
+/* True once a price has been recorded */
+bool civ_price_history_has_data(const civ_price_history_t *h);
+
+#endif /* CIVILIZATION_PRICE_HISTORY_H */
@@ -0,0 +1,104 @@
+/**
+ * @file query.h
+ * @brief Read-only query language over nation state and metric history
+ *
+ * A query filters the nations, optionally through a join on their
+ * neighbours or enemies, and either lists them or aggregates them:
+ *
+ *   select gdp, inflation where inflation > 8% and borders(at_war)
+ *     order by gdp desc limit 10
+ *   select count, avg(unemployment) where land_km2 > 1e6
+ *   select stability where stability < 0.4 during last 20
+ *
+ * Fields are nation indicators, listed with civ_query_field_name. With
+ * "during A..B" or "during last N" each field the metric history keeps
+ * (data/time_series.h) reads as its mean over those turns instead of its
+ * current value; a nation with no samples there reads as missing, which
+ * fails every comparison and is left out of every aggregate. Expressions
+ * take + - * /, comparisons, and, or, not and parentheses; N% is N / 100.
+ * borders(e) and at_war_with(e) are the joins: true for a nation with a
+ * neighbour, or an enemy, for which e holds. Without select the matching
+ * nations are listed with no columns.
+ *
+ * A compiled query knows which columns it reads, so a snapshot copies only
+ * those: current fields from the nation array, history ranges from the
+ * metric series, border pairs from the tech diffusion's border frontier
+ * and wars from the diplomacy's active relations, never a whole map or
+ * table. Running a query touches nothing but its snapshot, so it can run
+ * on any thread; civ_query_worker_t runs one at a time on its own. The
+ * expression is evaluated a column at a time, each node one flat pass
+ * over all rows.
+ */
+
+#ifndef CIVILIZATION_QUERY_H
+#define CIVILIZATION_QUERY_H
+
+#include "../../common.h"
+#include "../../types.h"
+
+struct civ_game;
+
+#define CIV_QUERY_MAX_SELECT 8
+#define CIV_QUERY_MAX_NODES  96
+#define CIV_QUERY_LABEL_MAX  32
+#define CIV_QUERY_NAME_MAX   64
+
+typedef struct civ_query civ_query_t;
+typedef struct civ_query_snapshot civ_query_snapshot_t;
+
+typedef struct {
+  int32_t turn;           /* of the snapshot */
+  size_t row_count;
+  int column_count;
+  char columns[CIV_QUERY_MAX_SELECT][CIV_QUERY_LABEL_MAX]; /* select text */
+  int32_t *nations;       /* per row: nation index, -1 for an aggregate */
+  char (*names)[CIV_QUERY_NAME_MAX];
+  double *values;         /* row_count * column_count, row by row; NaN = missing */
+} civ_query_result_t;
+
+/* NULL on a syntax error, described in error */
+civ_query_t *civ_query_compile(const char *text, char *error,
+                               size_t error_size);
+void civ_query_destroy(civ_query_t *query);
+
+/* Copy what query reads out of game; call on the sim thread. NULL
+   without memory or nations. */
+civ_query_snapshot_t *civ_query_snapshot_take(const struct civ_game *game,
+                                              const civ_query_t *query);
+void civ_query_snapshot_destroy(civ_query_snapshot_t *snapshot);
+
+/* Run query on a snapshot taken for it; free out with
+   civ_query_result_free */
+civ_result_t civ_query_run(const civ_query_t *query,
+                           const civ_query_snapshot_t *snapshot,
+                           civ_query_result_t *out);
+void civ_query_result_free(civ_query_result_t *result);
+
+/* Name of field i, NULL past the last, for help text and autocomplete */
+const char *civ_query_field_name(int i);
+
+/* ── Query worker ─────────────────────────────────────────────────────
+   One background thread running one query at a time, for screens that
+   must not hold up the frame. */
+typedef struct civ_query_worker civ_query_worker_t;
+
+civ_query_worker_t *civ_query_worker_create(void);
+/* Waits for the query in flight, then joins the thread */
+void civ_query_worker_destroy(civ_query_worker_t *worker);
+
+/* Snapshot game here and run query on the worker; false, with nothing
+   taken, while another runs or without memory. query must stay alive
+   until its result is taken. */
+bool civ_query_worker_submit(civ_query_worker_t *worker,
+                             const struct civ_game *game,
+                             const civ_query_t *query);
+bool civ_query_worker_busy(const civ_query_worker_t *worker);
+void civ_query_worker_wait(civ_query_worker_t *worker);
+
+/* The finished query's result and status, once; false if none waits.
+   out is only filled when the status is CIV_OK. */
+bool civ_query_worker_take_result(civ_query_worker_t *worker,
+                                  civ_query_result_t *out,
+                                  civ_result_t *status);
+
+#endif /* CIVILIZATION_QUERY_H */
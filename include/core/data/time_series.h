@@ -0,0 +1,103 @@
+/**
+ * @file time_series.h
+ * @brief Per-turn columnar history of nation economy and governance metrics
+ *
+ * One sample per turn holds every metric of every nation. Each (nation,
+ * metric) pair is its own column of fixed-point values, split into blocks
+ * of CIV_SERIES_BLOCK samples; a full block is sealed into its first value
+ * plus the differences to it, stored at the narrowest byte width that fits
+ * them. All columns share block boundaries with the turn column, so a
+ * range read binary-searches the turns once and decodes only the blocks it
+ * covers. Appending fills the open block and is constant time.
+ *
+ * Metric blocks more than CIV_SERIES_DETAIL_BLOCKS behind the newest are
+ * coarsened off the sim thread, through civ_time_series_coarsen on the
+ * maintenance thread (utils/maintenance.h), to one mean per
+ * CIV_SERIES_COARSE_STRIDE samples that reads back as a step. The turn
+ * column stays exact. The new block replaces the old one with an atomic
+ * pointer swap, so reads never wait, and the old one is freed by the next
+ * append. Reads and exports see every block that far back as coarse,
+ * whether or not the thread has got to it, so what they return depends on
+ * the turns recorded alone and two runs of one seed match. Reads and
+ * appends must still come from the sim thread or hold its lock.
+ */
+
+#ifndef CIVILIZATION_TIME_SERIES_H
+#define CIVILIZATION_TIME_SERIES_H
+
+#include "../../common.h"
+#include "../../types.h"
+
+#define CIV_SERIES_BLOCK 256 /* samples per block */
+#define CIV_SERIES_DETAIL_BLOCKS 4  /* newest sealed blocks kept in full */
+#define CIV_SERIES_COARSE_STRIDE 4  /* samples per value in older blocks */
+
+typedef enum {
+  CIV_SERIES_GDP = 0,
+  CIV_SERIES_INFLATION,
+  CIV_SERIES_UNEMPLOYMENT,
+  CIV_SERIES_TAX_REVENUE,
+  CIV_SERIES_STABILITY,
+  CIV_SERIES_LEGITIMACY,
+  CIV_SERIES_METRIC_COUNT
+} civ_series_metric_t;
+
+typedef struct civ_series_column civ_series_column_t;
+typedef struct civ_series_upkeep civ_series_upkeep_t;
+
+typedef struct {
+  size_t sample_count;
+  int nation_count;
+  civ_series_column_t *turns;   /* turn of each sample */
+  civ_series_column_t *columns; /* nation * CIV_SERIES_METRIC_COUNT + metric */
+  civ_series_upkeep_t *upkeep;  /* coarsening state shared with maintenance */
+} civ_time_series_t;
+
+civ_time_series_t *civ_time_series_create(void);
+void civ_time_series_destroy(civ_time_series_t *ts);
+void civ_time_series_clear(civ_time_series_t *ts);
+
+/**
+ * Record one turn: values holds CIV_SERIES_METRIC_COUNT per nation, nation
+ * by nation. Nations past the current count start their columns here;
+ * nations missing from values repeat their last sample. A turn at or before
+ * the last recorded one (a load or replay went back) first drops the
+ * samples from that turn on.
+ */
+civ_result_t civ_time_series_append(civ_time_series_t *ts, int32_t turn,
+                                    const float *values, int nation_count);
+
+/**
+ * Samples of one column with turn_min <= turn <= turn_max, as graph-ready
+ * x (turn) and y arrays; either may be NULL. Writes at most max samples,
+ * oldest first, and returns the total number in range.
+ */
+size_t civ_time_series_read(const civ_time_series_t *ts, int nation,
+                            civ_series_metric_t metric, int32_t turn_min,
+                            int32_t turn_max, float *turns, float *values,
+                            size_t max);
+
+/**
+ * Coarsen old blocks until max_bytes of them are done or SDL_GetTicksNS()
+ * passes deadline_ns. Safe from any one thread alongside the sim thread.
+ * @return Bytes of full-detail blocks replaced, 0 when none are due
+ */
+size_t civ_time_series_coarsen(civ_time_series_t *ts, size_t max_bytes,
+                               uint64_t deadline_ns);
+
+/* Name used for the metric in exports */
+const char *civ_time_series_metric_name(civ_series_metric_t metric);
+
+/* Heap bytes held by the blocks */
+size_t civ_time_series_bytes(const civ_time_series_t *ts);
+
+/* One row per turn and nation; nation_names (nation_count entries) may be
+   NULL to write indices */
+civ_result_t civ_time_series_export_csv(const civ_time_series_t *ts,
+                                        const char *path,
+                                        const char *const *nation_names);
+/* The blocks as stored, after a header with the fixed-point scales */
+civ_result_t civ_time_series_export_binary(const civ_time_series_t *ts,
+                                           const char *path);
+
+#endif /* CIVILIZATION_TIME_SERIES_H */
@@ -1,6 +1,15 @@
 /**
  * @file international_organizations.h
  * @brief International Organizations and Alliances System
+ *
+ * Members are nation symbols. For voting, each organization keeps a bitset
+ * of its members by diplomacy nation index, rebuilt when the membership or
+ * the diplomacy nation table changes. Resolutions stay open until the next
+ * session, where every open resolution of every organization is voted in
+ * one pass: each member weighs its opinion of the proposer from the
+ * relation columns against the distance from its ideology to the
+ * resolution's position, and votes for, against or abstains. A vote cast
+ * by hand replaces the member's own.
  */
 
 #ifndef CIVILIZATION_INTERNATIONAL_ORGANIZATIONS_H
@@ -8,7 +17,12 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include "../../utils/symbol.h"
 #include "../governance/legal/constitution.h"
+#include "relations.h"
+
+#define CIV_ORG_AXES         4
+#define CIV_ORG_ABSTAIN_BAND 0.1f /* |score| within this abstains */
 
 /* Organization Type */
 typedef enum {
@@ -25,13 +39,23 @@ typedef struct {
   char title[STRING_MEDIUM_LEN];
   char description[STRING_MAX_LEN];
   char proposer_id[STRING_SHORT_LEN];
+  civ_symbol_t sym;
+  civ_symbol_t proposer;
+  float position[CIV_ORG_AXES]; /* on the ideology axes */
+  float pass_share;             /* of votes for or against; default 0.5 */
+
+  /* Votes cast by hand, applied over the members' own at the session */
+  civ_symbol_t *cast_by;
+  int8_t *cast_vote;
+  size_t cast_count;
+  size_t cast_capacity;
 
   int votes_for;
   int votes_against;
   int votes_abstain;
 
   bool passed;
-  bool active;
+  bool active; /* open until the next session */
 } civ_resolution_t;
 
 /* International Organization */
@@ -40,15 +64,23 @@ typedef struct {
   char name[STRING_MEDIUM_LEN];
   civ_org_type_t type;
 
-  char **member_ids;
+  civ_symbol_t *members;
   size_t member_count;
   size_t member_capacity;
 
+  /* Members by diplomacy nation index, for the session */
+  uint64_t *member_bits;
+  size_t member_words;
+  const civ_diplomacy_system_t *member_table; /* the bits were built from */
+  size_t member_table_size;
+  bool members_valid;
+
   char leader_id[STRING_SHORT_LEN]; /* Optional leader/chair */
 
   civ_resolution_t *resolutions;
   size_t resolution_count;
   size_t resolution_capacity;
+  uint32_t resolutions_proposed; /* names res_<n> */
 
   civ_float_t cohesion; /* 0.0 to 1.0 */
   time_t formation_date;
@@ -61,6 +93,10 @@ typedef struct {
   civ_international_org_t *orgs;
   size_t org_count;
   size_t org_capacity;
+
+  /* Session scratch, per diplomacy nation */
+  int8_t *vote;
+  size_t vote_capacity;
 } civ_org_manager_t;
 
 /* Functions */
@@ -74,9 +110,13 @@ civ_result_t civ_org_add_member(civ_international_org_t *org,
                                 const char *nation_id);
 civ_result_t civ_org_remove_member(civ_international_org_t *org,
                                    const char *nation_id);
-civ_result_t civ_org_propose_resolution(civ_international_org_t *org,
-                                        const char *title, const char *desc,
-                                        const char *proposer);
+bool civ_org_is_member(const civ_international_org_t *org, civ_symbol_t nation);
+/* Resolution index, -1 if unknown; position (CIV_ORG_AXES, may be NULL)
+   is where the resolution stands on the ideology axes */
+int32_t civ_org_propose_resolution(civ_international_org_t *org,
+                                   const char *title, const char *desc,
+                                   const char *proposer, const float *position);
+int32_t civ_org_find_resolution(const civ_international_org_t *org, civ_symbol_t id);
 civ_result_t civ_org_vote(civ_international_org_t *org,
                           const char *resolution_id, const char *voter_id,
                           int vote); /* 1=For, -1=Against, 0=Abstain */
@@ -86,4 +126,13 @@ civ_result_t civ_org_manager_add(civ_org_manager_t *manager,
 civ_international_org_t *civ_org_manager_find(civ_org_manager_t *manager,
                                               const char *id);
 
+/* Vote every open resolution of every organization. Members missing from
+   the diplomacy table abstain. ideology holds one row of axes values per
+   diplomacy nation (the first CIV_ORG_AXES are read), NULL to vote on
+   relations alone. Resolutions decided at the previous session are dropped
+   first. Returns the number decided. */
+size_t civ_org_manager_hold_sessions(civ_org_manager_t *manager,
+                                     const civ_diplomacy_system_t *ds,
+                                     const civ_float_t *ideology, size_t axes);
+
 #endif /* CIVILIZATION_INTERNATIONAL_ORGANIZATIONS_H */
@@ -8,6 +8,9 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include "../interfaces/iserializable.h"
+#include "../../utils/memory_pool.h"
+#include "../../utils/timing_wheel.h"
 
 /* Relation level enumeration */
 typedef enum {
@@ -41,25 +44,27 @@ typedef enum {
   CIV_TREATY_TYPE_NON_AGGRESSION,
   CIV_TREATY_TYPE_DEFENSIVE_PACT,
   CIV_TREATY_TYPE_MILITARY_ALLIANCE,
-  CIV_TREATY_TYPE_RESEARCH_PARTNERSHIP
+  CIV_TREATY_TYPE_RESEARCH_PARTNERSHIP,
+  CIV_TREATY_TYPE_COUNT
 } civ_treaty_type_t;
 
-/* Diplomatic relation structure */
-typedef struct {
-  char nation_a[STRING_SHORT_LEN];
-  char nation_b[STRING_SHORT_LEN];
-  civ_relation_level_t relation_level;
-  civ_ai_stance_t current_stance;
-  civ_float_t trust;
-  civ_float_t opinion_score; /* -100.0 to 100.0 */
-  civ_personality_type_t personality;
-
-  /* Casus Belli & History */
-  civ_float_t grievances; /* Accumulated historical wrongs */
-  char primary_casus_belli[STRING_MEDIUM_LEN];
+/* One relation per unordered pair of nations: i < j maps to
+   j * (j - 1) / 2 + i */
+typedef int32_t civ_relation_id_t;
+#define CIV_RELATION_NONE (-1)
 
-  time_t last_updated;
-} civ_diplomatic_relation_t;
+/* Relation columns, each relation_count long and indexed by
+   civ_relation_id_t, so per-turn updates are flat sweeps */
+typedef struct {
+  civ_float_t *trust;
+  civ_float_t *opinion_score; /* -100.0 to 100.0 */
+  civ_float_t *grievances;    /* Accumulated historical wrongs */
+  int8_t *relation_level;     /* civ_relation_level_t */
+  uint8_t *current_stance;    /* civ_ai_stance_t */
+  uint8_t *personality;       /* civ_personality_type_t */
+  int32_t *casus_belli;       /* into casus_belli_text; -1 = none */
+  time_t *last_updated;
+} civ_relation_columns_t;
 
 /* Treaty structure */
 typedef struct {
@@ -68,18 +73,48 @@ typedef struct {
   char **signatories;
   size_t signatory_count;
   time_t start_date;
-  int32_t duration_days;
+  int32_t duration_days;     /* <= 0 = no expiry */
+  civ_float_t days_left;     /* game days until expiry, as last saved or
+                                loaded; see civ_diplomacy_treaty_days_left */
   bool active;
+  /* Rebuilt from the signatories, not saved */
+  civ_relation_id_t relation; /* between the first two signatories */
+  int32_t next_in_pair;       /* next active treaty on the pair; -1 ends */
+  civ_timer_id_t expiry;      /* in the system's expiry wheel; 0 = none */
 } civ_treaty_t;
 
 /* Diplomacy system structure */
 typedef struct {
-  civ_diplomatic_relation_t *relations;
-  size_t relation_count;
-  size_t relation_capacity;
+  /* Nations with relations, found by id through an FNV-1a table */
+  char (*nation_ids)[STRING_SHORT_LEN];
+  size_t nation_count;
+  uint32_t *nation_slots; /* nation index + 1; 0 = empty */
+  size_t nation_slot_count;
+
+  civ_relation_columns_t rel;
+  size_t relation_count; /* nation_count * (nation_count - 1) / 2 */
+  char (*casus_belli_text)[STRING_MEDIUM_LEN];
+  size_t casus_belli_count;
+
   civ_treaty_t *treaties;
   size_t treaty_count;
   size_t treaty_capacity;
+
+  /* Treaty ends wait in a wheel of game hours, so an advance touches only
+     the treaties running out rather than counting every one down */
+  double clock_days;          /* game days the treaties have advanced */
+  civ_timing_wheel_t expiry;  /* keyed by treaty index */
+
+  /* Active treaties indexed by pair and counted by type */
+  int32_t *pair_treaty_head; /* per relation: first treaty, -1 = none */
+  size_t active_treaties[CIV_TREATY_TYPE_COUNT];
+
+  /* Relations away from their resting state; the only ones updated */
+  civ_relation_id_t *active_ids;
+  size_t active_count;
+  size_t active_capacity;
+  uint8_t *is_active; /* per relation */
+  civ_memory_pool_manager_t *pool; /* signatory strings; NULL = heap */
 } civ_diplomacy_system_t;
 
 /* Function declarations */
@@ -87,24 +122,84 @@ civ_diplomacy_system_t *civ_diplomacy_system_create(void);
 void civ_diplomacy_system_destroy(civ_diplomacy_system_t *ds);
 void civ_diplomacy_system_init(civ_diplomacy_system_t *ds);
 
+/* Replace the relation table with neutral relations among nation_ids */
 void civ_diplomacy_system_initialize_relations(civ_diplomacy_system_t *ds,
                                                const char **nation_ids,
                                                size_t nation_count);
-civ_diplomatic_relation_t *
-civ_diplomacy_system_get_relation(civ_diplomacy_system_t *ds,
-                                  const char *nation_a, const char *nation_b);
+/* Index of a nation in the table, or -1 */
+int32_t civ_diplomacy_nation_index(const civ_diplomacy_system_t *ds,
+                                   const char *nation_id);
+/* Relation between two nations in either order; CIV_RELATION_NONE for a
+   nation with itself or one not in the table */
+civ_relation_id_t civ_diplomacy_relation_between(const civ_diplomacy_system_t *ds,
+                                                 int32_t a, int32_t b);
+civ_relation_id_t civ_diplomacy_relation_id(const civ_diplomacy_system_t *ds,
+                                            const char *nation_a,
+                                            const char *nation_b);
+/* Moves active relations one step; a relation at rest with no trade
+   agreement leaves the active set until something touches it again */
 void civ_diplomacy_system_update_relations(civ_diplomacy_system_t *ds,
                                            time_t current_date);
+/* Move the treaty clock by days game days, expiring what runs out */
+void civ_diplomacy_system_advance_treaties(civ_diplomacy_system_t *ds,
+                                           civ_float_t days);
+/* Game days until treaty index expires: 0 once it has, its duration_days
+   (<= 0) for one that never does */
+civ_float_t civ_diplomacy_treaty_days_left(const civ_diplomacy_system_t *ds,
+                                           size_t index);
+/* Queue a relation for updates after changing its columns directly */
+void civ_diplomacy_touch_relation(civ_diplomacy_system_t *ds,
+                                  civ_relation_id_t id);
+/* Active treaties of a type, kept as treaties are signed and expire */
+size_t civ_diplomacy_active_treaty_count(const civ_diplomacy_system_t *ds,
+                                         civ_treaty_type_t type);
+/* First active treaty on a relation, then treaties[i].next_in_pair; -1 ends */
+int32_t civ_diplomacy_pair_first_treaty(const civ_diplomacy_system_t *ds,
+                                        civ_relation_id_t id);
 civ_result_t civ_diplomacy_system_propose_treaty(civ_diplomacy_system_t *ds,
                                                  const char *proposer,
                                                  const char *recipient,
                                                  civ_treaty_type_t type,
                                                  int32_t duration_days);
 
+/* Nations joining and leaving the table. add_nation appends a nation with
+   neutral relations to all others and returns its index (the existing one
+   if already there), -1 when out of memory.
+
+   merge_nations folds from into into: into's relations take on weight
+   (from's share, 0-1) of from's trust and opinion, the worse of the two
+   levels and both sets of grievances; from's treaties with third nations
+   are re-signed by into, and those between the two lapse. from stays in
+   the table at rest. copy_relations gives to from's standing with every
+   other nation, for a secession; the pair itself is left to the caller. */
+typedef struct {
+  size_t rewritten; /* treaties now signed by the surviving nation */
+  size_t dissolved; /* treaties between the two, ended */
+} civ_diplomacy_merge_t;
+
+int32_t civ_diplomacy_add_nation(civ_diplomacy_system_t *ds,
+                                 const char *nation_id);
+civ_result_t civ_diplomacy_merge_nations(civ_diplomacy_system_t *ds,
+                                         const char *into, const char *from,
+                                         civ_float_t weight,
+                                         civ_diplomacy_merge_t *out);
+void civ_diplomacy_copy_relations(civ_diplomacy_system_t *ds, const char *from,
+                                  const char *to);
+
 /* Conflict & Justification */
-void civ_diplomacy_add_grievance(civ_diplomatic_relation_t *rel,
-                                 civ_float_t amount, const char *reason);
-bool civ_diplomacy_has_legitimate_war_goal(
-    const civ_diplomatic_relation_t *rel);
+void civ_diplomacy_add_grievance(civ_diplomacy_system_t *ds,
+                                 civ_relation_id_t id, civ_float_t amount,
+                                 const char *reason);
+bool civ_diplomacy_has_legitimate_war_goal(const civ_diplomacy_system_t *ds,
+                                           civ_relation_id_t id);
+/* Primary casus belli of a relation; "" when there is none */
+const char *civ_diplomacy_casus_belli(const civ_diplomacy_system_t *ds,
+                                      civ_relation_id_t id);
+
+/* Save section: relations and treaties; loading replaces both.
+   v2: nation table plus relation columns (v1 stored directed records)
+   v3: treaties keep their remaining days */
+#define CIV_DIPLOMACY_SAVE_VERSION 3
+civ_serializable_t civ_diplomacy_system_serializable(civ_diplomacy_system_t *ds);
 
 #endif /* CIVILIZATION_RELATIONS_H */
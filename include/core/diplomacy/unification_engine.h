@@ -8,7 +8,10 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include "../world/map_generator.h"
+#include "../world/nation.h"
 #include "international_organizations.h"
+#include "relations.h"
 
 /* Unification Stage */
 typedef enum {
@@ -26,14 +29,55 @@ typedef struct {
   bool success;
 } civ_merge_result_t;
 
-/* Functions */
-civ_merge_result_t civ_unification_propose_merger(const char *nation_a,
-                                                  const char *nation_b,
-                                                  civ_unification_stage_t goal);
-civ_result_t civ_unification_merge_economies(const char *nation_a,
-                                             const char *nation_b);
-civ_result_t civ_unification_create_shared_currency(const char *name,
-                                                    const char *nation_a,
-                                                    const char *nation_b);
+/* One merge or secession, as a single change for listeners that would
+   rather not follow it tile by tile */
+typedef struct {
+  int nation;             /* the surviving or the new nation */
+  int other;              /* the absorbed nation, or the parent */
+  int32_t tiles;
+  int64_t population;
+  int32_t min_x, min_y, max_x, max_y; /* tiles moved; min > max when none */
+  size_t treaties_rewritten;
+  size_t treaties_dissolved;
+  uint32_t political_revision; /* the nation manager's, after the change */
+} civ_unification_change_t;
+
+/* Fold nation from into nation into: territory, subdivisions, people and
+   economy through the nation manager, relations and treaties through the
+   diplomacy system (may be NULL). Work is in the two nations' tiles and
+   relations; from keeps its index, marked defunct. Nothing changes when
+   the pair is refused. */
+civ_result_t civ_unification_merge_nations(civ_nation_manager_t *nations,
+                                           civ_map_t *map,
+                                           civ_diplomacy_system_t *diplomacy,
+                                           int into, int from,
+                                           civ_unification_change_t *out);
+/* Split the subdivisions in subdivision_mask (bit per subdivision) off
+   from as a new nation id, which takes from's relations with everyone
+   else and level (civ_relation_level_t) with from. The new nation's
+   index, or -1 when refused. */
+int civ_unification_split_nation(civ_nation_manager_t *nations, civ_map_t *map,
+                                 civ_diplomacy_system_t *diplomacy, int from,
+                                 uint32_t subdivision_mask, const char *id,
+                                 const char *name, uint32_t color, int level,
+                                 civ_unification_change_t *out);
+
+/* Negotiated unions, one stage at a time. Market integration signs an
+   open-ended trade agreement; a currency union brings both nations' price
+   levels to their population-weighted mean; a federation or an absorption
+   folds from into into through civ_unification_merge_nations. Each stage
+   needs a friendlier, more trusting relation than the one before, and
+   out (may be NULL) is filled only by the last two. */
+civ_merge_result_t civ_unification_propose_merger(civ_nation_manager_t *nations,
+                                                  civ_map_t *map,
+                                                  civ_diplomacy_system_t *diplomacy,
+                                                  int into, int from,
+                                                  civ_unification_stage_t goal,
+                                                  civ_unification_change_t *out);
+civ_result_t civ_unification_merge_economies(civ_nation_manager_t *nations,
+                                             civ_diplomacy_system_t *diplomacy,
+                                             int a, int b);
+civ_result_t civ_unification_create_shared_currency(civ_nation_manager_t *nations,
+                                                    const char *name, int a, int b);
 
 #endif /* CIVILIZATION_UNIFICATION_ENGINE_H */
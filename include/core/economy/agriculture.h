@@ -23,6 +23,9 @@ typedef struct {
   civ_float_t fertilizer_tech;       /* technology multiplier */
   civ_season_t season;
   civ_float_t season_progress;       /* 0.0-1.0 through current season */
+  civ_float_t climate_yield;         /* this month's growing multiplier, 0.0-1.0 */
+  int         lean_months;           /* of the year, under the climate */
+  bool        has_climate;           /* else the flat season table */
 } civ_agriculture_system_t;
 
 civ_agriculture_system_t *civ_agriculture_create(void);
@@ -31,6 +34,11 @@ void civ_agriculture_update(civ_agriculture_system_t *a, civ_float_t time_delta,
                             civ_float_t population, civ_float_t geography_arable_area,
                             civ_float_t tech_level, civ_float_t climate_modifier);
 
+/* Seasonal growing for the land from the climate tables, replacing the
+   flat season table; lean_months (0-12) raise the famine risk */
+void civ_agriculture_set_climate(civ_agriculture_system_t *a, civ_float_t yield,
+                                 int lean_months);
+
 civ_float_t civ_agriculture_food_security(const civ_agriculture_system_t *a);
 bool civ_agriculture_is_famine(const civ_agriculture_system_t *a);
 civ_float_t civ_agriculture_surplus_export_capacity(const civ_agriculture_system_t *a);
@@ -4,6 +4,14 @@
  *
  * All rates and thresholds respond to inflation, GDP growth, and government
  * policy. No hardcoded "gold standard" — the banking system evolves with the economy.
+ *
+ * Bulk lending is pooled into cohorts, one per (risk tier, vintage, term):
+ * loans issued in one lending cycle share its rate, so a cohort amortizes
+ * as one annuity in closed form and draws its defaults as one binomial
+ * count. Each update is one monthly cycle and costs one step per live
+ * cohort, whatever the number of loans. Individual loans remain for the
+ * few the player follows one by one. Repaid and defaulted loans and
+ * cohorts are compacted away at the update that closes them.
  */
 #ifndef CIV_ECONOMY_BANKING_H
 #define CIV_ECONOMY_BANKING_H
@@ -32,8 +40,23 @@ typedef struct {
   int        months_remaining;
   civ_loan_risk_t risk_tier;
   bool       performing;           /* false = in default */
+  uint32_t   serial;               /* issue order; keys its default draws */
 } civ_loan_t;
 
+/* Loans of one risk tier, vintage and term, held as one amortizing pool */
+typedef struct {
+  civ_loan_risk_t risk_tier;
+  int32_t     vintage;            /* lending cycle the loans were issued in */
+  int         term_months;
+  int         months_elapsed;
+  int32_t     performing;         /* loans still paying */
+  int32_t     defaulted;          /* loans written off so far */
+  civ_float_t interest_rate;      /* APR, the vintage's rate for the tier */
+  civ_float_t principal;          /* issued principal of the performing loans */
+  civ_float_t balance;            /* outstanding on the performing loans */
+  civ_float_t monthly_payment;    /* owed by the performing loans together */
+} civ_loan_cohort_t;
+
 /* Central bank / national reserve */
 typedef struct {
   civ_float_t reserve_ratio;       /* fraction of deposits held in reserve */
@@ -42,9 +65,15 @@ typedef struct {
   civ_float_t reserve_holdings;    /* total reserves on hand */
   civ_float_t lending_volume;      /* outstanding loan principal */
   civ_float_t default_rate;        /* fraction of loans in default */
-  civ_loan_t *loans;               /* dynamic array */
+  civ_loan_t *loans;               /* individually tracked loans */
   int         loan_count;
   int         loan_capacity;
+  civ_loan_cohort_t *cohorts;      /* pooled loans, oldest vintage first */
+  int         cohort_count;
+  int         cohort_capacity;
+  int32_t     cycle;               /* lending cycles (updates) so far */
+  uint32_t    loans_issued;        /* individual loans ever, for serials */
+  uint64_t    rng_seed;            /* world seed for the default draws */
   civ_float_t credit_multiplier;   /* money creation factor */
 } civ_banking_system_t;
 
@@ -61,10 +90,16 @@ void civ_banking_update(civ_banking_system_t *b,
                         civ_float_t government_spending_ratio);
 
 /* --- Lending --- */
+/* Individually tracked loan; the pointer is valid until the next repayment
+   cycle, which may compact the array */
 civ_loan_t *civ_banking_issue_loan(civ_banking_system_t *b,
                                    const char *borrower_id,
                                    civ_float_t amount,
                                    int term_months);
+/* Pooled loan, added to its cohort; false for a bad amount or term */
+bool        civ_banking_lend(civ_banking_system_t *b, civ_float_t amount,
+                             int term_months);
+/* One monthly cycle: defaults, payments, and compaction of closed loans */
 void        civ_banking_repay_loans(civ_banking_system_t *b, civ_float_t time_delta);
 civ_float_t civ_banking_credit_available(const civ_banking_system_t *b);
 
@@ -1,6 +1,14 @@
 /**
  * @file commodity_markets.h
  * @brief Commodity markets — resource supply, demand, and regional pricing
+ *
+ * Each turn every region (one per nation) submits a supply and a demand
+ * curve per commodity, and the market clears all of them at once. Regions
+ * trade through one hub per commodity: a region ships out when its own
+ * clearing price is below the hub price less its transport cost, ships in
+ * when it is above the hub price plus that cost, and otherwise stays
+ * autarkic. The solver finds the hub prices at which shipments balance,
+ * starting from last turn's prices.
  */
 
 #ifndef CIV_ECONOMY_COMMODITY_MARKETS_H
@@ -33,10 +41,43 @@ typedef struct {
   char resource_id[STRING_SHORT_LEN];
   civ_float_t local_supply;
   civ_float_t local_demand;
-  civ_float_t current_price;
+  civ_float_t current_price;   /* hub price after the last clearing */
   civ_float_t stockpile;
+  civ_float_t base_value;      /* reference price the curves are quoted at */
 } civ_regional_resource_t;
 
+/* Curves are isoelastic around the reference price:
+   supply(p) = supply * (p / ref)^supply_elasticity, demand likewise with
+   -demand_elasticity. Region-major grid, index region * commodity_count +
+   commodity, so the solver's inner loops run over commodities. */
+typedef struct {
+  size_t       region_count;
+  size_t       commodity_count;
+  civ_float_t *block;              /* every array below, one allocation */
+
+  /* Per market, submitted each turn */
+  civ_float_t *supply;             /* quantity offered at the reference price */
+  civ_float_t *demand;             /* quantity wanted at the reference price */
+  civ_float_t *supply_elasticity;  /* quantity-weighted while submitting */
+  civ_float_t *demand_elasticity;
+
+  /* Per market, results */
+  civ_float_t *price;              /* local clearing price */
+  civ_float_t *net_export;         /* > 0 ships out, < 0 ships in */
+  civ_float_t *autarky;            /* price that clears the region alone */
+
+  /* Per region: cost to move one unit to or from the hub, as a fraction
+     of the reference price */
+  civ_float_t *transport;
+
+  /* Per commodity solver scratch */
+  civ_float_t *volume;             /* submitted supply + demand */
+  civ_float_t *excess;
+  civ_float_t *slope;
+  civ_float_t *low;
+  civ_float_t *high;
+} civ_commodity_grid_t;
+
 /* Commodity Market */
 typedef struct {
   civ_regional_resource_t *resources;
@@ -45,8 +86,14 @@ typedef struct {
 
   civ_float_t total_trade_volume;
   civ_float_t global_price_index;
+
+  civ_commodity_grid_t grid;
+  int last_iterations;             /* solver iterations at the last clearing */
 } civ_commodity_market_t;
 
+#define CIV_CLEARING_MAX_ITERATIONS 16
+#define CIV_CLEARING_TOLERANCE      1e-4  /* of traded volume */
+
 /* Functions */
 civ_commodity_market_t *civ_resource_market_create(void);
 void civ_resource_market_destroy(civ_commodity_market_t *market);
@@ -56,6 +103,24 @@ civ_result_t civ_resource_register(civ_commodity_market_t *market,
                                    civ_resource_category_t cat);
 void civ_resource_update_price(civ_regional_resource_t *res,
                                civ_float_t global_index);
+
+/* Size the grid to region_count regions and the registered commodities */
+civ_result_t civ_resource_market_set_regions(civ_commodity_market_t *market,
+                                             size_t region_count);
+void civ_resource_market_set_transport(civ_commodity_market_t *market,
+                                       size_t region, civ_float_t cost);
+
+/* Clear last turn's curves, then add each region's curves; several
+   submissions for one market add up */
+void civ_resource_market_begin_turn(civ_commodity_market_t *market);
+void civ_resource_market_submit(civ_commodity_market_t *market, size_t region,
+                                size_t commodity, civ_float_t supply,
+                                civ_float_t demand,
+                                civ_float_t supply_elasticity,
+                                civ_float_t demand_elasticity);
+
+/* Clear every commodity across all regions. Without regions, prices
+   follow each resource's own supply and demand. */
 void civ_resource_market_update_all(civ_commodity_market_t *market);
 
 #endif /* CIVILIZATION_RESOURCE_MARKET_H */
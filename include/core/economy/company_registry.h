@@ -0,0 +1,115 @@
+/**
+ * @file company_registry.h
+ * @brief Every firm in the world, as SoA arrays with nation and industry indexes
+ *
+ * Companies are dense ids into parallel arrays: the update walks the number
+ * fields below as flat float loops and never touches names. Nations and
+ * industries are interned symbols; each one keeps the list of its firms,
+ * so a screen showing one nation or one sector reads only those ids.
+ * Firms are never removed, so ids and list order are stable.
+ */
+#ifndef CIV_ECONOMY_COMPANY_REGISTRY_H
+#define CIV_ECONOMY_COMPANY_REGISTRY_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include "../../utils/symbol.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CIV_COMPANY_NAME 48
+
+/* Per-firm numbers: X(name, default) */
+#define CIV_COMPANY_FIELDS(X)                                                  \
+  X(employees, 0.0f)                                                           \
+  X(revenue, 0.0f)            /* per turn, reference currency */               \
+  X(productivity, 0.0f)       /* revenue per employee it staffs for */         \
+  X(stock_price, 0.0f)        /* 0 for private firms */                        \
+  X(growth_rate, 0.0f)        /* annualized */                                 \
+  X(trend, 0.0f)              /* growth above the market it reverts to */
+
+/* Firm ids of one nation or one industry, in registration order */
+typedef struct {
+  uint32_t *ids;
+  uint32_t  count;
+  uint32_t  capacity;
+} civ_company_list_t;
+
+/* Symbol -> list, for one of the two keys */
+typedef struct {
+  int32_t            *slot_of;      /* by symbol handle; -1 = no firms */
+  uint32_t            slot_of_size;
+  civ_symbol_t       *keys;         /* by slot */
+  civ_company_list_t *lists;        /* by slot */
+  uint32_t            count;
+  uint32_t            capacity;
+} civ_company_index_t;
+
+typedef struct {
+  uint32_t count;
+  uint32_t capacity;
+
+#define CIV_COMPANY_FIELD_DECL(name, init) float *name;
+  CIV_COMPANY_FIELDS(CIV_COMPANY_FIELD_DECL)
+#undef CIV_COMPANY_FIELD_DECL
+
+  civ_symbol_t *nation;
+  civ_symbol_t *industry;
+  uint8_t      *is_public;
+  char        (*name)[CIV_COMPANY_NAME];
+
+  civ_company_index_t by_nation;
+  civ_company_index_t by_industry;
+} civ_company_registry_t;
+
+/* One firm copied out for display */
+typedef struct {
+  const char *name;
+  const char *industry;
+  const char *nation_id;
+  int32_t     employees;
+  float       revenue;
+  float       stock_price;
+  bool        is_public;
+  float       growth_rate;
+} civ_company_t;
+
+void civ_company_registry_init(civ_company_registry_t *r);
+void civ_company_registry_free(civ_company_registry_t *r);
+
+/* Id of the new firm, or -1 when out of memory */
+int32_t civ_company_registry_add(civ_company_registry_t *r, const char *name,
+                                 const char *nation_id, const char *industry,
+                                 int32_t employees, float revenue,
+                                 float stock_price, float growth_rate);
+
+bool civ_company_registry_get(const civ_company_registry_t *r, uint32_t id,
+                              civ_company_t *out);
+
+/* Firms of a nation or an industry; NULL when it has none */
+const civ_company_list_t *civ_company_registry_nation(
+    const civ_company_registry_t *r, civ_symbol_t nation);
+const civ_company_list_t *civ_company_registry_industry(
+    const civ_company_registry_t *r, civ_symbol_t industry);
+
+/* Headcount and revenue of one nation's firms */
+void civ_company_registry_nation_totals(const civ_company_registry_t *r,
+                                        civ_symbol_t nation, float *employees,
+                                        float *revenue);
+
+/**
+ * One monthly turn for every firm: growth reverts to the firm's trend plus
+ * market_growth (annualized, e.g. world GDP growth) with a random shock,
+ * revenue compounds by a month of it, staff follow revenue and listed
+ * prices move with it. Draws from the bound RNG.
+ */
+void civ_company_registry_update(civ_company_registry_t *r, float market_growth);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,94 @@
+/**
+ * @file econ_reduce.h
+ * @brief Reproducible sums for the economy pipeline
+ *
+ * Every economy total goes through civ_econ_sum_t. Parallel sums split the
+ * input into blocks whose bounds depend only on the element count, and
+ * merge the block partials in block order, so the result never depends on
+ * the worker count or on which thread ran which block.
+ *
+ * That alone leaves a float sum at the mercy of the compiler: -ffast-math
+ * and FMA contraction may reassociate it differently per build or -march.
+ * Built with CIV_DETERMINISTIC_ECONOMY=1 (make DETERMINISTIC=1), each value
+ * is rounded once to fixed point with CIV_ECON_FIXED_FRAC_BITS fractional
+ * bits and summed as an integer. Integer addition is associative, so totals
+ * are bit-identical across builds, thread counts and vector widths, as
+ * replays and lockstep multiplayer need. Each value is clamped to
+ * ±CIV_ECON_FIXED_LIMIT before it is added.
+ */
+#ifndef CIV_ECONOMY_ECON_REDUCE_H
+#define CIV_ECONOMY_ECON_REDUCE_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include <math.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct civ_worker_pool;
+
+#ifndef CIV_DETERMINISTIC_ECONOMY
+#define CIV_DETERMINISTIC_ECONOMY 0
+#endif
+
+#define CIV_ECON_FIXED_FRAC_BITS 24  /* ±5.5e11 in steps of 6e-8 */
+#define CIV_ECON_FIXED_ONE       ((double)(1LL << CIV_ECON_FIXED_FRAC_BITS))
+#define CIV_ECON_FIXED_LIMIT     4.0e11  /* per value; leaves headroom to add */
+
+typedef struct {
+#if CIV_DETERMINISTIC_ECONOMY
+  int64_t q;
+#else
+  double sum;
+#endif
+} civ_econ_sum_t;
+
+#define CIV_ECON_SUM_ZERO ((civ_econ_sum_t){0})
+
+static inline void civ_econ_sum_add(civ_econ_sum_t *s, double v) {
+#if CIV_DETERMINISTIC_ECONOMY
+  if (v != v) return;  /* llrint of NaN is undefined; drop it */
+  v = CLAMP(v, -CIV_ECON_FIXED_LIMIT, CIV_ECON_FIXED_LIMIT);
+  s->q += (int64_t)llrint(v * CIV_ECON_FIXED_ONE);
+#else
+  s->sum += v;
+#endif
+}
+
+static inline void civ_econ_sum_merge(civ_econ_sum_t *s, const civ_econ_sum_t *o) {
+#if CIV_DETERMINISTIC_ECONOMY
+  s->q += o->q;
+#else
+  s->sum += o->sum;
+#endif
+}
+
+static inline double civ_econ_sum_value(const civ_econ_sum_t *s) {
+#if CIV_DETERMINISTIC_ECONOMY
+  return (double)s->q / CIV_ECON_FIXED_ONE;
+#else
+  return s->sum;
+#endif
+}
+
+/* Sum of values[0..count) across the pool; inline if pool is NULL */
+double civ_econ_parallel_sum(struct civ_worker_pool *pool, const float *values,
+                             size_t count);
+
+/* Sum of values[i] * weights[i] */
+double civ_econ_parallel_dot(struct civ_worker_pool *pool, const float *values,
+                             const float *weights, size_t count);
+
+/* Sum of value(ctx, i) for i in [0, count); value must be safe to call
+   from any thread */
+typedef double (*civ_econ_value_fn_t)(void *ctx, size_t index);
+double civ_econ_parallel_sum_fn(struct civ_worker_pool *pool, size_t count,
+                                civ_econ_value_fn_t value, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
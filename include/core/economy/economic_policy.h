@@ -54,6 +54,7 @@ typedef struct {
   civ_float_t              consumer_confidence; /* 0.0-1.0 */
   civ_float_t              business_confidence; /* 0.0-1.0 */
   civ_float_t              economic_freedom_index; /* composite */
+  uint32_t                 revision; /* bumped whenever a lever is set */
 } civ_economic_policy_system_t;
 
 /* --- Lifecycle --- */
@@ -83,6 +84,9 @@ civ_float_t civ_economic_policy_subsidy_multiplier(const civ_economic_policy_sys
 civ_float_t civ_economic_policy_price_modifier(const civ_economic_policy_system_t *p,
                                                 const char *commodity);
 civ_float_t civ_economic_policy_growth_modifier(const civ_economic_policy_system_t *p);
+/* The part of the growth modifier set by enacted levers alone; changes only
+   with revision */
+civ_float_t civ_economic_policy_stance_modifier(const civ_economic_policy_system_t *p);
 civ_float_t civ_economic_policy_inequality_modifier(const civ_economic_policy_system_t *p);
 
 #endif /* CIV_ECONOMY_ECONOMIC_POLICY_H */
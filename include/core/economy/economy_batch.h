@@ -0,0 +1,197 @@
+/**
+ * @file economy_batch.h
+ * @brief Per-nation economy model, run over all nations as SoA batches
+ *
+ * The single-instance modules (macro_economy, labor_market, ... war_economy)
+ * model one economy for the player's screens. The batch runs the same chain
+ * of stages for every nation at once: each field below is one float array
+ * indexed by lane (nation), and each stage is one loop over all lanes that
+ * reads the arrays earlier stages wrote. Sub-entities the modules track one
+ * by one (infrastructure networks, factories, power plants, capital pools,
+ * contraband markets) are folded into one aggregate per nation; labor keeps
+ * its four wage tiers.
+ *
+ * Money is in millions, like civ_nation_economy_t; wages and house prices
+ * are per person. Callers fill the inputs before each update and read the
+ * outputs after it. State carries each lane from tick to tick and starts
+ * from the module defaults when the lane is added.
+ */
+#ifndef CIV_ECONOMY_BATCH_H
+#define CIV_ECONOMY_BATCH_H
+
+#include "../../common.h"
+#include "../../types.h"
+
+/* Filled by the caller every update: X(name, default) */
+#define CIV_ECONOMY_BATCH_INPUTS(X)                                            \
+  X(population, 1000000.0f)   /* people */                                     \
+  X(base_gdp, 0.0f)           /* territory GDP; 0 = lane has no land */        \
+  X(tech_level, 1.0f)                                                          \
+  X(education, 0.50f)                                                          \
+  X(gov_efficiency, 0.50f)                                                     \
+  X(corruption, 0.10f)                                                         \
+  X(arable_km2, 1000.0f)                                                       \
+  X(area_km2, 10000.0f)                                                        \
+  X(mineral_deposit, 0.0f)    /* extractable units in the territory */         \
+  X(mineral_richness, 0.70f)                                                   \
+  X(fuel_availability, 0.80f)                                                  \
+  X(at_war, 0.0f)             /* 1 while actively fighting */
+
+/* Carried between updates */
+#define CIV_ECONOMY_BATCH_STATE(X)                                             \
+  X(seeded, 0.0f)             /* size-dependent state set from the inputs */   \
+  /* macro_economy */                                                          \
+  X(tax_burden, 0.20f)                                                         \
+  X(spending_ratio, 0.30f)                                                     \
+  /* labor_market, one wage per tier */                                        \
+  X(wage_unskilled, 15000.0f)                                                  \
+  X(wage_skilled, 28000.0f)                                                    \
+  X(wage_professional, 55000.0f)                                               \
+  X(wage_executive, 120000.0f)                                                 \
+  /* economic_policy */                                                        \
+  X(regulation, 2.0f)         /* civ_regulation_level_t */                     \
+  X(consumer_conf, 0.65f)                                                      \
+  X(business_conf, 0.60f)                                                      \
+  X(econ_freedom, 0.70f)                                                       \
+  /* taxation */                                                               \
+  X(corporate_tax_rate, 0.20f)                                                 \
+  X(sales_tax_rate, 0.05f)                                                     \
+  X(tax_efficiency, 0.85f)                                                     \
+  /* budget */                                                                 \
+  X(deficit_spending, 0.0f)   /* spending beyond revenue, share of GDP */      \
+  X(national_debt, 0.0f)                                                       \
+  X(debt_rate, 0.03f)                                                          \
+  X(credit_rating, 0.80f)                                                      \
+  X(debt_to_gdp, 0.0f)                                                         \
+  /* banking */                                                                \
+  X(policy_rate, 0.04f)                                                        \
+  X(reserve_ratio, 0.10f)                                                      \
+  X(money_supply, 0.0f)                                                        \
+  /* agriculture */                                                            \
+  X(season, 1.0f)             /* civ_season_t, spring */                       \
+  X(season_progress, 0.0f)                                                     \
+  X(soil_fertility, 0.65f)                                                     \
+  X(irrigation, 0.10f)                                                         \
+  /* extraction */                                                             \
+  X(mineral_depletion, 0.0f)  /* fraction of the deposit already mined */      \
+  X(sustainability, 0.80f)                                                     \
+  /* infrastructure, all networks share one budget so they move together */   \
+  X(infra_coverage, 0.30f)                                                     \
+  X(infra_condition, 0.70f)                                                    \
+  /* manufacturing */                                                          \
+  X(automation, 0.15f)                                                         \
+  X(mfg_supply_chain, 0.60f)                                                   \
+  /* energy */                                                                 \
+  X(energy_capacity, 0.0f)    /* MW */                                         \
+  X(renewable_share, 0.20f)                                                    \
+  X(plant_efficiency, 0.60f)                                                   \
+  X(grid_reliability, 0.85f)                                                   \
+  X(energy_price, 50.0f)                                                       \
+  /* housing */                                                                \
+  X(housing_units, 0.0f)                                                       \
+  X(price_to_income, 5.5f)                                                     \
+  X(homeownership, 0.65f)                                                      \
+  X(urbanization, 0.55f)                                                       \
+  /* land_use, shares of area */                                               \
+  X(share_undeveloped, 0.70f)                                                  \
+  X(share_residential, 0.05f)                                                  \
+  X(share_commercial, 0.02f)                                                   \
+  X(share_industrial, 0.02f)                                                   \
+  /* capital_assets */                                                         \
+  X(capital_stock, 0.0f)                                                       \
+  /* domestic_trade */                                                         \
+  X(market_integration, 0.50f)                                                 \
+  /* black_market */                                                           \
+  X(illicit_volume, 0.0f)                                                      \
+  /* war_economy */                                                            \
+  X(military_spending_ratio, 0.02f)                                            \
+  X(civilian_penalty, 0.0f)                                                    \
+  X(war_conversion, 0.0f)                                                      \
+  X(rationing, 0.0f)                                                           \
+  X(conscription, 0.0f)                                                        \
+  X(war_exhaustion, 0.0f)                                                      \
+  X(materiel_stockpile, 1000.0f)
+
+/* Written by every update */
+#define CIV_ECONOMY_BATCH_OUTPUTS(X)                                           \
+  X(gdp, 0.0f)                                                                 \
+  X(gdp_per_capita, 0.0f)                                                      \
+  X(gdp_growth, 0.0f)                                                          \
+  X(inflation, 0.0f)                                                           \
+  X(unemployment, 0.0f)                                                        \
+  X(workforce, 0.0f)                                                           \
+  X(labor_avail, 0.0f)                                                         \
+  X(avg_wage, 0.0f)                                                            \
+  X(regulation_level, 0.0f)                                                    \
+  X(tax_revenue, 0.0f)                                                         \
+  X(expenditure, 0.0f)                                                         \
+  X(deficit, 0.0f)                                                             \
+  X(fiscal_health, 0.0f)                                                       \
+  X(infra_budget, 0.0f)                                                        \
+  X(savings_rate, 0.0f)                                                        \
+  X(interest_rate, 0.0f)      /* banking rate, else budget borrowing rate */   \
+  X(food_production, 0.0f)    /* kcal per year */                              \
+  X(food_consumption, 0.0f)                                                    \
+  X(famine_risk, 0.0f)                                                         \
+  X(raw_materials, 0.0f)                                                       \
+  X(infra_quality, 0.0f)                                                       \
+  X(supply_chain, 0.0f)                                                        \
+  X(industrial_output, 0.0f)                                                   \
+  X(energy_demand, 0.0f)      /* MW */                                         \
+  X(energy_output, 0.0f)      /* MW */                                         \
+  X(blackout, 0.0f)                                                            \
+  X(land_value_index, 0.0f)                                                    \
+  X(productivity, 0.0f)       /* capital multiplier on output */               \
+  X(domestic_volume, 0.0f)                                                     \
+  X(innovation_index, 0.0f)                                                    \
+  X(illicit_share, 0.0f)      /* illicit economy / GDP */                      \
+  X(criminal_violence, 0.0f)
+
+typedef struct civ_economy_batch {
+  size_t count;
+  size_t capacity;
+  float *block;               /* every array below, one allocation */
+  float time_delta;           /* of the last update */
+#define CIV_ECONOMY_BATCH_MEMBER(name, init) float *name;
+  CIV_ECONOMY_BATCH_INPUTS(CIV_ECONOMY_BATCH_MEMBER)
+  CIV_ECONOMY_BATCH_STATE(CIV_ECONOMY_BATCH_MEMBER)
+  CIV_ECONOMY_BATCH_OUTPUTS(CIV_ECONOMY_BATCH_MEMBER)
+#undef CIV_ECONOMY_BATCH_MEMBER
+} civ_economy_batch_t;
+
+civ_economy_batch_t *civ_economy_batch_create(void);
+void civ_economy_batch_destroy(civ_economy_batch_t *b);
+
+/* Set the lane count; lanes beyond the previous count start from defaults */
+bool civ_economy_batch_resize(civ_economy_batch_t *b, size_t count);
+
+/* Run every stage, in data-flow order, over all lanes */
+void civ_economy_batch_update(civ_economy_batch_t *b, civ_float_t time_delta);
+
+/* One lane by value: every field, plus the tick length it was running at.
+   Plain floats, so a snapshot copies with = and forks without allocating. */
+typedef struct {
+#define CIV_ECONOMY_SNAPSHOT_MEMBER(name, init) float name;
+  CIV_ECONOMY_BATCH_INPUTS(CIV_ECONOMY_SNAPSHOT_MEMBER)
+  CIV_ECONOMY_BATCH_STATE(CIV_ECONOMY_SNAPSHOT_MEMBER)
+  CIV_ECONOMY_BATCH_OUTPUTS(CIV_ECONOMY_SNAPSHOT_MEMBER)
+#undef CIV_ECONOMY_SNAPSHOT_MEMBER
+  float time_delta;
+} civ_economy_snapshot_t;
+
+bool civ_economy_batch_snapshot(const civ_economy_batch_t *b, size_t lane,
+                                civ_economy_snapshot_t *out);
+bool civ_economy_batch_load(civ_economy_batch_t *b, size_t lane,
+                            const civ_economy_snapshot_t *snapshot);
+
+/* One economy out of two: stocks (debt, money, capital, housing, plant,
+   stockpiles) add, every other state field moves toward from's by weight
+   (from's share of the people), and from goes back to the defaults */
+bool civ_economy_batch_merge_lanes(civ_economy_batch_t *b, size_t into,
+                                   size_t from, float weight);
+/* to starts as a copy of from holding share of its stocks, which from
+   gives up; rates and levels carry over whole */
+bool civ_economy_batch_split_lane(civ_economy_batch_t *b, size_t from,
+                                  size_t to, float share);
+
+#endif
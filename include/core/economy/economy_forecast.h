@@ -0,0 +1,67 @@
+/**
+ * @file economy_forecast.h
+ * @brief What-if projections of one nation's economy from a snapshot
+ *
+ * A forecast replays the economy batch's stages on a copy of a lane, so
+ * it never touches live state: the same snapshot can be projected under
+ * any number of policy changes. civ_economy_forecast_many runs a set of
+ * changes as lanes of small batches spread over the worker pool, which is
+ * how the AI weighs its fiscal options and the screens show projections.
+ */
+#ifndef CIV_ECONOMY_FORECAST_H
+#define CIV_ECONOMY_FORECAST_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include "economy_batch.h"
+
+struct civ_worker_pool;
+
+#define CIV_ECONOMY_FORECAST_MAX_TURNS 64
+
+/* Added to the snapshot's levers before the first turn; the results are
+   clamped to each lever's range */
+typedef struct {
+  float corporate_tax_rate;
+  float sales_tax_rate;
+  float deficit_spending;     /* share of GDP */
+  float regulation;           /* civ_regulation_level_t steps */
+} civ_economy_policy_delta_t;
+
+typedef struct {
+  int turns;
+  float gdp[CIV_ECONOMY_FORECAST_MAX_TURNS];
+  float tax_revenue[CIV_ECONOMY_FORECAST_MAX_TURNS];
+  float deficit[CIV_ECONOMY_FORECAST_MAX_TURNS];
+  float national_debt[CIV_ECONOMY_FORECAST_MAX_TURNS];
+  float unemployment[CIV_ECONOMY_FORECAST_MAX_TURNS];
+  civ_economy_snapshot_t final;  /* state after the last turn */
+} civ_economy_projection_t;
+
+/* The snapshot's levers with delta applied, as a forecast would start */
+civ_economy_snapshot_t civ_economy_apply_policy(
+    const civ_economy_snapshot_t *snapshot,
+    const civ_economy_policy_delta_t *delta);
+
+/**
+ * Project snapshot forward turns updates (at most
+ * CIV_ECONOMY_FORECAST_MAX_TURNS) under delta, which may be NULL for
+ * current policy. Reads only its arguments, so any thread may call it.
+ */
+bool civ_economy_simulate(const civ_economy_snapshot_t *snapshot,
+                          const civ_economy_policy_delta_t *delta, int turns,
+                          civ_economy_projection_t *out);
+
+/* out[i] is the projection under deltas[i]; runs inline if pool is NULL */
+bool civ_economy_forecast_many(struct civ_worker_pool *pool,
+                               const civ_economy_snapshot_t *snapshot,
+                               const civ_economy_policy_delta_t *deltas,
+                               int count, int turns,
+                               civ_economy_projection_t *out);
+
+/* Higher is better: growth and fiscal health over the projection, less
+   unemployment and debt beyond 60% of GDP */
+float civ_economy_projection_score(const civ_economy_snapshot_t *start,
+                                   const civ_economy_projection_t *p);
+
+#endif
@@ -1,6 +1,20 @@
 /**
  * @file energy.h
  * @brief Energy — fuel, electricity, power grid, energy independence
+ *
+ * Plants are dispatched in merit order. The grid keeps its plants sorted by
+ * marginal cost with the running sum of their available capacity, and
+ * rebuilds that curve only when a plant is added, a fuel price moves, or
+ * fuel supply or technology shifts the plants' output. Each update then
+ * finds the marginal plant with one binary search over the cumulative
+ * capacity: plants below it run flat out, it runs part-loaded, the rest sit
+ * idle, and its marginal cost is the clearing price. Demand the firm supply
+ * (available capacity times reliability) cannot meet is unserved; any at
+ * all is a blackout.
+ *
+ * Neighbouring grids can be cleared jointly with civ_energy_clear_interconnected,
+ * which ships power over the links from the cheaper grid to the dearer
+ * until their marginal costs meet or the link is full.
  */
 #ifndef CIV_ECONOMY_ENERGY_H
 #define CIV_ECONOMY_ENERGY_H
@@ -17,7 +31,7 @@ typedef struct {
   civ_float_t         capacity_mw;
   civ_float_t         current_output_mw;
   civ_float_t         efficiency;          /* 0.0-1.0 */
-  civ_float_t         cost_per_mwh;
+  civ_float_t         cost_per_mwh;        /* marginal, as of the last curve */
   civ_float_t         carbon_intensity;    /* emissions per MWh */
   bool                is_renewable;
 } civ_power_plant_t;
@@ -33,8 +47,42 @@ typedef struct {
   civ_float_t         energy_independence;  /* 0.0-1.0, fraction self-supplied */
   civ_float_t         renewable_fraction;
   bool                blackout;
+
+  /* Fuel price per MWh of heat, by source; 0 for renewables */
+  civ_float_t         fuel_price[CIV_ENERGY_TYPE_COUNT];
+
+  /* Merit-order curve: plant indices by marginal cost with the running
+     sum of their available output */
+  int                *merit;
+  civ_float_t        *merit_cum;
+  int                 merit_capacity;
+  int                 curve_count;     /* plants the curve covers */
+  uint32_t            plant_revision;  /* bumped on add and civ_energy_plants_changed */
+  uint32_t            fuel_revision;   /* bumped on civ_energy_set_fuel_price */
+  uint32_t            curve_plants, curve_fuel;
+  int32_t             curve_supply_q;  /* fuel availability, 1/256 steps */
+  int32_t             curve_tech_q;    /* tech level, 1/256 steps */
+  bool                curve_built;
+  bool                converging;      /* plant efficiencies still moving */
+  uint32_t            updates_since_curve;
+  uint64_t            curve_rebuilds;
+
+  /* Dispatch */
+  int                 marginal;        /* curve position of the marginal plant, -1 none */
+  civ_float_t         available_mw;    /* output the curve can deliver */
+  civ_float_t         served_mw;
+  civ_float_t         unserved_mw;
+  civ_float_t         clearing_price;  /* marginal cost at the served load */
+  civ_float_t         net_import_mw;   /* from civ_energy_clear_interconnected */
 } civ_energy_system_t;
 
+/* Interconnector between grids from and to, either direction */
+typedef struct {
+  int                 from, to;
+  civ_float_t         capacity_mw;
+  civ_float_t         flow_mw;         /* out: positive from -> to */
+} civ_energy_link_t;
+
 civ_energy_system_t *civ_energy_create(void);
 void civ_energy_destroy(civ_energy_system_t *e);
 void civ_energy_update(civ_energy_system_t *e, civ_float_t time_delta,
@@ -43,6 +91,30 @@ void civ_energy_update(civ_energy_system_t *e, civ_float_t time_delta,
 
 civ_power_plant_t *civ_energy_add_plant(civ_energy_system_t *e, civ_energy_source_t source,
                                         civ_float_t capacity, civ_float_t efficiency);
+/* Call after editing a plant returned by civ_energy_add_plant */
+void civ_energy_plants_changed(civ_energy_system_t *e);
+void civ_energy_set_fuel_price(civ_energy_system_t *e, civ_energy_source_t source,
+                               civ_float_t price);
+
+/**
+ * Dispatch the curve against demand_mw: one binary search for the marginal
+ * plant, outputs rewritten only for plants whose state changed.
+ * @return Load served, MW
+ */
+civ_float_t civ_energy_dispatch(civ_energy_system_t *e, civ_float_t demand_mw);
+/* Marginal cost of the plant that would serve load_mw; scarcity price past
+   the end of the curve */
+civ_float_t civ_energy_marginal_cost_at(const civ_energy_system_t *e, civ_float_t load_mw);
+
+/**
+ * Clear updated grids jointly. Each link carries power from the grid with the
+ * lower marginal cost to the higher until their costs meet or the link is
+ * full; links are swept a few rounds so flows settle across a chain. Each
+ * grid is then re-dispatched against its demand plus exports.
+ */
+void civ_energy_clear_interconnected(civ_energy_system_t **grids, int grid_count,
+                                     civ_energy_link_t *links, int link_count);
+
 civ_float_t civ_energy_surplus(const civ_energy_system_t *e);
 civ_float_t civ_energy_cost_burden(const civ_energy_system_t *e, civ_float_t gdp);
 
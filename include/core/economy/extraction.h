@@ -1,44 +1,86 @@
 /**
  * @file extraction.h
  * @brief Resource extraction — mining, logging, fishing, hunting, raw materials
+ *
+ * Every site stands on a tile. Mines are opened on resource map deposits,
+ * take their size from the deposit's quantity and their richness from its
+ * quality; surface sites (logging, fishing, hunting) have a flat richness.
+ * The per-cycle depletion math runs over the active sites only, kept as
+ * parallel arrays so the loop is a straight sweep. A site that runs below
+ * CIV_EXTRACT_EXHAUSTED is archived: swapped out of the active arrays,
+ * left in `sites` flagged depleted, its deposit zeroed on the resource map
+ * and its tile touched so the economic view and minimap rebake.
  */
 #ifndef CIV_ECONOMY_EXTRACTION_H
 #define CIV_ECONOMY_EXTRACTION_H
 
 #include "../../common.h"
 #include "../../types.h"
+#include "../world/map_generator.h"
+#include "../world/resource_map.h"
+
+#define CIV_EXTRACT_EXHAUSTED       1.0   /* remaining units that close a site */
+#define CIV_EXTRACT_UNITS_PER_QTY   10.0  /* site units per deposit quantity */
+#define CIV_EXTRACT_SURFACE_RICHNESS 0.70
+#define CIV_EXTRACT_NO_DEPOSIT      (-1)
 
 typedef enum { CIV_EXTRACT_MINING, CIV_EXTRACT_LOGGING, CIV_EXTRACT_FISHING,
                CIV_EXTRACT_HUNTING, CIV_EXTRACT_QUARRYING, CIV_EXTRACT_TYPE_COUNT } civ_extraction_type_t;
 
+/* Cold per-site record; live and archived sites alike */
 typedef struct {
   civ_extraction_type_t type;
   char                  resource[STRING_SHORT_LEN];
-  civ_float_t           deposit_size;       /* remaining resource */
-  civ_float_t           extraction_rate;    /* per cycle output */
-  civ_float_t           depletion_factor;   /* how fast it runs out */
-  civ_float_t           efficiency;         /* 0.0-1.0 */
+  uint32_t              tile;             /* y * map width + x */
+  int32_t               deposit_type;     /* civ_resource_type_t, or CIV_EXTRACT_NO_DEPOSIT */
+  int32_t               deposit;          /* index into the resource map's deposits[deposit_type] */
+  civ_float_t           initial_deposit;
+  civ_float_t           final_deposit;    /* remaining when archived */
+  int32_t               slot;             /* in the active arrays, -1 once archived */
   bool                  depleted;
 } civ_extraction_site_t;
 
+/* Active sites as parallel arrays, slot i of each is one site */
+typedef struct {
+  civ_float_t *deposit;     /* remaining resource */
+  civ_float_t *richness;
+  civ_float_t *rate;        /* last cycle's output */
+  int32_t     *site;        /* index into sites */
+  int          count;
+  int          capacity;
+} civ_extraction_active_t;
+
 typedef struct {
-  civ_extraction_site_t *sites;
-  int                    site_count;
-  int                    site_capacity;
-  civ_float_t            total_output;      /* aggregate raw material units */
-  civ_float_t            sustainability_index; /* 0.0-1.0 */
+  civ_extraction_site_t  *sites;
+  int                     site_count;
+  int                     site_capacity;
+  civ_extraction_active_t active;
+  uint8_t                *opened[CIV_RESOURCE_COUNT]; /* by deposit, a site exists */
+  uint16_t                opened_count[CIV_RESOURCE_COUNT];
+  int                     surveyed_tiles;    /* owner's land at the last survey */
+  civ_float_t             efficiency;        /* 0.0-1.0, from tech and labor */
+  civ_float_t             total_output;      /* aggregate raw material units */
+  civ_float_t             sustainability_index; /* 0.0-1.0 */
 } civ_extraction_system_t;
 
 civ_extraction_system_t *civ_extraction_create(void);
 void civ_extraction_destroy(civ_extraction_system_t *e);
+/* rm and map receive exhausted deposits; either may be NULL */
 void civ_extraction_update(civ_extraction_system_t *e, civ_float_t time_delta,
                            civ_float_t tech_level, civ_float_t labor_available,
-                           civ_float_t geography_mineral_richness);
+                           civ_resource_map_t *rm, civ_map_t *map);
 
+/* Open a surface site on tile; NULL when full */
 civ_extraction_site_t *civ_extraction_add_site(civ_extraction_system_t *e,
                                                civ_extraction_type_t type,
                                                const char *resource,
+                                               uint32_t tile,
                                                civ_float_t deposit_size);
+/* Open a mine on every deposit of rm inside owner's territory that has none
+   yet; returns how many were opened */
+int civ_extraction_open_deposits(civ_extraction_system_t *e,
+                                 const civ_resource_map_t *rm,
+                                 const civ_map_t *map, civ_owner_index_t owner);
 civ_float_t civ_extraction_output_for(const civ_extraction_system_t *e, civ_extraction_type_t type);
 civ_float_t civ_extraction_depletion_rate(const civ_extraction_system_t *e);
 
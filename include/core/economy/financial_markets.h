@@ -11,6 +11,8 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include "../data/price_history.h"
+#include "company_registry.h"
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -22,6 +24,8 @@ extern "C" {
 #define CIV_CURRENCY_CODE  4
 #define CIV_CURRENCY_NAME  48
 #define CIV_WALLET_SLOTS   8
+/* ISO codes of three capital letters, packed base 26 */
+#define CIV_CURRENCY_ISO_SLOTS (26 * 26 * 26)
 
 /* ── Currency ──────────────────────────────────────────────────── */
 typedef struct {
@@ -47,18 +51,6 @@ typedef struct {
 
 /* ── Wallet entry ───────────────────────────────────────────────── */
 
-/* ── Company ────────────────────────────────────────────────────── */
-#define CIV_COMPANY_MAX 64
-typedef struct {
-  char     name[48];
-  char     industry[32];
-  char     nation_id[32];
-  int32_t  employees;
-  float    revenue;
-  float    stock_price;
-  bool     is_public;
-  float    growth_rate;
-} civ_company_t;
 typedef struct {
   char   currency_iso[4];
   float  balance;          /* amount held in this currency */
@@ -75,10 +67,21 @@ typedef struct {
 typedef struct {
   civ_market_currency_t  currencies[CIV_CURRENCY_MAX];
   int             currency_count;
+
+  /* Lookup and conversion tables, rebuilt whenever rates move */
+  int16_t  iso_index[CIV_CURRENCY_ISO_SLOTS]; /* currency index + 1; 0 = none */
+  float    to_ref[CIV_CURRENCY_MAX];          /* 1 / current_rate */
+  float   *cross_rates;       /* [from * cross_rate_count + to] */
+  int      cross_rate_count;  /* currencies the matrix covers */
+  int      cross_rate_capacity;
   civ_commodity_t commodities[12];
-  civ_company_t    companies[CIV_COMPANY_MAX];
-  int              company_count;
+  civ_company_registry_t companies;
   int             commodity_count;
+
+  /* Price history per instrument, one sample per turn */
+  civ_price_history_t *currency_history;   /* grows with currency_count */
+  int                  currency_history_count;
+  civ_price_history_t  commodity_history[12];
 } civ_market_engine_t;
 
 /* ── API ────────────────────────────────────────────────────────── */
@@ -88,14 +91,25 @@ void                 civ_market_destroy(civ_market_engine_t *m);
 /* Advance one turn — fluctuate rates and prices */
 void civ_market_update(civ_market_engine_t *m);
 
+/* Sample every currency rate and commodity price for turn */
+void civ_market_record_history(civ_market_engine_t *m, int32_t turn);
+const civ_price_history_t *civ_market_currency_history(const civ_market_engine_t *m,
+                                                       int index);
+const civ_price_history_t *civ_market_commodity_history(const civ_market_engine_t *m,
+                                                        int index);
+
 /* Apply real production data to commodity prices and currency strength.
    Pass the global civ_nation_economy_t aggregate as void*. */
 void civ_market_apply_production(civ_market_engine_t *m,
                                   float global_gdp, float global_food,
                                   float global_energy, float global_industrial);
 
-/* Currency lookup */
+/* Currency lookup — an indexed load for registered A-Z codes */
+int civ_market_currency_index(const civ_market_engine_t *m, const char *iso);
 civ_market_currency_t *civ_market_get_currency(civ_market_engine_t *m, const char *iso);
+/* Rebuild the conversion tables; update, apply_production and
+   add_currency call it, so only code writing current_rate directly must */
+void civ_market_refresh_rates(civ_market_engine_t *m);
 float           civ_market_exchange(civ_market_engine_t *m,
                                     const char *from_iso, const char *to_iso,
                                     float amount);
@@ -112,7 +126,8 @@ bool civ_wallet_exchange(civ_wallet_t *w, civ_market_engine_t *m,
 /* Commodity */
 civ_commodity_t *civ_market_get_commodity(civ_market_engine_t *m, const char *name);
 void civ_market_generate_companies(civ_market_engine_t *m, const char *nation_id);
-civ_company_t *civ_market_get_company(civ_market_engine_t *m, int idx);
+bool civ_market_get_company(const civ_market_engine_t *m, int idx,
+                            civ_company_t *out);
 float civ_market_cost_of_living(civ_market_engine_t *m, const char *iso);
 
 /* Compute dynamic price scaled by cost of living and currency */
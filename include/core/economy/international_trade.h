@@ -9,6 +9,7 @@
 #include "../../common.h"
 #include "../../types.h"
 #include "currency.h"
+#include "trade_network.h"
 
 /* Trade Route */
 typedef struct {
@@ -24,6 +25,12 @@ typedef struct {
 
   bool active;
   time_t established_date;
+
+  /* Map routes travel the trade network between two settlement tiles */
+  bool on_map;
+  int32_t from_x, from_y, to_x, to_y;
+  int32_t network_route;        /* -1 until the network has both endpoints */
+  civ_float_t network_revenue;  /* from the network's last evaluation */
 } civ_trade_route_t;
 
 /* Trade Manager */
@@ -33,6 +40,7 @@ typedef struct {
   size_t route_capacity;
 
   civ_currency_manager_t *currency_manager; /* Reference */
+  civ_trade_network_t *network;             /* Reference, may be NULL */
 } civ_trade_manager_t;
 
 /* Functions */
@@ -44,10 +52,27 @@ civ_result_t civ_trade_establish_route(civ_trade_manager_t *manager,
                                        const char *source, const char *target,
                                        const char *resource,
                                        civ_float_t amount);
+/* A route between the settlements on two tiles, carried over the network */
+civ_result_t civ_trade_establish_map_route(civ_trade_manager_t *manager,
+                                           const char *source,
+                                           const char *target,
+                                           const char *resource,
+                                           civ_float_t amount, int32_t from_x,
+                                           int32_t from_y, int32_t to_x,
+                                           int32_t to_y);
 civ_result_t civ_trade_cancel_route(civ_trade_manager_t *manager,
                                     const char *route_id);
 
+/* Swap the network (map reload); map routes re-attach on the next update */
+void civ_trade_manager_set_network(civ_trade_manager_t *manager,
+                                   civ_trade_network_t *network);
+
+/* Drifts values and hands map routes to the network; run the network's
+   update after it and civ_trade_collect_network after that */
 void civ_trade_update(civ_trade_manager_t *manager, civ_float_t time_delta);
+void civ_trade_collect_network(civ_trade_manager_t *manager);
+
+/* Map routes report the network's batched evaluation */
 civ_float_t civ_trade_calculate_revenue(const civ_trade_route_t *route);
 
 #endif /* CIVILIZATION_TRADE_SYSTEM_H */
@@ -26,7 +26,7 @@ typedef struct {
   int                 total_employed;
   int                 total_unemployed;
   civ_float_t         overall_unemployment;
-  civ_float_t         labor_force_participation; /* 0.0-1.0 */
+  civ_float_t         labor_force_participation; /* 0.0-1.0 of ages 15-64 */
   civ_float_t         avg_wage_national;
   civ_float_t         wage_inequality;           /* gini-like 0.0-1.0 */
   civ_float_t         minimum_wage;
@@ -35,8 +35,10 @@ typedef struct {
 
 civ_labor_market_t *civ_labor_market_create(void);
 void civ_labor_market_destroy(civ_labor_market_t *l);
+/* The participating share of working_age_population (15-64) is the
+   workforce */
 void civ_labor_market_update(civ_labor_market_t *l, civ_float_t time_delta,
-                             int total_population, civ_float_t gdp,
+                             int working_age_population, civ_float_t gdp,
                              civ_float_t tech_level, civ_float_t education_level,
                              civ_float_t business_confidence);
 
@@ -4,6 +4,12 @@
  *
  * Tax burden affects population happiness, economic growth, and government
  * revenue. Collection efficiency depends on governance quality and corruption.
+ *
+ * Income tax is levied on an income distribution rather than on the mean:
+ * per-capita GDP is spread over CIV_TAX_INCOME_BUCKETS quantile buckets, and
+ * each bucket's tax is read off a cumulative per-bracket table that is
+ * rebuilt only when brackets or rates change. The Gini coefficient is
+ * measured on the buckets after tax, so progressive brackets lower it.
  */
 #ifndef CIV_ECONOMY_TAXATION_H
 #define CIV_ECONOMY_TAXATION_H
@@ -29,12 +35,23 @@ typedef struct {
   civ_float_t rate;            /* 0.0 - 1.0 */
 } civ_tax_bracket_t;
 
+/* Income distribution as equal-population quantile buckets */
+#define CIV_TAX_INCOME_BUCKETS 16
+
+typedef struct {
+  civ_float_t relative[CIV_TAX_INCOME_BUCKETS]; /* bucket income / mean, ascending */
+  civ_float_t dispersion;      /* log-normal sigma the buckets come from */
+  civ_float_t gini;            /* before tax, from the buckets */
+} civ_income_distribution_t;
+
 /* Single tax policy */
 typedef struct {
   civ_tax_type_t    type;
   bool              active;
   civ_float_t       flat_rate;          /* for non-progressive types */
   civ_tax_bracket_t *brackets;         /* dynamic array for income/corporate */
+  civ_float_t      *bracket_base;      /* tax owed below bracket i; [count] is
+                                           owed below the top remainder */
   int                bracket_count;
   int                bracket_capacity;
   civ_float_t       collection_efficiency; /* 0.0-1.0, affected by governance */
@@ -47,7 +64,8 @@ typedef struct {
   civ_float_t      total_revenue;       /* collected last cycle */
   civ_float_t      projected_revenue;   /* estimated next cycle */
   civ_float_t      tax_burden_index;    /* 0.0-1.0 overall burden on population */
-  civ_float_t      gini_coefficient;    /* inequality measure */
+  civ_float_t      gini_coefficient;    /* inequality after income tax */
+  civ_income_distribution_t income;     /* how per-capita GDP is spread */
 } civ_taxation_system_t;
 
 /* --- Lifecycle --- */
@@ -71,8 +89,12 @@ void civ_taxation_add_bracket(civ_taxation_system_t *t,
                               civ_float_t threshold,
                               civ_float_t rate);
 void civ_taxation_toggle_tax(civ_taxation_system_t *t, civ_tax_type_t type, bool active);
+/* Rebuild the income buckets from a log-normal of this sigma (the default,
+   0.8, gives a pre-tax Gini near 0.41) */
+void civ_taxation_set_income_dispersion(civ_taxation_system_t *t, civ_float_t sigma);
 
 /* --- Query --- */
+/* Income tax on one income, from the cumulative bracket table */
 civ_float_t civ_taxation_calculate_income_tax(const civ_taxation_system_t *t, civ_float_t income);
 civ_float_t civ_taxation_effective_tax_rate(const civ_taxation_system_t *t);
 civ_float_t civ_taxation_revenue_forecast(const civ_taxation_system_t *t);
@@ -0,0 +1,161 @@
+/**
+ * @file trade_network.h
+ * @brief Map-based trade network — settlement graph, cached routes, shared capacity
+ *
+ * Every settlement is a node. Land edges join each settlement to its
+ * nearest neighbours along the pathfinder's cheapest route, asked of the
+ * path service when one is set: such an edge keeps its old base cost (is
+ * closed, when new) until the answer is published a tick later. Coastal
+ * settlements are also ports, joined to nearby ports by sea, priced along
+ * the ocean region graph when one is set (straight-line otherwise). Edge costs
+ * add road quality and a border charge between owners, and every edge has
+ * a capacity that all routes over it share.
+ *
+ * A few landmark nodes keep their distances to every node. Those give a
+ * lower bound on any trip, which serves routing as its A* heuristic and
+ * lets an edge change re-route only the routes it can affect: a dearer
+ * edge re-routes the routes that use it, a cheaper one only the routes the
+ * bound says it could shorten. Changes are collected as they happen
+ * (owner changes through a map owner listener, infrastructure when the
+ * network syncs with the settlements) and applied together by
+ * civ_trade_network_update, which then evaluates all routes in one pass.
+ */
+#ifndef CIV_ECONOMY_TRADE_NETWORK_H
+#define CIV_ECONOMY_TRADE_NETWORK_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include "../world/ocean_regions.h"
+#include "../world/path_service.h"
+#include "../world/pathfinding.h"
+#include "../world/settlement_manager.h"
+
+#define CIV_TRADE_LAND_NEIGHBOURS 4
+#define CIV_TRADE_LAND_RADIUS     48.0f  /* tiles */
+#define CIV_TRADE_SEA_NEIGHBOURS  6
+#define CIV_TRADE_SEA_RADIUS      240.0f
+#define CIV_TRADE_SEA_COST        4u     /* per tile, vs CIV_PATH_COST_STRAIGHT on land */
+#define CIV_TRADE_BORDER_COST     200u   /* crossing between two owners */
+#define CIV_TRADE_LANDMARKS       8
+#define CIV_TRADE_NO_NODE         UINT32_MAX
+
+typedef enum {
+  CIV_TRADE_EDGE_LAND = 0,
+  CIV_TRADE_EDGE_SEA
+} civ_trade_edge_kind_t;
+
+typedef struct {
+  uint32_t tile;
+  civ_owner_index_t owner;     /* tile owner as last seen */
+  float road_quality;          /* settlement infrastructure as last seen */
+  float port_capacity;
+  bool port;                   /* coastal */
+  uint32_t first_edge;         /* adjacency slice in edge_refs */
+  uint32_t edge_count;
+} civ_trade_node_t;
+
+typedef struct {
+  uint32_t a, b;
+  civ_trade_edge_kind_t kind;
+  uint32_t base_cost;          /* path or sea distance cost, before modifiers */
+  uint32_t cost;               /* what routing sees */
+  float capacity;              /* volume per turn before congestion */
+  float flow;                  /* volume of the routes using it */
+  bool dirty;                  /* cost needs recomputing */
+  bool base_dirty;             /* base_cost too (new edge or terrain change) */
+  civ_path_ticket_t path_ticket; /* land base cost being solved */
+} civ_trade_edge_t;
+
+typedef struct {
+  uint32_t from, to;           /* nodes */
+  float volume;                /* units per turn */
+  float value_per_unit;
+  float tariff_rate;
+  bool active;
+
+  uint32_t *path;              /* edges from -> to */
+  uint32_t path_length;
+  uint32_t path_capacity;
+  uint32_t cost;               /* CIV_PATH_NO_PATH while unreachable */
+  bool reroute;
+
+  /* Written by the turn's evaluation */
+  float throughput;            /* share of volume the path's capacity carries */
+  float revenue;
+} civ_trade_network_route_t;
+
+typedef struct {
+  civ_map_t *map;
+  civ_pathfinder_t *pathfinder; /* not owned */
+  civ_path_service_t *path_service; /* not owned; NULL = price land inline */
+  int path_layer;              /* service layer of pathfinder */
+  const civ_ocean_regions_t *ocean; /* not owned; NULL = straight sea legs */
+
+  civ_trade_node_t *nodes;     /* node i is settlement i */
+  uint32_t node_count;
+  uint32_t *tile_slots;        /* tile hash -> node + 1, 0 = empty */
+  uint32_t slot_mask;
+
+  civ_trade_edge_t *edges;
+  uint32_t edge_count;
+  uint32_t edge_capacity;
+  uint32_t *edge_refs;         /* per node adjacency, edge indices */
+
+  uint32_t landmarks[CIV_TRADE_LANDMARKS];
+  uint32_t landmark_count;
+  uint32_t *landmark_dist;     /* landmark * node_count + node */
+  bool landmarks_stale;
+
+  civ_trade_network_route_t *routes;
+  uint32_t route_count;
+  uint32_t route_capacity;
+
+  bool nodes_dirty;            /* some node's owner changed */
+  bool topology_dirty;         /* settlements added or terrain changed */
+
+  /* Last evaluation */
+  uint32_t reroutes;
+  float total_revenue;
+  float total_volume;
+} civ_trade_network_t;
+
+/* The network listens to map owner changes and must be destroyed before
+   map. pathfinder prices land edges and may be NULL (no land edges). */
+civ_trade_network_t *civ_trade_network_create(civ_map_t *map,
+                                              civ_pathfinder_t *pathfinder);
+void civ_trade_network_destroy(civ_trade_network_t *net);
+
+/* Price land edges through svc's layer, which must be the pathfinder's,
+   instead of inline; NULL goes back to inline */
+void civ_trade_network_set_path_service(civ_trade_network_t *net,
+                                        civ_path_service_t *svc, int layer);
+
+/* Price sea edges along ocean's regions (NULL = straight-line distance);
+   re-prices the sea edges there are */
+void civ_trade_network_set_ocean(civ_trade_network_t *net,
+                                 const civ_ocean_regions_t *ocean);
+
+/* Re-price every land edge, after terrain changes */
+void civ_trade_network_invalidate_all(civ_trade_network_t *net);
+
+/* Pick up new settlements and infrastructure changes; update runs this */
+void civ_trade_network_sync(civ_trade_network_t *net,
+                            const civ_settlement_manager_t *settlements);
+
+/* Returns the route index, or -1 */
+int32_t civ_trade_network_add_route(civ_trade_network_t *net,
+                                    uint32_t from_node, uint32_t to_node,
+                                    float volume, float value_per_unit,
+                                    float tariff_rate);
+void civ_trade_network_cancel_route(civ_trade_network_t *net, int32_t route);
+
+/* Node of the settlement on tile (x, y), or CIV_TRADE_NO_NODE */
+uint32_t civ_trade_network_node_at(const civ_trade_network_t *net,
+                                   int32_t x, int32_t y);
+
+/* Apply collected changes, re-route what they affect, recompute flows and
+   evaluate every route */
+void civ_trade_network_update(civ_trade_network_t *net,
+                              const civ_settlement_manager_t *settlements);
+
+#endif /* CIV_ECONOMY_TRADE_NETWORK_H */
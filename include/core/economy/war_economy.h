@@ -34,5 +34,7 @@ void civ_war_economy_set_mobilization(civ_war_economy_system_t *w, civ_mobilizat
 void civ_war_economy_produce_materiel(civ_war_economy_system_t *w, civ_float_t industrial_input);
 civ_float_t civ_war_economy_gdp_penalty(const civ_war_economy_system_t *w);
 bool civ_war_economy_is_sustainable(const civ_war_economy_system_t *w);
+/* At peace with every mobilization effect decayed away: updates change nothing */
+bool civ_war_economy_is_demobilized(const civ_war_economy_system_t *w);
 
 #endif
@@ -0,0 +1,77 @@
+/**
+ * @file climate.h
+ * @brief Monthly climate by latitude and elevation band, and seasonal yields
+ *
+ * Climate is never stored per tile. The tables hold, for every
+ * CIV_CLIMATE_LAT_BAND_DEGREES band of latitude and every land elevation
+ * band, each calendar month's mean temperature, precipitation and a growing
+ * multiplier (0-1) for crops; temperature follows the sun with the
+ * hemisphere's season and falls 6.5 C per km of height, rain follows the
+ * equatorial belt north and south through the year. A tile's biome index
+ * is its land use.
+ *
+ * A profile is what a region needs to evaluate: its land tiles counted by
+ * latitude band, elevation band and biome. A month's yield over the region
+ * is then one weighted sweep of the profile through the tables, and the
+ * same profile gives the year's lean months without any per-tile,
+ * per-month data. Rows are taken as equirectangular, north at row 0.
+ */
+#ifndef CIVILIZATION_CLIMATE_H
+#define CIVILIZATION_CLIMATE_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include "../world/map_generator.h"
+#include "geography.h"
+
+#define CIV_CLIMATE_LAT_BAND_DEGREES 10
+#define CIV_CLIMATE_LAT_BANDS  (180 / CIV_CLIMATE_LAT_BAND_DEGREES)
+#define CIV_CLIMATE_ELEV_BANDS 8   /* sea level to the highest peak */
+#define CIV_CLIMATE_MONTHS     12
+#define CIV_CLIMATE_BIOMES     8   /* civ_land_use_type_t */
+#define CIV_CLIMATE_PEAK_KM    6.0f /* height of elevation 1.0 above the sea */
+#define CIV_CLIMATE_LEAN       0.3f /* growing below this is a lean month */
+
+typedef struct {
+  float temperature[CIV_CLIMATE_LAT_BANDS][CIV_CLIMATE_ELEV_BANDS][CIV_CLIMATE_MONTHS]; /* C */
+  float precipitation[CIV_CLIMATE_LAT_BANDS][CIV_CLIMATE_MONTHS]; /* mm per month */
+  float growing[CIV_CLIMATE_LAT_BANDS][CIV_CLIMATE_ELEV_BANDS][CIV_CLIMATE_MONTHS];
+} civ_climate_t;
+
+/* A region's land tiles by band and biome */
+typedef struct {
+  uint32_t counts[CIV_CLIMATE_LAT_BANDS][CIV_CLIMATE_ELEV_BANDS][CIV_CLIMATE_BIOMES];
+  uint32_t land_tiles;
+  int32_t  surveyed_tiles; /* caller's key for when to survey again */
+} civ_climate_profile_t;
+
+civ_climate_t *civ_climate_create(void);
+void civ_climate_destroy(civ_climate_t *climate);
+
+/* Latitude and elevation band of tile; band 0 starts at the map's sea level */
+void civ_climate_bands_of(const civ_map_t *map, size_t tile, int *lat_band,
+                          int *elev_band);
+
+/* month is 1-12 */
+float civ_climate_temperature_at(const civ_climate_t *climate, const civ_map_t *map,
+                                 size_t tile, int month);
+float civ_climate_growing_at(const civ_climate_t *climate, const civ_map_t *map,
+                             size_t tile, int month);
+
+void civ_climate_profile_clear(civ_climate_profile_t *profile);
+/* Count tile in; water is skipped */
+void civ_climate_profile_add(civ_climate_profile_t *profile, const civ_map_t *map,
+                             size_t tile);
+/* Clear, then count every land tile owner holds */
+void civ_climate_profile_survey(civ_climate_profile_t *profile, const civ_map_t *map,
+                                civ_owner_index_t owner);
+
+/* The region's growing multiplier for month (1-12), 0-1, weighted by
+   what each biome can grow; 0 for a region without farmland */
+float civ_climate_profile_yield(const civ_climate_t *climate,
+                                const civ_climate_profile_t *profile, int month);
+/* Months of the year whose yield is under CIV_CLIMATE_LEAN, 0-12 */
+int civ_climate_profile_lean_months(const civ_climate_t *climate,
+                                    const civ_climate_profile_t *profile);
+
+#endif /* CIVILIZATION_CLIMATE_H */
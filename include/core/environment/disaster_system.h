@@ -1,6 +1,25 @@
 /**
  * @file disaster_system.h
  * @brief Environmental Disasters and Events
+ *
+ * Disasters run on simulation time: the manager's clock advances by the
+ * update's delta in game days, and a disaster lasts duration_hours of it.
+ * Spawns come from the CIV_RNG_DISASTERS stream keyed by update step,
+ * so every peer replaying the same updates gets the same disasters.
+ *
+ * Where they strike follows the map. Bound to a map, the manager scores
+ * every CIV_DISASTER_CELL-square cell for each type from its tiles:
+ * elevation for earthquakes and volcanoes, rivers and moisture for floods,
+ * heat and dryness for droughts and wildfires, warm coasts for hurricanes,
+ * population density for plague. The spawn rate, the cell and the type are
+ * drawn in proportion to those scores.
+ *
+ * A disaster stamps its footprint once, when triggered, onto a sparse
+ * tile-damage layer. civ_disaster_apply_impact then takes everything
+ * stamped since its last call in one pass. It finds the settlements and
+ * units under the new footprints through their spatial indexes and charges
+ * each tile's economic loss to its owner. Expired disasters are lifted from
+ * the layer.
  */
 
 #ifndef CIVILIZATION_DISASTER_SYSTEM_H
@@ -9,6 +28,14 @@
 #include "../../common.h"
 #include "../../types.h"
 #include "../environment/geography.h"
+#include "../world/owner_ids.h"
+#include "../world/settlement_manager.h"
+#include "../../utils/timing_wheel.h"
+
+#define CIV_DISASTER_CELL       32     /* hazard cell side, tiles */
+#define CIV_DISASTER_MAX_RADIUS 24.0f  /* footprint at severity 1, tiles */
+#define CIV_DISASTER_RATE       0.0002 /* spawns per day per unit of hazard */
+#define CIV_DISASTER_MAX_SPAWNS 4      /* per update */
 
 /* Disaster Type */
 typedef enum {
@@ -18,7 +45,8 @@ typedef enum {
   CIV_DISASTER_WILDFIRE,
   CIV_DISASTER_HURRICANE,
   CIV_DISASTER_PLAGUE,
-  CIV_DISASTER_VOLCANO
+  CIV_DISASTER_VOLCANO,
+  CIV_DISASTER_TYPE_COUNT
 } civ_disaster_type_t;
 
 /* Disaster Event */
@@ -27,16 +55,34 @@ typedef struct {
   civ_disaster_type_t type;
   char name[STRING_MEDIUM_LEN];
 
-  civ_coordinate_t location;
-  civ_float_t radius;   /* Area of effect */
+  int32_t x, y;         /* Epicentre tile */
+  civ_float_t radius;   /* Area of effect, tiles */
   civ_float_t severity; /* 0.0 to 1.0 */
 
-  time_t start_time;
+  double start_day;     /* Manager clock when it struck */
   int32_t duration_hours;
+  uint32_t number;      /* the n of its id; keys its expiry timer */
 
   bool active;
+  bool impact_pending;  /* stamped since the last civ_disaster_apply_impact */
 } civ_disaster_t;
 
+/* Sparse per-tile damage, open addressing on tile index */
+typedef struct {
+  uint32_t *keys;       /* tile + 1, 0 = empty */
+  float *damage;
+  uint32_t capacity;    /* power of two, 0 = unallocated */
+  uint32_t count;
+} civ_disaster_layer_t;
+
+typedef struct {
+  uint64_t disasters;        /* struck */
+  uint64_t settlements_hit;
+  uint64_t units_hit;
+  int64_t  population_lost;
+  int64_t  unit_losses;      /* strength */
+} civ_disaster_stats_t;
+
 /* Disaster Manager */
 typedef struct {
   civ_disaster_t *active_disasters;
@@ -44,21 +90,78 @@ typedef struct {
   size_t disaster_capacity;
 
   civ_geography_t *geography; /* Reference to world geography */
+
+  /* Map the hazard and the layers were built for */
+  const civ_map_t *map;
+  uint32_t map_serial;
+  int32_t cell_cols, cell_rows;
+  float *hazard;        /* per cell, CIV_DISASTER_TYPE_COUNT scores each */
+  double *hazard_cdf;   /* running sum of the cells' total scores */
+  double hazard_total;
+
+  civ_disaster_layer_t damage; /* applied footprints */
+  civ_disaster_layer_t fresh;  /* stamped, not yet applied */
+
+  double sim_days;      /* clock, game days */
+  uint64_t step;        /* updates run; keys the spawn stream */
+  uint64_t rng_seed;
+  uint32_t serial;      /* number in the next disaster id */
+
+  /* Ends wait in a wheel of whole game hours of sim_days; an update
+     compacts the list only when one fired */
+  civ_timing_wheel_t expiry;
+  size_t expired;       /* since the last compaction */
+
+  float *owner_loss;    /* economic loss per owner index, cumulative */
+  size_t owner_loss_capacity;
+  civ_disaster_stats_t stats;
 } civ_disaster_manager_t;
 
 /* Functions */
 civ_disaster_manager_t *civ_disaster_manager_create(civ_geography_t *geography);
 void civ_disaster_manager_destroy(civ_disaster_manager_t *manager);
 
+/* Score map's cells and restamp active disasters when map is not the one
+   the manager was built for; cheap otherwise. NULL unbinds. */
+void civ_disaster_manager_set_map(civ_disaster_manager_t *manager,
+                                  const civ_map_t *map);
+
+/* Strike tile (x, y); stamped at once, applied by the next
+   civ_disaster_apply_impact. Without a map nothing is stamped. */
 civ_result_t civ_disaster_trigger(civ_disaster_manager_t *manager,
-                                  civ_disaster_type_t type,
-                                  civ_coordinate_t location,
-                                  civ_float_t severity);
+                                  civ_disaster_type_t type, int32_t x,
+                                  int32_t y, civ_float_t severity);
+/* Strike a cell drawn by its hazard score for type, from the spawn stream */
+civ_result_t civ_disaster_spawn(civ_disaster_manager_t *manager,
+                                civ_disaster_type_t type,
+                                civ_float_t severity);
+/* Advance the clock by time_delta game days: expire, then roll spawns */
 void civ_disaster_update(civ_disaster_manager_t *manager,
                          civ_float_t time_delta);
 
-/* Impact Calculation */
+/**
+ * Apply everything stamped since the last call in one batch: population
+ * and order in the settlements, strength in the units, economic loss to
+ * the tiles' owners. Either manager may be NULL.
+ * @return Tiles applied
+ */
+size_t civ_disaster_apply_impact(civ_disaster_manager_t *manager,
+                                 civ_settlement_manager_t *settlements,
+                                 civ_unit_manager_t *units);
+
+/* Disasters still in effect */
+size_t civ_disaster_active_count(const civ_disaster_manager_t *manager);
+
+/* Damage on tile (x, y) from every disaster in effect, 0.0 to 1.0 */
+civ_float_t civ_disaster_damage_at(const civ_disaster_manager_t *manager,
+                                   int32_t x, int32_t y);
+
+/* Cumulative economic loss charged to owner */
+civ_float_t civ_disaster_owner_loss(const civ_disaster_manager_t *manager,
+                                    civ_owner_index_t owner);
+
+/* Impact Calculation: one disaster's damage at a tile, ignoring wrap */
 civ_float_t civ_disaster_calculate_damage(const civ_disaster_t *disaster,
-                                          civ_coordinate_t target_loc);
+                                          civ_float_t x, civ_float_t y);
 
 #endif /* CIVILIZATION_DISASTER_SYSTEM_H */
@@ -0,0 +1,77 @@
+/**
+ * @file pollution.h
+ * @brief Coarse-grid pollution: emitted at sources, carried by the wind
+ *
+ * The map is cut into CIV_POLLUTION_CELL-tile cells. Power plants,
+ * factories and extraction sites deposit emissions into the cell of their
+ * tile; a step then adds the deposits, carries each row along the
+ * prevailing wind of its latitude (easterlies in the tropics and near the
+ * poles, westerlies between), spreads the result with a separable 3-tap
+ * blur, x then y, and lets it decay. x wraps like the map; the poles
+ * reflect. Advection and blur both move pollution without creating or
+ * losing any, so only decay takes it away.
+ *
+ * Harm rises with the level as level / (level + CIV_POLLUTION_HARMFUL):
+ * it lowers settlements' health, raises their unrest and costs crops.
+ * The grid is small enough to step every tick on one thread.
+ */
+#ifndef CIVILIZATION_POLLUTION_H
+#define CIVILIZATION_POLLUTION_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include "../world/settlement_manager.h"
+
+#define CIV_POLLUTION_CELL      8      /* tiles per cell side */
+#define CIV_POLLUTION_DECAY     0.01f  /* rate per day */
+#define CIV_POLLUTION_DIFFUSION 0.05f  /* cells^2 per day */
+#define CIV_POLLUTION_WIND      0.3f   /* cells per day at the wind belts' core */
+#define CIV_POLLUTION_HARMFUL   50.0f  /* level at which harm is one half */
+#define CIV_POLLUTION_UNREST    0.02f  /* settlement unrest per day at full harm */
+#define CIV_POLLUTION_CROP_LOSS 0.5f   /* share of the harvest lost at full harm */
+
+typedef struct {
+  int32_t map_width, map_height;
+  int32_t cols, rows;
+  float *level;    /* by cell, row-major */
+  float *deposit;  /* emitted since the last step */
+  float *scratch;
+  float *wind;     /* by row, cells per day, positive eastwards */
+
+  double emitted;  /* over the field's life */
+  uint64_t steps;
+} civ_pollution_field_t;
+
+/* A clean field over a map of the given size; NULL without memory */
+civ_pollution_field_t *civ_pollution_create(int32_t map_width,
+                                            int32_t map_height);
+void civ_pollution_destroy(civ_pollution_field_t *field);
+
+/* Deposit amount at tile (x, y); taken into the field by the next step */
+void civ_pollution_emit(civ_pollution_field_t *field, int32_t x, int32_t y,
+                        civ_float_t amount);
+/* Deposit amount over owner's settlements by their population, for
+   sources that have no tile of their own (CIV_OWNER_NONE = all); how much
+   found a settlement */
+civ_float_t civ_pollution_emit_settlements(civ_pollution_field_t *field,
+                                           const civ_settlement_manager_t *sm,
+                                           civ_owner_index_t owner,
+                                           civ_float_t amount);
+
+/* Take in the deposits, then advect, blur and decay over dt days */
+void civ_pollution_step(civ_pollution_field_t *field, civ_float_t dt);
+
+/* Level at tile (x, y) */
+civ_float_t civ_pollution_at(const civ_pollution_field_t *field, int32_t x,
+                             int32_t y);
+/* 0 (clean) to 1 for a level */
+civ_float_t civ_pollution_harm(civ_float_t level);
+
+/* Set every settlement's health index from the harm where it stands and
+   add the unrest it causes over dt days. Returns the population-weighted
+   harm over owner's settlements (CIV_OWNER_NONE = all). */
+civ_float_t civ_pollution_apply(const civ_pollution_field_t *field,
+                                civ_settlement_manager_t *sm,
+                                civ_owner_index_t owner, civ_float_t dt);
+
+#endif /* CIVILIZATION_POLLUTION_H */
@@ -1,6 +1,23 @@
 /**
  * @file event_manager.h
  * @brief Event management system
+ *
+ * Emitted events are kept in a fixed-capacity ring; once it is full each
+ * new event evicts the oldest, which is first spilled to the journal when
+ * one is attached. Handlers live in one array per event type, so dispatch
+ * touches only the handlers that want the event.
+ *
+ * In deferred mode emitted events are stored but not dispatched; a call to
+ * civ_event_manager_dispatch_deferred at the phase boundary delivers them
+ * in emission order. The manager is not locked: emit from one thread.
+ *
+ * Other threads civ_event_manager_post instead, tagging each event with a
+ * source id (a nation, a system, a chunk). Posts are staged on a lock-free
+ * list and emitted on the main thread by civ_event_manager_merge_posted,
+ * which dispatch_deferred and update call first, sorted by source and then
+ * by the order the source posted them. The merged order, and so every
+ * handler's view, is the same whichever worker ran which source, as long
+ * as one source posts from one thread per phase.
  */
 
 #ifndef CIVILIZATION_EVENT_MANAGER_H
@@ -8,14 +25,20 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include "../data/history_db.h"
+#include <SDL3/SDL.h>
+
+#define CIV_EVENT_STORE_CAPACITY 1024 /* events kept in memory */
 
 /* Event type enumeration */
 typedef enum {
+    CIV_EVENT_TYPE_ANY = -1, /* handler type: every event */
     CIV_EVENT_TYPE_NATURAL = 0,
     CIV_EVENT_TYPE_POLITICAL,
     CIV_EVENT_TYPE_ECONOMIC,
     CIV_EVENT_TYPE_MILITARY,
-    CIV_EVENT_TYPE_SOCIAL
+    CIV_EVENT_TYPE_SOCIAL,
+    CIV_EVENT_TYPE_COUNT
 } civ_event_type_t;
 
 /* Event structure */
@@ -27,26 +50,48 @@ typedef struct {
     civ_float_t importance;
     time_t timestamp;
     bool active;
-    void* data;  /* Event-specific data */
+    void* data;  /* Event-specific data, owned by the manager once emitted
+                    and freed when the event is evicted */
 } civ_game_event_t;
 
 /* Event handler callback */
 typedef void (*civ_event_handler_cb_t)(const civ_game_event_t* event, void* user_data);
 
 /* Event handler structure */
-typedef struct civ_event_handler {
-    civ_event_type_t event_type;
+typedef struct {
     civ_event_handler_cb_t callback;
     void* user_data;
-    struct civ_event_handler* next;
 } civ_event_handler_t;
 
+/* Handlers of one type, in registration order */
+typedef struct {
+    civ_event_handler_t* handlers;
+    size_t count;
+    size_t capacity;
+} civ_event_handler_list_t;
+
+/* Staged post; see event_manager.c */
+typedef struct civ_event_staged civ_event_staged_t;
+
 /* Event manager structure */
 typedef struct {
-    civ_game_event_t* events;
+    civ_game_event_t* events;   /* ring of event_capacity slots */
+    size_t event_head;          /* slot of the oldest stored event */
     size_t event_count;
     size_t event_capacity;
-    civ_event_handler_t* handlers;
+    uint64_t events_emitted;    /* since creation */
+    uint64_t events_evicted;
+
+    /* One list per type; the last is CIV_EVENT_TYPE_ANY */
+    civ_event_handler_list_t handlers[CIV_EVENT_TYPE_COUNT + 1];
+
+    bool deferred;
+    size_t pending_count;       /* newest stored events not yet dispatched */
+
+    civ_event_staged_t* staged; /* posts, newest first; swapped out by merge */
+    SDL_AtomicInt staged_count;
+
+    civ_journal_t* spill;       /* receives evicted events; NULL = drop them */
     time_t last_update;
 } civ_event_manager_t;
 
@@ -55,6 +100,7 @@ civ_event_manager_t* civ_event_manager_create(void);
 void civ_event_manager_destroy(civ_event_manager_t* em);
 void civ_event_manager_init(civ_event_manager_t* em);
 
+/* type may be CIV_EVENT_TYPE_ANY */
 civ_result_t civ_event_manager_register_handler(civ_event_manager_t* em, civ_event_type_t type,
                                                 civ_event_handler_cb_t callback, void* user_data);
 civ_result_t civ_event_manager_emit_event(civ_event_manager_t* em, const civ_game_event_t* event);
@@ -63,5 +109,26 @@ civ_result_t civ_event_manager_create_event(civ_event_manager_t* em, civ_event_t
                                             civ_float_t importance);
 void civ_event_manager_update(civ_event_manager_t* em, civ_float_t time_delta);
 
-#endif /* CIVILIZATION_EVENT_MANAGER_H */
+/* Stage an event for the next merge; safe from any thread. The manager
+   takes event->data as emit does. */
+civ_result_t civ_event_manager_post(civ_event_manager_t* em, uint32_t source,
+                                    const civ_game_event_t* event);
+/* Emit every staged post ordered by (source, sequence) and return how many
+   there were; main thread, usually at a phase barrier */
+size_t civ_event_manager_merge_posted(civ_event_manager_t* em);
 
+/* Stored event by age, 0 = oldest; NULL past event_count */
+const civ_game_event_t* civ_event_manager_get_event(const civ_event_manager_t* em, size_t index);
+
+/* Journal that evicted events are written to (NULL to stop) */
+void civ_event_manager_set_spill(civ_event_manager_t* em, civ_journal_t* journal);
+
+/* Hold dispatch until civ_event_manager_dispatch_deferred. A phase that
+   emits more events than the ring holds has the oldest dispatched early. */
+void civ_event_manager_defer(civ_event_manager_t* em);
+/* Merge staged posts, deliver every held event in order and return to
+   immediate dispatch; events emitted by handlers meanwhile are delivered in
+   the same call, events they post wait for the next merge */
+void civ_event_manager_dispatch_deferred(civ_event_manager_t* em);
+
+#endif /* CIVILIZATION_EVENT_MANAGER_H */
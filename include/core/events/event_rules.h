@@ -0,0 +1,151 @@
+/**
+ * @file event_rules.h
+ * @brief Event triggers: rules over game facts, evaluated on change
+ *
+ * A rule is a conjunction of predicates (fact op threshold) and fires once
+ * each time it goes from not holding to holding. Facts are numbers set by
+ * the systems that own them. Every fact has an index of the predicates
+ * that read it, sorted by threshold; when a fact moves from a to b only
+ * the predicates with thresholds between a and b can change their answer,
+ * so only those are tested. Each rule counts its true predicates. An
+ * evaluation touches only the facts set since the last one and the rules
+ * they reach, however many rules are authored.
+ *
+ * A fact that was never set is unknown, and every predicate over it is
+ * false. The rules are not locked: set facts and evaluate from one thread.
+ */
+
+#ifndef CIVILIZATION_EVENT_RULES_H
+#define CIVILIZATION_EVENT_RULES_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include "../../utils/symbol.h"
+#include "event_manager.h"
+
+#define CIV_EVENT_RULE_MAX_PREDICATES 8
+
+typedef enum {
+    CIV_RULE_LT = 0,
+    CIV_RULE_LE,
+    CIV_RULE_GT,
+    CIV_RULE_GE,
+    CIV_RULE_EQ
+} civ_rule_op_t;
+
+typedef struct {
+    const char* fact;
+    civ_rule_op_t op;
+    civ_float_t threshold;
+} civ_rule_predicate_t;
+
+/* Called when a rule fires, after its event is emitted */
+typedef void (*civ_event_rule_cb_t)(const char* rule_id, void* user_data);
+
+/* Rule as authored; strings are copied */
+typedef struct {
+    const char* id;
+    civ_event_type_t type;
+    const char* title;       /* NULL = emit no event, only run action */
+    const char* description;
+    civ_float_t importance;
+    civ_rule_predicate_t predicates[CIV_EVENT_RULE_MAX_PREDICATES];
+    size_t predicate_count;
+    bool once;               /* retire after the first firing */
+    civ_event_rule_cb_t action;
+    void* user_data;
+} civ_event_rule_def_t;
+
+/* Predicate in a fact's index */
+typedef struct {
+    civ_float_t threshold;
+    uint32_t predicate;
+} civ_rule_alpha_t;
+
+typedef struct {
+    civ_rule_alpha_t* entries;  /* by threshold once sorted */
+    size_t count;
+    size_t capacity;
+    bool sorted;
+} civ_rule_index_t;
+
+typedef struct {
+    char id[STRING_SHORT_LEN];
+    civ_event_type_t type;
+    char title[STRING_MEDIUM_LEN];  /* empty = no event */
+    char description[STRING_MAX_LEN];
+    civ_float_t importance;
+    civ_event_rule_cb_t action;
+    void* user_data;
+    uint32_t predicate_count;
+    uint32_t satisfied;      /* predicates now true */
+    bool holding;            /* held at the end of the last evaluation */
+    bool touched;            /* on the touched list */
+    bool once;
+    bool retired;
+    uint64_t fired;
+} civ_event_rule_t;
+
+/* Whether a fact has a value and whether the predicates have seen one;
+   flags rather than NAN, which -ffast-math builds cannot test for */
+#define CIV_FACT_SET    0x01u
+#define CIV_FACT_TESTED 0x02u
+
+typedef struct {
+    /* Facts; seen is the value the predicates were last tested on */
+    civ_symbol_t* fact_symbol;
+    civ_float_t* fact_value;
+    civ_float_t* fact_seen;
+    uint8_t* fact_known;       /* CIV_FACT_SET, CIV_FACT_TESTED; 0 = unknown */
+    civ_rule_index_t* fact_index;
+    uint8_t* fact_dirty;
+    uint32_t* dirty;           /* facts set since the last evaluation */
+    size_t dirty_count;
+    size_t fact_count;
+    size_t fact_capacity;
+    int32_t* fact_of;          /* by symbol handle; -1 = not a fact */
+    uint32_t fact_of_size;
+
+    /* Predicates */
+    uint32_t* predicate_rule;
+    uint8_t* predicate_op;     /* civ_rule_op_t */
+    uint8_t* predicate_true;
+    size_t predicate_count;
+    size_t predicate_capacity;
+
+    civ_event_rule_t* rules;
+    size_t rule_count;
+    size_t rule_capacity;
+    uint32_t* touched;         /* rules whose count moved */
+    size_t touched_count;
+    size_t touched_capacity;
+
+    uint64_t tests;            /* predicate tests, all evaluations */
+    uint64_t fired;
+} civ_event_rules_t;
+
+civ_event_rules_t* civ_event_rules_create(void);
+void civ_event_rules_destroy(civ_event_rules_t* rules);
+
+/* Fact index for name, declared unknown if new; -1 without memory */
+int32_t civ_event_rules_fact(civ_event_rules_t* rules, const char* name);
+/* Set a fact by index or by symbol; a symbol not yet a fact is declared */
+void civ_event_rules_set(civ_event_rules_t* rules, size_t fact, civ_float_t value);
+civ_result_t civ_event_rules_set_fact(civ_event_rules_t* rules, civ_symbol_t fact,
+                                      civ_float_t value);
+/* Current value of a fact; 0 while unknown */
+civ_float_t civ_event_rules_get(const civ_event_rules_t* rules, size_t fact);
+bool civ_event_rules_known(const civ_event_rules_t* rules, size_t fact);
+
+/* Compile a rule into the fact indices. A rule that holds when added
+   fires at the next evaluation. */
+civ_result_t civ_event_rules_add(civ_event_rules_t* rules, const civ_event_rule_def_t* def);
+/* Rule index, -1 if unknown */
+int32_t civ_event_rules_find(const civ_event_rules_t* rules, const char* id);
+
+/* Test the predicates reached by facts set since the last call and fire
+   the rules that came to hold, emitting their events on em (may be NULL).
+   Returns the number fired. */
+size_t civ_event_rules_evaluate(civ_event_rules_t* rules, civ_event_manager_t* em);
+
+#endif /* CIVILIZATION_EVENT_RULES_H */
@@ -1,16 +1,43 @@
 /**
  * @file game_events.h
  * @brief Game Event Triggers
+ *
+ * The game publishes a fixed set of facts to its event rules every update,
+ * and the authored events below are rules over them.
  */
 
 #ifndef CIVILIZATION_GAME_EVENTS_H
 #define CIVILIZATION_GAME_EVENTS_H
 
 #include "../environment/disaster_system.h"
+#include "event_rules.h"
 
 struct civ_game;
 typedef struct civ_game civ_game_t;
 
+/* X(ID, name): facts published to the event rules */
+#define CIV_GAME_FACTS(X)                                                      \
+  X(STABILITY, "stability")                                                    \
+  X(LEGITIMACY, "legitimacy")                                                  \
+  X(AT_WAR, "at_war")                                                          \
+  X(WAR_EXHAUSTION, "war_exhaustion")                                          \
+  X(YEAR, "year")                                                              \
+  X(TURN, "turn")
+
+typedef enum {
+#define CIV_GAME_FACT_ENUM(id, name) CIV_GAME_FACT_##id,
+  CIV_GAME_FACTS(CIV_GAME_FACT_ENUM)
+#undef CIV_GAME_FACT_ENUM
+  CIV_GAME_FACT_COUNT
+} civ_game_fact_t;
+
+/* Declare the game facts on empty rules, their indices being the
+   civ_game_fact_t values, then add the authored events */
+civ_result_t civ_game_events_register_rules(civ_game_t *game,
+                                            civ_event_rules_t *rules);
+/* Set every game fact from the current state */
+void civ_game_events_publish(civ_game_t *game, civ_event_rules_t *rules);
+
 void civ_trigger_economic_crisis(civ_game_t *game);
 void civ_trigger_natural_disaster(civ_game_t *game, civ_disaster_type_t type);
 
@@ -12,10 +12,15 @@
 #include "../utils/cache.h"
 #include "../utils/config.h"
 #include "../utils/memory_pool.h"
+#include "../utils/arena.h"
 #include "abstracts/soft_metrics.h"
 #include "ai/ai_system.h"
+#include "ai/influence_map.h"
 #include "culture/culture.h"
 #include "culture/ideology_system.h"
+#include "culture/naming.h"
+#include "culture/religion_system.h"
+#include "data/time_series.h"
 #include "diplomacy/international_organizations.h"
 #include "diplomacy/relations.h"
 #include "economy/currency.h"
@@ -40,9 +45,12 @@
 #include "economy/war_economy.h"
 #include "economy/black_market.h"
 #include "economy/innovation_economy.h"
+#include "environment/climate.h"
+#include "environment/pollution.h"
 #include "environment/disaster_system.h"
 #include "environment/geography.h"
 #include "events/event_manager.h"
+#include "events/event_rules.h"
 #include "governance/custom_governance.h"
 #include "governance/government.h"
 #include "governance/branches/legislative.h"
@@ -50,24 +58,40 @@
 #include "military/conquest.h"
 #include "military/units.h"
 #include "politics/politics.h"
+#include "population/epidemic.h"
+#include "population/migration.h"
 #include "population/population_manager.h"
+#include "simulation_engine/command_log.h"
+#include "simulation_engine/state_hash.h"
 #include "simulation_engine/performance_optimizer.h"
 #include "simulation_engine/state_persistence.h"
+#include "simulation_engine/save_worker.h"
+#include "simulation_engine/delta_export.h"
 #include "simulation_engine/system_orchestrator.h"
 #include "simulation_engine/time_manager.h"
 #include "subunits/subunit.h"
 #include "technology/innovation_system.h"
+#include "technology/tech_diffusion.h"
 #include "visualization/cultural_display.h"
 #include "world/cities_data.h"
 #include "world/dynamic_borders.h"
+#include "world/logistics_field.h"
+#include "world/nation_labels.h"
 #include "world/nation.h"
 #include "world/flag_system.h"
 #include "world/map_generator.h"
 #include "world/nations_data.h"
+#include "world/path_service.h"
+#include "world/pathfinding.h"
 #include "world/resource_map.h"
+#include "world/scenario.h"
 #include "world/settlement_manager.h"
+#include "world/site_field.h"
 #include "world/territory.h"
+#include "world/tile_field.h"
+#include "world/modifier_stack.h"
 #include "world/wonders.h"
+#include "world/world_pack.h"
 
 struct civ_map_view_manager;
 struct civ_player_profile;
@@ -96,6 +120,28 @@ typedef struct {
   int32_t max_event_log;
 } civ_game_config_t;
 
+/* Autosave chain: a base file plus up to CIV_AUTOSAVE_MAX_DELTAS deltas,
+   each holding the map regions whose revision moved since the save before */
+#define CIV_AUTOSAVE_MAX_DELTAS 8
+
+typedef struct {
+  char      path[512];        /* base file of the chain */
+  uint64_t  chain_id;         /* 0 = no chain, next autosave is a base */
+  uint32_t *region_revision;  /* map revisions the files hold */
+  size_t    region_count;
+  uint32_t  map_serial;       /* map those revisions belong to */
+  int32_t   delta_count;      /* deltas written since the base */
+  size_t    delta_regions;    /* regions written across those deltas */
+} civ_autosave_state_t;
+
+/* A save section left on disk at load until something first needs it */
+#define CIV_GAME_DEFERRED_MAX 4
+
+typedef struct {
+  uint32_t tag;
+  char     path[512];         /* newest file of the loaded save holding it */
+} civ_deferred_section_t;
+
 /* Performance metrics */
 typedef struct {
   uint64_t update_count;
@@ -127,16 +173,35 @@ typedef struct civ_game {
   civ_population_manager_t *population_manager;
   civ_market_dynamics_t *market_economy;
   civ_innovation_system_t *technology_tree;
+  civ_tech_diffusion_t *tech_diffusion; /* spreads tech between nations */
+  civ_migration_t *migration;           /* moves people along the same links */
   civ_combat_system_t *military_system;
   civ_unit_manager_t *unit_manager;
   civ_diplomacy_system_t *diplomacy_system;
   civ_event_manager_t *event_manager;
+  civ_event_rules_t *event_rules; /* authored events over game facts */
   civ_dynamic_borders_t *dynamic_borders;
+  civ_nation_labels_t *nation_labels; /* name baselines over territory */
   civ_government_t *government;
   civ_geography_t *geography;
+  civ_climate_t *climate;                 /* monthly tables by latitude and height */
+  civ_climate_profile_t *climate_profile; /* the player's land through them */
+  civ_pollution_field_t *pollution;       /* coarse grid over world_map */
+  civ_float_t pollution_harm;             /* the player's people, last step */
   civ_culture_system_t *culture_system;
+  civ_naming_service_t *naming;           /* every procedural name, kept unique */
+  civ_religion_system_t *religion_system; /* over trade_network's nodes */
+  civ_epidemic_system_t *epidemics;       /* likewise */
   civ_ai_system_t *ai_system;
   civ_map_t *world_map;
+  civ_pathfinder_t *pathfinder; /* over world_map; builds on first query */
+  civ_path_service_t *path_service; /* queued queries; layer 0 = pathfinder */
+  civ_ocean_regions_t *ocean_regions; /* sea graph over world_map, built at load */
+  civ_logistics_field_t *logistics_field; /* hub travel costs per owner, over world_map */
+  civ_trade_network_t *trade_network; /* settlement graph over world_map */
+  civ_influence_map_t *influence_map; /* AI layers over world_map */
+  civ_site_field_t *site_field; /* settlement candidates over world_map */
+  civ_tile_field_t *tile_field; /* overlays spread over world_map */
   civ_territory_manager_t *territory_manager;
   civ_custom_governance_manager_t *custom_governance_manager;
   civ_conquest_system_t *conquest_system;
@@ -148,6 +213,7 @@ typedef struct civ_game {
   civ_trade_manager_t *trade_manager;
   civ_disaster_manager_t *disaster_manager;
   civ_wonder_manager_t *wonder_manager;
+  civ_modifier_table_t *modifiers; /* per-owner stacks, refreshed each update */
 
   /* --- Economy systems (18 modules) --- */
   /* Foundation */
@@ -176,11 +242,24 @@ typedef struct civ_game {
 
   /* Performance and modularity systems */
   civ_system_orchestrator_t *system_orchestrator;
+  void *system_graph; /* civ_game_systems_t — opaque */
   civ_performance_optimizer_t *performance_optimizer;
   civ_config_manager_t *config_manager;
   civ_cache_t *cache;
   civ_memory_pool_manager_t *memory_pool;
   civ_state_persistence_t *persistence;
+  civ_save_worker_t *save_worker; /* autosave writes; NULL = inline */
+  civ_command_log_t *command_log; /* recording this session; NULL = off */
+  civ_delta_export_t *delta_export; /* per-turn delta stream; NULL = off */
+  struct civ_lockstep *lockstep;  /* multiplayer session; NULL = local */
+  civ_state_hash_t *state_hashes; /* per-turn subsystem hashes */
+  civ_time_series_t *metrics_history; /* per-turn nation metrics */
+  int metrics_upkeep; /* its maintenance task (utils/maintenance.h) */
+  civ_arena_t *frame_arena; /* UI scratch; reset by civ_game_begin_frame */
+  civ_arena_t *turn_arena;  /* simulation scratch; reset each end turn */
+  civ_autosave_state_t autosave;
+  civ_deferred_section_t deferred[CIV_GAME_DEFERRED_MAX];
+  int deferred_count;
 
   /* Nations */
   char **nations;
@@ -191,6 +270,7 @@ typedef struct civ_game {
   bool is_paused;
 
   int32_t current_turn;
+  uint32_t turn_commands; /* player commands applied this turn; keys their RNG */
 
   /* Player identity */
   civ_player_profile_t  *current_profile;
@@ -205,24 +285,40 @@ typedef struct civ_game {
   void *time_engine;    /* civ_time_engine_t — opaque */
 
   /* NPC engine */
-  void *npc_engine;     /* civ_npc_engine_t — opaque */
+  void *npc_engine;     /* civ_npc_engine_t — opaque; after a load use civ_game_npcs */
 
   /* Market engine — currencies, commodities, companies */
   civ_market_engine_t          *market;
 
   /* Data-driven world systems */
+  civ_world_pack_t      *world_pack;   /* NULL = loose files under data/ */
   civ_nations_data_t    *nations_data;
   civ_resource_map_t    *resource_map;
-  civ_cities_data_t     *cities_data;
-  civ_flag_system_t     *flag_system;
+  civ_cities_data_t     *cities_data;  /* lazy: use civ_game_cities */
+  civ_flag_system_t     *flag_system;  /* lazy: use civ_game_flags */
 
   /* Global economy aggregates */
   civ_nation_economy_t   global_economy;
 
   /* Player wallet */
   civ_wallet_t wallet;
+
+  /* Fixed-timestep simulation thread (owned by the app controller) */
+  void *sim_thread;     /* civ_sim_thread_t — opaque */
+
+  /* Launch overrides — set before civ_game_initialize, never saved */
+  uint32_t    map_seed;     /* 0 = CIV_GLOBAL_MAP_SEED */
+  const char *map_path;     /* NULL = data/earth_2048x1024.earth */
+  uint32_t    max_workers;  /* system threads: 0 = per core, 1 = serial */
+  civ_float_t fixed_dt;     /* > 0: fixed update delta instead of wall time */
+  const civ_scenario_params_t *scenario; /* NULL = the bundled world */
+
+  /* Background load in progress, NULL once joined */
+  struct civ_game_loader *loader;
 } civ_game_t;
 
+typedef struct civ_game_loader civ_game_loader_t;
+
 /* Function declarations */
 
 /**
@@ -236,16 +332,47 @@ civ_game_t *civ_game_create(void);
 void civ_game_destroy(civ_game_t *game);
 
 /**
- * Initialize the game with configuration
+ * Initialize the game with configuration, running every load stage on the
+ * calling thread
  */
 civ_result_t civ_game_initialize(civ_game_t *game,
                                  const civ_game_config_t *config);
 
+/**
+ * Run the same load stages on a loader thread and return at once. Until
+ * civ_game_is_loaded, other threads may touch only current_profile.
+ */
+civ_result_t civ_game_load_start(civ_game_t *game,
+                                 const civ_game_config_t *config);
+
+/**
+ * Share of the load done (0-1) and the name of the running stage; 1 and
+ * "Ready" when nothing is loading
+ */
+float civ_game_load_progress(const civ_game_t *game, const char **stage);
+
+/**
+ * True once every load stage has run, or when no load was started
+ */
+bool civ_game_is_loaded(const civ_game_t *game);
+
+/**
+ * Join the loader thread and return the first stage failure; ok when
+ * nothing is loading
+ */
+civ_result_t civ_game_load_finish(civ_game_t *game);
+
 /**
  * Run the main game loop
  */
 void civ_game_run(civ_game_t *game);
 
+/**
+ * Start a rendered frame: drops everything on the frame arena. Call from
+ * the thread that draws, before any scene pushes to it.
+ */
+void civ_game_begin_frame(civ_game_t *game);
+
 /**
  * Update the game (call each frame)
  */
@@ -271,16 +398,60 @@ void civ_game_shutdown(civ_game_t *game);
  */
 civ_result_t civ_game_end_turn(civ_game_t *game);
 
+/**
+ * Apply a player command and append it to the command log when recording.
+ * Every UI action that changes game state goes through here so a recorded
+ * session replays exactly (see simulation_engine/command_log.h). Under a
+ * lockstep session the command is queued and applies at the end of the
+ * turn on every peer (see simulation_engine/lockstep.h).
+ */
+civ_result_t civ_game_execute(civ_game_t *game, const civ_command_t *cmd);
+
+/**
+ * Whether the game must advance the same on every run: it is being
+ * recorded, or a lockstep session holds peers to it. Wall time, frame
+ * rate and UI state must not reach the simulation while it does.
+ */
+bool civ_game_deterministic(const civ_game_t *game);
+
+/**
+ * World seed that keys every deterministic RNG stream (see utils/rng.h)
+ */
+uint64_t civ_game_rng_seed(const civ_game_t *game);
+
+/**
+ * Bind the player and every nation to their modifier stacks and rebuild the
+ * stacks whose inputs changed (see world/modifier_stack.h)
+ */
+void civ_game_refresh_modifiers(civ_game_t *game);
+
 /**
  * Save full game state (Map, Config, Players) to file
  */
 civ_result_t civ_game_save_state(civ_game_t *game, const char *filename);
 
 /**
- * Load full game state from file
+ * Load full game state from file, replaying any autosave deltas beside it
  */
 civ_result_t civ_game_load_state(civ_game_t *game, const char *filename);
 
+/**
+ * Autosave to filename: a delta of the regions changed since the last
+ * autosave, or a full base when there is no chain yet or it is due for
+ * compaction (too many deltas, or more regions than a base holds).
+ * The game is snapshotted here and the file written on the save worker;
+ * while a write is still in flight this autosave is skipped.
+ */
+civ_result_t civ_game_autosave(civ_game_t *game, const char *filename);
+
+/**
+ * Keyframe save of a recording (see simulation_engine/command_log.h): a
+ * compressed full base, snapshotted here and written on the save worker
+ * when it is idle, inline otherwise. A keyframe that fails to write is
+ * only missed by a seek, which falls back to an older one.
+ */
+civ_result_t civ_game_save_keyframe(civ_game_t *game, const char *filename);
+
 /* Legacy/Basic wrapper (mapped to save_state) */
 civ_result_t civ_game_save(civ_game_t *game, const char *filename);
 civ_result_t civ_game_load(civ_game_t *game, const char *filename);
@@ -290,6 +461,20 @@ civ_result_t civ_game_load(civ_game_t *game, const char *filename);
  */
 void civ_game_get_default_config(civ_game_config_t *config);
 
+/**
+ * Lazily loaded world data: loaded on first call, then cached.
+ * NULL only when out of memory; a missing file yields an empty set.
+ */
+civ_cities_data_t *civ_game_cities(civ_game_t *game);
+civ_flag_system_t *civ_game_flags(civ_game_t *game);
+
+/**
+ * NPC engine, with its saved NPCs and decision history read in on the
+ * first call after a load (the section is deferred until then);
+ * a civ_npc_engine_t, opaque like game->npc_engine
+ */
+void *civ_game_npcs(civ_game_t *game);
+
 /**
  * Add event to event log
  */
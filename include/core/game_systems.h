@@ -0,0 +1,116 @@
+/**
+ * @file game_systems.h
+ * @brief Per-tick game systems registered with the system orchestrator
+ *
+ * Each simulation phase that used to be hand-sequenced in civ_game_update
+ * is a node in the orchestrator's dependency graph. Nodes exchange their
+ * per-tick outputs (GDP, unemployment, interest rate, ...) through a shared
+ * frame; a node only reads frame fields written by its declared
+ * dependencies, so independent nodes can run concurrently.
+ *
+ * A system may also report how much work it has: a dormant one is skipped,
+ * a cheap one runs every few ticks with the time it missed, a full one
+ * runs every tick. Events that can change the answer (a war declared, a
+ * disaster striking) wake the systems they concern for a while.
+ */
+#ifndef CIV_GAME_SYSTEMS_H
+#define CIV_GAME_SYSTEMS_H
+
+#include "../common.h"
+#include "../types.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct civ_game;
+
+/* ── Shared per-tick signals ──────────────────────────────────────── */
+typedef struct {
+  /* demographics — population, tech and governance baseline */
+  int64_t     total_pop;
+  int64_t     working_age_pop; /* 15-64 */
+  civ_float_t tech_lev;
+  civ_float_t education;
+  civ_float_t health;
+  civ_float_t pollution_harm;  /* as the last tick's pollution step left it */
+  civ_float_t gov_efficiency;
+  civ_float_t corruption;
+  civ_float_t gov_stability;
+  civ_float_t gov_legitimacy;
+  civ_float_t arable_area;
+  civ_float_t geography_size;
+  float       gov_econ_bonus;
+  float       gov_trade_bonus;
+  float       gov_research_bonus;
+  float       gov_military_bonus;
+  float       gov_cohesion;
+
+  /* macro_economy (unemployment refined by labor_market) */
+  civ_float_t gdp;
+  civ_float_t gdp_per_capita;
+  civ_float_t gdp_growth;
+  civ_float_t inflation;
+  civ_float_t unemployment;
+
+  /* labor_market */
+  civ_float_t avg_wage;
+  int         labor_avail;
+  int         labor_employed;
+
+  /* economic_policy (demographics seeds the lagged values) */
+  civ_float_t business_conf;
+  civ_float_t regulation_level;
+
+  /* taxation / budget (interest rate refined by banking) */
+  civ_float_t tax_revenue;
+  civ_float_t budget_infra_allocation;
+  civ_float_t gov_spending_ratio;
+  civ_float_t debt_interest_rate;
+  civ_float_t savings_rate;
+
+  /* production chain */
+  civ_float_t food_surplus;
+  civ_float_t raw_materials;
+  civ_float_t infra_quality;
+  civ_float_t infra_supply_chain;
+  civ_float_t industrial_output;
+  civ_float_t energy_price;
+
+  /* governance */
+  civ_float_t total_gov_budget;
+  civ_float_t culture_level;
+} civ_game_frame_t;
+
+/* How much of a tick a system needs; see civ_game_systems_update */
+typedef enum {
+  CIV_SYSTEM_DORMANT, /* nothing would change: skipped, its time dropped */
+  CIV_SYSTEM_CHEAP,   /* slow drift: runs every few ticks on the time missed */
+  CIV_SYSTEM_FULL     /* runs every tick */
+} civ_system_activity_t;
+
+/* Register every per-tick system with game->system_orchestrator */
+civ_result_t civ_game_systems_register(struct civ_game *game);
+
+/* Run one tick of all registered systems */
+civ_result_t civ_game_systems_update(struct civ_game *game, civ_float_t dt);
+
+/* Run the named system every tick for the next CIV_SYSTEM_WAKE_TICKS
+   ticks whatever it reports. Call between updates or from an event
+   handler; unknown names are ignored. */
+#define CIV_SYSTEM_WAKE_TICKS 16
+void civ_game_systems_wake(struct civ_game *game, const char *name);
+
+/* What the named system decided on its last tick (FULL if unknown) */
+civ_system_activity_t civ_game_systems_activity(const struct civ_game *game,
+                                                const char *name);
+
+/* Release the node table (orchestrator itself is destroyed by the game) */
+void civ_game_systems_destroy(struct civ_game *game);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* CIV_GAME_SYSTEMS_H */
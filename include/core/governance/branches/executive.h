@@ -57,7 +57,9 @@ typedef struct {
 } civ_executive_t;
 
 civ_executive_t *civ_executive_create(void);
+void civ_executive_init(civ_executive_t *e);
 void civ_executive_destroy(civ_executive_t *e);
+void civ_executive_free(civ_executive_t *e);
 void civ_executive_update(civ_executive_t *e, float dt,
                           float centralization, float legitimacy,
                           float emergency_power, float representation);
@@ -68,6 +70,8 @@ civ_executive_action_t *civ_executive_issue_order(civ_executive_t *e,
 civ_executive_action_t *civ_executive_issue_decree(civ_executive_t *e,
                                                     const char *title, float effect);
 bool civ_executive_veto_bill(civ_executive_t *e, const char *bill_id);
+/* Legislative support a veto override must beat */
+float civ_executive_override_threshold(const civ_executive_t *e);
 bool civ_executive_override_possible(const civ_executive_t *e, float legislative_support);
 void civ_executive_sign_bill(civ_executive_t *e);
 void civ_executive_process_actions(civ_executive_t *e, float dt);
@@ -63,7 +63,9 @@ typedef struct {
 } civ_judiciary_t;
 
 civ_judiciary_t *civ_judiciary_create(void);
+void civ_judiciary_init(civ_judiciary_t *j);
 void civ_judiciary_destroy(civ_judiciary_t *j);
+void civ_judiciary_free(civ_judiciary_t *j);
 void civ_judiciary_update(civ_judiciary_t *j, float dt,
                           float gov_efficiency, float corruption,
                           float centralization, float representation);
@@ -4,6 +4,13 @@
  *
  * Allows for the creation of custom legislative bodies (parliaments, councils,
  * dictators, etc.) that have the power to enact rules and amend constitutions.
+ *
+ * Bills wait in a queue until the next session. A session votes every
+ * queued bill at once: each seat holds an ideology vector and each bill a
+ * position in the same space, so the seats' leanings on a bill are one
+ * matrix-vector product, and the tallies are checked against the pass
+ * share each body precomputes from its voting method and the override
+ * share the executive's veto power sets for the session.
  */
 
 #ifndef CIVILIZATION_LEGISLATIVE_SYSTEM_H
@@ -12,6 +19,13 @@
 #include "../../../common.h"
 #include "../../../types.h"
 #include "../legal/constitution.h"
+#include "executive.h"
+
+/* Dimensions of the ideology space seats and bills are placed in; what
+   each axis means is up to whoever seats members and drafts bills */
+#define CIV_LEGISLATIVE_AXES 4
+/* Leaning within which a seat abstains */
+#define CIV_LEGISLATIVE_ABSTAIN_BAND 0.05f
 
 /* Voting Method */
 typedef enum {
@@ -41,6 +55,12 @@ typedef struct {
   /* Powers */
   civ_voting_method_t voting_method;
   civ_float_t custom_threshold; /* For super majority */
+  civ_float_t pass_share;       /* yes share a bill must beat, from the above */
+
+  /* Seats: seat_count x CIV_LEGISLATIVE_AXES, row per member; owned by
+     the manager once the body is added */
+  float *seat_ideology;
+  int seat_count;
 
   /* Session State */
   bool in_session;
@@ -50,7 +70,10 @@ typedef struct {
 /* Bill / Proposal */
 typedef struct {
   char id[STRING_SHORT_LEN];
+  uint32_t number;  /* counts up per legislature; the id is bill_<number> */
   char title[STRING_MEDIUM_LEN];
+  int body;         /* voting body; -1 = simple majority, no seats */
+  float position[CIV_LEGISLATIVE_AXES];
 
   civ_rule_t *proposed_rule; /* Rule to add/modify */
   bool is_repeal;            /* If true, remove the rule instead */
@@ -63,6 +86,7 @@ typedef struct {
 
   bool resolved;
   bool passed;
+  bool vetoed; /* vetoed; passed too if the legislature overrode it */
 } civ_bill_t;
 
 /* Manager */
@@ -74,11 +98,17 @@ typedef struct {
   civ_bill_t *active_bills;
   size_t bill_count;
   size_t bill_capacity;
+  uint32_t bills_proposed; /* active bills stay in number order */
+
+  /* Executive's position; it vetoes the bills it leans against */
+  float leader[CIV_LEGISLATIVE_AXES];
 } civ_legislative_manager_t;
 
 /* Functions */
 civ_legislative_manager_t *civ_legislative_manager_create(void);
+void civ_legislative_manager_init(civ_legislative_manager_t *manager);
 void civ_legislative_manager_destroy(civ_legislative_manager_t *manager);
+void civ_legislative_manager_free(civ_legislative_manager_t *manager);
 
 civ_legislative_body_t *civ_legislative_body_create(const char *name,
                                                     const char *required_role);
@@ -86,6 +116,29 @@ civ_result_t
 civ_legislative_manager_add_body(civ_legislative_manager_t *manager,
                                  civ_legislative_body_t *body);
 
+/* Seat a body: the first government_share of the seats sit at government,
+   the next opposition_share at its opposite, the rest at the centre */
+civ_result_t civ_legislative_apportion(civ_legislative_manager_t *manager,
+                                       size_t body, int seats,
+                                       const float government[CIV_LEGISLATIVE_AXES],
+                                       float government_share,
+                                       float opposition_share);
+
+/* Queue a bill for the next session; the bill takes the rule. Returns the
+   bill's index, -1 on bad arguments or without memory. */
+int32_t civ_legislative_queue_bill(civ_legislative_manager_t *manager,
+                                   int body, civ_rule_t *rule, bool repeal,
+                                   const float position[CIV_LEGISLATIVE_AXES]);
+/* Index of the bill with that number, -1 if not active */
+int32_t civ_legislative_find_bill(const civ_legislative_manager_t *manager,
+                                  uint32_t number);
+
+/* Vote, veto and resolve every queued bill, then drop the resolved ones.
+   executive may be NULL (no veto). Returns the number enacted. */
+size_t civ_legislative_run_session(civ_legislative_manager_t *manager,
+                                   civ_executive_t *executive,
+                                   civ_constitution_t *target_constitution);
+
 civ_result_t civ_legislative_propose_bill(civ_legislative_manager_t *manager,
                                           const char *body_id, civ_rule_t *rule,
                                           bool repeal);
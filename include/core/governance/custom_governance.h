@@ -1,6 +1,13 @@
 /**
  * @file custom_governance.h
  * @brief Custom, emergent governance system
+ *
+ * A government made with civ_custom_governance_create carries its own
+ * evolution state. Once added to a manager that state moves into the
+ * manager's columns, index-aligned with the governments array, and every
+ * government advances in one pass over them; use the manager functions
+ * to reform a managed government. The derived title is rewritten only
+ * when the state crosses into a different name.
  */
 
 #ifndef CIVILIZATION_CUSTOM_GOVERNANCE_H
@@ -8,6 +15,7 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include "../../utils/symbol.h"
 #include "legal/constitution.h"
 
 /* Political Party System */
@@ -29,6 +37,7 @@ typedef struct {
 /* Governance structure */
 typedef struct {
   char id[STRING_SHORT_LEN];
+  civ_symbol_t id_sym; /* id interned */
   char name[STRING_MEDIUM_LEN];
   char description[STRING_MAX_LEN];
 
@@ -36,6 +45,9 @@ typedef struct {
   size_t role_count;
   size_t role_capacity;
 
+  char title[STRING_MEDIUM_LEN]; /* derived, see generate_name */
+
+  /* Evolution state while standalone; held by the manager once added */
   civ_float_t centralization;  /* 0.0 = decentralized, 1.0 = centralized */
   civ_float_t democracy_level; /* 0.0 = autocracy, 1.0 = full democracy */
   civ_float_t corruption;      /* 0.0 = honest, 1.0 = kleptocracy */
@@ -61,6 +73,19 @@ typedef struct {
   civ_custom_governance_t *governments;
   size_t government_count;
   size_t government_capacity;
+
+  /* Evolution state by government index */
+  civ_float_t *centralization;
+  civ_float_t *democracy_level;
+  civ_float_t *corruption;
+  civ_float_t *stability;
+  civ_float_t *efficiency;
+  civ_float_t *political_tension;
+  civ_float_t *role_efficiency; /* from the roles, refreshed when they change */
+  uint8_t *title_key;           /* name the title was written for */
+
+  int32_t *government_of; /* by symbol handle; -1 = not held */
+  uint32_t government_of_size;
 } civ_custom_governance_manager_t;
 
 /* Function declarations */
@@ -86,12 +111,32 @@ civ_custom_governance_manager_add(civ_custom_governance_manager_t *manager,
                                   civ_custom_governance_t *gov);
 civ_custom_governance_t *civ_custom_governance_manager_find(
     const civ_custom_governance_manager_t *manager, const char *id);
+civ_custom_governance_t *civ_custom_governance_manager_find_symbol(
+    const civ_custom_governance_manager_t *manager, civ_symbol_t id);
+/* Index of the government, -1 if the manager does not hold it */
+int32_t civ_custom_governance_manager_index(
+    const civ_custom_governance_manager_t *manager, civ_symbol_t id);
+
+/* Advance every managed government by time_delta */
+void civ_custom_governance_manager_update(
+    civ_custom_governance_manager_t *manager, civ_float_t time_delta);
+/* civ_custom_governance_reform and _add_role for the government at index */
+civ_result_t civ_custom_governance_manager_reform(
+    civ_custom_governance_manager_t *manager, size_t index,
+    const char *reform_description);
+civ_result_t civ_custom_governance_manager_add_role(
+    civ_custom_governance_manager_t *manager, size_t index,
+    const char *role_name, const char *description, civ_float_t authority);
 
 /* Evolutionary Logic */
 void civ_custom_governance_evolve(civ_custom_governance_t *gov,
                                   civ_float_t time_delta);
 void civ_custom_governance_generate_name(civ_custom_governance_t *gov,
                                          char *out_name, size_t max_len);
+/* The name as a small key: the same key always gives the same name */
+uint8_t civ_custom_governance_name_key(const civ_custom_governance_t *gov);
+void civ_custom_governance_name_text(uint8_t key, char *out_name,
+                                     size_t max_len);
 
 /**
  * @brief Map a linguistic title (e.g. "Lord") to a functional governance role
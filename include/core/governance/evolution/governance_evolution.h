@@ -149,6 +149,12 @@ void civ_governance_apply_decision(civ_governance_state_t *gov,
 /** Rich description from all 7 axes — 20+ distinct governance labels */
 const char *civ_governance_describe(const civ_governance_state_t *gov,
                                     char *buffer, size_t buffer_size);
+/** Which description the traits fall under; it moves only when a trait
+ *  crosses one of the thresholds the description reads */
+uint16_t    civ_governance_describe_key(const civ_governance_state_t *gov);
+/** Description for a key from civ_governance_describe_key */
+const char *civ_governance_describe_key_text(uint16_t key, char *buffer,
+                                             size_t buffer_size);
 
 /** Leader title based on governance structure */
 char *civ_governance_generate_title(const civ_governance_state_t *gov,
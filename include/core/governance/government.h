@@ -12,12 +12,25 @@
  *
  * This is the governance HUB — all governance subsystems are owned here
  * and ticked from civ_government_update.
+ *
+ * Each subsystem declares a cadence. The hub banks update time for it and
+ * ticks it once the bank reaches its period, with the banked time as dt;
+ * subsystems integrate in compounding steps (civ_compound) so a long dt
+ * lands where as many short ones would. Every government starts its banks
+ * at a phase drawn from its id, so nations do not all tick on one update.
+ *
+ * Governments live in arenas that hold each subsystem type for all their
+ * governments in one array. An update is a fixed sequence of stages, one
+ * per subsystem, and no stage reads another government, so a caller with
+ * many governments can run each stage across all of them before the next
+ * and walk each subsystem's array in order.
  */
 #ifndef CIVILIZATION_GOVERNMENT_H
 #define CIVILIZATION_GOVERNMENT_H
 
 #include "../../common.h"
 #include "../../types.h"
+#include "../interfaces/iserializable.h"
 #include "branches/council.h"
 #include "branches/executive.h"
 #include "branches/judiciary.h"
@@ -51,7 +64,81 @@ extern "C" {
 /* Budget allocation categories matching civ_budget_category_t */
 #define CIV_GOV_BUDGET_CATEGORIES 9
 
+/* ── Subsystem cadences ────────────────────────────────────────────── */
+/* Periods are in days, the unit of the update dt */
+#define CIV_GOV_WEEK  7.0f
+#define CIV_GOV_MONTH 30.0f
+#define CIV_GOV_YEAR  365.0f
+
+/* X(ID, period): time banked before a subsystem ticks; 0 = every update */
+#define CIV_GOVERNMENT_CADENCES(X)                                             \
+  X(EXECUTIVE, 0.0f)                                                           \
+  X(ELECTIONS, 0.0f) /* campaigns count updates */                             \
+  X(VIOLENCE, CIV_GOV_WEEK)                                                    \
+  X(INSTITUTIONS, CIV_GOV_MONTH)                                               \
+  X(SUBDIVISIONS, CIV_GOV_MONTH)                                               \
+  X(JUDICIARY, CIV_GOV_MONTH)                                                  \
+  X(COUNCIL, CIV_GOV_MONTH)                                                    \
+  X(RELIGIOUS_BODY, CIV_GOV_MONTH)                                             \
+  X(CIVIL_SERVICE, CIV_GOV_MONTH)                                              \
+  X(MINISTRIES, CIV_GOV_MONTH)                                                 \
+  X(METRICS, CIV_GOV_MONTH) /* societal health, notebook */                    \
+  X(RIGHTS, CIV_GOV_YEAR)
+
+typedef enum {
+#define CIV_GOV_CADENCE_ENUM(id, period) CIV_GOV_CADENCE_##id,
+  CIV_GOVERNMENT_CADENCES(CIV_GOV_CADENCE_ENUM)
+#undef CIV_GOV_CADENCE_ENUM
+  CIV_GOV_CADENCE_COUNT
+} civ_gov_cadence_t;
+
+/* ── Update stages, in the order an update runs them ───────────────── */
+#define CIV_GOVERNMENT_STAGES(X)                                               \
+  X(PROFILE)                                                                   \
+  X(INSTITUTIONS)                                                              \
+  X(SUBDIVISIONS)                                                              \
+  X(EVOLUTION)                                                                 \
+  X(EXECUTIVE)                                                                 \
+  X(JUDICIARY)                                                                 \
+  X(COUNCIL)                                                                   \
+  X(RELIGIOUS_BODY)                                                            \
+  X(ELECTIONS)                                                                 \
+  X(CIVIL_SERVICE)                                                             \
+  X(RIGHTS)                                                                    \
+  X(VIOLENCE)                                                                  \
+  X(CORRUPTION)                                                                \
+  X(MINISTRIES)                                                                \
+  X(DRIFT)      /* stability, legitimacy, efficiency */                        \
+  X(METRICS)    /* societal health, sessions, decisions, notebook */
+
+typedef enum {
+#define CIV_GOV_STAGE_ENUM(id) CIV_GOV_STAGE_##id,
+  CIV_GOVERNMENT_STAGES(CIV_GOV_STAGE_ENUM)
+#undef CIV_GOV_STAGE_ENUM
+  CIV_GOV_STAGE_COUNT
+} civ_gov_stage_t;
+
+/* Cross-module inputs of one update, held for its stages */
+typedef struct {
+  float dt;
+  int   total_population;
+  float culture_level;
+  float total_budget;
+  float education_level;
+  float economic_confidence;
+  float literacy_rate;
+} civ_gov_inputs_t;
+
+typedef struct {
+  float banked[CIV_GOV_CADENCE_COUNT]; /* time since each last ticked */
+  float due[CIV_GOV_CADENCE_COUNT];    /* bank at which it ticks next */
+} civ_gov_cadence_state_t;
+
 /* ── Political position — one role in the government hierarchy ────── */
+/* Traits of a position the profile reads, derived from its strings */
+#define CIV_POSITION_LIFE_TERM  0x01u /* term mentions "life" */
+#define CIV_POSITION_HEREDITARY 0x02u /* selection mentions "hereditary" */
+
 typedef struct {
   char   title[CIV_POSITION_TITLE_MAX];
   char   role_description[CIV_POSITION_ROLE_MAX];
@@ -93,11 +180,16 @@ typedef struct civ_government {
 
   /* Dynamic political positions from head-of-state down */
   civ_political_position_t *positions;
+  uint8_t                  *position_flags; /* CIV_POSITION_* per position */
   size_t                    position_count;
   size_t                    position_capacity;
 
-  /* Computed profile (updated each tick from structure) */
+  /* Computed profile: the structural part is recomputed only when the
+     positions changed, the part read from the metrics every tick */
   civ_governance_profile_t profile;
+  bool                     structure_dirty;
+  uint16_t                 title_key; /* describe key of dominant_title + 1;
+                                         0 = not written yet */
 
   /* Core metrics */
   float stability;
@@ -138,10 +230,57 @@ typedef struct civ_government {
   int   faction_count;
 
   civ_stature_tier_t stature_tier;
+
+  civ_gov_cadence_state_t cadence; /* phased from id at create, not saved */
+  civ_gov_inputs_t        inputs;  /* of the update in progress */
+
+  /* Arena holding this government and its subsystems, and its slot there */
+  struct civ_government_arena *arena;
+  uint32_t                     arena_slot;
+  bool                         owns_arena; /* created alone: arena of one */
 } civ_government_t;
 
+/* ── Government arena ──────────────────────────────────────────────── */
+/* X(type, slab): subsystems stored by value, slot i of every slab owned by
+   the government in slot i. Council and religious body are rare and stay
+   separate heap objects. */
+#define CIV_GOVERNMENT_ARENA_PARTS(X)                                          \
+  X(civ_government_t,          governments)                                   \
+  X(civ_constitution_t,        constitutions)                                 \
+  X(civ_executive_t,           executives)                                    \
+  X(civ_legislative_manager_t, legislatures)                                  \
+  X(civ_judiciary_t,           judiciaries)                                   \
+  X(civ_institution_manager_t, institution_managers)                          \
+  X(civ_subdivision_manager_t, subdivision_managers)                          \
+  X(civ_corruption_engine_t,   corruption_engines)                            \
+  X(civ_election_system_t,     election_systems)                              \
+  X(civ_political_violence_t,  political_violence)                            \
+  X(civ_ministry_manager_t,    ministry_managers)                             \
+  X(civ_civil_service_t,       civil_services)                                \
+  X(civ_rights_declaration_t,  rights)                                        \
+  X(civ_notebook_t,            notebooks)
+
+typedef struct civ_government_arena {
+#define CIV_GOV_ARENA_SLAB(type, slab) type *slab;
+  CIV_GOVERNMENT_ARENA_PARTS(CIV_GOV_ARENA_SLAB)
+#undef CIV_GOV_ARENA_SLAB
+  uint8_t  *live;       /* per slot */
+  uint32_t *free_slots; /* stack; slot 0 on top in a fresh arena */
+  size_t    free_count;
+  size_t    capacity;   /* fixed: subsystems are addressed in place */
+} civ_government_arena_t;
+
+civ_government_arena_t *civ_government_arena_create(size_t capacity);
+/* Destroys the governments still in the arena */
+void civ_government_arena_destroy(civ_government_arena_t *arena);
+
 /* ── API ───────────────────────────────────────────────────────────── */
+/* A government in an arena of its own */
 civ_government_t *civ_government_create(const char *name);
+/* In a free slot of arena, in slot order while none was given back; on its
+   own when arena is NULL or full */
+civ_government_t *civ_government_create_in(civ_government_arena_t *arena,
+                                           const char *name);
 void              civ_government_destroy(civ_government_t *gov);
 
 /* Add a political position to the government structure */
@@ -150,13 +289,29 @@ civ_political_position_t *civ_government_add_position(
     float exec_w, float leg_w, float jud_w,
     const char *selection, const char *term, int count);
 
+/* Remove the position at index; false if there is none */
+bool civ_government_remove_position(civ_government_t *gov, size_t index);
+
+/* Offices of from join into (a union): lower offices add their seats to
+   the one with the same title and level or come over whole, from's head
+   of state steps down. False, with into unchanged, when out of memory. */
+bool civ_government_fold_positions(civ_government_t *into,
+                                   const civ_government_t *from);
+
+/* Positions were edited in place (a reform): rederive their flags and the
+   structural profile at the next update */
+void civ_government_mark_structure_dirty(civ_government_t *gov);
+
 /* Compute governance profile from actual political structure */
 void civ_government_recompute_profile(civ_government_t *gov);
 
 /* Get a descriptive proximity label (computed, not fixed) */
 const char *civ_government_proximity_label(const civ_government_t *gov);
 
-/* Main tick — propagates to ALL governance subsystems.
+/* Period of a cadence in days; 0 = every update */
+float civ_government_cadence_period(civ_gov_cadence_t cadence);
+
+/* Main tick — propagates to ALL governance subsystems on their cadences.
  * Cross-module params enable dynamic behavior without hardcoding.
  * Pass 0/NULL for systems that don't exist yet. */
 void  civ_government_update(civ_government_t *gov, float time_delta,
@@ -165,17 +320,37 @@ void  civ_government_update(civ_government_t *gov, float time_delta,
                             float economic_confidence, float literacy_rate,
                             float faction_support,     /* avg faction support 0-1 */
                             int   faction_count);       /* number of active factions */
+/* The same update split up: begin takes the inputs, then every stage
+   runs once in order. Stages of different governments may interleave. */
+void  civ_government_begin_update(civ_government_t *gov, float time_delta,
+                                  int total_population, float culture_level,
+                                  float total_budget, float education_level,
+                                  float economic_confidence, float literacy_rate,
+                                  float faction_support, int faction_count);
+void  civ_government_update_stage(civ_government_t *gov, civ_gov_stage_t stage);
 float civ_government_get_stability(const civ_government_t *gov);
 
 /* ── Corruption (single source of truth) ──────────────────────────── */
 float civ_government_get_corruption(const civ_government_t *gov);
 
+/* ── Legality ──────────────────────────────────────────────────────── */
+/* Whether the constitution lets this government take action now */
+bool  civ_government_action_is_legal(const civ_government_t *gov,
+                                     civ_constitutional_action_t action);
+
 /* ── Budget integration ────────────────────────────────────────────── */
 void  civ_government_set_budget(civ_government_t *gov, int category, float amount);
 
 /* ── Legislative trigger ──────────────────────────────────────────── */
 void  civ_government_hold_session(civ_government_t *gov);
 
+/* ── Save section ──────────────────────────────────────────────────── */
+/* The hub's own state: positions, profile, metrics, evolution and health
+   snapshots, budget and session counters. Branches and institutions keep
+   rebuilding from these and are not stored. */
+#define CIV_GOVERNMENT_SAVE_VERSION 1
+civ_serializable_t civ_government_serializable(civ_government_t *gov);
+
 #ifdef __cplusplus
 }
 #endif
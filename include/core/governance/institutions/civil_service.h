@@ -48,7 +48,9 @@ typedef struct {
 } civ_civil_service_t;
 
 civ_civil_service_t *civ_civil_service_create(void);
+void civ_civil_service_init(civ_civil_service_t *cs);
 void civ_civil_service_destroy(civ_civil_service_t *cs);
+void civ_civil_service_free(civ_civil_service_t *cs);
 void civ_civil_service_update(civ_civil_service_t *cs, float dt,
                               float meritocracy_trait, float corruption,
                               float education_level, float total_budget,
@@ -1,6 +1,12 @@
 /**
  * @file institution.h
  * @brief Modular Institutional Framework for Infinite Simulation
+ *
+ * An institution's record holds what it is called and who controls it;
+ * its numbers are columns of the manager, one entry per institution, so
+ * an update is one pass over flat arrays. The pass also leaves behind
+ * log2(1 + stature) for every institution and its sums, overall and by
+ * focus, which is all the stature rankings and settlement bonuses read.
  */
 
 #ifndef CIVILIZATION_INSTITUTION_H
@@ -21,42 +27,54 @@ typedef enum {
       1 << 5 /* Language/Religion/Culture influence */
 } civ_institution_focus_t;
 
+#define CIV_INSTITUTION_FOCUS_COUNT 6
+
+/* Institution state bits */
+#define CIV_INSTITUTION_ACTIVE 0x01
+#define CIV_INSTITUTION_DISSOLVING 0x02
+
 /* Institution Structure */
 typedef struct {
   char id[STRING_SHORT_LEN];
   char name[STRING_MEDIUM_LEN];
-  uint32_t focuses; /* Bitmask of focus types */
-
-  civ_float_t stature;          /* Infinite XP metric */
-  civ_float_t growth_rate;      /* Driven by funding/efficiency */
-  civ_float_t maintenance_cost; /* Scales with stature */
-
   char governing_role[STRING_SHORT_LEN]; /* Who controls this? e.g. "Parliament"
                                           */
-
-  bool is_active;
-  bool is_dissolving;
 } civ_institution_t;
 
-/* Manager */
+/* Manager; the columns are indexed like items */
 typedef struct {
   civ_institution_t *items;
+  uint32_t *focuses;             /* Bitmask of focus types */
+  civ_float_t *stature;          /* Infinite XP metric */
+  civ_float_t *maintenance_cost; /* Scales with stature */
+  civ_float_t *log_stature;      /* log2(1 + stature); 0 once inactive */
+  uint8_t *state;                /* CIV_INSTITUTION_* bits */
   size_t count;
   size_t capacity;
+
+  /* Sums of log_stature; focus_bonus[b] is the bonus of focus 1 << b */
+  civ_float_t stature_log_sum;
+  civ_float_t focus_bonus[CIV_INSTITUTION_FOCUS_COUNT];
 } civ_institution_manager_t;
 
 /* Functions */
 civ_institution_manager_t *civ_institution_manager_create(void);
+void civ_institution_manager_init(civ_institution_manager_t *manager);
 void civ_institution_manager_destroy(civ_institution_manager_t *manager);
+void civ_institution_manager_free(civ_institution_manager_t *manager);
 
 civ_result_t civ_institution_found(civ_institution_manager_t *manager,
                                    const char *name, uint32_t focuses,
                                    const char *governing_role);
+/* Start winding an institution down; it loses stature until inactive */
+civ_result_t civ_institution_dissolve(civ_institution_manager_t *manager,
+                                      size_t index);
 
 void civ_institution_update(civ_institution_manager_t *manager,
                             civ_float_t budget_total,
                             civ_float_t gov_efficiency, civ_float_t time_delta);
 
+/* Bonus of the active institutions with any of the focus bits */
 civ_float_t
 civ_institution_get_total_bonus(const civ_institution_manager_t *manager,
                                 civ_institution_focus_t focus);
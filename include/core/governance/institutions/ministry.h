@@ -56,7 +56,9 @@ typedef struct {
 } civ_ministry_manager_t;
 
 civ_ministry_manager_t *civ_ministry_manager_create(void);
+void civ_ministry_manager_init(civ_ministry_manager_t *mgr);
 void civ_ministry_manager_destroy(civ_ministry_manager_t *mgr);
+void civ_ministry_manager_free(civ_ministry_manager_t *mgr);
 civ_ministry_t *civ_ministry_create(civ_ministry_type_t type, const char *minister_name);
 
 void civ_ministry_update_all(civ_ministry_manager_t *mgr, float total_budget,
@@ -26,7 +26,9 @@ typedef struct {
 
 /* Functions */
 civ_notebook_t *civ_notebook_create(void);
+void civ_notebook_init(civ_notebook_t *notebook);
 void civ_notebook_destroy(civ_notebook_t *notebook);
+void civ_notebook_free(civ_notebook_t *notebook);
 
 civ_result_t civ_notebook_add_note(civ_notebook_t *notebook, const char *title,
                                    const char *content);
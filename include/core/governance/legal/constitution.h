@@ -49,6 +49,43 @@ typedef struct {
   time_t enacted_date;
 } civ_rule_t;
 
+/* Actions whose legality the constitution decides:
+   X(ID, rule target_attribute, scope the action is taken in) */
+#define CIV_CONSTITUTIONAL_ACTIONS(X)                                          \
+  X(DECREE, "decree", NATIONAL)                                                \
+  X(DELAY_ELECTION, "election_delay", NATIONAL)                                \
+  X(EMERGENCY_POWERS, "emergency_powers", NATIONAL)                            \
+  X(SUSPENSION, "suspension", NATIONAL)                                        \
+  X(APPOINTMENT, "appointment", NATIONAL)                                      \
+  X(CURFEW, "curfew", LOCAL)
+
+typedef enum {
+#define CIV_CONSTITUTIONAL_ACTION_ENUM(id, key, scope) CIV_CONST_ACTION_##id,
+  CIV_CONSTITUTIONAL_ACTIONS(CIV_CONSTITUTIONAL_ACTION_ENUM)
+#undef CIV_CONSTITUTIONAL_ACTION_ENUM
+  CIV_CONST_ACTION_COUNT
+} civ_constitutional_action_t;
+
+/* Who is acting and with what backing */
+typedef struct {
+  float authority;           /* actor's authority, 0.0 to 1.0 */
+  float legislative_support; /* share of the legislature behind it */
+  bool suspended;            /* constitution suspended: nothing binds */
+} civ_legal_context_t;
+
+/* An action's compiled test: the rules naming the action folded into one
+   predicate and the bars it checks. A right forbids the action, a law
+   sets the authority it takes, a procedure the support; customs do not
+   bind. */
+struct civ_legality_s;
+typedef bool (*civ_legality_test_t)(const struct civ_legality_s *legality,
+                                    const civ_legal_context_t *ctx);
+typedef struct civ_legality_s {
+  civ_legality_test_t test;
+  float authority;
+  float support;
+} civ_legality_t;
+
 /* Constitution / Charter */
 typedef struct {
   char id[STRING_SHORT_LEN];
@@ -63,11 +100,16 @@ typedef struct {
   char amendment_body[STRING_SHORT_LEN]; /* ID of body that votes */
 
   time_t last_amendment;
+
+  /* By action; rebuilt whenever the rules change */
+  civ_legality_t legality[CIV_CONST_ACTION_COUNT];
 } civ_constitution_t;
 
 /* Functions */
 civ_constitution_t *civ_constitution_create(const char *name);
+void civ_constitution_init(civ_constitution_t *constitution, const char *name);
 void civ_constitution_destroy(civ_constitution_t *constitution);
+void civ_constitution_free(civ_constitution_t *constitution);
 
 civ_rule_t *civ_rule_create(const char *name, civ_rule_scope_t scope,
                             civ_rule_type_t type);
@@ -84,6 +126,19 @@ civ_rule_t *civ_constitution_find_rule(const civ_constitution_t *constitution,
 bool civ_rule_is_valid_in_scope(const civ_rule_t *rule,
                                 civ_rule_scope_t context_scope);
 
+/* Fold the active rules into the legality table. The rule functions
+   below call this; call it after changing rules in place. */
+void civ_constitution_compile(civ_constitution_t *c);
+/* Whether the constitution permits an action: one table dispatch */
+static inline bool civ_constitution_is_legal(const civ_constitution_t *c,
+                                             civ_constitutional_action_t action,
+                                             const civ_legal_context_t *ctx) {
+  if (!c || (unsigned)action >= CIV_CONST_ACTION_COUNT || ctx->suspended)
+    return true;
+  const civ_legality_t *l = &c->legality[action];
+  return l->test(l, ctx);
+}
+
 /* Amendment process */
 bool civ_constitution_propose_amendment(civ_constitution_t *c, const char *rule_id,
                                         const char *new_text, float support);
@@ -54,7 +54,9 @@ typedef struct {
 } civ_rights_declaration_t;
 
 civ_rights_declaration_t *civ_rights_create(void);
+void civ_rights_init(civ_rights_declaration_t *r);
 void civ_rights_destroy(civ_rights_declaration_t *r);
+void civ_rights_free(civ_rights_declaration_t *r);
 void civ_rights_update(civ_rights_declaration_t *r, float dt,
                        float rule_of_law, float representation,
                        float centralization, float emergency_active,
@@ -1,6 +1,15 @@
 /**
  * @file corruption.h
  * @brief Systemic Corruption Engine
+ *
+ * Corruption is a network: every implicated entity (an NPC, a minister, a
+ * faction, or "STATE" for the aggregate actor) is a node keyed by its
+ * interned id, and schemes that tie two entities together are weighted
+ * edges. The engine keeps the network's leakage term up to date as
+ * involvement moves, and a bit per entity handle telling whether it is
+ * compromised, so the check is one load. An audit examines at most
+ * CIV_CORRUPTION_AUDIT_SAMPLE entities drawn at random; whoever it catches
+ * exposes their partners along the edges.
  */
 
 #ifndef CIVILIZATION_CORRUPTION_H
@@ -8,6 +17,12 @@
 
 #include "../../../common.h"
 #include "../../../types.h"
+#include "../../../utils/symbol.h"
+
+/* Entities an audit examines; smaller networks are examined whole */
+#define CIV_CORRUPTION_AUDIT_SAMPLE 32
+/* Involvement above which an entity counts as compromised */
+#define CIV_CORRUPTION_COMPROMISED 0.3f
 
 /* Corruption Type */
 typedef enum {
@@ -18,21 +33,27 @@ typedef enum {
   CIV_CORRUPTION_PATRONAGE     /* Trading jobs for loyalty */
 } civ_corruption_type_t;
 
-/* Corruption Network Node */
-typedef struct {
-  char npc_id[STRING_SHORT_LEN];
-  civ_float_t involvement; /* 0.0 to 1.0 */
-  civ_float_t influence;
-  char cliques[4][STRING_SHORT_LEN]; /* Names of secret groups */
-  size_t clique_count;
-} civ_corruption_node_t;
-
 /* Corruption System */
 typedef struct {
-  civ_corruption_node_t *nodes;
+  /* Nodes: one per implicated entity */
+  civ_symbol_t *node_entity;
+  civ_float_t *involvement; /* 0.0 to 1.0 */
+  civ_float_t *influence;
+  int32_t *node_first;      /* first half-edge; -1 = none */
   size_t node_count;
   size_t node_capacity;
+  int32_t *node_of;         /* by symbol handle; -1 = not implicated */
+  uint64_t *compromised;    /* bit per symbol handle */
+  uint32_t node_of_size;
 
+  /* Edges, each stored as two half-edges 2e and 2e + 1 */
+  uint32_t *half_node;      /* node the half-edge leads to */
+  int32_t *half_next;       /* next half-edge out of the same node */
+  civ_float_t *edge_weight; /* 0.0 to 1.0, by edge */
+  size_t edge_count;
+  size_t edge_capacity;
+
+  civ_float_t exposure;       /* sum of involvement x influence */
   civ_float_t systemic_index; /* Overall national corruption */
   civ_float_t shadow_budget;  /* Funds diverted from national treasury */
 
@@ -41,11 +62,20 @@ typedef struct {
 
 /* Functions */
 civ_corruption_engine_t *civ_corruption_engine_create(void);
+void civ_corruption_engine_init(civ_corruption_engine_t *engine);
 void civ_corruption_engine_destroy(civ_corruption_engine_t *engine);
+void civ_corruption_engine_free(civ_corruption_engine_t *engine);
 
 civ_result_t civ_corruption_add_involvement(civ_corruption_engine_t *engine,
                                             const char *npc_id,
                                             civ_float_t amount);
+civ_result_t civ_corruption_add_involvement_sym(civ_corruption_engine_t *engine,
+                                                civ_symbol_t entity,
+                                                civ_float_t amount);
+/* Tie two entities into a scheme; weight adds to an existing tie */
+civ_result_t civ_corruption_implicate(civ_corruption_engine_t *engine,
+                                      civ_symbol_t a, civ_symbol_t b,
+                                      civ_float_t weight);
 civ_float_t
 civ_corruption_calculate_leakage(const civ_corruption_engine_t *engine,
                                  civ_float_t total_budget);
@@ -56,4 +86,11 @@ civ_result_t civ_corruption_run_audit(civ_corruption_engine_t *engine,
 bool civ_corruption_is_npc_compromised(const civ_corruption_engine_t *engine,
                                        const char *npc_id);
 
+static inline bool
+civ_corruption_is_compromised(const civ_corruption_engine_t *engine,
+                              civ_symbol_t entity) {
+  return entity < engine->node_of_size &&
+         ((engine->compromised[entity >> 6] >> (entity & 63)) & 1u);
+}
+
 #endif /* CIVILIZATION_CORRUPTION_H */
@@ -11,12 +11,23 @@
  * Elections run autonomously per cycle. NPCs campaign, voters respond
  * to economic conditions + governance performance + cultural factors.
  * The player can participate but does not control outcomes.
+ *
+ * Votes are tallied over an electorate of voter blocs rather than voters:
+ * each bloc is one district x voter class x ideology bucket, with a head
+ * count. A bloc splits its votes over the candidates by a softmax of
+ * their utility to it: the candidate's campaign standing, less the
+ * squared distance from the bloc's position to the candidate's stance,
+ * weighted by how much the class cares. District systems resolve each
+ * district's seats from its blocs' votes; proportional ones allocate on
+ * the national totals. The softmax runs over blocs in SIMD lanes.
  */
 #ifndef CIV_GOVERNANCE_ELECTIONS_H
 #define CIV_GOVERNANCE_ELECTIONS_H
 
 #include "../../../common.h"
 #include "../../../types.h"
+#include "../../../utils/symbol.h"
+#include "../../population/population_manager.h"
 
 /* Electoral systems */
 typedef enum {
@@ -30,6 +41,49 @@ typedef enum {
   CIV_ELECTION_TYPE_COUNT
 } civ_election_type_t;
 
+#define CIV_ELECTION_MAX_CANDIDATES 8
+#define CIV_ELECTORATE_BUCKETS      8     /* ideology buckets over -1..1 */
+#define CIV_ELECTORATE_SPREAD       0.45f /* ideology sd within a class */
+
+/* Voter classes by age, X(ID, first cohort, last cohort, lean, turnout,
+   salience): lean shifts the class's ideology, turnout scales its votes,
+   salience is what ideological distance costs a candidate with it */
+#define CIV_VOTER_CLASSES(X)                                                   \
+  X(YOUNG, 4, 5, -0.15f, 0.80f, 1.5f)                                          \
+  X(WORKING, 6, 12, 0.00f, 1.00f, 2.0f)                                        \
+  X(RETIRED, 13, 15, 0.15f, 1.15f, 2.5f)
+
+typedef enum {
+#define CIV_VOTER_CLASS_ENUM(id, first, last, lean, turnout, salience)         \
+  CIV_VOTER_##id,
+  CIV_VOTER_CLASSES(CIV_VOTER_CLASS_ENUM)
+#undef CIV_VOTER_CLASS_ENUM
+  CIV_VOTER_CLASS_COUNT
+} civ_voter_class_t;
+
+/* Voter blocs as columns, a district's blocs contiguous */
+typedef struct {
+  uint32_t *district;   /* district index */
+  uint8_t  *voter_class;
+  float    *position;   /* ideology, -1 to 1 */
+  float    *voters;     /* head count */
+  float    *weight;     /* voters x class turnout */
+  float    *salience;
+  size_t    bloc_count, bloc_capacity;
+
+  civ_symbol_t *district_ids;
+  uint32_t     *district_first;  /* district_count + 1 offsets into blocs */
+  float        *district_voters;
+  int          *district_seats;  /* scratch: last tally's */
+  struct civ_seat_remainder *district_remainder; /* scratch: apportioning */
+  size_t        district_count, district_capacity;
+
+  float  *utility;         /* scratch: candidate-major, bloc_capacity each */
+  float  *district_votes;  /* scratch: district x CIV_ELECTION_MAX_CANDIDATES */
+  size_t  scratch_blocs;
+  size_t  scratch_districts;
+} civ_electorate_t;
+
 typedef struct {
   char   id[STRING_SHORT_LEN], name[STRING_MEDIUM_LEN];
   char   npc_id[STRING_SHORT_LEN];
@@ -40,6 +94,9 @@ typedef struct {
   float  funding;              /* campaign resources */
   int    debates_won;
   bool   is_incumbent;
+  float  stance;               /* -1.0–1.0 on the electorate's ideology axis */
+  float  votes;                /* last tally */
+  int    seats;
 } civ_candidate_t;
 
 typedef struct {
@@ -65,10 +122,13 @@ typedef struct {
   float voter_trust;            /* 0.0–1.0 */
   float electoral_fairness;     /* 0.0–1.0, affected by corruption */
   int   total_elections_held;
+  civ_electorate_t electorate;  /* empty = one national district */
 } civ_election_system_t;
 
 civ_election_system_t *civ_election_create(void);
+void civ_election_init(civ_election_system_t *es);
 void civ_election_destroy(civ_election_system_t *es);
+void civ_election_free(civ_election_system_t *es);
 void civ_election_update(civ_election_system_t *es, float dt,
                          int total_population, float corruption,
                          float representation, float citizen_happiness,
@@ -84,8 +144,26 @@ civ_candidate_t *civ_election_add_candidate(civ_election_t *e,
                                              const char *party_id, bool incumbent);
 void civ_election_campaign(civ_election_t *e, float dt,
                            float literacy, float media_freedom);
-void civ_election_tally_votes(civ_election_t *e);
+/* Votes over electorate (NULL or empty: one national district of
+   e->eligible_voters), then seats by e->type */
+void civ_election_tally_votes(civ_election_t *e, civ_electorate_t *electorate);
+
+/* ── Electorate ─────────────────────────────────────────────────── */
+void civ_electorate_clear(civ_electorate_t *el);
+/* Add a district of voters per class, spread over the ideology buckets
+   around lean + the class's lean */
+civ_result_t civ_electorate_add_district(civ_electorate_t *el, civ_symbol_t id,
+                                         const float voters[CIV_VOTER_CLASS_COUNT],
+                                         float lean);
+/* One district per population region, classes from its age cohorts; lean
+   by region index, or NULL for none */
+civ_result_t civ_electorate_from_population(civ_electorate_t *el,
+                                            const civ_population_manager_t *pm,
+                                            const float *lean);
+/* Most seats, then most support */
 civ_candidate_t *civ_election_winner(const civ_election_t *e);
+/* Whether an election tallies on the next update */
+bool civ_election_due(const civ_election_system_t *es);
 float civ_election_turnout_rate(const civ_election_t *e);
 float civ_election_representation_quality(const civ_election_system_t *es);
 
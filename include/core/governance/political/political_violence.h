@@ -49,10 +49,13 @@ typedef struct {
   int   total_casualties;
   int   coups_attempted;
   int   coups_succeeded;
+  int   civil_wars_pending;  /* broke out, not yet split off by the game */
 } civ_political_violence_t;
 
 civ_political_violence_t *civ_political_violence_create(void);
+void civ_political_violence_init(civ_political_violence_t *pv);
 void civ_political_violence_destroy(civ_political_violence_t *pv);
+void civ_political_violence_free(civ_political_violence_t *pv);
 void civ_political_violence_update(civ_political_violence_t *pv, float dt,
                                    float militarization, float centralization,
                                    float legitimacy, float stability,
@@ -1,6 +1,13 @@
 /**
  * @file subdivision.h
  * @brief Administrative Hierarchy (States, Colonies, Provinces)
+ *
+ * A subdivision holds its tiles as sorted runs of consecutive tile indices,
+ * which in a row-major map are stretches of a row, so a province of a few
+ * thousand tiles is a few dozen spans. Per-province sums of a map-aligned
+ * value are one pass over the spans, cached on the subdivision. The plane
+ * is the reverse map, one id per tile, for "which province is this tile
+ * in" without a search.
  */
 
 #ifndef CIVILIZATION_SUBDIVISION_H
@@ -17,6 +24,24 @@ typedef enum {
   CIV_SUBDIVISION_OCCUPIED   /* Captured territory under transition */
 } civ_subdivision_type_t;
 
+/* Per-subdivision sums of map-aligned values: X(ID) */
+#define CIV_SUBDIVISION_AGGREGATES(X)                                          \
+  X(POPULATION) /* population density */                                     \
+  X(INFLUENCE)  /* political influence */
+
+typedef enum {
+#define CIV_SUBDIVISION_AGGREGATE_ENUM(id) CIV_SUBDIVISION_AGGREGATE_##id,
+  CIV_SUBDIVISION_AGGREGATES(CIV_SUBDIVISION_AGGREGATE_ENUM)
+#undef CIV_SUBDIVISION_AGGREGATE_ENUM
+  CIV_SUBDIVISION_AGGREGATE_COUNT
+} civ_subdivision_aggregate_t;
+
+/* Tiles first .. first + count - 1 */
+typedef struct {
+  uint32_t first;
+  uint32_t count;
+} civ_subdivision_span_t;
+
 /* Subdivision Structure */
 typedef struct {
   char id[STRING_SHORT_LEN];
@@ -26,10 +51,14 @@ typedef struct {
   civ_float_t autonomy;  /* 0.0 (Direct Rule) to 1.0 (High Autonomy) */
   civ_float_t stability; /* Local stability metric */
 
-  /* Territorial Definition */
-  uint32_t *tile_indices;
+  /* Territorial Definition: disjoint spans, ascending */
+  civ_subdivision_span_t *spans;
+  size_t span_count;
+  size_t span_capacity;
   size_t tile_count;
-  size_t tile_capacity;
+
+  /* Sums over the tiles as of the last civ_subdivision_manager_aggregate */
+  civ_float_t aggregate[CIV_SUBDIVISION_AGGREGATE_COUNT];
 
   /* Settlement Membership (subset of the nation's settlements) */
   char **settlement_ids;
@@ -43,19 +72,57 @@ typedef struct {
   size_t capacity;
 } civ_subdivision_manager_t;
 
+/* Map-aligned subdivision ids: subdivision index + 1 within the owning
+   nation's manager, 0 = none */
+typedef struct {
+  uint16_t *ids;
+  size_t tile_count;
+} civ_subdivision_plane_t;
+
 /* Functions */
 civ_subdivision_manager_t *civ_subdivision_manager_create(void);
+void civ_subdivision_manager_init(civ_subdivision_manager_t *manager);
 void civ_subdivision_manager_destroy(civ_subdivision_manager_t *manager);
+void civ_subdivision_manager_free(civ_subdivision_manager_t *manager);
 
 civ_subdivision_t *civ_subdivision_create(civ_subdivision_manager_t *manager,
                                           const char *name,
                                           civ_subdivision_type_t type);
 
 void civ_subdivision_add_tile(civ_subdivision_t *sub, uint32_t tile_index);
+void civ_subdivision_remove_tile(civ_subdivision_t *sub, uint32_t tile_index);
+bool civ_subdivision_has_tile(const civ_subdivision_t *sub,
+                              uint32_t tile_index);
+/* Sum of values[tile] over the subdivision's tiles */
+civ_float_t civ_subdivision_sum(const civ_subdivision_t *sub,
+                                const float *values);
 void civ_subdivision_add_settlement(civ_subdivision_t *sub,
                                     const char *settlement_id);
 
+/* Cache every subdivision's sum of a map-aligned array */
+void civ_subdivision_manager_aggregate(civ_subdivision_manager_t *manager,
+                                       civ_subdivision_aggregate_t aggregate,
+                                       const float *values);
+
+/* Stability drift; reads only the subdivisions, never their tiles */
 void civ_subdivision_update(civ_subdivision_manager_t *manager,
                             civ_float_t time_delta);
 
+civ_subdivision_plane_t *civ_subdivision_plane_create(size_t tile_count);
+void civ_subdivision_plane_destroy(civ_subdivision_plane_t *plane);
+/* Subdivision index of a tile, -1 if none */
+static inline int civ_subdivision_plane_at(const civ_subdivision_plane_t *plane,
+                                           size_t tile) {
+  return tile < plane->tile_count ? (int)plane->ids[tile] - 1 : -1;
+}
+/* Move a tile into subdivision index of manager, out of whatever it was in;
+   the plane's old id must refer to the same manager */
+void civ_subdivision_assign_tile(civ_subdivision_manager_t *manager,
+                                 civ_subdivision_plane_t *plane, size_t index,
+                                 uint32_t tile);
+/* Take a tile out of its subdivision in manager */
+void civ_subdivision_release_tile(civ_subdivision_manager_t *manager,
+                                  civ_subdivision_plane_t *plane,
+                                  uint32_t tile);
+
 #endif /* CIVILIZATION_SUBDIVISION_H */
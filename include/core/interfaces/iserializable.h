@@ -8,6 +8,7 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include <string.h>
 
 /* Serializable interface */
 typedef struct civ_serializable {
@@ -17,5 +18,42 @@ typedef struct civ_serializable {
     size_t (*get_serialized_size)(const void* object);
 } civ_serializable_t;
 
-#endif /* CIVILIZATION_ISERIALIZABLE_H */
+/* Cursor for implementing the interface. Puts past the end of the buffer
+   only count, so one put sequence over a NULL buffer measures the size and
+   the same sequence over a real one fills it; gets past the end fail and
+   leave the destination zeroed. */
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t pos;
+    bool overflow;
+} civ_ser_cursor_t;
+
+static inline civ_ser_cursor_t civ_ser_cursor(void* data, size_t size) {
+    civ_ser_cursor_t c = {(uint8_t*)data, data ? size : 0, 0, false};
+    return c;
+}
+
+static inline void civ_ser_put(civ_ser_cursor_t* c, const void* src, size_t n) {
+    if (n == 0) return; /* src and data may both be NULL then */
+    if (c->pos + n <= c->size) memcpy(c->data + c->pos, src, n);
+    else c->overflow = true;
+    c->pos += n;
+}
 
+static inline bool civ_ser_get(civ_ser_cursor_t* c, void* dst, size_t n) {
+    if (n == 0) return !c->overflow;
+    if (c->overflow || c->pos + n > c->size) {
+        c->overflow = true;
+        memset(dst, 0, n);
+        return false;
+    }
+    memcpy(dst, c->data + c->pos, n);
+    c->pos += n;
+    return true;
+}
+
+#define CIV_SER_PUT(c, v) civ_ser_put((c), &(v), sizeof(v))
+#define CIV_SER_GET(c, v) civ_ser_get((c), &(v), sizeof(v))
+
+#endif /* CIVILIZATION_ISERIALIZABLE_H */
@@ -48,6 +48,8 @@ double civ_knowledge_cost(double current_level, double base_cost,
 
 /**
  * @brief Apply research points to a knowledge domain
+ * Cost accrues continuously along the civ_knowledge_cost curve, so the new
+ * level is solved in closed form from its integral whatever the points.
  * Returns actual advancement achieved
  */
 double civ_knowledge_advance(double *knowledge, double research_points,
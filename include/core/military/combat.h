@@ -9,6 +9,10 @@
 #include "../../common.h"
 #include "../../types.h"
 #include "units.h"
+#include "../environment/climate.h"
+#include "../world/map_generator.h"
+
+struct civ_worker_pool;
 
 /* Combat phase enumeration */
 typedef enum {
@@ -19,6 +23,28 @@ typedef enum {
   CIV_COMBAT_PHASE_AFTERMATH
 } civ_combat_phase_t;
 
+/* Ground and weather a battle is fought in; modifiers are tables by these */
+typedef enum {
+  CIV_COMBAT_TERRAIN_PLAINS = 0,
+  CIV_COMBAT_TERRAIN_FOREST,
+  CIV_COMBAT_TERRAIN_MOUNTAINS,
+  CIV_COMBAT_TERRAIN_URBAN,
+  CIV_COMBAT_TERRAIN_RIVER,
+  CIV_COMBAT_TERRAIN_FORTIFIED,
+  CIV_COMBAT_TERRAIN_COUNT
+} civ_combat_terrain_t;
+
+typedef enum {
+  CIV_WEATHER_CLEAR = 0,
+  CIV_WEATHER_RAIN,
+  CIV_WEATHER_FOG,
+  CIV_WEATHER_SNOW,
+  CIV_WEATHER_STORM,
+  CIV_WEATHER_COUNT
+} civ_weather_t;
+
+#define CIV_WEATHER_CELL 16 /* tiles per side of a weather cell */
+
 /* Combat result structure */
 typedef struct {
   char victor[STRING_SHORT_LEN];
@@ -29,13 +55,99 @@ typedef struct {
   int32_t duration;
 } civ_combat_result_t;
 
+/* One combat log entry */
+typedef struct {
+  int32_t turn;                /* -1 for simulate_battle */
+  civ_symbol_t attacker;       /* unit name, or nation for simulate_battle */
+  civ_symbol_t defender;
+  int32_t casualties_attacker;
+  int32_t casualties_defender;
+  civ_symbol_t attacker_side;  /* owning nations; the nations themselves for */
+  civ_symbol_t defender_side;  /* simulate_battle */
+  int32_t front;               /* weather cell fought in; -1 = unknown */
+  uint16_t battle;             /* which of its turn's battles; 0 for simulated */
+  bool attacker_won;
+} civ_combat_record_t;
+
+/* ── War ledger ───────────────────────────────────────────────────────
+ * Every recorded battle between two sides is added to their war's running
+ * totals, so war weariness and AI evaluation read a war's cost directly.
+ * Side 0 is the side with the lower symbol. A war keeps its recent battles
+ * in a ring and totals for up to CIV_COMBAT_WAR_FRONTS fronts (weather
+ * cells); a new front past that takes over the one quiet the longest.
+ * Ground won counts battles a side won as the attacker.
+ */
+#define CIV_COMBAT_WAR_LEDGER 32
+#define CIV_COMBAT_WAR_FRONTS 8
+
+typedef struct {
+  int32_t cell;
+  int32_t battles;
+  int64_t casualties[2];
+  int32_t ground_won[2];
+  int32_t first_turn, last_turn; /* turns from the records; -1 = simulated */
+} civ_combat_front_t;
+
+typedef struct {
+  civ_symbol_t sides[2];
+  int32_t battles;
+  int32_t wins[2];
+  int64_t casualties[2];
+  int32_t ground_won[2];
+  int32_t first_turn, last_turn;
+  civ_combat_front_t fronts[CIV_COMBAT_WAR_FRONTS];
+  int32_t front_count;
+  civ_combat_record_t ledger[CIV_COMBAT_WAR_LEDGER]; /* ring */
+  uint32_t ledger_head;
+  uint32_t ledger_count;
+} civ_combat_war_t;
+
+/* A unit attacking another; units that die first are dropped */
+typedef struct {
+  civ_unit_handle_t attacker;
+  civ_unit_handle_t defender;
+} civ_engagement_t;
+
+/* Engagements resolved per civ_combat_system_resolve_turn; battles beyond
+   it wait for the next turn, and one battle larger than it is fought
+   over several */
+#define CIV_COMBAT_TURN_BUDGET 2048
+#define CIV_COMBAT_LOG_CAPACITY 256
+
 /* Combat system structure */
 typedef struct {
-  civ_float_t *terrain_modifiers;
-  civ_float_t *weather_modifiers;
-  civ_combat_result_t *combat_history;
-  size_t history_count;
-  size_t history_capacity;
+  civ_float_t *terrain_modifiers; /* CIV_COMBAT_TERRAIN_COUNT, on both sides */
+  civ_float_t *weather_modifiers; /* CIV_WEATHER_COUNT */
+
+  /* Weather by CIV_WEATHER_CELL cell, redrawn each turn; NULL = clear */
+  uint8_t *weather;
+  int32_t weather_cols, weather_rows;
+
+  civ_combat_war_t *wars;
+  size_t war_count;
+  size_t war_capacity;
+
+  /* simulate_battle sums these units by owner; NULL = fixed strengths */
+  const civ_unit_manager_t *units;
+
+  /* Ring of the last CIV_COMBAT_LOG_CAPACITY records */
+  civ_combat_record_t *log;
+  size_t log_head; /* next slot written */
+  size_t log_count;
+
+  /* Engagements queued for the next resolve */
+  civ_engagement_t *engagements;
+  size_t engagement_count;
+  size_t engagement_capacity;
+
+  /* Resolve scratch, by unit index and by engagement */
+  int32_t *unit_parent;
+  int32_t *unit_battle;
+  size_t unit_capacity;
+  civ_engagement_t *resolved;   /* by engagement: the units' indices */
+  uint32_t *order;              /* engagements grouped by battle */
+  civ_combat_record_t *results; /* by position in order; turn -1 = not fought */
+  size_t order_capacity;
 } civ_combat_system_t;
 
 /* Function declarations */
@@ -52,11 +164,98 @@ civ_float_t civ_combat_system_calculate_effectiveness(civ_combat_system_t *cs,
                                                       const char *terrain,
                                                       const char *weather);
 
+/* ── Turn combat phase ────────────────────────────────────────────────
+ * Units attack by queueing engagements during the turn. resolve_turn
+ * groups them into battles — engagements linked by a shared unit — and
+ * resolves the battles in parallel on pool, each with its own stream keyed
+ * by (seed, turn, its first attacker's handle), engagements in queue order
+ * within a battle. Deaths and log records are applied afterwards in queue order,
+ * so results are the same on any number of workers.
+ */
+bool civ_combat_system_queue_engagement(civ_combat_system_t *cs,
+                                        civ_unit_handle_t attacker,
+                                        civ_unit_handle_t defender);
+
+/* Engagements resolved; map may be NULL (open ground everywhere) */
+size_t civ_combat_system_resolve_turn(civ_combat_system_t *cs,
+                                      civ_unit_manager_t *um,
+                                      const civ_map_t *map,
+                                      struct civ_worker_pool *pool,
+                                      uint64_t seed, int32_t turn);
+
+/* Draw each cell's weather for turn from the climate of its centre tile
+   in month (1-12); NULL climate leaves every cell clear */
+void civ_combat_system_update_weather(civ_combat_system_t *cs,
+                                      const civ_map_t *map,
+                                      const civ_climate_t *climate,
+                                      uint64_t seed, int32_t turn, int month);
+civ_weather_t civ_combat_system_weather_at(const civ_combat_system_t *cs,
+                                           int32_t x, int32_t y);
+/* Combat ground of a tile; plains off the map or without one */
+civ_combat_terrain_t civ_combat_terrain_at(const civ_map_t *map, int32_t x,
+                                           int32_t y);
+civ_float_t civ_combat_system_terrain_factor(const civ_combat_system_t *cs,
+                                             civ_combat_terrain_t terrain);
+civ_float_t civ_combat_system_weather_factor(const civ_combat_system_t *cs,
+                                             civ_weather_t weather);
+
+void civ_combat_system_bind_units(civ_combat_system_t *cs,
+                                  const civ_unit_manager_t *um);
+
+/* The war between two sides in either order, or NULL */
+const civ_combat_war_t *civ_combat_system_war(const civ_combat_system_t *cs,
+                                              civ_symbol_t a, civ_symbol_t b);
+/* Casualties side has taken over all its wars */
+int64_t civ_combat_system_losses(const civ_combat_system_t *cs,
+                                 civ_symbol_t side);
+/* Forget a war once peace is made */
+void civ_combat_system_end_war(civ_combat_system_t *cs, civ_symbol_t a,
+                               civ_symbol_t b);
+
+/* Most recent log records first */
+size_t civ_combat_system_recent(const civ_combat_system_t *cs, size_t max,
+                                civ_combat_record_t *out);
+
 /**
  * Simulate a direct skirmish between two units
  */
-civ_combat_result_t civ_combat_unit_vs_unit(civ_unit_t *attacker,
-                                            civ_unit_t *defender,
+civ_combat_result_t civ_combat_unit_vs_unit(civ_unit_manager_t *um,
+                                            size_t attacker, size_t defender,
                                             const char *terrain);
 
+/* Default modifiers by name; 1.0 for NULL or unknown names */
+civ_float_t civ_combat_terrain_modifier(const char *terrain);
+civ_float_t civ_combat_weather_modifier(const char *weather);
+
+/* ── Battle forecasts ─────────────────────────────────────────────────
+ * Monte Carlo estimate of a battle between two stacks: each trial fights
+ * CIV_BATTLE_ROUNDS rounds in which both sides hit for their strength
+ * times a random factor in [0.5, 1.5). Trials run several SIMD lanes at a
+ * time, trial t of case c drawing from its own stream keyed by (seed, c, t);
+ * lanes do the scalar tail's arithmetic, so forecasts depend only on the
+ * cases and the seed.
+ */
+#define CIV_BATTLE_ROUNDS 20
+#define CIV_BATTLE_TRIALS 64 /* a good default for AI planning */
+
+typedef struct {
+  float attacker_strength; /* civ_combat_unit_power summed over the stack */
+  float defender_strength;
+  float terrain_modifier;  /* on the attacker */
+  float weather_modifier;  /* on both sides */
+} civ_battle_case_t;
+
+typedef struct {
+  float win_probability;   /* attacker ends stronger */
+  float attacker_losses;   /* expected fraction of the stack lost */
+  float defender_losses;
+} civ_battle_forecast_t;
+
+/* A unit's share of a stack's strength */
+civ_float_t civ_combat_unit_power(const civ_unit_manager_t *um, size_t index);
+
+void civ_combat_forecast_batch(const civ_battle_case_t *cases, size_t n,
+                               uint32_t trials, uint64_t seed,
+                               civ_battle_forecast_t *out);
+
 #endif /* CIVILIZATION_COMBAT_H */
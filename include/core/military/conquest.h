@@ -10,6 +10,7 @@
 #include "../../types.h"
 #include "../world/territory.h"
 #include "../world/map_generator.h"
+#include "../world/border_frontier.h"
 #include "../culture/cultural_assimilation.h"
 
 /* Conquest type */
@@ -58,6 +59,9 @@ typedef struct {
     
     civ_float_t base_conquest_rate;
     civ_float_t plunder_multiplier;
+
+    /* Contact tiles per owner pair, attached to the map on first transfer */
+    civ_border_frontier_t* frontier;
 } civ_conquest_system_t;
 
 /* Function declarations */
@@ -70,7 +74,9 @@ civ_result_t civ_conquest_start(civ_conquest_system_t* system,
                                 const char* target_region_id, civ_conquest_type_t type);
 civ_result_t civ_conquest_update(civ_conquest_system_t* system, civ_float_t time_delta);
 
-/* Transfer territory from defender to attacker when conquest completes.
+/* Transfer territory from defender to attacker when conquest completes:
+   the defender's land tiles touching the attacker, taken from the border
+   frontier, so the cost follows the front length rather than the map.
    nation_manager is civ_nation_manager_t*, passed as void* to avoid circular include. */
 int civ_conquest_transfer_territory(civ_conquest_system_t *system, civ_map_t *map,
                                      void *nation_manager);
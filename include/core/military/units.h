@@ -8,6 +8,8 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include "../interfaces/iserializable.h"
+#include "../../utils/symbol.h"
 
 /* Unit type enumeration */
 typedef enum {
@@ -21,31 +23,64 @@ typedef enum {
   CIV_UNIT_TYPE_SETTLER
 } civ_unit_type_t;
 
-/* Unit structure */
+/* Cold per-unit data; what movement and rendering do not read */
 typedef struct {
   char id[STRING_SHORT_LEN];
   char name[STRING_MEDIUM_LEN];
+  civ_symbol_t name_sym; /* name interned, rebuilt on load */
   civ_unit_type_t unit_type;
   civ_float_t combat_strength;
   civ_float_t movement_speed;
   civ_float_t supply_consumption;
   civ_float_t morale;
   civ_float_t experience;
-  int32_t current_strength;
   int32_t max_strength;
-  int32_t x;
-  int32_t y;
   int32_t visibility_range;
-  bool has_moved;
   int32_t level;
   civ_float_t next_level_xp;
 } civ_unit_t;
 
-/* Unit manager structure */
+/* Hot per-unit columns: X(type, name) */
+#define CIV_UNIT_HOT_FIELDS(X)                                                   X(int32_t, x)                                                                  X(int32_t, y)                                                                  X(int32_t, strength)      /* current strength */                               X(uint8_t, moved)         /* has moved this turn */                            X(civ_symbol_t, owner)    /* CIV_SYMBOL_NONE = nobody's */                     X(int32_t, hash_bucket)   /* -1 = not hashed */                                X(int32_t, hash_next)     /* next unit in the bucket, -1 ends */               X(uint32_t, slot)         /* the handle slot naming this unit */
+
+/* A unit for as long as it lives: slot in the low bits, the slot's
+   generation above. A handle to a unit that has died never resolves, even
+   once its slot is reused. */
+typedef uint32_t civ_unit_handle_t;
+#define CIV_UNIT_HANDLE_NONE ((civ_unit_handle_t)0)
+#define CIV_UNIT_SLOT_BITS 20
+#define CIV_UNIT_SLOT_MASK ((1u << CIV_UNIT_SLOT_BITS) - 1)
+#define CIV_UNIT_MAX ((size_t)CIV_UNIT_SLOT_MASK)
+
+/* Spatial hash: living units are chained by index into buckets keyed by
+   their CIV_UNIT_CELL_SIZE-tile cell. Positions must change through
+   civ_unit_manager_move_unit and deaths through civ_unit_manager_kill_unit
+   (or update_strength) so the hash stays in step with the columns. */
+#define CIV_UNIT_CELL_SHIFT 4 /* 16x16-tile cells */
+#define CIV_UNIT_CELL_SIZE (1 << CIV_UNIT_CELL_SHIFT)
+#define CIV_UNIT_HASH_BUCKETS 4096 /* power of two */
+
+/* Unit manager: units are dense indices [0, unit_count) into the hot
+   columns and the cold units array, every one of them alive. A death
+   moves the last unit into the dead one's index, so indices are good
+   until the next kill; hold a handle across turns or frames. */
 typedef struct {
-  civ_unit_t *units;
   size_t unit_count;
   size_t unit_capacity;
+  civ_unit_t *units;
+#define CIV_UNIT_HOT_DECL(type, name) type *name;
+  CIV_UNIT_HOT_FIELDS(CIV_UNIT_HOT_DECL)
+#undef CIV_UNIT_HOT_DECL
+
+  /* Slot map: per slot, the unit's index and the slot's generation */
+  uint32_t *slot_index; /* next free slot while the slot is free */
+  uint32_t *slot_generation;
+  size_t slot_count;
+  size_t slot_capacity;
+  uint32_t free_slot;   /* UINT32_MAX = none */
+
+  int32_t *bucket_heads; /* CIV_UNIT_HASH_BUCKETS first unit indices */
+  uint64_t next_serial;  /* number in the next unit id */
 } civ_unit_manager_t;
 
 /* Function declarations */
@@ -53,18 +88,55 @@ civ_unit_manager_t *civ_unit_manager_create(void);
 void civ_unit_manager_destroy(civ_unit_manager_t *um);
 void civ_unit_manager_init(civ_unit_manager_t *um);
 
-civ_unit_t *civ_unit_manager_create_unit(civ_unit_manager_t *um,
-                                         civ_unit_type_t type, const char *name,
-                                         int32_t size);
-civ_unit_t *civ_unit_manager_spawn_unit(civ_unit_manager_t *um,
-                                        civ_unit_type_t type, const char *name,
-                                        int32_t size, int32_t x, int32_t y);
+civ_unit_handle_t civ_unit_manager_create_unit(civ_unit_manager_t *um,
+                                               civ_unit_type_t type,
+                                               const char *name, int32_t size);
+civ_unit_handle_t civ_unit_manager_spawn_unit(civ_unit_manager_t *um,
+                                              civ_unit_type_t type,
+                                              const char *name, int32_t size,
+                                              int32_t x, int32_t y);
 void civ_unit_manager_recruit_units(civ_unit_manager_t *um,
                                     const char *nation_id, civ_unit_type_t type,
                                     int32_t count, civ_float_t quality);
 bool civ_unit_manager_update_strength(civ_unit_manager_t *um,
                                       const char *unit_id, int32_t casualties,
                                       int32_t prisoners);
+/* Take losses off the unit at index, killing it at zero strength (the
+   last unit then takes its index). @return Whether it died */
+bool civ_unit_manager_apply_losses(civ_unit_manager_t *um, size_t index,
+                                   int32_t losses);
 void civ_unit_check_level_up(civ_unit_t *unit);
 
+/* Index of a living unit, -1 once it has died */
+int32_t civ_unit_manager_resolve(const civ_unit_manager_t *um,
+                                 civ_unit_handle_t handle);
+civ_unit_handle_t civ_unit_manager_handle(const civ_unit_manager_t *um,
+                                          size_t index);
+/* Index of the unit with this id, -1 if none */
+int32_t civ_unit_manager_find(const civ_unit_manager_t *um, const char *id);
+void civ_unit_manager_set_owner(civ_unit_manager_t *um, size_t index,
+                                civ_symbol_t owner);
+
+/* Spatial queries over living units */
+void civ_unit_manager_move_unit(civ_unit_manager_t *um, size_t index,
+                                int32_t x, int32_t y);
+/* Removes the unit; the last unit takes its index */
+void civ_unit_manager_kill_unit(civ_unit_manager_t *um, size_t index);
+/* Index of a unit on (x, y) other than ignore (-1 for none), or -1 */
+int32_t civ_unit_manager_unit_at(const civ_unit_manager_t *um, int32_t x,
+                                 int32_t y, int32_t ignore);
+bool civ_unit_manager_is_occupied(const civ_unit_manager_t *um, int32_t x,
+                                  int32_t y, int32_t ignore);
+/* Indices of living units with x0 <= x <= x1 and y0 <= y <= y1. Writes at
+   most max indices, sorted ascending; returns the total number found. */
+size_t civ_unit_manager_query_rect(const civ_unit_manager_t *um, int32_t x0,
+                                   int32_t y0, int32_t x1, int32_t y1,
+                                   size_t *out, size_t max);
+
+/* Save section: every unit, cold fields then hot columns; loading replaces
+   them and rebuilds the hash, handing out fresh handles. Version 1
+   sections, one packed struct per unit, still load. */
+#define CIV_UNIT_SAVE_VERSION 2
+civ_serializable_t civ_unit_manager_serializable(civ_unit_manager_t *um);
+
 #endif /* CIVILIZATION_UNITS_H */
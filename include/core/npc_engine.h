@@ -5,12 +5,22 @@
  * Each nation has NPC actors (leaders, ministers, influential figures)
  * who make decisions based on ideology, national state, relationships,
  * and historical context. Decisions produce events that shape history.
+ *
+ * NPCs are dense ids into parallel arrays, never removed, and each nation
+ * keeps the ids of its own. A turn visits nations, not NPCs: a nation acts
+ * when its state moved since its NPCs last looked (land lost or gained,
+ * growth, jobs or prices worsening), or after a few quiet turns, and the
+ * NPC whose influence and leanings fit the occasion best answers it.
+ * Decisions are stored as template references; their text is formatted
+ * only when asked for, by civ_npc_engine_describe.
  */
 #ifndef CIV_CORE_NPC_ENGINE_H
 #define CIV_CORE_NPC_ENGINE_H
 
 #include "../common.h"
 #include "../types.h"
+#include "../utils/symbol.h"
+#include "interfaces/iserializable.h"
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -18,70 +28,160 @@
 extern "C" {
 #endif
 
-#define CIV_NPC_NAME_MAX   48
-#define CIV_NPC_MAX         8  /* per nation */
+#define CIV_NPC_NAME_MAX     48
+#define CIV_NPC_ROLE_MAX     48
+#define CIV_NPC_NATION_MAX   32
 #define CIV_NPC_DECISION_MAX 64
+#define CIV_NPC_TEXT_MAX     192 /* longest described decision */
+
+/* ── NPC ideology axes: X(name), 0 = first pole, 1 = second ─────── */
+#define CIV_NPC_IDEOLOGY_AXES(X)                                               \
+  X(traditional_vs_progressive)                                                \
+  X(authoritarian_vs_liberal)                                                  \
+  X(nationalist_vs_globalist)                                                  \
+  X(militarist_vs_pacifist)                                                    \
+  X(mercantile_vs_agrarian)                                                    \
+  X(religious_vs_secular)
+
+typedef enum {
+#define CIV_NPC_AXIS_ENUM(name) CIV_NPC_AXIS_##name,
+  CIV_NPC_IDEOLOGY_AXES(CIV_NPC_AXIS_ENUM)
+#undef CIV_NPC_AXIS_ENUM
+  CIV_NPC_AXIS_COUNT
+} civ_npc_axis_t;
 
-/* ── NPC ideology axes ──────────────────────────────────────────── */
 typedef struct {
-  float traditional_vs_progressive;  /* 0=traditional, 1=progressive */
-  float authoritarian_vs_liberal;   /* 0=authoritarian, 1=liberal */
-  float nationalist_vs_globalist;   /* 0=nationalist, 1=globalist */
-  float militarist_vs_pacifist;     /* 0=militarist, 1=pacifist */
-  float mercantile_vs_agrarian;     /* 0=mercantile, 1=agrarian */
-  float religious_vs_secular;       /* 0=religious, 1=secular */
+#define CIV_NPC_AXIS_FIELD(name) float name;
+  CIV_NPC_IDEOLOGY_AXES(CIV_NPC_AXIS_FIELD)
+#undef CIV_NPC_AXIS_FIELD
 } civ_npc_ideology_t;
 
-/* ── NPC actor ──────────────────────────────────────────────────── */
+/* Per-NPC numbers: X(name) */
+#define CIV_NPC_FIELDS(X)                                                      \
+  X(influence)  /* 0-1, how much they affect decisions */                      \
+  X(corruption) /* 0-1, likelihood of self-serving actions */                  \
+  X(competence) /* 0-1, effectiveness at their role */
+
+/* ── NPC actor, read back by civ_npc_engine_get ─────────────────── */
 typedef struct {
-  char           name[CIV_NPC_NAME_MAX];
-  char           role[48];        /* "President", "Minister of Trade", etc. */
+  const char        *name;
+  const char        *role;       /* "President", "Minister of Trade", etc. */
+  const char        *nation_id;  /* which nation they belong to */
   civ_npc_ideology_t ideology;
-  float          influence;       /* 0-1, how much they affect decisions */
-  float          corruption;      /* 0-1, likelihood of self-serving actions */
-  float          competence;      /* 0-1, effectiveness at their role */
-  int32_t        age;
-  char           nation_id[32];   /* which nation they belong to */
+  float              influence;
+  float              corruption;
+  float              competence;
+  int32_t            age;
 } civ_npc_t;
 
-/* ── Decision outcome ───────────────────────────────────────────── */
+typedef enum {
+  CIV_NPC_MILITARY,
+  CIV_NPC_ECONOMIC,
+  CIV_NPC_POLITICAL,
+  CIV_NPC_SOCIAL,
+  CIV_NPC_DIPLOMATIC,
+  CIV_NPC_CATEGORY_COUNT
+} civ_npc_category_t;
+
+/* What made a nation's NPCs act */
+typedef enum {
+  CIV_NPC_TRIGGER_QUIET,            /* nothing happened for a while */
+  CIV_NPC_TRIGGER_TERRITORY_LOST,
+  CIV_NPC_TRIGGER_TERRITORY_GAINED,
+  CIV_NPC_TRIGGER_RECESSION,        /* growth fell */
+  CIV_NPC_TRIGGER_UNEMPLOYMENT,
+  CIV_NPC_TRIGGER_INFLATION,
+  CIV_NPC_TRIGGER_COUNT
+} civ_npc_trigger_t;
+
+/* ── Decision outcome; text from civ_npc_engine_describe ────────── */
 typedef struct {
-  char     description[192];   /* what happened */
-  char     actor_name[48];     /* who made the decision */
-  char     nation_id[32];      /* which nation */
+  uint32_t actor;              /* NPC id who made the decision */
   int32_t  global_year;        /* when it happened */
   int32_t  global_day;
   float    stability_effect;   /* impact on nation stability */
   float    economic_effect;    /* impact on economy */
   float    diplomatic_effect;  /* impact on foreign relations */
-  uint32_t category;           /* 0=military,1=economic,2=political,3=social,4=diplomatic */
+  uint8_t  category;           /* civ_npc_category_t */
+  uint8_t  trigger;            /* civ_npc_trigger_t */
+  uint8_t  template_index;
+  uint8_t  corrupt;            /* template_index is a scandal */
 } civ_decision_t;
 
+/* A nation's NPCs, and the state they last reacted to */
+typedef struct {
+  civ_symbol_t nation;
+  uint32_t    *ids;
+  uint32_t     count;
+  uint32_t     capacity;
+  int32_t      nation_index;     /* in the nation manager; -1 = not found */
+  int32_t      next_quiet_turn;
+  bool         seen;             /* the fields below hold a real state */
+  int32_t      land_tiles;       /* last turn */
+  int32_t      land_mark;        /* gains are counted from here */
+  float        gdp_growth;       /* best since the last reaction */
+  float        unemployment;     /* lowest since the last reaction */
+  float        inflation;        /* lowest since the last reaction */
+} civ_npc_bucket_t;
+
 /* ── NPC Engine ──────────────────────────────────────────────────── */
 typedef struct {
-  civ_npc_t      *npcs;
-  int32_t         npc_count;
-  int32_t         npc_capacity;
+  uint32_t count;
+  uint32_t capacity;
+  float   *ideology[CIV_NPC_AXIS_COUNT];
+#define CIV_NPC_FIELD_DECL(name) float *name;
+  CIV_NPC_FIELDS(CIV_NPC_FIELD_DECL)
+#undef CIV_NPC_FIELD_DECL
+  int32_t *age;
+  uint32_t *bucket;            /* by NPC: its nation's bucket */
+  char   (*name)[CIV_NPC_NAME_MAX];
+  char   (*role)[CIV_NPC_ROLE_MAX];
+
+  civ_npc_bucket_t *buckets;   /* in order of each nation's first NPC */
+  uint32_t          bucket_count;
+  uint32_t          bucket_capacity;
+  int32_t          *bucket_of; /* by symbol handle; -1 = no NPCs */
+  uint32_t          bucket_of_size;
+  int32_t           nations_seen; /* nation count the indexes were found at */
+
   civ_decision_t  recent_decisions[CIV_NPC_DECISION_MAX];
   int32_t         decision_count;
   int32_t         decision_head; /* ring buffer head */
+  int32_t         turn;          /* turns processed */
 } civ_npc_engine_t;
 
 civ_npc_engine_t *civ_npc_engine_create(void);
 void              civ_npc_engine_destroy(civ_npc_engine_t *eng);
 
-/* Add an NPC to a nation */
-civ_npc_t *civ_npc_engine_add(civ_npc_engine_t *eng, const char *name,
-                              const char *role, const char *nation_id);
+/* Add an NPC to a nation; returns its id, -1 if out of memory */
+int32_t civ_npc_engine_add(civ_npc_engine_t *eng, const char *name,
+                           const char *role, const char *nation_id);
+
+bool civ_npc_engine_get(const civ_npc_engine_t *eng, uint32_t id,
+                        civ_npc_t *out);
 
-/* Process one turn of NPC decisions for all nations */
+/* A nation's NPCs, NULL if it has none */
+const civ_npc_bucket_t *civ_npc_engine_nation(const civ_npc_engine_t *eng,
+                                              const char *nation_id);
+
+/* Process one turn of NPC decisions for all nations; nation_mgr is a
+   civ_nation_manager_t, or NULL to act on quiet turns only */
 void civ_npc_engine_process_turn(civ_npc_engine_t *eng, void *nation_mgr,
                                  int32_t global_year, int32_t global_day);
 
-/* Get recent decisions as a readable string buffer */
+/* Most recent decisions first */
 int  civ_npc_engine_get_recent(civ_npc_engine_t *eng, int max,
                                civ_decision_t *out);
 
+/* Text of a decision; returns what snprintf would */
+int  civ_npc_engine_describe(const civ_npc_engine_t *eng,
+                             const civ_decision_t *d, char *buf, size_t size);
+
+/* Save section: NPCs, nation state and the decision history, oldest
+   decision first. Version 1 sections load without their history. */
+#define CIV_NPC_SAVE_VERSION 2
+civ_serializable_t civ_npc_engine_serializable(civ_npc_engine_t *eng);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,6 +1,14 @@
 /**
  * @file faction_system.h
  * @brief Political faction system
+ *
+ * Stability is kept as an aggregate of faction power and rivalry tension
+ * and moved by deltas: a faction whose power changes pushes the change to
+ * the total, the dominant faction and the rivalries it is part of. Only
+ * awake factions are advanced; one rests once its power and influence
+ * have settled and wakes when its support or a rivalry changes, so a tick
+ * costs in proportion to what moved. Changes worth showing are kept in a
+ * short history for the politics screen.
  */
 
 #ifndef CIVILIZATION_FACTION_SYSTEM_H
@@ -34,11 +42,64 @@ typedef struct {
     time_t creation_time;
 } civ_political_faction_t;
 
+#define CIV_FACTION_REST_EPSILON    1e-4f /* settled below this per update */
+#define CIV_FACTION_RESYNC_INTERVAL 256   /* updates between exact recounts */
+#define CIV_FACTION_CHANGE_STEP     0.01f /* stability move worth reporting */
+#define CIV_FACTION_CHANGE_HISTORY  32
+
+/* Stability change, for the politics screen */
+typedef enum {
+    CIV_FACTION_CHANGE_STABILITY = 0,
+    CIV_FACTION_CHANGE_DOMINANT,
+    CIV_FACTION_CHANGE_RIVALRY
+} civ_faction_change_kind_t;
+
+typedef struct {
+    civ_faction_change_kind_t kind;
+    int32_t faction;     /* the new dominant faction or a rival; -1 = none */
+    int32_t other;       /* the other rival; -1 = none */
+    civ_float_t before;  /* stability, or rivalry intensity */
+    civ_float_t after;
+} civ_faction_change_t;
+
+/* Rivalry edge; intensity 0 = ended, the edge is kept for reuse */
+typedef struct {
+    int32_t faction[2];
+    int32_t next[2];     /* next edge at each end; -1 = last */
+    civ_float_t intensity; /* 0.0 to 1.0 */
+} civ_faction_rivalry_t;
+
 /* Faction system */
 typedef struct {
     civ_political_faction_t* factions;
     size_t faction_count;
     size_t faction_capacity;
+
+    /* Per faction */
+    civ_float_t* counted_power; /* power as it stands in the aggregates */
+    int32_t* rivalry_head;      /* first rivalry edge; -1 = none */
+    uint8_t* awake;
+    uint32_t* active;           /* awake factions */
+    size_t active_count;
+
+    civ_faction_rivalry_t* rivalries;
+    size_t rivalry_count;
+    size_t rivalry_capacity;
+
+    /* Aggregates */
+    civ_float_t total_power;
+    civ_float_t max_power;
+    int32_t dominant;           /* -1 = none */
+    bool dominant_stale;        /* the dominant faction lost power */
+    civ_float_t tension;        /* sum of intensity x power x power */
+    civ_float_t stability;
+    uint32_t updates_since_resync;
+
+    /* Change history, a ring; change_total counts every change made */
+    civ_faction_change_t changes[CIV_FACTION_CHANGE_HISTORY];
+    uint64_t change_total;
+    civ_float_t reported_stability;
+    int32_t reported_dominant;
 } civ_faction_system_t;
 
 /* Function declarations */
@@ -51,7 +112,23 @@ void civ_faction_destroy(civ_political_faction_t* faction);
 civ_result_t civ_faction_system_add(civ_faction_system_t* system, civ_political_faction_t* faction);
 civ_political_faction_t* civ_faction_system_find(const civ_faction_system_t* system, const char* id);
 civ_result_t civ_faction_system_update(civ_faction_system_t* system, civ_float_t time_delta);
+/* The aggregate as of the last change; O(1) */
 civ_float_t civ_faction_system_calculate_stability(const civ_faction_system_t* system);
 
+/* Set a faction's support and wake it */
+civ_result_t civ_faction_system_set_support(civ_faction_system_t* system, size_t faction,
+                                            civ_float_t support);
+/* Re-read a faction after its fields were written directly, and wake it */
+civ_result_t civ_faction_system_touch(civ_faction_system_t* system, size_t faction);
+/* Set the rivalry between two factions; intensity 0 ends it */
+civ_result_t civ_faction_system_set_rivalry(civ_faction_system_t* system, size_t a, size_t b,
+                                            civ_float_t intensity);
+civ_float_t civ_faction_system_rivalry(const civ_faction_system_t* system, size_t a, size_t b);
+/* Recount the aggregates from scratch */
+void civ_faction_system_resync(civ_faction_system_t* system);
+/* The age-th most recent change, 0 = newest; NULL past the history */
+const civ_faction_change_t* civ_faction_system_change(const civ_faction_system_t* system,
+                                                      size_t age);
+
 #endif /* CIVILIZATION_FACTION_SYSTEM_H */
 
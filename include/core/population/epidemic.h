@@ -0,0 +1,105 @@
+/**
+ * @file epidemic.h
+ * @brief SEIR outbreaks over the trade network's settlement graph
+ *
+ * Every settlement is a compartment node holding the shares of its people
+ * who are susceptible, exposed, infectious and recovered from each
+ * disease. Nodes mix along the network's land and sea edges: the
+ * prevalence a node's people meet is its own, plus its neighbours'
+ * weighted by edge cost and by how busy the edge's routes are, times the
+ * disease's travel share. A disease with no incubation is plain SIR.
+ *
+ * Each disease keeps an active set: the nodes where anyone is exposed or
+ * infectious. An update visits those and their neighbours only, so a tick
+ * costs in proportion to the outbreak, not the world. It gathers the
+ * visited nodes' state into packed arrays, steps them all in one
+ * branch-free pass from the state at the start of the update, then
+ * scatters the result back; nodes where the disease has died out leave
+ * the set. Transitions are exact over dt (1 - e^-rate*dt), so any cadence
+ * gives the same rates. Deaths come off the settlements' populations.
+ */
+#ifndef CIVILIZATION_EPIDEMIC_H
+#define CIVILIZATION_EPIDEMIC_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include "../economy/trade_network.h"
+#include "../world/settlement_manager.h"
+
+#define CIV_EPIDEMIC_MAX_DISEASES 16
+#define CIV_EPIDEMIC_EXTINCT      1e-6f  /* exposed + infectious share that ends it */
+#define CIV_EPIDEMIC_REACH_COST   480u   /* edge cost at which mixing halves */
+#define CIV_EPIDEMIC_SEED_RADIUS  16     /* tiles, settlement nearest a seed point */
+
+typedef struct {
+  char name[STRING_MEDIUM_LEN];
+  float beta;            /* infecting contacts per infectious person per day */
+  float incubation_days; /* mean time exposed; 0 = SIR */
+  float infectious_days; /* mean time infectious */
+  float mortality;       /* share of those leaving infectious who die */
+  float travel;          /* mixing with neighbours at edge weight 1 */
+
+  /* Compartment shares by trade network node; s + e + i + r = 1 */
+  float *s, *e, *i, *r;
+
+  uint32_t *active;      /* nodes with anyone exposed or infectious */
+  uint32_t active_count;
+  uint32_t active_capacity;
+  uint64_t *in_active;   /* bit per node */
+
+  float infected;        /* sum of infectious shares over nodes, last update */
+  int64_t deaths;        /* over the disease's life */
+  int64_t cases;         /* people exposed, over the disease's life */
+} civ_epidemic_t;
+
+typedef struct {
+  civ_epidemic_t diseases[CIV_EPIDEMIC_MAX_DISEASES];
+  size_t disease_count;
+
+  uint32_t node_count;
+  uint32_t node_capacity;
+  uint32_t words;        /* of each bitset */
+
+  /* Scratch for one disease's update, sized to the visit set */
+  uint64_t *in_visit;
+  uint32_t *visit;
+  float *vs, *ve, *vi, *vr, *vp, *dead;
+  uint32_t visit_capacity;
+
+  uint32_t plague_seen;  /* disaster number + 1 of the last plague seeded */
+  uint32_t visited;      /* nodes stepped by the last update, all diseases */
+} civ_epidemic_system_t;
+
+civ_epidemic_system_t *civ_epidemic_system_create(void);
+void civ_epidemic_system_destroy(civ_epidemic_system_t *system);
+
+/* Add a disease; its index, or -1 when the table is full */
+int32_t civ_epidemic_define(civ_epidemic_system_t *system, const char *name,
+                            civ_float_t beta, civ_float_t incubation_days,
+                            civ_float_t infectious_days, civ_float_t mortality,
+                            civ_float_t travel);
+
+/* Make share of node's susceptible people infectious with disease */
+civ_result_t civ_epidemic_seed(civ_epidemic_system_t *system, size_t disease,
+                               uint32_t node, civ_float_t share);
+/* Seed the settlement nearest tile (x, y), within CIV_EPIDEMIC_SEED_RADIUS;
+   CIV_ERROR_NOT_FOUND when there is none */
+civ_result_t civ_epidemic_seed_at(civ_epidemic_system_t *system,
+                                  const civ_trade_network_t *net,
+                                  size_t disease, int32_t x, int32_t y,
+                                  civ_float_t share);
+
+/* Step every disease's active set over dt days. Node i is settlement i;
+   settlements may be NULL (the shares move, nobody is counted dead). */
+void civ_epidemic_system_update(civ_epidemic_system_t *system,
+                                const civ_trade_network_t *net,
+                                civ_settlement_manager_t *settlements,
+                                civ_float_t dt);
+
+/* Nodes with an outbreak of any disease */
+uint32_t civ_epidemic_active_count(const civ_epidemic_system_t *system);
+/* disease's infectious share of node, 0 to 1 */
+civ_float_t civ_epidemic_prevalence(const civ_epidemic_system_t *system,
+                                    size_t disease, uint32_t node);
+
+#endif /* CIVILIZATION_EPIDEMIC_H */
@@ -0,0 +1,80 @@
+/**
+ * @file migration.h
+ * @brief People moving between nations along their links
+ *
+ * A gravity model over the technology diffusion's link graph: borders,
+ * trade routes, friendships and treaties joining a pair are also what
+ * carries people between them. Each nation has an attraction from its
+ * wage against the world mean, its government's stability and how well it
+ * feeds itself, less while it is at war. Along every link people flow from
+ * the less attractive nation to the more, in proportion to
+ *
+ *     population x link weight x openness x pull / (1 + distance / scale)
+ *
+ * where openness falls from 1 between allies to none at war, pull is the
+ * attraction ratio less one (at most 2) and distance runs between the
+ * capitals. A nation sends at most max_share of its people a year.
+ *
+ * The pass is one sparse product over the links: rows compute their
+ * outflows, then each row gathers its inflows through the reverse links,
+ * both across the worker pool, and the net per nation is applied at once.
+ * Flows are whole people, so the world population is unchanged.
+ */
+#ifndef CIVILIZATION_MIGRATION_H
+#define CIVILIZATION_MIGRATION_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include "../diplomacy/relations.h"
+#include "../technology/tech_diffusion.h"
+#include "../world/nation.h"
+#include "population_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct civ_worker_pool;
+
+#define CIV_MIGRATION_RATE        0.02f  /* per year, at full weight and pull */
+#define CIV_MIGRATION_MAX_SHARE   0.01f  /* of a nation's people per year */
+#define CIV_MIGRATION_DISTANCE_KM 1000.0f
+
+typedef struct {
+  civ_float_t rate;
+  civ_float_t max_share;
+
+  /* By nation */
+  float *attraction;
+  int32_t *diplomacy_index; /* -1 when not in the relation table */
+  int64_t *net;             /* arrivals less departures, last pass */
+  size_t nation_capacity;
+
+  /* By link of the diffusion graph */
+  float *openness;
+  uint32_t *reverse;        /* the same pair in the target's row */
+  int64_t *flow;            /* people leaving the row's nation */
+  size_t link_capacity;
+
+  int64_t moved;            /* last pass, all nations */
+} civ_migration_t;
+
+civ_migration_t *civ_migration_create(void);
+void civ_migration_destroy(civ_migration_t *migration);
+
+/* One pass over links, which must be linked for nations. Every nation's
+   population takes its net; the player's also goes through
+   player_population's cohorts (may be NULL). diplomacy and pool may be
+   NULL. */
+civ_result_t civ_migration_process(civ_migration_t *migration,
+                                   civ_nation_manager_t *nations,
+                                   const civ_tech_diffusion_t *links,
+                                   const civ_diplomacy_system_t *diplomacy,
+                                   civ_population_manager_t *player_population,
+                                   struct civ_worker_pool *pool,
+                                   civ_float_t time_delta);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* CIVILIZATION_MIGRATION_H */
@@ -1,6 +1,16 @@
 /**
  * @file population_manager.h
  * @brief Population manager system
+ *
+ * Population is kept per region in CIV_COHORT_COUNT five-year age groups,
+ * the last open-ended, as one row of a regions x cohorts matrix. A tick
+ * advances every row by cohort-component steps: each cohort survives at
+ * its mortality, a fifth of it per year moves to the next, births enter
+ * the first, and emigrants leave in proportion to how unattractive the
+ * region is. Emigrants are pooled by age and settle in regions by
+ * attractiveness x population, so migration moves people but never makes
+ * or loses any. Rows advance in blocks on the worker pool, lanes running
+ * along the age groups.
  */
 
 #ifndef CIVILIZATION_POPULATION_MANAGER_H
@@ -8,25 +18,47 @@
 
 #include "../../common.h"
 #include "../../types.h"
-#include "demographics.h"
+#include "../../utils/arena.h"
+#include "../../utils/symbol.h"
+
+struct civ_worker_pool;
+
+#define CIV_COHORT_COUNT      16 /* 0-4, 5-9, ... 70-74, 75+ */
+#define CIV_COHORT_YEARS      5
+#define CIV_COHORT_WORK_FIRST 3  /* 15-19 */
+#define CIV_COHORT_WORK_LAST  12 /* 60-64 */
 
 /* Population manager structure */
 typedef struct {
-    civ_demographics_t* demographics;
+    /* Crude rates per year over the last update, all regions */
     civ_float_t birth_rate;
     civ_float_t death_rate;
-    civ_float_t migration_rate;
+    civ_float_t migration_rate; /* share of people who moved */
     civ_float_t growth_rate;
-    
-    /* Subsystems */
+
+    /* Subsystems; health and education scale every region's mortality
+       and fertility */
     civ_float_t education_quality;
     civ_float_t health_index;
+    civ_float_t air_quality;    /* 1 = clean; scales health_index */
     civ_float_t satisfaction;
-    
-    /* Regional data */
-    char** region_ids;
+
+    /* Regional data: cohorts is region_count x CIV_COHORT_COUNT */
+    civ_symbol_t* region_ids;
+    civ_float_t* cohorts;
+    civ_float_t* attractiveness;   /* 0-1, pull on migrants; default 0.5 */
+    civ_float_t* mortality_scale;  /* regional multipliers, default 1 */
+    civ_float_t* fertility_scale;
+    civ_float_t* region_total;     /* aggregates after the last update */
+    civ_float_t* region_workforce; /* ages 15-64 */
+    civ_float_t* region_emigrants; /* scratch: left this update */
     size_t region_count;
     size_t region_capacity;
+    int32_t* region_of;            /* by symbol handle; -1 = no region */
+    uint32_t region_of_size;
+
+    civ_float_t total;             /* sums of the region aggregates */
+    civ_float_t workforce;
 } civ_population_manager_t;
 
 /* Function declarations */
@@ -34,17 +66,29 @@ civ_population_manager_t* civ_population_manager_create(void);
 void civ_population_manager_destroy(civ_population_manager_t* pm);
 void civ_population_manager_init(civ_population_manager_t* pm);
 
-void civ_population_manager_update(civ_population_manager_t* pm, civ_float_t time_delta, 
-                                   const void* economic_conditions);
-void civ_population_manager_initialize_region(civ_population_manager_t* pm, const char* region_id, 
+/* Advance every region by time_delta years; pool may be NULL */
+void civ_population_manager_update(civ_population_manager_t* pm, civ_float_t time_delta,
+                                   struct civ_worker_pool* pool);
+/* Add a region with a standard age pyramid; nothing if it exists */
+void civ_population_manager_initialize_region(civ_population_manager_t* pm, const char* region_id,
                                              int64_t initial_population);
+/* Region index, -1 if unknown */
+int32_t civ_population_manager_find_region(const civ_population_manager_t* pm, const char* region_id);
 
 int64_t civ_population_manager_get_total(civ_population_manager_t* pm);
+/* People aged 15-64, all regions */
+int64_t civ_population_manager_get_workforce(const civ_population_manager_t* pm);
 civ_float_t civ_population_manager_get_growth_rate(const civ_population_manager_t* pm);
 
+/* People arriving from (people > 0) or leaving for (< 0) other nations,
+   spread over regions and ages like the movers of the cohort step;
+   departures stop at what there is. Returns the change made. */
+civ_float_t civ_population_manager_migrate(civ_population_manager_t* pm, civ_float_t people);
+
 /* Serialization */
 char* civ_population_manager_to_dict(const civ_population_manager_t* pm);
+/* The same string pushed on arena instead of the heap */
+char* civ_population_manager_to_dict_arena(const civ_population_manager_t* pm, civ_arena_t* arena);
 civ_result_t civ_population_manager_from_dict(civ_population_manager_t* pm, const char* json);
 
 #endif /* CIVILIZATION_POPULATION_MANAGER_H */
-
@@ -18,6 +18,8 @@ extern "C" {
 #define CIV_PROFILE_NAME_MAX 32
 #define CIV_PROFILE_ID_MAX 32
 #define CIV_PROFILE_PATH_MAX 64
+#define CIV_SAVE_THUMB_W 64
+#define CIV_SAVE_THUMB_H 32
 
 typedef struct civ_player_profile {
   char name[CIV_PROFILE_NAME_MAX];
@@ -27,6 +29,24 @@ typedef struct civ_player_profile {
   char avatar_path[CIV_PROFILE_PATH_MAX];
 } civ_player_profile_t;
 
+/**
+ * One save slot as the save browser shows it. Every save updates the
+ * profile's saves.idx with these, so listing never opens the saves.
+ */
+typedef struct civ_save_slot_info {
+  char slot[64];
+  char profile_name[64];
+  char save_label[64];
+  char faction_id[32];
+  uint64_t timestamp;
+  uint32_t turn;
+  int32_t global_year;
+  uint32_t settlement_count;
+  int64_t total_population;
+  bool indexed; /* false: the save exists but the index has nothing on it */
+  uint32_t thumbnail[CIV_SAVE_THUMB_W * CIV_SAVE_THUMB_H]; /* ARGB8888 */
+} civ_save_slot_info_t;
+
 /**
  * Create a new player profile
  * @param name Player name
@@ -66,6 +86,32 @@ bool civ_profile_get_save_path(const char *profile_id, const char *slot_name,
  */
 int civ_profile_list_saves(const char *profile_id, char ***out_saves);
 
+/**
+ * Slot name of path if it is one of the profile's saves
+ * @return False if path lies outside the profile's slot directory
+ */
+bool civ_profile_slot_from_path(const char *profile_id, const char *path,
+                                char *out_slot, size_t out_slot_size);
+
+/**
+ * Insert or replace info->slot in the profile's save index. The index is
+ * written beside itself and renamed into place, so readers see either the
+ * old or the new one.
+ * @return True on success
+ */
+bool civ_profile_update_save_index(const char *profile_id,
+                                   const civ_save_slot_info_t *info);
+
+/**
+ * List save slots with their indexed metadata, newest first. Saves missing
+ * from the index are listed with indexed = false; index entries whose save
+ * is gone are dropped.
+ * @param out_info Receives an array to release with free()
+ * @return Number of slots
+ */
+int civ_profile_list_save_info(const char *profile_id,
+                               civ_save_slot_info_t **out_info);
+
 /**
  * List available profiles
  * @param out_profiles Pointer to array of strings (allocated)
@@ -0,0 +1,167 @@
+/**
+ * @file command_log.h
+ * @brief Deterministic command recorder and fast-forward replay
+ *
+ * Everything that changes a session goes through a command: player actions
+ * are executed with civ_game_execute, and civ_game_update / end_turn log
+ * themselves (the update with the delta it used). AI and world systems draw
+ * from RNG streams keyed by the world seed and turn, so they need no
+ * commands of their own; each turn ends with a check record holding the
+ * turn seed and a state checksum, which a replay compares to find the
+ * first turn that diverged.
+ *
+ * A recording saves a keyframe of the state it starts from and can drop
+ * more every few turns. Seeking to turn N loads the newest keyframe at or
+ * before N and replays only the commands after it, so with keyframes every
+ * K turns any seek, backwards or forwards, costs at most K turns of
+ * simulation; that is what a history scrubber stands on, and it lets a
+ * desync hunt bisect over the keyframes instead of replaying the whole
+ * game.
+ */
+#ifndef CIV_SIMULATION_COMMAND_LOG_H
+#define CIV_SIMULATION_COMMAND_LOG_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct civ_game;
+
+typedef enum {
+  CIV_CMD_NONE = 0,
+  CIV_CMD_UPDATE,           /* i[0] updates of delta f */
+  CIV_CMD_END_TURN,
+  CIV_CMD_TURN_CHECK,       /* turn i[0], seed u, checksum i[1] after end_turn */
+  CIV_CMD_KEYFRAME,         /* base save of turn i[0], see keyframe_path */
+  CIV_CMD_SPAWN_UNIT,       /* type i[0], size i[1], at i[2], i[3], name text */
+  CIV_CMD_MOVE_UNIT,        /* unit id text to i[0], i[1] */
+  CIV_CMD_KILL_UNIT,        /* unit id text */
+  CIV_CMD_FOUND_SETTLEMENT, /* at i[0], i[1] */
+  CIV_CMD_SET_PRODUCTION,   /* settlement id text builds type i[0], cost f */
+  CIV_CMD_PROPOSE_TREATY,   /* text proposes type i[0] for i[1] days to text2 */
+  CIV_CMD_POLITICAL_ACTION, /* player character action i[0] */
+  CIV_CMD_TYPE_COUNT
+} civ_command_type_t;
+
+/* Player character actions on the politics screen */
+typedef enum {
+  CIV_POLITICAL_JOIN_PARTY = 0,
+  CIV_POLITICAL_DONATE,
+  CIV_POLITICAL_APPLY_POSITION,
+  CIV_POLITICAL_PROTEST,
+  CIV_POLITICAL_RUN_FOR_OFFICE
+} civ_political_action_t;
+
+typedef struct {
+  uint16_t type;          /* civ_command_type_t */
+  uint16_t reserved;
+  int32_t  turn;          /* game turn when issued */
+  int32_t  i[4];
+  uint64_t u;
+  double   f;
+  char     text[64];
+  char     text2[32];
+} civ_command_t;
+
+typedef struct civ_command_log {
+  civ_command_t *commands;
+  size_t         count;
+  size_t         capacity;
+
+  /* Session the log starts from */
+  uint64_t    seed;
+  civ_float_t fixed_dt;
+  char        map_path[256];
+
+  /* Recording; false for a log read back for replay. Flushes append
+     through the I/O service (utils/io_service.h). */
+  bool    recording;
+  size_t  written;          /* commands handed to the I/O service */
+  SDL_AtomicInt write_failed; /* set by a failed append */
+  char    path[256];
+  int32_t keyframe_every;   /* turns between keyframe saves, 0 = none */
+} civ_command_log_t;
+
+/**
+ * Start recording to path for a game about to be initialized; the game's
+ * seed, map and fixed delta go into the file header
+ * @return NULL if path cannot be created
+ */
+civ_command_log_t *civ_command_log_create(const char *path,
+                                          const struct civ_game *game);
+/* Read a recording back for replay; NULL on a missing or foreign file */
+civ_command_log_t *civ_command_log_open(const char *path);
+/* Flushes a recording */
+void civ_command_log_destroy(civ_command_log_t *log);
+
+/* Append one command (consecutive equal updates are merged) */
+civ_result_t civ_command_log_append(civ_command_log_t *log,
+                                    const civ_command_t *cmd);
+/* Queue the commands not yet written; reports an earlier append's failure */
+civ_result_t civ_command_log_flush(civ_command_log_t *log);
+
+/* Keyframe save of turn beside the recording at log_path */
+void civ_command_keyframe_path(const char *log_path, int32_t turn, char *out,
+                               size_t size);
+
+/* Cheap digest of the state a desync shows up in first */
+uint32_t civ_command_state_checksum(const struct civ_game *game);
+
+/**
+ * Apply cmd to game without recording it
+ * @return CIV_ERROR_INVALID_STATE if its target no longer exists
+ */
+civ_result_t civ_command_apply(struct civ_game *game, const civ_command_t *cmd);
+
+/* Outcome of civ_command_replay */
+typedef struct {
+  size_t  commands;     /* commands applied */
+  int32_t turns;        /* turns advanced */
+  int32_t first_desync; /* first turn whose check failed, 0 = none */
+  int32_t start_turn;   /* turn replay started from */
+} civ_replay_stats_t;
+
+/**
+ * Re-execute the log on game, which must be initialized from the log's
+ * seed, map and delta. With to_turn > 0 replay stops once that turn is
+ * reached, and starts from the newest keyframe at or before it when one
+ * can be loaded.
+ */
+civ_result_t civ_command_replay(struct civ_game *game,
+                                const civ_command_log_t *log, int32_t to_turn,
+                                civ_replay_stats_t *stats);
+
+/**
+ * Bring game, replaying log, to the start of turn from wherever an earlier
+ * replay or seek left it: forwards as civ_command_replay does, backwards
+ * from the newest keyframe at or before turn, the recording's first one
+ * when no later one precedes it
+ * @return CIV_ERROR_INVALID_STATE when no keyframe at or before turn loads,
+ *         as in a recording made before start keyframes were saved
+ */
+civ_result_t civ_command_seek(struct civ_game *game,
+                              const civ_command_log_t *log, int32_t turn,
+                              civ_replay_stats_t *stats);
+
+/**
+ * Find the first turn that fails its check by bisection: the stretch up to
+ * the first keyframe is replayed on game as initialized, then keyframe
+ * intervals are probed, each loaded from its keyframe and replayed to the
+ * next, until the earliest failing one is found. Exact when a run that
+ * goes wrong stays wrong, as a changed rule or a drifting system does; a
+ * desync that heals may be reported late. stats->first_desync is 0 when
+ * every probe agreed, and start_turn the last interval probed.
+ */
+civ_result_t civ_command_bisect(struct civ_game *game,
+                                const civ_command_log_t *log,
+                                civ_replay_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* CIV_SIMULATION_COMMAND_LOG_H */
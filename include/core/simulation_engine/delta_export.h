@@ -0,0 +1,109 @@
+/**
+ * @file delta_export.h
+ * @brief Live per-turn stream of what changed, for external dashboards
+ *
+ * At the end of every turn the exporter builds a frame of the changes
+ * since the last frame it handed over: the map regions whose revision
+ * moved (the same dirty tracking delta autosaves diff against), nations
+ * whose indicators changed, relations whose level changed or whose
+ * opinion or trust moved by a step, the events emitted, and the systems'
+ * timings. A writer thread compresses each frame and appends it to the
+ * stream's path; a FIFO there streams to a live reader.
+ *
+ * A frame carries at most CIV_DELTA_EXPORT_FRAME_REGIONS regions, taken
+ * round robin, and the rest follow in later frames: the first frame of a
+ * large map would otherwise hold every tile at once.
+ *
+ * The sim thread never waits on the stream. When the writer falls
+ * CIV_DELTA_EXPORT_QUEUE_FRAMES frames or CIV_DELTA_EXPORT_QUEUE_BYTES
+ * behind, the turn's frame is not built: its state changes coalesce into
+ * the next frame, since the baselines they are diffed against only move
+ * when a frame is handed over, and its timings are lost. Its events are
+ * kept for the next frame too, up to what the event ring still holds,
+ * unless the stream was opened to drop them. The frame that makes it
+ * says how many turns it covers and how many events were lost.
+ *
+ * Wire format, little-endian. A frame is
+ *   u32 magic CIV_DELTA_EXPORT_MAGIC, u32 version, u32 flags (bit 0: body
+ *   is civ_lz_compress'ed, state_persistence.h), u32 raw body bytes,
+ *   u32 stored body bytes, then the body
+ * and a body is a run of sections, u32 tag, u32 bytes, payload:
+ *   TURN  i32 turn, u32 sequence, u32 turns covered, u32 events lost,
+ *         u32 flags (bit 0: resync, forget what earlier frames said)
+ *   MAP   i32 width, height, region size, region cols, region rows; in the
+ *         first frame and after the map is replaced
+ *   OWNR  u32 first index, u32 count, then per owner u8 length and the id;
+ *         owners interned since the last frame
+ *   TILE  per region: i32 rx, ry, w, h, then w * h of u16 owner, u8
+ *         terrain, u8 land use, u8 population density, one column after
+ *         the other
+ *   NATN  per nation: i32 index, u16 owner, u8 defunct, f32 gdp,
+ *         inflation, unemployment, tax revenue, stability, legitimacy,
+ *         f64 population, i32 land tiles
+ *   RELN  per relation: u16 owner a, u16 owner b, i8 level, f32 opinion,
+ *         f32 trust; a relation never sent is neutral, opinion 0, trust 0.5
+ *   EVNT  per event: u8 type, f32 importance, u8 length and the title
+ *   SYSN  u32 count, per system u8 length and the name; when the set of
+ *         systems changes
+ *   TIME  per system, in SYSN order: f32 ms of its last update
+ */
+#ifndef CIV_SIMULATION_DELTA_EXPORT_H
+#define CIV_SIMULATION_DELTA_EXPORT_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct civ_game;
+
+#define CIV_DELTA_EXPORT_MAGIC        0x46445843u /* "CXDF" */
+#define CIV_DELTA_EXPORT_VERSION      1u
+#define CIV_DELTA_EXPORT_QUEUE_FRAMES 16
+#define CIV_DELTA_EXPORT_QUEUE_BYTES  (32u << 20)
+#define CIV_DELTA_EXPORT_FRAME_REGIONS 16 /* ~5 MiB of tiles, raw */
+#define CIV_DELTA_EXPORT_OPINION_STEP 1.0f  /* of -100..100 */
+#define CIV_DELTA_EXPORT_TRUST_STEP   0.01f
+
+typedef struct civ_delta_export civ_delta_export_t;
+
+typedef struct {
+  uint64_t frames_built;
+  uint64_t frames_written;
+  uint64_t turns_coalesced; /* turns whose frame was not built */
+  uint64_t events_lost;
+  uint64_t bytes_raw;       /* of frames written, before compression */
+  uint64_t bytes_written;
+  size_t   queue_peak;      /* frames waiting at once */
+  bool     failed;          /* the path could not be opened or written */
+} civ_delta_export_stats_t;
+
+/**
+ * Start the writer for a stream to path; it opens the file itself, so a
+ * FIFO without a reader holds up only the writer. keep_events carries the
+ * events of turns whose frame was not built into the next frame.
+ * @return NULL if the writer cannot start
+ */
+civ_delta_export_t *civ_delta_export_open(const char *path, bool keep_events);
+/* Write what is queued, then stop the writer and close the file; on a
+   FIFO nobody ever opened, this waits for a reader */
+void civ_delta_export_close(civ_delta_export_t *x);
+
+/* Hand over this turn's frame, or count the turn as coalesced while the
+   writer is behind; sim thread, at the end of the turn */
+void civ_delta_export_turn(civ_delta_export_t *x, const struct civ_game *game);
+
+/* Wait until the writer has written what is queued, or failed */
+void civ_delta_export_drain(civ_delta_export_t *x);
+
+void civ_delta_export_get_stats(const civ_delta_export_t *x,
+                                civ_delta_export_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* CIV_SIMULATION_DELTA_EXPORT_H */
@@ -1,6 +1,20 @@
 /**
  * @file event_dispatcher.h
  * @brief Event dispatcher for efficient event handling
+ *
+ * Event types are interned to civ_symbol_t and each type owns its own
+ * handler vector, found through a small hash on the symbol, so a dispatch
+ * runs only the handlers of that type and never compares strings.
+ *
+ * Worker threads cannot call handlers directly. During a parallel phase
+ * they civ_event_dispatcher_post_from events onto a lock-free
+ * multi-producer queue, tagged with a source id (a nation, a system, a
+ * chunk: whatever the task works for). civ_event_dispatcher_pump, on the
+ * main thread at the phase barrier, delivers them ordered by source and
+ * then by the order the source posted them, so the result does not depend
+ * on which worker ran what or when. That holds while each source posts from
+ * one thread per phase. Everything except posting and the already-interned
+ * type ids it takes is main-thread only.
  */
 
 #ifndef CIVILIZATION_EVENT_DISPATCHER_H
@@ -8,17 +22,38 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include "../../utils/symbol.h"
+#include <SDL3/SDL.h>
 
 /* Event handler function pointer */
 typedef void (*civ_event_handler_t)(const char* event_type, void* event_data, void* user_data);
 
+typedef struct {
+    civ_event_handler_t handler;
+    void* user_data;
+} civ_event_subscriber_t;
+
+/* Handlers of one event type, in registration order */
+typedef struct {
+    civ_symbol_t type;
+    civ_event_subscriber_t* subscribers;
+    size_t count;
+    size_t capacity;
+} civ_event_route_t;
+
+/* Queued post; see event_dispatcher.c */
+typedef struct civ_event_post civ_event_post_t;
+
 /* Event dispatcher */
 typedef struct {
-    civ_event_handler_t* handlers;
-    char** event_types;
-    void** user_data;
-    size_t handler_count;
-    size_t handler_capacity;
+    civ_event_route_t* routes;
+    size_t route_count;
+    size_t route_capacity;
+    uint32_t* route_slots;      /* symbol hash -> route index + 1, 0 = empty */
+    uint32_t slot_mask;
+
+    civ_event_post_t* posted;   /* newest first; swapped out by pump */
+    SDL_AtomicInt post_count;   /* posts waiting for the next pump */
 } civ_event_dispatcher_t;
 
 /* Function declarations */
@@ -26,10 +61,25 @@ civ_event_dispatcher_t* civ_event_dispatcher_create(void);
 void civ_event_dispatcher_destroy(civ_event_dispatcher_t* ed);
 void civ_event_dispatcher_init(civ_event_dispatcher_t* ed);
 
+/* Type id for event_type, interning it; resolve ids before a parallel phase */
+civ_symbol_t civ_event_dispatcher_type(const char* event_type);
+
 civ_result_t civ_event_dispatcher_register(civ_event_dispatcher_t* ed, const char* event_type,
                                           civ_event_handler_t handler, void* user_data);
+/* Removes the earliest handler registered for event_type */
 void civ_event_dispatcher_unregister(civ_event_dispatcher_t* ed, const char* event_type);
 civ_result_t civ_event_dispatcher_dispatch(civ_event_dispatcher_t* ed, const char* event_type, void* event_data);
+civ_result_t civ_event_dispatcher_dispatch_id(civ_event_dispatcher_t* ed, civ_symbol_t type, void* event_data);
 
-#endif /* CIVILIZATION_EVENT_DISPATCHER_H */
+/* Queue an event for the next pump; safe from any thread. event_data must
+   stay valid until it has been delivered. */
+civ_result_t civ_event_dispatcher_post_from(civ_event_dispatcher_t* ed, uint32_t source,
+                                            civ_symbol_t type, void* event_data);
+/* post_from source 0, which delivers first; main-thread posts need no source */
+civ_result_t civ_event_dispatcher_post(civ_event_dispatcher_t* ed, civ_symbol_t type, void* event_data);
+/* Deliver everything posted so far, merged by (source, sequence), and return
+   how many events that was; events posted by the handlers wait for the
+   following pump */
+size_t civ_event_dispatcher_pump(civ_event_dispatcher_t* ed);
 
+#endif /* CIVILIZATION_EVENT_DISPATCHER_H */
@@ -0,0 +1,138 @@
+/**
+ * @file lockstep.h
+ * @brief Lockstep multiplayer over the deterministic command log
+ *
+ * Every peer runs the whole simulation and the peers exchange only player
+ * commands. A turn is a fixed number of updates at the session's fixed
+ * delta. Then each peer sends its bundle for the turn: the commands its
+ * player issued since its last bundle, and the state checksum it had when
+ * the turn began. Once every peer's bundle for the turn is in, each peer
+ * applies all bundles in peer order and ends the turn. An empty turn costs
+ * one bundle header per peer, whatever the size of the world.
+ *
+ * While a session is attached to a game, civ_game_execute queues player
+ * commands for the next bundle instead of applying them. They take effect
+ * at the end of the turn on every peer at once, and still reach the
+ * command log when it is recording.
+ *
+ * Peer 0 is the authority. A peer whose checksum differs from peer 0's
+ * asks it for a snapshot and stops advancing. At its next turn boundary
+ * peer 0 saves its state and sends it in LZ-compressed chunks. The peer
+ * loads the snapshot and rejoins at that boundary; commands it had queued
+ * but not yet sent are dropped.
+ *
+ * The transport carries whole messages. Each message a peer sends is
+ * meant for every other peer; a relay server or a full mesh fans it out.
+ * Messages from one peer must arrive in the order they were sent. The
+ * loopback hub connects sessions within one process.
+ *
+ * Neither front end starts a session yet: nothing in the game or headless
+ * runner calls civ_lockstep_create, and the loopback hub is the only
+ * transport. An embedder that does must leave game->lockstep set for the
+ * whole session, since civ_game_deterministic reads it to keep wall time
+ * and UI state out of the simulation.
+ */
+#ifndef CIV_SIMULATION_LOCKSTEP_H
+#define CIV_SIMULATION_LOCKSTEP_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include "command_log.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct civ_game;
+
+#define CIV_LOCKSTEP_MAX_PEERS    16
+#define CIV_LOCKSTEP_MAX_COMMANDS 64      /* per bundle; the rest wait a turn */
+#define CIV_LOCKSTEP_MAX_MESSAGE  (72 * 1024) /* transport buffers */
+
+/* Whole-message link to the other peers */
+typedef struct {
+  void *user;
+  /* Queue data for every other peer; false if the link is down */
+  bool (*send)(void *user, const void *data, size_t size);
+  /* Copy the next waiting message into buf; 0 when none is waiting */
+  size_t (*receive)(void *user, void *buf, size_t capacity);
+} civ_lockstep_transport_t;
+
+typedef struct {
+  int32_t     peer_count;       /* 1..CIV_LOCKSTEP_MAX_PEERS */
+  int32_t     local_peer;       /* this peer's index; 0 is the authority */
+  int32_t     updates_per_turn; /* updates between turn ends, > 0 */
+  civ_float_t fixed_dt;         /* update delta; 0 keeps the game's */
+  char        snapshot_path[256]; /* scratch file for resync snapshots */
+} civ_lockstep_config_t;
+
+typedef enum {
+  CIV_LOCKSTEP_RUNNING,   /* updating through a turn */
+  CIV_LOCKSTEP_WAITING,   /* bundle sent, waiting for the other peers */
+  CIV_LOCKSTEP_RESYNCING, /* desynced, waiting for peer 0's snapshot */
+  CIV_LOCKSTEP_FAILED     /* link down or snapshot unusable */
+} civ_lockstep_state_t;
+
+typedef struct {
+  uint64_t bytes_sent, bytes_received;
+  uint64_t messages_sent, messages_received;
+  int32_t  turns;           /* turns ended under the session */
+  int32_t  resyncs;         /* snapshots loaded */
+  int32_t  snapshots_served;
+  int32_t  last_desync;     /* turn whose start state differed, 0 = none */
+  uint32_t dropped_commands; /* queued ones lost to a full queue or a resync */
+} civ_lockstep_stats_t;
+
+typedef struct civ_lockstep civ_lockstep_t;
+
+/**
+ * Start a session on game, which every peer must have initialized from the
+ * same seed and map. Sets the game's fixed delta and attaches the session
+ * (game->lockstep); game shutdown destroys it. The transport is copied.
+ * @return NULL for a bad config, or a game without a fixed delta
+ */
+civ_lockstep_t *civ_lockstep_create(struct civ_game *game,
+                                    const civ_lockstep_config_t *config,
+                                    const civ_lockstep_transport_t *transport);
+/* Detaches from the game; commands still queued are dropped */
+void civ_lockstep_destroy(civ_lockstep_t *session);
+
+/* Queue a player command for this peer's next bundle */
+civ_result_t civ_lockstep_submit(civ_lockstep_t *session,
+                                 const civ_command_t *cmd);
+
+/* Whether the session is applying bundles; civ_game_execute applies
+   commands directly while it is */
+bool civ_lockstep_applying(const civ_lockstep_t *session);
+
+/**
+ * Take one step: read what arrived, then run one update, or close the turn
+ * once every bundle is in, or serve and load snapshots. Replaces
+ * civ_game_update and civ_game_end_turn while a session runs. Nothing
+ * advances while the game is paused.
+ * @return State after the step
+ */
+civ_lockstep_state_t civ_lockstep_advance(civ_lockstep_t *session);
+
+void civ_lockstep_stats(const civ_lockstep_t *session,
+                        civ_lockstep_stats_t *out);
+
+/* ── Loopback hub ─────────────────────────────────────────────────── */
+
+/* In-process transport between peer_count sessions; each peer's
+   endpoint may be used from its own thread */
+typedef struct civ_lockstep_loopback civ_lockstep_loopback_t;
+
+civ_lockstep_loopback_t *civ_lockstep_loopback_create(int32_t peer_count);
+void civ_lockstep_loopback_destroy(civ_lockstep_loopback_t *hub);
+/* Endpoint of peer; valid while the hub is */
+civ_lockstep_transport_t civ_lockstep_loopback_endpoint(
+    civ_lockstep_loopback_t *hub, int32_t peer);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* CIV_SIMULATION_LOCKSTEP_H */
@@ -8,27 +8,58 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include <SDL3/SDL.h>
 
-/* Performance metric structure */
+/* ── Metric histograms ─────────────────────────────────────────────
+ *
+ * Metrics are registered once by name and recorded by handle. Each thread
+ * records into its own accumulator, behind a lock only the merge ever
+ * contends; civ_performance_optimizer_merge() folds every thread's samples
+ * into the totals at the end of a tick. Times are kept as log-bucketed
+ * histograms, CIV_PERF_OCTAVE_BUCKETS per doubling from 1 us, so the
+ * percentiles are exact to the bucket (about 12%) at any call count.
+ */
+
+#define CIV_PERF_MAX_METRICS   128
+#define CIV_PERF_MAX_THREADS   32
+#define CIV_PERF_OCTAVE_BUCKETS 4
+#define CIV_PERF_BUCKETS       96    /* 0 = under 1 us; the last is open */
+
+typedef int32_t civ_perf_metric_t;
+#define CIV_PERF_INVALID ((civ_perf_metric_t)-1)
+
+/* Performance metric, as of the last merge */
 typedef struct {
     char name[STRING_SHORT_LEN];
-    civ_float_t execution_time;
+    civ_float_t execution_time;  /* ms, all calls */
     uint64_t call_count;
     civ_float_t memory_usage;
     civ_float_t avg_time;
     civ_float_t min_time;
     civ_float_t max_time;
+    civ_float_t p50_time;
+    civ_float_t p95_time;
+    civ_float_t p99_time;
+    uint64_t buckets[CIV_PERF_BUCKETS];
 } civ_performance_metric_t;
 
+struct civ_perf_accumulator;
+
 /* Performance optimizer */
 typedef struct {
-    civ_performance_metric_t* metrics;
+    civ_performance_metric_t* metrics;  /* CIV_PERF_MAX_METRICS, by handle */
     size_t metric_count;
-    size_t metric_capacity;
     bool profiling_enabled;
     civ_float_t optimization_threshold;  /* ms */
     uint64_t total_calls;
     civ_float_t total_execution_time;
+    uint64_t merges;
+
+    /* Per-thread accumulators; the last one is shared once all are taken */
+    struct civ_perf_accumulator* threads[CIV_PERF_MAX_THREADS];
+    int thread_count;
+    SDL_TLSID thread_tls;
+    SDL_SpinLock lock;                   /* registration and thread slots */
 } civ_performance_optimizer_t;
 
 /* Function declarations */
@@ -37,29 +68,93 @@ void civ_performance_optimizer_destroy(civ_performance_optimizer_t* po);
 void civ_performance_optimizer_init(civ_performance_optimizer_t* po);
 
 void civ_performance_optimizer_enable_profiling(civ_performance_optimizer_t* po, bool enabled);
+
+/* Handle for name, registering it if new; CIV_PERF_INVALID when full */
+civ_perf_metric_t civ_performance_optimizer_register(civ_performance_optimizer_t* po,
+                                                     const char* name);
+/* Record one call on the calling thread; safe from any thread */
+void civ_performance_optimizer_record(civ_performance_optimizer_t* po, civ_perf_metric_t id,
+                                      civ_float_t execution_time, civ_float_t memory_delta);
+/* Register-and-record by name; a name lookup per call, for one-off metrics */
 void civ_performance_optimizer_record_metric(civ_performance_optimizer_t* po, const char* name,
                                             civ_float_t execution_time, civ_float_t memory_delta);
+/* Fold every thread's samples into the metrics; call once per tick from
+   the thread that drives it */
+void civ_performance_optimizer_merge(civ_performance_optimizer_t* po);
+
 civ_performance_metric_t* civ_performance_optimizer_get_metric(civ_performance_optimizer_t* po, const char* name);
+const civ_performance_metric_t* civ_performance_optimizer_metric(const civ_performance_optimizer_t* po,
+                                                                 civ_perf_metric_t id);
+/* Time in ms below which a share p (0-1) of the calls fell */
+civ_float_t civ_performance_optimizer_percentile(const civ_performance_metric_t* metric,
+                                                 civ_float_t p);
 char* civ_performance_optimizer_generate_report(const civ_performance_optimizer_t* po);
+/* Zero the statistics; handles stay valid */
 void civ_performance_optimizer_reset(civ_performance_optimizer_t* po);
 
+/* ── Scoped phase profiler ─────────────────────────────────────────
+ *
+ * Always compiled in. Metrics are registered once by name and timed by
+ * id; each thread appends (id, start, duration) records to its own ring
+ * buffer, and civ_profiler_end_frame() drains every ring into a history
+ * of per-frame totals that the debug overlay draws as a stacked bar.
+ */
+
+#define CIV_PROFILER_MAX_METRICS 64
+#define CIV_PROFILER_MAX_THREADS 32
+#define CIV_PROFILER_RING_SIZE   1024   /* events per thread, power of two */
+#define CIV_PROFILER_HISTORY     120    /* frames kept for the overlay */
+
+typedef uint16_t civ_profile_id_t;
+#define CIV_PROFILE_INVALID ((civ_profile_id_t)0xFFFF)
+
+/* One in-flight timed scope */
+typedef struct {
+    civ_profile_id_t id;
+    uint64_t start_ns;
+} civ_profile_scope_t;
+
+/* Per-frame totals, indexed by metric id */
+typedef struct {
+    uint64_t frame;
+    uint64_t start_ns;
+    uint64_t end_ns;
+    float metric_ms[CIV_PROFILER_MAX_METRICS];
+} civ_profile_frame_t;
+
+/* Register a metric; returns the existing id if the name is known */
+civ_profile_id_t civ_profiler_register(const char* name);
+const char* civ_profiler_metric_name(civ_profile_id_t id);
+size_t civ_profiler_metric_count(void);
+
+void civ_profiler_set_enabled(bool enabled);
+bool civ_profiler_is_enabled(void);
+
+uint64_t civ_profiler_now_ns(void);
+civ_profile_scope_t civ_profiler_begin(civ_profile_id_t id);
+void civ_profiler_end(civ_profile_scope_t* scope);
+void civ_profiler_record(civ_profile_id_t id, uint64_t start_ns, uint64_t end_ns);
+
+/* Close the current frame: drain all thread rings into the history.
+   Called once per simulation tick by whichever thread drives it. */
+void civ_profiler_end_frame(void);
+
+/* Copy up to max_frames most recent frames, oldest first */
+size_t civ_profiler_get_history(civ_profile_frame_t* out, size_t max_frames);
+
 /* Profiling macros */
-#ifdef DEBUG
-#define CIV_PROFILE_START(po, name) \
-    clock_t _profile_start_##name = clock(); \
-    const char* _profile_name_##name = #name;
-
-#define CIV_PROFILE_END(po, name) \
-    do { \
-        clock_t _profile_end_##name = clock(); \
-        civ_float_t _profile_time_##name = ((civ_float_t)(_profile_end_##name - _profile_start_##name)) / CLOCKS_PER_SEC * 1000.0f; \
-        if (po && po->profiling_enabled) { \
-            civ_performance_optimizer_record_metric(po, _profile_name_##name, _profile_time_##name, 0.0f); \
-        } \
-    } while(0)
-#else
-#define CIV_PROFILE_START(po, name) ((void)0)
-#define CIV_PROFILE_END(po, name) ((void)0)
+#define CIV_PROFILE_START(scope, id) \
+    civ_profile_scope_t scope = civ_profiler_begin(id)
+
+#define CIV_PROFILE_END(scope) civ_profiler_end(&(scope))
+
+/* Ends automatically when the enclosing block exits (GCC/Clang) */
+#if defined(__GNUC__) || defined(__clang__)
+#define CIV_PROFILE_CONCAT_(a, b) a##b
+#define CIV_PROFILE_CONCAT(a, b) CIV_PROFILE_CONCAT_(a, b)
+#define CIV_PROFILE_SCOPE(id) \
+    civ_profile_scope_t CIV_PROFILE_CONCAT(_civ_prof_, __LINE__) \
+        __attribute__((cleanup(civ_profiler_end))) = civ_profiler_begin(id)
 #endif
 
 #endif /* CIVILIZATION_PERFORMANCE_OPTIMIZER_H */
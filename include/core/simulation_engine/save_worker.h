@@ -0,0 +1,52 @@
+/**
+ * @file save_worker.h
+ * @brief Background thread that writes one save at a time
+ *
+ * The caller snapshots whatever the save needs and hands the snapshot to
+ * the worker as a job; serializing, compressing and writing happen on the
+ * worker thread, so the thread that took the snapshot never waits on the
+ * disk. One job runs at a time and a submit while busy is refused, so a
+ * slow disk drops autosaves instead of queueing them. The job reports
+ * progress, and its result is kept until collected.
+ */
+#ifndef CIV_SIMULATION_SAVE_WORKER_H
+#define CIV_SIMULATION_SAVE_WORKER_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct civ_save_worker civ_save_worker_t;
+
+/* Runs on the worker thread; job is owned by the worker until free_fn */
+typedef civ_result_t (*civ_save_job_fn_t)(void *job, civ_save_worker_t *worker);
+
+civ_save_worker_t *civ_save_worker_create(void);
+/* Waits for the job in flight, then joins the thread */
+void civ_save_worker_destroy(civ_save_worker_t *worker);
+
+/* Start job; false (job untouched) while another is in flight */
+bool civ_save_worker_submit(civ_save_worker_t *worker, civ_save_job_fn_t fn,
+                            void *job, void (*free_fn)(void *job));
+bool civ_save_worker_busy(const civ_save_worker_t *worker);
+/* Block until no job is in flight */
+void civ_save_worker_wait(civ_save_worker_t *worker);
+
+/* Job side: units of work done out of total */
+void civ_save_worker_set_progress(civ_save_worker_t *worker, uint32_t done,
+                                  uint32_t total);
+/* 0..1 while a job runs, < 0 when idle */
+float civ_save_worker_progress(const civ_save_worker_t *worker);
+
+/* Result of the last finished job, once; false if none is waiting */
+bool civ_save_worker_take_result(civ_save_worker_t *worker, civ_result_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* CIV_SIMULATION_SAVE_WORKER_H */
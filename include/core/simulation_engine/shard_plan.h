@@ -0,0 +1,133 @@
+/**
+ * @file shard_plan.h
+ * @brief Partition of a world into simulation shards, and the messages the
+ *        shards exchange at turn boundaries
+ *
+ * A plan gives every territory owner, whole, to one of shard_count shards,
+ * and every map region (CIV_MAP_REGION_SIZE square) to the shard holding
+ * most of its land. Owners are ordered along a serpentine walk of the
+ * regions their land centres on and cut into runs of about equal land, so
+ * a shard is a band of neighbouring nations and never splits one. A region
+ * with no owned land goes with the region before it in the walk.
+ *
+ * What crosses a shard line travels as a message: a border front between
+ * owners in different shards, a trade route between them. A shard posts to
+ * the exchange during a turn; civ_shard_exchange_deliver at the boundary
+ * orders everything by (destination, source, sequence), independent of
+ * thread or process timing, and fills each shard's inbox. Messages are
+ * flat and fixed-size so they can go over a pipe or a socket as they are.
+ *
+ * The headless host builds a plan with --shards N and reports, turn by
+ * turn, what would cross the shard lines. The systems still run once over
+ * the whole world.
+ */
+#ifndef CIV_SIMULATION_SHARD_PLAN_H
+#define CIV_SIMULATION_SHARD_PLAN_H
+
+#include "../../common.h"
+#include "../world/owner_ids.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct civ_map_s;
+
+#define CIV_SHARD_MAX  64
+#define CIV_SHARD_NONE ((uint16_t)0xFFFF)
+
+/* Two owners in different shards whose land touches */
+typedef struct {
+  civ_owner_index_t a, b;    /* a < b */
+  uint16_t shard_a, shard_b;
+  uint32_t contact;          /* touching tile edges now */
+  uint32_t previous;         /* at the refresh before; 0 = new front */
+} civ_shard_contact_t;
+
+typedef struct {
+  int32_t   shard_count;
+  int32_t   region_cols, region_rows;
+  uint16_t *region_shard;    /* per region, row-major */
+  uint16_t *owner_shard;     /* per owner index; CIV_SHARD_NONE = no land */
+  uint32_t  owner_capacity;
+  uint64_t  land[CIV_SHARD_MAX];   /* owned land tiles per shard */
+  uint32_t  owners[CIV_SHARD_MAX]; /* owners per shard */
+  uint32_t  regions[CIV_SHARD_MAX];
+
+  /* Cross-shard fronts, sorted by (a, b); ended ones stay one refresh
+     with contact 0 so their end can be sent */
+  civ_shard_contact_t *contacts;
+  size_t contact_count, contact_capacity;
+} civ_shard_plan_t;
+
+/* Partition map's owned land into shard_count (1..CIV_SHARD_MAX) shards
+   @return NULL on a bad count or allocation failure */
+civ_shard_plan_t *civ_shard_plan_build(const struct civ_map_s *map,
+                                       int32_t shard_count);
+void civ_shard_plan_destroy(civ_shard_plan_t *plan);
+
+/* Recount the cross-shard fronts for the map as it is now. Owners keep
+   their shards; ones new since the build join the lightest shard.
+   @return Fronts whose contact changed since the last refresh */
+size_t civ_shard_plan_refresh(civ_shard_plan_t *plan,
+                              const struct civ_map_s *map);
+
+/* Shard of owner, CIV_SHARD_NONE for unclaimed or unplanned owners */
+static inline uint16_t civ_shard_of_owner(const civ_shard_plan_t *plan,
+                                          civ_owner_index_t owner) {
+  return owner < plan->owner_capacity ? plan->owner_shard[owner]
+                                      : CIV_SHARD_NONE;
+}
+
+/* ── Exchange ─────────────────────────────────────────────────────── */
+
+typedef enum {
+  CIV_SHARD_MSG_BORDER, /* value: contact of from's owner a with owner b */
+  CIV_SHARD_MSG_TRADE,  /* value: route amount from owner a to owner b */
+  CIV_SHARD_MSG_KIND_COUNT
+} civ_shard_msg_kind_t;
+
+typedef struct {
+  uint16_t kind;
+  uint16_t from, to;         /* shards */
+  uint16_t reserved;
+  uint32_t seq;              /* per source shard, set by post */
+  civ_owner_index_t a, b;    /* owner in from, owner in to */
+  double   value;
+} civ_shard_message_t;
+
+typedef struct {
+  uint64_t messages, bytes;  /* delivered, all turns */
+  uint64_t by_kind[CIV_SHARD_MSG_KIND_COUNT];
+  size_t   last_turn;        /* delivered at the latest boundary */
+  size_t   peak_turn;
+} civ_shard_exchange_stats_t;
+
+typedef struct civ_shard_exchange civ_shard_exchange_t;
+
+civ_shard_exchange_t *civ_shard_exchange_create(int32_t shard_count);
+void civ_shard_exchange_destroy(civ_shard_exchange_t *ex);
+
+/* Queue msg from shard msg->from; posts from one shard must come from one
+   thread at a time */
+civ_result_t civ_shard_exchange_post(civ_shard_exchange_t *ex,
+                                     const civ_shard_message_t *msg);
+
+/* Turn boundary: order every message posted since the last one into the
+   inboxes, replacing theirs. @return Messages delivered */
+size_t civ_shard_exchange_deliver(civ_shard_exchange_t *ex);
+
+/* Shard's inbox from the latest boundary; valid until the next one */
+const civ_shard_message_t *civ_shard_exchange_inbox(
+    const civ_shard_exchange_t *ex, int32_t shard, size_t *count);
+
+void civ_shard_exchange_stats(const civ_shard_exchange_t *ex,
+                              civ_shard_exchange_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* CIV_SIMULATION_SHARD_PLAN_H */
@@ -0,0 +1,96 @@
+/**
+ * @file sim_thread.h
+ * @brief Fixed-timestep simulation thread decoupled from rendering
+ *
+ * The simulation thread owns civ_game_update / civ_game_end_turn and
+ * ticks at a fixed rate independent of the frame rate. After every tick
+ * it publishes an immutable snapshot of the HUD-facing state, so the
+ * render thread can draw time, turn and economy readouts without waiting
+ * on the simulation.
+ *
+ * Anything beyond the snapshot (map tiles, nations, panels that mutate
+ * game state) must be accessed between civ_sim_thread_lock() and
+ * civ_sim_thread_unlock(). The sim thread holds the lock for one tick at
+ * a time, so a slow tick delays a frame by at most one tick. The frame
+ * loop holds it across scene update and render, because scenes and panels
+ * draw straight from the live state; a slow frame therefore holds up the
+ * next tick for as long as it runs, and ticks lost that way are caught up
+ * or dropped like any other hitch.
+ *
+ * When the thread cannot start, civ_sim_thread_pump() runs the same ticks
+ * from the frame loop, with the same pacing, snapshot and tick hook.
+ */
+#ifndef CIV_SIMULATION_SIM_THREAD_H
+#define CIV_SIMULATION_SIM_THREAD_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include "../world/nation.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CIV_SIM_DEFAULT_TICK_HZ   20
+#define CIV_SIM_MIN_TICK_HZ       1
+#define CIV_SIM_MAX_TICK_HZ       240
+#define CIV_SIM_MAX_CATCHUP_TICKS 5    /* ticks run per wakeup before dropping debt */
+#define CIV_SIM_DAYS_PER_TURN     (365.0 / 12.0)
+
+struct civ_game;
+
+/* ── Published snapshot (read-only for the render thread) ──────────── */
+typedef struct {
+  uint64_t             tick;             /* ticks completed since start */
+  int32_t              turn;
+  int32_t              global_year;
+  int32_t              global_day;
+  int32_t              player_nation_index;
+  civ_nation_economy_t global_economy;
+  civ_nation_economy_t player_economy;
+  double               last_tick_ms;     /* wall time of the latest tick */
+  double               avg_tick_ms;      /* exponential moving average */
+  uint64_t             dropped_ticks;    /* ticks skipped to avoid spiral */
+} civ_sim_snapshot_t;
+
+typedef struct civ_sim_thread civ_sim_thread_t;
+
+/* Called on the sim thread after every tick, with the state lock held */
+typedef void (*civ_sim_tick_hook_t)(struct civ_game *game, void *user_data);
+
+/* Lifecycle — create does not start the thread */
+civ_sim_thread_t *civ_sim_thread_create(struct civ_game *game, int tick_hz);
+void civ_sim_thread_destroy(civ_sim_thread_t *sim);
+bool civ_sim_thread_start(civ_sim_thread_t *sim);
+void civ_sim_thread_stop(civ_sim_thread_t *sim);
+bool civ_sim_thread_is_running(const civ_sim_thread_t *sim);
+
+/* Pacing controls (safe to call from any thread) */
+void civ_sim_thread_set_tick_rate(civ_sim_thread_t *sim, int tick_hz);
+int  civ_sim_thread_get_tick_rate(const civ_sim_thread_t *sim);
+void civ_sim_thread_set_days_per_second(civ_sim_thread_t *sim, double days);
+
+/* Run hook after each tick (NULL clears it); set before start or while
+   holding the lock */
+void civ_sim_thread_set_tick_hook(civ_sim_thread_t *sim, civ_sim_tick_hook_t hook,
+                                  void *user_data);
+
+/* Exclusive access to the full game state */
+void civ_sim_thread_lock(civ_sim_thread_t *sim);
+void civ_sim_thread_unlock(civ_sim_thread_t *sim);
+
+/* Copy the most recently published snapshot; returns false before tick 1 */
+bool civ_sim_thread_get_snapshot(civ_sim_thread_t *sim, civ_sim_snapshot_t *out);
+
+/* Run one tick synchronously on the calling thread (thread not started) */
+void civ_sim_thread_step(civ_sim_thread_t *sim, double days);
+/* Run the ticks due by now on the calling thread, paced as the thread
+   would (thread not started) */
+void civ_sim_thread_pump(civ_sim_thread_t *sim);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* CIV_SIMULATION_SIM_THREAD_H */
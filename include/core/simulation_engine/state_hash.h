@@ -0,0 +1,99 @@
+/**
+ * @file state_hash.h
+ * @brief Per-turn, per-subsystem world state hashes
+ *
+ * At the end of every turn the game records one 64-bit hash per subsystem.
+ * Tiles are hashed per CIV_MAP_REGION_SIZE region and only regions whose
+ * revision moved since the last record are rehashed; the entity arrays
+ * (nations, governments, markets, units, settlements) are small enough to
+ * hash whole. Hashes cover raw bits, so any change of results — a new SIMD
+ * kernel, a reordered reduction, a thread race — shows as the first turn
+ * and subsystem where two runs part.
+ *
+ * Histories are written as CSV, one row per turn:
+ *
+ *   turn,tiles,nations,governments,markets,units,settlements
+ */
+#ifndef CIV_SIMULATION_STATE_HASH_H
+#define CIV_SIMULATION_STATE_HASH_H
+
+#include "../../common.h"
+#include "../../types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct civ_game;
+struct civ_map_s;
+
+/* X(id, column) */
+#define CIV_STATE_HASH_PARTS(X)                                                \
+  X(TILES, "tiles")                                                            \
+  X(NATIONS, "nations")                                                        \
+  X(GOVERNMENTS, "governments")                                                \
+  X(MARKETS, "markets")                                                        \
+  X(UNITS, "units")                                                            \
+  X(SETTLEMENTS, "settlements")
+
+typedef enum {
+#define CIV_STATE_HASH_ENUM(id, column) CIV_STATE_HASH_##id,
+  CIV_STATE_HASH_PARTS(CIV_STATE_HASH_ENUM)
+#undef CIV_STATE_HASH_ENUM
+  CIV_STATE_HASH_PART_COUNT
+} civ_state_hash_part_t;
+
+typedef struct {
+  int32_t  turn;
+  uint64_t part[CIV_STATE_HASH_PART_COUNT];
+} civ_state_hash_record_t;
+
+typedef struct civ_state_hash {
+  /* Tile regions as of the last record */
+  uint64_t *region_hash;
+  uint32_t *region_revision;
+  size_t    region_count;
+  uint32_t  map_serial;       /* map the cache describes; 0 = none */
+  uint64_t  tile_hash;        /* combined region hashes */
+  size_t    regions_rehashed; /* by the last record */
+
+  civ_state_hash_record_t *records;
+  size_t count;
+  size_t capacity;
+} civ_state_hash_t;
+
+civ_state_hash_t *civ_state_hash_create(void);
+void civ_state_hash_destroy(civ_state_hash_t *sh);
+
+/* Column name of a part */
+const char *civ_state_hash_part_name(civ_state_hash_part_t part);
+
+/* Hash game's state and append it as the record of its current turn */
+civ_result_t civ_state_hash_record(civ_state_hash_t *sh,
+                                   const struct civ_game *game);
+
+/**
+ * Rehash every tile region and compare with the incremental result
+ * @return false when a tile write skipped civ_map_touch_tile
+ */
+bool civ_state_hash_verify_tiles(const civ_state_hash_t *sh,
+                                 const struct civ_map_s *map);
+
+civ_result_t civ_state_hash_export(const civ_state_hash_t *sh,
+                                   const char *path);
+/* Read an exported history back; NULL on a missing or malformed file */
+civ_state_hash_t *civ_state_hash_load(const char *path);
+
+/**
+ * First record where a and b differ, in turns both cover
+ * @param turn, part Set to the divergence when one is found
+ * @return false if the common turns all match
+ */
+bool civ_state_hash_compare(const civ_state_hash_t *a,
+                            const civ_state_hash_t *b, int32_t *turn,
+                            civ_state_hash_part_t *part);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
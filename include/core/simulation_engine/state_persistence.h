@@ -25,5 +25,64 @@ civ_result_t civ_state_persistence_save(civ_state_persistence_t* sp, const char*
 civ_result_t civ_state_persistence_load(civ_state_persistence_t* sp, const char* filename, void* data, size_t* data_size);
 civ_result_t civ_state_persistence_list_saves(civ_state_persistence_t* sp, char** filenames, size_t* count);
 
+/* Chunked save container. A file is its magic and version followed by
+   tagged, versioned sections; each section is a run of chunks of at most
+   CIV_SAVE_CHUNK_SIZE raw bytes, ended by an empty chunk. A chunk is stored
+   LZ-compressed when compression is on and that makes it smaller, raw
+   otherwise. Writer and reader each stream through one chunk buffer, so
+   memory does not grow with the save.
+
+   The writer ends the file with a table of contents (tag, version, offset
+   and raw size of every section) and a footer pointing at it, so a reader
+   can jump straight to one section without decoding the ones before.
+   Version 1 files have no section versions and no table; they still read,
+   and a lookup in them scans. */
+#define CIV_SAVE_CONTAINER_MAGIC   0x43495643 /* "CIVC" */
+#define CIV_SAVE_CONTAINER_VERSION 2
+#define CIV_SAVE_CHUNK_SIZE        (256 * 1024)
+#define CIV_SAVE_TAG(a, b, c, d) \
+    ((uint32_t)(a) | (uint32_t)(b) << 8 | (uint32_t)(c) << 16 | (uint32_t)(d) << 24)
+#define CIV_SAVE_TAG_TOC           CIV_SAVE_TAG('T', 'O', 'C', ' ')
+
+typedef struct civ_save_writer civ_save_writer_t;
+typedef struct civ_save_reader civ_save_reader_t;
+
+/* NULL if the file cannot be created */
+civ_save_writer_t* civ_save_writer_open(const char* path, bool compress);
+/* Version 0 section */
+void civ_save_writer_begin_section(civ_save_writer_t* w, uint32_t tag);
+void civ_save_writer_begin_section_v(civ_save_writer_t* w, uint32_t tag, uint32_t version);
+void civ_save_writer_write(civ_save_writer_t* w, const void* data, size_t size);
+void civ_save_writer_end_section(civ_save_writer_t* w);
+/* Write the table of contents, flush, close and free; reports the first
+   error of the whole save */
+civ_result_t civ_save_writer_close(civ_save_writer_t* w);
+
+/* NULL if the file is missing or is not a container */
+civ_save_reader_t* civ_save_reader_open(const char* path);
+void civ_save_reader_close(civ_save_reader_t* r);
+/* Skip what is left of the current section and enter the next one;
+   false at the end of the file or on a damaged one */
+bool civ_save_reader_next_section(civ_save_reader_t* r, uint32_t* tag);
+/* Enter the first section with tag, through the table of contents when the
+   file has one; false if there is none. Sequential reading carries on from
+   that section. */
+bool civ_save_reader_find_section(civ_save_reader_t* r, uint32_t tag);
+/* Version the current section was written with (0 in version 1 files) */
+uint32_t civ_save_reader_section_version(const civ_save_reader_t* r);
+/* Bytes read from the current section, short at its end */
+size_t civ_save_reader_read(civ_save_reader_t* r, void* data, size_t size);
+/* The rest of the current section in one CIV_MALLOC buffer; NULL (size 0)
+   if it is empty or damaged */
+uint8_t* civ_save_reader_read_all(civ_save_reader_t* r, size_t* size);
+bool civ_save_reader_failed(const civ_save_reader_t* r);
+
+/* Byte-oriented LZ77 block codec (LZ4-style sequences, 64 KiB window).
+   compress returns 0 if the output does not fit in capacity; decompress
+   returns the decoded size, or 0 if src is damaged or dst too small. */
+size_t civ_lz_bound(size_t size);
+size_t civ_lz_compress(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity);
+size_t civ_lz_decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity);
+
 #endif /* CIVILIZATION_STATE_PERSISTENCE_H */
 
@@ -1,6 +1,12 @@
 /**
  * @file system_orchestrator.h
  * @brief System orchestrator for coordinated updates
+ *
+ * Systems are registered with the names of the systems whose output they
+ * read. The orchestrator topologically sorts the resulting DAG and, when
+ * parallel execution is enabled, runs every system as soon as all of its
+ * dependencies have finished, spreading independent systems across a
+ * worker pool. Serial execution follows the same topological order.
  */
 
 #ifndef CIVILIZATION_SYSTEM_ORCHESTRATOR_H
@@ -9,26 +15,57 @@
 #include "../../common.h"
 #include "../../types.h"
 #include "../interfaces/iupdatable.h"
+#include "performance_optimizer.h"
+#include <SDL3/SDL.h>
+
+#define CIV_ORCHESTRATOR_MAX_DEPS 16
 
 /* System status structure */
 typedef struct {
     char name[STRING_SHORT_LEN];
     bool enabled;
     civ_float_t health;  /* 0.0 to 1.0 */
-    civ_float_t last_update_time;
+    civ_float_t last_update_time;   /* ms, less jobs it ran for others while waiting */
     uint64_t update_count;
     civ_float_t avg_update_time;
+    civ_float_t total_update_time;  /* ms since registration */
 } civ_system_status_t;
 
+/* Dependency graph node, parallel to the systems array */
+typedef struct {
+    char name[STRING_SHORT_LEN];
+    char dependencies[CIV_ORCHESTRATOR_MAX_DEPS][STRING_SHORT_LEN];
+    size_t dep_count;
+    size_t* successors;        /* resolved at calculate_order */
+    size_t successor_count;
+    size_t indegree;           /* resolved dependency count */
+    SDL_AtomicInt pending;     /* deps left this frame (parallel run) */
+    void* owner;               /* civ_system_orchestrator_t, for pool jobs */
+    size_t index;
+    civ_profile_id_t profile_id;  /* phase profiler metric */
+    civ_perf_metric_t perf_id;    /* optimizer histogram */
+    civ_system_status_t status;
+} civ_system_node_t;
+
 /* System orchestrator */
 typedef struct {
     civ_updatable_t* systems;
+    civ_system_node_t* nodes;
     size_t system_count;
     size_t system_capacity;
     char** execution_order;
+    size_t* order_index;       /* execution_order as indices into systems */
     size_t order_count;
+    bool order_dirty;
+    bool order_acyclic;        /* false: cycle found, parallel run disabled */
     bool parallel_execution;
     uint32_t max_workers;
+    void* worker_pool;         /* civ_worker_pool_t — opaque */
+    civ_performance_optimizer_t* optimizer;  /* not owned; may be NULL */
+
+    /* Per-frame parallel run state */
+    SDL_AtomicInt remaining;
+    civ_float_t frame_delta;
 } civ_system_orchestrator_t;
 
 /* Function declarations */
@@ -36,7 +73,7 @@ civ_system_orchestrator_t* civ_system_orchestrator_create(void);
 void civ_system_orchestrator_destroy(civ_system_orchestrator_t* so);
 void civ_system_orchestrator_init(civ_system_orchestrator_t* so);
 
-civ_result_t civ_system_orchestrator_register(civ_system_orchestrator_t* so, 
+civ_result_t civ_system_orchestrator_register(civ_system_orchestrator_t* so,
                                                const char* name, civ_updatable_t* updatable,
                                                const char** dependencies, size_t dep_count);
 void civ_system_orchestrator_unregister(civ_system_orchestrator_t* so, const char* name);
@@ -46,5 +83,18 @@ void civ_system_orchestrator_enable_system(civ_system_orchestrator_t* so, const
 civ_system_status_t* civ_system_orchestrator_get_status(civ_system_orchestrator_t* so, const char* name);
 civ_float_t civ_system_orchestrator_get_overall_health(const civ_system_orchestrator_t* so);
 
-#endif /* CIVILIZATION_SYSTEM_ORCHESTRATOR_H */
+/* Switch between serial and DAG-parallel execution. max_workers counts the
+   calling thread, so 1 means serial; 0 picks from the core count. */
+void civ_system_orchestrator_set_parallel(civ_system_orchestrator_t* so, bool enabled,
+                                          uint32_t max_workers);
+
+/* Record every system's update time into po, per system, from whichever
+   thread runs it; NULL stops recording */
+void civ_system_orchestrator_set_optimizer(civ_system_orchestrator_t* so,
+                                           civ_performance_optimizer_t* po);
 
+/* Worker pool used for parallel runs (NULL when serial); systems may use it
+   for their own data-parallel loops. */
+void* civ_system_orchestrator_get_worker_pool(civ_system_orchestrator_t* so);
+
+#endif /* CIVILIZATION_SYSTEM_ORCHESTRATOR_H */
@@ -10,6 +10,7 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include "../../utils/arena.h"
 
 /* Time scale enumeration */
 typedef enum {
@@ -38,14 +39,29 @@ typedef struct {
     civ_season_t season;
 } civ_calendar_t;
 
-/* Time listener callback function type */
-typedef void (*civ_time_listener_cb_t)(const char* event_type, void* calendar, void* user_data);
+/* Calendar events a listener registers for */
+typedef enum {
+    CIV_TIME_EVENT_DAY = 0,       /* once per day, in order */
+    CIV_TIME_EVENT_MONTH,         /* once per month boundary crossed */
+    CIV_TIME_EVENT_YEAR,          /* once per year boundary crossed */
+    CIV_TIME_EVENT_DAYS_ADVANCED, /* once per update, with the day count */
+    CIV_TIME_EVENT_COUNT
+} civ_time_event_t;
+
+#define CIV_TIME_MAX_LISTENERS 16       /* per event */
+#define CIV_TIME_NS_PER_SECOND 1000000000ull
+#define CIV_TIME_MAX_STEP_NS   250000000ull /* longer gaps count as this */
+
+/* cal is the calendar as of the event: the boundary day for DAY, MONTH and
+   YEAR, the end of the update for DAYS_ADVANCED. days is 1, or the number
+   of days the update advanced for DAYS_ADVANCED. */
+typedef void (*civ_time_listener_cb_t)(civ_time_event_t event,
+                                       const civ_calendar_t* cal,
+                                       int32_t days, void* user_data);
 
-/* Time listener structure */
-typedef struct civ_time_listener {
+typedef struct {
     civ_time_listener_cb_t callback;
     void* user_data;
-    struct civ_time_listener* next;
 } civ_time_listener_t;
 
 /* Time manager structure */
@@ -53,12 +69,13 @@ typedef struct {
     civ_calendar_t calendar;
     civ_time_scale_t time_scale;
     civ_float_t game_speed;
-    civ_float_t time_delta;
-    time_t last_update_time;
-    civ_float_t accumulated_time;
+    civ_float_t time_delta;        /* game days of the last update */
+    uint64_t last_update_ns;       /* SDL_GetTicksNS(); 0 = not started */
+    double accumulated_time;       /* game days short of the next whole day */
     
-    /* Time listeners */
-    civ_time_listener_t* listeners;
+    /* Time listeners, by event */
+    civ_time_listener_t listeners[CIV_TIME_EVENT_COUNT][CIV_TIME_MAX_LISTENERS];
+    int listener_count[CIV_TIME_EVENT_COUNT];
     
     /* Time scale multipliers */
     civ_float_t scale_multipliers[6];
@@ -83,10 +100,20 @@ void civ_time_manager_init(civ_time_manager_t* tm);
 
 /**
  * Update the time manager (call each frame)
+ *
+ * Reads the monotonic clock; the calendar moves in whole days, however
+ * many the elapsed time covers, without a per-day walk unless DAY
+ * listeners are registered.
  * @return Time delta in game days
  */
 civ_float_t civ_time_manager_update(civ_time_manager_t* tm);
 
+/**
+ * Advance by elapsed_ns of real time at the current scale
+ * @return Time delta in game days
+ */
+civ_float_t civ_time_manager_advance(civ_time_manager_t* tm, uint64_t elapsed_ns);
+
 /**
  * Set the time scale
  */
@@ -98,14 +125,18 @@ void civ_time_manager_set_time_scale(civ_time_manager_t* tm, civ_time_scale_t sc
 void civ_time_manager_adjust_speed(civ_time_manager_t* tm, civ_float_t multiplier);
 
 /**
- * Add a time event listener
+ * Add a listener for one event; DAYS_ADVANCED takes a multi-day catch-up
+ * in a single call where DAY would take one call per day
+ * @return false if that event's table is full
  */
-void civ_time_manager_add_listener(civ_time_manager_t* tm, civ_time_listener_cb_t callback, void* user_data);
+bool civ_time_manager_add_listener(civ_time_manager_t* tm, civ_time_event_t event,
+                                   civ_time_listener_cb_t callback, void* user_data);
 
 /**
- * Remove a time event listener
+ * Remove a listener added with the same event, callback and user_data
  */
-void civ_time_manager_remove_listener(civ_time_manager_t* tm, civ_time_listener_cb_t callback);
+void civ_time_manager_remove_listener(civ_time_manager_t* tm, civ_time_event_t event,
+                                      civ_time_listener_cb_t callback, void* user_data);
 
 /**
  * Get current season
@@ -122,11 +153,21 @@ void civ_calendar_get_date_string(const civ_calendar_t* cal, char* buffer, size_
  */
 void civ_calendar_advance_day(civ_calendar_t* cal);
 
+/**
+ * Advance calendar by days (>= 0) in constant time
+ */
+void civ_calendar_advance_days(civ_calendar_t* cal, int64_t days);
+
 /**
  * Serialize time manager to JSON (returns allocated string, caller must free)
  */
 char* civ_time_manager_to_json(const civ_time_manager_t* tm);
 
+/**
+ * Serialize to JSON on arena; valid until its next reset
+ */
+char* civ_time_manager_to_json_arena(const civ_time_manager_t* tm, civ_arena_t* arena);
+
 /**
  * Deserialize time manager from JSON
  */
@@ -0,0 +1,54 @@
+/**
+ * @file worker_pool.h
+ * @brief Fixed-size worker thread pool for simulation jobs
+ *
+ * Jobs are plain function + argument pairs pulled from a shared FIFO.
+ * Waiting threads never just block: while their work is outstanding they
+ * pull and run queued jobs themselves, so nested parallel sections (a job
+ * that itself calls civ_worker_pool_parallel_for) cannot deadlock the pool.
+ */
+#ifndef CIV_SIMULATION_WORKER_POOL_H
+#define CIV_SIMULATION_WORKER_POOL_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CIV_WORKER_POOL_MAX_THREADS 64
+
+typedef void (*civ_job_fn_t)(void *arg);
+typedef void (*civ_parallel_for_fn_t)(void *ctx, int index);
+
+typedef struct civ_worker_pool civ_worker_pool_t;
+
+/* worker_count <= 0 picks (logical cores - 1); the caller is the extra lane */
+civ_worker_pool_t *civ_worker_pool_create(int worker_count);
+void civ_worker_pool_destroy(civ_worker_pool_t *pool);
+int  civ_worker_pool_size(const civ_worker_pool_t *pool);
+
+/* Queue a job; returns false only on allocation failure */
+bool civ_worker_pool_submit(civ_worker_pool_t *pool, civ_job_fn_t fn, void *arg);
+
+/* Pop and run one queued job on the calling thread; false if queue empty */
+bool civ_worker_pool_run_one(civ_worker_pool_t *pool);
+
+/* Run queued jobs until *outstanding drops to zero */
+void civ_worker_pool_wait_counter(civ_worker_pool_t *pool, SDL_AtomicInt *outstanding);
+/* Nanoseconds the calling thread has spent running jobs while waiting, a
+   running total; the difference across a call is the time it lent out */
+uint64_t civ_worker_pool_helped_ns(void);
+
+/* Call fn(ctx, i) for i in [0, count) across the pool and the caller.
+   Runs inline when pool is NULL or count is 1. */
+void civ_worker_pool_parallel_for(civ_worker_pool_t *pool, int count,
+                                  civ_parallel_for_fn_t fn, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* CIV_SIMULATION_WORKER_POOL_H */
@@ -1,6 +1,15 @@
 /**
  * @file subunit.h
  * @brief Subunit system
+ *
+ * Subunits live in one flat array and are addressed by index; an index
+ * stays valid for the manager's lifetime, and a subunit split or merged
+ * away is only deactivated. The hierarchy is integer parent links plus
+ * a maintained post-order array: every subunit's subtree is the run of
+ * `span` entries ending at its position `post`, children before parents.
+ * Reparenting, splitting and merging move such runs (memmove splices
+ * that renumber the entries after the splice point), and a rollup of
+ * population and GDP is one sweep of the order.
  */
 
 #ifndef CIVILIZATION_SUBUNIT_H
@@ -8,6 +17,9 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include "../../utils/symbol.h"
+
+#define CIV_SUBUNIT_NONE (-1)
 
 /* Subunit type */
 typedef enum {
@@ -23,19 +35,25 @@ typedef struct {
   char id[STRING_SHORT_LEN];
   char name[STRING_MEDIUM_LEN];
   civ_subunit_type_t type;
+  civ_symbol_t id_sym;
 
-  char parent_id[STRING_SHORT_LEN]; /* Parent subunit ID */
-  char **child_ids;                 /* Child subunit IDs */
-  size_t child_count;
-  size_t child_capacity;
+  /* Hierarchy, maintained by the manager */
+  int32_t parent; /* index, CIV_SUBUNIT_NONE at a root */
+  int32_t post;   /* position in the manager's order; -1 once inactive */
+  int32_t span;   /* subtree size, itself included */
+  bool active;
 
   civ_float_t autonomy;    /* 0.0 to 1.0 */
   civ_float_t loyalty;     /* 0.0 to 1.0 */
   civ_float_t development; /* 0.0 to 1.0 */
 
-  int64_t population;
+  int64_t population; /* own */
   civ_float_t gdp;
 
+  /* Subtree sums as of the last rollup */
+  int64_t total_population;
+  civ_float_t total_gdp;
+
   time_t creation_time;
 } civ_subunit_t;
 
@@ -44,6 +62,9 @@ typedef struct {
   civ_subunit_t *subunits;
   size_t subunit_count;
   size_t subunit_capacity;
+
+  int32_t *order;     /* active subunits in post-order */
+  size_t order_count;
 } civ_subunit_manager_t;
 
 /* Function declarations */
@@ -51,28 +72,40 @@ civ_subunit_manager_t *civ_subunit_manager_create(void);
 void civ_subunit_manager_destroy(civ_subunit_manager_t *manager);
 void civ_subunit_manager_init(civ_subunit_manager_t *manager);
 
-civ_subunit_t *civ_subunit_create(const char *id, const char *name,
-                                  civ_subunit_type_t type);
-void civ_subunit_destroy(civ_subunit_t *subunit);
+/* Defaults for a new subunit, to fill in before civ_subunit_manager_add */
+void civ_subunit_init(civ_subunit_t *subunit, const char *id, const char *name,
+                      civ_subunit_type_t type);
+/* Copy subunit in as the last child of parent (CIV_SUBUNIT_NONE = a new
+   root); out_index may be NULL */
 civ_result_t civ_subunit_manager_add(civ_subunit_manager_t *manager,
-                                     civ_subunit_t *subunit);
+                                     const civ_subunit_t *subunit,
+                                     int32_t parent, int32_t *out_index);
 civ_subunit_t *civ_subunit_manager_find(const civ_subunit_manager_t *manager,
                                         const char *id);
-civ_result_t civ_subunit_set_parent(civ_subunit_t *subunit,
-                                    const char *parent_id);
-civ_result_t civ_subunit_add_child(civ_subunit_t *subunit,
-                                   const char *child_id);
+/* Index of an active subunit, CIV_SUBUNIT_NONE if none has id */
+int32_t civ_subunit_manager_index(const civ_subunit_manager_t *manager,
+                                  const char *id);
+/* Move index's subtree under parent; fails if parent lies inside it */
+civ_result_t civ_subunit_set_parent(civ_subunit_manager_t *manager,
+                                    int32_t index, int32_t parent);
+/* Indices of index's subtree in post-order, itself last; NULL if inactive */
+const int32_t *civ_subunit_subtree(const civ_subunit_manager_t *manager,
+                                   int32_t index, size_t *count);
+/* Refill every total_population and total_gdp */
+void civ_subunit_manager_rollup(civ_subunit_manager_t *manager);
 civ_result_t civ_subunit_manager_update(civ_subunit_manager_t *manager,
                                         civ_float_t time_delta);
 
 /* Dynamic Management */
-civ_result_t civ_subunit_split(civ_subunit_manager_t *manager,
-                               civ_subunit_t *original, int count,
-                               char **new_names, civ_subunit_t **out_subunits);
+/* Replace index with count siblings sharing its population and GDP; its
+   children move to the first. out_indices takes count entries, may be NULL */
+civ_result_t civ_subunit_split(civ_subunit_manager_t *manager, int32_t index,
+                               int count, char **new_names,
+                               int32_t *out_indices);
+/* Replace count siblings with one subunit holding their sums and children */
 civ_result_t civ_subunit_merge(civ_subunit_manager_t *manager,
-                               civ_subunit_t **subunits, int count,
-                               const char *new_name,
-                               civ_subunit_t **out_merged);
+                               const int32_t *indices, int count,
+                               const char *new_name, int32_t *out_index);
 civ_result_t civ_subunit_set_type(civ_subunit_t *subunit,
                                   civ_subunit_type_t new_type);
 
@@ -57,6 +57,17 @@ void civ_innovation_system_destroy(civ_innovation_system_t *is);
 /* Process one turn of advancement */
 void civ_innovation_system_update(civ_innovation_system_t *is, float dt);
 
+/* Recompute aggregate_index after setting domain indices directly */
+void civ_innovation_system_refresh_aggregate(civ_innovation_system_t *is);
+
+/* Place this system among the other nations, once per turn. rivals holds
+   their tech indices and is sorted in place (descending); one sort serves
+   the aggregate and every domain, each ranked by binary search and
+   averaged together with its own index. Until the first call every rank
+   is 1. */
+void civ_innovation_system_rank(civ_innovation_system_t *is, int32_t *rivals,
+                                size_t count);
+
 /* Set total research budget (comes from population, buildings, trade) */
 void civ_innovation_system_set_research_budget(civ_innovation_system_t *is,
                                                float budget);
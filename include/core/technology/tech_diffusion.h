@@ -0,0 +1,95 @@
+/**
+ * @file tech_diffusion.h
+ * @brief Technology spreading between nations along their links
+ *
+ * Knowledge leaks across shared borders, down trade routes and between
+ * friends. civ_tech_diffusion_link rebuilds those links into a CSR graph
+ * over nation indices, each pair's weight the sum of what joins it:
+ *
+ * - a land border, CIV_TECH_BORDER_WEIGHT once it is CIV_TECH_FULL_BORDER
+ *   tiles long, proportionally less when shorter,
+ * - CIV_TECH_TRADE_WEIGHT per active trade route,
+ * - a friendly or allied relation, CIV_TECH_RELATION_WEIGHT times its trust,
+ * - each active treaty, by type (research partnerships the most).
+ *
+ * Every nation holds a row of CIV_TECH_DOMAIN_COUNT domain levels, so a turn
+ * is one sparse matrix product over all domains at once: each row sums its
+ * neighbours' weighted rows, and a domain below that weighted mean closes
+ * rate * min(total weight, 1) of the gap. Nations ahead of their neighbours
+ * lose nothing. Rows run across the worker pool.
+ *
+ * Nations other than the player carry one tech_index; their rows start at it
+ * in every domain and write back their mean. The player's row is the
+ * technology tree's domains. Whatever changes those values between turns
+ * (research, a load) is carried into the rows before the pass.
+ */
+#ifndef CIVILIZATION_TECH_DIFFUSION_H
+#define CIVILIZATION_TECH_DIFFUSION_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include "../diplomacy/relations.h"
+#include "../economy/international_trade.h"
+#include "../world/border_frontier.h"
+#include "../world/map_generator.h"
+#include "../world/nation.h"
+#include "innovation_system.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct civ_worker_pool;
+
+#define CIV_TECH_DIFFUSION_RATE  0.05f /* share of the gap closed per turn */
+#define CIV_TECH_BORDER_WEIGHT   0.5f
+#define CIV_TECH_FULL_BORDER     32    /* tiles */
+#define CIV_TECH_TRADE_WEIGHT    0.25f
+#define CIV_TECH_RELATION_WEIGHT 0.25f
+
+typedef struct {
+  civ_float_t rate;
+
+  /* Link graph over nation indices: row i is adj_target/adj_weight
+     [adj_start[i], adj_start[i + 1]) */
+  uint32_t *adj_start;
+  uint32_t *adj_target;
+  float *adj_weight;
+  size_t adj_count;
+  size_t adj_capacity;
+  size_t linked_nations; /* rows in adj_start */
+  civ_border_frontier_t *frontier;
+
+  /* Domain levels, nation rows of CIV_TECH_DOMAIN_COUNT floats, the values
+     last written back to each nation, and the pass's output */
+  float *levels;
+  float *next_levels;
+  int32_t *written;
+  size_t rows;
+} civ_tech_diffusion_t;
+
+civ_tech_diffusion_t *civ_tech_diffusion_create(void);
+void civ_tech_diffusion_destroy(civ_tech_diffusion_t *diffusion);
+
+/* Rebuild the links from map's borders, trade's routes and diplomacy's
+   relations and treaties; any of the three may be NULL. Nations are matched
+   by id. */
+civ_result_t civ_tech_diffusion_link(civ_tech_diffusion_t *diffusion,
+                                     const civ_nation_manager_t *nations,
+                                     civ_map_t *map,
+                                     const civ_trade_manager_t *trade,
+                                     const civ_diplomacy_system_t *diplomacy);
+
+/* One turn of diffusion over the links: nations' tech_index and the
+   player's domains in player_tree (may be NULL) are pulled toward their
+   neighbours'. pool may be NULL. */
+civ_result_t civ_tech_diffusion_process(civ_tech_diffusion_t *diffusion,
+                                        civ_nation_manager_t *nations,
+                                        civ_innovation_system_t *player_tree,
+                                        struct civ_worker_pool *pool,
+                                        civ_float_t time_delta);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
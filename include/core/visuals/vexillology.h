@@ -1,6 +1,13 @@
 /**
  * @file vexillology.h
  * @brief Procedural Flag Design and Validation
+ *
+ * A design is up to four layers drawn in order. The first paints the
+ * whole field; later layers paint only their charge (bar, cross, canton)
+ * over it, except the stripe patterns, which cover the field. A symbol is
+ * drawn centered, or in the canton, in its layer's secondary color (the
+ * primary where it lies on the charge). The hash covers every layer's
+ * pattern, symbol and colors, so equal hashes rasterize to the same pixels.
  */
 
 #ifndef CIVILIZATION_VEXILLOLOGY_H
@@ -24,16 +31,16 @@ typedef enum {
 
 /* Flag Symbol */
 typedef enum {
-  CIV_SYMBOL_NONE = 0,
-  CIV_SYMBOL_LION,    /* Power/Royal */
-  CIV_SYMBOL_EAGLE,   /* Vision/Empire */
-  CIV_SYMBOL_STAR,    /* Unity/Progress */
-  CIV_SYMBOL_WHEAT,   /* Prosperity/Food */
-  CIV_SYMBOL_HAMMER,  /* Labor/Industry */
-  CIV_SYMBOL_ANCHOR,  /* Maritime/Trade */
-  CIV_SYMBOL_SUN,     /* Divine/Knowledge */
-  CIV_SYMBOL_MOON,    /* Night/Mystery */
-  CIV_SYMBOL_MOUNTAIN /* Resilience */
+  CIV_FLAG_SYMBOL_NONE = 0,
+  CIV_FLAG_SYMBOL_LION,    /* Power/Royal */
+  CIV_FLAG_SYMBOL_EAGLE,   /* Vision/Empire */
+  CIV_FLAG_SYMBOL_STAR,    /* Unity/Progress */
+  CIV_FLAG_SYMBOL_WHEAT,   /* Prosperity/Food */
+  CIV_FLAG_SYMBOL_HAMMER,  /* Labor/Industry */
+  CIV_FLAG_SYMBOL_ANCHOR,  /* Maritime/Trade */
+  CIV_FLAG_SYMBOL_SUN,     /* Divine/Knowledge */
+  CIV_FLAG_SYMBOL_MOON,    /* Night/Mystery */
+  CIV_FLAG_SYMBOL_MOUNTAIN /* Resilience */
 } civ_flag_symbol_t;
 
 /* Flag Layer */
@@ -60,4 +67,11 @@ void civ_vexillology_add_layer(civ_flag_t *flag, civ_flag_pattern_t pattern,
 const char *civ_vexillology_describe(const civ_flag_t *flag);
 uint64_t civ_vexillology_calculate_hash(const civ_flag_t *flag);
 
+/* Fill flag with a design picked by seed in the two 0xRRGGBB colors */
+void civ_vexillology_generate(civ_flag_t *flag, uint64_t seed, uint32_t primary,
+                              uint32_t secondary);
+/* Draw flag into a w x h RGBA block at rgba, stride bytes per row */
+void civ_vexillology_rasterize(const civ_flag_t *flag, uint8_t *rgba, int w,
+                               int h, int stride);
+
 #endif /* CIVILIZATION_VEXILLOLOGY_H */
@@ -0,0 +1,64 @@
+/**
+ * @file border_frontier.h
+ * @brief Contact tiles between adjacent territory owners
+ *
+ * For every ordered owner pair (a, b) the frontier keeps the set of land
+ * tiles owned by a that have at least one 4-neighbour owned by b. It is
+ * built with one map pass when first attached to a map and then kept
+ * current through the map's owner listener, so front queries cost
+ * O(front length) instead of O(map).
+ *
+ * The frontier holds no map pointer: reattaching to a reloaded map simply
+ * rebuilds it. Detach before destroying a frontier whose map outlives it.
+ */
+#ifndef CIV_WORLD_BORDER_FRONTIER_H
+#define CIV_WORLD_BORDER_FRONTIER_H
+
+#include "map_generator.h"
+#include "owner_ids.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Open-addressing set of tile indices */
+typedef struct {
+  uint32_t *slots;      /* tile + 1; 0 = empty, UINT32_MAX = tombstone */
+  uint32_t  capacity;   /* power of two, 0 = unallocated */
+  uint32_t  count;
+  uint32_t  used;       /* count + tombstones */
+} civ_frontier_set_t;
+
+typedef struct {
+  uint32_t           *pair_keys;   /* (owner << 16 | neighbour) + 1, 0 = empty */
+  civ_frontier_set_t *pair_sets;
+  uint32_t            pair_capacity;
+  uint32_t            pair_count;
+} civ_border_frontier_t;
+
+civ_border_frontier_t *civ_border_frontier_create(void);
+void civ_border_frontier_destroy(civ_border_frontier_t *f);
+
+/* Make the frontier current for map: rebuilds and registers the owner
+   listener unless already attached. False only when out of memory. */
+bool civ_border_frontier_attach(civ_border_frontier_t *f, civ_map_t *map);
+void civ_border_frontier_detach(civ_border_frontier_t *f, civ_map_t *map);
+
+/* Tiles owned by owner that touch neighbour */
+size_t civ_border_frontier_count(const civ_border_frontier_t *f,
+                                 civ_owner_index_t owner,
+                                 civ_owner_index_t neighbour);
+
+/* Copy up to max of those tile indices into out; returns the number copied */
+size_t civ_border_frontier_collect(const civ_border_frontier_t *f,
+                                   civ_owner_index_t owner,
+                                   civ_owner_index_t neighbour,
+                                   uint32_t *out, size_t max);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
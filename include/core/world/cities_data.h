@@ -12,6 +12,7 @@
 #define CIV_CITIES_DATA_H
 
 #include "../../common.h"
+#include "../../utils/arena.h"
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -47,12 +48,21 @@ typedef struct {
     uint32_t         map_width, map_height;
 
     /* Spatial index: 32x32 grid cells over the world map.
-       Each cell stores indices into the cities[] array. */
+       Each cell stores indices into the cities[] array, sorted by tier
+       (most populous first, file order within a tier). */
     struct {
         uint32_t *indices;
         uint32_t  count;
         uint32_t  capacity;
     } grid[32][32];
+
+    /* Country index, built at load: the cities of country_keys[k] (ISO-A2
+       packed as first << 8 | second, ascending) are
+       country_cities[country_start[k] .. country_start[k + 1]), by tier */
+    uint16_t               *country_keys;
+    uint32_t               *country_start;
+    const civ_city_data_t **country_cities;
+    uint32_t                country_count;
 } civ_cities_data_t;
 
 /* ── Lifecycle ────────────────────────────────────────────────── */
@@ -63,8 +73,24 @@ void               civ_cities_data_destroy(civ_cities_data_t *cd);
 civ_result_t       civ_cities_data_load(civ_cities_data_t *cd,
                                         const char *filepath);
 
+/* Parse the same format from memory (e.g. a world pack section) */
+civ_result_t       civ_cities_data_load_view(civ_cities_data_t *cd,
+                                             const uint8_t *data, size_t size);
+
 /* ── Queries ──────────────────────────────────────────────────── */
 
+/* Cities visible within a tile viewport, written to out (room for max).
+   Cells are walked in row order and each cell by tier, stopping at the
+   first city below min_tier. Allocates nothing.
+   Returns the number written. */
+uint32_t civ_cities_query_tiles_into(
+    const civ_cities_data_t *cd,
+    int32_t tile_x, int32_t tile_y,
+    int32_t tile_w, int32_t tile_h,
+    uint32_t min_tier,         /* only cities at or above this tier */
+    const civ_city_data_t **out,
+    uint32_t max);
+
 /* Get cities visible within a tile viewport.
    Returns a caller-freed array of pointers. */
 const civ_city_data_t **civ_cities_query_tiles(
@@ -74,7 +100,25 @@ const civ_city_data_t **civ_cities_query_tiles(
     uint32_t min_tier,         /* only cities at or above this tier */
     uint32_t *out_count);
 
-/* Get cities for a specific country (by ISO-A2) */
+/* Same query with the result pushed on arena; valid until its reset and
+   never passed to civ_cities_free_result */
+const civ_city_data_t **civ_cities_query_tiles_arena(
+    const civ_cities_data_t *cd,
+    int32_t tile_x, int32_t tile_y,
+    int32_t tile_w, int32_t tile_h,
+    uint32_t min_tier,
+    civ_arena_t *arena,
+    uint32_t *out_count);
+
+/* Cities of a country (by ISO-A2), most populous tier first, as a span of
+   the country index; valid until the next load. NULL for none. */
+const civ_city_data_t *const *civ_cities_country_span(
+    const civ_cities_data_t *cd,
+    const char *iso_a2,
+    uint32_t *out_count);
+
+/* Get cities for a specific country (by ISO-A2), copied from the span.
+   Returns a caller-freed array of pointers. */
 const civ_city_data_t **civ_cities_for_country(
     const civ_cities_data_t *cd,
     const char *iso_a2,
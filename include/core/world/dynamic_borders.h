@@ -1,6 +1,17 @@
 /**
  * @file dynamic_borders.h
  * @brief Dynamic borders and territory system
+ *
+ * Borders are kept per pair of territory owners, not per hand-placed
+ * segment. Attached to a map, the system counts the land tile edges each
+ * pair of owners shares, and keeps the counts current through the map's
+ * owner listener. Conquest, treaties and anything else that goes through
+ * civ_map_set_owner move them. A pair gets a slot the first time its land
+ * touches and keeps it, with its tension, after the land parts.
+ *
+ * Slots are found through a hash on the ordered owner-index pair, so
+ * a tension query costs O(1). Tension, fortification and drift sit in
+ * their own arrays that civ_dynamic_borders_update walks in one pass.
  */
 
 #ifndef CIVILIZATION_DYNAMIC_BORDERS_H
@@ -8,6 +19,11 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include "owner_ids.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+struct civ_map_s;
 
 /* Border type enumeration */
 typedef enum {
@@ -28,7 +44,7 @@ typedef enum {
     CIV_BORDER_CONFLICT_REFUGEE_CRISIS
 } civ_border_conflict_type_t;
 
-/* Border segment structure */
+/* Hand-placed border segment; its tension is its owner pair's */
 typedef struct {
     char id[STRING_SHORT_LEN];
     char territory_a[STRING_SHORT_LEN];
@@ -36,8 +52,7 @@ typedef struct {
     civ_vec2_t start_point;
     civ_vec2_t end_point;
     civ_border_type_t border_type;
-    civ_float_t fortification_level;
-    civ_float_t tension_level;
+    uint32_t pair;                 /* slot in the pair arrays */
     time_t last_incident;
 } civ_border_segment_t;
 
@@ -55,8 +70,26 @@ typedef struct {
     civ_float_t economic_impact;
 } civ_border_conflict_t;
 
+/* Owner pairs a < b, one slot each, structure of arrays */
+typedef struct {
+    uint32_t* keys;                /* (a << 16 | b) + 1, 0 = empty */
+    uint32_t* slots;               /* pair slot per key */
+    uint32_t key_capacity;         /* power of two, 0 = unallocated */
+
+    civ_owner_index_t* owner_a;
+    civ_owner_index_t* owner_b;
+    uint32_t* contact;             /* shared land tile edges */
+    uint8_t* type;                 /* civ_border_type_t */
+    civ_float_t* drift;            /* tension per unit time from the type */
+    civ_float_t* tension;          /* 0..1 */
+    civ_float_t* fortification;
+    size_t count;
+    size_t capacity;
+} civ_border_pairs_t;
+
 /* Dynamic borders system */
 typedef struct {
+    civ_border_pairs_t pairs;
     civ_border_segment_t* border_segments;
     size_t segment_count;
     size_t segment_capacity;
@@ -78,5 +111,17 @@ void civ_dynamic_borders_update(civ_dynamic_borders_t* db, civ_float_t time_delt
 civ_float_t civ_dynamic_borders_get_tension(civ_dynamic_borders_t* db, const char* territory_a,
                                             const char* territory_b);
 
+/* Count every owner pair's shared edges on map and follow its ownership
+   changes from then on; rebuilds unless already attached. False only when
+   out of memory. The map must be detached from, or destroyed, first. */
+bool civ_dynamic_borders_attach(civ_dynamic_borders_t* db, struct civ_map_s* map);
+void civ_dynamic_borders_detach(civ_dynamic_borders_t* db, struct civ_map_s* map);
+
+/* Tension and shared land edges of owners a and b, in either order */
+civ_float_t civ_dynamic_borders_pair_tension(const civ_dynamic_borders_t* db,
+                                             civ_owner_index_t a, civ_owner_index_t b);
+uint32_t civ_dynamic_borders_pair_contact(const civ_dynamic_borders_t* db,
+                                          civ_owner_index_t a, civ_owner_index_t b);
+
 #endif /* CIVILIZATION_DYNAMIC_BORDERS_H */
 
@@ -6,11 +6,30 @@
  * as PNG files and stored in data/flags/. Indexed by country_id.
  * PNG textures are loaded via stb_image.h. Falls back to colored
  * rectangles for nations without flag data.
+ *
+ * Loading the index also builds hash tables over country_id and file name,
+ * so both lookups are constant time.
+ *
+ * Textures are packed into a few atlas pages. Each flag is decoded on the
+ * worker pool and scaled into a fixed cell, with a half-size copy beside
+ * it for small list icons; a page is uploaded as soon as every flag on it
+ * is decoded. All flags on a page share one texture, so consecutive
+ * civ_flag_render calls are merged by the renderer into one draw.
+ *
+ * Procedural flags (nations without a flag file: new states, revolutions,
+ * custom governments) are rasterized from their vexillology design into
+ * cells of CIV_FLAG_RASTER_PAGES pages of their own. The cells are an LRU
+ * keyed by the design's hash, so identical designs share one cell and a
+ * design is rasterized once, on the worker pool. civ_flag_system_poll
+ * copies finished cells into their page's texture, each page created once
+ * when its first cell is used, so a burst of new nations costs cell
+ * uploads, not textures.
  */
 #ifndef CIV_FLAG_SYSTEM_H
 #define CIV_FLAG_SYSTEM_H
 
 #include "../../common.h"
+#include "../visuals/vexillology.h"
 #include <SDL3/SDL.h>
 #include <stdint.h>
 
@@ -20,21 +39,82 @@ extern "C" {
 
 #define CIV_FLAG_MAX_COUNT  512
 
+/* Atlas layout: a cell holds the flag and its half-size copy, each with a
+   1 px border copied from its edge so filtering never samples a neighbour */
+#define CIV_FLAG_PAGE_SIZE  1024
+#define CIV_FLAG_CELL_W     64
+#define CIV_FLAG_CELL_H     40
+#define CIV_FLAG_MAX_PAGES  8
+#define CIV_FLAG_RASTER_PAGES 2 /* pages for procedural flags */
+
+struct civ_worker_pool;
+
 /* ── Single flag entry ─────────────────────────────────────────── */
 typedef struct {
     uint32_t    country_id;
-    SDL_Texture *texture;       /* loaded PNG, or NULL if failed */
-    int         width, height;
+    SDL_Texture *texture;       /* atlas page, or NULL until uploaded */
+    int         width, height;  /* of the source PNG */
     char        filename[64];
+    SDL_FRect   src;            /* CIV_FLAG_CELL_W x CIV_FLAG_CELL_H */
+    SDL_FRect   src_small;      /* half size */
+    int         page;
+    bool        decoded;        /* written to its page by a worker */
 } civ_flag_entry_t;
 
-/* ── Flag system ────────────────────────────────────────────────── */
+/* One decode job; the system keeps one per flag */
+typedef struct {
+    struct civ_flag_system *fs;
+    uint32_t index;
+} civ_flag_job_t;
+
+/* One procedural flag cell of the LRU */
+enum { CIV_FLAG_RASTER_EMPTY, CIV_FLAG_RASTER_QUEUED, CIV_FLAG_RASTER_DONE,
+       CIV_FLAG_RASTER_UPLOADED };
+
 typedef struct {
+    civ_flag_entry_t entry;      /* what civ_flag_render draws */
+    civ_flag_t       design;
+    uint64_t         hash;       /* 0 = empty */
+    uint64_t         last_used;
+    uint8_t         *pixels;     /* the rasterized cell until uploaded */
+    SDL_AtomicInt    state;      /* CIV_FLAG_RASTER_* */
+    struct civ_flag_system *fs;
+} civ_flag_raster_t;
+
+/* ── Flag system ────────────────────────────────────────────────── */
+typedef struct civ_flag_system {
     civ_flag_entry_t *flags;
     uint32_t          count;
     uint32_t          capacity;
     SDL_Renderer     *renderer;
     char              flags_dir[256];
+
+    /* Hash -> index + 1 (0 = empty), slot_mask + 1 each */
+    uint32_t         *id_slots;
+    uint32_t         *file_slots;  /* keyed on the lower-cased filename */
+    uint32_t          slot_mask;
+
+    /* Atlas pages; pixels are freed once the page is uploaded */
+    SDL_Texture      *pages[CIV_FLAG_MAX_PAGES];
+    uint8_t          *page_pixels[CIV_FLAG_MAX_PAGES]; /* RGBA bytes */
+    SDL_AtomicInt     page_pending[CIV_FLAG_MAX_PAGES]; /* flags to decode */
+    int               page_count;
+    civ_flag_job_t   *jobs;
+    SDL_AtomicInt     pending;   /* decode jobs queued or running */
+    struct civ_worker_pool *pool;
+    int               load_step; /* startup timeline step of the load */
+    bool              loading;
+
+    /* Procedural flags: hash -> raster + 1 (0 = empty), raster_mask + 1 */
+    civ_flag_raster_t *rasters;
+    uint32_t          raster_count;
+    uint32_t         *raster_slots;
+    uint32_t          raster_mask;
+    uint64_t          raster_clock;  /* bumped per lookup, for the LRU */
+    SDL_Texture      *raster_pages[CIV_FLAG_RASTER_PAGES];
+    SDL_AtomicInt     raster_pending; /* raster jobs queued or running */
+    SDL_AtomicInt     raster_ready;   /* rasterized, not yet uploaded */
+    struct civ_worker_pool *raster_pool;
 } civ_flag_system_t;
 
 /* ── Lifecycle ─────────────────────────────────────────────────── */
@@ -46,7 +126,21 @@ civ_result_t       civ_flag_system_load(civ_flag_system_t *fs,
                                         const char *index_path,
                                         const char *flags_dir);
 
-/* Load all PNG textures via stb_image — requires SDL_Renderer */
+/* Parse an index from memory (e.g. a world pack section) */
+civ_result_t       civ_flag_system_load_view(civ_flag_system_t *fs,
+                                             const uint8_t *data, size_t size,
+                                             const char *flags_dir);
+
+/* Queue every flag for decoding on pool (NULL = decode now, on the calling
+   thread) and return at once; civ_flag_system_poll uploads the pages */
+civ_result_t       civ_flag_system_begin_load(civ_flag_system_t *fs,
+                                              struct civ_worker_pool *pool);
+/* Upload pages whose flags are all decoded and procedural cells that are
+   rasterized — render thread, once a frame. Returns the number of flags
+   that became drawable. */
+int                civ_flag_system_poll(civ_flag_system_t *fs);
+
+/* Load all PNG textures and wait for them — requires SDL_Renderer */
 int                civ_flag_system_load_textures(civ_flag_system_t *fs);
 
 /* ── Lookup ────────────────────────────────────────────────────── */
@@ -55,8 +149,16 @@ const civ_flag_entry_t *civ_flag_system_get(const civ_flag_system_t *fs,
 const civ_flag_entry_t *civ_flag_system_get_by_iso(const civ_flag_system_t *fs,
                                                     const char *iso_a2);
 
+/* The procedural flag of design, rasterized on pool (NULL = now). Its
+   texture is NULL until civ_flag_system_poll uploads it, so call this every
+   frame like the other lookups: the entry is valid until a later miss
+   evicts it. NULL when every cell is still being rasterized. */
+const civ_flag_entry_t *civ_flag_system_procedural(civ_flag_system_t *fs,
+                                                   const civ_flag_t *design,
+                                                   struct civ_worker_pool *pool);
+
 /* ── Render ────────────────────────────────────────────────────── */
-/* Draw flag scaled to the given rect */
+/* Draw flag scaled to the given rect; small rects use the half-size copy */
 void civ_flag_render(SDL_Renderer *r, const civ_flag_entry_t *flag,
                      int x, int y, int w, int h);
 
@@ -0,0 +1,64 @@
+/**
+ * @file hydrology.h
+ * @brief Rivers, lakes and drainage basins from the generated relief
+ *
+ * One pass at generation time, in three stages over the tile grid:
+ *
+ * - Priority flood. Every sea tile bordering land (and land on the polar
+ *   rows) is an outlet. Tiles are settled lowest first from a binary heap;
+ *   a neighbour lying at or below the tile that reached it is raised a step
+ *   above it and queued on a FIFO instead, so depressions fill and flats
+ *   drain without touching the heap. O(n log n) in the worst case and close
+ *   to O(n) on flat ground.
+ * - D8 flow. On the filled surface each land tile drains to its steepest
+ *   lower neighbour of eight (x wraps). This only reads the filled heights,
+ *   so it runs in CIV_MAP_GEN_BLOCK squares across the worker pool.
+ * - Accumulation. The flood's settling order is lowest first, which every
+ *   receiver precedes, so walking it backwards adds each tile's upstream
+ *   area into its receiver in O(n). A tile draining off the land closes a
+ *   basin of its accumulated area.
+ *
+ * Tiles with at least CIV_HYDRO_RIVER_AREA upstream tiles carry a river;
+ * tiles the fill raised more than CIV_HYDRO_LAKE_DEPTH become lakes. Rivers
+ * and lake shores gain fertility and moisture, large river mouths become
+ * wetland, and the major valleys turn CIV_TERRAIN_VALLEY, so agriculture,
+ * movement and site scoring read the drainage from the tiles themselves.
+ */
+#ifndef CIV_WORLD_HYDROLOGY_H
+#define CIV_WORLD_HYDROLOGY_H
+
+#include "map_generator.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct civ_worker_pool;
+
+#define CIV_HYDRO_RIVER_AREA  192     /* upstream tiles that make a river */
+#define CIV_HYDRO_VALLEY_AREA 3072    /* ... and a valley around it */
+#define CIV_HYDRO_DELTA_AREA  16384   /* ... and a wetland delta at its mouth */
+#define CIV_HYDRO_LAKE_DEPTH  0.015f  /* fill above the ground that floods a tile */
+
+typedef struct {
+  int32_t river_tiles;
+  int32_t lake_tiles;
+  int32_t basins;          /* outlets draining at least CIV_HYDRO_RIVER_AREA tiles */
+  int32_t largest_basin;   /* tiles */
+} civ_hydrology_stats_t;
+
+/**
+ * @brief Derive rivers and lakes from map's elevation and write them to its tiles
+ *
+ * Land is what is not CIV_LAND_USE_WATER. Updates the map's river and land
+ * counts and resyncs its planes. pool and stats may be NULL; the result does
+ * not depend on the pool.
+ */
+civ_result_t civ_hydrology_generate(civ_map_t *map, struct civ_worker_pool *pool,
+                                    civ_hydrology_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* CIV_WORLD_HYDROLOGY_H */
@@ -9,6 +9,8 @@
 #include "../../common.h"
 #include "../../types.h"
 #include "../environment/geography.h"
+#include "map_metric.h"
+#include "owner_ids.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -31,6 +33,9 @@ extern "C" {
 #define CIV_DEFAULT_MAP_WIDTH 2048
 #define CIV_DEFAULT_MAP_HEIGHT 1024
 
+/** Generation work unit: square blocks run independently on a worker pool */
+#define CIV_MAP_GEN_BLOCK 256
+
 /** River generation limits */
 #define CIV_MAX_RIVERS_PER_MAP 50
 #define CIV_MAX_RIVER_LENGTH 500
@@ -41,6 +46,13 @@ extern "C" {
 
 /**
  * @brief Represents a single tile on the map with all environmental properties
+ *
+ * Attributes documented as 0.0-1.0 are stored as unsigned normalized
+ * integers: 16 bits for the fields terrain classification and settlement
+ * scoring compare against thresholds, 8 bits for the display overlays.
+ * Read and write them through the civ_tile_* accessors below, which decode
+ * to and encode from floats. cultural_influence is integrated turn by turn
+ * and stays a float32 so small increments are not lost to rounding.
  */
 typedef struct {
   /* Position */
@@ -48,44 +60,174 @@ typedef struct {
   int32_t y;
 
   /* Core environmental properties */
-  civ_float_t elevation;   /**< 0.0 (deep ocean) to 1.0 (highest peak) */
-  civ_float_t moisture;    /**< 0.0 (arid) to 1.0 (saturated) */
-  civ_float_t temperature; /**< 0.0 (cold) to 1.0 (hot) */
+  uint16_t elevation;   /**< 0.0 (deep ocean) to 1.0 (highest peak) */
+  uint16_t moisture;    /**< 0.0 (arid) to 1.0 (saturated) */
+  uint16_t temperature; /**< 0.0 (cold) to 1.0 (hot) */
+  uint16_t fertility;   /**< 0.0 (infertile) to 1.0 (highly fertile) */
 
-  /* Terrain classification */
-  civ_terrain_type_t terrain;   /**< Physical terrain type */
-  civ_land_use_type_t land_use; /**< Biome/land use classification */
+  uint8_t vegetation_density;  /**< 0.0 (barren) to 1.0 (dense) */
+  uint8_t resources;           /**< 0.0 (none) to 1.0 (abundant) */
+
+  /* Map view overlays */
+  uint8_t political_influence; /**< 0.0 (none) to 1.0 (max) */
+  uint8_t population_density;  /**< 0.0 (none) to 1.0 (max) */
+  float cultural_influence;    /**< 0.0 (none) to 1.0 (max) */
 
-  /* Resource and fertility */
-  civ_float_t vegetation_density; /**< 0.0 (barren) to 1.0 (dense) */
-  civ_float_t fertility; /**< 0.0 (infertile) to 1.0 (highly fertile) */
-  civ_float_t resources; /**< 0.0 (none) to 1.0 (abundant) */
+  /* Terrain classification */
+  uint8_t terrain;  /**< civ_terrain_type_t */
+  uint8_t land_use; /**< civ_land_use_type_t */
 
   /* Flags */
   bool has_river;    /**< True if tile contains a river */
   bool has_resource; /**< True if tile has natural resources */
 
-  /* Map view overlays */
-  civ_float_t political_influence; /**< 0.0 (none) to 1.0 (max) */
-  civ_float_t population_density;  /**< 0.0 (none) to 1.0 (max) */
-  civ_float_t cultural_influence;  /**< 0.0 (none) to 1.0 (max) */
-
   /* Visibility flags (Fog of War) */
   bool is_explored; /**< True if player has visited this tile at least once */
   bool is_visible;  /**< True if player currently has line-of-sight */
 
   /* Territory Ownership */
-  char     owner_id[STRING_SHORT_LEN];
+  civ_owner_index_t owner_index;  /**< interned owner id, CIV_OWNER_NONE = unclaimed */
   uint32_t political_color;  /**< country color for political map, 0 = unclaimed */
 } civ_map_tile_t;
 
+/* Unsigned normalized storage; encode clamps to [0, 1] and rounds */
+static inline float civ_unorm16_decode(uint16_t v) {
+  return (float)v * (1.0f / 65535.0f);
+}
+
+static inline uint16_t civ_unorm16_encode(civ_float_t v) {
+  return (uint16_t)(v <= 0.0 ? 0 : v >= 1.0 ? 65535 : v * 65535.0 + 0.5);
+}
+
+static inline float civ_unorm8_decode(uint8_t v) {
+  return (float)v * (1.0f / 255.0f);
+}
+
+static inline uint8_t civ_unorm8_encode(civ_float_t v) {
+  return (uint8_t)(v <= 0.0 ? 0 : v >= 1.0 ? 255 : v * 255.0 + 0.5);
+}
+
+/* Quantized tile fields: X(field, bits) */
+#define CIV_TILE_UNORM_FIELDS(X)                                               \
+  X(elevation, 16)                                                             \
+  X(moisture, 16)                                                              \
+  X(temperature, 16)                                                           \
+  X(fertility, 16)                                                             \
+  X(vegetation_density, 8)                                                     \
+  X(resources, 8)                                                              \
+  X(political_influence, 8)                                                    \
+  X(population_density, 8)
+
+/* civ_tile_<field>(tile) and civ_tile_set_<field>(tile, value) */
+#define CIV_TILE_ACCESSORS(field, bits)                                        \
+  static inline float civ_tile_##field(const civ_map_tile_t *t) {              \
+    return civ_unorm##bits##_decode(t->field);                                 \
+  }                                                                            \
+  static inline void civ_tile_set_##field(civ_map_tile_t *t, civ_float_t v) {  \
+    t->field = civ_unorm##bits##_encode(v);                                    \
+  }
+CIV_TILE_UNORM_FIELDS(CIV_TILE_ACCESSORS)
+#undef CIV_TILE_ACCESSORS
+
 /**
- * @brief Complete 2D map containing all tiles and generation metadata
+ * @brief A tile's attributes decoded to full precision
+ *
+ * Debug and compatibility view of the quantized fields, in the shape the
+ * tile had before they were packed.
+ */
+typedef struct {
+  civ_float_t elevation;
+  civ_float_t moisture;
+  civ_float_t temperature;
+  civ_float_t fertility;
+  civ_float_t vegetation_density;
+  civ_float_t resources;
+  civ_float_t political_influence;
+  civ_float_t population_density;
+  civ_float_t cultural_influence;
+} civ_map_tile_attrs_t;
+
+static inline civ_map_tile_attrs_t civ_map_tile_decode(const civ_map_tile_t *t) {
+  civ_map_tile_attrs_t a;
+#define CIV_TILE_DECODE(field, bits) a.field = civ_tile_##field(t);
+  CIV_TILE_UNORM_FIELDS(CIV_TILE_DECODE)
+#undef CIV_TILE_DECODE
+  a.cultural_influence = t->cultural_influence;
+  return a;
+}
+
+static inline void civ_map_tile_encode(civ_map_tile_t *t,
+                                       const civ_map_tile_attrs_t *a) {
+#define CIV_TILE_ENCODE(field, bits) civ_tile_set_##field(t, a->field);
+  CIV_TILE_UNORM_FIELDS(CIV_TILE_ENCODE)
+#undef CIV_TILE_ENCODE
+  t->cultural_influence = (float)a->cultural_influence;
+}
+
+/** Bits of civ_map_planes_t.flags */
+#define CIV_TILE_FLAG_RIVER    0x01u
+#define CIV_TILE_FLAG_RESOURCE 0x02u
+#define CIV_TILE_FLAG_WATER    0x10u
+
+/**
+ * @brief Structure-of-arrays mirror of the hot tile fields
+ *
+ * One plane per field, indexed like civ_map_t.tiles, so scans that read one
+ * or two fields stream only those. civ_map_tile_t stays the authoritative
+ * store during migration: terrain planes are refreshed by
+ * civ_map_sync_planes() after generation or load, and owner / visibility
+ * changes go through the civ_map_set_* writers, which update both.
  */
 typedef struct {
+  float             *elevation;
+  float             *moisture;
+  float             *temperature;
+  float             *fertility;
+  uint8_t           *terrain;         /**< civ_terrain_type_t */
+  uint8_t           *land_use;        /**< civ_land_use_type_t */
+  civ_owner_index_t *owner;
+  uint8_t           *flags;           /**< CIV_TILE_FLAG_* */
+  uint32_t          *political_color;
+  uint64_t          *visible;         /**< fog bitplane, bit i = tile i */
+  uint64_t          *explored;        /**< fog bitplane, bit i = tile i */
+} civ_map_planes_t;
+
+struct civ_map_s;
+
+/**
+ * @brief Notified by civ_map_set_owner after a tile changes owner
+ */
+typedef void (*civ_map_owner_listener_t)(void *user_data,
+                                         const struct civ_map_s *map,
+                                         size_t index,
+                                         civ_owner_index_t old_owner,
+                                         civ_owner_index_t new_owner);
+
+#define CIV_MAP_MAX_OWNER_LISTENERS 12
+
+/* Tile writers bump a revision per CIV_MAP_REGION_SIZE-square region so
+   caches of derived data (baked map textures) can tell what went stale */
+#define CIV_MAP_REGION_SHIFT 8
+#define CIV_MAP_REGION_SIZE  (1 << CIV_MAP_REGION_SHIFT)
+
+/**
+ * @brief Complete 2D map containing all tiles and generation metadata
+ */
+typedef struct civ_map_s {
   civ_map_tile_t *tiles; /**< 1D array of tiles in row-major order */
+  civ_map_planes_t *planes; /**< optional SoA mirror, NULL = tiles only */
+  struct {
+    civ_map_owner_listener_t fn;
+    void *user_data;
+  } owner_listeners[CIV_MAP_MAX_OWNER_LISTENERS];
+  int owner_listener_count;
+  uint32_t *region_revision; /**< per region, row-major; NULL if unallocated */
+  int32_t region_cols;
+  int32_t region_rows;
+  uint32_t serial;       /**< distinct for every map created */
   int32_t width;         /**< Map width in tiles */
   int32_t height;        /**< Map height in tiles */
+  civ_map_metric_t metric; /**< km and km^2 by row */
 
   /* Generation parameters */
   civ_float_t sea_level; /**< Elevation threshold for ocean/land */
@@ -98,6 +240,23 @@ typedef struct {
 
 } civ_map_t;
 
+/**
+ * @brief Stages civ_map_generate reports progress for, in order
+ */
+typedef enum {
+  CIV_MAP_GEN_STAGE_HEIGHTMAP = 0, /**< tile blocks: elevation, land, climate fields */
+  CIV_MAP_GEN_STAGE_RIVERS,        /**< hydrology, with generate_rivers */
+  CIV_MAP_GEN_STAGE_RESOURCES,     /**< resource placement, with generate_resources */
+  CIV_MAP_GEN_STAGE_FINALIZE,      /**< planes and region revisions */
+  CIV_MAP_GEN_STAGE_COUNT
+} civ_map_gen_stage_t;
+
+/* Called on the generating thread as stage advances; fraction is of the
+   whole generation, 0 to 1, and never goes back */
+typedef void (*civ_map_gen_progress_fn_t)(void *user_data,
+                                          civ_map_gen_stage_t stage,
+                                          float fraction);
+
 /**
  * @brief Parameters controlling map generation behavior
  */
@@ -123,6 +282,11 @@ typedef struct {
   civ_float_t noise_scale; /**< Noise frequency scaling */
   int32_t noise_octaves;   /**< Number of noise octaves */
 
+  /* Execution */
+  struct civ_worker_pool *worker_pool; /**< optional; NULL = calling thread */
+  civ_map_gen_progress_fn_t progress;  /**< optional */
+  void *progress_user_data;
+
 } civ_map_gen_params_t;
 
 /**
@@ -221,12 +385,146 @@ civ_map_tile_t *civ_map_get_adjacent_tile(const civ_map_t *map,
 civ_float_t civ_map_tile_distance(const civ_map_tile_t *a,
                                   const civ_map_tile_t *b);
 
+/* ========================================================================== */
+/* Tile Planes (SoA) ---------------------------------------------------------
+ */
+
+/**
+ * @brief Allocate the SoA planes and fill them from the tiles
+ * @param map Map instance
+ * @return true if planes are available afterwards
+ */
+bool civ_map_enable_planes(civ_map_t *map);
+
+/**
+ * @brief Free the SoA planes; accessors fall back to the tiles
+ */
+void civ_map_disable_planes(civ_map_t *map);
+
+/**
+ * @brief Refresh every plane from the tiles after bulk tile edits
+ */
+void civ_map_sync_planes(civ_map_t *map);
+
+/**
+ * @brief Refresh one tile's planes after editing it through a tile pointer
+ */
+void civ_map_sync_tile(civ_map_t *map, size_t index);
+
+/**
+ * @brief Bump the revision of the region holding tile index
+ *
+ * The civ_map_set_* writers and civ_map_sync_tile do this themselves; call
+ * it after writing other displayed fields through a tile pointer.
+ */
+void civ_map_touch_tile(civ_map_t *map, size_t index);
+
+/**
+ * @brief Bump every region, e.g. after regenerating the whole map
+ */
+void civ_map_touch_all(civ_map_t *map);
+
+static inline uint32_t civ_map_region_revision(const civ_map_t *map,
+                                               int32_t rx, int32_t ry) {
+  return map->region_revision
+             ? map->region_revision[(size_t)ry * map->region_cols + rx]
+             : 0;
+}
+
+/**
+ * @brief Set a tile's owner and political colour in tiles and planes
+ *
+ * Calls the owner listeners when the owner actually changes.
+ */
+void civ_map_set_owner(civ_map_t *map, size_t index, civ_owner_index_t owner,
+                       uint32_t political_color);
+
+/**
+ * @brief Register an owner-change listener
+ * @return false if the listener table is full
+ */
+bool civ_map_add_owner_listener(civ_map_t *map, civ_map_owner_listener_t fn,
+                                void *user_data);
+
+/**
+ * @brief Remove a listener registered with the same fn and user_data
+ */
+void civ_map_remove_owner_listener(civ_map_t *map, civ_map_owner_listener_t fn,
+                                   void *user_data);
+
+/**
+ * @brief Whether fn/user_data is registered on this map
+ */
+bool civ_map_has_owner_listener(const civ_map_t *map,
+                                civ_map_owner_listener_t fn,
+                                const void *user_data);
+
+/**
+ * @brief Set a tile's fog-of-war state in tiles and planes
+ */
+void civ_map_set_visibility(civ_map_t *map, size_t index, bool visible,
+                            bool explored);
+
+/* Per-field reads by tile index; use the planes when present */
+static inline civ_owner_index_t civ_map_owner_at(const civ_map_t *map,
+                                                 size_t i) {
+  return map->planes ? map->planes->owner[i] : map->tiles[i].owner_index;
+}
+
+static inline bool civ_map_is_water_at(const civ_map_t *map, size_t i) {
+  return map->planes ? (map->planes->flags[i] & CIV_TILE_FLAG_WATER) != 0
+                     : map->tiles[i].land_use == CIV_LAND_USE_WATER;
+}
+
+static inline bool civ_map_visible_at(const civ_map_t *map, size_t i) {
+  return map->planes ? (map->planes->visible[i >> 6] >> (i & 63)) & 1u
+                     : map->tiles[i].is_visible;
+}
+
+static inline bool civ_map_explored_at(const civ_map_t *map, size_t i) {
+  return map->planes ? (map->planes->explored[i >> 6] >> (i & 63)) & 1u
+                     : map->tiles[i].is_explored;
+}
+
+static inline float civ_map_elevation_at(const civ_map_t *map, size_t i) {
+  return map->planes ? map->planes->elevation[i]
+                     : civ_tile_elevation(&map->tiles[i]);
+}
+
+static inline float civ_map_fertility_at(const civ_map_t *map, size_t i) {
+  return map->planes ? map->planes->fertility[i]
+                     : civ_tile_fertility(&map->tiles[i]);
+}
+
+/**
+ * @brief Owner id string of a tile (compatibility accessor)
+ * @param tile Tile to query
+ * @return Interned owner id, "" when unclaimed
+ */
+const char *civ_map_tile_owner_id(const civ_map_tile_t *tile);
+
+/**
+ * @brief Set a tile's owner by id string, interning it
+ *
+ * Touches the tile only; use civ_map_set_owner (or civ_map_sync_tile
+ * afterwards) when the map has planes enabled.
+ * @param tile Tile to modify
+ * @param owner_id Owner id, NULL or "" to clear
+ */
+void civ_map_tile_set_owner_id(civ_map_tile_t *tile, const char *owner_id);
+
 /* ========================================================================== */
 /* Map Generation ------------------------------------------------------------
  */
 
 /**
  * @brief Generate complete map using specified parameters
+ *
+ * Tiles are produced in CIV_MAP_GEN_BLOCK squares that depend only on their
+ * own coordinates, so a worker pool in params yields the same map as the
+ * serial path. With params->generate_rivers, hydrology runs over the result
+ * (civ_hydrology_generate), equally independent of the pool. params->progress
+ * hears each stage start, the heightmap once per row of blocks, and the end.
  * @param map Map to generate (must be initialized)
  * @param params Generation parameters
  * @return Result indicating success or failure
@@ -253,7 +551,7 @@ civ_map_generate_terrain_with_params(civ_map_t *map,
                                      const civ_map_gen_params_t *params);
 
 /**
- * @brief Generate rivers flowing from mountains to oceans
+ * @brief Generate rivers and lakes from the map's relief (see hydrology.h)
  * @param map Map to generate rivers for
  * @return Result indicating success or failure
  */
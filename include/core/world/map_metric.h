@@ -0,0 +1,70 @@
+/**
+ * @file map_metric.h
+ * @brief Per-row ground metric of the equirectangular tile grid
+ *
+ * Rows are equal steps of latitude, north at row 0, and columns equal
+ * steps of longitude, so everything metric about a tile depends on its
+ * row alone. The tables hold, by row, the latitude and its cosine, the
+ * east-west spacing and the tile's area (the row's band of the sphere
+ * over the width, so the areas add up to the Earth's surface); the
+ * north-south spacing is the same for every row.
+ *
+ * Distances between tiles take the equirectangular approximation, the
+ * mean east-west spacing of the two rows against the north-south
+ * spacing, when both legs are under CIV_MAP_METRIC_SHORT_KM and the
+ * tiles are within CIV_MAP_METRIC_SHORT_DEGREES of longitude (near
+ * the poles a short leg can span half the globe); there it is within a
+ * fraction of a percent. Longer ones take the haversine, with
+ * the half-angle terms looked up by column and row offset, so the only
+ * calls left are one asin and one sqrt.
+ *
+ * Built by civ_map_create; the map owns the tables.
+ */
+#ifndef CIVILIZATION_MAP_METRIC_H
+#define CIVILIZATION_MAP_METRIC_H
+
+#include "../../common.h"
+#include "../../types.h"
+
+#define CIV_MAP_METRIC_EARTH_KM 6371.0  /* mean radius */
+#define CIV_MAP_METRIC_SHORT_KM 500.0f  /* legs below this skip the haversine */
+#define CIV_MAP_METRIC_SHORT_DEGREES 5  /* of longitude, likewise */
+
+typedef struct {
+  int32_t width, height;
+  float *lat_deg;   /* by row, at the row's centre */
+  float *cos_lat;
+  float *dx_km;     /* east-west tile spacing */
+  float *area_km2;  /* tile area */
+  float dy_km;      /* north-south tile spacing, every row */
+  int32_t short_cols; /* column offsets within CIV_MAP_METRIC_SHORT_DEGREES */
+  float *hav_col;   /* sin^2(dlon / 2) by column offset, 0..width/2 */
+  float *hav_row;   /* sin^2(dlat / 2) by row offset, 0..height-1 */
+} civ_map_metric_t;
+
+/* Fill the tables for a width x height grid; false without memory */
+bool civ_map_metric_init(civ_map_metric_t *metric, int32_t width,
+                         int32_t height);
+void civ_map_metric_free(civ_map_metric_t *metric);
+
+/* Ground distance in km between tiles (x0, y0) and (x1, y1); x wraps */
+float civ_map_metric_distance_km(const civ_map_metric_t *metric, int32_t x0,
+                                 int32_t y0, int32_t x1, int32_t y1);
+
+/* Row of a latitude, clamped to the grid */
+int32_t civ_map_metric_row_of(const civ_map_metric_t *metric, float lat_deg);
+
+static inline float civ_map_metric_area_km2(const civ_map_metric_t *metric,
+                                            int32_t y) {
+  return metric->area_km2[CLAMP(y, 0, metric->height - 1)];
+}
+
+/* Mean of the east-west and north-south spacing at row y, for turning a
+   distance counted in tiles into km */
+static inline float civ_map_metric_spacing_km(const civ_map_metric_t *metric,
+                                              int32_t y) {
+  return 0.5f * (metric->dx_km[CLAMP(y, 0, metric->height - 1)] +
+                 metric->dy_km);
+}
+
+#endif /* CIVILIZATION_MAP_METRIC_H */
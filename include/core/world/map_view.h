@@ -1,6 +1,13 @@
 /**
  * @file map_view.h
  * @brief Multiple map view system (political, geographical, demographical, etc.)
+ *
+ * A view copies nothing: it is a strided reference to the tile field it
+ * shows, in the SoA planes when the map has one for that field and in
+ * civ_map_tile_t otherwise, and reads decode in place. Switching or
+ * refreshing a view only re-resolves that reference, so it costs the same
+ * on any map size. Rebind (update_view or refresh_all) after the map's
+ * planes are enabled or disabled.
  */
 
 #ifndef CIVILIZATION_MAP_VIEW_H
@@ -22,10 +29,20 @@ typedef enum {
     CIV_MAP_VIEW_COUNT
 } civ_map_view_type_t;
 
+/* How a view's source field is stored */
+typedef enum {
+    CIV_MAP_VIEW_SOURCE_NONE = 0,  /* no data yet: reads 0 */
+    CIV_MAP_VIEW_SOURCE_FLOAT,
+    CIV_MAP_VIEW_SOURCE_UNORM8,
+    CIV_MAP_VIEW_SOURCE_UNORM16
+} civ_map_view_source_t;
+
 /* Map view data */
 typedef struct {
     civ_map_view_type_t view_type;
-    civ_float_t* data;  /* Per-tile data for this view */
+    const uint8_t* base;           /* field of tile 0 */
+    size_t stride;                 /* bytes from one tile's field to the next */
+    civ_map_view_source_t source;
     int32_t width;
     int32_t height;
     bool visible;
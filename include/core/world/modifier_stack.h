@@ -0,0 +1,98 @@
+/**
+ * @file modifier_stack.h
+ * @brief Per-owner aggregated multipliers, rebuilt only when an input moves
+ *
+ * Wonders, institutions, technology and policy each shape how much an owner
+ * produces, researches, earns and fights. Instead of every update asking
+ * each module, the table keeps one small stack of multipliers per tile
+ * owner index and the key of the inputs it was built from:
+ *
+ * - the wonder manager's revision (a wonder was built),
+ * - the economic policy's revision (a lever was set),
+ * - the technology tier, tech_index / CIV_MODIFIER_TECH_STEP,
+ * - each institution focus bonus in steps of 1 / CIV_MODIFIER_QUANTUM.
+ *
+ * civ_modifier_table_refresh compares keys and rebuilds only the stacks
+ * whose key changed; readers then take the stack by owner index with no
+ * lookups of their own. An owner with nothing bound reads the identity
+ * stack, plus any wonders it has built.
+ */
+#ifndef CIV_WORLD_MODIFIER_STACK_H
+#define CIV_WORLD_MODIFIER_STACK_H
+
+#include "../economy/economic_policy.h"
+#include "../governance/government.h"
+#include "owner_ids.h"
+#include "wonders.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CIV_MODIFIER_TECH_STEP  50     /* tech index per tier */
+#define CIV_MODIFIER_TECH_SCALE 1000.0 /* civ_knowledge_multiplier scale */
+#define CIV_MODIFIER_QUANTUM    256.0f /* institution bonus steps per 1.0 */
+
+/* Multipliers, 1.0 = no effect */
+typedef struct {
+  float production; /* wonders, production institutions, technology tier */
+  float science;    /* wonders, research institutions */
+  float culture;    /* wonders, identity institutions */
+  float gold;       /* wonders, commerce institutions */
+  float economy;    /* commerce institutions, enacted policy stance */
+  float military;   /* wonders, military institutions */
+} civ_modifier_stack_t;
+
+/* Where an owner's inputs live; borrowed, any may be NULL */
+typedef struct {
+  const civ_government_t *government;          /* institutions */
+  const int32_t *tech_index;
+  const civ_economic_policy_system_t *policy;
+} civ_modifier_source_t;
+
+/* The inputs a stack was built from */
+typedef struct {
+  uint32_t wonders;
+  uint32_t policy;
+  int32_t tech_tier;
+  int32_t institutions[CIV_INSTITUTION_FOCUS_COUNT];
+  bool built;
+} civ_modifier_key_t;
+
+typedef struct civ_modifier_table {
+  civ_modifier_stack_t *stacks;    /* by owner index */
+  civ_modifier_key_t *keys;
+  civ_modifier_source_t *sources;
+  uint32_t capacity;
+
+  const civ_wonder_manager_t *wonders;
+  uint64_t rebuilds;               /* stacks rebuilt since creation */
+} civ_modifier_table_t;
+
+civ_modifier_table_t *civ_modifier_table_create(const civ_wonder_manager_t *wonders);
+void civ_modifier_table_destroy(civ_modifier_table_t *table);
+
+/* Point owner's stack at source; cheap when source is what it was, so it
+   can be called every update. False only when out of memory. */
+bool civ_modifier_table_bind(civ_modifier_table_t *table,
+                             civ_owner_index_t owner,
+                             const civ_modifier_source_t *source);
+
+/**
+ * Rebuild every stack whose inputs changed since it was built
+ * @return Stacks rebuilt
+ */
+size_t civ_modifier_table_refresh(civ_modifier_table_t *table);
+
+/* Owner's stack as of the last refresh; the identity stack when unknown */
+const civ_modifier_stack_t *civ_modifier_stack_of(const civ_modifier_table_t *table,
+                                                  civ_owner_index_t owner);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CIV_WORLD_MODIFIER_STACK_H */
@@ -14,6 +14,7 @@
 #include "../../types.h"
 #include "../governance/government.h"
 #include "map_generator.h"
+#include "tile_field.h"
 #include <stdbool.h>
 
 #ifdef __cplusplus
@@ -51,9 +52,39 @@ typedef struct {
   int      owned_water_tiles;
 } civ_nation_economy_t;
 
+/* ── Resource profile (computed from owned tiles) ────────────────── */
+typedef struct {
+  uint16_t quantities[20];     /* one per CIV_RESOURCE_COUNT */
+  uint8_t  best_quality[20];
+  uint16_t total_resources;
+  int      distinct_types;
+} civ_nation_resource_profile_t;
+
+/* ── Territory aggregates (raw sums over owned tiles) ────────────── */
+typedef struct {
+  int      land_tiles;
+  int      water_tiles;
+  double   total_elevation;      /* land tiles only */
+  double   total_fertility;
+  double   land_km2;             /* by the map's row areas */
+  double   arable_km2;           /* land_km2 weighted by fertility */
+  uint32_t quantities[20];       /* one per CIV_RESOURCE_COUNT */
+  uint8_t  best_quality[20];
+  bool     quality_stale;        /* a best-quality tile was lost */
+} civ_nation_territory_t;
+
+/* ── Simulation detail (see nation_lod.h) ────────────────────────── */
+typedef struct {
+  uint8_t     interval;   /* updates per tick: 1, 4 or 16; 0 = not rated */
+  bool        replan;     /* ticked since its fiscal policy was last planned */
+  uint64_t    next_tick;  /* update it next ticks on */
+  civ_float_t banked_dt;  /* time of the updates it sat out */
+} civ_nation_lod_t;
+
 /* ── Nation ─────────────────────────────────────────────────────────── */
 typedef struct {
   char                    id[CIV_NATION_ID_MAX];
+  civ_owner_index_t       owner_index;     /* interned id, as stored on tiles */
   char                    name[CIV_NATION_NAME_MAX];
   uint32_t                color;
   uint32_t                color_accent;
@@ -87,6 +118,13 @@ typedef struct {
 
   /* Economic state */
   civ_nation_economy_t           economy;
+  civ_nation_resource_profile_t  resources;  /* as of the last economy pass */
+  civ_nation_territory_t         territory;  /* maintained per ownership change */
+
+  /* Owned tiles in no particular order, kept with territory */
+  uint32_t *tiles;
+  int32_t   tile_count;
+  int32_t   tile_capacity;
 
   /* Starting indices */
   int32_t tech_index;
@@ -98,15 +136,12 @@ typedef struct {
   int64_t population;
   float   cost_of_living;   /* 1.0 = baseline */
   float   gdp_per_capita;
-} civ_nation_t;
 
-/* ── Resource profile (computed from owned tiles) ────────────────── */
-typedef struct {
-  uint16_t quantities[20];     /* one per CIV_RESOURCE_COUNT */
-  uint8_t  best_quality[20];
-  uint16_t total_resources;
-  int      distinct_types;
-} civ_nation_resource_profile_t;
+  civ_nation_lod_t lod;     /* derived each update, not saved */
+
+  /* Merged into another nation; keeps its slot so nation indices hold */
+  bool defunct;
+} civ_nation_t;
 
 /* ── Nation manager ────────────────────────────────────────────────── */
 typedef struct {
@@ -114,9 +149,43 @@ typedef struct {
   int            count;
   int            capacity;
   int            player_nation_index;
+  int            focus_nation_index;  /* the one the player is looking at; -1 = none.
+                                         Presentation only: never read by the simulation */
+  float          lod_distance_scale;  /* on the LOD capital distances; 1 = as defined */
+
+  /* Owner index -> nation index (-1 = not a nation), see owner_ids.h */
+  int           *owner_nation;
+  uint32_t       owner_nation_size;
+
+  /* Territory aggregates are current while this manager is the map's owner
+     listener and was built against territory_resources */
+  bool           territory_valid;
+  const void    *territory_resources;
+  uint32_t       territory_depletions; /* resource map log entries applied */
+  uint32_t       territory_resets;     /* its depletion_resets then */
+  uint32_t      *tile_slot;      /* owned tile -> place in its nation's tiles */
+  size_t         tile_slot_size; /* map tiles it was sized for */
+  uint32_t       political_revision; /* bumped by each merge and secession */
+
+  /* Per-nation economy model, one lane per nation; see economy_batch.h */
+  struct civ_economy_batch *economy_batch;
+  int            fiscal_cursor; /* next nation civ_nation_plan_fiscal_policy visits */
+  struct civ_fiscal_speculation *fiscal_speculation; /* plans worked out ahead */
+
+  /* Every nation's government and subsystems, slot order = nation order */
+  civ_government_arena_t *government_arena;
+
+  /* Owned tile -> subdivision of its owner; current while subdivisions_valid
+     and this manager is the map's owner listener */
+  civ_subdivision_plane_t *subdivision_plane;
+  bool           subdivisions_valid;
+  uint64_t       subdivision_steps; /* tile-field step last aggregated */
 } civ_nation_manager_t;
 
 civ_nation_manager_t *civ_nation_manager_create(void);
+/* Room for capacity nations; the array never moves, so nation pointers
+   stay good for the manager's life */
+civ_nation_manager_t *civ_nation_manager_create_sized(int capacity);
 void civ_nation_manager_destroy(civ_nation_manager_t *mgr);
 
 /* Create all starting nations from borders data + nations_data */
@@ -128,6 +197,18 @@ void civ_nation_manager_init_from_data(civ_nation_manager_t *mgr,
 /* Legacy: 8 hardcoded nations for procedural fallback */
 void civ_nation_manager_init_default(civ_nation_manager_t *mgr);
 
+/* Append a nation with the default government; NULL when full. Call
+   civ_nation_manager_index_owners once the batch is added. */
+civ_nation_t *civ_nation_manager_add(civ_nation_manager_t *mgr,
+                                     const char *id, const char *name,
+                                     uint32_t color);
+
+/* Interned tile owner index for a nation (interns its id on first use) */
+civ_owner_index_t civ_nation_owner_index(civ_nation_t *nation);
+
+/* Rebuild the owner -> nation table after nations are added or renamed */
+void civ_nation_manager_index_owners(civ_nation_manager_t *mgr);
+
 /* Claim territory tiles on the world map for a nation */
 void civ_nation_claim_territory(civ_nation_t *nation, civ_map_t *map);
 void civ_nation_claim_all_territories(civ_nation_manager_t *mgr, civ_map_t *map);
@@ -136,7 +217,8 @@ void civ_nation_claim_all_territories(civ_nation_manager_t *mgr, civ_map_t *map)
 void civ_nation_claim_from_borders(civ_nation_t *n, civ_map_t *map,
                                    int nation_idx, int map_w, int map_h);
 
-/* Compute resource profile from owned tiles */
+/* Compute resource profile from owned tiles (full map scan; the last
+   economy pass also caches it in nation->resources) */
 void civ_nation_calculate_resources(civ_nation_t *n, civ_map_t *map,
                                     const void *resource_map,
                                     civ_nation_resource_profile_t *out);
@@ -150,7 +232,7 @@ bool civ_nation_contains_point(civ_nation_t *nation, float lon, float lat);
 bool civ_nation_contains_tile(civ_nation_t *nation, int32_t tx, int32_t ty,
                               int32_t map_w, int32_t map_h);
 
-/* Find nation owning a tile by checking owner_id on the tile itself */
+/* Find nation owning a tile from the owner index on the tile itself */
 civ_nation_t *civ_nation_find_owner(civ_nation_manager_t *mgr, civ_map_t *map,
                                     int32_t tx, int32_t ty);
 
@@ -158,11 +240,94 @@ civ_nation_t *civ_nation_find_owner(civ_nation_manager_t *mgr, civ_map_t *map,
 void civ_nation_compute_economy(civ_nation_t *n, civ_map_t *map,
                                 const void *resource_map);
 
-/* Compute economies for all nations and global aggregates */
+/* Compute economies for all nations and global aggregates. The first call
+   for a map builds every nation's territory aggregates in one pass and
+   registers an owner listener that keeps them current, so later calls
+   only touch nations, not tiles. */
 void civ_nation_compute_all_economies(civ_nation_manager_t *mgr, civ_map_t *map,
                                        const void *resource_map,
                                        civ_nation_economy_t *global_out);
 
+struct civ_modifier_table;
+
+/* Compute all economies, then advance every nation's economy model by dt
+   in one batch and publish its results into each nation's economy. Each
+   nation's technology counts at its modifier stack's economy multiplier;
+   modifiers may be NULL. */
+void civ_nation_update_economies(civ_nation_manager_t *mgr, civ_map_t *map,
+                                 const void *resource_map,
+                                 const struct civ_modifier_table *modifiers,
+                                 civ_float_t dt,
+                                 civ_nation_economy_t *global_out);
+
+/* Build the territory aggregates and tile lists for map now unless they
+   are already current; the first economy pass does the same */
+void civ_nation_manager_track_territory(civ_nation_manager_t *mgr, civ_map_t *map,
+                                        const void *resource_map);
+
+/* Nation idx's owned tiles, any order; NULL while territory is untracked */
+const uint32_t *civ_nation_owned_tiles(const civ_nation_manager_t *mgr, int idx,
+                                       int32_t *count);
+
+/* What a bulk change of hands moved */
+typedef struct {
+  int32_t tiles;
+  int64_t population;
+  int32_t min_x, min_y, max_x, max_y; /* box of the moved tiles; min > max when none */
+} civ_nation_transfer_t;
+
+/* Nation from joins into: its subdivisions, every tile it owns (walked
+   from its tile list, not the map), its people, indices, economy lane and
+   government offices. from stays in its slot, defunct, with nothing left,
+   its government destroyed. Refused, with nothing changed, when the two
+   hold more than CIV_SUBDIVISION_MAX subdivisions between them. */
+civ_result_t civ_nation_manager_absorb(civ_nation_manager_t *mgr, civ_map_t *map,
+                                       int into, int from,
+                                       civ_nation_transfer_t *out);
+
+/* A new nation takes from's subdivisions in subdivision_mask (bit s is
+   subdivision s) and the tiles of from lying in them, with people in
+   proportion to the land it takes. The parent keeps its other
+   subdivisions; those that left stay as empty boxes so its governance
+   subdivisions keep their places. Returns the new nation's index, -1 on
+   failure, with nothing changed. */
+int civ_nation_manager_secede(civ_nation_manager_t *mgr, civ_map_t *map, int from,
+                              uint32_t subdivision_mask, const char *id,
+                              const char *name, uint32_t color,
+                              civ_nation_transfer_t *out);
+
+/* Refresh every subdivision's cached sums from the tile field after it
+   stepped. The first call for a map places each owned tile in its owner's
+   subdivision (the first box holding it) in one pass and registers an
+   owner listener that moves tiles as they change hands. */
+void civ_nation_aggregate_subdivisions(civ_nation_manager_t *mgr, civ_map_t *map,
+                                       const civ_tile_field_t *field);
+
+struct civ_worker_pool;
+
+/* AI nations re-weigh their tax and spending levers: a few nations per
+   call, each projecting a grid of changes on pool and keeping the best.
+   A lane speculated from exactly its current state takes that plan. */
+void civ_nation_plan_fiscal_policy(civ_nation_manager_t *mgr,
+                                   struct civ_worker_pool *pool);
+
+/* Work out the next plan call's plans on pool in the background, from
+   copies of the lanes it will visit; a lane that changes before that call
+   is planned again there. Plans only depend on the lane copy, so whether a
+   guess is used never changes the outcome. */
+void civ_nation_speculate_fiscal_policy(civ_nation_manager_t *mgr,
+                                        struct civ_worker_pool *pool);
+/* Wait for and drop any speculation in flight */
+void civ_nation_discard_fiscal_speculation(civ_nation_manager_t *mgr);
+
+/* Save section: each nation's economy, population, indices and
+   government, keyed by nation id, then (v2) each one's name, colours,
+   capital, boxes and merge state. Loading recreates nations the session
+   does not have, such as those that seceded; a v1 section only updates
+   known ids. Territory is rebuilt from the tiles, not stored. */
+#define CIV_NATION_SAVE_VERSION 2
+civ_serializable_t civ_nation_manager_serializable(civ_nation_manager_t *mgr);
+
 #ifdef __cplusplus
 }
 #endif
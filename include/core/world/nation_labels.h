@@ -0,0 +1,77 @@
+/**
+ * @file nation_labels.h
+ * @brief Baselines for nation names drawn across their territory
+ *
+ * Every owner with at least CIV_NATION_LABEL_MIN_TILES tiles gets a curved
+ * baseline through the middle of its land, the path an atlas would set its
+ * name along. The owner's tiles give a principal axis (from their second
+ * moments); the axis is cut into CIV_NATION_LABEL_BINS bins, and each bin's
+ * control point sits midway across the territory there, which follows the
+ * medial axis of elongated or bent shapes. The control points are smoothed
+ * and sampled into a polyline of CIV_NATION_LABEL_SAMPLES points, left to
+ * right, in tile coordinates (x unwrapped, so a path may run past the map
+ * edge).
+ *
+ * The map's owner listener marks the owners a change touched; a refresh
+ * recomputes only those, in two passes over the map, and bumps their path
+ * revision so renderers lay their glyphs out again. Between ownership
+ * changes nothing is recomputed.
+ */
+#ifndef CIV_WORLD_NATION_LABELS_H
+#define CIV_WORLD_NATION_LABELS_H
+
+#include "map_generator.h"
+#include "owner_ids.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CIV_NATION_LABEL_MIN_TILES 24
+#define CIV_NATION_LABEL_BINS      6
+#define CIV_NATION_LABEL_SAMPLES   24
+
+typedef struct {
+  float    x[CIV_NATION_LABEL_SAMPLES], y[CIV_NATION_LABEL_SAMPLES];
+  float    length;     /* along the polyline, tiles */
+  float    thickness;  /* typical depth across the path, tiles */
+  uint32_t tiles;
+  uint32_t revision;   /* bumped whenever the path is recomputed */
+  bool     valid;      /* false for owners too small to label */
+} civ_nation_label_path_t;
+
+typedef struct {
+  civ_nation_label_path_t *paths; /* by owner index */
+  uint8_t                 *dirty; /* by owner index */
+  uint32_t                 capacity;
+  bool                     any_dirty;
+  uint32_t                 map_width;
+  uint64_t                 refreshes;
+} civ_nation_labels_t;
+
+civ_nation_labels_t *civ_nation_labels_create(void);
+void civ_nation_labels_destroy(civ_nation_labels_t *labels);
+
+/* Register the owner listener and mark every owner dirty unless already
+   attached to map. False only when out of memory. */
+bool civ_nation_labels_attach(civ_nation_labels_t *labels, civ_map_t *map);
+void civ_nation_labels_detach(civ_nation_labels_t *labels, civ_map_t *map);
+bool civ_nation_labels_attached(const civ_nation_labels_t *labels, const civ_map_t *map);
+
+/**
+ * Recompute the paths of owners whose territory changed
+ * @return Owners recomputed
+ */
+size_t civ_nation_labels_refresh(civ_nation_labels_t *labels, const civ_map_t *map);
+
+/* Owner's path, NULL when it has none */
+const civ_nation_label_path_t *civ_nation_labels_path(const civ_nation_labels_t *labels,
+                                                      civ_owner_index_t owner);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* CIV_WORLD_NATION_LABELS_H */
@@ -0,0 +1,52 @@
+/**
+ * @file nation_lod.h
+ * @brief Simulation level of detail for nations the player cannot see
+ *
+ * Each nation is rated every update by how much it matters to the player:
+ * the player's own nation, nations at war with or allied to it, and
+ * nations whose capital is near its capital tick every update; friendly,
+ * hostile or treaty partners and the middle distance tick every
+ * CIV_NATION_LOD_MID updates; the rest every CIV_NATION_LOD_FAR. What the
+ * UI has open plays no part, so replays and lockstep peers rate alike.
+ * A nation sitting out updates banks their time and spends it on its next
+ * tick, so the modules it drives integrate over the longer dt. A nation
+ * whose rating rises ticks on that same update with what it banked.
+ */
+#ifndef CIV_WORLD_NATION_LOD_H
+#define CIV_WORLD_NATION_LOD_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include "../diplomacy/relations.h"
+#include "nation.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CIV_NATION_LOD_NEAR 1
+#define CIV_NATION_LOD_MID  4
+#define CIV_NATION_LOD_FAR  16
+
+/* Capital distances, in degrees, that count as near and middle, before
+   mgr->lod_distance_scale */
+#define CIV_NATION_LOD_NEAR_DEG 25.0f
+#define CIV_NATION_LOD_MID_DEG  60.0f
+
+/* Rate every nation for update; ds may be NULL (distance only). Without a
+   player nation every nation ticks every update. Sim thread only. */
+void civ_nation_lod_refresh(civ_nation_manager_t *mgr,
+                            const civ_diplomacy_system_t *ds, uint64_t update);
+
+/* Bank dt for a nation; true when it ticks on update, with *tick_dt the
+   time the tick covers. Touches only that nation, so nations may be taken
+   in parallel. */
+bool civ_nation_lod_take(civ_nation_t *nation, uint64_t update, civ_float_t dt,
+                         civ_float_t *tick_dt);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
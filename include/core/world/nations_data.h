@@ -5,6 +5,9 @@
  * Provides lookup of real-world nation metadata (name, ISO codes,
  * continent, population, GDP, capital coords, assigned color).
  * Data is generated by tools/generate_nations.py from Natural Earth.
+ *
+ * Loading builds open-addressing indexes over name, ISO-A3 and ISO-A2, so
+ * the lookups below are hash probes rather than scans.
  */
 #ifndef CIV_NATIONS_DATA_H
 #define CIV_NATIONS_DATA_H
@@ -43,6 +46,12 @@ typedef struct {
     civ_nation_data_t  *nations;
     uint32_t            count;
     uint32_t            capacity;
+
+    /* Hash -> index + 1 (0 = empty); one table per key, slot_mask + 1 each */
+    uint32_t           *name_slots;
+    uint32_t           *iso_a3_slots;
+    uint32_t           *iso_a2_slots;
+    uint32_t            slot_mask;
 } civ_nations_data_t;
 
 /* ── Lifecycle ────────────────────────────────────────────────── */
@@ -53,11 +62,17 @@ void                civ_nations_data_destroy(civ_nations_data_t *nd);
 civ_result_t        civ_nations_data_load(civ_nations_data_t *nd,
                                           const char *filepath);
 
+/* Parse the same format from memory (e.g. a world pack section) */
+civ_result_t        civ_nations_data_load_view(civ_nations_data_t *nd,
+                                               const uint8_t *data, size_t size);
+
 /* ── Lookup ───────────────────────────────────────────────────── */
 const civ_nation_data_t *civ_nations_data_get_by_id(
     const civ_nations_data_t *nd, uint32_t id);
 const civ_nation_data_t *civ_nations_data_get_by_iso(
     const civ_nations_data_t *nd, const char *iso_a3);
+const civ_nation_data_t *civ_nations_data_get_by_iso_a2(
+    const civ_nations_data_t *nd, const char *iso_a2);
 const civ_nation_data_t *civ_nations_data_get_by_name(
     const civ_nations_data_t *nd, const char *name);
 
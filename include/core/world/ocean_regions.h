@@ -0,0 +1,101 @@
+/**
+ * @file ocean_regions.h
+ * @brief Sea regions, portals between them and the graph naval routes use
+ *
+ * Built once when a map is loaded. The water is cut into CIV_OCEAN_CELL
+ * squares and each square's water into its 4-connected pieces; every piece
+ * is a region: open sea when it touches no land, a coastal band when it
+ * does, a strait when it is a small coastal piece that joins others. Where
+ * two regions meet across a square border, each run of crossings gets a
+ * portal every CIV_OCEAN_PORTAL_SPAN tiles, at the run's middle. A portal
+ * has an endpoint on either side, and each region keeps the sailing cost
+ * between every pair of its endpoints.
+ *
+ * A query seeds the endpoints of the start's regions with a search bounded
+ * to those regions, runs A* over the endpoints (crossing a portal costs one
+ * straight step) and closes with the goal's regions the same way, so a route
+ * across an ocean touches a few thousand nodes, not millions of tiles. Land
+ * tiles next to water (ports) start or end in every region beside them.
+ * Costs are in pathfinder units, CIV_PATH_COST_STRAIGHT per orthogonal
+ * step; moves are 8-way without corner cutting and x wraps east-west.
+ */
+#ifndef CIV_WORLD_OCEAN_REGIONS_H
+#define CIV_WORLD_OCEAN_REGIONS_H
+
+#include "map_generator.h"
+#include "pathfinding.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct civ_worker_pool;
+
+#define CIV_OCEAN_CELL        64
+#define CIV_OCEAN_PORTAL_SPAN 32
+#define CIV_OCEAN_NO_REGION   UINT32_MAX
+
+typedef enum {
+  CIV_OCEAN_OPEN = 0,
+  CIV_OCEAN_COASTAL,
+  CIV_OCEAN_STRAIT
+} civ_ocean_region_kind_t;
+
+typedef struct {
+  uint32_t cell;
+  uint32_t tiles;
+  uint32_t coast_tiles;     /* next to land */
+  civ_ocean_region_kind_t kind;
+  uint32_t first_endpoint;  /* slice of region_endpoints */
+  uint32_t endpoint_count;
+  size_t   first_cost;      /* endpoint_count squared, row = from */
+} civ_ocean_region_t;
+
+/* Endpoint 2p is tile_a, in region_a; 2p + 1 is tile_b across the border */
+typedef struct {
+  uint32_t tile_a, tile_b;
+  uint32_t region_a, region_b;
+} civ_ocean_portal_t;
+
+typedef struct {
+  const civ_map_t    *map;
+  int32_t             cols, rows;       /* squares */
+  uint16_t           *local;            /* per tile, region within its square */
+  uint32_t           *cell_base;        /* first region of each square */
+  civ_ocean_region_t *regions;
+  uint32_t            region_count;
+  civ_ocean_portal_t *portals;
+  uint32_t            portal_count;
+  uint32_t           *region_endpoints; /* endpoint indices, by region */
+  uint32_t           *costs;            /* per region endpoint matrices */
+  size_t              cost_count;
+} civ_ocean_regions_t;
+
+typedef struct {
+  uint32_t  start, goal;         /* tiles: water, or land beside it */
+  uint32_t *waypoints;           /* caller buffer: portal tiles in order */
+  uint32_t  waypoint_capacity;   /* 0 = cost only */
+  uint32_t  waypoint_count;      /* out */
+  uint32_t  cost;                /* out, CIV_PATH_NO_PATH if none */
+} civ_ocean_request_t;
+
+/* Segment map's water; pool may be NULL. The regions keep map and must be
+   destroyed before it. */
+civ_ocean_regions_t *civ_ocean_regions_create(const civ_map_t *map,
+                                              struct civ_worker_pool *pool);
+void civ_ocean_regions_destroy(civ_ocean_regions_t *ocean);
+
+/* Region of a water tile, CIV_OCEAN_NO_REGION on land */
+uint32_t civ_ocean_region_at(const civ_ocean_regions_t *ocean, uint32_t tile);
+
+/* Fill one request; false if the goal cannot be reached by sea. Safe to
+   call from several threads at once. */
+bool civ_ocean_find(const civ_ocean_regions_t *ocean, civ_ocean_request_t *req);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* CIV_WORLD_OCEAN_REGIONS_H */
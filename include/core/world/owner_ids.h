@@ -0,0 +1,42 @@
+/**
+ * @file owner_ids.h
+ * @brief Global intern table for territory owner ids
+ *
+ * Tiles store a 16-bit owner index instead of the owner's id string.
+ * Any owner id (nation, settlement, border country name) is interned once
+ * and compared as an integer afterwards. Index 0 means unclaimed.
+ */
+#ifndef CIV_WORLD_OWNER_IDS_H
+#define CIV_WORLD_OWNER_IDS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint16_t civ_owner_index_t;
+
+#define CIV_OWNER_NONE ((civ_owner_index_t)0)
+#define CIV_OWNER_MAX  65535
+
+/* Index for id, adding it if new; CIV_OWNER_NONE for NULL/""/table full */
+civ_owner_index_t civ_owner_intern(const char *id);
+
+/* Index for id without adding it; CIV_OWNER_NONE if unknown */
+civ_owner_index_t civ_owner_find(const char *id);
+
+/* Id string for an index; "" for CIV_OWNER_NONE or unknown */
+const char *civ_owner_name(civ_owner_index_t index);
+
+/* Number of slots in use, including the reserved CIV_OWNER_NONE */
+uint32_t civ_owner_count(void);
+
+/* Drop every interned id (indices held by tiles become invalid) */
+void civ_owner_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,116 @@
+/**
+ * @file path_service.h
+ * @brief Ticketed path queries solved off the phase that asks for them
+ *
+ * Callers submit a query (start, goal, layer, how many steps they need) and
+ * get a ticket. A layer is one pathfinder, so one movement class or cost
+ * layer: land units, ships and trade each register the pathfinder built
+ * with their cost function. civ_path_service_kick, at the end of a phase,
+ * hands everything submitted to one pool job that solves each layer's
+ * queries as one civ_pathfinder_find_batch (shared rebuild, shared goal
+ * setup, spread over the pool). civ_path_service_apply, at the start of
+ * the next phase, waits for that job, runs the completion callbacks on the
+ * calling thread and makes the results readable until the apply after.
+ *
+ * Queries with the same layer, start and goal collapse into one search
+ * refined to the longest step count any of them asked for; the shorter
+ * ones read a prefix. A query with no such search rides one for its goal
+ * whose start is a neighbouring tile no farther from the goal, as units
+ * of a stack heading for one target do: its route is the step onto that
+ * start followed by the search's path. When the layer cannot take that
+ * step the query is searched on its own. A query answered by the previous apply, on a layer
+ * whose pathfinder has not been invalidated since, is answered from it
+ * without a search.
+ *
+ * Submitting is safe from any thread. Kick, apply, results and destroy are
+ * for the thread that drives the phases. Between kick and apply the
+ * layers' pathfinders, and the maps under them, belong to the service:
+ * nothing may query or invalidate them.
+ */
+#ifndef CIV_WORLD_PATH_SERVICE_H
+#define CIV_WORLD_PATH_SERVICE_H
+
+#include "pathfinding.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct civ_worker_pool;
+
+#define CIV_PATH_SERVICE_LAYERS 8
+#define CIV_PATH_TICKET_NONE    0u
+
+typedef uint32_t civ_path_ticket_t;
+
+typedef enum {
+  CIV_PATH_TICKET_UNKNOWN, /* never issued, or its results were replaced */
+  CIV_PATH_TICKET_PENDING,
+  CIV_PATH_TICKET_READY
+} civ_path_ticket_state_t;
+
+typedef struct {
+  uint32_t start, goal; /* tile indices */
+  uint8_t  layer;
+  uint32_t max_steps;   /* steps to refine; 0 = cost only */
+} civ_path_query_t;
+
+typedef struct {
+  uint32_t        cost;        /* whole route, CIV_PATH_NO_PATH if none */
+  uint32_t        path_length; /* < max_steps means the path reaches goal */
+  const uint32_t *path;        /* steps after start; valid until next apply */
+} civ_path_result_t;
+
+typedef struct {
+  uint64_t submitted;
+  uint64_t searches;   /* searches run */
+  uint64_t collapsed;  /* queries answered by another query's search */
+  uint64_t nearby;     /* of those, riding a neighbouring start's search */
+  uint64_t cached;     /* queries answered by the previous apply */
+  uint32_t last_batch; /* queries in the batch the last apply published */
+} civ_path_service_stats_t;
+
+/* Runs in civ_path_service_apply */
+typedef void (*civ_path_done_fn_t)(civ_path_ticket_t ticket,
+                                   const civ_path_result_t *result,
+                                   void *user_data);
+
+typedef struct civ_path_service civ_path_service_t;
+
+civ_path_service_t *civ_path_service_create(void);
+/* Waits for a kicked batch; its callbacks do not run */
+void civ_path_service_destroy(civ_path_service_t *svc);
+
+/* Register pathfinder as a layer; returns its id, or -1 when all are used */
+int civ_path_service_add_layer(civ_path_service_t *svc, civ_pathfinder_t *pf);
+
+/* Queue a query; done may be NULL. Returns CIV_PATH_TICKET_NONE for a bad
+   layer or endpoint, or when out of memory. */
+civ_path_ticket_t civ_path_service_submit(civ_path_service_t *svc,
+                                          const civ_path_query_t *query,
+                                          civ_path_done_fn_t done,
+                                          void *user_data);
+
+/* Start solving what was submitted on pool (inline when NULL); does
+   nothing while a kicked batch has not been applied */
+void civ_path_service_kick(civ_path_service_t *svc,
+                           struct civ_worker_pool *pool);
+
+/* Finish the kicked batch, call back and publish; returns its query count */
+size_t civ_path_service_apply(civ_path_service_t *svc);
+
+/* Published result of ticket; out is filled only when READY */
+civ_path_ticket_state_t civ_path_service_result(civ_path_service_t *svc,
+                                               civ_path_ticket_t ticket,
+                                               civ_path_result_t *out);
+
+void civ_path_service_stats(civ_path_service_t *svc,
+                           civ_path_service_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
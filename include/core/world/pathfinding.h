@@ -0,0 +1,139 @@
+/**
+ * @file pathfinding.h
+ * @brief Hierarchical (HPA*) pathfinding over map terrain
+ *
+ * The map is cut into CIV_PATH_CLUSTER-square clusters. Wherever the tiles
+ * on both sides of a cluster border are passable, the border gets one or
+ * two entrances; their tiles are the nodes of a small abstract graph, and
+ * each cluster caches the cost between every pair of its nodes. A query
+ * links start and goal to the nodes of their own clusters, searches the
+ * abstract graph, then refines each abstract edge with a search bounded to
+ * one cluster. Paths are near-optimal rather than optimal.
+ *
+ * Tile costs come from a cost function (terrain by default) and are cached.
+ * civ_pathfinder_invalidate_tile marks a tile's cluster and borders for
+ * rebuild; with cost_reads_owner set, ownership changes do so through a map
+ * owner listener. Rebuilds happen at the next query, so a conquest touching
+ * many tiles pays once. Movement is 8-way without corner cutting and x
+ * wraps east-west.
+ */
+#ifndef CIV_WORLD_PATHFINDING_H
+#define CIV_WORLD_PATHFINDING_H
+
+#include "map_generator.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct civ_worker_pool;
+
+#define CIV_PATH_CLUSTER            16
+#define CIV_PATH_MAX_BORDER_NODES   (CIV_PATH_CLUSTER / 2)
+#define CIV_PATH_MAX_CLUSTER_NODES  (4 * CIV_PATH_MAX_BORDER_NODES)
+#define CIV_PATH_COST_STRAIGHT      10u   /* per unit of tile cost */
+#define CIV_PATH_COST_DIAGONAL      14u
+#define CIV_PATH_NO_PATH            UINT32_MAX
+
+/* Cost multiplier for entering tile index: 0 = impassable, else 1..255 */
+typedef uint8_t (*civ_path_cost_fn_t)(void *user_data, const civ_map_t *map,
+                                      size_t index);
+
+/* Default land cost: water impassable, mountains 4, hills and forest or
+   wetland 2, everything else 1 */
+uint8_t civ_path_terrain_cost(void *user_data, const civ_map_t *map,
+                              size_t index);
+
+typedef struct {
+  civ_path_cost_fn_t cost_fn;        /* NULL = civ_path_terrain_cost */
+  void              *cost_user_data;
+  bool               cost_reads_owner; /* rebuild on tile owner changes */
+} civ_path_config_t;
+
+/* One crossing of a cluster border; a = west/north side, b = east/south */
+typedef struct {
+  uint32_t tile_a, tile_b;
+  uint8_t  node_a, node_b;    /* node index within each side's cluster */
+} civ_path_transition_t;
+
+typedef struct {
+  civ_path_transition_t t[CIV_PATH_MAX_BORDER_NODES];
+  uint8_t               count;
+  bool                  dirty;
+} civ_path_border_t;
+
+typedef struct {
+  uint32_t  node_tile[CIV_PATH_MAX_CLUSTER_NODES];
+  uint32_t  node_ref[CIV_PATH_MAX_CLUSTER_NODES]; /* border transition */
+  uint32_t *cost;             /* count x count, row = from */
+  uint32_t  cost_capacity;
+  uint8_t   count;
+  bool      dirty;
+} civ_path_cluster_t;
+
+typedef struct civ_path_lane civ_path_lane_t;
+
+typedef struct {
+  civ_map_t          *map;
+  civ_path_config_t   config;
+  uint8_t            *tile_cost;     /* cached cost_fn, one per tile */
+  civ_path_cluster_t *clusters;      /* row-major, cols x rows */
+  civ_path_border_t  *borders;       /* east borders, then south borders */
+  int32_t             cols, rows;
+  uint32_t           *node_base;     /* first global node of each cluster */
+  uint32_t           *node_cluster;  /* cluster of each global node */
+  uint32_t           *node_component; /* connected component of each node */
+  uint32_t            node_count;
+  bool                costs_dirty;   /* whole tile_cost cache stale */
+  bool                graph_dirty;   /* some border or cluster stale */
+  uint32_t            revision;      /* bumped by every cost change */
+  civ_path_lane_t    *lanes;         /* per-thread query scratch */
+  int                 lane_count;
+} civ_pathfinder_t;
+
+typedef struct {
+  uint32_t  start, goal;      /* tile indices */
+  uint32_t *path;             /* caller buffer of tile indices */
+  uint32_t  path_capacity;    /* 0 = cost only */
+  uint32_t  path_length;      /* out: steps written after start */
+  uint32_t  cost;             /* out: whole route, CIV_PATH_NO_PATH if none */
+} civ_path_request_t;
+
+/* NULL config = terrain cost, no owner listener. The pathfinder keeps map
+   and must be destroyed before it. Building is deferred to the first query. */
+civ_pathfinder_t *civ_pathfinder_create(civ_map_t *map,
+                                        const civ_path_config_t *config);
+void civ_pathfinder_destroy(civ_pathfinder_t *pf);
+
+/* Re-read a tile's cost after a terrain (or cost input) change */
+void civ_pathfinder_invalidate_tile(civ_pathfinder_t *pf, size_t index);
+void civ_pathfinder_invalidate_all(civ_pathfinder_t *pf);
+
+/* Rebuild whatever is stale; queries call this themselves */
+void civ_pathfinder_prepare(civ_pathfinder_t *pf, struct civ_worker_pool *pool);
+
+/* Cost of one 8-way step between neighbouring tiles, read from the cost
+   cache as of the last prepare; CIV_PATH_NO_PATH when the tiles are not
+   neighbours, to is impassable, the step cuts a corner or the cache has
+   not been filled */
+uint32_t civ_pathfinder_step_cost(const civ_pathfinder_t *pf, uint32_t from,
+                                  uint32_t to);
+
+/* Fill one request. Only the first path_capacity steps are refined, so a
+   unit moving a few tiles a turn pays for those tiles, not the whole route;
+   path_length < path_capacity means the path ends at the goal. cost always
+   covers the whole route. Returns false if the goal is unreachable. */
+bool civ_pathfinder_find(civ_pathfinder_t *pf, civ_path_request_t *req);
+
+/* Fill many requests, sharing one rebuild and the goal-side setup between
+   requests with the same goal; spread over pool when given */
+void civ_pathfinder_find_batch(civ_pathfinder_t *pf, civ_path_request_t *reqs,
+                               size_t count, struct civ_worker_pool *pool);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -3,9 +3,14 @@
 
 #include "map_generator.h"
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 bool civ_political_borders_load(const char *filepath, int32_t map_w, int32_t map_h);
+/* Load from memory without copying the tile array: data must stay valid
+   until civ_political_borders_free or the next load */
+bool civ_political_borders_load_view(const uint8_t *data, size_t size,
+                                     int32_t map_w, int32_t map_h);
 void civ_political_borders_apply(civ_map_t *map);
 void civ_political_borders_free(void);
 int         civ_political_borders_country_count(void);
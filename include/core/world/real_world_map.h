@@ -45,6 +45,14 @@ typedef struct {
  */
 civ_result_t civ_earth_map_load(const char *filepath, civ_map_t *map);
 
+/**
+ * @brief Populate a civ_map_t from an in-memory .earth image
+ *
+ * Same format as civ_earth_map_load; the landmask is read in place.
+ */
+civ_result_t civ_earth_map_load_view(const uint8_t *data, size_t size,
+                                     civ_map_t *map);
+
 /**
  * @brief Check if an Earth map data file exists and is valid
  * @param filepath Path to check
@@ -49,6 +49,26 @@ typedef struct {
     uint8_t  quality;      /* 0-100 */
 } civ_resource_deposit_t;
 
+/* A deposit as it was when civ_resource_map_deplete worked it out */
+typedef struct {
+    civ_resource_type_t    type;
+    civ_resource_deposit_t deposit;
+} civ_resource_depletion_t;
+
+/* ── Per-tile index ───────────────────────────────────────────── */
+/* One deposit on an indexed tile */
+typedef struct {
+    uint8_t  type;         /* civ_resource_type_t */
+    uint16_t deposit;      /* index into deposits[type] */
+} civ_resource_tile_entry_t;
+
+/* Hash slot: a tile's run of entries in tile_entries */
+typedef struct {
+    uint32_t tile_plus1;   /* y * width + x + 1, 0 = empty */
+    uint32_t first;
+    uint8_t  count;
+} civ_resource_tile_slot_t;
+
 /* ── Resource map ─────────────────────────────────────────────── */
 typedef struct {
     /* Sparse arrays: deposits_by_type[resource_type] is a flat
@@ -56,8 +76,28 @@ typedef struct {
     civ_resource_deposit_t *deposits[CIV_RESOURCE_COUNT];
     uint16_t                deposit_count[CIV_RESOURCE_COUNT];
     uint32_t                width, height;
+
+    /* Open-addressing tile -> entries index, built by
+       civ_resource_map_build_index (NULL = linear scans) */
+    civ_resource_tile_slot_t  *tile_slots;
+    uint32_t                   tile_slot_mask;
+    civ_resource_tile_entry_t *tile_entries;
+    uint32_t                   tile_entry_count;
+
+    /* Every depletion so far, oldest first, for holders of running sums
+       over deposits; each deposit appears once at most. Readers keep their
+       own cursor and start over when depletion_resets moves (a reload, or
+       a depletion the log had no room for). */
+    civ_resource_depletion_t *depletions;
+    uint32_t                  depletion_count;
+    uint32_t                  depletion_capacity;
+    uint32_t                  depletion_resets;
 } civ_resource_map_t;
 
+/* Callback for deposit iteration */
+typedef void (*civ_resource_deposit_fn)(void *ctx, civ_resource_type_t type,
+                                        const civ_resource_deposit_t *deposit);
+
 /* ── Lifecycle ────────────────────────────────────────────────── */
 civ_resource_map_t *civ_resource_map_create(uint32_t width, uint32_t height);
 void                civ_resource_map_destroy(civ_resource_map_t *rm);
@@ -66,7 +106,28 @@ void                civ_resource_map_destroy(civ_resource_map_t *rm);
 civ_result_t        civ_resource_map_load(civ_resource_map_t *rm,
                                           const char *filepath);
 
+/* Parse the same format from memory (e.g. a world pack section) */
+civ_result_t        civ_resource_map_load_view(civ_resource_map_t *rm,
+                                               const uint8_t *data,
+                                               size_t size);
+
+/* (Re)build the per-tile index; load does this. Call it after filling
+   deposits by hand. Queries fall back to linear scans without it. */
+civ_result_t        civ_resource_map_build_index(civ_resource_map_t *rm);
+
+/* Mark deposits[type][deposit] worked out: quantity and quality drop to 0,
+   it stays indexed so deposit indices held elsewhere remain valid. The
+   deposit as it was goes on the depletion log. */
+void                civ_resource_map_deplete(civ_resource_map_t *rm,
+                                             civ_resource_type_t type,
+                                             uint16_t deposit);
+
 /* ── Queries ──────────────────────────────────────────────────── */
+/* Deposit of a type at a tile, NULL if none */
+const civ_resource_deposit_t *civ_resource_map_find(const civ_resource_map_t *rm,
+                                                    int32_t x, int32_t y,
+                                                    civ_resource_type_t type);
+
 /* Check if a resource type is present at a tile */
 bool     civ_resource_map_has_type(const civ_resource_map_t *rm,
                                    int32_t x, int32_t y,
@@ -90,6 +151,14 @@ uint16_t civ_resource_map_total_at_tile(const civ_resource_map_t *rm,
 int      civ_resource_map_type_count_at_tile(const civ_resource_map_t *rm,
                                              int32_t x, int32_t y);
 
+/* Visit every deposit inside the inclusive tile rect [x0,x1] x [y0,y1]
+   (clamped to the map). Returns the number of deposits visited. */
+size_t   civ_resource_map_for_each_in_rect(const civ_resource_map_t *rm,
+                                           int32_t x0, int32_t y0,
+                                           int32_t x1, int32_t y1,
+                                           civ_resource_deposit_fn fn,
+                                           void *ctx);
+
 /* Friendly names for resource types */
 const char *civ_resource_type_name(civ_resource_type_t type);
 
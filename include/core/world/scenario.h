@@ -0,0 +1,75 @@
+/**
+ * @file scenario.h
+ * @brief Synthetic worlds past the bundled real-world data
+ *
+ * A scenario replaces the Earth landmask, the borders file and the
+ * Natural Earth nation list with a procedural world of any size: the map
+ * comes from civ_map_generate, nations from a jittered lattice of
+ * capitals each claiming the land nearest it, settlements and units from
+ * seeded draws over owned land. Everything follows from the map seed, so
+ * the same spec builds the same world, and runs at growing scales give a
+ * scaling curve per system.
+ *
+ * Spec strings, as given to --scenario:
+ *
+ *   nations=2000,settlements=20000,units=50000,map=8192x4096
+ *
+ * Any key may be left out; a scenario without nations keeps the bundled
+ * nations and only adds settlements and units to them.
+ */
+#ifndef CIV_WORLD_SCENARIO_H
+#define CIV_WORLD_SCENARIO_H
+
+#include "../../common.h"
+#include "../military/units.h"
+#include "map_generator.h"
+#include "nation.h"
+#include "settlement_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CIV_SCENARIO_NATIONS_MAX     8192
+#define CIV_SCENARIO_SETTLEMENTS_MAX 1000000
+#define CIV_SCENARIO_UNITS_MAX       ((int)CIV_UNIT_MAX)
+
+typedef struct {
+  int32_t map_width;    /* 0 = CIV_DEFAULT_MAP_WIDTH */
+  int32_t map_height;   /* 0 = CIV_DEFAULT_MAP_HEIGHT */
+  int     nations;      /* 0 = the bundled nations */
+  int     settlements;
+  int     units;
+} civ_scenario_params_t;
+
+/* Fill out from a spec string; false (out untouched) on a bad key or value */
+bool civ_scenario_parse(const char *spec, civ_scenario_params_t *out);
+
+/* True when the world is procedural rather than the bundled Earth */
+bool civ_scenario_replaces_world(const civ_scenario_params_t *params);
+
+/**
+ * Add params->nations nations to an empty manager created with room for
+ * them, and give each the land nearest its capital
+ */
+civ_result_t civ_scenario_claim_nations(civ_nation_manager_t *mgr,
+                                        civ_map_t *map,
+                                        const civ_scenario_params_t *params,
+                                        uint32_t seed);
+
+/* Settlements on owned land, each under the nation owning its tile */
+civ_result_t civ_scenario_place_settlements(
+    civ_settlement_manager_t *sm, const civ_nation_manager_t *mgr,
+    const civ_map_t *map, const civ_scenario_params_t *params, uint32_t seed);
+
+/* Units on owned land, owned by the nation owning their tile */
+civ_result_t civ_scenario_place_units(civ_unit_manager_t *um,
+                                      const civ_nation_manager_t *mgr,
+                                      const civ_map_t *map,
+                                      const civ_scenario_params_t *params,
+                                      uint32_t seed);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
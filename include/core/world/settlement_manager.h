@@ -11,6 +11,8 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include "../../utils/symbol.h"
+#include "../culture/naming.h"
 #include "../military/units.h"
 #include "map_generator.h"
 #include "territory.h"
@@ -61,7 +63,8 @@ typedef struct {
 
   char region_id[STRING_SHORT_LEN]; /* Subunit it belongs to */
 
-  time_t founded_date;
+  int32_t founded_year; /* game calendar (time_engine.h global time) */
+  int32_t founded_day;
 
   /* Production System */
   civ_unit_type_t production_type;
@@ -82,8 +85,25 @@ typedef struct {
   int32_t primary_ethnicity;
   int32_t primary_language;
   int32_t primary_faith;
+
+  /* Interned ids, maintained by the manager */
+  civ_symbol_t id_sym;     /* flagged CIV_SYMBOL_FLAG_RIVAL for AI cities */
+  civ_symbol_t region_sym;
+
+  /* Spatial index links, maintained by the manager */
+  int32_t owner_index; /* region_sym's slot in the manager's owner table */
+  int32_t index_bucket;
+  int32_t index_next;
 } civ_settlement_t;
 
+/* Spatial index: settlements are chained by array index into buckets keyed
+   by (owner, CIV_SETTLEMENT_CELL_SIZE cell). Settlements never move, so the
+   only updates are civ_settlement_manager_add and set_owner; region_id must
+   not be written directly once a settlement is added. */
+#define CIV_SETTLEMENT_CELL_SIZE 16.0f
+#define CIV_SETTLEMENT_HASH_BUCKETS 1024 /* power of two */
+#define CIV_SETTLEMENT_ANY_OWNER (-2) /* -1 is an unknown owner */
+
 /* Manager */
 typedef struct {
   civ_settlement_t *settlements;
@@ -91,18 +111,32 @@ typedef struct {
   size_t settlement_capacity;
 
   civ_float_t min_distance; /* Min distance between settlements */
+
+  int32_t bucket_heads[CIV_SETTLEMENT_HASH_BUCKETS];
+  civ_symbol_t *owner_syms;
+  civ_owner_index_t *owner_ids; /* owner_syms interned as tile owners */
+  size_t owner_count;
+  size_t owner_capacity;
+  int32_t cell_min_x, cell_min_y, cell_max_x, cell_max_y; /* occupied extent */
+  civ_naming_service_t *naming; /* not owned; NULL = numbered names */
+  uint32_t next_serial; /* of the next founded settle_<n> id */
+  int32_t year, day;    /* game date new settlements are founded on */
 } civ_settlement_manager_t;
 
 /* Functions */
 civ_settlement_manager_t *civ_settlement_manager_create(void);
 void civ_settlement_manager_destroy(civ_settlement_manager_t *manager);
 
-/* Forward declaration */
+/* Forward declarations */
 struct civ_government;
+struct civ_modifier_table;
 
+/* Production and culture are scaled by each owner's modifier stack;
+   modifiers may be NULL */
 civ_result_t civ_settlement_manager_update(civ_settlement_manager_t *manager,
                                            civ_map_t *map,
                                            struct civ_government *gov,
+                                           const struct civ_modifier_table *modifiers,
                                            civ_float_t time_delta);
 
 /* Formation Logic */
@@ -110,8 +144,56 @@ civ_float_t civ_calculate_site_suitability(
     civ_float_t x, civ_float_t y); /* Placeholder for complex logic */
 civ_result_t civ_attempt_settlement_spawn(civ_settlement_manager_t *manager,
                                           civ_float_t x, civ_float_t y);
+/* Found a hamlet owned by owner_id at a site already judged suitable;
+   fails only when it is too close to another settlement */
+civ_result_t civ_settlement_manager_found(civ_settlement_manager_t *manager,
+                                          civ_float_t x, civ_float_t y,
+                                          civ_float_t suitability,
+                                          const char *owner_id);
 
 civ_result_t civ_settlement_manager_add(civ_settlement_manager_t *manager,
                                         civ_settlement_t *settlement);
 
+/* A new city name from culture's stream (the owner id) into out; false,
+   out untouched, without a naming service or when none could be drawn */
+bool civ_settlement_manager_generate_name(civ_settlement_manager_t *manager,
+                                          const char *culture, char *out,
+                                          size_t size);
+
+/* Spatial queries */
+/* Index of region_id in the owner table, -1 if no settlement has had it */
+int32_t civ_settlement_manager_owner_index(
+    const civ_settlement_manager_t *manager, const char *region_id);
+civ_result_t civ_settlement_manager_set_owner(civ_settlement_manager_t *manager,
+                                              civ_settlement_t *settlement,
+                                              const char *region_id);
+/* Nearest settlement of owner (an owner index or CIV_SETTLEMENT_ANY_OWNER)
+   to (x, y), or NULL if it has none. *out_dist receives the distance. */
+civ_settlement_t *civ_settlement_manager_nearest(
+    const civ_settlement_manager_t *manager, int32_t owner, civ_float_t x,
+    civ_float_t y, civ_float_t *out_dist);
+/* Indices of owner's settlements closer than radius to (x, y). Writes at
+   most max indices; returns the total number found. */
+size_t civ_settlement_manager_query_radius(
+    const civ_settlement_manager_t *manager, int32_t owner, civ_float_t x,
+    civ_float_t y, civ_float_t radius, size_t *out, size_t max);
+/* Indices of settlements of any owner with x in [x0, x1) and y in
+   [y0, y1), ascending. Writes at most max; returns the total found. */
+size_t civ_settlement_manager_query_rect(
+    const civ_settlement_manager_t *manager, civ_float_t x0, civ_float_t y0,
+    civ_float_t x1, civ_float_t y1, size_t *out, size_t max);
+/* Settlement whose position truncates to tile (tx, ty) */
+civ_settlement_t *civ_settlement_manager_at(
+    const civ_settlement_manager_t *manager, int32_t tx, int32_t ty);
+
+/* Game date foundings are stamped with; the game sets it each turn */
+void civ_settlement_manager_set_date(civ_settlement_manager_t *manager,
+                                     int32_t year, int32_t day);
+
+/* Save section: every settlement; loading replaces them through
+   civ_settlement_manager_add, so owners and the index are rebuilt */
+#define CIV_SETTLEMENT_SAVE_VERSION 1
+civ_serializable_t
+civ_settlement_manager_serializable(civ_settlement_manager_t *manager);
+
 #endif /* CIVILIZATION_SETTLEMENT_MANAGER_H */
@@ -0,0 +1,102 @@
+/**
+ * @file site_field.h
+ * @brief Settlement suitability raster and ranked candidate sites
+ *
+ * The map is split into CIV_SITE_CELL_SIZE-tile cells. A cell's terrain
+ * score is its best land tile's — fertility, river, resources, not too
+ * high — and its score is that times a spacing factor: 0 within the
+ * settlement manager's minimum distance of any settlement, rising to 1 at
+ * twice that. Terrain is rescored one changed map region per refresh,
+ * spacing only around settlements that appeared since the last one.
+ *
+ * Candidates come from max-heaps: one open heap over every cell, and one
+ * per settlement owner over the cells within CIV_SITE_REACH of its
+ * settlements, ranked closer-first. Heap entries are never updated in
+ * place: a rescored cell bumps its stamp and is pushed again, and a pop
+ * discards entries whose stamp no longer matches, so a pop is O(log n)
+ * amortized and never returns a site that has been taken.
+ */
+#ifndef CIV_WORLD_SITE_FIELD_H
+#define CIV_WORLD_SITE_FIELD_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include "map_generator.h"
+#include "settlement_manager.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CIV_SITE_CELL_SHIFT 2 /* 4x4-tile cells */
+#define CIV_SITE_CELL_SIZE  (1 << CIV_SITE_CELL_SHIFT)
+#define CIV_SITE_REACH      24.0f /* tiles from an owner's settlement */
+#define CIV_SITE_OPEN       (-1)  /* owner for the open heap */
+
+typedef struct {
+  float    priority;
+  uint32_t cell;
+  uint32_t stamp;
+} civ_site_entry_t;
+
+typedef struct {
+  civ_site_entry_t *items;
+  uint32_t          count;
+  uint32_t          capacity;
+} civ_site_queue_t;
+
+/* A popped candidate */
+typedef struct {
+  float    x, y;   /* tile position */
+  float    score;  /* 0 to 1 */
+  civ_site_entry_t entry;
+} civ_site_t;
+
+typedef struct {
+  int32_t   cols, rows;
+  int32_t   map_width;
+  float     sea_level;
+  float    *terrain;    /* by cell; its best tile's score */
+  uint32_t *best_tile;
+  float    *score;      /* terrain x spacing; 0 = cannot settle */
+  uint32_t *stamp;
+
+  uint32_t *region_seen; /* map region revisions last scored */
+  size_t    region_count;
+  size_t    region_cursor;
+
+  civ_site_queue_t  open;
+  civ_site_queue_t *owners;      /* by settlement manager owner index */
+  size_t            owner_count;
+
+  int32_t *settlement_owner;     /* owner index each settlement was seen with */
+  size_t   settlement_seen;
+  size_t   settlement_capacity;
+  bool     built;
+} civ_site_field_t;
+
+civ_site_field_t *civ_site_field_create(const civ_map_t *map);
+void civ_site_field_destroy(civ_site_field_t *f);
+
+/* Catch up with map and settlement changes; the first call scores
+   everything. sm may be NULL (no spacing, no owner heaps). */
+void civ_site_field_refresh(civ_site_field_t *f, const civ_map_t *map,
+                            const civ_settlement_manager_t *sm);
+
+/* Best current site for owner (a settlement owner index or CIV_SITE_OPEN);
+   false once its heap is empty */
+bool civ_site_field_pop(civ_site_field_t *f, int32_t owner, civ_site_t *out);
+
+/* Return a popped site that was not used */
+void civ_site_field_push_back(civ_site_field_t *f, int32_t owner,
+                              const civ_site_t *site);
+
+/* Score of the cell holding tile (x, y) */
+float civ_site_field_score_at(const civ_site_field_t *f, float x, float y);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
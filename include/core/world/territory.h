@@ -1,6 +1,15 @@
 /**
  * @file territory.h
  * @brief Dynamic territory system (not tile-based)
+ *
+ * Point lookups go through a spatial index kept beside the regions: each
+ * region's bounding box sits in a uniform grid over all of them, and its
+ * edges are bucketed into horizontal bands of its box, so a query tests
+ * the few regions whose box covers the point's cell and, for each, only
+ * the edges in the point's band. A region is re-indexed on its own when
+ * its revision moves (civ_territory_region_add_point bumps it; code that
+ * edits boundary_points directly must too); the grid is only rebuilt when
+ * a box grows past its bounds.
  */
 
 #ifndef CIVILIZATION_TERRITORY_H
@@ -28,13 +37,17 @@ typedef struct {
     civ_float_t control_strength;  /* 0.0 to 1.0 - how well controlled */
     
     time_t acquisition_time;
+    uint32_t revision;             /* bumped on every boundary change */
 } civ_territory_region_t;
 
+typedef struct civ_territory_index civ_territory_index_t;
+
 /* Territory manager */
 typedef struct {
     civ_territory_region_t* regions;
     size_t region_count;
     size_t region_capacity;
+    civ_territory_index_t* index;  /* lookup grid, built on first query */
 } civ_territory_manager_t;
 
 /* Function declarations */
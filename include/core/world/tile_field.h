@@ -0,0 +1,96 @@
+/**
+ * @file tile_field.h
+ * @brief Tile-resolution influence fields spread over the map
+ *
+ * Each channel follows one tile overlay — cultural and political influence,
+ * population density — and spreads it over the land: every step moves a
+ * tile towards the mean of its four neighbours (diffusion) and towards the
+ * tile's own overlay value (relaxation, which also decays what spread away
+ * from its source). Water holds nothing, so influence does not cross the
+ * sea. x wraps like the map; the poles reflect.
+ *
+ * Steps run over bands of rows on the worker pool, every channel of a row
+ * together, reading the front buffer and writing the back one; the buffers
+ * swap when the step is done, so readers always see a whole step. Sources
+ * are re-read only for map regions whose revision moved, a few per step.
+ *
+ * A field attached to the GPU (tile_field_gpu.h) keeps every channel
+ * resident there and steps it with a compute shader instead; the changed
+ * regions are uploaded and the values come back asynchronously, so what
+ * readers see can trail the device by a step or two. The CPU step is the
+ * reference: it is what deterministic runs and every fallback use.
+ */
+#ifndef CIV_WORLD_TILE_FIELD_H
+#define CIV_WORLD_TILE_FIELD_H
+
+#include "../../common.h"
+#include "../../types.h"
+#include "map_generator.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct civ_worker_pool;
+
+/* X(ID, diffusion, relaxation): rates per unit of time */
+#define CIV_TILE_FIELD_CHANNELS(X)                                             \
+  X(CULTURE, 0.20f, 0.05f)                                                     \
+  X(POLITICS, 0.10f, 0.10f)                                                    \
+  X(POPULATION, 0.05f, 0.20f)
+
+typedef enum {
+#define CIV_TILE_FIELD_ENUM(id, diffusion, relaxation) CIV_TILE_FIELD_##id,
+  CIV_TILE_FIELD_CHANNELS(CIV_TILE_FIELD_ENUM)
+#undef CIV_TILE_FIELD_ENUM
+  CIV_TILE_FIELD_CHANNEL_COUNT
+} civ_tile_field_channel_t;
+
+#define CIV_TILE_FIELD_INTERVAL      4 /* updates per step */
+#define CIV_TILE_FIELD_REGION_BUDGET 8 /* changed regions re-read per step */
+
+/* SDL hint (or environment variable) that opts the game's field into the
+   GPU step */
+#define CIV_TILE_FIELD_GPU_HINT "CIV_TILE_FIELD_GPU"
+
+struct civ_tile_field_gpu;
+
+typedef struct {
+  civ_map_t *map;
+  int32_t    width, height;
+
+  float *value[CIV_TILE_FIELD_CHANNEL_COUNT];  /* front: what readers see */
+  float *next[CIV_TILE_FIELD_CHANNEL_COUNT];   /* back: written by a step */
+  float *source[CIV_TILE_FIELD_CHANNEL_COUNT]; /* the tiles' overlay values */
+  float *land;                                 /* 1 on land, 0 on water */
+
+  uint32_t *region_seen; /* map region revisions last read */
+  size_t    region_count;
+  size_t    region_cursor;
+
+  uint64_t steps;                 /* steps the front buffer holds */
+  struct civ_tile_field_gpu *gpu; /* resident copy stepped there, or NULL */
+} civ_tile_field_t;
+
+/* Every channel starts at its source; NULL without a map or memory */
+civ_tile_field_t *civ_tile_field_create(civ_map_t *map);
+void civ_tile_field_destroy(civ_tile_field_t *field);
+
+/* Step on a GPU compute device from now on; false, with the field left on
+   the CPU, when no device or compiled shader is available */
+bool civ_tile_field_attach_gpu(civ_tile_field_t *field);
+
+/* Re-read changed regions, then advance every channel over dt */
+void civ_tile_field_step(civ_tile_field_t *field, struct civ_worker_pool *pool,
+                         civ_float_t dt);
+
+/* Channel value at tile (x, y); x wraps, y clamps */
+float civ_tile_field_at(const civ_tile_field_t *field,
+                        civ_tile_field_channel_t channel, int32_t x, int32_t y);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
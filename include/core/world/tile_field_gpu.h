@@ -0,0 +1,54 @@
+/**
+ * @file tile_field_gpu.h
+ * @brief SDL_GPU compute backend for tile field steps
+ *
+ * The channels, their sources and the land mask live in device storage
+ * buffers laid out by map region (CIV_MAP_REGION_SIZE squares, row-major
+ * inside each), so re-reading a changed region is one contiguous upload
+ * per plane. A step records the region uploads, one dispatch of
+ * shaders/tile_field.comp that reads the front values and writes the back
+ * ones, and, when the previous one has landed, a download of the result.
+ * Downloads are fenced and collected at a later step without waiting; their
+ * regions are copied into the field's back buffer on the pool and swapped
+ * to the front, so readers still see whole steps and province sums follow
+ * field->steps as before.
+ *
+ * The device is created for the backend alone (no window, SPIR-V only),
+ * so it works under any render driver and on the sim thread. The GPU does
+ * not round like the CPU step; runs that must replay or stay in lockstep
+ * keep to the CPU.
+ */
+#ifndef CIV_WORLD_TILE_FIELD_GPU_H
+#define CIV_WORLD_TILE_FIELD_GPU_H
+
+#include "tile_field.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Compiled compute shader, relative to the asset root (`make shaders`) */
+#define CIV_TILE_FIELD_SHADER_PATH "data/shaders/tile_field.comp.spv"
+
+typedef struct civ_tile_field_gpu civ_tile_field_gpu_t;
+
+/* Device, pipeline and buffers, filled from field's current values; NULL
+   when SDL_GPU, a SPIR-V device or the shader is unavailable */
+civ_tile_field_gpu_t *civ_tile_field_gpu_create(const civ_tile_field_t *field);
+/* Waits for the device to finish what it was given */
+void civ_tile_field_gpu_destroy(civ_tile_field_gpu_t *gpu);
+
+/* Upload the regions the field just re-read, step once with coeffs (a, b,
+   k per channel) and collect a finished download into the field. False on
+   a device error; the field's CPU copy is then the last one collected. */
+bool civ_tile_field_gpu_step(civ_tile_field_gpu_t *gpu, civ_tile_field_t *field,
+                             struct civ_worker_pool *pool,
+                             const size_t *regions, int region_count,
+                             const float *coeffs);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
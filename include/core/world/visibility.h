@@ -0,0 +1,57 @@
+/**
+ * @file visibility.h
+ * @brief Reference-counted fog of war driven by sight discs
+ *
+ * Each sight source (a unit, by index) stamps a disc of its visibility
+ * range. The tracker counts the sources seeing every tile and writes the
+ * map's fog only when a count crosses zero, through civ_map_set_visibility
+ * (which maintains the visible/explored bitplanes). A source that has not
+ * moved costs one compare per update; a moved source touches the tiles
+ * that left or entered its disc, never the whole map.
+ *
+ * The first update on a map (or after the map is replaced) clears its
+ * visibility once and restamps every source.
+ */
+#ifndef CIV_WORLD_VISIBILITY_H
+#define CIV_WORLD_VISIBILITY_H
+
+#include "map_generator.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Disc a source currently has stamped; range < 0 = none */
+typedef struct {
+  int32_t x, y, range;
+} civ_visibility_stamp_t;
+
+typedef struct {
+  uint16_t               *refs;      /* sources seeing each tile (< 65536) */
+  civ_visibility_stamp_t *stamps;    /* by source index */
+  size_t                  stamp_count;
+  size_t                  stamp_capacity;
+  const civ_map_t        *map;       /* map refs were built for */
+  int32_t                 width, height;
+} civ_visibility_t;
+
+civ_visibility_t *civ_visibility_create(void);
+void civ_visibility_destroy(civ_visibility_t *vis);
+
+/* Move source's disc to (x, y) with the given range (0 = own tile only,
+   < 0 = nothing). Returns the number of tiles whose visibility changed. */
+size_t civ_visibility_update_source(civ_visibility_t *vis, civ_map_t *map,
+                                    size_t source, int32_t x, int32_t y,
+                                    int32_t range);
+
+/* Drop the discs of every source with index >= count */
+size_t civ_visibility_truncate(civ_visibility_t *vis, civ_map_t *map,
+                               size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
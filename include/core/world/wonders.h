@@ -8,6 +8,7 @@
 
 #include "../../common.h"
 #include "../../types.h"
+#include "owner_ids.h"
 
 /* Wonder Types */
 typedef enum {
@@ -43,11 +44,13 @@ typedef struct {
 
   bool is_built;
   char builder_id[STRING_SHORT_LEN]; /* ID of settlement or nation */
+  civ_owner_index_t builder_owner;   /* builder_id interned */
 } civ_wonder_t;
 
 /* Wonder Manager */
 typedef struct {
   civ_wonder_t wonders[CIV_WONDER_COUNT];
+  uint32_t revision; /* bumped whenever a wonder is built */
 } civ_wonder_manager_t;
 
 /* Functions */
@@ -64,5 +67,9 @@ void civ_wonder_mark_built(civ_wonder_manager_t *manager,
 civ_wonder_effects_t
 civ_wonder_calculate_global_bonuses(const civ_wonder_manager_t *manager,
                                     const char *owner_id);
+/* Same, for an interned owner */
+civ_wonder_effects_t
+civ_wonder_owner_bonuses(const civ_wonder_manager_t *manager,
+                         civ_owner_index_t owner);
 
 #endif /* CIVILIZATION_WONDERS_H */
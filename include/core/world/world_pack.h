@@ -0,0 +1,85 @@
+/**
+ * @file world_pack.h
+ * @brief Single-file world asset pack with a table of contents
+ *
+ * data/world.pack (written by tools/build_world_pack.py) bundles the earth
+ * landmask, borders, nations, resources, cities and flag index. Each
+ * section keeps its original file format and starts on a 64-byte boundary.
+ *
+ *   [header 64 B] [toc: section_count x 32 B] [sections, 64-byte aligned]
+ *
+ * The pack is memory-mapped and opening reads only the header and TOC.
+ * A section's pages are prefetched when its loader asks for the view and
+ * touched when it reads it, so sections nobody asks for (cities and flags
+ * until the game scene) cost nothing at startup.
+ */
+#ifndef CIV_WORLD_WORLD_PACK_H
+#define CIV_WORLD_WORLD_PACK_H
+
+#include "../../utils/mapped_file.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CIV_WORLD_PACK_MAGIC   0x4B415057 /* "WPAK" little-endian */
+#define CIV_WORLD_PACK_VERSION 1
+#define CIV_WORLD_PACK_ALIGN   64
+#define CIV_WORLD_PACK_PATH    "data/world.pack"
+
+typedef enum {
+  CIV_PACK_EARTH = 0,   /* "EART": .earth landmask */
+  CIV_PACK_BORDERS,     /* "BORD": earth_borders.bin */
+  CIV_PACK_NATIONS,     /* "NATN": nations.bin */
+  CIV_PACK_RESOURCES,   /* "RSRC": resources.bin */
+  CIV_PACK_CITIES,      /* "CITY": cities.bin */
+  CIV_PACK_FLAGS,       /* "FLAG": flags/index.bin (PNGs stay on disk) */
+  CIV_PACK_SECTION_COUNT
+} civ_pack_section_t;
+
+/* On-disk header, little-endian */
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t section_count;
+  uint32_t toc_offset;
+  uint64_t file_size;
+  uint32_t reserved[10];
+} civ_world_pack_header_t;
+
+/* On-disk TOC entry */
+typedef struct {
+  char     tag[4];
+  uint32_t flags;       /* reserved, 0 */
+  uint64_t offset;      /* from file start, CIV_WORLD_PACK_ALIGN aligned */
+  uint64_t size;
+  uint64_t reserved;
+} civ_world_pack_entry_t;
+
+typedef struct {
+  const uint8_t *data;
+  size_t         size;
+} civ_pack_view_t;
+
+typedef struct {
+  civ_mapped_file_t file;
+  civ_pack_view_t   sections[CIV_PACK_SECTION_COUNT];  /* data NULL = absent */
+} civ_world_pack_t;
+
+/* Map and validate a pack; NULL if missing or malformed. Unknown section
+   tags are ignored so newer packs still open. */
+civ_world_pack_t *civ_world_pack_open(const char *path);
+void              civ_world_pack_close(civ_world_pack_t *pack);
+
+/* View of a section; false if the pack lacks it. Views stay valid until
+   civ_world_pack_close. */
+bool civ_world_pack_section(const civ_world_pack_t *pack,
+                            civ_pack_section_t section, civ_pack_view_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
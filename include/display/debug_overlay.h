@@ -1,10 +1,12 @@
 /**
  * @file debug_overlay.h
- * @brief FPS counter and draw-call statistics overlay
+ * @brief FPS counter, draw-call statistics, phase profiler, memory tag and
+ *        startup timeline overlay
  */
 #ifndef CIV_DISPLAY_DEBUG_OVERLAY_H
 #define CIV_DISPLAY_DEBUG_OVERLAY_H
 
+#include "core/simulation_engine/performance_optimizer.h"
 #include <SDL3/SDL.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -13,6 +15,9 @@
 extern "C" {
 #endif
 
+#define CIV_DEBUG_PROFILE_FRAMES    96    /* simulation ticks in the bar view */
+#define CIV_DEBUG_PROFILE_BUDGET_MS 50.0  /* reference line: one 20 Hz tick */
+
 typedef struct {
   bool enabled;
   double frame_time_ms;
@@ -23,6 +28,17 @@ typedef struct {
   double max_frame_ms;
   int frame_count;
   double accumulator;
+
+  /* Per-phase stacked bars, oldest tick on the left */
+  bool show_profile;
+  civ_profile_frame_t profile_frames[CIV_DEBUG_PROFILE_FRAMES];
+  size_t profile_count;
+
+  /* Live and peak bytes per memory tag; drawn only under CIV_MEM_TAGS */
+  bool show_memory;
+
+  /* Startup steps as bars on a shared time axis */
+  bool show_startup;
 } civ_debug_overlay_t;
 
 void civ_debug_overlay_init(civ_debug_overlay_t *d);
@@ -30,6 +46,19 @@ void civ_debug_overlay_update(civ_debug_overlay_t *d, double dt_ms,
                               int draw_calls);
 void civ_debug_overlay_render(civ_debug_overlay_t *d, SDL_Renderer *r, int win_w);
 
+/* Stacked per-phase bars for the last CIV_DEBUG_PROFILE_FRAMES ticks */
+void civ_debug_overlay_render_profile(civ_debug_overlay_t *d, SDL_Renderer *r,
+                                      int x, int y);
+
+/* One row per memory tag: heap live against peak, pooled bytes beneath */
+void civ_debug_overlay_render_memory(civ_debug_overlay_t *d, SDL_Renderer *r,
+                                     int x, int y);
+
+/* One bar per startup step, from its start to its end, coloured by thread;
+   nested steps are inset */
+void civ_debug_overlay_render_startup(civ_debug_overlay_t *d, SDL_Renderer *r,
+                                      int x, int y);
+
 #ifdef __cplusplus
 }
 #endif
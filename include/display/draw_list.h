@@ -1,11 +1,17 @@
 /**
  * @file draw_list.h
  * @brief Deferred draw list — collect, sort by layer, flush
+ *
+ * Flushing turns the sorted commands into one vertex/index buffer and
+ * issues one SDL_RenderGeometry per run of commands sharing a texture
+ * (solid shapes share NULL), so a frame of panels costs a few calls.
+ * Command and geometry storage persist across frames.
  */
 #ifndef CIV_DISPLAY_DRAW_LIST_H
 #define CIV_DISPLAY_DRAW_LIST_H
 
 #include <SDL3/SDL.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -32,6 +38,7 @@ typedef struct {
   const char *text;
   int layer;
   uint32_t sort_key;
+  int order;          /* submission index, breaks sort_key ties */
 } civ_draw_cmd_t;
 
 typedef struct {
@@ -40,6 +47,11 @@ typedef struct {
   int capacity;
   int draw_calls_this_frame;
   double last_frame_ms;
+  bool sort_by_y;     /* within a layer; false = submission order */
+  SDL_Vertex *vertices;
+  int vertex_capacity;
+  int *indices;
+  int index_capacity;
 } civ_draw_list_t;
 
 void civ_draw_list_init(civ_draw_list_t *dl, int initial_capacity);
@@ -55,8 +67,11 @@ void civ_draw_line(civ_draw_list_t *dl, float x1, float y1, float x2, float y2,
                    uint32_t color, int layer);
 void civ_draw_text(civ_draw_list_t *dl, const char *text, float x, float y,
                    uint32_t color, int layer);
+void civ_draw_texture(civ_draw_list_t *dl, SDL_Texture *texture, float x,
+                      float y, float w, float h, uint8_t alpha, int layer);
 
-/* Flush all commands to the SDL renderer */
+/* Flush all commands to the SDL renderer; the list keeps them until
+   civ_draw_list_clear. Text commands carry no font and are not drawn. */
 void civ_draw_list_flush(civ_draw_list_t *dl, SDL_Renderer *r);
 
 #ifdef __cplusplus
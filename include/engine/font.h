@@ -72,7 +72,21 @@ civ_font_t *civ_font_load(const char *path, int size);
 void civ_font_destroy(civ_font_t *font);
 
 /**
- * Render text at position
+ * Queue text drawn until civ_font_end_batch instead of drawing it at once;
+ * each font's queued strings then go out as one geometry call. Only wrap
+ * runs of text that nothing else is drawn over before the batch ends.
+ */
+void civ_font_begin_batch(void);
+
+/**
+ * Draw everything queued since civ_font_begin_batch
+ */
+void civ_font_end_batch(void);
+
+/**
+ * Render text at position. Strings are rasterized once into a per-font
+ * atlas (least recently drawn rows evicted first) and drawn from it, tinted
+ * per call, so repeated labels create no textures.
  * @param renderer SDL renderer
  * @param font Font to use
  * @param text Text to render
@@ -115,6 +129,21 @@ void civ_font_render_alpha(SDL_Renderer *renderer, civ_font_t *font,
                            const char *text, int x, int y, uint32_t color,
                            uint8_t alpha);
 
+/**
+ * Render text scaled and rotated about its centre, from the atlas only
+ * (text it cannot cache is skipped)
+ * @param cx Centre X
+ * @param cy Centre Y
+ * @param scale Size relative to the font's rasterized size
+ * @param angle Clockwise rotation in radians
+ * @param color RGB color (0xRRGGBB)
+ * @param alpha Alpha value (0-255)
+ */
+void civ_font_render_transformed(SDL_Renderer *renderer, civ_font_t *font,
+                                 const char *text, float cx, float cy,
+                                 float scale, float angle, uint32_t color,
+                                 uint8_t alpha);
+
 /**
  * Get text dimensions
  * @param font Font to measure with
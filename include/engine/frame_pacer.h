@@ -0,0 +1,122 @@
+/**
+ * @file frame_pacer.h
+ * @brief Render-on-demand frame pacing
+ *
+ * The main loop asks the pacer each iteration whether a frame is worth
+ * presenting. A frame is drawn while there is activity — input events, a
+ * simulation change, or an animation that called civ_frame_request_redraw()
+ * — and for a short grace period afterwards; otherwise the loop only polls
+ * at a low rate and redraws once in a while as a safety net. Active frames
+ * are paced by VSync when the renderer has it, or by a precise wait for the
+ * rest of the target frame time when it does not.
+ *
+ * Whatever is left of the frame budget after rendering can be handed to
+ * idle tasks (chunk baking, deferred saves), which get a deadline and give
+ * control back before it.
+ */
+
+#ifndef CIV_ENGINE_FRAME_PACER_H
+#define CIV_ENGINE_FRAME_PACER_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CIV_FRAME_PACER_DEFAULT_HZ 60
+#define CIV_FRAME_PACER_POLL_HZ    20   /**< Loop rate while idle */
+#define CIV_FRAME_PACER_REFRESH_HZ 1    /**< Safety-net redraws while idle */
+#define CIV_FRAME_PACER_GRACE_NS   500000000ull /**< Keep drawing after activity */
+#define CIV_FRAME_PACER_MAX_TASKS  8
+
+/**
+ * Background work run in leftover frame time
+ * @param user_data Pointer given at registration
+ * @param deadline_ns SDL_GetTicksNS() value to return before
+ * @return True if the task has more work queued
+ */
+typedef bool (*civ_idle_task_fn_t)(void *user_data, Uint64 deadline_ns);
+
+/**
+ * Frame counters since init
+ */
+typedef struct {
+  uint64_t frames_presented; /**< Frames rendered and presented */
+  uint64_t frames_skipped;   /**< Loop iterations that drew nothing */
+  Uint64 idle_task_ns;       /**< Time spent in idle tasks */
+} civ_frame_pacer_stats_t;
+
+/**
+ * Reset the pacer
+ * @param target_hz Frame rate while active (<= 0 for the default)
+ * @param vsync True if presenting already waits for the vertical blank
+ */
+void civ_frame_pacer_init(int target_hz, bool vsync);
+
+/**
+ * Start a loop iteration; its budget runs from now
+ */
+void civ_frame_pacer_begin_frame(void);
+
+/**
+ * Decide whether this iteration presents, after events and scene updates
+ * have had their chance to report activity
+ * @return True if the caller should render and present this iteration
+ */
+bool civ_frame_pacer_should_present(void);
+
+/**
+ * Record input or another change that needs the screen redrawn; starts
+ * the grace period
+ */
+void civ_frame_pacer_note_activity(void);
+
+/**
+ * Ask for the next frame to be drawn (animations call this every update
+ * they are still moving)
+ */
+void civ_frame_request_redraw(void);
+
+/**
+ * Time left before the next iteration is due
+ * @return Nanoseconds, 0 if the iteration is already over budget
+ */
+Uint64 civ_frame_pacer_budget_ns(void);
+
+/**
+ * Register background work for leftover frame time
+ * @return False if the task table is full
+ */
+bool civ_frame_pacer_add_idle_task(civ_idle_task_fn_t fn, void *user_data);
+
+/**
+ * Unregister a task added with the same function and user data
+ */
+void civ_frame_pacer_remove_idle_task(civ_idle_task_fn_t fn, void *user_data);
+
+/**
+ * Run idle tasks round-robin until the frame budget is spent or none has
+ * work left
+ */
+void civ_frame_pacer_run_idle_tasks(void);
+
+/**
+ * Wait out the rest of the iteration. Active frames wait precisely (or
+ * not at all under VSync); idle iterations block on the event queue so
+ * input wakes the loop at once.
+ */
+void civ_frame_pacer_wait(void);
+
+/**
+ * Copy the frame counters
+ */
+void civ_frame_pacer_get_stats(civ_frame_pacer_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CIV_ENGINE_FRAME_PACER_H */
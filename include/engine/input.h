@@ -32,7 +32,7 @@ typedef struct {
   bool mouse_right_pressed;  /**< Right button just pressed this frame */
   bool mouse_right_released; /**< Right button just released this frame */
 
-  float scroll_delta; /**< Mouse wheel delta */
+  float scroll_delta; /**< Mouse wheel delta, summed over the frame's events */
 
   /* Keyboard state */
   const bool *keyboard; /**< Keyboard state array (SDL_GetKeyboardState) */
@@ -45,6 +45,11 @@ typedef struct {
   int active_id;       /**< ID of active/clicked widget */
   int last_clicked_id; /**< ID of widget clicked this frame */
 
+  /* Hit routing (see ui/hit_grid.h) */
+  bool hit_routed;       /**< hit_top is valid this frame */
+  const void *hit_top;   /**< Layer that owns the mouse; NULL = the scene */
+  const void *hit_layer; /**< Layer being updated or drawn now */
+
   /* Text input and keys */
   char text_input[32];    /**< Text input received this frame (UTF-8) */
   bool backspace_pressed; /**< True if backspace was pressed this frame */
@@ -80,13 +85,14 @@ void civ_input_begin_frame(civ_input_state_t *state);
 
 /**
  * End input frame (call at end of frame)
- * Update deltas and previous state
+ * Keep the mouse position the next frame's deltas start from
  * @param state Input state to finalize
  */
 void civ_input_end_frame(civ_input_state_t *state);
 
 /**
  * Check if mouse is over rectangle
+ * Once hits are routed, only true for the layer that owns the mouse.
  * @param state Input state
  * @param x Rectangle X
  * @param y Rectangle Y
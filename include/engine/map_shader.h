@@ -0,0 +1,64 @@
+/**
+ * @file map_shader.h
+ * @brief GPU map backend: tile attributes in a texture, colours in a shader
+ *
+ * The tile fields the map views read are packed into one RGBA texture and
+ * uploaded once, then again per map revision region as tiles change. A
+ * fragment shader (shaders/map_view.frag) does the view colouring, the
+ * east-west wrap and the polar clamp, so switching views only changes a
+ * uniform and the CPU cost of a frame is one textured quad.
+ *
+ * Needs SDL 3.4 custom render states, a renderer on the "gpu" driver
+ * (e.g. SDL_RENDER_DRIVER=gpu) with SPIR-V support, and the compiled
+ * shader from `make shaders`. Otherwise civ_map_shader_create returns NULL
+ * and the CPU paths draw the map.
+ */
+
+#ifndef CIV_ENGINE_MAP_SHADER_H
+#define CIV_ENGINE_MAP_SHADER_H
+
+#include "../core/world/map_generator.h"
+#include "../core/world/map_view.h"
+#include "../core/world/resource_map.h"
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Compiled fragment shader, relative to the asset root */
+#define CIV_MAP_SHADER_PATH "data/shaders/map_view.frag.spv"
+
+/**
+ * GPU map backend (opaque)
+ */
+typedef struct civ_map_shader civ_map_shader_t;
+
+/**
+ * Create the backend for a map size
+ * @return Backend, or NULL when the renderer or shader is unavailable
+ */
+civ_map_shader_t *civ_map_shader_create(SDL_Renderer *renderer, int map_width,
+                                        int map_height);
+
+/**
+ * Destroy the backend
+ */
+void civ_map_shader_destroy(civ_map_shader_t *shader);
+
+/**
+ * Upload changed tiles and draw the view over the whole framebuffer
+ * @param scale Pixels per tile
+ * @return false if nothing was drawn (caller falls back to the CPU paths)
+ */
+bool civ_map_shader_draw(civ_map_shader_t *shader, SDL_Renderer *renderer,
+                         const civ_map_t *map, const civ_resource_map_t *rm,
+                         civ_map_view_type_t view, float view_x, float view_y,
+                         float scale, int fb_width, int fb_height);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CIV_ENGINE_MAP_SHADER_H */
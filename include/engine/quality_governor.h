@@ -0,0 +1,87 @@
+/**
+ * @file quality_governor.h
+ * @brief Steps presentation and simulation detail against frame and tick budgets
+ *
+ * The main loop samples the CPU time of every presented frame, and of every
+ * sim tick it sees complete, into an exponential moving average per budget.
+ * While an average stays above its target for CIV_QUALITY_DEGRADE_SAMPLES
+ * samples in a row, the first knob of that budget with room left gives up
+ * one step of detail; once it stays well under target for the longer
+ * CIV_QUALITY_RESTORE_SAMPLES, the most recently degraded knob gets a step
+ * back. Any change restarts both counts, so one move settles before the
+ * next and the levels do not oscillate around the target.
+ *
+ * Knobs are ordered cheapest-to-lose first. Each runs from its full value
+ * at level 0 to its reduced bound at the last level; levels are atomic, so
+ * the sim thread reads its knobs without the main loop's lock.
+ */
+
+#ifndef CIV_ENGINE_QUALITY_GOVERNOR_H
+#define CIV_ENGINE_QUALITY_GOVERNOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CIV_QUALITY_DEGRADE_SAMPLES 30   /**< Over budget before a step down */
+#define CIV_QUALITY_RESTORE_SAMPLES 180  /**< Under budget before a step up */
+#define CIV_QUALITY_OVER_RATIO      1.10 /**< Average over target that counts */
+#define CIV_QUALITY_UNDER_RATIO     0.75 /**< Average under target that counts */
+#define CIV_QUALITY_EMA_ALPHA       0.1
+
+typedef enum {
+  CIV_QUALITY_BUDGET_FRAME, /**< Main-loop CPU time per presented frame */
+  CIV_QUALITY_BUDGET_TICK,  /**< Sim thread time per tick */
+  CIV_QUALITY_BUDGET_COUNT
+} civ_quality_budget_t;
+
+/* X(id, name, budget, full, reduced, steps) */
+#define CIV_QUALITY_KNOBS(X)                                                   \
+  X(BORDER_REFRESH_MS,  "border_refresh_ms",  FRAME, 0.0f,  500.0f, 4)         \
+  X(MINIMAP_REFRESH_MS, "minimap_refresh_ms", FRAME, 0.0f, 2000.0f, 4)         \
+  X(CLUSTER_PX,         "cluster_px",         FRAME, 12.0f,  24.0f, 3)         \
+  X(MAP_LOD_BIAS,       "map_lod_bias",       FRAME, 0.0f,    1.5f, 3)         \
+  X(VIEW_REFRESH_TICKS, "view_refresh_ticks", TICK,  1.0f,    8.0f, 3)         \
+  X(AI_BUDGET_SCALE,    "ai_budget_scale",    TICK,  1.0f,   0.25f, 3)         \
+  X(NATION_LOD_SCALE,   "nation_lod_scale",   TICK,  1.0f,    0.4f, 3)
+
+typedef enum {
+#define CIV_QUALITY_KNOB_ENUM(id, name, budget, full, reduced, steps)          \
+  CIV_QUALITY_##id,
+  CIV_QUALITY_KNOBS(CIV_QUALITY_KNOB_ENUM)
+#undef CIV_QUALITY_KNOB_ENUM
+  CIV_QUALITY_KNOB_COUNT
+} civ_quality_knob_t;
+
+/**
+ * Reset every knob to full detail
+ * @param frame_target_ms Frame CPU budget (<= 0 turns the governor off)
+ * @param tick_target_ms Tick budget (<= 0 leaves the tick knobs alone)
+ */
+void civ_quality_governor_init(double frame_target_ms, double tick_target_ms);
+
+/**
+ * Feed one measurement; may step a knob of that budget. Main thread only.
+ */
+void civ_quality_governor_sample(civ_quality_budget_t budget, double ms);
+
+/**
+ * Current value of a knob, between its full and reduced bounds. Any thread.
+ */
+float civ_quality_governor_value(civ_quality_knob_t knob);
+
+/**
+ * Current step of a knob, 0 = full detail. Any thread.
+ */
+int civ_quality_governor_level(civ_quality_knob_t knob);
+
+const char *civ_quality_governor_knob_name(civ_quality_knob_t knob);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CIV_ENGINE_QUALITY_GOVERNOR_H */
@@ -10,6 +10,8 @@
 #include "../core/world/map_view.h"
 #include "../core/world/resource_map.h"
 #include "../core/world/settlement_manager.h"
+#include "../display/draw_list.h"
+#include "map_shader.h"
 #include <SDL3/SDL.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -18,6 +20,20 @@
 extern "C" {
 #endif
 
+/**
+ * Route the shape helpers below (rects, outlines, lines, gradients) for
+ * renderer into a draw list until civ_render_end_batch, which draws them
+ * in submission order as a few geometry calls. Anything that draws on its
+ * own (textures, text, the map) calls civ_render_flush_batch first so the
+ * order on screen is unchanged.
+ */
+void civ_render_begin_batch(SDL_Renderer *renderer);
+void civ_render_flush_batch(void);
+void civ_render_end_batch(void);
+
+/* Geometry calls made by the last batch flush */
+int civ_render_batch_draw_calls(void);
+
 /**
  * Draw filled rectangle
  * @param renderer SDL renderer
@@ -93,6 +109,71 @@ void civ_render_gradient_vertical(SDL_Renderer *renderer, int x, int y, int w,
 void civ_render_shadow(SDL_Renderer *r, int x, int y, int w, int h,
                        int radius, int offset, uint8_t alpha);
 
+/* Baked map chunks are one map revision region each, one texel per tile */
+#define CIV_RENDER_CHUNK_SIZE CIV_MAP_REGION_SIZE
+
+/**
+ * One baked chunk of one map view
+ */
+typedef struct {
+  SDL_Texture *texture;  /**< NULL until first baked */
+  uint32_t revision;     /**< Region revision the texture shows */
+  bool baked;            /**< revision is meaningful */
+} civ_render_map_chunk_t;
+
+/* LOD level k averages 2^k x 2^k tiles, k = 1..CIV_RENDER_LOD_LEVELS */
+#define CIV_RENDER_LOD_LEVELS 4
+
+/**
+ * Downscale pyramid of one map view. Levels are rebuilt per map revision
+ * region, so a conquest only re-averages the texels over its regions.
+ */
+typedef struct {
+  SDL_Texture *texture[CIV_RENDER_LOD_LEVELS]; /**< [k - 1] = level k */
+  uint32_t    *texels[CIV_RENDER_LOD_LEVELS];
+  int          width[CIV_RENDER_LOD_LEVELS];
+  int          height[CIV_RENDER_LOD_LEVELS];
+  civ_render_map_chunk_t *regions; /**< Revision built per region; no texture */
+  const civ_resource_map_t *resources; /**< Built into the economic view */
+} civ_render_map_lod_t;
+
+/** One border edge in tile coordinates, axis-aligned */
+typedef struct {
+  float x0, y0, x1, y1;
+} civ_render_border_segment_t;
+
+/**
+ * Border edges of one map revision region: each owned land tile's east and
+ * south edges against a different owner, merged into runs. They depend on
+ * the east and south neighbour regions too, so all three revisions are kept.
+ */
+typedef struct {
+  civ_render_border_segment_t *segments;
+  int      count;
+  int      capacity;
+  uint32_t revision[3];  /**< Own, east and south region when built */
+  uint64_t built_ns;     /**< SDL_GetTicksNS() at the last build */
+  bool     built;
+} civ_render_map_border_chunk_t;
+
+/* Map markers drawn smaller than this are aggregated: markers sharing a
+   CIV_RENDER_CLUSTER_CELL_PX screen cell collapse into one */
+#define CIV_RENDER_CLUSTER_MIN_PX  12.0f
+#define CIV_RENDER_CLUSTER_CELL_PX 24
+
+/** One entity marker in screen space */
+typedef struct {
+  float    x, y;
+  uint32_t color;  /**< 0xRRGGBB */
+} civ_render_marker_t;
+
+/** Markers gathered into one screen cell */
+typedef struct {
+  float    sum_x, sum_y;
+  uint32_t count;
+  uint32_t color;  /**< Colour of the first marker in the cell */
+} civ_render_cluster_t;
+
 /**
  * Map rendering context
  */
@@ -102,12 +183,59 @@ typedef struct {
   int buffer_width;         /**< Buffer width */
   int buffer_height;        /**< Buffer height */
 
-  /* Multi-scale LOD buffers (pre-computed political view at low res) */
-  SDL_Texture *lod_texture_512;   /**< 512x256 downscale texture */
-  SDL_Texture *lod_texture_256;   /**< 256x128 downscale texture */
-  uint32_t    *lod_buffer_512;    /**< 512x256 CPU buffer */
-  uint32_t    *lod_buffer_256;    /**< 256x128 CPU buffer */
-  bool         lods_built;        /**< Whether LODs are computed */
+  /* LOD pyramid per view, built on first zoom-out; NULL until then */
+  civ_render_map_lod_t *lods[CIV_MAP_VIEW_COUNT];
+
+  /* Chunk textures per view, baked on demand and re-baked only when the
+     map revision of their region moves; NULL arrays until a view is drawn */
+  civ_render_map_chunk_t *chunks[CIV_MAP_VIEW_COUNT];
+  int          chunk_cols;        /**< Chunks across the map */
+  int          chunk_rows;        /**< Chunks down the map */
+  uint32_t     chunk_map_serial;  /**< civ_map_t.serial the chunks show */
+  const civ_resource_map_t *chunk_resources; /**< Baked into economic view */
+  uint32_t    *chunk_pixels;      /**< Bake scratch, one chunk */
+
+  /* Border segments per region, on the same grid as the chunks */
+  civ_render_map_border_chunk_t *border_chunks;
+  SDL_Vertex  *border_vertices;   /**< Screen-space quads, one chunk */
+  int          border_vertices_capacity;
+
+  /* Minimap, re-sampled only when a region revision moves */
+  SDL_Texture *minimap_texture;
+  uint32_t    *minimap_pixels;
+  int          minimap_width;
+  int          minimap_height;
+  uint64_t     minimap_revision;  /**< Sum of region revisions sampled */
+  uint64_t     minimap_sampled_ns;
+  bool         minimap_valid;
+
+  /* Per-pixel raster, used when chunks are unavailable */
+  int32_t     *raster_span_x;     /**< World x of each distinct column tile */
+  int32_t     *raster_col_span;   /**< Column -> index into raster_span_x */
+  int          raster_cols_capacity;
+  uint32_t    *raster_colors;     /**< Span colours, one row per job */
+  size_t       raster_colors_capacity;
+
+  /* Entity overlay scratch, grown on demand */
+  size_t      *entity_indices;
+  size_t       entity_capacity;
+  civ_render_marker_t  *markers;
+  size_t       marker_capacity;
+  civ_render_cluster_t *clusters;
+  size_t       cluster_capacity;
+
+  civ_map_shader_t *map_shader;   /**< GPU colouring, NULL = CPU paths */
+
+  /* Detail trade-offs, full detail as created; the quality governor moves
+     them under load */
+  float        lod_bias;          /**< Octaves added once zoomed out */
+  float        cluster_min_px;    /**< Markers below this aggregate */
+  uint64_t     border_refresh_ns; /**< Min age before a moved chunk rebuilds */
+  uint64_t     minimap_refresh_ns;/**< Min age before the minimap resamples */
+
+  /** Optional, not owned; spreads raster and bake rows when set. The
+      caller refreshes it each frame since pools can be recreated. */
+  struct civ_worker_pool *worker_pool;
 
   /* Camera state */
   float view_x; /**< Camera X position in world coords */
@@ -138,12 +266,33 @@ civ_render_map_context_create(SDL_Renderer *renderer, int fb_width,
  */
 void civ_render_map_context_destroy(civ_render_map_context_t *ctx);
 
-/* Pre-compute downscale LOD buffers for smooth zoomed-out rendering */
+/* Build the political view's LOD pyramid ahead of the first zoom-out.
+   Every view builds its own on demand and keeps it current. */
 void civ_render_map_build_lods(civ_render_map_context_t *ctx, civ_map_t *map,
                                SDL_Renderer *r);
 
+/**
+ * Bake stale map chunks and LOD regions of one view ahead of drawing,
+ * nearest the view centre first, for idle frame time
+ * @param deadline_ns SDL_GetTicksNS() value to stop by
+ * @return True if stale regions remain
+ */
+bool civ_render_map_prebake(SDL_Renderer *renderer,
+                            civ_render_map_context_t *ctx, civ_map_t *map,
+                            civ_map_view_type_t view,
+                            const civ_resource_map_t *resource_map,
+                            Uint64 deadline_ns);
+
 /**
  * Render world map to screen
+ *
+ * Below one pixel per tile the LOD level is picked from the zoom, with the
+ * next coarser level blended in by the fractional part so zooming has no
+ * visible steps. Colours the view in a shader when the GPU backend is
+ * available. Else
+ * draws the baked chunk textures under the view, re-baking stale chunks
+ * first, and falls back to rastering every pixel when textures cannot be
+ * created.
  * @param renderer SDL renderer
  * @param ctx Map rendering context
  * @param map World map data
@@ -156,27 +305,44 @@ void civ_render_map(SDL_Renderer *renderer, civ_render_map_context_t *ctx,
                     const civ_resource_map_t *resource_map);
 
 /**
- * Render minimap to screen
+ * Render minimap to screen. The map is sampled into a texture, from the
+ * political LOD pyramid when it is coarse enough, and re-sampled only when
+ * ownership or fog (any region revision) changes; each frame draws that
+ * texture and the viewport rectangle.
  */
 void civ_render_minimap(SDL_Renderer *renderer, int x, int y, int w, int h,
                         civ_map_t *map, civ_render_map_context_t *ctx);
 
 /**
  * Render border lines between territories with different owners.
- * Only drawn at zoom > 1.0x for performance.
+ * Segments are extracted per region and re-extracted only when the region
+ * or its east or south neighbour changes; each region is one geometry
+ * call, so borders are drawn at every zoom.
  */
 void civ_render_map_borders(SDL_Renderer *renderer,
                             civ_render_map_context_t *ctx,
                             civ_map_t *map, int fb_w, int fb_h);
 
 /**
- * Render settlements on the map
+ * Render settlements on the map. Only settlements under the view are
+ * visited, through the manager's spatial index; all shapes go out as one
+ * batched geometry call. Below ctx->cluster_min_px the castles give way
+ * to aggregated cluster markers.
  */
 void civ_render_settlements(SDL_Renderer *renderer,
                             civ_render_map_context_t *ctx,
                             civ_settlement_manager_t *manager, int win_w,
                             int win_h);
 
+/**
+ * Draw markers aggregated by screen cell: one square per occupied cell at
+ * the centroid of its markers, growing with the count. Batched.
+ */
+void civ_render_marker_clusters(SDL_Renderer *renderer,
+                                civ_render_map_context_t *ctx,
+                                const civ_render_marker_t *markers,
+                                size_t count, int win_w, int win_h);
+
 /**
  * Set alpha blending mode
  * @param renderer SDL renderer
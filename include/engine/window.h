@@ -74,6 +74,13 @@ void civ_window_clear(civ_window_t *window, uint32_t color);
  */
 void civ_window_present(civ_window_t *window);
 
+/**
+ * Check whether presenting waits for the display's vertical blank
+ * @param window Window handle
+ * @return True if VSync is active on the renderer
+ */
+bool civ_window_has_vsync(civ_window_t *window);
+
 /**
  * Get current window size
  * @param window Window handle
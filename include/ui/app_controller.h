@@ -2,6 +2,7 @@
 #define CIV_UI_APP_CONTROLLER_H
 
 #include "../core/game.h"
+#include "../core/simulation_engine/sim_thread.h"
 #include "../engine/input.h"
 #include "../engine/window.h"
 #include "window_mgr.h"
@@ -17,6 +18,13 @@ typedef struct {
   civ_game_t *game;
   civ_input_state_t input;
   civ_window_mgr_t  window_mgr;
+  civ_sim_thread_t *sim;     /* created once the game has loaded */
+  int tick_hz;
+  bool loaded;
+  bool governed;             /* quality governor on; --no-governor clears */
+  int32_t sim_turn, sim_day; /* last snapshot date drawn */
+  uint64_t sim_tick;         /* last tick fed to the governor */
+  int view_ticks;            /* ticks since the views were published; sim thread */
   Uint64 last_frame_time;
   float delta_time;
   bool running;
@@ -4,6 +4,12 @@
  *
  * All graphs render to SDL_Texture for composition into panels.
  * Shared infrastructure: axes, gridlines, labels, legends, color palettes.
+ *
+ * Line charts and sparklines draw at most four points per pixel column:
+ * a series denser than that is reduced to each column's first, lowest,
+ * highest and last sample, which rasterizes to the same pixels as the full
+ * series. Their lines go out as one batched geometry call, so a chart costs
+ * in proportion to its width whatever the history length.
  */
 #ifndef CIV_UI_GRAPH_H
 #define CIV_UI_GRAPH_H
@@ -90,6 +96,12 @@ void civ_graph_draw_grid(SDL_Renderer *r, civ_graph_ctx_t *ctx,
 void civ_graph_map_point(civ_graph_ctx_t *ctx, float x_val, float y_val,
                          int *px, int *py);
 
+/* Reduce count samples (x ascending; NULL = sample index) over [x_min,
+   x_max] to each of columns columns' first, min, max and last, in order.
+   out_x and out_y hold 4 * columns; returns the number written. */
+int civ_graph_decimate(const float *x, const float *y, int count, float x_min,
+                       float x_max, int columns, float *out_x, float *out_y);
+
 #ifdef __cplusplus
 }
 #endif
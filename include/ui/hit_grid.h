@@ -0,0 +1,67 @@
+/**
+ * @file hit_grid.h
+ * @brief Per-frame UI hit testing: z-ordered layer rects on a coarse grid
+ *
+ * Anything drawn over the scene that should take the mouse — windows,
+ * floating panels — adds its rect while it renders, bottom to top. Each
+ * rect is linked into the CIV_HIT_CELL-sized cells it covers, newest
+ * first, so the topmost rect under a point is the first one in its cell
+ * that contains it. After the frame's events are in, civ_hit_grid_route
+ * does that lookup once and records the layer that owns the mouse on the
+ * input state.
+ *
+ * civ_input_is_mouse_over then only answers for the layer that owns the
+ * mouse: code drawing a layer sets input->hit_layer to it, and the scene
+ * itself is layer NULL. A frame that is not drawn keeps the last grid.
+ */
+#ifndef CIV_UI_HIT_GRID_H
+#define CIV_UI_HIT_GRID_H
+
+#include "../engine/input.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CIV_HIT_CELL      64   /* grid cell side, px */
+#define CIV_HIT_RECTS_MAX 256
+#define CIV_HIT_REFS_MAX  8192 /* rect-in-cell links */
+
+typedef struct {
+  const void *layer;
+  int x, y, w, h;
+} civ_hit_rect_t;
+
+typedef struct {
+  civ_hit_rect_t rects[CIV_HIT_RECTS_MAX]; /* bottom to top */
+  int            count;
+  int16_t        ref_rect[CIV_HIT_REFS_MAX];
+  int16_t        ref_next[CIV_HIT_REFS_MAX];
+  int            ref_count;
+  int16_t       *cells;       /* head link per cell, -1 = empty */
+  int            cols, rows;
+  int            cell_capacity;
+  bool           overflow;    /* links ran out; queries scan the rects */
+  bool           built;
+} civ_hit_grid_t;
+
+/* The grid the frame loop builds and routes */
+extern civ_hit_grid_t g_ui_hits;
+
+/* Start a frame's grid over a screen_w x screen_h screen */
+void civ_hit_grid_begin(civ_hit_grid_t *g, int screen_w, int screen_h);
+/* Add a rect owned by layer, on top of everything added so far */
+void civ_hit_grid_add(civ_hit_grid_t *g, const void *layer, int x, int y,
+                      int w, int h);
+/* Layer of the topmost rect containing (x, y); NULL when only the scene */
+const void *civ_hit_grid_query(const civ_hit_grid_t *g, int x, int y);
+/* Record the layer under the mouse on input for this frame's tests */
+void civ_hit_grid_route(const civ_hit_grid_t *g, civ_input_state_t *input);
+void civ_hit_grid_free(civ_hit_grid_t *g);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
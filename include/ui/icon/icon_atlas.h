@@ -105,6 +105,12 @@ void              civ_icon_atlas_destroy(civ_icon_atlas_t *atlas);
 bool              civ_icon_atlas_load_sdf(civ_icon_atlas_t *atlas,
                                           const char *filepath);
 
+/* Icons rendered between begin and end are queued and drawn by end in one
+ * geometry call, above anything drawn in between. Without a batch each
+ * icon draws at once. */
+void civ_icon_atlas_begin_batch(civ_icon_atlas_t *atlas);
+void civ_icon_atlas_end_batch(civ_icon_atlas_t *atlas, SDL_Renderer *r);
+
 void civ_icon_render(civ_icon_atlas_t *atlas, SDL_Renderer *r,
                      civ_icon_id_t icon_id, float x, float y, int size,
                      uint32_t color, uint8_t alpha);
@@ -10,6 +10,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -60,7 +61,30 @@ void civ_flex_next(civ_flex_layout_t *fl, float child_w, float child_h,
 int civ_flex_layout_row(civ_flex_layout_t *fl, float item_w, float item_h,
                         float **out_positions);
 
+/* Row layout kept across frames. The positions stay valid while the
+ * container, padding, gap, item size and generation match the last call;
+ * bump generation when the items themselves change. */
+#define CIV_FLEX_ROW_MAX 64
+
+typedef struct {
+  float    key[10];
+  uint32_t generation;
+  bool     valid;
+  int      count;
+  float    positions[CIV_FLEX_ROW_MAX * 2];
+} civ_flex_row_cache_t;
+
+/* Like civ_flex_layout_row, but the positions live in cache (x,y pairs).
+ * Recomputes only when the key changes; fl's cursor is left untouched. */
+int civ_flex_layout_row_cached(civ_flex_layout_t *fl,
+                               civ_flex_row_cache_t *cache, float item_w,
+                               float item_h, uint32_t generation,
+                               const float **out_positions);
+
 /* ── Grid layout ─────────────────────────────────────────────────────── */
+/* Grids wider or taller than this ignore col_widths/row_heights */
+#define CIV_GRID_TRACKS_MAX 16
+
 typedef struct {
   int columns, rows;
   float gap;
@@ -68,6 +92,15 @@ typedef struct {
   float container_x, container_y, container_w, container_h;
   float *col_widths;  /* optional per-column widths */
   float *row_heights; /* optional per-row heights */
+  /* Bump after editing col_widths/row_heights or repointing them */
+  uint32_t generation;
+  /* Internal: track offsets, valid while the key matches */
+  float    cache_key[9];
+  uint32_t cache_generation;
+  bool     cache_valid;
+  float    cell_w, cell_h;
+  float    col_x[CIV_GRID_TRACKS_MAX + 1]; /* offsets from the padding */
+  float    row_y[CIV_GRID_TRACKS_MAX + 1];
 } civ_grid_layout_t;
 
 void civ_grid_init(civ_grid_layout_t *gl, float x, float y, float w, float h,
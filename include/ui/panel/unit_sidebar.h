@@ -11,11 +11,14 @@
 extern "C" {
 #endif
 
-void civ_unit_sidebar_render(SDL_Renderer *r, civ_unit_t *unit, civ_font_t *font,
+/* The unit at index in um */
+void civ_unit_sidebar_render(SDL_Renderer *r, const civ_unit_manager_t *um,
+                             size_t index, civ_font_t *font,
                              civ_input_state_t *input);
 
 /* Returns button click type: 0=none, 1=found city */
-int civ_unit_sidebar_click(civ_unit_t *unit, civ_input_state_t *input);
+int civ_unit_sidebar_click(const civ_unit_manager_t *um, size_t index,
+                           civ_input_state_t *input);
 
 #ifdef __cplusplus
 }
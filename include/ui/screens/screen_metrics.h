@@ -0,0 +1,107 @@
+/**
+ * @file screen_metrics.h
+ * @brief Derived values and view models the screens show, published once
+ *        per sim tick
+ *
+ * Screens ask for a metric by id, or for a screen's view model, instead of
+ * walking live game structures each frame. After every tick the sim thread
+ * calls civ_screen_metrics_publish, which builds all of them on the worker
+ * pool into a back buffer — values, sorted lists and formatted labels —
+ * and then flips the front index. Drawing a screen is a lookup and a copy
+ * of strings that are already formatted.
+ *
+ * Readers hold the sim lock (the frame loop does), so a publish never runs
+ * under a reader. A read that finds nothing published for the current
+ * update, or follows an invalidate, publishes inline first.
+ */
+#ifndef CIV_UI_SCREEN_METRICS_H
+#define CIV_UI_SCREEN_METRICS_H
+
+#include "../../core/game.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CIV_METRIC_VALUES    6
+#define CIV_METRIC_LABEL_LEN 160
+
+/* X(id) — see screen_metrics.c for what each reads and how it reads out */
+#define CIV_SCREEN_METRICS(X) \
+  X(NATION_SUMMARY)   /* player nation, GDP, growth, unemployment, inflation */ \
+  X(MARKET_OVERVIEW)  /* mean inflation of the majors, instrument counts */      \
+  X(WALLET_SUMMARY)   /* wallet total in USD, currencies held */
+
+typedef enum {
+#define CIV_METRIC_ENUM(id) CIV_METRIC_##id,
+  CIV_SCREEN_METRICS(CIV_METRIC_ENUM)
+#undef CIV_METRIC_ENUM
+  CIV_METRIC_COUNT
+} civ_metric_id_t;
+
+/* ── View models ───────────────────────────────────────────────────── */
+
+#define CIV_VIEW_RESOURCES   5
+#define CIV_VIEW_STOCKS      8
+#define CIV_VIEW_COMMODITIES 12
+#define CIV_VIEW_CHANGES     3
+
+/* Nation detail panel for the watched nation */
+typedef struct {
+  bool found;
+  char name[64];
+  char iso_a2[3];
+  char lines[4][CIV_METRIC_LABEL_LEN];  /* capital, economy, labour, government */
+  char indices[CIV_METRIC_LABEL_LEN];
+  char resources[CIV_METRIC_LABEL_LEN]; /* "" without a resource map */
+  char resource_rows[CIV_VIEW_RESOURCES][CIV_METRIC_LABEL_LEN]; /* largest first */
+  int  resource_count;
+  bool no_resources;                    /* territory holds none */
+} civ_nation_view_t;
+
+/* Stock market and commodity board of the economy screen */
+typedef struct {
+  char  stocks[CIV_VIEW_STOCKS][CIV_METRIC_LABEL_LEN]; /* public firms */
+  int   stock_count;
+  char  commodity_name[CIV_VIEW_COMMODITIES][32];
+  float commodity_bar[CIV_VIEW_COMMODITIES];           /* price / highest price */
+  char  commodity_rows[CIV_VIEW_COMMODITIES][64];
+  int   commodity_count;
+} civ_market_view_t;
+
+/* Faction summary and recent changes of the politics screen */
+typedef struct {
+  char standing[CIV_METRIC_LABEL_LEN];  /* influence, party, approval */
+  bool has_factions;
+  char factions[CIV_METRIC_LABEL_LEN];
+  char changes[CIV_VIEW_CHANGES][CIV_METRIC_LABEL_LEN]; /* newest first */
+  int  change_count;
+} civ_politics_view_t;
+
+/* Value k of the metric (0 past its last one) */
+float civ_screen_metric(civ_game_t *g, civ_metric_id_t id, int k);
+
+/* The metric formatted for display; "" when it has nothing to show */
+const char *civ_screen_metric_label(civ_game_t *g, civ_metric_id_t id);
+
+/* Current view models; never NULL for a non-NULL game */
+const civ_nation_view_t   *civ_screen_nation_view(civ_game_t *g);
+const civ_market_view_t   *civ_screen_market_view(civ_game_t *g);
+const civ_politics_view_t *civ_screen_politics_view(civ_game_t *g);
+
+/* Nation the detail view is built for, by id ("" = none); a change
+   invalidates */
+void civ_screen_metrics_watch_nation(const char *nation_id);
+
+/* Build everything for g into the back buffer and flip it to the front.
+   Called from the sim thread's tick hook with the state lock held. */
+void civ_screen_metrics_publish(civ_game_t *g);
+
+/* Drop every metric; a screen that changes game state calls this so its
+   own metrics show the change before the next update */
+void civ_screen_metrics_invalidate(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
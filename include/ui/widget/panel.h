@@ -1,6 +1,12 @@
 /**
  * @file panel.h
  * @brief Draggable, closable, animated panel container widget
+ *
+ * A panel can keep its chrome and content in a texture: between
+ * civ_panel_begin_cached and civ_panel_end_cached the content is drawn in
+ * panel coordinates only when the panel or a child is dirty, and the
+ * texture is blitted every frame. Dragging and the open/close animation
+ * move and fade the blit without re-rendering.
  */
 #ifndef CIV_UI_WIDGET_PANEL_H
 #define CIV_UI_WIDGET_PANEL_H
@@ -29,6 +35,11 @@ typedef struct {
   bool dragging;
   float drag_offset_x;
   float drag_offset_y;
+  /* Retained content */
+  SDL_Texture *cache;
+  int cache_w, cache_h;
+  SDL_Texture *prev_target; /* restored by end_cached */
+  bool rendering;
 } civ_panel_t;
 
 civ_panel_t *civ_panel_create(const char *id, float x, float y, float w, float h,
@@ -46,6 +57,12 @@ void civ_panel_render(civ_panel_t *panel, SDL_Renderer *r);
 void civ_panel_render_chrome(civ_panel_t *panel, SDL_Renderer *r, int win_w,
                              int win_h);
 
+/* True when the cache must be redrawn: r then targets it, chrome drawn,
+ * with (0,0) at the panel's corner, for the caller to draw content. */
+bool civ_panel_begin_cached(civ_panel_t *panel, SDL_Renderer *r);
+/* Finish a redraw if one began, then blit the cache. Call every frame. */
+void civ_panel_end_cached(civ_panel_t *panel, SDL_Renderer *r);
+
 #ifdef __cplusplus
 }
 #endif
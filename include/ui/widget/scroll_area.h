@@ -4,6 +4,11 @@
  *
  * Renders content to an off-screen texture, then blits the visible
  * portion. Supports mouse wheel scrolling and scrollbar dragging.
+ *
+ * Long lists use the row mode instead: rows come from a callback and only
+ * the visible ones, plus a few either side, are drawn straight to the
+ * screen under a clip rect. No render target is created. Rows are a fixed
+ * height, or an estimate refined as each row is first shown.
  */
 #ifndef CIV_UI_WIDGET_SCROLL_AREA_H
 #define CIV_UI_WIDGET_SCROLL_AREA_H
@@ -16,9 +21,19 @@
 extern "C" {
 #endif
 
+/* Draw row in the screen rect (x, y, w, h) */
+typedef void (*civ_scroll_row_draw_fn)(SDL_Renderer *r, int row, float x,
+                                       float y, float w, float h,
+                                       void *user_data);
+/* Exact height of row, asked once when it first becomes visible */
+typedef float (*civ_scroll_row_height_fn)(int row, void *user_data);
+
+#define CIV_SCROLL_OVERSCAN 2 /* rows drawn beyond each edge */
+
 typedef struct civ_scroll_area {
   civ_widget_base_t base;
   SDL_Texture *content_tex;   /* off-screen render target */
+  int          tex_w, tex_h;  /* may exceed the content size */
   int          content_w, content_h; /* virtual content size */
   float        scroll_x, scroll_y;   /* scroll offset */
   float        target_scroll_x, target_scroll_y;
@@ -30,6 +45,16 @@ typedef struct civ_scroll_area {
   uint32_t     color_scrollbar;
   uint32_t     color_scrollbar_hover;
   bool         hover_scrollbar;
+
+  /* Row mode; row_count < 0 = texture mode */
+  int          row_count;
+  float        row_height;    /* fixed height, or the estimate */
+  civ_scroll_row_draw_fn   draw_row;
+  civ_scroll_row_height_fn measure_row; /* NULL = fixed height */
+  void        *row_user_data;
+  float       *row_top;       /* row_count + 1 offsets, measure_row only */
+  float       *row_heights;   /* measured heights, 0 = still the estimate */
+  int          row_capacity;
 } civ_scroll_area_t;
 
 civ_scroll_area_t *civ_scroll_area_create(const char *id, float x, float y,
@@ -44,7 +69,23 @@ void civ_scroll_area_set_content_size(civ_scroll_area_t *sa, int cw, int ch);
 SDL_Renderer *civ_scroll_area_begin(civ_scroll_area_t *sa, SDL_Renderer *main_r);
 void          civ_scroll_area_end(civ_scroll_area_t *sa, SDL_Renderer *main_r);
 
-/* Update + render as a widget (for overlay mode) */
+/* Switch to row mode with count rows of row_h (the estimate when measure
+ * is given). Scroll position is kept, clamped to the new length.
+ * Returns false without memory for the row offsets. */
+bool civ_scroll_area_set_rows(civ_scroll_area_t *sa, int count, float row_h,
+                              civ_scroll_row_draw_fn draw,
+                              civ_scroll_row_height_fn measure,
+                              void *user_data);
+/* Forget measured heights, e.g. after the rows' content changed */
+void civ_scroll_area_invalidate_rows(civ_scroll_area_t *sa);
+/* First visible row and the count to draw with overscan, for callers
+ * handling hits themselves; 0 outside row mode */
+int civ_scroll_area_visible_rows(const civ_scroll_area_t *sa, int *first);
+/* Row under a screen point, -1 if none */
+int civ_scroll_area_row_at(const civ_scroll_area_t *sa, float mx, float my);
+
+/* Update + render as a widget (for overlay mode); in row mode render draws
+ * the visible rows */
 void civ_scroll_area_update(civ_scroll_area_t *sa, civ_input_state_t *input,
                             float dt);
 void civ_scroll_area_render(civ_scroll_area_t *sa, SDL_Renderer *r);
@@ -50,12 +50,22 @@ typedef struct {
 
   /* Content buffer for formatting */
   char format_buf[512];
+
+  /* Measured size; builders bump generation only when a line changes, so
+   * a tooltip rebuilt each frame with the same text is measured once */
+  uint32_t    generation;
+  uint32_t    measured_generation;
+  int         measured_count;
+  civ_font_t *measured_font; /* font of the last render */
+  civ_font_t *font;          /* NULL until rendered: width is estimated */
+  float       measured_w;
+  bool        measured;
 } civ_tooltip_t;
 
 civ_tooltip_t *civ_tooltip_create(const char *id);
 void civ_tooltip_destroy(civ_tooltip_t *t);
 
-/* Clear all lines and reset */
+/* Clear all lines; re-adding the same lines keeps the measured size */
 void civ_tooltip_clear(civ_tooltip_t *t);
 
 /* Add formatted lines — returns t for chaining */
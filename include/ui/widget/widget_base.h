@@ -5,6 +5,11 @@
  * Widgets use a retained-mode system: each widget is a struct with a rect,
  * unique ID, and state. The input system's hot_id/active_id tracks focus.
  * Widgets register themselves each frame via civ_widget_begin/civ_widget_end.
+ *
+ * A widget that changes how it looks (state, value, text, tween) marks
+ * itself dirty, and the mark climbs to its ancestors. Containers that cache
+ * their content in a texture (panels) re-render only when dirty and blit
+ * the cache otherwise; moving a container does not dirty it.
  */
 #ifndef CIV_UI_WIDGET_BASE_H
 #define CIV_UI_WIDGET_BASE_H
@@ -50,6 +55,7 @@ typedef struct civ_widget_base {
   bool enabled;
   int z_index;
   civ_widget_state_t state;
+  bool dirty; /* looks different from the last cached render */
   struct civ_widget_base *parent;
   struct civ_widget_base **children;
   int child_count;
@@ -62,6 +68,13 @@ void civ_widget_init(civ_widget_base_t *widget, civ_widget_type_t type,
 void civ_widget_add_child(civ_widget_base_t *parent, civ_widget_base_t *child);
 void civ_widget_destroy_children(civ_widget_base_t *w);
 
+/* Mark w and its ancestors dirty */
+void civ_widget_invalidate(civ_widget_base_t *w);
+/* Clear dirty over w's subtree, after rendering it */
+void civ_widget_clean(civ_widget_base_t *w);
+/* Set state, dirtying w if it changed */
+void civ_widget_set_state(civ_widget_base_t *w, civ_widget_state_t state);
+
 civ_widget_state_t civ_widget_compute_state(civ_widget_base_t *w,
                                             civ_input_state_t *input,
                                             bool can_activate);
@@ -5,6 +5,11 @@
  * Manages a z-ordered stack of windows. Each window has a type, rect,
  * title bar (optional), and render callback. Input is routed to the
  * topmost window first.
+ *
+ * A retained window keeps its chrome and content in a texture and calls
+ * its render callback (at wx = wy = 0) only when invalidated: by its owner,
+ * by input it handles, or by the mouse moving over it. Otherwise a frame
+ * is one blit, and dragging only moves the blit.
  */
 #ifndef CIV_UI_WINDOW_MGR_H
 #define CIV_UI_WINDOW_MGR_H
@@ -51,6 +56,11 @@ typedef struct {
   civ_window_render_fn render;
   civ_window_input_fn  handle_input;
   void               *userdata;
+  /* Retained rendering */
+  bool                retained;
+  bool                dirty;
+  SDL_Texture        *cache;
+  int                 cache_w, cache_h;
 } civ_ui_window_t;
 
 typedef struct {
@@ -67,6 +77,13 @@ int  civ_window_mgr_add(civ_window_mgr_t *mgr, civ_window_type_t type,
                         civ_window_input_fn input_fn, void *userdata);
 void civ_window_mgr_remove(civ_window_mgr_t *mgr, int idx);
 void civ_window_mgr_show(civ_window_mgr_t *mgr, int idx, bool show);
+/* Free the retained windows' textures; call before the renderer goes */
+void civ_window_mgr_shutdown(civ_window_mgr_t *mgr);
+
+/* Cache the window's rendering until it is invalidated */
+void civ_window_mgr_set_retained(civ_window_mgr_t *mgr, int idx, bool retained);
+/* Re-render a retained window next frame */
+void civ_window_mgr_invalidate(civ_window_mgr_t *mgr, int idx);
 
 /* Process input for all visible windows (top-down). Returns true if handled. */
 bool civ_window_mgr_input(civ_window_mgr_t *mgr, civ_input_state_t *input);
@@ -0,0 +1,43 @@
+/**
+ * @file arena.h
+ * @brief Bump-pointer arena for short-lived allocations
+ *
+ * Pushes carve from the current chunk and are never freed one by one;
+ * the whole arena is reset at a boundary (a frame, a turn). When a period
+ * overflows into extra chunks, the next reset folds them into a single
+ * chunk large enough for it, so a steady-state period makes no heap calls.
+ * Under CIV_MEM_TAGS pushes count toward the current memory tag's churn.
+ */
+
+#ifndef CIVILIZATION_ARENA_H
+#define CIVILIZATION_ARENA_H
+
+#include "../common.h"
+#include "../types.h"
+
+#define CIV_ARENA_ALIGN 16
+
+typedef struct civ_arena_chunk civ_arena_chunk_t;
+
+typedef struct {
+    civ_arena_chunk_t* head;    /* chunk being filled; older ones behind it */
+    size_t chunk_size;          /* minimum bytes per new chunk */
+    size_t used;                /* bytes pushed since the last reset */
+    size_t peak;                /* largest used seen at a reset */
+    size_t capacity;            /* bytes across all chunks */
+} civ_arena_t;
+
+civ_arena_t* civ_arena_create(size_t chunk_size);
+void civ_arena_destroy(civ_arena_t* arena);
+
+/* size bytes aligned to CIV_ARENA_ALIGN, valid until the next reset;
+   NULL on a NULL arena or out of memory */
+void* civ_arena_push(civ_arena_t* arena, size_t size);
+void* civ_arena_push_zero(civ_arena_t* arena, size_t size);
+/* Invalidate everything pushed so far */
+void civ_arena_reset(civ_arena_t* arena);
+
+#define CIV_ARENA_PUSH_ARRAY(arena, type, count) \
+    ((type*)civ_arena_push(arena, sizeof(type) * (count)))
+
+#endif /* CIVILIZATION_ARENA_H */
@@ -1,6 +1,12 @@
 /**
  * @file cache.h
  * @brief Caching system for performance
+ *
+ * Entries live in a fixed array of max_entries, found through an
+ * open-addressing table keyed by an FNV-1a hash of the key and ordered
+ * by an intrusive most-recently-used list. Get, set and remove are O(1);
+ * when the entry count or the byte budget would be exceeded, entries are
+ * evicted from the least recently used end.
  */
 
 #ifndef CIVILIZATION_CACHE_H
@@ -9,24 +15,33 @@
 #include "../common.h"
 #include "../types.h"
 
+#define CIV_CACHE_NONE UINT32_MAX
+
 /* Cache entry */
 typedef struct civ_cache_entry {
     char key[STRING_SHORT_LEN];
+    uint32_t hash;
     void* data;
     size_t data_size;
     time_t timestamp;
     time_t expiry;
-    struct civ_cache_entry* next;
+    uint32_t prev, next;    /* recency list, most recent first; CIV_CACHE_NONE ends */
 } civ_cache_entry_t;
 
 /* Cache structure */
 typedef struct {
-    civ_cache_entry_t* entries;
+    civ_cache_entry_t* entries;     /* max_entries slots; unused ones chain through next */
+    uint32_t* slots;                /* entry index + 1; 0 = empty */
+    size_t slot_count;              /* power of two, at least 2 * max_entries */
+    uint32_t lru_head, lru_tail;    /* most and least recently used */
+    uint32_t free_head;
     size_t entry_count;
     size_t max_entries;
-    size_t max_size;
+    size_t max_size;                /* byte budget over all data */
     size_t current_size;
     time_t default_ttl;  /* Time to live in seconds */
+
+    uint64_t hits, misses, evictions;
 } civ_cache_t;
 
 /* Function declarations */
@@ -36,10 +51,26 @@ void civ_cache_init(civ_cache_t* cache, size_t max_entries, size_t max_size, tim
 
 civ_result_t civ_cache_set(civ_cache_t* cache, const char* key, const void* data, size_t data_size, time_t ttl);
 civ_result_t civ_cache_get(civ_cache_t* cache, const char* key, void* out, size_t* out_size);
+/* The stored bytes without copying, valid until the entry changes; NULL on a miss */
+const void* civ_cache_peek(civ_cache_t* cache, const char* key, size_t* out_size);
 void civ_cache_remove(civ_cache_t* cache, const char* key);
 void civ_cache_clear(civ_cache_t* cache);
 void civ_cache_cleanup_expired(civ_cache_t* cache);
 size_t civ_cache_get_size(const civ_cache_t* cache);
 
-#endif /* CIVILIZATION_CACHE_H */
+/* Memoization: a value of size bytes stored under key for one tick (a
+   turn, a day). get succeeds only for the tick it was put at. */
+bool civ_cache_memo_get(civ_cache_t* cache, const char* key, uint64_t tick, void* out, size_t size);
+civ_result_t civ_cache_memo_put(civ_cache_t* cache, const char* key, uint64_t tick, const void* value, size_t size);
 
+/* *out_ptr = the memoized value, running compute (an expression of
+   out_ptr's type) on a miss. Without a cache, compute always runs. */
+#define CIV_CACHE_MEMO(cache, key, tick, out_ptr, compute)                          \
+    do {                                                                            \
+        if (!civ_cache_memo_get(cache, key, tick, out_ptr, sizeof(*(out_ptr)))) {   \
+            *(out_ptr) = (compute);                                                 \
+            civ_cache_memo_put(cache, key, tick, out_ptr, sizeof(*(out_ptr)));      \
+        }                                                                           \
+    } while (0)
+
+#endif /* CIVILIZATION_CACHE_H */
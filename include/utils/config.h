@@ -1,6 +1,11 @@
 /**
  * @file config.h
  * @brief Configuration system
+ *
+ * Keys are found through an open-addressing hash. Code that reads a setting
+ * often resolves its key once to a handle, which stays valid for the life of
+ * the manager (entries are never removed), and reads it with an index load.
+ * Listeners hear about every value that changes, including through a reload.
  */
 
 #ifndef CIVILIZATION_CONFIG_H
@@ -21,6 +26,9 @@ typedef enum {
 typedef struct {
     char key[STRING_SHORT_LEN];
     civ_config_type_t type;
+    bool is_set;              /* false: resolved before any value arrived */
+    uint32_t hash;
+    uint32_t version;         /* bumped on each change */
     union {
         int32_t int_value;
         civ_float_t float_value;
@@ -29,11 +37,34 @@ typedef struct {
     } value;
 } civ_config_entry_t;
 
-/* Configuration manager */
+/* Index of an entry; resolve once, read many times */
+typedef int32_t civ_config_handle_t;
+#define CIV_CONFIG_HANDLE_INVALID (-1)
+
+struct civ_config_manager;
+typedef void (*civ_config_listener_fn_t)(struct civ_config_manager* cm,
+                                         civ_config_handle_t handle,
+                                         void* user_data);
+
 typedef struct {
+    civ_config_handle_t handle; /* CIV_CONFIG_HANDLE_INVALID = every key */
+    civ_config_listener_fn_t fn;
+    void* user_data;
+} civ_config_listener_t;
+
+/* Configuration manager */
+typedef struct civ_config_manager {
     civ_config_entry_t* entries;
     size_t entry_count;
     size_t entry_capacity;
+
+    /* Hash of entry index + 1 (0 = empty slot), power-of-two size */
+    uint32_t* slots;
+    size_t slot_count;
+
+    civ_config_listener_t* listeners;
+    size_t listener_count;
+    size_t listener_capacity;
 } civ_config_manager_t;
 
 /* Function declarations */
@@ -51,8 +82,59 @@ civ_result_t civ_config_get_float(const civ_config_manager_t* cm, const char* ke
 civ_result_t civ_config_get_bool(const civ_config_manager_t* cm, const char* key, bool* out);
 civ_result_t civ_config_get_string(const civ_config_manager_t* cm, const char* key, char* out, size_t out_size);
 
+/* Keys the file no longer has keep their values */
 civ_result_t civ_config_load_from_file(civ_config_manager_t* cm, const char* filename);
 civ_result_t civ_config_save_to_file(const civ_config_manager_t* cm, const char* filename);
 
+/* Handle for key, adding an unset entry when it is not there yet;
+   CIV_CONFIG_HANDLE_INVALID only when out of memory */
+civ_config_handle_t civ_config_resolve(civ_config_manager_t* cm, const char* key);
+
+/* Call fn when the entry behind handle changes; CIV_CONFIG_HANDLE_INVALID
+   listens to every key */
+civ_result_t civ_config_subscribe(civ_config_manager_t* cm, civ_config_handle_t handle,
+                                  civ_config_listener_fn_t fn, void* user_data);
+void civ_config_unsubscribe(civ_config_manager_t* cm, civ_config_listener_fn_t fn,
+                            void* user_data);
+
+/* Handle reads: the value, or fallback while the entry is unset or holds
+   another type (int and float convert into each other) */
+static inline const civ_config_entry_t* civ_config_entry(const civ_config_manager_t* cm,
+                                                         civ_config_handle_t h) {
+    if (!cm || h < 0 || (size_t)h >= cm->entry_count || !cm->entries[h].is_set)
+        return NULL;
+    return &cm->entries[h];
+}
+
+static inline int32_t civ_config_int(const civ_config_manager_t* cm, civ_config_handle_t h,
+                                     int32_t fallback) {
+    const civ_config_entry_t* e = civ_config_entry(cm, h);
+    if (!e) return fallback;
+    if (e->type == CIV_CONFIG_TYPE_INT) return e->value.int_value;
+    if (e->type == CIV_CONFIG_TYPE_FLOAT) return (int32_t)e->value.float_value;
+    return fallback;
+}
+
+static inline civ_float_t civ_config_float(const civ_config_manager_t* cm, civ_config_handle_t h,
+                                           civ_float_t fallback) {
+    const civ_config_entry_t* e = civ_config_entry(cm, h);
+    if (!e) return fallback;
+    if (e->type == CIV_CONFIG_TYPE_FLOAT) return e->value.float_value;
+    if (e->type == CIV_CONFIG_TYPE_INT) return (civ_float_t)e->value.int_value;
+    return fallback;
+}
+
+static inline bool civ_config_bool(const civ_config_manager_t* cm, civ_config_handle_t h,
+                                   bool fallback) {
+    const civ_config_entry_t* e = civ_config_entry(cm, h);
+    return e && e->type == CIV_CONFIG_TYPE_BOOL ? e->value.bool_value : fallback;
+}
+
+static inline const char* civ_config_string(const civ_config_manager_t* cm, civ_config_handle_t h,
+                                            const char* fallback) {
+    const civ_config_entry_t* e = civ_config_entry(cm, h);
+    return e && e->type == CIV_CONFIG_TYPE_STRING ? e->value.string_value : fallback;
+}
+
 #endif /* CIVILIZATION_CONFIG_H */
 
@@ -0,0 +1,118 @@
+/**
+ * @file frame_trace.h
+ * @brief Rolling per-frame record with automatic hitch dumps
+ *
+ * Anything that does work worth seeing in a stall — sim ticks, system
+ * phases, render passes, draw calls, texture creation, file writes, event
+ * dispatch — bumps a frame counter, from any thread. At the end of every
+ * main-loop iteration civ_frame_trace_end_frame takes the counters with the
+ * frame's timings into a fixed ring of CIV_FRAME_TRACE_FRAMES records.
+ *
+ * A frame whose work (iteration time before the pacer's wait) runs past
+ * the threshold is a hitch. CIV_FRAME_TRACE_AFTER frames later, the
+ * CIV_FRAME_TRACE_BEFORE frames in front of it, the hitch and what followed
+ * are written as CSV to hitches/, so a stall reported from the field comes
+ * with the frames around it. Further hitches inside that window join the
+ * same file.
+ */
+
+#ifndef CIVILIZATION_FRAME_TRACE_H
+#define CIVILIZATION_FRAME_TRACE_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CIV_FRAME_TRACE_FRAMES       512  /**< Records kept */
+#define CIV_FRAME_TRACE_BEFORE       120  /**< Frames written ahead of a hitch */
+#define CIV_FRAME_TRACE_AFTER        30   /**< Frames written after it */
+#define CIV_FRAME_TRACE_MAX_DUMPS    16   /**< Files written per session */
+#define CIV_FRAME_TRACE_DEFAULT_MS   100.0
+#define CIV_FRAME_TRACE_DIR          "hitches"
+
+/* X(id, column) */
+#define CIV_FRAME_COUNTERS(X)                                                  \
+  X(SIM_TICKS,         "sim_ticks")     /* simulation ticks completed */     \
+  X(SIM_PHASES,        "sim_phases")    /* system nodes that ran */          \
+  X(RENDER_PASSES,     "render_passes")                                        \
+  X(DRAW_CALLS,        "draw_calls")    /* batched geometry submissions */   \
+  X(TEXTURES_CREATED,  "textures")                                             \
+  X(BYTES_WRITTEN,     "bytes_written") /* saves, journal, command log */    \
+  X(EVENTS_DISPATCHED, "events")        /* OS events and game events */
+
+typedef enum {
+#define CIV_FRAME_COUNTER_ENUM(id, column) CIV_FRAME_##id,
+  CIV_FRAME_COUNTERS(CIV_FRAME_COUNTER_ENUM)
+#undef CIV_FRAME_COUNTER_ENUM
+  CIV_FRAME_COUNTER_COUNT
+} civ_frame_counter_t;
+
+/**
+ * One main-loop iteration
+ */
+typedef struct {
+  uint64_t frame;
+  Uint64 start_ns;        /**< SDL_GetTicksNS() at the top of the loop */
+  float interval_ms;      /**< Since the previous iteration began */
+  float work_ms;          /**< Until the pacer's wait */
+  bool presented;
+  uint32_t counters[CIV_FRAME_COUNTER_COUNT];
+} civ_frame_record_t;
+
+/**
+ * Reset the ring and the counters
+ * @param threshold_ms Work time that makes a hitch (<= 0 disables dumps)
+ */
+void civ_frame_trace_init(double threshold_ms);
+
+/**
+ * Add n to a counter of the frame in progress; safe from any thread
+ */
+void civ_frame_trace_count(civ_frame_counter_t counter, uint64_t n);
+
+/**
+ * Close the iteration: record it, and write a dump if one is due
+ * @param start_ns Value the loop read at its top
+ * @param interval_ns Time since the previous iteration began
+ * @param presented True if the iteration drew a frame
+ */
+void civ_frame_trace_end_frame(Uint64 start_ns, Uint64 interval_ns,
+                               bool presented);
+
+/**
+ * Copy up to max most recent records, oldest first
+ * @return Records copied
+ */
+size_t civ_frame_trace_get(civ_frame_record_t *out, size_t max);
+
+/**
+ * Write a dump still waiting for its trailing frames
+ */
+void civ_frame_trace_shutdown(void);
+
+/* Texture creation, counted */
+static inline SDL_Texture *civ_create_texture(SDL_Renderer *renderer,
+                                              SDL_PixelFormat format,
+                                              SDL_TextureAccess access, int w,
+                                              int h) {
+  SDL_Texture *t = SDL_CreateTexture(renderer, format, access, w, h);
+  if (t) civ_frame_trace_count(CIV_FRAME_TEXTURES_CREATED, 1);
+  return t;
+}
+
+static inline SDL_Texture *civ_create_texture_from_surface(
+    SDL_Renderer *renderer, SDL_Surface *surface) {
+  SDL_Texture *t = SDL_CreateTextureFromSurface(renderer, surface);
+  if (t) civ_frame_trace_count(CIV_FRAME_TEXTURES_CREATED, 1);
+  return t;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CIVILIZATION_FRAME_TRACE_H */
@@ -0,0 +1,96 @@
+/**
+ * @file io_service.h
+ * @brief One background thread for file writes the sim and main threads make
+ *
+ * A write names a file, where in it the bytes go (appended, replacing the
+ * file, or at an offset), hands over a CIV_MALLOC buffer and optionally a
+ * completion callback. It is queued under its priority and the caller moves
+ * on; the service thread writes it and frees the buffer. Saves go ahead of
+ * journal appends, which go ahead of telemetry (hitch dumps, timelines).
+ * Each pass takes everything queued at the highest priority waiting, and
+ * consecutive writes to one file within it share one open and close.
+ *
+ * Writes to one file at one priority land in submission order; the service
+ * does not order writes across priorities. Callbacks run on the service
+ * thread and must not block on it.
+ *
+ * Before civ_io_service_start and after civ_io_service_stop writes run on
+ * the calling thread and call back before civ_io_write returns. The journal
+ * sink and the save worker keep their own threads: they stream, sync and
+ * report progress in ways a single buffer write does not.
+ */
+
+#ifndef CIVILIZATION_IO_SERVICE_H
+#define CIVILIZATION_IO_SERVICE_H
+
+#include "common.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CIV_IO_APPEND  (-1) /**< Offset: after the end, creating the file */
+#define CIV_IO_REPLACE (-2) /**< Offset: the bytes become the whole file */
+
+typedef enum {
+  CIV_IO_SAVE,      /**< Saves the player asked for, keyframes */
+  CIV_IO_JOURNAL,   /**< Command log and other append-only history */
+  CIV_IO_TELEMETRY, /**< Hitch dumps, timelines, reports */
+  CIV_IO_PRIORITY_COUNT
+} civ_io_priority_t;
+
+/* Runs on the service thread once the write finished or failed */
+typedef void (*civ_io_done_fn_t)(civ_result_t result, void *user);
+
+typedef struct {
+  uint64_t writes;     /**< Completed, failed ones included */
+  uint64_t failures;
+  uint64_t bytes;
+  uint64_t coalesced;  /**< Writes that reused the previous one's open file */
+  uint64_t queued;     /**< Waiting right now */
+} civ_io_stats_t;
+
+/**
+ * Start the service thread
+ * @return False when it could not start (writes stay on the caller)
+ */
+bool civ_io_service_start(void);
+
+/**
+ * Write everything queued, then stop; later writes run on the caller
+ */
+void civ_io_service_stop(void);
+
+/**
+ * Block until every write queued before the call has finished
+ */
+void civ_io_service_flush(void);
+
+/**
+ * Queue a write
+ * @param offset Byte offset, CIV_IO_APPEND or CIV_IO_REPLACE
+ * @param data CIV_MALLOC buffer the service frees; taken even on failure
+ * @param done Optional completion callback
+ */
+civ_result_t civ_io_write(const char *path, int64_t offset, void *data,
+                          size_t size, civ_io_priority_t priority,
+                          civ_io_done_fn_t done, void *user);
+
+/**
+ * civ_io_write of a copy of data; the caller keeps its buffer
+ */
+civ_result_t civ_io_write_copy(const char *path, int64_t offset,
+                               const void *data, size_t size,
+                               civ_io_priority_t priority,
+                               civ_io_done_fn_t done, void *user);
+
+void civ_io_service_stats(civ_io_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CIVILIZATION_IO_SERVICE_H */
@@ -0,0 +1,107 @@
+/**
+ * @file logger.h
+ * @brief Filtered, rate-limited civ_log lines written off the calling thread
+ *
+ * Every civ_log call site resolves its subsystem from its source path once
+ * (src/core/ai/... logs as "ai") and checks that subsystem's level before
+ * anything is formatted, so a filtered line costs a compare. A line that
+ * passes is formatted into the calling thread's buffer and pushed as one
+ * record (time, thread, level, subsystem, text) onto a bounded lock-free
+ * ring; the writer thread drains it to stderr in batches. Nothing on the
+ * logging thread takes a lock or touches stdio.
+ *
+ * Each thread lets through CIV_LOG_BURST lines from one call site per
+ * CIV_LOG_WINDOW_MS and counts the rest, which it reports with the site's
+ * next line after the window. When the ring is full a line is dropped and
+ * counted rather than waited for; the writer reports the count.
+ *
+ * Before civ_logger_start and after civ_logger_stop lines are written
+ * directly. FATAL lines always are, after the ring drains, since an abort
+ * usually follows them.
+ */
+
+#ifndef CIVILIZATION_LOGGER_H
+#define CIVILIZATION_LOGGER_H
+
+#include "common.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CIV_LOG_LINE_MAX  256  /**< Text per record, truncated past it */
+#define CIV_LOG_RING      1024 /**< Records in flight; power of two */
+#define CIV_LOG_BURST     20   /**< Lines per site per window per thread */
+#define CIV_LOG_WINDOW_MS 1000
+
+/* X(id, name, path) — the first path fragment in __FILE__ that matches */
+#define CIV_LOG_SUBSYSTEMS(X)                                                  \
+  X(GENERAL,     "general",     NULL)                                          \
+  X(AI,          "ai",          "/ai/")                                        \
+  X(ECONOMY,     "economy",     "/economy/")                                   \
+  X(WORLD,       "world",       "/world/")                                     \
+  X(ENVIRONMENT, "environment", "/environment/")                               \
+  X(GOVERNANCE,  "governance",  "/governance/")                                \
+  X(DIPLOMACY,   "diplomacy",   "/diplomacy/")                                 \
+  X(POLITICS,    "politics",    "/politics/")                                  \
+  X(POPULATION,  "population",  "/population/")                                \
+  X(CULTURE,     "culture",     "/culture/")                                   \
+  X(MILITARY,    "military",    "/military/")                                  \
+  X(EVENTS,      "events",      "/events/")                                    \
+  X(SIM,         "sim",         "/simulation_engine/")                         \
+  X(UTILS,       "utils",       "/utils/")                                     \
+  X(ENGINE,      "engine",      "/engine/")                                    \
+  X(UI,          "ui",          "/ui/")
+
+typedef enum {
+#define CIV_LOG_SUBSYSTEM_ENUM(id, name, path) CIV_LOG_SUB_##id,
+  CIV_LOG_SUBSYSTEMS(CIV_LOG_SUBSYSTEM_ENUM)
+#undef CIV_LOG_SUBSYSTEM_ENUM
+  CIV_LOG_SUB_COUNT
+} civ_log_subsystem_t;
+
+/** Above FATAL: the subsystem logs nothing */
+#define CIV_LOG_OFF (CIV_LOG_FATAL + 1)
+
+/**
+ * Start the writer thread; lines queue from here on
+ * @return False when the thread could not start (lines stay direct)
+ */
+bool civ_logger_start(void);
+
+/**
+ * Drain the ring and stop the writer; later lines are written directly
+ */
+void civ_logger_stop(void);
+
+/**
+ * Wait until every queued line is written
+ */
+void civ_logger_flush(void);
+
+/**
+ * Lowest level a subsystem logs (CIV_LOG_OFF silences it)
+ */
+void civ_logger_set_level(civ_log_subsystem_t subsystem, int level);
+
+/**
+ * Apply a comma-separated filter: "warning" sets every subsystem,
+ * "ai=debug,events=off" one each, applied left to right
+ * @return False on an unknown subsystem or level (the rest still apply)
+ */
+bool civ_logger_configure(const char *spec);
+
+/**
+ * Lines lost to a full ring and held back by the rate limit so far
+ */
+void civ_logger_stats(uint64_t *dropped, uint64_t *suppressed);
+
+const char *civ_log_subsystem_name(civ_log_subsystem_t subsystem);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CIVILIZATION_LOGGER_H */
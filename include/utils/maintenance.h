@@ -0,0 +1,95 @@
+/**
+ * @file maintenance.h
+ * @brief Low-priority background thread for compacting stores that grow
+ *        over a long session
+ *
+ * A store registers a step that does one bounded slice of its upkeep
+ * (downsampling, merging, rebuilding an index) and reports the bytes it went
+ * through. The thread wakes every CIV_MAINTENANCE_PERIOD_MS, or when kicked,
+ * and calls the steps round robin until the pass has gone through
+ * CIV_MAINTENANCE_PASS_BYTES, run CIV_MAINTENANCE_PASS_MS, or found every
+ * store with nothing left to do.
+ *
+ * A step builds its replacement off to the side and publishes it with an
+ * atomic pointer swap, so readers never wait on the thread. What it
+ * replaced stays readable until the store frees it from its own thread.
+ *
+ * Before civ_maintenance_start and after civ_maintenance_stop nothing runs
+ * unless the caller runs a pass itself.
+ */
+
+#ifndef CIVILIZATION_MAINTENANCE_H
+#define CIVILIZATION_MAINTENANCE_H
+
+#include "common.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CIV_MAINTENANCE_PERIOD_MS  250
+#define CIV_MAINTENANCE_PASS_MS    4
+#define CIV_MAINTENANCE_PASS_BYTES (1u << 20)
+#define CIV_MAINTENANCE_MAX_TASKS  16
+
+/* What is left of the pass when a step is called */
+typedef struct {
+  size_t   bytes;        /**< Work the step may still do */
+  uint64_t deadline_ns;  /**< SDL_GetTicksNS() to stop by */
+} civ_maintenance_budget_t;
+
+/* Do up to budget->bytes of upkeep, checking the deadline between units;
+   return the bytes gone through, 0 when nothing is left */
+typedef size_t (*civ_maintenance_step_fn_t)(
+    void *user, const civ_maintenance_budget_t *budget);
+
+typedef struct {
+  uint64_t passes;
+  uint64_t steps;
+  uint64_t bytes;
+  uint64_t busy_ns;      /**< Time spent inside steps */
+} civ_maintenance_stats_t;
+
+/**
+ * Start the thread at low priority
+ * @return False when it could not start (passes stay on the caller)
+ */
+bool civ_maintenance_start(void);
+
+/**
+ * Finish the pass in progress, then stop
+ */
+void civ_maintenance_stop(void);
+
+/**
+ * Add a step; it runs from the thread's next pass on
+ * @return Handle for civ_maintenance_unregister, -1 when full
+ */
+int civ_maintenance_register(const char *name, civ_maintenance_step_fn_t fn,
+                             void *user);
+
+/**
+ * Remove a step, waiting out a call to it in progress; afterwards its user
+ * data may be freed
+ */
+void civ_maintenance_unregister(int handle);
+
+/* Wake the thread for a pass now */
+void civ_maintenance_kick(void);
+
+/**
+ * One pass on the calling thread, when the service thread is not running
+ * @return Bytes gone through
+ */
+size_t civ_maintenance_run_pass(void);
+
+void civ_maintenance_stats(civ_maintenance_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CIVILIZATION_MAINTENANCE_H */
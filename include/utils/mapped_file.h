@@ -0,0 +1,117 @@
+/**
+ * @file mapped_file.h
+ * @brief Read-only file views for the binary world data loaders
+ *
+ * civ_mapped_file_open maps a whole file (mmap on POSIX, MapViewOfFile on
+ * Windows) so loaders can point straight at on-disk arrays instead of
+ * copying them. Where mapping is unavailable or fails the file is read
+ * into one heap buffer instead; callers see the same const view either way.
+ *
+ * civ_byte_reader_t walks a view with bounds checks. A read past the end
+ * returns zero and clears ok, so a loader can parse a whole record and
+ * test ok once instead of checking every field.
+ *
+ * All multi-byte fields are little-endian, as written by tools/.
+ */
+#ifndef CIVILIZATION_MAPPED_FILE_H
+#define CIVILIZATION_MAPPED_FILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    const uint8_t *data;
+    size_t         size;
+    bool           mapped;   /* false = heap copy */
+    void          *handle;   /* Windows mapping object */
+} civ_mapped_file_t;
+
+/* Open path read-only; false if it cannot be opened or read.
+   Empty files open successfully with data == NULL. The whole mapping is
+   prefetched, for loaders that read it front to back. */
+bool civ_mapped_file_open(civ_mapped_file_t *mf, const char *path);
+/* The same without the prefetch, for files read a part at a time */
+bool civ_mapped_file_open_lazy(civ_mapped_file_t *mf, const char *path);
+/* Ask for the pages under [data, data + size) of a mapped view ahead of
+   their first read; a no-op for a heap copy */
+void civ_mapped_file_prefetch(const civ_mapped_file_t *mf, const uint8_t *data,
+                              size_t size);
+
+/* Unmap or free; safe on a zeroed or already-closed file */
+void civ_mapped_file_close(civ_mapped_file_t *mf);
+
+/* ── Bounds-checked cursor ────────────────────────────────────────── */
+typedef struct {
+    const uint8_t *pos;
+    const uint8_t *end;
+    bool           ok;
+} civ_byte_reader_t;
+
+static inline civ_byte_reader_t civ_byte_reader_span(const uint8_t *data,
+                                                     size_t size) {
+    civ_byte_reader_t r = {data, data + size, data != NULL || size == 0};
+    return r;
+}
+
+static inline civ_byte_reader_t civ_byte_reader(const civ_mapped_file_t *mf) {
+    return civ_byte_reader_span(mf->data, mf->size);
+}
+
+static inline size_t civ_byte_reader_left(const civ_byte_reader_t *r) {
+    return r->ok ? (size_t)(r->end - r->pos) : 0;
+}
+
+/* Pointer to the next n bytes and advance past them; NULL if short */
+static inline const uint8_t *civ_byte_reader_take(civ_byte_reader_t *r, size_t n) {
+    if (civ_byte_reader_left(r) < n) {
+        r->ok = false;
+        return NULL;
+    }
+    const uint8_t *p = r->pos;
+    r->pos += n;
+    return p;
+}
+
+static inline uint8_t civ_byte_reader_u8(civ_byte_reader_t *r) {
+    const uint8_t *p = civ_byte_reader_take(r, 1);
+    return p ? p[0] : 0;
+}
+
+static inline uint16_t civ_byte_reader_u16(civ_byte_reader_t *r) {
+    const uint8_t *p = civ_byte_reader_take(r, 2);
+    return p ? (uint16_t)(p[0] | p[1] << 8) : 0;
+}
+
+static inline uint32_t civ_byte_reader_u32(civ_byte_reader_t *r) {
+    const uint8_t *p = civ_byte_reader_take(r, 4);
+    return p ? (uint32_t)p[0] | (uint32_t)p[1] << 8 |
+               (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24
+             : 0;
+}
+
+static inline float civ_byte_reader_f32(civ_byte_reader_t *r) {
+    uint32_t bits = civ_byte_reader_u32(r);
+    float v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+/* Copy a len-byte string into out (truncated to out_size - 1) */
+static inline void civ_byte_reader_str(civ_byte_reader_t *r, size_t len,
+                                       char *out, size_t out_size) {
+    const uint8_t *p = civ_byte_reader_take(r, len);
+    size_t n = p ? (len < out_size ? len : out_size - 1) : 0;
+    if (n) memcpy(out, p, n);
+    out[n] = '\0';
+}
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,128 @@
+/**
+ * @file mem_tags.h
+ * @brief Tagged allocation accounting behind CIV_MALLOC and the pools
+ *
+ * Built with CIV_MEM_TAGS (make MEM_TAGS=1), CIV_MALLOC, CIV_CALLOC,
+ * CIV_REALLOC and CIV_FREE charge every block to the calling thread's
+ * current tag. Code that owns a subsystem brackets its work with
+ * CIV_MEM_TAG_BEGIN/END: load stages, system nodes and the turn phases
+ * do, and parallel_for hands the caller's tag to its helpers. A table
+ * keyed by address remembers each block's size and tag, so a free on
+ * another thread or under another tag still credits the tag that
+ * allocated it, and pointers that never went through CIV_MALLOC (strdup,
+ * plain malloc) pass straight to libc uncounted.
+ *
+ * Blocks handed out by memory pools and bytes pushed onto arenas are
+ * counted under the same tags, apart from the heap their slabs and chunks
+ * take, so heap held against pooled bytes in use shows fragmentation and
+ * pushes per turn show churn.
+ *
+ * Without CIV_MEM_TAGS the macros are libc and the scope calls compile
+ * away; the stats calls report nothing.
+ */
+
+#ifndef CIVILIZATION_MEM_TAGS_H
+#define CIVILIZATION_MEM_TAGS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* X(id, name) */
+#define CIV_MEM_TAG_LIST(X)                                                    \
+  X(GENERAL,    "general")    /* anything not under a scope */               \
+  X(WORLD,      "world")      /* map, tile planes, borders, resources */     \
+  X(NATIONS,    "nations")    /* nation manager and nation data */           \
+  X(GOVERNANCE, "governance") /* governments, politics, diplomacy */         \
+  X(ECONOMY,    "economy")    /* economies, markets, trade */                \
+  X(SOCIETY,    "society")    /* population, culture, religion, NPCs */      \
+  X(MILITARY,   "military")   /* units, conquest, war economy */             \
+  X(AI,         "ai")                                                          \
+  X(EVENTS,     "events")     /* event manager and its log */                \
+  X(HISTORY,    "history")    /* history DB, price history, journal */       \
+  X(SAVE,       "save")       /* snapshots and save writers */               \
+  X(UI,         "ui")
+
+typedef enum {
+#define CIV_MEM_TAG_ENUM(id, name) CIV_MEM_TAG_##id,
+  CIV_MEM_TAG_LIST(CIV_MEM_TAG_ENUM)
+#undef CIV_MEM_TAG_ENUM
+  CIV_MEM_TAG_COUNT
+} civ_mem_tag_t;
+
+typedef struct {
+  /* CIV_MALLOC heap */
+  size_t   live_bytes;
+  size_t   peak_bytes;
+  uint64_t allocations;      /* includes reallocs that moved or grew */
+  uint64_t frees;
+  uint64_t turn_allocations; /* during the last completed turn */
+  size_t   turn_bytes;       /* bytes allocated during that turn */
+  double   allocations_per_turn; /* mean over every completed turn */
+
+  /* Pool blocks and arena pushes */
+  size_t   pool_live_bytes;
+  size_t   pool_peak_bytes;
+  uint64_t pool_allocations;
+  size_t   arena_turn_bytes; /* pushed during the last completed turn */
+  uint64_t arena_pushes;
+} civ_mem_tag_stats_t;
+
+#ifdef CIV_MEM_TAGS
+
+/* Make tag current on this thread; returns the one it replaces */
+civ_mem_tag_t civ_mem_tag_push(civ_mem_tag_t tag);
+void civ_mem_tag_pop(civ_mem_tag_t previous);
+civ_mem_tag_t civ_mem_tag_current(void);
+
+void *civ_mem_alloc(size_t size);
+void *civ_mem_calloc(size_t count, size_t size);
+void *civ_mem_realloc(void *ptr, size_t size);
+void civ_mem_free(void *ptr);
+
+/* A pool block of size bytes was handed out (true) or returned under tag */
+void civ_mem_note_pool(civ_mem_tag_t tag, size_t size, bool allocated);
+/* An arena push of size bytes under the current tag */
+void civ_mem_note_arena(size_t size);
+
+#else
+
+static inline civ_mem_tag_t civ_mem_tag_push(civ_mem_tag_t tag) {
+  (void)tag;
+  return CIV_MEM_TAG_GENERAL;
+}
+static inline void civ_mem_tag_pop(civ_mem_tag_t previous) { (void)previous; }
+static inline civ_mem_tag_t civ_mem_tag_current(void) {
+  return CIV_MEM_TAG_GENERAL;
+}
+static inline void civ_mem_note_pool(civ_mem_tag_t tag, size_t size,
+                                     bool allocated) {
+  (void)tag;
+  (void)size;
+  (void)allocated;
+}
+static inline void civ_mem_note_arena(size_t size) { (void)size; }
+
+#endif /* CIV_MEM_TAGS */
+
+/* Work under tag until the matching END; scopes nest */
+#define CIV_MEM_TAG_BEGIN(saved, tag) civ_mem_tag_t saved = civ_mem_tag_push(tag)
+#define CIV_MEM_TAG_END(saved) civ_mem_tag_pop(saved)
+
+/* False when built without CIV_MEM_TAGS */
+bool civ_mem_tags_enabled(void);
+const char *civ_mem_tag_name(civ_mem_tag_t tag);
+/* Counters of one tag; false when disabled or out of range */
+bool civ_mem_tags_get(civ_mem_tag_t tag, civ_mem_tag_stats_t *out);
+/* CIV_MALLOC blocks and bytes the calling thread has ever allocated, under
+   any tag; false (zeros) when disabled */
+bool civ_mem_tags_thread_totals(uint64_t *allocations, uint64_t *bytes);
+/* Start the per-turn window here without closing a turn (after a load) */
+void civ_mem_tags_mark(void);
+/* Close the turn: roll the per-turn counters and the rate */
+void civ_mem_tags_end_turn(void);
+/* One row per tag plus totals; nothing when disabled */
+void civ_mem_tags_dump(FILE *out);
+
+#endif /* CIVILIZATION_MEM_TAGS_H */
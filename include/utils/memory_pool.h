@@ -1,6 +1,19 @@
 /**
  * @file memory_pool.h
  * @brief Memory pool allocator for performance
+ *
+ * Requests are rounded up to a power-of-two size class (16 bytes up to the
+ * manager's block size). Each class carves slabs into blocks and keeps the
+ * free ones on an intrusive list, so allocate and free are both O(1). Each
+ * block starts with a small header naming its class, which is how free
+ * finds the owning pool. Larger requests go to the heap with the same header.
+ *
+ * The manager is safe to share between threads behind its lock. A worker
+ * that allocates a lot can keep a civ_memory_pool_cache_t, which moves
+ * blocks to and from the manager in batches and is lock-free in between.
+ *
+ * Under CIV_MEM_TAGS a block also records the memory tag it was handed out
+ * under, and is counted there until it comes back.
  */
 
 #ifndef CIVILIZATION_MEMORY_POOL_H
@@ -9,34 +22,75 @@
 #include "../common.h"
 #include "../types.h"
 
-/* Memory pool structure */
-typedef struct civ_memory_pool {
-    void* memory;
+#define CIV_POOL_MIN_BLOCK   16
+#define CIV_POOL_CLASS_MAX   12  /* 16 B .. 32 KiB */
+#define CIV_POOL_CACHE_BATCH 32  /* blocks a cache moves per refill/spill */
+
+/* Per-class counters; blocks held by caches count as in use */
+typedef struct {
     size_t block_size;
-    size_t block_count;
-    size_t free_count;
-    bool* used_blocks;
-    struct civ_memory_pool* next;
+    size_t slab_count;
+    size_t block_count;     /* blocks across all slabs */
+    size_t in_use;
+    size_t peak_in_use;
+    uint64_t allocations;
+    uint64_t frees;
+} civ_memory_pool_stats_t;
+
+typedef struct civ_memory_slab civ_memory_slab_t;
+
+/* One size class */
+typedef struct civ_memory_pool {
+    size_t block_size;      /* payload bytes per block */
+    size_t slab_blocks;     /* blocks carved per new slab */
+    void* free_list;        /* first free block's payload; next in its first word */
+    civ_memory_slab_t* slabs;
+    civ_memory_pool_stats_t stats;
 } civ_memory_pool_t;
 
 /* Memory pool manager */
 typedef struct {
-    civ_memory_pool_t* pools;
-    size_t pool_count;
-    size_t default_block_size;
-    size_t default_block_count;
+    civ_memory_pool_t pools[CIV_POOL_CLASS_MAX];
+    size_t pool_count;              /* classes in use */
+    size_t default_block_size;      /* largest pooled request */
+    size_t default_block_count;     /* minimum blocks per slab */
+    void* lock;                     /* SDL_Mutex; NULL = single-threaded */
+
+    /* Requests above default_block_size */
+    uint64_t large_allocations;
+    size_t large_in_use;
 } civ_memory_pool_manager_t;
 
+/* Lock-free front for one thread; blocks may be freed through either */
+typedef struct {
+    civ_memory_pool_manager_t* manager;
+    void* free_list[CIV_POOL_CLASS_MAX];
+    uint32_t count[CIV_POOL_CLASS_MAX];
+} civ_memory_pool_cache_t;
+
 /* Function declarations */
 civ_memory_pool_manager_t* civ_memory_pool_manager_create(size_t default_block_size, size_t default_block_count);
+/* Blocks still allocated from it become invalid */
 void civ_memory_pool_manager_destroy(civ_memory_pool_manager_t* manager);
 void* civ_memory_pool_allocate(civ_memory_pool_manager_t* manager, size_t size);
+/* ptr must come from this manager (directly or through a cache) */
 void civ_memory_pool_free(civ_memory_pool_manager_t* manager, void* ptr);
+/* Return every pooled block to its free list at once; caches must be
+   flushed first and large allocations are left alone */
 void civ_memory_pool_reset(civ_memory_pool_manager_t* manager);
 
+/* Counters of the class serving size; false for sizes past the largest */
+bool civ_memory_pool_get_stats(const civ_memory_pool_manager_t* manager, size_t size,
+                               civ_memory_pool_stats_t* out);
+
+void civ_memory_pool_cache_init(civ_memory_pool_cache_t* cache, civ_memory_pool_manager_t* manager);
+void* civ_memory_pool_cache_allocate(civ_memory_pool_cache_t* cache, size_t size);
+void civ_memory_pool_cache_free(civ_memory_pool_cache_t* cache, void* ptr);
+/* Hand every cached block back to the manager */
+void civ_memory_pool_cache_flush(civ_memory_pool_cache_t* cache);
+
 /* Convenience macros */
 #define CIV_POOL_ALLOC(manager, type) ((type*)civ_memory_pool_allocate(manager, sizeof(type)))
 #define CIV_POOL_ALLOC_ARRAY(manager, type, count) ((type*)civ_memory_pool_allocate(manager, sizeof(type) * (count)))
 
 #endif /* CIVILIZATION_MEMORY_POOL_H */
-
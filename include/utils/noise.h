@@ -33,4 +33,30 @@ civ_float_t civ_noise_octave3d(civ_float_t x, civ_float_t y, civ_float_t z,
                                int octaves, civ_float_t persistence,
                                civ_float_t scale, uint32_t seed);
 
+/* ── Row batches ──────────────────────────────────────────────────────────
+ * Evaluate n samples at (x0 + i * dx, y) in float. Lattice coordinates are
+ * wrapped to the 256-period of the permutation table in double once per
+ * 8-sample chunk, so precision does not degrade along long rows. Results
+ * match the scalar double functions to float precision. Uses AVX2, SSE2 or
+ * NEON when the build targets them, else a scalar loop.
+ */
+
+/**
+ * @brief 2D Perlin noise along a row, out[i] in roughly [-1, 1]
+ */
+void civ_noise_perlin_row(double x0, double dx, double y, int n, uint32_t seed,
+                          float *out);
+
+/**
+ * @brief Octave Perlin noise along a row, same mapping as civ_noise_octave
+ */
+void civ_noise_octave_row(double x0, double dx, double y, int n, int octaves,
+                          civ_float_t persistence, civ_float_t scale,
+                          uint32_t seed, float *out);
+
+/**
+ * @brief Name of the compiled-in row kernel ("avx2", "sse2", "neon", "scalar")
+ */
+const char *civ_noise_row_kernel(void);
+
 #endif
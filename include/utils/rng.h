@@ -0,0 +1,85 @@
+/**
+ * @file rng.h
+ * @brief Seedable random streams with per-thread binding
+ *
+ * Code that used libc rand() draws through civ_rand() instead. When a
+ * stream is bound to the calling thread the draw comes from that stream,
+ * otherwise it falls back to rand(). Binding a stream per entity lets a
+ * parallel loop give every entity its own reproducible sequence.
+ *
+ * Streams are counter based: the n-th draw is a pure function of the key
+ * and n, and keys are derived from (world seed, domain, turn, entity).
+ * A subsystem can therefore rebuild its stream for any turn without
+ * replaying anyone else's draws, so replays are bit-identical no matter
+ * how work is scheduled across threads.
+ */
+
+#ifndef CIVILIZATION_RNG_H
+#define CIVILIZATION_RNG_H
+
+#include "../types.h"
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#define CIV_THREAD_LOCAL __declspec(thread)
+#else
+#define CIV_THREAD_LOCAL _Thread_local
+#endif
+
+typedef struct {
+    uint64_t state;
+} civ_rng_t;
+
+/* Stream domains — one per subsystem that draws random numbers */
+typedef enum {
+    CIV_RNG_WORLDGEN = 1,    /* game initialization */
+    CIV_RNG_TURN,            /* end-of-turn catch-all */
+    CIV_RNG_SYSTEM,          /* per-tick orchestrator nodes (entity = node) */
+    CIV_RNG_GOVERNANCE,      /* per-nation government tick */
+    CIV_RNG_BARBARIANS,      /* entity = unit index */
+    CIV_RNG_SETTLEMENTS,     /* entity = settlement index */
+    CIV_RNG_NPC,
+    CIV_RNG_MARKET,
+    CIV_RNG_AI,
+    CIV_RNG_COMBAT,          /* entity = a battle's first attacker */
+    CIV_RNG_BANKING,         /* turn = lending cycle, entity = cohort or loan */
+    CIV_RNG_DISASTERS,       /* turn = disaster update step */
+    CIV_RNG_NAMING,          /* turn = name kind, entity = culture */
+    CIV_RNG_WEATHER,         /* entity = weather cell */
+    CIV_RNG_POLITICS,        /* secessions and unions; entity = nation */
+    CIV_RNG_COMMAND          /* entity = player command within the turn */
+} civ_rng_domain_t;
+
+/**
+ * @brief Seed a stream; distinct stream ids give independent sequences
+ */
+void civ_rng_seed(civ_rng_t* rng, uint64_t seed, uint64_t stream);
+
+/**
+ * @brief Seed the stream for (seed, domain, turn, entity)
+ */
+void civ_rng_seed_key(civ_rng_t* rng, uint64_t seed, civ_rng_domain_t domain,
+                      uint64_t turn, uint64_t entity);
+
+/**
+ * @brief Next 32 random bits from a stream
+ */
+uint32_t civ_rng_next_u32(civ_rng_t* rng);
+
+/**
+ * @brief Uniform value in [0, bound) without modulo bias; 0 when bound is 0
+ */
+uint32_t civ_rng_range(civ_rng_t* rng, uint32_t bound);
+
+/**
+ * @brief Bind a stream to the calling thread (NULL unbinds)
+ * @return The previously bound stream, for restoring
+ */
+civ_rng_t* civ_rng_bind(civ_rng_t* rng);
+
+/**
+ * @brief Drop-in for rand(): value in [0, RAND_MAX] from the bound stream
+ */
+int civ_rand(void);
+
+#endif
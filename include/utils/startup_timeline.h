@@ -0,0 +1,114 @@
+/**
+ * @file startup_timeline.h
+ * @brief Wall time, I/O and allocations of every cold-start step
+ *
+ * Each loader brackets its work with civ_startup_step_begin/end: the load
+ * tasks on the loader thread, font, window and atlas creation on the main
+ * thread, and the lazy loads (cities, flag index, map renderer) on first
+ * use. A step records when it started relative to civ_startup_timeline_init,
+ * how long it took, the thread it ran on, the bytes and files it read and
+ * the CIV_MALLOC blocks and bytes its thread allocated meanwhile (which
+ * needs a CIV_MEM_TAGS build). Nested steps count into their parents too:
+ * civ_startup_note_read charges every step open on the calling thread, and
+ * civ_startup_step_add_read one step from whatever thread did the work.
+ *
+ * A step that ends on another thread than it began — flag textures decode
+ * on the worker pool — reports its wall time and reads but no allocations.
+ *
+ * civ_startup_timeline_ready marks the world playable and logs the steps
+ * so far. Every step closed is appended to the timeline CSV as it ends,
+ * tagged with the build and the run, so runs of successive builds line up
+ * for tools/startup_report.py:
+ *
+ *   build,run,step,thread,start_ms,wall_ms,bytes_read,files,allocations,alloc_bytes
+ *
+ * The ready mark is a step named "ready" starting at 0 and lasting the
+ * time to it. Allocation columns are -1 when they are not known.
+ */
+
+#ifndef CIVILIZATION_STARTUP_TIMELINE_H
+#define CIVILIZATION_STARTUP_TIMELINE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CIV_STARTUP_MAX_STEPS    64
+#define CIV_STARTUP_MAX_DEPTH    8   /**< Nesting per thread */
+#define CIV_STARTUP_DEFAULT_CSV  "startup.csv"
+#define CIV_STARTUP_READY        "ready"
+
+/**
+ * One step, closed or still running
+ */
+typedef struct {
+  char name[32];
+  char thread[16];        /**< Thread name, or its id */
+  double start_ms;        /**< Since civ_startup_timeline_init */
+  double wall_ms;         /**< 0 while running */
+  uint64_t bytes_read;
+  uint32_t files;
+  int64_t allocations;    /**< -1 when unknown */
+  int64_t alloc_bytes;    /**< -1 when unknown */
+  int depth;              /**< Steps open on its thread when it began */
+  bool done;
+} civ_startup_step_t;
+
+/**
+ * Start the timeline from now; call once at the top of main
+ * @param csv_path Appended with each closed step (NULL = no file)
+ */
+void civ_startup_timeline_init(const char *csv_path);
+
+/**
+ * Name the calling thread in its steps (the thread that called init is
+ * "main"; others default to their id)
+ */
+void civ_startup_timeline_name_thread(const char *name);
+
+/**
+ * Open a step on the calling thread; steps nest
+ * @return Handle for civ_startup_step_end, -1 when the table is full
+ */
+int civ_startup_step_begin(const char *name);
+
+/**
+ * Close a step; safe from any thread
+ */
+void civ_startup_step_end(int step);
+
+/**
+ * Charge one file of bytes to every step open on the calling thread
+ */
+void civ_startup_note_read(uint64_t bytes);
+
+/**
+ * Charge one file of bytes to a given step, from any thread
+ */
+void civ_startup_step_add_read(int step, uint64_t bytes);
+
+/**
+ * Mark the world ready: record the time to here and log the steps so far
+ */
+void civ_startup_timeline_ready(void);
+
+/**
+ * Copy a step
+ * @return False past the last step
+ */
+bool civ_startup_timeline_get(int index, civ_startup_step_t *out);
+
+/**
+ * Steps begun so far
+ */
+int civ_startup_timeline_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CIVILIZATION_STARTUP_TIMELINE_H */
@@ -0,0 +1,109 @@
+/**
+ * @file store_registry.h
+ * @brief Population and capacity of the growable stores, sampled per turn
+ *
+ * A module that keeps a doubling array registers it when it creates it:
+ * where its element count and capacity live, the element size and how the
+ * module looks entries up. civ_store_registry_end_turn reads every store
+ * at the close of a turn and keeps its growth over the last turn, the mean
+ * per turn since civ_store_registry_mark (the end of the load) and its peak. A store whose lookups walk
+ * the array (CIV_STORE_SCANNED) is flagged once it holds more than
+ * CIV_STORE_SCAN_THRESHOLD entries, so the next index to build is the one
+ * a long game actually needs.
+ *
+ * The registry only holds pointers into its owners: destroy functions
+ * call civ_store_unregister_owner before they free the owner. Counts are
+ * read without the owner's locks, between turns, when no system writes
+ * them.
+ */
+
+#ifndef CIVILIZATION_STORE_REGISTRY_H
+#define CIVILIZATION_STORE_REGISTRY_H
+
+#include "common.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CIV_STORE_MAX            64
+#define CIV_STORE_SCAN_THRESHOLD 1024 /**< Entries past which a scan is flagged */
+
+typedef enum {
+  CIV_STORE_APPEND,  /**< Appended and walked in order; no keyed lookups */
+  CIV_STORE_INDEXED, /**< Keyed lookups go through an index */
+  CIV_STORE_SCANNED  /**< Keyed lookups walk the array */
+} civ_store_lookup_t;
+
+typedef struct {
+  char name[32];
+  civ_store_lookup_t lookup;
+  size_t count;
+  size_t capacity;
+  size_t elem_size;
+  size_t peak_count;
+  int64_t turn_growth;      /**< Entries gained in the last sampled turn */
+  double growth_per_turn;   /**< Mean since the mark */
+  uint32_t turns;           /**< Turns sampled since the mark */
+  bool flagged;             /**< Scanned and past the threshold */
+} civ_store_stats_t;
+
+/**
+ * Track a store of owner; count and capacity may be 1, 2, 4 or 8 bytes wide
+ * Use CIV_STORE_REGISTER rather than calling this directly.
+ */
+void civ_store_register(const char *name, const void *owner,
+                        const void *count, size_t count_size,
+                        const void *capacity, size_t capacity_size,
+                        size_t elem_size, civ_store_lookup_t lookup);
+
+#define CIV_STORE_REGISTER(name, owner, count, capacity, elem_size, lookup)    \
+  civ_store_register((name), (owner), &(count), sizeof(count), &(capacity),    \
+                     sizeof(capacity), (elem_size), (lookup))
+
+/**
+ * Drop every store registered against owner
+ */
+void civ_store_unregister_owner(const void *owner);
+
+/**
+ * Start the growth window here without sampling a turn (after a load)
+ */
+void civ_store_registry_mark(void);
+
+/**
+ * Sample every store at the close of a turn; warns once per store that
+ * crosses the scan threshold
+ */
+void civ_store_registry_end_turn(void);
+
+/**
+ * Copy a store's figures as of the last sample
+ * @return False past the last store
+ */
+bool civ_store_registry_get(int index, civ_store_stats_t *out);
+
+int civ_store_registry_count(void);
+
+/**
+ * One line per store, largest first by bytes reserved
+ */
+void civ_store_registry_dump(FILE *out);
+
+/**
+ * Write the stores as CSV:
+ * store,lookup,count,capacity,elem_size,bytes,peak,turn_growth,growth_per_turn,flagged
+ */
+civ_result_t civ_store_registry_export_csv(const char *path);
+
+const char *civ_store_lookup_name(civ_store_lookup_t lookup);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CIVILIZATION_STORE_REGISTRY_H */
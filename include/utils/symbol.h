@@ -0,0 +1,67 @@
+/**
+ * @file symbol.h
+ * @brief Global intern table for entity ids and other hot strings
+ *
+ * A string is interned once to a 32-bit handle, which then stands in for it:
+ * two ids are the same exactly when their handles are equal. Handles and the
+ * names behind them stay valid until civ_symbol_reset. Each symbol also
+ * carries flag bits, so a property that used to be a substring search (a
+ * "rival" settlement, a barbarian unit) is decided once when the owner
+ * interns the name and read back as a bit test.
+ *
+ * The well-known symbols below are interned first and keep the same handle
+ * in every run, so they can be compared against constants. Other handles
+ * depend on intern order and must not be saved; rebuild them from the
+ * strings on load. The table is not locked: intern from the simulation
+ * thread only.
+ */
+
+#ifndef CIVILIZATION_SYMBOL_H
+#define CIVILIZATION_SYMBOL_H
+
+#include "../common.h"
+#include "../types.h"
+
+typedef uint32_t civ_symbol_t;
+
+#define CIV_SYMBOL_NONE ((civ_symbol_t)0)
+
+/* Symbols with fixed handles: X(enum suffix, string) */
+#define CIV_SYMBOL_WELL_KNOWN(X) \
+    X(PLAYER, "PLAYER")          \
+    X(REBELS, "REBELS")          \
+    X(EXPANSION, "Expansion")    \
+    X(CULTURE, "Culture")        \
+    X(STATE, "STATE")
+
+enum {
+    CIV_SYM_RESERVED = 0, /* CIV_SYMBOL_NONE */
+#define CIV_SYMBOL_ENUM(name, str) CIV_SYM_##name,
+    CIV_SYMBOL_WELL_KNOWN(CIV_SYMBOL_ENUM)
+#undef CIV_SYMBOL_ENUM
+    CIV_SYM_WELL_KNOWN_COUNT
+};
+
+/* Flag bits, set by whoever interns the name */
+#define CIV_SYMBOL_FLAG_RIVAL     (1u << 0) /* AI-controlled rival settlement */
+#define CIV_SYMBOL_FLAG_BARBARIAN (1u << 1) /* unit steered by the barbarian AI */
+
+/* Handle for str, adding it if new; CIV_SYMBOL_NONE for NULL, "" or out of memory */
+civ_symbol_t civ_symbol_intern(const char* str);
+/* Handle for str without adding it; CIV_SYMBOL_NONE if it was never interned */
+civ_symbol_t civ_symbol_find(const char* str);
+/* String behind a handle; "" for CIV_SYMBOL_NONE or unknown handles */
+const char* civ_symbol_name(civ_symbol_t sym);
+
+void civ_symbol_add_flags(civ_symbol_t sym, uint32_t flags);
+uint32_t civ_symbol_flags(civ_symbol_t sym);
+static inline bool civ_symbol_has_flag(civ_symbol_t sym, uint32_t flag) {
+    return (civ_symbol_flags(sym) & flag) != 0;
+}
+
+/* Symbols in use, including CIV_SYMBOL_NONE */
+uint32_t civ_symbol_count(void);
+/* Drop every symbol; handles other than the well-known ones become invalid */
+void civ_symbol_reset(void);
+
+#endif /* CIVILIZATION_SYMBOL_H */
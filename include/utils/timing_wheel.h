@@ -0,0 +1,82 @@
+/**
+ * @file timing_wheel.h
+ * @brief Hierarchical timing wheel for expiry, maturity and decay callbacks
+ *
+ * Timers are due at a tick of the owner's clock (game hours, months, or
+ * whatever the owner counts in) and fire in order of due tick when the
+ * wheel is advanced past it. CIV_TIMING_WHEEL_LEVELS wheels of
+ * CIV_TIMING_WHEEL_SLOTS slots each cover ticks in 1, 64, 4096 and 262144
+ * tick steps; a timer sits in the finest wheel whose span reaches it and
+ * drops to a finer one each time the coarser wheel turns over its slot.
+ * Anything further out waits in an overflow list. Advancing touches only
+ * the slots it passes; a waiting timer is moved at most once per level on
+ * its way down, and an empty wheel jumps straight to the new time.
+ *
+ * Timers come from a pool inside the wheel; ids carry a generation so a
+ * stale id cancels nothing. The order timers due on the same tick fire in
+ * depends only on the schedule and cancel calls made, so an owner whose
+ * clock is deterministic gets the same callbacks in the same order every
+ * run. A callback may schedule and cancel timers, including others due on
+ * the same tick.
+ *
+ * Not thread-safe; each wheel belongs to the system that advances it.
+ */
+
+#ifndef CIVILIZATION_TIMING_WHEEL_H
+#define CIVILIZATION_TIMING_WHEEL_H
+
+#include "../common.h"
+#include "../types.h"
+
+#define CIV_TIMING_WHEEL_BITS   6
+#define CIV_TIMING_WHEEL_SLOTS  (1 << CIV_TIMING_WHEEL_BITS)
+#define CIV_TIMING_WHEEL_LEVELS 4
+
+typedef uint64_t civ_timer_id_t; /* 0 = none */
+
+/* Called when the timer falls due; key is the owner's tag for it */
+typedef void (*civ_timer_fn)(void *arg, uint64_t key, uint64_t due);
+
+typedef struct {
+  uint64_t due;
+  civ_timer_fn fn;
+  void *arg;
+  uint64_t key;
+  uint32_t next, prev;  /* in the list the timer is on */
+  uint32_t list;        /* slot, overflow, overdue or firing list; free when NIL */
+  uint32_t generation;
+} civ_timer_node_t;
+
+typedef struct {
+  uint64_t now;         /* every timer due at or before it has fired */
+  uint32_t heads[CIV_TIMING_WHEEL_LEVELS * CIV_TIMING_WHEEL_SLOTS + 3];
+
+  civ_timer_node_t *nodes;
+  uint32_t node_capacity;
+  uint32_t free_head;
+  size_t pending;       /* scheduled, not yet fired or cancelled */
+  uint64_t fired;       /* over the wheel's life */
+} civ_timing_wheel_t;
+
+/* Clear wheel to an empty one at tick now */
+void civ_timing_wheel_init(civ_timing_wheel_t *wheel, uint64_t now);
+void civ_timing_wheel_free(civ_timing_wheel_t *wheel);
+
+/* Fire fn(arg, key, due) once the wheel reaches due. A due tick already
+   reached fires first thing on the next advance that moves the clock, in
+   order of due tick and before any timer due later. 0 when out of
+   memory. */
+civ_timer_id_t civ_timing_wheel_schedule(civ_timing_wheel_t *wheel,
+                                         uint64_t due, civ_timer_fn fn,
+                                         void *arg, uint64_t key);
+/* false when the timer has already fired or been cancelled */
+bool civ_timing_wheel_cancel(civ_timing_wheel_t *wheel, civ_timer_id_t id);
+/* Due tick of a pending timer, or 0 */
+uint64_t civ_timing_wheel_due(const civ_timing_wheel_t *wheel,
+                              civ_timer_id_t id);
+
+/* Move the clock to now, firing everything due on the way; returns how
+   many timers fired. A clock going backwards is ignored. */
+size_t civ_timing_wheel_advance(civ_timing_wheel_t *wheel, uint64_t now);
+
+#endif /* CIVILIZATION_TIMING_WHEEL_H */
@@ -0,0 +1,129 @@
+#version 450
+/*
+ * Map view colouring for the GPU map backend (src/engine/map_shader.c).
+ *
+ * Drawn as one quad over the window with the attribute texture bound.
+ * Rows [0, h) of the texture hold elevation, density, culture and flags;
+ * rows [h, 2h) hold the political colour and the resource band. The
+ * colours and bands mirror get_map_color_for_view in renderer.c.
+ *
+ * Build: make shaders  (glslc -> data/shaders/map_view.frag.spv)
+ */
+
+layout(location = 0) in vec4 v_color;
+layout(location = 1) in vec2 v_uv;
+layout(location = 0) out vec4 o_color;
+
+layout(set = 2, binding = 0) uniform sampler2D u_attr;
+
+layout(set = 3, binding = 0, std140) uniform MapView {
+  vec2  screen;     /* window size in pixels */
+  vec2  view;       /* camera centre in tiles */
+  vec2  map_size;   /* width, height in tiles */
+  float scale;      /* pixels per tile */
+  int   view_type;  /* civ_map_view_type_t */
+};
+
+const uint FLAG_EXPLORED = 1u;
+const uint FLAG_VISIBLE  = 2u;
+const uint FLAG_WATER    = 4u;
+const uint FLAG_RIVER    = 8u;  /* river above sea level */
+const uint FLAG_COLORED  = 16u; /* political colour set */
+
+vec4 rgb(uint c) {
+  return vec4(float((c >> 16) & 255u), float((c >> 8) & 255u),
+              float(c & 255u), 255.0) / 255.0;
+}
+
+/* Integer channel scaling as the CPU path does it */
+vec4 scaled(vec4 c, float num, float den) {
+  return vec4(floor(round(c.rgb * 255.0) * num / den + 1e-3) / 255.0, 1.0);
+}
+
+uint elevation_color(float e) {
+  if (e < 0.05) return 0x0B2C4Du;
+  if (e < 0.20) return 0x15406Au;
+  if (e < 0.30) return 0x1A5C3Au;
+  if (e < 0.40) return 0x2D8C3Cu;
+  if (e < 0.55) return 0x4DA830u;
+  if (e < 0.70) return 0x8B6914u;
+  if (e < 0.85) return 0xA0855Au;
+  return 0xE0E0E0u;
+}
+
+uint density_color(float d) {
+  if (d < 0.01) return 0x1A2A1Au;
+  if (d < 0.05) return 0x2A4A2Au;
+  if (d < 0.15) return 0x3A6A30u;
+  if (d < 0.30) return 0x5A8A20u;
+  if (d < 0.50) return 0xAAAA20u;
+  if (d < 0.75) return 0xCC6600u;
+  return 0xFF2200u;
+}
+
+uint cultural_color(float c) {
+  if (c < 0.01) return 0x1A1A2Au;
+  if (c < 0.10) return 0x2A2A6Au;
+  if (c < 0.25) return 0x3A3AAAu;
+  if (c < 0.45) return 0x5555CCu;
+  if (c < 0.70) return 0x7744CCu;
+  return 0xCC44FFu;
+}
+
+const uint RESOURCE_BANDS[7] = uint[7](0x2A2A2Au, 0x2A4A2Au, 0x3A6A20u,
+                                       0x6A9A10u, 0xAAAA20u, 0xCC6600u,
+                                       0xFF2200u);
+
+void main() {
+  vec2 pixel = v_uv * screen;
+  vec2 world = view + (pixel - 0.5 * screen) / scale;
+
+  /* Polar clamp: past the poles is deep space */
+  if (world.y < 0.0 || world.y >= map_size.y) {
+    o_color = rgb(0x020408u);
+    return;
+  }
+  /* East-west wrap */
+  world.x = mod(world.x, map_size.x);
+
+  vec2 tile = floor(world) + 0.5;
+  vec4 a = texture(u_attr, vec2(tile.x, tile.y) / vec2(map_size.x, 2.0 * map_size.y));
+  vec4 b = texture(u_attr, vec2(tile.x, tile.y + map_size.y) /
+                               vec2(map_size.x, 2.0 * map_size.y));
+  uint flags = uint(a.a * 255.0 + 0.5);
+  bool visible = (flags & FLAG_VISIBLE) != 0u;
+  bool water = (flags & FLAG_WATER) != 0u;
+
+  if ((flags & FLAG_RIVER) != 0u) {
+    o_color = rgb(0x2A8AE0u);
+    return;
+  }
+  if ((flags & FLAG_EXPLORED) == 0u) {
+    o_color = rgb(0x010204u);
+    return;
+  }
+
+  vec4 water_color = rgb(visible ? 0x0B2C4Du : 0x02060Fu);
+  vec4 c;
+  if (view_type == 1) {                       /* geographical */
+    c = rgb(elevation_color(a.r));
+  } else if (view_type == 2 || view_type == 3 || view_type == 4) {
+    if (water) { o_color = water_color; return; }
+    if (view_type == 2) c = rgb(density_color(a.g));
+    else if (view_type == 3) c = rgb(cultural_color(a.b));
+    else c = rgb(RESOURCE_BANDS[min(uint(b.a * 255.0 + 0.5), 6u)]);
+  } else if (view_type == 5 || view_type == 6) { /* placeholder views */
+    o_color = water ? water_color : rgb(visible ? 0x2A3A2Au : 0x101010u);
+    return;
+  } else {                                    /* political */
+    if (water) { o_color = water_color; return; }
+    if ((flags & FLAG_COLORED) == 0u) {
+      o_color = rgb(visible ? 0x3A3A3Au : 0x101010u);
+      return;
+    }
+    c = vec4(b.rgb, 1.0);
+    o_color = visible ? c : scaled(c, 1.0, 3.0);
+    return;
+  }
+  o_color = visible ? c : scaled(c, 2.0, 3.0);
+}
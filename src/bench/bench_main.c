@@ -0,0 +1,608 @@
+/**
+ * @file bench_main.c
+ * @brief Microbenchmarks for the simulation and map-drawing hot kernels.
+ *
+ * Links what dominion_headless links plus the map renderer: no window, TTF
+ * or Nuklear. Map drawing goes to a software renderer on an offscreen
+ * surface, so it measures the CPU colouring and bake paths.
+ *
+ *   dominion_bench [--sizes 2048x1024,4096x2048,8192x4096]
+ *                  [--nations 8,64,256] [--reps 5] [--workers 0]
+ *                  [--seed N] [--only gen,econ,conquest,cities,render,journal]
+ *                  [--scratch DIR]
+ *
+ * Every fixture is built from the seed alone: the map through
+ * civ_map_generate, nations as a grid of blocks owning the land under
+ * them, cities and queries from a fixed generator, so two runs of the same
+ * build on the same machine time the same work. Results go to stdout as
+ * CSV, one row per kernel and fixture, progress to stderr:
+ *
+ *   bench,width,height,nations,reps,ops,ns_per_op,ns_per_op_min,
+ *   ops_per_sec,ns_per_tile,mb_per_sec
+ *
+ * ns_per_op is the median over reps and ops the work in one rep; per-tile
+ * and byte rates are left empty where a kernel has no tiles or bytes.
+ * --workers 1 runs everything on the calling thread.
+ */
+
+#include "core/data/history_db.h"
+#include "core/military/conquest.h"
+#include "core/simulation_engine/worker_pool.h"
+#include "core/world/cities_data.h"
+#include "core/world/map_generator.h"
+#include "core/world/nation.h"
+#include "core/world/owner_ids.h"
+#include "engine/renderer.h"
+#include "utils/rng.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_MAX_SIZES    8
+#define BENCH_MAX_COUNTS   8
+#define BENCH_MAX_REPS     64
+#define BENCH_FB_WIDTH     1920
+#define BENCH_FB_HEIGHT    1080
+#define BENCH_QUERIES      4096  /* city viewport queries per rep */
+#define BENCH_RECORDS      65536 /* journal appends per rep */
+#define BENCH_RECORD_BYTES 48
+
+enum {
+  BENCH_GEN      = 1 << 0,
+  BENCH_ECON     = 1 << 1,
+  BENCH_CONQUEST = 1 << 2,
+  BENCH_CITIES   = 1 << 3,
+  BENCH_RENDER   = 1 << 4,
+  BENCH_JOURNAL  = 1 << 5,
+  BENCH_ALL      = (1 << 6) - 1
+};
+
+typedef struct {
+  int32_t     widths[BENCH_MAX_SIZES];
+  int32_t     heights[BENCH_MAX_SIZES];
+  int         size_count;
+  int         nations[BENCH_MAX_COUNTS];
+  int         nation_count;
+  int         reps;
+  int         workers;
+  uint32_t    seed;
+  unsigned    only;
+  const char *scratch;
+} civ_bench_args_t;
+
+/* Fixture of one run: what the kernels share */
+typedef struct {
+  const civ_bench_args_t *args;
+  civ_worker_pool_t      *pool;
+  civ_map_t              *map;
+  civ_nation_manager_t   *nations;
+  uint64_t                samples[BENCH_MAX_REPS];
+} civ_bench_t;
+
+static void usage(const char *argv0) {
+  fprintf(stderr,
+          "usage: %s [--sizes WxH,...] [--nations N,...] [--reps N]\n"
+          "          [--workers N] [--seed N] [--only KERNEL,...] [--scratch DIR]\n"
+          "kernels: gen econ conquest cities render journal\n",
+          argv0);
+}
+
+static bool parse_sizes(const char *val, civ_bench_args_t *a) {
+  a->size_count = 0;
+  for (const char *p = val; *p;) {
+    char *end;
+    long w = strtol(p, &end, 10);
+    if (*end != 'x') return false;
+    long h = strtol(end + 1, &end, 10);
+    if (w < CIV_MIN_MAP_WIDTH || w > CIV_MAX_MAP_WIDTH ||
+        h < CIV_MIN_MAP_HEIGHT || h > CIV_MAX_MAP_HEIGHT ||
+        a->size_count >= BENCH_MAX_SIZES)
+      return false;
+    a->widths[a->size_count] = (int32_t)w;
+    a->heights[a->size_count] = (int32_t)h;
+    a->size_count++;
+    if (*end == ',') end++;
+    else if (*end) return false;
+    p = end;
+  }
+  return a->size_count > 0;
+}
+
+static bool parse_counts(const char *val, civ_bench_args_t *a) {
+  a->nation_count = 0;
+  for (const char *p = val; *p;) {
+    char *end;
+    long n = strtol(p, &end, 10);
+    if (n < 2 || n > CIV_NATION_CAPACITY_MAX || end == p ||
+        a->nation_count >= BENCH_MAX_COUNTS)
+      return false;
+    a->nations[a->nation_count++] = (int)n;
+    if (*end == ',') end++;
+    else if (*end) return false;
+    p = end;
+  }
+  return a->nation_count > 0;
+}
+
+static bool parse_only(const char *val, civ_bench_args_t *a) {
+  static const struct { const char *name; unsigned bit; } kernels[] = {
+    {"gen", BENCH_GEN},       {"econ", BENCH_ECON},
+    {"conquest", BENCH_CONQUEST}, {"cities", BENCH_CITIES},
+    {"render", BENCH_RENDER}, {"journal", BENCH_JOURNAL},
+  };
+  a->only = 0;
+  for (const char *p = val; *p;) {
+    size_t len = strcspn(p, ",");
+    bool found = false;
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+      if (strlen(kernels[k].name) == len && strncmp(p, kernels[k].name, len) == 0) {
+        a->only |= kernels[k].bit;
+        found = true;
+      }
+    }
+    if (!found) return false;
+    p += len;
+    if (*p == ',') p++;
+  }
+  return a->only != 0;
+}
+
+static bool parse_args(int argc, char **argv, civ_bench_args_t *a) {
+  parse_sizes("2048x1024,4096x2048,8192x4096", a);
+  parse_counts("8,64,256", a);
+  a->reps = 5;
+  a->workers = 0;
+  a->seed = CIV_GLOBAL_MAP_SEED;
+  a->only = BENCH_ALL;
+  a->scratch = ".";
+
+  for (int i = 1; i < argc; i++) {
+    const char *opt = argv[i];
+    const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+    if (strcmp(opt, "--help") == 0 || strcmp(opt, "-h") == 0) return false;
+    if (!val) {
+      fprintf(stderr, "missing value for %s\n", opt);
+      return false;
+    }
+    bool ok = true;
+    if      (strcmp(opt, "--sizes") == 0)   ok = parse_sizes(val, a);
+    else if (strcmp(opt, "--nations") == 0) ok = parse_counts(val, a);
+    else if (strcmp(opt, "--only") == 0)    ok = parse_only(val, a);
+    else if (strcmp(opt, "--reps") == 0)    a->reps = atoi(val);
+    else if (strcmp(opt, "--workers") == 0) a->workers = atoi(val);
+    else if (strcmp(opt, "--seed") == 0)    a->seed = (uint32_t)strtoul(val, NULL, 0);
+    else if (strcmp(opt, "--scratch") == 0) a->scratch = val;
+    else {
+      fprintf(stderr, "unknown option %s\n", opt);
+      return false;
+    }
+    if (!ok) {
+      fprintf(stderr, "bad value for %s: %s\n", opt, val);
+      return false;
+    }
+    i++;
+  }
+  if (a->reps < 1 || a->reps > BENCH_MAX_REPS || a->workers < 0) {
+    fprintf(stderr, "reps must be 1..%d, workers >= 0\n", BENCH_MAX_REPS);
+    return false;
+  }
+  if (a->seed == 0) a->seed = CIV_GLOBAL_MAP_SEED;
+  return true;
+}
+
+/* ── Reporting ───────────────────────────────────────────────────── */
+
+static int cmp_u64(const void *a, const void *b) {
+  uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+  return x < y ? -1 : x > y;
+}
+
+/* One CSV row from the rep times in b->samples; tiles and bytes are per
+   rep, 0 for none */
+static void report(civ_bench_t *b, const char *name, int nations,
+                   double ops, double tiles, double bytes) {
+  int reps = b->args->reps;
+  qsort(b->samples, (size_t)reps, sizeof(b->samples[0]), cmp_u64);
+  double median = (double)b->samples[reps / 2];
+  if (reps % 2 == 0)
+    median = 0.5 * (median + (double)b->samples[reps / 2 - 1]);
+  double best = (double)b->samples[0];
+  if (ops <= 0.0) ops = 1.0;
+
+  printf("%s,%d,%d,%d,%d,%.0f,%.3f,%.3f,%.1f,", name,
+         b->map ? b->map->width : 0, b->map ? b->map->height : 0, nations,
+         reps, ops, median / ops, best / ops,
+         median > 0.0 ? ops * 1e9 / median : 0.0);
+  if (tiles > 0.0) printf("%.4f", median / tiles);
+  putchar(',');
+  if (bytes > 0.0 && median > 0.0) printf("%.2f", bytes * 1e3 / median);
+  putchar('\n');
+  fflush(stdout);
+}
+
+/* ── Fixtures ────────────────────────────────────────────────────── */
+
+/* nations blocks over the map, rows x cols close to the map's aspect; each
+   nation owns the land in its block */
+static void fixture_nations(civ_bench_t *b, int count) {
+  civ_nation_manager_t *mgr = b->nations;
+  civ_map_t *map = b->map;
+
+  int cols = 1;
+  while (cols * cols < 2 * count) cols++;
+  int rows = (count + cols - 1) / cols;
+
+  mgr->count = count;
+  for (int i = 0; i < count; i++) {
+    civ_nation_t *n = &mgr->nations[i];
+    memset(n, 0, sizeof(*n));
+    snprintf(n->id, sizeof(n->id), "bench_%03d", i);
+    snprintf(n->name, sizeof(n->name), "Bench %d", i);
+    n->color = 0xFF000000u | ((uint32_t)i * 2654435761u >> 8);
+    n->color_accent = n->color;
+    n->population = 10000000 + (int64_t)i * 250000;
+    n->gdp_per_capita = 2000.0f + (float)(i % 16) * 500.0f;
+    n->cost_of_living = 1.0f;
+    n->owner_index = civ_nation_owner_index(n);
+  }
+  civ_nation_manager_index_owners(mgr);
+  mgr->territory_valid = false;
+
+  for (int32_t y = 0; y < map->height; y++) {
+    int r = (int)((int64_t)y * rows / map->height);
+    for (int32_t x = 0; x < map->width; x++) {
+      size_t i = (size_t)y * map->width + x;
+      int ni = r * cols + (int)((int64_t)x * cols / map->width);
+      if (ni >= count || civ_map_is_water_at(map, i)) {
+        civ_map_set_owner(map, i, CIV_OWNER_NONE, 0);
+      } else {
+        const civ_nation_t *n = &mgr->nations[ni];
+        civ_map_set_owner(map, i, n->owner_index, n->color);
+      }
+    }
+  }
+}
+
+/* ── Kernels ─────────────────────────────────────────────────────── */
+
+static bool bench_generate(civ_bench_t *b) {
+  civ_map_gen_params_t params = civ_map_default_params();
+  params.width = b->map->width;
+  params.height = b->map->height;
+  params.seed = b->args->seed;
+  params.worker_pool = b->pool;
+  for (int r = 0; r < b->args->reps; r++) {
+    uint64_t t0 = SDL_GetTicksNS();
+    civ_result_t res = civ_map_generate(b->map, &params);
+    b->samples[r] = SDL_GetTicksNS() - t0;
+    if (CIV_FAILED(res)) {
+      fprintf(stderr, "map generation failed: %s\n",
+              res.message ? res.message : "?");
+      return false;
+    }
+  }
+  double tiles = (double)b->map->width * b->map->height;
+  if (b->args->only & BENCH_GEN) report(b, "map_generate", 0, tiles, tiles, 0.0);
+  return true;
+}
+
+static void bench_economy(civ_bench_t *b, int count) {
+  civ_nation_manager_t *mgr = b->nations;
+  double tiles = (double)b->map->width * b->map->height;
+  civ_nation_economy_t global;
+
+  /* One full-map scan per nation */
+  for (int r = 0; r < b->args->reps; r++) {
+    uint64_t t0 = SDL_GetTicksNS();
+    for (int i = 0; i < count; i++)
+      civ_nation_compute_economy(&mgr->nations[i], b->map, NULL);
+    b->samples[r] = SDL_GetTicksNS() - t0;
+  }
+  report(b, "nation_compute_economy", count, count, tiles * count, 0.0);
+
+  /* Aggregates rebuilt in one pass, then kept by the owner listener */
+  for (int r = 0; r < b->args->reps; r++) {
+    mgr->territory_valid = false;
+    uint64_t t0 = SDL_GetTicksNS();
+    civ_nation_compute_all_economies(mgr, b->map, NULL, &global);
+    b->samples[r] = SDL_GetTicksNS() - t0;
+  }
+  report(b, "nation_economies_rebuild", count, count, tiles, 0.0);
+
+  for (int r = 0; r < b->args->reps; r++) {
+    uint64_t t0 = SDL_GetTicksNS();
+    civ_nation_compute_all_economies(mgr, b->map, NULL, &global);
+    b->samples[r] = SDL_GetTicksNS() - t0;
+  }
+  report(b, "nation_economies_current", count, count, 0.0, 0.0);
+}
+
+/* Nations 0 and 1 share a block edge; each rep the side that lost the
+   last front takes the other's, so the front stays the same length */
+static void bench_conquest(civ_bench_t *b, int count) {
+  civ_conquest_system_t *cs = civ_conquest_system_create();
+  if (!cs) return;
+  cs->frontier = civ_border_frontier_create();
+  if (!civ_border_frontier_attach(cs->frontier, b->map)) {
+    civ_conquest_system_destroy(cs);
+    return;
+  }
+
+  double moved = 0.0;
+  for (int r = 0; r < b->args->reps; r++) {
+    const civ_nation_t *att = &b->nations->nations[(r + 1) % 2];
+    const civ_nation_t *def = &b->nations->nations[r % 2];
+    civ_conquest_start(cs, att->id, def->id, "bench_front",
+                       CIV_CONQUEST_INVASION);
+    if (cs->conquest_count > 0) cs->conquests[cs->conquest_count - 1].completed = true;
+    uint64_t t0 = SDL_GetTicksNS();
+    int n = civ_conquest_transfer_territory(cs, b->map, b->nations);
+    b->samples[r] = SDL_GetTicksNS() - t0;
+    moved += n;
+  }
+  civ_border_frontier_detach(cs->frontier, b->map);
+  civ_conquest_system_destroy(cs);
+  /* Tiles moved per transfer, so ns_per_op is per tile */
+  report(b, "conquest_transfer_territory", count, moved / b->args->reps, 0.0,
+         0.0);
+}
+
+static void put_u16(uint8_t **p, uint16_t v) {
+  *(*p)++ = (uint8_t)v;
+  *(*p)++ = (uint8_t)(v >> 8);
+}
+
+static void put_u32(uint8_t **p, uint32_t v) {
+  put_u16(p, (uint16_t)v);
+  put_u16(p, (uint16_t)(v >> 16));
+}
+
+/* CIV_CITIES_MAX cities in the data/cities.bin layout, clustered the way
+   real ones are rather than spread evenly */
+static civ_cities_data_t *fixture_cities(civ_bench_t *b, civ_rng_t *rng) {
+  civ_map_t *map = b->map;
+  size_t cap = 20 + (size_t)CIV_CITIES_MAX * 32;
+  uint8_t *blob = malloc(cap);
+  civ_cities_data_t *cd =
+      civ_cities_data_create((uint32_t)map->width, (uint32_t)map->height);
+  if (!blob || !cd) {
+    free(blob);
+    civ_cities_data_destroy(cd);
+    return NULL;
+  }
+
+  uint8_t *p = blob;
+  put_u32(&p, 0x54494349u); /* "CITI" */
+  put_u32(&p, 1);
+  put_u32(&p, (uint32_t)map->width);
+  put_u32(&p, (uint32_t)map->height);
+  put_u32(&p, CIV_CITIES_MAX);
+  uint32_t cx = 0, cy = 0;
+  for (uint32_t i = 0; i < CIV_CITIES_MAX; i++) {
+    if (i % 64 == 0) {
+      cx = civ_rng_range(rng, (uint32_t)map->width);
+      cy = civ_rng_range(rng, (uint32_t)map->height);
+    }
+    int32_t spread = map->width / 64;
+    int32_t x = (int32_t)cx + (int32_t)civ_rng_range(rng, 2 * spread + 1) - spread;
+    int32_t y = (int32_t)cy + (int32_t)civ_rng_range(rng, 2 * spread + 1) - spread;
+    char name[16];
+    int len = snprintf(name, sizeof(name), "city%u", i);
+    put_u16(&p, (uint16_t)len);
+    memcpy(p, name, (size_t)len);
+    p += len;
+    *p++ = 2;
+    *p++ = 'X';
+    *p++ = 'X';
+    put_u16(&p, (uint16_t)CLAMP(x, 0, map->width - 1));
+    put_u16(&p, (uint16_t)CLAMP(y, 0, map->height - 1));
+    put_u32(&p, 100000u + civ_rng_range(rng, 10000000u));
+    *p++ = (uint8_t)(i % 64 == 0);
+    *p++ = (uint8_t)civ_rng_range(rng, 4);
+  }
+  civ_result_t res = civ_cities_data_load_view(cd, blob, (size_t)(p - blob));
+  free(blob);
+  if (CIV_FAILED(res)) {
+    civ_cities_data_destroy(cd);
+    return NULL;
+  }
+  return cd;
+}
+
+static void bench_cities(civ_bench_t *b) {
+  civ_rng_t rng;
+  civ_rng_seed(&rng, b->args->seed, 1);
+  civ_cities_data_t *cd = fixture_cities(b, &rng);
+  if (!cd) {
+    fprintf(stderr, "city fixture failed\n");
+    return;
+  }
+
+  /* Viewports of a 1080p screen at a few zooms */
+  static const int32_t views[][2] = {{480, 270}, {960, 540}, {1920, 1080}};
+  int32_t (*q)[4] = malloc(sizeof(*q) * BENCH_QUERIES);
+  if (!q) {
+    civ_cities_data_destroy(cd);
+    return;
+  }
+  for (int i = 0; i < BENCH_QUERIES; i++) {
+    const int32_t *v = views[i % 3];
+    q[i][2] = MIN(v[0], b->map->width);
+    q[i][3] = MIN(v[1], b->map->height);
+    q[i][0] = (int32_t)civ_rng_range(&rng, (uint32_t)(b->map->width - q[i][2] + 1));
+    q[i][1] = (int32_t)civ_rng_range(&rng, (uint32_t)(b->map->height - q[i][3] + 1));
+  }
+
+  /* One span for every query, as a frame would reuse */
+  const civ_city_data_t **hits = malloc(sizeof(*hits) * MAX(cd->count, 1u));
+  if (!hits) {
+    free(q);
+    civ_cities_data_destroy(cd);
+    return;
+  }
+
+  uint64_t found = 0;
+  for (int r = 0; r < b->args->reps; r++) {
+    uint64_t t0 = SDL_GetTicksNS();
+    for (int i = 0; i < BENCH_QUERIES; i++)
+      found += civ_cities_query_tiles_into(cd, q[i][0], q[i][1], q[i][2],
+                                           q[i][3], CIV_CITY_TIER_SMALL, hits,
+                                           cd->count);
+    b->samples[r] = SDL_GetTicksNS() - t0;
+  }
+  fprintf(stderr, "  cities: %.1f hits per query\n",
+          (double)found / ((double)BENCH_QUERIES * b->args->reps));
+  report(b, "cities_query_tiles", 0, BENCH_QUERIES, 0.0, 0.0);
+  free(hits);
+  free(q);
+  civ_cities_data_destroy(cd);
+}
+
+/* Warm frames at one tile per pixel and with the whole map in view, then
+   frames after every region went stale */
+static void bench_render(civ_bench_t *b, int count) {
+  SDL_Surface *target =
+      SDL_CreateSurface(BENCH_FB_WIDTH, BENCH_FB_HEIGHT, SDL_PIXELFORMAT_ARGB8888);
+  SDL_Renderer *renderer = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+  civ_render_map_context_t *ctx =
+      renderer ? civ_render_map_context_create(renderer, BENCH_FB_WIDTH,
+                                               BENCH_FB_HEIGHT, b->map->width,
+                                               b->map->height)
+               : NULL;
+  if (!ctx) {
+    fprintf(stderr, "render: no software renderer (%s), skipped\n",
+            SDL_GetError());
+    if (renderer) SDL_DestroyRenderer(renderer);
+    if (target) SDL_DestroySurface(target);
+    return;
+  }
+  ctx->worker_pool = b->pool;
+
+  static const struct { const char *name; float zoom; bool stale; } passes[] = {
+    {"render_map_detail", 0.25f, false},
+    {"render_map_overview", 0.0f, false},  /* clamped to the whole map */
+    {"render_map_rebake", 0.25f, true},
+  };
+  for (size_t pi = 0; pi < sizeof(passes) / sizeof(passes[0]); pi++) {
+    ctx->view_x = (float)b->map->width / 2.0f;
+    ctx->view_y = (float)b->map->height / 2.0f;
+    ctx->zoom = passes[pi].zoom;
+    civ_render_map(renderer, ctx, b->map, BENCH_FB_WIDTH, BENCH_FB_HEIGHT,
+                   CIV_MAP_VIEW_POLITICAL, NULL);
+    for (int r = 0; r < b->args->reps; r++) {
+      if (passes[pi].stale) civ_map_touch_all(b->map);
+      uint64_t t0 = SDL_GetTicksNS();
+      civ_render_map(renderer, ctx, b->map, BENCH_FB_WIDTH, BENCH_FB_HEIGHT,
+                     CIV_MAP_VIEW_POLITICAL, NULL);
+      b->samples[r] = SDL_GetTicksNS() - t0;
+    }
+    /* ctx->zoom holds what the frame was drawn at after clamping */
+    double scale = ctx->zoom * 4.0;
+    double tiles = MIN((double)BENCH_FB_WIDTH / scale, (double)b->map->width) *
+                   MIN((double)BENCH_FB_HEIGHT / scale, (double)b->map->height);
+    report(b, passes[pi].name, count, 1.0, tiles, 0.0);
+  }
+
+  civ_render_map_context_destroy(ctx);
+  SDL_DestroyRenderer(renderer);
+  SDL_DestroySurface(target);
+}
+
+static void bench_journal(civ_bench_t *b) {
+  char path[512];
+  snprintf(path, sizeof(path), "%s/bench_journal", b->args->scratch);
+  uint8_t payload[BENCH_RECORD_BYTES];
+  for (size_t i = 0; i < sizeof(payload); i++) payload[i] = (uint8_t)(i * 31);
+
+  for (int r = 0; r < b->args->reps; r++) {
+    civ_journal_t *j = civ_journal_create(path);
+    if (!j) {
+      fprintf(stderr, "journal: cannot create %s\n", path);
+      return;
+    }
+    uint64_t t0 = SDL_GetTicksNS();
+    for (int i = 0; i < BENCH_RECORDS; i++) {
+      if (i % 1024 == 0) civ_journal_set_turn(j, i / 1024);
+      civ_journal_log(j, (civ_journal_event_type_t)(i % CIV_JOURNAL_TYPE_COUNT),
+                      "bench", payload, sizeof(payload));
+    }
+    civ_journal_flush(j);
+    b->samples[r] = SDL_GetTicksNS() - t0;
+    civ_journal_destroy(j);
+  }
+
+  /* Leave no segments behind */
+  for (int seg = 0; seg < 10000; seg++) {
+    char seg_path[540];
+    snprintf(seg_path, sizeof(seg_path), "%s.%04d", path, seg);
+    if (remove(seg_path) != 0) break;
+  }
+  report(b, "journal_append", 0, BENCH_RECORDS, 0.0,
+         (double)BENCH_RECORDS * BENCH_RECORD_BYTES);
+}
+
+/* ── Driver ──────────────────────────────────────────────────────── */
+
+static bool run_size(civ_bench_t *b, int32_t w, int32_t h) {
+  const civ_bench_args_t *a = b->args;
+  fprintf(stderr, "[bench] %dx%d map\n", w, h);
+  b->map = civ_map_create(w, h, a->seed);
+  b->nations = civ_nation_manager_create();
+  if (!b->map || !b->nations) {
+    fprintf(stderr, "cannot allocate a %dx%d map\n", w, h);
+    civ_map_destroy(b->map);
+    civ_nation_manager_destroy(b->nations);
+    b->map = NULL;
+    b->nations = NULL;
+    return false;
+  }
+
+  /* Every other kernel needs the terrain, so generation always runs */
+  bool ok = bench_generate(b);
+  for (int c = 0; ok && c < a->nation_count &&
+                  (a->only & (BENCH_ECON | BENCH_CONQUEST | BENCH_RENDER));
+       c++) {
+    int count = a->nations[c];
+    fixture_nations(b, count);
+    if (a->only & BENCH_ECON) bench_economy(b, count);
+    if (a->only & BENCH_CONQUEST) bench_conquest(b, count);
+    if ((a->only & BENCH_RENDER) && c == a->nation_count - 1)
+      bench_render(b, count);
+  }
+  if (ok && (a->only & BENCH_CITIES)) bench_cities(b);
+
+  /* The map goes first: the manager is still its owner listener */
+  civ_map_destroy(b->map);
+  civ_nation_manager_destroy(b->nations);
+  b->map = NULL;
+  b->nations = NULL;
+  return ok;
+}
+
+int main(int argc, char *argv[]) {
+  civ_bench_args_t args;
+  if (!parse_args(argc, argv, &args)) {
+    usage(argv[0]);
+    return 2;
+  }
+  srand(args.seed);
+
+  civ_bench_t bench;
+  memset(&bench, 0, sizeof(bench));
+  bench.args = &args;
+  if (args.workers != 1)
+    bench.pool = civ_worker_pool_create(args.workers ? args.workers - 1 : 0);
+
+  printf("bench,width,height,nations,reps,ops,ns_per_op,ns_per_op_min,"
+         "ops_per_sec,ns_per_tile,mb_per_sec\n");
+  int rc = 0;
+  if (args.only & ~BENCH_JOURNAL) {
+    for (int s = 0; s < args.size_count; s++)
+      if (!run_size(&bench, args.widths[s], args.heights[s])) rc = 1;
+  }
+  if (args.only & BENCH_JOURNAL) bench_journal(&bench);
+
+  civ_worker_pool_destroy(bench.pool);
+  return rc;
+}
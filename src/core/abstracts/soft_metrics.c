@@ -23,7 +23,6 @@ civ_soft_metrics_manager_t* civ_soft_metrics_manager_create(void) {
 void civ_soft_metrics_manager_destroy(civ_soft_metrics_manager_t* sm) {
     if (!sm) return;
     
-    CIV_FREE(sm->happiness_metrics.recent_changes);
     CIV_FREE(sm->prestige_system.international_relations);
     CIV_FREE(sm);
 }
@@ -37,8 +36,6 @@ void civ_soft_metrics_manager_init(civ_soft_metrics_manager_t* sm) {
     sm->happiness_metrics.base_happiness = 0.5f;
     sm->happiness_metrics.stability = 0.5f;
     sm->happiness_metrics.loyalty = 0.5f;
-    sm->happiness_metrics.change_capacity = 10;
-    sm->happiness_metrics.recent_changes = (civ_float_t*)CIV_CALLOC(sm->happiness_metrics.change_capacity, sizeof(civ_float_t));
     
     /* Initialize legitimacy system */
     sm->legitimacy_system.legitimacy = 0.7f;
@@ -62,13 +59,13 @@ civ_float_t civ_happiness_metrics_get_overall(const civ_happiness_metrics_t* hm)
     
     /* Consider recent changes (weighted average) */
     civ_float_t recent_impact = 0.0f;
-    if (hm->recent_changes && hm->change_count > 0) {
+    if (hm->change_count > 0) {
         civ_float_t weights[] = {0.5f, 0.3f, 0.2f};
         size_t count = MIN(3, hm->change_count);
-        size_t start = hm->change_count > 3 ? hm->change_count - 3 : 0;
+        size_t start = hm->change_head + CIV_HAPPINESS_WINDOW - count;
         
         for (size_t i = 0; i < count; i++) {
-            recent_impact += hm->recent_changes[start + i] * weights[i];
+            recent_impact += hm->recent_changes[(start + i) % CIV_HAPPINESS_WINDOW] * weights[i];
         }
     }
     
@@ -92,23 +89,9 @@ civ_mood_t civ_happiness_metrics_get_mood(const civ_happiness_metrics_t* hm) {
 void civ_happiness_metrics_add_change(civ_happiness_metrics_t* hm, civ_float_t change) {
     if (!hm) return;
     
-    /* Expand capacity if needed */
-    if (hm->change_count >= hm->change_capacity) {
-        hm->change_capacity *= 2;
-        hm->recent_changes = (civ_float_t*)CIV_REALLOC(hm->recent_changes, 
-                                                       hm->change_capacity * sizeof(civ_float_t));
-    }
-    
-    if (hm->recent_changes) {
-        hm->recent_changes[hm->change_count++] = change;
-        
-        /* Keep only last 10 changes */
-        if (hm->change_count > 10) {
-            memmove(hm->recent_changes, hm->recent_changes + 1, 
-                    (hm->change_count - 1) * sizeof(civ_float_t));
-            hm->change_count--;
-        }
-    }
+    hm->recent_changes[hm->change_head] = change;
+    hm->change_head = (hm->change_head + 1) % CIV_HAPPINESS_WINDOW;
+    if (hm->change_count < CIV_HAPPINESS_WINDOW) hm->change_count++;
 }
 
 civ_float_t civ_legitimacy_calculate_score(const civ_legitimacy_system_t* ls) {
@@ -154,16 +137,15 @@ void civ_soft_metrics_update_from_events(civ_soft_metrics_manager_t* sm, const v
     }
 }
 
-char* civ_soft_metrics_to_dict(const civ_soft_metrics_manager_t* sm) {
-    if (!sm) return NULL;
-    
-    char* json = (char*)CIV_MALLOC(512);
+#define SOFT_METRICS_DICT_SIZE 512
+
+static char* format_dict(const civ_soft_metrics_manager_t* sm, char* json) {
     if (!json) return NULL;
     
     civ_float_t happiness = civ_happiness_metrics_get_overall(&sm->happiness_metrics);
     civ_float_t legitimacy = civ_legitimacy_calculate_score(&sm->legitimacy_system);
     
-    snprintf(json, 512,
+    snprintf(json, SOFT_METRICS_DICT_SIZE,
         "{\"happiness\":%.3f,\"legitimacy\":%.3f,\"prestige\":%.3f,"
         "\"stability\":%.3f,\"corruption\":%.3f}",
         happiness, legitimacy, sm->prestige_system.prestige,
@@ -172,3 +154,13 @@ char* civ_soft_metrics_to_dict(const civ_soft_metrics_manager_t* sm) {
     return json;
 }
 
+char* civ_soft_metrics_to_dict(const civ_soft_metrics_manager_t* sm) {
+    if (!sm) return NULL;
+    return format_dict(sm, (char*)CIV_MALLOC(SOFT_METRICS_DICT_SIZE));
+}
+
+char* civ_soft_metrics_to_dict_arena(const civ_soft_metrics_manager_t* sm, civ_arena_t* arena) {
+    if (!sm) return NULL;
+    return format_dict(sm, (char*)civ_arena_push(arena, SOFT_METRICS_DICT_SIZE));
+}
+
@@ -4,10 +4,26 @@
  */
 
 #include "core/ai/ai_system.h"
+#include "core/game.h"
+#include "core/simulation_engine/system_orchestrator.h"
+#include "core/simulation_engine/worker_pool.h"
 #include "common.h"
+#include "utils/rng.h"
+#include "utils/store_registry.h"
+#include <SDL3/SDL.h>
 #include <stdlib.h>
 #include <string.h>
 
+#define AI_FRAME_BUDGET_MS   2.0f
+#define AI_TURN_BUDGET_MS    8.0f
+#define AI_FIXED_FRAME_STEPS 64
+#define AI_FIXED_TURN_STEPS  256
+#define AI_BORDER_RANGE      15.0f /* matches the border friction range */
+#define AI_ATTACK_MEMORY     3     /* turns an attack keeps an AI urgent */
+#define AI_AGING             0.5f  /* priority per slice waited */
+#define AI_STEP_NS_GUESS     20000.0f /* until a slice has been measured */
+#define AI_STEP_NS_SMOOTHING 0.25f
+
 civ_ai_system_t *civ_ai_system_create(void) {
   civ_ai_system_t *ai_system =
       (civ_ai_system_t *)CIV_MALLOC(sizeof(civ_ai_system_t));
@@ -17,6 +33,9 @@ civ_ai_system_t *civ_ai_system_create(void) {
   }
 
   civ_ai_system_init(ai_system);
+  CIV_STORE_REGISTER("ai.tasks", ai_system, ai_system->task_count,
+                     ai_system->task_capacity, sizeof(civ_ai_task_t),
+                     CIV_STORE_APPEND);
   return ai_system;
 }
 
@@ -24,6 +43,7 @@ void civ_ai_system_destroy(civ_ai_system_t *ai_system) {
   if (!ai_system)
     return;
 
+  civ_store_unregister_owner(ai_system);
   for (size_t i = 0; i < ai_system->strategic_count; i++) {
     civ_strategic_ai_destroy(ai_system->strategic_ais[i]);
   }
@@ -32,6 +52,8 @@ void civ_ai_system_destroy(civ_ai_system_t *ai_system) {
   }
   CIV_FREE(ai_system->strategic_ais);
   CIV_FREE(ai_system->tactical_ais);
+  CIV_FREE(ai_system->tasks);
+  CIV_FREE(ai_system->ranks);
   CIV_FREE(ai_system);
 }
 
@@ -46,6 +68,215 @@ void civ_ai_system_init(civ_ai_system_t *ai_system) {
       ai_system->strategic_capacity, sizeof(civ_strategic_ai_t *));
   ai_system->tactical_ais = (civ_tactical_ai_t **)CIV_CALLOC(
       ai_system->tactical_capacity, sizeof(civ_tactical_ai_t *));
+  ai_system->budget = (civ_ai_budget_t){AI_FRAME_BUDGET_MS, AI_TURN_BUDGET_MS,
+                                        AI_FIXED_FRAME_STEPS,
+                                        AI_FIXED_TURN_STEPS};
+  ai_system->step_ns = AI_STEP_NS_GUESS;
+}
+
+static bool add_task(civ_ai_system_t *ai_system, civ_ai_task_kind_t kind,
+                     size_t index) {
+  if (ai_system->task_count >= ai_system->task_capacity) {
+    size_t cap = ai_system->task_capacity ? ai_system->task_capacity * 2 : 32;
+    civ_ai_task_t *tasks =
+        CIV_REALLOC(ai_system->tasks, cap * sizeof(civ_ai_task_t));
+    if (!tasks)
+      return false;
+    ai_system->tasks = tasks;
+    civ_ai_rank_t *ranks =
+        CIV_REALLOC(ai_system->ranks, cap * sizeof(civ_ai_rank_t));
+    if (!ranks)
+      return false;
+    ai_system->ranks = ranks;
+    ai_system->task_capacity = cap;
+  }
+  civ_ai_task_t *t = &ai_system->tasks[ai_system->task_count++];
+  memset(t, 0, sizeof(*t));
+  t->kind = (uint8_t)kind;
+  t->index = (uint32_t)index;
+  t->expansion_turn = -1;
+  t->attacked_turn = -1;
+  return true;
+}
+
+/* ── Scheduling ────────────────────────────────────────────────────── */
+
+static const char *task_id(const civ_ai_system_t *ai_system,
+                           const civ_ai_task_t *t) {
+  const civ_base_ai_t *base =
+      t->kind == CIV_AI_TASK_STRATEGIC
+          ? ai_system->strategic_ais[t->index]->base_ai
+          : ai_system->tactical_ais[t->index]->base_ai;
+  return base ? base->id : "";
+}
+
+static float task_priority(const civ_ai_system_t *ai_system,
+                           const civ_ai_task_t *t, const civ_game_t *game) {
+  float p = 1.0f + (float)t->waited * AI_AGING;
+  if (game && t->attacked_turn >= 0 &&
+      game->current_turn - t->attacked_turn <= AI_ATTACK_MEMORY)
+    p += 3.0f;
+
+  if (t->kind == CIV_AI_TASK_TACTICAL) {
+    const civ_tactical_ai_t *ai = ai_system->tactical_ais[t->index];
+    int32_t best = civ_tactical_ai_get_best_action(ai);
+    return best >= 0 ? p + ai->actions.urgency[best] : p;
+  }
+
+  const civ_strategic_ai_t *ai = ai_system->strategic_ais[t->index];
+  if (ai->player_distance < AI_BORDER_RANGE)
+    p += 2.0f;
+  if (game && game->diplomacy_system && ai->base_ai) {
+    const civ_diplomacy_system_t *ds = game->diplomacy_system;
+    civ_relation_id_t rel =
+        civ_diplomacy_relation_id(ds, ai->base_ai->id, "PLAYER");
+    if (rel != CIV_RELATION_NONE &&
+        ds->rel.relation_level[rel] == CIV_RELATION_LEVEL_WAR)
+      p += 4.0f;
+  }
+  return p;
+}
+
+static int compare_ranks(const void *a, const void *b) {
+  const civ_ai_rank_t *ra = a, *rb = b;
+  if (ra->priority != rb->priority)
+    return ra->priority > rb->priority ? -1 : 1;
+  return ra->task < rb->task ? -1 : (ra->task > rb->task);
+}
+
+/* Steps left in the task's current cycle */
+static uint32_t steps_left(const civ_ai_task_t *t) {
+  if (t->kind == CIV_AI_TASK_TACTICAL)
+    return 1;
+  return (uint32_t)(CIV_STRATEGIC_STEP_COUNT - t->step) +
+         (t->expansion_turn >= 0 ? 1u : 0u);
+}
+
+/* Propose the task's next step; true when that finished its cycle */
+static bool run_step(civ_ai_system_t *ai_system, civ_ai_task_t *t,
+                     civ_game_t *game) {
+  if (t->kind == CIV_AI_TASK_TACTICAL) {
+    civ_tactical_ai_react(ai_system->tactical_ais[t->index], t->pending_dt);
+    t->pending_dt = 0.0;
+    return true;
+  }
+
+  civ_strategic_ai_t *ai = ai_system->strategic_ais[t->index];
+  if (t->step < CIV_STRATEGIC_STEP_COUNT) {
+    civ_strategic_ai_plan_step(ai, (civ_strategic_step_t)t->step,
+                               t->pending_dt);
+    if (t->step == CIV_STRATEGIC_STEP_THINK)
+      t->pending_dt = 0.0;
+    t->step++;
+    if (t->step < CIV_STRATEGIC_STEP_COUNT || t->expansion_turn >= 0)
+      return false;
+  } else if (t->expansion_turn >= 0 && game) {
+    /* Keyed by the turn it was owed for, whenever it gets to run; commit
+       keeps drawing from the same stream */
+    civ_rng_seed_key(&t->rng, civ_game_rng_seed(game), CIV_RNG_AI,
+                     (uint64_t)t->expansion_turn, t->index);
+    civ_strategic_ai_propose_expansion(ai, game);
+  }
+  t->expansion_turn = -1;
+  t->step = 0;
+  return true;
+}
+
+typedef struct {
+  civ_ai_system_t *ai_system;
+  civ_game_t *game;
+} slice_ctx_t;
+
+/* One ranked task's granted steps; runs on any worker */
+static void propose_task(void *ctx, int k) {
+  slice_ctx_t *c = ctx;
+  civ_ai_system_t *ai_system = c->ai_system;
+  civ_ai_task_t *t = &ai_system->tasks[ai_system->ranks[k].task];
+
+  /* Tactical ids live in their own half of the key space */
+  uint64_t entity = t->kind == CIV_AI_TASK_TACTICAL
+                        ? ((uint64_t)1 << 32) | t->index
+                        : t->index;
+  civ_rng_seed_key(&t->rng, c->game ? civ_game_rng_seed(c->game) : 0,
+                   CIV_RNG_AI,
+                   c->game ? (uint64_t)c->game->current_turn : 0, entity);
+  civ_rng_t *prev = civ_rng_bind(&t->rng);
+  for (uint32_t s = 0; s < t->quota; s++)
+    if (run_step(ai_system, t, c->game))
+      break;
+  civ_rng_bind(prev);
+}
+
+static void run_slice(civ_ai_system_t *ai_system, civ_float_t time_delta,
+                      float budget_ms, uint32_t fixed_steps) {
+  civ_game_t *game = (civ_game_t *)ai_system->game_ptr;
+  size_t n = ai_system->task_count;
+  ai_system->last_steps = 0;
+  ai_system->last_ms = 0.0f;
+  ai_system->backlog = 0;
+  if (n == 0)
+    return;
+
+  uint64_t start = SDL_GetTicksNS();
+  for (size_t i = 0; i < n; i++) {
+    civ_ai_task_t *t = &ai_system->tasks[i];
+    t->pending_dt += time_delta;
+    t->priority = task_priority(ai_system, t, game);
+    ai_system->ranks[i] = (civ_ai_rank_t){t->priority, (uint32_t)i};
+  }
+  qsort(ai_system->ranks, n, sizeof(civ_ai_rank_t), compare_ranks);
+
+  /* Wall time only when nothing replays this game or runs it in lockstep */
+  bool timed = !civ_game_deterministic(game);
+  uint32_t quota = fixed_steps;
+  if (timed)
+    quota = (uint32_t)MIN(MAX(budget_ms, 0.0f) * 1000000.0f /
+                              MAX(ai_system->step_ns, 1.0f),
+                          (float)UINT32_MAX);
+  quota = MAX(quota, 1u); /* the first step always runs */
+
+  /* At most one cycle per task per slice, handed out in rank order */
+  uint32_t steps = 0;
+  size_t served = 0;
+  for (; served < n && steps < quota; served++) {
+    civ_ai_task_t *t = &ai_system->tasks[ai_system->ranks[served].task];
+    uint32_t want = steps_left(t);
+    t->quota = (uint8_t)MIN(want, quota - steps);
+    steps += t->quota;
+    t->waited = 0;
+    if (t->quota < want)
+      ai_system->backlog++;  /* resumes mid-cycle next slice */
+  }
+  for (size_t k = served; k < n; k++)
+    ai_system->tasks[ai_system->ranks[k].task].waited++;
+
+  /* Propose: read-only against the world, one stream per task */
+  slice_ctx_t ctx = {ai_system, game};
+  civ_worker_pool_t *pool =
+      game ? civ_system_orchestrator_get_worker_pool(game->system_orchestrator)
+           : NULL;
+  civ_worker_pool_parallel_for(pool, (int)served, propose_task, &ctx);
+
+  /* Commit: one AI at a time, in rank order */
+  for (size_t k = 0; k < served && game; k++) {
+    civ_ai_task_t *t = &ai_system->tasks[ai_system->ranks[k].task];
+    if (t->kind != CIV_AI_TASK_STRATEGIC)
+      continue;
+    civ_strategic_ai_t *ai = ai_system->strategic_ais[t->index];
+    if (ai->pending.count == 0)
+      continue;
+    civ_rng_t *prev = civ_rng_bind(&t->rng);
+    civ_strategic_ai_commit(ai, game);
+    civ_rng_bind(prev);
+  }
+
+  ai_system->backlog += (uint32_t)(n - served);
+  ai_system->last_steps = steps;
+  uint64_t elapsed = SDL_GetTicksNS() - start;
+  ai_system->last_ms = (float)elapsed / 1000000.0f;
+  if (steps > 0)
+    ai_system->step_ns += ((float)elapsed / (float)steps -
+                           ai_system->step_ns) * AI_STEP_NS_SMOOTHING;
 }
 
 civ_result_t civ_ai_system_update(civ_ai_system_t *ai_system,
@@ -57,17 +288,38 @@ civ_result_t civ_ai_system_update(civ_ai_system_t *ai_system,
     return result;
   }
 
-  /* Update strategic AIs */
-  for (size_t i = 0; i < ai_system->strategic_count; i++) {
-    civ_strategic_ai_plan(ai_system->strategic_ais[i], time_delta);
-  }
+  run_slice(ai_system, time_delta, ai_system->budget.frame_budget_ms,
+            ai_system->budget.fixed_frame_steps);
+  return result;
+}
 
-  /* Update tactical AIs */
-  for (size_t i = 0; i < ai_system->tactical_count; i++) {
-    civ_tactical_ai_react(ai_system->tactical_ais[i], time_delta);
-  }
+civ_result_t civ_ai_system_end_turn(civ_ai_system_t *ai_system, int32_t turn) {
+  if (!ai_system)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, NULL};
 
-  return result;
+  for (size_t i = 0; i < ai_system->task_count; i++)
+    if (ai_system->tasks[i].kind == CIV_AI_TASK_STRATEGIC)
+      ai_system->tasks[i].expansion_turn = turn;
+  run_slice(ai_system, 1.0f, ai_system->budget.turn_budget_ms,
+            ai_system->budget.fixed_turn_steps);
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+void civ_ai_system_set_budget_scale(civ_ai_system_t *ai_system, float scale) {
+  if (!ai_system)
+    return;
+  scale = MAX(scale, 0.0f);
+  ai_system->budget.frame_budget_ms = AI_FRAME_BUDGET_MS * scale;
+  ai_system->budget.turn_budget_ms = AI_TURN_BUDGET_MS * scale;
+}
+
+void civ_ai_system_note_attacked(civ_ai_system_t *ai_system, const char *id,
+                                 int32_t turn) {
+  if (!ai_system || !id)
+    return;
+  for (size_t i = 0; i < ai_system->task_count; i++)
+    if (strcmp(task_id(ai_system, &ai_system->tasks[i]), id) == 0)
+      ai_system->tasks[i].attacked_turn = turn;
 }
 
 civ_result_t civ_ai_system_add_strategic(civ_ai_system_t *ai_system,
@@ -86,7 +338,8 @@ civ_result_t civ_ai_system_add_strategic(civ_ai_system_t *ai_system,
         ai_system->strategic_capacity * sizeof(civ_strategic_ai_t *));
   }
 
-  if (ai_system->strategic_ais) {
+  if (ai_system->strategic_ais &&
+      add_task(ai_system, CIV_AI_TASK_STRATEGIC, ai_system->strategic_count)) {
     ai->game_ptr = ai_system->game_ptr;
     ai_system->strategic_ais[ai_system->strategic_count++] = ai;
   } else {
@@ -112,7 +365,8 @@ civ_result_t civ_ai_system_add_tactical(civ_ai_system_t *ai_system,
         ai_system->tactical_capacity * sizeof(civ_tactical_ai_t *));
   }
 
-  if (ai_system->tactical_ais) {
+  if (ai_system->tactical_ais &&
+      add_task(ai_system, CIV_AI_TASK_TACTICAL, ai_system->tactical_count)) {
     ai_system->tactical_ais[ai_system->tactical_count++] = ai;
   } else {
     result.error = CIV_ERROR_OUT_OF_MEMORY;
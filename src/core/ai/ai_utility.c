@@ -0,0 +1,97 @@
+/**
+ * @file ai_utility.c
+ * @brief Batch utility scoring — SIMD lanes with a scalar tail
+ */
+#include "core/ai/ai_utility.h"
+#include <math.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CIV_AI_UTILITY_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CIV_AI_UTILITY_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CIV_AI_UTILITY_NEON 1
+#endif
+
+void civ_ai_utility_batch(const float *benefit, const float *cost,
+                          const float *urgency, float threshold, float *out,
+                          size_t n) {
+  size_t i = 0;
+#if defined(CIV_AI_UTILITY_AVX2)
+  __m256 vt = _mm256_set1_ps(threshold);
+  __m256 none = _mm256_set1_ps(-INFINITY);
+  for (; i + 8 <= n; i += 8) {
+    __m256 u = _mm256_loadu_ps(urgency + i);
+    __m256 s = _mm256_mul_ps(
+        _mm256_sub_ps(_mm256_loadu_ps(benefit + i), _mm256_loadu_ps(cost + i)), u);
+    _mm256_storeu_ps(out + i,
+                     _mm256_blendv_ps(none, s, _mm256_cmp_ps(u, vt, _CMP_GE_OQ)));
+  }
+#elif defined(CIV_AI_UTILITY_SSE2)
+  __m128 vt = _mm_set1_ps(threshold);
+  __m128 none = _mm_set1_ps(-INFINITY);
+  for (; i + 4 <= n; i += 4) {
+    __m128 u = _mm_loadu_ps(urgency + i);
+    __m128 s = _mm_mul_ps(
+        _mm_sub_ps(_mm_loadu_ps(benefit + i), _mm_loadu_ps(cost + i)), u);
+    __m128 keep = _mm_cmpge_ps(u, vt);
+    _mm_storeu_ps(out + i, _mm_or_ps(_mm_and_ps(keep, s), _mm_andnot_ps(keep, none)));
+  }
+#elif defined(CIV_AI_UTILITY_NEON)
+  float32x4_t vt = vdupq_n_f32(threshold);
+  float32x4_t none = vdupq_n_f32(-INFINITY);
+  for (; i + 4 <= n; i += 4) {
+    float32x4_t u = vld1q_f32(urgency + i);
+    float32x4_t s =
+        vmulq_f32(vsubq_f32(vld1q_f32(benefit + i), vld1q_f32(cost + i)), u);
+    vst1q_f32(out + i, vbslq_f32(vcgeq_f32(u, vt), s, none));
+  }
+#endif
+  for (; i < n; i++)
+    out[i] = urgency[i] >= threshold ? (benefit[i] - cost[i]) * urgency[i]
+                                     : -INFINITY;
+}
+
+/* Largest score; max is exact, so lane order does not matter */
+static float max_of(const float *score, size_t n) {
+  size_t i = 0;
+  float best = -INFINITY;
+#if defined(CIV_AI_UTILITY_AVX2)
+  if (n >= 8) {
+    __m256 m = _mm256_loadu_ps(score);
+    for (i = 8; i + 8 <= n; i += 8) m = _mm256_max_ps(m, _mm256_loadu_ps(score + i));
+    float lanes[8];
+    _mm256_storeu_ps(lanes, m);
+    for (int k = 0; k < 8; k++) best = lanes[k] > best ? lanes[k] : best;
+  }
+#elif defined(CIV_AI_UTILITY_SSE2)
+  if (n >= 4) {
+    __m128 m = _mm_loadu_ps(score);
+    for (i = 4; i + 4 <= n; i += 4) m = _mm_max_ps(m, _mm_loadu_ps(score + i));
+    float lanes[4];
+    _mm_storeu_ps(lanes, m);
+    for (int k = 0; k < 4; k++) best = lanes[k] > best ? lanes[k] : best;
+  }
+#elif defined(CIV_AI_UTILITY_NEON)
+  if (n >= 4) {
+    float32x4_t m = vld1q_f32(score);
+    for (i = 4; i + 4 <= n; i += 4) m = vmaxq_f32(m, vld1q_f32(score + i));
+    float lanes[4];
+    vst1q_f32(lanes, m);
+    for (int k = 0; k < 4; k++) best = lanes[k] > best ? lanes[k] : best;
+  }
+#endif
+  for (; i < n; i++) best = score[i] > best ? score[i] : best;
+  return best;
+}
+
+int32_t civ_ai_argmax(const float *score, size_t n) {
+  if (!score || n == 0) return -1;
+  float best = max_of(score, n);
+  for (size_t i = 0; i < n; i++)
+    if (score[i] == best) return (int32_t)i;
+  return 0; /* every score NaN */
+}
@@ -4,10 +4,39 @@
  */
 
 #include "core/ai/base_ai.h"
+#include "core/ai/ai_utility.h"
 #include "common.h"
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
+
+static void decisions_free(civ_ai_decisions_t* d) {
+    CIV_FREE(d->type);
+    CIV_FREE(d->target);
+    CIV_FREE(d->priority);
+    CIV_FREE(d->confidence);
+    CIV_FREE(d->timestamp);
+    memset(d, 0, sizeof(*d));
+}
+
+#define GROW_ARRAY(arr, cap)                                           \
+    do {                                                               \
+        void* grown = CIV_REALLOC((arr), (cap) * sizeof(*(arr)));      \
+        if (!grown) return false;                                      \
+        (arr) = grown;                                                 \
+    } while (0)
+
+static bool decisions_reserve(civ_ai_decisions_t* d, size_t count) {
+    if (count <= d->capacity) return true;
+    size_t cap = d->capacity ? d->capacity : 32;
+    while (cap < count) cap *= 2;
+    GROW_ARRAY(d->type, cap);
+    GROW_ARRAY(d->target, cap);
+    GROW_ARRAY(d->priority, cap);
+    GROW_ARRAY(d->confidence, cap);
+    GROW_ARRAY(d->timestamp, cap);
+    d->capacity = cap;
+    return true;
+}
 
 civ_base_ai_t* civ_base_ai_create(const char* id, const char* name) {
     if (!id || !name) return NULL;
@@ -24,7 +53,7 @@ civ_base_ai_t* civ_base_ai_create(const char* id, const char* name) {
 
 void civ_base_ai_destroy(civ_base_ai_t* ai) {
     if (!ai) return;
-    CIV_FREE(ai->decisions);
+    decisions_free(&ai->decisions);
     CIV_FREE(ai);
 }
 
@@ -44,10 +73,8 @@ void civ_base_ai_init(civ_base_ai_t* ai, const char* id, const char* name) {
     
     ai->intelligence = 0.5f;
     ai->adaptability = 0.5f;
-    ai->decision_capacity = 32;
-    ai->decisions = (civ_ai_decision_t*)CIV_CALLOC(ai->decision_capacity, sizeof(civ_ai_decision_t));
-    ai->creation_time = time(NULL);
-    ai->last_think = ai->creation_time;
+    if (!decisions_reserve(&ai->decisions, 32))
+        civ_log(CIV_LOG_WARNING, "No decision storage for AI %s", ai->id);
 }
 
 civ_result_t civ_base_ai_think(civ_base_ai_t* ai, civ_float_t time_delta) {
@@ -59,12 +86,13 @@ civ_result_t civ_base_ai_think(civ_base_ai_t* ai, civ_float_t time_delta) {
     }
     
     /* Clear old decisions */
-    ai->decision_count = 0;
+    ai->decisions.count = 0;
     
     /* AI thinking process (simplified) */
     /* In a full implementation, this would evaluate various factors and generate decisions */
     
-    ai->last_think = time(NULL);
+    if (time_delta > 0) ai->clock += time_delta;
+    ai->last_think = ai->clock;
     return result;
 }
 
@@ -78,40 +106,35 @@ civ_result_t civ_base_ai_make_decision(civ_base_ai_t* ai, const char* action_typ
     
     priority = CLAMP(priority, 0.0f, 1.0f);
     
-    /* Expand if needed */
-    if (ai->decision_count >= ai->decision_capacity) {
-        ai->decision_capacity *= 2;
-        ai->decisions = (civ_ai_decision_t*)CIV_REALLOC(ai->decisions,
-                                                       ai->decision_capacity * sizeof(civ_ai_decision_t));
-    }
-    
-    if (ai->decisions) {
-        civ_ai_decision_t* decision = &ai->decisions[ai->decision_count++];
-        strncpy(decision->action_type, action_type, sizeof(decision->action_type) - 1);
-        if (target) {
-            strncpy(decision->target, target, sizeof(decision->target) - 1);
-        }
-        decision->priority = priority;
-        decision->confidence = ai->intelligence;
-        decision->timestamp = time(NULL);
-    } else {
+    civ_ai_decisions_t* d = &ai->decisions;
+    if (!decisions_reserve(d, d->count + 1)) {
         result.error = CIV_ERROR_OUT_OF_MEMORY;
+        return result;
     }
     
+    size_t i = d->count++;
+    d->type[i] = civ_symbol_intern(action_type);
+    d->target[i] = civ_symbol_intern(target);
+    d->priority[i] = (float)priority;
+    d->confidence[i] = (float)ai->intelligence;
+    d->timestamp[i] = ai->clock;
     return result;
 }
 
-civ_ai_decision_t* civ_base_ai_get_best_decision(const civ_base_ai_t* ai) {
-    if (!ai || ai->decision_count == 0) return NULL;
-    
-    civ_ai_decision_t* best = &ai->decisions[0];
-    for (size_t i = 1; i < ai->decision_count; i++) {
-        if (ai->decisions[i].priority > best->priority) {
-            best = &ai->decisions[i];
-        }
-    }
-    
-    return best;
+int32_t civ_base_ai_get_best_decision(const civ_base_ai_t* ai) {
+    if (!ai) return -1;
+    return civ_ai_argmax(ai->decisions.priority, ai->decisions.count);
+}
+
+bool civ_base_ai_get_decision(const civ_base_ai_t* ai, size_t index, civ_ai_decision_t* out) {
+    if (!ai || !out || index >= ai->decisions.count) return false;
+    const civ_ai_decisions_t* d = &ai->decisions;
+    out->action_type = civ_symbol_name(d->type[index]);
+    out->target = civ_symbol_name(d->target[index]);
+    out->priority = d->priority[index];
+    out->confidence = d->confidence[index];
+    out->timestamp = d->timestamp[index];
+    return true;
 }
 
 void civ_base_ai_set_personality(civ_base_ai_t* ai, const civ_ai_personality_t* personality) {
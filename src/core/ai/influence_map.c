@@ -0,0 +1,377 @@
+/**
+ * @file influence_map.c
+ * @brief Influence layers — delta-fed cell sources, incremental separable blur
+ */
+#include "core/ai/influence_map.h"
+#include "core/simulation_engine/worker_pool.h"
+#include "common.h"
+#include <math.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CIV_INFLUENCE_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CIV_INFLUENCE_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CIV_INFLUENCE_NEON 1
+#endif
+
+#define BAND_ROWS   16 /* rows per refresh job */
+#define KERNEL_TAPS (2 * CIV_INFLUENCE_RADIUS + 1)
+#define NO_CELL     UINT32_MAX
+
+/* Binomial weights, row 6 of Pascal's triangle over 64 */
+static const float k_kernel[KERNEL_TAPS] = {
+    1.0f / 64, 6.0f / 64, 15.0f / 64, 20.0f / 64, 15.0f / 64, 6.0f / 64,
+    1.0f / 64};
+
+static const float k_scale[CIV_INFLUENCE_LAYER_COUNT] = {
+#define CIV_INFLUENCE_SCALE(id, scale) [CIV_INFLUENCE_##id] = (float)(scale),
+    CIV_INFLUENCE_LAYERS(CIV_INFLUENCE_SCALE)
+#undef CIV_INFLUENCE_SCALE
+};
+
+/* ── Rows ──────────────────────────────────────────────────────────── */
+
+/* out[i] += w * in[i] */
+static void row_madd(float *out, const float *in, float w, int32_t n) {
+  int32_t i = 0;
+#if CIV_INFLUENCE_AVX2
+  __m256 vw = _mm256_set1_ps(w);
+  for (; i + 8 <= n; i += 8)
+    _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(out + i),
+                                            _mm256_mul_ps(vw, _mm256_loadu_ps(in + i))));
+#elif CIV_INFLUENCE_SSE2
+  __m128 vw = _mm_set1_ps(w);
+  for (; i + 4 <= n; i += 4)
+    _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i),
+                                      _mm_mul_ps(vw, _mm_loadu_ps(in + i))));
+#elif CIV_INFLUENCE_NEON
+  float32x4_t vw = vdupq_n_f32(w);
+  for (; i + 4 <= n; i += 4)
+    vst1q_f32(out + i, vaddq_f32(vld1q_f32(out + i),
+                                 vmulq_f32(vw, vld1q_f32(in + i))));
+#endif
+  for (; i < n; i++) out[i] += w * in[i];
+}
+
+static float row_peak(const float *row, int32_t n) {
+  float peak = 0.0f;
+  for (int32_t i = 0; i < n; i++) peak = MAX(peak, row[i]);
+  return peak;
+}
+
+/* ── Sources ───────────────────────────────────────────────────────── */
+
+static uint32_t cell_at(const civ_influence_map_t *im, float x, float y) {
+  int32_t cx = (int32_t)floorf(x) >> CIV_INFLUENCE_CELL_SHIFT;
+  int32_t cy = (int32_t)floorf(y) >> CIV_INFLUENCE_CELL_SHIFT;
+  cx = CLAMP(cx, 0, im->cols - 1);
+  cy = CLAMP(cy, 0, im->rows - 1);
+  return (uint32_t)(cy * im->cols + cx);
+}
+
+static void source_add(civ_influence_map_t *im, civ_influence_layer_t layer,
+                       uint32_t cell, int64_t delta) {
+  if (cell == NO_CELL || delta == 0) return;
+  im->source[layer][cell] += delta;
+  im->row_dirty[layer][cell / (uint32_t)im->cols] = 1;
+}
+
+/* Owned land that touches a tile of another owner (x wraps, y does not) */
+static bool tile_is_border(const civ_map_t *m, size_t t) {
+  civ_owner_index_t own = civ_map_owner_at(m, t);
+  if (own == CIV_OWNER_NONE || civ_map_is_water_at(m, t)) return false;
+  int32_t x = (int32_t)(t % (size_t)m->width);
+  int32_t y = (int32_t)(t / (size_t)m->width);
+  size_t row = (size_t)y * m->width;
+  size_t nb[4];
+  int nn = 0;
+  nb[nn++] = row + (size_t)((x + 1) % m->width);
+  nb[nn++] = row + (size_t)((x - 1 + m->width) % m->width);
+  if (y > 0) nb[nn++] = t - m->width;
+  if (y + 1 < m->height) nb[nn++] = t + m->width;
+  for (int k = 0; k < nn; k++) {
+    civ_owner_index_t o = civ_map_owner_at(m, nb[k]);
+    if (o != CIV_OWNER_NONE && o != own) return true;
+  }
+  return false;
+}
+
+static void refresh_border(civ_influence_map_t *im, size_t t) {
+  const civ_map_t *m = im->map;
+  uint8_t now = tile_is_border(m, t) ? 1 : 0;
+  if (now == im->tile_border[t]) return;
+  im->tile_border[t] = now;
+  uint32_t cell = cell_at(im, (float)(t % (size_t)m->width),
+                          (float)(t / (size_t)m->width));
+  source_add(im, CIV_INFLUENCE_TENSION, cell, now ? 1 : -1);
+}
+
+static void owner_listener(void *user_data, const civ_map_t *map, size_t index,
+                           civ_owner_index_t old_owner,
+                           civ_owner_index_t new_owner) {
+  (void)old_owner;
+  (void)new_owner;
+  civ_influence_map_t *im = (civ_influence_map_t *)user_data;
+  int32_t x = (int32_t)(index % (size_t)map->width);
+  int32_t y = (int32_t)(index / (size_t)map->width);
+  size_t row = (size_t)y * map->width;
+  refresh_border(im, index);
+  refresh_border(im, row + (size_t)((x + 1) % map->width));
+  refresh_border(im, row + (size_t)((x - 1 + map->width) % map->width));
+  if (y > 0) refresh_border(im, index - map->width);
+  if (y + 1 < map->height) refresh_border(im, index + map->width);
+}
+
+static bool reserve(civ_influence_contribution_t **items, size_t *capacity,
+                    size_t count) {
+  if (count <= *capacity) return true;
+  size_t cap = *capacity ? *capacity : 64;
+  while (cap < count) cap *= 2;
+  civ_influence_contribution_t *grown =
+      CIV_REALLOC(*items, cap * sizeof(civ_influence_contribution_t));
+  if (!grown) return false;
+  for (size_t i = *capacity; i < cap; i++)
+    grown[i] = (civ_influence_contribution_t){NO_CELL, {0, 0}};
+  *items = grown;
+  *capacity = cap;
+  return true;
+}
+
+/* Move contribution c to (cell, value) for the given layers */
+static void contribute(civ_influence_map_t *im, civ_influence_contribution_t *c,
+                       const civ_influence_layer_t *layers, int layer_count,
+                       uint32_t cell, const int64_t *value) {
+  bool same = c->cell == cell;
+  for (int k = 0; k < layer_count && same; k++) same = c->value[k] == value[k];
+  if (same) return;
+  for (int k = 0; k < layer_count; k++) {
+    source_add(im, layers[k], c->cell, -c->value[k]);
+    source_add(im, layers[k], cell, value[k]);
+    c->value[k] = cell == NO_CELL ? 0 : value[k];
+  }
+  c->cell = cell;
+}
+
+static void sync_units(civ_influence_map_t *im, const civ_unit_manager_t *um) {
+  static const civ_influence_layer_t layers[] = {CIV_INFLUENCE_THREAT};
+  size_t n = um ? um->unit_count : 0;
+  if (!reserve(&im->units, &im->unit_capacity, n)) return;
+  for (size_t i = 0; i < n; i++) {
+    int64_t value[1] = {0};
+    uint32_t cell = NO_CELL;
+    if (um->strength[i] > 0) {
+      value[0] = llrint((double)um->strength[i] * um->units[i].combat_strength);
+      cell = cell_at(im, (float)um->x[i], (float)um->y[i]);
+    }
+    contribute(im, &im->units[i], layers, 1, cell, value);
+  }
+  /* Units past the end are gone */
+  for (size_t i = n; i < im->unit_count; i++)
+    contribute(im, &im->units[i], layers, 1, NO_CELL, (int64_t[1]){0});
+  im->unit_count = n;
+}
+
+static void sync_settlements(civ_influence_map_t *im,
+                             const civ_settlement_manager_t *sm) {
+  static const civ_influence_layer_t layers[] = {CIV_INFLUENCE_ECONOMY,
+                                                 CIV_INFLUENCE_CULTURE};
+  size_t n = sm ? sm->settlement_count : 0;
+  if (!reserve(&im->settlements, &im->settlement_capacity, n)) return;
+  for (size_t i = 0; i < n; i++) {
+    const civ_settlement_t *s = &sm->settlements[i];
+    int64_t value[2] = {
+        MAX(s->population, 0),
+        llrint((double)s->culture_yield * k_scale[CIV_INFLUENCE_CULTURE])};
+    contribute(im, &im->settlements[i], layers, 2, cell_at(im, s->x, s->y),
+               value);
+  }
+  for (size_t i = n; i < im->settlement_count; i++)
+    contribute(im, &im->settlements[i], layers, 2, NO_CELL,
+               (int64_t[2]){0, 0});
+  im->settlement_count = n;
+}
+
+/* ── Blur ──────────────────────────────────────────────────────────── */
+
+typedef struct {
+  civ_influence_map_t *im;
+  int32_t bands;
+} blur_ctx_t;
+
+/* Horizontal pass over the band's dirty rows; x wraps like the map */
+static void blur_across(void *ctx, int job) {
+  blur_ctx_t *c = ctx;
+  civ_influence_map_t *im = c->im;
+  int layer = job / c->bands;
+  int32_t y0 = (job % c->bands) * BAND_ROWS;
+  int32_t y1 = MIN(y0 + BAND_ROWS, im->rows);
+  int32_t cols = im->cols, r = CIV_INFLUENCE_RADIUS;
+  float *pad = im->scratch + (size_t)job * (size_t)(cols + 2 * r);
+  float inv = 1.0f / k_scale[layer];
+
+  for (int32_t y = y0; y < y1; y++) {
+    if (!im->row_dirty[layer][y]) continue;
+    const int64_t *src = im->source[layer] + (size_t)y * cols;
+    for (int32_t i = 0; i < cols + 2 * r; i++) {
+      int32_t x = ((i - r) % cols + cols) % cols;
+      pad[i] = (float)src[x] * inv;
+    }
+    float *out = im->across[layer] + (size_t)y * cols;
+    memset(out, 0, (size_t)cols * sizeof(float));
+    for (int k = 0; k < KERNEL_TAPS; k++) row_madd(out, pad + k, k_kernel[k], cols);
+  }
+}
+
+/* Vertical pass over the band's stale rows; nothing past the poles */
+static void blur_down(void *ctx, int job) {
+  blur_ctx_t *c = ctx;
+  civ_influence_map_t *im = c->im;
+  int layer = job / c->bands;
+  int32_t y0 = (job % c->bands) * BAND_ROWS;
+  int32_t y1 = MIN(y0 + BAND_ROWS, im->rows);
+  int32_t cols = im->cols;
+
+  for (int32_t y = y0; y < y1; y++) {
+    if (!im->row_stale[layer][y]) continue;
+    float *out = im->field[layer] + (size_t)y * cols;
+    memset(out, 0, (size_t)cols * sizeof(float));
+    for (int k = 0; k < KERNEL_TAPS; k++) {
+      int32_t sy = y + k - CIV_INFLUENCE_RADIUS;
+      if (sy < 0 || sy >= im->rows) continue;
+      row_madd(out, im->across[layer] + (size_t)sy * cols, k_kernel[k], cols);
+    }
+    im->row_max[layer][y] = row_peak(out, cols);
+  }
+}
+
+static void blur(civ_influence_map_t *im, struct civ_worker_pool *pool) {
+  bool any = false;
+  for (int l = 0; l < CIV_INFLUENCE_LAYER_COUNT; l++) {
+    uint8_t *dirty = im->row_dirty[l], *stale = im->row_stale[l];
+    for (int32_t y = 0; y < im->rows; y++) {
+      if (!dirty[y]) continue;
+      any = true;
+      int32_t lo = MAX(y - CIV_INFLUENCE_RADIUS, 0);
+      int32_t hi = MIN(y + CIV_INFLUENCE_RADIUS, im->rows - 1);
+      for (int32_t s = lo; s <= hi; s++) stale[s] = 1;
+    }
+  }
+  if (!any) return;
+
+  blur_ctx_t ctx = {im, (im->rows + BAND_ROWS - 1) / BAND_ROWS};
+  int jobs = ctx.bands * CIV_INFLUENCE_LAYER_COUNT;
+  civ_worker_pool_parallel_for(pool, jobs, blur_across, &ctx);
+  civ_worker_pool_parallel_for(pool, jobs, blur_down, &ctx);
+
+  for (int l = 0; l < CIV_INFLUENCE_LAYER_COUNT; l++) {
+    memset(im->row_dirty[l], 0, (size_t)im->rows);
+    memset(im->row_stale[l], 0, (size_t)im->rows);
+    im->max[l] = row_peak(im->row_max[l], im->rows);
+  }
+  im->revision++;
+}
+
+/* ── Lifecycle ─────────────────────────────────────────────────────── */
+
+civ_influence_map_t *civ_influence_map_create(civ_map_t *map) {
+  if (!map || !map->tiles || map->width <= 0 || map->height <= 0) return NULL;
+  civ_influence_map_t *im = CIV_CALLOC(1, sizeof(civ_influence_map_t));
+  if (!im) {
+    civ_log(CIV_LOG_ERROR, "Failed to allocate influence map");
+    return NULL;
+  }
+  im->map = map;
+  im->cols = (map->width + CIV_INFLUENCE_CELL_SIZE - 1) >> CIV_INFLUENCE_CELL_SHIFT;
+  im->rows = (map->height + CIV_INFLUENCE_CELL_SIZE - 1) >> CIV_INFLUENCE_CELL_SHIFT;
+  size_t cells = (size_t)im->cols * im->rows;
+  size_t tiles = (size_t)map->width * map->height;
+  size_t jobs = (size_t)((im->rows + BAND_ROWS - 1) / BAND_ROWS) *
+                CIV_INFLUENCE_LAYER_COUNT;
+
+  bool ok = true;
+  for (int l = 0; l < CIV_INFLUENCE_LAYER_COUNT; l++) {
+    im->source[l] = CIV_CALLOC(cells, sizeof(int64_t));
+    im->across[l] = CIV_CALLOC(cells, sizeof(float));
+    im->field[l] = CIV_CALLOC(cells, sizeof(float));
+    im->row_max[l] = CIV_CALLOC((size_t)im->rows, sizeof(float));
+    im->row_dirty[l] = CIV_CALLOC((size_t)im->rows, 1);
+    im->row_stale[l] = CIV_CALLOC((size_t)im->rows, 1);
+    ok = ok && im->source[l] && im->across[l] && im->field[l] &&
+         im->row_max[l] && im->row_dirty[l] && im->row_stale[l];
+  }
+  im->scratch = CIV_CALLOC(jobs * (size_t)(im->cols + 2 * CIV_INFLUENCE_RADIUS),
+                           sizeof(float));
+  im->tile_border = CIV_CALLOC(tiles, 1);
+  if (!ok || !im->scratch || !im->tile_border) {
+    civ_log(CIV_LOG_ERROR, "Failed to allocate influence layers");
+    civ_influence_map_destroy(im);
+    return NULL;
+  }
+
+  for (size_t t = 0; t < tiles; t++) refresh_border(im, t);
+  if (!civ_map_add_owner_listener(map, owner_listener, im))
+    civ_log(CIV_LOG_WARNING, "Influence map: owner listener table full");
+  return im;
+}
+
+void civ_influence_map_destroy(civ_influence_map_t *im) {
+  if (!im) return;
+  civ_map_remove_owner_listener(im->map, owner_listener, im);
+  for (int l = 0; l < CIV_INFLUENCE_LAYER_COUNT; l++) {
+    CIV_FREE(im->source[l]);
+    CIV_FREE(im->across[l]);
+    CIV_FREE(im->field[l]);
+    CIV_FREE(im->row_max[l]);
+    CIV_FREE(im->row_dirty[l]);
+    CIV_FREE(im->row_stale[l]);
+  }
+  CIV_FREE(im->scratch);
+  CIV_FREE(im->tile_border);
+  CIV_FREE(im->units);
+  CIV_FREE(im->settlements);
+  CIV_FREE(im);
+}
+
+void civ_influence_map_refresh(civ_influence_map_t *im,
+                               const civ_unit_manager_t *units,
+                               const civ_settlement_manager_t *settlements,
+                               struct civ_worker_pool *pool) {
+  if (!im) return;
+  sync_units(im, units);
+  sync_settlements(im, settlements);
+  blur(im, pool);
+}
+
+/* ── Queries ───────────────────────────────────────────────────────── */
+
+float civ_influence_map_sample(const civ_influence_map_t *im,
+                               civ_influence_layer_t layer, float x, float y) {
+  if (!im || layer < 0 || layer >= CIV_INFLUENCE_LAYER_COUNT) return 0.0f;
+  float fx = x / CIV_INFLUENCE_CELL_SIZE - 0.5f;
+  float fy = y / CIV_INFLUENCE_CELL_SIZE - 0.5f;
+  float gx = floorf(fx), gy = floorf(fy);
+  float tx = fx - gx, ty = fy - gy;
+  int32_t x0 = (((int32_t)gx % im->cols) + im->cols) % im->cols;
+  int32_t x1 = (x0 + 1) % im->cols;
+  int32_t y0 = CLAMP((int32_t)gy, 0, im->rows - 1);
+  int32_t y1 = CLAMP((int32_t)gy + 1, 0, im->rows - 1);
+  const float *f = im->field[layer];
+  float top = f[y0 * im->cols + x0] + (f[y0 * im->cols + x1] - f[y0 * im->cols + x0]) * tx;
+  float bot = f[y1 * im->cols + x0] + (f[y1 * im->cols + x1] - f[y1 * im->cols + x0]) * tx;
+  return top + (bot - top) * ty;
+}
+
+float civ_influence_map_sample_norm(const civ_influence_map_t *im,
+                                    civ_influence_layer_t layer, float x,
+                                    float y) {
+  if (!im || layer < 0 || layer >= CIV_INFLUENCE_LAYER_COUNT ||
+      im->max[layer] <= 0.0f)
+    return 0.0f;
+  return CLAMP(civ_influence_map_sample(im, layer, x, y) / im->max[layer],
+               0.0f, 1.0f);
+}
@@ -5,11 +5,13 @@
 
 #include "core/ai/strategic_ai.h"
 #include "core/game.h"
+#include "core/military/combat.h"
 #include "core/world/map_generator.h"
 #include "core/world/settlement_manager.h"
+#include "core/world/site_field.h"
+#include "utils/rng.h"
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 
 civ_strategic_ai_t *civ_strategic_ai_create(const char *id, const char *name) {
   civ_strategic_ai_t *ai =
@@ -31,6 +33,7 @@ void civ_strategic_ai_destroy(civ_strategic_ai_t *ai) {
     civ_base_ai_destroy(ai->base_ai);
   }
   CIV_FREE(ai->goals);
+  CIV_FREE(ai->pending.items);
   CIV_FREE(ai);
 }
 
@@ -43,11 +46,12 @@ void civ_strategic_ai_init(civ_strategic_ai_t *ai, const char *id,
   ai->base_ai = civ_base_ai_create(id, name);
   ai->planning_horizon = 10.0f; /* 10 years */
   ai->risk_tolerance = 0.5f;
+  ai->player_distance = 1000.0f;
   ai->goal_capacity = 16;
   ai->goals = (civ_strategic_goal_t *)CIV_CALLOC(ai->goal_capacity,
                                                  sizeof(civ_strategic_goal_t));
 
-  ai->personality = (civ_personality_type_t)(rand() % 4);
+  ai->personality = (civ_personality_type_t)(civ_rand() % 4);
   ai->last_expansion_turn = 0;
   ai->expansion_frequency = (ai->personality == CIV_PERSONALITY_EXPANSIONIST ||
                              ai->personality == CIV_PERSONALITY_CULTURAL)
@@ -60,21 +64,63 @@ void civ_strategic_ai_init(civ_strategic_ai_t *ai, const char *id,
 
 civ_result_t civ_strategic_ai_plan(civ_strategic_ai_t *ai,
                                    civ_float_t time_delta) {
-  civ_result_t result = {CIV_OK, NULL};
+  if (!ai)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, NULL};
+  for (int step = 0; step < CIV_STRATEGIC_STEP_COUNT; step++)
+    civ_strategic_ai_plan_step(ai, (civ_strategic_step_t)step, time_delta);
+  return civ_strategic_ai_commit(ai, ai->game_ptr);
+}
 
-  if (!ai) {
-    result.error = CIV_ERROR_NULL_POINTER;
-    return result;
+/* ── Proposals ─────────────────────────────────────────────────────── */
+
+static civ_ai_action_t *propose(civ_strategic_ai_t *ai,
+                                civ_ai_action_kind_t kind) {
+  civ_ai_actions_t *list = &ai->pending;
+  if (list->count >= list->capacity) {
+    size_t cap = list->capacity ? list->capacity * 2 : 8;
+    civ_ai_action_t *items =
+        CIV_REALLOC(list->items, cap * sizeof(civ_ai_action_t));
+    if (!items)
+      return NULL;
+    list->items = items;
+    list->capacity = cap;
   }
+  civ_ai_action_t *a = &list->items[list->count++];
+  memset(a, 0, sizeof(*a));
+  a->kind = (uint8_t)kind;
+  return a;
+}
 
-  /* Update base AI thinking */
-  if (ai->base_ai) {
-    civ_base_ai_think(ai->base_ai, time_delta);
+static void propose_goal(civ_strategic_ai_t *ai, const char *type,
+                         const char *description, civ_float_t priority) {
+  civ_ai_action_t *a = propose(ai, CIV_AI_ACTION_ADD_GOAL);
+  if (a) {
+    a->goal.type = type;
+    a->goal.description = description;
+    a->goal.priority = priority;
+  }
+}
+
+/* The stance this AI has proposed for rel, else the committed one */
+static uint8_t proposed_stance(const civ_strategic_ai_t *ai,
+                               const civ_diplomacy_system_t *ds,
+                               civ_relation_id_t rel) {
+  for (size_t i = ai->pending.count; i-- > 0;) {
+    const civ_ai_action_t *a = &ai->pending.items[i];
+    if (a->kind == CIV_AI_ACTION_SET_RELATION && a->relation.id == rel)
+      return a->relation.stance;
   }
+  return ds->rel.current_stance[rel];
+}
+
+static civ_result_t propose_threats(civ_strategic_ai_t *ai, void *game_ptr);
 
-  /* Phase 10: Evaluate threats and update stance */
-  civ_strategic_ai_evaluate_threats(ai, ai->game_ptr);
+static int32_t current_turn(const civ_strategic_ai_t *ai) {
+  const civ_game_t *game = (const civ_game_t *)ai->game_ptr;
+  return game ? game->current_turn : 0;
+}
 
+static void plan_goals(civ_strategic_ai_t *ai) {
   /* Adjust risk tolerance by personality */
   if (ai->personality == CIV_PERSONALITY_AGGRESSIVE) {
     ai->risk_tolerance = 0.8f;
@@ -86,39 +132,69 @@ civ_result_t civ_strategic_ai_plan(civ_strategic_ai_t *ai,
 
   /* Personality-specific goal planning, modified by stance */
   if (ai->goal_count < 3) {
-    civ_diplomatic_relation_t *rel = civ_diplomacy_system_get_relation(
-        ((civ_game_t *)ai->game_ptr)->diplomacy_system, ai->base_ai->id,
-        "PLAYER");
+    civ_diplomacy_system_t *ds = ((civ_game_t *)ai->game_ptr)->diplomacy_system;
+    civ_relation_id_t rel =
+        civ_diplomacy_relation_id(ds, ai->base_ai->id, "PLAYER");
 
-    if (rel && (rel->current_stance == CIV_STANCE_HOSTILE ||
-                rel->current_stance == CIV_STANCE_WARY)) {
-      civ_strategic_ai_add_goal(ai, "Military", "Prepare for conflict", 0.95f);
+    uint8_t stance = rel != CIV_RELATION_NONE
+                         ? proposed_stance(ai, ds, rel)
+                         : CIV_STANCE_NEUTRAL;
+
+    if (stance == CIV_STANCE_HOSTILE || stance == CIV_STANCE_WARY) {
+      propose_goal(ai, "Military", "Prepare for conflict", 0.95f);
     } else if (ai->personality == CIV_PERSONALITY_EXPANSIONIST) {
-      civ_strategic_ai_add_goal(ai, "Expansion", "Found new settlements", 0.9f);
+      propose_goal(ai, "Expansion", "Found new settlements", 0.9f);
     } else if (ai->personality == CIV_PERSONALITY_AGGRESSIVE) {
-      civ_strategic_ai_add_goal(ai, "Military", "Build up forces", 0.8f);
+      propose_goal(ai, "Military", "Build up forces", 0.8f);
     } else if (ai->personality == CIV_PERSONALITY_MERCANTILE) {
-      civ_strategic_ai_add_goal(ai, "Trade", "Establish trade routes", 0.7f);
+      propose_goal(ai, "Trade", "Establish trade routes", 0.7f);
     } else if (ai->personality == CIV_PERSONALITY_CULTURAL) {
-      civ_strategic_ai_add_goal(ai, "Culture", "Achieve Cultural Hegemony",
-                                0.95f);
+      propose_goal(ai, "Culture", "Achieve Cultural Hegemony", 0.95f);
     }
   }
 
-  /* Update goal progress */
-  time_t now = time(NULL);
+  /* Remove completed or expired goals, keeping the rest in order */
+  int32_t turn = current_turn(ai);
+  size_t kept = 0;
   for (size_t i = 0; i < ai->goal_count; i++) {
-    civ_strategic_goal_t *goal = &ai->goals[i];
-
-    /* Remove completed or expired goals */
+    const civ_strategic_goal_t *goal = &ai->goals[i];
     if (goal->progress >= 1.0f ||
-        (goal->deadline > 0 && now > goal->deadline)) {
-      /* Remove goal */
-      memmove(&ai->goals[i], &ai->goals[i + 1],
-              (ai->goal_count - i - 1) * sizeof(civ_strategic_goal_t));
-      ai->goal_count--;
-      i--;
+        (goal->deadline_turn > 0 && turn > goal->deadline_turn))
+      continue;
+    if (kept != i)
+      ai->goals[kept] = *goal;
+    kept++;
+  }
+  ai->goal_count = kept;
+}
+
+civ_result_t civ_strategic_ai_plan_step(civ_strategic_ai_t *ai,
+                                        civ_strategic_step_t step,
+                                        civ_float_t time_delta) {
+  civ_result_t result = {CIV_OK, NULL};
+
+  if (!ai) {
+    result.error = CIV_ERROR_NULL_POINTER;
+    return result;
+  }
+
+  switch (step) {
+  case CIV_STRATEGIC_STEP_THINK:
+    /* Update base AI thinking */
+    if (ai->base_ai) {
+      civ_base_ai_think(ai->base_ai, time_delta);
     }
+    break;
+  case CIV_STRATEGIC_STEP_THREATS:
+    /* Phase 10: Evaluate threats and update stance */
+    propose_threats(ai, ai->game_ptr);
+    break;
+  case CIV_STRATEGIC_STEP_GOALS:
+    plan_goals(ai);
+    break;
+  default:
+    result.error = CIV_ERROR_INVALID_ARGUMENT;
+    break;
   }
 
   return result;
@@ -146,14 +222,16 @@ civ_result_t civ_strategic_ai_add_goal(civ_strategic_ai_t *ai,
 
   if (ai->goals) {
     civ_strategic_goal_t *goal = &ai->goals[ai->goal_count++];
+    memset(goal, 0, sizeof(*goal));
     strncpy(goal->goal_type, goal_type, sizeof(goal->goal_type) - 1);
+    goal->goal_sym = civ_symbol_intern(goal->goal_type);
     if (description) {
       strncpy(goal->description, description, sizeof(goal->description) - 1);
     }
     goal->priority = priority;
     goal->progress = 0.0f;
-    goal->deadline = 0; /* No deadline by default */
-    goal->created = time(NULL);
+    goal->deadline_turn = 0; /* No deadline by default */
+    goal->created_turn = current_turn(ai);
   } else {
     result.error = CIV_ERROR_OUT_OF_MEMORY;
   }
@@ -195,7 +273,7 @@ civ_result_t civ_strategic_ai_update_goal(civ_strategic_ai_t *ai,
   return result;
 }
 
-civ_result_t civ_strategic_ai_process_expansion(civ_strategic_ai_t *ai,
+civ_result_t civ_strategic_ai_propose_expansion(civ_strategic_ai_t *ai,
                                                 void *game_ptr) {
   civ_game_t *game = (civ_game_t *)game_ptr;
   if (!ai || !game)
@@ -206,84 +284,187 @@ civ_result_t civ_strategic_ai_process_expansion(civ_strategic_ai_t *ai,
     return (civ_result_t){CIV_OK, "Cooldown"};
   }
 
-  /* Strategy: Find a suitable site near existing Rival cities or units */
-  /* For simplicity, scan around (30, 30) or any settlement belonging to Rival
-   */
-  civ_float_t search_x = 30.0f;
-  civ_float_t search_y = 30.0f;
-
-  /* Find a random spot within 10 units */
-  for (int attempts = 0; attempts < 10; attempts++) {
-    float ox = (float)(rand() % 20 - 10);
-    float oy = (float)(rand() % 20 - 10);
-    float tx = search_x + ox;
-    float ty = search_y + oy;
-
-    /* Check suitability - Cultural AI is slightly less picky but values culture
-     */
-    float fitness = civ_calculate_site_suitability(tx, ty);
-    float threshold =
-        (ai->personality == CIV_PERSONALITY_CULTURAL) ? 0.65f : 0.75f;
-
-    if (fitness > threshold) {
-      civ_result_t res =
-          civ_attempt_settlement_spawn(game->settlement_manager, tx, ty);
-      if (res.error == CIV_OK) {
-        printf(
-            "[AI] %s founded a new settlement at %.1f, %.1f (Fitness: %.2f)\n",
-            ai->base_ai->name, tx, ty, fitness);
-        ai->last_expansion_turn = game->current_turn;
-
-        /* Update goal progress if expansion or culture was a goal */
-        for (size_t i = 0; i < ai->goal_count; i++) {
-          if (strcmp(ai->goals[i].goal_type, "Expansion") == 0 ||
-              strcmp(ai->goals[i].goal_type, "Culture") == 0) {
-            ai->goals[i].progress += 0.34f; /* 3 settlements to complete goal */
-          }
-        }
-        return res;
+  /* Cultural AIs are slightly less picky */
+  civ_ai_action_t *a = propose(ai, CIV_AI_ACTION_FOUND_SETTLEMENT);
+  if (!a)
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
+  a->site.threshold =
+      (ai->personality == CIV_PERSONALITY_CULTURAL) ? 0.3f : 0.4f;
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+civ_result_t civ_strategic_ai_process_expansion(civ_strategic_ai_t *ai,
+                                                void *game_ptr) {
+  civ_result_t res = civ_strategic_ai_propose_expansion(ai, game_ptr);
+  if (res.error != CIV_OK)
+    return res;
+  return civ_strategic_ai_commit(ai, game_ptr);
+}
+
+/* ── Commit ────────────────────────────────────────────────────────── */
+
+#define EXPANSION_CANDIDATES 8
+
+/* Fitness of a site-field candidate for this AI: drawn to trade, wary of
+   armies and contested borders */
+static float site_fitness(const civ_strategic_ai_t *ai,
+                          const civ_influence_map_t *im, const civ_site_t *s) {
+  float economy = civ_influence_map_sample_norm(im, CIV_INFLUENCE_ECONOMY, s->x, s->y);
+  float culture = civ_influence_map_sample_norm(im, CIV_INFLUENCE_CULTURE, s->x, s->y);
+  float threat = civ_influence_map_sample_norm(im, CIV_INFLUENCE_THREAT, s->x, s->y);
+  float tension = civ_influence_map_sample_norm(im, CIV_INFLUENCE_TENSION, s->x, s->y);
+  float culture_weight =
+      (ai->personality == CIV_PERSONALITY_CULTURAL) ? 0.3f : 0.0f;
+  float fitness = s->score * (1.0f + 0.3f * economy + culture_weight * culture -
+                              0.4f * threat - 0.2f * tension);
+  return CLAMP(fitness, 0.0f, 1.0f);
+}
+
+/* Settle the fittest of the top few site-field candidates near the AI's
+   own settlements, then anywhere; the rest go back to their heaps */
+static void commit_expansion(civ_strategic_ai_t *ai, civ_game_t *game,
+                             const civ_ai_action_t *a) {
+  civ_settlement_manager_t *sm = game->settlement_manager;
+  civ_site_field_t *sf = game->site_field;
+  if (!sm || !sf)
+    return;
+
+  civ_site_t sites[EXPANSION_CANDIDATES];
+  int32_t from[EXPANSION_CANDIDATES];
+  float fitness[EXPANSION_CANDIDATES];
+  size_t count = 0;
+  civ_site_t again[EXPANSION_CANDIDATES]; /* open-heap copies of own picks */
+  size_t again_count = 0;
+  int32_t own = civ_settlement_manager_owner_index(sm, ai->base_ai->id);
+  int32_t heaps[2] = {own, CIV_SITE_OPEN};
+  for (int h = own >= 0 ? 0 : 1; h < 2; h++) {
+    civ_site_t s;
+    while (count < EXPANSION_CANDIDATES && civ_site_field_pop(sf, heaps[h], &s)) {
+      bool seen = false;
+      for (size_t k = 0; k < count && !seen; k++)
+        seen = sites[k].entry.cell == s.entry.cell;
+      if (seen) {
+        /* An own-heap repeat has its copy returned below; the open heap
+           holds one entry per cell, so keep that one */
+        if (heaps[h] == CIV_SITE_OPEN && again_count < EXPANSION_CANDIDATES)
+          again[again_count++] = s;
+        continue;
+      }
+      sites[count] = s;
+      from[count] = heaps[h];
+      fitness[count++] = site_fitness(ai, game->influence_map, &s);
+    }
+  }
+
+  /* Insertion sort, stable so equal sites keep their heap order */
+  size_t order[EXPANSION_CANDIDATES];
+  for (size_t i = 0; i < count; i++) {
+    size_t j = i;
+    for (; j > 0 && fitness[order[j - 1]] < fitness[i]; j--)
+      order[j] = order[j - 1];
+    order[j] = i;
+  }
+
+  bool founded = false;
+  for (size_t k = 0; k < count; k++) {
+    const civ_site_t *s = &sites[order[k]];
+    if (founded || fitness[order[k]] <= a->site.threshold ||
+        civ_settlement_manager_found(sm, s->x, s->y, s->score,
+                                     ai->base_ai->id).error != CIV_OK) {
+      civ_site_field_push_back(sf, from[order[k]], s);
+      continue;
+    }
+    founded = true;
+    printf("[AI] %s founded a new settlement at %.1f, %.1f (Fitness: %.2f)\n",
+           ai->base_ai->name, s->x, s->y, fitness[order[k]]);
+    ai->last_expansion_turn = game->current_turn;
+
+    /* Update goal progress if expansion or culture was a goal */
+    for (size_t g = 0; g < ai->goal_count; g++) {
+      civ_symbol_t sym = ai->goals[g].goal_sym;
+      if (sym == CIV_SYM_EXPANSION || sym == CIV_SYM_CULTURE) {
+        ai->goals[g].progress += 0.34f; /* 3 settlements to complete goal */
       }
     }
   }
 
-  return (civ_result_t){CIV_OK, "No suitable site found"};
+  for (size_t k = 0; k < again_count; k++)
+    civ_site_field_push_back(sf, CIV_SITE_OPEN, &again[k]);
+
+  /* Respace around the new settlement before the next AI commits */
+  if (founded)
+    civ_site_field_refresh(sf, game->world_map, sm);
 }
 
-civ_result_t civ_strategic_ai_evaluate_threats(civ_strategic_ai_t *ai,
-                                               void *game_ptr) {
+civ_result_t civ_strategic_ai_commit(civ_strategic_ai_t *ai, void *game_ptr) {
+  civ_game_t *game = (civ_game_t *)game_ptr;
+  if (!ai || !game)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null args"};
+
+  civ_diplomacy_system_t *ds = game->diplomacy_system;
+  civ_ai_actions_t *list = &ai->pending;
+  for (size_t i = 0; i < list->count;) {
+    const civ_ai_action_t *a = &list->items[i];
+    switch ((civ_ai_action_kind_t)a->kind) {
+    case CIV_AI_ACTION_SET_RELATION:
+      if (ds && a->relation.id >= 0 &&
+          (size_t)a->relation.id < ds->relation_count) {
+        ds->rel.opinion_score[a->relation.id] = a->relation.opinion;
+        ds->rel.current_stance[a->relation.id] = a->relation.stance;
+      }
+      i++;
+      break;
+    case CIV_AI_ACTION_ADD_GOAL:
+      civ_strategic_ai_add_goal(ai, a->goal.type, a->goal.description,
+                                a->goal.priority);
+      i++;
+      break;
+    case CIV_AI_ACTION_FOUND_SETTLEMENT:
+      commit_expansion(ai, game, a);
+      i++;
+      break;
+    default:
+      i++;
+      break;
+    }
+  }
+  list->count = 0;
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+static civ_result_t propose_threats(civ_strategic_ai_t *ai, void *game_ptr) {
   civ_game_t *game = (civ_game_t *)game_ptr;
   if (!ai || !game || !game->diplomacy_system)
     return (civ_result_t){CIV_ERROR_NULL_POINTER, "Missing components"};
 
   /* Get relation with PLAYER */
-  civ_diplomatic_relation_t *rel = civ_diplomacy_system_get_relation(
-      game->diplomacy_system, ai->base_ai->id, "PLAYER");
+  civ_diplomacy_system_t *ds = game->diplomacy_system;
+  civ_relation_id_t rel =
+      civ_diplomacy_relation_id(ds, ai->base_ai->id, "PLAYER");
 
-  if (!rel)
+  if (rel == CIV_RELATION_NONE)
     return (civ_result_t){CIV_OK, "No relation with player"};
 
   /* 1. Calculate Border Friction */
   float min_dist = 1000.0f;
-  if (game->settlement_manager) {
-    for (size_t i = 0; i < game->settlement_manager->settlement_count; i++) {
-      civ_settlement_t *s1 = &game->settlement_manager->settlements[i];
-      if (strcmp(s1->region_id, ai->base_ai->id) != 0)
+  civ_settlement_manager_t *sm = game->settlement_manager;
+  int32_t own = civ_settlement_manager_owner_index(sm, ai->base_ai->id);
+  int32_t player = civ_settlement_manager_owner_index(sm, "PLAYER");
+  if (own >= 0 && player >= 0) {
+    for (size_t i = 0; i < sm->settlement_count; i++) {
+      civ_settlement_t *s1 = &sm->settlements[i];
+      if (s1->owner_index != own)
         continue;
 
-      for (size_t j = 0; j < game->settlement_manager->settlement_count; j++) {
-        civ_settlement_t *s2 = &game->settlement_manager->settlements[j];
-        if (strcmp(s2->region_id, "PLAYER") != 0)
-          continue;
-
-        float dx = s1->x - s2->x;
-        float dy = s1->y - s2->y;
-        float d = sqrtf(dx * dx + dy * dy);
-        if (d < min_dist)
-          min_dist = d;
-      }
+      civ_float_t d;
+      if (civ_settlement_manager_nearest(sm, player, s1->x, s1->y, &d) &&
+          d < min_dist)
+        min_dist = d;
     }
   }
 
+  ai->player_distance = min_dist;
+
   /* Opinion modifiers */
   float border_penalty = (min_dist < 15.0f) ? (15.0f - min_dist) * 2.0f : 0.0f;
 
@@ -296,52 +477,163 @@ civ_result_t civ_strategic_ai_evaluate_threats(civ_strategic_ai_t *ai,
 
   /* 3. Update Opinion Score */
   /* Drift toward 0, then apply penalties */
-  rel->opinion_score = rel->opinion_score * 0.95f;
-  rel->opinion_score -= border_penalty;
-  rel->opinion_score += power_factor;
+  civ_float_t opinion = ds->rel.opinion_score[rel];
+  opinion = opinion * 0.95f;
+  opinion -= border_penalty;
+  opinion += power_factor;
 
   /* Clamp */
-  rel->opinion_score = CLAMP(rel->opinion_score, -100.0f, 100.0f);
+  opinion = CLAMP(opinion, -100.0f, 100.0f);
 
   /* 4. Update Stance based on Opinion */
-  if (rel->opinion_score < -50.0f) {
-    rel->current_stance = CIV_STANCE_HOSTILE;
-  } else if (rel->opinion_score < -10.0f) {
-    rel->current_stance = CIV_STANCE_WARY;
-  } else if (rel->opinion_score > 40.0f) {
-    rel->current_stance = CIV_STANCE_FRIENDLY;
+  uint8_t stance;
+  if (opinion < -50.0f) {
+    stance = CIV_STANCE_HOSTILE;
+  } else if (opinion < -10.0f) {
+    stance = CIV_STANCE_WARY;
+  } else if (opinion > 40.0f) {
+    stance = CIV_STANCE_FRIENDLY;
   } else {
-    rel->current_stance = CIV_STANCE_NEUTRAL;
+    stance = CIV_STANCE_NEUTRAL;
   }
 
+  civ_ai_action_t *a = propose(ai, CIV_AI_ACTION_SET_RELATION);
+  if (!a)
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
+  a->relation.id = rel;
+  a->relation.opinion = opinion;
+  a->relation.stance = stance;
   return (civ_result_t){CIV_OK, "Threats evaluated"};
 }
 
+civ_result_t civ_strategic_ai_evaluate_threats(civ_strategic_ai_t *ai,
+                                               void *game_ptr) {
+  civ_result_t res = propose_threats(ai, game_ptr);
+  if (res.error != CIV_OK || !ai->pending.count)
+    return res;
+  civ_strategic_ai_commit(ai, game_ptr);
+  return res;
+}
+
+#define WAR_PLAN_MAX    32 /* target settlements forecast per decision */
+#define WAR_PLAN_REACH  12 /* tiles around a target counted into its battle */
+#define WAR_PLAN_UNITS  256
+
+/* Battle for one target settlement: units standing on our land near it
+   against units on theirs, the settlement's ground favouring defence */
+static bool war_plan_case(const civ_game_t *game, const civ_settlement_t *s,
+                          civ_owner_index_t own, civ_owner_index_t target,
+                          civ_battle_case_t *out) {
+  const civ_unit_manager_t *um = game->unit_manager;
+  const civ_map_t *map = game->world_map;
+  size_t found[WAR_PLAN_UNITS];
+  int32_t x = (int32_t)s->x, y = (int32_t)s->y;
+  size_t n = civ_unit_manager_query_rect(um, x - WAR_PLAN_REACH, y - WAR_PLAN_REACH,
+                                         x + WAR_PLAN_REACH, y + WAR_PLAN_REACH,
+                                         found, WAR_PLAN_UNITS);
+  n = MIN(n, (size_t)WAR_PLAN_UNITS);
+
+  float attack = 0.0f, defend = 0.0f;
+  for (size_t i = 0; i < n; i++) {
+    int32_t ux = um->x[found[i]], uy = um->y[found[i]];
+    if (ux < 0 || uy < 0 || ux >= map->width || uy >= map->height)
+      continue;
+    civ_owner_index_t owner =
+        civ_map_owner_at(map, (size_t)uy * (size_t)map->width + (size_t)ux);
+    if (owner == own)
+      attack += (float)civ_combat_unit_power(um, found[i]);
+    else if (owner == target)
+      defend += (float)civ_combat_unit_power(um, found[i]);
+  }
+  if (attack <= 0.0f && defend <= 0.0f)
+    return false;
+
+  /* A settlement is urban ground at best, worse where the tile is */
+  const civ_combat_system_t *cs = game->military_system;
+  float ground = (float)MIN(
+      civ_combat_system_terrain_factor(cs, CIV_COMBAT_TERRAIN_URBAN),
+      civ_combat_system_terrain_factor(cs, civ_combat_terrain_at(map, x, y)));
+  float weather = (float)civ_combat_system_weather_factor(
+      cs, civ_combat_system_weather_at(cs, x, y));
+  *out = (civ_battle_case_t){attack, defend, ground, weather};
+  return true;
+}
+
+/* Best forecast over the target's settlements; false when no settlement
+   has troops of either side near it */
+static bool forecast_war(const civ_strategic_ai_t *ai, const civ_game_t *game,
+                         const char *target_id, civ_battle_forecast_t *best) {
+  const civ_settlement_manager_t *sm = game->settlement_manager;
+  if (!sm || !game->unit_manager || !game->world_map)
+    return false;
+  int32_t target_slot = civ_settlement_manager_owner_index(sm, target_id);
+  civ_owner_index_t own = civ_owner_find(ai->base_ai->id);
+  civ_owner_index_t target = civ_owner_find(target_id);
+  if (target_slot < 0 || own == CIV_OWNER_NONE || target == CIV_OWNER_NONE)
+    return false;
+
+  civ_battle_case_t cases[WAR_PLAN_MAX];
+  size_t n = 0;
+  for (size_t i = 0; i < sm->settlement_count && n < WAR_PLAN_MAX; i++) {
+    const civ_settlement_t *s = &sm->settlements[i];
+    if (s->owner_index == target_slot &&
+        war_plan_case(game, s, own, target, &cases[n]))
+      n++;
+  }
+  if (n == 0)
+    return false;
+
+  civ_rng_t rng;
+  civ_rng_seed_key(&rng, civ_game_rng_seed(game), CIV_RNG_AI,
+                   (uint64_t)game->current_turn, ((uint64_t)own << 16) | target);
+  uint64_t seed = ((uint64_t)civ_rng_next_u32(&rng) << 32) | civ_rng_next_u32(&rng);
+  civ_battle_forecast_t forecasts[WAR_PLAN_MAX];
+  civ_combat_forecast_batch(cases, n, CIV_BATTLE_TRIALS, seed, forecasts);
+
+  *best = forecasts[0];
+  for (size_t i = 1; i < n; i++)
+    if (forecasts[i].win_probability > best->win_probability ||
+        (forecasts[i].win_probability == best->win_probability &&
+         forecasts[i].attacker_losses < best->attacker_losses))
+      *best = forecasts[i];
+  return true;
+}
+
+/* Whether the best war plan is worth the risk this AI is willing to take */
+static bool war_plan_acceptable(const civ_strategic_ai_t *ai,
+                                const civ_game_t *game, const char *target_id) {
+  civ_battle_forecast_t best;
+  if (!forecast_war(ai, game, target_id, &best))
+    return true; /* nothing to forecast: opinion alone decides */
+  float needed = 1.0f - (float)ai->risk_tolerance * 0.5f;
+  return best.win_probability >= needed &&
+         best.attacker_losses <= (float)ai->risk_tolerance;
+}
+
 bool civ_strategic_ai_should_declare_war(civ_strategic_ai_t *ai, void *game_ptr,
                                          const char *target_id) {
   civ_game_t *game = (civ_game_t *)game_ptr;
   if (!ai || !game || !game->diplomacy_system)
     return false;
 
-  civ_diplomatic_relation_t *rel = civ_diplomacy_system_get_relation(
-      game->diplomacy_system, ai->base_ai->id, target_id);
+  const civ_diplomacy_system_t *ds = game->diplomacy_system;
+  civ_relation_id_t rel =
+      civ_diplomacy_relation_id(ds, ai->base_ai->id, target_id);
 
-  if (!rel || rel->relation_level == CIV_RELATION_LEVEL_WAR)
+  if (rel == CIV_RELATION_NONE ||
+      ds->rel.relation_level[rel] == CIV_RELATION_LEVEL_WAR)
     return false;
 
-  /* Aggressive AIs declare war on sight if opinion is low */
-  if (ai->personality == CIV_PERSONALITY_AGGRESSIVE &&
-      rel->opinion_score < -40.0f) {
-    return true;
-  }
-
-  /* Hostile stance + very low opinion */
-  if (rel->current_stance == CIV_STANCE_HOSTILE &&
-      rel->opinion_score < -70.0f) {
-    return true;
-  }
+  /* Aggressive AIs want war on sight if opinion is low; others only from a
+     hostile stance and very low opinion */
+  bool wants_war =
+      (ai->personality == CIV_PERSONALITY_AGGRESSIVE &&
+       ds->rel.opinion_score[rel] < -40.0f) ||
+      (ds->rel.current_stance[rel] == CIV_STANCE_HOSTILE &&
+       ds->rel.opinion_score[rel] < -70.0f);
 
-  return false;
+  /* ... and declare it when a battle forecast says they can win */
+  return wants_war && war_plan_acceptable(ai, game, target_id);
 }
 
 bool civ_strategic_ai_should_offer_peace(civ_strategic_ai_t *ai, void *game_ptr,
@@ -350,17 +642,19 @@ bool civ_strategic_ai_should_offer_peace(civ_strategic_ai_t *ai, void *game_ptr,
   if (!ai || !game || !game->diplomacy_system)
     return false;
 
-  civ_diplomatic_relation_t *rel = civ_diplomacy_system_get_relation(
-      game->diplomacy_system, ai->base_ai->id, target_id);
+  const civ_diplomacy_system_t *ds = game->diplomacy_system;
+  civ_relation_id_t rel =
+      civ_diplomacy_relation_id(ds, ai->base_ai->id, target_id);
 
-  if (!rel || rel->relation_level != CIV_RELATION_LEVEL_WAR)
+  if (rel == CIV_RELATION_NONE ||
+      ds->rel.relation_level[rel] != CIV_RELATION_LEVEL_WAR)
     return false;
 
   /* Offer peace if opinion has recovered or AI is risk-averse */
-  if (rel->opinion_score > -20.0f)
+  if (ds->rel.opinion_score[rel] > -20.0f)
     return true;
 
-  if (ai->risk_tolerance < 0.3f && (rand() % 100 < 5))
+  if (ai->risk_tolerance < 0.3f && (civ_rand() % 100 < 5))
     return true;
 
   return false;
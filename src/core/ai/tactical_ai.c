@@ -4,11 +4,53 @@
  */
 
 #include "core/ai/tactical_ai.h"
+#include "core/ai/ai_utility.h"
 #include "common.h"
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
-#include <math.h>
+
+static void actions_free(civ_tactical_actions_t* a) {
+#define FREE_FIELD(name) CIV_FREE(a->name);
+    CIV_TACTICAL_ACTION_FIELDS(FREE_FIELD)
+#undef FREE_FIELD
+    CIV_FREE(a->type);
+    CIV_FREE(a->target);
+    CIV_FREE(a->timestamp);
+    memset(a, 0, sizeof(*a));
+}
+
+#define GROW_ARRAY(arr, cap)                                           \
+    do {                                                               \
+        void* grown = CIV_REALLOC((arr), (cap) * sizeof(*(arr)));      \
+        if (!grown) return false;                                      \
+        (arr) = grown;                                                 \
+    } while (0)
+
+static bool actions_reserve(civ_tactical_actions_t* a, size_t count) {
+    if (count <= a->capacity) return true;
+    size_t cap = a->capacity ? a->capacity : 32;
+    while (cap < count) cap *= 2;
+#define GROW_FIELD(name) GROW_ARRAY(a->name, cap);
+    CIV_TACTICAL_ACTION_FIELDS(GROW_FIELD)
+#undef GROW_FIELD
+    GROW_ARRAY(a->type, cap);
+    GROW_ARRAY(a->target, cap);
+    GROW_ARRAY(a->timestamp, cap);
+    a->capacity = cap;
+    return true;
+}
+
+/* Drop the first n actions, one move per array */
+static void actions_drop_front(civ_tactical_actions_t* a, size_t n) {
+    size_t keep = a->count - n;
+#define SHIFT_FIELD(name) memmove(a->name, a->name + n, keep * sizeof(*a->name));
+    CIV_TACTICAL_ACTION_FIELDS(SHIFT_FIELD)
+    SHIFT_FIELD(type)
+    SHIFT_FIELD(target)
+    SHIFT_FIELD(timestamp)
+#undef SHIFT_FIELD
+    a->count = keep;
+}
 
 civ_tactical_ai_t* civ_tactical_ai_create(const char* id, const char* name) {
     civ_tactical_ai_t* ai = (civ_tactical_ai_t*)CIV_MALLOC(sizeof(civ_tactical_ai_t));
@@ -27,7 +69,7 @@ void civ_tactical_ai_destroy(civ_tactical_ai_t* ai) {
     if (ai->base_ai) {
         civ_base_ai_destroy(ai->base_ai);
     }
-    CIV_FREE(ai->actions);
+    actions_free(&ai->actions);
     CIV_FREE(ai);
 }
 
@@ -38,8 +80,8 @@ void civ_tactical_ai_init(civ_tactical_ai_t* ai, const char* id, const char* nam
     ai->base_ai = civ_base_ai_create(id, name);
     ai->reaction_time = 1.0f;  /* 1 second */
     ai->decision_threshold = 0.3f;
-    ai->action_capacity = 32;
-    ai->actions = (civ_tactical_action_t*)CIV_CALLOC(ai->action_capacity, sizeof(civ_tactical_action_t));
+    if (!actions_reserve(&ai->actions, 32))
+        civ_log(CIV_LOG_WARNING, "No action storage for tactical AI %s", id);
 }
 
 civ_result_t civ_tactical_ai_react(civ_tactical_ai_t* ai, civ_float_t time_delta) {
@@ -55,16 +97,13 @@ civ_result_t civ_tactical_ai_react(civ_tactical_ai_t* ai, civ_float_t time_delta
         civ_base_ai_think(ai->base_ai, time_delta);
     }
     
-    /* Remove old actions */
-    time_t now = time(NULL);
-    for (size_t i = 0; i < ai->action_count; i++) {
-        /* Remove actions older than reaction time */
-        if (now - ai->actions[i].timestamp > (time_t)ai->reaction_time) {
-            memmove(&ai->actions[i], &ai->actions[i + 1], (ai->action_count - i - 1) * sizeof(civ_tactical_action_t));
-            ai->action_count--;
-            i--;
-        }
-    }
+    /* Actions are stamped in clock order, so the expired ones are a prefix */
+    if (time_delta > 0) ai->clock += time_delta;
+    civ_tactical_actions_t* a = &ai->actions;
+    size_t expired = 0;
+    while (expired < a->count && ai->clock - a->timestamp[expired] > ai->reaction_time)
+        expired++;
+    if (expired) actions_drop_front(a, expired);
     
     return result;
 }
@@ -79,45 +118,45 @@ civ_result_t civ_tactical_ai_add_action(civ_tactical_ai_t* ai, const char* actio
     
     urgency = CLAMP(urgency, 0.0f, 1.0f);
     
-    /* Expand if needed */
-    if (ai->action_count >= ai->action_capacity) {
-        ai->action_capacity *= 2;
-        ai->actions = (civ_tactical_action_t*)CIV_REALLOC(ai->actions,
-                                                         ai->action_capacity * sizeof(civ_tactical_action_t));
-    }
-    
-    if (ai->actions) {
-        civ_tactical_action_t* action = &ai->actions[ai->action_count++];
-        strncpy(action->action_type, action_type, sizeof(action->action_type) - 1);
-        if (target) {
-            strncpy(action->target, target, sizeof(action->target) - 1);
-        }
-        action->urgency = urgency;
-        action->cost = 0.0f;
-        action->expected_benefit = urgency;
-        action->timestamp = time(NULL);
-    } else {
+    civ_tactical_actions_t* a = &ai->actions;
+    if (!actions_reserve(a, a->count + 1)) {
         result.error = CIV_ERROR_OUT_OF_MEMORY;
+        return result;
     }
     
+    size_t i = a->count++;
+    a->type[i] = civ_symbol_intern(action_type);
+    a->target[i] = civ_symbol_intern(target);
+    a->urgency[i] = (float)urgency;
+    a->cost[i] = 0.0f;
+    a->expected_benefit[i] = (float)urgency;
+    a->utility[i] = 0.0f;
+    a->timestamp[i] = ai->clock;
     return result;
 }
 
-civ_tactical_action_t* civ_tactical_ai_get_best_action(const civ_tactical_ai_t* ai) {
-    if (!ai || ai->action_count == 0) return NULL;
-    
-    civ_tactical_action_t* best = NULL;
-    civ_float_t best_utility = -1.0f;
-    
-    for (size_t i = 0; i < ai->action_count; i++) {
-        civ_float_t utility = civ_tactical_ai_calculate_utility(&ai->actions[i]);
-        if (utility > best_utility && ai->actions[i].urgency >= ai->decision_threshold) {
-            best_utility = utility;
-            best = &ai->actions[i];
-        }
-    }
-    
-    return best;
+int32_t civ_tactical_ai_get_best_action(const civ_tactical_ai_t* ai) {
+    if (!ai || ai->actions.count == 0) return -1;
+    
+    /* Utility = expected_benefit - cost, weighted by urgency; actions below
+       the threshold score -inf */
+    const civ_tactical_actions_t* a = &ai->actions;
+    civ_ai_utility_batch(a->expected_benefit, a->cost, a->urgency,
+                         (float)ai->decision_threshold, a->utility, a->count);
+    int32_t best = civ_ai_argmax(a->utility, a->count);
+    return best >= 0 && a->utility[best] > -1.0f ? best : -1;
+}
+
+bool civ_tactical_ai_get_action(const civ_tactical_ai_t* ai, size_t index, civ_tactical_action_t* out) {
+    if (!ai || !out || index >= ai->actions.count) return false;
+    const civ_tactical_actions_t* a = &ai->actions;
+    out->action_type = civ_symbol_name(a->type[index]);
+    out->target = civ_symbol_name(a->target[index]);
+    out->urgency = a->urgency[index];
+    out->cost = a->cost[index];
+    out->expected_benefit = a->expected_benefit[index];
+    out->timestamp = a->timestamp[index];
+    return true;
 }
 
 civ_float_t civ_tactical_ai_calculate_utility(const civ_tactical_action_t* action) {
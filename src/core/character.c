@@ -3,6 +3,7 @@
  * @brief Player character — a person in the simulated world
  */
 #include "core/character.h"
+#include "utils/rng.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -96,12 +97,12 @@ void civ_character_apply_background(civ_character_t *c, civ_background_t bg) {
   c->housing_level = (bg == CIV_BG_ARISTOCRATIC) ? 3 : (bg == CIV_BG_NOMADIC) ? 1 : 2;
   c->housing_cost = (c->housing_level == 3) ? 0 : (c->housing_level == 2) ? 50 : 10;
   c->education_level = (bg == CIV_BG_ACADEMIC) ? 4 : (bg == CIV_BG_BUREAUCRATIC) ? 3 : 2;
-  c->health = 80.0f + (float)(rand() % 20);
+  c->health = 80.0f + (float)(civ_rand() % 20);
   c->healthcare_cost = 10.0f;
   c->savings_balance = c->personal_wealth * 0.5f;
   c->monthly_salary = (bg == CIV_BG_MERCHANT) ? 200 : (bg == CIV_BG_ARISTOCRATIC) ? 300 : 80;
   c->monthly_expenses = c->housing_cost + c->healthcare_cost + 20;
-  c->relationship_count = 2 + rand() % 5;
+  c->relationship_count = 2 + civ_rand() % 5;
   c->career_rank = (bg == CIV_BG_ARISTOCRATIC || bg == CIV_BG_MERCHANT) ? 2 : 1;
 }
 
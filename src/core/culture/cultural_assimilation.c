@@ -10,6 +10,53 @@
 #include <string.h>
 #include <time.h>
 
+/* Grow every column to capacity; the old ones stay valid on failure */
+static bool reserve_columns(civ_assimilation_tracker_t *tracker,
+                            size_t capacity) {
+#define CIV_ASSIM_GROW(column)                                                 \
+  do {                                                                         \
+    void *grown = CIV_REALLOC(tracker->column,                                 \
+                              capacity * sizeof(*tracker->column));            \
+    if (!grown)                                                                \
+      return false;                                                            \
+    tracker->column = grown;                                                   \
+  } while (0)
+  CIV_ASSIM_GROW(events);
+  CIV_ASSIM_GROW(progress);
+  CIV_ASSIM_GROW(rate);
+  CIV_ASSIM_GROW(resistance);
+  CIV_ASSIM_GROW(adoption_level);
+  CIV_ASSIM_GROW(tool_multiplier);
+  CIV_ASSIM_GROW(type_scale);
+  CIV_ASSIM_GROW(source_influence);
+  CIV_ASSIM_GROW(target_openness);
+  CIV_ASSIM_GROW(similarity);
+  CIV_ASSIM_GROW(source_index);
+  CIV_ASSIM_GROW(target_index);
+  CIV_ASSIM_GROW(stage);
+  CIV_ASSIM_GROW(crossed);
+#undef CIV_ASSIM_GROW
+  tracker->event_capacity = capacity;
+  return true;
+}
+
+static void free_columns(civ_assimilation_tracker_t *tracker) {
+  CIV_FREE(tracker->events);
+  CIV_FREE(tracker->progress);
+  CIV_FREE(tracker->rate);
+  CIV_FREE(tracker->resistance);
+  CIV_FREE(tracker->adoption_level);
+  CIV_FREE(tracker->tool_multiplier);
+  CIV_FREE(tracker->type_scale);
+  CIV_FREE(tracker->source_influence);
+  CIV_FREE(tracker->target_openness);
+  CIV_FREE(tracker->similarity);
+  CIV_FREE(tracker->source_index);
+  CIV_FREE(tracker->target_index);
+  CIV_FREE(tracker->stage);
+  CIV_FREE(tracker->crossed);
+  CIV_FREE(tracker->transitions);
+}
 
 civ_assimilation_tracker_t *civ_assimilation_tracker_create(void) {
   civ_assimilation_tracker_t *tracker =
@@ -27,7 +74,7 @@ civ_assimilation_tracker_t *civ_assimilation_tracker_create(void) {
 void civ_assimilation_tracker_destroy(civ_assimilation_tracker_t *tracker) {
   if (!tracker)
     return;
-  CIV_FREE(tracker->events);
+  free_columns(tracker);
   CIV_FREE(tracker);
 }
 
@@ -38,9 +85,7 @@ void civ_assimilation_tracker_init(civ_assimilation_tracker_t *tracker) {
   memset(tracker, 0, sizeof(civ_assimilation_tracker_t));
   tracker->base_assimilation_rate = 0.01f;
   tracker->forced_assimilation_multiplier = 2.0f;
-  tracker->event_capacity = 100;
-  tracker->events = (civ_assimilation_event_t *)CIV_CALLOC(
-      tracker->event_capacity, sizeof(civ_assimilation_event_t));
+  reserve_columns(tracker, 100); /* add_event retries if this fails */
 }
 
 civ_result_t
@@ -56,49 +101,170 @@ civ_assimilation_tracker_add_event(civ_assimilation_tracker_t *tracker,
   }
 
   /* Check if event already exists */
-  for (size_t i = 0; i < tracker->event_count; i++) {
-    if (strcmp(tracker->events[i].source_culture_id, source_id) == 0 &&
-        strcmp(tracker->events[i].target_culture_id, target_id) == 0) {
-      result.error = CIV_ERROR_INVALID_STATE;
-      result.message = "Assimilation event already exists";
-      return result;
-    }
+  if (civ_assimilation_tracker_find_event(tracker, source_id, target_id) >= 0) {
+    result.error = CIV_ERROR_INVALID_STATE;
+    result.message = "Assimilation event already exists";
+    return result;
   }
 
   /* Expand if needed */
-  if (tracker->event_count >= tracker->event_capacity) {
-    tracker->event_capacity *= 2;
-    tracker->events = (civ_assimilation_event_t *)CIV_REALLOC(
-        tracker->events,
-        tracker->event_capacity * sizeof(civ_assimilation_event_t));
+  if (tracker->event_count >= tracker->event_capacity &&
+      !reserve_columns(tracker, tracker->event_capacity
+                                    ? tracker->event_capacity * 2
+                                    : 100)) {
+    result.error = CIV_ERROR_OUT_OF_MEMORY;
+    return result;
   }
 
-  if (tracker->events) {
-    civ_assimilation_event_t *event = &tracker->events[tracker->event_count++];
-    memset(event, 0, sizeof(civ_assimilation_event_t));
-    strncpy(event->source_culture_id, source_id,
-            sizeof(event->source_culture_id) - 1);
-    strncpy(event->target_culture_id, target_id,
-            sizeof(event->target_culture_id) - 1);
-    if (region_id) {
-      strncpy(event->region_id, region_id, sizeof(event->region_id) - 1);
-    }
-    event->type = type;
-    event->stage = CIV_INTEGRATION_DISSENT;
-    event->progress = 0.0f;
-    event->rate = tracker->base_assimilation_rate;
-    event->resistance = 0.7f; /* Starting resistance is higher for dissent */
-    event->tool_count = 0;
-    event->adoption_level = 0.0f;
-    event->start_time = time(NULL);
-    event->last_update = event->start_time;
-  } else {
-    result.error = CIV_ERROR_OUT_OF_MEMORY;
+  size_t i = tracker->event_count++;
+  civ_assimilation_event_t *event = &tracker->events[i];
+  memset(event, 0, sizeof(civ_assimilation_event_t));
+  strncpy(event->source_culture_id, source_id,
+          sizeof(event->source_culture_id) - 1);
+  strncpy(event->target_culture_id, target_id,
+          sizeof(event->target_culture_id) - 1);
+  if (region_id) {
+    strncpy(event->region_id, region_id, sizeof(event->region_id) - 1);
   }
+  event->type = type;
+  event->tool_count = 0;
+  event->start_time = time(NULL);
+  event->last_update = event->start_time;
+
+  tracker->stage[i] = CIV_INTEGRATION_DISSENT;
+  tracker->progress[i] = 0.0f;
+  tracker->rate[i] = tracker->base_assimilation_rate;
+  tracker->resistance[i] = 0.7f; /* Starting resistance is higher for dissent */
+  tracker->adoption_level[i] = 0.0f;
+  tracker->tool_multiplier[i] = 1.0f;
+  tracker->source_index[i] = -1;
+  tracker->target_index[i] = -1;
+  tracker->crossed[i] = 0;
 
   return result;
 }
 
+/* Index of identity id in manager, starting from where it was last seen */
+static int32_t resolve_identity(const civ_cultural_identity_manager_t *manager,
+                                int32_t hint, const char *id) {
+  if (hint >= 0 && (size_t)hint < manager->identity_count &&
+      strcmp(manager->identities[hint].id, id) == 0)
+    return hint;
+  const civ_cultural_identity_t *found =
+      civ_cultural_identity_manager_find(manager, id);
+  return found ? (int32_t)(found - manager->identities) : -1;
+}
+
+/* Rate, progress, adoption and stage of every event in one pass */
+static void advance_events(civ_assimilation_tracker_t *tracker,
+                           civ_float_t time_delta) {
+  const civ_float_t base = tracker->base_assimilation_rate;
+  const civ_float_t *restrict type_scale = tracker->type_scale;
+  const civ_float_t *restrict influence = tracker->source_influence;
+  const civ_float_t *restrict openness = tracker->target_openness;
+  const civ_float_t *restrict similarity = tracker->similarity;
+  const civ_float_t *restrict tools = tracker->tool_multiplier;
+  civ_float_t *restrict rate = tracker->rate;
+  civ_float_t *restrict progress = tracker->progress;
+  civ_float_t *restrict resistance = tracker->resistance;
+  civ_float_t *restrict adoption = tracker->adoption_level;
+  uint8_t *restrict stage = tracker->stage;
+  uint8_t *restrict crossed = tracker->crossed;
+
+  for (size_t i = 0; i < tracker->event_count; i++) {
+    civ_float_t r = base * type_scale[i] * influence[i] * openness[i] *
+                    (1.0f + similarity[i]) * tools[i];
+    civ_float_t p = progress[i] + r * (1.0f - resistance[i]) * time_delta;
+    p = CLAMP(p, 0.0f, 1.0f);
+    rate[i] = r;
+    progress[i] = p;
+    adoption[i] = p * (1.0f - resistance[i]);
+
+    /* Below the first threshold the stage stays as it was */
+    uint8_t reached = (uint8_t)((p > 0.2f) + (p > 0.4f) + (p > 0.7f) +
+                                (p > 0.9f));
+    uint8_t next = reached ? reached : stage[i];
+    crossed[i] = next != stage[i] ? (uint8_t)(stage[i] + 1) : 0;
+    stage[i] = next;
+    /* Resistance drops as integration increases */
+    resistance[i] *= crossed[i] ? 0.8f : 1.0f;
+  }
+}
+
+static void move_event(civ_assimilation_tracker_t *tracker, size_t from,
+                       size_t to) {
+  tracker->events[to] = tracker->events[from];
+  tracker->progress[to] = tracker->progress[from];
+  tracker->rate[to] = tracker->rate[from];
+  tracker->resistance[to] = tracker->resistance[from];
+  tracker->adoption_level[to] = tracker->adoption_level[from];
+  tracker->tool_multiplier[to] = tracker->tool_multiplier[from];
+  tracker->type_scale[to] = tracker->type_scale[from];
+  tracker->source_influence[to] = tracker->source_influence[from];
+  tracker->target_openness[to] = tracker->target_openness[from];
+  tracker->similarity[to] = tracker->similarity[from];
+  tracker->source_index[to] = tracker->source_index[from];
+  tracker->target_index[to] = tracker->target_index[from];
+  tracker->stage[to] = tracker->stage[from];
+  tracker->crossed[to] = tracker->crossed[from];
+}
+
+static void record_transition(civ_assimilation_tracker_t *tracker, size_t i,
+                              civ_integration_stage_t from) {
+  if (tracker->transition_count >= tracker->transition_capacity) {
+    size_t cap =
+        tracker->transition_capacity ? tracker->transition_capacity * 2 : 16;
+    civ_assimilation_transition_t *grown = CIV_REALLOC(
+        tracker->transitions, cap * sizeof(civ_assimilation_transition_t));
+    if (!grown)
+      return;
+    tracker->transitions = grown;
+    tracker->transition_capacity = cap;
+  }
+  const civ_assimilation_event_t *event = &tracker->events[i];
+  civ_assimilation_transition_t *t =
+      &tracker->transitions[tracker->transition_count++];
+  memcpy(t->source_culture_id, event->source_culture_id,
+         sizeof(t->source_culture_id));
+  memcpy(t->target_culture_id, event->target_culture_id,
+         sizeof(t->target_culture_id));
+  memcpy(t->region_id, event->region_id, sizeof(t->region_id));
+  t->from = from;
+  t->to = (civ_integration_stage_t)tracker->stage[i];
+  civ_log(CIV_LOG_INFO, "Cultural event in %s moved to stage %d",
+          event->region_id, t->to);
+}
+
+/* Diffuse traits from source to target */
+static void adopt_traits(const civ_cultural_identity_t *source,
+                         civ_cultural_identity_t *target,
+                         civ_float_t adoption_level, civ_float_t time_delta) {
+  for (size_t j = 0; j < source->trait_count; j++) {
+    const char *trait_name = source->traits[j].name;
+    civ_float_t source_strength = source->traits[j].strength;
+
+    /* Find or create trait in target */
+    bool found = false;
+    for (size_t k = 0; k < target->trait_count; k++) {
+      if (strcmp(target->traits[k].name, trait_name) == 0) {
+        found = true;
+        /* Increase trait strength based on assimilation */
+        civ_float_t adoption =
+            source_strength * adoption_level * time_delta * 0.1f;
+        target->traits[k].strength =
+            CLAMP(target->traits[k].strength + adoption, 0.0f, 1.0f);
+        break;
+      }
+    }
+
+    if (!found && adoption_level > 0.2f) {
+      /* Create new trait if adoption is significant */
+      civ_cultural_identity_add_trait(target, trait_name,
+                                      source_strength * adoption_level * 0.5f);
+    }
+  }
+}
+
 civ_result_t civ_assimilation_tracker_update(
     civ_assimilation_tracker_t *tracker,
     civ_cultural_identity_manager_t *identity_manager, civ_float_t time_delta) {
@@ -110,102 +276,82 @@ civ_result_t civ_assimilation_tracker_update(
   }
 
   time_t now = time(NULL);
+  tracker->transition_count = 0;
 
+  /* Gather the rate inputs; an event whose cultures are gone stands still */
   for (size_t i = 0; i < tracker->event_count; i++) {
-    civ_assimilation_event_t *event = &tracker->events[i];
-
-    /* Get source and target cultures */
-    civ_cultural_identity_t *source = civ_cultural_identity_manager_find(
-        identity_manager, event->source_culture_id);
-    civ_cultural_identity_t *target = civ_cultural_identity_manager_find(
-        identity_manager, event->target_culture_id);
-
-    if (!source || !target) {
-      /* Remove invalid event */
-      memmove(&tracker->events[i], &tracker->events[i + 1],
-              (tracker->event_count - i - 1) *
-                  sizeof(civ_assimilation_event_t));
-      tracker->event_count--;
-      i--;
+    const civ_assimilation_event_t *event = &tracker->events[i];
+    int32_t s = resolve_identity(identity_manager, tracker->source_index[i],
+                                 event->source_culture_id);
+    int32_t t = resolve_identity(identity_manager, tracker->target_index[i],
+                                 event->target_culture_id);
+    tracker->source_index[i] = s;
+    tracker->target_index[i] = t;
+    if (s < 0 || t < 0) {
+      tracker->type_scale[i] = 0.0f;
+      tracker->source_influence[i] = 0.0f;
+      tracker->target_openness[i] = 0.0f;
+      tracker->similarity[i] = 0.0f;
       continue;
     }
+    const civ_cultural_identity_t *source = &identity_manager->identities[s];
+    const civ_cultural_identity_t *target = &identity_manager->identities[t];
+    tracker->type_scale[i] = event->type == CIV_ASSIMILATION_FORCED
+                                 ? tracker->forced_assimilation_multiplier
+                                 : 1.0f;
+    tracker->source_influence[i] = source->influence_radius * 0.1f;
+    /* Lower cohesion = easier assimilation */
+    tracker->target_openness[i] = 1.0f - target->cohesion;
+    tracker->similarity[i] =
+        civ_cultural_identity_calculate_similarity(source, target);
+  }
 
-    /* Calculate assimilation rate */
-    event->rate =
-        civ_assimilation_calculate_rate(tracker, source, target, event->type);
-
-    /* Update progress */
-    civ_float_t progress_delta =
-        event->rate * (1.0f - event->resistance) * time_delta;
-    event->progress = CLAMP(event->progress + progress_delta, 0.0f, 1.0f);
+  advance_events(tracker, time_delta);
 
-    /* Update adoption level (how much of target culture adopts source traits)
-     */
-    event->adoption_level = event->progress * (1.0f - event->resistance);
+  /* Per-event work, dropping events that are gone or complete */
+  size_t kept = 0;
+  for (size_t i = 0; i < tracker->event_count; i++) {
+    int32_t s = tracker->source_index[i], t = tracker->target_index[i];
+    if (s < 0 || t < 0)
+      continue; /* Remove invalid event */
 
     /* Apply assimilation to target culture */
-    if (event->progress > 0.1f) {
-      /* Diffuse traits from source to target */
-      for (size_t j = 0; j < source->trait_count; j++) {
-        const char *trait_name = source->traits[j].name;
-        civ_float_t source_strength = source->traits[j].strength;
-
-        /* Find or create trait in target */
-        bool found = false;
-        for (size_t k = 0; k < target->trait_count; k++) {
-          if (strcmp(target->traits[k].name, trait_name) == 0) {
-            found = true;
-            /* Increase trait strength based on assimilation */
-            civ_float_t adoption =
-                source_strength * event->adoption_level * time_delta * 0.1f;
-            target->traits[k].strength =
-                CLAMP(target->traits[k].strength + adoption, 0.0f, 1.0f);
-            break;
-          }
-        }
-
-        if (!found && event->adoption_level > 0.2f) {
-          /* Create new trait if adoption is significant */
-          civ_cultural_identity_add_trait(target, trait_name,
-                                          source_strength *
-                                              event->adoption_level * 0.5f);
-        }
-      }
-    }
-
-    /* Update stage based on progress */
-    civ_assimilation_update_stage(event);
-
-    event->last_update = now;
+    if (tracker->progress[i] > 0.1f)
+      adopt_traits(&identity_manager->identities[s],
+                   &identity_manager->identities[t],
+                   tracker->adoption_level[i], time_delta);
+    if (tracker->crossed[i])
+      record_transition(tracker, i,
+                        (civ_integration_stage_t)(tracker->crossed[i] - 1));
+    tracker->events[i].last_update = now;
 
     /* Remove completed events */
-    if (event->progress >= 1.0f) {
-      memmove(&tracker->events[i], &tracker->events[i + 1],
-              (tracker->event_count - i - 1) *
-                  sizeof(civ_assimilation_event_t));
-      tracker->event_count--;
-      i--;
-    }
+    if (tracker->progress[i] >= 1.0f)
+      continue;
+    if (kept != i)
+      move_event(tracker, i, kept);
+    kept++;
   }
+  tracker->event_count = kept;
 
   return result;
 }
 
-civ_assimilation_event_t *
-civ_assimilation_tracker_get_event(const civ_assimilation_tracker_t *tracker,
-                                   const char *source_id,
-                                   const char *target_id) {
+int32_t
+civ_assimilation_tracker_find_event(const civ_assimilation_tracker_t *tracker,
+                                    const char *source_id,
+                                    const char *target_id) {
   if (!tracker || !source_id || !target_id)
-    return NULL;
+    return -1;
 
   for (size_t i = 0; i < tracker->event_count; i++) {
     if (strcmp(tracker->events[i].source_culture_id, source_id) == 0 &&
         strcmp(tracker->events[i].target_culture_id, target_id) == 0) {
-      return (civ_assimilation_event_t *)&tracker->events[i];
+      return (int32_t)i;
     }
   }
 
-  return NULL;
+  return -1;
 }
 
 civ_float_t civ_assimilation_calculate_rate(
@@ -235,44 +381,24 @@ civ_float_t civ_assimilation_calculate_rate(
   return base_rate;
 }
 
-civ_result_t civ_assimilation_apply_tool(civ_assimilation_event_t *event,
+civ_result_t civ_assimilation_apply_tool(civ_assimilation_tracker_t *tracker,
+                                         size_t event,
                                          civ_assimilation_tool_t tool) {
-  if (!event)
-    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null event"};
+  if (!tracker)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null tracker"};
+  if (event >= tracker->event_count)
+    return (civ_result_t){CIV_ERROR_NOT_FOUND, "Unknown event"};
 
-  if (event->tool_count >= 4)
+  civ_assimilation_event_t *e = &tracker->events[event];
+  if (e->tool_count >= 4)
     return (civ_result_t){CIV_ERROR_INVALID_STATE, "Too many tools"};
 
-  event->active_tools[event->tool_count++] = tool;
+  e->active_tools[e->tool_count++] = tool;
 
   /* Policy shift: reduce resistance or increase rate */
-  event->resistance = CLAMP(event->resistance - 0.1f, 0.0f, 1.0f);
-  event->rate *= 1.2f;
-
-  return (civ_result_t){CIV_OK, NULL};
-}
-
-civ_result_t civ_assimilation_update_stage(civ_assimilation_event_t *event) {
-  if (!event)
-    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null event"};
-
-  civ_integration_stage_t old_stage = event->stage;
-
-  if (event->progress > 0.9f)
-    event->stage = CIV_INTEGRATION_UNIFICATION;
-  else if (event->progress > 0.7f)
-    event->stage = CIV_INTEGRATION_ABSORPTION;
-  else if (event->progress > 0.4f)
-    event->stage = CIV_INTEGRATION_ADOPTION;
-  else if (event->progress > 0.2f)
-    event->stage = CIV_INTEGRATION_ACCEPTANCE;
-
-  if (event->stage != old_stage) {
-    civ_log(CIV_LOG_INFO, "Cultural event in %s moved to stage %d",
-            event->region_id, event->stage);
-    /* Resistance drops as integration increases */
-    event->resistance *= 0.8f;
-  }
+  tracker->resistance[event] =
+      CLAMP(tracker->resistance[event] - 0.1f, 0.0f, 1.0f);
+  tracker->tool_multiplier[event] *= 1.2f;
 
   return (civ_result_t){CIV_OK, NULL};
 }
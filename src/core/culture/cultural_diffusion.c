@@ -5,11 +5,27 @@
 
 #include "core/culture/cultural_diffusion.h"
 #include "common.h"
+#include "core/simulation_engine/worker_pool.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CIV_DIFFUSION_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CIV_DIFFUSION_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CIV_DIFFUSION_NEON 1
+#endif
+
+#define TRAIT_LANES 8 /* trait_stride is a multiple of this */
+#define NEW_TRAIT_THRESHOLD 0.3f /* neighbour strength that seeds a trait */
+#define NEW_TRAIT_SHARE 0.1f
+
 
 civ_cultural_diffusion_t *civ_cultural_diffusion_create(void) {
   civ_cultural_diffusion_t *diffusion =
@@ -27,6 +43,15 @@ void civ_cultural_diffusion_destroy(civ_cultural_diffusion_t *diffusion) {
   if (!diffusion)
     return;
   CIV_FREE(diffusion->events);
+  CIV_FREE(diffusion->adj_start);
+  CIV_FREE(diffusion->adj_target);
+  CIV_FREE(diffusion->adj_weight);
+  civ_border_frontier_destroy(diffusion->frontier);
+  CIV_FREE(diffusion->trait_syms);
+  CIV_FREE(diffusion->column_of);
+  CIV_FREE(diffusion->strength);
+  CIV_FREE(diffusion->next_strength);
+  CIV_FREE(diffusion->held);
   CIV_FREE(diffusion);
 }
 
@@ -47,9 +72,271 @@ void civ_cultural_diffusion_init(civ_cultural_diffusion_t *diffusion) {
       diffusion->event_capacity, sizeof(civ_cultural_diffusion_event_t));
 }
 
+/* ── Links ─────────────────────────────────────────────────────────── */
+typedef struct {
+  uint32_t a, b;
+  float distance;
+} link_t;
+
+static int compare_link(const void *x, const void *y) {
+  const link_t *l = (const link_t *)x, *r = (const link_t *)y;
+  if (l->a != r->a) return l->a < r->a ? -1 : 1;
+  if (l->b != r->b) return l->b < r->b ? -1 : 1;
+  return (l->distance > r->distance) - (l->distance < r->distance);
+}
+
+static bool push_link(link_t **links, size_t *count, size_t *cap, uint32_t a,
+                      uint32_t b, float distance) {
+  if (*count + 2 > *cap) {
+    size_t grown_cap = *cap ? *cap * 2 : 64;
+    link_t *grown = (link_t *)CIV_REALLOC(*links, grown_cap * sizeof(link_t));
+    if (!grown) return false;
+    *links = grown;
+    *cap = grown_cap;
+  }
+  (*links)[(*count)++] = (link_t){a, b, distance};
+  (*links)[(*count)++] = (link_t){b, a, distance};
+  return true;
+}
+
+civ_result_t civ_cultural_diffusion_link(civ_cultural_diffusion_t *diffusion,
+                                         const civ_cultural_identity_manager_t *manager,
+                                         civ_map_t *map,
+                                         const civ_trade_manager_t *trade) {
+  civ_result_t result = {CIV_OK, NULL};
+  if (!diffusion || !manager) {
+    result.error = CIV_ERROR_NULL_POINTER;
+    return result;
+  }
+  diffusion->adj_count = 0;
+  diffusion->linked_identities = 0;
+  if (manager->identity_count < 2)
+    return result; /* nothing to link; the frontier waits for a use */
+
+  /* Identity by owner index; owners without one are not linked */
+  uint32_t owners = civ_owner_count();
+  int32_t *identity_of = (int32_t *)CIV_MALLOC((owners + 1) * sizeof(int32_t));
+  if (!identity_of) {
+    result.error = CIV_ERROR_OUT_OF_MEMORY;
+    return result;
+  }
+  memset(identity_of, 0xFF, (owners + 1) * sizeof(int32_t));
+  for (size_t i = 0; i < manager->identity_count; i++) {
+    civ_owner_index_t o = civ_owner_find(manager->identities[i].id);
+    if (o != CIV_OWNER_NONE && o < owners && identity_of[o] < 0)
+      identity_of[o] = (int32_t)i;
+  }
+
+  link_t *links = NULL;
+  size_t count = 0, cap = 0;
+  bool ok = true;
+  if (map) {
+    if (!diffusion->frontier)
+      diffusion->frontier = civ_border_frontier_create();
+    ok = diffusion->frontier &&
+         civ_border_frontier_attach(diffusion->frontier, map);
+    const civ_border_frontier_t *f = diffusion->frontier;
+    for (uint32_t k = 0; ok && k < f->pair_capacity; k++) {
+      uint32_t key = f->pair_keys[k];
+      if (key == 0 || f->pair_sets[k].count == 0) continue;
+      uint32_t owner = (key - 1) >> 16, neighbour = (key - 1) & 0xFFFFu;
+      /* Each border is stored from both sides; take it once */
+      if (owner >= neighbour || owner >= owners || neighbour >= owners)
+        continue;
+      int32_t a = identity_of[owner], b = identity_of[neighbour];
+      if (a < 0 || b < 0 || a == b) continue;
+      uint32_t shared = MIN(f->pair_sets[k].count, (uint32_t)CIV_CULTURE_FULL_BORDER);
+      float distance = CIV_CULTURE_BORDER_DISTANCE *
+                       (float)CIV_CULTURE_FULL_BORDER / (float)shared;
+      ok = push_link(&links, &count, &cap, (uint32_t)a, (uint32_t)b, distance);
+    }
+  }
+  for (size_t r = 0; ok && trade && r < trade->route_count; r++) {
+    const civ_trade_route_t *route = &trade->routes[r];
+    if (!route->active) continue;
+    civ_owner_index_t so = civ_owner_find(route->source_nation_id);
+    civ_owner_index_t to = civ_owner_find(route->target_nation_id);
+    int32_t a = so < owners ? identity_of[so] : -1;
+    int32_t b = to < owners ? identity_of[to] : -1;
+    if (so == CIV_OWNER_NONE || to == CIV_OWNER_NONE || a < 0 || b < 0 || a == b)
+      continue;
+    ok = push_link(&links, &count, &cap, (uint32_t)a, (uint32_t)b,
+                   CIV_CULTURE_TRADE_DISTANCE);
+  }
+  CIV_FREE(identity_of);
+
+  /* The nearest link between a pair stands for all of them */
+  if (count > 0)
+    qsort(links, count, sizeof(link_t), compare_link);
+  size_t rows = manager->identity_count;
+  uint32_t *start = (uint32_t *)CIV_REALLOC(diffusion->adj_start,
+                                            (rows + 1) * sizeof(uint32_t));
+  if (start) diffusion->adj_start = start;
+  if (ok && start && count > diffusion->adj_capacity) {
+    uint32_t *target = (uint32_t *)CIV_REALLOC(diffusion->adj_target,
+                                               count * sizeof(uint32_t));
+    if (target) diffusion->adj_target = target;
+    float *weight = (float *)CIV_REALLOC(diffusion->adj_weight,
+                                         count * sizeof(float));
+    if (weight) diffusion->adj_weight = weight;
+    ok = target && weight;
+    if (ok) diffusion->adj_capacity = count;
+  }
+  if (!ok || !start) {
+    CIV_FREE(links);
+    diffusion->adj_count = 0;
+    diffusion->linked_identities = 0;
+    result.error = CIV_ERROR_OUT_OF_MEMORY;
+    return result;
+  }
+
+  size_t n = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (i > 0 && links[i].a == links[i - 1].a &&
+        links[i].b == links[i - 1].b)
+      continue;
+    diffusion->adj_target[n] = links[i].b;
+    diffusion->adj_weight[n] =
+        expf(-(float)diffusion->distance_decay * links[i].distance);
+    links[n++].a = links[i].a;
+  }
+  memset(start, 0, (rows + 1) * sizeof(uint32_t));
+  for (size_t i = 0; i < n; i++) start[links[i].a + 1]++;
+  for (size_t i = 0; i < rows; i++) start[i + 1] += start[i];
+  CIV_FREE(links);
+  diffusion->adj_count = n;
+  diffusion->linked_identities = rows;
+  return result;
+}
+
+/* ── Trait table ───────────────────────────────────────────────────── */
+static int32_t trait_column(civ_cultural_diffusion_t *d, civ_symbol_t sym) {
+  if (sym == CIV_SYMBOL_NONE) return -1;
+  if (sym >= d->column_of_size) {
+    uint32_t size = MAX(sym + 1, d->column_of_size * 2);
+    int32_t *grown = (int32_t *)CIV_REALLOC(d->column_of, size * sizeof(int32_t));
+    if (!grown) return -1;
+    memset(grown + d->column_of_size, 0xFF,
+           (size - d->column_of_size) * sizeof(int32_t));
+    d->column_of = grown;
+    d->column_of_size = size;
+  }
+  if (d->column_of[sym] >= 0) return d->column_of[sym];
+  if (d->trait_count == d->trait_capacity) {
+    uint32_t cap = d->trait_capacity ? d->trait_capacity * 2 : 32;
+    civ_symbol_t *grown = (civ_symbol_t *)CIV_REALLOC(d->trait_syms, cap * sizeof(civ_symbol_t));
+    if (!grown) return -1;
+    d->trait_syms = grown;
+    d->trait_capacity = cap;
+  }
+  d->trait_syms[d->trait_count] = sym;
+  return d->column_of[sym] = (int32_t)d->trait_count++;
+}
+
+/* Size the matrices for rows identities and the current trait count */
+static bool reserve_matrix(civ_cultural_diffusion_t *d, size_t rows) {
+  uint32_t stride = (d->trait_count + TRAIT_LANES - 1) / TRAIT_LANES * TRAIT_LANES;
+  uint32_t words = (d->trait_count + 63) / 64;
+  stride = MAX(stride, (uint32_t)TRAIT_LANES);
+  words = MAX(words, 1u);
+  if (rows <= d->matrix_rows && stride == d->trait_stride && words == d->trait_words)
+    return true;
+  size_t cells = MAX(rows, (size_t)1) * stride;
+  float *s = (float *)CIV_REALLOC(d->strength, cells * sizeof(float));
+  if (s) d->strength = s;
+  float *next = (float *)CIV_REALLOC(d->next_strength, cells * sizeof(float));
+  if (next) d->next_strength = next;
+  uint64_t *held = (uint64_t *)CIV_REALLOC(d->held, MAX(rows, (size_t)1) * words * sizeof(uint64_t));
+  if (held) d->held = held;
+  if (!s || !next || !held) return false;
+  d->matrix_rows = MAX(rows, d->matrix_rows);
+  d->trait_stride = stride;
+  d->trait_words = words;
+  return true;
+}
+
+/* ── Tick ──────────────────────────────────────────────────────────── */
+/* acc += w * row, TRAIT_LANES at a time; stride is a whole number of lanes.
+   No FMA, so lanes round like the scalar loop. */
+static void axpy_max(float *acc, float *peak, float w, const float *row,
+                     uint32_t stride) {
+  uint32_t k = 0;
+#if defined(CIV_DIFFUSION_AVX2)
+  __m256 vw = _mm256_set1_ps(w);
+  for (; k + 8 <= stride; k += 8) {
+    __m256 r = _mm256_loadu_ps(row + k);
+    _mm256_storeu_ps(acc + k, _mm256_add_ps(_mm256_loadu_ps(acc + k), _mm256_mul_ps(vw, r)));
+    _mm256_storeu_ps(peak + k, _mm256_max_ps(_mm256_loadu_ps(peak + k), r));
+  }
+#elif defined(CIV_DIFFUSION_SSE2)
+  __m128 vw = _mm_set1_ps(w);
+  for (; k + 4 <= stride; k += 4) {
+    __m128 r = _mm_loadu_ps(row + k);
+    _mm_storeu_ps(acc + k, _mm_add_ps(_mm_loadu_ps(acc + k), _mm_mul_ps(vw, r)));
+    _mm_storeu_ps(peak + k, _mm_max_ps(_mm_loadu_ps(peak + k), r));
+  }
+#elif defined(CIV_DIFFUSION_NEON)
+  float32x4_t vw = vdupq_n_f32(w);
+  for (; k + 4 <= stride; k += 4) {
+    float32x4_t r = vld1q_f32(row + k);
+    vst1q_f32(acc + k, vaddq_f32(vld1q_f32(acc + k), vmulq_f32(vw, r)));
+    vst1q_f32(peak + k, vmaxq_f32(vld1q_f32(peak + k), r));
+  }
+#endif
+  for (; k < stride; k++) {
+    acc[k] = acc[k] + w * row[k];
+    peak[k] = row[k] > peak[k] ? row[k] : peak[k];
+  }
+}
+
+typedef struct {
+  const civ_cultural_diffusion_t *d;
+  const civ_cultural_identity_manager_t *manager;
+  civ_float_t time_delta;
+} tick_ctx_t;
+
+/* Row i of next from row i of strength and its neighbours' rows. A held
+   trait grows by the weighted sum; a missing one is seeded (its next cell
+   set negative, -strength) when a neighbour holds it strongly. */
+static void tick_row(void *arg, int i) {
+  const tick_ctx_t *ctx = (const tick_ctx_t *)arg;
+  const civ_cultural_diffusion_t *d = ctx->d;
+  uint32_t stride = d->trait_stride;
+  const float *own = d->strength + (size_t)i * stride;
+  const uint64_t *held = d->held + (size_t)i * d->trait_words;
+  float *next = d->next_strength + (size_t)i * stride;
+  float peak[TRAIT_LANES * 64];
+  float *acc = next;
+
+  memset(acc, 0, stride * sizeof(float));
+  for (uint32_t base = 0; base < stride; base += TRAIT_LANES * 64) {
+    uint32_t span = MIN(stride - base, (uint32_t)(TRAIT_LANES * 64));
+    memset(peak, 0, span * sizeof(float));
+    for (uint32_t e = d->adj_start[i]; e < d->adj_start[i + 1]; e++)
+      axpy_max(acc + base, peak, d->adj_weight[e],
+               d->strength + (size_t)d->adj_target[e] * stride + base, span);
+
+    /* base_rate * strength * (1 - resistance * factor) * distance factor,
+       summed over the links */
+    const civ_cultural_identity_t *target = &ctx->manager->identities[i];
+    float scale = (float)(d->base_diffusion_rate *
+                          (1.0f - (1.0f - target->cohesion) * d->resistance_factor) *
+                          ctx->time_delta);
+    for (uint32_t k = base; k < base + span && k < d->trait_count; k++) {
+      if (held[k >> 6] >> (k & 63) & 1)
+        next[k] = CLAMP(own[k] + acc[k] * scale, 0.0f, 1.0f);
+      else
+        next[k] = peak[k - base] > NEW_TRAIT_THRESHOLD
+                      ? -peak[k - base] * NEW_TRAIT_SHARE
+                      : 0.0f;
+    }
+  }
+}
+
 civ_result_t
 civ_cultural_diffusion_process(civ_cultural_diffusion_t *diffusion,
                                civ_cultural_identity_manager_t *manager,
+                               struct civ_worker_pool *pool,
                                civ_float_t time_delta) {
   civ_result_t result = {CIV_OK, NULL};
 
@@ -57,43 +344,51 @@ civ_cultural_diffusion_process(civ_cultural_diffusion_t *diffusion,
     result.error = CIV_ERROR_NULL_POINTER;
     return result;
   }
+  size_t rows = manager->identity_count;
+  /* Links from an older identity list are ignored until relinked */
+  if (rows == 0 || diffusion->linked_identities != rows ||
+      diffusion->adj_count == 0)
+    return result;
 
-  /* Process diffusion between all identity pairs */
-  for (size_t i = 0; i < manager->identity_count; i++) {
-    for (size_t j = i + 1; j < manager->identity_count; j++) {
-      civ_cultural_identity_t *source = &manager->identities[i];
-      civ_cultural_identity_t *target = &manager->identities[j];
-
-      /* Calculate distance (simplified - would use actual geographic distance)
-       */
-      civ_float_t distance =
-          fabsf(source->influence_radius - target->influence_radius);
-
-      /* Diffuse traits from source to target */
-      for (size_t k = 0; k < source->trait_count; k++) {
-        const char *trait_name = source->traits[k].name;
-        civ_float_t source_strength = source->traits[k].strength;
-
-        /* Find or create trait in target */
-        bool found = false;
-        for (size_t l = 0; l < target->trait_count; l++) {
-          if (strcmp(target->traits[l].name, trait_name) == 0) {
-            found = true;
-            /* Apply diffusion */
-            civ_float_t rate = civ_cultural_diffusion_calculate_rate(
-                diffusion, source_strength, 1.0f - target->cohesion, distance);
-            target->traits[l].strength = CLAMP(
-                target->traits[l].strength + rate * time_delta, 0.0f, 1.0f);
-            break;
-          }
-        }
-
-        if (!found && source_strength > 0.3f) {
-          /* Create new trait in target if strong enough */
-          civ_cultural_identity_add_trait(target, trait_name,
-                                          source_strength * 0.1f);
-        }
-      }
+  /* Gather: intern new traits, then fill the rows */
+  for (size_t i = 0; i < rows; i++) {
+    const civ_cultural_identity_t *id = &manager->identities[i];
+    for (size_t t = 0; t < id->trait_count; t++)
+      trait_column(diffusion, id->traits[t].sym);
+  }
+  if (!reserve_matrix(diffusion, rows)) {
+    result.error = CIV_ERROR_OUT_OF_MEMORY;
+    return result;
+  }
+  uint32_t stride = diffusion->trait_stride, words = diffusion->trait_words;
+  memset(diffusion->strength, 0, rows * stride * sizeof(float));
+  memset(diffusion->held, 0, rows * words * sizeof(uint64_t));
+  for (size_t i = 0; i < rows; i++) {
+    const civ_cultural_identity_t *id = &manager->identities[i];
+    for (size_t t = 0; t < id->trait_count; t++) {
+      int32_t k = trait_column(diffusion, id->traits[t].sym);
+      if (k < 0) continue;
+      diffusion->strength[i * stride + (size_t)k] = (float)id->traits[t].strength;
+      diffusion->held[i * words + ((uint32_t)k >> 6)] |= 1ull << (k & 63);
+    }
+  }
+
+  tick_ctx_t ctx = {diffusion, manager, time_delta};
+  civ_worker_pool_parallel_for(pool, (int)rows, tick_row, &ctx);
+
+  /* Scatter on this thread: strengths back, seeded traits appended */
+  for (size_t i = 0; i < rows; i++) {
+    civ_cultural_identity_t *id = &manager->identities[i];
+    const float *next = diffusion->next_strength + i * stride;
+    const uint64_t *held = diffusion->held + i * words;
+    for (size_t t = 0; t < id->trait_count; t++) {
+      int32_t k = trait_column(diffusion, id->traits[t].sym);
+      if (k >= 0) id->traits[t].strength = next[k];
+    }
+    for (uint32_t k = 0; k < diffusion->trait_count; k++) {
+      if (next[k] < 0.0f && !(held[k >> 6] >> (k & 63) & 1))
+        civ_cultural_identity_add_trait(
+            id, civ_symbol_name(diffusion->trait_syms[k]), -next[k]);
     }
   }
 
@@ -108,7 +108,9 @@ civ_result_t civ_cultural_identity_add_trait(civ_cultural_identity_t *identity,
 
   if (identity->traits) {
     civ_cultural_trait_t *trait = &identity->traits[identity->trait_count++];
+    memset(trait, 0, sizeof(*trait));
     strncpy(trait->name, trait_name, sizeof(trait->name) - 1);
+    trait->sym = civ_symbol_intern(trait->name);
     trait->strength = strength;
     trait->influence = strength * 0.5f;
   } else {
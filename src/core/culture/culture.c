@@ -49,7 +49,11 @@ void civ_culture_system_init(civ_culture_system_t* culture) {
     culture->writing_system_manager = civ_writing_system_manager_create();
 }
 
-civ_result_t civ_culture_system_update(civ_culture_system_t* culture, civ_float_t time_delta) {
+civ_result_t civ_culture_system_update(civ_culture_system_t* culture,
+                                       civ_map_t* map,
+                                       const civ_trade_manager_t* trade,
+                                       struct civ_worker_pool* pool,
+                                       civ_float_t time_delta) {
     civ_result_t result = {CIV_OK, NULL};
     
     if (!culture) {
@@ -66,7 +70,8 @@ civ_result_t civ_culture_system_update(civ_culture_system_t* culture, civ_float_
     
     /* Process cultural diffusion */
     if (culture->diffusion && culture->identity_manager) {
-        civ_cultural_diffusion_process(culture->diffusion, culture->identity_manager, time_delta);
+        civ_cultural_diffusion_link(culture->diffusion, culture->identity_manager, map, trade);
+        civ_cultural_diffusion_process(culture->diffusion, culture->identity_manager, pool, time_delta);
     }
     
     /* Update assimilation tracker */
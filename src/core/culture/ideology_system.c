@@ -4,26 +4,29 @@
  */
 
 #include "core/culture/ideology_system.h"
+#include "utils/rng.h"
 
 civ_ideology_system_t *civ_ideology_system_create(void) {
-  civ_ideology_system_t *system = CIV_MALLOC(sizeof(civ_ideology_system_t));
-  if (system) {
-    system->ideologies = NULL;
-    system->ideology_count = 0;
-    system->ideology_capacity = 0;
-  }
-  return system;
+  return CIV_CALLOC(1, sizeof(civ_ideology_system_t));
 }
 
 void civ_ideology_system_destroy(civ_ideology_system_t *system) {
   if (system) {
-    if (system->ideologies) {
-      for (size_t i = 0; i < system->ideology_count; i++) {
-        // Deep clean would be needed here if ideologies own their memory deeply
-        // For now assuming flat array for simplicity or need helper
-      }
-      CIV_FREE(system->ideologies);
+    for (size_t i = 0; i < system->ideology_count; i++) {
+      CIV_FREE(system->ideologies[i].values);
+      CIV_FREE(system->ideologies[i].policies);
     }
+    CIV_FREE(system->ideologies);
+    CIV_FREE(system->axes);
+    CIV_FREE(system->axis_of);
+    CIV_FREE(system->vectors);
+    CIV_FREE(system->cached);
+    CIV_FREE(system->distance);
+    CIV_FREE(system->order);
+    CIV_FREE(system->order_stale);
+    CIV_FREE(system->dirty);
+    CIV_FREE(system->probe);
+    CIV_FREE(system->probe_distance);
     CIV_FREE(system);
   }
 }
@@ -172,7 +175,7 @@ civ_ideology_t *civ_ideology_split(civ_ideology_system_t *system,
 
     /* Copy values with slight variation */
     for (size_t i = 0; i < parent->value_count; i++) {
-      civ_float_t variant = (civ_float_t)((rand() % 100 - 50) * 0.01f);
+      civ_float_t variant = (civ_float_t)((civ_rand() % 100 - 50) * 0.01f);
       civ_ideology_set_value(child, parent->values[i].name,
                              parent->values[i].value + variant);
     }
@@ -194,7 +197,7 @@ civ_result_t civ_ideology_drift(civ_ideology_t *ideology,
   if (stability < 0.4f) {
     for (size_t i = 0; i < ideology->value_count; i++) {
       civ_float_t shift =
-          (civ_float_t)((rand() % 100 - 50) * 0.001f * (1.0f - stability));
+          (civ_float_t)((civ_rand() % 100 - 50) * 0.001f * (1.0f - stability));
       ideology->values[i].value =
           CLAMP(ideology->values[i].value + shift, -1.0f, 1.0f);
     }
@@ -203,3 +206,304 @@ civ_result_t civ_ideology_drift(civ_ideology_t *ideology,
   civ_ideology_update_metrics(ideology);
   return (civ_result_t){CIV_OK, NULL};
 }
+
+/* ── Distance store ─────────────────────────────────────────────────── */
+
+civ_ideology_t *civ_ideology_system_add(civ_ideology_system_t *system,
+                                        civ_ideology_t *ideology) {
+  if (!system || !ideology)
+    return NULL;
+  if (system->ideology_count >= system->ideology_capacity) {
+    size_t cap =
+        system->ideology_capacity == 0 ? 8 : system->ideology_capacity * 2;
+    civ_ideology_t *grown =
+        CIV_REALLOC(system->ideologies, cap * sizeof(civ_ideology_t));
+    if (!grown)
+      return NULL;
+    system->ideologies = grown;
+    system->ideology_capacity = cap;
+  }
+  civ_ideology_t *stored = &system->ideologies[system->ideology_count++];
+  *stored = *ideology;
+  CIV_FREE(ideology);
+  return stored;
+}
+
+static size_t grow_to(size_t have, size_t need) {
+  size_t cap = have ? have : 8;
+  while (cap < need)
+    cap *= 2;
+  return cap;
+}
+
+/* Make room for rows x axes, keeping what the store holds */
+static bool reserve_store(civ_ideology_system_t *system, size_t rows,
+                          size_t axes) {
+  if (rows <= system->row_capacity && axes <= system->axis_capacity)
+    return true;
+  size_t nr = grow_to(system->row_capacity, rows);
+  size_t na = grow_to(system->axis_capacity, axes);
+
+  civ_float_t *vectors = CIV_CALLOC(nr * na, sizeof(civ_float_t));
+  civ_float_t *cached = CIV_CALLOC(nr * na, sizeof(civ_float_t));
+  civ_float_t *distance = CIV_CALLOC(nr * nr, sizeof(civ_float_t));
+  uint32_t *order = CIV_MALLOC(nr * nr * sizeof(uint32_t));
+  bool *order_stale = CIV_MALLOC(nr * sizeof(bool));
+  uint32_t *dirty = CIV_MALLOC(nr * sizeof(uint32_t));
+  civ_float_t *probe = CIV_MALLOC(na * sizeof(civ_float_t));
+  civ_float_t *probe_distance = CIV_MALLOC(nr * sizeof(civ_float_t));
+  if (!vectors || !cached || !distance || !order || !order_stale || !dirty ||
+      !probe || !probe_distance) {
+    CIV_FREE(vectors);
+    CIV_FREE(cached);
+    CIV_FREE(distance);
+    CIV_FREE(order);
+    CIV_FREE(order_stale);
+    CIV_FREE(dirty);
+    CIV_FREE(probe);
+    CIV_FREE(probe_distance);
+    return false;
+  }
+
+  for (size_t r = 0; r < system->row_count; r++) {
+    memcpy(vectors + r * na, system->vectors + r * system->axis_capacity,
+           system->axis_count * sizeof(civ_float_t));
+    memcpy(cached + r * na, system->cached + r * system->axis_capacity,
+           system->axis_count * sizeof(civ_float_t));
+    memcpy(distance + r * nr, system->distance + r * system->row_capacity,
+           system->row_count * sizeof(civ_float_t));
+  }
+  for (size_t r = 0; r < nr; r++)
+    order_stale[r] = true;
+
+  CIV_FREE(system->vectors);
+  CIV_FREE(system->cached);
+  CIV_FREE(system->distance);
+  CIV_FREE(system->order);
+  CIV_FREE(system->order_stale);
+  CIV_FREE(system->dirty);
+  CIV_FREE(system->probe);
+  CIV_FREE(system->probe_distance);
+  system->vectors = vectors;
+  system->cached = cached;
+  system->distance = distance;
+  system->order = order;
+  system->order_stale = order_stale;
+  system->dirty = dirty;
+  system->probe = probe;
+  system->probe_distance = probe_distance;
+  system->row_capacity = nr;
+  system->axis_capacity = na;
+  return true;
+}
+
+/* Column of axis name, added when add is set; -1 if it has none */
+static int32_t axis_index(civ_ideology_system_t *system, const char *name,
+                          bool add) {
+  civ_symbol_t sym = add ? civ_symbol_intern(name) : civ_symbol_find(name);
+  if (sym == CIV_SYMBOL_NONE)
+    return -1;
+  if (sym < system->axis_of_size && system->axis_of[sym] >= 0)
+    return system->axis_of[sym];
+  if (!add)
+    return -1;
+
+  if (sym >= system->axis_of_size) {
+    uint32_t size = MAX(civ_symbol_count(), sym + 1);
+    int32_t *grown = CIV_REALLOC(system->axis_of, size * sizeof(int32_t));
+    if (!grown)
+      return -1;
+    for (uint32_t s = system->axis_of_size; s < size; s++)
+      grown[s] = -1;
+    system->axis_of = grown;
+    system->axis_of_size = size;
+  }
+  if (system->axis_count % 8 == 0) {
+    civ_symbol_t *grown = CIV_REALLOC(
+        system->axes, (system->axis_count + 8) * sizeof(civ_symbol_t));
+    if (!grown)
+      return -1;
+    system->axes = grown;
+  }
+  if (!reserve_store(system, MAX(system->row_capacity, 1),
+                     system->axis_count + 1))
+    return -1;
+  system->axes[system->axis_count] = sym;
+  system->axis_of[sym] = (int32_t)system->axis_count;
+  return (int32_t)system->axis_count++;
+}
+
+static civ_float_t row_distance(const civ_float_t *a, const civ_float_t *b,
+                                size_t axes) {
+  civ_float_t sq = 0.0;
+  for (size_t x = 0; x < axes; x++) {
+    civ_float_t d = a[x] - b[x];
+    sq += d * d;
+  }
+  return sqrt(sq);
+}
+
+civ_result_t civ_ideology_system_refresh(civ_ideology_system_t *system) {
+  if (!system)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null system"};
+
+  for (size_t i = 0; i < system->ideology_count; i++) {
+    const civ_ideology_t *ideology = &system->ideologies[i];
+    for (size_t v = 0; v < ideology->value_count; v++)
+      if (axis_index(system, ideology->values[v].name, true) < 0)
+        return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Out of memory"};
+  }
+  if (!reserve_store(system, system->ideology_count, system->axis_count))
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Out of memory"};
+
+  size_t stride = system->axis_capacity, dirty = 0;
+  civ_float_t epsilon_sq = CIV_IDEOLOGY_DRIFT_EPSILON * CIV_IDEOLOGY_DRIFT_EPSILON;
+  for (size_t i = 0; i < system->ideology_count; i++) {
+    const civ_ideology_t *ideology = &system->ideologies[i];
+    civ_float_t *row = system->vectors + i * stride;
+    civ_float_t *cached = system->cached + i * stride;
+    memset(row, 0, stride * sizeof(civ_float_t));
+    for (size_t v = 0; v < ideology->value_count; v++)
+      row[axis_index(system, ideology->values[v].name, false)] =
+          ideology->values[v].value;
+
+    civ_float_t drift = row_distance(row, cached, system->axis_count);
+    if (i >= system->row_count || drift * drift > epsilon_sq) {
+      memcpy(cached, row, stride * sizeof(civ_float_t));
+      system->dirty[dirty++] = (uint32_t)i;
+    }
+  }
+  system->row_count = system->ideology_count;
+
+  size_t rows = system->row_capacity;
+  for (size_t k = 0; k < dirty; k++) {
+    size_t d = system->dirty[k];
+    for (size_t j = 0; j < system->row_count; j++) {
+      civ_float_t dist =
+          row_distance(system->cached + d * stride,
+                       system->cached + j * stride, system->axis_count);
+      system->distance[d * rows + j] = dist;
+      system->distance[j * rows + d] = dist;
+    }
+  }
+  if (dirty > 0)
+    for (size_t r = 0; r < system->row_count; r++)
+      system->order_stale[r] = true;
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+civ_float_t civ_ideology_system_distance(const civ_ideology_system_t *system,
+                                         size_t i, size_t j) {
+  if (!system || i >= system->row_count || j >= system->row_count)
+    return 0.0f;
+  return system->distance[i * system->row_capacity + j];
+}
+
+/* Binary max-heap on (key, index): the farthest, then highest index, on top */
+static bool farther(const civ_float_t *key, uint32_t a, uint32_t b) {
+  return key[a] > key[b] || (key[a] == key[b] && a > b);
+}
+
+static void sift_down(uint32_t *heap, size_t n, size_t at,
+                      const civ_float_t *key) {
+  for (;;) {
+    size_t top = at, l = 2 * at + 1, r = l + 1;
+    if (l < n && farther(key, heap[l], heap[top]))
+      top = l;
+    if (r < n && farther(key, heap[r], heap[top]))
+      top = r;
+    if (top == at)
+      return;
+    uint32_t t = heap[at];
+    heap[at] = heap[top];
+    heap[top] = t;
+    at = top;
+  }
+}
+
+/* Sort a max-heap of n into nearest first */
+static void heap_sort(uint32_t *heap, size_t n, const civ_float_t *key) {
+  for (size_t end = n; end > 1; end--) {
+    uint32_t t = heap[0];
+    heap[0] = heap[end - 1];
+    heap[end - 1] = t;
+    sift_down(heap, end - 1, 0, key);
+  }
+}
+
+static void heapify(uint32_t *heap, size_t n, const civ_float_t *key) {
+  for (size_t at = n / 2; at-- > 0;)
+    sift_down(heap, n, at, key);
+}
+
+size_t civ_ideology_system_nearest(civ_ideology_system_t *system, size_t i,
+                                   size_t k, uint32_t *out,
+                                   civ_float_t *out_distance) {
+  if (!system || !out || i >= system->row_count)
+    return 0;
+  const civ_float_t *key = system->distance + i * system->row_capacity;
+  uint32_t *order = system->order + i * system->row_capacity;
+  size_t others = system->row_count - 1;
+
+  if (system->order_stale[i]) {
+    size_t n = 0;
+    for (size_t j = 0; j < system->row_count; j++)
+      if (j != i)
+        order[n++] = (uint32_t)j;
+    heapify(order, n, key);
+    heap_sort(order, n, key);
+    system->order_stale[i] = false;
+  }
+
+  k = MIN(k, others);
+  for (size_t n = 0; n < k; n++) {
+    out[n] = order[n];
+    if (out_distance)
+      out_distance[n] = key[order[n]];
+  }
+  return k;
+}
+
+size_t civ_ideology_system_nearest_to(civ_ideology_system_t *system,
+                                      const civ_ideology_t *probe, size_t k,
+                                      uint32_t *out,
+                                      civ_float_t *out_distance) {
+  if (!system || !probe || !out || system->row_count == 0 || k == 0)
+    return 0;
+
+  /* Axes the store lacks add the same to every distance */
+  civ_float_t outside_sq = 0.0;
+  memset(system->probe, 0, system->axis_count * sizeof(civ_float_t));
+  for (size_t v = 0; v < probe->value_count; v++) {
+    int32_t x = axis_index(system, probe->values[v].name, false);
+    if (x >= 0)
+      system->probe[x] = probe->values[v].value;
+    else
+      outside_sq += probe->values[v].value * probe->values[v].value;
+  }
+
+  civ_float_t *key = system->probe_distance;
+  for (size_t j = 0; j < system->row_count; j++) {
+    civ_float_t d = row_distance(system->probe,
+                                 system->cached + j * system->axis_capacity,
+                                 system->axis_count);
+    key[j] = sqrt(d * d + outside_sq);
+  }
+
+  /* Keep the k nearest in a max-heap in out, then sort them */
+  k = MIN(k, system->row_count);
+  for (size_t j = 0; j < k; j++)
+    out[j] = (uint32_t)j;
+  heapify(out, k, key);
+  for (size_t j = k; j < system->row_count; j++) {
+    if (farther(key, out[0], (uint32_t)j)) {
+      out[0] = (uint32_t)j;
+      sift_down(out, k, 0, key);
+    }
+  }
+  heap_sort(out, k, key);
+  if (out_distance)
+    for (size_t n = 0; n < k; n++)
+      out_distance[n] = key[out[n]];
+  return k;
+}
@@ -5,6 +5,7 @@
 
 #include "core/culture/language_evolution.h"
 #include "common.h"
+#include "utils/rng.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
@@ -17,6 +18,95 @@ static civ_float_t lang_rng_float(void) {
   return (civ_float_t)((lang_rng_state / 65536) % 32768) / 32768.0f;
 }
 
+/* ── Concept index ───────────────────────────────────────────────── */
+
+static inline uint32_t concept_slot(civ_symbol_t concept, size_t capacity) {
+  return (concept * 2654435761u) & (uint32_t)(capacity - 1);
+}
+
+/* Vocabulary index of concept, -1 if the language has no word for it */
+static int32_t find_concept(const civ_language_t *language,
+                            civ_symbol_t concept) {
+  if (concept == CIV_SYMBOL_NONE || !language->concept_slots)
+    return -1;
+  size_t mask = language->concept_capacity - 1;
+  for (uint32_t s = concept_slot(concept, language->concept_capacity);;
+       s = (s + 1) & mask) {
+    uint32_t v = language->concept_slots[s];
+    if (v == 0)
+      return -1;
+    if (language->vocabulary[v - 1].concept == concept)
+      return (int32_t)(v - 1);
+  }
+}
+
+static void place_concept(civ_language_t *language, size_t index) {
+  size_t mask = language->concept_capacity - 1;
+  uint32_t s = concept_slot(language->vocabulary[index].concept,
+                            language->concept_capacity);
+  while (language->concept_slots[s])
+    s = (s + 1) & mask;
+  language->concept_slots[s] = (uint32_t)index + 1;
+}
+
+/* Room for one more concept at a load of at most one half */
+static bool reserve_concept(civ_language_t *language) {
+  if ((language->vocabulary_size + 1) * 2 <= language->concept_capacity)
+    return true;
+  size_t capacity = language->concept_capacity ? language->concept_capacity * 2 : 64;
+  uint32_t *slots = (uint32_t *)CIV_CALLOC(capacity, sizeof(uint32_t));
+  if (!slots)
+    return false;
+  CIV_FREE(language->concept_slots);
+  language->concept_slots = slots;
+  language->concept_capacity = capacity;
+  for (size_t i = 0; i < language->vocabulary_size; i++)
+    place_concept(language, i);
+  return true;
+}
+
+/* ── MinHash sketch ──────────────────────────────────────────────── */
+
+static inline uint64_t mix64(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xBF58476D1CE4E5B9ull;
+  x ^= x >> 27;
+  x *= 0x94D049BB133111EBull;
+  return x ^ (x >> 31);
+}
+
+/* Hashed on the strings, not the handle, so sketches compare across runs */
+static uint64_t pair_hash(const civ_vocab_entry_t *e) {
+  uint64_t h = 0xCBF29CE484222325ull;
+  for (const char *c = e->concept_id; *c; c++)
+    h = (h ^ (uint8_t)*c) * 0x100000001B3ull;
+  h = (h ^ 0xFF) * 0x100000001B3ull;
+  for (const char *c = e->word; *c; c++)
+    h = (h ^ (uint8_t)*c) * 0x100000001B3ull;
+  return h;
+}
+
+/* Slot k takes hash h1 + k * h2 of the pair, which is as good as k
+   independent hashes for MinHash */
+static void sketch_add(uint32_t *sketch, const civ_vocab_entry_t *e) {
+  uint64_t h = pair_hash(e);
+  uint32_t h1 = (uint32_t)mix64(h), h2 = (uint32_t)(mix64(h ^ 0x9E3779B97F4A7C15ull) | 1u);
+  for (int k = 0; k < CIV_LANGUAGE_SKETCH_SIZE; k++) {
+    uint32_t v = h1 + (uint32_t)k * h2;
+    if (v < sketch[k])
+      sketch[k] = v;
+  }
+}
+
+void civ_language_refresh_sketch(civ_language_t *language) {
+  if (!language)
+    return;
+  memset(language->sketch, 0xFF, sizeof(language->sketch));
+  for (size_t i = 0; i < language->vocabulary_size; i++)
+    sketch_add(language->sketch, &language->vocabulary[i]);
+  language->sketch_dirty = false;
+}
+
 civ_language_evolution_t *civ_language_evolution_create(void) {
   civ_language_evolution_t *evolution =
       (civ_language_evolution_t *)CIV_MALLOC(sizeof(civ_language_evolution_t));
@@ -84,6 +174,7 @@ civ_language_t *civ_language_create(const char *id, const char *name,
   language->vocabulary_capacity = 64;
   language->vocabulary = (civ_vocab_entry_t *)CIV_CALLOC(
       language->vocabulary_capacity, sizeof(civ_vocab_entry_t));
+  memset(language->sketch, 0xFF, sizeof(language->sketch));
 
   language->loanword_capacity = 16;
   language->loanwords = (civ_vocab_entry_t *)CIV_CALLOC(
@@ -102,6 +193,7 @@ void civ_language_destroy(civ_language_t *language) {
   if (!language)
     return;
   CIV_FREE(language->vocabulary);
+  CIV_FREE(language->concept_slots);
   CIV_FREE(language->loanwords);
 }
 
@@ -114,9 +206,12 @@ civ_result_t civ_language_evolution_update(civ_language_evolution_t *evolution,
     return result;
   }
 
-  /* Evolve all languages */
+  /* Evolve all languages, then bring the sketches of those whose words
+     changed up to date */
   for (size_t i = 0; i < evolution->language_count; i++) {
     civ_language_evolve(&evolution->languages[i], time_delta);
+    if (evolution->languages[i].sketch_dirty)
+      civ_language_refresh_sketch(&evolution->languages[i]);
   }
 
   return result;
@@ -176,21 +271,47 @@ civ_result_t civ_language_evolve_grammar(civ_language_t *language,
   return (civ_result_t){CIV_OK, NULL};
 }
 
+/* Simple sound shift: the first vowel moves to the next vowel; true if
+   the word changed */
+static bool shift_vowel(char *word, const char *vowels) {
+  char *v = strpbrk(word, vowels);
+  if (!v)
+    return false;
+  size_t v_idx = strcspn(vowels, (char[]){*v, '\0'});
+  if (v_idx >= strlen(vowels) - 1)
+    return false;
+  *v = vowels[v_idx + 1];
+  return true;
+}
+
+/* Uniform in [0, 1) from two draws of the bound stream, fine enough that
+   long gaps at small intensities are not cut short */
+static double drift_uniform(void) {
+  const double span = (double)RAND_MAX + 1.0;
+  return ((double)civ_rand() * span + (double)civ_rand()) / (span * span);
+}
+
 civ_result_t civ_language_evolve_vocabulary(civ_language_t *language,
                                             civ_float_t intensity) {
-  /* Shift words slightly (sound change) */
-  for (size_t i = 0; i < language->vocabulary_size; i++) {
-    if (lang_rng_float() < intensity) {
-      /* Apply a simple sound shift: vowels change to next vowel */
-      char *v =
-          strpbrk(language->vocabulary[i].word, language->phonology.vowels);
-      if (v) {
-        size_t v_idx = strcspn(language->phonology.vowels, (char[]){*v, '\0'});
-        if (v_idx < strlen(language->phonology.vowels) - 1) {
-          *v = language->phonology.vowels[v_idx + 1];
-        }
-      }
+  /* Each word shifts with probability intensity. The gap to the next word
+     that shifts is geometric, so draw the gaps and visit only those words
+     (sound change) */
+  if (intensity <= 0.0f || language->vocabulary_size == 0)
+    return (civ_result_t){CIV_OK, NULL};
+  double log_keep = intensity < 1.0f ? log(1.0 - (double)intensity) : 0.0;
+  size_t i = 0;
+  for (;;) {
+    if (log_keep < 0.0) {
+      double u = drift_uniform();
+      double gap = floor(log(1.0 - u) / log_keep);
+      if (gap >= (double)(language->vocabulary_size - i))
+        break;
+      i += (size_t)gap;
     }
+    if (shift_vowel(language->vocabulary[i].word, language->phonology.vowels))
+      language->sketch_dirty = true;
+    if (++i >= language->vocabulary_size)
+      break;
   }
   return (civ_result_t){CIV_OK, NULL};
 }
@@ -211,27 +332,55 @@ civ_float_t civ_language_calculate_similarity(const civ_language_t *a,
     parent_similarity = 0.4f; /* Siblings share parent */
   }
 
-  /* Complexity similarity */
-  civ_float_t complexity_similarity =
-      1.0f - (civ_float_t)fabs((double)(a->complexity - b->complexity));
+  /* Shared vocabulary when both have words, complexity otherwise */
+  civ_float_t likeness =
+      a->vocabulary_size && b->vocabulary_size
+          ? civ_language_lexical_similarity(a, b)
+          : 1.0f - (civ_float_t)fabs((double)(a->complexity - b->complexity));
 
   /* Combined similarity */
-  return CLAMP(parent_similarity + complexity_similarity * 0.4f, 0.0f, 1.0f);
+  return CLAMP(parent_similarity + likeness * 0.4f, 0.0f, 1.0f);
+}
+
+civ_float_t civ_language_lexical_similarity(const civ_language_t *a,
+                                            const civ_language_t *b) {
+  if (!a || !b || !a->vocabulary_size || !b->vocabulary_size)
+    return 0.0f;
+  int same = 0;
+  for (int k = 0; k < CIV_LANGUAGE_SKETCH_SIZE; k++)
+    same += a->sketch[k] == b->sketch[k];
+  return (civ_float_t)same / CIV_LANGUAGE_SKETCH_SIZE;
+}
+
+void civ_language_similarity_matrix(const civ_language_evolution_t *evolution,
+                                    civ_float_t *out) {
+  if (!evolution || !out)
+    return;
+  size_t n = evolution->language_count;
+  for (size_t i = 0; i < n; i++) {
+    out[i * n + i] = 1.0f;
+    for (size_t j = i + 1; j < n; j++) {
+      civ_float_t s = civ_language_calculate_similarity(
+          &evolution->languages[i], &evolution->languages[j]);
+      out[i * n + j] = out[j * n + i] = s;
+    }
+  }
 }
 
 /* Vocabulary helper */
+const char *civ_language_word_for(const civ_language_t *language,
+                                  civ_symbol_t concept) {
+  if (!language)
+    return NULL;
+  int32_t i = find_concept(language, concept);
+  return i >= 0 ? language->vocabulary[i].word : NULL;
+}
+
 const char *civ_language_get_word(const civ_language_t *language,
                                   const char *concept_id) {
   if (!language || !concept_id)
     return NULL;
-
-  for (size_t i = 0; i < language->vocabulary_size; i++) {
-    if (strcmp(language->vocabulary[i].concept_id, concept_id) == 0) {
-      return language->vocabulary[i].word;
-    }
-  }
-
-  return NULL;
+  return civ_language_word_for(language, civ_symbol_find(concept_id));
 }
 
 civ_result_t civ_language_add_word(civ_language_t *language,
@@ -243,24 +392,50 @@ civ_result_t civ_language_add_word(civ_language_t *language,
     return result;
   }
 
+  civ_symbol_t concept = civ_symbol_intern(concept_id);
+  if (concept == CIV_SYMBOL_NONE) {
+    result.error = CIV_ERROR_INVALID_ARGUMENT;
+    return result;
+  }
+
+  /* A word for a concept the language has replaces the old one */
+  int32_t existing = find_concept(language, concept);
+  if (existing >= 0) {
+    civ_vocab_entry_t *e = &language->vocabulary[existing];
+    if (strncmp(e->word, word, STRING_SHORT_LEN - 1) != 0) {
+      memset(e->word, 0, sizeof(e->word));
+      strncpy(e->word, word, STRING_SHORT_LEN - 1);
+      language->sketch_dirty = true;
+    }
+    return result;
+  }
+
   /* Expand if needed */
   if (language->vocabulary_size >= language->vocabulary_capacity) {
-    language->vocabulary_capacity *= 2;
-    language->vocabulary = (civ_vocab_entry_t *)CIV_REALLOC(
-        language->vocabulary,
-        language->vocabulary_capacity * sizeof(civ_vocab_entry_t));
+    size_t capacity = language->vocabulary_capacity * 2;
+    civ_vocab_entry_t *grown = (civ_vocab_entry_t *)CIV_REALLOC(
+        language->vocabulary, capacity * sizeof(civ_vocab_entry_t));
+    if (!grown) {
+      result.error = CIV_ERROR_OUT_OF_MEMORY;
+      return result;
+    }
+    language->vocabulary = grown;
+    language->vocabulary_capacity = capacity;
   }
 
-  if (language->vocabulary) {
-    strncpy(language->vocabulary[language->vocabulary_size].concept_id,
-            concept_id, STRING_SHORT_LEN - 1);
-    strncpy(language->vocabulary[language->vocabulary_size].word, word,
-            STRING_SHORT_LEN - 1);
-    language->vocabulary_size++;
-  } else {
+  if (!language->vocabulary || !reserve_concept(language)) {
     result.error = CIV_ERROR_OUT_OF_MEMORY;
+    return result;
   }
 
+  civ_vocab_entry_t *e = &language->vocabulary[language->vocabulary_size];
+  memset(e, 0, sizeof(*e));
+  strncpy(e->concept_id, concept_id, STRING_SHORT_LEN - 1);
+  strncpy(e->word, word, STRING_SHORT_LEN - 1);
+  e->concept = concept;
+  place_concept(language, language->vocabulary_size++);
+  sketch_add(language->sketch, e); /* a new pair only lowers minima */
+
   return result;
 }
 
@@ -283,10 +458,22 @@ civ_language_t *civ_language_evolve_from(civ_language_evolution_t *evolution,
       parent->prestige * 0.8f; /* New language starts with less prestige */
   new_lang->speakers = parent->speakers * 0.1f; /* Starts with fewer speakers */
 
-  /* Add to evolution system */
-  civ_language_evolution_add(evolution, new_lang);
+  /* Start from the parent's words, so the two drift apart from sharing
+     all of them */
+  for (size_t i = 0; i < parent->vocabulary_size; i++)
+    civ_language_add_word(new_lang, parent->vocabulary[i].concept_id,
+                          parent->vocabulary[i].word);
+
+  /* Add to evolution system, which takes over the language's buffers */
+  civ_result_t added = civ_language_evolution_add(evolution, new_lang);
+  if (added.error != CIV_OK) {
+    civ_language_destroy(new_lang);
+    CIV_FREE(new_lang);
+    return NULL;
+  }
+  CIV_FREE(new_lang);
 
-  return new_lang;
+  return &evolution->languages[evolution->language_count - 1];
 }
 
 civ_result_t civ_language_evolution_add(civ_language_evolution_t *evolution,
@@ -300,10 +487,15 @@ civ_result_t civ_language_evolution_add(civ_language_evolution_t *evolution,
 
   /* Expand if needed */
   if (evolution->language_count >= evolution->language_capacity) {
-    evolution->language_capacity *= 2;
-    evolution->languages = (civ_language_t *)CIV_REALLOC(
-        evolution->languages,
-        evolution->language_capacity * sizeof(civ_language_t));
+    size_t capacity = evolution->language_capacity ? evolution->language_capacity * 2 : 32;
+    civ_language_t *grown = (civ_language_t *)CIV_REALLOC(
+        evolution->languages, capacity * sizeof(civ_language_t));
+    if (!grown) {
+      result.error = CIV_ERROR_OUT_OF_MEMORY;
+      return result;
+    }
+    evolution->languages = grown;
+    evolution->language_capacity = capacity;
   }
 
   if (evolution->languages) {
@@ -339,12 +531,14 @@ civ_language_t *civ_language_split_dialect(civ_language_evolution_t *evolution,
   char dialect_id[STRING_SHORT_LEN];
   snprintf(dialect_id, STRING_SHORT_LEN, "%s_dia", parent->id);
 
+  /* Adding the dialect may move the languages parent lives among */
+  civ_float_t complexity = parent->complexity, prestige = parent->prestige;
   civ_language_t *dialect =
       civ_language_evolve_from(evolution, parent, dialect_id, dialect_name);
   if (dialect) {
     /* Dialects are extremely similar to parent initially */
-    dialect->complexity = parent->complexity;
-    dialect->prestige = parent->prestige * 0.9f;
+    dialect->complexity = complexity;
+    dialect->prestige = prestige * 0.9f;
   }
   return dialect;
 }
@@ -367,10 +561,10 @@ civ_result_t civ_language_borrow_word(civ_language_t *target,
   }
 
   if (target->loanwords) {
-    strncpy(target->loanwords[target->loanword_count].concept_id, concept_id,
-            STRING_SHORT_LEN - 1);
-    strncpy(target->loanwords[target->loanword_count].word, word,
-            STRING_SHORT_LEN - 1);
+    civ_vocab_entry_t *e = &target->loanwords[target->loanword_count];
+    strncpy(e->concept_id, concept_id, STRING_SHORT_LEN - 1);
+    strncpy(e->word, word, STRING_SHORT_LEN - 1);
+    e->concept = civ_symbol_find(concept_id);
     target->loanword_count++;
     return (civ_result_t){CIV_OK, NULL};
   }
@@ -0,0 +1,369 @@
+/**
+ * @file naming.c
+ * @brief Implementation of the naming service
+ */
+
+#include "core/culture/naming.h"
+#include "common.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define INITIAL_SLOTS 64
+#define INITIAL_POOL  1024
+
+/* Letters for cultures without a script of their own */
+static const civ_writing_system_t k_latin = {
+    .consonants = "bcdfghklmnprstvz",
+    .vowels = "aeiou",
+    .consonant_count = 16,
+    .vowel_count = 5,
+};
+
+static uint32_t name_hash(const char *text, size_t len) {
+  uint32_t h = 2166136261u;
+  for (size_t i = 0; i < len; i++) {
+    h ^= (uint8_t)text[i];
+    h *= 16777619u;
+  }
+  return h;
+}
+
+static uint64_t culture_hash(const char *culture) {
+  uint64_t h = 14695981039346656037ull;
+  for (const char *c = culture ? culture : ""; *c; c++) {
+    h ^= (uint8_t)*c;
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+civ_naming_service_t *civ_naming_create(void) {
+  civ_naming_service_t *naming =
+      (civ_naming_service_t *)CIV_CALLOC(1, sizeof(civ_naming_service_t));
+  if (!naming) {
+    civ_log(CIV_LOG_ERROR, "Failed to allocate naming service");
+    return NULL;
+  }
+  return naming;
+}
+
+void civ_naming_destroy(civ_naming_service_t *naming) {
+  if (!naming)
+    return;
+  CIV_FREE(naming->pool);
+  CIV_FREE(naming->slots);
+  CIV_FREE(naming->slot_hashes);
+  CIV_FREE(naming->streams);
+  CIV_FREE(naming);
+}
+
+/* Slot holding text, or the empty slot it would go in */
+static size_t probe(const civ_naming_service_t *n, const char *text,
+                    size_t len, uint32_t hash) {
+  size_t mask = n->slot_count - 1;
+  for (size_t i = hash & mask;; i = (i + 1) & mask) {
+    civ_name_t id = n->slots[i];
+    if (id == 0)
+      return i;
+    const char *held = n->pool + id - 1;
+    if (n->slot_hashes[i] == hash && strncmp(held, text, len) == 0 &&
+        held[len] == '\0')
+      return i;
+  }
+}
+
+/* Room for names more names at under half load */
+static bool reserve_slots(civ_naming_service_t *n, size_t names) {
+  size_t want = MAX(n->slot_count, (size_t)INITIAL_SLOTS);
+  while (want < (n->name_count + names) * 2)
+    want *= 2;
+  if (want == n->slot_count)
+    return true;
+  civ_name_t *slots = (civ_name_t *)CIV_CALLOC(want, sizeof(civ_name_t));
+  uint32_t *hashes = (uint32_t *)CIV_MALLOC(want * sizeof(uint32_t));
+  if (!slots || !hashes) {
+    CIV_FREE(slots);
+    CIV_FREE(hashes);
+    return false;
+  }
+  size_t mask = want - 1;
+  for (size_t s = 0; s < n->slot_count; s++) {
+    if (n->slots[s] == 0)
+      continue;
+    size_t i = n->slot_hashes[s] & mask;
+    while (slots[i] != 0)
+      i = (i + 1) & mask;
+    slots[i] = n->slots[s];
+    hashes[i] = n->slot_hashes[s];
+  }
+  CIV_FREE(n->slots);
+  CIV_FREE(n->slot_hashes);
+  n->slots = slots;
+  n->slot_hashes = hashes;
+  n->slot_count = want;
+  return true;
+}
+
+static bool reserve_pool(civ_naming_service_t *n, size_t bytes) {
+  size_t want = MAX(n->pool_capacity, (size_t)INITIAL_POOL);
+  while (want < n->pool_size + bytes)
+    want *= 2;
+  if (want == n->pool_capacity)
+    return true;
+  if (want > UINT32_MAX)
+    return false;
+  char *pool = (char *)CIV_REALLOC(n->pool, want);
+  if (!pool)
+    return false;
+  n->pool = pool;
+  n->pool_capacity = want;
+  return true;
+}
+
+/* Intern text unless it is taken; 0 for taken (*taken set) or no memory */
+static civ_name_t insert(civ_naming_service_t *n, const char *text, size_t len,
+                         bool *taken) {
+  *taken = false;
+  if (!reserve_slots(n, 1) || !reserve_pool(n, len + 1))
+    return 0;
+  uint32_t hash = name_hash(text, len);
+  size_t slot = probe(n, text, len, hash);
+  if (n->slots[slot] != 0) {
+    *taken = true;
+    return 0;
+  }
+  civ_name_t id = (civ_name_t)n->pool_size + 1;
+  memcpy(n->pool + n->pool_size, text, len);
+  n->pool[n->pool_size + len] = '\0';
+  n->pool_size += len + 1;
+  n->slots[slot] = id;
+  n->slot_hashes[slot] = hash;
+  n->name_count++;
+  return id;
+}
+
+civ_name_t civ_naming_reserve(civ_naming_service_t *naming, const char *name) {
+  if (!naming || !name || !name[0])
+    return 0;
+  bool taken;
+  return insert(naming, name, strlen(name), &taken);
+}
+
+civ_name_t civ_naming_find(const civ_naming_service_t *naming,
+                           const char *name) {
+  if (!naming || !name || naming->slot_count == 0)
+    return 0;
+  size_t len = strlen(name);
+  return naming->slots[probe(naming, name, len, name_hash(name, len))];
+}
+
+const char *civ_naming_text(const civ_naming_service_t *naming,
+                            civ_name_t name) {
+  if (!naming || name == 0 || name > naming->pool_size)
+    return "";
+  return naming->pool + name - 1;
+}
+
+/* The culture's stream for kind, seeded on first use */
+static civ_name_stream_t *stream_for(civ_naming_service_t *n,
+                                     const char *culture,
+                                     civ_name_kind_t kind) {
+  uint64_t key = culture_hash(culture);
+  for (size_t i = 0; i < n->stream_count; i++)
+    if (n->streams[i].culture == key && n->streams[i].kind == kind)
+      return &n->streams[i];
+  if (n->stream_count >= n->stream_capacity) {
+    size_t capacity = n->stream_capacity ? n->stream_capacity * 2 : 16;
+    civ_name_stream_t *streams = (civ_name_stream_t *)CIV_REALLOC(
+        n->streams, capacity * sizeof(civ_name_stream_t));
+    if (!streams)
+      return NULL;
+    n->streams = streams;
+    n->stream_capacity = capacity;
+  }
+  civ_name_stream_t *s = &n->streams[n->stream_count++];
+  s->culture = key;
+  s->kind = kind;
+  s->drawn = 0;
+  civ_rng_seed_key(&s->rng, n->rng_seed, CIV_RNG_NAMING, (uint64_t)kind, key);
+  return s;
+}
+
+static civ_name_t draw(civ_naming_service_t *n, const civ_writing_system_t *script,
+                       civ_name_stream_t *s, size_t min_length,
+                       size_t max_length) {
+  char text[CIV_NAMING_MAX_LEN + 1];
+  min_length = CLAMP(min_length, (size_t)1, (size_t)CIV_NAMING_MAX_LEN);
+  max_length = CLAMP(max_length, min_length, (size_t)CIV_NAMING_MAX_LEN);
+  for (int attempt = 0; attempt < CIV_NAMING_ATTEMPTS; attempt++) {
+    size_t longer = (size_t)attempt / 8;
+    size_t len = civ_writing_system_spell_name(
+        script, &s->rng, MIN(min_length + longer, (size_t)CIV_NAMING_MAX_LEN),
+        MIN(max_length + longer, (size_t)CIV_NAMING_MAX_LEN), text, sizeof(text));
+    s->drawn++;
+    if (len == 0)
+      return 0;
+    bool taken;
+    civ_name_t id = insert(n, text, len, &taken);
+    if (!taken)
+      return id;
+    n->collisions++;
+  }
+  return 0;
+}
+
+static const civ_writing_system_t *letters_of(const civ_writing_system_t *script) {
+  return script && script->consonants && script->vowels &&
+                 script->consonant_count + script->vowel_count > 0
+             ? script
+             : &k_latin;
+}
+
+civ_name_t civ_naming_generate(civ_naming_service_t *naming,
+                               const civ_writing_system_t *script,
+                               const char *culture, civ_name_kind_t kind,
+                               size_t min_length, size_t max_length) {
+  if (!naming || (unsigned)kind >= CIV_NAME_KIND_COUNT)
+    return 0;
+  civ_name_stream_t *s = stream_for(naming, culture, kind);
+  return s ? draw(naming, letters_of(script), s, min_length, max_length) : 0;
+}
+
+size_t civ_naming_generate_batch(civ_naming_service_t *naming,
+                                 const civ_writing_system_t *script,
+                                 const char *culture, civ_name_kind_t kind,
+                                 size_t min_length, size_t max_length,
+                                 civ_name_t *out, size_t count) {
+  if (!out)
+    return 0;
+  memset(out, 0, count * sizeof(*out));
+  if (!naming || (unsigned)kind >= CIV_NAME_KIND_COUNT || count == 0)
+    return 0;
+  civ_name_stream_t *s = stream_for(naming, culture, kind);
+  size_t longest = MIN(MAX(max_length, min_length) + CIV_NAMING_ATTEMPTS / 8,
+                       (size_t)CIV_NAMING_MAX_LEN);
+  if (!s || !reserve_slots(naming, count) ||
+      !reserve_pool(naming, count * (longest + 1)))
+    return 0;
+
+  const civ_writing_system_t *letters = letters_of(script);
+  size_t made = 0;
+  for (size_t i = 0; i < count; i++) {
+    civ_name_t id = draw(naming, letters, s, min_length, max_length);
+    if (id)
+      out[made++] = id;
+  }
+  return made;
+}
+
+/* ---- Save section ---- */
+
+static void naming_put(const civ_naming_service_t *n, civ_ser_cursor_t *c) {
+  uint32_t pool_size = (uint32_t)n->pool_size;
+  uint32_t stream_count = (uint32_t)n->stream_count;
+  CIV_SER_PUT(c, n->rng_seed);
+  CIV_SER_PUT(c, n->collisions);
+  CIV_SER_PUT(c, pool_size);
+  civ_ser_put(c, n->pool, n->pool_size);
+  CIV_SER_PUT(c, stream_count);
+  civ_ser_put(c, n->streams, n->stream_count * sizeof(civ_name_stream_t));
+}
+
+static civ_result_t naming_serialize(const void *object, char *buffer,
+                                     size_t buffer_size, size_t *written) {
+  civ_ser_cursor_t c = civ_ser_cursor(buffer, buffer_size);
+  naming_put((const civ_naming_service_t *)object, &c);
+  if (written) *written = c.pos;
+  return c.overflow ? (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Buffer too small"}
+                    : (civ_result_t){CIV_OK, NULL};
+}
+
+static size_t naming_serialized_size(const void *object) {
+  civ_ser_cursor_t c = civ_ser_cursor(NULL, 0);
+  naming_put((const civ_naming_service_t *)object, &c);
+  return c.pos;
+}
+
+/* Index every name in the pool; false on an empty or repeated name */
+static bool index_pool(civ_naming_service_t *n) {
+  size_t names = 0;
+  for (size_t i = 0; i < n->pool_size; i++)
+    names += n->pool[i] == '\0';
+  CIV_FREE(n->slots);
+  CIV_FREE(n->slot_hashes);
+  n->slots = NULL;
+  n->slot_hashes = NULL;
+  n->slot_count = 0;
+  n->name_count = 0;
+  if (!reserve_slots(n, names))
+    return false;
+  for (size_t off = 0; off < n->pool_size;) {
+    const char *text = n->pool + off;
+    size_t len = strlen(text);
+    uint32_t hash = name_hash(text, len);
+    size_t slot = probe(n, text, len, hash);
+    if (len == 0 || n->slots[slot] != 0)
+      return false;
+    n->slots[slot] = (civ_name_t)off + 1;
+    n->slot_hashes[slot] = hash;
+    n->name_count++;
+    off += len + 1;
+  }
+  return true;
+}
+
+static civ_result_t naming_deserialize(void *object, const char *buffer,
+                                       size_t buffer_size) {
+  civ_naming_service_t *n = (civ_naming_service_t *)object;
+  civ_ser_cursor_t c = civ_ser_cursor((void *)buffer, buffer_size);
+  uint64_t rng_seed = 0, collisions = 0;
+  uint32_t pool_size = 0, stream_count = 0;
+  if (!CIV_SER_GET(&c, rng_seed) || !CIV_SER_GET(&c, collisions) ||
+      !CIV_SER_GET(&c, pool_size) || pool_size > buffer_size - c.pos ||
+      (pool_size && buffer[c.pos + pool_size - 1] != '\0'))
+    return (civ_result_t){CIV_ERROR_INVALID_DATA, "Naming section size"};
+  const char *pool = buffer + c.pos;
+  c.pos += pool_size;
+  if (!CIV_SER_GET(&c, stream_count) ||
+      (size_t)stream_count * sizeof(civ_name_stream_t) != buffer_size - c.pos)
+    return (civ_result_t){CIV_ERROR_INVALID_DATA, "Naming section size"};
+
+  char *new_pool = NULL;
+  civ_name_stream_t *streams = NULL;
+  if (pool_size)
+    new_pool = (char *)CIV_MALLOC(pool_size);
+  if (stream_count)
+    streams = (civ_name_stream_t *)CIV_MALLOC(stream_count *
+                                              sizeof(civ_name_stream_t));
+  if ((pool_size && !new_pool) || (stream_count && !streams)) {
+    CIV_FREE(new_pool);
+    CIV_FREE(streams);
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Naming section"};
+  }
+  if (pool_size)
+    memcpy(new_pool, pool, pool_size);
+  civ_ser_get(&c, streams, stream_count * sizeof(civ_name_stream_t));
+
+  CIV_FREE(n->pool);
+  CIV_FREE(n->streams);
+  n->pool = new_pool;
+  n->pool_size = n->pool_capacity = pool_size;
+  n->streams = streams;
+  n->stream_count = n->stream_capacity = stream_count;
+  n->rng_seed = rng_seed;
+  n->collisions = collisions;
+  if (!index_pool(n)) {
+    /* A set that misses names would hand them out again */
+    CIV_FREE(n->pool);
+    n->pool = NULL;
+    n->pool_size = n->pool_capacity = 0;
+    index_pool(n);
+    return (civ_result_t){CIV_ERROR_INVALID_DATA, "Naming section names"};
+  }
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+civ_serializable_t civ_naming_serializable(civ_naming_service_t *naming) {
+  return (civ_serializable_t){naming, naming_serialize, naming_deserialize,
+                              naming_serialized_size};
+}
@@ -5,20 +5,25 @@
 
 #include "core/culture/religion_system.h"
 #include "common.h"
+#include "utils/rng.h"
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
 civ_religion_system_t *civ_religion_system_create(void) {
   civ_religion_system_t *system =
-      (civ_religion_system_t *)CIV_MALLOC(sizeof(civ_religion_system_t));
+      (civ_religion_system_t *)CIV_CALLOC(1, sizeof(civ_religion_system_t));
   if (!system)
     return NULL;
 
   system->religion_capacity = 16;
-  system->religion_count = 0;
   system->religions = (civ_religion_t *)CIV_CALLOC(system->religion_capacity,
                                                    sizeof(civ_religion_t));
+  if (!system->religions) {
+    CIV_FREE(system);
+    return NULL;
+  }
 
   return system;
 }
@@ -26,7 +31,13 @@ civ_religion_system_t *civ_religion_system_create(void) {
 void civ_religion_system_destroy(civ_religion_system_t *system) {
   if (!system)
     return;
+  for (size_t r = 0; r < system->religion_count; r++) {
+    CIV_FREE(system->religions[r].frontier);
+    CIV_FREE(system->religions[r].in_frontier);
+  }
   CIV_FREE(system->religions);
+  CIV_FREE(system->adherence);
+  CIV_FREE(system->conversion);
   CIV_FREE(system);
 }
 
@@ -34,11 +45,17 @@ civ_religion_t *civ_religion_emerge(civ_religion_system_t *system,
                                     const char *name, const char *culture_id) {
   if (!system || !name || !culture_id)
     return NULL;
+  if (system->religion_count >= CIV_RELIGION_MAX)
+    return NULL;
 
   if (system->religion_count >= system->religion_capacity) {
+    civ_religion_t *grown = (civ_religion_t *)CIV_REALLOC(
+        system->religions,
+        system->religion_capacity * 2 * sizeof(civ_religion_t));
+    if (!grown)
+      return NULL;
+    system->religions = grown;
     system->religion_capacity *= 2;
-    system->religions = (civ_religion_t *)CIV_REALLOC(
-        system->religions, system->religion_capacity * sizeof(civ_religion_t));
   }
 
   if (system->religions) {
@@ -54,8 +71,8 @@ civ_religion_t *civ_religion_emerge(civ_religion_system_t *system,
 
     /* Procedural tenets based on rand for now */
     rel->tenet_count = 2;
-    rel->tenets[0] = (civ_religion_tenet_t)(rand() % 6);
-    rel->tenets[1] = (civ_religion_tenet_t)(rand() % 6);
+    rel->tenets[0] = (civ_religion_tenet_t)(civ_rand() % 6);
+    rel->tenets[1] = (civ_religion_tenet_t)(civ_rand() % 6);
 
     return rel;
   }
@@ -78,3 +95,317 @@ civ_result_t civ_religion_spread(civ_religion_t *religion,
 
   return (civ_result_t){CIV_OK, NULL};
 }
+
+/* ── Spread ─────────────────────────────────────────────────────────── */
+
+static int slot_of(const civ_religion_adherence_t *a, uint8_t id) {
+  for (int k = 0; k < CIV_RELIGION_TOP_K; k++)
+    if (a->religion[k] == id)
+      return k;
+  return -1;
+}
+
+static uint16_t share_of(const civ_religion_adherence_t *a, uint8_t id) {
+  int k = slot_of(a, id);
+  return k >= 0 ? a->share[k] : 0;
+}
+
+/* Largest share first, empty slots last */
+static void sort_slots(civ_religion_adherence_t *a) {
+  for (int i = 1; i < CIV_RELIGION_TOP_K; i++) {
+    uint16_t s = a->share[i];
+    uint8_t r = a->religion[i];
+    int j = i;
+    for (; j > 0 && a->share[j - 1] < s; j--) {
+      a->share[j] = a->share[j - 1];
+      a->religion[j] = a->religion[j - 1];
+    }
+    a->share[j] = s;
+    a->religion[j] = r;
+  }
+}
+
+static bool in_frontier(const civ_religion_t *rel, uint32_t node) {
+  uint32_t w = node >> 6;
+  return w < rel->frontier_words && (rel->in_frontier[w] >> (node & 63)) & 1u;
+}
+
+static void leave_frontier(civ_religion_t *rel, uint32_t node) {
+  if (in_frontier(rel, node))
+    rel->in_frontier[node >> 6] &= ~(1ull << (node & 63));
+}
+
+static void frontier_push(civ_religion_t *rel, uint32_t node) {
+  uint32_t w = node >> 6;
+  if (w >= rel->frontier_words) {
+    uint32_t words = MAX(w + 1, rel->frontier_words * 2);
+    uint64_t *bits = CIV_REALLOC(rel->in_frontier, words * sizeof(uint64_t));
+    if (!bits)
+      return;
+    memset(bits + rel->frontier_words, 0,
+           (words - rel->frontier_words) * sizeof(uint64_t));
+    rel->in_frontier = bits;
+    rel->frontier_words = words;
+  }
+  if ((rel->in_frontier[w] >> (node & 63)) & 1u)
+    return;
+  if (rel->frontier_count >= rel->frontier_capacity) {
+    uint32_t cap = rel->frontier_capacity ? rel->frontier_capacity * 2 : 64;
+    uint32_t *grown = CIV_REALLOC(rel->frontier, cap * sizeof(uint32_t));
+    if (!grown)
+      return;
+    rel->frontier = grown;
+    rel->frontier_capacity = cap;
+  }
+  rel->in_frontier[w] |= 1ull << (node & 63);
+  rel->frontier[rel->frontier_count++] = node;
+}
+
+static uint32_t neighbour(const civ_trade_network_t *net, uint32_t node,
+                          uint32_t k, float *weight) {
+  const civ_trade_node_t *n = &net->nodes[node];
+  const civ_trade_edge_t *e = &net->edges[net->edge_refs[n->first_edge + k]];
+  *weight = (float)CIV_RELIGION_REACH_COST /
+            ((float)CIV_RELIGION_REACH_COST + (float)e->cost);
+  return e->a == node ? e->b : e->a;
+}
+
+static uint32_t degree(const civ_trade_network_t *net, uint32_t node) {
+  return net && net->edge_refs ? net->nodes[node].edge_count : 0;
+}
+
+/* Neighbours below saturation join religion's frontier */
+static void push_neighbours(civ_religion_system_t *system,
+                            const civ_trade_network_t *net, size_t religion,
+                            uint32_t node) {
+  uint8_t id = (uint8_t)(religion + 1);
+  for (uint32_t k = 0; k < degree(net, node); k++) {
+    float w;
+    uint32_t nb = neighbour(net, node, k, &w);
+    if (share_of(&system->adherence[nb], id) < CIV_RELIGION_SATURATED)
+      frontier_push(&system->religions[religion], nb);
+  }
+}
+
+/* Convert fraction d of everyone at node not already of religion, taking
+   from the others evenly; returns religion's new share */
+static uint16_t convert(civ_religion_system_t *system,
+                        const civ_trade_network_t *net, size_t religion,
+                        uint32_t node, float d) {
+  civ_religion_adherence_t *a = &system->adherence[node];
+  civ_religion_t *rel = &system->religions[religion];
+  uint8_t id = (uint8_t)(religion + 1);
+  int slot = slot_of(a, id);
+  uint16_t before = slot >= 0 ? a->share[slot] : 0;
+  float gain = d * (float)(CIV_RELIGION_SHARE_ONE - before);
+
+  if (slot < 0) {
+    slot = CIV_RELIGION_TOP_K - 1; /* emptiest, as slots are sorted */
+    if (a->religion[slot] != 0) {
+      if (gain <= (float)a->share[slot])
+        return 0; /* not enough to enter the node's top faiths */
+      civ_religion_t *evicted = &system->religions[a->religion[slot] - 1];
+      evicted->adherent_mass -= a->share[slot];
+      frontier_push(evicted, node);
+    }
+    a->religion[slot] = id;
+    a->share[slot] = 0;
+  }
+
+  uint32_t others = 0;
+  for (int k = 0; k < CIV_RELIGION_TOP_K; k++) {
+    if (k == slot || a->religion[k] == 0)
+      continue;
+    civ_religion_t *other = &system->religions[a->religion[k] - 1];
+    uint16_t kept = (uint16_t)((float)a->share[k] * (1.0f - d));
+    other->adherent_mass -= (uint64_t)(a->share[k] - kept);
+    a->share[k] = kept;
+    others += kept;
+    if (kept < CIV_RELIGION_SATURATED)
+      frontier_push(other, node);
+  }
+
+  uint32_t after = before + (uint32_t)lrintf(gain);
+  after = MIN(after, CIV_RELIGION_SHARE_ONE - others);
+  a->share[slot] = (uint16_t)after;
+  rel->adherent_mass += after - before;
+  if (before == 0 && after > 0 && net)
+    push_neighbours(system, net, religion, node);
+  sort_slots(a);
+  return (uint16_t)after;
+}
+
+static bool reserve_nodes(civ_religion_system_t *system, uint32_t count) {
+  if (count <= system->node_capacity)
+    return true;
+  uint32_t cap = system->node_capacity ? system->node_capacity : 64;
+  while (cap < count)
+    cap *= 2;
+  civ_religion_adherence_t *grown = CIV_REALLOC(
+      system->adherence, cap * sizeof(civ_religion_adherence_t));
+  if (!grown)
+    return false;
+  memset(grown + system->node_capacity, 0,
+         (cap - system->node_capacity) * sizeof(civ_religion_adherence_t));
+  system->adherence = grown;
+  system->node_capacity = cap;
+  return true;
+}
+
+static void rebuild_frontiers(civ_religion_system_t *system,
+                              const civ_trade_network_t *net) {
+  for (size_t r = 0; r < system->religion_count; r++) {
+    civ_religion_t *rel = &system->religions[r];
+    rel->frontier_count = 0;
+    if (rel->in_frontier)
+      memset(rel->in_frontier, 0, rel->frontier_words * sizeof(uint64_t));
+  }
+  for (uint32_t n = 0; n < system->node_count; n++) {
+    const civ_religion_adherence_t *a = &system->adherence[n];
+    for (int k = 0; k < CIV_RELIGION_TOP_K && a->religion[k]; k++) {
+      size_t r = a->religion[k] - 1u;
+      if (a->share[k] < CIV_RELIGION_SATURATED)
+        frontier_push(&system->religions[r], n);
+      push_neighbours(system, net, r, n);
+    }
+  }
+  system->edges_seen = net->edge_count;
+  system->frontiers_stale = false;
+}
+
+/* Fraction of the rest religion converts at a frontier node over dt, or
+   -1 when nothing of it is there or next door */
+static float conversion_at(const civ_religion_system_t *system,
+                           const civ_trade_network_t *net,
+                           const civ_tile_field_t *field, size_t religion,
+                           uint32_t node, civ_float_t dt) {
+  uint8_t id = (uint8_t)(religion + 1);
+  float presence = (float)share_of(&system->adherence[node], id);
+  for (uint32_t k = 0; k < degree(net, node); k++) {
+    float w;
+    uint32_t nb = neighbour(net, node, k, &w);
+    presence += w * (float)share_of(&system->adherence[nb], id);
+  }
+  if (presence <= 0.0f)
+    return -1.0f;
+
+  float culture = 1.0f;
+  if (field && field->width > 0) {
+    uint32_t tile = net->nodes[node].tile;
+    culture = 0.5f + CLAMP(civ_tile_field_at(field, CIV_TILE_FIELD_CULTURE,
+                                             (int32_t)(tile % (uint32_t)field->width),
+                                             (int32_t)(tile / (uint32_t)field->width)),
+                           0.0f, 1.0f);
+  }
+  float pressure = CIV_RELIGION_SPREAD_RATE *
+                   (float)system->religions[religion].fervor * culture *
+                   (presence / (float)CIV_RELIGION_SHARE_ONE) * (float)dt;
+  return 1.0f - expf(-pressure);
+}
+
+void civ_religion_system_update(civ_religion_system_t *system,
+                                const civ_trade_network_t *net,
+                                const civ_tile_field_t *field,
+                                civ_float_t dt) {
+  if (!system || !net || dt <= 0.0)
+    return;
+  if (net->node_count != system->node_count) {
+    if (!reserve_nodes(system, net->node_count))
+      return;
+    if (net->node_count < system->node_count)
+      memset(system->adherence + net->node_count, 0,
+             (system->node_count - net->node_count) *
+                 sizeof(civ_religion_adherence_t));
+    system->node_count = net->node_count;
+    system->frontiers_stale = true;
+  }
+  if (system->frontiers_stale || system->edges_seen != net->edge_count)
+    rebuild_frontiers(system, net);
+
+  /* Every conversion from the state the update started with */
+  size_t entries = 0;
+  for (size_t r = 0; r < system->religion_count; r++)
+    entries += system->religions[r].frontier_count;
+  if (entries > system->conversion_capacity) {
+    float *grown = CIV_REALLOC(system->conversion, entries * sizeof(float));
+    if (!grown)
+      return;
+    system->conversion = grown;
+    system->conversion_capacity = entries;
+  }
+  size_t at = 0;
+  for (size_t r = 0; r < system->religion_count; r++) {
+    const civ_religion_t *rel = &system->religions[r];
+    for (uint32_t i = 0; i < rel->frontier_count; i++)
+      system->conversion[at++] =
+          conversion_at(system, net, field, r, rel->frontier[i], dt);
+  }
+
+  /* Apply them; nodes pushed meanwhile wait for the next update */
+  at = 0;
+  for (size_t r = 0; r < system->religion_count; r++) {
+    civ_religion_t *rel = &system->religions[r];
+    uint32_t visited = rel->frontier_count, kept = 0;
+    for (uint32_t i = 0; i < visited; i++) {
+      uint32_t node = rel->frontier[i];
+      float d = system->conversion[at++];
+      if (d >= 0.0f &&
+          convert(system, net, r, node, d) < CIV_RELIGION_SATURATED) {
+        rel->frontier[kept++] = node;
+        continue;
+      }
+      leave_frontier(rel, node);
+    }
+    memmove(rel->frontier + kept, rel->frontier + visited,
+            (rel->frontier_count - visited) * sizeof(uint32_t));
+    rel->frontier_count = kept + (rel->frontier_count - visited);
+  }
+
+  for (size_t r = 0; r < system->religion_count; r++) {
+    civ_religion_t *rel = &system->religions[r];
+    rel->global_reach =
+        system->node_count
+            ? (civ_float_t)rel->adherent_mass /
+                  ((civ_float_t)CIV_RELIGION_SHARE_ONE * system->node_count)
+            : 0.0;
+  }
+}
+
+civ_result_t civ_religion_found(civ_religion_system_t *system,
+                                size_t religion, uint32_t node,
+                                civ_float_t share) {
+  if (!system)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null pointer"};
+  if (religion >= system->religion_count)
+    return (civ_result_t){CIV_ERROR_NOT_FOUND, "Unknown religion"};
+  if (!reserve_nodes(system, node + 1))
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
+  if (node >= system->node_count)
+    system->node_count = node + 1;
+
+  uint16_t before = share_of(&system->adherence[node], (uint8_t)(religion + 1));
+  float target = (float)CLAMP(share, 0.0, 1.0) * (float)CIV_RELIGION_SHARE_ONE;
+  if (target > (float)before)
+    convert(system, NULL, religion, node,
+            (target - before) / (float)(CIV_RELIGION_SHARE_ONE - before));
+  system->frontiers_stale = true;
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+int32_t civ_religion_dominant(const civ_religion_system_t *system,
+                              uint32_t node) {
+  if (!system || node >= system->node_count)
+    return -1;
+  const civ_religion_adherence_t *a = &system->adherence[node];
+  return a->religion[0] && a->share[0] ? (int32_t)a->religion[0] - 1 : -1;
+}
+
+civ_float_t civ_religion_share(const civ_religion_system_t *system,
+                               size_t religion, uint32_t node) {
+  if (!system || node >= system->node_count ||
+      religion >= system->religion_count)
+    return 0.0;
+  return (civ_float_t)share_of(&system->adherence[node],
+                               (uint8_t)(religion + 1)) /
+         CIV_RELIGION_SHARE_ONE;
+}
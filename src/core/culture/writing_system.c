@@ -5,23 +5,13 @@
 
 #include "core/culture/writing_system.h"
 #include "common.h"
+#include "utils/rng.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
 
-/* RNG for name generation */
-static uint32_t name_rng_state = 0;
-static void name_rng_seed(uint32_t seed) { name_rng_state = seed; }
-static uint32_t name_rng_next(void) {
-  name_rng_state = name_rng_state * 1103515245 + 12345;
-  return (name_rng_state / 65536) % 32768;
-}
-static int32_t name_rng_range(int32_t min, int32_t max) {
-  return min + (name_rng_next() % (max - min + 1));
-}
-
 civ_writing_system_manager_t *civ_writing_system_manager_create(void) {
   civ_writing_system_manager_t *manager =
       (civ_writing_system_manager_t *)CIV_MALLOC(
@@ -158,48 +148,58 @@ civ_writing_system_evolve_from(civ_writing_system_manager_t *manager,
 
   /* Slight variation in complexity */
   new_script->complexity = CLAMP(
-      parent->complexity + (name_rng_next() % 100 - 50) * 0.01f, 0.0f, 1.0f);
+      parent->complexity + (civ_rand() % 100 - 50) * 0.01f, 0.0f, 1.0f);
   new_script->efficiency = CLAMP(
-      parent->efficiency + (name_rng_next() % 100 - 50) * 0.01f, 0.0f, 1.0f);
+      parent->efficiency + (civ_rand() % 100 - 50) * 0.01f, 0.0f, 1.0f);
 
   civ_writing_system_manager_add(manager, new_script);
 
   return result;
 }
 
+size_t civ_writing_system_spell_name(const civ_writing_system_t *script,
+                                     civ_rng_t *rng, size_t min_length,
+                                     size_t max_length, char *out,
+                                     size_t out_size) {
+  if (!script || !rng || !out || out_size == 0)
+    return 0;
+  out[0] = '\0';
+  if (script->consonant_count == 0 && script->vowel_count == 0)
+    return 0;
+
+  max_length = MAX(max_length, min_length);
+  size_t length =
+      min_length + civ_rng_range(rng, (uint32_t)(max_length - min_length + 1));
+  length = MIN(MAX(length, (size_t)1), out_size - 1);
+  for (size_t i = 0; i < length; i++) {
+    if ((i % 2 == 0 && script->consonant_count > 0) || script->vowel_count == 0)
+      out[i] = script->consonants[civ_rng_range(rng, (uint32_t)script->consonant_count)];
+    else
+      out[i] = script->vowels[civ_rng_range(rng, (uint32_t)script->vowel_count)];
+  }
+  out[length] = '\0';
+
+  /* Capitalize first letter */
+  if (out[0] >= 'a' && out[0] <= 'z')
+    out[0] = out[0] - 'a' + 'A';
+  return length;
+}
+
 char *civ_writing_system_generate_name(const civ_writing_system_t *script,
                                        size_t min_length, size_t max_length) {
   if (!script || !script->consonants || !script->vowels)
     return NULL;
 
-  size_t length =
-      min_length + (name_rng_next() % (max_length - min_length + 1));
-  char *name = (char *)CIV_MALLOC(length + 1);
-  if (!name)
+  /* A fresh stream per call, keyed off whatever stream the thread has */
+  civ_rng_t rng;
+  civ_rng_seed(&rng, ((uint64_t)civ_rand() << 32) ^ (uint64_t)civ_rand(), 0);
+  size_t size = MAX(max_length, min_length) + 1;
+  char *name = (char *)CIV_MALLOC(size);
+  if (name && civ_writing_system_spell_name(script, &rng, min_length,
+                                            max_length, name, size) == 0) {
+    CIV_FREE(name);
     return NULL;
-
-  name_rng_seed((uint32_t)time(NULL));
-
-  for (size_t i = 0; i < length; i++) {
-    if (i % 2 == 0 && script->consonant_count > 0) {
-      /* Consonant */
-      int32_t idx = name_rng_range(0, (int32_t)script->consonant_count - 1);
-      name[i] = script->consonants[idx];
-    } else if (script->vowel_count > 0) {
-      /* Vowel */
-      int32_t idx = name_rng_range(0, (int32_t)script->vowel_count - 1);
-      name[i] = script->vowels[idx];
-    } else {
-      name[i] = 'a' + (name_rng_next() % 26);
-    }
   }
-  name[length] = '\0';
-
-  /* Capitalize first letter */
-  if (name[0] >= 'a' && name[0] <= 'z') {
-    name[0] = name[0] - 'a' + 'A';
-  }
-
   return name;
 }
 
@@ -210,7 +210,7 @@ civ_result_t civ_writing_system_evolve_symbols(civ_writing_system_t *script,
 
   /* Procedurally shift character inventory */
   if (intensity > 0.1f && script->consonants) {
-    size_t idx = name_rng_next() % script->consonant_count;
+    size_t idx = (size_t)civ_rand() % script->consonant_count;
     /* Simple shift: replace a consonant with a neighbor in the alphabet for now
      */
     if (script->consonants[idx] >= 'a' && script->consonants[idx] < 'z') {
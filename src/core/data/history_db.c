@@ -4,66 +4,542 @@
  */
 
 #include "core/data/history_db.h"
+#include "utils/mapped_file.h"
+#include "utils/frame_trace.h"
+#include <SDL3/SDL.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
-#define CIV_JOURNAL_FORMAT_MAGIC 0x434A4442u /* CJDB */
-#define CIV_JOURNAL_FORMAT_VERSION 1u
+#if defined(_WIN32)
+#include <io.h>
+#define journal_sync_file(f) _commit(_fileno(f))
+#elif defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#define journal_sync_file(f) fsync(fileno(f))
+#else
+#define journal_sync_file(f) 0
+#endif
+
+#define CIV_JOURNAL_SEGMENT_MAGIC 0x47534A43u /* CJSG */
+#define CIV_JOURNAL_INDEX_MAGIC 0x58494A43u   /* CJIX */
+#define CIV_JOURNAL_FORMAT_VERSION 3u
+
+/* ── On-disk layout ─────────────────────────────────────────────────
+   segment: head, records..., then once sealed: index entries, per-type
+   counts, summary, trailer. A record is its head followed by context_len
+   context bytes and the event data. Each index entry is the zone map of
+   one block of CIV_JOURNAL_INDEX_STRIDE records and the summary that of
+   the whole segment, so a query skips what cannot match unread. */
 
 typedef struct {
   uint32_t magic;
   uint32_t version;
-  uint64_t event_count;
-} civ_journal_file_header_t;
+  uint32_t segment;
+  uint32_t reserved;
+  uint64_t first_sequence;
+} journal_segment_head_t;
 
-static civ_result_t civ_journal_reserve(civ_journal_t *j, size_t min_capacity) {
-  if (!j)
-    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null journal"};
+typedef struct {
+  uint32_t payload_size; /* context + data bytes */
+  uint16_t type;
+  uint16_t context_len;
+  uint64_t sequence_id;
+  uint32_t timestamp;
+  int32_t  turn;
+  uint32_t context_hash;
+  uint32_t checksum;     /* FNV-1a over the head (checksum 0) and payload */
+} journal_record_head_t;
 
-  if (min_capacity <= j->capacity)
-    return (civ_result_t){CIV_OK, NULL};
+typedef struct {
+  uint64_t sequence_id;  /* first record of the block */
+  uint64_t offset;
+  int32_t  turn_min, turn_max;
+  uint32_t type_mask;
+  uint32_t context_bloom;
+} journal_index_entry_t;
+
+typedef struct {
+  uint32_t type_mask;
+  int32_t  turn_min, turn_max;
+  uint32_t reserved;
+  uint64_t context_bloom[4];
+} journal_summary_t;
+
+typedef struct {
+  uint64_t index_offset;  /* end of the records */
+  uint64_t last_sequence;
+  uint32_t index_count;
+  uint32_t record_count;
+  uint32_t type_count;    /* uint64 counts between the index and here */
+  uint32_t magic;
+} journal_trailer_t;
+
+static uint32_t journal_checksum(journal_record_head_t head,
+                                 const uint8_t *payload) {
+  head.checksum = 0;
+  uint32_t h = 2166136261u;
+  const uint8_t *p = (const uint8_t *)&head;
+  for (size_t i = 0; i < sizeof(head); i++) h = (h ^ p[i]) * 16777619u;
+  for (size_t i = 0; i < head.payload_size; i++)
+    h = (h ^ payload[i]) * 16777619u;
+  return h;
+}
+
+static uint32_t context_hash(const char *context, size_t len) {
+  uint32_t h = 2166136261u;
+  for (size_t i = 0; i < len; i++) h = (h ^ (uint8_t)context[i]) * 16777619u;
+  return h;
+}
+
+/* Two bits of a 32-bit block filter, three of the 256-bit segment one */
+static uint32_t block_bloom_bits(uint32_t h) {
+  return 1u << (h & 31) | 1u << ((h >> 5) & 31);
+}
 
-  size_t new_capacity = j->capacity ? j->capacity : 256;
-  while (new_capacity < min_capacity) {
-    new_capacity *= 2;
+static void summary_bloom_add(journal_summary_t *sum, uint32_t h) {
+  for (int k = 0; k < 3; k++) {
+    uint32_t bit = (h >> (8 * k)) & 255;
+    sum->context_bloom[bit >> 6] |= 1ull << (bit & 63);
   }
+}
 
-  civ_event_t *new_journal =
-      (civ_event_t *)CIV_REALLOC(j->journal, new_capacity * sizeof(civ_event_t));
-  if (!new_journal)
-    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Journal realloc failed"};
+static bool summary_bloom_test(const journal_summary_t *sum, uint32_t h) {
+  for (int k = 0; k < 3; k++) {
+    uint32_t bit = (h >> (8 * k)) & 255;
+    if (!(sum->context_bloom[bit >> 6] & 1ull << (bit & 63))) return false;
+  }
+  return true;
+}
 
-  j->journal = new_journal;
-  j->capacity = new_capacity;
-  return (civ_result_t){CIV_OK, NULL};
+static void segment_path(char *out, size_t out_size, const char *db_path,
+                         uint32_t segment) {
+  snprintf(out, out_size, "%s.%04u", db_path, segment);
+}
+
+/* ── Background writer ────────────────────────────────────────────── */
+
+struct civ_journal_sink {
+  SDL_Thread    *thread;   /* NULL: batches are written by the caller */
+  SDL_Mutex     *lock;
+  SDL_Condition *wake_cv;  /* queue past the threshold, flush or stop */
+  SDL_Condition *done_cv;  /* broadcast after each batch */
+
+  /* Guarded by lock */
+  uint8_t  *queue;
+  size_t    queue_size, queue_cap;
+  uint64_t  queued_through;  /* last sequence queued */
+  uint64_t  synced_through;  /* last sequence on disk */
+  bool      flush_requested;
+  bool      stopping;
+  bool      writing;
+  civ_result_t error;        /* first write failure, until reported */
+
+  /* Writer side only */
+  char      db_path[256];
+  FILE     *file;
+  uint32_t  segment;          /* open segment, or the next one to open */
+  uint64_t  segment_bytes;
+  uint32_t  segment_records;
+  uint64_t  segment_last;
+  uint64_t  segment_types[CIV_JOURNAL_TYPE_COUNT];
+  journal_summary_t segment_summary;
+  journal_index_entry_t *index;
+  size_t    index_count, index_cap;
+  uint8_t  *batch;
+  size_t    batch_cap;
+};
+
+static bool sink_open_segment(civ_journal_sink_t *s, uint64_t first_sequence) {
+  char path[272];
+  segment_path(path, sizeof(path), s->db_path, s->segment);
+  s->file = fopen(path, "wb");
+  if (!s->file) return false;
+  journal_segment_head_t head = {CIV_JOURNAL_SEGMENT_MAGIC,
+                                 CIV_JOURNAL_FORMAT_VERSION, s->segment, 0,
+                                 first_sequence};
+  s->segment_bytes = sizeof(head);
+  s->segment_records = 0;
+  s->index_count = 0;
+  memset(s->segment_types, 0, sizeof(s->segment_types));
+  memset(&s->segment_summary, 0, sizeof(s->segment_summary));
+  s->segment_summary.turn_min = INT32_MAX;
+  s->segment_summary.turn_max = INT32_MIN;
+  return fwrite(&head, sizeof(head), 1, s->file) == 1;
+}
+
+/* Footer, sync and close; the next record opens the following segment */
+static bool sink_seal_segment(civ_journal_sink_t *s) {
+  if (!s->file) return true;
+  journal_trailer_t trailer = {s->segment_bytes, s->segment_last,
+                               (uint32_t)s->index_count, s->segment_records,
+                               CIV_JOURNAL_TYPE_COUNT, CIV_JOURNAL_INDEX_MAGIC};
+  bool ok =
+      fwrite(s->index, sizeof(*s->index), s->index_count, s->file) ==
+          s->index_count &&
+      fwrite(s->segment_types, sizeof(s->segment_types), 1, s->file) == 1 &&
+      fwrite(&s->segment_summary, sizeof(s->segment_summary), 1, s->file) == 1 &&
+      fwrite(&trailer, sizeof(trailer), 1, s->file) == 1 &&
+      fflush(s->file) == 0 && journal_sync_file(s->file) == 0;
+  if (fclose(s->file) != 0) ok = false;
+  s->file = NULL;
+  s->segment++;
+  return ok;
+}
+
+static bool sink_write_record(civ_journal_sink_t *s, const uint8_t *rec) {
+  journal_record_head_t head;
+  memcpy(&head, rec, sizeof(head));
+  size_t bytes = sizeof(head) + head.payload_size;
+
+  if (s->file && s->segment_records > 0 &&
+      s->segment_bytes + bytes > CIV_JOURNAL_SEGMENT_BYTES &&
+      !sink_seal_segment(s))
+    return false;
+  if (!s->file && !sink_open_segment(s, head.sequence_id)) return false;
+
+  if (s->segment_records % CIV_JOURNAL_INDEX_STRIDE == 0) {
+    if (s->index_count == s->index_cap) {
+      size_t cap = s->index_cap ? s->index_cap * 2 : 64;
+      journal_index_entry_t *grown = (journal_index_entry_t *)CIV_REALLOC(
+          s->index, cap * sizeof(*grown));
+      if (!grown) return false;
+      s->index = grown;
+      s->index_cap = cap;
+    }
+    s->index[s->index_count++] = (journal_index_entry_t){
+        head.sequence_id, s->segment_bytes, head.turn, head.turn, 0, 0};
+  }
+  if (fwrite(rec, 1, bytes, s->file) != bytes) return false;
+  civ_frame_trace_count(CIV_FRAME_BYTES_WRITTEN, bytes);
+  s->segment_bytes += bytes;
+  s->segment_records++;
+  s->segment_last = head.sequence_id;
+  if (head.type < CIV_JOURNAL_TYPE_COUNT) s->segment_types[head.type]++;
+
+  journal_index_entry_t *block = &s->index[s->index_count - 1];
+  block->turn_min = MIN(block->turn_min, head.turn);
+  block->turn_max = MAX(block->turn_max, head.turn);
+  block->type_mask |= CIV_JOURNAL_TYPE_BIT(head.type);
+  block->context_bloom |= block_bloom_bits(head.context_hash);
+  journal_summary_t *sum = &s->segment_summary;
+  sum->turn_min = MIN(sum->turn_min, head.turn);
+  sum->turn_max = MAX(sum->turn_max, head.turn);
+  sum->type_mask |= CIV_JOURNAL_TYPE_BIT(head.type);
+  summary_bloom_add(sum, head.context_hash);
+  return true;
+}
+
+/* Take everything queued, append it and sync once */
+static void sink_drain(civ_journal_sink_t *s) {
+  SDL_LockMutex(s->lock);
+  s->flush_requested = false;
+  if (s->writing || s->queue_size == 0) {
+    SDL_UnlockMutex(s->lock);
+    return;
+  }
+  uint8_t *batch = s->queue;
+  size_t batch_size = s->queue_size;
+  size_t batch_cap = s->queue_cap;
+  uint64_t through = s->queued_through;
+  s->queue = s->batch;
+  s->queue_cap = s->batch_cap;
+  s->queue_size = 0;
+  s->writing = true;
+  SDL_UnlockMutex(s->lock);
+
+  bool ok = true;
+  for (size_t pos = 0; ok && pos < batch_size;) {
+    journal_record_head_t head;
+    memcpy(&head, batch + pos, sizeof(head));
+    ok = sink_write_record(s, batch + pos);
+    pos += sizeof(head) + head.payload_size;
+  }
+  if (ok && s->file)
+    ok = fflush(s->file) == 0 && journal_sync_file(s->file) == 0;
+
+  SDL_LockMutex(s->lock);
+  s->batch = batch;
+  s->batch_cap = batch_cap;
+  s->writing = false;
+  /* A failed batch is dropped and reported by the next flush */
+  s->synced_through = through;
+  if (!ok && s->error.error == CIV_OK)
+    s->error = (civ_result_t){CIV_ERROR_IO, "Journal IO Error"};
+  SDL_BroadcastCondition(s->done_cv);
+  SDL_UnlockMutex(s->lock);
+}
+
+static int sink_main(void *arg) {
+  civ_journal_sink_t *s = (civ_journal_sink_t *)arg;
+  civ_mem_tag_push(CIV_MEM_TAG_HISTORY);
+  SDL_LockMutex(s->lock);
+  while (!s->stopping || s->queue_size > 0) {
+    if (s->queue_size < CIV_JOURNAL_SYNC_BYTES && !s->flush_requested &&
+        !s->stopping)
+      SDL_WaitConditionTimeout(s->wake_cv, s->lock, CIV_JOURNAL_SYNC_MS);
+    SDL_UnlockMutex(s->lock);
+    sink_drain(s);
+    SDL_LockMutex(s->lock);
+  }
+  SDL_UnlockMutex(s->lock);
+  return 0;
+}
+
+static civ_journal_sink_t *sink_create(const char *db_path,
+                                       uint32_t first_segment) {
+  CIV_MEM_TAG_BEGIN(prev_tag, CIV_MEM_TAG_HISTORY);
+  civ_journal_sink_t *s =
+      (civ_journal_sink_t *)CIV_CALLOC(1, sizeof(civ_journal_sink_t));
+  CIV_MEM_TAG_END(prev_tag);
+  if (!s) return NULL;
+  snprintf(s->db_path, sizeof(s->db_path), "%s", db_path);
+  s->segment = first_segment;
+  s->lock = SDL_CreateMutex();
+  s->wake_cv = SDL_CreateCondition();
+  s->done_cv = SDL_CreateCondition();
+  if (!s->lock || !s->wake_cv || !s->done_cv) {
+    if (s->lock) SDL_DestroyMutex(s->lock);
+    if (s->wake_cv) SDL_DestroyCondition(s->wake_cv);
+    if (s->done_cv) SDL_DestroyCondition(s->done_cv);
+    CIV_FREE(s);
+    return NULL;
+  }
+  /* Without a thread the caller drains; records still batch the same way */
+  s->thread = SDL_CreateThread(sink_main, "civ_journal", s);
+  return s;
+}
+
+/* Block until everything queued so far is on disk */
+static civ_result_t sink_flush(civ_journal_sink_t *s) {
+  if (!s->thread) sink_drain(s);
+  SDL_LockMutex(s->lock);
+  uint64_t target = s->queued_through;
+  if (s->thread) {
+    s->flush_requested = true;
+    SDL_SignalCondition(s->wake_cv);
+    while (s->synced_through < target)
+      SDL_WaitCondition(s->done_cv, s->lock);
+  }
+  civ_result_t res = s->error;
+  s->error = (civ_result_t){CIV_OK, NULL};
+  SDL_UnlockMutex(s->lock);
+  return res.error == CIV_OK ? (civ_result_t){CIV_OK, "Journal Flushed"} : res;
+}
+
+static civ_result_t sink_destroy(civ_journal_sink_t *s) {
+  if (!s) return (civ_result_t){CIV_OK, NULL};
+  civ_result_t res = sink_flush(s);
+  if (s->thread) {
+    SDL_LockMutex(s->lock);
+    s->stopping = true;
+    SDL_SignalCondition(s->wake_cv);
+    SDL_UnlockMutex(s->lock);
+    SDL_WaitThread(s->thread, NULL);
+  }
+  if (!sink_seal_segment(s) && res.error == CIV_OK)
+    res = (civ_result_t){CIV_ERROR_IO, "Journal IO Error"};
+  SDL_DestroyCondition(s->wake_cv);
+  SDL_DestroyCondition(s->done_cv);
+  SDL_DestroyMutex(s->lock);
+  CIV_FREE(s->queue);
+  CIV_FREE(s->batch);
+  CIV_FREE(s->index);
+  CIV_FREE(s);
+  return res;
+}
+
+/* ── Reading segments ─────────────────────────────────────────────── */
+
+typedef struct {
+  civ_mapped_file_t mf;
+  journal_segment_head_t head;
+  journal_trailer_t trailer;
+  journal_summary_t summary;
+  const uint8_t *index;  /* trailer.index_count entries, unaligned */
+  const uint8_t *counts; /* trailer.type_count uint64 counts */
+  bool sealed;
+  uint64_t end;          /* end of the records */
+} segment_view_t;
+
+static void segment_close(segment_view_t *v) { civ_mapped_file_close(&v->mf); }
+
+static bool segment_open(const char *db_path, uint32_t segment,
+                         segment_view_t *v) {
+  char path[272];
+  segment_path(path, sizeof(path), db_path, segment);
+  memset(v, 0, sizeof(*v));
+  if (!civ_mapped_file_open(&v->mf, path)) return false;
+  const uint8_t *data = v->mf.data;
+  size_t size = v->mf.size;
+  if (size < sizeof(v->head)) {
+    segment_close(v);
+    return false;
+  }
+  memcpy(&v->head, data, sizeof(v->head));
+  if (v->head.magic != CIV_JOURNAL_SEGMENT_MAGIC ||
+      v->head.version != CIV_JOURNAL_FORMAT_VERSION) {
+    segment_close(v);
+    return false;
+  }
+  v->end = size;
+
+  size_t tail = sizeof(v->summary) + sizeof(v->trailer);
+  if (size < sizeof(v->head) + tail) return true;
+  memcpy(&v->trailer, data + size - sizeof(v->trailer), sizeof(v->trailer));
+  uint64_t footer =
+      (uint64_t)v->trailer.index_count * sizeof(journal_index_entry_t) +
+      (uint64_t)v->trailer.type_count * sizeof(uint64_t) + tail;
+  if (v->trailer.magic == CIV_JOURNAL_INDEX_MAGIC &&
+      v->trailer.index_offset >= sizeof(v->head) &&
+      v->trailer.index_offset + footer == size) {
+    v->sealed = true;
+    v->end = v->trailer.index_offset;
+    v->index = data + v->trailer.index_offset;
+    v->counts = v->index +
+                (size_t)v->trailer.index_count * sizeof(journal_index_entry_t);
+    memcpy(&v->summary, data + size - tail, sizeof(v->summary));
+  }
+  return true;
+}
+
+static journal_index_entry_t segment_block(const segment_view_t *v,
+                                           uint32_t i) {
+  journal_index_entry_t e;
+  memcpy(&e, v->index + (size_t)i * sizeof(e), sizeof(e));
+  return e;
+}
+
+/* Record at pos; false at the end or at a torn or damaged record. Sealed
+   segments were synced whole before their footer, so only an unsealed
+   tail has its checksums verified. */
+static bool segment_record(const segment_view_t *v, uint64_t *pos,
+                           journal_record_head_t *head,
+                           const uint8_t **payload) {
+  if (*pos + sizeof(*head) > v->end) return false;
+  memcpy(head, v->mf.data + *pos, sizeof(*head));
+  if (head->context_len > CIV_JOURNAL_CONTEXT_MAX ||
+      head->payload_size < head->context_len ||
+      head->payload_size - head->context_len > CIV_JOURNAL_DATA_MAX ||
+      *pos + sizeof(*head) + head->payload_size > v->end)
+    return false;
+  *payload = v->mf.data + *pos + sizeof(*head);
+  if (!v->sealed && journal_checksum(*head, *payload) != head->checksum)
+    return false;
+  *pos += sizeof(*head) + head->payload_size;
+  return true;
+}
+
+/* ── Queries ──────────────────────────────────────────────────────── */
+
+typedef struct {
+  const civ_journal_query_t *q;
+  size_t context_len;
+  uint32_t context_hash;
+  civ_journal_visit_fn_t fn;
+  void *user_data;
+} query_state_t;
+
+static bool zone_may_match(const civ_journal_query_t *q, uint32_t type_mask,
+                           int32_t turn_min, int32_t turn_max) {
+  return (!q->type_mask || (type_mask & q->type_mask)) &&
+         turn_max >= q->turn_min && turn_min <= q->turn_max;
+}
+
+/* Visit the matching records in [pos, stop); false once fn stops */
+static bool scan_records(const segment_view_t *v, uint64_t pos, uint64_t stop,
+                         const query_state_t *qs) {
+  const civ_journal_query_t *q = qs->q;
+  char context[CIV_JOURNAL_CONTEXT_MAX + 1];
+  journal_record_head_t h;
+  const uint8_t *payload;
+  if (pos < sizeof(v->head)) return true;
+  while (pos < stop && segment_record(v, &pos, &h, &payload)) {
+    if (h.sequence_id < q->from_sequence || h.turn < q->turn_min ||
+        h.turn > q->turn_max ||
+        (q->type_mask && !(q->type_mask & CIV_JOURNAL_TYPE_BIT(h.type))))
+      continue;
+    if (q->context &&
+        (h.context_hash != qs->context_hash ||
+         h.context_len != qs->context_len ||
+         memcmp(payload, q->context, qs->context_len) != 0))
+      continue;
+    memcpy(context, payload, h.context_len);
+    context[h.context_len] = '\0';
+    civ_event_t e = {h.sequence_id, h.timestamp, h.turn,
+                     (civ_journal_event_type_t)h.type, context,
+                     payload + h.context_len,
+                     h.payload_size - h.context_len};
+    if (!qs->fn(&e, qs->user_data)) return false;
+  }
+  return true;
+}
+
+static bool segment_query(const segment_view_t *v, const query_state_t *qs) {
+  const civ_journal_query_t *q = qs->q;
+  if (!v->sealed || v->trailer.index_count == 0)
+    return scan_records(v, sizeof(v->head), v->end, qs);
+
+  if (v->trailer.last_sequence < q->from_sequence ||
+      !zone_may_match(q, v->summary.type_mask, v->summary.turn_min,
+                      v->summary.turn_max) ||
+      (q->context && !summary_bloom_test(&v->summary, qs->context_hash)))
+    return true;
+
+  uint32_t bits = block_bloom_bits(qs->context_hash);
+  uint32_t blocks = v->trailer.index_count;
+  journal_index_entry_t b = segment_block(v, 0);
+  for (uint32_t i = 0; i < blocks; i++) {
+    journal_index_entry_t next = i + 1 < blocks ? segment_block(v, i + 1) : b;
+    uint64_t stop = i + 1 < blocks ? next.offset : v->end;
+    bool skip = (i + 1 < blocks && next.sequence_id <= q->from_sequence) ||
+                !zone_may_match(q, b.type_mask, b.turn_min, b.turn_max) ||
+                (q->context && (b.context_bloom & bits) != bits);
+    if (!skip && !scan_records(v, b.offset, MIN(stop, v->end), qs))
+      return false;
+    b = next;
+  }
+  return true;
+}
+
+/* ── Journal ──────────────────────────────────────────────────────── */
+
+static void remove_segments(const char *db_path) {
+  char path[272];
+  for (uint32_t seg = 0;; seg++) {
+    segment_path(path, sizeof(path), db_path, seg);
+    if (remove(path) != 0) break;
+  }
 }
 
 civ_journal_t *civ_journal_create(const char *path) {
+  CIV_MEM_TAG_BEGIN(prev_tag, CIV_MEM_TAG_HISTORY);
   civ_journal_t *j = (civ_journal_t *)CIV_MALLOC(sizeof(civ_journal_t));
+  CIV_MEM_TAG_END(prev_tag);
   if (!j)
     return NULL;
 
   memset(j, 0, sizeof(civ_journal_t));
   j->format_version = CIV_JOURNAL_FORMAT_VERSION;
+  j->next_sequence = 1;
 
-  civ_result_t r = civ_journal_reserve(j, 1024);
-  if (CIV_FAILED(r)) {
-    CIV_FREE(j);
-    return NULL;
-  }
-
-  if (path)
+  if (path && path[0]) {
     strncpy(j->db_path, path, sizeof(j->db_path) - 1);
+    remove_segments(j->db_path);
+    j->sink = sink_create(j->db_path, 0);
+    if (!j->sink) {
+      CIV_FREE(j);
+      return NULL;
+    }
+  }
 
   return j;
 }
 
 void civ_journal_destroy(civ_journal_t *j) {
   if (j) {
-    civ_journal_flush(j);
-    CIV_FREE(j->journal);
+    sink_destroy(j->sink);
     CIV_FREE(j);
   }
 }
@@ -73,108 +549,183 @@ civ_result_t civ_journal_log(civ_journal_t *j, civ_journal_event_type_t type,
                              size_t size) {
   if (!j)
     return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null journal"};
+  if ((unsigned)type >= CIV_JOURNAL_TYPE_COUNT || size > CIV_JOURNAL_DATA_MAX)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Invalid journal event"};
+  if (!data)
+    size = 0;
 
-  civ_result_t reserve_result = civ_journal_reserve(j, j->event_count + 1);
-  if (CIV_FAILED(reserve_result))
-    return reserve_result;
+  uint64_t sequence = j->next_sequence++;
+  j->event_count++;
+  j->type_counts[type]++;
 
-  civ_event_t *e = &j->journal[j->event_count++];
-  memset(e, 0, sizeof(*e));
-  e->sequence_id = (uint64_t)j->event_count;
-  e->timestamp = (uint32_t)time(NULL);
-  e->type = type;
-  e->data_size = (size > sizeof(e->data)) ? sizeof(e->data) : size;
-
-  if (context)
-    strncpy(e->context, context, sizeof(e->context) - 1);
-  if (data && e->data_size > 0)
-    memcpy(e->data, data, e->data_size);
-
-  if ((j->event_count % 256) == 0)
-    return civ_journal_flush(j);
+  civ_journal_sink_t *s = j->sink;
+  if (!s)
+    return (civ_result_t){CIV_OK, NULL};
 
+  size_t context_len = context ? strlen(context) : 0;
+  if (context_len > CIV_JOURNAL_CONTEXT_MAX)
+    context_len = CIV_JOURNAL_CONTEXT_MAX;
+  journal_record_head_t head = {(uint32_t)(context_len + size),
+                                (uint16_t)type,
+                                (uint16_t)context_len,
+                                sequence,
+                                (uint32_t)time(NULL),
+                                j->current_turn,
+                                context_hash(context, context_len),
+                                0};
+  size_t bytes = sizeof(head) + head.payload_size;
+
+  SDL_LockMutex(s->lock);
+  if (s->queue_size + bytes > s->queue_cap) {
+    size_t cap = s->queue_cap ? s->queue_cap : CIV_JOURNAL_SYNC_BYTES;
+    while (cap < s->queue_size + bytes) cap *= 2;
+    CIV_MEM_TAG_BEGIN(prev_tag, CIV_MEM_TAG_HISTORY);
+    uint8_t *grown = (uint8_t *)CIV_REALLOC(s->queue, cap);
+    CIV_MEM_TAG_END(prev_tag);
+    if (!grown) {
+      SDL_UnlockMutex(s->lock);
+      return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Journal queue full"};
+    }
+    s->queue = grown;
+    s->queue_cap = cap;
+  }
+  uint8_t *rec = s->queue + s->queue_size;
+  if (context_len) memcpy(rec + sizeof(head), context, context_len);
+  if (size) memcpy(rec + sizeof(head) + context_len, data, size);
+  head.checksum = journal_checksum(head, rec + sizeof(head));
+  memcpy(rec, &head, sizeof(head));
+  s->queue_size += bytes;
+  s->queued_through = sequence;
+  bool wake = s->queue_size >= CIV_JOURNAL_SYNC_BYTES;
+  if (wake && s->thread) SDL_SignalCondition(s->wake_cv);
+  SDL_UnlockMutex(s->lock);
+
+  if (wake && !s->thread)
+    sink_drain(s);
   return (civ_result_t){CIV_OK, NULL};
 }
 
 civ_result_t civ_journal_flush(civ_journal_t *j) {
-  if (!j || !j->db_path[0])
+  if (!j || !j->sink)
     return (civ_result_t){CIV_OK, NULL};
-
-  FILE *f = fopen(j->db_path, "wb");
-  if (!f)
-    return (civ_result_t){CIV_ERROR_IO, "Journal IO Error"};
-
-  civ_journal_file_header_t header = {CIV_JOURNAL_FORMAT_MAGIC,
-                                      j->format_version,
-                                      (uint64_t)j->event_count};
-
-  if (fwrite(&header, sizeof(header), 1, f) != 1) {
-    fclose(f);
-    return (civ_result_t){CIV_ERROR_IO, "Failed writing journal header"};
-  }
-
-  if (j->event_count > 0 &&
-      fwrite(j->journal, sizeof(civ_event_t), j->event_count, f) !=
-          j->event_count) {
-    fclose(f);
-    return (civ_result_t){CIV_ERROR_IO, "Failed writing journal events"};
-  }
-
-  fclose(f);
-  return (civ_result_t){CIV_OK, "Journal Flushed"};
+  return sink_flush(j->sink);
 }
 
 civ_result_t civ_journal_load(civ_journal_t *j, const char *path) {
   if (!j || !path)
     return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null args"};
 
-  FILE *f = fopen(path, "rb");
-  if (!f)
+  segment_view_t v;
+  if (!segment_open(path, 0, &v))
     return (civ_result_t){CIV_ERROR_IO, "Journal Not Found"};
-
-  civ_journal_file_header_t header = {0};
-  if (fread(&header, sizeof(header), 1, f) != 1) {
-    fclose(f);
-    return (civ_result_t){CIV_ERROR_IO, "Invalid Journal Header"};
+  segment_close(&v);
+
+  sink_destroy(j->sink);
+  j->sink = NULL;
+  j->event_count = 0;
+  j->next_sequence = 1;
+  memset(j->type_counts, 0, sizeof(j->type_counts));
+
+  /* Sealed segments are summed from their footers; only an unsealed one
+     (the session that wrote it ended without closing) is scanned */
+  uint32_t seg = 0;
+  for (; segment_open(path, seg, &v); seg++) {
+    if (v.sealed) {
+      uint32_t n = MIN(v.trailer.type_count, (uint32_t)CIV_JOURNAL_TYPE_COUNT);
+      for (uint32_t t = 0; t < n; t++) {
+        uint64_t count;
+        memcpy(&count, v.counts + t * sizeof(count), sizeof(count));
+        j->type_counts[t] += (size_t)count;
+      }
+      j->event_count += v.trailer.record_count;
+      if (v.trailer.record_count)
+        j->next_sequence = v.trailer.last_sequence + 1;
+    } else {
+      uint64_t pos = sizeof(v.head);
+      journal_record_head_t h;
+      const uint8_t *payload;
+      while (segment_record(&v, &pos, &h, &payload)) {
+        if (h.type < CIV_JOURNAL_TYPE_COUNT) j->type_counts[h.type]++;
+        j->event_count++;
+        j->next_sequence = h.sequence_id + 1;
+      }
+    }
+    segment_close(&v);
   }
 
-  if (header.magic != CIV_JOURNAL_FORMAT_MAGIC) {
-    fclose(f);
-    return (civ_result_t){CIV_ERROR_INVALID_STATE, "Unsupported journal file"};
-  }
+  j->format_version = CIV_JOURNAL_FORMAT_VERSION;
+  memset(j->db_path, 0, sizeof(j->db_path));
+  strncpy(j->db_path, path, sizeof(j->db_path) - 1);
+  j->sink = sink_create(j->db_path, seg);
+  if (!j->sink)
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Journal writer failed"};
+
+  return (civ_result_t){CIV_OK, "Journal Loaded"};
+}
+
+void civ_journal_set_turn(civ_journal_t *j, int32_t turn) {
+  if (j)
+    j->current_turn = turn;
+}
 
-  civ_result_t reserve_result = civ_journal_reserve(j, (size_t)header.event_count);
-  if (CIV_FAILED(reserve_result)) {
-    fclose(f);
-    return reserve_result;
+void civ_journal_query_init(civ_journal_query_t *q) {
+  if (!q)
+    return;
+  memset(q, 0, sizeof(*q));
+  q->turn_min = INT32_MIN;
+  q->turn_max = INT32_MAX;
+}
+
+civ_result_t civ_journal_query(civ_journal_t *j, const civ_journal_query_t *q,
+                               civ_journal_visit_fn_t fn, void *user_data) {
+  if (!j || !q || !fn)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null args"};
+  if (!j->db_path[0])
+    return (civ_result_t){CIV_OK, NULL};
+  civ_result_t res = civ_journal_flush(j);
+  if (CIV_FAILED(res))
+    return res;
+
+  query_state_t qs = {q, 0, 0, fn, user_data};
+  if (q->context) {
+    qs.context_len = MIN(strlen(q->context), (size_t)CIV_JOURNAL_CONTEXT_MAX);
+    qs.context_hash = context_hash(q->context, qs.context_len);
   }
 
-  size_t read_count = 0;
-  if (header.event_count > 0) {
-    read_count =
-        fread(j->journal, sizeof(civ_event_t), (size_t)header.event_count, f);
+  /* Segments are mapped by path while the writer may hold the last one
+     open; everything flushed above is already in the file */
+  segment_view_t v;
+  bool more = true;
+  for (uint32_t seg = 0; more && segment_open(j->db_path, seg, &v); seg++) {
+    more = segment_query(&v, &qs);
+    segment_close(&v);
   }
-  fclose(f);
+  return (civ_result_t){CIV_OK, NULL};
+}
 
-  if (read_count != (size_t)header.event_count)
-    return (civ_result_t){CIV_ERROR_IO, "Corrupted journal data"};
+static bool count_visit(const civ_event_t *event, void *user_data) {
+  (void)event;
+  (*(size_t *)user_data)++;
+  return true;
+}
 
-  j->event_count = read_count;
-  j->format_version = header.version;
-  strncpy(j->db_path, path, sizeof(j->db_path) - 1);
+size_t civ_journal_query_count(civ_journal_t *j, const civ_journal_query_t *q) {
+  size_t count = 0;
+  civ_journal_query(j, q, count_visit, &count);
+  return count;
+}
 
-  return (civ_result_t){CIV_OK, "Journal Loaded"};
+civ_result_t civ_journal_replay(civ_journal_t *j, uint64_t from_sequence,
+                                civ_journal_visit_fn_t fn, void *user_data) {
+  civ_journal_query_t q;
+  civ_journal_query_init(&q);
+  q.from_sequence = from_sequence;
+  return civ_journal_query(j, &q, fn, user_data);
 }
 
 size_t civ_journal_count_by_type(const civ_journal_t *j,
                                  civ_journal_event_type_t type) {
-  if (!j)
+  if (!j || (unsigned)type >= CIV_JOURNAL_TYPE_COUNT)
     return 0;
-
-  size_t count = 0;
-  for (size_t i = 0; i < j->event_count; i++) {
-    if (j->journal[i].type == type)
-      count++;
-  }
-  return count;
+  return j->type_counts[type];
 }
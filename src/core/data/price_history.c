@@ -0,0 +1,161 @@
+/**
+ * @file price_history.c
+ * @brief Min/max/mean bucket rings at 1, 10 and 100 turns per bucket.
+ */
+
+#include "core/data/price_history.h"
+#include <string.h>
+
+static const int32_t level_span[CIV_PRICE_HISTORY_LEVELS] = {1, 10, 100};
+
+static int32_t bucket_start(int32_t turn, int32_t span) {
+  int32_t q = turn / span;
+  if (turn % span < 0)
+    q--;
+  return q * span;
+}
+
+/* Closed buckets oldest first, then the open one if it has samples */
+static size_t level_size(const civ_price_level_t *l) {
+  return l->count + (l->open.count ? 1 : 0);
+}
+
+static const civ_price_bucket_t *bucket_at(const civ_price_level_t *l,
+                                           size_t i) {
+  if (i == l->count)
+    return &l->open;
+  return &l->buckets[(l->head + CIV_PRICE_HISTORY_CAPACITY - l->count + i) %
+                     CIV_PRICE_HISTORY_CAPACITY];
+}
+
+void civ_price_history_init(civ_price_history_t *h) {
+  if (h)
+    memset(h, 0, sizeof(*h));
+}
+
+bool civ_price_history_has_data(const civ_price_history_t *h) {
+  return h && h->levels[0].open.count > 0;
+}
+
+void civ_price_history_record(civ_price_history_t *h, int32_t turn,
+                              float price) {
+  if (!h)
+    return;
+  if (!civ_price_history_has_data(h) || turn < h->last_turn) {
+    civ_price_history_init(h);
+    h->first_turn = turn;
+  }
+
+  for (int k = 0; k < CIV_PRICE_HISTORY_LEVELS; k++) {
+    civ_price_level_t *l = &h->levels[k];
+    int32_t start = bucket_start(turn, level_span[k]);
+
+    if (l->open.count && l->open.start != start) {
+      l->buckets[l->head] = l->open;
+      l->head = (l->head + 1) % CIV_PRICE_HISTORY_CAPACITY;
+      if (l->count < CIV_PRICE_HISTORY_CAPACITY)
+        l->count++;
+      l->open.count = 0;
+    }
+    if (!l->open.count) {
+      l->open.start = start;
+      l->open.min = l->open.max = price;
+      l->open.sum = 0.0f;
+    }
+    if (l->open.count == UINT16_MAX)
+      continue;
+    l->open.count++;
+    l->open.sum += price;
+    if (price < l->open.min)
+      l->open.min = price;
+    if (price > l->open.max)
+      l->open.max = price;
+  }
+
+  /* The coarsest ring dropping its oldest bucket is the only way samples
+     leave the history */
+  const civ_price_level_t *coarse = &h->levels[CIV_PRICE_HISTORY_LEVELS - 1];
+  int32_t oldest = bucket_at(coarse, 0)->start;
+  if (oldest > h->first_turn)
+    h->first_turn = oldest;
+  h->last_turn = turn;
+}
+
+/* First bucket of l that ends at or after turn */
+static size_t lower_bound(const civ_price_level_t *l, int32_t span,
+                          int32_t turn) {
+  size_t lo = 0, hi = level_size(l);
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (bucket_at(l, mid)->start + span - 1 < turn)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+size_t civ_price_history_read(const civ_price_history_t *h, int32_t turn_min,
+                              int32_t turn_max, size_t max_points,
+                              float *turns, float *mins, float *maxs,
+                              float *avgs) {
+  if (!civ_price_history_has_data(h) || max_points == 0 || turn_max < turn_min)
+    return 0;
+  if (turn_min < h->first_turn)
+    turn_min = h->first_turn;
+  if (turn_max > h->last_turn)
+    turn_max = h->last_turn;
+  if (turn_max < turn_min)
+    return 0;
+
+  /* Finest level that still holds turn_min and spans the window in at
+     most max_points buckets */
+  int k = 0;
+  for (; k < CIV_PRICE_HISTORY_LEVELS - 1; k++) {
+    const civ_price_level_t *l = &h->levels[k];
+    int32_t span = level_span[k];
+    size_t needed = (size_t)((bucket_start(turn_max, span) -
+                              bucket_start(turn_min, span)) / span) + 1;
+    if (bucket_at(l, 0)->start <= turn_min && needed <= max_points)
+      break;
+  }
+  const civ_price_level_t *l = &h->levels[k];
+  int32_t span = level_span[k];
+
+  size_t first = lower_bound(l, span, turn_min);
+  size_t last = first;
+  size_t size = level_size(l);
+  while (last < size && bucket_at(l, last)->start <= turn_max)
+    last++;
+  size_t in_range = last - first;
+  if (in_range == 0)
+    return 0;
+
+  /* Only the coarsest level can still be over budget */
+  size_t group = (in_range + max_points - 1) / max_points;
+  size_t written = 0;
+  for (size_t i = first; i < last; i += group) {
+    const civ_price_bucket_t *b = bucket_at(l, i);
+    float lo = b->min, hi = b->max, sum = 0.0f;
+    uint32_t count = 0;
+    for (size_t j = i; j < i + group && j < last; j++) {
+      const civ_price_bucket_t *g = bucket_at(l, j);
+      if (g->min < lo)
+        lo = g->min;
+      if (g->max > hi)
+        hi = g->max;
+      sum += g->sum;
+      count += g->count;
+    }
+    if (turns)
+      turns[written] = (float)b->start;
+    if (mins)
+      mins[written] = lo;
+    if (maxs)
+      maxs[written] = hi;
+    if (avgs)
+      avgs[written] = count ? sum / (float)count : lo;
+    written++;
+  }
+  return written;
+}
@@ -0,0 +1,1183 @@
+/**
+ * @file query.c
+ * @brief Query compiler, column snapshots and vectorized evaluation
+ */
+
+#include "core/data/query.h"
+#include "core/game.h"
+#include "core/world/nation.h"
+#include <SDL3/SDL.h>
+#include <ctype.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ── Fields ─────────────────────────────────────────────────────────── */
+
+typedef enum {
+  FIELD_GDP = 0,
+  FIELD_GDP_PER_CAPITA,
+  FIELD_GDP_GROWTH,
+  FIELD_INFLATION,
+  FIELD_UNEMPLOYMENT,
+  FIELD_TAX_REVENUE,
+  FIELD_STABILITY,
+  FIELD_LEGITIMACY,
+  FIELD_POPULATION,
+  FIELD_LAND_TILES,
+  FIELD_LAND_KM2,
+  FIELD_ARABLE_KM2,
+  FIELD_WARS,
+  FIELD_AT_WAR,
+  FIELD_NEIGHBOURS,
+  FIELD_PLAYER,
+  FIELD_INDEX,
+  FIELD_COUNT
+} query_field_t;
+
+static const struct {
+  const char *name;
+  int series; /* civ_series_metric_t kept in the history, -1 = none */
+} k_fields[FIELD_COUNT] = {
+    {"gdp", CIV_SERIES_GDP},
+    {"gdp_per_capita", -1},
+    {"gdp_growth", -1},
+    {"inflation", CIV_SERIES_INFLATION},
+    {"unemployment", CIV_SERIES_UNEMPLOYMENT},
+    {"tax_revenue", CIV_SERIES_TAX_REVENUE},
+    {"stability", CIV_SERIES_STABILITY},
+    {"legitimacy", CIV_SERIES_LEGITIMACY},
+    {"population", -1},
+    {"land_tiles", -1},
+    {"land_km2", -1},
+    {"arable_km2", -1},
+    {"wars", -1},
+    {"at_war", -1},
+    {"neighbours", -1},
+    {"player", -1},
+    {"index", -1},
+};
+
+const char *civ_query_field_name(int i) {
+  return i >= 0 && i < FIELD_COUNT ? k_fields[i].name : NULL;
+}
+
+/* ── Compiled form ──────────────────────────────────────────────────── */
+
+typedef enum {
+  NODE_NUM = 0,
+  NODE_FIELD,
+  NODE_NEG,
+  NODE_NOT,
+  NODE_ADD,
+  NODE_SUB,
+  NODE_MUL,
+  NODE_DIV,
+  NODE_LT,
+  NODE_LE,
+  NODE_GT,
+  NODE_GE,
+  NODE_EQ,
+  NODE_NE,
+  NODE_AND,
+  NODE_OR,
+  NODE_BORDERS,     /* join over border pairs */
+  NODE_AT_WAR_WITH  /* join over war pairs */
+} node_kind_t;
+
+/* Children always come before their parent, so evaluating the nodes in
+   order has every operand ready */
+typedef struct {
+  uint8_t kind;
+  int16_t a, b;
+  int16_t field;
+  double num;
+} query_node_t;
+
+typedef enum {
+  AGG_NONE = 0,
+  AGG_COUNT,
+  AGG_SUM,
+  AGG_AVG,
+  AGG_MIN,
+  AGG_MAX
+} query_agg_t;
+
+typedef struct {
+  uint8_t agg;
+  int16_t node; /* -1 for count */
+  char label[CIV_QUERY_LABEL_MAX];
+} query_item_t;
+
+#define QUERY_TEXT_MAX 4096 /* bounds the parser's recursion */
+
+/* What a snapshot must copy */
+#define NEED_BORDERS 0x1u
+#define NEED_WARS    0x2u
+
+struct civ_query {
+  query_node_t nodes[CIV_QUERY_MAX_NODES];
+  int node_count;
+  query_item_t items[CIV_QUERY_MAX_SELECT];
+  int item_count;
+  bool aggregate;
+  int16_t where;  /* -1 = every nation */
+  int16_t order;  /* -1 = nation order */
+  bool descending;
+  int64_t limit;  /* < 0 = none */
+
+  /* Time range for history fields */
+  bool has_range;
+  bool range_last; /* range_min is a count of turns back from the snapshot */
+  int32_t range_min, range_max;
+
+  uint32_t fields_read; /* bit per query_field_t */
+  uint32_t needs;
+};
+
+/* ── Parser ─────────────────────────────────────────────────────────── */
+
+typedef enum {
+  TOK_END = 0,
+  TOK_NUM,
+  TOK_IDENT,
+  TOK_OP /* punctuation and operators, in text */
+} token_kind_t;
+
+typedef struct {
+  const char *src;
+  const char *pos;
+  token_kind_t kind;
+  const char *start; /* of the current token */
+  size_t len;
+  double num;
+  civ_query_t *q;
+  int depth; /* of nested parentheses and joins */
+  char *error;
+  size_t error_size;
+  bool failed;
+} parser_t;
+
+static void fail(parser_t *p, const char *fmt, ...) {
+  if (p->failed)
+    return;
+  p->failed = true;
+  if (!p->error || p->error_size == 0)
+    return;
+  int at = snprintf(p->error, p->error_size, "at %d: ",
+                    (int)(p->start - p->src) + 1);
+  if (at < 0 || (size_t)at >= p->error_size)
+    return;
+  va_list ap;
+  va_start(ap, fmt);
+  vsnprintf(p->error + at, p->error_size - (size_t)at, fmt, ap);
+  va_end(ap);
+}
+
+static void next(parser_t *p) {
+  const char *s = p->pos;
+  while (isspace((unsigned char)*s))
+    s++;
+  p->start = s;
+  if (*s == '\0') {
+    p->kind = TOK_END;
+    p->len = 0;
+  } else if (isdigit((unsigned char)*s) ||
+             (*s == '.' && isdigit((unsigned char)s[1]))) {
+    /* Digits by hand, so 100..200 stops at the range dots */
+    const char *e = s;
+    while (isdigit((unsigned char)*e))
+      e++;
+    if (*e == '.' && isdigit((unsigned char)e[1]))
+      for (e++; isdigit((unsigned char)*e);)
+        e++;
+    if ((*e == 'e' || *e == 'E') &&
+        (isdigit((unsigned char)e[1]) ||
+         ((e[1] == '+' || e[1] == '-') && isdigit((unsigned char)e[2]))))
+      for (e += 2; isdigit((unsigned char)*e);)
+        e++;
+    char buf[64];
+    size_t n = MIN((size_t)(e - s), sizeof(buf) - 1);
+    memcpy(buf, s, n);
+    buf[n] = '\0';
+    p->kind = TOK_NUM;
+    p->num = strtod(buf, NULL);
+    if (*e == '%') {
+      p->num /= 100.0;
+      e++;
+    }
+    s = e;
+  } else if (isalpha((unsigned char)*s) || *s == '_') {
+    while (isalnum((unsigned char)*s) || *s == '_')
+      s++;
+    p->kind = TOK_IDENT;
+  } else if ((s[0] == '<' || s[0] == '>' || s[0] == '!' || s[0] == '=') &&
+             s[1] == '=') {
+    s += 2;
+    p->kind = TOK_OP;
+  } else if (s[0] == '.' && s[1] == '.') {
+    s += 2;
+    p->kind = TOK_OP;
+  } else if (strchr("<>=+-*/(),", *s)) {
+    s++;
+    p->kind = TOK_OP;
+  } else {
+    p->len = 1;
+    fail(p, "unexpected '%c'", *s);
+    p->kind = TOK_END;
+    return;
+  }
+  p->len = (size_t)(s - p->start);
+  p->pos = s;
+}
+
+static bool is(const parser_t *p, const char *text) {
+  size_t n = strlen(text);
+  if (p->kind == TOK_END || p->len != n)
+    return false;
+  if (p->kind == TOK_IDENT) {
+    for (size_t i = 0; i < n; i++)
+      if (tolower((unsigned char)p->start[i]) != text[i])
+        return false;
+    return true;
+  }
+  return memcmp(p->start, text, n) == 0;
+}
+
+static bool accept(parser_t *p, const char *text) {
+  if (!is(p, text))
+    return false;
+  next(p);
+  return true;
+}
+
+static void expect(parser_t *p, const char *text) {
+  if (!accept(p, text))
+    fail(p, "expected '%s'", text);
+}
+
+static int16_t add_node(parser_t *p, node_kind_t kind, int16_t a, int16_t b) {
+  civ_query_t *q = p->q;
+  if (p->failed)
+    return -1;
+  if (q->node_count >= CIV_QUERY_MAX_NODES) {
+    fail(p, "query too long");
+    return -1;
+  }
+  query_node_t *n = &q->nodes[q->node_count];
+  memset(n, 0, sizeof(*n));
+  n->kind = (uint8_t)kind;
+  n->a = a;
+  n->b = b;
+  n->field = -1;
+  return (int16_t)q->node_count++;
+}
+
+static int16_t parse_expr(parser_t *p);
+
+static int16_t parse_primary(parser_t *p) {
+  if (p->failed)
+    return -1;
+  if (p->kind == TOK_NUM) {
+    int16_t n = add_node(p, NODE_NUM, -1, -1);
+    if (n >= 0)
+      p->q->nodes[n].num = p->num;
+    next(p);
+    return n;
+  }
+  if (accept(p, "(")) {
+    int16_t n = parse_expr(p);
+    expect(p, ")");
+    return n;
+  }
+  if (p->kind == TOK_IDENT) {
+    node_kind_t join = is(p, "borders")       ? NODE_BORDERS
+                       : is(p, "at_war_with") ? NODE_AT_WAR_WITH
+                                              : NODE_NUM;
+    if (join != NODE_NUM) {
+      next(p);
+      expect(p, "(");
+      int16_t inner = parse_expr(p);
+      expect(p, ")");
+      p->q->needs |= join == NODE_BORDERS ? NEED_BORDERS : NEED_WARS;
+      return add_node(p, join, inner, -1);
+    }
+    for (int f = 0; f < FIELD_COUNT; f++) {
+      if (!is(p, k_fields[f].name))
+        continue;
+      next(p);
+      int16_t n = add_node(p, NODE_FIELD, -1, -1);
+      if (n >= 0) {
+        p->q->nodes[n].field = (int16_t)f;
+        p->q->fields_read |= 1u << f;
+      }
+      if (f == FIELD_WARS || f == FIELD_AT_WAR)
+        p->q->needs |= NEED_WARS;
+      else if (f == FIELD_NEIGHBOURS)
+        p->q->needs |= NEED_BORDERS;
+      return n;
+    }
+    fail(p, "unknown field '%.*s'", (int)p->len, p->start);
+    return -1;
+  }
+  if (p->kind == TOK_END)
+    fail(p, "unexpected end");
+  else
+    fail(p, "unexpected '%.*s'", (int)p->len, p->start);
+  return -1;
+}
+
+static int16_t parse_unary(parser_t *p) {
+  if (accept(p, "-"))
+    return add_node(p, NODE_NEG, parse_unary(p), -1);
+  return parse_primary(p);
+}
+
+static int16_t parse_term(parser_t *p) {
+  int16_t n = parse_unary(p);
+  for (;;) {
+    if (accept(p, "*"))
+      n = add_node(p, NODE_MUL, n, parse_unary(p));
+    else if (accept(p, "/"))
+      n = add_node(p, NODE_DIV, n, parse_unary(p));
+    else
+      return n;
+  }
+}
+
+static int16_t parse_sum(parser_t *p) {
+  int16_t n = parse_term(p);
+  for (;;) {
+    if (accept(p, "+"))
+      n = add_node(p, NODE_ADD, n, parse_term(p));
+    else if (accept(p, "-"))
+      n = add_node(p, NODE_SUB, n, parse_term(p));
+    else
+      return n;
+  }
+}
+
+static int16_t parse_compare(parser_t *p) {
+  static const struct {
+    const char *op;
+    node_kind_t kind;
+  } ops[] = {{"<=", NODE_LE}, {">=", NODE_GE}, {"!=", NODE_NE},
+             {"<", NODE_LT},  {">", NODE_GT},  {"=", NODE_EQ}};
+  int16_t n = parse_sum(p);
+  for (size_t i = 0; i < ARRAY_SIZE(ops); i++)
+    if (accept(p, ops[i].op))
+      return add_node(p, ops[i].kind, n, parse_sum(p));
+  return n;
+}
+
+static int16_t parse_not(parser_t *p) {
+  if (accept(p, "not"))
+    return add_node(p, NODE_NOT, parse_not(p), -1);
+  return parse_compare(p);
+}
+
+static int16_t parse_and(parser_t *p) {
+  int16_t n = parse_not(p);
+  while (accept(p, "and"))
+    n = add_node(p, NODE_AND, n, parse_not(p));
+  return n;
+}
+
+static int16_t parse_expr(parser_t *p) {
+  if (++p->depth > 32) {
+    fail(p, "nested too deep");
+    return -1;
+  }
+  int16_t n = parse_and(p);
+  while (accept(p, "or"))
+    n = add_node(p, NODE_OR, n, parse_and(p));
+  p->depth--;
+  return n;
+}
+
+static void parse_item(parser_t *p) {
+  civ_query_t *q = p->q;
+  if (q->item_count >= CIV_QUERY_MAX_SELECT) {
+    fail(p, "more than %d columns", CIV_QUERY_MAX_SELECT);
+    return;
+  }
+  query_item_t *item = &q->items[q->item_count++];
+  const char *from = p->start;
+  static const struct {
+    const char *name;
+    query_agg_t agg;
+  } aggs[] = {{"sum", AGG_SUM}, {"avg", AGG_AVG}, {"min", AGG_MIN},
+              {"max", AGG_MAX}};
+
+  item->agg = AGG_NONE;
+  item->node = -1;
+  if (accept(p, "count")) {
+    item->agg = AGG_COUNT;
+  } else {
+    for (size_t i = 0; i < ARRAY_SIZE(aggs) && item->agg == AGG_NONE; i++) {
+      if (!accept(p, aggs[i].name))
+        continue;
+      item->agg = (uint8_t)aggs[i].agg;
+      expect(p, "(");
+      item->node = parse_expr(p);
+      expect(p, ")");
+    }
+    if (item->agg == AGG_NONE)
+      item->node = parse_expr(p);
+  }
+  bool agg = item->agg != AGG_NONE;
+  if (q->item_count > 1 && agg != q->aggregate)
+    fail(p, "aggregates and plain columns cannot be mixed");
+  q->aggregate = agg;
+
+  size_t n = MIN((size_t)(p->start - from), sizeof(item->label) - 1);
+  while (n > 0 && isspace((unsigned char)from[n - 1]))
+    n--;
+  memcpy(item->label, from, n);
+  item->label[n] = '\0';
+}
+
+/* A whole number for a turn or a limit */
+static int32_t parse_whole(parser_t *p, const char *what) {
+  if (p->kind != TOK_NUM || p->num < 0.0 || p->num > 2e9 ||
+      p->num != floor(p->num)) {
+    fail(p, "expected %s", what);
+    return 0;
+  }
+  int32_t v = (int32_t)p->num;
+  next(p);
+  return v;
+}
+
+civ_query_t *civ_query_compile(const char *text, char *error,
+                               size_t error_size) {
+  if (error && error_size)
+    error[0] = '\0';
+  if (!text || strlen(text) > QUERY_TEXT_MAX) {
+    if (error && error_size)
+      snprintf(error, error_size, text ? "query too long" : "no query");
+    return NULL;
+  }
+  civ_query_t *q = (civ_query_t *)CIV_CALLOC(1, sizeof(civ_query_t));
+  if (!q) {
+    if (error && error_size)
+      snprintf(error, error_size, "out of memory");
+    return NULL;
+  }
+  q->where = -1;
+  q->order = -1;
+  q->limit = -1;
+
+  parser_t p;
+  memset(&p, 0, sizeof(p));
+  p.src = p.pos = p.start = text;
+  p.q = q;
+  p.error = error;
+  p.error_size = error_size;
+  next(&p);
+
+  if (accept(&p, "select")) {
+    do
+      parse_item(&p);
+    while (!p.failed && accept(&p, ","));
+  }
+  if (accept(&p, "where"))
+    q->where = parse_expr(&p);
+  if (accept(&p, "during")) {
+    q->has_range = true;
+    if (accept(&p, "last")) {
+      q->range_last = true;
+      q->range_min = parse_whole(&p, "a turn");
+      if (!p.failed && q->range_min < 1)
+        fail(&p, "last needs at least one turn");
+    } else {
+      q->range_min = parse_whole(&p, "a turn");
+      expect(&p, "..");
+      q->range_max = parse_whole(&p, "a turn");
+      if (!p.failed && q->range_max < q->range_min)
+        fail(&p, "range ends before it starts");
+    }
+  }
+  if (accept(&p, "order")) {
+    expect(&p, "by");
+    if (!p.failed && q->aggregate)
+      fail(&p, "an aggregate has one row to order");
+    q->order = parse_expr(&p);
+    if (accept(&p, "desc"))
+      q->descending = true;
+    else
+      accept(&p, "asc");
+  }
+  if (accept(&p, "limit"))
+    q->limit = parse_whole(&p, "a row count");
+  if (!p.failed && p.kind != TOK_END)
+    fail(&p, "unexpected '%.*s'", (int)p.len, p.start);
+
+  if (p.failed) {
+    CIV_FREE(q);
+    return NULL;
+  }
+  return q;
+}
+
+void civ_query_destroy(civ_query_t *query) { CIV_FREE(query); }
+
+/* ── Snapshot ───────────────────────────────────────────────────────── */
+
+/* Pairs of rows, as CSR: row r's partners are to[start[r]..start[r+1]) */
+typedef struct {
+  uint32_t *start;
+  uint32_t *to;
+} query_pairs_t;
+
+struct civ_query_snapshot {
+  int32_t turn;
+  size_t rows;
+  int32_t *nation;                   /* row -> nation index */
+  char (*names)[CIV_QUERY_NAME_MAX];
+  double *columns[FIELD_COUNT];      /* NULL unless the query reads it */
+  query_pairs_t borders;
+  query_pairs_t wars;
+};
+
+typedef struct {
+  uint32_t a, b;
+} row_pair_t;
+
+static int compare_pair(const void *x, const void *y) {
+  const row_pair_t *a = (const row_pair_t *)x, *b = (const row_pair_t *)y;
+  if (a->a != b->a)
+    return a->a < b->a ? -1 : 1;
+  return a->b < b->b ? -1 : a->b > b->b;
+}
+
+/* Sort and dedupe count pairs (both directions already in) into CSR */
+static bool pairs_build(query_pairs_t *out, row_pair_t *pairs, size_t count,
+                        size_t rows) {
+  out->start = (uint32_t *)CIV_CALLOC(rows + 1, sizeof(uint32_t));
+  out->to = (uint32_t *)CIV_MALLOC((count ? count : 1) * sizeof(uint32_t));
+  if (!out->start || !out->to)
+    return false;
+  if (count > 1)
+    qsort(pairs, count, sizeof(row_pair_t), compare_pair);
+  size_t kept = 0;
+  for (size_t k = 0; k < count; k++) {
+    if (k > 0 && pairs[k].a == pairs[k - 1].a && pairs[k].b == pairs[k - 1].b)
+      continue;
+    out->to[kept++] = pairs[k].b;
+    out->start[pairs[k].a + 1]++;
+  }
+  for (size_t r = 0; r < rows; r++)
+    out->start[r + 1] += out->start[r];
+  return true;
+}
+
+static void pairs_free(query_pairs_t *pairs) {
+  CIV_FREE(pairs->start);
+  CIV_FREE(pairs->to);
+}
+
+/* Push the pair both ways; false without memory */
+static bool push_pair(row_pair_t **pairs, size_t *count, size_t *cap,
+                      int32_t a, int32_t b) {
+  if (a < 0 || b < 0 || a == b)
+    return true;
+  if (*count + 2 > *cap) {
+    size_t grown = *cap ? *cap * 2 : 64;
+    row_pair_t *p = (row_pair_t *)CIV_REALLOC(*pairs, grown * sizeof(row_pair_t));
+    if (!p)
+      return false;
+    *pairs = p;
+    *cap = grown;
+  }
+  (*pairs)[(*count)++] = (row_pair_t){(uint32_t)a, (uint32_t)b};
+  (*pairs)[(*count)++] = (row_pair_t){(uint32_t)b, (uint32_t)a};
+  return true;
+}
+
+static int32_t row_of_owner(const civ_nation_manager_t *nm,
+                            const int32_t *row_of, civ_owner_index_t owner) {
+  if (owner == CIV_OWNER_NONE || !nm->owner_nation ||
+      owner >= nm->owner_nation_size)
+    return -1;
+  int32_t n = nm->owner_nation[owner];
+  return n >= 0 && n < nm->count ? row_of[n] : -1;
+}
+
+/* Border pairs straight from the frontier's pair index */
+static bool take_borders(civ_query_snapshot_t *s, const civ_game_t *game,
+                         const civ_nation_manager_t *nm, const int32_t *row_of) {
+  row_pair_t *pairs = NULL;
+  size_t count = 0, cap = 0;
+  bool ok = true;
+  const civ_border_frontier_t *f =
+      game->tech_diffusion ? game->tech_diffusion->frontier : NULL;
+  for (uint32_t k = 0; ok && f && k < f->pair_capacity; k++) {
+    uint32_t key = f->pair_keys[k];
+    if (key == 0 || f->pair_sets[k].count == 0)
+      continue;
+    uint32_t owner = (key - 1) >> 16, neighbour = (key - 1) & 0xFFFFu;
+    ok = push_pair(&pairs, &count, &cap,
+                   row_of_owner(nm, row_of, (civ_owner_index_t)owner),
+                   row_of_owner(nm, row_of, (civ_owner_index_t)neighbour));
+  }
+  ok = ok && pairs_build(&s->borders, pairs, count, s->rows);
+  CIV_FREE(pairs);
+  return ok;
+}
+
+/* The pair (i, j), i < j, behind relation id j * (j - 1) / 2 + i */
+static void relation_pair(civ_relation_id_t id, size_t *i, size_t *j) {
+  size_t b = (size_t)((1.0 + sqrt(1.0 + 8.0 * (double)id)) * 0.5);
+  while (b * (b - 1) / 2 > (size_t)id)
+    b--;
+  while ((b + 1) * b / 2 <= (size_t)id)
+    b++;
+  *j = b;
+  *i = (size_t)id - b * (b - 1) / 2;
+}
+
+/* A relation at war is never at rest, so the active set holds every war */
+static bool take_wars(civ_query_snapshot_t *s, const civ_game_t *game,
+                      const civ_nation_manager_t *nm, const int32_t *row_of) {
+  const civ_diplomacy_system_t *ds = game->diplomacy_system;
+  row_pair_t *pairs = NULL;
+  size_t count = 0, cap = 0;
+  bool ok = true;
+  int32_t *dip_row = NULL;
+  if (ds && ds->nation_count > 1 && ds->rel.relation_level) {
+    dip_row = (int32_t *)CIV_MALLOC(ds->nation_count * sizeof(int32_t));
+    ok = dip_row != NULL;
+    for (size_t i = 0; ok && i < ds->nation_count; i++)
+      dip_row[i] = row_of_owner(nm, row_of, civ_owner_find(ds->nation_ids[i]));
+    for (size_t a = 0; ok && a < ds->active_count; a++) {
+      civ_relation_id_t id = ds->active_ids[a];
+      if (ds->rel.relation_level[id] != CIV_RELATION_LEVEL_WAR)
+        continue;
+      size_t i, j;
+      relation_pair(id, &i, &j);
+      if (j < ds->nation_count)
+        ok = push_pair(&pairs, &count, &cap, dip_row[i], dip_row[j]);
+    }
+  }
+  ok = ok && pairs_build(&s->wars, pairs, count, s->rows);
+  CIV_FREE(dip_row);
+  CIV_FREE(pairs);
+  return ok;
+}
+
+/* Mean of a history metric over [lo, hi]; NaN without samples there */
+static double series_mean(const civ_time_series_t *ts, int nation,
+                          civ_series_metric_t metric, int32_t lo, int32_t hi,
+                          float *buf, size_t cap) {
+  size_t n = civ_time_series_read(ts, nation, metric, lo, hi, NULL, buf, cap);
+  n = MIN(n, cap);
+  if (n == 0)
+    return NAN;
+  double sum = 0.0;
+  for (size_t k = 0; k < n; k++)
+    sum += buf[k];
+  return sum / (double)n;
+}
+
+static double current_value(const civ_game_t *game, const civ_nation_t *n,
+                            int index, query_field_t f) {
+  switch (f) {
+  case FIELD_GDP: return n->economy.gdp;
+  case FIELD_GDP_PER_CAPITA: return n->economy.gdp_per_capita;
+  case FIELD_GDP_GROWTH: return n->economy.gdp_growth;
+  case FIELD_INFLATION: return n->economy.inflation;
+  case FIELD_UNEMPLOYMENT: return n->economy.unemployment;
+  case FIELD_TAX_REVENUE: return n->economy.tax_revenue;
+  case FIELD_STABILITY: return n->government ? n->government->stability : NAN;
+  case FIELD_LEGITIMACY: return n->government ? n->government->legitimacy : NAN;
+  case FIELD_POPULATION: return (double)n->population;
+  case FIELD_LAND_TILES: return n->territory.land_tiles;
+  case FIELD_LAND_KM2: return n->territory.land_km2;
+  case FIELD_ARABLE_KM2: return n->territory.arable_km2;
+  case FIELD_PLAYER: {
+    const civ_nation_manager_t *nm = (const civ_nation_manager_t *)game->nation_manager;
+    return index == nm->player_nation_index ? 1.0 : 0.0;
+  }
+  case FIELD_INDEX: return index;
+  default: return NAN; /* from the pairs */
+  }
+}
+
+civ_query_snapshot_t *civ_query_snapshot_take(const civ_game_t *game,
+                                              const civ_query_t *query) {
+  const civ_nation_manager_t *nm =
+      game ? (const civ_nation_manager_t *)game->nation_manager : NULL;
+  if (!nm || !query || nm->count <= 0)
+    return NULL;
+  civ_query_snapshot_t *s =
+      (civ_query_snapshot_t *)CIV_CALLOC(1, sizeof(civ_query_snapshot_t));
+  int32_t *row_of = (int32_t *)CIV_MALLOC((size_t)nm->count * sizeof(int32_t));
+  if (!s || !row_of)
+    goto fail;
+  s->turn = game->current_turn;
+  for (int i = 0; i < nm->count; i++)
+    row_of[i] = nm->nations[i].defunct ? -1 : (int32_t)s->rows++;
+  s->nation = (int32_t *)CIV_MALLOC((s->rows ? s->rows : 1) * sizeof(int32_t));
+  s->names = CIV_MALLOC((s->rows ? s->rows : 1) * sizeof(*s->names));
+  if (!s->nation || !s->names)
+    goto fail;
+  for (int i = 0; i < nm->count; i++) {
+    if (row_of[i] < 0)
+      continue;
+    s->nation[row_of[i]] = i;
+    snprintf(s->names[row_of[i]], sizeof(s->names[0]), "%s", nm->nations[i].name);
+  }
+
+  if ((query->needs & NEED_BORDERS) && !take_borders(s, game, nm, row_of))
+    goto fail;
+  if ((query->needs & NEED_WARS) && !take_wars(s, game, nm, row_of))
+    goto fail;
+
+  /* History ranges resolve against the snapshot's turn */
+  int32_t lo = query->range_min, hi = query->range_max;
+  if (query->range_last) {
+    hi = s->turn;
+    lo = s->turn - query->range_min + 1;
+  }
+  const civ_time_series_t *ts = game->metrics_history;
+  size_t cap = 0;
+  if (query->has_range && ts && hi >= lo)
+    cap = (size_t)MIN((int64_t)hi - lo + 1, (int64_t)ts->sample_count);
+  float *buf = cap ? (float *)CIV_MALLOC(cap * sizeof(float)) : NULL;
+  if (cap && !buf)
+    goto fail;
+
+  for (int f = 0; f < FIELD_COUNT; f++) {
+    if (!(query->fields_read & (1u << f)))
+      continue;
+    double *col = (double *)CIV_MALLOC((s->rows ? s->rows : 1) * sizeof(double));
+    if (!col) {
+      CIV_FREE(buf);
+      goto fail;
+    }
+    s->columns[f] = col;
+    bool history = query->has_range && k_fields[f].series >= 0;
+    for (size_t r = 0; r < s->rows; r++) {
+      int i = s->nation[r];
+      if (history)
+        col[r] = ts && i < ts->nation_count
+                     ? series_mean(ts, i, (civ_series_metric_t)k_fields[f].series,
+                                   lo, hi, buf, cap)
+                     : NAN;
+      else if (f == FIELD_WARS || f == FIELD_AT_WAR) {
+        uint32_t d = s->wars.start[r + 1] - s->wars.start[r];
+        col[r] = f == FIELD_WARS ? (double)d : d > 0 ? 1.0 : 0.0;
+      } else if (f == FIELD_NEIGHBOURS)
+        col[r] = (double)(s->borders.start[r + 1] - s->borders.start[r]);
+      else
+        col[r] = current_value(game, &nm->nations[i], i, (query_field_t)f);
+    }
+  }
+  CIV_FREE(buf);
+  CIV_FREE(row_of);
+  return s;
+
+fail:
+  CIV_FREE(row_of);
+  civ_query_snapshot_destroy(s);
+  return NULL;
+}
+
+void civ_query_snapshot_destroy(civ_query_snapshot_t *s) {
+  if (!s)
+    return;
+  for (int f = 0; f < FIELD_COUNT; f++)
+    CIV_FREE(s->columns[f]);
+  pairs_free(&s->borders);
+  pairs_free(&s->wars);
+  CIV_FREE(s->nation);
+  CIV_FREE(s->names);
+  CIV_FREE(s);
+}
+
+/* ── Evaluation ─────────────────────────────────────────────────────── */
+
+static inline bool truthy(double v) { return v != 0.0 && v == v; }
+
+/* out[r] true where a partner of r has v true */
+static void eval_join(const query_pairs_t *pairs, const double *v, double *out,
+                      size_t rows) {
+  for (size_t r = 0; r < rows; r++) {
+    double hit = 0.0;
+    for (uint32_t k = pairs->start[r]; k < pairs->start[r + 1]; k++)
+      if (truthy(v[pairs->to[k]])) {
+        hit = 1.0;
+        break;
+      }
+    out[r] = hit;
+  }
+}
+
+/* Every node into its own column, children first */
+static void eval_nodes(const civ_query_t *q, const civ_query_snapshot_t *s,
+                       double *cols) {
+  size_t rows = s->rows;
+  for (int k = 0; k < q->node_count; k++) {
+    const query_node_t *n = &q->nodes[k];
+    double *restrict out = cols + (size_t)k * rows;
+    const double *a = n->a >= 0 ? cols + (size_t)n->a * rows : NULL;
+    const double *b = n->b >= 0 ? cols + (size_t)n->b * rows : NULL;
+    size_t r;
+    switch ((node_kind_t)n->kind) {
+    case NODE_NUM:
+      for (r = 0; r < rows; r++) out[r] = n->num;
+      break;
+    case NODE_FIELD:
+      memcpy(out, s->columns[n->field], rows * sizeof(double));
+      break;
+    case NODE_NEG:
+      for (r = 0; r < rows; r++) out[r] = -a[r];
+      break;
+    case NODE_NOT:
+      for (r = 0; r < rows; r++) out[r] = truthy(a[r]) ? 0.0 : 1.0;
+      break;
+    case NODE_ADD:
+      for (r = 0; r < rows; r++) out[r] = a[r] + b[r];
+      break;
+    case NODE_SUB:
+      for (r = 0; r < rows; r++) out[r] = a[r] - b[r];
+      break;
+    case NODE_MUL:
+      for (r = 0; r < rows; r++) out[r] = a[r] * b[r];
+      break;
+    case NODE_DIV:
+      for (r = 0; r < rows; r++) out[r] = b[r] != 0.0 ? a[r] / b[r] : NAN;
+      break;
+    /* Comparisons with a missing value are false, != included */
+    case NODE_LT:
+      for (r = 0; r < rows; r++) out[r] = a[r] < b[r];
+      break;
+    case NODE_LE:
+      for (r = 0; r < rows; r++) out[r] = a[r] <= b[r];
+      break;
+    case NODE_GT:
+      for (r = 0; r < rows; r++) out[r] = a[r] > b[r];
+      break;
+    case NODE_GE:
+      for (r = 0; r < rows; r++) out[r] = a[r] >= b[r];
+      break;
+    case NODE_EQ:
+      for (r = 0; r < rows; r++) out[r] = a[r] == b[r];
+      break;
+    case NODE_NE:
+      for (r = 0; r < rows; r++) out[r] = a[r] < b[r] || a[r] > b[r];
+      break;
+    case NODE_AND:
+      for (r = 0; r < rows; r++) out[r] = truthy(a[r]) && truthy(b[r]);
+      break;
+    case NODE_OR:
+      for (r = 0; r < rows; r++) out[r] = truthy(a[r]) || truthy(b[r]);
+      break;
+    case NODE_BORDERS:
+      eval_join(&s->borders, a, out, rows);
+      break;
+    case NODE_AT_WAR_WITH:
+      eval_join(&s->wars, a, out, rows);
+      break;
+    }
+  }
+}
+
+typedef struct {
+  double key;
+  uint32_t row;
+} order_key_t;
+
+/* Missing keys last either way; ties keep nation order */
+static int compare_asc(const void *x, const void *y) {
+  const order_key_t *a = (const order_key_t *)x, *b = (const order_key_t *)y;
+  bool ma = a->key != a->key, mb = b->key != b->key;
+  if (ma != mb)
+    return ma ? 1 : -1;
+  if (!ma && a->key != b->key)
+    return a->key < b->key ? -1 : 1;
+  return a->row < b->row ? -1 : a->row > b->row;
+}
+
+static int compare_desc(const void *x, const void *y) {
+  const order_key_t *a = (const order_key_t *)x, *b = (const order_key_t *)y;
+  bool ma = a->key != a->key, mb = b->key != b->key;
+  if (ma != mb)
+    return ma ? 1 : -1;
+  if (!ma && a->key != b->key)
+    return a->key > b->key ? -1 : 1;
+  return a->row < b->row ? -1 : a->row > b->row;
+}
+
+static double aggregate(query_agg_t agg, const double *v, const uint32_t *match,
+                        size_t count) {
+  if (agg == AGG_COUNT)
+    return (double)count;
+  double acc = agg == AGG_MIN ? INFINITY : agg == AGG_MAX ? -INFINITY : 0.0;
+  size_t seen = 0;
+  for (size_t k = 0; k < count; k++) {
+    double x = v[match[k]];
+    if (x != x)
+      continue;
+    seen++;
+    if (agg == AGG_MIN)
+      acc = MIN(acc, x);
+    else if (agg == AGG_MAX)
+      acc = MAX(acc, x);
+    else
+      acc += x;
+  }
+  if (seen == 0)
+    return agg == AGG_SUM ? 0.0 : NAN;
+  return agg == AGG_AVG ? acc / (double)seen : acc;
+}
+
+civ_result_t civ_query_run(const civ_query_t *q, const civ_query_snapshot_t *s,
+                           civ_query_result_t *out) {
+  if (!q || !s || !out)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Invalid query"};
+  memset(out, 0, sizeof(*out));
+  out->turn = s->turn;
+  out->column_count = q->item_count;
+  for (int c = 0; c < q->item_count; c++)
+    snprintf(out->columns[c], sizeof(out->columns[c]), "%s", q->items[c].label);
+
+  size_t rows = s->rows;
+  double *cols = (double *)CIV_MALLOC(
+      MAX((size_t)q->node_count * rows, (size_t)1) * sizeof(double));
+  uint32_t *match = (uint32_t *)CIV_MALLOC((rows ? rows : 1) * sizeof(uint32_t));
+  if (!cols || !match) {
+    CIV_FREE(cols);
+    CIV_FREE(match);
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Query buffer allocation failed"};
+  }
+  eval_nodes(q, s, cols);
+#define COLUMN(node) (cols + (size_t)(node) * rows)
+
+  size_t count = 0;
+  const double *where = q->where >= 0 ? COLUMN(q->where) : NULL;
+  for (size_t r = 0; r < rows; r++)
+    if (!where || truthy(where[r]))
+      match[count++] = (uint32_t)r;
+
+  civ_result_t res = {CIV_OK, NULL};
+  if (q->aggregate) {
+    out->row_count = 1;
+  } else {
+    if (q->order >= 0 && count > 1) {
+      order_key_t *keys =
+          (order_key_t *)CIV_MALLOC(count * sizeof(order_key_t));
+      if (!keys) {
+        res = (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Query buffer allocation failed"};
+        goto done;
+      }
+      const double *key = COLUMN(q->order);
+      for (size_t k = 0; k < count; k++)
+        keys[k] = (order_key_t){key[match[k]], match[k]};
+      qsort(keys, count, sizeof(order_key_t),
+            q->descending ? compare_desc : compare_asc);
+      for (size_t k = 0; k < count; k++)
+        match[k] = keys[k].row;
+      CIV_FREE(keys);
+    }
+    out->row_count = q->limit >= 0 ? MIN(count, (size_t)q->limit) : count;
+  }
+
+  size_t n = out->row_count;
+  out->nations = (int32_t *)CIV_MALLOC((n ? n : 1) * sizeof(int32_t));
+  out->names = CIV_CALLOC(n ? n : 1, sizeof(*out->names));
+  out->values = (double *)CIV_MALLOC(
+      MAX(n * (size_t)q->item_count, (size_t)1) * sizeof(double));
+  if (!out->nations || !out->names || !out->values) {
+    civ_query_result_free(out);
+    res = (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Query result allocation failed"};
+    goto done;
+  }
+  if (q->aggregate) {
+    out->nations[0] = -1;
+    for (int c = 0; c < q->item_count; c++) {
+      const query_item_t *item = &q->items[c];
+      out->values[c] = aggregate((query_agg_t)item->agg,
+                                 item->node >= 0 ? COLUMN(item->node) : NULL,
+                                 match, count);
+    }
+  } else {
+    for (size_t k = 0; k < n; k++) {
+      uint32_t r = match[k];
+      out->nations[k] = s->nation[r];
+      memcpy(out->names[k], s->names[r], sizeof(out->names[k]));
+      for (int c = 0; c < q->item_count; c++)
+        out->values[k * (size_t)q->item_count + c] = COLUMN(q->items[c].node)[r];
+    }
+  }
+#undef COLUMN
+
+done:
+  CIV_FREE(cols);
+  CIV_FREE(match);
+  return res;
+}
+
+void civ_query_result_free(civ_query_result_t *result) {
+  if (!result)
+    return;
+  CIV_FREE(result->nations);
+  CIV_FREE(result->names);
+  CIV_FREE(result->values);
+  result->nations = NULL;
+  result->names = NULL;
+  result->values = NULL;
+  result->row_count = 0;
+}
+
+/* ── Worker ─────────────────────────────────────────────────────────── */
+
+struct civ_query_worker {
+  SDL_Thread *thread;
+  SDL_Mutex *lock;
+  SDL_Condition *job_cv;  /* signalled when a query is submitted */
+  SDL_Condition *idle_cv; /* broadcast when one finishes */
+
+  /* Guarded by lock */
+  const civ_query_t *query;
+  civ_query_snapshot_t *snapshot;
+  bool busy;
+  bool stopping;
+  bool has_result;
+  civ_query_result_t result;
+  civ_result_t status;
+};
+
+static int query_worker_main(void *arg) {
+  civ_query_worker_t *w = (civ_query_worker_t *)arg;
+  for (;;) {
+    SDL_LockMutex(w->lock);
+    while (!w->snapshot && !w->stopping)
+      SDL_WaitCondition(w->job_cv, w->lock);
+    if (!w->snapshot) {
+      SDL_UnlockMutex(w->lock);
+      break;
+    }
+    const civ_query_t *query = w->query;
+    civ_query_snapshot_t *snapshot = w->snapshot;
+    SDL_UnlockMutex(w->lock);
+
+    civ_query_result_t result;
+    civ_result_t status = civ_query_run(query, snapshot, &result);
+    civ_query_snapshot_destroy(snapshot);
+
+    SDL_LockMutex(w->lock);
+    if (w->has_result)
+      civ_query_result_free(&w->result); /* never collected */
+    w->result = result;
+    w->status = status;
+    w->has_result = true;
+    w->query = NULL;
+    w->snapshot = NULL;
+    w->busy = false;
+    SDL_BroadcastCondition(w->idle_cv);
+    SDL_UnlockMutex(w->lock);
+  }
+  return 0;
+}
+
+civ_query_worker_t *civ_query_worker_create(void) {
+  civ_query_worker_t *w = CIV_CALLOC(1, sizeof(*w));
+  if (!w)
+    return NULL;
+  w->lock = SDL_CreateMutex();
+  w->job_cv = SDL_CreateCondition();
+  w->idle_cv = SDL_CreateCondition();
+  if (w->lock && w->job_cv && w->idle_cv)
+    w->thread = SDL_CreateThread(query_worker_main, "civ_query", w);
+  if (!w->thread) {
+    if (w->lock) SDL_DestroyMutex(w->lock);
+    if (w->job_cv) SDL_DestroyCondition(w->job_cv);
+    if (w->idle_cv) SDL_DestroyCondition(w->idle_cv);
+    CIV_FREE(w);
+    return NULL;
+  }
+  return w;
+}
+
+void civ_query_worker_destroy(civ_query_worker_t *w) {
+  if (!w)
+    return;
+  SDL_LockMutex(w->lock);
+  w->stopping = true;
+  SDL_SignalCondition(w->job_cv);
+  SDL_UnlockMutex(w->lock);
+  /* The thread finishes the query in flight before it sees stopping */
+  SDL_WaitThread(w->thread, NULL);
+  if (w->has_result)
+    civ_query_result_free(&w->result);
+  SDL_DestroyCondition(w->job_cv);
+  SDL_DestroyCondition(w->idle_cv);
+  SDL_DestroyMutex(w->lock);
+  CIV_FREE(w);
+}
+
+bool civ_query_worker_submit(civ_query_worker_t *w, const civ_game_t *game,
+                             const civ_query_t *query) {
+  if (!w || !game || !query || civ_query_worker_busy(w))
+    return false;
+  /* Only the submitting thread starts queries, so the worker stays idle
+     while the snapshot is taken */
+  civ_query_snapshot_t *snapshot = civ_query_snapshot_take(game, query);
+  if (!snapshot)
+    return false;
+  SDL_LockMutex(w->lock);
+  bool accepted = !w->busy && !w->stopping;
+  if (accepted) {
+    w->query = query;
+    w->snapshot = snapshot;
+    w->busy = true;
+    SDL_SignalCondition(w->job_cv);
+  }
+  SDL_UnlockMutex(w->lock);
+  if (!accepted)
+    civ_query_snapshot_destroy(snapshot);
+  return accepted;
+}
+
+bool civ_query_worker_busy(const civ_query_worker_t *w) {
+  if (!w)
+    return false;
+  SDL_LockMutex(w->lock);
+  bool busy = w->busy;
+  SDL_UnlockMutex(w->lock);
+  return busy;
+}
+
+void civ_query_worker_wait(civ_query_worker_t *w) {
+  if (!w)
+    return;
+  SDL_LockMutex(w->lock);
+  while (w->busy)
+    SDL_WaitCondition(w->idle_cv, w->lock);
+  SDL_UnlockMutex(w->lock);
+}
+
+bool civ_query_worker_take_result(civ_query_worker_t *w,
+                                  civ_query_result_t *out,
+                                  civ_result_t *status) {
+  if (!w)
+    return false;
+  SDL_LockMutex(w->lock);
+  bool has = w->has_result;
+  if (has) {
+    if (status)
+      *status = w->status;
+    if (out && w->status.error == CIV_OK)
+      *out = w->result;
+    else
+      civ_query_result_free(&w->result);
+    memset(&w->result, 0, sizeof(w->result));
+  }
+  w->has_result = false;
+  SDL_UnlockMutex(w->lock);
+  return has;
+}
@@ -0,0 +1,716 @@
+/**
+ * @file time_series.c
+ * @brief Block-encoded metric columns with turn-indexed range reads.
+ */
+
+#include "core/data/time_series.h"
+#include <SDL3/SDL.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define CIV_SERIES_MAGIC 0x52535443u /* CTSR */
+#define CIV_SERIES_FORMAT_VERSION 2u
+
+/* Values are stored as fixed point: round(value * scale) */
+static const double metric_scale[CIV_SERIES_METRIC_COUNT] = {
+    100.0,    /* gdp, millions */
+    100000.0, /* inflation */
+    100000.0, /* unemployment */
+    100.0,    /* tax_revenue */
+    100000.0, /* stability */
+    100000.0, /* legitimacy */
+};
+
+static const char *const metric_names[CIV_SERIES_METRIC_COUNT] = {
+    "gdp", "inflation", "unemployment", "tax_revenue", "stability",
+    "legitimacy"};
+
+/* Encoded values of a sealed block: the first, then BLOCK / stride - 1
+   zigzag differences to the value before, little-endian at width bytes
+   each. Each value stands for stride samples. Never changed once built. */
+typedef struct {
+  int64_t base;
+  uint8_t width;     /* 0 (all equal), 1, 2, 4 or 8 */
+  uint8_t stride;    /* 1, or CIV_SERIES_COARSE_STRIDE once coarsened */
+  uint8_t deltas[];
+} block_data_t;
+
+/* A sealed block: its first sample, and its values, which the maintenance
+   step swaps for coarser ones */
+typedef struct {
+  int64_t base;
+  block_data_t *data; /* atomic; NULL when every sample is base */
+} series_block_t;
+
+struct civ_series_column {
+  series_block_t *blocks;
+  size_t block_count;
+  size_t block_capacity;
+  size_t coarse_blocks; /* leading blocks already coarsened or flat */
+  int64_t open[CIV_SERIES_BLOCK]; /* block being filled */
+  int64_t last;
+  size_t first_sample; /* samples before this predate the nation */
+};
+
+/* Shared with the maintenance thread. The lock covers the column and block
+   arrays against it; readers, which run on the sim thread or under its
+   lock, never take it. */
+struct civ_series_upkeep {
+  SDL_Mutex *lock;
+  uint32_t generation;   /* bumped when samples are dropped */
+  size_t cursor;         /* next column to coarsen */
+  block_data_t **retired; /* swapped out, freed by the next append */
+  size_t retired_count, retired_capacity;
+};
+
+/* On-disk header of civ_time_series_export_binary. Then for the turn
+   column and each metric column in order: first_sample and the sealed
+   block count (u64 each), every sealed block as its values' base (i64),
+   width (u8), stride (u8) and BLOCK / stride - 1 deltas, and the open
+   block's sample_count % BLOCK raw values (i64). */
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t block_size;
+  uint32_t metric_count;
+  uint32_t nation_count;
+  uint32_t reserved;
+  uint64_t sample_count;
+  double scales[CIV_SERIES_METRIC_COUNT];
+} series_file_header_t;
+
+static civ_result_t ok_result(void) {
+  civ_result_t res = {CIV_OK, NULL};
+  return res;
+}
+
+static civ_result_t error_result(civ_error_t code, const char *msg) {
+  civ_result_t res = {code, msg};
+  return res;
+}
+
+static int64_t quantize(float value, double scale) {
+  double q = (double)value * scale;
+  if (!isfinite(q))
+    return 0;
+  /* Keeps every difference of two values inside int64 */
+  if (q > 4e18) q = 4e18;
+  if (q < -4e18) q = -4e18;
+  return llround(q);
+}
+
+static uint64_t zigzag(int64_t d) {
+  return ((uint64_t)d << 1) ^ (uint64_t)(d >> 63);
+}
+
+static int64_t unzigzag(uint64_t u) {
+  return (int64_t)(u >> 1) ^ -(int64_t)(u & 1);
+}
+
+/* ── Blocks ───────────────────────────────────────────────────────── */
+
+static block_data_t *block_data(const series_block_t *b) {
+  return (block_data_t *)SDL_GetAtomicPointer((void **)&b->data);
+}
+
+static size_t block_data_bytes(const block_data_t *d) {
+  return d ? sizeof(*d) +
+                 (size_t)(CIV_SERIES_BLOCK / d->stride - 1) * d->width
+           : 0;
+}
+
+static void block_decode(const series_block_t *b, int64_t *out) {
+  const block_data_t *d = block_data(b);
+  if (!d) {
+    for (int k = 0; k < CIV_SERIES_BLOCK; k++)
+      out[k] = b->base;
+    return;
+  }
+  const uint8_t *p = d->deltas;
+  int64_t v = d->base;
+  for (int k = 0; k < CIV_SERIES_BLOCK; k += d->stride) {
+    if (k > 0) {
+      uint64_t u = 0;
+      for (int j = 0; j < d->width; j++)
+        u |= (uint64_t)*p++ << (8 * j);
+      v += unzigzag(u);
+    }
+    for (int j = 0; j < d->stride; j++)
+      out[k + j] = v;
+  }
+}
+
+/* count values at stride samples each; NULL for a flat full-detail block,
+   which decodes from the block's base alone */
+static block_data_t *block_encode(const int64_t *vals, int count,
+                                  uint8_t stride, bool *ok) {
+  uint64_t zz[CIV_SERIES_BLOCK - 1];
+  uint64_t bits = 0;
+  for (int k = 1; k < count; k++) {
+    zz[k - 1] = zigzag(vals[k] - vals[k - 1]);
+    bits |= zz[k - 1];
+  }
+  *ok = true;
+  if (bits == 0 && stride == 1)
+    return NULL;
+  uint8_t width = bits == 0 ? 0 : bits <= 0xFFu ? 1 : bits <= 0xFFFFu ? 2
+                  : bits <= 0xFFFFFFFFu ? 4 : 8;
+  block_data_t *d = CIV_MALLOC(sizeof(*d) + (size_t)(count - 1) * width);
+  if (!d) {
+    *ok = false;
+    return NULL;
+  }
+  d->base = vals[0];
+  d->width = width;
+  d->stride = stride;
+  uint8_t *p = d->deltas;
+  for (int k = 0; k < count - 1; k++)
+    for (int j = 0; j < width; j++)
+      *p++ = (uint8_t)(zz[k] >> (8 * j));
+  return d;
+}
+
+/* Mean of each run of stride values, rounded down, without overflow */
+static void block_means(const int64_t *vals, int stride, int64_t *out) {
+  for (int k = 0; k < CIV_SERIES_BLOCK / stride; k++) {
+    int64_t q = 0, r = 0;
+    for (int j = 0; j < stride; j++) {
+      q += vals[k * stride + j] / stride;
+      r += vals[k * stride + j] % stride;
+    }
+    out[k] = q + r / stride - (r % stride < 0 ? 1 : 0);
+  }
+}
+
+static bool column_reserve(civ_series_column_t *col, size_t blocks) {
+  if (blocks <= col->block_capacity)
+    return true;
+  size_t cap = col->block_capacity ? col->block_capacity : 16;
+  while (cap < blocks)
+    cap *= 2;
+  series_block_t *grown =
+      CIV_REALLOC(col->blocks, cap * sizeof(*grown));
+  if (!grown)
+    return false;
+  col->blocks = grown;
+  col->block_capacity = cap;
+  return true;
+}
+
+/* Seal the full open block; capacity was reserved by the caller. Out of
+   memory keeps the block boundary and loses its detail. */
+static bool column_seal(civ_series_column_t *col) {
+  bool ok;
+  series_block_t *b = &col->blocks[col->block_count++];
+  b->base = col->open[0];
+  b->data = block_encode(col->open, CIV_SERIES_BLOCK, 1, &ok);
+  return ok;
+}
+
+/* Values of block index into out; the open block when it is not sealed */
+static void column_block(const civ_series_column_t *col, size_t index,
+                         int64_t *out) {
+  if (index < col->block_count)
+    block_decode(&col->blocks[index], out);
+  else
+    memcpy(out, col->open, sizeof(col->open));
+}
+
+/* Sealed blocks older than the newest CIV_SERIES_DETAIL_BLOCKS: coarse,
+   whether or not the maintenance step has got to them yet */
+static size_t due_blocks(const civ_time_series_t *ts) {
+  size_t sealed = ts->turns->block_count;
+  return sealed > CIV_SERIES_DETAIL_BLOCKS ? sealed - CIV_SERIES_DETAIL_BLOCKS
+                                           : 0;
+}
+
+/* Metric values of block index as a read sees them: a due block still in
+   full detail reads as its means, so results depend only on the samples
+   and never on how far the maintenance thread has got */
+static void metric_block(const civ_time_series_t *ts,
+                         const civ_series_column_t *col, size_t index,
+                         int64_t *out) {
+  column_block(col, index, out);
+  if (index >= due_blocks(ts))
+    return;
+  const block_data_t *d = block_data(&col->blocks[index]);
+  if (!d || d->stride != 1)
+    return; /* flat, or coarse already */
+  int64_t means[CIV_SERIES_BLOCK];
+  block_means(out, CIV_SERIES_COARSE_STRIDE, means);
+  for (int k = 0; k < CIV_SERIES_BLOCK; k++)
+    out[k] = means[k / CIV_SERIES_COARSE_STRIDE];
+}
+
+static void column_free(civ_series_column_t *col) {
+  for (size_t b = 0; b < col->block_count; b++)
+    CIV_FREE(col->blocks[b].data);
+  CIV_FREE(col->blocks);
+  col->blocks = NULL;
+  col->block_count = col->block_capacity = col->coarse_blocks = 0;
+}
+
+/* Keep the first n of the samples */
+static void column_truncate(civ_series_column_t *col, size_t n) {
+  size_t keep = n / CIV_SERIES_BLOCK;
+  if (keep < col->block_count) {
+    block_decode(&col->blocks[keep], col->open);
+    for (size_t b = keep; b < col->block_count; b++)
+      CIV_FREE(col->blocks[b].data);
+    col->block_count = keep;
+    col->coarse_blocks = MIN(col->coarse_blocks, keep);
+  }
+  if (n > 0) {
+    int64_t vals[CIV_SERIES_BLOCK];
+    column_block(col, (n - 1) / CIV_SERIES_BLOCK, vals);
+    col->last = vals[(n - 1) % CIV_SERIES_BLOCK];
+  } else {
+    col->last = 0;
+  }
+  if (col->first_sample > n)
+    col->first_sample = n;
+}
+
+/* ── Series ───────────────────────────────────────────────────────── */
+
+civ_time_series_t *civ_time_series_create(void) {
+  civ_time_series_t *ts = CIV_CALLOC(1, sizeof(*ts));
+  if (!ts)
+    return NULL;
+  ts->turns = CIV_CALLOC(1, sizeof(*ts->turns));
+  ts->upkeep = CIV_CALLOC(1, sizeof(*ts->upkeep));
+  if (ts->upkeep)
+    ts->upkeep->lock = SDL_CreateMutex();
+  if (!ts->turns || !ts->upkeep || !ts->upkeep->lock) {
+    if (ts->upkeep && ts->upkeep->lock)
+      SDL_DestroyMutex(ts->upkeep->lock);
+    CIV_FREE(ts->upkeep);
+    CIV_FREE(ts->turns);
+    CIV_FREE(ts);
+    return NULL;
+  }
+  return ts;
+}
+
+/* Blocks the maintenance step swapped out; no reader can still hold one
+   while the sim thread is in here */
+static void free_retired(civ_series_upkeep_t *u) {
+  for (size_t i = 0; i < u->retired_count; i++)
+    CIV_FREE(u->retired[i]);
+  u->retired_count = 0;
+}
+
+static void clear_locked(civ_time_series_t *ts) {
+  free_retired(ts->upkeep);
+  ts->upkeep->generation++;
+  ts->upkeep->cursor = 0;
+  size_t cols = (size_t)ts->nation_count * CIV_SERIES_METRIC_COUNT;
+  for (size_t c = 0; c < cols; c++)
+    column_free(&ts->columns[c]);
+  CIV_FREE(ts->columns);
+  ts->columns = NULL;
+  ts->nation_count = 0;
+  column_free(ts->turns);
+  memset(ts->turns, 0, sizeof(*ts->turns));
+  ts->sample_count = 0;
+}
+
+void civ_time_series_clear(civ_time_series_t *ts) {
+  if (!ts)
+    return;
+  SDL_LockMutex(ts->upkeep->lock);
+  clear_locked(ts);
+  SDL_UnlockMutex(ts->upkeep->lock);
+}
+
+void civ_time_series_destroy(civ_time_series_t *ts) {
+  if (!ts)
+    return;
+  clear_locked(ts);
+  SDL_DestroyMutex(ts->upkeep->lock);
+  CIV_FREE(ts->upkeep->retired);
+  CIV_FREE(ts->upkeep);
+  CIV_FREE(ts->turns);
+  CIV_FREE(ts);
+}
+
+static size_t block_length(const civ_time_series_t *ts, size_t index) {
+  size_t start = index * CIV_SERIES_BLOCK;
+  size_t left = ts->sample_count - start;
+  return left < CIV_SERIES_BLOCK ? left : CIV_SERIES_BLOCK;
+}
+
+/* First sample whose turn is >= turn; turns never decrease */
+static size_t lower_bound(const civ_time_series_t *ts, int32_t turn) {
+  const civ_series_column_t *tc = ts->turns;
+  size_t blocks = (ts->sample_count + CIV_SERIES_BLOCK - 1) / CIV_SERIES_BLOCK;
+  size_t lo = 0, hi = blocks;
+  while (lo < hi) { /* first block starting at or after turn */
+    size_t mid = (lo + hi) / 2;
+    int64_t first = mid < tc->block_count ? tc->blocks[mid].base : tc->open[0];
+    if (first >= turn)
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+  if (lo == 0)
+    return 0;
+  int64_t vals[CIV_SERIES_BLOCK];
+  column_block(tc, lo - 1, vals);
+  size_t n = block_length(ts, lo - 1);
+  for (size_t k = 0; k < n; k++) {
+    if (vals[k] >= turn)
+      return (lo - 1) * CIV_SERIES_BLOCK + k;
+  }
+  return MIN(lo * CIV_SERIES_BLOCK, ts->sample_count);
+}
+
+static void truncate_samples(civ_time_series_t *ts, size_t n) {
+  ts->upkeep->generation++;
+  size_t cols = (size_t)ts->nation_count * CIV_SERIES_METRIC_COUNT;
+  column_truncate(ts->turns, n);
+  for (size_t c = 0; c < cols; c++)
+    column_truncate(&ts->columns[c], n);
+  ts->sample_count = n;
+}
+
+/* New nations' columns, flat up to the current sample */
+static bool grow_nations(civ_time_series_t *ts, int nation_count) {
+  size_t old_cols = (size_t)ts->nation_count * CIV_SERIES_METRIC_COUNT;
+  size_t cols = (size_t)nation_count * CIV_SERIES_METRIC_COUNT;
+  civ_series_column_t *grown =
+      CIV_REALLOC(ts->columns, cols * sizeof(*grown));
+  if (!grown)
+    return false;
+  ts->columns = grown;
+  size_t sealed = ts->turns->block_count;
+  for (size_t c = old_cols; c < cols; c++) {
+    civ_series_column_t *col = &grown[c];
+    memset(col, 0, sizeof(*col));
+    col->first_sample = ts->sample_count;
+    if (!column_reserve(col, sealed + 1)) {
+      for (size_t d = old_cols; d < c; d++)
+        column_free(&grown[d]);
+      return false;
+    }
+    memset(col->blocks, 0, sealed * sizeof(*col->blocks));
+    col->block_count = sealed;
+  }
+  ts->nation_count = nation_count;
+  return true;
+}
+
+/* Caller holds the upkeep lock */
+static civ_result_t append_locked(civ_time_series_t *ts, int32_t turn,
+                                  const float *values, int nation_count) {
+  if (ts->sample_count > 0 && turn <= ts->turns->last)
+    truncate_samples(ts, lower_bound(ts, turn));
+  if (nation_count > ts->nation_count && !grow_nations(ts, nation_count))
+    return error_result(CIV_ERROR_OUT_OF_MEMORY, "Series columns");
+
+  size_t cols = (size_t)ts->nation_count * CIV_SERIES_METRIC_COUNT;
+  size_t off = ts->sample_count % CIV_SERIES_BLOCK;
+  bool seals = off == CIV_SERIES_BLOCK - 1;
+  if (seals) {
+    size_t need = ts->turns->block_count + 1;
+    if (!column_reserve(ts->turns, need))
+      return error_result(CIV_ERROR_OUT_OF_MEMORY, "Series blocks");
+    for (size_t c = 0; c < cols; c++) {
+      if (!column_reserve(&ts->columns[c], need))
+        return error_result(CIV_ERROR_OUT_OF_MEMORY, "Series blocks");
+    }
+  }
+
+  bool lossless = true;
+  ts->turns->open[off] = ts->turns->last = turn;
+  if (seals)
+    lossless &= column_seal(ts->turns);
+  for (size_t c = 0; c < cols; c++) {
+    civ_series_column_t *col = &ts->columns[c];
+    size_t nation = c / CIV_SERIES_METRIC_COUNT;
+    size_t metric = c % CIV_SERIES_METRIC_COUNT;
+    if (nation < (size_t)nation_count)
+      col->last = quantize(values[c], metric_scale[metric]);
+    col->open[off] = col->last;
+    if (seals)
+      lossless &= column_seal(col);
+  }
+  ts->sample_count++;
+  return lossless ? ok_result()
+                  : error_result(CIV_ERROR_OUT_OF_MEMORY, "Block flattened");
+}
+
+civ_result_t civ_time_series_append(civ_time_series_t *ts, int32_t turn,
+                                    const float *values, int nation_count) {
+  if (!ts || nation_count < 0 || (nation_count > 0 && !values))
+    return error_result(CIV_ERROR_INVALID_ARGUMENT, "Invalid sample");
+  SDL_LockMutex(ts->upkeep->lock);
+  free_retired(ts->upkeep);
+  civ_result_t res = append_locked(ts, turn, values, nation_count);
+  SDL_UnlockMutex(ts->upkeep->lock);
+  return res;
+}
+
+size_t civ_time_series_read(const civ_time_series_t *ts, int nation,
+                            civ_series_metric_t metric, int32_t turn_min,
+                            int32_t turn_max, float *turns, float *values,
+                            size_t max) {
+  if (!ts || nation < 0 || nation >= ts->nation_count || metric < 0 ||
+      metric >= CIV_SERIES_METRIC_COUNT || turn_min > turn_max)
+    return 0;
+  const civ_series_column_t *col =
+      &ts->columns[(size_t)nation * CIV_SERIES_METRIC_COUNT + metric];
+  double inv = 1.0 / metric_scale[metric];
+  size_t s = MAX(lower_bound(ts, turn_min), col->first_sample);
+  size_t total = 0;
+  int64_t tv[CIV_SERIES_BLOCK], vv[CIV_SERIES_BLOCK];
+
+  while (s < ts->sample_count) {
+    size_t b = s / CIV_SERIES_BLOCK, n = block_length(ts, b);
+    column_block(ts->turns, b, tv);
+    if (values)
+      metric_block(ts, col, b, vv);
+    for (size_t k = s % CIV_SERIES_BLOCK; k < n; k++) {
+      if (tv[k] > turn_max)
+        return total;
+      if (total < max) {
+        if (turns) turns[total] = (float)tv[k];
+        if (values) values[total] = (float)((double)vv[k] * inv);
+      }
+      total++;
+    }
+    s = (b + 1) * CIV_SERIES_BLOCK;
+  }
+  return total;
+}
+
+/* ── Coarsening ───────────────────────────────────────────────────── */
+
+/* Next block due for coarsening: a column's oldest full-detail block more
+   than CIV_SERIES_DETAIL_BLOCKS behind the newest. Flat and already coarse
+   ones are passed over on the way. */
+static bool next_coarsen_job(civ_time_series_t *ts, size_t *col_out,
+                             size_t *block_out) {
+  civ_series_upkeep_t *u = ts->upkeep;
+  size_t cols = (size_t)ts->nation_count * CIV_SERIES_METRIC_COUNT;
+  size_t sealed = ts->turns->block_count;
+  if (cols == 0 || sealed <= CIV_SERIES_DETAIL_BLOCKS)
+    return false;
+  size_t due = sealed - CIV_SERIES_DETAIL_BLOCKS;
+  for (size_t n = 0; n < cols; n++) {
+    size_t c = (u->cursor + n) % cols;
+    civ_series_column_t *col = &ts->columns[c];
+    while (col->coarse_blocks < due) {
+      const block_data_t *d = block_data(&col->blocks[col->coarse_blocks]);
+      if (d && d->stride == 1) {
+        u->cursor = (c + 1) % cols;
+        *col_out = c;
+        *block_out = col->coarse_blocks;
+        return true;
+      }
+      col->coarse_blocks++;
+    }
+  }
+  return false;
+}
+
+size_t civ_time_series_coarsen(civ_time_series_t *ts, size_t max_bytes,
+                               uint64_t deadline_ns) {
+  if (!ts)
+    return 0;
+  civ_series_upkeep_t *u = ts->upkeep;
+  int64_t vals[CIV_SERIES_BLOCK], means[CIV_SERIES_BLOCK];
+  size_t done = 0;
+  while (done < max_bytes && SDL_GetTicksNS() < deadline_ns) {
+    /* Decode under the lock, encode outside it, swap under it again if
+       nothing moved in between */
+    size_t c, b;
+    SDL_LockMutex(u->lock);
+    if (!next_coarsen_job(ts, &c, &b)) {
+      SDL_UnlockMutex(u->lock);
+      break;
+    }
+    uint32_t generation = u->generation;
+    series_block_t *blk = &ts->columns[c].blocks[b];
+    block_data_t *old = block_data(blk);
+    block_decode(blk, vals);
+    SDL_UnlockMutex(u->lock);
+
+    bool ok;
+    block_means(vals, CIV_SERIES_COARSE_STRIDE, means);
+    block_data_t *coarse =
+        block_encode(means, CIV_SERIES_BLOCK / CIV_SERIES_COARSE_STRIDE,
+                     CIV_SERIES_COARSE_STRIDE, &ok);
+    if (!ok)
+      break;
+
+    SDL_LockMutex(u->lock);
+    bool current = u->generation == generation &&
+                   ts->columns[c].coarse_blocks == b &&
+                   block_data(&ts->columns[c].blocks[b]) == old;
+    if (current && u->retired_count == u->retired_capacity) {
+      size_t cap = u->retired_capacity ? u->retired_capacity * 2 : 64;
+      block_data_t **grown = CIV_REALLOC(u->retired, cap * sizeof(*grown));
+      if (grown) {
+        u->retired = grown;
+        u->retired_capacity = cap;
+      } else {
+        current = false;
+      }
+    }
+    if (current) {
+      civ_series_column_t *col = &ts->columns[c];
+      SDL_SetAtomicPointer((void **)&col->blocks[b].data, coarse);
+      u->retired[u->retired_count++] = old;
+      col->coarse_blocks++;
+      coarse = NULL;
+    }
+    SDL_UnlockMutex(u->lock);
+    CIV_FREE(coarse);
+    done += block_data_bytes(old);
+  }
+  return done;
+}
+
+const char *civ_time_series_metric_name(civ_series_metric_t metric) {
+  if (metric < 0 || metric >= CIV_SERIES_METRIC_COUNT)
+    return "unknown";
+  return metric_names[metric];
+}
+
+static size_t column_bytes(const civ_series_column_t *col) {
+  size_t bytes = sizeof(*col) + col->block_capacity * sizeof(series_block_t);
+  for (size_t b = 0; b < col->block_count; b++)
+    bytes += block_data_bytes(block_data(&col->blocks[b]));
+  return bytes;
+}
+
+size_t civ_time_series_bytes(const civ_time_series_t *ts) {
+  if (!ts)
+    return 0;
+  size_t bytes = sizeof(*ts) + column_bytes(ts->turns);
+  size_t cols = (size_t)ts->nation_count * CIV_SERIES_METRIC_COUNT;
+  for (size_t c = 0; c < cols; c++)
+    bytes += column_bytes(&ts->columns[c]);
+  return bytes;
+}
+
+/* ── Export ───────────────────────────────────────────────────────── */
+
+civ_result_t civ_time_series_export_csv(const civ_time_series_t *ts,
+                                        const char *path,
+                                        const char *const *nation_names) {
+  if (!ts || !path)
+    return error_result(CIV_ERROR_INVALID_ARGUMENT, "Invalid export");
+  size_t cols = (size_t)ts->nation_count * CIV_SERIES_METRIC_COUNT;
+  int64_t *vals = CIV_MALLOC((cols + 1) * CIV_SERIES_BLOCK * sizeof(int64_t));
+  if (!vals)
+    return error_result(CIV_ERROR_OUT_OF_MEMORY, "Export buffer");
+  FILE *f = fopen(path, "w");
+  if (!f) {
+    CIV_FREE(vals);
+    return error_result(CIV_ERROR_IO, "Cannot create export");
+  }
+
+  fprintf(f, "turn,nation");
+  for (int m = 0; m < CIV_SERIES_METRIC_COUNT; m++)
+    fprintf(f, ",%s", metric_names[m]);
+  fputc('\n', f);
+
+  int64_t *tv = vals + cols * CIV_SERIES_BLOCK;
+  size_t blocks = (ts->sample_count + CIV_SERIES_BLOCK - 1) / CIV_SERIES_BLOCK;
+  for (size_t b = 0; b < blocks; b++) {
+    column_block(ts->turns, b, tv);
+    for (size_t c = 0; c < cols; c++)
+      metric_block(ts, &ts->columns[c], b, vals + c * CIV_SERIES_BLOCK);
+    size_t n = block_length(ts, b);
+    for (size_t k = 0; k < n; k++) {
+      size_t sample = b * CIV_SERIES_BLOCK + k;
+      for (int nation = 0; nation < ts->nation_count; nation++) {
+        size_t c0 = (size_t)nation * CIV_SERIES_METRIC_COUNT;
+        if (sample < ts->columns[c0].first_sample)
+          continue;
+        if (nation_names && nation_names[nation])
+          fprintf(f, "%lld,%s", (long long)tv[k], nation_names[nation]);
+        else
+          fprintf(f, "%lld,%d", (long long)tv[k], nation);
+        for (int m = 0; m < CIV_SERIES_METRIC_COUNT; m++)
+          fprintf(f, ",%.10g",
+                  (double)vals[(c0 + m) * CIV_SERIES_BLOCK + k] / metric_scale[m]);
+        fputc('\n', f);
+      }
+    }
+  }
+  CIV_FREE(vals);
+  bool ok = !ferror(f);
+  if (fclose(f) != 0)
+    ok = false;
+  return ok ? ok_result() : error_result(CIV_ERROR_IO, "Export write failed");
+}
+
+/* due blocks still in full detail are written coarsened, as reads see
+   them (0 for the turn column, which stays exact) */
+static bool write_column(FILE *f, const civ_series_column_t *col,
+                         size_t open_count, size_t due) {
+  uint64_t first = col->first_sample, count = col->block_count;
+  fwrite(&first, sizeof(first), 1, f);
+  fwrite(&count, sizeof(count), 1, f);
+  for (size_t b = 0; b < col->block_count; b++) {
+    const block_data_t *d = block_data(&col->blocks[b]);
+    block_data_t flat = {col->blocks[b].base, 0, 1};
+    block_data_t *coarse = NULL;
+    if (!d) {
+      d = &flat;
+    } else if (b < due && d->stride == 1) {
+      int64_t vals[CIV_SERIES_BLOCK], means[CIV_SERIES_BLOCK];
+      bool ok;
+      block_decode(&col->blocks[b], vals);
+      block_means(vals, CIV_SERIES_COARSE_STRIDE, means);
+      coarse = block_encode(means, CIV_SERIES_BLOCK / CIV_SERIES_COARSE_STRIDE,
+                            CIV_SERIES_COARSE_STRIDE, &ok);
+      if (!ok)
+        return false;
+      d = coarse;
+    }
+    fwrite(&d->base, sizeof(d->base), 1, f);
+    fwrite(&d->width, sizeof(d->width), 1, f);
+    fwrite(&d->stride, sizeof(d->stride), 1, f);
+    if (d->width)
+      fwrite(d->deltas, d->width, CIV_SERIES_BLOCK / d->stride - 1, f);
+    CIV_FREE(coarse);
+  }
+  fwrite(col->open, sizeof(col->open[0]), open_count, f);
+  return true;
+}
+
+civ_result_t civ_time_series_export_binary(const civ_time_series_t *ts,
+                                           const char *path) {
+  if (!ts || !path)
+    return error_result(CIV_ERROR_INVALID_ARGUMENT, "Invalid export");
+  FILE *f = fopen(path, "wb");
+  if (!f)
+    return error_result(CIV_ERROR_IO, "Cannot create export");
+
+  series_file_header_t h;
+  memset(&h, 0, sizeof(h));
+  h.magic = CIV_SERIES_MAGIC;
+  h.version = CIV_SERIES_FORMAT_VERSION;
+  h.block_size = CIV_SERIES_BLOCK;
+  h.metric_count = CIV_SERIES_METRIC_COUNT;
+  h.nation_count = (uint32_t)ts->nation_count;
+  h.sample_count = ts->sample_count;
+  memcpy(h.scales, metric_scale, sizeof(h.scales));
+  fwrite(&h, sizeof(h), 1, f);
+
+  size_t open_count = ts->sample_count % CIV_SERIES_BLOCK;
+  size_t cols = (size_t)ts->nation_count * CIV_SERIES_METRIC_COUNT;
+  bool ok = write_column(f, ts->turns, open_count, 0);
+  for (size_t c = 0; c < cols && ok; c++)
+    ok = write_column(f, &ts->columns[c], open_count, due_blocks(ts));
+
+  ok = ok && !ferror(f);
+  if (fclose(f) != 0)
+    ok = false;
+  return ok ? ok_result() : error_result(CIV_ERROR_IO, "Export write failed");
+}
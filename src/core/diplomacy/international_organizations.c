@@ -4,15 +4,11 @@
  */
 
 #include "core/diplomacy/international_organizations.h"
+#include <math.h>
 #include <stdio.h>
 
 civ_org_manager_t *civ_org_manager_create(void) {
-  civ_org_manager_t *manager = CIV_MALLOC(sizeof(civ_org_manager_t));
-  if (manager) {
-    manager->orgs = NULL;
-    manager->org_count = 0;
-    manager->org_capacity = 0;
-  }
+  civ_org_manager_t *manager = CIV_CALLOC(1, sizeof(civ_org_manager_t));
   return manager;
 }
 
@@ -24,40 +20,37 @@ void civ_org_manager_destroy(civ_org_manager_t *manager) {
       }
       CIV_FREE(manager->orgs);
     }
+    CIV_FREE(manager->vote);
     CIV_FREE(manager);
   }
 }
 
 civ_international_org_t *civ_org_create(const char *name, civ_org_type_t type) {
-  civ_international_org_t *org = CIV_MALLOC(sizeof(civ_international_org_t));
+  civ_international_org_t *org = CIV_CALLOC(1, sizeof(civ_international_org_t));
   if (org) {
     snprintf(org->id, STRING_SHORT_LEN, "org_%ld", (long)time(NULL));
     strncpy(org->name, name, STRING_MEDIUM_LEN - 1);
     org->type = type;
-
-    org->member_ids = NULL;
-    org->member_count = 0;
-    org->member_capacity = 0;
-
-    org->resolutions = NULL;
-    org->resolution_count = 0;
-    org->resolution_capacity = 0;
-
     org->cohesion = 1.0f;
     org->formation_date = time(NULL);
-    memset(org->leader_id, 0, STRING_SHORT_LEN);
   }
   return org;
 }
 
+static void resolution_free(civ_resolution_t *res) {
+  CIV_FREE(res->cast_by);
+  CIV_FREE(res->cast_vote);
+  res->cast_by = NULL;
+  res->cast_vote = NULL;
+  res->cast_count = res->cast_capacity = 0;
+}
+
 void civ_org_destroy(civ_international_org_t *org) {
   if (org) {
-    if (org->member_ids) {
-      for (size_t i = 0; i < org->member_count; i++) {
-        CIV_FREE(org->member_ids[i]);
-      }
-      CIV_FREE(org->member_ids);
-    }
+    CIV_FREE(org->members);
+    CIV_FREE(org->member_bits);
+    for (size_t i = 0; i < org->resolution_count; i++)
+      resolution_free(&org->resolutions[i]);
     CIV_FREE(org->resolutions);
     // Note: if org was malloced separately vs in array, handle accordingly.
     // Assuming here it's used with manager which copies, or standalone.
@@ -66,66 +59,146 @@ void civ_org_destroy(civ_international_org_t *org) {
   }
 }
 
+static int32_t member_slot(const civ_international_org_t *org, civ_symbol_t nation) {
+  for (size_t i = 0; i < org->member_count; i++)
+    if (org->members[i] == nation)
+      return (int32_t)i;
+  return -1;
+}
+
+bool civ_org_is_member(const civ_international_org_t *org, civ_symbol_t nation) {
+  return org && nation != CIV_SYMBOL_NONE && member_slot(org, nation) >= 0;
+}
+
 civ_result_t civ_org_add_member(civ_international_org_t *org,
                                 const char *nation_id) {
   if (!org || !nation_id)
     return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Invalid args"};
 
-  // Check duplicate
-  for (size_t i = 0; i < org->member_count; i++) {
-    if (strcmp(org->member_ids[i], nation_id) == 0) {
-      return (civ_result_t){CIV_ERROR_INVALID_STATE, "Already a member"};
-    }
-  }
+  civ_symbol_t nation = civ_symbol_intern(nation_id);
+  if (nation == CIV_SYMBOL_NONE)
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
+  if (member_slot(org, nation) >= 0)
+    return (civ_result_t){CIV_ERROR_INVALID_STATE, "Already a member"};
 
   if (org->member_count >= org->member_capacity) {
     size_t new_cap = org->member_capacity == 0 ? 4 : org->member_capacity * 2;
-    char **new_ids = CIV_REALLOC(org->member_ids, new_cap * sizeof(char *));
+    civ_symbol_t *new_ids = CIV_REALLOC(org->members, new_cap * sizeof(civ_symbol_t));
     if (!new_ids)
       return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
-    org->member_ids = new_ids;
+    org->members = new_ids;
     org->member_capacity = new_cap;
   }
 
-  org->member_ids[org->member_count] = CIV_MALLOC(strlen(nation_id) + 1);
-  strcpy(org->member_ids[org->member_count], nation_id);
-  org->member_count++;
+  org->members[org->member_count++] = nation;
+  org->members_valid = false;
 
   return (civ_result_t){CIV_OK, "Member added"};
 }
 
-civ_result_t civ_org_propose_resolution(civ_international_org_t *org,
-                                        const char *title, const char *desc,
-                                        const char *proposer) {
-  if (!org || !title)
+civ_result_t civ_org_remove_member(civ_international_org_t *org,
+                                   const char *nation_id) {
+  if (!org || !nation_id)
     return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Invalid args"};
 
+  int32_t slot = member_slot(org, civ_symbol_find(nation_id));
+  if (slot < 0)
+    return (civ_result_t){CIV_ERROR_NOT_FOUND, "Not a member"};
+
+  org->members[slot] = org->members[--org->member_count];
+  org->members_valid = false;
+  return (civ_result_t){CIV_OK, "Member removed"};
+}
+
+int32_t civ_org_propose_resolution(civ_international_org_t *org,
+                                   const char *title, const char *desc,
+                                   const char *proposer, const float *position) {
+  if (!org || !title)
+    return -1;
+
   if (org->resolution_count >= org->resolution_capacity) {
     size_t new_cap =
         org->resolution_capacity == 0 ? 4 : org->resolution_capacity * 2;
     civ_resolution_t *new_res =
         CIV_REALLOC(org->resolutions, new_cap * sizeof(civ_resolution_t));
     if (!new_res)
-      return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
+      return -1;
     org->resolutions = new_res;
     org->resolution_capacity = new_cap;
   }
 
-  civ_resolution_t *res = &org->resolutions[org->resolution_count++];
-  snprintf(res->id, STRING_SHORT_LEN, "res_%ld", (long)time(NULL));
-  strncpy(res->title, title, STRING_MEDIUM_LEN - 1);
+  char id[STRING_SHORT_LEN];
+  snprintf(id, sizeof(id), "res_%u", org->resolutions_proposed);
+  civ_symbol_t sym = civ_symbol_intern(id);
+  if (sym == CIV_SYMBOL_NONE)
+    return -1;
+
+  civ_resolution_t *res = &org->resolutions[org->resolution_count];
+  memset(res, 0, sizeof(*res));
+  snprintf(res->id, sizeof(res->id), "%s", id);
+  snprintf(res->title, sizeof(res->title), "%s", title);
   if (desc)
-    strncpy(res->description, desc, STRING_MAX_LEN - 1);
-  if (proposer)
-    strncpy(res->proposer_id, proposer, STRING_SHORT_LEN - 1);
-
-  res->votes_for = 0;
-  res->votes_against = 0;
-  res->votes_abstain = 0;
-  res->passed = false;
+    snprintf(res->description, sizeof(res->description), "%s", desc);
+  if (proposer) {
+    snprintf(res->proposer_id, sizeof(res->proposer_id), "%s", proposer);
+    res->proposer = civ_symbol_intern(proposer);
+  }
+  if (position)
+    memcpy(res->position, position, sizeof(res->position));
+  res->sym = sym;
+  res->pass_share = 0.5f;
   res->active = true;
 
-  return (civ_result_t){CIV_OK, "Resolution proposed"};
+  org->resolutions_proposed++;
+  return (int32_t)org->resolution_count++;
+}
+
+int32_t civ_org_find_resolution(const civ_international_org_t *org, civ_symbol_t id) {
+  if (!org || id == CIV_SYMBOL_NONE)
+    return -1;
+  for (size_t i = 0; i < org->resolution_count; i++)
+    if (org->resolutions[i].sym == id)
+      return (int32_t)i;
+  return -1;
+}
+
+civ_result_t civ_org_vote(civ_international_org_t *org,
+                          const char *resolution_id, const char *voter_id,
+                          int vote) {
+  if (!org || !resolution_id || !voter_id)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Invalid args"};
+
+  int32_t r = civ_org_find_resolution(org, civ_symbol_find(resolution_id));
+  if (r < 0 || !org->resolutions[r].active)
+    return (civ_result_t){CIV_ERROR_NOT_FOUND, "Resolution not open"};
+  civ_symbol_t voter = civ_symbol_find(voter_id);
+  if (!civ_org_is_member(org, voter))
+    return (civ_result_t){CIV_ERROR_INVALID_STATE, "Not a member"};
+
+  civ_resolution_t *res = &org->resolutions[r];
+  int8_t v = vote > 0 ? 1 : vote < 0 ? -1 : 0;
+  for (size_t i = 0; i < res->cast_count; i++) {
+    if (res->cast_by[i] == voter) {
+      res->cast_vote[i] = v;
+      return (civ_result_t){CIV_OK, "Vote changed"};
+    }
+  }
+
+  if (res->cast_count >= res->cast_capacity) {
+    size_t new_cap = res->cast_capacity == 0 ? 4 : res->cast_capacity * 2;
+    civ_symbol_t *by = CIV_REALLOC(res->cast_by, new_cap * sizeof(civ_symbol_t));
+    if (!by)
+      return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
+    res->cast_by = by;
+    int8_t *votes = CIV_REALLOC(res->cast_vote, new_cap * sizeof(int8_t));
+    if (!votes)
+      return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
+    res->cast_vote = votes;
+    res->cast_capacity = new_cap;
+  }
+  res->cast_by[res->cast_count] = voter;
+  res->cast_vote[res->cast_count++] = v;
+  return (civ_result_t){CIV_OK, "Vote cast"};
 }
 
 civ_result_t civ_org_manager_add(civ_org_manager_t *manager,
@@ -150,3 +223,167 @@ civ_result_t civ_org_manager_add(civ_org_manager_t *manager,
 
   return (civ_result_t){CIV_OK, "Organization added"};
 }
+
+civ_international_org_t *civ_org_manager_find(civ_org_manager_t *manager,
+                                              const char *id) {
+  if (!manager || !id)
+    return NULL;
+  for (size_t i = 0; i < manager->org_count; i++)
+    if (strcmp(manager->orgs[i].id, id) == 0)
+      return &manager->orgs[i];
+  return NULL;
+}
+
+/* ── Sessions ──────────────────────────────────────────────────────── */
+
+/* Member bits against the diplomacy table; false without memory */
+static bool rebuild_member_bits(civ_international_org_t *org,
+                                const civ_diplomacy_system_t *ds) {
+  if (org->members_valid && org->member_table == ds &&
+      org->member_table_size == ds->nation_count)
+    return true;
+
+  size_t words = (ds->nation_count + 63) / 64;
+  if (words > org->member_words) {
+    uint64_t *bits = CIV_REALLOC(org->member_bits, words * sizeof(uint64_t));
+    if (!bits)
+      return false;
+    org->member_bits = bits;
+    org->member_words = words;
+  }
+  memset(org->member_bits, 0, org->member_words * sizeof(uint64_t));
+  for (size_t i = 0; i < org->member_count; i++) {
+    int32_t n = civ_diplomacy_nation_index(ds, civ_symbol_name(org->members[i]));
+    if (n >= 0)
+      org->member_bits[n >> 6] |= (uint64_t)1 << (n & 63);
+  }
+  org->member_table = ds;
+  org->member_table_size = ds->nation_count;
+  org->members_valid = true;
+  return true;
+}
+
+/* Half opinion of the proposer, half closeness to the position, -1 to 1 */
+static float member_score(const civ_diplomacy_system_t *ds, int32_t member,
+                          int32_t proposer, const civ_resolution_t *res,
+                          const civ_float_t *ideology, size_t axes) {
+  float regard = 0.0f;
+  if (member == proposer) {
+    regard = 1.0f;
+  } else if (proposer >= 0) {
+    civ_relation_id_t rel = civ_diplomacy_relation_between(ds, member, proposer);
+    if (rel != CIV_RELATION_NONE)
+      regard = (float)ds->rel.opinion_score[rel] * 0.01f;
+  }
+  if (!ideology)
+    return regard;
+
+  /* Axes run -1 to 1, so the farthest two points are 2 sqrt(n) apart */
+  size_t n = MIN(axes, (size_t)CIV_ORG_AXES);
+  const civ_float_t *row = ideology + (size_t)member * axes;
+  float d2 = 0.0f;
+  for (size_t k = 0; k < n; k++) {
+    float d = (float)row[k] - res->position[k];
+    d2 += d * d;
+  }
+  float closeness = n ? 1.0f - sqrtf(d2 / (float)n) : 0.0f;
+  return 0.5f * regard + 0.5f * closeness;
+}
+
+/* Drop what the last session decided, keeping the open order */
+static void compact_resolutions(civ_international_org_t *org) {
+  size_t kept = 0;
+  for (size_t i = 0; i < org->resolution_count; i++) {
+    if (org->resolutions[i].active)
+      org->resolutions[kept++] = org->resolutions[i];
+    else
+      resolution_free(&org->resolutions[i]);
+  }
+  org->resolution_count = kept;
+}
+
+size_t civ_org_manager_hold_sessions(civ_org_manager_t *manager,
+                                     const civ_diplomacy_system_t *ds,
+                                     const civ_float_t *ideology, size_t axes) {
+  if (!manager || !ds)
+    return 0;
+  if (ds->nation_count > manager->vote_capacity) {
+    int8_t *vote = CIV_REALLOC(manager->vote, ds->nation_count);
+    if (!vote)
+      return 0;
+    manager->vote = vote;
+    manager->vote_capacity = ds->nation_count;
+  }
+
+  size_t decided = 0;
+  for (size_t o = 0; o < manager->org_count; o++) {
+    civ_international_org_t *org = &manager->orgs[o];
+    compact_resolutions(org);
+    if (org->resolution_count == 0 || !rebuild_member_bits(org, ds))
+      continue;
+
+    size_t absent = org->member_count;
+    for (size_t w = 0; w < org->member_words; w++)
+      for (uint64_t bits = org->member_bits[w]; bits; bits &= bits - 1)
+        absent--;
+
+    float margin_sum = 0.0f;
+    size_t contested = 0;
+    for (size_t r = 0; r < org->resolution_count; r++) {
+      civ_resolution_t *res = &org->resolutions[r];
+      if (!res->active)
+        continue;
+      int32_t proposer = res->proposer != CIV_SYMBOL_NONE
+                             ? civ_diplomacy_nation_index(ds, civ_symbol_name(res->proposer))
+                             : -1;
+
+      /* Everyone's own vote, then the hand-cast ones over them */
+      for (size_t w = 0; w < org->member_words; w++) {
+        uint64_t bits = org->member_bits[w];
+        for (int b = 0; bits; b++, bits >>= 1) {
+          if (!(bits & 1))
+            continue;
+          int32_t m = (int32_t)(w * 64 + (size_t)b);
+          float score = member_score(ds, m, proposer, res, ideology, axes);
+          manager->vote[m] = score > CIV_ORG_ABSTAIN_BAND    ? 1
+                             : score < -CIV_ORG_ABSTAIN_BAND ? -1
+                                                             : 0;
+        }
+      }
+      for (size_t c = 0; c < res->cast_count; c++) {
+        int32_t m = civ_diplomacy_nation_index(ds, civ_symbol_name(res->cast_by[c]));
+        if (m >= 0 && (org->member_bits[m >> 6] >> (m & 63)) & 1)
+          manager->vote[m] = res->cast_vote[c];
+      }
+
+      int yes = 0, no = 0, abstain = (int)absent;
+      for (size_t w = 0; w < org->member_words; w++) {
+        uint64_t bits = org->member_bits[w];
+        for (int b = 0; bits; b++, bits >>= 1) {
+          if (!(bits & 1))
+            continue;
+          int8_t v = manager->vote[w * 64 + (size_t)b];
+          yes += v > 0;
+          no += v < 0;
+          abstain += v == 0;
+        }
+      }
+
+      res->votes_for = yes;
+      res->votes_against = no;
+      res->votes_abstain = abstain;
+      res->passed = yes > res->pass_share * (float)(yes + no);
+      res->active = false;
+      decided++;
+      if (yes + no > 0) {
+        margin_sum += (float)abs(yes - no) / (float)(yes + no);
+        contested++;
+      }
+    }
+
+    /* Lopsided votes are a united body; split ones wear it down */
+    if (contested)
+      org->cohesion += 0.1f * (margin_sum / (float)contested - org->cohesion);
+  }
+  return decided;
+}
@@ -5,11 +5,266 @@
 
 #include "core/diplomacy/relations.h"
 #include "common.h"
+#include "utils/rng.h"
+#include "utils/store_registry.h"
+#include "utils/timing_wheel.h"
 #include <math.h>
+#include <stddef.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
+/* Signatory strings come from the game's pool when one is attached */
+static char *alloc_name(civ_diplomacy_system_t *ds, size_t size) {
+  return ds->pool ? (char *)civ_memory_pool_allocate(ds->pool, size)
+                  : (char *)CIV_MALLOC(size);
+}
+
+static void free_name(civ_diplomacy_system_t *ds, char *name) {
+  if (ds->pool)
+    civ_memory_pool_free(ds->pool, name);
+  else
+    CIV_FREE(name);
+}
+
+static void free_treaties(civ_diplomacy_system_t *ds, civ_treaty_t *treaties,
+                          size_t count) {
+  if (!treaties)
+    return;
+  for (size_t i = 0; i < count; i++) {
+    if (treaties[i].signatories) {
+      for (size_t j = 0; j < treaties[i].signatory_count; j++) {
+        free_name(ds, treaties[i].signatories[j]);
+      }
+      CIV_FREE(treaties[i].signatories);
+    }
+  }
+  CIV_FREE(treaties);
+}
+
+/* Relation columns, for allocating, freeing and saving them together */
+#define RELATION_COLUMNS(X)                                                    \
+  X(trust) X(opinion_score) X(grievances) X(relation_level) X(current_stance) \
+  X(personality) X(casus_belli) X(last_updated)
+
+static void free_relation_table(civ_diplomacy_system_t *ds) {
+#define FREE_COLUMN(f) CIV_FREE(ds->rel.f);
+  RELATION_COLUMNS(FREE_COLUMN)
+#undef FREE_COLUMN
+  CIV_FREE(ds->nation_ids);
+  CIV_FREE(ds->nation_slots);
+  CIV_FREE(ds->casus_belli_text);
+  CIV_FREE(ds->pair_treaty_head);
+  CIV_FREE(ds->active_ids);
+  CIV_FREE(ds->is_active);
+  memset(&ds->rel, 0, sizeof(ds->rel));
+  ds->nation_ids = NULL;
+  ds->nation_slots = NULL;
+  ds->casus_belli_text = NULL;
+  ds->pair_treaty_head = NULL;
+  ds->active_ids = NULL;
+  ds->is_active = NULL;
+  ds->nation_count = ds->nation_slot_count = 0;
+  ds->relation_count = ds->casus_belli_count = 0;
+  ds->active_count = ds->active_capacity = 0;
+}
+
+/* Zeroed table for nation_count nations; ids are filled in by the caller */
+static bool alloc_relation_table(civ_diplomacy_system_t *ds,
+                                 size_t nation_count) {
+  ds->nation_count = nation_count;
+  ds->relation_count = nation_count * (nation_count ? nation_count - 1 : 0) / 2;
+  ds->nation_slot_count = 16;
+  while (ds->nation_slot_count < nation_count * 2)
+    ds->nation_slot_count *= 2;
+  ds->nation_ids = CIV_CALLOC(nation_count ? nation_count : 1,
+                              sizeof(*ds->nation_ids));
+  ds->nation_slots = (uint32_t *)CIV_CALLOC(ds->nation_slot_count,
+                                            sizeof(uint32_t));
+  bool ok = ds->nation_ids && ds->nation_slots;
+  size_t n = ds->relation_count ? ds->relation_count : 1;
+#define ALLOC_COLUMN(f)                                                        \
+  ok = ok && (ds->rel.f = CIV_CALLOC(n, sizeof(*ds->rel.f))) != NULL;
+  RELATION_COLUMNS(ALLOC_COLUMN)
+#undef ALLOC_COLUMN
+  ds->pair_treaty_head = (int32_t *)CIV_MALLOC(n * sizeof(int32_t));
+  ds->active_ids = (civ_relation_id_t *)CIV_MALLOC(n * sizeof(civ_relation_id_t));
+  ds->is_active = (uint8_t *)CIV_CALLOC(n, 1);
+  ok = ok && ds->pair_treaty_head && ds->active_ids && ds->is_active;
+  if (!ok) {
+    free_relation_table(ds);
+    return false;
+  }
+  for (size_t k = 0; k < n; k++)
+    ds->pair_treaty_head[k] = -1;
+  ds->active_capacity = n;
+  return true;
+}
+
+/* FNV-1a over the part of an id the table can hold */
+static uint32_t nation_hash(const char *id, size_t *len) {
+  uint32_t h = 2166136261u;
+  size_t n = 0;
+  while (id[n] && n < STRING_SHORT_LEN - 1) {
+    h ^= (uint8_t)id[n++];
+    h *= 16777619u;
+  }
+  *len = n;
+  return h;
+}
+
+static void index_nation(civ_diplomacy_system_t *ds, size_t nation) {
+  size_t len;
+  size_t mask = ds->nation_slot_count - 1;
+  size_t i = nation_hash(ds->nation_ids[nation], &len) & mask;
+  while (ds->nation_slots[i] != 0)
+    i = (i + 1) & mask;
+  ds->nation_slots[i] = (uint32_t)nation + 1;
+}
+
+/* Take over src's table, releasing dst's */
+static void move_relation_table(civ_diplomacy_system_t *dst,
+                                civ_diplomacy_system_t *src) {
+  free_relation_table(dst);
+  dst->nation_ids = src->nation_ids;
+  dst->nation_count = src->nation_count;
+  dst->nation_slots = src->nation_slots;
+  dst->nation_slot_count = src->nation_slot_count;
+  dst->rel = src->rel;
+  dst->relation_count = src->relation_count;
+  dst->casus_belli_text = src->casus_belli_text;
+  dst->casus_belli_count = src->casus_belli_count;
+  dst->pair_treaty_head = src->pair_treaty_head;
+  dst->active_ids = src->active_ids;
+  dst->active_count = src->active_count;
+  dst->active_capacity = src->active_capacity;
+  dst->is_active = src->is_active;
+}
+
+/* ── Treaty index and active set ──────────────────────────────────── */
+
+#define TRUST_REST     0.5f
+#define TRUST_REST_EPS 1e-4f /* closer than this, drift has nothing to do */
+
+static civ_relation_level_t level_for_trust(civ_float_t trust) {
+  return trust < 0.3f   ? CIV_RELATION_LEVEL_HOSTILE
+         : trust < 0.4f ? CIV_RELATION_LEVEL_NEUTRAL
+         : trust < 0.7f ? CIV_RELATION_LEVEL_FRIENDLY
+                        : CIV_RELATION_LEVEL_ALLIED;
+}
+
+static void activate(civ_diplomacy_system_t *ds, civ_relation_id_t id) {
+  if (id < 0 || (size_t)id >= ds->relation_count || ds->is_active[id])
+    return;
+  ds->is_active[id] = 1;
+  ds->active_ids[ds->active_count++] = id;
+}
+
+/* Active trade agreements on a pair, each a buff to its trust drift */
+static int pair_trade_agreements(const civ_diplomacy_system_t *ds,
+                                 civ_relation_id_t id) {
+  int n = 0;
+  for (int32_t t = ds->pair_treaty_head[id]; t >= 0;
+       t = ds->treaties[t].next_in_pair)
+    n += ds->treaties[t].treaty_type == CIV_TREATY_TYPE_TRADE_AGREEMENT;
+  return n;
+}
+
+static bool at_rest(const civ_diplomacy_system_t *ds, size_t k) {
+  civ_float_t trust = ds->rel.trust[k];
+  return fabs(trust - TRUST_REST) <= TRUST_REST_EPS &&
+         ds->rel.relation_level[k] == (int8_t)level_for_trust(trust) &&
+         pair_trade_agreements(ds, (civ_relation_id_t)k) == 0;
+}
+
+static void link_treaty(civ_diplomacy_system_t *ds, int32_t index) {
+  civ_treaty_t *t = &ds->treaties[index];
+  t->next_in_pair = -1;
+  if (!t->active || (size_t)t->treaty_type >= CIV_TREATY_TYPE_COUNT)
+    return;
+  ds->active_treaties[t->treaty_type]++;
+  if (t->relation == CIV_RELATION_NONE)
+    return;
+  t->next_in_pair = ds->pair_treaty_head[t->relation];
+  ds->pair_treaty_head[t->relation] = index;
+  activate(ds, t->relation);
+}
+
+static void unlink_treaty(civ_diplomacy_system_t *ds, int32_t index) {
+  civ_treaty_t *t = &ds->treaties[index];
+  if ((size_t)t->treaty_type < CIV_TREATY_TYPE_COUNT)
+    ds->active_treaties[t->treaty_type]--;
+  if (t->relation == CIV_RELATION_NONE)
+    return;
+  int32_t *link = &ds->pair_treaty_head[t->relation];
+  while (*link >= 0 && *link != index)
+    link = &ds->treaties[*link].next_in_pair;
+  if (*link == index)
+    *link = t->next_in_pair;
+  t->next_in_pair = -1;
+  activate(ds, t->relation);
+}
+
+/* After the nation table or the treaty list was replaced */
+static void rebuild_indexes(civ_diplomacy_system_t *ds) {
+  for (size_t k = 0; k < ds->relation_count; k++)
+    ds->pair_treaty_head[k] = -1;
+  memset(ds->active_treaties, 0, sizeof(ds->active_treaties));
+  for (size_t i = 0; i < ds->treaty_count; i++) {
+    civ_treaty_t *t = &ds->treaties[i];
+    t->relation = t->signatory_count >= 2
+                      ? civ_diplomacy_relation_id(ds, t->signatories[0],
+                                                  t->signatories[1])
+                      : CIV_RELATION_NONE;
+    link_treaty(ds, (int32_t)i);
+  }
+  ds->active_count = 0;
+  if (ds->is_active)
+    memset(ds->is_active, 0, ds->relation_count);
+  for (size_t k = 0; k < ds->relation_count; k++)
+    if (!at_rest(ds, k))
+      activate(ds, (civ_relation_id_t)k);
+}
+
+/* The expiry wheel counts whole game hours of the treaty clock */
+static uint64_t clock_hours(const civ_diplomacy_system_t *ds) {
+  return (uint64_t)floor(ds->clock_days * 24.0);
+}
+
+static void expire_treaty(void *arg, uint64_t key, uint64_t due) {
+  (void)due;
+  civ_diplomacy_system_t *ds = (civ_diplomacy_system_t *)arg;
+  civ_treaty_t *t = &ds->treaties[key];
+  t->expiry = 0;
+  t->days_left = 0;
+  if (t->active) {
+    t->active = false;
+    unlink_treaty(ds, (int32_t)key);
+  }
+}
+
+/* Put treaty index in the wheel at its days_left from now */
+static void schedule_expiry(civ_diplomacy_system_t *ds, size_t index) {
+  civ_treaty_t *t = &ds->treaties[index];
+  t->expiry = 0;
+  if (!t->active || t->duration_days <= 0)
+    return;
+  double ends = ds->clock_days + MAX(t->days_left, 0.0);
+  t->expiry = civ_timing_wheel_schedule(&ds->expiry,
+                                        (uint64_t)ceil(ends * 24.0),
+                                        expire_treaty, ds, index);
+}
+
+static void set_neutral(civ_diplomacy_system_t *ds, civ_relation_id_t id,
+                        time_t now) {
+  ds->rel.relation_level[id] = CIV_RELATION_LEVEL_NEUTRAL;
+  ds->rel.trust[id] = 0.5f;
+  ds->rel.personality[id] = (uint8_t)(civ_rand() % 4);
+  ds->rel.casus_belli[id] = -1;
+  ds->rel.last_updated[id] = now;
+}
+
 civ_diplomacy_system_t *civ_diplomacy_system_create(void) {
   civ_diplomacy_system_t *ds =
       (civ_diplomacy_system_t *)CIV_MALLOC(sizeof(civ_diplomacy_system_t));
@@ -19,6 +274,12 @@ civ_diplomacy_system_t *civ_diplomacy_system_create(void) {
   }
 
   civ_diplomacy_system_init(ds);
+  CIV_STORE_REGISTER("diplomacy.treaties", ds, ds->treaty_count,
+                     ds->treaty_capacity, sizeof(civ_treaty_t),
+                     CIV_STORE_INDEXED);
+  CIV_STORE_REGISTER("diplomacy.active_relations", ds, ds->active_count,
+                     ds->active_capacity, sizeof(civ_relation_id_t),
+                     CIV_STORE_APPEND);
   return ds;
 }
 
@@ -26,21 +287,10 @@ void civ_diplomacy_system_destroy(civ_diplomacy_system_t *ds) {
   if (!ds)
     return;
 
-  if (ds->relations) {
-    CIV_FREE(ds->relations);
-  }
-
-  if (ds->treaties) {
-    for (size_t i = 0; i < ds->treaty_count; i++) {
-      if (ds->treaties[i].signatories) {
-        for (size_t j = 0; j < ds->treaties[i].signatory_count; j++) {
-          CIV_FREE(ds->treaties[i].signatories[j]);
-        }
-        CIV_FREE(ds->treaties[i].signatories);
-      }
-    }
-    CIV_FREE(ds->treaties);
-  }
+  civ_store_unregister_owner(ds);
+  free_relation_table(ds);
+  free_treaties(ds, ds->treaties, ds->treaty_count);
+  civ_timing_wheel_free(&ds->expiry);
 
   CIV_FREE(ds);
 }
@@ -50,9 +300,7 @@ void civ_diplomacy_system_init(civ_diplomacy_system_t *ds) {
     return;
 
   memset(ds, 0, sizeof(civ_diplomacy_system_t));
-  ds->relation_capacity = 100;
-  ds->relations = (civ_diplomatic_relation_t *)CIV_CALLOC(
-      ds->relation_capacity, sizeof(civ_diplomatic_relation_t));
+  civ_timing_wheel_init(&ds->expiry, 0);
   ds->treaty_capacity = 50;
   ds->treaties =
       (civ_treaty_t *)CIV_CALLOC(ds->treaty_capacity, sizeof(civ_treaty_t));
@@ -64,45 +312,59 @@ void civ_diplomacy_system_initialize_relations(civ_diplomacy_system_t *ds,
   if (!ds || !nation_ids)
     return;
 
-  /* Create relations between all nations */
+  civ_diplomacy_system_t fresh;
+  memset(&fresh, 0, sizeof(fresh));
+  if (!alloc_relation_table(&fresh, nation_count)) {
+    civ_log(CIV_LOG_ERROR, "Failed to allocate relations for %zu nations",
+            nation_count);
+    return;
+  }
   for (size_t i = 0; i < nation_count; i++) {
-    for (size_t j = 0; j < nation_count; j++) {
-      if (i != j) {
-        if (ds->relation_count >= ds->relation_capacity) {
-          ds->relation_capacity *= 2;
-          ds->relations = (civ_diplomatic_relation_t *)CIV_REALLOC(
-              ds->relations,
-              ds->relation_capacity * sizeof(civ_diplomatic_relation_t));
-        }
-
-        civ_diplomatic_relation_t *rel = &ds->relations[ds->relation_count++];
-        strncpy(rel->nation_a, nation_ids[i], sizeof(rel->nation_a) - 1);
-        strncpy(rel->nation_b, nation_ids[j], sizeof(rel->nation_b) - 1);
-        rel->relation_level = CIV_RELATION_LEVEL_NEUTRAL;
-        rel->trust = 0.5f;
-        rel->personality = (civ_personality_type_t)(rand() % 4);
-        rel->last_updated = time(NULL);
-      }
-    }
+    snprintf(fresh.nation_ids[i], sizeof(fresh.nation_ids[i]), "%s",
+             nation_ids[i]);
+    index_nation(&fresh, i);
   }
-}
 
-civ_diplomatic_relation_t *
-civ_diplomacy_system_get_relation(civ_diplomacy_system_t *ds,
-                                  const char *nation_a, const char *nation_b) {
-  if (!ds || !nation_a || !nation_b)
-    return NULL;
+  /* Create relations between all nations */
+  time_t now = time(NULL);
+  for (size_t k = 0; k < fresh.relation_count; k++)
+    set_neutral(&fresh, (civ_relation_id_t)k, now);
+  move_relation_table(ds, &fresh);
+  rebuild_indexes(ds);
+}
 
-  for (size_t i = 0; i < ds->relation_count; i++) {
-    if ((strcmp(ds->relations[i].nation_a, nation_a) == 0 &&
-         strcmp(ds->relations[i].nation_b, nation_b) == 0) ||
-        (strcmp(ds->relations[i].nation_a, nation_b) == 0 &&
-         strcmp(ds->relations[i].nation_b, nation_a) == 0)) {
-      return &ds->relations[i];
-    }
+int32_t civ_diplomacy_nation_index(const civ_diplomacy_system_t *ds,
+                                   const char *nation_id) {
+  if (!ds || !nation_id || ds->nation_slot_count == 0)
+    return -1;
+  size_t len;
+  uint32_t hash = nation_hash(nation_id, &len);
+  size_t mask = ds->nation_slot_count - 1;
+  for (size_t i = hash & mask;; i = (i + 1) & mask) {
+    uint32_t slot = ds->nation_slots[i];
+    if (slot == 0)
+      return -1;
+    const char *id = ds->nation_ids[slot - 1];
+    if (strncmp(id, nation_id, len) == 0 && id[len] == '\0')
+      return (int32_t)(slot - 1);
   }
+}
 
-  return NULL;
+civ_relation_id_t civ_diplomacy_relation_between(const civ_diplomacy_system_t *ds,
+                                                 int32_t a, int32_t b) {
+  if (!ds || a < 0 || b < 0 || a == b || (size_t)a >= ds->nation_count ||
+      (size_t)b >= ds->nation_count)
+    return CIV_RELATION_NONE;
+  int64_t lo = MIN(a, b), hi = MAX(a, b);
+  return (civ_relation_id_t)(hi * (hi - 1) / 2 + lo);
+}
+
+civ_relation_id_t civ_diplomacy_relation_id(const civ_diplomacy_system_t *ds,
+                                            const char *nation_a,
+                                            const char *nation_b) {
+  return civ_diplomacy_relation_between(ds,
+                                        civ_diplomacy_nation_index(ds, nation_a),
+                                        civ_diplomacy_nation_index(ds, nation_b));
 }
 
 void civ_diplomacy_system_update_relations(civ_diplomacy_system_t *ds,
@@ -110,48 +372,69 @@ void civ_diplomacy_system_update_relations(civ_diplomacy_system_t *ds,
   if (!ds)
     return;
 
-  /* Simplified relation update */
-  for (size_t i = 0; i < ds->relation_count; i++) {
-    civ_diplomatic_relation_t *rel = &ds->relations[i];
-
-    /* Check for active treaties affecting this relation */
-    civ_float_t treaty_bonus = 0.0f;
-    for (size_t t = 0; t < ds->treaty_count; t++) {
-      civ_treaty_t *treaty = &ds->treaties[t];
-      if (treaty->active &&
-          treaty->treaty_type == CIV_TREATY_TYPE_TRADE_AGREEMENT) {
-        /* Check if this relation involves signatories */
-        bool match = false;
-        if (strcmp(treaty->signatories[0], rel->nation_a) == 0 &&
-            strcmp(treaty->signatories[1], rel->nation_b) == 0)
-          match = true;
-        if (strcmp(treaty->signatories[0], rel->nation_b) == 0 &&
-            strcmp(treaty->signatories[1], rel->nation_a) == 0)
-          match = true;
-
-        if (match) {
-          treaty_bonus += 0.005f; /* Buff to trust drift */
-        }
-      }
-    }
+  civ_float_t *trust = ds->rel.trust;
+  size_t kept = 0;
+  for (size_t a = 0; a < ds->active_count; a++) {
+    civ_relation_id_t k = ds->active_ids[a];
+    int agreements = pair_trade_agreements(ds, k);
 
-    /* Gradual drift toward neutral */
-    civ_float_t drift = (rel->trust - 0.5f) * 0.01f;
-    rel->trust = CLAMP(rel->trust - drift + treaty_bonus, 0.0f, 1.0f);
+    /* Gradual drift toward neutral, buffed by trade agreements */
+    trust[k] -= (trust[k] - TRUST_REST) * 0.01f;
+    trust[k] = CLAMP(trust[k] + 0.005f * agreements, 0.0f, 1.0f);
+    if (agreements == 0 && fabs(trust[k] - TRUST_REST) <= TRUST_REST_EPS)
+      trust[k] = TRUST_REST;
 
     /* Update relation level based on trust */
-    if (rel->trust < 0.3f) {
-      rel->relation_level = CIV_RELATION_LEVEL_HOSTILE;
-    } else if (rel->trust < 0.4f) {
-      rel->relation_level = CIV_RELATION_LEVEL_NEUTRAL;
-    } else if (rel->trust < 0.7f) {
-      rel->relation_level = CIV_RELATION_LEVEL_FRIENDLY;
-    } else {
-      rel->relation_level = CIV_RELATION_LEVEL_ALLIED;
-    }
+    ds->rel.relation_level[k] = (int8_t)level_for_trust(trust[k]);
+    ds->rel.last_updated[k] = current_date;
 
-    rel->last_updated = current_date;
+    if (agreements > 0 || trust[k] != TRUST_REST)
+      ds->active_ids[kept++] = k;
+    else
+      ds->is_active[k] = 0;
   }
+  ds->active_count = kept;
+}
+
+void civ_diplomacy_system_advance_treaties(civ_diplomacy_system_t *ds,
+                                           civ_float_t days) {
+  if (!ds || days <= 0)
+    return;
+  ds->clock_days += days;
+  civ_timing_wheel_advance(&ds->expiry, clock_hours(ds));
+}
+
+civ_float_t civ_diplomacy_treaty_days_left(const civ_diplomacy_system_t *ds,
+                                           size_t index) {
+  if (!ds || index >= ds->treaty_count)
+    return 0;
+  const civ_treaty_t *t = &ds->treaties[index];
+  if (!t->active)
+    return t->days_left;
+  uint64_t due = civ_timing_wheel_due(&ds->expiry, t->expiry);
+  if (due == 0)
+    return t->duration_days > 0 ? t->days_left : (civ_float_t)t->duration_days;
+  return (civ_float_t)MAX((double)due / 24.0 - ds->clock_days, 0.0);
+}
+
+void civ_diplomacy_touch_relation(civ_diplomacy_system_t *ds,
+                                  civ_relation_id_t id) {
+  if (ds)
+    activate(ds, id);
+}
+
+size_t civ_diplomacy_active_treaty_count(const civ_diplomacy_system_t *ds,
+                                         civ_treaty_type_t type) {
+  if (!ds || (size_t)type >= CIV_TREATY_TYPE_COUNT)
+    return 0;
+  return ds->active_treaties[type];
+}
+
+int32_t civ_diplomacy_pair_first_treaty(const civ_diplomacy_system_t *ds,
+                                        civ_relation_id_t id) {
+  if (!ds || id < 0 || (size_t)id >= ds->relation_count)
+    return -1;
+  return ds->pair_treaty_head[id];
 }
 
 civ_result_t civ_diplomacy_system_propose_treaty(civ_diplomacy_system_t *ds,
@@ -166,15 +449,14 @@ civ_result_t civ_diplomacy_system_propose_treaty(civ_diplomacy_system_t *ds,
     return result;
   }
 
-  civ_diplomatic_relation_t *rel =
-      civ_diplomacy_system_get_relation(ds, proposer, recipient);
-  if (!rel) {
+  civ_relation_id_t rel = civ_diplomacy_relation_id(ds, proposer, recipient);
+  if (rel == CIV_RELATION_NONE) {
     result.error = CIV_ERROR_NOT_FOUND;
     return result;
   }
 
   /* Check acceptance based on trust */
-  civ_float_t acceptance_chance = rel->trust;
+  civ_float_t acceptance_chance = ds->rel.trust[rel];
   if (acceptance_chance < 0.3f) {
     result.error = CIV_ERROR_INVALID_STATE;
     result.message = "Treaty rejected due to low trust";
@@ -196,35 +478,499 @@ civ_result_t civ_diplomacy_system_propose_treaty(civ_diplomacy_system_t *ds,
   treaty->treaty_type = type;
   treaty->signatory_count = 2;
   treaty->signatories = (char **)CIV_CALLOC(2, sizeof(char *));
-  treaty->signatories[0] = (char *)CIV_MALLOC(strlen(proposer) + 1);
-  treaty->signatories[1] = (char *)CIV_MALLOC(strlen(recipient) + 1);
+  treaty->signatories[0] = alloc_name(ds, strlen(proposer) + 1);
+  treaty->signatories[1] = alloc_name(ds, strlen(recipient) + 1);
   strcpy(treaty->signatories[0], proposer);
   strcpy(treaty->signatories[1], recipient);
   treaty->start_date = time(NULL);
   treaty->duration_days = duration_days;
+  treaty->days_left = (civ_float_t)duration_days;
   treaty->active = true;
+  treaty->relation = rel;
+  link_treaty(ds, (int32_t)(ds->treaty_count - 1));
+  schedule_expiry(ds, ds->treaty_count - 1);
 
   return result;
 }
 
-void civ_diplomacy_add_grievance(civ_diplomatic_relation_t *rel,
-                                 civ_float_t amount, const char *reason) {
-  if (!rel)
+/* Index of reason in the casus belli strings, adding it if new */
+static int32_t intern_casus_belli(civ_diplomacy_system_t *ds,
+                                  const char *reason) {
+  for (size_t i = 0; i < ds->casus_belli_count; i++)
+    if (strncmp(ds->casus_belli_text[i], reason, STRING_MEDIUM_LEN - 1) == 0)
+      return (int32_t)i;
+  char(*grown)[STRING_MEDIUM_LEN] = CIV_REALLOC(
+      ds->casus_belli_text,
+      (ds->casus_belli_count + 1) * sizeof(*ds->casus_belli_text));
+  if (!grown)
+    return -1;
+  ds->casus_belli_text = grown;
+  snprintf(grown[ds->casus_belli_count], STRING_MEDIUM_LEN, "%s", reason);
+  return (int32_t)ds->casus_belli_count++;
+}
+
+void civ_diplomacy_add_grievance(civ_diplomacy_system_t *ds,
+                                 civ_relation_id_t id, civ_float_t amount,
+                                 const char *reason) {
+  if (!ds || id < 0 || (size_t)id >= ds->relation_count)
     return;
 
-  rel->grievances += amount;
+  ds->rel.grievances[id] += amount;
   if (amount > 0.5f && reason) {
-    strncpy(rel->primary_casus_belli, reason, STRING_MEDIUM_LEN - 1);
+    ds->rel.casus_belli[id] = intern_casus_belli(ds, reason);
   }
   civ_log(CIV_LOG_INFO, "Grievance added: %s (New total: %.2f)",
-          reason ? reason : "Unknown", rel->grievances);
+          reason ? reason : "Unknown", ds->rel.grievances[id]);
 }
 
-bool civ_diplomacy_has_legitimate_war_goal(
-    const civ_diplomatic_relation_t *rel) {
-  if (!rel)
+bool civ_diplomacy_has_legitimate_war_goal(const civ_diplomacy_system_t *ds,
+                                           civ_relation_id_t id) {
+  if (!ds || id < 0 || (size_t)id >= ds->relation_count)
     return false;
 
   /* Justified if grievances exceed 1.0 or specific casus belli exists */
-  return (rel->grievances > 1.0f) || (strlen(rel->primary_casus_belli) > 0);
+  return (ds->rel.grievances[id] > 1.0f) ||
+         civ_diplomacy_casus_belli(ds, id)[0] != '\0';
+}
+
+const char *civ_diplomacy_casus_belli(const civ_diplomacy_system_t *ds,
+                                      civ_relation_id_t id) {
+  if (!ds || id < 0 || (size_t)id >= ds->relation_count)
+    return "";
+  int32_t cb = ds->rel.casus_belli[id];
+  return cb >= 0 && (size_t)cb < ds->casus_belli_count
+             ? ds->casus_belli_text[cb]
+             : "";
+}
+
+/* ---- Merges and secessions ---- */
+
+static bool grow_buffer(void **buffer, size_t count, size_t size) {
+  void *grown = CIV_REALLOC(*buffer, MAX(count, 1) * size);
+  if (grown)
+    *buffer = grown;
+  return grown != NULL;
+}
+
+int32_t civ_diplomacy_add_nation(civ_diplomacy_system_t *ds,
+                                 const char *nation_id) {
+  if (!ds || !nation_id || !nation_id[0])
+    return -1;
+  int32_t existing = civ_diplomacy_nation_index(ds, nation_id);
+  if (existing >= 0)
+    return existing;
+
+  /* The new nation's relations go on the end of the triangle. A failed
+     grow leaves larger buffers behind and the table as it was. */
+  size_t nation = ds->nation_count;
+  size_t count = ds->relation_count + nation;
+  bool ok = grow_buffer((void **)&ds->nation_ids, nation + 1,
+                        sizeof(*ds->nation_ids));
+#define GROW_COLUMN(f)                                                         \
+  ok = ok && grow_buffer((void **)&ds->rel.f, count, sizeof(*ds->rel.f));
+  RELATION_COLUMNS(GROW_COLUMN)
+#undef GROW_COLUMN
+  ok = ok &&
+       grow_buffer((void **)&ds->pair_treaty_head, count, sizeof(int32_t)) &&
+       grow_buffer((void **)&ds->active_ids, count, sizeof(civ_relation_id_t)) &&
+       grow_buffer((void **)&ds->is_active, count, 1);
+  uint32_t *slots = NULL;
+  size_t slot_count = MAX(ds->nation_slot_count, (size_t)16);
+  while (slot_count < (nation + 1) * 2)
+    slot_count *= 2;
+  if (ok && slot_count != ds->nation_slot_count) {
+    slots = (uint32_t *)CIV_CALLOC(slot_count, sizeof(uint32_t));
+    ok = slots != NULL;
+  }
+  if (!ok) {
+    civ_log(CIV_LOG_ERROR, "Failed to grow relations for nation %s", nation_id);
+    return -1;
+  }
+
+  snprintf(ds->nation_ids[nation], sizeof(ds->nation_ids[nation]), "%s",
+           nation_id);
+  ds->nation_count = nation + 1;
+  if (slots) {
+    CIV_FREE(ds->nation_slots);
+    ds->nation_slots = slots;
+    ds->nation_slot_count = slot_count;
+    for (size_t i = 0; i < ds->nation_count; i++)
+      index_nation(ds, i);
+  } else {
+    index_nation(ds, nation);
+  }
+
+  time_t now = time(NULL);
+  for (size_t k = ds->relation_count; k < count; k++) {
+    ds->rel.opinion_score[k] = 0;
+    ds->rel.grievances[k] = 0;
+    ds->rel.current_stance[k] = 0;
+    set_neutral(ds, (civ_relation_id_t)k, now);
+    ds->pair_treaty_head[k] = -1;
+    ds->is_active[k] = 0;
+  }
+  ds->relation_count = count;
+  ds->active_capacity = MAX(count, 1);
+  for (size_t k = count - nation; k < count; k++)
+    activate(ds, (civ_relation_id_t)k);
+  return (int32_t)nation;
+}
+
+civ_result_t civ_diplomacy_merge_nations(civ_diplomacy_system_t *ds,
+                                         const char *into, const char *from,
+                                         civ_float_t weight,
+                                         civ_diplomacy_merge_t *out) {
+  civ_diplomacy_merge_t merge = {0, 0};
+  if (out)
+    *out = merge;
+  if (!ds || !into || !from)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, NULL};
+  int32_t a = civ_diplomacy_nation_index(ds, into);
+  int32_t b = civ_diplomacy_nation_index(ds, from);
+  if (a < 0 || b < 0 || a == b)
+    return (civ_result_t){CIV_ERROR_NOT_FOUND, "Nation not in the table"};
+  weight = CLAMP(weight, 0.0f, 1.0f);
+  time_t now = time(NULL);
+
+  for (int32_t c = 0; c < (int32_t)ds->nation_count; c++) {
+    if (c == b)
+      continue;
+    civ_relation_id_t old = civ_diplomacy_relation_between(ds, b, c);
+
+    /* from's treaties with c pass to into, and with into itself lapse */
+    while (ds->pair_treaty_head[old] >= 0) {
+      int32_t index = ds->pair_treaty_head[old];
+      civ_treaty_t *t = &ds->treaties[index];
+      unlink_treaty(ds, index);
+      if (c == a) {
+        t->days_left = civ_diplomacy_treaty_days_left(ds, (size_t)index);
+        civ_timing_wheel_cancel(&ds->expiry, t->expiry);
+        t->expiry = 0;
+        t->active = false;
+        merge.dissolved++;
+        continue;
+      }
+      for (size_t j = 0; j < t->signatory_count; j++) {
+        if (strcmp(t->signatories[j], from) != 0)
+          continue;
+        char *name = alloc_name(ds, strlen(into) + 1);
+        if (!name)
+          continue;
+        strcpy(name, into);
+        free_name(ds, t->signatories[j]);
+        t->signatories[j] = name;
+      }
+      t->relation = t->signatory_count >= 2
+                        ? civ_diplomacy_relation_id(ds, t->signatories[0],
+                                                    t->signatories[1])
+                        : CIV_RELATION_NONE;
+      if (t->relation == old)
+        t->relation = CIV_RELATION_NONE; /* could not be renamed */
+      link_treaty(ds, index);
+      merge.rewritten++;
+    }
+
+    /* into takes on from's standing in proportion, the worse level and
+       every grievance */
+    if (c != a) {
+      civ_relation_id_t kept = civ_diplomacy_relation_between(ds, a, c);
+      ds->rel.trust[kept] += (ds->rel.trust[old] - ds->rel.trust[kept]) * weight;
+      ds->rel.opinion_score[kept] +=
+          (ds->rel.opinion_score[old] - ds->rel.opinion_score[kept]) * weight;
+      ds->rel.grievances[kept] += ds->rel.grievances[old];
+      ds->rel.relation_level[kept] =
+          MIN(ds->rel.relation_level[kept], ds->rel.relation_level[old]);
+      if (ds->rel.casus_belli[kept] < 0)
+        ds->rel.casus_belli[kept] = ds->rel.casus_belli[old];
+      ds->rel.last_updated[kept] = now;
+      activate(ds, kept);
+    }
+    ds->rel.opinion_score[old] = 0;
+    ds->rel.grievances[old] = 0;
+    set_neutral(ds, old, now);
+    activate(ds, old);
+  }
+  if (out)
+    *out = merge;
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+void civ_diplomacy_copy_relations(civ_diplomacy_system_t *ds, const char *from,
+                                  const char *to) {
+  int32_t a = civ_diplomacy_nation_index(ds, from);
+  int32_t b = civ_diplomacy_nation_index(ds, to);
+  if (a < 0 || b < 0 || a == b)
+    return;
+  for (int32_t c = 0; c < (int32_t)ds->nation_count; c++) {
+    if (c == a || c == b)
+      continue;
+    civ_relation_id_t src = civ_diplomacy_relation_between(ds, a, c);
+    civ_relation_id_t dst = civ_diplomacy_relation_between(ds, b, c);
+#define COPY_COLUMN(f) ds->rel.f[dst] = ds->rel.f[src];
+    RELATION_COLUMNS(COPY_COLUMN)
+#undef COPY_COLUMN
+    activate(ds, dst);
+  }
+}
+
+/* ---- Save section ---- */
+
+/* Leads a v2/v3 section; a v1 section starts with its record count instead */
+#define DIPLOMACY_TABLE_MARK    0xD1A7AB1Eu
+#define DIPLOMACY_TABLE_MARK_V3 0xD1A7AB1Fu /* treaties carry days_left */
+
+/* v1 record: one per ordered pair, found by name */
+typedef struct {
+  char nation_a[STRING_SHORT_LEN];
+  char nation_b[STRING_SHORT_LEN];
+  civ_relation_level_t relation_level;
+  civ_ai_stance_t current_stance;
+  civ_float_t trust;
+  civ_float_t opinion_score;
+  civ_personality_type_t personality;
+  civ_float_t grievances;
+  char primary_casus_belli[STRING_MEDIUM_LEN];
+  time_t last_updated;
+} legacy_relation_t;
+
+static void diplomacy_put(const civ_diplomacy_system_t *ds,
+                          civ_ser_cursor_t *c) {
+  uint32_t mark = DIPLOMACY_TABLE_MARK_V3;
+  uint32_t count = (uint32_t)ds->nation_count;
+  CIV_SER_PUT(c, mark);
+  CIV_SER_PUT(c, count);
+  civ_ser_put(c, ds->nation_ids, ds->nation_count * sizeof(*ds->nation_ids));
+#define PUT_COLUMN(f)                                                          \
+  civ_ser_put(c, ds->rel.f, ds->relation_count * sizeof(*ds->rel.f));
+  RELATION_COLUMNS(PUT_COLUMN)
+#undef PUT_COLUMN
+  count = (uint32_t)ds->casus_belli_count;
+  CIV_SER_PUT(c, count);
+  civ_ser_put(c, ds->casus_belli_text,
+              ds->casus_belli_count * sizeof(*ds->casus_belli_text));
+
+  count = (uint32_t)ds->treaty_count;
+  CIV_SER_PUT(c, count);
+  for (size_t i = 0; i < ds->treaty_count; i++) {
+    const civ_treaty_t *t = &ds->treaties[i];
+    int32_t type = (int32_t)t->treaty_type;
+    int64_t start = (int64_t)t->start_date;
+    uint8_t active = t->active ? 1 : 0;
+    uint32_t signatories = (uint32_t)t->signatory_count;
+    civ_float_t days_left = civ_diplomacy_treaty_days_left(ds, i);
+    civ_ser_put(c, t->treaty_id, sizeof(t->treaty_id));
+    CIV_SER_PUT(c, type);
+    CIV_SER_PUT(c, start);
+    CIV_SER_PUT(c, t->duration_days);
+    CIV_SER_PUT(c, active);
+    CIV_SER_PUT(c, days_left);
+    CIV_SER_PUT(c, signatories);
+    for (size_t j = 0; j < t->signatory_count; j++) {
+      uint16_t len = (uint16_t)strlen(t->signatories[j]);
+      CIV_SER_PUT(c, len);
+      civ_ser_put(c, t->signatories[j], len);
+    }
+  }
+}
+
+static civ_result_t diplomacy_serialize(const void *object, char *buffer,
+                                        size_t buffer_size, size_t *written) {
+  civ_ser_cursor_t c = civ_ser_cursor(buffer, buffer_size);
+  diplomacy_put((const civ_diplomacy_system_t *)object, &c);
+  if (written) *written = c.pos;
+  return c.overflow ? (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Buffer too small"}
+                    : (civ_result_t){CIV_OK, NULL};
+}
+
+static size_t diplomacy_serialized_size(const void *object) {
+  civ_ser_cursor_t c = civ_ser_cursor(NULL, 0);
+  diplomacy_put((const civ_diplomacy_system_t *)object, &c);
+  return c.pos;
+}
+
+static bool read_relation_table(civ_diplomacy_system_t *t,
+                                civ_ser_cursor_t *c) {
+  uint32_t nations = 0, texts = 0;
+  if (!CIV_SER_GET(c, nations) ||
+      (size_t)nations * STRING_SHORT_LEN > c->size - c->pos ||
+      !alloc_relation_table(t, nations))
+    return false;
+  civ_ser_get(c, t->nation_ids, nations * sizeof(*t->nation_ids));
+  for (size_t i = 0; i < nations; i++) {
+    t->nation_ids[i][STRING_SHORT_LEN - 1] = '\0';
+    index_nation(t, i);
+  }
+#define GET_COLUMN(f) civ_ser_get(c, t->rel.f, t->relation_count * sizeof(*t->rel.f));
+  RELATION_COLUMNS(GET_COLUMN)
+#undef GET_COLUMN
+  if (!CIV_SER_GET(c, texts) ||
+      (size_t)texts * STRING_MEDIUM_LEN > c->size - c->pos)
+    return false;
+  if (texts) {
+    t->casus_belli_text = CIV_CALLOC(texts, sizeof(*t->casus_belli_text));
+    if (!t->casus_belli_text)
+      return false;
+    civ_ser_get(c, t->casus_belli_text, texts * sizeof(*t->casus_belli_text));
+    for (size_t i = 0; i < texts; i++)
+      t->casus_belli_text[i][STRING_MEDIUM_LEN - 1] = '\0';
+  }
+  t->casus_belli_count = texts;
+  for (size_t k = 0; k < t->relation_count; k++)
+    if (t->rel.casus_belli[k] >= (int32_t)texts)
+      t->rel.casus_belli[k] = -1;
+  return !c->overflow;
+}
+
+/* v1 directed records into the table; the first record of a pair wins, as
+   lookups used to return it */
+static bool read_legacy_relations(civ_diplomacy_system_t *t,
+                                  civ_ser_cursor_t *c, uint32_t count) {
+  if ((size_t)count * sizeof(legacy_relation_t) > c->size - c->pos)
+    return false;
+  const uint8_t *recs = c->data + c->pos; /* not aligned for the struct */
+  c->pos += (size_t)count * sizeof(legacy_relation_t);
+
+  /* Nation ids in order of first appearance */
+  char(*ids)[STRING_SHORT_LEN] =
+      CIV_CALLOC(count ? (size_t)count * 2 : 1, STRING_SHORT_LEN);
+  if (!ids)
+    return false;
+  size_t nations = 0;
+  for (uint32_t r = 0; r < count; r++) {
+    const uint8_t *rec = recs + (size_t)r * sizeof(legacy_relation_t);
+    const char *pair[2] = {
+        (const char *)rec + offsetof(legacy_relation_t, nation_a),
+        (const char *)rec + offsetof(legacy_relation_t, nation_b)};
+    for (int e = 0; e < 2; e++) {
+      size_t i = 0;
+      while (i < nations && strncmp(ids[i], pair[e], STRING_SHORT_LEN - 1) != 0)
+        i++;
+      if (i == nations)
+        snprintf(ids[nations++], STRING_SHORT_LEN, "%.*s",
+                 STRING_SHORT_LEN - 1, pair[e]);
+    }
+  }
+  bool ok = alloc_relation_table(t, nations);
+  if (ok) {
+    memcpy(t->nation_ids, ids, nations * STRING_SHORT_LEN);
+    for (size_t i = 0; i < nations; i++)
+      index_nation(t, i);
+    uint8_t *seen = CIV_CALLOC(t->relation_count ? t->relation_count : 1, 1);
+    ok = seen != NULL;
+    for (uint32_t r = 0; ok && r < count; r++) {
+      legacy_relation_t rec;
+      memcpy(&rec, recs + (size_t)r * sizeof(rec), sizeof(rec));
+      rec.nation_a[STRING_SHORT_LEN - 1] = rec.nation_b[STRING_SHORT_LEN - 1] = '\0';
+      civ_relation_id_t id = civ_diplomacy_relation_id(t, rec.nation_a, rec.nation_b);
+      if (id == CIV_RELATION_NONE || seen[id])
+        continue;
+      seen[id] = 1;
+      t->rel.relation_level[id] = (int8_t)rec.relation_level;
+      t->rel.current_stance[id] = (uint8_t)rec.current_stance;
+      t->rel.trust[id] = rec.trust;
+      t->rel.opinion_score[id] = rec.opinion_score;
+      t->rel.personality[id] = (uint8_t)rec.personality;
+      t->rel.grievances[id] = rec.grievances;
+      rec.primary_casus_belli[STRING_MEDIUM_LEN - 1] = '\0';
+      t->rel.casus_belli[id] =
+          rec.primary_casus_belli[0] ? intern_casus_belli(t, rec.primary_casus_belli) : -1;
+      t->rel.last_updated[id] = rec.last_updated;
+    }
+    /* Pairs without a record start neutral */
+    for (size_t k = 0; ok && k < t->relation_count; k++)
+      if (!seen[k]) {
+        t->rel.relation_level[k] = CIV_RELATION_LEVEL_NEUTRAL;
+        t->rel.trust[k] = 0.5f;
+        t->rel.casus_belli[k] = -1;
+      }
+    CIV_FREE(seen);
+  }
+  CIV_FREE(ids);
+  return ok;
+}
+
+/* Parsed into fresh arrays, so a damaged section leaves the system as is */
+static civ_result_t diplomacy_deserialize(void *object, const char *buffer,
+                                          size_t buffer_size) {
+  civ_diplomacy_system_t *ds = (civ_diplomacy_system_t *)object;
+  civ_ser_cursor_t c = civ_ser_cursor((void *)buffer, buffer_size);
+  uint32_t mark = 0, treaty_count = 0;
+  civ_diplomacy_system_t fresh;
+  memset(&fresh, 0, sizeof(fresh));
+  bool ok = CIV_SER_GET(&c, mark) &&
+            (mark == DIPLOMACY_TABLE_MARK || mark == DIPLOMACY_TABLE_MARK_V3
+                 ? read_relation_table(&fresh, &c)
+                 : read_legacy_relations(&fresh, &c, mark));
+  if (!ok) {
+    free_relation_table(&fresh);
+    return (civ_result_t){CIV_ERROR_INVALID_DATA, "Diplomacy section size"};
+  }
+
+  CIV_SER_GET(&c, treaty_count);
+  size_t treaty_cap = MAX((size_t)treaty_count, (size_t)50);
+  civ_treaty_t *treaties =
+      c.overflow || treaty_count > buffer_size
+          ? NULL
+          : (civ_treaty_t *)CIV_CALLOC(treaty_cap, sizeof(civ_treaty_t));
+  size_t parsed = 0;
+  for (; treaties && parsed < treaty_count && !c.overflow; parsed++) {
+    civ_treaty_t *t = &treaties[parsed];
+    int32_t type = 0;
+    int64_t start = 0;
+    uint8_t active = 0;
+    uint32_t signatories = 0;
+    civ_ser_get(&c, t->treaty_id, sizeof(t->treaty_id));
+    t->treaty_id[sizeof(t->treaty_id) - 1] = '\0';
+    CIV_SER_GET(&c, type);
+    CIV_SER_GET(&c, start);
+    CIV_SER_GET(&c, t->duration_days);
+    CIV_SER_GET(&c, active);
+    if (mark == DIPLOMACY_TABLE_MARK_V3)
+      CIV_SER_GET(&c, t->days_left);
+    else
+      t->days_left = (civ_float_t)t->duration_days;
+    if (!CIV_SER_GET(&c, signatories) || signatories > buffer_size)
+      break;
+    t->treaty_type = (civ_treaty_type_t)type;
+    t->start_date = (time_t)start;
+    t->active = active != 0;
+    t->signatories = (char **)CIV_CALLOC(signatories ? signatories : 1,
+                                         sizeof(char *));
+    if (!t->signatories)
+      break;
+    for (uint32_t j = 0; j < signatories; j++) {
+      uint16_t len = 0;
+      if (!CIV_SER_GET(&c, len))
+        break;
+      char *name = alloc_name(ds, (size_t)len + 1);
+      if (!name || !civ_ser_get(&c, name, len)) {
+        free_name(ds, name);
+        c.overflow = true;
+        break;
+      }
+      name[len] = '\0';
+      t->signatories[t->signatory_count++] = name;
+    }
+  }
+  if (!treaties || c.overflow || parsed < treaty_count) {
+    free_treaties(ds, treaties, MIN(parsed + 1, (size_t)treaty_count));
+    free_relation_table(&fresh);
+    return (civ_result_t){CIV_ERROR_INVALID_DATA, "Diplomacy section damaged"};
+  }
+
+  move_relation_table(ds, &fresh);
+  free_treaties(ds, ds->treaties, ds->treaty_count);
+  ds->treaties = treaties;
+  ds->treaty_count = treaty_count;
+  ds->treaty_capacity = treaty_cap;
+  rebuild_indexes(ds);
+  civ_timing_wheel_free(&ds->expiry);
+  for (size_t i = 0; i < ds->treaty_count; i++)
+    schedule_expiry(ds, i);
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+civ_serializable_t civ_diplomacy_system_serializable(civ_diplomacy_system_t *ds) {
+  return (civ_serializable_t){ds, diplomacy_serialize, diplomacy_deserialize,
+                              diplomacy_serialized_size};
 }
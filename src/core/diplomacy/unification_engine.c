@@ -9,42 +9,183 @@
 #include <stdio.h>
 #include <string.h>
 
+/* Trust a relation needs before either side will hear of a union */
+#define UNIFICATION_MIN_TRUST 0.75f
 
-civ_merge_result_t
-civ_unification_propose_merger(const char *nation_a, const char *nation_b,
-                               civ_unification_stage_t goal) {
-  civ_merge_result_t result;
-  memset(&result, 0, sizeof(civ_merge_result_t));
-
-  /* Simple logic: Success if both names are valid */
-  if (nation_a && nation_b) {
-    result.success = true;
-    result.stage = goal;
-    snprintf(result.new_national_name, STRING_MEDIUM_LEN - 1,
-             "The United Commonwealth of %s-%s", nation_a, nation_b);
-    result.stability_impact = 0.1f; /* Small boost for unity */
-  } else {
-    result.success = false;
+/* ── Merges and secessions ─────────────────────────────────────────── */
+
+static void record_change(civ_unification_change_t *out,
+                          const civ_nation_manager_t *nations, int nation,
+                          int other, const civ_nation_transfer_t *moved,
+                          const civ_diplomacy_merge_t *treaties) {
+  if (!out) return;
+  out->nation = nation;
+  out->other = other;
+  out->tiles = moved->tiles;
+  out->population = moved->population;
+  out->min_x = moved->min_x;
+  out->min_y = moved->min_y;
+  out->max_x = moved->max_x;
+  out->max_y = moved->max_y;
+  out->treaties_rewritten = treaties ? treaties->rewritten : 0;
+  out->treaties_dissolved = treaties ? treaties->dissolved : 0;
+  out->political_revision = nations->political_revision;
+}
+
+civ_result_t civ_unification_merge_nations(civ_nation_manager_t *nations,
+                                           civ_map_t *map,
+                                           civ_diplomacy_system_t *diplomacy,
+                                           int into, int from,
+                                           civ_unification_change_t *out) {
+  if (out) memset(out, 0, sizeof(*out));
+  if (!nations || !map) return (civ_result_t){CIV_ERROR_NULL_POINTER, NULL};
+  if (into < 0 || from < 0 || into >= nations->count || from >= nations->count)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "No such nation"};
+
+  /* Both ids must be in the table before anything moves */
+  char into_id[CIV_NATION_ID_MAX], from_id[CIV_NATION_ID_MAX];
+  snprintf(into_id, sizeof(into_id), "%s", nations->nations[into].id);
+  snprintf(from_id, sizeof(from_id), "%s", nations->nations[from].id);
+  bool related = diplomacy && civ_diplomacy_nation_index(diplomacy, into_id) >= 0 &&
+                 civ_diplomacy_nation_index(diplomacy, from_id) >= 0;
+  int64_t a = MAX(nations->nations[into].population, 0);
+  int64_t b = MAX(nations->nations[from].population, 0);
+  civ_float_t weight = a + b > 0 ? (civ_float_t)b / (civ_float_t)(a + b) : 0.5;
+
+  civ_nation_transfer_t moved;
+  civ_result_t result = civ_nation_manager_absorb(nations, map, into, from, &moved);
+  if (result.error != CIV_OK) return result;
+
+  civ_diplomacy_merge_t treaties = {0, 0};
+  if (related) civ_diplomacy_merge_nations(diplomacy, into_id, from_id, weight, &treaties);
+  record_change(out, nations, into, from, &moved, &treaties);
+  civ_log(CIV_LOG_INFO,
+          "%s absorbed %s: %d tiles, %lld people, %zu treaties carried over, %zu ended",
+          nations->nations[into].name, nations->nations[from].name, moved.tiles,
+          (long long)moved.population, treaties.rewritten, treaties.dissolved);
+  return result;
+}
+
+int civ_unification_split_nation(civ_nation_manager_t *nations, civ_map_t *map,
+                                 civ_diplomacy_system_t *diplomacy, int from,
+                                 uint32_t subdivision_mask, const char *id,
+                                 const char *name, uint32_t color, int level,
+                                 civ_unification_change_t *out) {
+  if (out) memset(out, 0, sizeof(*out));
+  if (!nations || !map || !id || from < 0 || from >= nations->count) return -1;
+  char parent_id[CIV_NATION_ID_MAX];
+  snprintf(parent_id, sizeof(parent_id), "%s", nations->nations[from].id);
+
+  /* Room in the relation table first; a secession refused after this
+     leaves only an unused neutral entry */
+  bool related = diplomacy && civ_diplomacy_nation_index(diplomacy, parent_id) >= 0;
+  if (related && civ_diplomacy_add_nation(diplomacy, id) < 0) return -1;
+
+  civ_nation_transfer_t moved;
+  int ni = civ_nation_manager_secede(nations, map, from, subdivision_mask, id,
+                                     name, color, &moved);
+  if (ni < 0) return -1;
+
+  if (related) {
+    civ_diplomacy_copy_relations(diplomacy, parent_id, id);
+    civ_relation_id_t pair = civ_diplomacy_relation_id(diplomacy, parent_id, id);
+    if (pair != CIV_RELATION_NONE) {
+      diplomacy->rel.relation_level[pair] =
+          (int8_t)CLAMP(level, CIV_RELATION_LEVEL_WAR, CIV_RELATION_LEVEL_ALLIED);
+      civ_diplomacy_touch_relation(diplomacy, pair);
+    }
   }
+  record_change(out, nations, ni, from, &moved, NULL);
+  civ_log(CIV_LOG_INFO, "%s seceded from %s: %d tiles, %lld people",
+          nations->nations[ni].name, nations->nations[from].name, moved.tiles,
+          (long long)moved.population);
+  return ni;
+}
+
+/* ── Negotiated unions ─────────────────────────────────────────────── */
+
+static bool live_pair(const civ_nation_manager_t *nations, int a, int b) {
+  return nations && a >= 0 && b >= 0 && a < nations->count && b < nations->count &&
+         a != b && !nations->nations[a].defunct && !nations->nations[b].defunct;
+}
 
-  civ_log(CIV_LOG_INFO, "Merger proposal between %s and %s: %s", nation_a,
-          nation_b, result.success ? "ACCEPTED" : "REJECTED");
+civ_result_t civ_unification_merge_economies(civ_nation_manager_t *nations,
+                                             civ_diplomacy_system_t *diplomacy,
+                                             int a, int b) {
+  if (!nations || !diplomacy) return (civ_result_t){CIV_ERROR_NULL_POINTER, NULL};
+  if (!live_pair(nations, a, b))
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "No such pair of nations"};
+  civ_result_t result = civ_diplomacy_system_propose_treaty(
+      diplomacy, nations->nations[a].id, nations->nations[b].id,
+      CIV_TREATY_TYPE_TRADE_AGREEMENT, -1);
+  if (result.error == CIV_OK)
+    civ_log(CIV_LOG_INFO, "Markets of %s and %s merged into a single trade bloc",
+            nations->nations[a].name, nations->nations[b].name);
   return result;
 }
 
-civ_result_t civ_unification_merge_economies(const char *nation_a,
-                                             const char *nation_b) {
-  civ_log(CIV_LOG_INFO,
-          "Merging markets of %s and %s into a single trade bloc.", nation_a,
-          nation_b);
+civ_result_t civ_unification_create_shared_currency(civ_nation_manager_t *nations,
+                                                    const char *name, int a, int b) {
+  if (!nations || !name) return (civ_result_t){CIV_ERROR_NULL_POINTER, NULL};
+  if (!live_pair(nations, a, b))
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "No such pair of nations"};
+  civ_nation_t *na = &nations->nations[a], *nb = &nations->nations[b];
+  int64_t pa = MAX(na->population, 0), pb = MAX(nb->population, 0);
+  float weight = pa + pb > 0 ? (float)((double)pb / (double)(pa + pb)) : 0.5f;
+  float level = na->cost_of_living + (nb->cost_of_living - na->cost_of_living) * weight;
+  na->cost_of_living = nb->cost_of_living = level;
+  civ_log(CIV_LOG_INFO, "New shared currency '%s' established between %s and %s",
+          name, na->name, nb->name);
   return (civ_result_t){CIV_OK, NULL};
 }
 
-civ_result_t civ_unification_create_shared_currency(const char *name,
-                                                    const char *nation_a,
-                                                    const char *nation_b) {
-  civ_log(CIV_LOG_INFO,
-          "New shared currency '%s' established between %s and %s.", name,
-          nation_a, nation_b);
-  return (civ_result_t){CIV_OK, NULL};
+civ_merge_result_t civ_unification_propose_merger(civ_nation_manager_t *nations,
+                                                  civ_map_t *map,
+                                                  civ_diplomacy_system_t *diplomacy,
+                                                  int into, int from,
+                                                  civ_unification_stage_t goal,
+                                                  civ_unification_change_t *out) {
+  civ_merge_result_t result;
+  memset(&result, 0, sizeof(result));
+  if (out) memset(out, 0, sizeof(*out));
+  result.stage = goal;
+  if (!live_pair(nations, into, from) || !map || !diplomacy) return result;
+  civ_nation_t *a = &nations->nations[into], *b = &nations->nations[from];
+
+  /* Closer unions need closer friends */
+  civ_relation_id_t pair = civ_diplomacy_relation_id(diplomacy, a->id, b->id);
+  int needed = goal >= CIV_UNIFY_POLITICAL_FEDERATION ? CIV_RELATION_LEVEL_ALLIED
+                                                      : CIV_RELATION_LEVEL_FRIENDLY;
+  bool willing = pair != CIV_RELATION_NONE &&
+                 diplomacy->rel.relation_level[pair] >= needed &&
+                 diplomacy->rel.trust[pair] >= UNIFICATION_MIN_TRUST;
+  char united[STRING_MEDIUM_LEN];
+  snprintf(united, sizeof(united), "The United Commonwealth of %s-%s", a->name, b->name);
+
+  civ_result_t done = {CIV_ERROR_INVALID_STATE, "Merger rejected"};
+  if (willing) {
+    switch (goal) {
+    case CIV_UNIFY_MARKET_INTEGRATION:
+      done = civ_unification_merge_economies(nations, diplomacy, into, from);
+      break;
+    case CIV_UNIFY_CURRENCY_UNION:
+      done = civ_unification_create_shared_currency(nations, united, into, from);
+      break;
+    case CIV_UNIFY_POLITICAL_FEDERATION:
+    case CIV_UNIFY_TOTAL_ABSORPTION:
+      done = civ_unification_merge_nations(nations, map, diplomacy, into, from, out);
+      break;
+    }
+  }
+
+  result.success = done.error == CIV_OK;
+  if (result.success) {
+    snprintf(result.new_national_name, sizeof(result.new_national_name), "%s",
+             goal >= CIV_UNIFY_POLITICAL_FEDERATION ? united : nations->nations[into].name);
+    result.stability_impact = 0.1f; /* Small boost for unity */
+  }
+  civ_log(CIV_LOG_INFO, "Merger proposal between %s and %s: %s",
+          nations->nations[into].name, nations->nations[from].name,
+          result.success ? "ACCEPTED" : "REJECTED");
+  return result;
 }
@@ -47,17 +47,18 @@ void civ_agriculture_update(civ_agriculture_system_t *a, civ_float_t time_delta,
   /* Fertilizer tech ramps with overall tech */
   a->fertilizer_tech = 1.0 + tech_level * 0.5;
 
-  /* Seasonal yield multiplier */
+  /* Seasonal yield multiplier; the climate's growing peaks at the summer
+     table's 1.2 */
   civ_float_t season_mult[] = { 0.8, 1.2, 1.1, 0.3 };
-  int s = (int)a->season;
+  civ_float_t season_factor = a->has_climate ? a->climate_yield * 1.2 : season_mult[(int)a->season];
 
   /* Crop yield: area * fertility * water * irrigation * fertilizer * season * climate */
   a->crop_yield = a->arable_land_km2 * a->soil_fertility * (0.5 + a->water_availability * 0.5)
                   * (1.0 + a->irrigation_level) * a->fertilizer_tech
-                  * season_mult[s] * climate_modifier * 2.0;
+                  * season_factor * climate_modifier * 2.0;
 
   /* Livestock: fraction of arable land */
-  a->livestock_output = a->arable_land_km2 * 0.3 * a->soil_fertility * season_mult[s] * 0.8;
+  a->livestock_output = a->arable_land_km2 * 0.3 * a->soil_fertility * season_factor * 0.8;
 
   /* Total food (kcal equivalent from tons) */
   a->food_production = (a->crop_yield + a->livestock_output) * 800.0;
@@ -70,6 +71,18 @@ void civ_agriculture_update(civ_agriculture_system_t *a, civ_float_t time_delta,
   /* Famine risk: when production < 70% of needs */
   civ_float_t ratio = (a->food_consumption > 0) ? a->food_production / a->food_consumption : 1.0;
   a->famine_risk = (ratio < 0.7) ? (1.0 - ratio / 0.7) : 0.0;
+
+  /* Lean months leave little to carry the year through a bad one */
+  if (a->has_climate && a->lean_months > 0)
+    a->famine_risk = MIN(a->famine_risk + a->lean_months / 12.0 * 0.2, 1.0);
+}
+
+void civ_agriculture_set_climate(civ_agriculture_system_t *a, civ_float_t yield,
+                                 int lean_months) {
+  if (!a) return;
+  a->climate_yield = CLAMP(yield, 0.0, 1.0);
+  a->lean_months = CLAMP(lean_months, 0, 12);
+  a->has_climate = true;
 }
 
 civ_float_t civ_agriculture_food_security(const civ_agriculture_system_t *a) {
@@ -4,6 +4,7 @@
  */
 #include "core/economy/banking.h"
 #include "common.h"
+#include "utils/rng.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
@@ -13,6 +14,12 @@
 #define CIV_BANKING_RESERVE_CEILING  0.25
 #define CIV_BANKING_RATE_FLOOR       0.001
 #define CIV_BANKING_RATE_CEILING     0.35
+#define CIV_BANKING_NORMAL_DEFAULTS  30.0  /* expected defaults past which a
+                                              cohort's draw is a normal */
+
+/* Monthly default chance per risk tier, before the system default rate */
+static const civ_float_t tier_default_chance[CIV_LOAN_RISK_COUNT] = {
+    0.002, 0.01, 0.03, 0.08};
 
 civ_banking_system_t *civ_banking_create(void) {
   civ_banking_system_t *b = CIV_MALLOC(sizeof(civ_banking_system_t));
@@ -29,7 +36,7 @@ civ_banking_system_t *civ_banking_create(void) {
   b->loan_capacity = CIV_BANKING_INITIAL_LOAN_CAP;
   b->loans = CIV_MALLOC(sizeof(civ_loan_t) * b->loan_capacity);
   if (!b->loans) {
-    free(b);
+    CIV_FREE(b);
     return NULL;
   }
   return b;
@@ -37,8 +44,9 @@ civ_banking_system_t *civ_banking_create(void) {
 
 void civ_banking_destroy(civ_banking_system_t *b) {
   if (!b) return;
-  free(b->loans);
-  free(b);
+  CIV_FREE(b->loans);
+  CIV_FREE(b->cohorts);
+  CIV_FREE(b);
 }
 
 /* --- Update: everything responds to macro conditions --- */
@@ -105,6 +113,69 @@ void civ_banking_update(civ_banking_system_t *b,
   civ_banking_repay_loans(b, time_delta);
 }
 
+/* Risk tier of a new loan, by its size against the money supply */
+static civ_loan_risk_t loan_risk(const civ_banking_system_t *b,
+                                 civ_float_t amount) {
+  return (amount > b->money_supply * 0.001)  ? CIV_LOAN_RISK_HIGH :
+         (amount > b->money_supply * 0.0001) ? CIV_LOAN_RISK_MEDIUM :
+         CIV_LOAN_RISK_LOW;
+}
+
+/* Level payment per unit of principal over term months */
+static civ_float_t annuity_factor(civ_float_t rate, int term_months) {
+  if (rate > 0.0) {
+    civ_float_t monthly_rate = rate / 12.0;
+    civ_float_t denom = 1.0 - pow(1.0 + monthly_rate, (civ_float_t)(-term_months));
+    if (denom > 0.0) return monthly_rate / denom;
+  }
+  return 1.0 / (civ_float_t)term_months;
+}
+
+/* Outstanding fraction of an annuity's principal after paid payments */
+static civ_float_t balance_factor(civ_float_t rate, int term_months, int paid) {
+  if (paid >= term_months) return 0.0;
+  if (rate > 0.0) {
+    civ_float_t g = 1.0 + rate / 12.0;
+    civ_float_t gn = pow(g, (civ_float_t)term_months);
+    if (gn > 1.0) return (gn - pow(g, (civ_float_t)paid)) / (gn - 1.0);
+  }
+  return 1.0 - (civ_float_t)paid / (civ_float_t)term_months;
+}
+
+static civ_float_t default_chance(const civ_banking_system_t *b,
+                                  civ_loan_risk_t risk) {
+  int idx = CLAMP((int)risk, 0, CIV_LOAN_RISK_COUNT - 1);
+  return tier_default_chance[idx] + b->default_rate * 0.1;
+}
+
+/* Uniform in (0, 1) */
+static double draw_unit(civ_rng_t *rng) {
+  return ((double)civ_rng_next_u32(rng) + 0.5) / 4294967296.0;
+}
+
+/* Defaults among n loans at chance p: an inversion walk of the binomial
+   distribution while few are expected, a rounded normal past that */
+static int32_t draw_defaults(civ_rng_t *rng, int32_t n, double p) {
+  if (n <= 0 || p <= 0.0) return 0;
+  if (p >= 1.0) return n;
+  double mean = (double)n * p;
+  if (mean < CIV_BANKING_NORMAL_DEFAULTS) {
+    double q = 1.0 - p, ratio = p / q;
+    double pmf = pow(q, (double)n), cdf = pmf, u = draw_unit(rng);
+    int32_t k = 0;
+    while (u > cdf && k < n) {
+      pmf *= ratio * (double)(n - k) / (double)(k + 1);
+      cdf += pmf;
+      k++;
+    }
+    return k;
+  }
+  double u1 = draw_unit(rng), u2 = draw_unit(rng);
+  double z = sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+  double k = floor(mean + z * sqrt(mean * (1.0 - p)) + 0.5);
+  return (int32_t)CLAMP(k, 0.0, (double)n);
+}
+
 civ_loan_t *civ_banking_issue_loan(civ_banking_system_t *b,
                                    const char *borrower_id,
                                    civ_float_t amount,
@@ -123,8 +194,9 @@ civ_loan_t *civ_banking_issue_loan(civ_banking_system_t *b,
   civ_loan_t *loan = &b->loans[b->loan_count];
   memset(loan, 0, sizeof(*loan));
 
-  /* Loan ID from count */
-  snprintf(loan->id, STRING_SHORT_LEN, "LOAN_%d", b->loan_count);
+  /* Ids stay unique as closed loans are compacted away */
+  loan->serial = b->loans_issued++;
+  snprintf(loan->id, STRING_SHORT_LEN, "LOAN_%u", loan->serial);
   strncpy(loan->borrower_id, borrower_id, STRING_SHORT_LEN - 1);
 
   loan->principal    = amount;
@@ -134,67 +206,129 @@ civ_loan_t *civ_banking_issue_loan(civ_banking_system_t *b,
   loan->performing   = true;
 
   /* Interest rate scales with base rate + risk premium */
-  loan->risk_tier = (amount > b->money_supply * 0.001) ? CIV_LOAN_RISK_HIGH :
-                    (amount > b->money_supply * 0.0001) ? CIV_LOAN_RISK_MEDIUM :
-                    CIV_LOAN_RISK_LOW;
-
+  loan->risk_tier = loan_risk(b, amount);
   loan->interest_rate = civ_banking_get_lending_rate(b, loan->risk_tier);
-
-  /* Monthly payment (amortized) */
-  if (loan->interest_rate > 0.0 && term_months > 0) {
-    civ_float_t monthly_rate = loan->interest_rate / 12.0;
-    civ_float_t denom = 1.0 - pow(1.0 + monthly_rate, (civ_float_t)(-term_months));
-    if (denom > 0.0)
-      loan->monthly_payment = amount * monthly_rate / denom;
-    else
-      loan->monthly_payment = amount / (civ_float_t)term_months;
-  } else {
-    loan->monthly_payment = amount / (civ_float_t)term_months;
-  }
+  loan->monthly_payment = amount * annuity_factor(loan->interest_rate, term_months);
 
   b->lending_volume += amount;
   b->loan_count++;
   return loan;
 }
 
+bool civ_banking_lend(civ_banking_system_t *b, civ_float_t amount,
+                      int term_months) {
+  if (!b || amount <= 0 || term_months <= 0) return false;
+  civ_loan_risk_t risk = loan_risk(b, amount);
+
+  /* This cycle's cohorts are the newest, at the end */
+  civ_loan_cohort_t *c = NULL;
+  for (int i = b->cohort_count - 1;
+       i >= 0 && b->cohorts[i].vintage == b->cycle; i--) {
+    if (b->cohorts[i].risk_tier == risk &&
+        b->cohorts[i].term_months == term_months) {
+      c = &b->cohorts[i];
+      break;
+    }
+  }
+  if (!c) {
+    if (b->cohort_count >= b->cohort_capacity) {
+      int new_cap = b->cohort_capacity ? b->cohort_capacity * 2 : 16;
+      civ_loan_cohort_t *tmp =
+          CIV_REALLOC(b->cohorts, sizeof(civ_loan_cohort_t) * new_cap);
+      if (!tmp) return false;
+      b->cohorts = tmp;
+      b->cohort_capacity = new_cap;
+    }
+    c = &b->cohorts[b->cohort_count++];
+    memset(c, 0, sizeof(*c));
+    c->risk_tier = risk;
+    c->vintage = b->cycle;
+    c->term_months = term_months;
+    c->interest_rate = civ_banking_get_lending_rate(b, risk);
+  }
+  c->performing++;
+  c->principal += amount;
+  c->balance += amount;
+  c->monthly_payment += amount * annuity_factor(c->interest_rate, term_months);
+  b->lending_volume += amount;
+  return true;
+}
+
+/* One month of a cohort: write off its defaults, then take a payment */
+static void cohort_step(civ_banking_system_t *b, civ_loan_cohort_t *c) {
+  civ_rng_t rng;
+  civ_rng_seed_key(&rng, b->rng_seed, CIV_RNG_BANKING, (uint64_t)b->cycle,
+                   ((uint64_t)(uint32_t)c->vintage << 24) |
+                       ((uint64_t)(c->term_months & 0xFFFFF) << 4) |
+                       (uint64_t)c->risk_tier);
+  int32_t k = draw_defaults(&rng, c->performing,
+                            (double)default_chance(b, c->risk_tier));
+  if (k > 0) {
+    civ_float_t kept = (civ_float_t)(c->performing - k) / (civ_float_t)c->performing;
+    c->principal *= kept;
+    c->monthly_payment *= kept;
+    c->performing -= k;
+    c->defaulted += k;
+  }
+  if (c->performing == 0) {
+    c->balance = 0;
+    return;
+  }
+  c->months_elapsed++;
+  c->balance = c->principal *
+               balance_factor(c->interest_rate, c->term_months, c->months_elapsed);
+}
+
+/* One month of an individual loan, drawn from its own stream */
+static void loan_step(civ_banking_system_t *b, civ_loan_t *loan) {
+  civ_rng_t rng;
+  civ_rng_seed_key(&rng, b->rng_seed, CIV_RNG_BANKING, (uint64_t)b->cycle,
+                   (1ull << 63) | loan->serial);
+  if (draw_unit(&rng) < default_chance(b, loan->risk_tier)) {
+    loan->performing = false;
+    return;
+  }
+  loan->months_remaining--;
+  loan->remaining = loan->principal *
+                    balance_factor(loan->interest_rate, loan->term_months,
+                                   loan->term_months - loan->months_remaining);
+  if (loan->remaining <= 0 || loan->months_remaining <= 0) {
+    loan->remaining = 0;
+    loan->months_remaining = 0;
+  }
+}
+
 void civ_banking_repay_loans(civ_banking_system_t *b, civ_float_t time_delta) {
   if (!b) return;
   (void)time_delta;
 
+  /* Each call is one monthly cycle; closed loans and cohorts are dropped
+     in place, keeping the rest in order */
+  civ_float_t outstanding = 0.0;
+  int kept = 0;
   for (int i = 0; i < b->loan_count; i++) {
     civ_loan_t *loan = &b->loans[i];
+    if (loan->performing && loan->remaining > 0) loan_step(b, loan);
     if (!loan->performing || loan->remaining <= 0) continue;
-
-    /* Check for default based on risk tier */
-    civ_float_t default_chance = 0.0;
-    switch (loan->risk_tier) {
-      case CIV_LOAN_RISK_LOW:      default_chance = 0.002; break;
-      case CIV_LOAN_RISK_MEDIUM:   default_chance = 0.01;  break;
-      case CIV_LOAN_RISK_HIGH:     default_chance = 0.03;  break;
-      case CIV_LOAN_RISK_PREDATORY: default_chance = 0.08;  break;
-      default: break;
-    }
-
-    /* Default chance scales with banking system default rate */
-    default_chance += b->default_rate * 0.1;
-
-    civ_float_t roll = (civ_float_t)rand() / (civ_float_t)RAND_MAX;
-    if (roll < default_chance) {
-      loan->performing = false;
-      b->lending_volume -= loan->remaining;
-      continue;
-    }
-
-    /* Pay down principal */
-    loan->remaining -= loan->monthly_payment;
-    loan->months_remaining--;
-    b->lending_volume -= loan->monthly_payment;
-
-    if (loan->remaining <= 0 || loan->months_remaining <= 0) {
-      loan->remaining = 0;
-      loan->months_remaining = 0;
-    }
+    outstanding += loan->remaining;
+    if (kept != i) b->loans[kept] = *loan;
+    kept++;
   }
+  b->loan_count = kept;
+
+  kept = 0;
+  for (int i = 0; i < b->cohort_count; i++) {
+    civ_loan_cohort_t *c = &b->cohorts[i];
+    cohort_step(b, c);
+    if (c->performing == 0 || c->balance <= 0) continue;
+    outstanding += c->balance;
+    if (kept != i) b->cohorts[kept] = *c;
+    kept++;
+  }
+  b->cohort_count = kept;
+
+  b->lending_volume = outstanding;
+  b->cycle++;
 }
 
 civ_float_t civ_banking_credit_available(const civ_banking_system_t *b) {
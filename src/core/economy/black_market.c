@@ -29,7 +29,6 @@ void civ_black_market_update(civ_black_market_system_t *b, civ_float_t time_delt
                              civ_float_t unemployment_rate, civ_float_t regulation_level,
                              civ_float_t enforcement_budget) {
   if (!b) return;
-  (void)time_delta;
 
   b->enforcement_budget = enforcement_budget;
   /* Effectiveness: more budget = more effective, but corruption undermines */
@@ -49,7 +48,7 @@ void civ_black_market_update(civ_black_market_system_t *b, civ_float_t time_delt
     /* Volume: grows with unemployment, regulation, corruption; shrinks with enforcement */
     civ_float_t growth = unemployment_rate * 0.3 + regulation_level * 0.15
                         + corruption_level * 0.25 - m->enforcement_pressure * 0.4;
-    m->volume *= (1.0 + growth);
+    m->volume *= pow(1.0 + growth, time_delta);  /* growth is per tick */
     if (m->volume < 100.0) m->volume = 100.0;
 
     /* Profit margin: higher enforcement = higher risk premium */
@@ -5,6 +5,7 @@
 
 #include "core/economy/commodity_markets.h"
 #include "common.h"
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -26,6 +27,7 @@ civ_commodity_market_t *civ_resource_market_create(void) {
 void civ_resource_market_destroy(civ_commodity_market_t *market) {
   if (!market)
     return;
+  CIV_FREE(market->grid.block);
   CIV_FREE(market->resources);
   CIV_FREE(market);
 }
@@ -50,6 +52,7 @@ civ_result_t civ_resource_register(civ_commodity_market_t *market,
     res->local_supply = 100.0f;
     res->local_demand = 100.0f;
     res->current_price = 1.0f;
+    res->base_value = 1.0f;
 
     civ_log(CIV_LOG_INFO, "Registered procedural resource: %s (Category: %d)",
             name, (int)cat);
@@ -73,15 +76,234 @@ void civ_resource_update_price(civ_regional_resource_t *res,
   }
 }
 
+/* ── Clearing grid ────────────────────────────────────────────────── */
+
+#define CLEARING_MIN_ELASTICITY 0.05
+#define CLEARING_MAX_ELASTICITY 5.0
+#define CLEARING_MIN_PRICE      1e-6  /* of the reference price */
+
+/* (Re)size the grid when the region count or the registered commodities
+   changed; submitted curves and transport costs start over */
+static bool ensure_grid(civ_commodity_market_t *market, size_t regions) {
+  civ_commodity_grid_t *g = &market->grid;
+  size_t commodities = market->resource_count;
+  if (g->block && g->region_count == regions && g->commodity_count == commodities)
+    return true;
+
+  size_t markets = regions * commodities;
+  civ_float_t *block = (civ_float_t *)CIV_CALLOC(
+      markets * 7 + regions + commodities * 5, sizeof(civ_float_t));
+  if (!block && markets + regions + commodities > 0) return false;
+  CIV_FREE(g->block);
+
+  g->block = block;
+  g->region_count = regions;
+  g->commodity_count = commodities;
+  g->supply            = block;
+  g->demand            = g->supply + markets;
+  g->supply_elasticity = g->demand + markets;
+  g->demand_elasticity = g->supply_elasticity + markets;
+  g->price             = g->demand_elasticity + markets;
+  g->net_export        = g->price + markets;
+  g->autarky           = g->net_export + markets;
+  g->transport         = g->autarky + markets;
+  g->volume            = g->transport + regions;
+  g->excess            = g->volume + commodities;
+  g->slope             = g->excess + commodities;
+  g->low               = g->slope + commodities;
+  g->high              = g->low + commodities;
+  return true;
+}
+
+civ_result_t civ_resource_market_set_regions(civ_commodity_market_t *market,
+                                             size_t region_count) {
+  if (!market)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null pointer"};
+  if (!ensure_grid(market, region_count))
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+void civ_resource_market_set_transport(civ_commodity_market_t *market,
+                                       size_t region, civ_float_t cost) {
+  if (!market || !ensure_grid(market, market->grid.region_count)) return;
+  if (region < market->grid.region_count)
+    market->grid.transport[region] = MAX(cost, 0.0);
+}
+
+void civ_resource_market_begin_turn(civ_commodity_market_t *market) {
+  if (!market || !ensure_grid(market, market->grid.region_count)) return;
+  civ_commodity_grid_t *g = &market->grid;
+  size_t bytes = g->region_count * g->commodity_count * sizeof(civ_float_t);
+  memset(g->supply, 0, bytes);
+  memset(g->demand, 0, bytes);
+  memset(g->supply_elasticity, 0, bytes);
+  memset(g->demand_elasticity, 0, bytes);
+}
+
+void civ_resource_market_submit(civ_commodity_market_t *market, size_t region,
+                                size_t commodity, civ_float_t supply,
+                                civ_float_t demand,
+                                civ_float_t supply_elasticity,
+                                civ_float_t demand_elasticity) {
+  if (!market) return;
+  civ_commodity_grid_t *g = &market->grid;
+  if (region >= g->region_count || commodity >= g->commodity_count) return;
+
+  size_t m = region * g->commodity_count + commodity;
+  supply = MAX(supply, 0.0);
+  demand = MAX(demand, 0.0);
+  g->supply[m] += supply;
+  g->demand[m] += demand;
+  g->supply_elasticity[m] += supply * supply_elasticity;
+  g->demand_elasticity[m] += demand * demand_elasticity;
+}
+
+/* Where a region's price settles against hub price hub: the hub price less
+   transport when it ships out, plus transport when it ships in, otherwise
+   its own autarky price. Returns false for an autarkic region. */
+static bool local_price(civ_float_t autarky, civ_float_t hub, civ_float_t t,
+                        civ_float_t floor, civ_float_t *p) {
+  if (autarky < hub - t) {
+    *p = MAX(hub - t, floor);
+    return true;
+  }
+  if (autarky > hub + t) {
+    *p = hub + t;
+    return true;
+  }
+  *p = autarky;
+  return false;
+}
+
+static void clear_grid(civ_commodity_market_t *market) {
+  civ_commodity_grid_t *g = &market->grid;
+  size_t R = g->region_count, C = g->commodity_count;
+  civ_float_t index = market->global_price_index > 0.0 ? market->global_price_index : 1.0;
+
+  /* Per commodity: warm start, bracket and submitted volume */
+  for (size_t c = 0; c < C; c++) {
+    civ_regional_resource_t *res = &market->resources[c];
+    civ_float_t ref = res->base_value * index;
+    if (res->current_price <= ref * CLEARING_MIN_PRICE) res->current_price = ref;
+    g->volume[c] = 0.0;
+    g->low[c] = 0.0;
+    g->high[c] = HUGE_VAL;
+  }
+
+  /* Per market: mean elasticities and the autarky price, where
+     s (a/ref)^es = d (a/ref)^-ed */
+  for (size_t r = 0; r < R; r++) {
+    for (size_t c = 0; c < C; c++) {
+      size_t m = r * C + c;
+      civ_float_t ref = market->resources[c].base_value * index;
+      civ_float_t s = g->supply[m], d = g->demand[m];
+      civ_float_t es = s > 0.0 ? g->supply_elasticity[m] / s : 0.5;
+      civ_float_t ed = d > 0.0 ? g->demand_elasticity[m] / d : 0.5;
+      es = CLAMP(es, CLEARING_MIN_ELASTICITY, CLEARING_MAX_ELASTICITY);
+      ed = CLAMP(ed, CLEARING_MIN_ELASTICITY, CLEARING_MAX_ELASTICITY);
+      g->supply_elasticity[m] = es;
+      g->demand_elasticity[m] = ed;
+      if (s > 0.0 && d > 0.0)
+        g->autarky[m] = ref * pow(d / s, 1.0 / (es + ed));
+      else
+        g->autarky[m] = s > 0.0 ? 0.0 : HUGE_VAL;
+      g->volume[c] += s + d;
+    }
+  }
+
+  /* Newton on the hub prices for all commodities at once; the excess is
+     increasing in the hub price, so a bracket keeps each step safe */
+  int iter = 0;
+  while (iter < CIV_CLEARING_MAX_ITERATIONS) {
+    iter++;
+    memset(g->excess, 0, C * sizeof(civ_float_t));
+    memset(g->slope, 0, C * sizeof(civ_float_t));
+
+    for (size_t r = 0; r < R; r++) {
+      for (size_t c = 0; c < C; c++) {
+        size_t m = r * C + c;
+        civ_float_t s = g->supply[m], d = g->demand[m];
+        if (s <= 0.0 && d <= 0.0) continue;
+        civ_float_t ref = market->resources[c].base_value * index;
+        civ_float_t p;
+        if (!local_price(g->autarky[m], market->resources[c].current_price,
+                         g->transport[r] * ref, ref * CLEARING_MIN_PRICE, &p))
+          continue;
+        civ_float_t x = p / ref;
+        civ_float_t es = g->supply_elasticity[m], ed = g->demand_elasticity[m];
+        civ_float_t qs = s * pow(x, es), qd = d * pow(x, -ed);
+        g->excess[c] += qs - qd;
+        g->slope[c] += (es * qs + ed * qd) / p;
+      }
+    }
+
+    size_t open = 0;
+    for (size_t c = 0; c < C; c++) {
+      civ_float_t e = g->excess[c];
+      /* Balanced, or every region stays home and any hub price will do */
+      if (fabs(e) <= CIV_CLEARING_TOLERANCE * g->volume[c] || g->slope[c] <= 0.0)
+        continue;
+      open++;
+
+      civ_float_t *hub = &market->resources[c].current_price;
+      if (e > 0.0) g->high[c] = MIN(g->high[c], *hub);
+      else g->low[c] = MAX(g->low[c], *hub);
+
+      civ_float_t next = *hub - e / g->slope[c];
+      if (next <= g->low[c] || next >= g->high[c]) {
+        if (g->low[c] > 0.0 && g->high[c] < HUGE_VAL)
+          next = sqrt(g->low[c] * g->high[c]);
+        else
+          next = e > 0.0 ? *hub * 0.5 : *hub * 2.0;
+      }
+      *hub = next;
+    }
+    if (open == 0) break;
+  }
+  market->last_iterations = iter;
+
+  /* Publish local prices, flows and per-commodity totals */
+  market->total_trade_volume = 0.0;
+  for (size_t c = 0; c < C; c++) {
+    market->resources[c].local_supply = 0.0;
+    market->resources[c].local_demand = 0.0;
+  }
+  for (size_t r = 0; r < R; r++) {
+    for (size_t c = 0; c < C; c++) {
+      size_t m = r * C + c;
+      civ_regional_resource_t *res = &market->resources[c];
+      civ_float_t ref = res->base_value * index;
+      civ_float_t s = g->supply[m], d = g->demand[m];
+      if (s <= 0.0 && d <= 0.0) {
+        g->price[m] = res->current_price;
+        g->net_export[m] = 0.0;
+        continue;
+      }
+      civ_float_t p;
+      bool trades = local_price(g->autarky[m], res->current_price,
+                                g->transport[r] * ref, ref * CLEARING_MIN_PRICE, &p);
+      civ_float_t x = p / ref;
+      civ_float_t qs = s * pow(x, g->supply_elasticity[m]);
+      civ_float_t qd = d * pow(x, -g->demand_elasticity[m]);
+      g->price[m] = p;
+      g->net_export[m] = trades ? qs - qd : 0.0;
+      res->local_supply += qs;
+      res->local_demand += qd;
+      if (g->net_export[m] > 0.0)
+        market->total_trade_volume += g->net_export[m] * res->current_price;
+    }
+  }
+}
+
 void civ_resource_market_update_all(civ_commodity_market_t *market) {
   if (!market) return;
 
-  /* Nudge supply/demand with small random drift */
-  for (size_t i = 0; i < market->resource_count; i++) {
-    civ_regional_resource_t *res = &market->resources[i];
-    float drift = ((float)(rand() % 100) / 100.0f - 0.5f) * 0.05f;
-    res->local_supply = MAX(1.0f, res->local_supply + drift * 10.0f);
-    res->local_demand = MAX(1.0f, res->local_demand + drift * 10.0f);
-    civ_resource_update_price(res, market->global_price_index);
+  if (market->grid.region_count > 0 && ensure_grid(market, market->grid.region_count)) {
+    clear_grid(market);
+    return;
   }
+
+  for (size_t i = 0; i < market->resource_count; i++)
+    civ_resource_update_price(&market->resources[i], market->global_price_index);
 }
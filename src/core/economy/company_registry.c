@@ -0,0 +1,220 @@
+/**
+ * @file company_registry.c
+ * @brief Company store — SoA fields, symbol-keyed id lists, batched turn
+ */
+#include "core/economy/company_registry.h"
+#include "core/economy/econ_reduce.h"
+#include "common.h"
+#include "utils/rng.h"
+#include <stdio.h>
+#include <string.h>
+
+#define COMPANY_MIN_CAPACITY   64
+#define COMPANY_MARKET_GROWTH  0.03f  /* world growth add() rates are read against */
+#define COMPANY_REVERSION      0.20f  /* share of the gap to trend closed per turn */
+#define COMPANY_SHOCK          0.01f  /* largest random growth change per turn */
+#define COMPANY_STAFFING       0.25f  /* share of the staffing gap hired per turn */
+#define COMPANY_MIN_REVENUE    1000.0f
+
+/* ── Index ─────────────────────────────────────────────────────────── */
+
+static void index_free(civ_company_index_t *ix) {
+  for (uint32_t s = 0; s < ix->count; s++) CIV_FREE(ix->lists[s].ids);
+  CIV_FREE(ix->lists);
+  CIV_FREE(ix->keys);
+  CIV_FREE(ix->slot_of);
+  memset(ix, 0, sizeof(*ix));
+}
+
+static int32_t index_slot(const civ_company_index_t *ix, civ_symbol_t key) {
+  if (key == CIV_SYMBOL_NONE || key >= ix->slot_of_size) return -1;
+  return ix->slot_of[key];
+}
+
+static civ_company_list_t *index_list_for(civ_company_index_t *ix,
+                                          civ_symbol_t key) {
+  if (key >= ix->slot_of_size) {
+    uint32_t size = MAX(civ_symbol_count(), key + 1);
+    int32_t *slot_of = CIV_REALLOC(ix->slot_of, size * sizeof(int32_t));
+    if (!slot_of) return NULL;
+    for (uint32_t k = ix->slot_of_size; k < size; k++) slot_of[k] = -1;
+    ix->slot_of = slot_of;
+    ix->slot_of_size = size;
+  }
+  int32_t slot = ix->slot_of[key];
+  if (slot >= 0) return &ix->lists[slot];
+
+  if (ix->count >= ix->capacity) {
+    uint32_t cap = ix->capacity ? ix->capacity * 2 : 16;
+    civ_symbol_t *keys = CIV_REALLOC(ix->keys, cap * sizeof(civ_symbol_t));
+    if (!keys) return NULL;
+    ix->keys = keys;
+    civ_company_list_t *lists = CIV_REALLOC(ix->lists,
+                                            cap * sizeof(civ_company_list_t));
+    if (!lists) return NULL;
+    ix->lists = lists;
+    ix->capacity = cap;
+  }
+  slot = (int32_t)ix->count++;
+  ix->keys[slot] = key;
+  memset(&ix->lists[slot], 0, sizeof(civ_company_list_t));
+  ix->slot_of[key] = slot;
+  return &ix->lists[slot];
+}
+
+static bool index_add(civ_company_index_t *ix, civ_symbol_t key, uint32_t id) {
+  civ_company_list_t *l = index_list_for(ix, key);
+  if (!l) return false;
+  if (l->count >= l->capacity) {
+    uint32_t cap = l->capacity ? l->capacity * 2 : 8;
+    uint32_t *ids = CIV_REALLOC(l->ids, cap * sizeof(uint32_t));
+    if (!ids) return false;
+    l->ids = ids;
+    l->capacity = cap;
+  }
+  l->ids[l->count++] = id;
+  return true;
+}
+
+/* ── Store ─────────────────────────────────────────────────────────── */
+
+void civ_company_registry_init(civ_company_registry_t *r) {
+  if (r) memset(r, 0, sizeof(*r));
+}
+
+void civ_company_registry_free(civ_company_registry_t *r) {
+  if (!r) return;
+#define FREE_FIELD(name, init) CIV_FREE(r->name);
+  CIV_COMPANY_FIELDS(FREE_FIELD)
+#undef FREE_FIELD
+  CIV_FREE(r->nation);
+  CIV_FREE(r->industry);
+  CIV_FREE(r->is_public);
+  CIV_FREE(r->name);
+  index_free(&r->by_nation);
+  index_free(&r->by_industry);
+  memset(r, 0, sizeof(*r));
+}
+
+#define GROW_ARRAY(arr, cap)                                                   \
+  do {                                                                         \
+    void *grown = CIV_REALLOC((arr), (size_t)(cap) * sizeof(*(arr)));          \
+    if (!grown) return false;                                                  \
+    (arr) = grown;                                                             \
+  } while (0)
+
+static bool reserve(civ_company_registry_t *r, uint32_t count) {
+  if (count <= r->capacity) return true;
+  uint32_t cap = r->capacity ? r->capacity : COMPANY_MIN_CAPACITY;
+  while (cap < count) cap *= 2;
+#define GROW_FIELD(name, init) GROW_ARRAY(r->name, cap);
+  CIV_COMPANY_FIELDS(GROW_FIELD)
+#undef GROW_FIELD
+  GROW_ARRAY(r->nation, cap);
+  GROW_ARRAY(r->industry, cap);
+  GROW_ARRAY(r->is_public, cap);
+  GROW_ARRAY(r->name, cap);
+  r->capacity = cap;
+  return true;
+}
+
+int32_t civ_company_registry_add(civ_company_registry_t *r, const char *name,
+                                 const char *nation_id, const char *industry,
+                                 int32_t employees, float revenue,
+                                 float stock_price, float growth_rate) {
+  if (!r || !reserve(r, r->count + 1)) return -1;
+  civ_symbol_t nation_sym = civ_symbol_intern(nation_id);
+  civ_symbol_t industry_sym = civ_symbol_intern(industry);
+
+  uint32_t id = r->count;
+#define INIT_FIELD(field, init) r->field[id] = init;
+  CIV_COMPANY_FIELDS(INIT_FIELD)
+#undef INIT_FIELD
+  r->employees[id] = (float)MAX(employees, 1);
+  r->revenue[id] = MAX(revenue, COMPANY_MIN_REVENUE);
+  r->productivity[id] = r->revenue[id] / r->employees[id];
+  r->stock_price[id] = MAX(stock_price, 0.0f);
+  r->growth_rate[id] = growth_rate;
+  r->trend[id] = growth_rate - COMPANY_MARKET_GROWTH;
+  r->nation[id] = nation_sym;
+  r->industry[id] = industry_sym;
+  r->is_public[id] = stock_price > 0.0f;
+  snprintf(r->name[id], CIV_COMPANY_NAME, "%s", name ? name : "");
+
+  r->count++;
+
+  /* A firm an index could not grow for stays in the store, unlisted */
+  if ((nation_sym && !index_add(&r->by_nation, nation_sym, id)) ||
+      (industry_sym && !index_add(&r->by_industry, industry_sym, id)))
+    civ_log(CIV_LOG_WARNING, "Company %u left out of its index", id);
+  return (int32_t)id;
+}
+
+bool civ_company_registry_get(const civ_company_registry_t *r, uint32_t id,
+                              civ_company_t *out) {
+  if (!r || !out || id >= r->count) return false;
+  out->name = r->name[id];
+  out->industry = civ_symbol_name(r->industry[id]);
+  out->nation_id = civ_symbol_name(r->nation[id]);
+  out->employees = (int32_t)r->employees[id];
+  out->revenue = r->revenue[id];
+  out->stock_price = r->stock_price[id];
+  out->is_public = r->is_public[id] != 0;
+  out->growth_rate = r->growth_rate[id];
+  return true;
+}
+
+const civ_company_list_t *civ_company_registry_nation(
+    const civ_company_registry_t *r, civ_symbol_t nation) {
+  if (!r) return NULL;
+  int32_t slot = index_slot(&r->by_nation, nation);
+  return slot >= 0 ? &r->by_nation.lists[slot] : NULL;
+}
+
+const civ_company_list_t *civ_company_registry_industry(
+    const civ_company_registry_t *r, civ_symbol_t industry) {
+  if (!r) return NULL;
+  int32_t slot = index_slot(&r->by_industry, industry);
+  return slot >= 0 ? &r->by_industry.lists[slot] : NULL;
+}
+
+void civ_company_registry_nation_totals(const civ_company_registry_t *r,
+                                        civ_symbol_t nation, float *employees,
+                                        float *revenue) {
+  civ_econ_sum_t staff = CIV_ECON_SUM_ZERO, income = CIV_ECON_SUM_ZERO;
+  const civ_company_list_t *l = civ_company_registry_nation(r, nation);
+  for (uint32_t k = 0; l && k < l->count; k++) {
+    civ_econ_sum_add(&staff, r->employees[l->ids[k]]);
+    civ_econ_sum_add(&income, r->revenue[l->ids[k]]);
+  }
+  if (employees) *employees = (float)civ_econ_sum_value(&staff);
+  if (revenue) *revenue = (float)civ_econ_sum_value(&income);
+}
+
+/* ── Turn ──────────────────────────────────────────────────────────── */
+
+void civ_company_registry_update(civ_company_registry_t *r, float market_growth) {
+  if (!r || r->count == 0) return;
+  uint32_t n = r->count;
+
+  /* Random draws in id order, so the result does not depend on the loops
+     below being split or vectorized */
+  float *growth = r->growth_rate;
+  for (uint32_t i = 0; i < n; i++) {
+    float shock = ((float)(civ_rand() % 2001) - 1000.0f) / 1000.0f * COMPANY_SHOCK;
+    float target = r->trend[i] + market_growth;
+    growth[i] = CLAMP(growth[i] + (target - growth[i]) * COMPANY_REVERSION + shock,
+                      -0.5f, 0.5f);
+  }
+
+  float *revenue = r->revenue, *employees = r->employees;
+  float *productivity = r->productivity, *price = r->stock_price;
+  for (uint32_t i = 0; i < n; i++) {
+    float step = 1.0f + growth[i] / 12.0f;
+    revenue[i] = MAX(revenue[i] * step, COMPANY_MIN_REVENUE);
+    price[i] *= step;
+    float staffed = revenue[i] / productivity[i];
+    employees[i] = MAX(employees[i] + (staffed - employees[i]) * COMPANY_STAFFING,
+                       1.0f);
+  }
+}
@@ -0,0 +1,71 @@
+/**
+ * @file econ_reduce.c
+ * @brief Block-ordered parallel sums over the worker pool
+ */
+#include "core/economy/econ_reduce.h"
+#include "core/simulation_engine/worker_pool.h"
+#include "common.h"
+
+#define REDUCE_MIN_BLOCK  1024  /* elements; smaller inputs are one block */
+#define REDUCE_MAX_BLOCKS 256
+
+typedef struct {
+  const float        *values;
+  const float        *weights;   /* NULL for a plain sum */
+  civ_econ_value_fn_t value;     /* used when values is NULL */
+  void               *ctx;
+  size_t              count, block;
+  civ_econ_sum_t      partial[REDUCE_MAX_BLOCKS];
+} reduce_job_t;
+
+static void reduce_block(void *arg, int b) {
+  reduce_job_t *job = arg;
+  size_t first = (size_t)b * job->block;
+  size_t last = MIN(first + job->block, job->count);
+  civ_econ_sum_t s = CIV_ECON_SUM_ZERO;
+  if (!job->values) {
+    for (size_t i = first; i < last; i++)
+      civ_econ_sum_add(&s, job->value(job->ctx, i));
+  } else if (job->weights) {
+    for (size_t i = first; i < last; i++)
+      civ_econ_sum_add(&s, (double)job->values[i] * (double)job->weights[i]);
+  } else {
+    for (size_t i = first; i < last; i++)
+      civ_econ_sum_add(&s, job->values[i]);
+  }
+  job->partial[b] = s;
+}
+
+/* Block bounds come from count alone, never from the pool size */
+static double reduce(struct civ_worker_pool *pool, reduce_job_t *job) {
+  if (job->count == 0) return 0.0;
+  job->block = MAX((size_t)REDUCE_MIN_BLOCK,
+                   (job->count + REDUCE_MAX_BLOCKS - 1) / REDUCE_MAX_BLOCKS);
+  int blocks = (int)((job->count + job->block - 1) / job->block);
+  civ_worker_pool_parallel_for(pool, blocks, reduce_block, job);
+
+  civ_econ_sum_t total = CIV_ECON_SUM_ZERO;
+  for (int b = 0; b < blocks; b++) civ_econ_sum_merge(&total, &job->partial[b]);
+  return civ_econ_sum_value(&total);
+}
+
+double civ_econ_parallel_sum(struct civ_worker_pool *pool, const float *values,
+                             size_t count) {
+  if (!values) return 0.0;
+  reduce_job_t job = {.values = values, .count = count};
+  return reduce(pool, &job);
+}
+
+double civ_econ_parallel_dot(struct civ_worker_pool *pool, const float *values,
+                             const float *weights, size_t count) {
+  if (!values || !weights) return 0.0;
+  reduce_job_t job = {.values = values, .weights = weights, .count = count};
+  return reduce(pool, &job);
+}
+
+double civ_econ_parallel_sum_fn(struct civ_worker_pool *pool, size_t count,
+                                civ_econ_value_fn_t value, void *ctx) {
+  if (!value) return 0.0;
+  reduce_job_t job = {.value = value, .ctx = ctx, .count = count};
+  return reduce(pool, &job);
+}
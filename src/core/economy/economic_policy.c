@@ -96,12 +96,14 @@ void civ_economic_policy_set_instrument(civ_economic_policy_system_t *p,
       p->instruments[type].cost = magnitude * 10000.0;
       break;
   }
+  p->revision++;
 }
 
 void civ_economic_policy_set_regulation(civ_economic_policy_system_t *p,
                                         civ_regulation_level_t level) {
   if (!p) return;
   p->regulation = level;
+  p->revision++;
 }
 
 civ_float_t civ_economic_policy_subsidy_multiplier(const civ_economic_policy_system_t *p,
@@ -165,6 +167,16 @@ civ_float_t civ_economic_policy_growth_modifier(const civ_economic_policy_system
   return mod;
 }
 
+civ_float_t civ_economic_policy_stance_modifier(const civ_economic_policy_system_t *p) {
+  if (!p) return 1.0;
+  civ_float_t mod = 1.0 - (civ_float_t)p->regulation * 0.04;
+  if (p->instruments[CIV_POLICY_INVESTMENT_TAX_CREDIT].active)
+    mod += p->instruments[CIV_POLICY_INVESTMENT_TAX_CREDIT].magnitude * 0.08;
+  if (mod < 0.5) mod = 0.5;
+  if (mod > 1.5) mod = 1.5;
+  return mod;
+}
+
 civ_float_t civ_economic_policy_inequality_modifier(const civ_economic_policy_system_t *p) {
   if (!p) return 1.0;
   civ_float_t mod = 1.0;
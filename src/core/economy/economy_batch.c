@@ -0,0 +1,602 @@
+/**
+ * @file economy_batch.c
+ * @brief Batched per-nation economy — one loop per stage over all nations
+ *
+ * Each stage ports the per-tick rules of the module it is named after.
+ * Where a module constant assumes the single global economy's absolute
+ * scale, the stage states it per capita or per unit of GDP instead, and
+ * quantities the modules compound without bound (house prices, land
+ * values) are kept as levels; the stage comments say so.
+ */
+#include "core/economy/economy_batch.h"
+#include "core/economy/budget.h"
+#include "core/economy/infrastructure.h"
+#include "common.h"
+#include <math.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BATCH_MIN_CAPACITY   16      /* lanes; a multiple of 4 keeps arrays 16-byte aligned */
+#define BATCH_MILLION        1000000.0f
+#define BATCH_PARTICIPATION  0.62f   /* labor_market default */
+#define BATCH_WATER          0.70f   /* agriculture default, never updated */
+#define BATCH_CAPITAL_DEPREC 0.0785f /* investment-weighted mean of the five pool rates */
+
+static const struct {
+  size_t member;  /* offset of the array pointer in civ_economy_batch_t */
+  float  init;
+} k_fields[] = {
+#define BATCH_FIELD(name, init) {offsetof(civ_economy_batch_t, name), init},
+  CIV_ECONOMY_BATCH_INPUTS(BATCH_FIELD)
+  CIV_ECONOMY_BATCH_STATE(BATCH_FIELD)
+  CIV_ECONOMY_BATCH_OUTPUTS(BATCH_FIELD)
+#undef BATCH_FIELD
+};
+
+#define BATCH_FIELD_COUNT (sizeof(k_fields) / sizeof(k_fields[0]))
+
+static float **field_array(civ_economy_batch_t *b, size_t f) {
+  return (float **)((char *)b + k_fields[f].member);
+}
+
+civ_economy_batch_t *civ_economy_batch_create(void) {
+  civ_economy_batch_t *b = CIV_CALLOC(1, sizeof(civ_economy_batch_t));
+  if (!b) civ_log(CIV_LOG_ERROR, "Failed to allocate economy batch");
+  return b;
+}
+
+void civ_economy_batch_destroy(civ_economy_batch_t *b) {
+  if (!b) return;
+  CIV_FREE(b->block);
+  CIV_FREE(b);
+}
+
+bool civ_economy_batch_resize(civ_economy_batch_t *b, size_t count) {
+  if (!b) return false;
+
+  if (count > b->capacity) {
+    size_t cap = b->capacity ? b->capacity : BATCH_MIN_CAPACITY;
+    while (cap < count) cap *= 2;
+    float *block = CIV_MALLOC(BATCH_FIELD_COUNT * cap * sizeof(float));
+    if (!block) return false;
+    for (size_t f = 0; f < BATCH_FIELD_COUNT; f++) {
+      float **arr = field_array(b, f);
+      float *moved = block + f * cap;
+      if (b->count) memcpy(moved, *arr, b->count * sizeof(float));
+      *arr = moved;
+    }
+    CIV_FREE(b->block);
+    b->block = block;
+    b->capacity = cap;
+  }
+
+  for (size_t f = 0; f < BATCH_FIELD_COUNT; f++) {
+    float *arr = *field_array(b, f);
+    for (size_t i = b->count; i < count; i++) arr[i] = k_fields[f].init;
+  }
+  b->count = count;
+  return true;
+}
+
+bool civ_economy_batch_snapshot(const civ_economy_batch_t *b, size_t lane,
+                                civ_economy_snapshot_t *out) {
+  if (!b || !out || lane >= b->count) return false;
+#define BATCH_SAVE(name, init) out->name = b->name[lane];
+  CIV_ECONOMY_BATCH_INPUTS(BATCH_SAVE)
+  CIV_ECONOMY_BATCH_STATE(BATCH_SAVE)
+  CIV_ECONOMY_BATCH_OUTPUTS(BATCH_SAVE)
+#undef BATCH_SAVE
+  out->time_delta = b->time_delta;
+  return true;
+}
+
+bool civ_economy_batch_load(civ_economy_batch_t *b, size_t lane,
+                            const civ_economy_snapshot_t *snapshot) {
+  if (!b || !snapshot || lane >= b->count) return false;
+#define BATCH_LOAD(name, init) b->name[lane] = snapshot->name;
+  CIV_ECONOMY_BATCH_INPUTS(BATCH_LOAD)
+  CIV_ECONOMY_BATCH_STATE(BATCH_LOAD)
+  CIV_ECONOMY_BATCH_OUTPUTS(BATCH_LOAD)
+#undef BATCH_LOAD
+  return true;
+}
+
+/* State that is an amount rather than a rate or a level */
+#define BATCH_STOCKS(X)                                                        \
+  X(national_debt) X(money_supply) X(energy_capacity) X(housing_units)         \
+  X(capital_stock) X(illicit_volume) X(materiel_stockpile)
+
+static void reset_lane(civ_economy_batch_t *b, size_t lane) {
+  for (size_t f = 0; f < BATCH_FIELD_COUNT; f++)
+    (*field_array(b, f))[lane] = k_fields[f].init;
+}
+
+bool civ_economy_batch_merge_lanes(civ_economy_batch_t *b, size_t into,
+                                   size_t from, float weight) {
+  if (!b || into >= b->count || from >= b->count || into == from) return false;
+  float w = CLAMP(weight, 0.0f, 1.0f);
+#define BATCH_SUM(name) float name = b->name[into] + b->name[from];
+  BATCH_STOCKS(BATCH_SUM)
+#undef BATCH_SUM
+  /* The calendar and the seeding are the absorber's */
+  float seeded = MAX(b->seeded[into], b->seeded[from]);
+  float season = b->season[into], progress = b->season_progress[into];
+#define BATCH_BLEND(name, init) b->name[into] += (b->name[from] - b->name[into]) * w;
+  CIV_ECONOMY_BATCH_STATE(BATCH_BLEND)
+#undef BATCH_BLEND
+#define BATCH_STORE(name) b->name[into] = name;
+  BATCH_STOCKS(BATCH_STORE)
+#undef BATCH_STORE
+  b->seeded[into] = seeded;
+  b->season[into] = season;
+  b->season_progress[into] = progress;
+  reset_lane(b, from);
+  return true;
+}
+
+bool civ_economy_batch_split_lane(civ_economy_batch_t *b, size_t from,
+                                  size_t to, float share) {
+  if (!b || from >= b->count || to >= b->count || from == to) return false;
+  float s = CLAMP(share, 0.0f, 1.0f);
+  for (size_t f = 0; f < BATCH_FIELD_COUNT; f++) {
+    float *arr = *field_array(b, f);
+    arr[to] = arr[from];
+  }
+#define BATCH_DIVIDE(name)                                                     \
+  b->name[to] = b->name[from] * s;                                             \
+  b->name[from] -= b->name[to];
+  BATCH_STOCKS(BATCH_DIVIDE)
+#undef BATCH_DIVIDE
+  return true;
+}
+
+/* ── Stages, in data-flow order ────────────────────────────────────── */
+
+/* State sized by the territory, once a lane has some; ratios follow the
+   single-instance defaults against their 500k GDP */
+static void stage_seed(civ_economy_batch_t *b, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    if (b->seeded[i] != 0.0f || b->base_gdp[i] <= 0.0f) continue;
+    float gdp = b->base_gdp[i], pop = b->population[i];
+    b->money_supply[i]    = gdp * 2.0f;
+    b->capital_stock[i]   = gdp * 1.76f;
+    b->illicit_volume[i]  = gdp * 0.15f;
+    b->housing_units[i]   = pop / 3.0f * 0.92f;
+    b->energy_capacity[i] = pop * 0.0015f;
+    b->seeded[i] = 1.0f;
+  }
+}
+
+/* macro_economy: territory GDP under last tick's tax, spending and war drag */
+static void stage_macro(civ_economy_batch_t *b, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    float tax = b->tax_burden[i], spend = b->spending_ratio[i];
+    float tech = b->tech_level[i];
+    float gdp = b->base_gdp[i] * (1.0f - tax * 0.5f) * (1.0f + spend * 0.3f)
+                * (1.0f - b->civilian_penalty[i]);
+    b->gdp[i] = gdp;
+    b->gdp_per_capita[i] = b->population[i] > 0.0f
+                           ? gdp * BATCH_MILLION / b->population[i] : 0.0f;
+    float unemp = CLAMP(0.05f * ((1.0f - tech * 0.1f) + tax * 0.2f), 0.0f, 1.0f);
+    float infl  = CLAMP(0.02f * (1.0f + (spend - 0.3f) * 0.5f), -0.1f, 0.5f);
+    b->unemployment[i] = unemp;
+    b->inflation[i] = infl;
+    b->gdp_growth[i] = CLAMP(tech * 0.02f - unemp * 0.01f + infl * 0.005f,
+                             -0.1f, 0.15f);
+  }
+}
+
+/* labor_market: four skill tiers; reads last tick's business confidence */
+static void stage_labor(civ_economy_batch_t *b, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    float edu = b->education[i], bc = b->business_conf[i];
+    float displacement = b->tech_level[i] * 0.04f;
+    float *wage[4] = {&b->wage_unskilled[i], &b->wage_skilled[i],
+                      &b->wage_professional[i], &b->wage_executive[i]};
+    float dist[4] = {0.30f * (1.0f - edu * 0.5f), 0.40f,
+                     0.22f * (1.0f + edu * 0.5f), 0.08f * (1.0f + edu * 0.3f)};
+    float dist_sum = dist[0] + dist[1] + dist[2] + dist[3];
+
+    float workforce = b->population[i] * BATCH_PARTICIPATION;
+    float per_worker = workforce > 0.0f ? b->gdp[i] * BATCH_MILLION / workforce
+                                        : 50000.0f;
+    float employed = 0.0f, payroll = 0.0f;
+    for (int k = 0; k < 4; k++) {
+      float tier = workforce * dist[k] / dist_sum;
+      /* Automation hits the unskilled tier hardest */
+      float u = CLAMP(0.05f - (float)k * 0.015f + (1.0f - bc) * 0.05f
+                      + displacement * (k == 0 ? 1.5f : 1.0f), 0.01f, 0.35f);
+      employed += tier * (1.0f - u);
+      float growth = (per_worker / (*wage[k] + 1.0f) - 1.0f) * 0.1f
+                     + (bc - 0.5f) * 0.1f;
+      *wage[k] = MAX(*wage[k] * (1.0f + growth), 5000.0f);
+      payroll += *wage[k] * tier;
+    }
+    b->workforce[i] = workforce;
+    b->labor_avail[i] = workforce - employed;
+    b->unemployment[i] = workforce > 0.0f ? 1.0f - employed / workforce : 0.0f;
+    b->avg_wage[i] = payroll / (workforce + 1.0f);
+  }
+}
+
+/* economic_policy: confidence chases targets set by the macro indicators */
+static void stage_policy(civ_economy_batch_t *b, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    float infl = b->inflation[i], unemp = b->unemployment[i];
+    float growth = b->gdp_growth[i], corr = b->corruption[i];
+    float reg = b->regulation[i];
+
+    float cc = CLAMP(0.70f - (unemp - 0.05f) * 1.5f - (infl - 0.03f) * 2.0f
+                     + growth * 2.0f, 0.10f, 0.95f);
+    b->consumer_conf[i] += (cc - b->consumer_conf[i]) * 0.15f;
+
+    float bc = CLAMP(0.65f + growth * 2.5f - reg * 0.06f - corr * 0.4f
+                     - (infl - 0.02f), 0.05f, 0.95f);
+    b->business_conf[i] += (bc - b->business_conf[i]) * 0.12f;
+
+    float ef = MAX(0.85f - reg * 0.15f - corr * 0.3f, 0.10f);
+    b->econ_freedom[i] += (ef - b->econ_freedom[i]) * 0.1f;
+    b->regulation_level[i] = reg * 0.25f;
+  }
+}
+
+/* taxation: corporate and sales tax; the default income tax has no brackets */
+static void stage_taxation(civ_economy_batch_t *b, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    float corr = b->corruption[i], gdp = b->gdp[i];
+    float target = b->gov_efficiency[i] * (1.0f - corr * 0.7f);
+    b->tax_efficiency[i] += (target - b->tax_efficiency[i]) * 0.2f;
+    float collected = b->tax_efficiency[i] * (1.0f - corr * 0.8f);
+    float revenue = gdp * (0.15f * b->corporate_tax_rate[i]
+                           + 0.65f * b->sales_tax_rate[i]) * collected;
+    b->tax_revenue[i] = revenue;
+    b->tax_burden[i] = gdp > 0.0f ? revenue / gdp : 0.0f;
+  }
+}
+
+/* budget: even allocations, so spending is revenue plus any planned
+   deficit, with a 1%-of-GDP floor */
+static void stage_budget(civ_economy_batch_t *b, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    float gdp = b->gdp[i], revenue = b->tax_revenue[i];
+    float spending = MAX(revenue + gdp * b->deficit_spending[i], gdp * 0.01f);
+    float deficit = revenue - spending;
+    float debt = b->national_debt[i];
+
+    if (deficit < 0.0f) {
+      float limit = revenue * b->credit_rating[i] * 5.0f
+                    * (1.0f - b->debt_to_gdp[i] * 0.5f);
+      debt += MIN(-deficit, MAX(limit, 0.0f));
+    } else if (deficit > 0.0f && debt > 0.0f) {
+      debt -= MIN(deficit * 0.7f, debt);
+    }
+    float interest = debt * b->debt_rate[i];
+    debt += interest;
+    spending += interest;
+    deficit = revenue - spending;
+
+    float d2g = gdp > 0.0f ? debt / gdp : 0.0f;
+    float rating = CLAMP(0.95f - d2g * 0.8f + (deficit > 0.0f ? 0.05f : 0.0f),
+                         0.05f, 0.98f);
+    b->credit_rating[i] += (rating - b->credit_rating[i]) * 0.1f;
+    b->debt_rate[i] = 0.01f + (1.0f - b->credit_rating[i]) * 0.15f;
+
+    float deficit_health = deficit >= 0.0f
+      ? 1.0f : MAX(1.0f - fabsf(deficit) / (gdp * 0.1f + 1.0f), 0.0f);
+    float debt_health = MAX(1.0f - d2g, 0.0f);
+    b->fiscal_health[i] = deficit_health * 0.4f + debt_health * 0.4f
+                          + b->credit_rating[i] * 0.2f;
+
+    b->national_debt[i] = debt;
+    b->debt_to_gdp[i] = d2g;
+    b->expenditure[i] = spending;
+    b->deficit[i] = deficit;
+    b->spending_ratio[i] = gdp > 0.0f ? spending / gdp : 0.20f;
+    b->infra_budget[i] = spending / (float)CIV_BUDGET_CATEGORY_COUNT;
+    b->savings_rate[i] = MAX(1.0f - b->spending_ratio[i], 0.05f);
+    b->interest_rate[i] = b->debt_rate[i];
+  }
+}
+
+/* banking: policy rate and reserves; no per-nation loan book */
+static void stage_banking(civ_economy_batch_t *b, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    float infl = b->inflation[i], growth = b->gdp_growth[i];
+    float target = 0.04f;
+    if (infl > 0.06f)
+      target += (infl - 0.03f) * 0.8f;
+    else if (infl > 0.03f)
+      target += (infl - 0.03f) * 0.4f;
+    if (growth < 0.0f && b->unemployment[i] > 0.07f)
+      target -= 0.02f;
+    else if (growth < 0.02f)
+      target -= 0.005f;
+    target += b->spending_ratio[i] * 0.01f;
+
+    float rate = b->policy_rate[i] + (target - b->policy_rate[i]) * 0.1f;
+    rate = CLAMP(rate, 0.001f, 0.35f);
+    b->policy_rate[i] = rate;
+
+    float reserve = b->reserve_ratio[i];
+    if (infl > 0.05f)
+      reserve += 0.002f;
+    else if (infl < 0.01f)
+      reserve -= 0.001f;
+    b->reserve_ratio[i] = CLAMP(reserve, 0.01f, 0.25f);
+
+    b->money_supply[i] *= 1.0f + growth * 0.5f - (rate - 0.02f) * 0.1f;
+    b->interest_rate[i] = rate;
+  }
+}
+
+/* agriculture: seasons, soil and irrigation on the nation's arable land */
+static void stage_agriculture(civ_economy_batch_t *b, size_t n, float dt) {
+  static const float season_yield[4] = {0.8f, 1.2f, 1.1f, 0.3f};
+  for (size_t i = 0; i < n; i++) {
+    float progress = b->season_progress[i] + dt * 0.01f;
+    if (progress >= 1.0f) {
+      progress = 0.0f;
+      b->season[i] = (float)(((int)b->season[i] + 1) % 4);
+    }
+    b->season_progress[i] = progress;
+
+    float tech = b->tech_level[i], pop = b->population[i];
+    float arable = b->arable_km2[i];
+    float intensity = pop / (arable + 1.0f);
+    float soil = b->soil_fertility[i] + (0.5f - intensity * 0.001f
+                 - b->soil_fertility[i] * 0.05f + tech * 0.02f) * dt * 0.5f;
+    soil = CLAMP(soil, 0.10f, 1.00f);
+    b->soil_fertility[i] = soil;
+    b->irrigation[i] += (tech * 0.2f - b->irrigation[i]) * dt * 0.3f;
+
+    float season = season_yield[(int)b->season[i] & 3];
+    float crops = arable * soil * (0.5f + BATCH_WATER * 0.5f)
+                  * (1.0f + b->irrigation[i]) * (1.0f + tech * 0.5f)
+                  * season * 2.0f;
+    float livestock = arable * 0.3f * soil * season * 0.8f;
+    float produced = (crops + livestock) * 800.0f;
+    float consumed = pop * 2500.0f * 365.0f;
+    b->food_production[i] = produced;
+    b->food_consumption[i] = consumed;
+    float ratio = consumed > 0.0f ? produced / consumed : 1.0f;
+    b->famine_risk[i] = ratio < 0.7f ? 1.0f - ratio / 0.7f : 0.0f;
+  }
+}
+
+/* extraction: one deposit per nation; depletion is kept as a fraction so
+   the reserve follows territory changes */
+static void stage_extraction(civ_economy_batch_t *b, size_t n, float dt) {
+  for (size_t i = 0; i < n; i++) {
+    float deposit = b->mineral_deposit[i];
+    float reserve = deposit * (1.0f - b->mineral_depletion[i]);
+    float efficiency = MIN(0.3f + b->tech_level[i] * 0.5f
+                           + (b->labor_avail[i] > 1000.0f ? 0.2f : 0.0f), 1.0f);
+    float mined = MIN(reserve * efficiency * 0.02f * b->mineral_richness[i]
+                      * dt * 0.1f, reserve);
+    reserve -= mined;
+    if (deposit > 0.0f)
+      b->mineral_depletion[i] = MIN(b->mineral_depletion[i] + mined / deposit, 1.0f);
+
+    float depletion = reserve > 0.0f ? mined / reserve : 0.0f;
+    b->sustainability[i] = CLAMP(b->sustainability[i]
+        + ((1.0f - depletion * 10.0f) - b->sustainability[i]) * 0.05f, 0.0f, 1.0f);
+    b->raw_materials[i] = MAX(mined, 1.0f);
+  }
+}
+
+/* infrastructure: wear scales with density (1% a tick at 100 people/km2)
+   and upkeep with the share of GDP spent per network */
+static void stage_infrastructure(civ_economy_batch_t *b, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    float gdp = b->gdp[i];
+    float density = b->area_km2[i] > 0.0f ? b->population[i] / b->area_km2[i] : 0.0f;
+    float wear = 0.01f * MIN(density / 100.0f, 3.0f);
+    float per_network = b->infra_budget[i] / (float)CIV_INFRA_TYPE_COUNT;
+    float upkeep = gdp > 0.0f ? per_network / gdp * 10.0f : 0.0f;
+    float condition = b->infra_condition[i];
+    condition = CLAMP(condition - condition * wear + upkeep, 0.0f, 1.0f);
+    b->infra_condition[i] = condition;
+    b->infra_quality[i] = b->infra_coverage[i] * condition;
+    b->supply_chain[i] = condition;
+  }
+}
+
+/* manufacturing: one factory sized to a quarter of the workforce, staffed
+   from available labor; each 1000 workers need one unit of raw materials */
+static void stage_manufacturing(civ_economy_batch_t *b, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    float tech = b->tech_level[i];
+    b->mfg_supply_chain[i] += (b->infra_quality[i] - b->mfg_supply_chain[i]) * 0.1f;
+    b->automation[i] += (tech * 0.5f - b->automation[i]) * 0.05f;
+
+    float workers = CLAMP(b->labor_avail[i], 0.0f, b->workforce[i] * 0.25f);
+    float raw_needed = workers * 0.001f + 0.001f;
+    float raw_eff = MIN(b->raw_materials[i] / raw_needed, 1.0f);
+    float per_worker = (1.0f + tech * 0.8f) * (1.0f + b->automation[i] * 0.5f)
+                       * b->mfg_supply_chain[i] * raw_eff;
+    b->industrial_output[i] = MAX(workers * per_worker, 1.0f);
+  }
+}
+
+/* energy: one aggregate plant with a renewable share */
+static void stage_energy(civ_economy_batch_t *b, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    float tech = b->tech_level[i], renew = b->renewable_share[i];
+    float demand = b->population[i] * 0.001f + b->industrial_output[i] * 0.01f;
+    b->plant_efficiency[i] += (0.4f + tech * 0.4f - b->plant_efficiency[i]) * 0.05f;
+    float capacity = b->energy_capacity[i];
+    b->energy_output[i] = capacity * b->plant_efficiency[i]
+                          * (renew + (1.0f - renew) * b->fuel_availability[i]);
+
+    float supply = capacity * b->grid_reliability[i];
+    b->energy_demand[i] = demand;
+    b->blackout[i] = demand > supply ? 1.0f : 0.0f;
+    float balance = demand > 0.0f ? supply / demand : 2.0f;
+    float target = 100.0f / (balance + 0.2f) * (1.0f - renew * 0.3f)
+                   / (1.0f + tech * 0.3f);
+    b->energy_price[i] += (target - b->energy_price[i]) * 0.1f;
+
+    float grid = b->grid_reliability[i]
+                 + (tech * 0.1f - (1.0f - b->grid_reliability[i]) * 0.02f) * 0.5f;
+    b->grid_reliability[i] = CLAMP(grid, 0.20f, 0.99f);
+  }
+}
+
+/* housing: construction against need; the price is held as a multiple of
+   income, which rates above a 4% neutral push down */
+static void stage_housing(civ_economy_batch_t *b, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    float needed = b->population[i] / 3.0f;
+    float units = b->housing_units[i];
+    float rate = b->interest_rate[i];
+    float cost_index = 2.0f - b->infra_quality[i];
+
+    float build = MAX(needed - units, 0.0f) * 0.1f * (1.0f - rate * 2.0f)
+                  / (cost_index + 0.5f);
+    units = MAX(units + MAX(build, 0.0f) - units * 0.02f, 100.0f);
+    b->housing_units[i] = units;
+
+    float vacancy = (units - MIN(needed, units)) / units;
+    float pressure = vacancy < 0.05f ? 0.05f : (vacancy > 0.15f ? -0.02f : 0.0f);
+    float p2i = b->price_to_income[i] * (1.0f + pressure - (rate - 0.04f) * 0.3f);
+    p2i = CLAMP(p2i, 1.0f, 15.0f);
+    b->price_to_income[i] = p2i;
+
+    float afford = p2i < 3.0f ? 1.0f : (p2i > 8.0f ? 0.0f : 1.0f - (p2i - 3.0f) / 5.0f);
+    b->homeownership[i] += (afford - b->homeownership[i]) * 0.05f;
+    b->urbanization[i] = MIN(b->urbanization[i] + 0.001f, 0.95f);
+  }
+}
+
+/* land_use: zone shares of the territory; 20% farmland and 1% conservation
+   stay fixed. Land values are a level set by income and density. */
+static void stage_land_use(civ_economy_batch_t *b, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    float area = b->area_km2[i];
+    float undeveloped = b->share_undeveloped[i];
+    float developed = area * (0.99f - undeveloped);
+    float pressure = developed > 0.0f ? b->population[i] / developed * 0.01f : 0.5f;
+
+    if (pressure > 0.5f && undeveloped > 0.0f) {
+      float convert = undeveloped * 0.002f * b->urbanization[i];
+      b->share_undeveloped[i] = undeveloped - convert;
+      b->share_residential[i] += convert * 0.5f;
+      b->share_commercial[i] += convert * 0.3f;
+      b->share_industrial[i] += convert * 0.2f;
+    }
+
+    float income = b->gdp_per_capita[i] / 50000.0f;
+    float built = 1.0f + income + MIN(pressure, 10.0f) * 0.02f;
+    float value = b->share_undeveloped[i] * 100.0f * (1.0f + income * 0.2f)
+                  + (0.20f * 5000.0f
+                     + b->share_residential[i] * 50000.0f
+                     + b->share_commercial[i] * 30000.0f
+                     + b->share_industrial[i] * 20000.0f) * built
+                  + 0.01f * 200.0f;
+    b->land_value_index[i] = value / 1000.0f;
+  }
+}
+
+/* capital_assets: one pool with the pools' mean depreciation */
+static void stage_capital(civ_economy_batch_t *b, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    float gdp = b->gdp[i];
+    float invest = gdp * b->savings_rate[i] * b->business_conf[i]
+                   * MAX(1.0f - b->interest_rate[i] * 1.5f, 0.1f);
+    float stock = MAX(b->capital_stock[i] * (1.0f - BATCH_CAPITAL_DEPREC) + invest, 0.0f);
+    b->capital_stock[i] = stock;
+    b->productivity[i] = 1.0f + stock / (gdp + 1.0f) * 0.3f;
+  }
+}
+
+/* domestic_trade: integration follows infrastructure */
+static void stage_domestic_trade(civ_economy_batch_t *b, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    b->market_integration[i] += (b->infra_quality[i] - b->market_integration[i]) * 0.08f;
+    b->domestic_volume[i] = b->population[i] * b->market_integration[i] * 0.5f;
+  }
+}
+
+/* innovation_economy: R&D intensity times commercialization */
+static void stage_innovation(civ_economy_batch_t *b, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    float edu = b->education[i], bc = b->business_conf[i];
+    float rd = 0.01f + edu * 0.03f + bc * 0.01f;
+    float commercial = CLAMP(edu * 0.4f + bc * 0.2f - b->regulation_level[i] * 0.1f
+                             + 0.15f, 0.05f, 0.80f);
+    b->innovation_index[i] = MIN(rd * 10.0f * commercial, 1.0f);
+  }
+}
+
+/* black_market: enforcement is the administration share of spending; the
+   volume is capped at half of GDP */
+static void stage_black_market(civ_economy_batch_t *b, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    float gdp = b->gdp[i], corr = b->corruption[i];
+    float enforcement = b->expenditure[i] / (float)CIV_BUDGET_CATEGORY_COUNT;
+    float effect = gdp > 0.0f ? enforcement / gdp * 50.0f * (1.0f - corr * 0.8f) : 0.0f;
+    effect = CLAMP(effect, 0.05f, 0.95f);
+    float growth = b->unemployment[i] * 0.3f + b->regulation_level[i] * 0.15f
+                   + corr * 0.25f - effect * 0.4f;
+    float volume = CLAMP(b->illicit_volume[i] * (1.0f + growth), gdp * 0.001f, gdp * 0.5f);
+    b->illicit_volume[i] = volume;
+    b->illicit_share[i] = gdp > 0.0f ? volume / gdp : 0.0f;
+    b->criminal_violence[i] = MIN(b->illicit_share[i] * 0.4f
+                                  + effect * 0.1f * (1.0f - corr), 1.0f);
+  }
+}
+
+/* war_economy: nations at war run partial mobilization; in peace the
+   civilian penalty eases along with rationing */
+static void stage_war(civ_economy_batch_t *b, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    bool fighting = b->at_war[i] > 0.5f;
+    if (!fighting) {
+      b->military_spending_ratio[i] += (0.02f - b->military_spending_ratio[i]) * 0.1f;
+      b->war_conversion[i] *= 0.95f;
+      b->rationing[i] *= 0.9f;
+      b->conscription[i] *= 0.9f;
+      b->civilian_penalty[i] *= 0.9f;
+      b->war_exhaustion[i] *= 0.95f;
+    } else {
+      b->military_spending_ratio[i] = 0.12f;
+      b->civilian_penalty[i] = 0.08f;
+      b->war_conversion[i] = 0.10f;
+      b->conscription[i] = 0.02f;
+      b->war_exhaustion[i] = MIN(b->war_exhaustion[i] + 0.01f + b->rationing[i] * 0.03f
+                                 + b->civilian_penalty[i] * 0.02f, 1.0f);
+    }
+    float stockpile = b->materiel_stockpile[i]
+                      + b->industrial_output[i] * b->war_conversion[i] * 0.5f;
+    if (fighting) stockpile -= stockpile * 0.05f;
+    b->materiel_stockpile[i] = stockpile;
+  }
+}
+
+void civ_economy_batch_update(civ_economy_batch_t *b, civ_float_t time_delta) {
+  if (!b || b->count == 0) return;
+  size_t n = b->count;
+  float dt = (float)time_delta;
+  b->time_delta = dt;
+
+  stage_seed(b, n);
+  stage_macro(b, n);
+  stage_labor(b, n);
+  stage_policy(b, n);
+  stage_taxation(b, n);
+  stage_budget(b, n);
+  stage_banking(b, n);
+  stage_agriculture(b, n, dt);
+  stage_extraction(b, n, dt);
+  stage_infrastructure(b, n);
+  stage_manufacturing(b, n);
+  stage_energy(b, n);
+  stage_housing(b, n);
+  stage_land_use(b, n);
+  stage_capital(b, n);
+  stage_domestic_trade(b, n);
+  stage_innovation(b, n);
+  stage_black_market(b, n);
+  stage_war(b, n);
+}
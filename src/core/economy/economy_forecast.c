@@ -0,0 +1,110 @@
+/**
+ * @file economy_forecast.c
+ * @brief What-if projections — forked snapshots run as batch lanes
+ */
+#include "core/economy/economy_forecast.h"
+#include "core/economy/economic_policy.h"
+#include "core/simulation_engine/worker_pool.h"
+#include "common.h"
+
+#define FORECAST_CHUNK 16  /* deltas per batch, one batch per job */
+
+civ_economy_snapshot_t civ_economy_apply_policy(
+    const civ_economy_snapshot_t *snapshot,
+    const civ_economy_policy_delta_t *delta) {
+  civ_economy_snapshot_t s = *snapshot;
+  if (!delta) return s;
+  s.corporate_tax_rate = CLAMP(s.corporate_tax_rate + delta->corporate_tax_rate,
+                               0.0f, 0.9f);
+  s.sales_tax_rate = CLAMP(s.sales_tax_rate + delta->sales_tax_rate, 0.0f, 0.5f);
+  s.deficit_spending = CLAMP(s.deficit_spending + delta->deficit_spending,
+                             -0.2f, 0.2f);
+  s.regulation = CLAMP(s.regulation + delta->regulation, 0.0f,
+                       (float)(CIV_REGULATION_COUNT - 1));
+  return s;
+}
+
+/* Lanes [0, n) of b start from snapshot under deltas[0..n) */
+static bool run_lanes(const civ_economy_snapshot_t *snapshot,
+                      const civ_economy_policy_delta_t *deltas, int n,
+                      int turns, civ_economy_projection_t *out) {
+  civ_economy_batch_t *b = civ_economy_batch_create();
+  if (!b || !civ_economy_batch_resize(b, (size_t)n)) {
+    civ_economy_batch_destroy(b);
+    return false;
+  }
+  for (int i = 0; i < n; i++) {
+    civ_economy_snapshot_t start =
+        civ_economy_apply_policy(snapshot, deltas ? &deltas[i] : NULL);
+    civ_economy_batch_load(b, (size_t)i, &start);
+    out[i].turns = turns;
+  }
+
+  float dt = snapshot->time_delta > 0.0f ? snapshot->time_delta : 1.0f;
+  for (int t = 0; t < turns; t++) {
+    civ_economy_batch_update(b, dt);
+    for (int i = 0; i < n; i++) {
+      out[i].gdp[t] = b->gdp[i];
+      out[i].tax_revenue[t] = b->tax_revenue[i];
+      out[i].deficit[t] = b->deficit[i];
+      out[i].national_debt[t] = b->national_debt[i];
+      out[i].unemployment[t] = b->unemployment[i];
+    }
+  }
+  for (int i = 0; i < n; i++)
+    civ_economy_batch_snapshot(b, (size_t)i, &out[i].final);
+  civ_economy_batch_destroy(b);
+  return true;
+}
+
+bool civ_economy_simulate(const civ_economy_snapshot_t *snapshot,
+                          const civ_economy_policy_delta_t *delta, int turns,
+                          civ_economy_projection_t *out) {
+  if (!snapshot || !out) return false;
+  return run_lanes(snapshot, delta, 1,
+                   CLAMP(turns, 0, CIV_ECONOMY_FORECAST_MAX_TURNS), out);
+}
+
+typedef struct {
+  const civ_economy_snapshot_t *snapshot;
+  const civ_economy_policy_delta_t *deltas;
+  int count, turns;
+  civ_economy_projection_t *out;
+  SDL_AtomicInt failed;
+} forecast_job_t;
+
+static void forecast_chunk(void *ctx, int chunk) {
+  forecast_job_t *job = ctx;
+  int first = chunk * FORECAST_CHUNK;
+  int n = MIN(FORECAST_CHUNK, job->count - first);
+  if (!run_lanes(job->snapshot, job->deltas + first, n, job->turns,
+                 job->out + first))
+    SDL_SetAtomicInt(&job->failed, 1);
+}
+
+bool civ_economy_forecast_many(struct civ_worker_pool *pool,
+                               const civ_economy_snapshot_t *snapshot,
+                               const civ_economy_policy_delta_t *deltas,
+                               int count, int turns,
+                               civ_economy_projection_t *out) {
+  if (!snapshot || !deltas || !out || count <= 0) return false;
+  forecast_job_t job = {snapshot, deltas, count,
+                        CLAMP(turns, 0, CIV_ECONOMY_FORECAST_MAX_TURNS), out};
+  SDL_SetAtomicInt(&job.failed, 0);
+  int chunks = (count + FORECAST_CHUNK - 1) / FORECAST_CHUNK;
+  civ_worker_pool_parallel_for(pool, chunks, forecast_chunk, &job);
+  return SDL_GetAtomicInt(&job.failed) == 0;
+}
+
+float civ_economy_projection_score(const civ_economy_snapshot_t *start,
+                                   const civ_economy_projection_t *p) {
+  if (!start || !p || p->turns <= 0) return 0.0f;
+  const civ_economy_snapshot_t *end = &p->final;
+  float gdp0 = MAX(start->gdp, 1.0f);
+  float growth = (end->gdp - gdp0) / gdp0;
+  float unemployment = 0.0f;
+  for (int t = 0; t < p->turns; t++) unemployment += p->unemployment[t];
+  unemployment /= (float)p->turns;
+  float excess_debt = MAX(end->debt_to_gdp - 0.6f, 0.0f);
+  return growth + end->fiscal_health * 0.5f - unemployment - excess_debt;
+}
@@ -5,6 +5,19 @@
 #include <string.h>
 
 #define CIV_ENERGY_INITIAL_PLANT_CAP 8
+#define CIV_ENERGY_SCARCITY_PRICE    500.0 /* per MWh of unserved load */
+#define CIV_ENERGY_CURVE_QUANTUM     256.0 /* fuel and tech steps per 1.0 */
+#define CIV_ENERGY_SETTLED           0.005 /* efficiency gap that stops drift */
+#define CIV_ENERGY_INTERCONNECT_ROUNDS 4
+
+/* Operating cost per MWh by source, before fuel */
+static const civ_float_t k_operating_cost[CIV_ENERGY_TYPE_COUNT] = {
+  12.0, 15.0, 8.0, 14.0, 2.0, 3.0, 4.0, 6.0
+};
+/* Fuel per MWh of heat; a plant burns fuel_price / efficiency per MWh out */
+static const civ_float_t k_default_fuel_price[CIV_ENERGY_TYPE_COUNT] = {
+  9.0, 28.0, 18.0, 3.0, 0.0, 0.0, 0.0, 0.0
+};
 
 civ_energy_system_t *civ_energy_create(void) {
   civ_energy_system_t *e = CIV_MALLOC(sizeof(civ_energy_system_t));
@@ -15,69 +28,241 @@ civ_energy_system_t *civ_energy_create(void) {
   e->grid_reliability = 0.85;
   e->energy_price = 50.0; /* per MWh */
   e->energy_independence = 0.90;
+  memcpy(e->fuel_price, k_default_fuel_price, sizeof(e->fuel_price));
+  e->marginal = -1;
   return e;
 }
 
 void civ_energy_destroy(civ_energy_system_t *e) {
   if (!e) return;
   free(e->plants);
+  free(e->merit);
+  free(e->merit_cum);
   free(e);
 }
 
-void civ_energy_update(civ_energy_system_t *e, civ_float_t time_delta,
-                       civ_float_t population, civ_float_t industrial_output,
-                       civ_float_t tech_level, civ_float_t fuel_availability) {
-  if (!e) return;
-  (void)time_delta;
+/* ── Merit order ────────────────────────────────────────────────────── */
 
-  /* Demand: per-capita baseload + industrial */
-  e->total_demand_mw = population * 0.001 + industrial_output * 0.01;
+static civ_float_t plant_available(const civ_power_plant_t *p, civ_float_t fuel_availability) {
+  return p->capacity_mw * p->efficiency * (p->is_renewable ? 1.0 : fuel_availability);
+}
 
-  /* Supply */
-  e->total_capacity_mw = 0.0;
-  e->renewable_fraction = 0.0;
-  civ_float_t renewable_capacity = 0.0;
+/* Insertion sort by marginal cost, ties by index; grids hold few plants
+   and the curve is rebuilt rarely */
+static void sort_merit(int *merit, const civ_power_plant_t *plants, int n) {
+  for (int i = 1; i < n; i++) {
+    int v = merit[i];
+    int j = i - 1;
+    while (j >= 0 && (plants[merit[j]].cost_per_mwh > plants[v].cost_per_mwh ||
+                      (plants[merit[j]].cost_per_mwh == plants[v].cost_per_mwh &&
+                       merit[j] > v))) {
+      merit[j + 1] = merit[j];
+      j--;
+    }
+    merit[j + 1] = v;
+  }
+}
 
+/* Drift efficiencies over the updates since the last curve, price plants
+   and sort them; the drift is what used to run every update, taken in one
+   step while the plants are settled */
+static bool rebuild_curve(civ_energy_system_t *e, civ_float_t tech_level,
+                          civ_float_t fuel_availability) {
+  if (e->plant_count > e->merit_capacity) {
+    int *merit = CIV_REALLOC(e->merit, sizeof(int) * e->plant_capacity);
+    if (!merit) return false;
+    e->merit = merit;
+    civ_float_t *cum = CIV_REALLOC(e->merit_cum, sizeof(civ_float_t) * e->plant_capacity);
+    if (!cum) return false;
+    e->merit_cum = cum;
+    e->merit_capacity = e->plant_capacity;
+  }
+
+  civ_float_t target = 0.4 + tech_level * 0.4;
+  civ_float_t keep = pow(0.95, (double)MAX(e->updates_since_curve, 1u));
+  e->converging = false;
   for (int i = 0; i < e->plant_count; i++) {
     civ_power_plant_t *p = &e->plants[i];
+    p->efficiency = target + (p->efficiency - target) * keep;
+    if (fabs(p->efficiency - target) > CIV_ENERGY_SETTLED) e->converging = true;
+    civ_float_t fuel = p->is_renewable ? 0.0 : e->fuel_price[p->source];
+    p->cost_per_mwh = k_operating_cost[p->source] +
+                      (p->efficiency > 0.0 ? fuel / p->efficiency : fuel);
+    e->merit[i] = i;
+  }
+  sort_merit(e->merit, e->plants, e->plant_count);
 
-    /* Efficiency improves with tech */
-    p->efficiency += (0.4 + tech_level * 0.4 - p->efficiency) * 0.05;
+  civ_float_t cum = 0.0;
+  for (int k = 0; k < e->plant_count; k++) {
+    cum += plant_available(&e->plants[e->merit[k]], fuel_availability);
+    e->merit_cum[k] = cum;
+  }
+  e->available_mw = cum;
+  e->curve_count = e->plant_count;
+  e->marginal = -1; /* every plant's output is rewritten */
+  e->updates_since_curve = 0;
+  e->curve_plants = e->plant_revision;
+  e->curve_fuel = e->fuel_revision;
+  e->curve_built = true;
+  e->curve_rebuilds++;
+  return true;
+}
 
-    /* Non-renewable output limited by fuel */
-    civ_float_t fuel_mult = p->is_renewable ? 1.0 : fuel_availability;
+/* First curve position whose cumulative output covers load */
+static int curve_position(const civ_energy_system_t *e, civ_float_t load) {
+  int lo = 0, hi = e->curve_count - 1;
+  while (lo < hi) {
+    int mid = lo + (hi - lo) / 2;
+    if (e->merit_cum[mid] >= load) hi = mid;
+    else lo = mid + 1;
+  }
+  return lo;
+}
 
-    p->current_output_mw = p->capacity_mw * p->efficiency * fuel_mult;
-    e->total_capacity_mw += p->capacity_mw;
+static civ_float_t firm_supply(const civ_energy_system_t *e) {
+  return e->available_mw * e->grid_reliability;
+}
+
+civ_float_t civ_energy_marginal_cost_at(const civ_energy_system_t *e, civ_float_t load_mw) {
+  if (!e) return 0.0;
+  if (load_mw > firm_supply(e) || e->curve_count == 0 || !e->curve_built)
+    return CIV_ENERGY_SCARCITY_PRICE;
+  return e->plants[e->merit[curve_position(e, MAX(load_mw, 0.0))]].cost_per_mwh;
+}
 
-    if (p->is_renewable) renewable_capacity += p->capacity_mw;
+civ_float_t civ_energy_dispatch(civ_energy_system_t *e, civ_float_t demand_mw) {
+  if (!e) return 0.0;
+  demand_mw = MAX(demand_mw, 0.0);
+  civ_float_t served = MIN(demand_mw, firm_supply(e));
+  e->served_mw = served;
+  e->unserved_mw = demand_mw - served;
+  e->blackout = e->unserved_mw > 0.0;
+  if (e->curve_count == 0 || !e->curve_built) {
+    e->clearing_price = CIV_ENERGY_SCARCITY_PRICE;
+    return served;
   }
 
-  e->renewable_fraction = (e->total_capacity_mw > 0)
-    ? renewable_capacity / e->total_capacity_mw : 0.0;
+  int k = curve_position(e, served);
+  /* Below min(old, k) plants stay flat out and above max(old, k) idle */
+  int lo = 0, hi = e->curve_count - 1;
+  if (e->marginal >= 0) {
+    lo = MIN(e->marginal, k);
+    hi = MAX(e->marginal, k);
+  }
+  for (int r = lo; r <= hi; r++) {
+    civ_power_plant_t *p = &e->plants[e->merit[r]];
+    if (r < k) p->current_output_mw = e->merit_cum[r] - (r > 0 ? e->merit_cum[r - 1] : 0.0);
+    else if (r > k) p->current_output_mw = 0.0;
+    else p->current_output_mw = served - (r > 0 ? e->merit_cum[r - 1] : 0.0);
+  }
+  e->marginal = k;
+  e->clearing_price = e->blackout ? CIV_ENERGY_SCARCITY_PRICE
+                                  : e->plants[e->merit[k]].cost_per_mwh;
+  return served;
+}
 
-  /* Blackout risk: demand > supply * reliability */
-  civ_float_t effective_supply = e->total_capacity_mw * e->grid_reliability;
-  e->blackout = (e->total_demand_mw > effective_supply);
+void civ_energy_update(civ_energy_system_t *e, civ_float_t time_delta,
+                       civ_float_t population, civ_float_t industrial_output,
+                       civ_float_t tech_level, civ_float_t fuel_availability) {
+  if (!e) return;
+  (void)time_delta;
+
+  /* Demand: per-capita baseload + industrial */
+  e->total_demand_mw = population * 0.001 + industrial_output * 0.01;
+
+  /* Supply: the curve stands until its inputs move */
+  int32_t supply_q = (int32_t)lrint(fuel_availability * CIV_ENERGY_CURVE_QUANTUM);
+  int32_t tech_q = (int32_t)lrint(tech_level * CIV_ENERGY_CURVE_QUANTUM);
+  e->updates_since_curve++;
+  bool curve_ok = true;
+  if (!e->curve_built || e->converging || e->curve_plants != e->plant_revision ||
+      e->curve_fuel != e->fuel_revision || e->curve_supply_q != supply_q ||
+      e->curve_tech_q != tech_q) {
+    e->curve_supply_q = supply_q;
+    e->curve_tech_q = tech_q;
+    curve_ok = rebuild_curve(e, tech_level, fuel_availability);
+  }
+
+  /* Imports from the last joint clearing stand in for local plants. A
+     curve that could not grow keeps the last one, which covers only the
+     plants it was built for; outputs stand until the next rebuild. */
+  if (curve_ok)
+    civ_energy_dispatch(e, e->total_demand_mw - e->net_import_mw);
 
-  /* Energy price: supply/demand balance */
-  civ_float_t balance = (e->total_demand_mw > 0)
-    ? effective_supply / e->total_demand_mw : 2.0;
-  civ_float_t target_price = 100.0 / (balance + 0.2);
-  /* Renewables cheaper */
-  target_price *= (1.0 - e->renewable_fraction * 0.3);
-  /* Tech reduces cost */
-  target_price /= (1.0 + tech_level * 0.3);
-  e->energy_price += (target_price - e->energy_price) * 0.1;
+  /* Energy price follows the clearing price */
+  e->energy_price += (e->clearing_price - e->energy_price) * 0.1;
 
   /* Grid reliability: degrades without investment, tech improves */
   e->grid_reliability += (tech_level * 0.1 - (1.0 - e->grid_reliability) * 0.02) * 0.5;
   if (e->grid_reliability < 0.20) e->grid_reliability = 0.20;
   if (e->grid_reliability > 0.99) e->grid_reliability = 0.99;
 
-  /* Energy independence */
+  /* Energy independence: fuel supply, less what comes over the border */
   e->energy_independence = (e->total_capacity_mw > 0)
     ? 1.0 - (1.0 - fuel_availability) * 0.5 : 0.0;
+  if (e->net_import_mw > 0.0 && e->total_demand_mw > 0.0)
+    e->energy_independence *= 1.0 - MIN(e->net_import_mw / e->total_demand_mw, 1.0);
+}
+
+/* ── Interconnection ────────────────────────────────────────────────── */
+
+/* Marginal cost gap between the ends of a link carrying flow from a to b */
+static civ_float_t link_gap(const civ_energy_system_t *a, civ_float_t load_a,
+                            const civ_energy_system_t *b, civ_float_t load_b,
+                            civ_float_t flow) {
+  return civ_energy_marginal_cost_at(a, load_a + flow) -
+         civ_energy_marginal_cost_at(b, load_b - flow);
+}
+
+void civ_energy_clear_interconnected(civ_energy_system_t **grids, int grid_count,
+                                     civ_energy_link_t *links, int link_count) {
+  if (!grids || grid_count <= 0) return;
+  civ_float_t *exports = CIV_CALLOC((size_t)grid_count, sizeof(civ_float_t));
+  if (!exports) return;
+  for (int l = 0; l < link_count; l++) links[l].flow_mw = 0.0;
+
+  for (int round = 0; round < CIV_ENERGY_INTERCONNECT_ROUNDS; round++) {
+    for (int l = 0; l < link_count; l++) {
+      civ_energy_link_t *ln = &links[l];
+      if (ln->from < 0 || ln->from >= grid_count || ln->to < 0 ||
+          ln->to >= grid_count || ln->from == ln->to)
+        continue;
+      civ_energy_system_t *a = grids[ln->from], *b = grids[ln->to];
+      if (!a || !b) continue;
+
+      /* Loads without this link; the gap rises with flow from a to b */
+      exports[ln->from] -= ln->flow_mw;
+      exports[ln->to] += ln->flow_mw;
+      civ_float_t load_a = a->total_demand_mw + exports[ln->from];
+      civ_float_t load_b = b->total_demand_mw + exports[ln->to];
+      civ_float_t cap = MAX(ln->capacity_mw, 0.0);
+      /* Neither end ships past its own firm supply */
+      civ_float_t hi = MIN(cap, MAX(firm_supply(a) - load_a, 0.0));
+      civ_float_t lo = -MIN(cap, MAX(firm_supply(b) - load_b, 0.0));
+
+      civ_float_t flow;
+      if (link_gap(a, load_a, b, load_b, hi) <= 0.0) flow = hi;
+      else if (link_gap(a, load_a, b, load_b, lo) >= 0.0) flow = lo;
+      else {
+        for (int it = 0; it < 32; it++) {
+          civ_float_t mid = 0.5 * (lo + hi);
+          if (link_gap(a, load_a, b, load_b, mid) < 0.0) lo = mid;
+          else hi = mid;
+        }
+        flow = 0.5 * (lo + hi);
+      }
+      ln->flow_mw = flow;
+      exports[ln->from] += flow;
+      exports[ln->to] -= flow;
+    }
+  }
+
+  for (int g = 0; g < grid_count; g++) {
+    if (!grids[g]) continue;
+    grids[g]->net_import_mw = -exports[g];
+    civ_energy_dispatch(grids[g], grids[g]->total_demand_mw + exports[g]);
+  }
+  CIV_FREE(exports);
 }
 
 civ_power_plant_t *civ_energy_add_plant(civ_energy_system_t *e, civ_energy_source_t source,
@@ -96,12 +281,35 @@ civ_power_plant_t *civ_energy_add_plant(civ_energy_system_t *e, civ_energy_sourc
   p->capacity_mw = capacity;
   p->efficiency = efficiency;
   p->is_renewable = (source >= CIV_ENERGY_SOLAR);
-  p->cost_per_mwh = p->is_renewable ? 40.0 : 60.0;
+  p->cost_per_mwh = k_operating_cost[source] +
+                    (p->is_renewable || efficiency <= 0.0 ? 0.0
+                                                          : e->fuel_price[source] / efficiency);
   p->carbon_intensity = p->is_renewable ? 0.01 : 0.8;
   e->plant_count++;
+  civ_energy_plants_changed(e);
   return p;
 }
 
+void civ_energy_plants_changed(civ_energy_system_t *e) {
+  if (!e) return;
+  e->plant_revision++;
+  civ_float_t total = 0.0, renewable = 0.0;
+  for (int i = 0; i < e->plant_count; i++) {
+    total += e->plants[i].capacity_mw;
+    if (e->plants[i].is_renewable) renewable += e->plants[i].capacity_mw;
+  }
+  e->total_capacity_mw = total;
+  e->renewable_fraction = total > 0 ? renewable / total : 0.0;
+}
+
+void civ_energy_set_fuel_price(civ_energy_system_t *e, civ_energy_source_t source,
+                               civ_float_t price) {
+  if (!e || source < 0 || source >= CIV_ENERGY_TYPE_COUNT) return;
+  if (e->fuel_price[source] == price) return;
+  e->fuel_price[source] = price;
+  e->fuel_revision++;
+}
+
 civ_float_t civ_energy_surplus(const civ_energy_system_t *e) {
   if (!e) return 0.0;
   return e->total_capacity_mw - e->total_demand_mw;
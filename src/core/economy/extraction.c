@@ -18,55 +18,101 @@ civ_extraction_system_t *civ_extraction_create(void) {
 
 void civ_extraction_destroy(civ_extraction_system_t *e) {
   if (!e) return;
+  CIV_FREE(e->active.deposit);
+  CIV_FREE(e->active.richness);
+  CIV_FREE(e->active.rate);
+  CIV_FREE(e->active.site);
+  for (int t = 0; t < CIV_RESOURCE_COUNT; t++) CIV_FREE(e->opened[t]);
   free(e->sites);
   free(e);
 }
 
+static bool reserve_active(civ_extraction_active_t *a, int want) {
+  if (want <= a->capacity) return true;
+  int nc = a->capacity ? a->capacity * 2 : CIV_EXTRACT_INITIAL_SITE_CAP;
+  while (nc < want) nc *= 2;
+  civ_float_t *deposit = CIV_REALLOC(a->deposit, sizeof(civ_float_t) * nc);
+  if (!deposit) return false;
+  a->deposit = deposit;
+  civ_float_t *richness = CIV_REALLOC(a->richness, sizeof(civ_float_t) * nc);
+  if (!richness) return false;
+  a->richness = richness;
+  civ_float_t *rate = CIV_REALLOC(a->rate, sizeof(civ_float_t) * nc);
+  if (!rate) return false;
+  a->rate = rate;
+  int32_t *site = CIV_REALLOC(a->site, sizeof(int32_t) * nc);
+  if (!site) return false;
+  a->site = site;
+  a->capacity = nc;
+  return true;
+}
+
+/* Swap slot out of the active arrays and archive its site */
+static void archive(civ_extraction_system_t *e, int slot,
+                    civ_resource_map_t *rm, civ_map_t *map) {
+  civ_extraction_active_t *a = &e->active;
+  civ_extraction_site_t *s = &e->sites[a->site[slot]];
+  s->final_deposit = MAX(a->deposit[slot], 0.0);
+  s->depleted = true;
+  s->slot = -1;
+  if (s->deposit_type != CIV_EXTRACT_NO_DEPOSIT && rm)
+    civ_resource_map_deplete(rm, (civ_resource_type_t)s->deposit_type,
+                             (uint16_t)s->deposit);
+  /* The economic view and minimap read the deposit through the region */
+  if (map && s->tile < (uint32_t)map->width * (uint32_t)map->height)
+    civ_map_touch_tile(map, s->tile);
+
+  int last = --a->count;
+  if (slot != last) {
+    a->deposit[slot] = a->deposit[last];
+    a->richness[slot] = a->richness[last];
+    a->rate[slot] = a->rate[last];
+    a->site[slot] = a->site[last];
+    e->sites[a->site[slot]].slot = slot;
+  }
+}
+
 void civ_extraction_update(civ_extraction_system_t *e, civ_float_t time_delta,
                            civ_float_t tech_level, civ_float_t labor_available,
-                           civ_float_t geography_mineral_richness) {
+                           civ_resource_map_t *rm, civ_map_t *map) {
   if (!e) return;
   e->total_output = 0.0;
 
-  civ_float_t depletion_sum = 0.0;
-  for (int i = 0; i < e->site_count; i++) {
-    civ_extraction_site_t *s = &e->sites[i];
-    if (s->depleted) continue;
-
-    /* Efficiency from tech and labor */
-    s->efficiency = 0.3 + tech_level * 0.5 + (labor_available > 1000 ? 0.2 : 0.0);
-    if (s->efficiency > 1.0) s->efficiency = 1.0;
-
-    /* Extraction rate: deposit * efficiency * mineral richness */
-    s->extraction_rate = s->deposit_size * s->efficiency * 0.02
-                         * geography_mineral_richness * time_delta * 0.1;
-
-    /* Deplete the deposit */
-    s->deposit_size -= s->extraction_rate;
-    if (s->deposit_size <= 0) {
-      s->deposit_size = 0;
-      s->depleted = true;
-      s->extraction_rate = 0;
-    }
+  /* Efficiency from tech and labor, shared by every site */
+  e->efficiency = 0.3 + tech_level * 0.5 + (labor_available > 1000 ? 0.2 : 0.0);
+  if (e->efficiency > 1.0) e->efficiency = 1.0;
 
-    s->depletion_factor = (s->deposit_size > 0)
-      ? s->extraction_rate / s->deposit_size : 0.0;
-    depletion_sum += s->depletion_factor;
-    e->total_output += s->extraction_rate;
+  /* Extraction rate: deposit * efficiency * richness; the depletion share
+     of each site is rate / what it leaves */
+  civ_extraction_active_t *a = &e->active;
+  civ_float_t k = e->efficiency * 0.02 * time_delta * 0.1;
+  civ_float_t depletion_sum = 0.0, output = 0.0;
+  for (int i = 0; i < a->count; i++) {
+    civ_float_t rate = a->deposit[i] * a->richness[i] * k;
+    a->rate[i] = rate;
+    a->deposit[i] -= rate;
+    output += rate;
+    depletion_sum += a->deposit[i] > 0.0 ? rate / a->deposit[i] : 0.0;
   }
+  e->total_output = output;
+  int active = a->count;
+
+  /* Backwards, so a swapped-in site has already been checked */
+  for (int i = a->count - 1; i >= 0; i--)
+    if (a->deposit[i] < CIV_EXTRACT_EXHAUSTED) archive(e, i, rm, map);
 
   /* Sustainability: worsens with depletion, improves with renewable practices */
-  civ_float_t avg_depletion = (e->site_count > 0) ? depletion_sum / e->site_count : 0.0;
+  civ_float_t avg_depletion = (active > 0) ? depletion_sum / active : 0.0;
   e->sustainability_index += ((1.0 - avg_depletion * 10.0) - e->sustainability_index) * 0.05;
   if (e->sustainability_index < 0.0) e->sustainability_index = 0.0;
   if (e->sustainability_index > 1.0) e->sustainability_index = 1.0;
 }
 
-civ_extraction_site_t *civ_extraction_add_site(civ_extraction_system_t *e,
-                                               civ_extraction_type_t type,
-                                               const char *resource,
-                                               civ_float_t deposit_size) {
-  if (!e || !resource) return NULL;
+static civ_extraction_site_t *open_site(civ_extraction_system_t *e,
+                                        civ_extraction_type_t type,
+                                        const char *resource, uint32_t tile,
+                                        civ_float_t deposit_size,
+                                        civ_float_t richness) {
   if (e->site_count >= e->site_capacity) {
     int nc = e->site_capacity * 2;
     civ_extraction_site_t *tmp = CIV_REALLOC(e->sites, sizeof(civ_extraction_site_t) * nc);
@@ -74,26 +120,87 @@ civ_extraction_site_t *civ_extraction_add_site(civ_extraction_system_t *e,
     e->sites = tmp;
     e->site_capacity = nc;
   }
+  if (!reserve_active(&e->active, e->active.count + 1)) return NULL;
+
   civ_extraction_site_t *s = &e->sites[e->site_count];
   memset(s, 0, sizeof(*s));
   s->type = type;
   strncpy(s->resource, resource, STRING_SHORT_LEN - 1);
-  s->deposit_size = deposit_size;
+  s->tile = tile;
+  s->deposit_type = CIV_EXTRACT_NO_DEPOSIT;
+  s->deposit = CIV_EXTRACT_NO_DEPOSIT;
+  s->initial_deposit = deposit_size;
+
+  civ_extraction_active_t *a = &e->active;
+  s->slot = a->count;
+  a->deposit[a->count] = deposit_size;
+  a->richness[a->count] = richness;
+  a->rate[a->count] = 0.0;
+  a->site[a->count] = e->site_count;
+  a->count++;
   e->site_count++;
   return s;
 }
 
+civ_extraction_site_t *civ_extraction_add_site(civ_extraction_system_t *e,
+                                               civ_extraction_type_t type,
+                                               const char *resource,
+                                               uint32_t tile,
+                                               civ_float_t deposit_size) {
+  if (!e || !resource) return NULL;
+  return open_site(e, type, resource, tile, deposit_size,
+                   CIV_EXTRACT_SURFACE_RICHNESS);
+}
+
+int civ_extraction_open_deposits(civ_extraction_system_t *e,
+                                 const civ_resource_map_t *rm,
+                                 const civ_map_t *map, civ_owner_index_t owner) {
+  if (!e || !rm || !map || owner == CIV_OWNER_NONE) return 0;
+  int opened = 0;
+  for (int t = 0; t < CIV_RESOURCE_COUNT; t++) {
+    uint16_t n = rm->deposit_count[t];
+    if (n == 0 || !rm->deposits[t]) continue;
+    if (e->opened_count[t] < n) {
+      uint8_t *flags = CIV_REALLOC(e->opened[t], n);
+      if (!flags) continue;
+      memset(flags + e->opened_count[t], 0, n - e->opened_count[t]);
+      e->opened[t] = flags;
+      e->opened_count[t] = n;
+    }
+    for (uint16_t i = 0; i < n; i++) {
+      const civ_resource_deposit_t *d = &rm->deposits[t][i];
+      if (e->opened[t][i] || d->quantity == 0 ||
+          d->x >= (uint32_t)map->width || d->y >= (uint32_t)map->height)
+        continue;
+      size_t tile = (size_t)d->y * map->width + d->x;
+      if (civ_map_owner_at(map, tile) != owner) continue;
+      /* Richness 0.4 on the poorest ore up to 1.3 on the best */
+      civ_extraction_site_t *s = open_site(
+          e, CIV_EXTRACT_MINING, civ_resource_type_name((civ_resource_type_t)t),
+          (uint32_t)tile, d->quantity * CIV_EXTRACT_UNITS_PER_QTY,
+          0.4 + 0.9 * MIN(d->quality, 100) / 100.0);
+      if (!s) return opened;
+      s->deposit_type = t;
+      s->deposit = i;
+      e->opened[t][i] = 1;
+      opened++;
+    }
+  }
+  return opened;
+}
+
 civ_float_t civ_extraction_output_for(const civ_extraction_system_t *e, civ_extraction_type_t type) {
   if (!e) return 0.0;
   civ_float_t out = 0.0;
-  for (int i = 0; i < e->site_count; i++)
-    if (e->sites[i].type == type) out += e->sites[i].extraction_rate;
+  for (int i = 0; i < e->active.count; i++)
+    if (e->sites[e->active.site[i]].type == type) out += e->active.rate[i];
   return out;
 }
 
 civ_float_t civ_extraction_depletion_rate(const civ_extraction_system_t *e) {
-  if (!e || e->site_count == 0) return 0.0;
+  if (!e || e->active.count == 0) return 0.0;
   civ_float_t sum = 0.0;
-  for (int i = 0; i < e->site_count; i++) sum += e->sites[i].depletion_factor;
-  return sum / e->site_count;
+  for (int i = 0; i < e->active.count; i++)
+    if (e->active.deposit[i] > 0.0) sum += e->active.rate[i] / e->active.deposit[i];
+  return sum / e->active.count;
 }
@@ -4,6 +4,7 @@
  */
 #include "core/economy/financial_markets.h"
 #include "common.h"
+#include "utils/rng.h"
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -46,6 +47,23 @@ static const struct { const char *name, *unit; float price, volatility; } s_comm
   {"Sugar","tonne",550.0f,0.022f},{"Rice","tonne",420.0f,0.015f},
 };
 
+/* Slot in iso_index, or -1 for codes that are not three capital letters */
+static int iso_slot(const char *iso) {
+  if (!iso) return -1;
+  int slot = 0;
+  for (int k = 0; k < 3; k++) {
+    if (iso[k] < 'A' || iso[k] > 'Z') return -1;
+    slot = slot * 26 + (iso[k] - 'A');
+  }
+  return iso[3] == '\0' ? slot : -1;
+}
+
+static void register_iso(civ_market_engine_t *m, int index) {
+  int slot = iso_slot(m->currencies[index].iso);
+  if (slot >= 0 && m->iso_index[slot] == 0)
+    m->iso_index[slot] = (int16_t)(index + 1);
+}
+
 civ_market_engine_t *civ_market_create(void) {
   civ_market_engine_t *m = (civ_market_engine_t *)malloc(sizeof(civ_market_engine_t));
   if (!m) return NULL; memset(m, 0, sizeof(*m));
@@ -60,6 +78,7 @@ civ_market_engine_t *civ_market_create(void) {
     c->current_rate = s_currency_defs[i].base_rate;
     c->volatility = s_currency_defs[i].volatility;
     c->inflation = 0.02f;
+    register_iso(m, i);
   }
   int ncom = sizeof(s_commodity_defs)/sizeof(s_commodity_defs[0]);
   m->commodity_count = ncom < 12 ? ncom : 12;
@@ -71,10 +90,17 @@ civ_market_engine_t *civ_market_create(void) {
     co->volatility = s_commodity_defs[i].volatility;
     co->supply_index = 0.5f; co->demand_index = 0.5f;
   }
+  civ_market_refresh_rates(m);
   return m;
 }
 
-void civ_market_destroy(civ_market_engine_t *m) { free(m); }
+void civ_market_destroy(civ_market_engine_t *m) {
+  if (!m) return;
+  civ_company_registry_free(&m->companies);
+  free(m->currency_history);
+  free(m->cross_rates);
+  free(m);
+}
 
 civ_market_currency_t *civ_market_add_currency(civ_market_engine_t *m,
     const char *iso, const char *name, const char *symbol, float rate) {
@@ -85,6 +111,8 @@ civ_market_currency_t *civ_market_add_currency(civ_market_engine_t *m,
   strncpy(c->symbol, symbol, 3);
   c->base_rate = rate; c->current_rate = rate;
   c->volatility = 0.015f; c->inflation = 0.02f;
+  register_iso(m, m->currency_count - 1);
+  civ_market_refresh_rates(m);
   return c;
 }
 
@@ -96,8 +124,8 @@ void civ_market_apply_production(civ_market_engine_t *m,
   for (int i = 0; i < m->commodity_count; i++) {
     civ_commodity_t *co = &m->commodities[i];
     /* Base drift */
-    float ss = ((float)(rand()%100)/100.0f - 0.5f) * 0.03f;
-    float ds = ((float)(rand()%100)/100.0f - 0.5f) * 0.03f;
+    float ss = ((float)(civ_rand()%100)/100.0f - 0.5f) * 0.03f;
+    float ds = ((float)(civ_rand()%100)/100.0f - 0.5f) * 0.03f;
 
     /* Production-influenced adjustment */
     if (strcmp(co->name, "Wheat") == 0 || strcmp(co->name, "Corn") == 0 ||
@@ -129,19 +157,20 @@ void civ_market_apply_production(civ_market_engine_t *m,
   /* Currency rates: influenced by GDP */
   for (int i = 0; i < m->currency_count; i++) {
     civ_market_currency_t *c = &m->currencies[i];
-    float swing = ((float)(rand()%100)/100.0f - 0.5f) * c->volatility * 1.5f;
+    float swing = ((float)(civ_rand()%100)/100.0f - 0.5f) * c->volatility * 1.5f;
     c->current_rate *= (1.0f + swing);
     c->current_rate *= (1.0f + c->inflation * 0.001f);
     if (c->current_rate < c->base_rate * 0.5f) c->current_rate = c->base_rate * 0.5f;
     if (c->current_rate > c->base_rate * 3.0f) c->current_rate = c->base_rate * 3.0f;
   }
+  civ_market_refresh_rates(m);
 }
 
 void civ_market_update(civ_market_engine_t *m) {
   if (!m) return;
   for (int i = 0; i < m->currency_count; i++) {
     civ_market_currency_t *c = &m->currencies[i];
-    float swing = ((float)(rand()%100)/100.0f - 0.5f) * c->volatility * 2.0f;
+    float swing = ((float)(civ_rand()%100)/100.0f - 0.5f) * c->volatility * 2.0f;
     c->current_rate *= (1.0f + swing);
     c->current_rate *= (1.0f + c->inflation * 0.001f);
     if (c->current_rate < c->base_rate * 0.5f) c->current_rate = c->base_rate * 0.5f;
@@ -149,8 +178,8 @@ void civ_market_update(civ_market_engine_t *m) {
   }
   for (int i = 0; i < m->commodity_count; i++) {
     civ_commodity_t *co = &m->commodities[i];
-    float ss = ((float)(rand()%100)/100.0f - 0.5f) * 0.05f;
-    float ds = ((float)(rand()%100)/100.0f - 0.5f) * 0.05f;
+    float ss = ((float)(civ_rand()%100)/100.0f - 0.5f) * 0.05f;
+    float ds = ((float)(civ_rand()%100)/100.0f - 0.5f) * 0.05f;
     co->supply_index += ss; co->demand_index += ds;
     if (co->supply_index < 0.1f) co->supply_index = 0.1f;
     if (co->supply_index > 0.9f) co->supply_index = 0.9f;
@@ -159,21 +188,89 @@ void civ_market_update(civ_market_engine_t *m) {
     float pm = (co->demand_index - co->supply_index) * co->volatility;
     co->price_per_unit *= (1.0f + pm);
   }
+  civ_market_refresh_rates(m);
 }
 
-civ_market_currency_t *civ_market_get_currency(civ_market_engine_t *m, const char *iso) {
-  if (!m || !iso) return NULL;
+void civ_market_record_history(civ_market_engine_t *m, int32_t turn) {
+  if (!m) return;
+  if (m->currency_history_count < m->currency_count) {
+    civ_price_history_t *grown = realloc(m->currency_history,
+        (size_t)m->currency_count * sizeof(civ_price_history_t));
+    if (grown) {
+      for (int i = m->currency_history_count; i < m->currency_count; i++)
+        civ_price_history_init(&grown[i]);
+      m->currency_history = grown;
+      m->currency_history_count = m->currency_count;
+    }
+  }
+  for (int i = 0; i < m->currency_history_count; i++)
+    civ_price_history_record(&m->currency_history[i], turn,
+                             m->currencies[i].current_rate);
+  for (int i = 0; i < m->commodity_count && i < 12; i++)
+    civ_price_history_record(&m->commodity_history[i], turn,
+                             m->commodities[i].price_per_unit);
+}
+
+const civ_price_history_t *civ_market_currency_history(const civ_market_engine_t *m,
+                                                       int index) {
+  if (!m || index < 0 || index >= m->currency_history_count) return NULL;
+  return &m->currency_history[index];
+}
+
+const civ_price_history_t *civ_market_commodity_history(const civ_market_engine_t *m,
+                                                        int index) {
+  if (!m || index < 0 || index >= m->commodity_count || index >= 12) return NULL;
+  return &m->commodity_history[index];
+}
+
+int civ_market_currency_index(const civ_market_engine_t *m, const char *iso) {
+  if (!m || !iso) return -1;
+  int slot = iso_slot(iso);
+  if (slot >= 0) {
+    int index = m->iso_index[slot] - 1;
+    if (index >= 0 && index < m->currency_count) return index;
+    return -1;
+  }
   for (int i = 0; i < m->currency_count; i++)
-    if (strcmp(m->currencies[i].iso, iso) == 0) return &m->currencies[i];
-  return NULL;
+    if (strcmp(m->currencies[i].iso, iso) == 0) return i;
+  return -1;
+}
+
+civ_market_currency_t *civ_market_get_currency(civ_market_engine_t *m, const char *iso) {
+  int index = civ_market_currency_index(m, iso);
+  return index >= 0 ? &m->currencies[index] : NULL;
+}
+
+void civ_market_refresh_rates(civ_market_engine_t *m) {
+  if (!m) return;
+  int n = m->currency_count;
+  for (int i = 0; i < n; i++)
+    m->to_ref[i] = 1.0f / m->currencies[i].current_rate;
+
+  if (n > m->cross_rate_capacity) {
+    float *grown = realloc(m->cross_rates, (size_t)n * (size_t)n * sizeof(float));
+    if (!grown) {
+      m->cross_rate_count = 0;  /* conversions fall back to to_ref */
+      return;
+    }
+    m->cross_rates = grown;
+    m->cross_rate_capacity = n;
+  }
+  for (int i = 0; i < n; i++) {
+    float *row = m->cross_rates + (size_t)i * (size_t)n;
+    for (int j = 0; j < n; j++) row[j] = m->to_ref[i] * m->currencies[j].current_rate;
+  }
+  m->cross_rate_count = n;
 }
 
 float civ_market_exchange(civ_market_engine_t *m, const char *from, const char *to, float amt) {
   if (!m || !from || !to) return amt;
-  civ_market_currency_t *fc = civ_market_get_currency(m, from);
-  civ_market_currency_t *tc = civ_market_get_currency(m, to);
-  if (!fc || !tc) return amt;
-  return (amt / fc->current_rate) * tc->current_rate;
+  int fi = civ_market_currency_index(m, from);
+  int ti = civ_market_currency_index(m, to);
+  if (fi < 0 || ti < 0) return amt;
+  if (fi < m->cross_rate_count && ti < m->cross_rate_count)
+    return amt * m->cross_rates[(size_t)fi * (size_t)m->cross_rate_count + (size_t)ti];
+  return amt * m->to_ref[fi] * m->currencies[ti].current_rate;
 }
 
 void civ_wallet_init(civ_wallet_t *w) { memset(w, 0, sizeof(*w)); }
@@ -218,8 +315,8 @@ bool civ_wallet_exchange(civ_wallet_t *w, civ_market_engine_t *m,
 float civ_wallet_total(civ_wallet_t *w, civ_market_engine_t *m) {
   if (!w || !m) return 0; float total = 0;
   for (int i = 0; i < w->count; i++) {
-    civ_market_currency_t *c = civ_market_get_currency(m, w->slots[i].currency_iso);
-    if (c) total += w->slots[i].balance / c->current_rate;
+    int ci = civ_market_currency_index(m, w->slots[i].currency_iso);
+    if (ci >= 0) total += w->slots[i].balance * m->to_ref[ci];
   }
   return total;
 }
@@ -239,30 +336,30 @@ float civ_market_dynamic_price(civ_market_engine_t *m, float base_price,
 }
 
 void civ_market_generate_companies(civ_market_engine_t *m, const char *nation_id) {
-  if (!m || m->company_count >= CIV_COMPANY_MAX) return;
+  if (!m || !nation_id || !nation_id[0]) return;
   const char *industries[] = {"Agriculture","Technology","Finance","Manufacturing",
       "Retail","Energy","Healthcare","Construction","Transport","Media"};
   const char *city_sfx[] = {"Capital","Metro","Holdings","Group","Industries",
       "Corp","Exchange","Enterprises","Ventures","Partners"};
-  for (int i = 0; i < 8 && m->company_count < CIV_COMPANY_MAX; i++) {
-    civ_company_t *co = &m->companies[m->company_count++];
+  for (int i = 0; i < 8; i++) {
     int si = ((int)(unsigned char)nation_id[0] * 31 +
               (int)(unsigned char)nation_id[1] * 7 + i * 13) % 10;
     if (si < 0) si = -si;
-    snprintf(co->name, sizeof(co->name), "%s %s %s", nation_id, industries[i%10], city_sfx[si]);
-    snprintf(co->industry, sizeof(co->industry), "%s", industries[i%10]);
-    snprintf(co->nation_id, sizeof(co->nation_id), "%s", nation_id);
-    co->employees = 50 + (rand() % 5000);
-    co->revenue = co->employees * (500.0f + (rand() % 5000));
-    co->stock_price = (i%3==0) ? (10.0f + (rand()%200)) : 0.0f;
-    co->is_public = (i%3==0);
-    co->growth_rate = ((rand()%2000)/100.0f - 5.0f)/100.0f;
+    char name[CIV_COMPANY_NAME];
+    snprintf(name, sizeof(name), "%s %s %s", nation_id, industries[i%10], city_sfx[si]);
+    int32_t employees = 50 + (civ_rand() % 5000);
+    float revenue = employees * (500.0f + (civ_rand() % 5000));
+    float stock_price = (i%3==0) ? (10.0f + (civ_rand()%200)) : 0.0f;
+    float growth_rate = ((civ_rand()%2000)/100.0f - 5.0f)/100.0f;
+    civ_company_registry_add(&m->companies, name, nation_id, industries[i%10],
+                             employees, revenue, stock_price, growth_rate);
   }
 }
 
-civ_company_t *civ_market_get_company(civ_market_engine_t *m, int idx) {
-  if (!m || idx<0||idx>=m->company_count) return NULL;
-  return &m->companies[idx];
+bool civ_market_get_company(const civ_market_engine_t *m, int idx,
+                            civ_company_t *out) {
+  if (!m || idx < 0) return false;
+  return civ_company_registry_get(&m->companies, (uint32_t)idx, out);
 }
 
 float civ_market_cost_of_living(civ_market_engine_t *m, const char *iso) {
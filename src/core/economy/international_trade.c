@@ -4,6 +4,7 @@
  */
 
 #include "core/economy/international_trade.h"
+#include "utils/rng.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -15,6 +16,7 @@ civ_trade_manager_create(civ_currency_manager_t *currency_mgr) {
     manager->route_count = 0;
     manager->route_capacity = 0;
     manager->currency_manager = currency_mgr;
+    manager->network = NULL;
   }
   return manager;
 }
@@ -26,36 +28,67 @@ void civ_trade_manager_destroy(civ_trade_manager_t *manager) {
   }
 }
 
-civ_result_t civ_trade_establish_route(civ_trade_manager_t *manager,
-                                       const char *source, const char *target,
-                                       const char *resource,
-                                       civ_float_t amount) {
-  if (!manager || !source || !target)
-    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Invalid args"};
-
+static civ_trade_route_t *push_route(civ_trade_manager_t *manager,
+                                     const char *source, const char *target,
+                                     const char *resource,
+                                     civ_float_t amount) {
   if (manager->route_count >= manager->route_capacity) {
     size_t new_cap =
         manager->route_capacity == 0 ? 8 : manager->route_capacity * 2;
     civ_trade_route_t *new_arr =
         CIV_REALLOC(manager->routes, new_cap * sizeof(civ_trade_route_t));
     if (!new_arr)
-      return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
+      return NULL;
     manager->routes = new_arr;
     manager->route_capacity = new_cap;
   }
 
   civ_trade_route_t *route = &manager->routes[manager->route_count++];
-  snprintf(route->id, STRING_SHORT_LEN, "trade_%ld", (long)time(NULL));
+  memset(route, 0, sizeof(*route));
+  snprintf(route->id, STRING_SHORT_LEN, "trade_%ld_%zu", (long)time(NULL),
+           manager->route_count - 1);
   strncpy(route->source_nation_id, source, STRING_SHORT_LEN - 1);
   strncpy(route->target_nation_id, target, STRING_SHORT_LEN - 1);
-  strncpy(route->resource_type, resource, STRING_SHORT_LEN - 1);
+  if (resource)
+    strncpy(route->resource_type, resource, STRING_SHORT_LEN - 1);
 
   route->amount = amount;
   route->value_per_unit = 10.0f; // Base value
   route->tariff_rate = 0.05f;    // 5% default tariff
   route->active = true;
   route->established_date = time(NULL);
+  route->network_route = -1;
+  return route;
+}
 
+civ_result_t civ_trade_establish_route(civ_trade_manager_t *manager,
+                                       const char *source, const char *target,
+                                       const char *resource,
+                                       civ_float_t amount) {
+  if (!manager || !source || !target)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Invalid args"};
+  if (!push_route(manager, source, target, resource, amount))
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
+  return (civ_result_t){CIV_OK, "Trade route established"};
+}
+
+civ_result_t civ_trade_establish_map_route(civ_trade_manager_t *manager,
+                                           const char *source,
+                                           const char *target,
+                                           const char *resource,
+                                           civ_float_t amount, int32_t from_x,
+                                           int32_t from_y, int32_t to_x,
+                                           int32_t to_y) {
+  if (!manager || !source || !target)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Invalid args"};
+  civ_trade_route_t *route = push_route(manager, source, target, resource, amount);
+  if (!route)
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
+  route->on_map = true;
+  route->from_x = from_x;
+  route->from_y = from_y;
+  route->to_x = to_x;
+  route->to_y = to_y;
   return (civ_result_t){CIV_OK, "Trade route established"};
 }
 
@@ -67,31 +100,77 @@ civ_result_t civ_trade_cancel_route(civ_trade_manager_t *manager,
   for (size_t i = 0; i < manager->route_count; i++) {
     if (strcmp(manager->routes[i].id, route_id) == 0) {
       manager->routes[i].active = false;
+      if (manager->network && manager->routes[i].network_route >= 0)
+        civ_trade_network_cancel_route(manager->network,
+                                       manager->routes[i].network_route);
       return (civ_result_t){CIV_OK, "Trade route cancelled"};
     }
   }
   return (civ_result_t){CIV_ERROR_NOT_FOUND, "Route not found"};
 }
 
+void civ_trade_manager_set_network(civ_trade_manager_t *manager,
+                                   civ_trade_network_t *network) {
+  if (!manager)
+    return;
+  manager->network = network;
+  for (size_t i = 0; i < manager->route_count; i++) {
+    manager->routes[i].network_route = -1;
+    manager->routes[i].network_revenue = 0.0f;
+  }
+}
+
 void civ_trade_update(civ_trade_manager_t *manager, civ_float_t time_delta) {
   if (!manager)
     return;
 
   // Update logic: Fluctuations in value, random disruptions
   for (size_t i = 0; i < manager->route_count; i++) {
-    if (!manager->routes[i].active)
+    civ_trade_route_t *route = &manager->routes[i];
+    if (!route->active)
       continue;
 
     // Random value fluctuation
-    civ_float_t fluctuation = ((rand() % 100) - 50) / 1000.0f; // -0.05 to 0.05
-    manager->routes[i].value_per_unit *= (1.0f + fluctuation);
-    if (manager->routes[i].value_per_unit < 1.0f)
-      manager->routes[i].value_per_unit = 1.0f;
+    civ_float_t fluctuation = ((civ_rand() % 100) - 50) / 1000.0f; // -0.05 to 0.05
+    route->value_per_unit *= (1.0f + fluctuation);
+    if (route->value_per_unit < 1.0f)
+      route->value_per_unit = 1.0f;
+
+    if (!route->on_map || !manager->network)
+      continue;
+    civ_trade_network_t *net = manager->network;
+    if (route->network_route < 0) {
+      uint32_t from = civ_trade_network_node_at(net, route->from_x, route->from_y);
+      uint32_t to = civ_trade_network_node_at(net, route->to_x, route->to_y);
+      if (from == CIV_TRADE_NO_NODE || to == CIV_TRADE_NO_NODE)
+        continue;
+      route->network_route = civ_trade_network_add_route(
+          net, from, to, (float)route->amount, (float)route->value_per_unit,
+          (float)route->tariff_rate);
+    } else {
+      /* Value and tariff only price the route; the path stays cached */
+      civ_trade_network_route_t *nr = &net->routes[route->network_route];
+      nr->value_per_unit = (float)route->value_per_unit;
+      nr->tariff_rate = (float)route->tariff_rate;
+    }
+  }
+}
+
+void civ_trade_collect_network(civ_trade_manager_t *manager) {
+  if (!manager || !manager->network)
+    return;
+  for (size_t i = 0; i < manager->route_count; i++) {
+    civ_trade_route_t *route = &manager->routes[i];
+    if (route->network_route >= 0)
+      route->network_revenue =
+          manager->network->routes[route->network_route].revenue;
   }
 }
 
 civ_float_t civ_trade_calculate_revenue(const civ_trade_route_t *route) {
   if (!route || !route->active)
     return 0.0f;
+  if (route->on_map)
+    return route->network_revenue;
   return route->amount * route->value_per_unit * (1.0f - route->tariff_rate);
 }
@@ -8,7 +8,7 @@ civ_labor_market_t *civ_labor_market_create(void) {
   civ_labor_market_t *l = CIV_MALLOC(sizeof(civ_labor_market_t));
   if (!l) return NULL;
   memset(l, 0, sizeof(*l));
-  l->labor_force_participation = 0.62;
+  l->labor_force_participation = 0.85;
   l->avg_wage_national = 30000.0;
   l->wage_inequality = 0.38;
   l->productivity_per_worker = 50000.0;
@@ -27,13 +27,13 @@ civ_labor_market_t *civ_labor_market_create(void) {
 void civ_labor_market_destroy(civ_labor_market_t *l) { free(l); }
 
 void civ_labor_market_update(civ_labor_market_t *l, civ_float_t time_delta,
-                             int total_population, civ_float_t gdp,
+                             int working_age_population, civ_float_t gdp,
                              civ_float_t tech_level, civ_float_t education_level,
                              civ_float_t business_confidence) {
   if (!l) return;
   (void)time_delta;
 
-  l->total_workforce = (int)(total_population * l->labor_force_participation);
+  l->total_workforce = (int)(working_age_population * l->labor_force_participation);
 
   /* Distribute workforce across tiers based on education */
   civ_float_t tier_dist[CIV_LABOR_TIER_COUNT];
@@ -9,6 +9,48 @@
 #include <string.h>
 
 #define CIV_TAX_INITIAL_BRACKET_CAP 8
+#define CIV_TAX_DEFAULT_DISPERSION  0.8
+
+/* Standard normal quantiles at the bucket midpoints (k + 0.5) / 16 */
+static const double k_bucket_z[CIV_TAX_INCOME_BUCKETS] = {
+  -1.862732, -1.318011, -1.009990, -0.776422, -0.579132, -0.402250,
+  -0.237202, -0.078412,  0.078412,  0.237202,  0.402250,  0.579132,
+   0.776422,  1.009990,  1.318011,  1.862732,
+};
+
+/* Mean absolute difference over twice the mean; buckets hold equal shares */
+static civ_float_t bucket_gini(const civ_float_t *x) {
+  civ_float_t sum = 0.0, diff = 0.0;
+  for (int i = 0; i < CIV_TAX_INCOME_BUCKETS; i++) {
+    sum += x[i];
+    for (int j = 0; j < CIV_TAX_INCOME_BUCKETS; j++)
+      diff += fabs(x[i] - x[j]);
+  }
+  return sum > 0.0 ? diff / (2.0 * CIV_TAX_INCOME_BUCKETS * sum) : 0.0;
+}
+
+/* base[i] is the tax owed on income up to bracket i's start, so a lookup is
+   one count of thresholds below the income */
+static void rebuild_bracket_table(civ_tax_policy_t *p) {
+  if (!p->bracket_base) return;
+  civ_float_t prev = 0.0;
+  p->bracket_base[0] = 0.0;
+  for (int i = 0; i < p->bracket_count; i++) {
+    p->bracket_base[i + 1] =
+        p->bracket_base[i] + (p->brackets[i].threshold - prev) * p->brackets[i].rate;
+    prev = p->brackets[i].threshold;
+  }
+}
+
+static civ_float_t table_tax(const civ_tax_policy_t *p, civ_float_t income) {
+  if (income <= 0.0 || p->bracket_count == 0) return 0.0;
+  int j = 0;
+  for (int i = 0; i < p->bracket_count; i++)
+    j += p->brackets[i].threshold < income;
+  civ_float_t start = j > 0 ? p->brackets[j - 1].threshold : 0.0;
+  civ_float_t rate = p->brackets[MIN(j, p->bracket_count - 1)].rate;
+  return p->bracket_base[j] + (income - start) * rate;
+}
 
 civ_taxation_system_t *civ_taxation_create(void) {
   civ_taxation_system_t *t = CIV_MALLOC(sizeof(civ_taxation_system_t));
@@ -28,6 +70,10 @@ civ_taxation_system_t *civ_taxation_create(void) {
   t->policies[CIV_TAX_INCOME].active = true;
   t->policies[CIV_TAX_INCOME].bracket_capacity = CIV_TAX_INITIAL_BRACKET_CAP;
   t->policies[CIV_TAX_INCOME].brackets = CIV_MALLOC(sizeof(civ_tax_bracket_t) * CIV_TAX_INITIAL_BRACKET_CAP);
+  t->policies[CIV_TAX_INCOME].bracket_base =
+      CIV_CALLOC(CIV_TAX_INITIAL_BRACKET_CAP + 1, sizeof(civ_float_t));
+  if (!t->policies[CIV_TAX_INCOME].brackets || !t->policies[CIV_TAX_INCOME].bracket_base)
+    t->policies[CIV_TAX_INCOME].bracket_capacity = 0;
 
   /* Corporate tax */
   t->policies[CIV_TAX_CORPORATE].active = true;
@@ -37,6 +83,8 @@ civ_taxation_system_t *civ_taxation_create(void) {
   t->policies[CIV_TAX_SALES].active = true;
   t->policies[CIV_TAX_SALES].flat_rate = 0.05;
 
+  civ_taxation_set_income_dispersion(t, CIV_TAX_DEFAULT_DISPERSION);
+  t->gini_coefficient = t->income.gini;
   return t;
 }
 
@@ -44,6 +92,7 @@ void civ_taxation_destroy(civ_taxation_system_t *t) {
   if (!t) return;
   for (int i = 0; i < CIV_TAX_TYPE_COUNT; i++) {
     free(t->policies[i].brackets);
+    free(t->policies[i].bracket_base);
   }
   free(t);
 }
@@ -70,11 +119,22 @@ void civ_taxation_update(civ_taxation_system_t *t,
   civ_float_t revenue = 0.0;
   civ_float_t per_capita_gdp = (population > 0) ? total_gdp / population : 0.0;
 
-  /* Income tax: apply brackets to per-capita GDP, then scale by population */
-  if (t->policies[CIV_TAX_INCOME].active && t->policies[CIV_TAX_INCOME].bracket_count > 0) {
-    civ_float_t avg_income_tax = civ_taxation_calculate_income_tax(t, per_capita_gdp);
-    revenue += avg_income_tax * population * t->policies[CIV_TAX_INCOME].collection_efficiency
-               * (1.0 - t->policies[CIV_TAX_INCOME].evasion_rate);
+  /* Income tax: spread per-capita GDP over the buckets, tax each from the
+     bracket table, and measure inequality on what is left */
+  const civ_tax_policy_t *income_tax = &t->policies[CIV_TAX_INCOME];
+  t->gini_coefficient = t->income.gini;
+  if (income_tax->active && income_tax->bracket_count > 0) {
+    civ_float_t after[CIV_TAX_INCOME_BUCKETS];
+    civ_float_t bucket_tax = 0.0;
+    for (int k = 0; k < CIV_TAX_INCOME_BUCKETS; k++) {
+      civ_float_t income = per_capita_gdp * t->income.relative[k];
+      civ_float_t tax = table_tax(income_tax, income);
+      bucket_tax += tax;
+      after[k] = income - tax;
+    }
+    revenue += bucket_tax * (population / CIV_TAX_INCOME_BUCKETS)
+               * income_tax->collection_efficiency * (1.0 - income_tax->evasion_rate);
+    if (per_capita_gdp > 0.0) t->gini_coefficient = bucket_gini(after);
   }
 
   /* Corporate tax: fraction of GDP */
@@ -114,14 +174,6 @@ void civ_taxation_update(civ_taxation_system_t *t,
 
   /* Tax burden: fraction of GDP taken as tax */
   t->tax_burden_index = (total_gdp > 0) ? (revenue / total_gdp) : 0.0;
-
-  /* Gini: simplified model from tax progressivity */
-  civ_float_t top_rate = t->policies[CIV_TAX_INCOME].bracket_count > 0
-    ? t->policies[CIV_TAX_INCOME].brackets[t->policies[CIV_TAX_INCOME].bracket_count - 1].rate
-    : 0.0;
-  t->gini_coefficient = 0.45 - (top_rate * 0.25); /* progressive tax reduces inequality */
-  if (t->gini_coefficient < 0.20) t->gini_coefficient = 0.20;
-  if (t->gini_coefficient > 0.65) t->gini_coefficient = 0.65;
 }
 
 void civ_taxation_set_policy(civ_taxation_system_t *t,
@@ -131,6 +183,7 @@ void civ_taxation_set_policy(civ_taxation_system_t *t,
   t->policies[type].flat_rate = flat_rate;
   if (flat_rate < 0.0) t->policies[type].flat_rate = 0.0;
   if (flat_rate > 1.0) t->policies[type].flat_rate = 1.0;
+  rebuild_bracket_table(&t->policies[type]);
 }
 
 void civ_taxation_add_bracket(civ_taxation_system_t *t,
@@ -141,10 +194,13 @@ void civ_taxation_add_bracket(civ_taxation_system_t *t,
   civ_tax_policy_t *p = &t->policies[type];
 
   if (p->bracket_count >= p->bracket_capacity) {
-    int new_cap = p->bracket_capacity * 2;
+    int new_cap = p->bracket_capacity ? p->bracket_capacity * 2 : CIV_TAX_INITIAL_BRACKET_CAP;
     civ_tax_bracket_t *tmp = CIV_REALLOC(p->brackets, sizeof(civ_tax_bracket_t) * new_cap);
     if (!tmp) return;
     p->brackets = tmp;
+    civ_float_t *base = CIV_REALLOC(p->bracket_base, sizeof(civ_float_t) * (new_cap + 1));
+    if (!base) return;
+    p->bracket_base = base;
     p->bracket_capacity = new_cap;
   }
 
@@ -158,6 +214,7 @@ void civ_taxation_add_bracket(civ_taxation_system_t *t,
   p->brackets[pos].threshold = threshold;
   p->brackets[pos].rate      = rate;
   p->bracket_count++;
+  rebuild_bracket_table(p);
 }
 
 void civ_taxation_toggle_tax(civ_taxation_system_t *t, civ_tax_type_t type, bool active) {
@@ -165,32 +222,25 @@ void civ_taxation_toggle_tax(civ_taxation_system_t *t, civ_tax_type_t type, bool
   t->policies[type].active = active;
 }
 
+void civ_taxation_set_income_dispersion(civ_taxation_system_t *t, civ_float_t sigma) {
+  if (!t) return;
+  sigma = CLAMP(sigma, 0.0, 3.0);
+  civ_float_t sum = 0.0;
+  for (int k = 0; k < CIV_TAX_INCOME_BUCKETS; k++) {
+    t->income.relative[k] = exp(sigma * k_bucket_z[k]);
+    sum += t->income.relative[k];
+  }
+  for (int k = 0; k < CIV_TAX_INCOME_BUCKETS; k++)
+    t->income.relative[k] *= CIV_TAX_INCOME_BUCKETS / sum;
+  t->income.dispersion = sigma;
+  t->income.gini = bucket_gini(t->income.relative);
+}
+
 civ_float_t civ_taxation_calculate_income_tax(const civ_taxation_system_t *t, civ_float_t income) {
   if (!t) return 0.0;
   const civ_tax_policy_t *p = &t->policies[CIV_TAX_INCOME];
-  if (!p->active || p->bracket_count == 0) return 0.0;
-
-  civ_float_t tax = 0.0;
-  civ_float_t prev_threshold = 0.0;
-
-  for (int i = 0; i < p->bracket_count; i++) {
-    civ_float_t bracket_income = income - prev_threshold;
-    if (bracket_income <= 0) break;
-
-    civ_float_t taxable_in_bracket = (income > p->brackets[i].threshold)
-      ? (p->brackets[i].threshold - prev_threshold)
-      : bracket_income;
-
-    tax += taxable_in_bracket * p->brackets[i].rate;
-    prev_threshold = p->brackets[i].threshold;
-  }
-
-  /* Top bracket catches remainder */
-  if (income > prev_threshold && p->bracket_count > 0) {
-    tax += (income - prev_threshold) * p->brackets[p->bracket_count - 1].rate;
-  }
-
-  return tax;
+  if (!p->active) return 0.0;
+  return table_tax(p, income);
 }
 
 civ_float_t civ_taxation_effective_tax_rate(const civ_taxation_system_t *t) {
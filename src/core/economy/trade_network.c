@@ -0,0 +1,817 @@
+/**
+ * @file trade_network.c
+ * @brief Map-based trade network — settlement graph, cached routes, shared capacity
+ */
+
+#include "core/economy/trade_network.h"
+#include "core/economy/econ_reduce.h"
+#include "common.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRADE_QUERY_MAX      64
+#define TRADE_LAND_CAPACITY  100.0f  /* volume per turn on an unpaved road */
+#define TRADE_SEA_CAPACITY   400.0f
+#define TRADE_COST_VALUE     0.001f  /* money per unit of volume per unit of cost */
+#define TRADE_INF            CIV_PATH_NO_PATH
+
+/* ── Binary heap of (key, node) ───────────────────────────────────── */
+
+typedef struct {
+  uint32_t key, node;
+} heap_entry_t;
+
+typedef struct {
+  heap_entry_t *items;
+  size_t count, capacity;
+} heap_t;
+
+static bool heap_push(heap_t *h, uint32_t key, uint32_t node) {
+  if (h->count >= h->capacity) {
+    size_t cap = h->capacity ? h->capacity * 2 : 64;
+    heap_entry_t *items = CIV_REALLOC(h->items, cap * sizeof(heap_entry_t));
+    if (!items) return false;
+    h->items = items;
+    h->capacity = cap;
+  }
+  size_t i = h->count++;
+  while (i > 0) {
+    size_t parent = (i - 1) / 2;
+    if (h->items[parent].key <= key) break;
+    h->items[i] = h->items[parent];
+    i = parent;
+  }
+  h->items[i] = (heap_entry_t){key, node};
+  return true;
+}
+
+static heap_entry_t heap_pop(heap_t *h) {
+  heap_entry_t top = h->items[0];
+  heap_entry_t last = h->items[--h->count];
+  size_t i = 0;
+  for (;;) {
+    size_t child = i * 2 + 1;
+    if (child >= h->count) break;
+    if (child + 1 < h->count && h->items[child + 1].key < h->items[child].key)
+      child++;
+    if (h->items[child].key >= last.key) break;
+    h->items[i] = h->items[child];
+    i = child;
+  }
+  if (h->count) h->items[i] = last;
+  return top;
+}
+
+static uint32_t add_cost(uint32_t a, uint32_t b) {
+  uint64_t sum = (uint64_t)a + b;
+  return sum >= TRADE_INF ? TRADE_INF - 1 : (uint32_t)sum;
+}
+
+/* ── Tile index ───────────────────────────────────────────────────── */
+
+static uint32_t tile_slot(uint32_t tile, uint32_t mask) {
+  return (tile * 2654435761u) & mask;
+}
+
+static uint32_t find_node(const civ_trade_network_t *net, uint32_t tile) {
+  if (!net->tile_slots) return CIV_TRADE_NO_NODE;
+  for (uint32_t h = tile_slot(tile, net->slot_mask); net->tile_slots[h];
+       h = (h + 1) & net->slot_mask) {
+    uint32_t node = net->tile_slots[h] - 1;
+    if (net->nodes[node].tile == tile) return node;
+  }
+  return CIV_TRADE_NO_NODE;
+}
+
+/* Indexes the first node on each tile, enough to tell settlement tiles */
+static bool index_tiles(civ_trade_network_t *net) {
+  uint32_t size = 32;
+  while (size < net->node_count * 2) size <<= 1;
+  uint32_t *slots = CIV_CALLOC(size, sizeof(uint32_t));
+  if (!slots) return false;
+  CIV_FREE(net->tile_slots);
+  net->tile_slots = slots;
+  net->slot_mask = size - 1;
+  for (uint32_t i = 0; i < net->node_count; i++) {
+    if (find_node(net, net->nodes[i].tile) != CIV_TRADE_NO_NODE) continue;
+    uint32_t h = tile_slot(net->nodes[i].tile, net->slot_mask);
+    while (slots[h]) h = (h + 1) & net->slot_mask;
+    slots[h] = i + 1;
+  }
+  return true;
+}
+
+/* ── Change collection ────────────────────────────────────────────── */
+
+static void mark_node_edges(civ_trade_network_t *net, uint32_t node) {
+  const civ_trade_node_t *n = &net->nodes[node];
+  if (!net->edge_refs) return;
+  for (uint32_t k = 0; k < n->edge_count; k++)
+    net->edges[net->edge_refs[n->first_edge + k]].dirty = true;
+}
+
+/* Only settlement tiles matter; update re-reads their owners */
+static void on_owner_change(void *user_data, const civ_map_t *map, size_t index,
+                            civ_owner_index_t old_owner,
+                            civ_owner_index_t new_owner) {
+  (void)map; (void)old_owner; (void)new_owner;
+  civ_trade_network_t *net = user_data;
+  if (find_node(net, (uint32_t)index) != CIV_TRADE_NO_NODE)
+    net->nodes_dirty = true;
+}
+
+civ_trade_network_t *civ_trade_network_create(civ_map_t *map,
+                                              civ_pathfinder_t *pathfinder) {
+  if (!map) return NULL;
+  civ_trade_network_t *net = CIV_CALLOC(1, sizeof(civ_trade_network_t));
+  if (!net) {
+    civ_log(CIV_LOG_ERROR, "Failed to allocate trade network");
+    return NULL;
+  }
+  net->map = map;
+  net->pathfinder = pathfinder;
+  net->landmarks_stale = true;
+  if (!civ_map_add_owner_listener(map, on_owner_change, net))
+    civ_log(CIV_LOG_WARNING, "Trade network: owner listener table full");
+  return net;
+}
+
+void civ_trade_network_destroy(civ_trade_network_t *net) {
+  if (!net) return;
+  civ_map_remove_owner_listener(net->map, on_owner_change, net);
+  for (uint32_t i = 0; i < net->route_count; i++)
+    CIV_FREE(net->routes[i].path);
+  CIV_FREE(net->routes);
+  CIV_FREE(net->landmark_dist);
+  CIV_FREE(net->edge_refs);
+  CIV_FREE(net->edges);
+  CIV_FREE(net->tile_slots);
+  CIV_FREE(net->nodes);
+  CIV_FREE(net);
+}
+
+void civ_trade_network_invalidate_all(civ_trade_network_t *net) {
+  if (!net) return;
+  for (uint32_t e = 0; e < net->edge_count; e++) {
+    net->edges[e].dirty = net->edges[e].base_dirty = true;
+    net->edges[e].path_ticket = CIV_PATH_TICKET_NONE; /* asked before the change */
+  }
+}
+
+void civ_trade_network_set_path_service(civ_trade_network_t *net,
+                                        civ_path_service_t *svc, int layer) {
+  if (!net) return;
+  net->path_service = layer >= 0 ? svc : NULL;
+  net->path_layer = layer;
+  for (uint32_t e = 0; e < net->edge_count; e++)
+    net->edges[e].path_ticket = CIV_PATH_TICKET_NONE;
+}
+
+void civ_trade_network_set_ocean(civ_trade_network_t *net,
+                                 const civ_ocean_regions_t *ocean) {
+  if (!net || net->ocean == ocean) return;
+  net->ocean = ocean;
+  for (uint32_t e = 0; e < net->edge_count; e++)
+    if (net->edges[e].kind == CIV_TRADE_EDGE_SEA)
+      net->edges[e].dirty = net->edges[e].base_dirty = true;
+}
+
+uint32_t civ_trade_network_node_at(const civ_trade_network_t *net,
+                                   int32_t x, int32_t y) {
+  if (!net || x < 0 || y < 0 || x >= net->map->width || y >= net->map->height)
+    return CIV_TRADE_NO_NODE;
+  return find_node(net, (uint32_t)(y * net->map->width + x));
+}
+
+/* ── Topology ─────────────────────────────────────────────────────── */
+
+static uint32_t settlement_tile(const civ_map_t *map, const civ_settlement_t *s) {
+  int32_t x = (int32_t)floorf((float)s->x), y = (int32_t)floorf((float)s->y);
+  x = ((x % map->width) + map->width) % map->width;
+  y = CLAMP(y, 0, map->height - 1);
+  return (uint32_t)(y * map->width + x);
+}
+
+static bool is_coastal(const civ_map_t *map, uint32_t tile) {
+  int32_t x = (int32_t)(tile % (uint32_t)map->width);
+  int32_t y = (int32_t)(tile / (uint32_t)map->width);
+  for (int dy = -1; dy <= 1; dy++) {
+    int32_t ny = y + dy;
+    if (ny < 0 || ny >= map->height) continue;
+    for (int dx = -1; dx <= 1; dx++) {
+      int32_t nx = (x + dx + map->width) % map->width;
+      if (civ_map_is_water_at(map, (size_t)(ny * map->width + nx))) return true;
+    }
+  }
+  return false;
+}
+
+/* Tile distance with x wrapping east-west */
+static float tile_distance(const civ_map_t *map, uint32_t a, uint32_t b) {
+  float dx = fabsf((float)(a % (uint32_t)map->width) - (float)(b % (uint32_t)map->width));
+  float dy = fabsf((float)(a / (uint32_t)map->width) - (float)(b / (uint32_t)map->width));
+  dx = MIN(dx, (float)map->width - dx);
+  return sqrtf(dx * dx + dy * dy);
+}
+
+static bool push_edge(civ_trade_network_t *net, uint32_t a, uint32_t b,
+                      civ_trade_edge_kind_t kind) {
+  if (net->edge_count >= net->edge_capacity) {
+    uint32_t cap = net->edge_capacity ? net->edge_capacity * 2 : 64;
+    civ_trade_edge_t *edges = CIV_REALLOC(net->edges, cap * sizeof(civ_trade_edge_t));
+    if (!edges) return false;
+    net->edges = edges;
+    net->edge_capacity = cap;
+  }
+  civ_trade_edge_t *e = &net->edges[net->edge_count++];
+  memset(e, 0, sizeof(*e));
+  e->a = MIN(a, b);
+  e->b = MAX(a, b);
+  e->kind = kind;
+  e->base_cost = e->cost = TRADE_INF;
+  e->dirty = e->base_dirty = true;
+  return true;
+}
+
+static int edge_order(const void *pa, const void *pb) {
+  const civ_trade_edge_t *x = pa, *y = pb;
+  if (x->a != y->a) return x->a < y->a ? -1 : 1;
+  if (x->b != y->b) return x->b < y->b ? -1 : 1;
+  return (int)x->kind - (int)y->kind;
+}
+
+/* Link each node to its nearest neighbours, by land and, for ports, by sea */
+static void collect_neighbours(civ_trade_network_t *net,
+                               const civ_settlement_manager_t *sm, uint32_t i,
+                               civ_trade_edge_kind_t kind) {
+  const civ_settlement_t *s = &sm->settlements[i];
+  int limit = kind == CIV_TRADE_EDGE_LAND ? CIV_TRADE_LAND_NEIGHBOURS
+                                          : CIV_TRADE_SEA_NEIGHBOURS;
+  float radius = kind == CIV_TRADE_EDGE_LAND ? CIV_TRADE_LAND_RADIUS
+                                             : CIV_TRADE_SEA_RADIUS;
+  size_t found[TRADE_QUERY_MAX];
+  size_t n = civ_settlement_manager_query_radius(sm, CIV_SETTLEMENT_ANY_OWNER,
+                                                 s->x, s->y, radius, found,
+                                                 TRADE_QUERY_MAX);
+  n = MIN(n, (size_t)TRADE_QUERY_MAX);
+
+  uint32_t best[CIV_TRADE_SEA_NEIGHBOURS];
+  float best_d[CIV_TRADE_SEA_NEIGHBOURS];
+  int best_n = 0;
+  for (size_t k = 0; k < n; k++) {
+    uint32_t j = (uint32_t)found[k];
+    if (j == i || j >= net->node_count) continue;
+    if (net->nodes[j].tile == net->nodes[i].tile) continue;
+    if (kind == CIV_TRADE_EDGE_SEA && !net->nodes[j].port) continue;
+    float d = tile_distance(net->map, net->nodes[i].tile, net->nodes[j].tile);
+    int at = best_n < limit ? best_n++ : limit;
+    while (at > 0 && best_d[at - 1] > d) {
+      if (at < limit) {
+        best[at] = best[at - 1];
+        best_d[at] = best_d[at - 1];
+      }
+      at--;
+    }
+    if (at < limit) {
+      best[at] = j;
+      best_d[at] = d;
+    }
+  }
+  for (int k = 0; k < best_n; k++)
+    push_edge(net, i, best[k], kind);
+}
+
+static void build_adjacency(civ_trade_network_t *net) {
+  CIV_FREE(net->edge_refs);
+  net->edge_refs = CIV_MALLOC((size_t)MAX(net->edge_count, 1) * 2 * sizeof(uint32_t));
+  for (uint32_t i = 0; i < net->node_count; i++)
+    net->nodes[i].edge_count = 0;
+  if (!net->edge_refs) return;
+  for (uint32_t e = 0; e < net->edge_count; e++) {
+    net->nodes[net->edges[e].a].edge_count++;
+    net->nodes[net->edges[e].b].edge_count++;
+  }
+  uint32_t next = 0;
+  for (uint32_t i = 0; i < net->node_count; i++) {
+    net->nodes[i].first_edge = next;
+    next += net->nodes[i].edge_count;
+    net->nodes[i].edge_count = 0;
+  }
+  for (uint32_t e = 0; e < net->edge_count; e++) {
+    civ_trade_node_t *a = &net->nodes[net->edges[e].a];
+    civ_trade_node_t *b = &net->nodes[net->edges[e].b];
+    net->edge_refs[a->first_edge + a->edge_count++] = e;
+    net->edge_refs[b->first_edge + b->edge_count++] = e;
+  }
+}
+
+/* Rebuild edges for the current nodes, keeping the base cost of edges that
+   already existed so only new pairs go to the pathfinder */
+static void rebuild_topology(civ_trade_network_t *net,
+                             const civ_settlement_manager_t *sm) {
+  civ_trade_edge_t *old = net->edges;
+  uint32_t old_count = net->edge_count;
+  net->edges = NULL;
+  net->edge_count = net->edge_capacity = 0;
+
+  for (uint32_t i = 0; i < net->node_count; i++) {
+    collect_neighbours(net, sm, i, CIV_TRADE_EDGE_LAND);
+    if (net->nodes[i].port) collect_neighbours(net, sm, i, CIV_TRADE_EDGE_SEA);
+  }
+
+  /* Sort, drop the pairs both ends proposed, then carry old base costs */
+  qsort(net->edges, net->edge_count, sizeof(civ_trade_edge_t), edge_order);
+  uint32_t kept = 0;
+  for (uint32_t e = 0; e < net->edge_count; e++) {
+    if (kept && edge_order(&net->edges[kept - 1], &net->edges[e]) == 0) continue;
+    civ_trade_edge_t *edge = &net->edges[kept++];
+    *edge = net->edges[e];
+    civ_trade_edge_t *prev = old_count
+        ? bsearch(edge, old, old_count, sizeof(civ_trade_edge_t), edge_order) : NULL;
+    if (prev && !prev->base_dirty) {
+      edge->base_cost = prev->base_cost;
+      edge->base_dirty = false;
+    } else if (prev) {
+      edge->path_ticket = prev->path_ticket; /* still being solved */
+    }
+  }
+  net->edge_count = kept;
+  CIV_FREE(old);
+
+  build_adjacency(net);
+  net->landmarks_stale = true;
+  for (uint32_t r = 0; r < net->route_count; r++) {
+    net->routes[r].reroute = true;
+    net->routes[r].path_length = 0;  /* edge indices changed */
+  }
+}
+
+void civ_trade_network_sync(civ_trade_network_t *net,
+                            const civ_settlement_manager_t *sm) {
+  if (!net || !sm) return;
+
+  uint32_t count = (uint32_t)sm->settlement_count;
+  if (count != net->node_count) {
+    civ_trade_node_t *nodes = CIV_REALLOC(net->nodes,
+        (size_t)MAX(count, 1) * sizeof(civ_trade_node_t));
+    if (!nodes) return;
+    net->nodes = nodes;
+    for (uint32_t i = net->node_count; i < count; i++) {
+      const civ_settlement_t *s = &sm->settlements[i];
+      civ_trade_node_t *n = &nodes[i];
+      memset(n, 0, sizeof(*n));
+      n->tile = settlement_tile(net->map, s);
+      n->owner = civ_map_owner_at(net->map, n->tile);
+      n->road_quality = (float)s->infrastructure.road_quality;
+      n->port_capacity = (float)s->infrastructure.port_capacity;
+      n->port = is_coastal(net->map, n->tile);
+    }
+    net->node_count = count;
+    index_tiles(net);
+    net->topology_dirty = true;
+  }
+
+  if (net->topology_dirty) {
+    rebuild_topology(net, sm);
+    net->topology_dirty = false;
+    net->nodes_dirty = true;
+  }
+
+  /* Infrastructure: settlements are read, never told, so compare */
+  for (uint32_t i = 0; i < net->node_count; i++) {
+    const civ_settlement_t *s = &sm->settlements[i];
+    civ_trade_node_t *n = &net->nodes[i];
+    if (n->road_quality != (float)s->infrastructure.road_quality ||
+        n->port_capacity != (float)s->infrastructure.port_capacity) {
+      n->road_quality = (float)s->infrastructure.road_quality;
+      n->port_capacity = (float)s->infrastructure.port_capacity;
+      mark_node_edges(net, i);
+    }
+  }
+}
+
+/* ── Edge pricing ─────────────────────────────────────────────────── */
+
+/* Land base costs through the path service: collect what the last apply
+   published and ask for the rest. An edge is re-priced once its answer
+   is in; a ticket whose results were replaced unread is asked again. */
+static void request_land_paths(civ_trade_network_t *net) {
+  for (uint32_t e = 0; e < net->edge_count; e++) {
+    civ_trade_edge_t *edge = &net->edges[e];
+    if (!edge->base_dirty || edge->kind != CIV_TRADE_EDGE_LAND) continue;
+    if (edge->path_ticket != CIV_PATH_TICKET_NONE) {
+      civ_path_result_t res;
+      civ_path_ticket_state_t state =
+          civ_path_service_result(net->path_service, edge->path_ticket, &res);
+      if (state == CIV_PATH_TICKET_PENDING) continue;
+      edge->path_ticket = CIV_PATH_TICKET_NONE;
+      if (state == CIV_PATH_TICKET_READY) {
+        edge->base_cost = res.cost;
+        edge->base_dirty = false;
+        edge->dirty = true;
+        continue;
+      }
+    }
+    civ_path_query_t q = {net->nodes[edge->a].tile, net->nodes[edge->b].tile,
+                          (uint8_t)net->path_layer, 0};
+    edge->path_ticket = civ_path_service_submit(net->path_service, &q, NULL, NULL);
+  }
+}
+
+/* Land base costs for every edge that needs one, in one pathfinder batch */
+static void price_land_paths(civ_trade_network_t *net) {
+  if (net->path_service) {
+    request_land_paths(net);
+    return;
+  }
+  uint32_t wanted = 0;
+  for (uint32_t e = 0; e < net->edge_count; e++)
+    if (net->edges[e].base_dirty && net->edges[e].kind == CIV_TRADE_EDGE_LAND)
+      wanted++;
+  if (wanted == 0) return;
+
+  civ_path_request_t *reqs = CIV_CALLOC(wanted, sizeof(civ_path_request_t));
+  uint32_t *which = CIV_MALLOC(wanted * sizeof(uint32_t));
+  if (!reqs || !which || !net->pathfinder) {
+    /* No router: land edges stay closed until one is available */
+    CIV_FREE(reqs);
+    CIV_FREE(which);
+    for (uint32_t e = 0; e < net->edge_count; e++)
+      if (net->edges[e].base_dirty && net->edges[e].kind == CIV_TRADE_EDGE_LAND) {
+        net->edges[e].base_cost = TRADE_INF;
+        net->edges[e].base_dirty = false;
+      }
+    return;
+  }
+  uint32_t n = 0;
+  for (uint32_t e = 0; e < net->edge_count; e++) {
+    civ_trade_edge_t *edge = &net->edges[e];
+    if (!edge->base_dirty || edge->kind != CIV_TRADE_EDGE_LAND) continue;
+    reqs[n].start = net->nodes[edge->a].tile;
+    reqs[n].goal = net->nodes[edge->b].tile;
+    which[n++] = e;
+  }
+  civ_pathfinder_find_batch(net->pathfinder, reqs, n, NULL);
+  for (uint32_t k = 0; k < n; k++) {
+    net->edges[which[k]].base_cost = reqs[k].cost;
+    net->edges[which[k]].base_dirty = false;
+  }
+  CIV_FREE(reqs);
+  CIV_FREE(which);
+}
+
+/* Sailing distance between two ports at CIV_TRADE_SEA_COST per tile; over
+   the ocean regions when set, else as the crow flies */
+static uint32_t sea_cost(const civ_trade_network_t *net, uint32_t a, uint32_t b) {
+  if (!net->ocean)
+    return (uint32_t)ceilf(tile_distance(net->map, a, b) * (float)CIV_TRADE_SEA_COST);
+  civ_ocean_request_t req = {.start = a, .goal = b};
+  if (!civ_ocean_find(net->ocean, &req)) return TRADE_INF;
+  return (uint32_t)(((uint64_t)req.cost * CIV_TRADE_SEA_COST + CIV_PATH_COST_STRAIGHT - 1) /
+                    CIV_PATH_COST_STRAIGHT);
+}
+
+static void price_edge(civ_trade_network_t *net, civ_trade_edge_t *e) {
+  const civ_trade_node_t *a = &net->nodes[e->a], *b = &net->nodes[e->b];
+  if (e->base_dirty && e->kind == CIV_TRADE_EDGE_SEA) {
+    e->base_cost = sea_cost(net, a->tile, b->tile);
+    e->base_dirty = false;
+  }
+
+  float road = CLAMP((a->road_quality + b->road_quality) * 0.5f, 0.0f, 1.0f);
+  if (e->kind == CIV_TRADE_EDGE_LAND) {
+    e->capacity = TRADE_LAND_CAPACITY * (1.0f + road * 3.0f);
+  } else {
+    float port = MIN(a->port_capacity, b->port_capacity);
+    e->capacity = TRADE_SEA_CAPACITY * (1.0f + MAX(port, 0.0f));
+  }
+
+  if (e->base_cost == TRADE_INF) {
+    e->cost = TRADE_INF;
+    return;
+  }
+  /* Good roads make a land leg up to a third cheaper */
+  uint32_t cost = e->kind == CIV_TRADE_EDGE_LAND
+      ? (uint32_t)((float)e->base_cost * (1.0f - road / 3.0f)) : e->base_cost;
+  if (a->owner != b->owner) cost = add_cost(cost, CIV_TRADE_BORDER_COST);
+  e->cost = MAX(cost, 1u);
+}
+
+/* ── Landmarks ────────────────────────────────────────────────────── */
+
+static void dijkstra(const civ_trade_network_t *net, uint32_t source,
+                     uint32_t *dist, heap_t *heap) {
+  for (uint32_t i = 0; i < net->node_count; i++) dist[i] = TRADE_INF;
+  dist[source] = 0;
+  heap->count = 0;
+  heap_push(heap, 0, source);
+  while (heap->count) {
+    heap_entry_t top = heap_pop(heap);
+    if (top.key != dist[top.node]) continue;
+    const civ_trade_node_t *n = &net->nodes[top.node];
+    for (uint32_t k = 0; k < n->edge_count; k++) {
+      const civ_trade_edge_t *e = &net->edges[net->edge_refs[n->first_edge + k]];
+      if (e->cost == TRADE_INF) continue;
+      uint32_t next = e->a == top.node ? e->b : e->a;
+      uint32_t d = add_cost(top.key, e->cost);
+      if (d < dist[next]) {
+        dist[next] = d;
+        heap_push(heap, d, next);
+      }
+    }
+  }
+}
+
+/* Farthest-point selection: each landmark is the node farthest from the
+   ones chosen so far, preferring nodes none of them reach */
+static void rebuild_landmarks(civ_trade_network_t *net, heap_t *heap) {
+  net->landmark_count = 0;
+  net->landmarks_stale = false;
+  if (net->node_count == 0 || !net->edge_refs) return;
+
+  uint32_t *dist = CIV_REALLOC(net->landmark_dist,
+      (size_t)CIV_TRADE_LANDMARKS * net->node_count * sizeof(uint32_t));
+  if (!dist) return;
+  net->landmark_dist = dist;
+
+  uint32_t next = 0;
+  for (uint32_t l = 0; l < CIV_TRADE_LANDMARKS; l++) {
+    net->landmarks[l] = next;
+    dijkstra(net, next, &dist[(size_t)l * net->node_count], heap);
+    net->landmark_count = l + 1;
+
+    uint32_t best = CIV_TRADE_NO_NODE, best_d = 0;
+    for (uint32_t i = 0; i < net->node_count; i++) {
+      uint32_t nearest = TRADE_INF;
+      for (uint32_t k = 0; k <= l; k++)
+        nearest = MIN(nearest, dist[(size_t)k * net->node_count + i]);
+      if (nearest > best_d || (best == CIV_TRADE_NO_NODE && nearest > 0)) {
+        best = i;
+        best_d = nearest;
+      }
+    }
+    if (best == CIV_TRADE_NO_NODE || best_d == 0) break;
+    next = best;
+  }
+}
+
+/* Lower bound on the cost from u to v; TRADE_INF when a landmark reaches
+   exactly one of them, which in an undirected graph means no path */
+static uint32_t lower_bound(const civ_trade_network_t *net, uint32_t u, uint32_t v) {
+  uint32_t bound = 0;
+  for (uint32_t l = 0; l < net->landmark_count; l++) {
+    const uint32_t *d = &net->landmark_dist[(size_t)l * net->node_count];
+    if (d[u] == TRADE_INF || d[v] == TRADE_INF) {
+      if (d[u] != d[v]) return TRADE_INF;
+      continue;
+    }
+    uint32_t diff = d[u] > d[v] ? d[u] - d[v] : d[v] - d[u];
+    bound = MAX(bound, diff);
+  }
+  return bound;
+}
+
+/* ── Routing ──────────────────────────────────────────────────────── */
+
+typedef struct {
+  uint32_t *g;
+  uint32_t *via;      /* edge the best path arrived over */
+  uint32_t *stamp;    /* search that last touched the node */
+  uint32_t search;
+  heap_t heap;
+} route_scratch_t;
+
+static void route_astar(civ_trade_network_t *net, civ_trade_network_route_t *r,
+                        route_scratch_t *s) {
+  r->path_length = 0;
+  r->cost = TRADE_INF;
+  if (r->from >= net->node_count || r->to >= net->node_count) return;
+  if (r->from == r->to) {
+    r->cost = 0;
+    return;
+  }
+  if (lower_bound(net, r->from, r->to) == TRADE_INF) return;
+
+  s->search++;
+  s->heap.count = 0;
+  s->g[r->from] = 0;
+  s->via[r->from] = UINT32_MAX;
+  s->stamp[r->from] = s->search;
+  heap_push(&s->heap, lower_bound(net, r->from, r->to), r->from);
+
+  while (s->heap.count) {
+    heap_entry_t top = heap_pop(&s->heap);
+    uint32_t u = top.node;
+    if (u == r->to) break;
+    uint32_t gu = s->g[u];
+    if (add_cost(gu, lower_bound(net, u, r->to)) != top.key) continue;  /* stale */
+
+    const civ_trade_node_t *n = &net->nodes[u];
+    for (uint32_t k = 0; k < n->edge_count; k++) {
+      uint32_t ei = net->edge_refs[n->first_edge + k];
+      const civ_trade_edge_t *e = &net->edges[ei];
+      if (e->cost == TRADE_INF) continue;
+      uint32_t v = e->a == u ? e->b : e->a;
+      uint32_t gv = add_cost(gu, e->cost);
+      if (s->stamp[v] == s->search && s->g[v] <= gv) continue;
+      uint32_t h = lower_bound(net, v, r->to);
+      if (h == TRADE_INF) continue;
+      s->stamp[v] = s->search;
+      s->g[v] = gv;
+      s->via[v] = ei;
+      heap_push(&s->heap, add_cost(gv, h), v);
+    }
+  }
+  if (s->stamp[r->to] != s->search) return;
+
+  /* Walk back, then reverse into from -> to order */
+  uint32_t length = 0;
+  for (uint32_t v = r->to; v != r->from; length++) {
+    const civ_trade_edge_t *e = &net->edges[s->via[v]];
+    v = e->a == v ? e->b : e->a;
+  }
+  if (length > r->path_capacity) {
+    uint32_t *path = CIV_REALLOC(r->path, length * sizeof(uint32_t));
+    if (!path) return;
+    r->path = path;
+    r->path_capacity = length;
+  }
+  uint32_t i = length;
+  for (uint32_t v = r->to; v != r->from;) {
+    uint32_t ei = s->via[v];
+    r->path[--i] = ei;
+    v = net->edges[ei].a == v ? net->edges[ei].b : net->edges[ei].a;
+  }
+  r->path_length = length;
+  r->cost = s->g[r->to];
+}
+
+static void apply_flow(civ_trade_network_t *net, const civ_trade_network_route_t *r,
+                       float sign) {
+  if (!r->active) return;
+  for (uint32_t k = 0; k < r->path_length; k++)
+    net->edges[r->path[k]].flow += sign * r->volume;
+}
+
+int32_t civ_trade_network_add_route(civ_trade_network_t *net,
+                                    uint32_t from_node, uint32_t to_node,
+                                    float volume, float value_per_unit,
+                                    float tariff_rate) {
+  if (!net || from_node >= net->node_count || to_node >= net->node_count)
+    return -1;
+  if (net->route_count >= net->route_capacity) {
+    uint32_t cap = net->route_capacity ? net->route_capacity * 2 : 16;
+    civ_trade_network_route_t *routes =
+        CIV_REALLOC(net->routes, cap * sizeof(civ_trade_network_route_t));
+    if (!routes) return -1;
+    net->routes = routes;
+    net->route_capacity = cap;
+  }
+  civ_trade_network_route_t *r = &net->routes[net->route_count];
+  memset(r, 0, sizeof(*r));
+  r->from = from_node;
+  r->to = to_node;
+  r->volume = MAX(volume, 0.0f);
+  r->value_per_unit = value_per_unit;
+  r->tariff_rate = CLAMP(tariff_rate, 0.0f, 1.0f);
+  r->active = true;
+  r->cost = TRADE_INF;
+  r->reroute = true;
+  return (int32_t)net->route_count++;
+}
+
+void civ_trade_network_cancel_route(civ_trade_network_t *net, int32_t route) {
+  if (!net || route < 0 || (uint32_t)route >= net->route_count) return;
+  civ_trade_network_route_t *r = &net->routes[route];
+  apply_flow(net, r, -1.0f);
+  r->active = false;
+  r->path_length = 0;
+  r->throughput = r->revenue = 0.0f;
+}
+
+/* ── Turn update ──────────────────────────────────────────────────── */
+
+void civ_trade_network_update(civ_trade_network_t *net,
+                              const civ_settlement_manager_t *settlements) {
+  if (!net) return;
+  bool rebuilt = net->landmarks_stale;
+  civ_trade_network_sync(net, settlements);
+  rebuilt = rebuilt || net->landmarks_stale;
+
+  if (net->nodes_dirty) {
+    for (uint32_t i = 0; i < net->node_count; i++) {
+      civ_owner_index_t owner = civ_map_owner_at(net->map, net->nodes[i].tile);
+      if (owner == net->nodes[i].owner) continue;
+      net->nodes[i].owner = owner;
+      mark_node_edges(net, i);
+    }
+    net->nodes_dirty = false;
+  }
+
+  /* Re-price dirty edges, noting which way each moved */
+  price_land_paths(net);
+  int8_t *moved = NULL;
+  uint32_t *cheaper = NULL;
+  uint32_t cheaper_count = 0;
+  for (uint32_t e = 0; e < net->edge_count; e++) {
+    civ_trade_edge_t *edge = &net->edges[e];
+    if (!edge->dirty) continue;
+    edge->dirty = false;
+    uint32_t before = edge->cost;
+    price_edge(net, edge);
+    if (edge->cost == before || rebuilt) continue;
+    if (!moved) {
+      moved = CIV_CALLOC(net->edge_count, sizeof(int8_t));
+      cheaper = CIV_MALLOC(net->edge_count * sizeof(uint32_t));
+      if (!moved || !cheaper) {
+        rebuilt = true;  /* re-route everything instead */
+        continue;
+      }
+    }
+    moved[e] = edge->cost > before ? 1 : -1;
+    if (edge->cost < before) cheaper[cheaper_count++] = e;
+  }
+
+  /* Old bounds stay admissible when costs only rise */
+  heap_t heap = {0};
+  if (rebuilt || cheaper_count > 0 || net->landmarks_stale)
+    rebuild_landmarks(net, &heap);
+
+  /* Which routes to re-route */
+  for (uint32_t ri = 0; ri < net->route_count; ri++) {
+    civ_trade_network_route_t *r = &net->routes[ri];
+    if (!r->active || r->reroute) continue;
+    if (rebuilt) {
+      r->reroute = true;
+      continue;
+    }
+    for (uint32_t k = 0; k < r->path_length && moved; k++)
+      if (moved[r->path[k]] > 0) {
+        r->reroute = true;
+        break;
+      }
+    for (uint32_t k = 0; k < cheaper_count && !r->reroute; k++) {
+      const civ_trade_edge_t *e = &net->edges[cheaper[k]];
+      uint32_t via_ab = add_cost(add_cost(lower_bound(net, r->from, e->a), e->cost),
+                                 lower_bound(net, e->b, r->to));
+      uint32_t via_ba = add_cost(add_cost(lower_bound(net, r->from, e->b), e->cost),
+                                 lower_bound(net, e->a, r->to));
+      if (MIN(via_ab, via_ba) < r->cost) r->reroute = true;
+    }
+  }
+  CIV_FREE(moved);
+  CIV_FREE(cheaper);
+
+  /* Re-route, moving each route's flow from its old path to its new one */
+  net->reroutes = 0;
+  route_scratch_t scratch = {0};
+  if (rebuilt)
+    for (uint32_t e = 0; e < net->edge_count; e++) net->edges[e].flow = 0.0f;
+  for (uint32_t ri = 0; ri < net->route_count; ri++) {
+    civ_trade_network_route_t *r = &net->routes[ri];
+    if (!r->active || !r->reroute) continue;
+    if (!scratch.g) {
+      size_t n = MAX(net->node_count, 1);
+      scratch.g = CIV_MALLOC(n * sizeof(uint32_t));
+      scratch.via = CIV_MALLOC(n * sizeof(uint32_t));
+      scratch.stamp = CIV_CALLOC(n, sizeof(uint32_t));
+      if (!scratch.g || !scratch.via || !scratch.stamp) break;
+    }
+    if (!rebuilt) apply_flow(net, r, -1.0f);
+    route_astar(net, r, &scratch);
+    apply_flow(net, r, 1.0f);
+    r->reroute = false;
+    net->reroutes++;
+  }
+  if (rebuilt)
+    for (uint32_t ri = 0; ri < net->route_count; ri++)
+      if (!net->routes[ri].reroute) apply_flow(net, &net->routes[ri], 1.0f);
+  CIV_FREE(scratch.g);
+  CIV_FREE(scratch.via);
+  CIV_FREE(scratch.stamp);
+  CIV_FREE(scratch.heap.items);
+  CIV_FREE(heap.items);
+
+  /* Evaluate every route against the shared capacities */
+  civ_econ_sum_t revenue = CIV_ECON_SUM_ZERO, volume = CIV_ECON_SUM_ZERO;
+  for (uint32_t ri = 0; ri < net->route_count; ri++) {
+    civ_trade_network_route_t *r = &net->routes[ri];
+    r->throughput = 0.0f;
+    r->revenue = 0.0f;
+    if (!r->active || r->cost == TRADE_INF) continue;
+    float carried = 1.0f;
+    for (uint32_t k = 0; k < r->path_length; k++) {
+      const civ_trade_edge_t *e = &net->edges[r->path[k]];
+      if (e->flow > e->capacity) carried = MIN(carried, e->capacity / e->flow);
+    }
+    float moved_volume = r->volume * carried;
+    r->throughput = carried;
+    r->revenue = moved_volume * (r->value_per_unit * (1.0f - r->tariff_rate)
+                                 - (float)r->cost * TRADE_COST_VALUE);
+    civ_econ_sum_add(&revenue, r->revenue);
+    civ_econ_sum_add(&volume, moved_volume);
+  }
+  net->total_revenue = (float)civ_econ_sum_value(&revenue);
+  net->total_volume = (float)civ_econ_sum_value(&volume);
+}
@@ -17,21 +17,30 @@ civ_war_economy_system_t *civ_war_economy_create(void) {
 
 void civ_war_economy_destroy(civ_war_economy_system_t *w) { free(w); }
 
+bool civ_war_economy_is_demobilized(const civ_war_economy_system_t *w) {
+  if (!w) return true;
+  return !w->at_war && fabs(w->military_spending_ratio - 0.02) < 1e-4 &&
+         w->civilian_to_military_conversion < 1e-4 &&
+         w->rationing_level < 1e-4 && w->conscription_rate < 1e-4 &&
+         w->war_exhaustion < 1e-4;
+}
+
 void civ_war_economy_update(civ_war_economy_system_t *w, civ_float_t time_delta,
                             civ_float_t gdp, civ_float_t industrial_output,
                             int population, bool actively_fighting) {
   if (!w) return;
-  (void)time_delta;
   (void)population;
 
   if (!w->at_war && !actively_fighting) {
-    /* Peacetime: gradual demobilization */
-    w->military_spending_ratio += (0.02 - w->military_spending_ratio) * 0.1;
-    w->civilian_to_military_conversion *= 0.95;
-    w->rationing_level *= 0.9;
-    w->conscription_rate *= 0.9;
+    /* Peacetime: gradual demobilization, by the tick, so a call covering
+       several ticks decays as far as that many calls would */
+    civ_float_t fast = pow(0.9, time_delta), slow = pow(0.95, time_delta);
+    w->military_spending_ratio = 0.02 + (w->military_spending_ratio - 0.02) * fast;
+    w->civilian_to_military_conversion *= slow;
+    w->rationing_level *= fast;
+    w->conscription_rate *= fast;
     w->months_at_war = 0;
-    w->war_exhaustion *= 0.95;
+    w->war_exhaustion *= slow;
   } else {
     w->at_war = true;
     if (actively_fighting) w->months_at_war++;
@@ -0,0 +1,172 @@
+/**
+ * @file climate.c
+ * @brief Climate lookup tables and regional seasonal yields
+ */
+#include "core/environment/climate.h"
+#include "common.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LAPSE_RATE   6.5f  /* C per km */
+#define ITCZ_SWING   8.0f  /* degrees the rain belt moves north and south */
+#define RAIN_ENOUGH  60.0f /* mm per month that crops need */
+
+/* What each biome can grow at a full growing multiplier */
+static const float k_biome_yield[CIV_CLIMATE_BIOMES] = {
+    0.3f,  /* forest */
+    1.0f,  /* agriculture */
+    0.05f, /* urban */
+    0.5f,  /* wetland */
+    0.8f,  /* grassland */
+    0.1f,  /* desert */
+    0.0f,  /* water */
+    0.15f, /* tundra */
+};
+
+/* Centre latitude of band b, degrees north */
+static float band_latitude(int b) {
+  return 90.0f - ((float)b + 0.5f) * (float)CIV_CLIMATE_LAT_BAND_DEGREES;
+}
+
+/* +1 at the hemisphere's midsummer, -1 at midwinter */
+static float season_phase(float lat, int month) {
+  float c = cosf(2.0f * (float)M_PI * (float)(month - 7) / CIV_CLIMATE_MONTHS);
+  return lat >= 0.0f ? c : -c;
+}
+
+/* Crops need warmth and rain; heat past 30 C starts to hurt */
+static float growing_of(float temperature, float precipitation) {
+  float warmth;
+  if (temperature < 4.0f)
+    warmth = 0.0f;
+  else if (temperature < 16.0f)
+    warmth = (temperature - 4.0f) / 12.0f;
+  else if (temperature <= 30.0f)
+    warmth = 1.0f;
+  else
+    warmth = MAX(1.0f - 0.05f * (temperature - 30.0f), 0.4f);
+  float rain = 0.25f + 0.75f * MIN(precipitation / RAIN_ENOUGH, 1.0f);
+  return warmth * rain;
+}
+
+civ_climate_t *civ_climate_create(void) {
+  civ_climate_t *climate = (civ_climate_t *)CIV_CALLOC(1, sizeof(civ_climate_t));
+  if (!climate) {
+    civ_log(CIV_LOG_ERROR, "Failed to allocate climate tables");
+    return NULL;
+  }
+
+  for (int b = 0; b < CIV_CLIMATE_LAT_BANDS; b++) {
+    float lat = band_latitude(b);
+    float mean = 27.0f - 0.006f * lat * lat;
+    float swing = 0.25f * fabsf(lat);
+    for (int m = 0; m < CIV_CLIMATE_MONTHS; m++) {
+      /* The equatorial rain belt follows the sun; mid-latitude storms stay */
+      float itcz = ITCZ_SWING * cosf(2.0f * (float)M_PI * (float)(m - 6) / CIV_CLIMATE_MONTHS);
+      float tropic = (lat - itcz) / 12.0f, storm = (fabsf(lat) - 50.0f) / 14.0f;
+      float rain = 15.0f + 200.0f * expf(-tropic * tropic) + 70.0f * expf(-storm * storm);
+      climate->precipitation[b][m] = rain;
+      float sea_temperature = mean + swing * season_phase(lat, m + 1);
+      for (int e = 0; e < CIV_CLIMATE_ELEV_BANDS; e++) {
+        float km = ((float)e + 0.5f) / CIV_CLIMATE_ELEV_BANDS * CIV_CLIMATE_PEAK_KM;
+        float t = sea_temperature - LAPSE_RATE * km;
+        climate->temperature[b][e][m] = t;
+        climate->growing[b][e][m] = growing_of(t, rain);
+      }
+    }
+  }
+  return climate;
+}
+
+void civ_climate_destroy(civ_climate_t *climate) { CIV_FREE(climate); }
+
+void civ_climate_bands_of(const civ_map_t *map, size_t tile, int *lat_band,
+                          int *elev_band) {
+  int y = (int)(tile / (size_t)map->width);
+  int b = (int)((int64_t)y * CIV_CLIMATE_LAT_BANDS / MAX(map->height, 1));
+  *lat_band = CLAMP(b, 0, CIV_CLIMATE_LAT_BANDS - 1);
+  float sea = CLAMP((float)map->sea_level, 0.0f, 0.99f);
+  float h = (civ_map_elevation_at(map, tile) - sea) / (1.0f - sea);
+  int e = (int)(h * CIV_CLIMATE_ELEV_BANDS);
+  *elev_band = CLAMP(e, 0, CIV_CLIMATE_ELEV_BANDS - 1);
+}
+
+static int month_index(int month) {
+  return ((month - 1) % CIV_CLIMATE_MONTHS + CIV_CLIMATE_MONTHS) % CIV_CLIMATE_MONTHS;
+}
+
+float civ_climate_temperature_at(const civ_climate_t *climate, const civ_map_t *map,
+                                 size_t tile, int month) {
+  if (!climate || !map) return 0.0f;
+  int b, e;
+  civ_climate_bands_of(map, tile, &b, &e);
+  return climate->temperature[b][e][month_index(month)];
+}
+
+float civ_climate_growing_at(const civ_climate_t *climate, const civ_map_t *map,
+                             size_t tile, int month) {
+  if (!climate || !map) return 0.0f;
+  int b, e;
+  civ_climate_bands_of(map, tile, &b, &e);
+  return climate->growing[b][e][month_index(month)];
+}
+
+/* ── Profiles ──────────────────────────────────────────────────────── */
+
+void civ_climate_profile_clear(civ_climate_profile_t *profile) {
+  if (!profile) return;
+  memset(profile->counts, 0, sizeof(profile->counts));
+  profile->land_tiles = 0;
+}
+
+static void count_tile(civ_climate_profile_t *profile, const civ_map_t *map,
+                       size_t tile) {
+  uint8_t biome = map->planes ? map->planes->land_use[tile] : map->tiles[tile].land_use;
+  if (biome >= CIV_CLIMATE_BIOMES) return;
+  int b, e;
+  civ_climate_bands_of(map, tile, &b, &e);
+  profile->counts[b][e][biome]++;
+  profile->land_tiles++;
+}
+
+void civ_climate_profile_add(civ_climate_profile_t *profile, const civ_map_t *map,
+                             size_t tile) {
+  if (!profile || !map || civ_map_is_water_at(map, tile)) return;
+  count_tile(profile, map, tile);
+}
+
+void civ_climate_profile_survey(civ_climate_profile_t *profile, const civ_map_t *map,
+                                civ_owner_index_t owner) {
+  if (!profile) return;
+  civ_climate_profile_clear(profile);
+  if (!map || owner == CIV_OWNER_NONE) return;
+  size_t n = (size_t)map->width * (size_t)map->height;
+  for (size_t i = 0; i < n; i++)
+    if (civ_map_owner_at(map, i) == owner && !civ_map_is_water_at(map, i))
+      count_tile(profile, map, i);
+}
+
+float civ_climate_profile_yield(const civ_climate_t *climate,
+                                const civ_climate_profile_t *profile, int month) {
+  if (!climate || !profile || profile->land_tiles == 0) return 0.0f;
+  int m = month_index(month);
+  double grown = 0.0, potential = 0.0;
+  for (int b = 0; b < CIV_CLIMATE_LAT_BANDS; b++)
+    for (int e = 0; e < CIV_CLIMATE_ELEV_BANDS; e++) {
+      double farmland = 0.0;
+      for (int k = 0; k < CIV_CLIMATE_BIOMES; k++)
+        farmland += (double)profile->counts[b][e][k] * k_biome_yield[k];
+      grown += farmland * climate->growing[b][e][m];
+      potential += farmland;
+    }
+  return potential > 0.0 ? (float)(grown / potential) : 0.0f;
+}
+
+int civ_climate_profile_lean_months(const civ_climate_t *climate,
+                                    const civ_climate_profile_t *profile) {
+  int lean = 0;
+  for (int m = 1; m <= CIV_CLIMATE_MONTHS; m++)
+    if (civ_climate_profile_yield(climate, profile, m) < CIV_CLIMATE_LEAN) lean++;
+  return lean;
+}
@@ -4,34 +4,324 @@
  */
 
 #include "core/environment/disaster_system.h"
+#include "utils/rng.h"
+#include "utils/store_registry.h"
+#include "utils/timing_wheel.h"
 #include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
+#define POPULATION_LOSS 0.05f /* share of a settlement lost at damage 1 */
+#define UNREST_GAIN     0.3f
+#define UNIT_LOSS       0.2f  /* share of a unit's strength */
+#define SITE_DRAWS      4     /* tiles tried in a cell; the likeliest wins */
 
+static const char *const type_names[CIV_DISASTER_TYPE_COUNT] = {
+    "Earthquake", "Flood", "Drought", "Wildfire", "Hurricane", "Plague",
+    "Volcano"};
+
+/* How often each type strikes, relative to the others, at full hazard */
+static const float type_weight[CIV_DISASTER_TYPE_COUNT] = {
+    1.0f, 1.5f, 1.0f, 1.0f, 0.8f, 0.4f, 0.2f};
+
+/* ── Damage layer ──────────────────────────────────────────────────── */
+static uint32_t hash_u32(uint32_t v) { return v * 2654435761u; }
+
+static bool layer_grow(civ_disaster_layer_t *l) {
+  uint32_t cap = l->capacity ? l->capacity * 2 : 1024;
+  uint32_t *keys = CIV_CALLOC(cap, sizeof(uint32_t));
+  float *damage = CIV_MALLOC(cap * sizeof(float));
+  if (!keys || !damage) {
+    CIV_FREE(keys);
+    CIV_FREE(damage);
+    return false;
+  }
+  for (uint32_t i = 0; i < l->capacity; i++) {
+    if (!l->keys[i]) continue;
+    uint32_t h = hash_u32(l->keys[i]) & (cap - 1);
+    while (keys[h]) h = (h + 1) & (cap - 1);
+    keys[h] = l->keys[i];
+    damage[h] = l->damage[i];
+  }
+  CIV_FREE(l->keys);
+  CIV_FREE(l->damage);
+  l->keys = keys;
+  l->damage = damage;
+  l->capacity = cap;
+  return true;
+}
+
+static void layer_add(civ_disaster_layer_t *l, uint32_t tile, float v) {
+  if ((l->count + 1) * 2 > l->capacity && !layer_grow(l)) return;
+  uint32_t key = tile + 1, mask = l->capacity - 1;
+  uint32_t h = hash_u32(key) & mask;
+  while (l->keys[h] && l->keys[h] != key) h = (h + 1) & mask;
+  if (!l->keys[h]) {
+    l->keys[h] = key;
+    l->damage[h] = 0.0f;
+    l->count++;
+  }
+  l->damage[h] += v;
+}
+
+static float layer_get(const civ_disaster_layer_t *l, uint32_t tile) {
+  if (!l->count) return 0.0f;
+  uint32_t key = tile + 1, mask = l->capacity - 1;
+  for (uint32_t h = hash_u32(key) & mask; l->keys[h]; h = (h + 1) & mask)
+    if (l->keys[h] == key) return l->damage[h];
+  return 0.0f;
+}
+
+static void layer_clear(civ_disaster_layer_t *l) {
+  if (l->count) memset(l->keys, 0, l->capacity * sizeof(uint32_t));
+  l->count = 0;
+}
+
+static void layer_free(civ_disaster_layer_t *l) {
+  CIV_FREE(l->keys);
+  CIV_FREE(l->damage);
+  memset(l, 0, sizeof(*l));
+}
+
+/* Footprint of d, wrapping east-west like the map */
+static void stamp(const civ_disaster_manager_t *manager, const civ_disaster_t *d,
+                  civ_disaster_layer_t *layer) {
+  const civ_map_t *map = manager->map;
+  if (!map) return;
+  int32_t r = (int32_t)ceilf(d->radius);
+  for (int32_t dy = -r; dy <= r; dy++) {
+    int32_t y = d->y + dy;
+    if (y < 0 || y >= map->height) continue;
+    for (int32_t dx = -r; dx <= r; dx++) {
+      float v = civ_disaster_calculate_damage(d, (civ_float_t)(d->x + dx),
+                                              (civ_float_t)y);
+      if (v <= 0.0f) continue;
+      int32_t x = ((d->x + dx) % map->width + map->width) % map->width;
+      layer_add(layer, (uint32_t)((size_t)y * map->width + x), v);
+    }
+  }
+}
+
+/* Both layers again from the disasters in effect */
+static void restamp(civ_disaster_manager_t *manager) {
+  layer_clear(&manager->damage);
+  layer_clear(&manager->fresh);
+  for (size_t i = 0; i < manager->disaster_count; i++) {
+    const civ_disaster_t *d = &manager->active_disasters[i];
+    if (d->active)
+      stamp(manager, d, d->impact_pending ? &manager->fresh : &manager->damage);
+  }
+}
+
+/* ── Hazard ────────────────────────────────────────────────────────── */
+/* Per-type hazard of tile i, 0..1 before the type weights */
+static void tile_hazard(const civ_map_t *map, size_t i,
+                        float out[CIV_DISASTER_TYPE_COUNT]) {
+  memset(out, 0, CIV_DISASTER_TYPE_COUNT * sizeof(float));
+  if (civ_map_is_water_at(map, i)) return;
+  const civ_map_tile_t *t = &map->tiles[i];
+  float elev = civ_tile_elevation(t), wet = civ_tile_moisture(t);
+  float heat = civ_tile_temperature(t), veg = civ_tile_vegetation_density(t);
+
+  int32_t x = (int32_t)(i % (size_t)map->width);
+  int32_t y = (int32_t)(i / (size_t)map->width);
+  size_t row = (size_t)y * map->width;
+  bool coast = civ_map_is_water_at(map, row + (size_t)((x + 1) % map->width)) ||
+               civ_map_is_water_at(map, row + (size_t)((x - 1 + map->width) % map->width)) ||
+               (y > 0 && civ_map_is_water_at(map, i - map->width)) ||
+               (y + 1 < map->height && civ_map_is_water_at(map, i + map->width));
+
+  out[CIV_DISASTER_EARTHQUAKE] = elev * elev;
+  out[CIV_DISASTER_FLOOD] = (t->has_river ? 1.0f : 0.3f) * wet * (1.0f - elev);
+  out[CIV_DISASTER_DROUGHT] = (1.0f - wet) * heat;
+  out[CIV_DISASTER_WILDFIRE] = veg * heat * (1.0f - wet);
+  out[CIV_DISASTER_HURRICANE] = coast ? heat * heat : 0.0f;
+  out[CIV_DISASTER_PLAGUE] = civ_tile_population_density(t);
+  float peak = MAX(0.0f, (elev - 0.85f) / 0.15f);
+  out[CIV_DISASTER_VOLCANO] = peak * peak;
+}
+
+static bool score_cells(civ_disaster_manager_t *manager, const civ_map_t *map) {
+  int32_t cols = (map->width + CIV_DISASTER_CELL - 1) / CIV_DISASTER_CELL;
+  int32_t rows = (map->height + CIV_DISASTER_CELL - 1) / CIV_DISASTER_CELL;
+  size_t cells = (size_t)cols * rows;
+  float *hazard = CIV_CALLOC(cells * CIV_DISASTER_TYPE_COUNT, sizeof(float));
+  double *cdf = CIV_MALLOC(cells * sizeof(double));
+  uint32_t *tiles = CIV_CALLOC(cells, sizeof(uint32_t));
+  if (!hazard || !cdf || !tiles) {
+    CIV_FREE(hazard);
+    CIV_FREE(cdf);
+    CIV_FREE(tiles);
+    return false;
+  }
+
+  size_t tile_count = (size_t)map->width * map->height;
+  for (size_t i = 0; i < tile_count; i++) {
+    size_t x = i % (size_t)map->width, y = i / (size_t)map->width;
+    size_t c = (y / CIV_DISASTER_CELL) * cols + x / CIV_DISASTER_CELL;
+    float h[CIV_DISASTER_TYPE_COUNT];
+    tile_hazard(map, i, h);
+    for (int k = 0; k < CIV_DISASTER_TYPE_COUNT; k++)
+      hazard[c * CIV_DISASTER_TYPE_COUNT + k] += h[k];
+    tiles[c]++;
+  }
+
+  /* Mean hazard, weighted by type, so edge cells rate like full ones */
+  double total = 0.0;
+  for (size_t c = 0; c < cells; c++) {
+    for (int k = 0; k < CIV_DISASTER_TYPE_COUNT; k++) {
+      float *h = &hazard[c * CIV_DISASTER_TYPE_COUNT + k];
+      *h = tiles[c] ? *h / (float)tiles[c] * type_weight[k] : 0.0f;
+      total += *h;
+    }
+    cdf[c] = total;
+  }
+  CIV_FREE(tiles);
+
+  CIV_FREE(manager->hazard);
+  CIV_FREE(manager->hazard_cdf);
+  manager->hazard = hazard;
+  manager->hazard_cdf = cdf;
+  manager->hazard_total = total;
+  manager->cell_cols = cols;
+  manager->cell_rows = rows;
+  return true;
+}
+
+static double draw_unit(civ_rng_t *rng) {
+  return ((double)civ_rng_next_u32(rng) + 0.5) / 4294967296.0;
+}
+
+/* Cell where u of type's hazard, summed over the cells, falls; type < 0
+   weighs every type through the cdf */
+static size_t pick_cell(const civ_disaster_manager_t *manager, int type,
+                        double u) {
+  size_t cells = (size_t)manager->cell_cols * manager->cell_rows;
+  if (type < 0) {
+    double target = u * manager->hazard_total;
+    size_t lo = 0, hi = cells - 1;
+    while (lo < hi) {
+      size_t mid = (lo + hi) / 2;
+      if (manager->hazard_cdf[mid] > target) hi = mid;
+      else lo = mid + 1;
+    }
+    return lo;
+  }
+  double total = 0.0;
+  for (size_t c = 0; c < cells; c++)
+    total += manager->hazard[c * CIV_DISASTER_TYPE_COUNT + type];
+  double target = u * total, run = 0.0;
+  for (size_t c = 0; c < cells; c++) {
+    run += manager->hazard[c * CIV_DISASTER_TYPE_COUNT + type];
+    if (run > target) return c;
+  }
+  return cells - 1;
+}
+
+/* Likeliest of SITE_DRAWS tiles in cell for type */
+static void pick_tile(const civ_disaster_manager_t *manager, size_t cell,
+                      int type, civ_rng_t *rng, int32_t *out_x, int32_t *out_y) {
+  const civ_map_t *map = manager->map;
+  int32_t x0 = (int32_t)(cell % (size_t)manager->cell_cols) * CIV_DISASTER_CELL;
+  int32_t y0 = (int32_t)(cell / (size_t)manager->cell_cols) * CIV_DISASTER_CELL;
+  int32_t w = MIN(CIV_DISASTER_CELL, map->width - x0);
+  int32_t h = MIN(CIV_DISASTER_CELL, map->height - y0);
+  float best = -1.0f;
+  for (int k = 0; k < SITE_DRAWS; k++) {
+    int32_t x = x0 + (int32_t)civ_rng_range(rng, (uint32_t)w);
+    int32_t y = y0 + (int32_t)civ_rng_range(rng, (uint32_t)h);
+    float score[CIV_DISASTER_TYPE_COUNT];
+    tile_hazard(map, (size_t)y * map->width + x, score);
+    if (score[type] > best) {
+      best = score[type];
+      *out_x = x;
+      *out_y = y;
+    }
+  }
+}
+
+/* Type in cell, by its share of the cell's weighted hazard */
+static int pick_type(const civ_disaster_manager_t *manager, size_t cell,
+                     double u) {
+  const float *h = &manager->hazard[cell * CIV_DISASTER_TYPE_COUNT];
+  double total = 0.0;
+  for (int k = 0; k < CIV_DISASTER_TYPE_COUNT; k++) total += h[k];
+  double target = u * total, run = 0.0;
+  for (int k = 0; k < CIV_DISASTER_TYPE_COUNT - 1; k++) {
+    run += h[k];
+    if (run > target) return k;
+  }
+  return CIV_DISASTER_TYPE_COUNT - 1;
+}
+
+/* ── Manager ───────────────────────────────────────────────────────── */
 civ_disaster_manager_t *
 civ_disaster_manager_create(civ_geography_t *geography) {
-  civ_disaster_manager_t *manager = CIV_MALLOC(sizeof(civ_disaster_manager_t));
+  civ_disaster_manager_t *manager = CIV_CALLOC(1, sizeof(civ_disaster_manager_t));
   if (manager) {
-    manager->active_disasters = NULL;
-    manager->disaster_count = 0;
-    manager->disaster_capacity = 0;
     manager->geography = geography;
+    manager->rng_seed = CIV_GLOBAL_MAP_SEED;
+    civ_timing_wheel_init(&manager->expiry, 0);
+    CIV_STORE_REGISTER("environment.disasters", manager,
+                       manager->disaster_count, manager->disaster_capacity,
+                       sizeof(civ_disaster_t), CIV_STORE_APPEND);
   }
   return manager;
 }
 
 void civ_disaster_manager_destroy(civ_disaster_manager_t *manager) {
   if (manager) {
+    civ_store_unregister_owner(manager);
     CIV_FREE(manager->active_disasters);
+    CIV_FREE(manager->hazard);
+    CIV_FREE(manager->hazard_cdf);
+    CIV_FREE(manager->owner_loss);
+    layer_free(&manager->damage);
+    layer_free(&manager->fresh);
+    civ_timing_wheel_free(&manager->expiry);
     CIV_FREE(manager);
   }
 }
 
+void civ_disaster_manager_set_map(civ_disaster_manager_t *manager,
+                                  const civ_map_t *map) {
+  if (!manager) return;
+  if (map == manager->map && (!map || map->serial == manager->map_serial))
+    return;
+
+  manager->map = NULL;
+  CIV_FREE(manager->hazard);
+  CIV_FREE(manager->hazard_cdf);
+  manager->hazard = NULL;
+  manager->hazard_cdf = NULL;
+  manager->hazard_total = 0.0;
+  if (map && map->tiles && score_cells(manager, map)) {
+    manager->map = map;
+    manager->map_serial = map->serial;
+  }
+  restamp(manager);
+}
+
+/* Due on the hour after key's disaster ends; the list is compacted by the
+   update that advanced the wheel */
+static void expire_disaster(void *arg, uint64_t key, uint64_t due) {
+  (void)due;
+  civ_disaster_manager_t *manager = (civ_disaster_manager_t *)arg;
+  for (size_t i = 0; i < manager->disaster_count; i++) {
+    civ_disaster_t *d = &manager->active_disasters[i];
+    if (d->number == (uint32_t)key && d->active) {
+      d->active = false;
+      manager->expired++;
+      return;
+    }
+  }
+}
+
 civ_result_t civ_disaster_trigger(civ_disaster_manager_t *manager,
-                                  civ_disaster_type_t type,
-                                  civ_coordinate_t location,
-                                  civ_float_t severity) {
-  if (!manager)
+                                  civ_disaster_type_t type, int32_t x,
+                                  int32_t y, civ_float_t severity) {
+  if (!manager || type < 0 || type >= CIV_DISASTER_TYPE_COUNT)
     return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Invalid args"};
 
   if (manager->disaster_count >= manager->disaster_capacity) {
@@ -45,61 +335,295 @@ civ_result_t civ_disaster_trigger(civ_disaster_manager_t *manager,
     manager->disaster_capacity = new_cap;
   }
 
+  if (manager->map) {
+    x = (x % manager->map->width + manager->map->width) % manager->map->width;
+    y = CLAMP(y, 0, manager->map->height - 1);
+  }
+  severity = CLAMP(severity, 0.0f, 1.0f);
+
   civ_disaster_t *d = &manager->active_disasters[manager->disaster_count++];
-  snprintf(d->id, STRING_SHORT_LEN, "dis_%ld", (long)time(NULL));
+  memset(d, 0, sizeof(*d));
+  d->number = manager->serial++;
+  snprintf(d->id, STRING_SHORT_LEN, "dis_%u", d->number);
   d->type = type;
+  snprintf(d->name, STRING_MEDIUM_LEN, "%s at %d, %d", type_names[type],
+           (int)x, (int)y);
 
-  const char *type_names[] = {"Earthquake", "Flood",  "Drought", "Wildfire",
-                              "Hurricane",  "Plague", "Volcano"};
-  snprintf(d->name, STRING_MEDIUM_LEN, "%s at %.1f, %.1f", type_names[type],
-           location.latitude, location.longitude);
-
-  d->location = location;
-  d->radius = 50.0f * severity; // Arbitrary radius scaling
+  d->x = x;
+  d->y = y;
+  d->radius = MAX(1.0f, CIV_DISASTER_MAX_RADIUS * severity);
   d->severity = severity;
-  d->start_time = time(NULL);
-  d->duration_hours = (int)(24 * 7 * severity); // Up to a week or more
+  d->start_day = manager->sim_days;
+  d->duration_hours = MAX(1, (int)(24 * 7 * severity)); // Up to a week
   d->active = true;
+  d->impact_pending = true;
+  /* Over once the clock is past start + duration */
+  civ_timing_wheel_schedule(
+      &manager->expiry,
+      (uint64_t)floor(d->start_day * 24.0 + d->duration_hours) + 1,
+      expire_disaster, manager, d->number);
+  stamp(manager, d, &manager->fresh);
+  manager->stats.disasters++;
 
   return (civ_result_t){CIV_OK, "Disaster triggered"};
 }
 
+civ_result_t civ_disaster_spawn(civ_disaster_manager_t *manager,
+                                civ_disaster_type_t type,
+                                civ_float_t severity) {
+  if (!manager || type < 0 || type >= CIV_DISASTER_TYPE_COUNT)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Invalid args"};
+  if (!manager->map || manager->hazard_total <= 0.0)
+    return (civ_result_t){CIV_ERROR_INVALID_STATE, "No map bound"};
+
+  /* Its own stream, apart from the update's rolls */
+  civ_rng_t rng;
+  civ_rng_seed_key(&rng, manager->rng_seed, CIV_RNG_DISASTERS, manager->step,
+                   1 + (uint64_t)manager->serial);
+  size_t cell = pick_cell(manager, (int)type, draw_unit(&rng));
+  int32_t x = 0, y = 0;
+  pick_tile(manager, cell, (int)type, &rng, &x, &y);
+  return civ_disaster_trigger(manager, type, x, y, severity);
+}
+
 void civ_disaster_update(civ_disaster_manager_t *manager,
                          civ_float_t time_delta) {
-  if (!manager)
+  if (!manager || time_delta < 0.0f)
+    return;
+
+  manager->sim_days += time_delta;
+  manager->step++;
+
+  // Expire on the sim clock and drop what ended
+  civ_timing_wheel_advance(&manager->expiry,
+                           (uint64_t)floor(manager->sim_days * 24.0));
+  if (manager->expired > 0) {
+    size_t kept = 0;
+    for (size_t i = 0; i < manager->disaster_count; i++)
+      if (manager->active_disasters[i].active)
+        manager->active_disasters[kept++] = manager->active_disasters[i];
+    manager->disaster_count = kept;
+    manager->expired = 0;
+    restamp(manager);
+  }
+
+  // Spawns: Poisson in the map's total hazard over the elapsed days
+  if (!manager->map || manager->hazard_total <= 0.0)
     return;
+  civ_rng_t rng;
+  civ_rng_seed_key(&rng, manager->rng_seed, CIV_RNG_DISASTERS, manager->step,
+                   0);
+  double lambda = CIV_DISASTER_RATE * manager->hazard_total * time_delta;
+  double u = draw_unit(&rng), pmf = exp(-lambda), cdf = pmf;
+  int spawns = 0;
+  while (u > cdf && spawns < CIV_DISASTER_MAX_SPAWNS) {
+    spawns++;
+    pmf *= lambda / spawns;
+    cdf += pmf;
+  }
+  for (int s = 0; s < spawns; s++) {
+    size_t cell = pick_cell(manager, -1, draw_unit(&rng));
+    int type = pick_type(manager, cell, draw_unit(&rng));
+    int32_t x = 0, y = 0;
+    pick_tile(manager, cell, type, &rng, &x, &y);
+    /* Mostly minor, now and then severe */
+    double v = draw_unit(&rng);
+    civ_disaster_trigger(manager, (civ_disaster_type_t)type, x, y,
+                         (civ_float_t)(0.2 + 0.8 * v * v));
+  }
+}
 
-  time_t now = time(NULL);
+/* ── Impact ────────────────────────────────────────────────────────── */
+static int cmp_size(const void *a, const void *b) {
+  size_t x = *(const size_t *)a, y = *(const size_t *)b;
+  return (x > y) - (x < y);
+}
+
+typedef struct {
+  size_t *items;
+  size_t count, capacity;
+} index_list_t;
+
+static bool list_reserve(index_list_t *l, size_t extra) {
+  if (l->count + extra <= l->capacity) return true;
+  size_t cap = MAX(l->capacity * 2, l->count + extra);
+  size_t *grown = CIV_REALLOC(l->items, cap * sizeof(size_t));
+  if (!grown) return false;
+  l->items = grown;
+  l->capacity = cap;
+  return true;
+}
 
-  // Check for expiration
+/* Sort ascending and drop repeats */
+static void list_unique(index_list_t *l) {
+  if (l->count < 2) return;
+  qsort(l->items, l->count, sizeof(size_t), cmp_size);
+  size_t n = 1;
+  for (size_t i = 1; i < l->count; i++)
+    if (l->items[i] != l->items[n - 1]) l->items[n++] = l->items[i];
+  l->count = n;
+}
+
+/* Settlements and units in [x0, x1] x [y0, y1], one span of the wrap */
+static void gather_span(civ_settlement_manager_t *settlements,
+                        civ_unit_manager_t *units, int32_t x0, int32_t y0,
+                        int32_t x1, int32_t y1, index_list_t *hit_s,
+                        index_list_t *hit_u) {
+  if (settlements) {
+    size_t n = civ_settlement_manager_query_rect(
+        settlements, (civ_float_t)x0, (civ_float_t)y0, (civ_float_t)(x1 + 1),
+        (civ_float_t)(y1 + 1), NULL, 0);
+    if (n && list_reserve(hit_s, n))
+      hit_s->count += civ_settlement_manager_query_rect(
+          settlements, (civ_float_t)x0, (civ_float_t)y0, (civ_float_t)(x1 + 1),
+          (civ_float_t)(y1 + 1), hit_s->items + hit_s->count, n);
+  }
+  if (units) {
+    size_t n = civ_unit_manager_query_rect(units, x0, y0, x1, y1, NULL, 0);
+    if (n && list_reserve(hit_u, n))
+      hit_u->count += civ_unit_manager_query_rect(
+          units, x0, y0, x1, y1, hit_u->items + hit_u->count, n);
+  }
+}
+
+static void charge_owners(civ_disaster_manager_t *manager) {
+  const civ_map_t *map = manager->map;
+  const civ_disaster_layer_t *l = &manager->fresh;
+  for (uint32_t i = 0; i < l->capacity; i++) {
+    if (!l->keys[i]) continue;
+    size_t tile = l->keys[i] - 1;
+    civ_owner_index_t owner = civ_map_owner_at(map, tile);
+    if (owner == CIV_OWNER_NONE) continue;
+    if (owner >= manager->owner_loss_capacity) {
+      size_t cap = MAX((size_t)owner + 1, manager->owner_loss_capacity * 2);
+      float *grown = CIV_REALLOC(manager->owner_loss, cap * sizeof(float));
+      if (!grown) continue;
+      memset(grown + manager->owner_loss_capacity, 0,
+             (cap - manager->owner_loss_capacity) * sizeof(float));
+      manager->owner_loss = grown;
+      manager->owner_loss_capacity = cap;
+    }
+    /* What the land yields plus who lives on it */
+    const civ_map_tile_t *t = &map->tiles[tile];
+    float value = 0.5f * (civ_tile_resources(t) + civ_tile_fertility(t)) +
+                  civ_tile_population_density(t);
+    manager->owner_loss[owner] += MIN(1.0f, l->damage[i]) * value;
+  }
+}
+
+size_t civ_disaster_apply_impact(civ_disaster_manager_t *manager,
+                                 civ_settlement_manager_t *settlements,
+                                 civ_unit_manager_t *units) {
+  if (!manager) return 0;
+  const civ_map_t *map = manager->map;
+  size_t applied = manager->fresh.count;
+  if (!map || applied == 0) {
+    for (size_t i = 0; i < manager->disaster_count; i++)
+      manager->active_disasters[i].impact_pending = false;
+    layer_clear(&manager->fresh);
+    return 0;
+  }
+
+  /* Everyone under any new footprint's box, once */
+  index_list_t hit_s = {0}, hit_u = {0};
   for (size_t i = 0; i < manager->disaster_count; i++) {
     civ_disaster_t *d = &manager->active_disasters[i];
-    if (!d->active)
+    if (!d->impact_pending) continue;
+    d->impact_pending = false;
+    int32_t r = (int32_t)ceilf(d->radius);
+    int32_t y0 = MAX(0, d->y - r), y1 = MIN(map->height - 1, d->y + r);
+    int32_t x0 = d->x - r, x1 = d->x + r;
+    if (x1 - x0 + 1 >= map->width) {
+      gather_span(settlements, units, 0, y0, map->width - 1, y1, &hit_s, &hit_u);
       continue;
-
-    double elapsed_hours = difftime(now, d->start_time) / 3600.0;
-    if (elapsed_hours > d->duration_hours) {
-      d->active = false;
     }
+    gather_span(settlements, units, MAX(0, x0), y0, MIN(map->width - 1, x1), y1,
+                &hit_s, &hit_u);
+    if (x0 < 0)
+      gather_span(settlements, units, x0 + map->width, y0, map->width - 1, y1,
+                  &hit_s, &hit_u);
+    if (x1 >= map->width)
+      gather_span(settlements, units, 0, y0, x1 - map->width, y1, &hit_s,
+                  &hit_u);
   }
+  list_unique(&hit_s);
+  list_unique(&hit_u);
 
-  // Random spawn logic could go here (e.g., 0.01% chance per tick based on
-  // geography)
-  if (rand() % 10000 < 5) { // 0.05% chance
-    civ_coordinate_t loc = {(civ_float_t)(rand() % 100),
-                            (civ_float_t)(rand() % 100)};
-    civ_disaster_trigger(manager, (civ_disaster_type_t)(rand() % 7), loc,
-                         (civ_float_t)(rand() % 100) / 100.0f);
+  for (size_t k = 0; k < hit_s.count; k++) {
+    civ_settlement_t *s = &settlements->settlements[hit_s.items[k]];
+    int32_t tx = (int32_t)s->x, ty = (int32_t)s->y;
+    if (tx < 0 || tx >= map->width || ty < 0 || ty >= map->height) continue;
+    float dmg = MIN(1.0f, layer_get(&manager->fresh,
+                                    (uint32_t)((size_t)ty * map->width + tx)));
+    if (dmg <= 0.0f) continue;
+    int64_t lost = (int64_t)((double)s->population * dmg * POPULATION_LOSS);
+    s->population -= lost;
+    s->unrest = MIN(1.0f, s->unrest + dmg * UNREST_GAIN);
+    manager->stats.settlements_hit++;
+    manager->stats.population_lost += lost;
   }
+
+  /* Highest index first: a death moves the last unit down into its place,
+     and that one has been seen already */
+  for (size_t k = hit_u.count; k-- > 0;) {
+    size_t i = hit_u.items[k];
+    if (i >= units->unit_count || units->x[i] < 0 || units->y[i] < 0 ||
+        units->x[i] >= map->width || units->y[i] >= map->height)
+      continue;
+    float dmg = MIN(1.0f, layer_get(&manager->fresh,
+                                    (uint32_t)((size_t)units->y[i] * map->width +
+                                               units->x[i])));
+    int32_t losses = (int32_t)((float)units->strength[i] * dmg * UNIT_LOSS + 0.5f);
+    if (losses <= 0) continue;
+    manager->stats.units_hit++;
+    manager->stats.unit_losses += MIN(losses, units->strength[i]);
+    civ_unit_manager_apply_losses(units, i, losses);
+  }
+  CIV_FREE(hit_s.items);
+  CIV_FREE(hit_u.items);
+
+  charge_owners(manager);
+  const civ_disaster_layer_t *f = &manager->fresh;
+  for (uint32_t i = 0; i < f->capacity; i++)
+    if (f->keys[i]) layer_add(&manager->damage, f->keys[i] - 1, f->damage[i]);
+  layer_clear(&manager->fresh);
+  return applied;
+}
+
+size_t civ_disaster_active_count(const civ_disaster_manager_t *manager) {
+  if (!manager)
+    return 0;
+  size_t active = 0;
+  for (size_t i = 0; i < manager->disaster_count; i++)
+    if (manager->active_disasters[i].active)
+      active++;
+  return active;
+}
+
+civ_float_t civ_disaster_damage_at(const civ_disaster_manager_t *manager,
+                                   int32_t x, int32_t y) {
+  if (!manager || !manager->map || x < 0 || y < 0 ||
+      x >= manager->map->width || y >= manager->map->height)
+    return 0.0f;
+  uint32_t tile = (uint32_t)((size_t)y * manager->map->width + x);
+  return MIN(1.0f, layer_get(&manager->damage, tile) +
+                       layer_get(&manager->fresh, tile));
+}
+
+civ_float_t civ_disaster_owner_loss(const civ_disaster_manager_t *manager,
+                                    civ_owner_index_t owner) {
+  if (!manager || owner >= manager->owner_loss_capacity)
+    return 0.0f;
+  return manager->owner_loss[owner];
 }
 
 civ_float_t civ_disaster_calculate_damage(const civ_disaster_t *disaster,
-                                          civ_coordinate_t target_loc) {
+                                          civ_float_t x, civ_float_t y) {
   if (!disaster || !disaster->active)
     return 0.0f;
 
-  civ_float_t dx = disaster->location.latitude - target_loc.latitude;
-  civ_float_t dy = disaster->location.longitude - target_loc.longitude;
+  civ_float_t dx = (civ_float_t)disaster->x - x;
+  civ_float_t dy = (civ_float_t)disaster->y - y;
   civ_float_t dist = sqrt(dx * dx + dy * dy);
 
   if (dist > disaster->radius)
@@ -12,6 +12,8 @@
 
 
 #define EARTH_RADIUS_KM 6371.0
+#define KM_PER_DEGREE   (EARTH_RADIUS_KM * M_PI / 180.0)
+#define SHORT_HOP_KM    500.0 /* legs below this skip the haversine */
 
 civ_geography_t *civ_geography_create(const char *region_name,
                                       civ_coordinate_t sw,
@@ -85,6 +87,16 @@ civ_result_t civ_geography_add_land_patch(civ_geography_t *geo,
 
 civ_float_t civ_geography_calculate_distance(civ_coordinate_t a,
                                              civ_coordinate_t b) {
+  /* Short hops are flat to well under a percent: one cosine, no haversine */
+  civ_float_t dlon_deg = fabs(b.longitude - a.longitude);
+  if (dlon_deg > 180.0) dlon_deg = 360.0 - dlon_deg;
+  civ_float_t ns = fabs(b.latitude - a.latitude) * KM_PER_DEGREE;
+  if (ns < SHORT_HOP_KM && dlon_deg * KM_PER_DEGREE < SHORT_HOP_KM) {
+    civ_float_t ew = dlon_deg * KM_PER_DEGREE *
+                     cos(0.5 * (a.latitude + b.latitude) * M_PI / 180.0);
+    return sqrt(ew * ew + ns * ns);
+  }
+
   /* Haversine formula for great-circle distance */
   civ_float_t lat1 = a.latitude * M_PI / 180.0f;
   civ_float_t lon1 = a.longitude * M_PI / 180.0f;
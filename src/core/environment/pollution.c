@@ -0,0 +1,218 @@
+/**
+ * @file pollution.c
+ * @brief Implementation of the coarse pollution field
+ */
+#include "core/environment/pollution.h"
+#include "common.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_BLUR_WEIGHT 0.25f /* per pass; more would overshoot */
+
+/* Wind of a row, positive eastwards: -sin(6 |lat|) puts easterlies at 15
+   degrees, westerlies at 45 and easterlies again at 75, calm between */
+static float wind_of_row(int32_t row, int32_t rows) {
+  float lat = 90.0f - ((float)row + 0.5f) * 180.0f / (float)rows;
+  return -CIV_POLLUTION_WIND * sinf(6.0f * fabsf(lat) * (float)M_PI / 180.0f);
+}
+
+civ_pollution_field_t *civ_pollution_create(int32_t map_width,
+                                            int32_t map_height) {
+  if (map_width <= 0 || map_height <= 0)
+    return NULL;
+  civ_pollution_field_t *field =
+      (civ_pollution_field_t *)CIV_CALLOC(1, sizeof(civ_pollution_field_t));
+  if (!field) {
+    civ_log(CIV_LOG_ERROR, "Failed to allocate pollution field");
+    return NULL;
+  }
+  field->map_width = map_width;
+  field->map_height = map_height;
+  field->cols = (map_width + CIV_POLLUTION_CELL - 1) / CIV_POLLUTION_CELL;
+  field->rows = (map_height + CIV_POLLUTION_CELL - 1) / CIV_POLLUTION_CELL;
+  size_t cells = (size_t)field->cols * (size_t)field->rows;
+  field->level = (float *)CIV_CALLOC(cells, sizeof(float));
+  field->deposit = (float *)CIV_CALLOC(cells, sizeof(float));
+  field->scratch = (float *)CIV_CALLOC(cells, sizeof(float));
+  field->wind = (float *)CIV_MALLOC((size_t)field->rows * sizeof(float));
+  if (!field->level || !field->deposit || !field->scratch || !field->wind) {
+    civ_log(CIV_LOG_ERROR, "Failed to allocate pollution grid");
+    civ_pollution_destroy(field);
+    return NULL;
+  }
+  for (int32_t y = 0; y < field->rows; y++)
+    field->wind[y] = wind_of_row(y, field->rows);
+  return field;
+}
+
+void civ_pollution_destroy(civ_pollution_field_t *field) {
+  if (!field)
+    return;
+  CIV_FREE(field->level);
+  CIV_FREE(field->deposit);
+  CIV_FREE(field->scratch);
+  CIV_FREE(field->wind);
+  CIV_FREE(field);
+}
+
+/* Cell of tile (x, y), x wrapped and y clamped */
+static size_t cell_of(const civ_pollution_field_t *f, int32_t x, int32_t y) {
+  int32_t wx = ((x % f->map_width) + f->map_width) % f->map_width;
+  int32_t cy = CLAMP(y, 0, f->map_height - 1) / CIV_POLLUTION_CELL;
+  return (size_t)cy * (size_t)f->cols + (size_t)(wx / CIV_POLLUTION_CELL);
+}
+
+void civ_pollution_emit(civ_pollution_field_t *field, int32_t x, int32_t y,
+                        civ_float_t amount) {
+  if (!field || !(amount > 0.0))
+    return;
+  field->deposit[cell_of(field, x, y)] += (float)amount;
+  field->emitted += amount;
+}
+
+static civ_owner_index_t owner_of(const civ_settlement_manager_t *sm,
+                                  const civ_settlement_t *s) {
+  return s->owner_index >= 0 && (size_t)s->owner_index < sm->owner_count
+             ? sm->owner_ids[s->owner_index]
+             : CIV_OWNER_NONE;
+}
+
+civ_float_t civ_pollution_emit_settlements(civ_pollution_field_t *field,
+                                           const civ_settlement_manager_t *sm,
+                                           civ_owner_index_t owner,
+                                           civ_float_t amount) {
+  if (!field || !sm || !(amount > 0.0))
+    return 0.0;
+  double people = 0.0;
+  for (size_t k = 0; k < sm->settlement_count; k++) {
+    const civ_settlement_t *s = &sm->settlements[k];
+    if (owner == CIV_OWNER_NONE || owner_of(sm, s) == owner)
+      people += (double)MAX(s->population, (int64_t)0);
+  }
+  if (people <= 0.0)
+    return 0.0;
+  for (size_t k = 0; k < sm->settlement_count; k++) {
+    const civ_settlement_t *s = &sm->settlements[k];
+    if ((owner == CIV_OWNER_NONE || owner_of(sm, s) == owner) &&
+        s->population > 0)
+      civ_pollution_emit(field, (int32_t)s->x, (int32_t)s->y,
+                         amount * (double)s->population / people);
+  }
+  return amount;
+}
+
+/* Each row slides along its wind by linear interpolation between the two
+   cells it lands across, so every cell's pollution is split, not lost */
+static void advect(civ_pollution_field_t *f, float dt) {
+  int32_t cols = f->cols;
+  for (int32_t y = 0; y < f->rows; y++) {
+    float shift = fmodf(f->wind[y] * dt, (float)cols);
+    if (shift < 0.0f)
+      shift += (float)cols;
+    int32_t whole = (int32_t)shift;
+    float part = shift - (float)whole;
+    const float *in = f->level + (size_t)y * cols;
+    float *out = f->scratch + (size_t)y * cols;
+    for (int32_t x = 0; x < cols; x++) {
+      int32_t from = ((x - whole) % cols + cols) % cols;
+      int32_t behind = from == 0 ? cols - 1 : from - 1;
+      out[x] = (1.0f - part) * in[from] + part * in[behind];
+    }
+  }
+  float *t = f->level;
+  f->level = f->scratch;
+  f->scratch = t;
+}
+
+/* One 3-tap pass along x, wrapping */
+static void blur_x(civ_pollution_field_t *f, float a) {
+  int32_t cols = f->cols;
+  for (int32_t y = 0; y < f->rows; y++) {
+    const float *in = f->level + (size_t)y * cols;
+    float *out = f->scratch + (size_t)y * cols;
+    for (int32_t x = 0; x < cols; x++) {
+      float left = in[x == 0 ? cols - 1 : x - 1];
+      float right = in[x == cols - 1 ? 0 : x + 1];
+      out[x] = (1.0f - 2.0f * a) * in[x] + a * (left + right);
+    }
+  }
+  float *t = f->level;
+  f->level = f->scratch;
+  f->scratch = t;
+}
+
+/* One 3-tap pass along y, each row at once; the poles reflect */
+static void blur_y(civ_pollution_field_t *f, float a) {
+  size_t cols = (size_t)f->cols;
+  for (int32_t y = 0; y < f->rows; y++) {
+    const float *in = f->level + (size_t)y * cols;
+    const float *up = y > 0 ? in - cols : in;
+    const float *down = y < f->rows - 1 ? in + cols : in;
+    float *restrict out = f->scratch + (size_t)y * cols;
+    for (size_t x = 0; x < cols; x++)
+      out[x] = (1.0f - 2.0f * a) * in[x] + a * (up[x] + down[x]);
+  }
+  float *t = f->level;
+  f->level = f->scratch;
+  f->scratch = t;
+}
+
+void civ_pollution_step(civ_pollution_field_t *field, civ_float_t dt) {
+  if (!field || !(dt > 0.0))
+    return;
+  size_t cells = (size_t)field->cols * (size_t)field->rows;
+  for (size_t c = 0; c < cells; c++)
+    field->level[c] += field->deposit[c];
+  memset(field->deposit, 0, cells * sizeof(float));
+
+  advect(field, (float)dt);
+
+  /* Explicit diffusion is stable to a quarter per pass; longer steps take
+     more passes */
+  float spread = CIV_POLLUTION_DIFFUSION * (float)dt;
+  int passes = MAX((int)ceilf(spread / MAX_BLUR_WEIGHT), 1);
+  float a = spread / (float)passes;
+  for (int p = 0; p < passes; p++) {
+    blur_x(field, a);
+    blur_y(field, a);
+  }
+
+  float keep = expf(-CIV_POLLUTION_DECAY * (float)dt);
+  for (size_t c = 0; c < cells; c++)
+    field->level[c] *= keep;
+  field->steps++;
+}
+
+civ_float_t civ_pollution_at(const civ_pollution_field_t *field, int32_t x,
+                             int32_t y) {
+  if (!field)
+    return 0.0;
+  return field->level[cell_of(field, x, y)];
+}
+
+civ_float_t civ_pollution_harm(civ_float_t level) {
+  return level > 0.0 ? level / (level + CIV_POLLUTION_HARMFUL) : 0.0;
+}
+
+civ_float_t civ_pollution_apply(const civ_pollution_field_t *field,
+                                civ_settlement_manager_t *sm,
+                                civ_owner_index_t owner, civ_float_t dt) {
+  if (!field || !sm)
+    return 0.0;
+  double harmed = 0.0, people = 0.0;
+  for (size_t k = 0; k < sm->settlement_count; k++) {
+    civ_settlement_t *s = &sm->settlements[k];
+    civ_float_t harm = civ_pollution_harm(
+        civ_pollution_at(field, (int32_t)s->x, (int32_t)s->y));
+    s->demographics.health_index = 1.0 - harm;
+    if (dt > 0.0)
+      s->unrest = CLAMP(s->unrest + harm * CIV_POLLUTION_UNREST * dt, 0.0, 1.0);
+    if (s->population > 0 &&
+        (owner == CIV_OWNER_NONE || owner_of(sm, s) == owner)) {
+      harmed += harm * (double)s->population;
+      people += (double)s->population;
+    }
+  }
+  return people > 0.0 ? harmed / people : 0.0;
+}
@@ -5,10 +5,26 @@
 
 #include "core/events/event_manager.h"
 #include "common.h"
+#include "utils/frame_trace.h"
+#include "utils/rng.h"
+#include "utils/store_registry.h"
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
+/* Posts go onto a Treiber stack, as in event_dispatcher.c: producers CAS
+   onto the head and the merge takes the list with one exchange. seq counts
+   the posting thread's posts, which orders one source's events. */
+struct civ_event_staged {
+    civ_event_staged_t* next;
+    uint32_t source;
+    uint64_t seq;
+    size_t arrival;             /* set by the merge; ties only */
+    civ_game_event_t event;
+};
+
+static CIV_THREAD_LOCAL uint64_t t_post_seq;
+
 civ_event_manager_t* civ_event_manager_create(void) {
     civ_event_manager_t* em = (civ_event_manager_t*)CIV_MALLOC(sizeof(civ_event_manager_t));
     if (!em) {
@@ -17,25 +33,34 @@ civ_event_manager_t* civ_event_manager_create(void) {
     }
     
     civ_event_manager_init(em);
+    CIV_STORE_REGISTER("events.log", em, em->event_count, em->event_capacity,
+                       sizeof(civ_game_event_t), CIV_STORE_APPEND);
     return em;
 }
 
 void civ_event_manager_destroy(civ_event_manager_t* em) {
     if (!em) return;
     
+    civ_store_unregister_owner(em);
+    /* Posts never merged */
+    civ_event_staged_t* staged = (civ_event_staged_t*)SDL_SetAtomicPointer((void**)&em->staged, NULL);
+    while (staged) {
+        civ_event_staged_t* next = staged->next;
+        CIV_FREE(staged->event.data);
+        CIV_FREE(staged);
+        staged = next;
+    }
     /* Free all handlers */
-    civ_event_handler_t* handler = em->handlers;
-    while (handler) {
-        civ_event_handler_t* next = handler->next;
-        CIV_FREE(handler);
-        handler = next;
+    for (size_t t = 0; t <= CIV_EVENT_TYPE_COUNT; t++) {
+        CIV_FREE(em->handlers[t].handlers);
     }
     
     /* Free events */
     if (em->events) {
         for (size_t i = 0; i < em->event_count; i++) {
-            if (em->events[i].data) {
-                CIV_FREE(em->events[i].data);
+            civ_game_event_t* e = &em->events[(em->event_head + i) % em->event_capacity];
+            if (e->data) {
+                CIV_FREE(e->data);
             }
         }
         CIV_FREE(em->events);
@@ -48,11 +73,18 @@ void civ_event_manager_init(civ_event_manager_t* em) {
     if (!em) return;
     
     memset(em, 0, sizeof(civ_event_manager_t));
-    em->event_capacity = 100;
+    em->event_capacity = CIV_EVENT_STORE_CAPACITY;
     em->events = (civ_game_event_t*)CIV_CALLOC(em->event_capacity, sizeof(civ_game_event_t));
+    if (!em->events) em->event_capacity = 0;
     em->last_update = time(NULL);
 }
 
+static civ_event_handler_list_t* handler_list(civ_event_manager_t* em, civ_event_type_t type) {
+    if (type == CIV_EVENT_TYPE_ANY) return &em->handlers[CIV_EVENT_TYPE_COUNT];
+    if (type < 0 || type >= CIV_EVENT_TYPE_COUNT) return NULL;
+    return &em->handlers[type];
+}
+
 civ_result_t civ_event_manager_register_handler(civ_event_manager_t* em, civ_event_type_t type,
                                                  civ_event_handler_cb_t callback, void* user_data) {
     civ_result_t result = {CIV_OK, NULL};
@@ -61,22 +93,89 @@ civ_result_t civ_event_manager_register_handler(civ_event_manager_t* em, civ_eve
         result.error = CIV_ERROR_NULL_POINTER;
         return result;
     }
-    
-    civ_event_handler_t* handler = (civ_event_handler_t*)CIV_MALLOC(sizeof(civ_event_handler_t));
-    if (!handler) {
-        result.error = CIV_ERROR_OUT_OF_MEMORY;
+    civ_event_handler_list_t* list = handler_list(em, type);
+    if (!list) {
+        result.error = CIV_ERROR_INVALID_ARGUMENT;
         return result;
     }
     
-    handler->event_type = type;
-    handler->callback = callback;
-    handler->user_data = user_data;
-    handler->next = em->handlers;
-    em->handlers = handler;
+    if (list->count >= list->capacity) {
+        size_t capacity = list->capacity ? list->capacity * 2 : 4;
+        civ_event_handler_t* handlers = (civ_event_handler_t*)CIV_REALLOC(
+            list->handlers, capacity * sizeof(civ_event_handler_t));
+        if (!handlers) {
+            result.error = CIV_ERROR_OUT_OF_MEMORY;
+            return result;
+        }
+        list->handlers = handlers;
+        list->capacity = capacity;
+    }
+    list->handlers[list->count++] = (civ_event_handler_t){callback, user_data};
     
     return result;
 }
 
+/* Handlers may register more handlers, so re-read the list every step */
+static void dispatch(civ_event_manager_t* em, const civ_game_event_t* event) {
+    civ_frame_trace_count(CIV_FRAME_EVENTS_DISPATCHED, 1);
+    civ_event_handler_list_t* lists[2] = {handler_list(em, event->type),
+                                          handler_list(em, CIV_EVENT_TYPE_ANY)};
+    for (int l = 0; l < 2; l++) {
+        if (!lists[l]) continue;
+        for (size_t i = 0; i < lists[l]->count; i++) {
+            civ_event_handler_t h = lists[l]->handlers[i];
+            h.callback(event, h.user_data);
+        }
+    }
+}
+
+/* Journal record of an evicted event: this header, then the description */
+typedef struct {
+    int32_t type;
+    float importance;
+    int64_t timestamp;
+} spill_record_t;
+
+static void evict_oldest(civ_event_manager_t* em) {
+    civ_game_event_t* e = &em->events[em->event_head];
+    if (em->spill) {
+        uint8_t record[sizeof(spill_record_t) + STRING_MAX_LEN];
+        spill_record_t header = {(int32_t)e->type, (float)e->importance, (int64_t)e->timestamp};
+        size_t len = strnlen(e->description, sizeof(e->description));
+        memcpy(record, &header, sizeof(header));
+        memcpy(record + sizeof(header), e->description, len);
+        civ_journal_log(em->spill, CIV_JOURNAL_GENERIC_LOG, e->title, record,
+                        sizeof(header) + len);
+    }
+    if (e->data) CIV_FREE(e->data);
+    e->data = NULL;
+    em->event_head = (em->event_head + 1) % em->event_capacity;
+    em->event_count--;
+    em->events_evicted++;
+    if (em->pending_count > em->event_count) em->pending_count = em->event_count;
+}
+
+/* Dispatch the pending events from a copy, since handlers may emit more
+   and push them out of the ring */
+static void dispatch_batch(civ_event_manager_t* em) {
+    size_t n = em->pending_count;
+    if (n == 0) return;
+    em->pending_count = 0;
+    size_t first = em->event_head + em->event_count - n;
+    civ_game_event_t* batch = (civ_game_event_t*)CIV_MALLOC(n * sizeof(civ_game_event_t));
+    if (!batch) {
+        civ_log(CIV_LOG_ERROR, "Event manager: no memory for deferred batch");
+        for (size_t i = 0; i < n; i++)
+            dispatch(em, &em->events[(first + i) % em->event_capacity]);
+        return;
+    }
+    for (size_t i = 0; i < n; i++)
+        batch[i] = em->events[(first + i) % em->event_capacity];
+    for (size_t i = 0; i < n; i++)
+        dispatch(em, &batch[i]);
+    CIV_FREE(batch);
+}
+
 civ_result_t civ_event_manager_emit_event(civ_event_manager_t* em, const civ_game_event_t* event) {
     civ_result_t result = {CIV_OK, NULL};
     
@@ -85,24 +184,24 @@ civ_result_t civ_event_manager_emit_event(civ_event_manager_t* em, const civ_gam
         return result;
     }
     
-    /* Store event */
-    if (em->event_count >= em->event_capacity) {
-        em->event_capacity *= 2;
-        em->events = (civ_game_event_t*)CIV_REALLOC(em->events, 
-                                                    em->event_capacity * sizeof(civ_game_event_t));
-    }
-    
-    if (em->events) {
-        em->events[em->event_count++] = *event;
+    /* Store event; a full ring drops its oldest, so pending ones go out first */
+    if (em->event_capacity > 0) {
+        if (em->deferred && em->pending_count == em->event_capacity) {
+            dispatch_batch(em);
+        }
+        if (em->event_count == em->event_capacity) {
+            evict_oldest(em);
+        }
+        em->events[(em->event_head + em->event_count) % em->event_capacity] = *event;
+        em->event_count++;
     }
+    em->events_emitted++;
     
     /* Notify handlers */
-    civ_event_handler_t* handler = em->handlers;
-    while (handler) {
-        if (handler->event_type == event->type || handler->event_type == -1) {
-            handler->callback(event, handler->user_data);
-        }
-        handler = handler->next;
+    if (em->deferred && em->event_capacity > 0) {
+        em->pending_count++;
+    } else {
+        dispatch(em, event);
     }
     
     return result;
@@ -119,7 +218,8 @@ civ_result_t civ_event_manager_create_event(civ_event_manager_t* em, civ_event_t
     }
     
     civ_game_event_t event = {0};
-    snprintf(event.event_id, sizeof(event.event_id), "event_%zu", em->event_count);
+    snprintf(event.event_id, sizeof(event.event_id), "event_%llu",
+             (unsigned long long)em->events_emitted);
     event.type = type;
     strncpy(event.title, title, sizeof(event.title) - 1);
     strncpy(event.description, description, sizeof(event.description) - 1);
@@ -130,11 +230,110 @@ civ_result_t civ_event_manager_create_event(civ_event_manager_t* em, civ_event_t
     return civ_event_manager_emit_event(em, &event);
 }
 
+static int compare_staged(const void* a, const void* b) {
+    const civ_event_staged_t* x = *(civ_event_staged_t* const*)a;
+    const civ_event_staged_t* y = *(civ_event_staged_t* const*)b;
+    if (x->source != y->source) return x->source < y->source ? -1 : 1;
+    if (x->seq != y->seq) return x->seq < y->seq ? -1 : 1;
+    return x->arrival < y->arrival ? -1 : x->arrival > y->arrival;
+}
+
+civ_result_t civ_event_manager_post(civ_event_manager_t* em, uint32_t source,
+                                    const civ_game_event_t* event) {
+    if (!em || !event) {
+        return (civ_result_t){CIV_ERROR_NULL_POINTER, NULL};
+    }
+
+    civ_event_staged_t* staged = (civ_event_staged_t*)CIV_MALLOC(sizeof(civ_event_staged_t));
+    if (!staged) {
+        return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Failed to stage event"};
+    }
+    staged->source = source;
+    staged->seq = t_post_seq++;
+    staged->event = *event;
+
+    void* head;
+    do {
+        head = SDL_GetAtomicPointer((void**)&em->staged);
+        staged->next = (civ_event_staged_t*)head;
+    } while (!SDL_CompareAndSwapAtomicPointer((void**)&em->staged, head, staged));
+    SDL_AddAtomicInt(&em->staged_count, 1);
+
+    return (civ_result_t){CIV_OK, NULL};
+}
+
+size_t civ_event_manager_merge_posted(civ_event_manager_t* em) {
+    if (!em || SDL_GetAtomicInt(&em->staged_count) == 0) return 0;
+
+    civ_event_staged_t* staged = (civ_event_staged_t*)SDL_SetAtomicPointer((void**)&em->staged, NULL);
+
+    /* Newest first -> arrival order */
+    civ_event_staged_t* ordered = NULL;
+    size_t count = 0;
+    while (staged) {
+        civ_event_staged_t* next = staged->next;
+        staged->next = ordered;
+        ordered = staged;
+        staged = next;
+        count++;
+    }
+    SDL_AddAtomicInt(&em->staged_count, -(int)count);
+    if (count == 0) return 0;
+
+    civ_event_staged_t** sorted = (civ_event_staged_t**)CIV_MALLOC(count * sizeof(civ_event_staged_t*));
+    if (sorted) {
+        size_t i = 0;
+        for (civ_event_staged_t* s = ordered; s; s = s->next, i++) {
+            s->arrival = i;
+            sorted[i] = s;
+        }
+        qsort(sorted, count, sizeof(civ_event_staged_t*), compare_staged);
+        for (i = 0; i + 1 < count; i++) sorted[i]->next = sorted[i + 1];
+        sorted[count - 1]->next = NULL;
+        ordered = sorted[0];
+        CIV_FREE(sorted);
+    } else {
+        civ_log(CIV_LOG_ERROR, "Event manager: no memory to order %zu posts", count);
+    }
+
+    while (ordered) {
+        civ_event_staged_t* next = ordered->next;
+        civ_event_manager_emit_event(em, &ordered->event);
+        CIV_FREE(ordered);
+        ordered = next;
+    }
+    return count;
+}
+
 void civ_event_manager_update(civ_event_manager_t* em, civ_float_t time_delta) {
     if (!em) return;
     
+    /* Posts made outside a deferred phase land here, once per tick */
+    if (!em->deferred) civ_event_manager_merge_posted(em);
+    
     /* Update event manager (could process scheduled events, etc.) */
     time_t current_time = time(NULL);
     em->last_update = current_time;
 }
 
+const civ_game_event_t* civ_event_manager_get_event(const civ_event_manager_t* em, size_t index) {
+    if (!em || index >= em->event_count) return NULL;
+    return &em->events[(em->event_head + index) % em->event_capacity];
+}
+
+void civ_event_manager_set_spill(civ_event_manager_t* em, civ_journal_t* journal) {
+    if (em) em->spill = journal;
+}
+
+void civ_event_manager_defer(civ_event_manager_t* em) {
+    if (em) em->deferred = true;
+}
+
+void civ_event_manager_dispatch_deferred(civ_event_manager_t* em) {
+    if (!em) return;
+    civ_event_manager_merge_posted(em);
+    while (em->pending_count > 0) {
+        dispatch_batch(em);
+    }
+    em->deferred = false;
+}
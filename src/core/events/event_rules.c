@@ -0,0 +1,338 @@
+/**
+ * @file event_rules.c
+ * @brief Implementation of event trigger rules
+ */
+
+#include "core/events/event_rules.h"
+#include "common.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+civ_event_rules_t* civ_event_rules_create(void) {
+    civ_event_rules_t* rules = (civ_event_rules_t*)CIV_CALLOC(1, sizeof(civ_event_rules_t));
+    if (!rules) {
+        civ_log(CIV_LOG_ERROR, "Failed to allocate event rules");
+        return NULL;
+    }
+    return rules;
+}
+
+void civ_event_rules_destroy(civ_event_rules_t* rules) {
+    if (!rules) return;
+
+    for (size_t f = 0; f < rules->fact_count; f++) {
+        CIV_FREE(rules->fact_index[f].entries);
+    }
+    CIV_FREE(rules->fact_symbol);
+    CIV_FREE(rules->fact_value);
+    CIV_FREE(rules->fact_seen);
+    CIV_FREE(rules->fact_known);
+    CIV_FREE(rules->fact_index);
+    CIV_FREE(rules->fact_dirty);
+    CIV_FREE(rules->dirty);
+    CIV_FREE(rules->fact_of);
+    CIV_FREE(rules->predicate_rule);
+    CIV_FREE(rules->predicate_op);
+    CIV_FREE(rules->predicate_true);
+    CIV_FREE(rules->rules);
+    CIV_FREE(rules->touched);
+    CIV_FREE(rules);
+}
+
+/* Grow one column to capacity elements; false leaves it as it was */
+static bool grow_column(void** column, size_t elem_size, size_t capacity) {
+    void* grown = CIV_REALLOC(*column, capacity * elem_size);
+    if (!grown) return false;
+    *column = grown;
+    return true;
+}
+
+static bool reserve_fact(civ_event_rules_t* rules) {
+    if (rules->fact_count < rules->fact_capacity) return true;
+    size_t capacity = rules->fact_capacity ? rules->fact_capacity * 2 : 16;
+    if (!grow_column((void**)&rules->fact_symbol, sizeof(civ_symbol_t), capacity) ||
+        !grow_column((void**)&rules->fact_value, sizeof(civ_float_t), capacity) ||
+        !grow_column((void**)&rules->fact_seen, sizeof(civ_float_t), capacity) ||
+        !grow_column((void**)&rules->fact_known, sizeof(uint8_t), capacity) ||
+        !grow_column((void**)&rules->fact_index, sizeof(civ_rule_index_t), capacity) ||
+        !grow_column((void**)&rules->fact_dirty, sizeof(uint8_t), capacity) ||
+        !grow_column((void**)&rules->dirty, sizeof(uint32_t), capacity)) {
+        return false;
+    }
+    rules->fact_capacity = capacity;
+    return true;
+}
+
+static bool reserve_lookup(civ_event_rules_t* rules, civ_symbol_t id) {
+    if (id < rules->fact_of_size) return true;
+    uint32_t size = MAX(civ_symbol_count(), id + 1);
+    int32_t* fact_of = CIV_REALLOC(rules->fact_of, size * sizeof(int32_t));
+    if (!fact_of) return false;
+    for (uint32_t k = rules->fact_of_size; k < size; k++) fact_of[k] = -1;
+    rules->fact_of = fact_of;
+    rules->fact_of_size = size;
+    return true;
+}
+
+static int32_t declare_fact(civ_event_rules_t* rules, civ_symbol_t id) {
+    if (id == CIV_SYMBOL_NONE || !reserve_lookup(rules, id)) return -1;
+    if (rules->fact_of[id] >= 0) return rules->fact_of[id];
+    if (!reserve_fact(rules)) {
+        civ_log(CIV_LOG_ERROR, "Failed to grow event rule facts");
+        return -1;
+    }
+
+    size_t f = rules->fact_count++;
+    rules->fact_of[id] = (int32_t)f;
+    rules->fact_symbol[f] = id;
+    rules->fact_value[f] = 0.0f;
+    rules->fact_seen[f] = 0.0f;
+    rules->fact_known[f] = 0;
+    rules->fact_index[f] = (civ_rule_index_t){0};
+    rules->fact_dirty[f] = 0;
+    return (int32_t)f;
+}
+
+int32_t civ_event_rules_fact(civ_event_rules_t* rules, const char* name) {
+    if (!rules || !name) return -1;
+    return declare_fact(rules, civ_symbol_intern(name));
+}
+
+void civ_event_rules_set(civ_event_rules_t* rules, size_t fact, civ_float_t value) {
+    if (!rules || fact >= rules->fact_count) return;
+    /* Unchanged facts cost nothing at the next evaluation */
+    if ((rules->fact_known[fact] & CIV_FACT_SET) && rules->fact_value[fact] == value)
+        return;
+    rules->fact_known[fact] |= CIV_FACT_SET;
+    rules->fact_value[fact] = value;
+    if (!rules->fact_dirty[fact]) {
+        rules->fact_dirty[fact] = 1;
+        rules->dirty[rules->dirty_count++] = (uint32_t)fact;
+    }
+}
+
+civ_result_t civ_event_rules_set_fact(civ_event_rules_t* rules, civ_symbol_t fact,
+                                      civ_float_t value) {
+    if (!rules)
+        return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null event rules"};
+    int32_t f = declare_fact(rules, fact);
+    if (f < 0)
+        return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Failed to declare fact"};
+    civ_event_rules_set(rules, (size_t)f, value);
+    return (civ_result_t){CIV_OK, NULL};
+}
+
+civ_float_t civ_event_rules_get(const civ_event_rules_t* rules, size_t fact) {
+    if (!rules || fact >= rules->fact_count) return 0.0f;
+    return rules->fact_value[fact];
+}
+
+bool civ_event_rules_known(const civ_event_rules_t* rules, size_t fact) {
+    return rules && fact < rules->fact_count &&
+           (rules->fact_known[fact] & CIV_FACT_SET);
+}
+
+static bool test(civ_rule_op_t op, civ_float_t value, civ_float_t threshold) {
+    switch (op) {
+    case CIV_RULE_LT: return value < threshold;
+    case CIV_RULE_LE: return value <= threshold;
+    case CIV_RULE_GT: return value > threshold;
+    case CIV_RULE_GE: return value >= threshold;
+    case CIV_RULE_EQ: return value == threshold;
+    }
+    return false;
+}
+
+static void touch(civ_event_rules_t* rules, uint32_t r) {
+    if (rules->rules[r].touched) return;
+    rules->rules[r].touched = true;
+    rules->touched[rules->touched_count++] = r;
+}
+
+int32_t civ_event_rules_find(const civ_event_rules_t* rules, const char* id) {
+    if (!rules || !id) return -1;
+    for (size_t r = 0; r < rules->rule_count; r++) {
+        if (strcmp(rules->rules[r].id, id) == 0) return (int32_t)r;
+    }
+    return -1;
+}
+
+civ_result_t civ_event_rules_add(civ_event_rules_t* rules, const civ_event_rule_def_t* def) {
+    if (!rules || !def || !def->id)
+        return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null rule"};
+    if (def->predicate_count == 0 || def->predicate_count > CIV_EVENT_RULE_MAX_PREDICATES)
+        return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Rule needs 1 to 8 predicates"};
+
+    /* Declare the facts first so a failure leaves no half-compiled rule */
+    int32_t facts[CIV_EVENT_RULE_MAX_PREDICATES];
+    for (size_t k = 0; k < def->predicate_count; k++) {
+        const civ_rule_predicate_t* p = &def->predicates[k];
+        if (!p->fact || p->op > CIV_RULE_EQ)
+            return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Bad rule predicate"};
+        facts[k] = civ_event_rules_fact(rules, p->fact);
+        if (facts[k] < 0)
+            return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Failed to declare fact"};
+        /* A range over one fact puts two entries in its index */
+        size_t needed = rules->fact_index[facts[k]].count + 1;
+        for (size_t j = 0; j < k; j++) needed += facts[j] == facts[k];
+        civ_rule_index_t* index = &rules->fact_index[facts[k]];
+        if (needed > index->capacity) {
+            size_t capacity = index->capacity ? index->capacity * 2 : 4;
+            while (capacity < needed) capacity *= 2;
+            if (!grow_column((void**)&index->entries, sizeof(civ_rule_alpha_t), capacity))
+                return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Failed to grow fact index"};
+            index->capacity = capacity;
+        }
+    }
+
+    if (rules->predicate_count + def->predicate_count > rules->predicate_capacity) {
+        size_t capacity = rules->predicate_capacity ? rules->predicate_capacity * 2 : 32;
+        while (capacity < rules->predicate_count + def->predicate_count) capacity *= 2;
+        if (!grow_column((void**)&rules->predicate_rule, sizeof(uint32_t), capacity) ||
+            !grow_column((void**)&rules->predicate_op, sizeof(uint8_t), capacity) ||
+            !grow_column((void**)&rules->predicate_true, sizeof(uint8_t), capacity))
+            return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Failed to grow predicates"};
+        rules->predicate_capacity = capacity;
+    }
+    if (rules->rule_count >= rules->rule_capacity) {
+        size_t capacity = rules->rule_capacity ? rules->rule_capacity * 2 : 16;
+        if (!grow_column((void**)&rules->rules, sizeof(civ_event_rule_t), capacity) ||
+            !grow_column((void**)&rules->touched, sizeof(uint32_t), capacity))
+            return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Failed to grow rules"};
+        rules->rule_capacity = capacity;
+    }
+
+    uint32_t r = (uint32_t)rules->rule_count++;
+    civ_event_rule_t* rule = &rules->rules[r];
+    memset(rule, 0, sizeof(civ_event_rule_t));
+    strncpy(rule->id, def->id, sizeof(rule->id) - 1);
+    rule->type = def->type;
+    if (def->title) strncpy(rule->title, def->title, sizeof(rule->title) - 1);
+    if (def->description) strncpy(rule->description, def->description, sizeof(rule->description) - 1);
+    rule->importance = CLAMP(def->importance, 0.0f, 1.0f);
+    rule->action = def->action;
+    rule->user_data = def->user_data;
+    rule->predicate_count = (uint32_t)def->predicate_count;
+    rule->once = def->once;
+
+    /* Predicates start on the values last evaluated, so facts set since
+       still move them at the next evaluation */
+    for (size_t k = 0; k < def->predicate_count; k++) {
+        const civ_rule_predicate_t* p = &def->predicates[k];
+        uint32_t id = (uint32_t)rules->predicate_count++;
+        rules->predicate_rule[id] = r;
+        rules->predicate_op[id] = (uint8_t)p->op;
+        /* Predicates over a fact they have not seen yet are false */
+        rules->predicate_true[id] =
+            (rules->fact_known[facts[k]] & CIV_FACT_TESTED) &&
+            test(p->op, rules->fact_seen[facts[k]], p->threshold);
+        rule->satisfied += rules->predicate_true[id];
+
+        civ_rule_index_t* index = &rules->fact_index[facts[k]];
+        index->entries[index->count++] = (civ_rule_alpha_t){p->threshold, id};
+        index->sorted = false;
+    }
+    touch(rules, r);
+
+    return (civ_result_t){CIV_OK, NULL};
+}
+
+static int compare_alpha(const void* a, const void* b) {
+    civ_float_t ta = ((const civ_rule_alpha_t*)a)->threshold;
+    civ_float_t tb = ((const civ_rule_alpha_t*)b)->threshold;
+    return (ta > tb) - (ta < tb);
+}
+
+/* First entry with threshold >= value */
+static size_t lower_bound(const civ_rule_index_t* index, civ_float_t value) {
+    size_t lo = 0, hi = index->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (index->entries[mid].threshold < value) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/* Retest the predicates of fact whose answer can differ between the value
+   they saw and the current one: those with thresholds in between */
+static void propagate(civ_event_rules_t* rules, size_t fact) {
+    civ_rule_index_t* index = &rules->fact_index[fact];
+    civ_float_t before = rules->fact_seen[fact];
+    civ_float_t value = rules->fact_value[fact];
+    bool tested = rules->fact_known[fact] & CIV_FACT_TESTED;
+    rules->fact_seen[fact] = value;
+    rules->fact_known[fact] |= CIV_FACT_TESTED;
+    rules->fact_dirty[fact] = 0;
+    if (index->count == 0) return;
+
+    if (!index->sorted) {
+        qsort(index->entries, index->count, sizeof(civ_rule_alpha_t), compare_alpha);
+        index->sorted = true;
+    }
+
+    size_t first = 0, last = index->count;
+    /* The first value reaches every predicate: all were false before it */
+    if (tested) {
+        civ_float_t lo = MIN(before, value), hi = MAX(before, value);
+        first = lower_bound(index, lo);
+        last = first;
+        while (last < index->count && index->entries[last].threshold <= hi) last++;
+    }
+
+    for (size_t k = first; k < last; k++) {
+        uint32_t p = index->entries[k].predicate;
+        uint8_t now = test((civ_rule_op_t)rules->predicate_op[p], value, index->entries[k].threshold);
+        rules->tests++;
+        if (now == rules->predicate_true[p]) continue;
+        rules->predicate_true[p] = now;
+        uint32_t r = rules->predicate_rule[p];
+        if (now) rules->rules[r].satisfied++;
+        else rules->rules[r].satisfied--;
+        touch(rules, r);
+    }
+}
+
+static void fire(civ_event_rules_t* rules, size_t r, civ_event_manager_t* em) {
+    civ_event_rule_t* rule = &rules->rules[r];
+    rule->fired++;
+    rules->fired++;
+    if (rule->once) rule->retired = true;
+    if (em && rule->title[0]) {
+        civ_event_manager_create_event(em, rule->type, rule->title, rule->description,
+                                       rule->importance);
+    }
+    if (rule->action) rule->action(rule->id, rule->user_data);
+}
+
+size_t civ_event_rules_evaluate(civ_event_rules_t* rules, civ_event_manager_t* em) {
+    if (!rules) return 0;
+
+    for (size_t k = 0; k < rules->dirty_count; k++) {
+        propagate(rules, rules->dirty[k]);
+    }
+    rules->dirty_count = 0;
+
+    /* A rule fires when it holds now and did not at the last evaluation.
+       Actions may set facts, which wait for the next evaluation, and add
+       rules, which are touched behind the ones read here. */
+    size_t fired = 0;
+    size_t touched = rules->touched_count;
+    for (size_t k = 0; k < touched; k++) {
+        uint32_t r = rules->touched[k];
+        civ_event_rule_t* rule = &rules->rules[r];
+        bool holds = rule->satisfied == rule->predicate_count;
+        bool rising = holds && !rule->holding && !rule->retired;
+        rule->touched = false;
+        rule->holding = holds;
+        if (rising) {
+            fire(rules, r, em);
+            fired++;
+        }
+    }
+    rules->touched_count -= touched;
+    memmove(rules->touched, rules->touched + touched, rules->touched_count * sizeof(uint32_t));
+
+    return fired;
+}
@@ -7,9 +7,88 @@
 #include "common.h"
 #include "core/events/event_manager.h"
 #include "core/game.h"
+#include "core/time_engine.h"
 #include <stdio.h>
 #include <string.h>
 
+static const char *const g_fact_names[CIV_GAME_FACT_COUNT] = {
+#define CIV_GAME_FACT_NAME(id, name) name,
+    CIV_GAME_FACTS(CIV_GAME_FACT_NAME)
+#undef CIV_GAME_FACT_NAME
+};
+
+/* Authored events */
+static const civ_event_rule_def_t g_game_rules[] = {
+    {.id = "civil_unrest",
+     .type = CIV_EVENT_TYPE_POLITICAL,
+     .title = "Civil Unrest",
+     .description = "Rival factions have pushed the state to the edge of "
+                    "open unrest.",
+     .importance = 0.7f,
+     .predicates = {{"stability", CIV_RULE_LT, 0.25f}},
+     .predicate_count = 1},
+    {.id = "crisis_of_legitimacy",
+     .type = CIV_EVENT_TYPE_POLITICAL,
+     .title = "Crisis of Legitimacy",
+     .description = "Few still accept the government's right to rule.",
+     .importance = 0.8f,
+     .predicates = {{"legitimacy", CIV_RULE_LT, 0.3f}},
+     .predicate_count = 1},
+    {.id = "war_weariness",
+     .type = CIV_EVENT_TYPE_MILITARY,
+     .title = "War Weariness",
+     .description = "The war has worn the nation down; calls for peace "
+                    "grow louder.",
+     .importance = 0.6f,
+     .predicates = {{"at_war", CIV_RULE_EQ, 1.0f},
+                    {"war_exhaustion", CIV_RULE_GE, 0.6f}},
+     .predicate_count = 2},
+};
+
+civ_result_t civ_game_events_register_rules(civ_game_t *game,
+                                            civ_event_rules_t *rules) {
+  (void)game;
+  if (!rules)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null event rules"};
+  if (rules->fact_count != 0)
+    return (civ_result_t){CIV_ERROR_INVALID_STATE, "Rules already have facts"};
+
+  for (int f = 0; f < CIV_GAME_FACT_COUNT; f++) {
+    if (civ_event_rules_fact(rules, g_fact_names[f]) != f)
+      return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Failed to declare fact"};
+  }
+  for (size_t i = 0; i < sizeof(g_game_rules) / sizeof(g_game_rules[0]); i++) {
+    civ_result_t r = civ_event_rules_add(rules, &g_game_rules[i]);
+    if (CIV_FAILED(r))
+      return r;
+  }
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+/* Facts whose system is missing stay unknown */
+void civ_game_events_publish(civ_game_t *game, civ_event_rules_t *rules) {
+  if (!game || !rules)
+    return;
+
+  if (game->politics_system) {
+    civ_event_rules_set(rules, CIV_GAME_FACT_STABILITY,
+                        game->politics_system->stability);
+    civ_event_rules_set(rules, CIV_GAME_FACT_LEGITIMACY,
+                        game->politics_system->legitimacy);
+  }
+  if (game->war_economy) {
+    civ_event_rules_set(rules, CIV_GAME_FACT_AT_WAR,
+                        game->war_economy->at_war ? 1.0f : 0.0f);
+    civ_event_rules_set(rules, CIV_GAME_FACT_WAR_EXHAUSTION,
+                        game->war_economy->war_exhaustion);
+  }
+  if (game->time_engine) {
+    const civ_time_engine_t *te = (const civ_time_engine_t *)game->time_engine;
+    civ_event_rules_set(rules, CIV_GAME_FACT_YEAR, te->global.global_year);
+  }
+  civ_event_rules_set(rules, CIV_GAME_FACT_TURN, game->current_turn);
+}
+
 void civ_trigger_economic_crisis(civ_game_t *game) {
   if (!game)
     return;
@@ -48,9 +127,8 @@ void civ_trigger_natural_disaster(civ_game_t *game, civ_disaster_type_t type) {
   if (!game || !game->disaster_manager)
     return;
 
-  /* Trigger disaster */
-  civ_coordinate_t loc = {50.0f, 50.0f}; // Random or specific
-  civ_disaster_trigger(game->disaster_manager, type, loc, 0.8f);
+  /* Trigger disaster where the map makes it likeliest */
+  civ_disaster_spawn(game->disaster_manager, type, 0.8f);
 
   civ_game_add_event(game, "DISASTER", "Major Natural Disaster", 0.8f);
 
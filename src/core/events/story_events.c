@@ -5,6 +5,7 @@
 
 #include "core/events/story_events.h"
 #include "common.h"
+#include "utils/rng.h"
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -17,7 +18,7 @@ void civ_story_spawn_community(civ_player_community_t *community,
     return;
 
   community->population =
-      1000 + (rand() % 500); /* Random starting pop around 1000 */
+      1000 + (civ_rand() % 500); /* Random starting pop around 1000 */
   community->morale = 0.7f;
   strncpy(community->region_id, region_id, STRING_SHORT_LEN - 1);
   community->state = CIV_STORY_COMMUNITY_MEMBER;
@@ -1,4 +1,5 @@
 #include "core/game.h"
+#include "core/game_systems.h"
 #include "utils/paths.h"
 #include "core/ai/ai_system.h"
 #include "core/character.h"
@@ -6,7 +7,11 @@
 #include "core/culture/culture.h"
 #include "core/data/history_db.h"
 #include "core/diplomacy/relations.h"
+#include "core/diplomacy/unification_engine.h"
+#include "core/events/game_events.h"
 #include "core/military/combat.h"
+#include "core/simulation_engine/lockstep.h"
+#include "core/simulation_engine/worker_pool.h"
 #include "core/profile.h"
 #include "core/time_engine.h"
 #include "core/world/cities_data.h"
@@ -17,9 +22,15 @@
 #include "core/world/political_borders.h"
 #include "core/world/real_world_map.h"
 #include "core/world/resource_map.h"
+#include "core/world/scenario.h"
 #include "core/technology/innovation_system.h"
 #include "utils/config.h"
+#include "utils/maintenance.h"
 #include "utils/memory_pool.h"
+#include "utils/rng.h"
+#include "utils/startup_timeline.h"
+#include "utils/store_registry.h"
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -69,17 +80,65 @@ void civ_game_destroy(civ_game_t *game) {
 
 #define RESOLVE(rel) (civ_path_resolve(rel, _path, sizeof(_path)), _path)
 
-civ_result_t civ_game_initialize(civ_game_t *game,
-                                 const civ_game_config_t *config) {
-  char _path[512];
-  if (!game || !config)
-    return error_result(CIV_ERROR_INVALID_ARGUMENT, "Invalid arguments");
+/* Phase profiler metrics outside the system graph */
+static civ_profile_id_t prof_time = CIV_PROFILE_INVALID;
+static civ_profile_id_t prof_end_turn = CIV_PROFILE_INVALID;
+static civ_perf_metric_t perf_update = CIV_PERF_INVALID;
+
+/* Procedural atlas on a short-lived pool; the orchestrator's pool does not
+   exist yet at this point of initialization */
+static void generate_atlas(civ_game_t *game) {
+  civ_map_gen_params_t params = civ_map_default_params();
+  if (game->max_workers != 1)
+    params.worker_pool = civ_worker_pool_create(
+        game->max_workers ? (int)game->max_workers - 1 : 0);
+  civ_map_generate(game->world_map, &params);
+  civ_worker_pool_destroy(params.worker_pool);
+}
 
-  // Copy config
-  memcpy(&game->config, config, sizeof(civ_game_config_t));
+/* Sample every nation's economy and government into the metric history */
+static void record_metrics(civ_game_t *game) {
+  civ_nation_manager_t *nm = (civ_nation_manager_t *)game->nation_manager;
+  if (!game->metrics_history || !nm || nm->count <= 0)
+    return;
+  float *row = CIV_ARENA_PUSH_ARRAY(game->turn_arena, float,
+                                    (size_t)nm->count * CIV_SERIES_METRIC_COUNT);
+  if (!row)
+    return;
+  for (int i = 0; i < nm->count; i++) {
+    const civ_nation_t *n = &nm->nations[i];
+    float *v = row + (size_t)i * CIV_SERIES_METRIC_COUNT;
+    v[CIV_SERIES_GDP] = n->economy.gdp;
+    v[CIV_SERIES_INFLATION] = n->economy.inflation;
+    v[CIV_SERIES_UNEMPLOYMENT] = n->economy.unemployment;
+    v[CIV_SERIES_TAX_REVENUE] = n->economy.tax_revenue;
+    v[CIV_SERIES_STABILITY] = n->government ? n->government->stability : 0.0f;
+    v[CIV_SERIES_LEGITIMACY] = n->government ? n->government->legitimacy : 0.0f;
+  }
+  civ_time_series_append(game->metrics_history, game->current_turn, row,
+                         nm->count);
+}
+
+/* Maintenance step: coarsen the oldest metric blocks */
+static size_t coarsen_metrics(void *user,
+                              const civ_maintenance_budget_t *budget) {
+  return civ_time_series_coarsen((civ_time_series_t *)user, budget->bytes,
+                                 budget->deadline_ns);
+}
 
+/* ── Load tasks ─────────────────────────────────────────────────────
+ * Initialization is a graph of tasks, each listing the tasks whose data it
+ * reads. The graph runs one task at a time in table order, which is a
+ * valid topological order: interning, the border tables and the RNG stream
+ * are not safe to share between threads, and a fixed order keeps the world
+ * a seed produces identical to a synchronous start. A task whose
+ * dependency failed is skipped. */
+
+static civ_result_t load_core(civ_game_t *game) {
+  char _path[512];
   // Initialize Memory Pool
   game->memory_pool = civ_memory_pool_manager_create(1024, 100);
+  game->cache = civ_cache_create(512, 4 * 1024 * 1024, 0);
 
   // Initialize Time Manager
   game->time_manager = civ_time_manager_create();
@@ -88,147 +147,356 @@ civ_result_t civ_game_initialize(civ_game_t *game,
   }
 
   // Initialize State Persistence
+  CIV_MEM_TAG_BEGIN(prev_tag, CIV_MEM_TAG_SAVE);
   game->persistence = civ_state_persistence_create("saves");
+  game->save_worker = civ_save_worker_create();
+  civ_mem_tag_push(CIV_MEM_TAG_HISTORY);
+  game->metrics_history = civ_time_series_create();
+  if (game->metrics_history)
+    game->metrics_upkeep = civ_maintenance_register(
+        "metrics", coarsen_metrics, game->metrics_history);
+  game->state_hashes = civ_state_hash_create();
+  civ_mem_tag_pop(prev_tag);
+  game->frame_arena = civ_arena_create(64 * 1024);
+  game->turn_arena = civ_arena_create(256 * 1024);
 
   // Initialize Event Manager
+  civ_mem_tag_push(CIV_MEM_TAG_EVENTS);
   game->event_manager = civ_event_manager_create();
+  civ_event_manager_set_spill(game->event_manager, g_journal);
+  game->event_rules = civ_event_rules_create();
+  if (game->event_rules)
+    civ_game_events_register_rules(game, game->event_rules);
+  CIV_MEM_TAG_END(prev_tag);
+
+  /* One mapped pack replaces the loose data/ files when present; opening
+     touches only its header and table of contents */
+  game->world_pack = civ_world_pack_open(RESOLVE(CIV_WORLD_PACK_PATH));
+  if (game->world_pack)
+    printf("[GAME] World pack opened from %s\n", _path);
+
+  return ok_result();
+}
+
+/* Overlay fields over map; stepped on the GPU when the CIV_TILE_FIELD_GPU
+   hint asks for it and a device is there */
+static civ_tile_field_t *create_tile_field(civ_map_t *map) {
+  civ_tile_field_t *field = civ_tile_field_create(map);
+  if (field && SDL_GetHintBoolean(CIV_TILE_FIELD_GPU_HINT, false) &&
+      !civ_tile_field_attach_gpu(field))
+    printf("[GAME] Tile field GPU step unavailable — stepping on the CPU\n");
+  return field;
+}
+
+/* Earth landmask into the map, or the procedural atlas without one */
+static void load_earth(civ_game_t *game) {
+  char _path[512];
+  /* A --map override beats the pack's landmask */
+  civ_pack_view_t earth;
+  bool have_earth = false;
+  civ_result_t earth_res = {CIV_OK, NULL};
+  if (!game->map_path &&
+      civ_world_pack_section(game->world_pack, CIV_PACK_EARTH, &earth)) {
+    snprintf(_path, sizeof(_path), "world pack");
+    earth_res = civ_earth_map_load_view(earth.data, earth.size, game->world_map);
+    have_earth = true;
+  } else {
+    if (game->map_path)
+      snprintf(_path, sizeof(_path), "%s", game->map_path);
+    else
+      RESOLVE(CIV_EARTH_MAP_DEFAULT_PATH);
+    if (civ_earth_map_is_valid(_path)) {
+      earth_res = civ_earth_map_load(_path, game->world_map);
+      have_earth = true;
+    }
+  }
+  if (!have_earth) {
+    printf("[GAME] No Earth map found — using procedural atlas\n");
+    generate_atlas(game);
+  } else if (earth_res.error == CIV_OK) {
+    printf("[GAME] Earth map loaded from %s\n", _path);
+  } else {
+    printf("[GAME] Earth map load failed: %s — using procedural atlas\n",
+           earth_res.message);
+    generate_atlas(game);
+  }
+}
+
+static civ_result_t load_map(civ_game_t *game) {
+  uint32_t seed = game->map_seed ? game->map_seed : CIV_GLOBAL_MAP_SEED;
+  const civ_scenario_params_t *scn = game->scenario;
+  int32_t width = scn && scn->map_width ? scn->map_width : CIV_DEFAULT_MAP_WIDTH;
+  int32_t height =
+      scn && scn->map_height ? scn->map_height : CIV_DEFAULT_MAP_HEIGHT;
 
   // Initialize world map — try Earth data first, fall back to procedural atlas
-  uint32_t seed = CIV_GLOBAL_MAP_SEED;
-  game->world_map =
-      civ_map_create(CIV_DEFAULT_MAP_WIDTH, CIV_DEFAULT_MAP_HEIGHT, seed);
+  game->world_map = civ_map_create(width, height, seed);
   if (game->world_map) {
-    RESOLVE("data/earth_2048x1024.earth");
-    if (civ_earth_map_is_valid(_path)) {
-      civ_result_t earth_res =
-          civ_earth_map_load(_path, game->world_map);
-      if (earth_res.error == CIV_OK) {
-        printf("[GAME] Earth map loaded from %s\n",
-               CIV_EARTH_MAP_DEFAULT_PATH);
-      } else {
-        printf("[GAME] Earth map load failed: %s — using procedural atlas\n",
-               earth_res.message);
-        civ_map_generate_terrain(game->world_map);
-      }
+    if (civ_scenario_replaces_world(scn)) {
+      printf("[GAME] Scenario world %dx%d\n", (int)width, (int)height);
+      generate_atlas(game);
     } else {
-      printf("[GAME] No Earth map found — using procedural atlas\n");
-      civ_map_generate_terrain(game->world_map);
+      load_earth(game);
     }
-  }
+    /* Terrain is final; ownership and fog writes keep the planes current */
+    if (!civ_map_enable_planes(game->world_map))
+      printf("[GAME] Tile planes unavailable — scans read tiles directly\n");
+    game->pathfinder = civ_pathfinder_create(game->world_map, NULL);
+    game->path_service = civ_path_service_create();
+    int land_layer =
+        civ_path_service_add_layer(game->path_service, game->pathfinder);
+    game->ocean_regions = civ_ocean_regions_create(game->world_map, NULL);
+    game->trade_network =
+        civ_trade_network_create(game->world_map, game->pathfinder);
+    civ_trade_network_set_ocean(game->trade_network, game->ocean_regions);
+    civ_trade_network_set_path_service(game->trade_network, game->path_service,
+                                       land_layer);
+    game->influence_map = civ_influence_map_create(game->world_map);
+    game->site_field = civ_site_field_create(game->world_map);
+    game->logistics_field = civ_logistics_field_create(game->world_map);
+    game->tile_field = create_tile_field(game->world_map);
+  }
+
+  if (!game->world_map)
+    return error_result(CIV_ERROR_OUT_OF_MEMORY, "Cannot create world map");
+  return ok_result();
+}
 
+static civ_result_t load_systems(civ_game_t *game) {
   // Initialize Systems
   game->population_manager = civ_population_manager_create();
   game->market_economy = civ_market_dynamics_create();
   game->technology_tree = civ_innovation_system_create();
+  game->tech_diffusion = civ_tech_diffusion_create();
+  game->migration = civ_migration_create();
   game->military_system = civ_combat_system_create();
   game->unit_manager = civ_unit_manager_create();
+  civ_combat_system_bind_units(game->military_system, game->unit_manager);
   game->diplomacy_system = civ_diplomacy_system_create();
+  if (game->diplomacy_system)
+    game->diplomacy_system->pool = game->memory_pool;
+  /* Attached to the map on its first update */
+  game->dynamic_borders = civ_dynamic_borders_create();
+  game->nation_labels = civ_nation_labels_create();
+  /* Bound to the map on its first update, like the borders */
+  game->disaster_manager = civ_disaster_manager_create(NULL);
+  if (game->disaster_manager)
+    game->disaster_manager->rng_seed = civ_game_rng_seed(game);
   game->culture_system = civ_culture_system_create();
+  game->naming = civ_naming_create();
+  if (game->naming)
+    game->naming->rng_seed = civ_game_rng_seed(game);
+  game->religion_system = civ_religion_system_create();
+  game->epidemics = civ_epidemic_system_create();
+  /* Plague disasters break out as this */
+  civ_epidemic_define(game->epidemics, "Plague", 0.4, 4.0, 10.0, 0.3, 0.5);
   game->ai_system = civ_ai_system_create();
   if (game->ai_system) {
     game->ai_system->game_ptr = game;
   }
   game->settlement_manager = civ_settlement_manager_create();
+  if (game->settlement_manager)
+    game->settlement_manager->naming = game->naming;
   game->wonder_manager = civ_wonder_manager_create();
+  game->modifiers = civ_modifier_table_create(game->wonder_manager);
   game->government = civ_government_create("Initial Government");
   game->custom_governance_manager = civ_custom_governance_manager_create();
 
-  /* Initialize system orchestrator */
+  /* Initialize system orchestrator and its per-tick system graph */
+  prof_time = civ_profiler_register("time");
+  prof_end_turn = civ_profiler_register("end_turn");
+  /* Per-system histograms are cheap enough to keep on in every build */
+  game->performance_optimizer = civ_performance_optimizer_create();
+  civ_performance_optimizer_enable_profiling(game->performance_optimizer, true);
+  perf_update = civ_performance_optimizer_register(game->performance_optimizer, "update");
   game->system_orchestrator = civ_system_orchestrator_create();
-
-  /* Load real political borders from Natural Earth data */
-  if (civ_political_borders_load(RESOLVE("data/earth_borders.bin"),
-                                  game->world_map->width,
-                                  game->world_map->height)) {
-    civ_political_borders_apply(game->world_map);
+  if (game->system_orchestrator) {
+    civ_system_orchestrator_set_optimizer(game->system_orchestrator,
+                                          game->performance_optimizer);
+    civ_result_t sr = civ_game_systems_register(game);
+    if (CIV_FAILED(sr))
+      printf("[GAME] System graph registration failed: %s\n",
+             sr.message ? sr.message : "unknown error");
   }
 
+  return ok_result();
+}
+
+static civ_result_t load_borders(civ_game_t *game) {
+  char _path[512];
+  /* Scenario nations claim their own land */
+  if (game->scenario && game->scenario->nations > 0)
+    return ok_result();
+  /* Load real political borders from Natural Earth data; the pack's tile
+     array is used in place */
+  civ_pack_view_t view;
+  bool borders_ok =
+      civ_world_pack_section(game->world_pack, CIV_PACK_BORDERS, &view)
+          ? civ_political_borders_load_view(view.data, view.size,
+                                            game->world_map->width,
+                                            game->world_map->height)
+          : civ_political_borders_load(RESOLVE("data/earth_borders.bin"),
+                                       game->world_map->width,
+                                       game->world_map->height);
+  if (borders_ok) civ_political_borders_apply(game->world_map);
+
+  return ok_result();
+}
+
+static civ_result_t load_nations_data(civ_game_t *game) {
+  char _path[512];
+  civ_pack_view_t view;
   /* Load master nation index from Natural Earth */
   game->nations_data = civ_nations_data_create();
   if (game->nations_data) {
-    civ_nations_data_load(game->nations_data, RESOLVE("data/nations.bin"));
+    if (civ_world_pack_section(game->world_pack, CIV_PACK_NATIONS, &view))
+      civ_nations_data_load_view(game->nations_data, view.data, view.size);
+    else
+      civ_nations_data_load(game->nations_data, RESOLVE("data/nations.bin"));
     printf("[GAME] Nations data: %u countries loaded\n",
            game->nations_data->count);
   }
 
+  return ok_result();
+}
+
+static civ_result_t load_resources(civ_game_t *game) {
+  char _path[512];
+  civ_pack_view_t view;
   /* Load resource map */
   game->resource_map = civ_resource_map_create(
       game->world_map->width, game->world_map->height);
   if (game->resource_map) {
-    civ_resource_map_load(game->resource_map, RESOLVE("data/resources.bin"));
+    if (civ_world_pack_section(game->world_pack, CIV_PACK_RESOURCES, &view))
+      civ_resource_map_load_view(game->resource_map, view.data, view.size);
+    else
+      civ_resource_map_load(game->resource_map, RESOLVE("data/resources.bin"));
     printf("[GAME] Resource map loaded\n");
   }
 
-  /* Initialize nations from borders data + nations_data */
-  {
-    civ_nation_manager_t *nm = civ_nation_manager_create();
-    if (nm) {
-      civ_nation_manager_init_from_data(nm, game->nations_data,
-          game->world_map->width, game->world_map->height,
-          CIV_NATION_DEFAULT_COUNT);
-      printf("[GAME] %d nations initialized\n", nm->count);
-      game->nation_manager = nm;
-
-      /* Claim territory from borders for pixel-accurate ownership */
-      for (int ni = 0; ni < nm->count; ni++) {
-        civ_nation_claim_from_borders(&nm->nations[ni], game->world_map,
-            ni, game->world_map->width, game->world_map->height);
-      }
-      printf("[GAME] Territory claimed for %d nations\n", nm->count);
+  return ok_result();
+}
 
-      /* Compute initial per-nation economies */
-      civ_nation_compute_all_economies(nm, game->world_map,
-          game->resource_map, &game->global_economy);
-      printf("[GAME] Per-nation economies computed, global GDP=%.1fM\n",
-             game->global_economy.gdp);
-    }
-  }
+/* Names from the data files are taken before any are generated */
+static void reserve_nation_names(civ_game_t *game) {
+  civ_nation_manager_t *nm = (civ_nation_manager_t *)game->nation_manager;
+  if (!game->naming || !nm)
+    return;
+  for (int ni = 0; ni < nm->count; ni++)
+    civ_naming_reserve(game->naming, nm->nations[ni].name);
+}
 
-  /* Load flag metadata — textures loaded later when renderer is available */
-  game->flag_system = civ_flag_system_create(NULL);
-  if (game->flag_system) {
-    char _path2[512];
-    civ_path_resolve("data/flags/index.bin", _path, sizeof(_path));
-    civ_path_resolve("data/flags", _path2, sizeof(_path2));
-    civ_flag_system_load(game->flag_system, _path, _path2);
+static civ_result_t load_nations(civ_game_t *game) {
+  const civ_scenario_params_t *scn = game->scenario;
+  if (scn && scn->nations > 0) {
+    civ_nation_manager_t *nm = civ_nation_manager_create_sized(
+        MAX(scn->nations, CIV_NATION_CAPACITY_MAX));
+    if (!nm)
+      return error_result(CIV_ERROR_OUT_OF_MEMORY, "Cannot create nations");
+    game->nation_manager = nm;
+    civ_result_t r = civ_scenario_claim_nations(
+        nm, game->world_map, scn, (uint32_t)civ_game_rng_seed(game));
+    if (CIV_FAILED(r))
+      return r;
+    printf("[GAME] Scenario: %d nations claimed territory\n", nm->count);
+    reserve_nation_names(game);
+    civ_nation_compute_all_economies(nm, game->world_map,
+        game->resource_map, &game->global_economy);
+    return ok_result();
   }
 
-  /* Load cities data */
-  game->cities_data = civ_cities_data_create(
-      game->world_map->width, game->world_map->height);
-  if (game->cities_data) {
-    civ_cities_data_load(game->cities_data, RESOLVE("data/cities.bin"));
-    printf("[GAME] Cities data: %u cities loaded\n",
-           game->cities_data->count);
+  /* Initialize nations from borders data + nations_data */
+  civ_nation_manager_t *nm = civ_nation_manager_create();
+  if (nm) {
+    /* Each nation gets its default government as it is added */
+    int step = civ_startup_step_begin("Nations and governments");
+    civ_nation_manager_init_from_data(nm, game->nations_data,
+        game->world_map->width, game->world_map->height,
+        CIV_NATION_DEFAULT_COUNT);
+    civ_startup_step_end(step);
+    printf("[GAME] %d nations initialized\n", nm->count);
+    game->nation_manager = nm;
+    reserve_nation_names(game);
+
+    /* Claim territory from borders for pixel-accurate ownership */
+    step = civ_startup_step_begin("Territory");
+    for (int ni = 0; ni < nm->count; ni++) {
+      civ_nation_claim_from_borders(&nm->nations[ni], game->world_map,
+          ni, game->world_map->width, game->world_map->height);
+    }
+    civ_startup_step_end(step);
+    printf("[GAME] Territory claimed for %d nations\n", nm->count);
+
+    /* Compute initial per-nation economies */
+    step = civ_startup_step_begin("Nation economies");
+    civ_nation_compute_all_economies(nm, game->world_map,
+        game->resource_map, &game->global_economy);
+    civ_startup_step_end(step);
+    printf("[GAME] Per-nation economies computed, global GDP=%.1fM\n",
+           game->global_economy.gdp);
   }
 
+  /* Flag metadata and cities load on first use (civ_game_flags /
+     civ_game_cities); nothing before the game scene reads them */
+  return ok_result();
+}
+
+/* Scenario settlements and units, over whichever nations loaded */
+static civ_result_t load_scenario(civ_game_t *game) {
+  const civ_scenario_params_t *scn = game->scenario;
+  civ_nation_manager_t *nm = (civ_nation_manager_t *)game->nation_manager;
+  if (!scn || !nm)
+    return ok_result();
+  uint32_t seed = (uint32_t)civ_game_rng_seed(game);
+  civ_result_t r = {CIV_OK, NULL};
+  if (scn->settlements > 0 && game->settlement_manager)
+    r = civ_scenario_place_settlements(game->settlement_manager, nm,
+                                       game->world_map, scn, seed);
+  if (!CIV_FAILED(r) && scn->units > 0 && game->unit_manager)
+    r = civ_scenario_place_units(game->unit_manager, nm, game->world_map, scn,
+                                 seed);
+  if (CIV_FAILED(r))
+    return r;
+  printf("[GAME] Scenario: %zu settlements, %zu units\n",
+         game->settlement_manager ? game->settlement_manager->settlement_count : 0,
+         game->unit_manager ? game->unit_manager->unit_count : 0);
+  return ok_result();
+}
+
+static civ_result_t load_time(civ_game_t *game) {
   /* Initialize time engine — global baseline 00 BC, custom calendars */
-  {
-    civ_time_engine_t *te = civ_time_engine_create();
-    if (te) {
-      civ_time_engine_init_default_calendars(te);
-      game->time_engine = te;
-      printf("[GAME] Time engine initialized: Year %d, %d calendars\n",
-             te->global.global_year, te->calendar_count);
-    }
+  civ_time_engine_t *te = civ_time_engine_create();
+  if (te) {
+    civ_time_engine_init_default_calendars(te);
+    game->time_engine = te;
+    civ_settlement_manager_set_date(game->settlement_manager,
+                                    te->global.global_year, te->global.global_day);
+    printf("[GAME] Time engine initialized: Year %d, %d calendars\n",
+           te->global.global_year, te->calendar_count);
   }
 
+  return ok_result();
+}
+
+static civ_result_t load_npcs(civ_game_t *game) {
   /* Initialize NPC engine */
-  {
-    civ_npc_engine_t *ne = civ_npc_engine_create();
-    if (ne) {
-      civ_npc_engine_add(ne, "Aleksandr Volkov", "President", "Russia");
-      civ_npc_engine_add(ne, "Maria Chen", "Trade Minister", "China");
-      civ_npc_engine_add(ne, "James Okafor", "Finance Director", "Nigeria");
-      civ_npc_engine_add(ne, "Isabel Rojas", "Foreign Secretary", "Brazil");
-      civ_npc_engine_add(ne, "Klaus Weber", "Chancellor", "Germany");
-      civ_npc_engine_add(ne, "Yuki Tanaka", "Defense Minister", "Japan");
-      civ_npc_engine_add(ne, "Amina Hassan", "Culture Minister", "Egypt");
-      civ_npc_engine_add(ne, "Raj Patel", "Prime Minister", "India");
-      game->npc_engine = ne;
-    }
+  civ_npc_engine_t *ne = civ_npc_engine_create();
+  if (ne) {
+    civ_npc_engine_add(ne, "Aleksandr Volkov", "President", "Russia");
+    civ_npc_engine_add(ne, "Maria Chen", "Trade Minister", "China");
+    civ_npc_engine_add(ne, "James Okafor", "Finance Director", "Nigeria");
+    civ_npc_engine_add(ne, "Isabel Rojas", "Foreign Secretary", "Brazil");
+    civ_npc_engine_add(ne, "Klaus Weber", "Chancellor", "Germany");
+    civ_npc_engine_add(ne, "Yuki Tanaka", "Defense Minister", "Japan");
+    civ_npc_engine_add(ne, "Amina Hassan", "Culture Minister", "Egypt");
+    civ_npc_engine_add(ne, "Raj Patel", "Prime Minister", "India");
+    game->npc_engine = ne;
   }
 
+  return ok_result();
+}
+
+static civ_result_t load_market(civ_game_t *game) {
   /* Initialize player as Private Citizen */
   civ_role_init(&game->player_role);
   civ_role_set(&game->player_role, &civ_role_private_citizen, "none");
@@ -241,12 +509,19 @@ civ_result_t civ_game_initialize(civ_game_t *game,
   civ_market_generate_companies(game->market, "Global");
   civ_wallet_init(&game->wallet);
 
+  return ok_result();
+}
+
+static civ_result_t load_economy(civ_game_t *game) {
   /* --- Initialize economy modules --- */
   game->banking            = civ_banking_create();
+  if (game->banking) game->banking->rng_seed = civ_game_rng_seed(game);
   game->taxation           = civ_taxation_create();
   game->budget             = civ_budget_create();
   game->economic_policy    = civ_economic_policy_create();
   game->agriculture        = civ_agriculture_create();
+  game->climate            = civ_climate_create();
+  game->climate_profile    = CIV_CALLOC(1, sizeof(civ_climate_profile_t));
   game->extraction         = civ_extraction_create();
   game->manufacturing      = civ_manufacturing_create();
   game->energy             = civ_energy_create();
@@ -260,40 +535,424 @@ civ_result_t civ_game_initialize(civ_game_t *game,
   game->war_economy        = civ_war_economy_create();
   game->black_market       = civ_black_market_create();
   game->innovation_economy = civ_innovation_economy_create();
-  printf("[GAME] 18 economy modules initialized\n");
+  game->trade_manager      = civ_trade_manager_create(game->currency_manager);
+  civ_trade_manager_set_network(game->trade_manager, game->trade_network);
+  printf("[GAME] 19 economy modules initialized\n");
+
+  /* One commodity per map resource, in civ_resource_type_t order */
+  for (int r = 0; r < CIV_RESOURCE_COUNT && game->commodity_market; r++)
+    civ_resource_register(game->commodity_market,
+                          civ_resource_type_name((civ_resource_type_t)r),
+                          r <= CIV_RESOURCE_COAL ? CIV_RES_CAT_INDUSTRIAL
+                                                 : CIV_RES_CAT_BASIC_MATERIAL);
+
+  return ok_result();
+}
+
+/* Keyframe save of the current turn, noted in the recording */
+static void record_keyframe(civ_game_t *game) {
+  civ_command_log_t *log = game->command_log;
+  char path[512];
+  civ_command_keyframe_path(log->path, game->current_turn, path, sizeof(path));
+  if (CIV_FAILED(civ_game_save_keyframe(game, path))) return;
+  civ_command_t cmd;
+  memset(&cmd, 0, sizeof(cmd));
+  cmd.type = CIV_CMD_KEYFRAME;
+  cmd.turn = game->current_turn;
+  cmd.i[0] = game->current_turn;
+  civ_command_log_append(log, &cmd);
+}
 
+static civ_result_t load_finish(civ_game_t *game) {
   game->state = CIV_GAME_STATE_RUNNING;
   game->is_running = true;
   game->is_paused = false;
   game->current_turn = 1;
+  civ_journal_set_turn(g_journal, game->current_turn);
+  record_metrics(game);
+  civ_state_hash_record(game->state_hashes, game);
+  /* A recording keeps the state it starts from, so a seek can go back
+     before its first periodic keyframe */
+  if (game->command_log && game->command_log->recording) record_keyframe(game);
+  /* Per-turn allocation and store growth rates start here, not with the
+     load */
+  civ_mem_tags_mark();
+  civ_store_registry_mark();
 
   printf("[GAME] Initialized at turn %d\n", game->current_turn);
+  return ok_result();
+}
+
+typedef enum {
+  LOAD_CORE,
+  LOAD_MAP,
+  LOAD_SYSTEMS,
+  LOAD_BORDERS,
+  LOAD_NATIONS_DATA,
+  LOAD_RESOURCES,
+  LOAD_NATIONS,
+  LOAD_SCENARIO,
+  LOAD_TIME,
+  LOAD_NPCS,
+  LOAD_MARKET,
+  LOAD_ECONOMY,
+  LOAD_FINISH,
+  LOAD_TASK_COUNT
+} load_task_id_t;
+
+#define DEP(t) (1u << (t))
+
+typedef struct {
+  const char *name;
+  civ_result_t (*run)(civ_game_t *game);
+  uint32_t deps;
+  int weight; /* rough share of the load time */
+  civ_mem_tag_t mem_tag;
+} load_task_t;
+
+static const load_task_t load_tasks[LOAD_TASK_COUNT] = {
+  [LOAD_CORE]         = {"Core services", load_core, 0, 1,
+                         CIV_MEM_TAG_GENERAL},
+  [LOAD_MAP]          = {"World map", load_map, DEP(LOAD_CORE), 30,
+                         CIV_MEM_TAG_WORLD},
+  [LOAD_SYSTEMS]      = {"Simulation systems", load_systems,
+                         DEP(LOAD_CORE) | DEP(LOAD_MAP), 4, CIV_MEM_TAG_GENERAL},
+  [LOAD_BORDERS]      = {"Political borders", load_borders, DEP(LOAD_MAP), 10,
+                         CIV_MEM_TAG_WORLD},
+  [LOAD_NATIONS_DATA] = {"Nation index", load_nations_data, DEP(LOAD_CORE), 3,
+                         CIV_MEM_TAG_NATIONS},
+  [LOAD_RESOURCES]    = {"Resources", load_resources, DEP(LOAD_MAP), 6,
+                         CIV_MEM_TAG_WORLD},
+  [LOAD_NATIONS]      = {"Nations", load_nations,
+                         DEP(LOAD_BORDERS) | DEP(LOAD_NATIONS_DATA) |
+                             DEP(LOAD_RESOURCES), 30, CIV_MEM_TAG_NATIONS},
+  [LOAD_SCENARIO]     = {"Scenario", load_scenario,
+                         DEP(LOAD_SYSTEMS) | DEP(LOAD_NATIONS), 2,
+                         CIV_MEM_TAG_WORLD},
+  [LOAD_TIME]         = {"Calendars", load_time, DEP(LOAD_CORE), 1,
+                         CIV_MEM_TAG_GENERAL},
+  [LOAD_NPCS]         = {"Characters", load_npcs, DEP(LOAD_CORE), 1,
+                         CIV_MEM_TAG_SOCIETY},
+  [LOAD_MARKET]       = {"Markets", load_market, DEP(LOAD_CORE), 8,
+                         CIV_MEM_TAG_ECONOMY},
+  [LOAD_ECONOMY]      = {"Economy", load_economy,
+                         DEP(LOAD_MAP) | DEP(LOAD_MARKET), 4, CIV_MEM_TAG_ECONOMY},
+  [LOAD_FINISH]       = {"Starting", load_finish,
+                         DEP(LOAD_SYSTEMS) | DEP(LOAD_NATIONS) |
+                             DEP(LOAD_SCENARIO) | DEP(LOAD_TIME) |
+                             DEP(LOAD_NPCS) | DEP(LOAD_ECONOMY), 2,
+                         CIV_MEM_TAG_GENERAL},
+};
+
+struct civ_game_loader {
+  civ_game_config_t config;
+  SDL_Thread *thread;
+  SDL_AtomicInt done_weight;
+  SDL_AtomicInt stage;    /* running task; LOAD_TASK_COUNT once finished */
+  civ_result_t result;    /* first failure; read after the thread is joined */
+};
+
+/* Run every task whose dependencies succeeded, on the calling thread */
+static civ_result_t run_load_tasks(civ_game_t *game, civ_game_loader_t *loader) {
+  /* World generation draws from one stream keyed by the map seed */
+  uint32_t seed = game->map_seed ? game->map_seed : CIV_GLOBAL_MAP_SEED;
+  civ_rng_t init_rng;
+  civ_rng_seed_key(&init_rng, seed, CIV_RNG_WORLDGEN, 0, 0);
+  civ_rng_t *prev_rng = civ_rng_bind(&init_rng);
+
+  civ_result_t first_failure = ok_result();
+  uint32_t succeeded = 0;
+  int done_weight = 0;
+  for (int t = 0; t < LOAD_TASK_COUNT; t++) {
+    const load_task_t *task = &load_tasks[t];
+    if (loader) SDL_SetAtomicInt(&loader->stage, t);
+    if ((task->deps & succeeded) == task->deps) {
+      int step = civ_startup_step_begin(task->name);
+      CIV_MEM_TAG_BEGIN(prev_tag, task->mem_tag);
+      civ_result_t r = task->run(game);
+      CIV_MEM_TAG_END(prev_tag);
+      civ_startup_step_end(step);
+      if (CIV_FAILED(r)) {
+        printf("[GAME] Load stage '%s' failed: %s\n", task->name,
+               r.message ? r.message : "unknown error");
+        if (!CIV_FAILED(first_failure)) first_failure = r;
+      } else {
+        succeeded |= DEP(t);
+      }
+    }
+    done_weight += task->weight;
+    if (loader) SDL_SetAtomicInt(&loader->done_weight, done_weight);
+  }
+
+  civ_rng_bind(prev_rng);
+  return first_failure;
+}
 
+civ_result_t civ_game_initialize(civ_game_t *game,
+                                 const civ_game_config_t *config) {
+  if (!game || !config)
+    return error_result(CIV_ERROR_INVALID_ARGUMENT, "Invalid arguments");
+  memcpy(&game->config, config, sizeof(civ_game_config_t));
+  return run_load_tasks(game, NULL);
+}
+
+static int load_thread_main(void *data) {
+  civ_game_t *game = data;
+  civ_game_loader_t *loader = game->loader;
+  civ_startup_timeline_name_thread("loader");
+  loader->result = run_load_tasks(game, loader);
+  SDL_SetAtomicInt(&loader->stage, LOAD_TASK_COUNT);
+  return 0;
+}
+
+civ_result_t civ_game_load_start(civ_game_t *game,
+                                 const civ_game_config_t *config) {
+  if (!game || !config)
+    return error_result(CIV_ERROR_INVALID_ARGUMENT, "Invalid arguments");
+  if (game->loader)
+    return error_result(CIV_ERROR_INVALID_STATE, "Game is already loading");
+
+  civ_game_loader_t *loader = calloc(1, sizeof(*loader));
+  if (!loader)
+    return error_result(CIV_ERROR_OUT_OF_MEMORY, "Cannot allocate loader");
+  memcpy(&game->config, config, sizeof(civ_game_config_t));
+  game->loader = loader;
+  loader->result = ok_result();
+
+  loader->thread = SDL_CreateThread(load_thread_main, "civ_load", game);
+  if (!loader->thread) {
+    /* No thread: load now, so the caller still gets a loaded game */
+    load_thread_main(game);
+  }
   return ok_result();
 }
 
+float civ_game_load_progress(const civ_game_t *game, const char **stage) {
+  civ_game_loader_t *loader = game ? game->loader : NULL;
+  if (!loader) {
+    if (stage) *stage = "Ready";
+    return 1.0f;
+  }
+  int total = 0;
+  for (int t = 0; t < LOAD_TASK_COUNT; t++) total += load_tasks[t].weight;
+  int running = SDL_GetAtomicInt(&loader->stage);
+  if (stage)
+    *stage = running < LOAD_TASK_COUNT ? load_tasks[running].name : "Ready";
+  return (float)SDL_GetAtomicInt(&loader->done_weight) / (float)total;
+}
+
+bool civ_game_is_loaded(const civ_game_t *game) {
+  if (!game) return false;
+  return !game->loader ||
+         SDL_GetAtomicInt(&game->loader->stage) == LOAD_TASK_COUNT;
+}
+
+civ_result_t civ_game_load_finish(civ_game_t *game) {
+  civ_game_loader_t *loader = game ? game->loader : NULL;
+  if (!loader) return ok_result();
+  if (loader->thread) SDL_WaitThread(loader->thread, NULL);
+  civ_result_t result = loader->result;
+  free(loader);
+  game->loader = NULL;
+  return result;
+}
+
+/* Record a command the game issued itself (update, end of turn) */
+static void record_command(civ_game_t *game, civ_command_type_t type,
+                           int32_t count, double f) {
+  civ_command_t cmd;
+  memset(&cmd, 0, sizeof(cmd));
+  cmd.type = (uint16_t)type;
+  cmd.turn = game->current_turn;
+  cmd.i[0] = count;
+  cmd.f = f;
+  civ_command_log_append(game->command_log, &cmd);
+}
+
+/* Close a recorded turn: state check, then a keyframe save when due */
+static void record_turn_end(civ_game_t *game) {
+  civ_command_log_t *log = game->command_log;
+  civ_command_t cmd;
+  memset(&cmd, 0, sizeof(cmd));
+  cmd.type = CIV_CMD_TURN_CHECK;
+  cmd.turn = game->current_turn;
+  cmd.i[0] = game->current_turn;
+  cmd.i[1] = (int32_t)civ_command_state_checksum(game);
+  cmd.u = civ_game_rng_seed(game);
+  civ_command_log_append(log, &cmd);
+
+  if (log->keyframe_every > 0 && game->current_turn % log->keyframe_every == 0)
+    record_keyframe(game);
+  civ_command_log_flush(log);
+}
+
+civ_result_t civ_game_execute(civ_game_t *game, const civ_command_t *cmd) {
+  if (!game || !cmd)
+    return error_result(CIV_ERROR_INVALID_ARGUMENT, "Invalid command");
+  if (cmd->type == CIV_CMD_UPDATE || cmd->type == CIV_CMD_END_TURN ||
+      cmd->type == CIV_CMD_TURN_CHECK || cmd->type == CIV_CMD_KEYFRAME)
+    return error_result(CIV_ERROR_INVALID_ARGUMENT,
+                        "Turn flow is not a player command");
+  if (game->lockstep && !civ_lockstep_applying(game->lockstep))
+    return civ_lockstep_submit(game->lockstep, cmd);
+  civ_result_t res = civ_command_apply(game, cmd);
+  if (!CIV_FAILED(res) && game->command_log) {
+    civ_command_t logged = *cmd;
+    logged.turn = game->current_turn;
+    civ_command_log_append(game->command_log, &logged);
+  }
+  return res;
+}
+
+bool civ_game_deterministic(const civ_game_t *game) {
+  return game && (game->command_log || game->lockstep);
+}
+
+uint64_t civ_game_rng_seed(const civ_game_t *game) {
+  if (game && game->world_map)
+    return game->world_map->seed;
+  return game && game->map_seed ? game->map_seed : CIV_GLOBAL_MAP_SEED;
+}
+
+void civ_game_refresh_modifiers(civ_game_t *game) {
+  if (!game || !game->modifiers)
+    return;
+  civ_modifier_source_t player = {
+      game->government,
+      game->technology_tree ? &game->technology_tree->aggregate_index : NULL,
+      game->economic_policy};
+  civ_modifier_table_bind(game->modifiers, civ_owner_intern("PLAYER"), &player);
+
+  civ_nation_manager_t *nm = (civ_nation_manager_t *)game->nation_manager;
+  for (int i = 0; nm && i < nm->count; i++) {
+    civ_nation_t *n = &nm->nations[i];
+    /* The player's nation runs on the player's policy */
+    civ_modifier_source_t src = {
+        n->government, &n->tech_index,
+        n->government && n->government == game->government
+            ? game->economic_policy : NULL};
+    civ_modifier_table_bind(game->modifiers, civ_nation_owner_index(n), &src);
+  }
+  civ_modifier_table_refresh(game->modifiers);
+}
+
+/* ── Secessions and unions ─────────────────────────────────────────── */
+#define UNION_CHANCE_PCT  5    /* per turn, for the turn's best candidate */
+#define UNION_SIZE_RATIO  4    /* the larger partner outnumbers the smaller */
+
+/* A civil war splits off the later half of a nation's subdivisions, at
+   war with the rump */
+static void split_civil_wars(civ_game_t *game, civ_nation_manager_t *nm) {
+  for (int ni = 0; ni < nm->count; ni++) {
+    civ_nation_t *n = &nm->nations[ni];
+    civ_political_violence_t *pv = n->government ? n->government->political_violence : NULL;
+    if (n->defunct || !pv || pv->civil_wars_pending == 0) continue;
+    pv->civil_wars_pending = 0;
+    if (n->subdivision_count < 2) continue;
+
+    uint32_t mask = 0;
+    for (int s = n->subdivision_count / 2; s < n->subdivision_count && s < 32; s++)
+      mask |= 1u << s;
+    char id[CIV_NATION_ID_MAX], name[CIV_NATION_NAME_MAX];
+    for (int k = 1; k < 100; k++) {
+      snprintf(id, sizeof(id), "%.24s_R%d", n->id, k);
+      if (!civ_nation_get_by_id(nm, id)) break;
+    }
+    snprintf(name, sizeof(name), "Free %s", n->name);
+    civ_unification_split_nation(nm, game->world_map, game->diplomacy_system, ni,
+                                 mask, id, name, n->color ^ 0xFFFFFFu,
+                                 CIV_RELATION_LEVEL_WAR, NULL);
+  }
+}
+
+/* Long allies of very different size may agree to become one nation: the
+   smallest such partner of the turn is offered to the larger. The player's
+   nation is never the one absorbed. */
+static void negotiate_unions(civ_game_t *game, civ_nation_manager_t *nm,
+                             civ_rng_t *rng) {
+  civ_diplomacy_system_t *ds = game->diplomacy_system;
+  if (!ds || civ_rng_range(rng, 100) >= UNION_CHANCE_PCT) return;
+  int best_into = -1, best_from = -1;
+  for (size_t t = 0; t < ds->treaty_count; t++) {
+    const civ_treaty_t *tr = &ds->treaties[t];
+    if (!tr->active || tr->treaty_type != CIV_TREATY_TYPE_MILITARY_ALLIANCE ||
+        tr->signatory_count < 2)
+      continue;
+    civ_nation_t *a = civ_nation_get_by_id(nm, tr->signatories[0]);
+    civ_nation_t *b = civ_nation_get_by_id(nm, tr->signatories[1]);
+    if (!a || !b || a->defunct || b->defunct) continue;
+    if (a->population < b->population) { civ_nation_t *x = a; a = b; b = x; }
+    int from = (int)(b - nm->nations);
+    if (from == nm->player_nation_index ||
+        b->population * UNION_SIZE_RATIO > a->population ||
+        a->subdivision_count + b->subdivision_count > CIV_SUBDIVISION_MAX)
+      continue;
+    if (best_from < 0 || b->population < nm->nations[best_from].population) {
+      best_into = (int)(a - nm->nations);
+      best_from = from;
+    }
+  }
+  if (best_from >= 0)
+    civ_unification_propose_merger(nm, game->world_map, ds, best_into, best_from,
+                                   CIV_UNIFY_TOTAL_ABSORPTION, NULL);
+}
+
 civ_result_t civ_game_end_turn(civ_game_t *game) {
   if (!game)
     return error_result(CIV_ERROR_INVALID_ARGUMENT, "Invalid game");
 
+  CIV_PROFILE_START(turn_scope, prof_end_turn);
+  civ_arena_reset(game->turn_arena);
+  /* The turn moves borders and units: no path solve may still be reading */
+  civ_path_service_apply(game->path_service);
+  if (game->command_log)
+    record_command(game, CIV_CMD_END_TURN, 0, 0.0);
   game->current_turn++;
-  if (game->time_engine)
-    civ_time_engine_advance_turn((civ_time_engine_t *)game->time_engine);
+  game->turn_commands = 0;
+  civ_journal_set_turn(g_journal, game->current_turn);
+
+  /* Subsystems draw from streams keyed by (seed, domain, turn, entity);
+   * anything not given its own stream uses the turn stream. */
+  uint64_t seed = civ_game_rng_seed(game);
+  uint64_t turn = (uint64_t)game->current_turn;
+  civ_rng_t turn_rng, sub_rng;
+  civ_rng_seed_key(&turn_rng, seed, CIV_RNG_TURN, turn, 0);
+  civ_rng_t *prev_rng = civ_rng_bind(&turn_rng);
+
+  if (game->time_engine) {
+    civ_time_engine_t *te = (civ_time_engine_t *)game->time_engine;
+    civ_time_engine_advance_turn(te);
+    civ_settlement_manager_set_date(game->settlement_manager,
+                                    te->global.global_year, te->global.global_day);
+  }
   /* NPC decisions */
   if (game->npc_engine && game->time_engine) {
     civ_time_engine_t *te = (civ_time_engine_t *)game->time_engine;
-    civ_npc_engine_process_turn((civ_npc_engine_t *)game->npc_engine,
+    civ_rng_seed_key(&sub_rng, seed, CIV_RNG_NPC, turn, 0);
+    civ_rng_bind(&sub_rng);
+    CIV_MEM_TAG_BEGIN(prev_tag, CIV_MEM_TAG_SOCIETY);
+    civ_npc_engine_process_turn((civ_npc_engine_t *)civ_game_npcs(game),
                                 game->nation_manager,
                                 te->global.global_year, te->global.global_day);
+    CIV_MEM_TAG_END(prev_tag);
+    civ_rng_bind(&turn_rng);
   }
   /* Market fluctuation — feed production data to influence prices */
   if (game->market) {
+    CIV_MEM_TAG_BEGIN(prev_tag, CIV_MEM_TAG_ECONOMY);
+    civ_rng_seed_key(&sub_rng, seed, CIV_RNG_MARKET, turn, 0);
+    civ_rng_bind(&sub_rng);
     civ_market_update(game->market);
+    civ_company_registry_update(&game->market->companies,
+                                game->global_economy.gdp_growth);
+    civ_rng_bind(&turn_rng);
     civ_market_apply_production(game->market,
         game->global_economy.gdp,
         game->global_economy.food_production,
         game->global_economy.energy_output,
         game->global_economy.industrial_output);
+    civ_market_record_history(game->market, game->current_turn);
+    CIV_MEM_TAG_END(prev_tag);
   }
 
   /* Feed player wallet from tax revenue (small fraction per turn) */
@@ -312,55 +971,67 @@ civ_result_t civ_game_end_turn(civ_game_t *game) {
   if (game->current_turn % 10 == 0 && game->current_profile) {
     char path[256];
     civ_profile_get_save_path(game->current_profile->id, "autosave", path, sizeof(path));
-    civ_result_t sr = civ_game_save_state(game, path);
+    civ_result_t sr = civ_game_autosave(game, path);
     if (sr.error == CIV_OK)
       printf("[GAME] Autosaved to %s\n", path);
   }
 
   // Reset unit movement
   if (game->unit_manager && game->unit_manager->units) {
-    for (size_t i = 0; i < game->unit_manager->unit_count; i++) {
-      civ_unit_t *u = &game->unit_manager->units[i];
-      u->has_moved = false;
-
+    civ_unit_manager_t *um = game->unit_manager;
+    memset(um->moved, 0, um->unit_count * sizeof(uint8_t));
+    for (size_t i = 0; i < um->unit_count; i++) {
       /* Simple Barbarian AI: Move randomly if it's a Barbarian unit */
-      if (strstr(u->name, "Barbarians")) {
-        int dx = (rand() % 3) - 1; /* -1, 0, 1 */
-        int dy = (rand() % 3) - 1;
+      if (civ_symbol_has_flag(um->units[i].name_sym, CIV_SYMBOL_FLAG_BARBARIAN)) {
+        civ_rng_t unit_rng;
+        civ_rng_seed_key(&unit_rng, seed, CIV_RNG_BARBARIANS, turn, i);
+        int dx = (int)civ_rng_range(&unit_rng, 3) - 1; /* -1, 0, 1 */
+        int dy = (int)civ_rng_range(&unit_rng, 3) - 1;
 
         int32_t nx =
-            (u->x + dx + game->world_map->width) % game->world_map->width;
-        int32_t ny = u->y + dy;
+            (um->x[i] + dx + game->world_map->width) % game->world_map->width;
+        int32_t ny = um->y[i] + dy;
 
         if (ny >= 0 && ny < game->world_map->height) {
-          /* Check if tile is occupied */
-          bool occupied = false;
-          for (size_t j = 0; j < game->unit_manager->unit_count; j++) {
-            if (i != j && game->unit_manager->units[j].x == nx &&
-                game->unit_manager->units[j].y == ny) {
-              occupied = true;
-              break;
-            }
-          }
-          if (!occupied) {
-            u->x = nx;
-            u->y = ny;
-          }
+          int32_t other = civ_unit_manager_unit_at(um, nx, ny, (int32_t)i);
+          if (other < 0)
+            civ_unit_manager_move_unit(um, i, nx, ny);
+          else if (game->military_system &&
+                   !civ_symbol_has_flag(um->units[other].name_sym,
+                                        CIV_SYMBOL_FLAG_BARBARIAN))
+            civ_combat_system_queue_engagement(
+                game->military_system, civ_unit_manager_handle(um, i),
+                civ_unit_manager_handle(um, (size_t)other));
         }
       }
     }
   }
 
+  /* Every engagement of the turn, battle by battle, in this turn's weather */
+  if (game->military_system && game->unit_manager) {
+    civ_combat_system_update_weather(
+        game->military_system, game->world_map, game->climate, seed,
+        game->current_turn,
+        game->time_manager ? game->time_manager->calendar.month : 1);
+    size_t fought = civ_combat_system_resolve_turn(
+        game->military_system, game->unit_manager, game->world_map,
+        civ_system_orchestrator_get_worker_pool(game->system_orchestrator),
+        seed, game->current_turn);
+    if (fought > 0)
+      printf("[GAME] %zu engagements resolved\n", fought);
+  }
+
   // Trigger settlement growth and calculate science
   if (game->settlement_manager) {
+    civ_game_refresh_modifiers(game);
     civ_settlement_manager_update(game->settlement_manager, game->world_map,
-                                  game->government, 1.0f);
+                                  game->government, game->modifiers, 1.0f);
   }
 
   if (game->government) {
     /* End-of-turn governance tick */
-    int pop = game->population_manager && game->population_manager->demographics
-      ? (int)game->population_manager->demographics->total_population : 10000;
+    int pop = game->population_manager
+      ? (int)civ_population_manager_get_total(game->population_manager) : 10000;
     float cult = game->culture_system ? 0.50f : 0.30f;
     float gbudget = game->budget ? game->budget->total_expenditure : 100000.0f;
     float edu   = game->population_manager ? game->population_manager->education_quality : 0.50f;
@@ -378,42 +1049,65 @@ civ_result_t civ_game_end_turn(civ_game_t *game) {
 
   /* Calculate Trade Bonuses */
   float trade_bonus = 0.0f;
-  if (game->diplomacy_system) {
-    for (size_t t = 0; t < game->diplomacy_system->treaty_count; t++) {
-      civ_treaty_t *treaty = &game->diplomacy_system->treaties[t];
-      if (treaty->active &&
-          treaty->treaty_type == CIV_TREATY_TYPE_TRADE_AGREEMENT) {
-        trade_bonus += 1.0f; /* +1 Science per active agreement */
-      }
-    }
-  }
+  /* +1 Science per active agreement */
+  trade_bonus += (float)civ_diplomacy_active_treaty_count(
+      game->diplomacy_system, CIV_TREATY_TYPE_TRADE_AGREEMENT);
 
-  /* Calculate Wonder Bonuses */
-  civ_wonder_effects_t wonder_bonuses = {0};
-  if (game->wonder_manager) {
-    wonder_bonuses =
-        civ_wonder_calculate_global_bonuses(game->wonder_manager, "PLAYER");
-  }
+  /* Wonders and research institutions, from the player's stack */
+  const civ_modifier_stack_t *player_mods =
+      civ_modifier_stack_of(game->modifiers, civ_owner_find("PLAYER"));
 
   float base_science = 1.0f + (float)(total_pop / 1000);
-  float science_per_turn =
-      (base_science + trade_bonus) * (1.0f + wonder_bonuses.science_mult);
+  float science_per_turn = (base_science + trade_bonus) * player_mods->science;
 
   if (game->technology_tree) {
     civ_innovation_system_set_research_budget(game->technology_tree,
                                               science_per_turn);
     civ_innovation_system_update(game->technology_tree, 1.0f);
+
+    /* Knowledge crosses borders, trade routes and friendships */
+    civ_nation_manager_t *nm = (civ_nation_manager_t *)game->nation_manager;
+    if (nm && game->tech_diffusion &&
+        civ_tech_diffusion_link(game->tech_diffusion, nm, game->world_map,
+                                game->trade_manager, game->diplomacy_system)
+                .error == CIV_OK)
+      civ_tech_diffusion_process(
+          game->tech_diffusion, nm, game->technology_tree,
+          civ_system_orchestrator_get_worker_pool(game->system_orchestrator), 1.0f);
+
+    /* People follow the same links toward better wages and stabler states */
+    if (nm && game->migration && game->tech_diffusion &&
+        game->tech_diffusion->linked_nations == (size_t)nm->count)
+      civ_migration_process(
+          game->migration, nm, game->tech_diffusion, game->diplomacy_system,
+          game->population_manager,
+          civ_system_orchestrator_get_worker_pool(game->system_orchestrator), 1.0f);
+
+    /* Standing among the other nations, from one contiguous gather */
+    int32_t *rivals = nm ? CIV_ARENA_PUSH_ARRAY(game->frame_arena, int32_t,
+                                                MAX(nm->count, 1))
+                         : NULL;
+    if (rivals) {
+      size_t n = 0;
+      for (int i = 0; i < nm->count; i++)
+        if (i != nm->player_nation_index && !nm->nations[i].defunct)
+          rivals[n++] = nm->nations[i].tech_index;
+      civ_innovation_system_rank(game->technology_tree, rivals, n);
+    }
   }
 
   /* Process Production Completion */
   for (size_t i = 0; i < game->settlement_manager->settlement_count; i++) {
     civ_settlement_t *s = &game->settlement_manager->settlements[i];
+    civ_rng_t city_rng;
+    civ_rng_seed_key(&city_rng, seed, CIV_RNG_SETTLEMENTS, turn, i);
 
     /* If city is not producing, and is a Rival city, start producing
      * something */
-    if (!s->is_producing && strstr(s->id, "rival")) {
+    if (!s->is_producing &&
+        civ_symbol_has_flag(s->id_sym, CIV_SYMBOL_FLAG_RIVAL)) {
       s->is_producing = true;
-      if (s->population > 500 && (rand() % 100 < 30)) {
+      if (s->population > 500 && civ_rng_range(&city_rng, 100) < 30) {
         s->production_type = 7; /* Settler */
         s->production_target = 80.0f;
         printf("[AI] %s started training Settlers\n", s->name);
@@ -433,9 +1127,22 @@ civ_result_t civ_game_end_turn(civ_game_t *game) {
       if (game->unit_manager) {
         char unit_name[64];
         snprintf(unit_name, sizeof(unit_name), "City Garrison (%s)", s->name);
-        civ_unit_manager_spawn_unit(game->unit_manager, s->production_type,
-                                    unit_name, 100, (int32_t)s->x,
-                                    (int32_t)s->y);
+        int32_t u = civ_unit_manager_resolve(
+            game->unit_manager,
+            civ_unit_manager_spawn_unit(game->unit_manager, s->production_type,
+                                        unit_name, 100, (int32_t)s->x,
+                                        (int32_t)s->y));
+        if (u >= 0) {
+          civ_unit_manager_set_owner(game->unit_manager, (size_t)u,
+                                     s->region_sym);
+          /* Trained under the owner's wonders and military institutions */
+          civ_owner_index_t owner =
+              s->owner_index >= 0
+                  ? game->settlement_manager->owner_ids[s->owner_index]
+                  : CIV_OWNER_NONE;
+          game->unit_manager->units[u].combat_strength *=
+              civ_modifier_stack_of(game->modifiers, owner)->military;
+        }
       }
 
       /* Reset production */
@@ -445,7 +1152,8 @@ civ_result_t civ_game_end_turn(civ_game_t *game) {
     }
 
     /* Phase 9: Revolts */
-    if (strcmp(s->region_id, "REBELS") == 0 && (rand() % 100 < 20)) {
+    if (s->region_sym == CIV_SYM_REBELS &&
+        civ_rng_range(&city_rng, 100) < 20) {
       if (game->unit_manager) {
         civ_unit_manager_spawn_unit(game->unit_manager, CIV_UNIT_TYPE_INFANTRY,
                                     "Rebel Insurgents", 80, (int32_t)s->x,
@@ -454,61 +1162,39 @@ civ_result_t civ_game_end_turn(civ_game_t *game) {
     }
   }
 
-  // AI System Update
-  if (game->ai_system) {
-    civ_ai_system_update(game->ai_system, 1.0f);
-
-    /* Trigger Proactive AI Expansion */
-    for (size_t i = 0; i < game->ai_system->strategic_count; i++) {
-      civ_strategic_ai_process_expansion(game->ai_system->strategic_ais[i],
-                                         game);
-    }
+  /* Borders redrawn by civil wars and unions */
+  civ_nation_manager_t *nations = (civ_nation_manager_t *)game->nation_manager;
+  if (nations && game->world_map) {
+    civ_rng_seed_key(&sub_rng, seed, CIV_RNG_POLITICS, turn, 0);
+    split_civil_wars(game, nations);
+    negotiate_unions(game, nations, &sub_rng);
   }
 
+  // AI System Update
+  /* Plans and owed expansions within the turn budget; the rest carry
+     over into the next frame slices */
+  if (game->ai_system)
+    civ_ai_system_end_turn(game->ai_system, (int32_t)turn);
+
+  civ_rng_bind(prev_rng);
+  CIV_MEM_TAG_BEGIN(prev_tag, CIV_MEM_TAG_HISTORY);
+  record_metrics(game);
+  civ_state_hash_record(game->state_hashes, game);
+  CIV_MEM_TAG_END(prev_tag);
+  civ_mem_tags_end_turn();
+  civ_store_registry_end_turn();
+  /* The turn changed the economies the last tick's guesses were made from;
+     guess again while the player looks the new turn over */
+  civ_nation_speculate_fiscal_policy(
+      (civ_nation_manager_t *)game->nation_manager,
+      civ_system_orchestrator_get_worker_pool(game->system_orchestrator));
+  CIV_PROFILE_END(turn_scope);
+  civ_delta_export_turn(game->delta_export, game);
+  if (game->command_log)
+    record_turn_end(game);
   return ok_result();
 }
 
-/* Phase 11: Stature Ranking Logic */
-static void civ_game_update_stature_rankings(civ_game_t *game) {
-  if (!game || !game->government)
-    return;
-
-  civ_government_t *gov = game->government;
-
-  /* Calculate National Capability Index (NCI) */
-  /* Factors: Institutional Stature, Stability, Efficiency, and Tech Level */
-  civ_float_t institutional_stature = 0.0f;
-  if (gov->institution_manager) {
-    /* Sum of log-scaled stature from all institutions */
-    for (size_t i = 0; i < gov->institution_manager->count; i++) {
-      if (gov->institution_manager->items[i].is_active) {
-        institutional_stature +=
-            log2f(1.0f + gov->institution_manager->items[i].stature);
-      }
-    }
-  }
-
-  civ_float_t nci =
-      (institutional_stature * 10.0f) * gov->efficiency * gov->stability;
-
-  /* Simple Tier Mapping (In a multi-nation world, this would be relative to
-   * others) */
-  if (nci > 500.0f)
-    gov->stature_tier = CIV_STATURE_HEGEMON;
-  else if (nci > 300.0f)
-    gov->stature_tier = CIV_STATURE_GREAT_POWER;
-  else if (nci > 150.0f)
-    gov->stature_tier = CIV_STATURE_REGIONAL_POWER;
-  else if (nci > 75.0f)
-    gov->stature_tier = CIV_STATURE_STABLE_STATE;
-  else if (nci > 30.0f)
-    gov->stature_tier = CIV_STATURE_DEVELOPING_STATE;
-  else if (nci > 10.0f)
-    gov->stature_tier = CIV_STATURE_FRONTIER_NATION;
-  else
-    gov->stature_tier = CIV_STATURE_FAILED_STATE;
-}
-
 void civ_game_run(civ_game_t *game) {
   if (!game)
     return;
@@ -519,417 +1205,41 @@ void civ_game_run(civ_game_t *game) {
   }
 }
 
+void civ_game_begin_frame(civ_game_t *game) {
+  if (game)
+    civ_arena_reset(game->frame_arena);
+}
+
 void civ_game_update(civ_game_t *game) {
   if (!game || !game->is_running || game->is_paused)
     return;
 
+  uint64_t update_start = civ_profiler_now_ns();
+
   /* Phase 0: Time — produces delta for all downstream systems */
+  CIV_PROFILE_START(time_scope, prof_time);
   civ_float_t dt = 1.0f;
-  if (game->time_manager) {
+  if (game->fixed_dt > 0.0) {
+    dt = game->fixed_dt;
+  } else if (game->time_manager) {
     dt = civ_time_manager_update(game->time_manager);
   }
+  CIV_PROFILE_END(time_scope);
+  if (game->command_log)
+    record_command(game, CIV_CMD_UPDATE, 1, dt);
 
-  /* Phase 1: Demographics & Economy
-   * ================================================================
-   * Dependencies flow top-down. Each module reads values produced by
-   * modules above it. Circular deps use previous-cycle (lagged) values.
-   * ================================================================ */
-
-  /* Recompute per-nation economies every 10 turns */
-  if (game->nation_manager && game->world_map &&
-      game->current_turn % 10 == 1) {
-    civ_nation_compute_all_economies(
-        (civ_nation_manager_t *)game->nation_manager,
-        game->world_map, game->resource_map, &game->global_economy);
-  }
-
-  /* --- Extract baseline data from core systems --- */
-  int64_t   total_pop  = 0;
-  civ_float_t tech_lev  = 1.0;
-  civ_float_t education = 0.50;
-  civ_float_t health    = 0.50;
-
-  if (game->population_manager) {
-    civ_population_manager_update(game->population_manager, dt, NULL);
-    if (game->population_manager->demographics)
-      total_pop = game->population_manager->demographics->total_population;
-    education = game->population_manager->education_quality;
-    health    = game->population_manager->health_index;
-  }
-  if (total_pop < 100) total_pop = 100;
-
-  if (game->technology_tree)
-    tech_lev = (civ_float_t)game->technology_tree->aggregate_index / 100.0;
-  if (tech_lev < 0.1) tech_lev = 0.1;
-
-  /* Governance signals — single source of truth */
-  civ_float_t gov_efficiency  = game->government ? game->government->efficiency : 0.50;
-  civ_float_t corruption      = game->government
-    ? civ_government_get_corruption(game->government) : 0.10f;
-  civ_float_t gov_stability   = game->government ? game->government->stability : 0.60f;
-  civ_float_t gov_legitimacy  = game->government ? game->government->legitimacy : 0.60f;
-  civ_float_t regulation_level = 0.35;
-  if (game->economic_policy)
-    regulation_level = (civ_float_t)game->economic_policy->regulation * 0.25;
-
-  /* Geography */
-  civ_float_t arable_area    = game->geography ? civ_geography_get_agricultural_area(game->geography) : 2000.0;
-  civ_float_t geography_size = 10000.0;
-  if (game->geography && game->geography->patch_count > 0) {
-    geography_size = 0.0;
-    for (size_t pi = 0; pi < game->geography->patch_count; pi++)
-      geography_size += game->geography->land_patches[pi].area;
-  }
-  if (geography_size < 100.0) geography_size = 100.0;
-
-  /* Governance cross-module bonuses — read once, applied throughout economy */
-  float gov_econ_bonus    = 1.0f;
-  float gov_trade_bonus   = 1.0f;
-  float gov_research_bonus = 1.0f;
-  float gov_military_bonus = 1.0f;
-  float gov_cohesion       = 0.50f;
-  if (game->government) {
-    civ_governance_state_t *ev = &game->government->evolution_state;
-    gov_econ_bonus     = (float)civ_governance_economic_bonus(ev);
-    gov_trade_bonus    = (float)civ_governance_trade_bonus(ev);
-    gov_research_bonus = (float)civ_governance_research_bonus(ev);
-    gov_military_bonus = (float)civ_governance_military_bonus(ev);
-    gov_cohesion       = (float)civ_governance_cohesion_bonus(ev);
-  }
-
-  /* =================================================================
-   * Phase 1a: macro_economy (produces GDP, inflation, growth, unemployment)
-   * ================================================================= */
-  civ_float_t gdp            = 500000.0;
-  civ_float_t gdp_per_capita = 50000.0;
-  civ_float_t gdp_growth     = 0.02;
-  civ_float_t inflation      = 0.02;
-  civ_float_t unemployment   = 0.05;
-
-  if (game->market_economy) {
-    civ_market_dynamics_update(game->market_economy, dt, game->population_manager,
-                               game->geography, tech_lev * gov_econ_bonus);
-    civ_economic_report_t rep = civ_market_dynamics_get_report(game->market_economy);
-    gdp            = rep.gdp * gov_econ_bonus;
-    gdp_per_capita = rep.gdp_per_capita * gov_econ_bonus;
-    gdp_growth     = rep.growth_rate * gov_econ_bonus;
-    inflation      = rep.inflation_rate;
-    unemployment   = rep.unemployment_rate;
-  }
-
-  /* =================================================================
-   * Phase 1b: labor_market (needs population + GDP + education + confidence)
-   * ================================================================= */
-  civ_float_t business_conf = game->economic_policy ? game->economic_policy->business_confidence : 0.60;
-  civ_float_t avg_wage      = 30000.0;
-  int         labor_avail   = (int)(total_pop * 0.4);
-  int         labor_employed = 0;
-
-  if (game->labor_market) {
-    civ_labor_market_update(game->labor_market, dt, (int)total_pop, gdp, tech_lev,
-                            education, business_conf);
-    unemployment  = game->labor_market->overall_unemployment;
-    avg_wage      = game->labor_market->avg_wage_national;
-    labor_avail   = game->labor_market->total_workforce - game->labor_market->total_employed;
-    if (labor_avail < 0) labor_avail = 0;
-    labor_employed = game->labor_market->total_employed;
-  }
-
-  /* =================================================================
-   * Phase 1c: economic_policy (needs macro indicators)
-   * ================================================================= */
-  if (game->economic_policy) {
-    civ_economic_policy_update(game->economic_policy, dt, inflation,
-                               unemployment, gdp_growth, corruption);
-    business_conf = game->economic_policy->business_confidence;
-    regulation_level = (civ_float_t)game->economic_policy->regulation * 0.25;
-  }
-
-  /* =================================================================
-   * Phase 1d: taxation (needs GDP + population + governance)
-   * ================================================================= */
-  civ_float_t tax_revenue = 50000.0;
-
-  if (game->taxation) {
-    civ_taxation_update(game->taxation, dt, gdp, (civ_float_t)total_pop,
-                        gov_efficiency, corruption);
-    tax_revenue = game->taxation->total_revenue;
-  }
-
-  /* =================================================================
-   * Phase 1e: budget (needs tax revenue + GDP + population + inflation)
-   * ================================================================= */
-  civ_float_t budget_infra_allocation = 30000.0;
-  civ_float_t gov_spending_ratio      = 0.20;
-  civ_float_t debt_interest_rate      = 0.03;
-  civ_float_t savings_rate            = 0.15;
-
-  if (game->budget) {
-    civ_budget_update(game->budget, dt, tax_revenue, gdp,
-                      (civ_float_t)total_pop, inflation);
-    gov_spending_ratio   = (gdp > 0) ? game->budget->total_expenditure / gdp : 0.20;
-    budget_infra_allocation = civ_budget_spending_for(game->budget, CIV_BUDGET_INFRASTRUCTURE);
-    debt_interest_rate   = game->budget->debt_interest_rate;
-    savings_rate         = 1.0 - gov_spending_ratio;
-    if (savings_rate < 0.05) savings_rate = 0.05;
-  }
-
-  /* =================================================================
-   * Phase 1e2: commodity_market (update resource prices)
-   * ================================================================= */
-  if (game->commodity_market) {
-    game->commodity_market->global_price_index = 1.0f + inflation;
-    civ_resource_market_update_all(game->commodity_market);
-  }
-
-  /* =================================================================
-   * Phase 1f: banking (needs macro + gov spending)
-   * ================================================================= */
-  if (game->banking) {
-    civ_banking_update(game->banking, dt, inflation, gdp_growth,
-                       unemployment, gov_spending_ratio);
-    debt_interest_rate = game->banking->base_interest_rate; /* banking rate overrides budget rate */
-  }
-
-  /* =================================================================
-   * Phase 1g: agriculture (needs population + arable land + tech + climate)
-   * ================================================================= */
-  civ_float_t food_surplus = 0.0;
-  if (game->agriculture) {
-    civ_agriculture_update(game->agriculture, dt, (civ_float_t)total_pop,
-                           arable_area, tech_lev, 1.0);
-    food_surplus = game->agriculture->food_surplus;
-  }
-
-  /* =================================================================
-   * Phase 1h: extraction (needs tech + labor + geography)
-   * ================================================================= */
-  civ_float_t raw_materials = 100.0;
-  if (game->extraction) {
-    civ_float_t mineral_richness = 0.70; /* proxy — no direct geography field yet */
-    civ_extraction_update(game->extraction, dt, tech_lev,
-                          (civ_float_t)labor_avail, mineral_richness);
-    raw_materials = game->extraction->total_output;
-    if (raw_materials < 1.0) raw_materials = 1.0;
-  }
-
-  /* =================================================================
-   * Phase 1i: infrastructure (needs budget + population + geography)
-   * ================================================================= */
-  civ_float_t infra_quality = 0.50;
-  civ_float_t infra_supply_chain = 0.50;
-  if (game->infrastructure) {
-    civ_infrastructure_update(game->infrastructure, dt, budget_infra_allocation,
-                              (civ_float_t)total_pop, geography_size);
-    infra_quality       = game->infrastructure->overall_quality;
-    infra_supply_chain  = game->infrastructure->supply_chain_efficiency;
-  }
-
-  /* =================================================================
-   * Phase 1j: manufacturing (needs tech + labor + raw materials + infra)
-   * ================================================================= */
-  civ_float_t industrial_output = 500.0;
-  if (game->manufacturing) {
-    civ_manufacturing_update(game->manufacturing, dt, tech_lev,
-                             (civ_float_t)labor_avail, raw_materials, infra_quality);
-    industrial_output = game->manufacturing->total_industrial_output;
-    if (industrial_output < 1.0) industrial_output = 1.0;
-  }
-
-  /* =================================================================
-   * Phase 1k: energy (needs population + industrial output + tech)
-   * ================================================================= */
-  civ_float_t energy_price = 50.0;
-  if (game->energy) {
-    civ_energy_update(game->energy, dt, (civ_float_t)total_pop,
-                      industrial_output, tech_lev, 0.80);
-    energy_price = game->energy->energy_price;
-  }
-
-  /* =================================================================
-   * Phase 1l: housing (needs population + wages + interest + costs)
-   * ================================================================= */
-  civ_float_t construction_cost_index = (energy_price / 50.0 + infra_quality > 0)
-                                         ? (1.0 + (1.0 - infra_quality)) : 1.5;
-  if (game->housing) {
-    civ_housing_update(game->housing, dt, (int)total_pop, avg_wage,
-                       debt_interest_rate, construction_cost_index);
-  }
-
-  /* =================================================================
-   * Phase 1m: land_use (needs population + GDP/capita + urbanization)
-   * ================================================================= */
-  civ_float_t urban_rate = game->housing ? game->housing->urbanization : 0.55;
-  if (game->land_use) {
-    civ_land_use_update(game->land_use, dt, (int)total_pop, gdp_per_capita, urban_rate);
-  }
-
-  /* =================================================================
-   * Phase 1n: capital_assets (needs GDP + savings + interest + confidence)
-   * ================================================================= */
-  if (game->capital_assets) {
-    civ_capital_assets_update(game->capital_assets, dt, gdp, savings_rate,
-                              debt_interest_rate, business_conf);
-  }
-
-  /* =================================================================
-   * Phase 1o: domestic_trade (needs infrastructure + population + geography)
-   * ================================================================= */
-  if (game->domestic_trade) {
-    civ_domestic_trade_update(game->domestic_trade, dt, infra_quality,
-                              (civ_float_t)total_pop, geography_size);
-  }
-
-  /* =================================================================
-   * Phase 1p: international_trade
-   * ================================================================= */
-  if (game->trade_manager)
-    civ_trade_update(game->trade_manager, dt);
-
-  /* =================================================================
-   * Phase 1q: innovation_economy (needs GDP + education + confidence + capital)
-   * ================================================================= */
-  civ_float_t capital_avail = game->capital_assets
-    ? game->capital_assets->total_capital_stock / (gdp + 1.0) : 0.50;
-  if (game->innovation_economy) {
-    civ_innovation_economy_update(game->innovation_economy, dt, gdp, education,
-                                  business_conf, regulation_level, capital_avail);
-  }
-
-  /* =================================================================
-   * Phase 1r: black_market (needs GDP + corruption + unemployment + regulation)
-   * ================================================================= */
-  if (game->black_market) {
-    civ_black_market_update(game->black_market, dt, gdp, corruption,
-                            unemployment, regulation_level, 10000.0);
-  }
-
-  /* =================================================================
-   * Phase 1s: war_economy (needs GDP + industrial output + population)
-   * ================================================================= */
-  bool actively_fighting = false;
-  if (game->war_economy) {
-    civ_war_economy_update(game->war_economy, dt, gdp, industrial_output,
-                           (int)total_pop, actively_fighting);
-  }
-
-  /* =================================================================
-   * Phase 2: Diplomacy & Governance
-   * ================================================================= */
-  if (game->diplomacy_system)
-    civ_diplomacy_system_update_relations(game->diplomacy_system, 0);
-
-  /* Feed budget allocations into government from economic budget module */
-  if (game->government && game->budget) {
-    civ_government_set_budget(game->government, CIV_BUDGET_MILITARY,
-      civ_budget_spending_for(game->budget, CIV_BUDGET_MILITARY));
-    civ_government_set_budget(game->government, CIV_BUDGET_INFRASTRUCTURE,
-      civ_budget_spending_for(game->budget, CIV_BUDGET_INFRASTRUCTURE));
-    civ_government_set_budget(game->government, CIV_BUDGET_EDUCATION,
-      civ_budget_spending_for(game->budget, CIV_BUDGET_EDUCATION));
-    civ_government_set_budget(game->government, CIV_BUDGET_HEALTHCARE,
-      civ_budget_spending_for(game->budget, CIV_BUDGET_HEALTHCARE));
-    civ_government_set_budget(game->government, CIV_BUDGET_WELFARE,
-      civ_budget_spending_for(game->budget, CIV_BUDGET_WELFARE));
-    civ_government_set_budget(game->government, CIV_BUDGET_RESEARCH,
-      civ_budget_spending_for(game->budget, CIV_BUDGET_RESEARCH));
-    civ_government_set_budget(game->government, CIV_BUDGET_ADMINISTRATION,
-      civ_budget_spending_for(game->budget, CIV_BUDGET_ADMINISTRATION));
-    civ_government_set_budget(game->government, CIV_BUDGET_DEBT_SERVICE,
-      civ_budget_spending_for(game->budget, CIV_BUDGET_DEBT_SERVICE));
-  }
-
-  /* Main governance tick — propagates to ALL 14 subsystems */
-  civ_float_t total_gov_budget = game->budget ? game->budget->total_expenditure : 100000.0f;
-  civ_float_t culture_level    = game->culture_system ? 0.50f : 0.30f;
-
-  if (game->government) {
-    float edu_lvl  = game->population_manager ? game->population_manager->education_quality : 0.50f;
-    float econ_conf = game->economic_policy ? game->economic_policy->consumer_confidence : 0.50f;
-    float lit_rate  = edu_lvl;
-    float fac_sup   = 0.55f;
-    int   fac_cnt   = 3;
-    civ_government_update(game->government, dt, (int)total_pop,
-                          culture_level, total_gov_budget, edu_lvl, econ_conf, lit_rate,
-                          fac_sup, fac_cnt);
-
-    /* Refresh corruption/efficiency from governance (updated this frame) */
-    corruption     = civ_government_get_corruption(game->government);
-    gov_efficiency = game->government->efficiency;
-    gov_stability  = game->government->stability;
-    gov_legitimacy = game->government->legitimacy;
-  }
-
-  /* Custom governance: parallel system — update if nations have custom govs */
-  if (game->custom_governance_manager) {
-    for (size_t i = 0; i < game->custom_governance_manager->government_count; i++) {
-      civ_custom_governance_t *cg = game->custom_governance_manager->governments + i;
-      civ_custom_governance_update(cg, dt);
-    }
-  }
-
-  /* ── Tick ALL nation governments autonomously ── */
-  if (game->nation_manager) {
-    civ_nation_manager_t *nm = (civ_nation_manager_t *)game->nation_manager;
-    for (int ni = 0; ni < nm->count; ni++) {
-      civ_nation_t *nation = &nm->nations[ni];
-      if (!nation->government) continue;
-      /* Skip player nation — already ticked above */
-      if (nation->government == game->government) continue;
-
-      /* Each nation gets its own governance tick with autonomous trait evolution */
-      civ_government_update(nation->government, dt, (int)total_pop,
-                            culture_level, total_gov_budget / (float)(nm->count + 1),
-                            education, business_conf, education, 0.55f, 3);
-    }
-  }
-
-  /* Phase 3: Settlements & Production */
-  if (game->settlement_manager)
-    civ_settlement_manager_update(game->settlement_manager, game->world_map,
-                                  game->government, dt);
-
-  /* Phase 4: Technology */
-  if (game->technology_tree)
-    civ_innovation_system_update(game->technology_tree, dt * gov_research_bonus);
-
-  /* Phase 5: Culture & Society */
-  if (game->culture_system)
-    civ_culture_system_update(game->culture_system, dt);
-  if (game->politics_system)
-    civ_politics_system_update(game->politics_system, dt);
-
-  /* Phase 6: Military */
-  if (game->conquest_system) {
-    civ_conquest_update(game->conquest_system, dt);
-    int transferred = civ_conquest_transfer_territory(
-        game->conquest_system, game->world_map, game->nation_manager);
-    if (transferred > 0)
-      printf("[GAME] %d border tiles transferred via conquest\n", transferred);
-  }
-
-  /* Phase 7: Territory & Borders */
-  if (game->dynamic_borders)
-    civ_dynamic_borders_update(game->dynamic_borders, dt);
-  if (game->territory_manager)
-    civ_territory_manager_update(game->territory_manager, dt);
-
-  /* Phase 8: AI reacts to current world state */
-  if (game->ai_system)
-    civ_ai_system_update(game->ai_system, dt);
-  if (game->subunit_manager)
-    civ_subunit_manager_update(game->subunit_manager, dt);
-
-  /* Phase 9: Events & Disasters */
-  if (game->event_manager)
-    civ_event_manager_update(game->event_manager, dt);
-  if (game->disaster_manager)
-    civ_disaster_update(game->disaster_manager, dt);
-
-  /* Phase 10: Stature rankings (computed from all above) */
-  civ_game_update_stature_rankings(game);
+  /* Phases 1–10 run as a dependency graph on the system orchestrator;
+   * see game_systems.c for the per-system data dependencies. */
+  civ_game_systems_update(game, dt);
 
   game->performance.update_count++;
+  civ_profiler_end_frame();
+  civ_performance_optimizer_record(
+      game->performance_optimizer, perf_update,
+      (civ_float_t)(civ_profiler_now_ns() - update_start) / 1000000.0f, 0.0f);
+  /* Workers are idle between ticks but for the path solve, which records
+     no samples; fold theirs in */
+  civ_performance_optimizer_merge(game->performance_optimizer);
 }
 
 void civ_game_pause(civ_game_t *game) {
@@ -946,18 +1256,46 @@ void civ_game_shutdown(civ_game_t *game) {
   if (!game)
     return;
 
+  /* The loader thread is still writing the state torn down below */
+  civ_game_load_finish(game);
+
   game->is_running = false;
   game->state = CIV_GAME_STATE_SHUTTING_DOWN;
 
   // Destroy systems in reverse order of dependency
+  civ_tile_field_destroy(game->tile_field);
+  game->tile_field = NULL;
+  civ_logistics_field_destroy(game->logistics_field, game->world_map);
+  game->logistics_field = NULL;
+  civ_site_field_destroy(game->site_field);
+  game->site_field = NULL;
+  civ_influence_map_destroy(game->influence_map);
+  game->influence_map = NULL;
+  civ_trade_network_destroy(game->trade_network);
+  game->trade_network = NULL;
+  civ_ocean_regions_destroy(game->ocean_regions);
+  game->ocean_regions = NULL;
+  civ_path_service_destroy(game->path_service);
+  game->path_service = NULL;
+  civ_pathfinder_destroy(game->pathfinder);
+  game->pathfinder = NULL;
   if (game->world_map)
     civ_map_destroy(game->world_map);
-  // if (game->event_manager) civ_event_manager_destroy(game->event_manager); //
-  // event_manager free might differ
+  /* Border tiles may point into the pack mapping */
+  civ_political_borders_free();
+  civ_world_pack_close(game->world_pack);
+  game->world_pack = NULL;
+  if (game->cities_data) civ_cities_data_destroy(game->cities_data);
+  if (game->flag_system) civ_flag_system_destroy(game->flag_system);
+  game->cities_data = NULL;
+  game->flag_system = NULL;
+  civ_event_rules_destroy(game->event_rules);
+  game->event_rules = NULL;
+  if (game->event_manager)
+    civ_event_manager_destroy(game->event_manager);
+  game->event_manager = NULL;
   if (game->time_manager)
     civ_time_manager_destroy(game->time_manager);
-  if (game->memory_pool)
-    civ_memory_pool_manager_destroy(game->memory_pool);
 
   if (game->population_manager)
     civ_population_manager_destroy(game->population_manager);
@@ -970,6 +1308,10 @@ void civ_game_shutdown(civ_game_t *game) {
   if (game->budget)             civ_budget_destroy(game->budget);
   if (game->economic_policy)    civ_economic_policy_destroy(game->economic_policy);
   if (game->agriculture)        civ_agriculture_destroy(game->agriculture);
+  civ_climate_destroy(game->climate);
+  CIV_FREE(game->climate_profile);
+  civ_pollution_destroy(game->pollution);
+  game->pollution = NULL;
   if (game->extraction)         civ_extraction_destroy(game->extraction);
   if (game->manufacturing)      civ_manufacturing_destroy(game->manufacturing);
   if (game->energy)             civ_energy_destroy(game->energy);
@@ -983,6 +1325,9 @@ void civ_game_shutdown(civ_game_t *game) {
   if (game->war_economy)        civ_war_economy_destroy(game->war_economy);
   if (game->black_market)       civ_black_market_destroy(game->black_market);
   if (game->innovation_economy) civ_innovation_economy_destroy(game->innovation_economy);
+  if (game->trade_manager)      civ_trade_manager_destroy(game->trade_manager);
+  if (game->market)             civ_market_destroy(game->market);
+  game->market = NULL;
 
   /* Governance */
   if (game->nation_manager) {
@@ -1002,21 +1347,64 @@ void civ_game_shutdown(civ_game_t *game) {
     civ_combat_system_destroy(game->military_system);
   if (game->diplomacy_system)
     civ_diplomacy_system_destroy(game->diplomacy_system);
+  /* After the map, which held its owner listener */
+  civ_dynamic_borders_destroy(game->dynamic_borders);
+  game->dynamic_borders = NULL;
+  civ_tech_diffusion_destroy(game->tech_diffusion);
+  game->tech_diffusion = NULL;
+  civ_migration_destroy(game->migration);
+  game->migration = NULL;
+  civ_nation_labels_destroy(game->nation_labels);
+  game->nation_labels = NULL;
   if (game->culture_system)
     civ_culture_system_destroy(game->culture_system);
+  civ_naming_destroy(game->naming);
+  game->naming = NULL;
+  civ_religion_system_destroy(game->religion_system);
+  civ_epidemic_system_destroy(game->epidemics);
+  game->epidemics = NULL;
+  civ_disaster_manager_destroy(game->disaster_manager);
+  game->disaster_manager = NULL;
+  game->religion_system = NULL;
   if (game->settlement_manager)
     civ_settlement_manager_destroy(game->settlement_manager);
+  civ_modifier_table_destroy(game->modifiers);
+  game->modifiers = NULL;
   if (game->wonder_manager)
     civ_wonder_manager_destroy(game->wonder_manager);
+  /* Lets an autosave in flight finish before the game goes away */
+  SAFE_DESTROY(game->save_worker, civ_save_worker_destroy);
+  SAFE_DESTROY(game->lockstep, civ_lockstep_destroy);
+  SAFE_DESTROY(game->command_log, civ_command_log_destroy);
+  SAFE_DESTROY(game->delta_export, civ_delta_export_close);
+  SAFE_DESTROY(game->state_hashes, civ_state_hash_destroy);
+  if (game->metrics_history)
+    civ_maintenance_unregister(game->metrics_upkeep);
+  SAFE_DESTROY(game->metrics_history, civ_time_series_destroy);
+  SAFE_DESTROY(game->frame_arena, civ_arena_destroy);
+  SAFE_DESTROY(game->turn_arena, civ_arena_destroy);
+  SAFE_DESTROY(game->cache, civ_cache_destroy);
   if (game->persistence)
     civ_state_persistence_destroy(game->persistence);
+  CIV_FREE(game->autosave.region_revision);
+  civ_game_systems_destroy(game);
   if (game->system_orchestrator)
     civ_system_orchestrator_destroy(game->system_orchestrator);
+  SAFE_DESTROY(game->performance_optimizer, civ_performance_optimizer_destroy);
   // ... destroy others ...
+  /* Last: systems above may still hand blocks back to it */
+  SAFE_DESTROY(game->memory_pool, civ_memory_pool_manager_destroy);
+
+  /* Built with CIV_MEM_TAGS: peaks per tag, and anything still live here
+     was never handed back */
+  if (civ_mem_tags_enabled()) {
+    printf("[GAME] Memory by tag at shutdown:\n");
+    civ_mem_tags_dump(stdout);
+  }
 }
 
 #define CIV_SAVE_MAGIC   0x43495653 /* "CIVS" */
-#define CIV_SAVE_VERSION 3
+#define CIV_SAVE_VERSION 5 /* v5: chunked container, quantized tile columns */
 
 typedef struct {
   /* v1 */
@@ -1045,81 +1433,264 @@ typedef struct {
   uint32_t          reserved[7];
 } civ_save_header_t;
 
-civ_result_t civ_game_save_state(civ_game_t *game, const char *filename) {
-  if (!game || !game->persistence)
-    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT,
-                          "Invalid game or persistence"};
+/* Tile fields are saved one column (section) each, row by row. Values are
+   quantized, delta coded against their west neighbour and split into byte
+   planes, so the LZ pass sees long runs of zeros. */
+typedef enum {
+  COL_UNIT,      /* value in [0, 1], 16 bits */
+  COL_TERRAIN,
+  COL_LAND_USE,
+  COL_OWNER,
+  COL_COLOR,
+  COL_FLAGS      /* bools packed into one byte */
+} tile_column_kind_t;
 
-  // 1. Prepare Header
-  civ_save_header_t header;
-  memset(&header, 0, sizeof(header));
-  header.magic = CIV_SAVE_MAGIC;
-  header.version = CIV_SAVE_VERSION;
-  header.config = game->config;
-  header.map_width = game->world_map ? game->world_map->width : 0;
-  header.map_height = game->world_map ? game->world_map->height : 0;
-  header.map_seed = game->world_map ? game->world_map->seed : 0;
-  header.sea_level = game->world_map ? game->world_map->sea_level : 0.0f;
+typedef struct {
+  uint32_t           tag;
+  tile_column_kind_t kind;
+  size_t             offset;   /* COL_UNIT field */
+  int                slot;     /* COL_UNIT index in saved_tile_t.unit */
+  int                bits;     /* COL_UNIT field: 8/16 = unorm, 32 = float */
+} tile_column_t;
+
+#define UNIT_COLUMN(a, b, c, d, field, slot, bits)                           \
+  {CIV_SAVE_TAG(a, b, c, d), COL_UNIT, offsetof(civ_map_tile_t, field), slot, \
+   bits}
+
+static const tile_column_t tile_columns[] = {
+    UNIT_COLUMN('T', 'E', 'L', 'V', elevation, 0, 16),
+    UNIT_COLUMN('T', 'M', 'O', 'I', moisture, 1, 16),
+    UNIT_COLUMN('T', 'T', 'M', 'P', temperature, 2, 16),
+    UNIT_COLUMN('T', 'V', 'E', 'G', vegetation_density, 3, 8),
+    UNIT_COLUMN('T', 'F', 'E', 'R', fertility, 4, 16),
+    UNIT_COLUMN('T', 'R', 'E', 'S', resources, 5, 8),
+    UNIT_COLUMN('T', 'P', 'I', 'N', political_influence, 6, 8),
+    UNIT_COLUMN('T', 'P', 'O', 'P', population_density, 7, 8),
+    UNIT_COLUMN('T', 'C', 'U', 'L', cultural_influence, 8, 32),
+    {CIV_SAVE_TAG('T', 'T', 'E', 'R'), COL_TERRAIN, 0, 0},
+    {CIV_SAVE_TAG('T', 'L', 'U', 'S'), COL_LAND_USE, 0, 0},
+    {CIV_SAVE_TAG('T', 'O', 'W', 'N'), COL_OWNER, 0, 0},
+    {CIV_SAVE_TAG('T', 'C', 'O', 'L'), COL_COLOR, 0, 0},
+    {CIV_SAVE_TAG('T', 'F', 'L', 'G'), COL_FLAGS, 0, 0},
+};
+
+/* A tile as the save stores it, every column already quantized to 16 bits.
+   Snapshots hold tiles in this form, a little smaller than the live tile. */
+#define SAVED_UNIT_FIELDS 9
+typedef struct {
+  uint16_t          unit[SAVED_UNIT_FIELDS];
+  uint8_t           terrain, land_use, flags;
+  civ_owner_index_t owner;
+  uint32_t          color;
+} saved_tile_t;
+
+#define SAVE_TAG_HEADER CIV_SAVE_TAG('H', 'E', 'A', 'D')
+#define SAVE_TAG_OWNERS CIV_SAVE_TAG('O', 'W', 'N', 'R')
+#define SAVE_TAG_CHAIN  CIV_SAVE_TAG('C', 'H', 'A', 'N') /* base: chain id */
+#define SAVE_TAG_DELTA  CIV_SAVE_TAG('D', 'L', 'T', 'A') /* delta: id, seq */
+#define SAVE_TAG_REGION CIV_SAVE_TAG('R', 'G', 'N', '0') /* delta: one region */
+#define TILE_FLAG_RIVER    0x01u
+#define TILE_FLAG_RESOURCE 0x02u
+#define TILE_FLAG_EXPLORED 0x04u
+#define TILE_FLAG_VISIBLE  0x08u
+
+static int column_bytes(tile_column_kind_t kind) {
+  switch (kind) {
+  case COL_UNIT:  return 2;
+  case COL_OWNER: return (int)sizeof(civ_owner_index_t);
+  case COL_COLOR: return 4;
+  default:        return 1;
+  }
+}
+
+/* Unorm fields widen exactly (x * 257 maps 255 to 65535); floats quantize */
+static uint16_t unit_field_get(const tile_column_t *c, const civ_map_tile_t *t) {
+  const uint8_t *field = (const uint8_t *)t + c->offset;
+  switch (c->bits) {
+  case 8:  return (uint16_t)(*field * 257u);
+  case 16: return *(const uint16_t *)field;
+  default: return civ_unorm16_encode(*(const float *)field);
+  }
+}
+
+static void unit_field_set(const tile_column_t *c, civ_map_tile_t *t,
+                           uint32_t v) {
+  uint8_t *field = (uint8_t *)t + c->offset;
+  switch (c->bits) {
+  case 8:  *field = (uint8_t)((v + 128u) / 257u); break;
+  case 16: *(uint16_t *)field = (uint16_t)v; break;
+  default: *(float *)field = civ_unorm16_decode((uint16_t)v); break;
+  }
+}
+
+static void pack_tile(saved_tile_t *out, const civ_map_tile_t *t) {
+  for (size_t c = 0; c < ARRAY_SIZE(tile_columns); c++) {
+    if (tile_columns[c].kind != COL_UNIT) continue;
+    out->unit[tile_columns[c].slot] = unit_field_get(&tile_columns[c], t);
+  }
+  out->terrain = (uint8_t)t->terrain;
+  out->land_use = (uint8_t)t->land_use;
+  out->flags = (uint8_t)((t->has_river ? TILE_FLAG_RIVER : 0) |
+                         (t->has_resource ? TILE_FLAG_RESOURCE : 0) |
+                         (t->is_explored ? TILE_FLAG_EXPLORED : 0) |
+                         (t->is_visible ? TILE_FLAG_VISIBLE : 0));
+  out->owner = t->owner_index;
+  out->color = t->political_color;
+}
+
+static uint32_t saved_value(const tile_column_t *c, const saved_tile_t *t) {
+  switch (c->kind) {
+  case COL_UNIT:     return t->unit[c->slot];
+  case COL_TERRAIN:  return t->terrain;
+  case COL_LAND_USE: return t->land_use;
+  case COL_OWNER:    return t->owner;
+  case COL_COLOR:    return t->color;
+  case COL_FLAGS:    return t->flags;
+  }
+  return 0;
+}
+
+static void column_set(const tile_column_t *c, civ_map_tile_t *t, uint32_t v) {
+  switch (c->kind) {
+  case COL_UNIT:     unit_field_set(c, t, v); break;
+  case COL_TERRAIN:  t->terrain = (uint8_t)v; break;
+  case COL_LAND_USE: t->land_use = (uint8_t)v; break;
+  case COL_OWNER:    t->owner_index = (civ_owner_index_t)v; break;
+  case COL_COLOR:    t->political_color = v; break;
+  case COL_FLAGS:
+    t->has_river = (v & TILE_FLAG_RIVER) != 0;
+    t->has_resource = (v & TILE_FLAG_RESOURCE) != 0;
+    t->is_explored = (v & TILE_FLAG_EXPLORED) != 0;
+    t->is_visible = (v & TILE_FLAG_VISIBLE) != 0;
+    break;
+  }
+}
+
+static void encode_row(uint8_t *out, const uint32_t *vals, int w, int bytes) {
+  uint32_t prev = 0;
+  for (int x = 0; x < w; x++) {
+    uint32_t d = vals[x] - prev;
+    prev = vals[x];
+    for (int b = 0; b < bytes; b++)
+      out[(size_t)b * w + x] = (uint8_t)(d >> (8 * b));
+  }
+}
+
+static void decode_row(uint32_t *vals, const uint8_t *in, int w, int bytes) {
+  uint32_t mask = bytes >= 4 ? 0xFFFFFFFFu : (1u << (8 * bytes)) - 1;
+  uint32_t prev = 0;
+  for (int x = 0; x < w; x++) {
+    uint32_t d = 0;
+    for (int b = 0; b < bytes; b++)
+      d |= (uint32_t)in[(size_t)b * w + x] << (8 * b);
+    prev = (prev + d) & mask;
+    vals[x] = prev;
+  }
+}
+
+/* Row scratch for the column coder: one value and its byte planes */
+typedef struct {
+  uint32_t *vals;
+  uint8_t  *bytes;
+} tile_row_buffer_t;
+
+static bool row_buffer_init(tile_row_buffer_t *rb, int32_t width) {
+  rb->vals = (uint32_t *)CIV_MALLOC((size_t)width * sizeof(uint32_t));
+  rb->bytes = (uint8_t *)CIV_MALLOC((size_t)width * sizeof(uint32_t));
+  return rb->vals && rb->bytes;
+}
+
+static void row_buffer_free(tile_row_buffer_t *rb) {
+  CIV_FREE(rb->vals);
+  CIV_FREE(rb->bytes);
+}
+
+/* A rectangle of tiles, whole map or one revision region */
+typedef struct {
+  int32_t x0, y0, w, h;
+} tile_rect_t;
+
+static tile_rect_t region_rect(int32_t width, int32_t height, int32_t rx,
+                               int32_t ry) {
+  tile_rect_t rect = {rx * CIV_MAP_REGION_SIZE, ry * CIV_MAP_REGION_SIZE, 0, 0};
+  rect.w = MIN(CIV_MAP_REGION_SIZE, width - rect.x0);
+  rect.h = MIN(CIV_MAP_REGION_SIZE, height - rect.y0);
+  return rect;
+}
+
+/* remap, when given, translates saved owner indices to session ones */
+static bool load_tile_column(civ_save_reader_t *r, civ_map_t *map,
+                             const tile_column_t *c, tile_row_buffer_t *rb,
+                             tile_rect_t rect, const civ_owner_index_t *remap,
+                             uint32_t remap_count) {
+  int bytes = column_bytes(c->kind);
+  size_t row_size = (size_t)rect.w * bytes;
+  for (int32_t y = rect.y0; y < rect.y0 + rect.h; y++) {
+    if (civ_save_reader_read(r, rb->bytes, row_size) != row_size)
+      return false;
+    decode_row(rb->vals, rb->bytes, rect.w, bytes);
+    if (remap && c->kind == COL_OWNER)
+      for (int32_t x = 0; x < rect.w; x++)
+        rb->vals[x] = rb->vals[x] < remap_count ? remap[rb->vals[x]]
+                                                : CIV_OWNER_NONE;
+    civ_map_tile_t *row = &map->tiles[(size_t)y * map->width + rect.x0];
+    for (int32_t x = 0; x < rect.w; x++)
+      column_set(c, &row[x], rb->vals[x]);
+  }
+  return true;
+}
+
+static void fill_save_header(const civ_game_t *game, civ_save_header_t *out) {
+  memset(out, 0, sizeof(*out));
+  out->magic = CIV_SAVE_MAGIC;
+  out->version = CIV_SAVE_VERSION;
+  out->config = game->config;
+  out->map_width = game->world_map ? game->world_map->width : 0;
+  out->map_height = game->world_map ? game->world_map->height : 0;
+  out->map_seed = game->world_map ? game->world_map->seed : 0;
+  out->sea_level = game->world_map ? game->world_map->sea_level : 0.0f;
   /* v2 metadata */
-  header.turn = game->current_turn;
-  header.timestamp = (uint64_t)time(NULL);
-  snprintf(header.faction_id, sizeof(header.faction_id), "%s",
+  out->turn = game->current_turn;
+  out->timestamp = (uint64_t)time(NULL);
+  snprintf(out->faction_id, sizeof(out->faction_id), "%s",
            game->faction_id[0] ? game->faction_id : "none");
-  snprintf(header.profile_name, sizeof(header.profile_name), "%s",
+  snprintf(out->profile_name, sizeof(out->profile_name), "%s",
            game->current_profile ? game->current_profile->name : "unknown");
-  snprintf(header.save_label, sizeof(header.save_label), "Turn %d",
+  snprintf(out->save_label, sizeof(out->save_label), "Turn %d",
            game->current_turn);
   if (game->settlement_manager)
-    header.settlement_count = (uint32_t)game->settlement_manager->settlement_count;
+    out->settlement_count = (uint32_t)game->settlement_manager->settlement_count;
   if (game->settlement_manager) {
     for (size_t i = 0; i < game->settlement_manager->settlement_count; i++)
-      header.total_population +=
+      out->total_population +=
           game->settlement_manager->settlements[i].population;
   }
   /* v3: time engine state */
   if (game->time_engine) {
     civ_time_engine_t *te = (civ_time_engine_t *)game->time_engine;
-    header.global_year = te->global.global_year;
-    header.global_day = te->global.global_day;
-    header.turn_number = te->global.turn_number;
+    out->global_year = te->global.global_year;
+    out->global_day = te->global.global_day;
+    out->turn_number = te->global.turn_number;
   }
   /* v3: player character */
   if (game->player_character) {
     civ_character_t *pc = (civ_character_t *)game->player_character;
-    header.char_bg = (int32_t)pc->background;
-    header.char_wealth = pc->personal_wealth;
-    header.char_reputation = pc->reputation;
-    header.char_influence = pc->political_influence;
-    memcpy(header.char_skills, pc->skills, sizeof(pc->skills));
+    out->char_bg = (int32_t)pc->background;
+    out->char_wealth = pc->personal_wealth;
+    out->char_reputation = pc->reputation;
+    out->char_influence = pc->political_influence;
+    memcpy(out->char_skills, pc->skills, sizeof(pc->skills));
   }
   /* Player nation index */
   if (game->nation_manager)
-    header.player_nation_idx =
+    out->player_nation_idx =
         ((civ_nation_manager_t *)game->nation_manager)->player_nation_index;
   else
-    header.player_nation_idx = -1;
-
-  // 2. Serialize Map Data (Tiles)
-  size_t map_size = 0;
-  void *map_data = NULL;
-  if (game->world_map) {
-    map_size = header.map_width * header.map_height * sizeof(civ_map_tile_t);
-    map_data = game->world_map->tiles;
-  }
-
-  // 3. Combine into one buffer
-  size_t total_size = sizeof(header) + map_size;
-  uint8_t *buffer = (uint8_t *)CIV_MALLOC(total_size);
-  if (!buffer)
-    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Buffer allocation failed"};
-
-  memcpy(buffer, &header, sizeof(header));
-  if (map_data) {
-    memcpy(buffer + sizeof(header), map_data, map_size);
-  }
+    out->player_nation_idx = -1;
+}
 
-  // 4. Save directly — ensure directory exists
-  /* Extract directory from filename and create it */
+/* Create the directories leading to filename */
+static void ensure_save_directory(const char *filename) {
   char dir[512];
   snprintf(dir, sizeof(dir), "%s", filename);
   char *slash = strrchr(dir, '/');
@@ -1128,78 +1699,736 @@ civ_result_t civ_game_save_state(civ_game_t *game, const char *filename) {
   for (char *p = dir; *p; p++) {
     if (*p == '/') { *p = '\0'; SDL_CreateDirectory(dir); *p = '/'; }
   }
-  civ_result_t res = {CIV_OK, "Saved"};
-  FILE *sf = fopen(filename, "wb");
-  if (!sf) {
-    res = (civ_result_t){CIV_ERROR_IO, "Cannot open save file"};
-  } else {
-    size_t written = fwrite(buffer, 1, total_size, sf);
-    fclose(sf);
-    if (written != total_size)
-      res = (civ_result_t){CIV_ERROR_IO, "Write incomplete"};
+}
+
+/* False, with out unusable, when the path does not fit */
+static bool delta_path(char *out, size_t size, const char *base, int seq) {
+  int n = snprintf(out, size, "%s.d%d", base, seq);
+  return n >= 0 && (size_t)n < size;
+}
+
+/* The base and every delta path next to it fit the 512-byte path buffers */
+static bool save_path_fits(const char *base) {
+  char probe[512];
+  return delta_path(probe, sizeof(probe), base, CIV_AUTOSAVE_MAX_DELTAS);
+}
+
+/* A new base orphans the deltas of the old one */
+static void remove_deltas(const char *base) {
+  char path[512];
+  for (int seq = 1; seq <= CIV_AUTOSAVE_MAX_DELTAS; seq++) {
+    if (!delta_path(path, sizeof(path), base, seq) || remove(path) != 0)
+      break;
   }
-  CIV_FREE(buffer);
-  return res;
 }
 
-civ_result_t civ_game_load_state(civ_game_t *game, const char *filename) {
-  if (!game || !game->persistence)
-    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT,
-                          "Invalid game or persistence"};
+static uint64_t new_chain_id(const civ_map_t *map) {
+  uint64_t id = ((uint64_t)time(NULL) << 32) ^ SDL_GetTicksNS();
+  return (id ^ (map ? map->serial : 0)) | 1u; /* 0 = no chain */
+}
 
-  // 1. Load directly from file (don't use persistence layer)
-  FILE *lf = fopen(filename, "rb");
-  if (!lf) {
-    return (civ_result_t){CIV_ERROR_NOT_FOUND, "Save file not found"};
+/* ── Subsystem sections ─────────────────────────────────────────────
+   Everything beyond the map goes through civ_serializable_t, one tagged,
+   versioned section per subsystem. Lazy sections are not read at load;
+   the file holding them is remembered and the table of contents finds
+   them when their accessor is first called. */
+
+#define SAVE_TAG_ECONOMY     CIV_SAVE_TAG('E', 'C', 'O', 'N')
+#define SAVE_TAG_NATIONS     CIV_SAVE_TAG('N', 'A', 'T', 'N')
+#define SAVE_TAG_GOVERNMENT  CIV_SAVE_TAG('G', 'O', 'V', 'T')
+#define SAVE_TAG_DIPLOMACY   CIV_SAVE_TAG('D', 'I', 'P', 'L')
+#define SAVE_TAG_SETTLEMENTS CIV_SAVE_TAG('S', 'E', 'T', 'L')
+#define SAVE_TAG_UNITS       CIV_SAVE_TAG('U', 'N', 'I', 'T')
+#define SAVE_TAG_NPCS        CIV_SAVE_TAG('N', 'P', 'C', 'S')
+#define SAVE_TAG_NAMING      CIV_SAVE_TAG('N', 'A', 'M', 'E')
+#define ECONOMY_SAVE_VERSION 1
+
+/* Global aggregates and the player wallet */
+static void economy_put(const civ_game_t *game, civ_ser_cursor_t *c) {
+  CIV_SER_PUT(c, game->global_economy);
+  CIV_SER_PUT(c, game->wallet);
+}
+
+static civ_result_t economy_serialize(const void *object, char *buffer,
+                                      size_t buffer_size, size_t *written) {
+  civ_ser_cursor_t c = civ_ser_cursor(buffer, buffer_size);
+  economy_put((const civ_game_t *)object, &c);
+  if (written) *written = c.pos;
+  return c.overflow ? error_result(CIV_ERROR_INVALID_ARGUMENT, "Buffer too small")
+                    : ok_result();
+}
+
+static size_t economy_serialized_size(const void *object) {
+  civ_ser_cursor_t c = civ_ser_cursor(NULL, 0);
+  economy_put((const civ_game_t *)object, &c);
+  return c.pos;
+}
+
+static civ_result_t economy_deserialize(void *object, const char *buffer,
+                                        size_t buffer_size) {
+  civ_game_t *game = (civ_game_t *)object;
+  civ_ser_cursor_t c = civ_ser_cursor((void *)buffer, buffer_size);
+  civ_nation_economy_t global;
+  civ_wallet_t wallet;
+  if (!CIV_SER_GET(&c, global) || !CIV_SER_GET(&c, wallet) ||
+      wallet.count < 0 || wallet.count > CIV_WALLET_SLOTS)
+    return error_result(CIV_ERROR_INVALID_DATA, "Economy section size");
+  game->global_economy = global;
+  game->wallet = wallet;
+  return ok_result();
+}
+
+static bool bind_economy(civ_game_t *game, civ_serializable_t *out) {
+  *out = (civ_serializable_t){game, economy_serialize, economy_deserialize,
+                              economy_serialized_size};
+  return true;
+}
+
+static bool bind_nations(civ_game_t *game, civ_serializable_t *out) {
+  if (!game->nation_manager) return false;
+  *out = civ_nation_manager_serializable(
+      (civ_nation_manager_t *)game->nation_manager);
+  return true;
+}
+
+static bool bind_government(civ_game_t *game, civ_serializable_t *out) {
+  if (!game->government) return false;
+  *out = civ_government_serializable(game->government);
+  return true;
+}
+
+static bool bind_diplomacy(civ_game_t *game, civ_serializable_t *out) {
+  if (!game->diplomacy_system) return false;
+  *out = civ_diplomacy_system_serializable(game->diplomacy_system);
+  return true;
+}
+
+static bool bind_settlements(civ_game_t *game, civ_serializable_t *out) {
+  if (!game->settlement_manager) return false;
+  *out = civ_settlement_manager_serializable(game->settlement_manager);
+  return true;
+}
+
+static bool bind_units(civ_game_t *game, civ_serializable_t *out) {
+  if (!game->unit_manager) return false;
+  *out = civ_unit_manager_serializable(game->unit_manager);
+  return true;
+}
+
+static bool bind_naming(civ_game_t *game, civ_serializable_t *out) {
+  if (!game->naming) return false;
+  *out = civ_naming_serializable(game->naming);
+  return true;
+}
+
+static bool bind_npcs(civ_game_t *game, civ_serializable_t *out) {
+  if (!game->npc_engine) return false;
+  *out = civ_npc_engine_serializable((civ_npc_engine_t *)game->npc_engine);
+  return true;
+}
+
+typedef struct {
+  uint32_t tag;
+  uint32_t version;   /* written; loading takes this version or older */
+  bool     lazy;
+  bool   (*bind)(civ_game_t *game, civ_serializable_t *out);
+} game_section_t;
+
+static const game_section_t game_sections[] = {
+    {SAVE_TAG_ECONOMY, ECONOMY_SAVE_VERSION, false, bind_economy},
+    {SAVE_TAG_NATIONS, CIV_NATION_SAVE_VERSION, false, bind_nations},
+    {SAVE_TAG_GOVERNMENT, CIV_GOVERNMENT_SAVE_VERSION, false, bind_government},
+    {SAVE_TAG_DIPLOMACY, CIV_DIPLOMACY_SAVE_VERSION, false, bind_diplomacy},
+    {SAVE_TAG_SETTLEMENTS, CIV_SETTLEMENT_SAVE_VERSION, false, bind_settlements},
+    {SAVE_TAG_UNITS, CIV_UNIT_SAVE_VERSION, false, bind_units},
+    /* After the settlements, whose loading re-reserves their names */
+    {SAVE_TAG_NAMING, CIV_NAMING_SAVE_VERSION, false, bind_naming},
+    {SAVE_TAG_NPCS, CIV_NPC_SAVE_VERSION, true, bind_npcs},
+};
+
+/* Read one section from an open file into its subsystem */
+static bool read_game_section(civ_game_t *game, civ_save_reader_t *r,
+                              const game_section_t *gs) {
+  civ_serializable_t ser;
+  if (!gs->bind(game, &ser) || !civ_save_reader_find_section(r, gs->tag))
+    return false;
+  if (civ_save_reader_section_version(r) > gs->version) {
+    printf("[GAME] Save section %.4s is from a newer version; skipped\n",
+           (const char *)&gs->tag);
+    return false;
+  }
+  size_t size = 0;
+  uint8_t *data = civ_save_reader_read_all(r, &size);
+  civ_result_t res =
+      data ? ser.deserialize(ser.object, (const char *)data, size)
+           : error_result(CIV_ERROR_INVALID_DATA, "Section damaged");
+  CIV_FREE(data);
+  if (res.error != CIV_OK)
+    printf("[GAME] Save section %.4s not restored: %s\n",
+           (const char *)&gs->tag, res.message ? res.message : "");
+  return res.error == CIV_OK;
+}
+
+/* Restore every section from the newest of paths (newest last) holding
+   it; lazy ones are only located */
+static void load_game_sections(civ_game_t *game, char (*paths)[512],
+                               int path_count) {
+  civ_save_reader_t *readers[CIV_AUTOSAVE_MAX_DELTAS + 1] = {NULL};
+  game->deferred_count = 0;
+  for (size_t s = 0; s < ARRAY_SIZE(game_sections); s++) {
+    const game_section_t *gs = &game_sections[s];
+    for (int p = path_count - 1; p >= 0; p--) {
+      if (!readers[p]) readers[p] = civ_save_reader_open(paths[p]);
+      if (!readers[p]) continue;
+      if (gs->lazy) {
+        if (!civ_save_reader_find_section(readers[p], gs->tag)) continue;
+        if (game->deferred_count < CIV_GAME_DEFERRED_MAX) {
+          civ_deferred_section_t *d = &game->deferred[game->deferred_count++];
+          d->tag = gs->tag;
+          snprintf(d->path, sizeof(d->path), "%s", paths[p]);
+        }
+        break;
+      }
+      if (read_game_section(game, readers[p], gs)) break;
+    }
   }
-  fseek(lf, 0, SEEK_END);
-  long file_size = ftell(lf);
-  fseek(lf, 0, SEEK_SET);
-  if (file_size <= 0) { fclose(lf); return (civ_result_t){CIV_ERROR_INVALID_DATA, "Empty file"}; }
+  for (int p = 0; p < path_count; p++) civ_save_reader_close(readers[p]);
+}
 
-  size_t buffer_cap = (size_t)file_size + 4096;
-  uint8_t *buffer = (uint8_t *)CIV_MALLOC(buffer_cap);
-  if (!buffer) { fclose(lf); return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Buffer alloc"}; }
+/* Read a deferred section now, if one is pending for tag */
+static void load_deferred_section(civ_game_t *game, uint32_t tag) {
+  for (int i = 0; i < game->deferred_count; i++) {
+    civ_deferred_section_t d = game->deferred[i];
+    if (d.tag != tag) continue;
+    game->deferred[i] = game->deferred[--game->deferred_count];
+    for (size_t s = 0; s < ARRAY_SIZE(game_sections); s++) {
+      if (game_sections[s].tag != tag) continue;
+      civ_save_reader_t *r = civ_save_reader_open(d.path);
+      if (r) read_game_section(game, r, &game_sections[s]);
+      civ_save_reader_close(r);
+    }
+    return;
+  }
+}
 
-  size_t data_size = (size_t)file_size;
-  if (fread(buffer, 1, data_size, lf) != data_size) {
-    fclose(lf); CIV_FREE(buffer);
-    return (civ_result_t){CIV_ERROR_IO, "Read failed"};
+void *civ_game_npcs(civ_game_t *game) {
+  if (!game) return NULL;
+  if (game->deferred_count) load_deferred_section(game, SAVE_TAG_NPCS);
+  return game->npc_engine;
+}
+
+/* A serialized section held by a snapshot */
+typedef struct {
+  uint32_t tag, version;
+  uint8_t *data;
+  size_t   size;
+} save_blob_t;
+
+/* Everything one save file holds, copied off the live game so the save
+   worker can write it while the simulation moves on. Tiles are copied per
+   revision region, and a delta copies only the regions it writes. */
+typedef struct {
+  char              path[512];      /* the file itself, base or delta */
+  bool              compress;
+  civ_save_header_t header;
+  uint64_t          chain_id;
+  int32_t           seq;            /* 0 = base, else delta number */
+  int32_t           width, height;
+  int32_t           region_cols, region_rows;
+  saved_tile_t    **regions;        /* row-major; NULL = not in this file */
+  size_t            region_count;   /* regions present */
+  uint32_t          owner_count;
+  char            (*owner_names)[STRING_SHORT_LEN];
+  save_blob_t       blobs[ARRAY_SIZE(game_sections)];
+  size_t            blob_count;
+  /* Save browser entry, when path is one of the profile's slots */
+  char              profile_id[CIV_PROFILE_ID_MAX];
+  civ_save_slot_info_t *slot_info;
+} save_snapshot_t;
+
+static void snapshot_free(void *job) {
+  save_snapshot_t *s = (save_snapshot_t *)job;
+  if (!s) return;
+  if (s->regions)
+    for (size_t r = 0; r < (size_t)s->region_cols * s->region_rows; r++)
+      CIV_FREE(s->regions[r]);
+  CIV_FREE(s->regions);
+  CIV_FREE(s->owner_names);
+  for (size_t b = 0; b < s->blob_count; b++) CIV_FREE(s->blobs[b].data);
+  CIV_FREE(s->slot_info);
+  CIV_FREE(s);
+}
+
+/* Political map view colours, averaged over 2x2 tile samples per texel */
+static uint32_t thumbnail_tile_color(const civ_map_tile_t *t) {
+  if (t->land_use == CIV_LAND_USE_WATER) return 0xFF0B2C4D;
+  return t->political_color ? (t->political_color | 0xFF000000) : 0xFF3A3A3A;
+}
+
+static void build_thumbnail(const civ_map_t *map, uint32_t *out) {
+  for (int ty = 0; ty < CIV_SAVE_THUMB_H; ty++) {
+    for (int tx = 0; tx < CIV_SAVE_THUMB_W; tx++) {
+      uint32_t sum[3] = {0, 0, 0};
+      for (int k = 0; k < 4; k++) {
+        int32_t x = (int32_t)(((int64_t)tx * 2 + (k & 1)) * map->width /
+                              (CIV_SAVE_THUMB_W * 2));
+        int32_t y = (int32_t)(((int64_t)ty * 2 + (k >> 1)) * map->height /
+                              (CIV_SAVE_THUMB_H * 2));
+        uint32_t c = thumbnail_tile_color(&map->tiles[(size_t)y * map->width + x]);
+        sum[0] += (c >> 16) & 0xFF;
+        sum[1] += (c >> 8) & 0xFF;
+        sum[2] += c & 0xFF;
+      }
+      out[ty * CIV_SAVE_THUMB_W + tx] =
+          0xFF000000 | (sum[0] / 4) << 16 | (sum[1] / 4) << 8 | sum[2] / 4;
+    }
   }
-  fclose(lf);
+}
 
-  // 2. Parse Header
-  if (data_size < sizeof(civ_save_header_t)) {
-    CIV_FREE(buffer);
-    return (civ_result_t){CIV_ERROR_INVALID_DATA, "File too small"};
+/* The save browser entry for a save into one of the profile's slots */
+static civ_save_slot_info_t *take_slot_info(const civ_game_t *game,
+                                            const char *path,
+                                            const civ_save_header_t *h) {
+  char slot[64];
+  if (!game->current_profile ||
+      !civ_profile_slot_from_path(game->current_profile->id, path, slot,
+                                  sizeof(slot)))
+    return NULL;
+  civ_save_slot_info_t *info =
+      (civ_save_slot_info_t *)CIV_CALLOC(1, sizeof(civ_save_slot_info_t));
+  if (!info) return NULL;
+  snprintf(info->slot, sizeof(info->slot), "%s", slot);
+  snprintf(info->profile_name, sizeof(info->profile_name), "%s", h->profile_name);
+  snprintf(info->save_label, sizeof(info->save_label), "%s", h->save_label);
+  snprintf(info->faction_id, sizeof(info->faction_id), "%s", h->faction_id);
+  info->timestamp = h->timestamp;
+  info->turn = h->turn;
+  info->global_year = h->global_year;
+  info->settlement_count = h->settlement_count;
+  info->total_population = h->total_population;
+  const civ_map_t *map = game->world_map;
+  if (map && map->tiles && map->width > 0 && map->height > 0)
+    build_thumbnail(map, info->thumbnail);
+  return info;
+}
+
+/* Copy the game for one file. since, when given, holds the region
+   revisions already on disk, and only regions that moved are copied. */
+static save_snapshot_t *snapshot_take(civ_game_t *game,
+                                      const char *path, uint64_t chain_id,
+                                      int32_t seq, const uint32_t *since) {
+  save_snapshot_t *s = (save_snapshot_t *)CIV_CALLOC(1, sizeof(*s));
+  if (!s) return NULL;
+  if (seq == 0)
+    snprintf(s->path, sizeof(s->path), "%s", path);
+  else if (!delta_path(s->path, sizeof(s->path), path, seq))
+    goto fail;
+  s->compress = game->persistence->compression_enabled;
+  fill_save_header(game, &s->header);
+  s->chain_id = chain_id;
+  s->seq = seq;
+  s->slot_info = take_slot_info(game, path, &s->header);
+  if (s->slot_info)
+    snprintf(s->profile_id, sizeof(s->profile_id), "%s",
+             game->current_profile->id);
+
+  s->owner_count = civ_owner_count();
+  s->owner_names = CIV_CALLOC(s->owner_count ? s->owner_count : 1,
+                              sizeof(*s->owner_names));
+  if (!s->owner_names) goto fail;
+  for (uint32_t o = 1; o < s->owner_count; o++)
+    snprintf(s->owner_names[o], sizeof(s->owner_names[o]), "%s",
+             civ_owner_name((civ_owner_index_t)o));
+
+  /* Deferred sections come in first, or the save would drop them */
+  while (game->deferred_count)
+    load_deferred_section(game, game->deferred[0].tag);
+  for (size_t g = 0; g < ARRAY_SIZE(game_sections); g++) {
+    civ_serializable_t ser;
+    if (!game_sections[g].bind(game, &ser)) continue;
+    save_blob_t *b = &s->blobs[s->blob_count];
+    b->tag = game_sections[g].tag;
+    b->version = game_sections[g].version;
+    b->size = ser.get_serialized_size(ser.object);
+    b->data = (uint8_t *)CIV_MALLOC(b->size ? b->size : 1);
+    if (!b->data) goto fail;
+    s->blob_count++;
+    if (ser.serialize(ser.object, (char *)b->data, b->size, NULL).error != CIV_OK)
+      goto fail;
+  }
+
+  const civ_map_t *map = game->world_map;
+  if (!map || !map->tiles) return s;
+  s->width = map->width;
+  s->height = map->height;
+  s->region_cols = (map->width + CIV_MAP_REGION_SIZE - 1) >> CIV_MAP_REGION_SHIFT;
+  s->region_rows = (map->height + CIV_MAP_REGION_SIZE - 1) >> CIV_MAP_REGION_SHIFT;
+  s->regions = (saved_tile_t **)CIV_CALLOC(
+      (size_t)s->region_cols * s->region_rows, sizeof(saved_tile_t *));
+  if (!s->regions) goto fail;
+
+  for (int32_t ry = 0; ry < s->region_rows; ry++) {
+    for (int32_t rx = 0; rx < s->region_cols; rx++) {
+      size_t r = (size_t)ry * s->region_cols + rx;
+      if (since && map->region_revision[r] == since[r]) continue;
+      tile_rect_t rect = region_rect(s->width, s->height, rx, ry);
+      saved_tile_t *out = (saved_tile_t *)CIV_MALLOC(
+          (size_t)rect.w * rect.h * sizeof(saved_tile_t));
+      if (!out) goto fail;
+      for (int32_t y = 0; y < rect.h; y++) {
+        const civ_map_tile_t *row =
+            &map->tiles[(size_t)(rect.y0 + y) * map->width + rect.x0];
+        for (int32_t x = 0; x < rect.w; x++)
+          pack_tile(&out[(size_t)y * rect.w + x], &row[x]);
+      }
+      s->regions[r] = out;
+      s->region_count++;
+    }
   }
+  return s;
 
-  civ_save_header_t *header = (civ_save_header_t *)buffer;
-  if (header->magic != CIV_SAVE_MAGIC) {
-    CIV_FREE(buffer);
-    return (civ_result_t){CIV_ERROR_INVALID_DATA, "Invalid file format"};
+fail:
+  snapshot_free(s);
+  return NULL;
+}
+
+/* One column of rect from the snapshot; rect may span several regions,
+   all of which must be present */
+static void write_tile_column(civ_save_writer_t *w, const save_snapshot_t *s,
+                              const tile_column_t *c, tile_row_buffer_t *rb,
+                              tile_rect_t rect) {
+  int bytes = column_bytes(c->kind);
+  for (int32_t y = rect.y0; y < rect.y0 + rect.h; y++) {
+    int32_t ry = y >> CIV_MAP_REGION_SHIFT;
+    for (int32_t x = rect.x0; x < rect.x0 + rect.w;) {
+      int32_t rx = x >> CIV_MAP_REGION_SHIFT;
+      tile_rect_t reg = region_rect(s->width, s->height, rx, ry);
+      const saved_tile_t *row = s->regions[(size_t)ry * s->region_cols + rx] +
+                                (size_t)(y - reg.y0) * reg.w - reg.x0;
+      int32_t end = MIN(reg.x0 + reg.w, rect.x0 + rect.w);
+      for (; x < end; x++)
+        rb->vals[x - rect.x0] = saved_value(c, &row[x]);
+    }
+    encode_row(rb->bytes, rb->vals, rect.w, bytes);
+    civ_save_writer_write(w, rb->bytes, (size_t)rect.w * bytes);
   }
+}
 
-  // 3. Restore Config
-  game->config = header->config;
+/* Subsystem sections; every file carries them, and the newest wins */
+static void write_blob_sections(civ_save_writer_t *w, const save_snapshot_t *s) {
+  for (size_t b = 0; b < s->blob_count; b++) {
+    civ_save_writer_begin_section_v(w, s->blobs[b].tag, s->blobs[b].version);
+    civ_save_writer_write(w, s->blobs[b].data, s->blobs[b].size);
+    civ_save_writer_end_section(w);
+  }
+}
 
-  // 4. Restore Map
-  if (header->map_width > 0 && header->map_height > 0) {
-    if (game->world_map)
-      civ_map_destroy(game->world_map);
-
-    game->world_map =
-        civ_map_create(header->map_width, header->map_height, header->map_seed);
-    if (game->world_map) {
-      game->world_map->sea_level = header->sea_level;
-      size_t map_byte_size =
-          header->map_width * header->map_height * sizeof(civ_map_tile_t);
-      if (sizeof(civ_save_header_t) + map_byte_size <= data_size) {
-        memcpy(game->world_map->tiles, buffer + sizeof(civ_save_header_t),
-               map_byte_size);
+static void write_owner_section(civ_save_writer_t *w, const save_snapshot_t *s) {
+  civ_save_writer_begin_section(w, SAVE_TAG_OWNERS);
+  civ_save_writer_write(w, &s->owner_count, sizeof(s->owner_count));
+  if (s->owner_count)
+    civ_save_writer_write(w, s->owner_names,
+                          (size_t)s->owner_count * sizeof(*s->owner_names));
+  civ_save_writer_end_section(w);
+}
+
+/* Write a snapshot beside its path and rename it into place, so a crash
+   mid-write leaves the previous file intact. A base holds the header, chain
+   id, the subsystem sections, every tile column and the owner table; a
+   delta holds the header, chain id and sequence, the owner table, the
+   subsystem sections, then each region it copied with all columns. Runs on the save worker (or inline when there is none). */
+static civ_result_t snapshot_write(void *job, civ_save_worker_t *worker) {
+  save_snapshot_t *s = (save_snapshot_t *)job;
+  char tmp[520];
+  snprintf(tmp, sizeof(tmp), "%s.tmp", s->path);
+
+  tile_row_buffer_t rb = {NULL, NULL};
+  if (s->regions && !row_buffer_init(&rb, s->width)) {
+    row_buffer_free(&rb);
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Buffer allocation failed"};
+  }
+  ensure_save_directory(s->path);
+  civ_save_writer_t *w = civ_save_writer_open(tmp, s->compress);
+  if (!w) {
+    row_buffer_free(&rb);
+    return (civ_result_t){CIV_ERROR_IO, "Cannot open save file"};
+  }
+
+  civ_save_writer_begin_section(w, SAVE_TAG_HEADER);
+  civ_save_writer_write(w, &s->header, sizeof(s->header));
+  if (s->seq == 0) {
+    civ_save_writer_begin_section(w, SAVE_TAG_CHAIN);
+    civ_save_writer_write(w, &s->chain_id, sizeof(s->chain_id));
+    civ_save_writer_end_section(w);
+    write_blob_sections(w, s);
+
+    uint32_t total = s->regions ? (uint32_t)ARRAY_SIZE(tile_columns) : 0;
+    tile_rect_t all = {0, 0, s->width, s->height};
+    for (uint32_t c = 0; c < total; c++) {
+      civ_save_writer_begin_section(w, tile_columns[c].tag);
+      write_tile_column(w, s, &tile_columns[c], &rb, all);
+      civ_save_writer_end_section(w);
+      civ_save_worker_set_progress(worker, c + 1, total);
+    }
+    /* Owner id table, so tile owner indices survive a new session */
+    write_owner_section(w, s);
+  } else {
+    uint64_t link[2] = {s->chain_id, (uint64_t)s->seq};
+    civ_save_writer_begin_section(w, SAVE_TAG_DELTA);
+    civ_save_writer_write(w, link, sizeof(link));
+    write_owner_section(w, s);
+    write_blob_sections(w, s);
+
+    uint32_t done = 0;
+    for (int32_t ry = 0; ry < s->region_rows; ry++) {
+      for (int32_t rx = 0; rx < s->region_cols; rx++) {
+        if (!s->regions[(size_t)ry * s->region_cols + rx]) continue;
+        int32_t at[2] = {rx, ry};
+        civ_save_writer_begin_section(w, SAVE_TAG_REGION);
+        civ_save_writer_write(w, at, sizeof(at));
+        for (size_t c = 0; c < ARRAY_SIZE(tile_columns); c++)
+          write_tile_column(w, s, &tile_columns[c], &rb,
+                            region_rect(s->width, s->height, rx, ry));
+        civ_save_worker_set_progress(worker, ++done, (uint32_t)s->region_count);
       }
     }
   }
+  row_buffer_free(&rb);
+
+  civ_result_t res = civ_save_writer_close(w);
+  if (res.error == CIV_OK && !SDL_RenamePath(tmp, s->path))
+    res = (civ_result_t){CIV_ERROR_IO, "Cannot replace save file"};
+  if (res.error != CIV_OK) {
+    remove(tmp);
+    return res;
+  }
+  if (s->seq == 0) remove_deltas(s->path);
+  if (s->slot_info && !civ_profile_update_save_index(s->profile_id, s->slot_info))
+    printf("[GAME] Save index not updated for %s\n", s->slot_info->slot);
+  res.message = "Saved";
+  return res;
+}
+
+civ_result_t civ_game_save_state(civ_game_t *game, const char *filename) {
+  if (!game || !game->persistence || !filename)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT,
+                          "Invalid game or persistence"};
+  if (!save_path_fits(filename))
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Save path too long"};
+  /* An autosave in flight may be writing the same file */
+  civ_save_worker_wait(game->save_worker);
+  CIV_MEM_TAG_BEGIN(prev_tag, CIV_MEM_TAG_SAVE);
+  save_snapshot_t *s =
+      snapshot_take(game, filename, new_chain_id(game->world_map), 0, NULL);
+  CIV_MEM_TAG_END(prev_tag);
+  if (!s)
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Snapshot allocation failed"};
+  civ_result_t res = snapshot_write(s, NULL);
+  snapshot_free(s);
+  return res;
+}
+
+/* Remember the map's region revisions as the state the files now hold */
+static void snapshot_autosave(civ_game_t *game, uint64_t chain_id) {
+  civ_autosave_state_t *as = &game->autosave;
+  const civ_map_t *map = game->world_map;
+  size_t n = map && map->region_revision
+                 ? (size_t)map->region_cols * map->region_rows : 0;
+  if (n > as->region_count) {
+    uint32_t *rev =
+        (uint32_t *)CIV_REALLOC(as->region_revision, n * sizeof(uint32_t));
+    if (!rev) {
+      as->chain_id = 0; /* next autosave writes a base */
+      return;
+    }
+    as->region_revision = rev;
+  }
+  if (n) memcpy(as->region_revision, map->region_revision, n * sizeof(uint32_t));
+  as->region_count = n;
+  as->map_serial = map ? map->serial : 0;
+  as->chain_id = chain_id;
+}
+
+civ_result_t civ_game_autosave(civ_game_t *game, const char *filename) {
+  if (!game || !game->persistence || !filename)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT,
+                          "Invalid game or persistence"};
+  if (!save_path_fits(filename))
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Save path too long"};
+  civ_autosave_state_t *as = &game->autosave;
+  const civ_map_t *map = game->world_map;
+
+  /* The chain state below was advanced when the last save was handed
+     off; if that write failed, the files are behind it, so start over */
+  civ_result_t last;
+  if (civ_save_worker_take_result(game->save_worker, &last) &&
+      last.error != CIV_OK)
+    as->chain_id = 0;
+  /* Never wait on the disk: skip this one, and the regions it would have
+     written stay dirty for the next */
+  if (civ_save_worker_busy(game->save_worker))
+    return (civ_result_t){CIV_ERROR_INVALID_STATE, "Autosave still writing"};
+
+  /* Compact into a new base when there is no chain for this map and file,
+     the chain is at its length limit, or replaying it would read more
+     regions than a base holds */
+  bool base = !as->chain_id || !map || !map->region_revision ||
+              as->map_serial != map->serial ||
+              as->region_count != (size_t)map->region_cols * map->region_rows ||
+              strcmp(as->path, filename) != 0 ||
+              as->delta_count >= CIV_AUTOSAVE_MAX_DELTAS ||
+              as->delta_regions >= as->region_count;
+  uint64_t chain_id = base ? new_chain_id(map) : as->chain_id;
+  CIV_MEM_TAG_BEGIN(prev_tag, CIV_MEM_TAG_SAVE);
+  save_snapshot_t *s =
+      base ? snapshot_take(game, filename, chain_id, 0, NULL)
+           : snapshot_take(game, filename, chain_id, as->delta_count + 1,
+                           as->region_revision);
+  CIV_MEM_TAG_END(prev_tag);
+  if (!s)
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Snapshot allocation failed"};
+
+  if (base) {
+    as->delta_count = 0;
+    as->delta_regions = 0;
+    snprintf(as->path, sizeof(as->path), "%s", filename);
+  } else {
+    as->delta_count++;
+    as->delta_regions += s->region_count;
+  }
+  snapshot_autosave(game, chain_id);
+
+  if (civ_save_worker_submit(game->save_worker, snapshot_write, s,
+                             snapshot_free))
+    return (civ_result_t){CIV_OK, "Saving"};
+
+  /* No worker thread: write inline */
+  civ_result_t res = snapshot_write(s, NULL);
+  snapshot_free(s);
+  if (res.error != CIV_OK) as->chain_id = 0;
+  return res;
+}
+
+civ_result_t civ_game_save_keyframe(civ_game_t *game, const char *filename) {
+  if (!game || !game->persistence || !filename)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT,
+                          "Invalid game or persistence"};
+  if (!save_path_fits(filename))
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Save path too long"};
+  CIV_MEM_TAG_BEGIN(prev_tag, CIV_MEM_TAG_SAVE);
+  save_snapshot_t *s =
+      snapshot_take(game, filename, new_chain_id(game->world_map), 0, NULL);
+  CIV_MEM_TAG_END(prev_tag);
+  if (!s)
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Snapshot allocation failed"};
+  s->compress = true; /* a session keeps dozens of these */
+
+  if (!civ_save_worker_busy(game->save_worker)) {
+    /* This write's result would hide a failed autosave's; act on it now */
+    civ_result_t last;
+    if (civ_save_worker_take_result(game->save_worker, &last) &&
+        last.error != CIV_OK)
+      game->autosave.chain_id = 0;
+    if (civ_save_worker_submit(game->save_worker, snapshot_write, s,
+                               snapshot_free))
+      return (civ_result_t){CIV_OK, "Saving"};
+  }
+
+  /* An autosave still writing, or no worker thread: write inline */
+  civ_result_t res = snapshot_write(s, NULL);
+  snapshot_free(s);
+  return res;
+}
+
+/* Re-intern a saved owner id table; entry i is the session index of saved
+   index i. NULL (and count 0) for an empty or malformed table. */
+static civ_owner_index_t *owner_remap(const uint8_t *data, size_t size,
+                                      uint32_t *count_out) {
+  uint32_t count = 0;
+  if (data && size >= sizeof(count)) memcpy(&count, data, sizeof(count));
+  if (count > 0 && size < sizeof(count) + (size_t)count * STRING_SHORT_LEN)
+    count = 0;
+
+  civ_owner_index_t *remap = NULL;
+  if (count > 0)
+    remap = (civ_owner_index_t *)CIV_CALLOC(count, sizeof(civ_owner_index_t));
+  for (uint32_t o = 1; remap && o < count; o++) {
+    char name[STRING_SHORT_LEN];
+    memcpy(name, data + sizeof(count) + (size_t)o * STRING_SHORT_LEN,
+           STRING_SHORT_LEN);
+    name[STRING_SHORT_LEN - 1] = '\0';
+    remap[o] = civ_owner_intern(name);
+  }
+  *count_out = remap ? count : 0;
+  return remap;
+}
+
+/* Re-intern the saved owner ids and remap tile owner indices onto them */
+static void load_owner_table(civ_map_t *map, size_t tile_count,
+                             const uint8_t *data, size_t size) {
+  uint32_t count = 0;
+  civ_owner_index_t *remap = owner_remap(data, size, &count);
+  for (size_t i = 0; i < tile_count; i++) {
+    civ_map_tile_t *t = &map->tiles[i];
+    t->owner_index = (remap && t->owner_index < count) ? remap[t->owner_index]
+                                                       : CIV_OWNER_NONE;
+  }
+  CIV_FREE(remap);
+}
+
+/* Replace the world map with an empty one sized by header; tiles are
+   filled by the caller before finish_restored_map */
+static void begin_restored_map(civ_game_t *game, const civ_save_header_t *header) {
+  if (header->map_width == 0 || header->map_height == 0) return;
+  civ_trade_manager_set_network(game->trade_manager, NULL);
+  civ_tile_field_destroy(game->tile_field);
+  game->tile_field = NULL;
+  civ_logistics_field_destroy(game->logistics_field, game->world_map);
+  game->logistics_field = NULL;
+  civ_site_field_destroy(game->site_field);
+  game->site_field = NULL;
+  civ_influence_map_destroy(game->influence_map);
+  game->influence_map = NULL;
+  civ_trade_network_destroy(game->trade_network);
+  game->trade_network = NULL;
+  civ_ocean_regions_destroy(game->ocean_regions);
+  game->ocean_regions = NULL;
+  civ_path_service_destroy(game->path_service);
+  game->path_service = NULL;
+  civ_pathfinder_destroy(game->pathfinder);
+  game->pathfinder = NULL;
+  if (game->world_map)
+    civ_map_destroy(game->world_map);
+  game->world_map =
+      civ_map_create(header->map_width, header->map_height, header->map_seed);
+  if (game->world_map)
+    game->world_map->sea_level = header->sea_level;
+}
+
+static void finish_restored_map(civ_game_t *game) {
+  if (!game->world_map || game->pathfinder) return;
+  civ_map_enable_planes(game->world_map);
+  game->pathfinder = civ_pathfinder_create(game->world_map, NULL);
+  game->path_service = civ_path_service_create();
+  int land_layer =
+      civ_path_service_add_layer(game->path_service, game->pathfinder);
+  game->ocean_regions = civ_ocean_regions_create(game->world_map, NULL);
+  game->trade_network =
+      civ_trade_network_create(game->world_map, game->pathfinder);
+  civ_trade_network_set_ocean(game->trade_network, game->ocean_regions);
+  civ_trade_network_set_path_service(game->trade_network, game->path_service,
+                                     land_layer);
+  game->influence_map = civ_influence_map_create(game->world_map);
+  game->site_field = civ_site_field_create(game->world_map);
+  game->logistics_field = civ_logistics_field_create(game->world_map);
+  game->tile_field = create_tile_field(game->world_map);
+  civ_trade_manager_set_network(game->trade_manager, game->trade_network);
+}
+
+/* Everything but the map that the header carries */
+static void restore_header_state(civ_game_t *game,
+                                 const civ_save_header_t *header) {
+  game->config = header->config;
 
   /* v3: Restore time engine */
   if (header->version >= 3 && game->time_engine) {
@@ -1219,6 +2448,7 @@ civ_result_t civ_game_load_state(civ_game_t *game, const char *filename) {
   }
   /* Restore turn */
   game->current_turn = header->turn;
+  civ_journal_set_turn(g_journal, game->current_turn);
 
   /* Restore player nation index */
   if (header->player_nation_idx >= 0 && game->nation_manager) {
@@ -1226,11 +2456,301 @@ civ_result_t civ_game_load_state(civ_game_t *game, const char *filename) {
     nm->player_nation_index = header->player_nation_idx;
     printf("[GAME] Restored player nation index: %d\n", header->player_nation_idx);
   }
+  if (game->nation_manager) {
+    civ_nation_manager_index_owners((civ_nation_manager_t *)game->nation_manager);
+    /* Economies and resource profiles follow the restored territory */
+    if (game->world_map)
+      civ_nation_compute_all_economies((civ_nation_manager_t *)game->nation_manager,
+                                       game->world_map, game->resource_map,
+                                       &game->global_economy);
+  }
+}
+
+/* Tile layout of v4 saves, written as a raw array before tile attributes
+   were quantized */
+typedef struct {
+  int32_t x, y;
+  civ_float_t elevation, moisture, temperature;
+  civ_terrain_type_t terrain;
+  civ_land_use_type_t land_use;
+  civ_float_t vegetation_density, fertility, resources;
+  bool has_river, has_resource;
+  civ_float_t political_influence, population_density, cultural_influence;
+  bool is_explored, is_visible;
+  civ_owner_index_t owner_index;
+  uint32_t political_color;
+} legacy_tile_v4_t;
+
+static void load_legacy_tiles(civ_map_t *map, const uint8_t *data,
+                              size_t tile_count) {
+  for (size_t i = 0; i < tile_count; i++) {
+    legacy_tile_v4_t lt;
+    memcpy(&lt, data + i * sizeof(lt), sizeof(lt));
+    civ_map_tile_t *t = &map->tiles[i];
+    civ_map_tile_attrs_t a = {lt.elevation,          lt.moisture,
+                              lt.temperature,        lt.fertility,
+                              lt.vegetation_density, lt.resources,
+                              lt.political_influence, lt.population_density,
+                              lt.cultural_influence};
+    t->x = lt.x;
+    t->y = lt.y;
+    civ_map_tile_encode(t, &a);
+    t->terrain = (uint8_t)lt.terrain;
+    t->land_use = (uint8_t)lt.land_use;
+    t->has_river = lt.has_river;
+    t->has_resource = lt.has_resource;
+    t->is_explored = lt.is_explored;
+    t->is_visible = lt.is_visible;
+    t->owner_index = lt.owner_index;
+    t->political_color = lt.political_color;
+  }
+}
+
+/* Pre-v5 saves: header, raw tile array and owner table in one blob */
+static civ_result_t load_legacy_state(civ_game_t *game, const char *filename) {
+  FILE *lf = fopen(filename, "rb");
+  if (!lf) {
+    return (civ_result_t){CIV_ERROR_NOT_FOUND, "Save file not found"};
+  }
+  fseek(lf, 0, SEEK_END);
+  long file_size = ftell(lf);
+  fseek(lf, 0, SEEK_SET);
+  if (file_size <= 0) { fclose(lf); return (civ_result_t){CIV_ERROR_INVALID_DATA, "Empty file"}; }
+
+  uint8_t *buffer = (uint8_t *)CIV_MALLOC((size_t)file_size);
+  if (!buffer) { fclose(lf); return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Buffer alloc"}; }
+
+  size_t data_size = (size_t)file_size;
+  if (fread(buffer, 1, data_size, lf) != data_size) {
+    fclose(lf); CIV_FREE(buffer);
+    return (civ_result_t){CIV_ERROR_IO, "Read failed"};
+  }
+  fclose(lf);
+
+  if (data_size < sizeof(civ_save_header_t)) {
+    CIV_FREE(buffer);
+    return (civ_result_t){CIV_ERROR_INVALID_DATA, "File too small"};
+  }
+
+  civ_save_header_t *header = (civ_save_header_t *)buffer;
+  if (header->magic != CIV_SAVE_MAGIC) {
+    CIV_FREE(buffer);
+    return (civ_result_t){CIV_ERROR_INVALID_DATA, "Invalid file format"};
+  }
+
+  begin_restored_map(game, header);
+  if (game->world_map && header->map_width > 0 && header->map_height > 0) {
+    size_t tile_count = (size_t)header->map_width * header->map_height;
+    size_t map_byte_size = tile_count * sizeof(legacy_tile_v4_t);
+    if (header->version < 4) {
+      /* Pre-v4 tiles carried owner strings; the layout no longer matches */
+      printf("[GAME] Save v%u predates the current tile layout; map not restored\n",
+             header->version);
+    } else if (sizeof(civ_save_header_t) + map_byte_size <= data_size) {
+      load_legacy_tiles(game->world_map, buffer + sizeof(civ_save_header_t),
+                        tile_count);
+      load_owner_table(game->world_map, tile_count,
+                       buffer + sizeof(civ_save_header_t) + map_byte_size,
+                       data_size - sizeof(civ_save_header_t) - map_byte_size);
+    }
+  }
+  finish_restored_map(game);
+  restore_header_state(game, header);
 
   CIV_FREE(buffer);
   return (civ_result_t){CIV_OK, "Game loaded successfully"};
 }
 
+/* Owner table section: count, then one fixed-width name per index */
+static uint8_t *read_owner_section(civ_save_reader_t *r, size_t *size) {
+  uint32_t count = 0;
+  *size = 0;
+  if (civ_save_reader_read(r, &count, sizeof(count)) != sizeof(count) ||
+      count > (uint32_t)CIV_OWNER_MAX + 1)
+    return NULL;
+  size_t n = sizeof(count) + (size_t)count * STRING_SHORT_LEN;
+  uint8_t *data = (uint8_t *)CIV_MALLOC(n);
+  if (!data) return NULL;
+  memcpy(data, &count, sizeof(count));
+  if (civ_save_reader_read(r, data + sizeof(count), n - sizeof(count)) !=
+      n - sizeof(count)) {
+    CIV_FREE(data);
+    return NULL;
+  }
+  *size = n;
+  return data;
+}
+
+/* Base file: header, tile columns and owner table. The map is left for
+   deltas to update before finish_restored_map. */
+static civ_result_t load_container_state(civ_game_t *game, civ_save_reader_t *r,
+                                         civ_save_header_t *header,
+                                         civ_map_t **map_out,
+                                         uint64_t *chain_id) {
+  bool have_header = false;
+  uint8_t *owners = NULL;
+  size_t owners_size = 0;
+  civ_map_t *map = NULL; /* restored map, once the header made it */
+  tile_row_buffer_t rb = {NULL, NULL};
+  civ_result_t res = {CIV_OK, "Game loaded successfully"};
+  uint32_t tag;
+  *chain_id = 0;
+
+  while (res.error == CIV_OK && civ_save_reader_next_section(r, &tag)) {
+    if (tag == SAVE_TAG_HEADER) {
+      if (have_header ||
+          civ_save_reader_read(r, header, sizeof(*header)) != sizeof(*header) ||
+          header->magic != CIV_SAVE_MAGIC) {
+        res = (civ_result_t){CIV_ERROR_INVALID_DATA, "Invalid file format"};
+        break;
+      }
+      have_header = true;
+      begin_restored_map(game, header);
+      map = header->map_width > 0 && header->map_height > 0 ? game->world_map
+                                                            : NULL;
+      if (map && !row_buffer_init(&rb, map->width))
+        res = (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Buffer alloc"};
+      continue;
+    }
+    if (!have_header) continue; /* sections before the header mean nothing */
+
+    if (tag == SAVE_TAG_CHAIN) {
+      if (civ_save_reader_read(r, chain_id, sizeof(*chain_id)) != sizeof(*chain_id))
+        *chain_id = 0;
+      continue;
+    }
+    if (tag == SAVE_TAG_OWNERS) {
+      CIV_FREE(owners);
+      owners = read_owner_section(r, &owners_size);
+      continue;
+    }
+    for (size_t c = 0; map && c < ARRAY_SIZE(tile_columns); c++) {
+      if (tile_columns[c].tag != tag) continue;
+      tile_rect_t all = {0, 0, map->width, map->height};
+      if (!load_tile_column(r, map, &tile_columns[c], &rb, all, NULL, 0))
+        res = (civ_result_t){CIV_ERROR_INVALID_DATA, "Tile data truncated"};
+      break;
+    }
+  }
+  if (res.error == CIV_OK && civ_save_reader_failed(r))
+    res = (civ_result_t){CIV_ERROR_INVALID_DATA, "Save file damaged"};
+  if (res.error == CIV_OK && !have_header)
+    res = (civ_result_t){CIV_ERROR_INVALID_DATA, "Save has no header"};
+
+  if (map)
+    load_owner_table(map, (size_t)map->width * map->height, owners,
+                     owners_size);
+  row_buffer_free(&rb);
+  CIV_FREE(owners);
+  *map_out = map;
+  return res;
+}
+
+/* Replay delta seq of chain onto map. Returns false, leaving the map
+   alone, if the file is missing or belongs to another base; a delta
+   damaged partway through leaves the regions before the damage applied. */
+static bool apply_delta(civ_map_t *map, const char *path, uint64_t chain_id,
+                        int seq, civ_save_header_t *header) {
+  civ_save_reader_t *r = civ_save_reader_open(path);
+  if (!r) return false;
+
+  civ_save_header_t h;
+  bool have_header = false, linked = false, touched = false;
+  civ_owner_index_t *remap = NULL;
+  uint32_t remap_count = 0;
+  tile_row_buffer_t rb = {NULL, NULL};
+  bool ok = row_buffer_init(&rb, CIV_MAP_REGION_SIZE);
+  uint32_t tag;
+
+  while (ok && civ_save_reader_next_section(r, &tag)) {
+    if (tag == SAVE_TAG_HEADER) {
+      ok = civ_save_reader_read(r, &h, sizeof(h)) == sizeof(h) &&
+           h.magic == CIV_SAVE_MAGIC && (int32_t)h.map_width == map->width &&
+           (int32_t)h.map_height == map->height;
+      have_header = ok;
+    } else if (tag == SAVE_TAG_DELTA) {
+      uint64_t link[2];
+      ok = civ_save_reader_read(r, link, sizeof(link)) == sizeof(link) &&
+           link[0] == chain_id && link[1] == (uint64_t)seq;
+      linked = ok;
+    } else if (tag == SAVE_TAG_OWNERS) {
+      size_t size = 0;
+      uint8_t *data = read_owner_section(r, &size);
+      CIV_FREE(remap);
+      remap = owner_remap(data, size, &remap_count);
+      CIV_FREE(data);
+    } else if (tag == SAVE_TAG_REGION) {
+      int32_t at[2];
+      ok = have_header && linked && remap &&
+           civ_save_reader_read(r, at, sizeof(at)) == sizeof(at) &&
+           at[0] >= 0 && at[0] < map->region_cols && at[1] >= 0 &&
+           at[1] < map->region_rows;
+      for (size_t c = 0; ok && c < ARRAY_SIZE(tile_columns); c++) {
+        touched = true;
+        ok = load_tile_column(r, map, &tile_columns[c], &rb,
+                              region_rect(map->width, map->height, at[0], at[1]), remap,
+                              remap_count);
+      }
+    }
+  }
+  ok = ok && !civ_save_reader_failed(r) && have_header && linked;
+  if (ok)
+    *header = h;
+  else if (touched)
+    printf("[GAME] Delta %s is damaged; regions before the damage applied\n",
+           path);
+
+  row_buffer_free(&rb);
+  CIV_FREE(remap);
+  civ_save_reader_close(r);
+  return ok;
+}
+
+civ_result_t civ_game_load_state(civ_game_t *game, const char *filename) {
+  if (!game || !game->persistence || !filename)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT,
+                          "Invalid game or persistence"};
+  civ_save_worker_wait(game->save_worker);
+  /* Memoized values describe the state being replaced */
+  civ_cache_clear(game->cache);
+
+  /* Streamed through the container reader; anything else is a legacy blob */
+  civ_save_reader_t *r = civ_save_reader_open(filename);
+  if (!r) return load_legacy_state(game, filename);
+
+  civ_save_header_t header;
+  civ_map_t *map = NULL;
+  uint64_t chain_id = 0;
+  civ_result_t res = load_container_state(game, r, &header, &map, &chain_id);
+  civ_save_reader_close(r);
+
+  /* Autosave deltas, in order, until one is missing or not ours */
+  char paths[CIV_AUTOSAVE_MAX_DELTAS + 1][512];
+  int deltas = 0;
+  snprintf(paths[0], sizeof(paths[0]), "%s", filename);
+  if (res.error == CIV_OK && map && chain_id) {
+    for (int seq = 1; seq <= CIV_AUTOSAVE_MAX_DELTAS; seq++) {
+      if (!delta_path(paths[seq], sizeof(paths[seq]), filename, seq) ||
+          !apply_delta(map, paths[seq], chain_id, seq, &header))
+        break;
+      deltas++;
+    }
+  }
+  if (deltas > 0) printf("[GAME] Replayed %d autosave deltas\n", deltas);
+
+  finish_restored_map(game);
+  if (res.error == CIV_OK) {
+    restore_header_state(game, &header);
+    load_game_sections(game, paths, deltas + 1);
+    /* Saves from before the naming section hold only what the
+       settlements re-reserved; no-op for names already taken */
+    reserve_nation_names(game);
+  }
+  /* The files no longer match what the next autosave would diff against */
+  game->autosave.chain_id = 0;
+  return res;
+}
+
 /* Wrappers */
 civ_result_t civ_game_save(civ_game_t *game, const char *filename) {
   return civ_game_save_state(game, filename);
@@ -1252,6 +2772,49 @@ void civ_game_get_default_config(civ_game_config_t *config) {
   config->enable_dependency_tracking = true;
 }
 
+civ_cities_data_t *civ_game_cities(civ_game_t *game) {
+  if (!game || game->cities_data || !game->world_map)
+    return game ? game->cities_data : NULL;
+
+  char _path[512];
+  civ_pack_view_t view;
+  int step = civ_startup_step_begin("Cities");
+  game->cities_data = civ_cities_data_create(
+      game->world_map->width, game->world_map->height);
+  if (game->cities_data) {
+    if (civ_world_pack_section(game->world_pack, CIV_PACK_CITIES, &view))
+      civ_cities_data_load_view(game->cities_data, view.data, view.size);
+    else
+      civ_cities_data_load(game->cities_data, RESOLVE("data/cities.bin"));
+  }
+  civ_startup_step_end(step);
+  if (game->cities_data) {
+    printf("[GAME] Cities data: %u cities loaded\n",
+           game->cities_data->count);
+  }
+  return game->cities_data;
+}
+
+civ_flag_system_t *civ_game_flags(civ_game_t *game) {
+  if (!game || game->flag_system) return game ? game->flag_system : NULL;
+
+  /* Metadata only — textures load once the renderer is available */
+  char _path[512], _path2[512];
+  civ_pack_view_t view;
+  int step = civ_startup_step_begin("Flag index");
+  game->flag_system = civ_flag_system_create(NULL);
+  if (game->flag_system) {
+    civ_path_resolve("data/flags", _path2, sizeof(_path2));
+    if (civ_world_pack_section(game->world_pack, CIV_PACK_FLAGS, &view))
+      civ_flag_system_load_view(game->flag_system, view.data, view.size, _path2);
+    else
+      civ_flag_system_load(game->flag_system, RESOLVE("data/flags/index.bin"),
+                           _path2);
+  }
+  civ_startup_step_end(step);
+  return game->flag_system;
+}
+
 void civ_game_add_event(civ_game_t *game, const char *type,
                         const char *description, civ_float_t importance) {
   if (!game || !game->event_manager)
@@ -0,0 +1,1235 @@
+/**
+ * @file game_systems.c
+ * @brief Per-tick game systems as orchestrator DAG nodes
+ *
+ * Dependencies follow real data flow: a node lists the systems whose frame
+ * outputs or module state it reads. Every node draws random numbers from
+ * its own stream keyed by (seed, tick, node), so scheduling order never
+ * changes the simulation.
+ *
+ * A node with an activity function asks it before each run. Cheap nodes
+ * bank the time of the ticks they sit out and spend it on the next run;
+ * the modules behind them scale by dt, so the cadence changes cost, not
+ * rates.
+ */
+
+#include "core/game_systems.h"
+#include "core/game.h"
+#include "core/ai/ai_system.h"
+#include "core/culture/culture.h"
+#include "core/diplomacy/relations.h"
+#include "core/events/event_manager.h"
+#include "core/events/game_events.h"
+#include "core/technology/innovation_system.h"
+#include "core/world/nation.h"
+#include "core/world/nation_lod.h"
+#include "core/simulation_engine/worker_pool.h"
+#include "utils/frame_trace.h"
+#include "utils/rng.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define CIV_GAME_SYSTEM_MAX_DEPS CIV_ORCHESTRATOR_MAX_DEPS
+
+typedef void (*civ_game_system_fn_t)(civ_game_t *game, civ_game_frame_t *f,
+                                     civ_float_t dt);
+
+/* May read the frame fields its system's dependencies write */
+typedef civ_system_activity_t (*civ_game_system_activity_fn_t)(
+    civ_game_t *game, const civ_game_frame_t *f);
+
+typedef struct {
+  const char                   *name;
+  civ_game_system_fn_t          run;
+  const char                   *deps[CIV_GAME_SYSTEM_MAX_DEPS];
+  civ_game_system_activity_fn_t activity;       /* NULL = always full */
+  uint32_t                      cheap_interval; /* ticks per cheap run */
+} civ_game_system_desc_t;
+
+typedef struct {
+  const civ_game_system_desc_t *desc;
+  civ_game_t                   *game;
+  civ_game_frame_t             *frame;
+  size_t                        index;
+  civ_rng_t                     rng;
+  civ_mem_tag_t                 mem_tag;
+  bool                          enabled;
+  civ_system_activity_t         activity;   /* last decision */
+  civ_float_t                   banked_dt;  /* time of ticks sat out */
+  uint32_t                      sat_out;
+  uint64_t                      awake_until; /* full through this tick */
+} civ_game_system_node_t;
+
+/* Per-nation scratch for the parallel governance tick */
+typedef struct {
+  civ_rng_t rng;
+  bool      due;  /* ticks this update */
+} civ_nation_scratch_t;
+
+typedef struct {
+  civ_game_frame_t        frame;
+  civ_game_system_node_t *nodes;
+  size_t                  node_count;
+  civ_nation_scratch_t   *nation_scratch;
+  int                     nation_scratch_capacity;
+} civ_game_systems_t;
+
+/* ── Frame defaults (used when a module is absent) ─────────────────── */
+static void frame_reset(civ_game_frame_t *f) {
+  memset(f, 0, sizeof(*f));
+  f->total_pop               = 100;
+  f->tech_lev                = 1.0;
+  f->education               = 0.50;
+  f->health                  = 0.50;
+  f->gov_efficiency          = 0.50;
+  f->corruption              = 0.10;
+  f->gov_stability           = 0.60;
+  f->gov_legitimacy          = 0.60;
+  f->arable_area             = 2000.0;
+  f->geography_size          = 10000.0;
+  f->gov_econ_bonus          = 1.0f;
+  f->gov_trade_bonus         = 1.0f;
+  f->gov_research_bonus      = 1.0f;
+  f->gov_military_bonus      = 1.0f;
+  f->gov_cohesion            = 0.50f;
+  f->gdp                     = 500000.0;
+  f->gdp_per_capita          = 50000.0;
+  f->gdp_growth              = 0.02;
+  f->inflation               = 0.02;
+  f->unemployment            = 0.05;
+  f->avg_wage                = 30000.0;
+  f->business_conf           = 0.60;
+  f->regulation_level        = 0.35;
+  f->tax_revenue             = 50000.0;
+  f->budget_infra_allocation = 30000.0;
+  f->gov_spending_ratio      = 0.20;
+  f->debt_interest_rate      = 0.03;
+  f->savings_rate            = 0.15;
+  f->raw_materials           = 100.0;
+  f->infra_quality           = 0.50;
+  f->infra_supply_chain      = 0.50;
+  f->industrial_output       = 500.0;
+  f->energy_price            = 50.0;
+  f->total_gov_budget        = 100000.0;
+  f->culture_level           = 0.30;
+}
+
+/* ── Phase 1: Demographics & Economy ──────────────────────────────── */
+/* Stacks are read by the economy, settlement and military updates after it;
+   only the owners whose inputs moved are rebuilt */
+static void sys_modifiers(civ_game_t *game, civ_game_frame_t *f,
+                          civ_float_t dt) {
+  (void)f; (void)dt;
+  civ_game_refresh_modifiers(game);
+}
+
+static void sys_nation_economies(civ_game_t *game, civ_game_frame_t *f,
+                                 civ_float_t dt) {
+  (void)f;
+  /* Territory aggregates track ownership changes, so this touches nations
+     only and can run every update. Levers are planned from the state the
+     last update left, which is what the speculation after it copied. */
+  if (game->nation_manager && game->world_map) {
+    civ_nation_plan_fiscal_policy(
+        (civ_nation_manager_t *)game->nation_manager,
+        civ_system_orchestrator_get_worker_pool(game->system_orchestrator));
+    civ_nation_update_economies(
+        (civ_nation_manager_t *)game->nation_manager,
+        game->world_map, game->resource_map, game->modifiers, dt,
+        &game->global_economy);
+  }
+}
+
+static void sys_demographics(civ_game_t *game, civ_game_frame_t *f,
+                             civ_float_t dt) {
+  /* Last tick's air; pollution runs after everything that reads it */
+  f->pollution_harm = game->pollution_harm;
+  if (game->population_manager) {
+    game->population_manager->air_quality = 1.0 - f->pollution_harm;
+    civ_population_manager_update(
+        game->population_manager, dt,
+        civ_system_orchestrator_get_worker_pool(game->system_orchestrator));
+    f->total_pop = civ_population_manager_get_total(game->population_manager);
+    f->working_age_pop =
+        civ_population_manager_get_workforce(game->population_manager);
+    f->education = game->population_manager->education_quality;
+    f->health    = game->population_manager->health_index;
+  }
+  if (f->total_pop < 100) f->total_pop = 100;
+  if (f->working_age_pop <= 0) f->working_age_pop = f->total_pop * 65 / 100;
+
+  if (game->technology_tree)
+    f->tech_lev = (civ_float_t)game->technology_tree->aggregate_index / 100.0;
+  if (f->tech_lev < 0.1) f->tech_lev = 0.1;
+
+  /* Governance signals — single source of truth */
+  if (game->government) {
+    f->gov_efficiency = game->government->efficiency;
+    f->corruption     = civ_government_get_corruption(game->government);
+    f->gov_stability  = game->government->stability;
+    f->gov_legitimacy = game->government->legitimacy;
+  }
+
+  /* Lagged policy values — economic_policy refreshes them this tick */
+  if (game->economic_policy) {
+    f->regulation_level = (civ_float_t)game->economic_policy->regulation * 0.25;
+    f->business_conf    = game->economic_policy->business_confidence;
+  }
+
+  /* Geography */
+  if (game->geography) {
+    f->arable_area = civ_geography_get_agricultural_area(game->geography);
+    if (game->geography->patch_count > 0) {
+      f->geography_size = 0.0;
+      for (size_t pi = 0; pi < game->geography->patch_count; pi++)
+        f->geography_size += game->geography->land_patches[pi].area;
+    }
+  }
+  if (f->geography_size < 100.0) f->geography_size = 100.0;
+
+  /* Governance cross-module bonuses — read once, applied throughout economy */
+  if (game->government) {
+    civ_governance_state_t *ev = &game->government->evolution_state;
+    f->gov_econ_bonus     = (float)civ_governance_economic_bonus(ev);
+    f->gov_trade_bonus    = (float)civ_governance_trade_bonus(ev);
+    f->gov_research_bonus = (float)civ_governance_research_bonus(ev);
+    f->gov_military_bonus = (float)civ_governance_military_bonus(ev);
+    f->gov_cohesion       = (float)civ_governance_cohesion_bonus(ev);
+  }
+}
+
+/* Produces GDP, inflation, growth, unemployment */
+static void sys_macro_economy(civ_game_t *game, civ_game_frame_t *f,
+                              civ_float_t dt) {
+  if (!game->market_economy) return;
+  civ_market_dynamics_update(game->market_economy, dt, game->population_manager,
+                             game->geography, f->tech_lev * f->gov_econ_bonus);
+  civ_economic_report_t rep = civ_market_dynamics_get_report(game->market_economy);
+  f->gdp            = rep.gdp * f->gov_econ_bonus;
+  f->gdp_per_capita = rep.gdp_per_capita * f->gov_econ_bonus;
+  f->gdp_growth     = rep.growth_rate * f->gov_econ_bonus;
+  f->inflation      = rep.inflation_rate;
+  f->unemployment   = rep.unemployment_rate;
+}
+
+/* Needs population + GDP + education + (lagged) confidence */
+static void sys_labor_market(civ_game_t *game, civ_game_frame_t *f,
+                             civ_float_t dt) {
+  f->labor_avail = (int)(f->total_pop * 0.4);
+  if (!game->labor_market) return;
+  civ_labor_market_update(game->labor_market, dt, (int)f->working_age_pop,
+                          f->gdp, f->tech_lev, f->education, f->business_conf);
+  f->unemployment   = game->labor_market->overall_unemployment;
+  f->avg_wage       = game->labor_market->avg_wage_national;
+  f->labor_avail    = game->labor_market->total_workforce - game->labor_market->total_employed;
+  if (f->labor_avail < 0) f->labor_avail = 0;
+  f->labor_employed = game->labor_market->total_employed;
+}
+
+/* Needs macro indicators */
+static void sys_economic_policy(civ_game_t *game, civ_game_frame_t *f,
+                                civ_float_t dt) {
+  if (!game->economic_policy) return;
+  civ_economic_policy_update(game->economic_policy, dt, f->inflation,
+                             f->unemployment, f->gdp_growth, f->corruption);
+  f->business_conf    = game->economic_policy->business_confidence;
+  f->regulation_level = (civ_float_t)game->economic_policy->regulation * 0.25;
+}
+
+/* Needs GDP + population + governance */
+static void sys_taxation(civ_game_t *game, civ_game_frame_t *f, civ_float_t dt) {
+  if (!game->taxation) return;
+  civ_taxation_update(game->taxation, dt, f->gdp, (civ_float_t)f->total_pop,
+                      f->gov_efficiency, f->corruption);
+  f->tax_revenue = game->taxation->total_revenue;
+}
+
+/* Needs tax revenue + GDP + population + inflation */
+static void sys_budget(civ_game_t *game, civ_game_frame_t *f, civ_float_t dt) {
+  if (!game->budget) return;
+  civ_budget_update(game->budget, dt, f->tax_revenue, f->gdp,
+                    (civ_float_t)f->total_pop, f->inflation);
+  f->gov_spending_ratio = (f->gdp > 0) ? game->budget->total_expenditure / f->gdp : 0.20;
+  f->budget_infra_allocation = civ_budget_spending_for(game->budget, CIV_BUDGET_INFRASTRUCTURE);
+  f->debt_interest_rate = game->budget->debt_interest_rate;
+  f->savings_rate       = 1.0 - f->gov_spending_ratio;
+  if (f->savings_rate < 0.05) f->savings_rate = 0.05;
+}
+
+/* Commodity curves, one region per nation: supply is what the territory
+   holds and demand follows each nation's share of world industry. Regions
+   reach the hub, at the mean capital, through the infrastructure's
+   logistics cost per thousand km. */
+static void submit_commodity_curves(civ_game_t *game, civ_commodity_market_t *cm,
+                                    const civ_nation_manager_t *mgr) {
+  size_t commodities = MIN(cm->resource_count, (size_t)CIV_RESOURCE_COUNT);
+  if (civ_resource_market_set_regions(cm, (size_t)mgr->count).error != CIV_OK)
+    return;
+  civ_resource_market_begin_turn(cm);
+
+  double world_supply[CIV_RESOURCE_COUNT] = {0};
+  double world_industry = 0.0, hub_lon = 0.0, hub_lat = 0.0;
+  int landed = 0;
+  for (int i = 0; i < mgr->count; i++) {
+    const civ_nation_t *n = &mgr->nations[i];
+    if (n->economy.owned_land_tiles == 0) continue;
+    for (size_t c = 0; c < commodities; c++)
+      world_supply[c] += n->territory.quantities[c];
+    world_industry += n->economy.industrial_output;
+    hub_lon += n->capital_lon;
+    hub_lat += n->capital_lat;
+    landed++;
+  }
+  if (landed == 0 || world_industry <= 0.0) return;
+  hub_lon /= landed;
+  hub_lat /= landed;
+
+  for (int i = 0; i < mgr->count; i++) {
+    const civ_nation_t *n = &mgr->nations[i];
+    if (n->economy.owned_land_tiles == 0) continue;
+    double dx = (n->capital_lon - hub_lon) * cos(hub_lat * M_PI / 180.0);
+    double dy = n->capital_lat - hub_lat;
+    double km = sqrt(dx * dx + dy * dy) * 111.0;
+    /* Plus the haul from the nation's hubs across its own territory */
+    if (game->logistics_field && game->world_map) {
+      const civ_map_metric_t *metric = &game->world_map->metric;
+      km += civ_logistics_field_mean(game->logistics_field, n->owner_index) *
+            civ_map_metric_spacing_km(metric,
+                                      civ_map_metric_row_of(metric, n->capital_lat));
+    }
+    civ_resource_market_set_transport(cm, (size_t)i,
+        civ_infrastructure_logistics_cost(game->infrastructure, km / 1000.0));
+
+    double share = n->economy.industrial_output / world_industry;
+    for (size_t c = 0; c < commodities; c++)
+      civ_resource_market_submit(cm, (size_t)i, c, n->territory.quantities[c],
+                                 world_supply[c] * share, 0.4, 0.6);
+  }
+}
+
+/* Clear resource markets across nations */
+static void sys_commodity_market(civ_game_t *game, civ_game_frame_t *f,
+                                 civ_float_t dt) {
+  (void)dt;
+  if (!game->commodity_market) return;
+  game->commodity_market->global_price_index = 1.0f + f->inflation;
+  if (game->nation_manager)
+    submit_commodity_curves(game, game->commodity_market,
+                            (const civ_nation_manager_t *)game->nation_manager);
+  civ_resource_market_update_all(game->commodity_market);
+}
+
+/* Needs macro + gov spending; banking rate overrides budget rate */
+static void sys_banking(civ_game_t *game, civ_game_frame_t *f, civ_float_t dt) {
+  if (!game->banking) return;
+  civ_banking_update(game->banking, dt, f->inflation, f->gdp_growth,
+                     f->unemployment, f->gov_spending_ratio);
+  f->debt_interest_rate = game->banking->base_interest_rate;
+}
+
+/* Needs population + arable land + tech + climate */
+static void sys_agriculture(civ_game_t *game, civ_game_frame_t *f,
+                            civ_float_t dt) {
+  if (!game->agriculture) return;
+  /* The player's land through the climate tables, surveyed again as it moves */
+  civ_nation_manager_t *nm = (civ_nation_manager_t *)game->nation_manager;
+  if (nm && nm->player_nation_index >= 0 && nm->player_nation_index < nm->count &&
+      game->climate && game->climate_profile && game->world_map &&
+      game->time_manager) {
+    civ_nation_t *player = &nm->nations[nm->player_nation_index];
+    civ_climate_profile_t *profile = game->climate_profile;
+    if (player->economy.owned_land_tiles != profile->surveyed_tiles) {
+      civ_climate_profile_survey(profile, game->world_map,
+                                 civ_nation_owner_index(player));
+      profile->surveyed_tiles = player->economy.owned_land_tiles;
+    }
+    if (profile->land_tiles > 0)
+      civ_agriculture_set_climate(
+          game->agriculture,
+          civ_climate_profile_yield(game->climate, profile,
+                                    game->time_manager->calendar.month) *
+              (1.0 - CIV_POLLUTION_CROP_LOSS * f->pollution_harm),
+          civ_climate_profile_lean_months(game->climate, profile));
+  }
+  civ_agriculture_update(game->agriculture, dt, (civ_float_t)f->total_pop,
+                         f->arable_area, f->tech_lev, 1.0);
+  f->food_surplus = game->agriculture->food_surplus;
+}
+
+/* Needs tech + labor + geography */
+static void sys_extraction(civ_game_t *game, civ_game_frame_t *f,
+                           civ_float_t dt) {
+  if (!game->extraction) return;
+  /* Mines open on the player's deposits, surveyed again as its land moves */
+  civ_nation_manager_t *nm = (civ_nation_manager_t *)game->nation_manager;
+  if (nm && nm->player_nation_index >= 0 && nm->player_nation_index < nm->count &&
+      game->resource_map && game->world_map) {
+    civ_nation_t *player = &nm->nations[nm->player_nation_index];
+    if (player->economy.owned_land_tiles != game->extraction->surveyed_tiles) {
+      civ_extraction_open_deposits(game->extraction, game->resource_map,
+                                   game->world_map, civ_nation_owner_index(player));
+      game->extraction->surveyed_tiles = player->economy.owned_land_tiles;
+    }
+  }
+  civ_extraction_update(game->extraction, dt, f->tech_lev,
+                        (civ_float_t)f->labor_avail, game->resource_map,
+                        game->world_map);
+  f->raw_materials = game->extraction->total_output;
+  if (f->raw_materials < 1.0) f->raw_materials = 1.0;
+}
+
+/* Needs budget + population + geography */
+static void sys_infrastructure(civ_game_t *game, civ_game_frame_t *f,
+                               civ_float_t dt) {
+  if (!game->infrastructure) return;
+  civ_infrastructure_update(game->infrastructure, dt, f->budget_infra_allocation,
+                            (civ_float_t)f->total_pop, f->geography_size);
+  f->infra_quality      = game->infrastructure->overall_quality;
+  f->infra_supply_chain = game->infrastructure->supply_chain_efficiency;
+}
+
+/* Needs tech + labor + raw materials + infra */
+static void sys_manufacturing(civ_game_t *game, civ_game_frame_t *f,
+                              civ_float_t dt) {
+  if (!game->manufacturing) return;
+  civ_manufacturing_update(game->manufacturing, dt, f->tech_lev,
+                           (civ_float_t)f->labor_avail, f->raw_materials,
+                           f->infra_quality);
+  f->industrial_output = game->manufacturing->total_industrial_output;
+  if (f->industrial_output < 1.0) f->industrial_output = 1.0;
+}
+
+/* Needs population + industrial output + tech */
+static void sys_energy(civ_game_t *game, civ_game_frame_t *f, civ_float_t dt) {
+  if (!game->energy) return;
+  civ_energy_update(game->energy, dt, (civ_float_t)f->total_pop,
+                    f->industrial_output, f->tech_lev, 0.80);
+  f->energy_price = game->energy->energy_price;
+}
+
+/* Needs population + wages + interest + costs */
+static void sys_housing(civ_game_t *game, civ_game_frame_t *f, civ_float_t dt) {
+  if (!game->housing) return;
+  civ_float_t construction_cost_index = (f->energy_price / 50.0 + f->infra_quality > 0)
+                                         ? (1.0 + (1.0 - f->infra_quality)) : 1.5;
+  civ_housing_update(game->housing, dt, (int)f->total_pop, f->avg_wage,
+                     f->debt_interest_rate, construction_cost_index);
+}
+
+/* Needs population + GDP/capita + urbanization */
+static void sys_land_use(civ_game_t *game, civ_game_frame_t *f, civ_float_t dt) {
+  if (!game->land_use) return;
+  civ_float_t urban_rate = game->housing ? game->housing->urbanization : 0.55;
+  civ_land_use_update(game->land_use, dt, (int)f->total_pop, f->gdp_per_capita,
+                      urban_rate);
+}
+
+/* Needs GDP + savings + interest + confidence */
+static void sys_capital_assets(civ_game_t *game, civ_game_frame_t *f,
+                               civ_float_t dt) {
+  if (!game->capital_assets) return;
+  civ_capital_assets_update(game->capital_assets, dt, f->gdp, f->savings_rate,
+                            f->debt_interest_rate, f->business_conf);
+}
+
+/* Needs infrastructure + population + geography */
+static void sys_domestic_trade(civ_game_t *game, civ_game_frame_t *f,
+                               civ_float_t dt) {
+  if (!game->domestic_trade) return;
+  civ_domestic_trade_update(game->domestic_trade, dt, f->infra_quality,
+                            (civ_float_t)f->total_pop, f->geography_size);
+}
+
+static void sys_international_trade(civ_game_t *game, civ_game_frame_t *f,
+                                    civ_float_t dt) {
+  (void)f;
+  if (!game->trade_manager) return;
+  civ_trade_update(game->trade_manager, dt);
+  if (game->trade_network) {
+    civ_trade_network_update(game->trade_network, game->settlement_manager);
+    civ_trade_collect_network(game->trade_manager);
+  }
+}
+
+/* Needs GDP + education + confidence + capital */
+static void sys_innovation_economy(civ_game_t *game, civ_game_frame_t *f,
+                                   civ_float_t dt) {
+  if (!game->innovation_economy) return;
+  civ_float_t capital_avail = game->capital_assets
+    ? game->capital_assets->total_capital_stock / (f->gdp + 1.0) : 0.50;
+  civ_innovation_economy_update(game->innovation_economy, dt, f->gdp, f->education,
+                                f->business_conf, f->regulation_level, capital_avail);
+}
+
+/* Needs GDP + corruption + unemployment + regulation */
+static void sys_black_market(civ_game_t *game, civ_game_frame_t *f,
+                             civ_float_t dt) {
+  if (!game->black_market) return;
+  civ_black_market_update(game->black_market, dt, f->gdp, f->corruption,
+                          f->unemployment, f->regulation_level, 10000.0);
+}
+
+/* Needs GDP + industrial output + population */
+static void sys_war_economy(civ_game_t *game, civ_game_frame_t *f,
+                            civ_float_t dt) {
+  if (!game->war_economy) return;
+  bool actively_fighting = false;
+  civ_war_economy_update(game->war_economy, dt, f->gdp, f->industrial_output,
+                         (int)f->total_pop, actively_fighting);
+}
+
+/* Peace decays mobilization slowly; once it has decayed away there is
+   nothing left to update */
+static civ_system_activity_t war_economy_activity(civ_game_t *game,
+                                                  const civ_game_frame_t *f) {
+  (void)f;
+  if (!game->war_economy) return CIV_SYSTEM_DORMANT;
+  if (game->war_economy->at_war) return CIV_SYSTEM_FULL;
+  return civ_war_economy_is_demobilized(game->war_economy) ? CIV_SYSTEM_DORMANT
+                                                           : CIV_SYSTEM_CHEAP;
+}
+
+/* Illicit trade grows fast only where corruption or joblessness feed it */
+#define BLACK_MARKET_CORRUPTION_FULL   0.30
+#define BLACK_MARKET_UNEMPLOYMENT_FULL 0.15
+
+static civ_system_activity_t black_market_activity(civ_game_t *game,
+                                                   const civ_game_frame_t *f) {
+  if (!game->black_market) return CIV_SYSTEM_DORMANT;
+  if (f->corruption >= BLACK_MARKET_CORRUPTION_FULL ||
+      f->unemployment >= BLACK_MARKET_UNEMPLOYMENT_FULL)
+    return CIV_SYSTEM_FULL;
+  return CIV_SYSTEM_CHEAP;
+}
+
+/* ── Phase 2: Diplomacy & Governance ──────────────────────────────── */
+static void sys_diplomacy(civ_game_t *game, civ_game_frame_t *f, civ_float_t dt) {
+  (void)f;
+  if (game->diplomacy_system) {
+    civ_diplomacy_system_advance_treaties(game->diplomacy_system, dt);
+    civ_diplomacy_system_update_relations(game->diplomacy_system, 0);
+  }
+}
+
+/* Governments share nothing but their random draws, so each nation
+   draws from its own stream keyed by (seed, tick, nation index). Nations
+   far from the player's concerns tick every few updates over the time
+   they banked; see nation_lod.h. A job takes a block of nations and runs
+   each update stage across the block before the next, so it sweeps one
+   subsystem's arena slab at a time. */
+#define NATION_GOV_BLOCK 16 /* nations per governance job */
+
+typedef struct {
+  civ_game_t           *game;
+  civ_game_frame_t     *frame;
+  civ_nation_manager_t *nm;
+  civ_nation_scratch_t *scratch;
+  civ_float_t           dt;
+  int                   live; /* nations not absorbed into another */
+} civ_nation_tick_ctx_t;
+
+static bool reserve_nation_scratch(civ_game_systems_t *gs, int count) {
+  if (count <= gs->nation_scratch_capacity) return true;
+  civ_nation_scratch_t *grown = CIV_REALLOC(gs->nation_scratch,
+                                            sizeof(civ_nation_scratch_t) * (size_t)count);
+  if (!grown) return false;
+  gs->nation_scratch = grown;
+  gs->nation_scratch_capacity = count;
+  return true;
+}
+
+static void nation_governance_begin(civ_nation_tick_ctx_t *ctx, int ni) {
+  civ_nation_t *nation = &ctx->nm->nations[ni];
+  civ_game_frame_t *f = ctx->frame;
+  civ_nation_scratch_t *scratch = &ctx->scratch[ni];
+  scratch->due = false;
+  if (nation->defunct || !nation->government) return;
+  /* Skip player nation — already ticked above */
+  if (nation->government == ctx->game->government) return;
+  civ_float_t dt;
+  if (!civ_nation_lod_take(nation, ctx->game->performance.update_count, ctx->dt, &dt))
+    return;
+
+  scratch->due = true;
+  civ_rng_seed_key(&scratch->rng, civ_game_rng_seed(ctx->game), CIV_RNG_GOVERNANCE,
+                   ctx->game->performance.update_count, (uint64_t)ni);
+
+  /* Each nation gets its own governance tick with autonomous trait evolution */
+  civ_government_begin_update(nation->government, dt, (int)f->total_pop,
+                              f->culture_level, f->total_gov_budget / (float)(ctx->live + 1),
+                              f->education, f->business_conf, f->education, 0.55f, 3);
+}
+
+static void nation_governance_block(void *arg, int job) {
+  civ_nation_tick_ctx_t *ctx = (civ_nation_tick_ctx_t *)arg;
+  int n0 = job * NATION_GOV_BLOCK;
+  int n1 = MIN(n0 + NATION_GOV_BLOCK, ctx->nm->count);
+  for (int ni = n0; ni < n1; ni++) nation_governance_begin(ctx, ni);
+  for (int s = 0; s < CIV_GOV_STAGE_COUNT; s++) {
+    for (int ni = n0; ni < n1; ni++) {
+      civ_nation_scratch_t *scratch = &ctx->scratch[ni];
+      if (!scratch->due) continue;
+      civ_rng_t *prev = civ_rng_bind(&scratch->rng);
+      civ_government_update_stage(ctx->nm->nations[ni].government, (civ_gov_stage_t)s);
+      civ_rng_bind(prev);
+    }
+  }
+}
+
+static void sys_governance(civ_game_t *game, civ_game_frame_t *f,
+                           civ_float_t dt) {
+  /* Feed budget allocations into government from economic budget module */
+  if (game->government && game->budget) {
+    static const civ_budget_category_t cats[] = {
+      CIV_BUDGET_MILITARY, CIV_BUDGET_INFRASTRUCTURE, CIV_BUDGET_EDUCATION,
+      CIV_BUDGET_HEALTHCARE, CIV_BUDGET_WELFARE, CIV_BUDGET_RESEARCH,
+      CIV_BUDGET_ADMINISTRATION, CIV_BUDGET_DEBT_SERVICE,
+    };
+    for (size_t c = 0; c < sizeof(cats) / sizeof(cats[0]); c++)
+      civ_government_set_budget(game->government, cats[c],
+                                civ_budget_spending_for(game->budget, cats[c]));
+  }
+
+  /* Main governance tick — propagates to ALL 14 subsystems */
+  f->total_gov_budget = game->budget ? game->budget->total_expenditure : 100000.0f;
+  f->culture_level    = game->culture_system ? 0.50f : 0.30f;
+
+  if (game->government) {
+    float edu_lvl  = game->population_manager ? game->population_manager->education_quality : 0.50f;
+    float econ_conf = game->economic_policy ? game->economic_policy->consumer_confidence : 0.50f;
+    float lit_rate  = edu_lvl;
+    float fac_sup   = 0.55f;
+    int   fac_cnt   = 3;
+    civ_election_system_t *es = game->government->election_system;
+    if (game->population_manager && civ_election_due(es))
+      civ_electorate_from_population(&es->electorate, game->population_manager, NULL);
+    civ_government_update(game->government, dt, (int)f->total_pop,
+                          f->culture_level, f->total_gov_budget, edu_lvl, econ_conf,
+                          lit_rate, fac_sup, fac_cnt);
+  }
+
+  /* Custom governance: parallel system — update if nations have custom govs */
+  civ_custom_governance_manager_update(game->custom_governance_manager, dt);
+
+  /* ── Tick ALL nation governments autonomously ── */
+  if (game->nation_manager) {
+    civ_nation_manager_t *nm = (civ_nation_manager_t *)game->nation_manager;
+    civ_game_systems_t *gs = (civ_game_systems_t *)game->system_graph;
+    civ_nation_lod_refresh(nm, game->diplomacy_system,
+                           game->performance.update_count);
+    if (nm->count > 0 && reserve_nation_scratch(gs, nm->count)) {
+      civ_nation_tick_ctx_t ctx = {game, f, nm, gs->nation_scratch, dt, 0};
+      for (int i = 0; i < nm->count; i++) ctx.live += !nm->nations[i].defunct;
+      civ_worker_pool_parallel_for(
+          civ_system_orchestrator_get_worker_pool(game->system_orchestrator),
+          (nm->count + NATION_GOV_BLOCK - 1) / NATION_GOV_BLOCK,
+          nation_governance_block, &ctx);
+    }
+  }
+}
+
+/* ── Phases 3–10 ──────────────────────────────────────────────────── */
+static void sys_settlements(civ_game_t *game, civ_game_frame_t *f,
+                            civ_float_t dt) {
+  (void)f;
+  if (game->settlement_manager)
+    civ_settlement_manager_update(game->settlement_manager, game->world_map,
+                                  game->government, game->modifiers, dt);
+}
+
+static void sys_technology(civ_game_t *game, civ_game_frame_t *f,
+                           civ_float_t dt) {
+  if (game->technology_tree)
+    civ_innovation_system_update(game->technology_tree, dt * f->gov_research_bonus);
+}
+
+static void sys_culture(civ_game_t *game, civ_game_frame_t *f, civ_float_t dt) {
+  (void)f;
+  if (game->culture_system)
+    civ_culture_system_update(
+        game->culture_system, game->world_map, game->trade_manager,
+        civ_system_orchestrator_get_worker_pool(game->system_orchestrator), dt);
+}
+
+static void sys_religion(civ_game_t *game, civ_game_frame_t *f, civ_float_t dt) {
+  (void)f;
+  if (game->religion_system)
+    civ_religion_system_update(game->religion_system, game->trade_network,
+                               game->tile_field, dt);
+}
+
+/* A new plague disaster breaks out at the settlement nearest its epicentre */
+static void sys_epidemic(civ_game_t *game, civ_game_frame_t *f, civ_float_t dt) {
+  (void)f;
+  civ_epidemic_system_t *ep = game->epidemics;
+  if (!ep || !game->trade_network) return;
+  civ_disaster_manager_t *dm = game->disaster_manager;
+  for (size_t k = 0; dm && ep->disease_count > 0 && k < dm->disaster_count; k++) {
+    const civ_disaster_t *d = &dm->active_disasters[k];
+    if (!d->active || d->type != CIV_DISASTER_PLAGUE || d->number < ep->plague_seen)
+      continue;
+    ep->plague_seen = d->number + 1;
+    civ_epidemic_seed_at(ep, game->trade_network, 0, d->x, d->y,
+                         0.01 * d->severity);
+  }
+  civ_epidemic_system_update(ep, game->trade_network, game->settlement_manager, dt);
+}
+
+/* Nothing to step between outbreaks but a plague to watch for */
+static civ_system_activity_t epidemic_activity(civ_game_t *game,
+                                               const civ_game_frame_t *f) {
+  (void)f;
+  if (civ_epidemic_active_count(game->epidemics) > 0) return CIV_SYSTEM_FULL;
+  return game->disaster_manager &&
+                 civ_disaster_active_count(game->disaster_manager) > 0
+             ? CIV_SYSTEM_CHEAP : CIV_SYSTEM_DORMANT;
+}
+
+/* Emissions per unit of each kind of site's output */
+static const civ_float_t k_site_emission[CIV_EXTRACT_TYPE_COUNT] = {
+    1.0,  /* mining */
+    0.3,  /* logging */
+    0.05, /* fishing */
+    0.02, /* hunting */
+    0.6,  /* quarrying */
+};
+#define PLANT_EMISSION    0.01 /* per carbon-weighted MW per day */
+#define FACTORY_EMISSION  0.02 /* per unit of industrial output per day */
+
+/* The player's sites pollute where they stand; plants and factories have
+   no tile, so theirs goes up over the player's settlements by population */
+static void sys_pollution(civ_game_t *game, civ_game_frame_t *f, civ_float_t dt) {
+  (void)f;
+  const civ_map_t *map = game->world_map;
+  if (!map) return;
+  if (game->pollution && (game->pollution->map_width != map->width ||
+                          game->pollution->map_height != map->height)) {
+    civ_pollution_destroy(game->pollution);
+    game->pollution = NULL;
+  }
+  if (!game->pollution)
+    game->pollution = civ_pollution_create(map->width, map->height);
+  civ_pollution_field_t *pf = game->pollution;
+  if (!pf) return;
+
+  civ_owner_index_t owner = CIV_OWNER_NONE;
+  civ_nation_manager_t *nm = (civ_nation_manager_t *)game->nation_manager;
+  if (nm && nm->player_nation_index >= 0 && nm->player_nation_index < nm->count)
+    owner = civ_nation_owner_index(&nm->nations[nm->player_nation_index]);
+
+  const civ_extraction_system_t *ex = game->extraction;
+  for (int i = 0; ex && i < ex->active.count; i++) {
+    const civ_extraction_site_t *site = &ex->sites[ex->active.site[i]];
+    civ_pollution_emit(pf, (int32_t)(site->tile % (uint32_t)map->width),
+                       (int32_t)(site->tile / (uint32_t)map->width),
+                       ex->active.rate[i] * k_site_emission[site->type] * dt);
+  }
+  civ_float_t stacks = 0.0;
+  if (game->energy)
+    for (int p = 0; p < game->energy->plant_count; p++)
+      stacks += game->energy->plants[p].current_output_mw *
+                game->energy->plants[p].carbon_intensity;
+  stacks *= PLANT_EMISSION;
+  if (game->manufacturing)
+    stacks += game->manufacturing->total_industrial_output * FACTORY_EMISSION;
+  civ_pollution_emit_settlements(pf, game->settlement_manager, owner, stacks * dt);
+
+  civ_pollution_step(pf, dt);
+  game->pollution_harm =
+      civ_pollution_apply(pf, game->settlement_manager, owner, dt);
+}
+
+static void sys_politics(civ_game_t *game, civ_game_frame_t *f, civ_float_t dt) {
+  (void)f;
+  if (game->politics_system)
+    civ_politics_system_update(game->politics_system, dt);
+}
+
+static void sys_conquest(civ_game_t *game, civ_game_frame_t *f, civ_float_t dt) {
+  (void)f;
+  if (!game->conquest_system) return;
+  civ_conquest_update(game->conquest_system, dt);
+  int transferred = civ_conquest_transfer_territory(
+      game->conquest_system, game->world_map, game->nation_manager);
+  if (transferred > 0)
+    printf("[GAME] %d border tiles transferred via conquest\n", transferred);
+}
+
+/* Completed conquests are removed once their territory moves */
+static civ_system_activity_t conquest_activity(civ_game_t *game,
+                                               const civ_game_frame_t *f) {
+  (void)f;
+  if (!game->conquest_system || game->conquest_system->conquest_count == 0)
+    return CIV_SYSTEM_DORMANT;
+  return CIV_SYSTEM_FULL;
+}
+
+static void sys_borders(civ_game_t *game, civ_game_frame_t *f, civ_float_t dt) {
+  (void)f;
+  if (game->dynamic_borders) {
+    /* No-op once attached; recounts after a load replaced the map */
+    if (game->world_map)
+      civ_dynamic_borders_attach(game->dynamic_borders, game->world_map);
+    civ_dynamic_borders_update(game->dynamic_borders, dt);
+  }
+  if (game->territory_manager)
+    civ_territory_manager_update(game->territory_manager, dt);
+}
+
+/* Label baselines of the owners whose territory moved */
+static void sys_nation_labels(civ_game_t *game, civ_game_frame_t *f,
+                              civ_float_t dt) {
+  (void)f; (void)dt;
+  if (!game->nation_labels || !game->world_map) return;
+  civ_nation_labels_attach(game->nation_labels, game->world_map);
+  civ_nation_labels_refresh(game->nation_labels, game->world_map);
+}
+
+/* Ownership changes come in runs (a war, a treaty); the refresh waits for
+   the run instead of rescanning the map on every tick of it */
+static civ_system_activity_t nation_labels_activity(civ_game_t *game,
+                                                    const civ_game_frame_t *f) {
+  (void)f;
+  if (!game->nation_labels || !game->world_map) return CIV_SYSTEM_DORMANT;
+  if (!civ_nation_labels_attached(game->nation_labels, game->world_map))
+    return CIV_SYSTEM_FULL;
+  return game->nation_labels->any_dirty ? CIV_SYSTEM_CHEAP : CIV_SYSTEM_DORMANT;
+}
+
+/* Hub travel costs: the player's nation and settlements price the player's
+   networks, every other nation its terrain and settlement roads */
+static void sys_logistics(civ_game_t *game, civ_game_frame_t *f, civ_float_t dt) {
+  (void)f; (void)dt;
+  if (!game->logistics_field || !game->world_map) return;
+  civ_logistics_field_bind(game->logistics_field, civ_owner_intern("PLAYER"),
+                           game->infrastructure);
+  civ_nation_manager_t *nm = (civ_nation_manager_t *)game->nation_manager;
+  for (int i = 0; nm && i < nm->count; i++) {
+    civ_nation_t *n = &nm->nations[i];
+    if (n->economy.owned_land_tiles == 0) continue;
+    civ_logistics_field_bind(game->logistics_field, civ_nation_owner_index(n),
+                             n->government && n->government == game->government
+                                 ? game->infrastructure : NULL);
+  }
+  civ_logistics_field_refresh(
+      game->logistics_field, game->world_map, game->settlement_manager,
+      civ_system_orchestrator_get_worker_pool(game->system_orchestrator));
+}
+
+/* Networks and borders drift; a rebuild every few ticks keeps up */
+static civ_system_activity_t logistics_activity(civ_game_t *game,
+                                                const civ_game_frame_t *f) {
+  (void)f;
+  return game->logistics_field ? CIV_SYSTEM_CHEAP : CIV_SYSTEM_DORMANT;
+}
+
+/* Layers the AIs read; after everything that moves what they count */
+static void sys_influence(civ_game_t *game, civ_game_frame_t *f,
+                          civ_float_t dt) {
+  (void)f;
+  (void)dt;
+  civ_influence_map_refresh(
+      game->influence_map, game->unit_manager, game->settlement_manager,
+      civ_system_orchestrator_get_worker_pool(game->system_orchestrator));
+}
+
+/* Settlement candidates; borders last moved the settlements it spaces */
+static void sys_sites(civ_game_t *game, civ_game_frame_t *f, civ_float_t dt) {
+  (void)f;
+  (void)dt;
+  civ_site_field_refresh(game->site_field, game->world_map,
+                         game->settlement_manager);
+}
+
+/* Overlay fields; borders and settlements last wrote the tiles they read */
+static void sys_fields(civ_game_t *game, civ_game_frame_t *f, civ_float_t dt) {
+  (void)f;
+  civ_tile_field_step(
+      game->tile_field,
+      civ_system_orchestrator_get_worker_pool(game->system_orchestrator), dt);
+  /* Province sums follow the field, one pass over each province's spans */
+  if (game->nation_manager && game->world_map)
+    civ_nation_aggregate_subdivisions(
+        (civ_nation_manager_t *)game->nation_manager, game->world_map,
+        game->tile_field);
+}
+
+/* Slow spread: step every CIV_TILE_FIELD_INTERVAL updates on the time
+   banked since the last */
+static civ_system_activity_t fields_activity(civ_game_t *game,
+                                             const civ_game_frame_t *f) {
+  (void)f;
+  return game->tile_field ? CIV_SYSTEM_CHEAP : CIV_SYSTEM_DORMANT;
+}
+
+/* AI reacts to current world state */
+static void sys_ai(civ_game_t *game, civ_game_frame_t *f, civ_float_t dt) {
+  (void)f;
+  if (game->ai_system)
+    civ_ai_system_update(game->ai_system, dt);
+  if (game->subunit_manager)
+    civ_subunit_manager_update(game->subunit_manager, dt);
+}
+
+/* Authored events test only the rules whose facts moved */
+static void sys_events(civ_game_t *game, civ_game_frame_t *f, civ_float_t dt) {
+  (void)f;
+  if (game->event_rules) {
+    civ_game_events_publish(game, game->event_rules);
+    civ_event_rules_evaluate(game->event_rules, game->event_manager);
+  }
+  if (game->event_manager)
+    civ_event_manager_update(game->event_manager, dt);
+}
+
+static void sys_disasters(civ_game_t *game, civ_game_frame_t *f,
+                          civ_float_t dt) {
+  (void)f;
+  if (!game->disaster_manager) return;
+  civ_disaster_manager_set_map(game->disaster_manager, game->world_map);
+  civ_disaster_update(game->disaster_manager, dt);
+  civ_disaster_apply_impact(game->disaster_manager, game->settlement_manager,
+                            game->unit_manager);
+}
+
+/* Between disasters only the spawn roll runs, and it scales by dt */
+static civ_system_activity_t disasters_activity(civ_game_t *game,
+                                                const civ_game_frame_t *f) {
+  (void)f;
+  if (!game->disaster_manager) return CIV_SYSTEM_DORMANT;
+  return civ_disaster_active_count(game->disaster_manager) > 0
+             ? CIV_SYSTEM_FULL : CIV_SYSTEM_CHEAP;
+}
+
+/* Phase 11: Stature Ranking Logic */
+static void sys_stature(civ_game_t *game, civ_game_frame_t *f, civ_float_t dt) {
+  (void)f; (void)dt;
+  if (!game->government)
+    return;
+
+  civ_government_t *gov = game->government;
+
+  /* Calculate National Capability Index (NCI) */
+  /* Factors: Institutional Stature, Stability, Efficiency, and Tech Level */
+  civ_float_t institutional_stature = 0.0f;
+  if (gov->institution_manager) {
+    /* Sum of log-scaled stature, kept by the institution update */
+    institutional_stature = gov->institution_manager->stature_log_sum;
+  }
+
+  civ_float_t nci =
+      (institutional_stature * 10.0f) * gov->efficiency * gov->stability;
+
+  /* Simple Tier Mapping (In a multi-nation world, this would be relative to
+   * others) */
+  if (nci > 500.0f)
+    gov->stature_tier = CIV_STATURE_HEGEMON;
+  else if (nci > 300.0f)
+    gov->stature_tier = CIV_STATURE_GREAT_POWER;
+  else if (nci > 150.0f)
+    gov->stature_tier = CIV_STATURE_REGIONAL_POWER;
+  else if (nci > 75.0f)
+    gov->stature_tier = CIV_STATURE_STABLE_STATE;
+  else if (nci > 30.0f)
+    gov->stature_tier = CIV_STATURE_DEVELOPING_STATE;
+  else if (nci > 10.0f)
+    gov->stature_tier = CIV_STATURE_FRONTIER_NATION;
+  else
+    gov->stature_tier = CIV_STATURE_FAILED_STATE;
+}
+
+/* ── Dependency graph ─────────────────────────────────────────────── */
+static const civ_game_system_desc_t g_system_table[] = {
+  {"modifiers",           sys_modifiers,           {"technology", "economic_policy"}},
+  {"nation_economies",    sys_nation_economies,    {"modifiers"}},
+  {"demographics",        sys_demographics,        {NULL}},
+  {"macro_economy",       sys_macro_economy,       {"demographics"}},
+  {"labor_market",        sys_labor_market,        {"macro_economy"}},
+  {"economic_policy",     sys_economic_policy,     {"labor_market"}},
+  {"taxation",            sys_taxation,            {"macro_economy"}},
+  {"budget",              sys_budget,              {"taxation"}},
+  {"commodity_market",    sys_commodity_market,    {"macro_economy", "nation_economies",
+                                                    "infrastructure", "logistics"}},
+  {"banking",             sys_banking,             {"labor_market", "budget"}},
+  {"agriculture",         sys_agriculture,         {"demographics", "nation_economies",
+                                                    "settlements", "borders"}},
+  {"extraction",          sys_extraction,          {"labor_market", "nation_economies",
+                                                    "borders"}},
+  {"infrastructure",      sys_infrastructure,      {"budget"}},
+  {"manufacturing",       sys_manufacturing,       {"labor_market", "extraction",
+                                                    "infrastructure"}},
+  {"energy",              sys_energy,              {"manufacturing"}},
+  {"housing",             sys_housing,             {"labor_market", "banking",
+                                                    "infrastructure", "energy"}},
+  {"land_use",            sys_land_use,            {"macro_economy", "housing"}},
+  {"capital_assets",      sys_capital_assets,      {"budget", "banking",
+                                                    "economic_policy"}},
+  {"domestic_trade",      sys_domestic_trade,      {"infrastructure"}},
+  {"international_trade", sys_international_trade, {"borders"}},
+  {"innovation_economy",  sys_innovation_economy,  {"economic_policy",
+                                                    "capital_assets"}},
+  {"black_market",        sys_black_market,        {"labor_market",
+                                                    "economic_policy"},
+                          black_market_activity, 8},
+  {"war_economy",         sys_war_economy,         {"manufacturing"},
+                          war_economy_activity, 8},
+  {"diplomacy",           sys_diplomacy,           {NULL}},
+  {"governance",          sys_governance,          {"budget", "economic_policy",
+                                                    "nation_economies",
+                                                    "diplomacy"}},
+  {"settlements",         sys_settlements,         {"governance",
+                                                    "nation_economies"}},
+  {"technology",          sys_technology,          {"demographics"}},
+  {"culture",             sys_culture,             {"borders",
+                                                    "international_trade"}},
+  {"religion",            sys_religion,            {"fields",
+                                                    "international_trade"}},
+  {"politics",            sys_politics,            {"governance"}},
+  {"conquest",            sys_conquest,            {"settlements"},
+                          conquest_activity, 1},
+  {"borders",             sys_borders,             {"conquest"}},
+  {"nation_labels",       sys_nation_labels,       {"borders"},
+                          nation_labels_activity, 20},
+  {"logistics",           sys_logistics,           {"borders", "settlements",
+                                                    "infrastructure"},
+                          logistics_activity, 16},
+  {"influence",           sys_influence,           {"borders"}},
+  {"sites",               sys_sites,               {"borders"}},
+  {"fields",              sys_fields,              {"borders"},
+                          fields_activity, CIV_TILE_FIELD_INTERVAL},
+  {"ai",                  sys_ai,                  {"influence", "sites", "fields",
+                                                    "technology", "culture",
+                                                    "politics", "diplomacy",
+                                                    "agriculture", "land_use",
+                                                    "domestic_trade",
+                                                    "international_trade",
+                                                    "commodity_market",
+                                                    "innovation_economy",
+                                                    "black_market", "war_economy"}},
+  {"events",              sys_events,              {"ai"}},
+  {"disasters",           sys_disasters,           {"events"},
+                          disasters_activity, 8},
+  {"stature",             sys_stature,             {"events"}},
+  {"epidemic",            sys_epidemic,            {"disasters", "settlements"},
+                          epidemic_activity, 4},
+  {"pollution",           sys_pollution,           {"energy", "extraction",
+                                                    "manufacturing", "epidemic"}},
+};
+
+#define CIV_GAME_SYSTEM_COUNT (sizeof(g_system_table) / sizeof(g_system_table[0]))
+
+/* Memory tag a system allocates under; systems not listed are economy */
+static const struct {
+  const char   *name;
+  civ_mem_tag_t tag;
+} g_system_mem_tags[] = {
+  {"demographics", CIV_MEM_TAG_SOCIETY},   {"technology", CIV_MEM_TAG_SOCIETY},
+  {"culture",      CIV_MEM_TAG_SOCIETY},   {"religion",   CIV_MEM_TAG_SOCIETY},
+  {"diplomacy",    CIV_MEM_TAG_GOVERNANCE}, {"governance", CIV_MEM_TAG_GOVERNANCE},
+  {"politics",     CIV_MEM_TAG_GOVERNANCE}, {"settlements", CIV_MEM_TAG_NATIONS},
+  {"stature",      CIV_MEM_TAG_NATIONS},   {"war_economy", CIV_MEM_TAG_MILITARY},
+  {"conquest",     CIV_MEM_TAG_MILITARY},  {"borders",    CIV_MEM_TAG_WORLD},
+  {"sites",        CIV_MEM_TAG_WORLD},     {"fields",     CIV_MEM_TAG_WORLD},
+  {"influence",    CIV_MEM_TAG_AI},        {"ai",         CIV_MEM_TAG_AI},
+  {"events",       CIV_MEM_TAG_EVENTS},    {"disasters",  CIV_MEM_TAG_EVENTS},
+  {"epidemic",     CIV_MEM_TAG_SOCIETY},   {"pollution",  CIV_MEM_TAG_WORLD},
+};
+
+static civ_mem_tag_t system_mem_tag(const char *name) {
+  for (size_t i = 0; i < ARRAY_SIZE(g_system_mem_tags); i++)
+    if (strcmp(g_system_mem_tags[i].name, name) == 0)
+      return g_system_mem_tags[i].tag;
+  return CIV_MEM_TAG_ECONOMY;
+}
+
+/* ── civ_updatable_t adapters ─────────────────────────────────────── */
+/* Time this tick's run covers, or < 0 to sit it out */
+static civ_float_t node_schedule(civ_game_system_node_t *node, civ_float_t dt) {
+  const civ_game_system_desc_t *desc = node->desc;
+  civ_system_activity_t activity = CIV_SYSTEM_FULL;
+  if (desc->activity && node->game->performance.update_count > node->awake_until)
+    activity = desc->activity(node->game, node->frame);
+  node->activity = activity;
+
+  if (activity == CIV_SYSTEM_DORMANT) {
+    node->banked_dt = 0.0;
+    node->sat_out = 0;
+    return -1.0;
+  }
+  if (activity == CIV_SYSTEM_CHEAP && node->sat_out + 1 < desc->cheap_interval) {
+    node->banked_dt += dt;
+    node->sat_out++;
+    return -1.0;
+  }
+  civ_float_t span = node->banked_dt + dt;
+  node->banked_dt = 0.0;
+  node->sat_out = 0;
+  return span;
+}
+
+static civ_result_t node_update(void *system, civ_float_t dt) {
+  civ_game_system_node_t *node = (civ_game_system_node_t *)system;
+  civ_float_t span = node_schedule(node, dt);
+  if (span < 0.0) return (civ_result_t){CIV_OK, NULL};
+  civ_rng_seed_key(&node->rng, civ_game_rng_seed(node->game), CIV_RNG_SYSTEM,
+                   node->game->performance.update_count, node->index);
+  civ_rng_t *prev = civ_rng_bind(&node->rng);
+  CIV_MEM_TAG_BEGIN(prev_tag, node->mem_tag);
+  node->desc->run(node->game, node->frame, span);
+  CIV_MEM_TAG_END(prev_tag);
+  civ_frame_trace_count(CIV_FRAME_SIM_PHASES, 1);
+  civ_rng_bind(prev);
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+static const char *node_get_name(const void *system) {
+  return ((const civ_game_system_node_t *)system)->desc->name;
+}
+
+static bool node_is_enabled(const void *system) {
+  return ((const civ_game_system_node_t *)system)->enabled;
+}
+
+static void node_set_enabled(void *system, bool enabled) {
+  ((civ_game_system_node_t *)system)->enabled = enabled;
+}
+
+/* ── Wake triggers ────────────────────────────────────────────────── */
+static const struct {
+  civ_event_type_t type;
+  const char      *systems[3];
+} g_wake_table[] = {
+  {CIV_EVENT_TYPE_MILITARY,  {"war_economy", "conquest", NULL}},
+  {CIV_EVENT_TYPE_NATURAL,   {"disasters", NULL}},
+  {CIV_EVENT_TYPE_ECONOMIC,  {"black_market", NULL}},
+  {CIV_EVENT_TYPE_POLITICAL, {"black_market", NULL}},
+};
+
+#define CIV_WAKE_TABLE_COUNT (sizeof(g_wake_table) / sizeof(g_wake_table[0]))
+
+static void wake_on_event(const civ_game_event_t *event, void *user_data) {
+  civ_game_t *game = (civ_game_t *)user_data;
+  for (size_t i = 0; i < CIV_WAKE_TABLE_COUNT; i++) {
+    if (g_wake_table[i].type != event->type) continue;
+    for (size_t k = 0; k < 3 && g_wake_table[i].systems[k]; k++)
+      civ_game_systems_wake(game, g_wake_table[i].systems[k]);
+  }
+}
+
+static civ_game_system_node_t *find_node(const civ_game_t *game,
+                                         const char *name) {
+  if (!game || !game->system_graph || !name) return NULL;
+  civ_game_systems_t *gs = (civ_game_systems_t *)game->system_graph;
+  for (size_t i = 0; i < gs->node_count; i++)
+    if (strcmp(gs->nodes[i].desc->name, name) == 0) return &gs->nodes[i];
+  return NULL;
+}
+
+/* ── Public API ───────────────────────────────────────────────────── */
+civ_result_t civ_game_systems_register(civ_game_t *game) {
+  if (!game || !game->system_orchestrator)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "No system orchestrator"};
+  if (game->system_graph)
+    return (civ_result_t){CIV_ERROR_INVALID_STATE, "Systems already registered"};
+
+  civ_game_systems_t *gs = CIV_CALLOC(1, sizeof(*gs));
+  if (!gs) return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Game systems"};
+  gs->nodes = CIV_CALLOC(CIV_GAME_SYSTEM_COUNT, sizeof(civ_game_system_node_t));
+  if (!gs->nodes) {
+    CIV_FREE(gs);
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Game systems"};
+  }
+  gs->node_count = CIV_GAME_SYSTEM_COUNT;
+  frame_reset(&gs->frame);
+  game->system_graph = gs;
+
+  for (size_t i = 0; i < CIV_GAME_SYSTEM_COUNT; i++) {
+    const civ_game_system_desc_t *desc = &g_system_table[i];
+    civ_game_system_node_t *node = &gs->nodes[i];
+    node->desc = desc;
+    node->game = game;
+    node->frame = &gs->frame;
+    node->index = i;
+    node->mem_tag = system_mem_tag(desc->name);
+    node->enabled = true;
+    node->activity = CIV_SYSTEM_FULL;
+
+    size_t dep_count = 0;
+    while (dep_count < CIV_GAME_SYSTEM_MAX_DEPS && desc->deps[dep_count])
+      dep_count++;
+
+    civ_updatable_t upd = {0};
+    upd.system      = node;
+    upd.update      = node_update;
+    upd.get_name    = node_get_name;
+    upd.is_enabled  = node_is_enabled;
+    upd.set_enabled = node_set_enabled;
+    civ_result_t r = civ_system_orchestrator_register(
+        game->system_orchestrator, desc->name, &upd, (const char **)desc->deps, dep_count);
+    if (CIV_FAILED(r)) return r;
+  }
+
+  civ_result_t order = civ_system_orchestrator_calculate_order(game->system_orchestrator);
+  if (CIV_FAILED(order)) return order;
+
+  if (game->event_manager) {
+    for (size_t i = 0; i < CIV_WAKE_TABLE_COUNT; i++)
+      civ_event_manager_register_handler(game->event_manager,
+                                         g_wake_table[i].type, wake_on_event,
+                                         game);
+  }
+
+  /* Independent nodes run concurrently; one lane per core by default */
+  civ_system_orchestrator_set_parallel(game->system_orchestrator,
+                                       game->max_workers != 1, game->max_workers);
+  printf("[GAME] %zu systems scheduled (%s, %u workers)\n",
+         gs->node_count,
+         game->system_orchestrator->parallel_execution ? "parallel" : "serial",
+         game->system_orchestrator->max_workers);
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+civ_result_t civ_game_systems_update(civ_game_t *game, civ_float_t dt) {
+  if (!game || !game->system_orchestrator || !game->system_graph)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Systems not registered"};
+  civ_game_systems_t *gs = (civ_game_systems_t *)game->system_graph;
+  frame_reset(&gs->frame);
+  /* Paths asked for last tick were solved in between; their callbacks run
+     before any system does */
+  civ_path_service_apply(game->path_service);
+  /* Events raised by systems reach their handlers once every system has
+     run, so no handler sees a half-updated world */
+  civ_event_manager_defer(game->event_manager);
+  civ_result_t r = civ_system_orchestrator_update_all(game->system_orchestrator, dt);
+  civ_event_manager_dispatch_deferred(game->event_manager);
+  /* The map holds still until the next tick: solve this tick's queries,
+     and plan the next tick's fiscal policies while the sim waits */
+  civ_worker_pool_t *pool =
+      civ_system_orchestrator_get_worker_pool(game->system_orchestrator);
+  civ_path_service_kick(game->path_service, pool);
+  civ_nation_speculate_fiscal_policy(
+      (civ_nation_manager_t *)game->nation_manager, pool);
+  return r;
+}
+
+void civ_game_systems_wake(civ_game_t *game, const char *name) {
+  civ_game_system_node_t *node = find_node(game, name);
+  if (node)
+    node->awake_until = game->performance.update_count + CIV_SYSTEM_WAKE_TICKS;
+}
+
+civ_system_activity_t civ_game_systems_activity(const civ_game_t *game,
+                                                const char *name) {
+  civ_game_system_node_t *node = find_node(game, name);
+  return node ? node->activity : CIV_SYSTEM_FULL;
+}
+
+void civ_game_systems_destroy(civ_game_t *game) {
+  if (!game || !game->system_graph) return;
+  civ_game_systems_t *gs = (civ_game_systems_t *)game->system_graph;
+  CIV_FREE(gs->nodes);
+  CIV_FREE(gs->nation_scratch);
+  CIV_FREE(gs);
+  game->system_graph = NULL;
+}
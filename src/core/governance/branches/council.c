@@ -1,5 +1,6 @@
 #include "core/governance/branches/council.h"
 #include "common.h"
+#include "utils/rng.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
@@ -40,7 +41,7 @@ void civ_council_update(civ_council_t *c, float dt,
   /* Internal cohesion: tradition binds, corruption divides */
   float cohesion_target = tradition * 0.3f + legitimacy * 0.3f
                           + (1.0f - corruption) * 0.2f + 0.2f;
-  c->internal_cohesion += (cohesion_target - c->internal_cohesion) * 0.05f * dt;
+  c->internal_cohesion += (cohesion_target - c->internal_cohesion) * civ_compound(0.05f, dt);
 
   /* Collective strength: member count * avg power * cohesion */
   c->collective_strength = 0.0f;
@@ -72,8 +73,8 @@ civ_council_member_t *civ_council_add_member(civ_council_t *c, const char *name,
   strncpy(m->name, name, STRING_MEDIUM_LEN - 1);
   if (npc_id) strncpy(m->member_id, npc_id, STRING_SHORT_LEN - 1);
   m->power_share = power_share;
-  m->competence = 0.40f + (float)(rand() % 40) / 100.0f;
-  m->loyalty = 0.50f + (float)(rand() % 30) / 100.0f;
+  m->competence = 0.40f + (float)(civ_rand() % 40) / 100.0f;
+  m->loyalty = 0.50f + (float)(civ_rand() % 30) / 100.0f;
   c->member_count++;
   return m;
 }
@@ -8,9 +8,7 @@
 #include <stdlib.h>
 #include <string.h>
 
-civ_executive_t *civ_executive_create(void) {
-  civ_executive_t *e = CIV_MALLOC(sizeof(civ_executive_t));
-  if (!e) return NULL;
+void civ_executive_init(civ_executive_t *e) {
   memset(e, 0, sizeof(*e));
   e->action_capacity = 8;
   e->actions = CIV_MALLOC(sizeof(civ_executive_action_t) * e->action_capacity);
@@ -18,12 +16,23 @@ civ_executive_t *civ_executive_create(void) {
   e->political_capital = 0.60f;
   e->decree_power = 0.20f;
   e->veto.veto_power = 0.50f;
+}
+
+civ_executive_t *civ_executive_create(void) {
+  civ_executive_t *e = CIV_MALLOC(sizeof(civ_executive_t));
+  if (!e) return NULL;
+  civ_executive_init(e);
   return e;
 }
 
-void civ_executive_destroy(civ_executive_t *e) {
+void civ_executive_free(civ_executive_t *e) {
   if (!e) return;
   free(e->actions);
+}
+
+void civ_executive_destroy(civ_executive_t *e) {
+  if (!e) return;
+  civ_executive_free(e);
   free(e);
 }
 
@@ -110,11 +119,15 @@ bool civ_executive_veto_bill(civ_executive_t *e, const char *bill_id) {
   return true;
 }
 
+float civ_executive_override_threshold(const civ_executive_t *e) {
+  if (!e) return 0.0f;
+  /* Override requires support > veto_power threshold */
+  return 0.50f + e->veto.veto_power * 0.35f;
+}
+
 bool civ_executive_override_possible(const civ_executive_t *e, float legislative_support) {
   if (!e) return true; /* no executive = no veto */
-  /* Override requires support > veto_power threshold */
-  float override_threshold = 0.50f + e->veto.veto_power * 0.35f;
-  return legislative_support > override_threshold;
+  return legislative_support > civ_executive_override_threshold(e);
 }
 
 void civ_executive_sign_bill(civ_executive_t *e) {
@@ -4,13 +4,12 @@
  */
 #include "core/governance/branches/judiciary.h"
 #include "common.h"
+#include "utils/rng.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
-civ_judiciary_t *civ_judiciary_create(void) {
-  civ_judiciary_t *j = CIV_MALLOC(sizeof(civ_judiciary_t));
-  if (!j) return NULL;
+void civ_judiciary_init(civ_judiciary_t *j) {
   memset(j, 0, sizeof(*j));
   j->court_capacity = 4;
   j->courts = CIV_MALLOC(sizeof(civ_court_t) * j->court_capacity);
@@ -19,13 +18,24 @@ civ_judiciary_t *civ_judiciary_create(void) {
   j->rule_of_law = 0.55;
   j->judicial_independence = 0.45;
   j->due_process_index = 0.50;
+}
+
+civ_judiciary_t *civ_judiciary_create(void) {
+  civ_judiciary_t *j = CIV_MALLOC(sizeof(civ_judiciary_t));
+  if (!j) return NULL;
+  civ_judiciary_init(j);
   return j;
 }
 
-void civ_judiciary_destroy(civ_judiciary_t *j) {
+void civ_judiciary_free(civ_judiciary_t *j) {
   if (!j) return;
   free(j->courts);
   free(j->cases);
+}
+
+void civ_judiciary_destroy(civ_judiciary_t *j) {
+  if (!j) return;
+  civ_judiciary_free(j);
   free(j);
 }
 
@@ -36,7 +46,7 @@ void civ_judiciary_update(civ_judiciary_t *j, float dt,
 
   /* Judicial independence: representation supports it, centralization undermines it */
   float target_independence = 0.30f + representation * 0.40f - centralization * 0.20f;
-  j->judicial_independence += (target_independence - j->judicial_independence) * 0.03f * dt;
+  j->judicial_independence += (target_independence - j->judicial_independence) * civ_compound(0.03f, dt);
 
   /* Corruption erodes judicial integrity */
   j->judicial_independence -= corruption * 0.02f * dt;
@@ -50,7 +60,7 @@ void civ_judiciary_update(civ_judiciary_t *j, float dt,
     c->efficiency = gov_efficiency * (1.0f - corruption * 0.5f) - c->backlog * 0.001f;
     if (c->efficiency < 0.05f) c->efficiency = 0.05f;
     c->public_trust += (j->judicial_independence * 0.3f + (1.0f - corruption) * 0.3f
-                        - c->backlog * 0.0001f - c->public_trust) * 0.05f * dt;
+                        - c->backlog * 0.0001f - c->public_trust) * civ_compound(0.05f, dt);
   }
 
   /* Process cases */
@@ -64,7 +74,7 @@ void civ_judiciary_update(civ_judiciary_t *j, float dt,
 
   /* Due process: representation + independence - backlog */
   j->due_process_index += (representation * 0.3f + j->judicial_independence * 0.2f
-                           - j->due_process_index) * 0.04f * dt;
+                           - j->due_process_index) * civ_compound(0.04f, dt);
 }
 
 civ_court_t *civ_judiciary_create_court(civ_judiciary_t *j, const char *name,
@@ -114,11 +124,11 @@ civ_case_t *civ_judiciary_file_case(civ_judiciary_t *j, civ_case_type_t type,
 
 void civ_judiciary_process_docket(civ_judiciary_t *j, float dt) {
   if (!j) return;
-  (void)dt;
+  int days = MAX(1, (int)lroundf(dt));
 
   for (int i = 0; i < j->case_count; i++) {
     civ_case_t *cs = &j->cases[i];
-    cs->age_days++;
+    cs->age_days += days;
 
     /* Dismiss old unresolved cases */
     if (cs->age_days > 100 && cs->status == CIV_CASE_FILED) {
@@ -142,14 +152,14 @@ void civ_judiciary_process_docket(civ_judiciary_t *j, float dt) {
       if (cs->type == CIV_CASE_CONSTITUTIONAL)
         resolve_chance *= 0.5f; /* constitutional cases take longer */
 
-      if ((float)rand() / RAND_MAX < resolve_chance) {
+      if ((float)civ_rand() / RAND_MAX < civ_compound(resolve_chance, dt)) {
         cs->status = CIV_CASE_DECIDED;
         j->precedents_set++;
         best_court->backlog += 1.0f;
 
         /* Constitutional cases: may strike down laws */
         if (cs->type == CIV_CASE_CONSTITUTIONAL && civ_judiciary_can_strike_law(j)) {
-          if ((float)rand() / RAND_MAX < j->judicial_independence * 0.5f) {
+          if ((float)civ_rand() / RAND_MAX < j->judicial_independence * 0.5f) {
             cs->struck_down_law = true;
             j->laws_struck_down++;
             snprintf(cs->ruling_summary, STRING_MEDIUM_LEN, "Struck down: %s",
@@ -4,33 +4,65 @@
  */
 
 #include "core/governance/branches/legislative.h"
+#include <ctype.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
+/* Yes share a bill must beat under a voting method */
+static civ_float_t pass_share_of(const civ_legislative_body_t *body) {
+  switch (body->voting_method) {
+  case CIV_VOTE_METHOD_SUPER_MAJORITY:
+    return body->custom_threshold > 0.5f ? body->custom_threshold
+                                         : 2.0f / 3.0f;
+  case CIV_VOTE_METHOD_UNANIMOUS:
+    return 1.0f;
+  default:
+    return 0.5f;
+  }
+}
+
+/* Active bill named by id, -1 if none: ids are bill_<number> */
+static int32_t find_bill_id(const civ_legislative_manager_t *manager,
+                            const char *bill_id) {
+  if (strncmp(bill_id, "bill_", 5) != 0 || !isdigit((unsigned char)bill_id[5]))
+    return -1;
+  char *end = NULL;
+  unsigned long number = strtoul(bill_id + 5, &end, 10);
+  if (*end || number > UINT32_MAX)
+    return -1;
+  return civ_legislative_find_bill(manager, (uint32_t)number);
+}
+
+void civ_legislative_manager_init(civ_legislative_manager_t *manager) {
+  memset(manager, 0, sizeof(*manager));
+}
+
 civ_legislative_manager_t *civ_legislative_manager_create(void) {
   civ_legislative_manager_t *manager =
       CIV_MALLOC(sizeof(civ_legislative_manager_t));
-  if (manager) {
-    manager->bodies = NULL;
-    manager->body_count = 0;
-    manager->body_capacity = 0;
-
-    manager->active_bills = NULL;
-    manager->bill_count = 0;
-    manager->bill_capacity = 0;
-  }
+  if (manager)
+    civ_legislative_manager_init(manager);
   return manager;
 }
 
-void civ_legislative_manager_destroy(civ_legislative_manager_t *manager) {
+void civ_legislative_manager_free(civ_legislative_manager_t *manager) {
   if (manager) {
+    for (size_t i = 0; i < manager->body_count; i++)
+      CIV_FREE(manager->bodies[i].seat_ideology);
     CIV_FREE(manager->bodies);
     // Deep clean bills if needed (free proposed_rule)
     for (size_t i = 0; i < manager->bill_count; i++) {
       civ_rule_destroy(manager->active_bills[i].proposed_rule);
     }
     CIV_FREE(manager->active_bills);
+  }
+}
+
+void civ_legislative_manager_destroy(civ_legislative_manager_t *manager) {
+  if (manager) {
+    civ_legislative_manager_free(manager);
     CIV_FREE(manager);
   }
 }
@@ -39,18 +71,18 @@ civ_legislative_body_t *civ_legislative_body_create(const char *name,
                                                     const char *required_role) {
   civ_legislative_body_t *body = CIV_MALLOC(sizeof(civ_legislative_body_t));
   if (body) {
+    memset(body, 0, sizeof(*body));
     snprintf(body->id, STRING_SHORT_LEN, "leg_%ld", (long)time(NULL));
     strncpy(body->name, name, STRING_MEDIUM_LEN - 1);
 
     if (required_role)
       strncpy(body->required_role, required_role, STRING_SHORT_LEN - 1);
-    else
-      memset(body->required_role, 0, STRING_SHORT_LEN);
 
     body->member_count = 0;
     body->session_type = CIV_SESSION_LEGISLATIVE;
     body->voting_method = CIV_VOTE_METHOD_SIMPLE_MAJORITY;
     body->custom_threshold = 0.5f;
+    body->pass_share = pass_share_of(body);
     body->in_session = true;
     body->next_session = 0;
   }
@@ -74,42 +106,114 @@ civ_legislative_manager_add_body(civ_legislative_manager_t *manager,
     manager->body_capacity = new_cap;
   }
 
-  manager->bodies[manager->body_count++] = *body;
+  civ_legislative_body_t *added = &manager->bodies[manager->body_count++];
+  *added = *body;
+  added->pass_share = pass_share_of(added);
   // Note: body pointer passed in is now copied, caller should free container if
-  // malloced
+  // malloced (its seats now belong to the manager)
   return (civ_result_t){CIV_OK, "Body added"};
 }
 
-civ_result_t civ_legislative_propose_bill(civ_legislative_manager_t *manager,
-                                          const char *body_id, civ_rule_t *rule,
-                                          bool repeal) {
-  if (!manager || !body_id || !rule)
+civ_result_t civ_legislative_apportion(civ_legislative_manager_t *manager,
+                                       size_t body, int seats,
+                                       const float government[CIV_LEGISLATIVE_AXES],
+                                       float government_share,
+                                       float opposition_share) {
+  if (!manager || !government || body >= manager->body_count || seats <= 0)
     return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Invalid args"};
 
+  civ_legislative_body_t *b = &manager->bodies[body];
+  if (seats != b->seat_count) {
+    float *grown = CIV_REALLOC(b->seat_ideology, (size_t)seats *
+                                                     CIV_LEGISLATIVE_AXES *
+                                                     sizeof(float));
+    if (!grown)
+      return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
+    b->seat_ideology = grown;
+    b->seat_count = seats;
+  }
+
+  int ins = (int)(seats * government_share);
+  int outs = (int)(seats * opposition_share);
+  ins = CLAMP(ins, 0, seats);
+  outs = CLAMP(outs, 0, seats - ins);
+  for (int i = 0; i < seats; i++) {
+    float side = i < ins ? 1.0f : i < ins + outs ? -1.0f : 0.0f;
+    for (int k = 0; k < CIV_LEGISLATIVE_AXES; k++)
+      b->seat_ideology[i * CIV_LEGISLATIVE_AXES + k] = side * government[k];
+  }
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+int32_t civ_legislative_queue_bill(civ_legislative_manager_t *manager,
+                                   int body, civ_rule_t *rule, bool repeal,
+                                   const float position[CIV_LEGISLATIVE_AXES]) {
+  if (!manager || !rule || body >= (int)manager->body_count)
+    return -1;
+
   if (manager->bill_count >= manager->bill_capacity) {
     size_t new_cap =
         manager->bill_capacity == 0 ? 8 : manager->bill_capacity * 2;
     civ_bill_t *new_bills =
         CIV_REALLOC(manager->active_bills, new_cap * sizeof(civ_bill_t));
     if (!new_bills)
-      return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
+      return -1;
     manager->active_bills = new_bills;
     manager->bill_capacity = new_cap;
   }
 
-  civ_bill_t *bill = &manager->active_bills[manager->bill_count++];
-  snprintf(bill->id, STRING_SHORT_LEN, "bill_%ld", (long)time(NULL));
+  /* Numbers count up within the legislature, so they are the same in
+     every replay and need nothing process-wide */
+  int32_t index = (int32_t)manager->bill_count++;
+  civ_bill_t *bill = &manager->active_bills[index];
+  memset(bill, 0, sizeof(*bill));
+  bill->number = manager->bills_proposed++;
+  snprintf(bill->id, sizeof(bill->id), "bill_%u", bill->number);
   snprintf(bill->title, STRING_MEDIUM_LEN, "%s %s", repeal ? "Repeal" : "Enact",
            rule->name);
+  bill->body = body < 0 ? -1 : body;
+  if (position)
+    memcpy(bill->position, position, sizeof(bill->position));
 
   bill->proposed_rule = rule; // Takes ownership
   bill->is_repeal = repeal;
-  bill->votes_yes = 0;
-  bill->votes_no = 0;
-  bill->votes_abstain = 0;
-  bill->resolved = false;
-  bill->passed = false;
+  return index;
+}
+
+int32_t civ_legislative_find_bill(const civ_legislative_manager_t *manager,
+                                  uint32_t number) {
+  if (!manager)
+    return -1;
+  size_t lo = 0, hi = manager->bill_count;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    uint32_t at = manager->active_bills[mid].number;
+    if (at == number)
+      return (int32_t)mid;
+    if (at < number)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return -1;
+}
 
+civ_result_t civ_legislative_propose_bill(civ_legislative_manager_t *manager,
+                                          const char *body_id, civ_rule_t *rule,
+                                          bool repeal) {
+  if (!manager || !body_id || !rule)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Invalid args"};
+
+  int body = -1;
+  for (size_t i = 0; i < manager->body_count; i++) {
+    if (strcmp(manager->bodies[i].id, body_id) == 0) {
+      body = (int)i;
+      break;
+    }
+  }
+
+  if (civ_legislative_queue_bill(manager, body, rule, repeal, NULL) < 0)
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
   return (civ_result_t){CIV_OK, "Bill proposed"};
 }
 
@@ -118,18 +222,44 @@ civ_result_t civ_legislative_cast_vote(civ_legislative_manager_t *manager,
   if (!manager || !bill_id)
     return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Invalid args"};
 
-  for (size_t i = 0; i < manager->bill_count; i++) {
-    if (strcmp(manager->active_bills[i].id, bill_id) == 0) {
-      if (vote > 0)
-        manager->active_bills[i].votes_yes++;
-      else if (vote < 0)
-        manager->active_bills[i].votes_no++;
-      else
-        manager->active_bills[i].votes_abstain++;
-      return (civ_result_t){CIV_OK, "Vote cast"};
-    }
+  int32_t i = find_bill_id(manager, bill_id);
+  if (i < 0)
+    return (civ_result_t){CIV_ERROR_NOT_FOUND, "Bill not found"};
+
+  if (vote > 0)
+    manager->active_bills[i].votes_yes++;
+  else if (vote < 0)
+    manager->active_bills[i].votes_no++;
+  else
+    manager->active_bills[i].votes_abstain++;
+  return (civ_result_t){CIV_OK, "Vote cast"};
+}
+
+/* Whether the tally carries the bill in its body */
+static bool bill_carries(const civ_legislative_manager_t *manager,
+                         const civ_bill_t *bill, bool leader_yes) {
+  const civ_legislative_body_t *body =
+      bill->body >= 0 ? &manager->bodies[bill->body] : NULL;
+  if (body && body->voting_method == CIV_VOTE_METHOD_ABSOLUTE_AUTHORITY)
+    return leader_yes;
+
+  int total_votes = bill->votes_yes + bill->votes_no;
+  if (total_votes == 0)
+    return false;
+  float share = (float)bill->votes_yes / total_votes;
+  if (body && body->voting_method == CIV_VOTE_METHOD_UNANIMOUS)
+    return bill->votes_no == 0;
+  return share > (body ? body->pass_share : 0.5f);
+}
+
+/* Write a carried bill into the constitution */
+static void enact(civ_bill_t *bill, civ_constitution_t *target_constitution) {
+  bill->passed = true;
+  if (bill->is_repeal) {
+    civ_constitution_remove_rule(target_constitution, bill->proposed_rule->id);
+  } else {
+    civ_constitution_add_rule(target_constitution, bill->proposed_rule);
   }
-  return (civ_result_t){CIV_ERROR_NOT_FOUND, "Bill not found"};
 }
 
 civ_result_t
@@ -139,31 +269,96 @@ civ_legislative_resolve_bill(civ_legislative_manager_t *manager,
   if (!manager || !bill_id || !target_constitution)
     return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Invalid args"};
 
+  int32_t i = find_bill_id(manager, bill_id);
+  if (i < 0)
+    return (civ_result_t){CIV_ERROR_NOT_FOUND, "Bill not found"};
+
+  civ_bill_t *bill = &manager->active_bills[i];
+  if (bill->resolved)
+    return (civ_result_t){CIV_ERROR_INVALID_STATE, "Already resolved"};
+
+  if (bill_carries(manager, bill, bill->votes_yes > bill->votes_no))
+    enact(bill, target_constitution);
+  else
+    bill->passed = false;
+
+  bill->resolved = true;
+  return (civ_result_t){CIV_OK, bill->passed ? "Bill passed" : "Bill failed"};
+}
+
+/* Seats' votes on a bill: leanings are seats x position */
+static bool tally(const civ_legislative_body_t *body, civ_bill_t *bill) {
+  bool leader_yes = false;
+  const float *seat = body->seat_ideology;
+  for (int i = 0; i < body->seat_count; i++, seat += CIV_LEGISLATIVE_AXES) {
+    float lean = 0.0f;
+    for (int k = 0; k < CIV_LEGISLATIVE_AXES; k++)
+      lean += seat[k] * bill->position[k];
+    bill->votes_yes += lean > CIV_LEGISLATIVE_ABSTAIN_BAND;
+    bill->votes_no += lean < -CIV_LEGISLATIVE_ABSTAIN_BAND;
+    bill->votes_abstain += lean >= -CIV_LEGISLATIVE_ABSTAIN_BAND &&
+                           lean <= CIV_LEGISLATIVE_ABSTAIN_BAND;
+    if (i == 0)
+      leader_yes = lean > CIV_LEGISLATIVE_ABSTAIN_BAND;
+  }
+  return leader_yes;
+}
+
+size_t civ_legislative_run_session(civ_legislative_manager_t *manager,
+                                   civ_executive_t *executive,
+                                   civ_constitution_t *target_constitution) {
+  if (!manager || !target_constitution)
+    return 0;
+
+  /* The override bar is the same for every bill this session */
+  float override_share =
+      executive ? civ_executive_override_threshold(executive) : 0.0f;
+  size_t enacted = 0;
+
   for (size_t i = 0; i < manager->bill_count; i++) {
     civ_bill_t *bill = &manager->active_bills[i];
-    if (strcmp(bill->id, bill_id) == 0) {
-      if (bill->resolved)
-        return (civ_result_t){CIV_ERROR_INVALID_STATE, "Already resolved"};
-
-      // Simple majority check for now. Real logic would use body's voting
-      // method.
-      int total_votes = bill->votes_yes + bill->votes_no;
-      if (total_votes > 0 && (float)bill->votes_yes / total_votes > 0.5f) {
-        bill->passed = true;
-        if (bill->is_repeal) {
-          civ_constitution_remove_rule(target_constitution,
-                                       bill->proposed_rule->id);
-        } else {
-          civ_constitution_add_rule(target_constitution, bill->proposed_rule);
+    if (bill->resolved)
+      continue;
+
+    bool leader_yes = bill->votes_yes > bill->votes_no;
+    if (bill->body >= 0 && manager->bodies[bill->body].seat_count > 0)
+      leader_yes = tally(&manager->bodies[bill->body], bill);
+    bill->resolved = true;
+    if (!bill_carries(manager, bill, leader_yes))
+      continue;
+
+    if (executive) {
+      executive->veto.bills_awaiting_signature++;
+      float approval = 0.0f;
+      for (int k = 0; k < CIV_LEGISLATIVE_AXES; k++)
+        approval += manager->leader[k] * bill->position[k];
+      if (approval < -CIV_LEGISLATIVE_ABSTAIN_BAND) {
+        civ_executive_veto_bill(executive, bill->id);
+        bill->vetoed = true;
+        int total_votes = bill->votes_yes + bill->votes_no;
+        if ((float)bill->votes_yes / total_votes <= override_share) {
+          executive->veto.vetoes_sustained++;
+          continue;
         }
+        executive->veto.vetoes_overridden++;
       } else {
-        bill->passed = false;
+        civ_executive_sign_bill(executive);
       }
+    }
+    enact(bill, target_constitution);
+    enacted++;
+  }
 
-      bill->resolved = true;
-      return (civ_result_t){CIV_OK,
-                            bill->passed ? "Bill passed" : "Bill failed"};
+  /* Drop the resolved bills; the constitution holds its own copy */
+  size_t kept = 0;
+  for (size_t i = 0; i < manager->bill_count; i++) {
+    civ_bill_t *bill = &manager->active_bills[i];
+    if (bill->resolved) {
+      civ_rule_destroy(bill->proposed_rule);
+      continue;
     }
+    manager->active_bills[kept++] = *bill;
   }
-  return (civ_result_t){CIV_ERROR_NOT_FOUND, "Bill not found"};
+  manager->bill_count = kept;
+  return enacted;
 }
@@ -37,7 +37,7 @@ void civ_religious_body_update(civ_religious_body_t *r, float dt,
 
   /* Spiritual authority from trait + tradition */
   r->spiritual_authority += (religious_authority_trait * 0.5f + tradition * 0.3f
-                             - r->spiritual_authority) * 0.03f * dt;
+                             - r->spiritual_authority) * civ_compound(0.03f, dt);
 
   /* Political influence: spiritual authority translated into secular power */
   r->political_influence = r->spiritual_authority * 0.7f
@@ -47,7 +47,7 @@ void civ_religious_body_update(civ_religious_body_t *r, float dt,
 
   /* Doctrinal rigidity: tradition + authority, reduced by representation */
   r->doctrinal_rigidity += (tradition * 0.5f + r->spiritual_authority * 0.3f
-                            - representation * 0.2f - r->doctrinal_rigidity) * 0.04f * dt;
+                            - representation * 0.2f - r->doctrinal_rigidity) * civ_compound(0.04f, dt);
   if (r->doctrinal_rigidity < 0.10f) r->doctrinal_rigidity = 0.10f;
   if (r->doctrinal_rigidity > 0.95f) r->doctrinal_rigidity = 0.95f;
 
@@ -69,7 +69,7 @@ void civ_religious_body_update(civ_religious_body_t *r, float dt,
 
   /* Update leader piety */
   for (int i = 0; i < r->leader_count; i++) {
-    r->leaders[i].piety += (r->spiritual_authority - r->leaders[i].piety) * 0.02f * dt;
+    r->leaders[i].piety += (r->spiritual_authority - r->leaders[i].piety) * civ_compound(0.02f, dt);
     /* Corrupt leaders lose piety */
     r->leaders[i].piety -= corruption * (1.0f - r->leaders[i].piety) * 0.01f * dt;
   }
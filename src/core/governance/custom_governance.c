@@ -10,6 +10,102 @@
 #include <string.h>
 #include <time.h>
 
+/* Evolution state, as a government holds it and as the manager's columns
+   hold it for one index; the rules below are written once against it */
+typedef struct {
+  civ_float_t centralization;
+  civ_float_t democracy_level;
+  civ_float_t corruption;
+  civ_float_t stability;
+  civ_float_t efficiency;
+  civ_float_t political_tension;
+} lane_t;
+
+static lane_t lane_of_government(const civ_custom_governance_t *gov) {
+  return (lane_t){gov->centralization, gov->democracy_level, gov->corruption,
+                  gov->stability,      gov->efficiency,      gov->political_tension};
+}
+
+static void lane_to_government(const lane_t *l, civ_custom_governance_t *gov) {
+  gov->centralization = l->centralization;
+  gov->democracy_level = l->democracy_level;
+  gov->corruption = l->corruption;
+  gov->stability = l->stability;
+  gov->efficiency = l->efficiency;
+  gov->political_tension = l->political_tension;
+}
+
+static lane_t lane_load(const civ_custom_governance_manager_t *m, size_t i) {
+  return (lane_t){m->centralization[i], m->democracy_level[i], m->corruption[i],
+                  m->stability[i],      m->efficiency[i],      m->political_tension[i]};
+}
+
+static void lane_store(civ_custom_governance_manager_t *m, size_t i,
+                       const lane_t *l) {
+  m->centralization[i] = l->centralization;
+  m->democracy_level[i] = l->democracy_level;
+  m->corruption[i] = l->corruption;
+  m->stability[i] = l->stability;
+  m->efficiency[i] = l->efficiency;
+  m->political_tension[i] = l->political_tension;
+}
+
+static civ_float_t roles_efficiency(const civ_custom_governance_t *gov) {
+  if (gov->role_count == 0)
+    return 0.1f; // No roles defined? Low efficiency
+  civ_float_t sum = 0.0f;
+  for (size_t i = 0; i < gov->role_count; i++) {
+    sum += gov->roles[i].responsibility * gov->roles[i].authority;
+  }
+  return sum / (civ_float_t)gov->role_count;
+}
+
+static void lane_update(lane_t *gov, civ_float_t role_efficiency,
+                        civ_float_t time_delta);
+static void lane_evolve(lane_t *gov, civ_float_t time_delta);
+static uint8_t lane_name_key(const lane_t *gov);
+
+#define GROW_COLUMN(field, cap)                                                \
+  do {                                                                         \
+    void *grown = CIV_REALLOC(manager->field, (cap) * sizeof(*manager->field)); \
+    if (!grown)                                                                \
+      return false;                                                            \
+    manager->field = grown;                                                    \
+  } while (0)
+
+static bool reserve_governments(civ_custom_governance_manager_t *manager,
+                                size_t cap) {
+  if (cap <= manager->government_capacity)
+    return true;
+  GROW_COLUMN(governments, cap);
+  GROW_COLUMN(centralization, cap);
+  GROW_COLUMN(democracy_level, cap);
+  GROW_COLUMN(corruption, cap);
+  GROW_COLUMN(stability, cap);
+  GROW_COLUMN(efficiency, cap);
+  GROW_COLUMN(political_tension, cap);
+  GROW_COLUMN(role_efficiency, cap);
+  GROW_COLUMN(title_key, cap);
+  manager->government_capacity = cap;
+  return true;
+}
+
+static bool reserve_lookup(civ_custom_governance_manager_t *manager,
+                           civ_symbol_t id) {
+  if (id < manager->government_of_size)
+    return true;
+  uint32_t size = MAX(civ_symbol_count(), id + 1);
+  int32_t *government_of =
+      CIV_REALLOC(manager->government_of, size * sizeof(int32_t));
+  if (!government_of)
+    return false;
+  for (uint32_t k = manager->government_of_size; k < size; k++)
+    government_of[k] = -1;
+  manager->government_of = government_of;
+  manager->government_of_size = size;
+  return true;
+}
+
 civ_custom_governance_manager_t *civ_custom_governance_manager_create(void) {
   civ_custom_governance_manager_t *manager =
       (civ_custom_governance_manager_t *)CIV_MALLOC(
@@ -32,6 +128,15 @@ void civ_custom_governance_manager_destroy(
     civ_custom_governance_destroy(&manager->governments[i]);
   }
   CIV_FREE(manager->governments);
+  CIV_FREE(manager->centralization);
+  CIV_FREE(manager->democracy_level);
+  CIV_FREE(manager->corruption);
+  CIV_FREE(manager->stability);
+  CIV_FREE(manager->efficiency);
+  CIV_FREE(manager->political_tension);
+  CIV_FREE(manager->role_efficiency);
+  CIV_FREE(manager->title_key);
+  CIV_FREE(manager->government_of);
   CIV_FREE(manager);
 }
 
@@ -41,9 +146,7 @@ void civ_custom_governance_manager_init(
     return;
 
   memset(manager, 0, sizeof(civ_custom_governance_manager_t));
-  manager->government_capacity = 32;
-  manager->governments = (civ_custom_governance_t *)CIV_CALLOC(
-      manager->government_capacity, sizeof(civ_custom_governance_t));
+  reserve_governments(manager, 32);
 }
 
 civ_custom_governance_t *civ_custom_governance_create(const char *id,
@@ -60,6 +163,7 @@ civ_custom_governance_t *civ_custom_governance_create(const char *id,
 
   memset(gov, 0, sizeof(civ_custom_governance_t));
   strncpy(gov->id, id, sizeof(gov->id) - 1);
+  gov->id_sym = civ_symbol_intern(gov->id);
   strncpy(gov->name, name, sizeof(gov->name) - 1);
   gov->centralization = 0.5f;
   gov->democracy_level = 0.3f;
@@ -72,6 +176,7 @@ civ_custom_governance_t *civ_custom_governance_create(const char *id,
       gov->role_capacity, sizeof(civ_governance_role_t));
 
   gov->party_system = CIV_PARTY_NONE;
+  civ_custom_governance_generate_name(gov, gov->title, sizeof(gov->title));
 
   // Initialize default constitution
   gov->constitution = civ_constitution_create(name);
@@ -140,6 +245,8 @@ civ_result_t civ_custom_governance_reform(civ_custom_governance_t *gov,
   } else {
     gov->custom_rules = (char *)CIV_MALLOC(desc_len + 1);
     gov->custom_rules_size = 0;
+    if (gov->custom_rules)
+      gov->custom_rules[0] = '\0';
   }
 
   if (gov->custom_rules) {
@@ -193,18 +300,16 @@ civ_result_t civ_custom_governance_update(civ_custom_governance_t *gov,
     return result;
   }
 
-  /* Efficiency based on centralization and role distribution */
-  civ_float_t role_efficiency = 0.0f;
-  if (gov->role_count > 0) {
-    for (size_t i = 0; i < gov->role_count; i++) {
-      role_efficiency += gov->roles[i].responsibility * gov->roles[i].authority;
-    }
-    role_efficiency /= (civ_float_t)gov->role_count;
-  } else {
-    // No roles defined? Low efficiency
-    role_efficiency = 0.1f;
-  }
+  lane_t lane = lane_of_government(gov);
+  lane_update(&lane, roles_efficiency(gov), time_delta);
+  lane_to_government(&lane, gov);
+  return result;
+}
 
+/* Efficiency from centralization and role distribution, then stability
+   and the evolution rules */
+static void lane_update(lane_t *gov, civ_float_t role_efficiency,
+                        civ_float_t time_delta) {
   // Efficiency benefit from centralization, but capped by corruption if low
   // democracy
   civ_float_t central_eff = gov->centralization;
@@ -229,18 +334,21 @@ civ_result_t civ_custom_governance_update(civ_custom_governance_t *gov,
     stability_recovery -= 0.05f * time_delta;
   }
 
-  civ_custom_governance_evolve(gov, time_delta);
+  lane_evolve(gov, time_delta);
 
   gov->stability = CLAMP(gov->stability + stability_recovery, 0.0f, 1.0f);
-
-  return result;
 }
 
 void civ_custom_governance_evolve(civ_custom_governance_t *gov,
                                   civ_float_t time_delta) {
   if (!gov)
     return;
+  lane_t lane = lane_of_government(gov);
+  lane_evolve(&lane, time_delta);
+  lane_to_government(&lane, gov);
+}
 
+static void lane_evolve(lane_t *gov, civ_float_t time_delta) {
   // Corruption Growth:
   // Grows faster with high centralization if Democracy is low (no
   // checks/balances). Grows faster with low Stability (chaos).
@@ -293,47 +401,75 @@ void civ_custom_governance_evolve(civ_custom_governance_t *gov,
   gov->democracy_level = CLAMP(gov->democracy_level, 0.0f, 1.0f);
 }
 
-void civ_custom_governance_generate_name(civ_custom_governance_t *gov,
-                                         char *out_name, size_t max_len) {
-  if (!gov || !out_name)
-    return;
+/* Names: NAME_NOUNS x NAME_ADJECTIVES, key = noun * NAME_ADJECTIVES + adj */
+static const char *const g_name_nouns[] = {
+    "Empire", "Autocracy", "Union", "Commune", "Confederacy", "Republic", "State"};
+static const char *const g_name_adjectives[] = {"",        "Corrupt ",
+                                                "Fractured ", "Ordered ",
+                                                "Free "};
+#define NAME_NOUNS (sizeof(g_name_nouns) / sizeof(g_name_nouns[0]))
+#define NAME_ADJECTIVES (sizeof(g_name_adjectives) / sizeof(g_name_adjectives[0]))
 
-  const char *adj = "";
-  const char *noun = "Government";
+static uint8_t lane_name_key(const lane_t *gov) {
+  unsigned noun, adj = 0;
 
   // Noun selection
   if (gov->centralization > 0.8f) {
     if (gov->democracy_level < 0.2f)
-      noun = "Empire";
+      noun = 0; // Empire
     else if (gov->democracy_level < 0.5f)
-      noun = "Autocracy";
+      noun = 1; // Autocracy
     else
-      noun = "Union"; // Centralized Democracy
+      noun = 2; // Union: Centralized Democracy
   } else if (gov->centralization < 0.2f) {
     if (gov->democracy_level > 0.8f)
-      noun = "Commune";
+      noun = 3; // Commune
     else
-      noun = "Confederacy";
+      noun = 4; // Confederacy
   } else {
     if (gov->democracy_level > 0.6f)
-      noun = "Republic";
+      noun = 5; // Republic
     else
-      noun = "State";
+      noun = 6; // State
   }
 
   // Adjective selection
   if (gov->corruption > 0.7f)
-    adj = "Corrupt ";
+    adj = 1; // Corrupt
   else if (gov->stability < 0.3f)
-    adj = "Fractured ";
+    adj = 2; // Fractured
   // else if (gov->military_power > 0.8f) adj = "Martial "; // hypothetical
   // field
   else if (gov->efficiency > 0.8f)
-    adj = "Ordered ";
+    adj = 3; // Ordered
   else if (gov->democracy_level > 0.9f)
-    adj = "Free ";
+    adj = 4; // Free
+
+  return (uint8_t)(noun * NAME_ADJECTIVES + adj);
+}
+
+uint8_t civ_custom_governance_name_key(const civ_custom_governance_t *gov) {
+  if (!gov)
+    return 0;
+  lane_t lane = lane_of_government(gov);
+  return lane_name_key(&lane);
+}
 
-  snprintf(out_name, max_len, "%s%s", adj, noun);
+void civ_custom_governance_name_text(uint8_t key, char *out_name,
+                                     size_t max_len) {
+  if (!out_name || max_len == 0)
+    return;
+  size_t noun = MIN(key / NAME_ADJECTIVES, NAME_NOUNS - 1);
+  snprintf(out_name, max_len, "%s%s", g_name_adjectives[key % NAME_ADJECTIVES],
+           g_name_nouns[noun]);
+}
+
+void civ_custom_governance_generate_name(civ_custom_governance_t *gov,
+                                         char *out_name, size_t max_len) {
+  if (!gov || !out_name)
+    return;
+  civ_custom_governance_name_text(civ_custom_governance_name_key(gov),
+                                  out_name, max_len);
 }
 
 civ_result_t
@@ -346,36 +482,31 @@ civ_custom_governance_manager_add(civ_custom_governance_manager_t *manager,
     return result;
   }
 
-  if (manager->government_count >= manager->government_capacity) {
-    manager->government_capacity *= 2;
-    manager->governments = (civ_custom_governance_t *)CIV_REALLOC(
-        manager->governments,
-        manager->government_capacity * sizeof(civ_custom_governance_t));
-  }
-
-  if (manager->governments) {
-    // Note: Shallow copy of gov struct. If gov has pointers (roles,
-    // constitution), we must be careful who owns them. The manager seems to
-    // store by value `civ_custom_governance_t` in the array? Yes:
-    // `civ_custom_governance_t *governments`. If we copy *gov into
-    // manager->governments[i], we copy the pointers. We should probably assume
-    // ownership transfer or deep copy. For simplicity here, we assume ownership
-    // transfer. The caller shouldn't free the passed `gov` pointer if it was
-    // malloced separately, OR `gov` was stack allocated. Given
-    // `civ_custom_governance_create` returns a pointer, we should probably copy
-    // the CONTENT and then free the input container, or just store pointers in
-    // the manager. The current struct uses `civ_custom_governance_t
-    // *governments;` (array of structs). So we copy the content.
-    manager->governments[manager->government_count++] = *gov;
-    // IMPORTANT: The original `gov` pointer from create() should be freed by
-    // the caller, BUT `gov->roles` etc are now pointed to by the manager's
-    // copy. So the caller MUST NOT call destroy() on the original `gov`. We
-    // will just Free the container.
-    CIV_FREE(gov);
-  } else {
+  if ((manager->government_count >= manager->government_capacity &&
+       !reserve_governments(manager,
+                            MAX(manager->government_capacity * 2, (size_t)32))) ||
+      (gov->id_sym != CIV_SYMBOL_NONE && !reserve_lookup(manager, gov->id_sym))) {
     result.error = CIV_ERROR_OUT_OF_MEMORY;
+    return result;
   }
 
+  // The manager stores governments by value: the content is copied and the
+  // container from create() freed, so the caller must not destroy `gov`.
+  // Its evolution state moves into the columns.
+  size_t i = manager->government_count++;
+  civ_custom_governance_t *held = &manager->governments[i];
+  *held = *gov;
+  CIV_FREE(gov);
+  lane_t lane = lane_of_government(held);
+  lane_store(manager, i, &lane);
+  manager->role_efficiency[i] = roles_efficiency(held);
+  manager->title_key[i] = lane_name_key(&lane);
+  civ_custom_governance_name_text(manager->title_key[i], held->title,
+                                  sizeof(held->title));
+  // The first government added under an id is the one found by it
+  if (held->id_sym != CIV_SYMBOL_NONE && manager->government_of[held->id_sym] < 0)
+    manager->government_of[held->id_sym] = (int32_t)i;
+
   return result;
 }
 
@@ -383,14 +514,71 @@ civ_custom_governance_t *civ_custom_governance_manager_find(
     const civ_custom_governance_manager_t *manager, const char *id) {
   if (!manager || !id)
     return NULL;
+  return civ_custom_governance_manager_find_symbol(manager,
+                                                   civ_symbol_find(id));
+}
 
+int32_t civ_custom_governance_manager_index(
+    const civ_custom_governance_manager_t *manager, civ_symbol_t id) {
+  if (!manager || id == CIV_SYMBOL_NONE || id >= manager->government_of_size)
+    return -1;
+  return manager->government_of[id];
+}
+
+civ_custom_governance_t *civ_custom_governance_manager_find_symbol(
+    const civ_custom_governance_manager_t *manager, civ_symbol_t id) {
+  int32_t i = civ_custom_governance_manager_index(manager, id);
+  return i >= 0 ? &manager->governments[i] : NULL;
+}
+
+/* Rewrite the title only when the state crossed into another name */
+static void retitle(civ_custom_governance_manager_t *manager, size_t i,
+                    const lane_t *lane) {
+  uint8_t key = lane_name_key(lane);
+  if (key == manager->title_key[i])
+    return;
+  manager->title_key[i] = key;
+  civ_custom_governance_name_text(key, manager->governments[i].title,
+                                  sizeof(manager->governments[i].title));
+}
+
+void civ_custom_governance_manager_update(
+    civ_custom_governance_manager_t *manager, civ_float_t time_delta) {
+  if (!manager)
+    return;
   for (size_t i = 0; i < manager->government_count; i++) {
-    if (strcmp(manager->governments[i].id, id) == 0) {
-      return (civ_custom_governance_t *)&manager->governments[i];
-    }
+    lane_t lane = lane_load(manager, i);
+    lane_update(&lane, manager->role_efficiency[i], time_delta);
+    lane_store(manager, i, &lane);
+    retitle(manager, i, &lane);
   }
+}
 
-  return NULL;
+civ_result_t civ_custom_governance_manager_reform(
+    civ_custom_governance_manager_t *manager, size_t index,
+    const char *reform_description) {
+  if (!manager || index >= manager->government_count)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "No such government"};
+  civ_custom_governance_t *gov = &manager->governments[index];
+  lane_t lane = lane_load(manager, index);
+  lane_to_government(&lane, gov);
+  civ_result_t result = civ_custom_governance_reform(gov, reform_description);
+  lane = lane_of_government(gov);
+  lane_store(manager, index, &lane);
+  retitle(manager, index, &lane);
+  return result;
+}
+
+civ_result_t civ_custom_governance_manager_add_role(
+    civ_custom_governance_manager_t *manager, size_t index,
+    const char *role_name, const char *description, civ_float_t authority) {
+  if (!manager || index >= manager->government_count)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "No such government"};
+  civ_custom_governance_t *gov = &manager->governments[index];
+  civ_result_t result =
+      civ_custom_governance_add_role(gov, role_name, description, authority);
+  manager->role_efficiency[index] = roles_efficiency(gov);
+  return result;
 }
 
 civ_result_t civ_custom_governance_map_title(civ_custom_governance_t *gov,
@@ -4,6 +4,7 @@
  */
 #include "core/governance/evolution/governance_evolution.h"
 #include "common.h"
+#include "utils/rng.h"
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -261,7 +262,7 @@ bool civ_governance_age_leader(civ_governance_state_t *gov) {
   if (gov->succession_crisis > 0)
     mortality += gov->succession_crisis * 0.005;
 
-  double roll = (double)rand() / (double)RAND_MAX;
+  double roll = (double)civ_rand() / (double)RAND_MAX;
   if (roll < mortality) {
     civ_governance_trigger_succession(gov);
     return true;
@@ -292,7 +293,7 @@ void civ_governance_trigger_succession(civ_governance_state_t *gov) {
   if (gov->succession_crisis < 0) gov->succession_crisis = 0;
 
   /* Reset leader */
-  gov->leader_age = 25 + rand() % 30;
+  gov->leader_age = 25 + civ_rand() % 30;
   gov->stability -= (1.0 - smoothness) * 0.3;
   gov->legitimacy -= (1.0 - smoothness) * 0.2;
 
@@ -455,7 +456,7 @@ bool civ_governance_should_decide(const civ_governance_state_t *gov,
   if (population > 50000 && gov->traits.representation < 0.20) return true;
   if (gov->corruption > 0.40) return true;
   if (gov->emergency_active && gov->emergency_remaining < 10) return true;
-  if ((double)rand() / RAND_MAX < 0.03) return true;
+  if ((double)civ_rand() / RAND_MAX < 0.03) return true;
 
   (void)culture_level;
   return false;
@@ -575,76 +576,119 @@ void civ_governance_apply_decision(civ_governance_state_t *gov,
 /* ====================================================================
  * DESCRIPTION — 20+ governance labels from 7-axis state
  * ==================================================================== */
-const char *civ_governance_describe(const civ_governance_state_t *gov,
-                                    char *buffer, size_t buffer_size) {
-  if (!gov || !buffer) return "Unknown";
+/* Forms in the order they are tested; a key is form << 2 | variant, the
+   variant picking the qualifier */
+typedef enum {
+  DESCRIBE_THEOCRACY = 0, DESCRIBE_JUNTA, DESCRIBE_STRATOCRACY,
+  DESCRIBE_MARKET_DEMOCRACY, DESCRIBE_PLUTOCRACY, DESCRIBE_TECHNO_REPUBLIC,
+  DESCRIBE_TECHNOCRACY, DESCRIBE_CONFEDERATION, DESCRIBE_DEMOCRACY,
+  DESCRIBE_REPUBLIC, DESCRIBE_MONARCHY, DESCRIBE_AUTOCRACY,
+  DESCRIBE_OLIGARCHY, DESCRIBE_CONST_MONARCHY, DESCRIBE_FEUDAL,
+  DESCRIBE_COMMAND_ECONOMY, DESCRIBE_WARLORDS, DESCRIBE_EMERGENCY,
+  DESCRIBE_POLITY, DESCRIBE_FORM_COUNT
+} describe_form_t;
+
+static const struct {
+  const char *noun;
+  const char *qualifier[4];
+} g_describe_forms[DESCRIBE_FORM_COUNT] = {
+  {"Theocracy",               {"Centralized", "Representative"}},
+  {"Military Junta",          {"Federated", "Unitary"}},
+  {"Stratocracy",             {"Command", "Meritocratic"}},
+  {"Market Democracy",        {"Federal", "Unitary"}},
+  {"Plutocracy",              {"Commercial", "Traditional"}},
+  {"Technocratic Republic",   {"Federal", "Unitary"}},
+  {"Technocracy",             {"Distributed", "Centralized"}},
+  {"Confederation",           {"Progressive", "Traditional"}},
+  {"Democracy",               {"Federal", "Unitary"}},
+  {"Republic",                {"Federal", "Centralized"}},
+  {"Monarchy",                {"Absolute", "Enlightened", "Divine"}},
+  {"Autocracy",               {"Centralized", "Developmental", "Military"}},
+  {"Oligarchy",               {"Council", "Merchant", "Noble"}},
+  {"Constitutional Monarchy", {"Federal", "Centralized"}},
+  {"Feudal Lordship",         {"Secular", "Sacred"}},
+  {"Command Economy",         {"Directorate", "Council"}},
+  {"Warlord Confederacy",     {""}},
+  {"under Emergency Rule",    {"Provisional Government", "Military Administration"}},
+  {NULL,                      {"Decentralized Chiefdom", "Centralized Chiefdom",
+                               "Decentralized Polity", "Centralized Polity"}},
+};
+
+#define DESCRIBE_KEY(form, variant) ((uint16_t)((form) << 2 | (variant)))
+
+uint16_t civ_governance_describe_key(const civ_governance_state_t *gov) {
+  if (!gov) return DESCRIBE_KEY(DESCRIBE_POLITY, 0);
   const civ_governance_traits_t *t = &gov->traits;
 
-  /* Build from most to least defining axis */
+  /* Most to least defining axis */
   if (t->religious_authority > 0.65 && t->centralization > 0.60)
-    snprintf(buffer, buffer_size, "%s Theocracy",
-             t->representation > 0.30 ? "Representative" : "Centralized");
-  else if (t->militarization > 0.70 && t->representation < 0.25)
-    snprintf(buffer, buffer_size, "%s Military Junta",
-             t->centralization > 0.70 ? "Unitary" : "Federated");
-  else if (t->militarization > 0.55)
-    snprintf(buffer, buffer_size, "%s Stratocracy",
-             t->meritocracy > 0.50 ? "Meritocratic" : "Command");
-  else if (t->economic_freedom > 0.80 && t->representation > 0.50)
-    snprintf(buffer, buffer_size, "%s Market Democracy",
-             t->centralization > 0.60 ? "Unitary" : "Federal");
-  else if (t->economic_freedom > 0.80)
-    snprintf(buffer, buffer_size, "%s Plutocracy",
-             t->tradition_index > 0.60 ? "Traditional" : "Commercial");
-  else if (t->meritocracy > 0.70 && t->representation > 0.45)
-    snprintf(buffer, buffer_size, "%s Technocratic Republic",
-             t->centralization > 0.55 ? "Unitary" : "Federal");
-  else if (t->meritocracy > 0.70)
-    snprintf(buffer, buffer_size, "%s Technocracy",
-             t->centralization > 0.70 ? "Centralized" : "Distributed");
-  else if (t->representation > 0.65 && t->centralization < 0.40)
-    snprintf(buffer, buffer_size, "%s Confederation",
-             t->tradition_index > 0.60 ? "Traditional" : "Progressive");
-  else if (t->representation > 0.65)
-    snprintf(buffer, buffer_size, "%s Democracy",
-             t->centralization > 0.60 ? "Unitary" : "Federal");
-  else if (t->representation > 0.40)
-    snprintf(buffer, buffer_size, "%s Republic",
-             t->centralization > 0.60 ? "Centralized" : "Federal");
-  else if (t->centralization > 0.75 && t->tradition_index > 0.60)
-    snprintf(buffer, buffer_size, "%s Monarchy",
-             t->religious_authority > 0.50 ? "Divine" :
-             t->meritocracy > 0.40 ? "Enlightened" : "Absolute");
-  else if (t->centralization > 0.75)
-    snprintf(buffer, buffer_size, "%s Autocracy",
-             t->militarization > 0.40 ? "Military" :
-             t->economic_freedom > 0.60 ? "Developmental" : "Centralized");
-  else if (t->centralization < 0.30 && t->representation < 0.30)
-    snprintf(buffer, buffer_size, "%s Oligarchy",
-             t->tradition_index > 0.60 ? "Noble" :
-             t->economic_freedom > 0.60 ? "Merchant" : "Council");
-  else if (t->tradition_index > 0.75 && t->representation > 0.35)
-    snprintf(buffer, buffer_size, "%s Constitutional Monarchy",
-             t->centralization > 0.55 ? "Centralized" : "Federal");
-  else if (t->tradition_index > 0.75)
-    snprintf(buffer, buffer_size, "%s Feudal Lordship",
-             t->religious_authority > 0.50 ? "Sacred" : "Secular");
-  else if (t->economic_freedom < 0.25 && t->centralization > 0.60)
-    snprintf(buffer, buffer_size, "%s Command Economy",
-             t->representation > 0.30 ? "Council" : "Directorate");
-  else if (t->representation < 0.15 && t->centralization < 0.40)
-    snprintf(buffer, buffer_size, "Warlord Confederacy");
-  else if (gov->emergency_active)
-    snprintf(buffer, buffer_size, "%s under Emergency Rule",
-             t->militarization > 0.50 ? "Military Administration" : "Provisional Government");
-  else
-    snprintf(buffer, buffer_size, "%s %s",
-             t->centralization > 0.55 ? "Centralized" : "Decentralized",
-             t->representation > 0.35 ? "Polity" : "Chiefdom");
+    return DESCRIBE_KEY(DESCRIBE_THEOCRACY, t->representation > 0.30);
+  if (t->militarization > 0.70 && t->representation < 0.25)
+    return DESCRIBE_KEY(DESCRIBE_JUNTA, t->centralization > 0.70);
+  if (t->militarization > 0.55)
+    return DESCRIBE_KEY(DESCRIBE_STRATOCRACY, t->meritocracy > 0.50);
+  if (t->economic_freedom > 0.80 && t->representation > 0.50)
+    return DESCRIBE_KEY(DESCRIBE_MARKET_DEMOCRACY, t->centralization > 0.60);
+  if (t->economic_freedom > 0.80)
+    return DESCRIBE_KEY(DESCRIBE_PLUTOCRACY, t->tradition_index > 0.60);
+  if (t->meritocracy > 0.70 && t->representation > 0.45)
+    return DESCRIBE_KEY(DESCRIBE_TECHNO_REPUBLIC, t->centralization > 0.55);
+  if (t->meritocracy > 0.70)
+    return DESCRIBE_KEY(DESCRIBE_TECHNOCRACY, t->centralization > 0.70);
+  if (t->representation > 0.65 && t->centralization < 0.40)
+    return DESCRIBE_KEY(DESCRIBE_CONFEDERATION, t->tradition_index > 0.60);
+  if (t->representation > 0.65)
+    return DESCRIBE_KEY(DESCRIBE_DEMOCRACY, t->centralization > 0.60);
+  if (t->representation > 0.40)
+    return DESCRIBE_KEY(DESCRIBE_REPUBLIC, t->centralization > 0.60);
+  if (t->centralization > 0.75 && t->tradition_index > 0.60)
+    return DESCRIBE_KEY(DESCRIBE_MONARCHY, t->religious_authority > 0.50 ? 2 :
+                                           t->meritocracy > 0.40 ? 1 : 0);
+  if (t->centralization > 0.75)
+    return DESCRIBE_KEY(DESCRIBE_AUTOCRACY, t->militarization > 0.40 ? 2 :
+                                            t->economic_freedom > 0.60 ? 1 : 0);
+  if (t->centralization < 0.30 && t->representation < 0.30)
+    return DESCRIBE_KEY(DESCRIBE_OLIGARCHY, t->tradition_index > 0.60 ? 2 :
+                                            t->economic_freedom > 0.60 ? 1 : 0);
+  if (t->tradition_index > 0.75 && t->representation > 0.35)
+    return DESCRIBE_KEY(DESCRIBE_CONST_MONARCHY, t->centralization > 0.55);
+  if (t->tradition_index > 0.75)
+    return DESCRIBE_KEY(DESCRIBE_FEUDAL, t->religious_authority > 0.50);
+  if (t->economic_freedom < 0.25 && t->centralization > 0.60)
+    return DESCRIBE_KEY(DESCRIBE_COMMAND_ECONOMY, t->representation > 0.30);
+  if (t->representation < 0.15 && t->centralization < 0.40)
+    return DESCRIBE_KEY(DESCRIBE_WARLORDS, 0);
+  if (gov->emergency_active)
+    return DESCRIBE_KEY(DESCRIBE_EMERGENCY, t->militarization > 0.50);
+  return DESCRIBE_KEY(DESCRIBE_POLITY, (t->representation > 0.35) << 1 |
+                                       (t->centralization > 0.55));
+}
 
+const char *civ_governance_describe_key_text(uint16_t key, char *buffer,
+                                             size_t buffer_size) {
+  if (!buffer) return "Unknown";
+  unsigned form = key >> 2, variant = key & 3;
+  if (form >= DESCRIBE_FORM_COUNT) form = DESCRIBE_POLITY;
+  const char *noun = g_describe_forms[form].noun;
+  const char *qualifier = g_describe_forms[form].qualifier[variant];
+  if (!qualifier) qualifier = g_describe_forms[form].qualifier[0];
+
+  if (!noun)
+    snprintf(buffer, buffer_size, "%s", qualifier);
+  else if (!qualifier[0])
+    snprintf(buffer, buffer_size, "%s", noun);
+  else
+    snprintf(buffer, buffer_size, "%s %s", qualifier, noun);
   return buffer;
 }
 
+const char *civ_governance_describe(const civ_governance_state_t *gov,
+                                    char *buffer, size_t buffer_size) {
+  if (!gov || !buffer) return "Unknown";
+  return civ_governance_describe_key_text(civ_governance_describe_key(gov),
+                                          buffer, buffer_size);
+}
+
 /* ====================================================================
  * TITLES
  * ==================================================================== */
@@ -9,12 +9,116 @@
 #include <stdlib.h>
 #include <string.h>
 
+static const float g_cadence_period[CIV_GOV_CADENCE_COUNT] = {
+#define CIV_GOV_CADENCE_PERIOD(id, period) period,
+  CIV_GOVERNMENT_CADENCES(CIV_GOV_CADENCE_PERIOD)
+#undef CIV_GOV_CADENCE_PERIOD
+};
+
+float civ_government_cadence_period(civ_gov_cadence_t cadence) {
+  if (cadence < 0 || cadence >= CIV_GOV_CADENCE_COUNT) return 0.0f;
+  return g_cadence_period[cadence];
+}
+
+/* First ticks come after a share of each period drawn from the id (FNV-1a,
+   then an LCG per cadence), so governments spread over the period */
+static void cadence_init(civ_government_t *gov) {
+  uint32_t h = 2166136261u;
+  for (const char *p = gov->id; *p; p++) h = (h ^ (uint8_t)*p) * 16777619u;
+  for (int c = 0; c < CIV_GOV_CADENCE_COUNT; c++) {
+    h = h * 1664525u + 1013904223u;
+    gov->cadence.banked[c] = 0.0f;
+    gov->cadence.due[c] = g_cadence_period[c] * (float)((h >> 22) + 1) / 1024.0f;
+  }
+}
+
+/* Bank dt; true once the cadence is due, with the banked time in tick_dt */
+static bool cadence_take(civ_government_t *gov, civ_gov_cadence_t c, float dt,
+                         float *tick_dt) {
+  civ_gov_cadence_state_t *s = &gov->cadence;
+  s->banked[c] += dt;
+  if (s->banked[c] < s->due[c]) return false;
+  *tick_dt = s->banked[c];
+  s->banked[c] = 0.0f;
+  s->due[c] = g_cadence_period[c];
+  return true;
+}
+
+/* ── Arena ─────────────────────────────────────────────────────────── */
+static civ_government_arena_t *arena_alloc(size_t capacity) {
+  if (capacity == 0 || capacity > UINT32_MAX) return NULL;
+  civ_government_arena_t *arena = CIV_CALLOC(1, sizeof(civ_government_arena_t));
+  if (!arena) return NULL;
+  arena->capacity = capacity;
+  bool ok = true;
+#define CIV_GOV_ARENA_ALLOC(type, slab) \
+  ok = ok && (arena->slab = (type *)CIV_CALLOC(capacity, sizeof(type))) != NULL;
+  CIV_GOVERNMENT_ARENA_PARTS(CIV_GOV_ARENA_ALLOC)
+#undef CIV_GOV_ARENA_ALLOC
+  arena->live = (uint8_t *)CIV_CALLOC(capacity, 1);
+  arena->free_slots = (uint32_t *)CIV_MALLOC(capacity * sizeof(uint32_t));
+  if (!ok || !arena->live || !arena->free_slots) {
+    civ_government_arena_destroy(arena);
+    return NULL;
+  }
+  for (size_t i = 0; i < capacity; i++)
+    arena->free_slots[i] = (uint32_t)(capacity - 1 - i);
+  arena->free_count = capacity;
+  return arena;
+}
+
+civ_government_arena_t *civ_government_arena_create(size_t capacity) {
+  CIV_MEM_TAG_BEGIN(prev_tag, CIV_MEM_TAG_GOVERNANCE);
+  civ_government_arena_t *arena = arena_alloc(capacity);
+  CIV_MEM_TAG_END(prev_tag);
+  return arena;
+}
+
+static void government_release(civ_government_t *gov);
+
+void civ_government_arena_destroy(civ_government_arena_t *arena) {
+  if (!arena) return;
+  if (arena->live && arena->governments)
+    for (size_t i = 0; i < arena->capacity; i++)
+      if (arena->live[i]) government_release(&arena->governments[i]);
+#define CIV_GOV_ARENA_FREE(type, slab) CIV_FREE(arena->slab);
+  CIV_GOVERNMENT_ARENA_PARTS(CIV_GOV_ARENA_FREE)
+#undef CIV_GOV_ARENA_FREE
+  CIV_FREE(arena->live);
+  CIV_FREE(arena->free_slots);
+  CIV_FREE(arena);
+}
+
 civ_government_t *civ_government_create(const char *name) {
-  civ_government_t *gov =
-      (civ_government_t *)CIV_MALLOC(sizeof(civ_government_t));
-  if (!gov) return NULL;
+  civ_government_arena_t *arena = civ_government_arena_create(1);
+  if (!arena) return NULL;
+  civ_government_t *gov = civ_government_create_in(arena, name);
+  gov->owns_arena = true;
+  return gov;
+}
 
+static civ_government_t *government_init_in(civ_government_arena_t *arena,
+                                            const char *name);
+
+/* Governments and everything they allocate count under GOVERNANCE */
+civ_government_t *civ_government_create_in(civ_government_arena_t *arena,
+                                           const char *name) {
+  if (!arena || arena->free_count == 0) return civ_government_create(name);
+  CIV_MEM_TAG_BEGIN(prev_tag, CIV_MEM_TAG_GOVERNANCE);
+  civ_government_t *gov = government_init_in(arena, name);
+  CIV_MEM_TAG_END(prev_tag);
+  return gov;
+}
+
+static civ_government_t *government_init_in(civ_government_arena_t *arena,
+                                            const char *name) {
+
+  uint32_t slot = arena->free_slots[--arena->free_count];
+  arena->live[slot] = 1;
+  civ_government_t *gov = &arena->governments[slot];
   memset(gov, 0, sizeof(civ_government_t));
+  gov->arena = arena;
+  gov->arena_slot = slot;
   strncpy(gov->name, name, STRING_MEDIUM_LEN - 1);
   snprintf(gov->id, sizeof(gov->id), "gov_%s", name);
 
@@ -28,28 +132,43 @@ civ_government_t *civ_government_create(const char *name) {
   gov->position_capacity = 8;
   gov->positions = (civ_political_position_t *)CIV_MALLOC(
       sizeof(civ_political_position_t) * gov->position_capacity);
+  gov->position_flags = (uint8_t *)CIV_MALLOC(gov->position_capacity);
 
-  /* ── Create ALL governance subsystems ── */
-  gov->constitution        = civ_constitution_create(name);
+  /* ── Create ALL governance subsystems, in place in the arena slot ── */
+  gov->constitution        = &arena->constitutions[slot];
 
   /* Branches: all optional. Default = tripartite (exec + leg + jud).
    * Council and religious_body are NULL by default — create them
    * only for governance forms that use collective or theocratic rule. */
-  gov->executive           = civ_executive_create();
-  gov->legislative_manager = civ_legislative_manager_create();
-  gov->judiciary           = civ_judiciary_create();
+  gov->executive           = &arena->executives[slot];
+  gov->legislative_manager = &arena->legislatures[slot];
+  gov->judiciary           = &arena->judiciaries[slot];
   gov->council             = NULL;  /* no collective council by default */
   gov->religious_body      = NULL;  /* no religious authority by default */
 
-  gov->institution_manager = civ_institution_manager_create();
-  gov->subdivision_manager = civ_subdivision_manager_create();
-  gov->corruption_engine   = civ_corruption_engine_create();
-  gov->election_system     = civ_election_create();
-  gov->political_violence  = civ_political_violence_create();
-  gov->ministry_manager    = civ_ministry_manager_create();
-  gov->civil_service       = civ_civil_service_create();
-  gov->rights              = civ_rights_create();
-  gov->notebook            = civ_notebook_create();
+  gov->institution_manager = &arena->institution_managers[slot];
+  gov->subdivision_manager = &arena->subdivision_managers[slot];
+  gov->corruption_engine   = &arena->corruption_engines[slot];
+  gov->election_system     = &arena->election_systems[slot];
+  gov->political_violence  = &arena->political_violence[slot];
+  gov->ministry_manager    = &arena->ministry_managers[slot];
+  gov->civil_service       = &arena->civil_services[slot];
+  gov->rights              = &arena->rights[slot];
+  gov->notebook            = &arena->notebooks[slot];
+
+  civ_constitution_init(gov->constitution, name);
+  civ_executive_init(gov->executive);
+  civ_legislative_manager_init(gov->legislative_manager);
+  civ_judiciary_init(gov->judiciary);
+  civ_institution_manager_init(gov->institution_manager);
+  civ_subdivision_manager_init(gov->subdivision_manager);
+  civ_corruption_engine_init(gov->corruption_engine);
+  civ_election_init(gov->election_system);
+  civ_political_violence_init(gov->political_violence);
+  civ_ministry_manager_init(gov->ministry_manager);
+  civ_civil_service_init(gov->civil_service);
+  civ_rights_init(gov->rights);
+  civ_notebook_init(gov->notebook);
 
   /* Initialize evolution state (decision-driven governance change) */
   civ_governance_init(&gov->evolution_state);
@@ -82,28 +201,47 @@ civ_government_t *civ_government_create(const char *name) {
                               "emergence", "indefinite", 1);
 
   civ_government_recompute_profile(gov);
+  cadence_init(gov);
   return gov;
 }
 
-void civ_government_destroy(civ_government_t *gov) {
-  if (!gov) return;
+/* Free what the government owns and give its slot back */
+static void government_release(civ_government_t *gov) {
+  civ_government_arena_t *arena = gov->arena;
   CIV_FREE(gov->positions);
-  if (gov->institution_manager) civ_institution_manager_destroy(gov->institution_manager);
-  if (gov->subdivision_manager) civ_subdivision_manager_destroy(gov->subdivision_manager);
-  if (gov->constitution)        civ_constitution_destroy(gov->constitution);
-  if (gov->executive)           civ_executive_destroy(gov->executive);
-  if (gov->legislative_manager) civ_legislative_manager_destroy(gov->legislative_manager);
-  if (gov->judiciary)           civ_judiciary_destroy(gov->judiciary);
+  CIV_FREE(gov->position_flags);
+  civ_institution_manager_free(gov->institution_manager);
+  civ_subdivision_manager_free(gov->subdivision_manager);
+  civ_constitution_free(gov->constitution);
+  civ_executive_free(gov->executive);
+  civ_legislative_manager_free(gov->legislative_manager);
+  civ_judiciary_free(gov->judiciary);
   if (gov->council)             civ_council_destroy(gov->council);
   if (gov->religious_body)      civ_religious_body_destroy(gov->religious_body);
-  if (gov->corruption_engine)   civ_corruption_engine_destroy(gov->corruption_engine);
-  if (gov->election_system)     civ_election_destroy(gov->election_system);
-  if (gov->political_violence)  civ_political_violence_destroy(gov->political_violence);
-  if (gov->ministry_manager)    civ_ministry_manager_destroy(gov->ministry_manager);
-  if (gov->civil_service)       civ_civil_service_destroy(gov->civil_service);
-  if (gov->rights)              civ_rights_destroy(gov->rights);
-  if (gov->notebook)            civ_notebook_destroy(gov->notebook);
-  CIV_FREE(gov);
+  civ_corruption_engine_free(gov->corruption_engine);
+  civ_election_free(gov->election_system);
+  civ_political_violence_free(gov->political_violence);
+  civ_ministry_manager_free(gov->ministry_manager);
+  civ_civil_service_free(gov->civil_service);
+  civ_rights_free(gov->rights);
+  civ_notebook_free(gov->notebook);
+  arena->live[gov->arena_slot] = 0;
+  arena->free_slots[arena->free_count++] = gov->arena_slot;
+}
+
+void civ_government_destroy(civ_government_t *gov) {
+  if (!gov) return;
+  civ_government_arena_t *arena = gov->arena;
+  bool owned = gov->owns_arena;
+  government_release(gov);
+  if (owned) civ_government_arena_destroy(arena);
+}
+
+static uint8_t position_flags_of(const civ_political_position_t *p) {
+  uint8_t flags = 0;
+  if (strstr(p->term, "life")) flags |= CIV_POSITION_LIFE_TERM;
+  if (strstr(p->selection_method, "hereditary")) flags |= CIV_POSITION_HEREDITARY;
+  return flags;
 }
 
 civ_political_position_t *civ_government_add_position(
@@ -118,6 +256,9 @@ civ_political_position_t *civ_government_add_position(
         gov->positions, sizeof(civ_political_position_t) * new_cap);
     if (!new_p) return NULL;
     gov->positions = new_p;
+    uint8_t *new_f = (uint8_t *)realloc(gov->position_flags, new_cap);
+    if (!new_f) return NULL;
+    gov->position_flags = new_f;
     gov->position_capacity = new_cap;
   }
 
@@ -131,12 +272,79 @@ civ_political_position_t *civ_government_add_position(
   if (selection) strncpy(p->selection_method, selection, CIV_POSITION_SELECT_MAX - 1);
   if (term) strncpy(p->term, term, CIV_POSITION_TERM_MAX - 1);
   p->position_count = count;
+  gov->position_flags[gov->position_count - 1] = position_flags_of(p);
+  gov->structure_dirty = true;
   return p;
 }
 
-void civ_government_recompute_profile(civ_government_t *gov) {
-  if (!gov || gov->position_count == 0) return;
+bool civ_government_remove_position(civ_government_t *gov, size_t index) {
+  if (!gov || index >= gov->position_count) return false;
+  size_t tail = gov->position_count - index - 1;
+  memmove(&gov->positions[index], &gov->positions[index + 1],
+          tail * sizeof(civ_political_position_t));
+  memmove(&gov->position_flags[index], &gov->position_flags[index + 1], tail);
+  gov->position_count--;
+  gov->structure_dirty = true;
+  return true;
+}
+
+static civ_political_position_t *find_position(civ_government_t *gov,
+                                               const char *title, int level) {
+  for (size_t i = 0; i < gov->position_count; i++)
+    if (gov->positions[i].hierarchy_level == level &&
+        strcmp(gov->positions[i].title, title) == 0)
+      return &gov->positions[i];
+  return NULL;
+}
+
+bool civ_government_fold_positions(civ_government_t *into,
+                                   const civ_government_t *from) {
+  if (!into || !from) return false;
+
+  /* Room for every new office first, so a refusal changes nothing */
+  size_t need = into->position_count;
+  for (size_t i = 0; i < from->position_count; i++) {
+    const civ_political_position_t *p = &from->positions[i];
+    if (p->hierarchy_level > 0 && !find_position(into, p->title, p->hierarchy_level))
+      need++;
+  }
+  if (need > into->position_capacity) {
+    civ_political_position_t *new_p = (civ_political_position_t *)realloc(
+        into->positions, sizeof(civ_political_position_t) * need);
+    if (!new_p) return false;
+    into->positions = new_p;
+    uint8_t *new_f = (uint8_t *)realloc(into->position_flags, need);
+    if (!new_f) return false;
+    into->position_flags = new_f;
+    into->position_capacity = need;
+  }
+
+  /* The head of state steps down; every lower office joins its match */
+  for (size_t i = 0; i < from->position_count; i++) {
+    const civ_political_position_t *p = &from->positions[i];
+    if (p->hierarchy_level <= 0) continue;
+    civ_political_position_t *q = find_position(into, p->title, p->hierarchy_level);
+    if (q) {
+      q->position_count += p->position_count;
+      continue;
+    }
+    q = &into->positions[into->position_count++];
+    *q = *p;
+    q->current_occupant = 0;
+  }
+  civ_government_mark_structure_dirty(into);
+  return true;
+}
+
+void civ_government_mark_structure_dirty(civ_government_t *gov) {
+  if (!gov) return;
+  for (size_t i = 0; i < gov->position_count; i++)
+    gov->position_flags[i] = position_flags_of(&gov->positions[i]);
+  gov->structure_dirty = true;
+}
 
+/* The part of the profile read from the positions alone */
+static void recompute_structure(civ_government_t *gov) {
   float total_exec = 0, total_leg = 0, total_jud = 0;
   float top_exec = 0;
 
@@ -167,14 +375,18 @@ void civ_government_recompute_profile(civ_government_t *gov) {
   float rigidity = 0.3f;
   int life_terms = 0, hereditary = 0;
   for (size_t i = 0; i < gov->position_count; i++) {
-    if (strstr(gov->positions[i].term, "life")) life_terms++;
-    if (strstr(gov->positions[i].selection_method, "hereditary")) hereditary++;
+    life_terms += (gov->position_flags[i] & CIV_POSITION_LIFE_TERM) != 0;
+    hereditary += (gov->position_flags[i] & CIV_POSITION_HEREDITARY) != 0;
   }
   rigidity += (float)life_terms / (float)(gov->position_count + 1) * 0.35f;
   rigidity += (float)hereditary / (float)(gov->position_count + 1) * 0.35f;
   if (rigidity > 1.0f) rigidity = 1.0f;
   gov->profile.institutional_rigidity = rigidity;
+  gov->structure_dirty = false;
+}
 
+/* The part read from the metrics, which move every tick */
+static void recompute_metrics(civ_government_t *gov) {
   gov->profile.citizen_happiness =
       gov->stability * 0.5f + gov->profile.representation_index * 0.3f +
       gov->legitimacy * 0.2f;
@@ -185,6 +397,12 @@ void civ_government_recompute_profile(civ_government_t *gov) {
        gov->profile.power_balance * 50.0f) / 4.5f;
 }
 
+void civ_government_recompute_profile(civ_government_t *gov) {
+  if (!gov || gov->position_count == 0) return;
+  recompute_structure(gov);
+  recompute_metrics(gov);
+}
+
 const char *civ_government_proximity_label(const civ_government_t *gov) {
   if (!gov) return "Unclassified";
 
@@ -208,238 +426,328 @@ const char *civ_government_proximity_label(const civ_government_t *gov) {
 /* ====================================================================
  * MAIN TICK — propagates to ALL governance subsystems
  * ==================================================================== */
-void civ_government_update(civ_government_t *gov, float dt,
-                           int total_population, float culture_level,
-                           float total_budget, float education_level,
-                           float economic_confidence, float literacy_rate,
-                           float faction_support, int faction_count) {
+void civ_government_begin_update(civ_government_t *gov, float dt,
+                                 int total_population, float culture_level,
+                                 float total_budget, float education_level,
+                                 float economic_confidence, float literacy_rate,
+                                 float faction_support, int faction_count) {
   if (!gov) return;
 
   /* Cache cross-module values for use by sub-functions */
   gov->faction_support = faction_support;
   gov->faction_count   = faction_count;
+  gov->inputs = (civ_gov_inputs_t){dt, total_population, culture_level, total_budget,
+                                   education_level, economic_confidence, literacy_rate};
+}
 
-  /* Recompute profile from current political structure */
-  civ_government_recompute_profile(gov);
+void civ_government_update_stage(civ_government_t *gov, civ_gov_stage_t stage) {
+  if (!gov) return;
+  const civ_gov_inputs_t *in = &gov->inputs;
+  float dt                  = in->dt;
+  int   total_population    = in->total_population;
+  float culture_level       = in->culture_level;
+  float total_budget        = in->total_budget;
+  float education_level     = in->education_level;
+  float economic_confidence = in->economic_confidence;
+  float literacy_rate       = in->literacy_rate;
+
+  /* Aliases for evolution and corruption — used throughout the tick */
+  civ_governance_state_t *ev = &gov->evolution_state;
+  civ_corruption_engine_t *ce = gov->corruption_engine;
+
+  /* Subsystems below tick on their cadences with the time they banked */
+  float tdt;
+
+  switch (stage) {
+  case CIV_GOV_STAGE_PROFILE:
+    /* Profile: the structure only after positions changed */
+    if (gov->position_count > 0) {
+      if (gov->structure_dirty) recompute_structure(gov);
+      recompute_metrics(gov);
+    }
+    break;
 
   /* ── Tick institutions: budget-fed growth/decay ── */
-  float inst_budget = gov->budget_allocations[CIV_BUDGET_ADMINISTRATION];
-  if (inst_budget < 1000.0f) inst_budget = 1000.0f;
-  civ_institution_update(gov->institution_manager, inst_budget, gov->efficiency, dt);
+  case CIV_GOV_STAGE_INSTITUTIONS:
+    if (cadence_take(gov, CIV_GOV_CADENCE_INSTITUTIONS, dt, &tdt)) {
+      float inst_budget = gov->budget_allocations[CIV_BUDGET_ADMINISTRATION];
+      if (inst_budget < 1000.0f) inst_budget = 1000.0f;
+      civ_institution_update(gov->institution_manager, inst_budget, gov->efficiency, tdt);
+    }
+    break;
 
   /* ── Tick subdivisions: stability drift ── */
-  civ_subdivision_update(gov->subdivision_manager, dt);
+  case CIV_GOV_STAGE_SUBDIVISIONS:
+    if (cadence_take(gov, CIV_GOV_CADENCE_SUBDIVISIONS, dt, &tdt))
+      civ_subdivision_update(gov->subdivision_manager, tdt);
+    break;
 
   /* ── Tick governance evolution: decision-driven trait changes ── */
-  civ_governance_update(&gov->evolution_state,
-                        (civ_float_t)total_population, (civ_float_t)culture_level);
-
-  /* Aliases for evolution and corruption — used throughout the tick */
-  civ_governance_state_t *ev = &gov->evolution_state;
-  civ_corruption_engine_t *ce = gov->corruption_engine;
-
-  /* Evolution state feeds back into government metrics */
-  gov->stability  += (gov->evolution_state.stability - gov->stability) * 0.05f * dt;
-  gov->legitimacy += (gov->evolution_state.legitimacy - gov->legitimacy) * 0.05f * dt;
-  float ev_eff = (float)civ_governance_efficiency(&gov->evolution_state, total_population, culture_level);
-  float ev_cr  = (float)civ_governance_corruption_resistance(&gov->evolution_state);
-  gov->efficiency += (ev_eff - gov->efficiency) * 0.08f * dt;
+  case CIV_GOV_STAGE_EVOLUTION: {
+    civ_governance_update(&gov->evolution_state,
+                          (civ_float_t)total_population, (civ_float_t)culture_level);
+
+    /* Evolution state feeds back into government metrics */
+    gov->stability  += (gov->evolution_state.stability - gov->stability) * 0.05f * dt;
+    gov->legitimacy += (gov->evolution_state.legitimacy - gov->legitimacy) * 0.05f * dt;
+    float ev_eff = (float)civ_governance_efficiency(&gov->evolution_state, total_population, culture_level);
+    float ev_cr  = (float)civ_governance_corruption_resistance(&gov->evolution_state);
+    gov->efficiency += (ev_eff - gov->efficiency) * 0.08f * dt;
+    break;
+  }
 
   /* ── 4. Tick executive: veto, decrees, political capital ── */
-  civ_executive_update(gov->executive, dt,
-                       (float)ev->traits.centralization, gov->legitimacy,
-                       ev->emergency_active ? (float)ev->emergency_power_grab : 0.0f,
-                       (float)ev->traits.representation);
+  case CIV_GOV_STAGE_EXECUTIVE:
+    if (cadence_take(gov, CIV_GOV_CADENCE_EXECUTIVE, dt, &tdt))
+      civ_executive_update(gov->executive, tdt,
+                           (float)ev->traits.centralization, gov->legitimacy,
+                           ev->emergency_active ? (float)ev->emergency_power_grab : 0.0f,
+                           (float)ev->traits.representation);
+    break;
 
   /* ── 5. Tick judiciary: courts, cases, rule of law ── */
-  if (gov->judiciary)
-    civ_judiciary_update(gov->judiciary, dt, gov->efficiency,
-                         gov->corruption_engine->systemic_index,
-                         (float)ev->traits.centralization,
-                         (float)ev->traits.representation);
+  case CIV_GOV_STAGE_JUDICIARY:
+    if (cadence_take(gov, CIV_GOV_CADENCE_JUDICIARY, dt, &tdt) && gov->judiciary)
+      civ_judiciary_update(gov->judiciary, tdt, gov->efficiency,
+                           gov->corruption_engine->systemic_index,
+                           (float)ev->traits.centralization,
+                           (float)ev->traits.representation);
+    break;
 
   /* ── 6. Tick council: collective leadership (NULL = not used) ── */
-  if (gov->council)
-    civ_council_update(gov->council, dt,
-                       (float)ev->traits.centralization, gov->legitimacy,
-                       gov->corruption_engine->systemic_index,
-                       (float)ev->traits.tradition_index);
+  case CIV_GOV_STAGE_COUNCIL:
+    if (cadence_take(gov, CIV_GOV_CADENCE_COUNCIL, dt, &tdt) && gov->council)
+      civ_council_update(gov->council, tdt,
+                         (float)ev->traits.centralization, gov->legitimacy,
+                         gov->corruption_engine->systemic_index,
+                         (float)ev->traits.tradition_index);
+    break;
 
   /* ── 7. Tick religious body: theocratic authority (NULL = secular) ── */
-  if (gov->religious_body)
-    civ_religious_body_update(gov->religious_body, dt,
-                              (float)ev->traits.religious_authority,
-                              (float)ev->traits.tradition_index,
-                              (float)ev->traits.representation,
-                              gov->corruption_engine->systemic_index);
+  case CIV_GOV_STAGE_RELIGIOUS_BODY:
+    if (cadence_take(gov, CIV_GOV_CADENCE_RELIGIOUS_BODY, dt, &tdt) && gov->religious_body)
+      civ_religious_body_update(gov->religious_body, tdt,
+                                (float)ev->traits.religious_authority,
+                                (float)ev->traits.tradition_index,
+                                (float)ev->traits.representation,
+                                gov->corruption_engine->systemic_index);
+    break;
 
   /* ── 8. Tick elections: autonomous electoral cycles ── */
-  if (gov->election_system) {
-    civ_election_update(gov->election_system, dt,
-                        total_population, gov->corruption_engine->systemic_index,
-                        (float)ev->traits.representation,
-                        gov->profile.citizen_happiness, economic_confidence, literacy_rate);
-    /* Schedule initial election if none exist and representation > 0.2 */
-    if (gov->election_system->election_count == 0 && ev->traits.representation > 0.20) {
-      civ_election_schedule(gov->election_system, "general_election",
-                            "General Assembly", CIV_ELECTION_FPTP, 100, 40);
-      /* Add some candidates */
-      civ_election_t *e = &gov->election_system->elections[0];
-      civ_election_add_candidate(e, "Incumbent Leader", "NPC_LEADER", "GOVERNING", true);
-      civ_election_add_candidate(e, "Challenger", "NPC_CHALLENGER", "OPPOSITION", false);
-      civ_election_add_candidate(e, "Independent Voice", "NPC_INDEP", "INDEPENDENT", false);
+  case CIV_GOV_STAGE_ELECTIONS:
+    if (cadence_take(gov, CIV_GOV_CADENCE_ELECTIONS, dt, &tdt) && gov->election_system) {
+      civ_election_update(gov->election_system, tdt,
+                          total_population, gov->corruption_engine->systemic_index,
+                          (float)ev->traits.representation,
+                          gov->profile.citizen_happiness, economic_confidence, literacy_rate);
+      /* Schedule initial election if none exist and representation > 0.2 */
+      if (gov->election_system->election_count == 0 && ev->traits.representation > 0.20) {
+        civ_election_schedule(gov->election_system, "general_election",
+                              "General Assembly", CIV_ELECTION_FPTP, 100, 40);
+        /* Add some candidates */
+        civ_election_t *e = &gov->election_system->elections[0];
+        civ_election_add_candidate(e, "Incumbent Leader", "NPC_LEADER", "GOVERNING", true);
+        civ_election_add_candidate(e, "Challenger", "NPC_CHALLENGER", "OPPOSITION", false);
+        civ_election_add_candidate(e, "Independent Voice", "NPC_INDEP", "INDEPENDENT", false);
+      }
     }
-  }
+    break;
 
   /* ── 9. Tick civil service: bureaucracy, merit vs patronage ── */
-  if (gov->civil_service) {
-    civ_civil_service_update(gov->civil_service, dt,
-                             (float)ev->traits.meritocracy,
-                             gov->corruption_engine->systemic_index,
-                             education_level, total_budget, gov->efficiency);
-    /* Create default departments if empty */
-    if (gov->civil_service->dept_count == 0) {
-      civ_civil_service_add_department(gov->civil_service, "Treasury", 200);
-      civ_civil_service_add_department(gov->civil_service, "Public Works", 300);
-      civ_civil_service_add_department(gov->civil_service, "Records Office", 150);
-      civ_civil_service_add_department(gov->civil_service, "Foreign Service", 100);
+  case CIV_GOV_STAGE_CIVIL_SERVICE:
+    if (cadence_take(gov, CIV_GOV_CADENCE_CIVIL_SERVICE, dt, &tdt) && gov->civil_service) {
+      civ_civil_service_update(gov->civil_service, tdt,
+                               (float)ev->traits.meritocracy,
+                               gov->corruption_engine->systemic_index,
+                               education_level, total_budget, gov->efficiency);
+      /* Create default departments if empty */
+      if (gov->civil_service->dept_count == 0) {
+        civ_civil_service_add_department(gov->civil_service, "Treasury", 200);
+        civ_civil_service_add_department(gov->civil_service, "Public Works", 300);
+        civ_civil_service_add_department(gov->civil_service, "Records Office", 150);
+        civ_civil_service_add_department(gov->civil_service, "Foreign Service", 100);
+      }
     }
-  }
+    break;
 
   /* ── 10. Tick rights: civil liberties, constitutional protections ── */
-  if (gov->rights && gov->judiciary) {
-    float rule_of_law = gov->judiciary->rule_of_law;
-    civ_rights_update(gov->rights, dt, rule_of_law,
-                      (float)ev->traits.representation,
-                      (float)ev->traits.centralization,
-                      ev->emergency_active ? (float)ev->emergency_power_grab : 0.0f,
-                      gov->corruption_engine->systemic_index, education_level);
-
-    /* Default: grant basic rights if representation rises */
-    if (ev->traits.representation > 0.30f) {
-      if (gov->rights->rights[CIV_RIGHT_SPEECH].level == CIV_PROTECTION_NONE)
-        civ_rights_set_protection(gov->rights, CIV_RIGHT_SPEECH, CIV_PROTECTION_STATUTORY);
-      if (gov->rights->rights[CIV_RIGHT_ASSEMBLY].level == CIV_PROTECTION_NONE)
-        civ_rights_set_protection(gov->rights, CIV_RIGHT_ASSEMBLY, CIV_PROTECTION_STATUTORY);
-      if (gov->rights->rights[CIV_RIGHT_PROPERTY].level == CIV_PROTECTION_NONE)
-        civ_rights_set_protection(gov->rights, CIV_RIGHT_PROPERTY, CIV_PROTECTION_STATUTORY);
-    }
-    if (ev->traits.representation > 0.50f) {
-      if (gov->rights->rights[CIV_RIGHT_DUE_PROCESS].level == CIV_PROTECTION_NONE)
-        civ_rights_set_protection(gov->rights, CIV_RIGHT_DUE_PROCESS, CIV_PROTECTION_CONSTITUTIONAL);
-      if (gov->rights->rights[CIV_RIGHT_VOTE].level == CIV_PROTECTION_NONE)
-        civ_rights_set_protection(gov->rights, CIV_RIGHT_VOTE, CIV_PROTECTION_CONSTITUTIONAL);
-    }
+  case CIV_GOV_STAGE_RIGHTS:
+    if (cadence_take(gov, CIV_GOV_CADENCE_RIGHTS, dt, &tdt) && gov->rights && gov->judiciary) {
+      float rule_of_law = gov->judiciary->rule_of_law;
+      civ_rights_update(gov->rights, tdt, rule_of_law,
+                        (float)ev->traits.representation,
+                        (float)ev->traits.centralization,
+                        ev->emergency_active ? (float)ev->emergency_power_grab : 0.0f,
+                        gov->corruption_engine->systemic_index, education_level);
+
+      /* Default: grant basic rights if representation rises */
+      if (ev->traits.representation > 0.30f) {
+        if (gov->rights->rights[CIV_RIGHT_SPEECH].level == CIV_PROTECTION_NONE)
+          civ_rights_set_protection(gov->rights, CIV_RIGHT_SPEECH, CIV_PROTECTION_STATUTORY);
+        if (gov->rights->rights[CIV_RIGHT_ASSEMBLY].level == CIV_PROTECTION_NONE)
+          civ_rights_set_protection(gov->rights, CIV_RIGHT_ASSEMBLY, CIV_PROTECTION_STATUTORY);
+        if (gov->rights->rights[CIV_RIGHT_PROPERTY].level == CIV_PROTECTION_NONE)
+          civ_rights_set_protection(gov->rights, CIV_RIGHT_PROPERTY, CIV_PROTECTION_STATUTORY);
+      }
+      if (ev->traits.representation > 0.50f) {
+        if (gov->rights->rights[CIV_RIGHT_DUE_PROCESS].level == CIV_PROTECTION_NONE)
+          civ_rights_set_protection(gov->rights, CIV_RIGHT_DUE_PROCESS, CIV_PROTECTION_CONSTITUTIONAL);
+        if (gov->rights->rights[CIV_RIGHT_VOTE].level == CIV_PROTECTION_NONE)
+          civ_rights_set_protection(gov->rights, CIV_RIGHT_VOTE, CIV_PROTECTION_CONSTITUTIONAL);
+      }
 
-    /* File constitutional challenges when rights violations detected */
-    for (int i = 0; i < CIV_RIGHT_COUNT; i++) {
-      if (gov->rights->rights[i].violations_this_cycle > 0
-          && gov->rights->constitutional_challenges > 0
-          && gov->judiciary->case_count < gov->judiciary->case_capacity) {
-        civ_judiciary_file_case(gov->judiciary, CIV_CASE_CONSTITUTIONAL,
-                                "Rights violation challenge", 0.60f);
-        gov->rights->rights[i].violations_this_cycle = 0;
+      /* File constitutional challenges when rights violations detected */
+      for (int i = 0; i < CIV_RIGHT_COUNT; i++) {
+        if (gov->rights->rights[i].violations_this_cycle > 0
+            && gov->rights->constitutional_challenges > 0
+            && gov->judiciary->case_count < gov->judiciary->case_capacity) {
+          civ_judiciary_file_case(gov->judiciary, CIV_CASE_CONSTITUTIONAL,
+                                  "Rights violation challenge", 0.60f);
+          gov->rights->rights[i].violations_this_cycle = 0;
+        }
       }
     }
-  }
+    break;
 
   /* ── 11. Political violence: coups, assassinations, civil war ── */
-  if (gov->political_violence) {
-    float cohesion = (float)civ_governance_cohesion_bonus(ev);
-    civ_political_violence_update(gov->political_violence, dt,
-                                  (float)ev->traits.militarization,
-                                  (float)ev->traits.centralization,
-                                  gov->legitimacy, gov->stability,
-                                  gov->corruption_engine->systemic_index,
-                                  (float)ev->traits.representation,
-                                  gov->executive ? gov->executive->power_consolidation : 0.0f,
-                                  gov->executive ? gov->executive->constitution_suspended : false,
-                                  (float)gov->faction_count, cohesion);
-  }
+  case CIV_GOV_STAGE_VIOLENCE:
+    if (cadence_take(gov, CIV_GOV_CADENCE_VIOLENCE, dt, &tdt) && gov->political_violence) {
+      float cohesion = (float)civ_governance_cohesion_bonus(ev);
+      civ_political_violence_update(gov->political_violence, tdt,
+                                    (float)ev->traits.militarization,
+                                    (float)ev->traits.centralization,
+                                    gov->legitimacy, gov->stability,
+                                    gov->corruption_engine->systemic_index,
+                                    (float)ev->traits.representation,
+                                    gov->executive ? gov->executive->power_consolidation : 0.0f,
+                                    gov->executive ? gov->executive->constitution_suspended : false,
+                                    (float)gov->faction_count, cohesion);
+    }
+    break;
 
   /* ── 12. Tick corruption engine ── */
-  /* Systemic corruption rises with low efficiency, high institutional rigidity */
-  civ_float_t corruption_pressure = (1.0f - gov->efficiency) * 0.02f
-                                    + gov->profile.institutional_rigidity * 0.01f;
-  /* Add involvement from each actor (simplified: one aggregate actor) */
-  civ_corruption_add_involvement(gov->corruption_engine, "STATE", corruption_pressure * dt);
-  /* Audit effectiveness from efficiency */
-  gov->corruption_engine->audit_effectiveness = gov->efficiency * 0.8f;
-  /* Run light audit each tick */
-  civ_corruption_run_audit(gov->corruption_engine, 0.02f * dt);
-
-  /* Leakage from corruption reduces effective budget */
-  civ_float_t corruption_leakage = civ_corruption_calculate_leakage(gov->corruption_engine,
-                                                                     total_budget);
-  (void)corruption_leakage; /* used implicitly via reduced budget in economy */
+  case CIV_GOV_STAGE_CORRUPTION: {
+    /* Systemic corruption rises with low efficiency, high institutional rigidity */
+    civ_float_t corruption_pressure = (1.0f - gov->efficiency) * 0.02f
+                                      + gov->profile.institutional_rigidity * 0.01f;
+    /* Add involvement from each actor (simplified: one aggregate actor) */
+    civ_corruption_add_involvement_sym(gov->corruption_engine, CIV_SYM_STATE,
+                                       corruption_pressure * dt);
+    /* Audit effectiveness from efficiency */
+    gov->corruption_engine->audit_effectiveness = gov->efficiency * 0.8f;
+    /* Run light audit each tick */
+    civ_corruption_run_audit(gov->corruption_engine, 0.02f * dt);
+
+    /* Leakage from corruption reduces effective budget */
+    civ_float_t corruption_leakage = civ_corruption_calculate_leakage(gov->corruption_engine,
+                                                                       total_budget);
+    (void)corruption_leakage; /* used implicitly via reduced budget in economy */
+    break;
+  }
 
   /* ── Tick ministries: budget competition, reforms, minister dynamics ── */
-  civ_ministry_update_all(gov->ministry_manager, total_budget,
-                          gov->efficiency, gov->corruption_engine->systemic_index, dt);
+  case CIV_GOV_STAGE_MINISTRIES:
+    if (cadence_take(gov, CIV_GOV_CADENCE_MINISTRIES, dt, &tdt))
+      civ_ministry_update_all(gov->ministry_manager, total_budget,
+                              gov->efficiency, gov->corruption_engine->systemic_index, tdt);
+    break;
 
   /* ── Stability drift ── */
-  /* Legitimacy pulls stability; corruption erodes both */
-  float drift = (gov->legitimacy - gov->stability) * 0.02f * dt;
-  drift -= gov->corruption_engine->systemic_index * 0.01f * dt;
-  gov->stability += drift;
-
-  /* Legitimacy: eroded by corruption, boosted by representation */
-  float legit_drift = gov->profile.representation_index * 0.01f
-                      - gov->corruption_engine->systemic_index * 0.02f;
-  gov->legitimacy += legit_drift * dt;
-
-  /* Efficiency: dragged by corruption and rigidity */
-  float eff_target = 0.5f + gov->profile.representation_index * 0.3f
-                     - gov->profile.institutional_rigidity * 0.2f
-                     - gov->corruption_engine->systemic_index * 0.4f;
-  gov->efficiency += (eff_target - gov->efficiency) * 0.03f * dt;
-
-  /* Clamp */
-  if (gov->stability < 0.0f)  gov->stability = 0.0f;
-  if (gov->stability > 1.0f)  gov->stability = 1.0f;
-  if (gov->legitimacy < 0.0f) gov->legitimacy = 0.0f;
-  if (gov->legitimacy > 1.0f) gov->legitimacy = 1.0f;
-  if (gov->efficiency < 0.0f) gov->efficiency = 0.0f;
-  if (gov->efficiency > 1.0f) gov->efficiency = 1.0f;
+  case CIV_GOV_STAGE_DRIFT: {
+    /* Legitimacy pulls stability; corruption erodes both */
+    float drift = (gov->legitimacy - gov->stability) * 0.02f * dt;
+    drift -= gov->corruption_engine->systemic_index * 0.01f * dt;
+    gov->stability += drift;
+
+    /* Legitimacy: eroded by corruption, boosted by representation */
+    float legit_drift = gov->profile.representation_index * 0.01f
+                        - gov->corruption_engine->systemic_index * 0.02f;
+    gov->legitimacy += legit_drift * dt;
+
+    /* Efficiency: dragged by corruption and rigidity */
+    float eff_target = 0.5f + gov->profile.representation_index * 0.3f
+                       - gov->profile.institutional_rigidity * 0.2f
+                       - gov->corruption_engine->systemic_index * 0.4f;
+    gov->efficiency += (eff_target - gov->efficiency) * 0.03f * dt;
+
+    /* Clamp */
+    if (gov->stability < 0.0f)  gov->stability = 0.0f;
+    if (gov->stability > 1.0f)  gov->stability = 1.0f;
+    if (gov->legitimacy < 0.0f) gov->legitimacy = 0.0f;
+    if (gov->legitimacy > 1.0f) gov->legitimacy = 1.0f;
+    if (gov->efficiency < 0.0f) gov->efficiency = 0.0f;
+    if (gov->efficiency > 1.0f) gov->efficiency = 1.0f;
+    break;
+  }
 
   /* ── Societal health dashboard ── */
+  case CIV_GOV_STAGE_METRICS: {
+    bool metrics_due = cadence_take(gov, CIV_GOV_CADENCE_METRICS, dt, &tdt);
+    if (metrics_due) {
+      gov->societal_health.stability_index     = gov->stability;
+      gov->societal_health.cohesion_index      = gov->legitimacy;
+      gov->societal_health.corruption_index    = ce->systemic_index;
+      gov->societal_health.radicalization_index = 1.0f - gov->profile.citizen_happiness;
+      gov->societal_health.evolution_velocity  = (float)(ev->reform_cooldown > 0 ? 1.0/ev->reform_cooldown : 1.0);
+      gov->societal_health.secularism_index    = 0.5f + ev->traits.meritocracy * 0.3f - ev->traits.religious_authority * 0.3f;
+      gov->societal_health.vitality_index      = gov->profile.citizen_happiness;
+      gov->societal_health.economic_cohesion   = gov->efficiency;
+      gov->societal_health.international_repute = gov->profile.governance_ranking / 100.0f;
+      gov->societal_health.gdp_index           = 1.0f; /* set externally from economy */
+      gov->societal_health.industrial_stability = 0.8f;
+      /* Reformat the title only when the traits crossed into another one */
+      uint16_t title_key = (uint16_t)(civ_governance_describe_key(ev) + 1);
+      if (title_key != gov->title_key) {
+        civ_governance_describe_key_text((uint16_t)(title_key - 1),
+                                         gov->societal_health.dominant_title,
+                                         STRING_SHORT_LEN);
+        gov->title_key = title_key;
+      }
+    }
 
-  gov->societal_health.stability_index     = gov->stability;
-  gov->societal_health.cohesion_index      = gov->legitimacy;
-  gov->societal_health.corruption_index    = ce->systemic_index;
-  gov->societal_health.radicalization_index = 1.0f - gov->profile.citizen_happiness;
-  gov->societal_health.evolution_velocity  = (float)(ev->reform_cooldown > 0 ? 1.0/ev->reform_cooldown : 1.0);
-  gov->societal_health.secularism_index    = 0.5f + ev->traits.meritocracy * 0.3f - ev->traits.religious_authority * 0.3f;
-  gov->societal_health.vitality_index      = gov->profile.citizen_happiness;
-  gov->societal_health.economic_cohesion   = gov->efficiency;
-  gov->societal_health.international_repute = gov->profile.governance_ranking / 100.0f;
-  gov->societal_health.gdp_index           = 1.0f; /* set externally from economy */
-  gov->societal_health.industrial_stability = 0.8f;
-  civ_governance_describe(ev, gov->societal_health.dominant_title, STRING_SHORT_LEN);
-
-  /* ── Periodic legislative session (every ~20 turns) ── */
-  gov->turns_since_last_session++;
-  if (gov->turns_since_last_session >= 20) {
-    civ_government_hold_session(gov);
-    gov->turns_since_last_session = 0;
+    /* ── Periodic legislative session (every ~20 turns) ── */
+    gov->turns_since_last_session++;
+    if (gov->turns_since_last_session >= 20) {
+      civ_government_hold_session(gov);
+      gov->turns_since_last_session = 0;
+    }
+
+    /* ── Decision trigger from evolution system ── */
+    if (civ_governance_should_decide(ev, (civ_float_t)total_population, (civ_float_t)culture_level)) {
+      civ_governance_decision_t decision =
+        civ_governance_generate_decision(ev, (civ_float_t)total_population, (civ_float_t)culture_level);
+      /* Auto-resolve: pick option B (moderate) for now — player UI would intercept this */
+      civ_governance_apply_decision(ev, &decision, 1);
+    }
+
+    /* ── Notebook: record significant events ── */
+    if (metrics_due) {
+      char note[STRING_MAX_LEN];
+      snprintf(note, sizeof(note),
+               "Turn: stab=%.2f legit=%.2f eff=%.2f corr=%.3f | %s | %s",
+               gov->stability, gov->legitimacy, gov->efficiency, ce->systemic_index,
+               gov->societal_health.dominant_title, civ_government_proximity_label(gov));
+      civ_notebook_add_note(gov->notebook, "Governance Update", note);
+    }
+    break;
   }
 
-  /* ── Decision trigger from evolution system ── */
-  if (civ_governance_should_decide(ev, (civ_float_t)total_population, (civ_float_t)culture_level)) {
-    civ_governance_decision_t decision =
-      civ_governance_generate_decision(ev, (civ_float_t)total_population, (civ_float_t)culture_level);
-    /* Auto-resolve: pick option B (moderate) for now — player UI would intercept this */
-    civ_governance_apply_decision(ev, &decision, 1);
+  default:
+    break;
   }
+}
 
-  /* ── Notebook: record significant events ── */
-  char note[STRING_MAX_LEN], label[64];
-  civ_governance_describe(ev, label, sizeof(label));
-  snprintf(note, sizeof(note),
-           "Turn: stab=%.2f legit=%.2f eff=%.2f corr=%.3f | %s | %s",
-           gov->stability, gov->legitimacy, gov->efficiency,
-           ce->systemic_index, label, civ_government_proximity_label(gov));
-  civ_notebook_add_note(gov->notebook, "Governance Update", note);
+void civ_government_update(civ_government_t *gov, float dt,
+                           int total_population, float culture_level,
+                           float total_budget, float education_level,
+                           float economic_confidence, float literacy_rate,
+                           float faction_support, int faction_count) {
+  if (!gov) return;
+  civ_government_begin_update(gov, dt, total_population, culture_level, total_budget,
+                              education_level, economic_confidence, literacy_rate,
+                              faction_support, faction_count);
+  for (int s = 0; s < CIV_GOV_STAGE_COUNT; s++)
+    civ_government_update_stage(gov, (civ_gov_stage_t)s);
 }
 
 /* ── Corruption: single source of truth ──────────────────────────── */
@@ -448,6 +756,18 @@ float civ_government_get_corruption(const civ_government_t *gov) {
   return gov->corruption_engine->systemic_index;
 }
 
+bool civ_government_action_is_legal(const civ_government_t *gov,
+                                    civ_constitutional_action_t action) {
+  if (!gov) return false;
+  const civ_executive_t *e = gov->executive;
+  civ_legal_context_t ctx = {
+    .authority           = e ? e->executive_strength : 0.5f,
+    .legislative_support = (gov->faction_count > 0) ? gov->faction_support : 0.55f,
+    .suspended           = e ? e->constitution_suspended : false,
+  };
+  return civ_constitution_is_legal(gov->constitution, action, &ctx);
+}
+
 float civ_government_get_stability(const civ_government_t *gov) {
   return gov ? gov->stability : 0.0f;
 }
@@ -461,49 +781,149 @@ void civ_government_set_budget(civ_government_t *gov, int category, float amount
 /* ── Legislative session ──────────────────────────────────────────── */
 void civ_government_hold_session(civ_government_t *gov) {
   if (!gov || !gov->legislative_manager) return;
+  civ_legislative_manager_t *lm = gov->legislative_manager;
 
-  /* Create a simple bill to test legislative machinery */
-  civ_rule_t *rule = civ_rule_create("Public Order Act", CIV_RULE_SCOPE_NATIONAL, CIV_RULE_TYPE_LAW);
-  if (!rule) return;
-  strncpy(rule->description, "Maintain public order through regulated enforcement",
-          STRING_MAX_LEN - 1);
-  rule->authority_role[0] = '\0';
-  rule->active = true;
-
-  /* Propose through first legislative body if one exists */
-  if (gov->legislative_manager->body_count > 0) {
-    const char *body_id = gov->legislative_manager->bodies[0].id;
-    civ_legislative_propose_bill(gov->legislative_manager, body_id, rule, false);
-
-    /* Dynamic voting from faction influence — no hardcoded split. */
-    int total_members = gov->legislative_manager->bodies[0].member_count;
-    if (total_members < 10) total_members = 100;
-    float gov_support = (gov->faction_count > 0) ? gov->faction_support : 0.55f;
-    /* Opposition fragments with more factions */
-    float fragmentation = (gov->faction_count > 2) ? (gov->faction_count - 2) * 0.05f : 0.0f;
-    float yes_ratio = gov_support * (1.0f - fragmentation);
-    float no_ratio  = (1.0f - gov_support) * (1.0f - fragmentation * 0.5f);
-    if (yes_ratio < 0.15f) yes_ratio = 0.15f;
-    if (no_ratio < 0.10f)  no_ratio = 0.10f;
-    int yes = (int)(total_members * yes_ratio);
-    int no  = (int)(total_members * no_ratio);
-    for (int i = 0; i < yes; i++)
-      civ_legislative_cast_vote(gov->legislative_manager, rule->id, true);
-    for (int i = 0; i < no; i++)
-      civ_legislative_cast_vote(gov->legislative_manager, rule->id, false);
-    /* remainder = abstain */
-
-    /* Resolve: apply to constitution in custom_governance */
-    /* Note: constitution lives in custom_governance_t — accessed via game struct */
-    civ_legislative_resolve_bill(gov->legislative_manager, rule->id, gov->constitution);
-  } else {
+  if (lm->body_count == 0) {
     /* No legislative body exists — create a default one */
     civ_legislative_body_t *body = civ_legislative_body_create("General Assembly", "Leader");
     if (body) {
       body->member_count = 100;
-      civ_legislative_manager_add_body(gov->legislative_manager, body);
+      civ_legislative_manager_add_body(lm, body);
       free(body);
     }
-    civ_rule_destroy(rule);
+    return;
   }
+
+  /* Seats from faction influence — no hardcoded split. The government
+     bloc sits on the first axis, the opposition against it. */
+  static const float programme[CIV_LEGISLATIVE_AXES] = {1.0f, 0.0f, 0.0f, 0.0f};
+  int total_members = lm->bodies[0].member_count;
+  if (total_members < 10) total_members = 100;
+  float gov_support = (gov->faction_count > 0) ? gov->faction_support : 0.55f;
+  /* Opposition fragments with more factions */
+  float fragmentation = (gov->faction_count > 2) ? (gov->faction_count - 2) * 0.05f : 0.0f;
+  float yes_ratio = gov_support * (1.0f - fragmentation);
+  float no_ratio  = (1.0f - gov_support) * (1.0f - fragmentation * 0.5f);
+  if (yes_ratio < 0.15f) yes_ratio = 0.15f;
+  if (no_ratio < 0.10f)  no_ratio = 0.10f;
+  /* remainder = abstain */
+  civ_legislative_apportion(lm, 0, total_members, programme, yes_ratio, no_ratio);
+  memcpy(lm->leader, programme, sizeof(lm->leader));
+
+  /* The government's standing bill, until it is law */
+  static const char *act = "Public Order Act";
+  const civ_constitution_t *c = gov->constitution;
+  bool enacted = false;
+  for (size_t i = 0; c && i < c->rule_count && !enacted; i++)
+    enacted = c->rules[i].active && strcmp(c->rules[i].name, act) == 0;
+  if (!enacted) {
+    civ_rule_t *rule = civ_rule_create(act, CIV_RULE_SCOPE_NATIONAL, CIV_RULE_TYPE_LAW);
+    if (rule) {
+      strncpy(rule->description, "Maintain public order through regulated enforcement",
+              STRING_MAX_LEN - 1);
+      rule->authority_role[0] = '\0';
+      rule->active = true;
+      if (civ_legislative_queue_bill(lm, 0, rule, false, programme) < 0)
+        civ_rule_destroy(rule);
+    }
+  }
+
+  /* Everything queued since the last session, bills from elsewhere too */
+  civ_legislative_run_session(lm, gov->executive, gov->constitution);
+}
+
+/* ── Save section ──────────────────────────────────────────────────── */
+
+static void government_put(const civ_government_t *gov, civ_ser_cursor_t *c) {
+  uint32_t positions = (uint32_t)gov->position_count;
+  int32_t stature = (int32_t)gov->stature_tier;
+  civ_ser_put(c, gov->id, sizeof(gov->id));
+  civ_ser_put(c, gov->name, sizeof(gov->name));
+  CIV_SER_PUT(c, positions);
+  civ_ser_put(c, gov->positions,
+              gov->position_count * sizeof(civ_political_position_t));
+  CIV_SER_PUT(c, gov->profile);
+  CIV_SER_PUT(c, gov->stability);
+  CIV_SER_PUT(c, gov->legitimacy);
+  CIV_SER_PUT(c, gov->efficiency);
+  CIV_SER_PUT(c, gov->evolution_state);
+  CIV_SER_PUT(c, gov->societal_health);
+  CIV_SER_PUT(c, gov->budget_allocations);
+  CIV_SER_PUT(c, gov->legislative_threshold);
+  CIV_SER_PUT(c, gov->turns_since_last_session);
+  CIV_SER_PUT(c, gov->faction_support);
+  CIV_SER_PUT(c, gov->faction_count);
+  CIV_SER_PUT(c, stature);
+}
+
+static civ_result_t government_serialize(const void *object, char *buffer,
+                                         size_t buffer_size, size_t *written) {
+  civ_ser_cursor_t c = civ_ser_cursor(buffer, buffer_size);
+  government_put((const civ_government_t *)object, &c);
+  if (written) *written = c.pos;
+  return c.overflow ? (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Buffer too small"}
+                    : (civ_result_t){CIV_OK, NULL};
+}
+
+static size_t government_serialized_size(const void *object) {
+  civ_ser_cursor_t c = civ_ser_cursor(NULL, 0);
+  government_put((const civ_government_t *)object, &c);
+  return c.pos;
+}
+
+static civ_result_t government_deserialize(void *object, const char *buffer,
+                                           size_t buffer_size) {
+  civ_government_t *gov = (civ_government_t *)object;
+  civ_ser_cursor_t c = civ_ser_cursor((void *)buffer, buffer_size);
+  char id[sizeof(gov->id)], name[sizeof(gov->name)];
+  uint32_t positions = 0;
+  civ_ser_get(&c, id, sizeof(id));
+  civ_ser_get(&c, name, sizeof(name));
+  if (!CIV_SER_GET(&c, positions) ||
+      (size_t)positions * sizeof(civ_political_position_t) > buffer_size - c.pos)
+    return (civ_result_t){CIV_ERROR_INVALID_DATA, "Government section size"};
+
+  size_t cap = MAX(MAX((size_t)positions, gov->position_capacity), (size_t)1);
+  civ_political_position_t *p = (civ_political_position_t *)CIV_REALLOC(
+      gov->positions, cap * sizeof(civ_political_position_t));
+  if (!p) return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Position allocation"};
+  uint8_t *flags = (uint8_t *)CIV_REALLOC(gov->position_flags, cap);
+  if (!flags) {
+    gov->positions = p;
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Position allocation"};
+  }
+  gov->positions = p;
+  gov->position_flags = flags;
+  gov->position_capacity = cap;
+  gov->position_count = positions;
+  civ_ser_get(&c, gov->positions, positions * sizeof(civ_political_position_t));
+  civ_government_mark_structure_dirty(gov);
+
+  int32_t stature = 0;
+  memcpy(gov->id, id, sizeof(id));
+  memcpy(gov->name, name, sizeof(name));
+  gov->id[sizeof(gov->id) - 1] = gov->name[sizeof(gov->name) - 1] = '\0';
+  CIV_SER_GET(&c, gov->profile);
+  CIV_SER_GET(&c, gov->stability);
+  CIV_SER_GET(&c, gov->legitimacy);
+  CIV_SER_GET(&c, gov->efficiency);
+  CIV_SER_GET(&c, gov->evolution_state);
+  CIV_SER_GET(&c, gov->societal_health);
+  gov->title_key = 0;
+  CIV_SER_GET(&c, gov->budget_allocations);
+  CIV_SER_GET(&c, gov->legislative_threshold);
+  CIV_SER_GET(&c, gov->turns_since_last_session);
+  CIV_SER_GET(&c, gov->faction_support);
+  CIV_SER_GET(&c, gov->faction_count);
+  CIV_SER_GET(&c, stature);
+  gov->stature_tier = (civ_stature_tier_t)stature;
+  return c.overflow
+             ? (civ_result_t){CIV_ERROR_INVALID_DATA, "Government section truncated"}
+             : (civ_result_t){CIV_OK, NULL};
+}
+
+civ_serializable_t civ_government_serializable(civ_government_t *gov) {
+  return (civ_serializable_t){gov, government_serialize,
+                              government_deserialize,
+                              government_serialized_size};
 }
@@ -8,9 +8,7 @@
 #include <stdlib.h>
 #include <string.h>
 
-civ_civil_service_t *civ_civil_service_create(void) {
-  civ_civil_service_t *cs = CIV_MALLOC(sizeof(civ_civil_service_t));
-  if (!cs) return NULL;
+void civ_civil_service_init(civ_civil_service_t *cs) {
   memset(cs, 0, sizeof(*cs));
   cs->dept_capacity = 8;
   cs->departments = CIV_MALLOC(sizeof(civ_cs_department_t) * cs->dept_capacity);
@@ -22,12 +20,23 @@ civ_civil_service_t *civ_civil_service_create(void) {
   cs->corruption_vulnerability = 0.20f;
   cs->political_neutrality = 0.50f;
   cs->budget_efficiency = 0.55f;
+}
+
+civ_civil_service_t *civ_civil_service_create(void) {
+  civ_civil_service_t *cs = CIV_MALLOC(sizeof(civ_civil_service_t));
+  if (!cs) return NULL;
+  civ_civil_service_init(cs);
   return cs;
 }
 
-void civ_civil_service_destroy(civ_civil_service_t *cs) {
+void civ_civil_service_free(civ_civil_service_t *cs) {
   if (!cs) return;
   free(cs->departments);
+}
+
+void civ_civil_service_destroy(civ_civil_service_t *cs) {
+  if (!cs) return;
+  civ_civil_service_free(cs);
   free(cs);
 }
 
@@ -42,31 +51,31 @@ void civ_civil_service_update(civ_civil_service_t *cs, float dt,
     case CIV_CS_RECRUITMENT_EXAM:
       /* Merit-based: high competence, high neutrality, high rigidity */
       cs->avg_competence += (meritocracy_trait * 0.6f + education_level * 0.3f
-                             - cs->avg_competence) * 0.04f * dt;
-      cs->political_neutrality += (0.80f - cs->political_neutrality) * 0.03f * dt;
-      cs->bureaucratic_rigidity += (0.65f - cs->bureaucratic_rigidity) * 0.02f * dt;
+                             - cs->avg_competence) * civ_compound(0.04f, dt);
+      cs->political_neutrality += (0.80f - cs->political_neutrality) * civ_compound(0.03f, dt);
+      cs->bureaucratic_rigidity += (0.65f - cs->bureaucratic_rigidity) * civ_compound(0.02f, dt);
       cs->corruption_vulnerability = 0.10f;
       break;
     case CIV_CS_RECRUITMENT_APPOINTMENT:
       /* Politically responsive, moderate competence */
-      cs->avg_competence += (0.50f - cs->avg_competence) * 0.04f * dt;
-      cs->political_neutrality += (0.30f - cs->political_neutrality) * 0.04f * dt;
-      cs->bureaucratic_rigidity += (0.25f - cs->bureaucratic_rigidity) * 0.03f * dt;
+      cs->avg_competence += (0.50f - cs->avg_competence) * civ_compound(0.04f, dt);
+      cs->political_neutrality += (0.30f - cs->political_neutrality) * civ_compound(0.04f, dt);
+      cs->bureaucratic_rigidity += (0.25f - cs->bureaucratic_rigidity) * civ_compound(0.03f, dt);
       cs->corruption_vulnerability = 0.35f;
       break;
     case CIV_CS_RECRUITMENT_PATRONAGE:
       /* Loyal to patrons, low competence, high corruption */
-      cs->avg_competence += (0.30f - cs->avg_competence) * 0.04f * dt;
-      cs->political_neutrality += (0.15f - cs->political_neutrality) * 0.05f * dt;
-      cs->bureaucratic_rigidity += (0.15f - cs->bureaucratic_rigidity) * 0.04f * dt;
+      cs->avg_competence += (0.30f - cs->avg_competence) * civ_compound(0.04f, dt);
+      cs->political_neutrality += (0.15f - cs->political_neutrality) * civ_compound(0.05f, dt);
+      cs->bureaucratic_rigidity += (0.15f - cs->bureaucratic_rigidity) * civ_compound(0.04f, dt);
       cs->corruption_vulnerability = 0.55f;
       break;
     case CIV_CS_RECRUITMENT_HYBRID:
     default:
       cs->avg_competence += (meritocracy_trait * 0.4f + 0.30f
-                             - cs->avg_competence) * 0.03f * dt;
-      cs->political_neutrality += (0.50f - cs->political_neutrality) * 0.03f * dt;
-      cs->bureaucratic_rigidity += (0.40f - cs->bureaucratic_rigidity) * 0.02f * dt;
+                             - cs->avg_competence) * civ_compound(0.03f, dt);
+      cs->political_neutrality += (0.50f - cs->political_neutrality) * civ_compound(0.03f, dt);
+      cs->bureaucratic_rigidity += (0.40f - cs->bureaucratic_rigidity) * civ_compound(0.02f, dt);
       cs->corruption_vulnerability = 0.25f;
       break;
   }
@@ -78,7 +87,7 @@ void civ_civil_service_update(civ_civil_service_t *cs, float dt,
   /* Institutional memory: grows with time, eroded by patronage turnover */
   float memory_target = (cs->recruitment_model == CIV_CS_RECRUITMENT_EXAM) ? 0.80f
                       : (cs->recruitment_model == CIV_CS_RECRUITMENT_PATRONAGE) ? 0.25f : 0.55f;
-  cs->institutional_memory += (memory_target - cs->institutional_memory) * 0.02f * dt;
+  cs->institutional_memory += (memory_target - cs->institutional_memory) * civ_compound(0.02f, dt);
 
   /* Budget efficiency: competence * neutrality */
   cs->budget_efficiency = cs->avg_competence * 0.5f + cs->political_neutrality * 0.3f
@@ -89,7 +98,7 @@ void civ_civil_service_update(civ_civil_service_t *cs, float dt,
   for (int i = 0; i < cs->dept_count; i++) {
     civ_cs_department_t *d = &cs->departments[i];
     d->budget = per_dept_budget;
-    d->avg_competence += (cs->avg_competence - d->avg_competence) * 0.05f * dt;
+    d->avg_competence += (cs->avg_competence - d->avg_competence) * civ_compound(0.05f, dt);
     d->morale += (government_efficiency * 0.3f + (1.0f - actual_corruption) * 0.3f
                   - d->morale * 0.1f) * 0.05f * dt;
     if (d->morale < 0.10f) d->morale = 0.10f;
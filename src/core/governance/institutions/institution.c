@@ -11,22 +11,65 @@
 #include <stdlib.h>
 #include <string.h>
 
+#define GROW_COLUMN(field, cap)                                                \
+  do {                                                                         \
+    void *grown = CIV_REALLOC(manager->field, (cap) * sizeof(*manager->field)); \
+    if (!grown)                                                                \
+      return false;                                                            \
+    manager->field = grown;                                                    \
+  } while (0)
+
+static bool reserve_institutions(civ_institution_manager_t *manager,
+                                 size_t cap) {
+  if (cap <= manager->capacity)
+    return true;
+  GROW_COLUMN(items, cap);
+  GROW_COLUMN(focuses, cap);
+  GROW_COLUMN(stature, cap);
+  GROW_COLUMN(maintenance_cost, cap);
+  GROW_COLUMN(log_stature, cap);
+  GROW_COLUMN(state, cap);
+  manager->capacity = cap;
+  return true;
+}
+
+/* Benefit scaling is logarithmic: bonus = log2(1 + stature) * 0.1 */
+static void add_bonus(civ_institution_manager_t *manager, size_t i,
+                      float gain) {
+  uint32_t focuses = manager->focuses[i];
+  for (int b = 0; b < CIV_INSTITUTION_FOCUS_COUNT; b++) {
+    if (focuses & (1u << b))
+      manager->focus_bonus[b] += gain * 0.1f;
+  }
+}
+
+void civ_institution_manager_init(civ_institution_manager_t *manager) {
+  memset(manager, 0, sizeof(*manager));
+  reserve_institutions(manager, 8);
+}
+
 civ_institution_manager_t *civ_institution_manager_create(void) {
   civ_institution_manager_t *manager = (civ_institution_manager_t *)CIV_MALLOC(
       sizeof(civ_institution_manager_t));
-  if (manager) {
-    manager->count = 0;
-    manager->capacity = 8;
-    manager->items = (civ_institution_t *)CIV_MALLOC(sizeof(civ_institution_t) *
-                                                     manager->capacity);
-  }
+  if (manager)
+    civ_institution_manager_init(manager);
   return manager;
 }
 
+void civ_institution_manager_free(civ_institution_manager_t *manager) {
+  if (!manager)
+    return;
+  CIV_FREE(manager->items);
+  CIV_FREE(manager->focuses);
+  CIV_FREE(manager->stature);
+  CIV_FREE(manager->maintenance_cost);
+  CIV_FREE(manager->log_stature);
+  CIV_FREE(manager->state);
+}
+
 void civ_institution_manager_destroy(civ_institution_manager_t *manager) {
   if (manager) {
-    if (manager->items)
-      CIV_FREE(manager->items);
+    civ_institution_manager_free(manager);
     CIV_FREE(manager);
   }
 }
@@ -37,33 +80,44 @@ civ_result_t civ_institution_found(civ_institution_manager_t *manager,
   if (!manager)
     return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null manager"};
 
-  if (manager->count >= manager->capacity) {
-    size_t new_cap = manager->capacity * 2;
-    civ_institution_t *new_items = (civ_institution_t *)realloc(
-        manager->items, sizeof(civ_institution_t) * new_cap);
-    if (!new_items)
-      return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
-    manager->items = new_items;
-    manager->capacity = new_cap;
-  }
+  if (manager->count >= manager->capacity &&
+      !reserve_institutions(manager, MAX(8, manager->capacity * 2)))
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
 
-  civ_institution_t *inst = &manager->items[manager->count++];
+  size_t i = manager->count++;
+  civ_institution_t *inst = &manager->items[i];
   memset(inst, 0, sizeof(civ_institution_t));
 
   strncpy(inst->name, name, STRING_MEDIUM_LEN - 1);
-  inst->focuses = focuses;
   if (governing_role) {
     strncpy(inst->governing_role, governing_role, STRING_SHORT_LEN - 1);
   }
+  snprintf(inst->id, STRING_SHORT_LEN, "inst_%zu", manager->count);
 
-  inst->stature = 1.0f; /* Starting point */
-  inst->is_active = true;
+  manager->focuses[i] = focuses;
+  manager->stature[i] = 1.0f; /* Starting point */
+  manager->maintenance_cost[i] = 0.0f;
+  manager->state[i] = CIV_INSTITUTION_ACTIVE;
 
-  snprintf(inst->id, STRING_SHORT_LEN, "inst_%zu", manager->count);
+  float gain = log2f(1.0f + manager->stature[i]);
+  manager->log_stature[i] = gain;
+  manager->stature_log_sum += gain;
+  add_bonus(manager, i, gain);
 
   return (civ_result_t){CIV_OK, NULL};
 }
 
+civ_result_t civ_institution_dissolve(civ_institution_manager_t *manager,
+                                      size_t index) {
+  if (!manager)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null manager"};
+  if (index >= manager->count ||
+      !(manager->state[index] & CIV_INSTITUTION_ACTIVE))
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "No such institution"};
+  manager->state[index] |= CIV_INSTITUTION_DISSOLVING;
+  return (civ_result_t){CIV_OK, NULL};
+}
+
 void civ_institution_update(civ_institution_manager_t *manager,
                             civ_float_t budget_total,
                             civ_float_t gov_efficiency,
@@ -71,12 +125,16 @@ void civ_institution_update(civ_institution_manager_t *manager,
   if (!manager || manager->count == 0)
     return;
 
+  const size_t n = manager->count;
+  uint8_t *state = manager->state;
+  civ_float_t *stature = manager->stature;
+
   /* Allocation per active institution (simplistic equal split for now) */
   civ_float_t active_count = 0;
-  for (size_t i = 0; i < manager->count; i++) {
-    if (manager->items[i].is_active && !manager->items[i].is_dissolving) {
-      active_count += 1.0f;
-    }
+  for (size_t i = 0; i < n; i++) {
+    active_count += (state[i] & (CIV_INSTITUTION_ACTIVE |
+                                 CIV_INSTITUTION_DISSOLVING)) ==
+                    CIV_INSTITUTION_ACTIVE;
   }
 
   if (active_count == 0)
@@ -84,30 +142,42 @@ void civ_institution_update(civ_institution_manager_t *manager,
 
   civ_float_t budget_per_inst = budget_total / active_count;
 
-  for (size_t i = 0; i < manager->count; i++) {
-    civ_institution_t *inst = &manager->items[i];
-    if (!inst->is_active)
+  /* One pass moves every stature and rebuilds the sums behind it */
+  manager->stature_log_sum = 0.0f;
+  memset(manager->focus_bonus, 0, sizeof(manager->focus_bonus));
+
+  for (size_t i = 0; i < n; i++) {
+    if (!(state[i] & CIV_INSTITUTION_ACTIVE))
       continue;
 
-    if (inst->is_dissolving) {
-      inst->stature -= 0.1f * time_delta;
-      if (inst->stature <= 0.0f) {
-        inst->stature = 0.0f;
-        inst->is_active = false;
+    civ_float_t s = stature[i];
+    if (state[i] & CIV_INSTITUTION_DISSOLVING) {
+      s -= 0.1f * time_delta;
+      if (s <= 0.0f) {
+        stature[i] = 0.0f;
+        manager->log_stature[i] = 0.0f;
+        state[i] &= (uint8_t)~CIV_INSTITUTION_ACTIVE;
+        continue;
       }
-      continue;
+    } else {
+      /* Stature growth: Funded level * efficiency */
+      /* Maintenance cost scales exponentially: higher stature is harder to
+       * keep */
+      civ_float_t upkeep = 0.05f * powf(s, 1.2f);
+      manager->maintenance_cost[i] = upkeep;
+
+      civ_float_t net_investment = budget_per_inst - upkeep;
+
+      /* Growth or Decay based on net investment */
+      civ_float_t drift = net_investment * gov_efficiency * 0.01f;
+      s = fmaxf(0.1f, s + drift * time_delta);
     }
+    stature[i] = s;
 
-    /* Stature growth: Funded level * efficiency */
-    /* Maintenance cost scales exponentially: higher stature is harder to keep
-     */
-    inst->maintenance_cost = 0.05f * powf(inst->stature, 1.2f);
-
-    civ_float_t net_investment = budget_per_inst - inst->maintenance_cost;
-
-    /* Growth or Decay based on net investment */
-    civ_float_t drift = net_investment * gov_efficiency * 0.01f;
-    inst->stature = fmaxf(0.1f, inst->stature + drift * time_delta);
+    float gain = log2f(1.0f + s);
+    manager->log_stature[i] = gain;
+    manager->stature_log_sum += gain;
+    add_bonus(manager, i, gain);
   }
 }
 
@@ -117,12 +187,17 @@ civ_institution_get_total_bonus(const civ_institution_manager_t *manager,
   if (!manager)
     return 0.0f;
 
+  /* A single focus has its sum kept by the update */
+  for (int b = 0; b < CIV_INSTITUTION_FOCUS_COUNT; b++) {
+    if ((uint32_t)focus == (1u << b))
+      return manager->focus_bonus[b];
+  }
+
   civ_float_t total_bonus = 0.0f;
   for (size_t i = 0; i < manager->count; i++) {
-    const civ_institution_t *inst = &manager->items[i];
-    if (inst->is_active && (inst->focuses & focus)) {
-      /* Logarithmic benefit scaling: Benefit = log2(1 + stature) * 0.1 */
-      total_bonus += log2f(1.0f + inst->stature) * 0.1f;
+    if ((manager->state[i] & CIV_INSTITUTION_ACTIVE) &&
+        (manager->focuses[i] & focus)) {
+      total_bonus += (float)manager->log_stature[i] * 0.1f;
     }
   }
 
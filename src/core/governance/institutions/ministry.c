@@ -4,6 +4,7 @@
  */
 #include "core/governance/institutions/ministry.h"
 #include "common.h"
+#include "utils/rng.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
@@ -11,20 +12,29 @@
 static void civ_ministry_approve_reform(civ_reform_proposal_t *r);
 static void civ_ministry_reject_reform(civ_reform_proposal_t *r);
 
-civ_ministry_manager_t *civ_ministry_manager_create(void) {
-  civ_ministry_manager_t *mgr = CIV_MALLOC(sizeof(civ_ministry_manager_t));
-  if (!mgr) return NULL;
+void civ_ministry_manager_init(civ_ministry_manager_t *mgr) {
   memset(mgr, 0, sizeof(*mgr));
   mgr->ministry_capacity = CIV_MINISTRY_TYPE_COUNT;
   mgr->ministries = CIV_MALLOC(sizeof(civ_ministry_t) * mgr->ministry_capacity);
+}
+
+civ_ministry_manager_t *civ_ministry_manager_create(void) {
+  civ_ministry_manager_t *mgr = CIV_MALLOC(sizeof(civ_ministry_manager_t));
+  if (!mgr) return NULL;
+  civ_ministry_manager_init(mgr);
   return mgr;
 }
 
-void civ_ministry_manager_destroy(civ_ministry_manager_t *mgr) {
+void civ_ministry_manager_free(civ_ministry_manager_t *mgr) {
   if (!mgr) return;
   for (int i = 0; i < mgr->ministry_count; i++)
     free(mgr->ministries[i].proposals);
   free(mgr->ministries);
+}
+
+void civ_ministry_manager_destroy(civ_ministry_manager_t *mgr) {
+  if (!mgr) return;
+  civ_ministry_manager_free(mgr);
   free(mgr);
 }
 
@@ -39,10 +49,10 @@ civ_ministry_t *civ_ministry_create(civ_ministry_type_t type, const char *minist
   strncpy(m->minister.name, minister_name ? minister_name : "Vacant", STRING_MEDIUM_LEN - 1);
 
   /* Personalities differ slightly per ministry — randomized at creation */
-  m->minister.competence = 0.40f + (float)(rand() % 40) / 100.0f;
-  m->minister.loyalty    = 0.50f + (float)(rand() % 30) / 100.0f;
-  m->minister.ambition   = 0.20f + (float)(rand() % 50) / 100.0f;
-  m->minister.corruption_vulnerability = 0.05f + (float)(rand() % 20) / 100.0f;
+  m->minister.competence = 0.40f + (float)(civ_rand() % 40) / 100.0f;
+  m->minister.loyalty    = 0.50f + (float)(civ_rand() % 30) / 100.0f;
+  m->minister.ambition   = 0.20f + (float)(civ_rand() % 50) / 100.0f;
+  m->minister.corruption_vulnerability = 0.05f + (float)(civ_rand() % 20) / 100.0f;
 
   m->proposal_capacity = 4;
   m->proposals = CIV_MALLOC(sizeof(civ_reform_proposal_t) * m->proposal_capacity);
@@ -67,45 +77,55 @@ void civ_ministry_update_all(civ_ministry_manager_t *mgr, float total_budget,
   mgr->budget_pressure = (total_budget > 0) ? total_claimed / total_budget : 1.0f;
   if (mgr->budget_pressure > 2.0f) mgr->budget_pressure = 2.0f;
 
+  /* Rates are the same for every ministry this tick */
+  const float eff_rate  = civ_compound(0.1f, dt);  /* efficiency, satisfaction */
+  const float corr_rate = civ_compound(0.05f, dt);
+  const float expected  = base_share * 0.8f;
+  const float pressure  = mgr->budget_pressure;
+
+  /* Numbers first: each ministry reads only its own record, so this pass
+     is straight-line arithmetic over the array */
   for (int i = 0; i < mgr->ministry_count; i++) {
     civ_ministry_t *m = &mgr->ministries[i];
 
     /* Budget allocation: power_index influences share */
     m->budget = base_share * (0.7f + m->power_index * 0.6f);
-    if (mgr->budget_pressure > 1.0f)
-      m->budget /= mgr->budget_pressure;
+    if (pressure > 1.0f)
+      m->budget /= pressure;
 
     /* Efficiency: minister competence * governance efficiency */
     float target_eff = m->minister.competence * 0.5f + gov_efficiency * 0.3f
                        + (m->budget / (base_share + 1.0f)) * 0.2f;
-    m->efficiency += (target_eff - m->efficiency) * 0.1f * dt;
+    m->efficiency += (target_eff - m->efficiency) * eff_rate;
 
     /* Corruption: personal vulnerability * systemic corruption */
     m->corruption_level += (m->minister.corruption_vulnerability * corruption
                             + (1.0f - m->efficiency) * 0.01f
-                            - m->corruption_level) * 0.05f * dt;
-    if (m->corruption_level < 0.0f) m->corruption_level = 0.0f;
-    if (m->corruption_level > 0.5f) m->corruption_level = 0.5f;
+                            - m->corruption_level) * corr_rate;
+    m->corruption_level = CLAMP(m->corruption_level, 0.0f, 0.5f);
 
     /* Domain output: budget * efficiency * (1 - corruption) */
     m->domain_output = m->budget * m->efficiency * (1.0f - m->corruption_level);
 
     /* Public satisfaction: driven by output relative to expectation */
-    float expected = base_share * 0.8f;
     m->public_satisfaction += ((m->domain_output / (expected + 1.0f))
-                                - m->public_satisfaction) * 0.1f * dt;
-    if (m->public_satisfaction < 0.1f) m->public_satisfaction = 0.1f;
-    if (m->public_satisfaction > 1.0f) m->public_satisfaction = 1.0f;
+                                - m->public_satisfaction) * eff_rate;
+    m->public_satisfaction = CLAMP(m->public_satisfaction, 0.1f, 1.0f);
 
     /* Minister tenure */
     m->minister.tenure_turns++;
+  }
+
+  /* Then the reforms, which branch and draw on the RNG in ministry order */
+  for (int i = 0; i < mgr->ministry_count; i++) {
+    civ_ministry_t *m = &mgr->ministries[i];
 
     /* Process reforms */
     civ_ministry_process_reforms(m, m->budget * 0.1f, dt);
 
     /* Ambition: high-ambition ministers may propose reforms unprompted */
     if (m->minister.ambition > 0.60f && m->proposal_count < 3
-        && (rand() % 100) < (int)(m->minister.ambition * 5.0f)) {
+        && (civ_rand() % 100) < (int)(m->minister.ambition * 5.0f)) {
       civ_ministry_propose_reform(m, "Efficiency Reform", "Restructure operations");
     }
   }
@@ -9,24 +9,32 @@
 #include <string.h>
 #include <time.h>
 
-civ_notebook_t *civ_notebook_create(void) {
-  civ_notebook_t *notebook =
-      (civ_notebook_t *)CIV_MALLOC(sizeof(civ_notebook_t));
-  if (!notebook)
-    return NULL;
-
+void civ_notebook_init(civ_notebook_t *notebook) {
   memset(notebook, 0, sizeof(civ_notebook_t));
   notebook->note_capacity = 32;
   notebook->notes =
       (civ_note_t *)CIV_CALLOC(notebook->note_capacity, sizeof(civ_note_t));
+}
 
+civ_notebook_t *civ_notebook_create(void) {
+  civ_notebook_t *notebook =
+      (civ_notebook_t *)CIV_MALLOC(sizeof(civ_notebook_t));
+  if (!notebook)
+    return NULL;
+  civ_notebook_init(notebook);
   return notebook;
 }
 
-void civ_notebook_destroy(civ_notebook_t *notebook) {
+void civ_notebook_free(civ_notebook_t *notebook) {
   if (!notebook)
     return;
   CIV_FREE(notebook->notes);
+}
+
+void civ_notebook_destroy(civ_notebook_t *notebook) {
+  if (!notebook)
+    return;
+  civ_notebook_free(notebook);
   CIV_FREE(notebook);
 }
 
@@ -4,35 +4,127 @@
  */
 
 #include "core/governance/legal/constitution.h"
+#include "utils/rng.h"
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
 
-civ_constitution_t *civ_constitution_create(const char *name) {
-  civ_constitution_t *constitution = CIV_MALLOC(sizeof(civ_constitution_t));
-  if (constitution) {
-    snprintf(constitution->id, STRING_SHORT_LEN, "const_%ld", (long)time(NULL));
-    strncpy(constitution->name, name, STRING_MEDIUM_LEN - 1);
+/* ── Compiled legality ──────────────────────────────────────────── */
+static bool legal_always(const civ_legality_t *l, const civ_legal_context_t *ctx) {
+  (void)l; (void)ctx;
+  return true;
+}
+
+static bool legal_never(const civ_legality_t *l, const civ_legal_context_t *ctx) {
+  (void)l; (void)ctx;
+  return false;
+}
+
+static bool legal_with_authority(const civ_legality_t *l,
+                                 const civ_legal_context_t *ctx) {
+  return ctx->authority >= l->authority;
+}
+
+static bool legal_with_support(const civ_legality_t *l,
+                               const civ_legal_context_t *ctx) {
+  return ctx->legislative_support >= l->support;
+}
+
+static bool legal_with_both(const civ_legality_t *l,
+                            const civ_legal_context_t *ctx) {
+  return ctx->authority >= l->authority &&
+         ctx->legislative_support >= l->support;
+}
+
+static const char *const action_keys[CIV_CONST_ACTION_COUNT] = {
+#define CIV_CONSTITUTIONAL_ACTION_KEY(id, key, scope) key,
+  CIV_CONSTITUTIONAL_ACTIONS(CIV_CONSTITUTIONAL_ACTION_KEY)
+#undef CIV_CONSTITUTIONAL_ACTION_KEY
+};
 
-    constitution->rules = NULL;
-    constitution->rule_count = 0;
-    constitution->rule_capacity = 0;
+static const civ_rule_scope_t action_scopes[CIV_CONST_ACTION_COUNT] = {
+#define CIV_CONSTITUTIONAL_ACTION_SCOPE(id, key, scope) CIV_RULE_SCOPE_##scope,
+  CIV_CONSTITUTIONAL_ACTIONS(CIV_CONSTITUTIONAL_ACTION_SCOPE)
+#undef CIV_CONSTITUTIONAL_ACTION_SCOPE
+};
 
-    constitution->amendment_threshold = 0.51f; // Simple majority default
-    memset(constitution->amendment_body, 0, STRING_SHORT_LEN);
+void civ_constitution_compile(civ_constitution_t *c) {
+  if (!c)
+    return;
 
-    constitution->last_amendment = 0;
+  for (int a = 0; a < CIV_CONST_ACTION_COUNT; a++) {
+    bool forbidden = false, by_law = false, by_procedure = false;
+    float authority = 0.0f, support = 0.0f;
+
+    for (size_t i = 0; i < c->rule_count; i++) {
+      const civ_rule_t *r = &c->rules[i];
+      if (!r->active || strcmp(r->target_attribute, action_keys[a]) != 0 ||
+          !civ_rule_is_valid_in_scope(r, action_scopes[a]))
+        continue;
+      switch (r->type) {
+      case CIV_RULE_TYPE_RIGHT:
+        forbidden = true;
+        break;
+      case CIV_RULE_TYPE_LAW:
+        by_law = true;
+        authority = MAX(authority, (float)r->required_authority);
+        break;
+      case CIV_RULE_TYPE_PROCEDURE:
+        /* A procedure without its own bar takes the amendment threshold */
+        by_procedure = true;
+        support = MAX(support, r->modifier_value > 0.0f
+                                   ? (float)r->modifier_value
+                                   : (float)c->amendment_threshold);
+        break;
+      default:
+        break;
+      }
+    }
+
+    civ_legality_t *l = &c->legality[a];
+    l->authority = authority;
+    l->support = support;
+    l->test = forbidden                   ? legal_never
+              : by_law && by_procedure    ? legal_with_both
+              : by_law                    ? legal_with_authority
+              : by_procedure              ? legal_with_support
+                                          : legal_always;
   }
+}
+
+void civ_constitution_init(civ_constitution_t *constitution, const char *name) {
+  snprintf(constitution->id, STRING_SHORT_LEN, "const_%ld", (long)time(NULL));
+  strncpy(constitution->name, name, STRING_MEDIUM_LEN - 1);
+
+  constitution->rules = NULL;
+  constitution->rule_count = 0;
+  constitution->rule_capacity = 0;
+
+  constitution->amendment_threshold = 0.51f; // Simple majority default
+  memset(constitution->amendment_body, 0, STRING_SHORT_LEN);
+
+  constitution->last_amendment = 0;
+  civ_constitution_compile(constitution);
+}
+
+civ_constitution_t *civ_constitution_create(const char *name) {
+  civ_constitution_t *constitution = CIV_MALLOC(sizeof(civ_constitution_t));
+  if (constitution)
+    civ_constitution_init(constitution, name);
   return constitution;
 }
 
+void civ_constitution_free(civ_constitution_t *constitution) {
+  if (constitution && constitution->rules) {
+    // Rules are stored by value in array, but might have deep pointers later
+    // For now, flat struct
+    CIV_FREE(constitution->rules);
+  }
+}
+
 void civ_constitution_destroy(civ_constitution_t *constitution) {
   if (constitution) {
-    if (constitution->rules) {
-      // Rules are stored by value in array, but might have deep pointers later
-      // For now, flat struct
-      CIV_FREE(constitution->rules);
-    }
+    civ_constitution_free(constitution);
     CIV_FREE(constitution);
   }
 }
@@ -42,7 +134,7 @@ civ_rule_t *civ_rule_create(const char *name, civ_rule_scope_t scope,
   civ_rule_t *rule = CIV_MALLOC(sizeof(civ_rule_t));
   if (rule) {
     snprintf(rule->id, STRING_SHORT_LEN, "rule_%ld_%d", (long)time(NULL),
-             rand() % 1000);
+             civ_rand() % 1000);
     strncpy(rule->name, name, STRING_MEDIUM_LEN - 1);
     memset(rule->description, 0, STRING_MAX_LEN);
 
@@ -84,6 +176,7 @@ civ_result_t civ_constitution_add_rule(civ_constitution_t *constitution,
   }
 
   constitution->rules[constitution->rule_count++] = *rule;
+  civ_constitution_compile(constitution);
   return (civ_result_t){CIV_OK, "Rule added"};
 }
 
@@ -100,6 +193,7 @@ civ_result_t civ_constitution_remove_rule(civ_constitution_t *constitution,
                 sizeof(civ_rule_t) * (constitution->rule_count - 1 - i));
       }
       constitution->rule_count--;
+      civ_constitution_compile(constitution);
       return (civ_result_t){CIV_OK, "Rule removed"};
     }
   }
@@ -151,6 +245,7 @@ bool civ_constitution_ratify_amendment(civ_constitution_t *c, const char *rule_i
   if (!c || !rule_id) return false;
   if (legislative_support < c->amendment_threshold) return false;
   c->last_amendment = time(NULL);
+  civ_constitution_compile(c);
   return true;
 }
 
@@ -172,4 +267,5 @@ void civ_constitution_amend_rule(civ_constitution_t *c, const char *rule_id,
     strncpy(r->description, new_description, STRING_MAX_LEN - 1);
   r->modifier_value = new_modifier;
   c->last_amendment = time(NULL);
+  civ_constitution_compile(c);
 }
@@ -4,13 +4,12 @@
  */
 #include "core/governance/legal/rights.h"
 #include "common.h"
+#include "utils/rng.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
-civ_rights_declaration_t *civ_rights_create(void) {
-  civ_rights_declaration_t *r = CIV_MALLOC(sizeof(civ_rights_declaration_t));
-  if (!r) return NULL;
+void civ_rights_init(civ_rights_declaration_t *r) {
   memset(r, 0, sizeof(*r));
 
   /* Default: minimal rights in early societies */
@@ -21,9 +20,18 @@ civ_rights_declaration_t *civ_rights_create(void) {
   }
   r->civil_liberties_index = 0.15f;
   r->rights_consciousness = 0.25f;
+}
+
+civ_rights_declaration_t *civ_rights_create(void) {
+  civ_rights_declaration_t *r = CIV_MALLOC(sizeof(civ_rights_declaration_t));
+  if (!r) return NULL;
+  civ_rights_init(r);
   return r;
 }
 
+/* The declaration owns no memory of its own */
+void civ_rights_free(civ_rights_declaration_t *r) { (void)r; }
+
 void civ_rights_destroy(civ_rights_declaration_t *r) { free(r); }
 
 void civ_rights_update(civ_rights_declaration_t *r, float dt,
@@ -43,7 +51,7 @@ void civ_rights_update(civ_rights_declaration_t *r, float dt,
                                  + (rt->level == CIV_PROTECTION_CONSTITUTIONAL ? 0.25f : 0.0f)
                                  + (rt->level == CIV_PROTECTION_ABSOLUTE ? 0.35f : 0.0f)
                                  + (1.0f - corruption) * 0.15f;
-      rt->enforcement += (target_enforcement - rt->enforcement) * 0.05f * dt;
+      rt->enforcement += (target_enforcement - rt->enforcement) * civ_compound(0.05f, dt);
     }
 
     /* Emergency: rights can be suspended */
@@ -59,7 +67,7 @@ void civ_rights_update(civ_rights_declaration_t *r, float dt,
     /* Violations when enforcement is low and restriction pressure is high */
     if (rt->enforcement < 0.30f && rt->restriction_pressure > 0.50f) {
       float violation_chance = (rt->restriction_pressure - rt->enforcement) * 0.05f;
-      if ((float)rand() / RAND_MAX < violation_chance)
+      if ((float)civ_rand() / RAND_MAX < civ_compound(violation_chance, dt))
         rt->violations_this_cycle++;
     }
   }
@@ -73,12 +81,12 @@ void civ_rights_update(civ_rights_declaration_t *r, float dt,
   /* Rights consciousness: education + representation */
   r->rights_consciousness += (education_level * 0.4f + representation * 0.3f
                               + r->civil_liberties_index * 0.2f
-                              - r->rights_consciousness) * 0.03f * dt;
+                              - r->rights_consciousness) * civ_compound(0.03f, dt);
 
   /* Constitutional challenges filed when rights are violated */
   for (int i = 0; i < CIV_RIGHT_COUNT; i++) {
     if (r->rights[i].violations_this_cycle > 0 && r->rights_consciousness > 0.30f
-        && (float)rand() / RAND_MAX < 0.10f) {
+        && (float)civ_rand() / RAND_MAX < 0.10f) {
       r->constitutional_challenges++;
     }
   }
@@ -5,28 +5,131 @@
 
 #include "core/governance/political/corruption.h"
 #include "common.h"
+#include "utils/rng.h"
 #include <stdlib.h>
 #include <string.h>
 
+#define GROW_COLUMN(field, cap)                                                \
+  do {                                                                         \
+    void *grown = CIV_REALLOC(engine->field, (cap) * sizeof(*engine->field));  \
+    if (!grown)                                                                \
+      return false;                                                            \
+    engine->field = grown;                                                     \
+  } while (0)
+
+static bool reserve_nodes(civ_corruption_engine_t *engine, size_t cap) {
+  if (cap <= engine->node_capacity)
+    return true;
+  GROW_COLUMN(node_entity, cap);
+  GROW_COLUMN(involvement, cap);
+  GROW_COLUMN(influence, cap);
+  GROW_COLUMN(node_first, cap);
+  engine->node_capacity = cap;
+  return true;
+}
+
+static bool reserve_edges(civ_corruption_engine_t *engine, size_t cap) {
+  if (cap <= engine->edge_capacity)
+    return true;
+  GROW_COLUMN(half_node, cap * 2);
+  GROW_COLUMN(half_next, cap * 2);
+  GROW_COLUMN(edge_weight, cap);
+  engine->edge_capacity = cap;
+  return true;
+}
+
+/* Lookup and compromise bits cover every handle below a multiple of 64 */
+static bool reserve_lookup(civ_corruption_engine_t *engine, civ_symbol_t id) {
+  if (id < engine->node_of_size)
+    return true;
+  uint32_t size = (MAX(civ_symbol_count(), id + 1) + 63u) & ~63u;
+  int32_t *node_of = CIV_REALLOC(engine->node_of, size * sizeof(int32_t));
+  if (!node_of)
+    return false;
+  engine->node_of = node_of;
+  uint64_t *bits = CIV_REALLOC(engine->compromised, (size / 64) * sizeof(uint64_t));
+  if (!bits)
+    return false;
+  engine->compromised = bits;
+  for (uint32_t i = engine->node_of_size; i < size; i++)
+    node_of[i] = -1;
+  memset(bits + engine->node_of_size / 64, 0,
+         (size - engine->node_of_size) / 64 * sizeof(uint64_t));
+  engine->node_of_size = size;
+  return true;
+}
+
+static int32_t find_node(const civ_corruption_engine_t *engine,
+                         civ_symbol_t entity) {
+  return entity < engine->node_of_size ? engine->node_of[entity] : -1;
+}
+
+static int32_t add_node(civ_corruption_engine_t *engine, civ_symbol_t entity) {
+  int32_t i = find_node(engine, entity);
+  if (i >= 0)
+    return i;
+  if (!reserve_lookup(engine, entity))
+    return -1;
+  if (engine->node_count >= engine->node_capacity &&
+      !reserve_nodes(engine, MAX(32, engine->node_capacity * 2)))
+    return -1;
+  i = (int32_t)engine->node_count++;
+  engine->node_entity[i] = entity;
+  engine->involvement[i] = 0.0f;
+  engine->influence[i] = 1.0f;
+  engine->node_first[i] = -1;
+  engine->node_of[entity] = i;
+  return i;
+}
+
+/* Every involvement change goes through here to keep the sums and bits */
+static void set_involvement(civ_corruption_engine_t *engine, int32_t i,
+                            civ_float_t value) {
+  civ_float_t old = engine->involvement[i];
+  engine->involvement[i] = value;
+  engine->exposure += (value - old) * engine->influence[i];
+
+  civ_symbol_t s = engine->node_entity[i];
+  uint64_t bit = 1ull << (s & 63);
+  if (value > CIV_CORRUPTION_COMPROMISED)
+    engine->compromised[s >> 6] |= bit;
+  else
+    engine->compromised[s >> 6] &= ~bit;
+}
+
+void civ_corruption_engine_init(civ_corruption_engine_t *engine) {
+  memset(engine, 0, sizeof(civ_corruption_engine_t));
+  reserve_nodes(engine, 32);
+  engine->audit_effectiveness = 0.5f;
+}
+
 civ_corruption_engine_t *civ_corruption_engine_create(void) {
   civ_corruption_engine_t *engine =
       (civ_corruption_engine_t *)CIV_MALLOC(sizeof(civ_corruption_engine_t));
   if (!engine)
     return NULL;
-
-  memset(engine, 0, sizeof(civ_corruption_engine_t));
-  engine->node_capacity = 32;
-  engine->nodes = (civ_corruption_node_t *)CIV_CALLOC(
-      engine->node_capacity, sizeof(civ_corruption_node_t));
-  engine->audit_effectiveness = 0.5f;
-
+  civ_corruption_engine_init(engine);
   return engine;
 }
 
+void civ_corruption_engine_free(civ_corruption_engine_t *engine) {
+  if (!engine)
+    return;
+  CIV_FREE(engine->node_entity);
+  CIV_FREE(engine->involvement);
+  CIV_FREE(engine->influence);
+  CIV_FREE(engine->node_first);
+  CIV_FREE(engine->node_of);
+  CIV_FREE(engine->compromised);
+  CIV_FREE(engine->half_node);
+  CIV_FREE(engine->half_next);
+  CIV_FREE(engine->edge_weight);
+}
+
 void civ_corruption_engine_destroy(civ_corruption_engine_t *engine) {
   if (!engine)
     return;
-  CIV_FREE(engine->nodes);
+  civ_corruption_engine_free(engine);
   CIV_FREE(engine);
 }
 
@@ -35,33 +138,60 @@ civ_result_t civ_corruption_add_involvement(civ_corruption_engine_t *engine,
                                             civ_float_t amount) {
   if (!engine || !npc_id)
     return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null pointer"};
+  return civ_corruption_add_involvement_sym(engine, civ_symbol_intern(npc_id),
+                                            amount);
+}
 
-  /* Find existing node or add new */
-  for (size_t i = 0; i < engine->node_count; i++) {
-    if (strcmp(engine->nodes[i].npc_id, npc_id) == 0) {
-      engine->nodes[i].involvement =
-          CLAMP(engine->nodes[i].involvement + amount, 0.0f, 1.0f);
+civ_result_t civ_corruption_add_involvement_sym(civ_corruption_engine_t *engine,
+                                                civ_symbol_t entity,
+                                                civ_float_t amount) {
+  if (!engine)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null pointer"};
+  if (entity == CIV_SYMBOL_NONE)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "No entity"};
+
+  int32_t i = add_node(engine, entity);
+  if (i < 0)
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
+  set_involvement(engine, i, CLAMP(engine->involvement[i] + amount, 0.0f, 1.0f));
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+civ_result_t civ_corruption_implicate(civ_corruption_engine_t *engine,
+                                      civ_symbol_t a, civ_symbol_t b,
+                                      civ_float_t weight) {
+  if (!engine)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null pointer"};
+  if (a == CIV_SYMBOL_NONE || b == CIV_SYMBOL_NONE || a == b)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Bad pair"};
+
+  int32_t na = add_node(engine, a);
+  int32_t nb = na >= 0 ? add_node(engine, b) : -1;
+  if (nb < 0)
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
+
+  /* Strengthen an existing tie */
+  for (int32_t h = engine->node_first[na]; h >= 0; h = engine->half_next[h]) {
+    if (engine->half_node[h] == (uint32_t)nb) {
+      civ_float_t *w = &engine->edge_weight[h >> 1];
+      *w = CLAMP(*w + weight, 0.0f, 1.0f);
       return (civ_result_t){CIV_OK, NULL};
     }
   }
 
-  /* Add new node */
-  if (engine->node_count >= engine->node_capacity) {
-    engine->node_capacity *= 2;
-    engine->nodes = (civ_corruption_node_t *)CIV_REALLOC(
-        engine->nodes, engine->node_capacity * sizeof(civ_corruption_node_t));
-  }
-
-  if (engine->nodes) {
-    civ_corruption_node_t *node = &engine->nodes[engine->node_count++];
-    strncpy(node->npc_id, npc_id, STRING_SHORT_LEN - 1);
-    node->involvement = CLAMP(amount, 0.0f, 1.0f);
-    node->influence = 1.0f;
-    node->clique_count = 0;
-  } else {
+  if (engine->edge_count >= engine->edge_capacity &&
+      !reserve_edges(engine, MAX(16, engine->edge_capacity * 2)))
     return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
-  }
 
+  size_t e = engine->edge_count++;
+  int32_t h = (int32_t)(e * 2);
+  engine->edge_weight[e] = CLAMP(weight, 0.0f, 1.0f);
+  engine->half_node[h] = (uint32_t)nb;
+  engine->half_next[h] = engine->node_first[na];
+  engine->node_first[na] = h;
+  engine->half_node[h + 1] = (uint32_t)na;
+  engine->half_next[h + 1] = engine->node_first[nb];
+  engine->node_first[nb] = h + 1;
   return (civ_result_t){CIV_OK, NULL};
 }
 
@@ -71,16 +201,29 @@ civ_corruption_calculate_leakage(const civ_corruption_engine_t *engine,
   if (!engine)
     return 0.0f;
 
-  civ_float_t leakage = 0.0f;
-  for (size_t i = 0; i < engine->node_count; i++) {
-    leakage +=
-        engine->nodes[i].involvement * engine->nodes[i].influence * 0.01f;
-  }
-
+  civ_float_t leakage = engine->exposure * 0.01f;
   return total_budget *
          CLAMP(leakage + engine->systemic_index * 0.05f, 0.0f, 0.8f);
 }
 
+/* Test one entity; a catch also weakens everyone tied to it */
+static void audit_node(civ_corruption_engine_t *engine, int32_t i,
+                       civ_float_t detection_power, civ_float_t intensity) {
+  if (engine->involvement[i] <= (1.0f - detection_power))
+    return;
+
+  /* Corruption detected and suppressed */
+  set_involvement(engine, i, engine->involvement[i] * (1.0f - intensity));
+  civ_log(CIV_LOG_INFO, "Audit detected corruption in node %s",
+          civ_symbol_name(engine->node_entity[i]));
+
+  for (int32_t h = engine->node_first[i]; h >= 0; h = engine->half_next[h]) {
+    int32_t j = (int32_t)engine->half_node[h];
+    civ_float_t exposed = intensity * engine->edge_weight[h >> 1];
+    set_involvement(engine, j, engine->involvement[j] * (1.0f - exposed));
+  }
+}
+
 civ_result_t civ_corruption_run_audit(civ_corruption_engine_t *engine,
                                       civ_float_t intensity) {
   if (!engine)
@@ -89,13 +232,14 @@ civ_result_t civ_corruption_run_audit(civ_corruption_engine_t *engine,
   /* Audits reduce involvement but may cause tension/instability */
   civ_float_t detection_power = intensity * engine->audit_effectiveness;
 
-  for (size_t i = 0; i < engine->node_count; i++) {
-    if (engine->nodes[i].involvement > (1.0f - detection_power)) {
-      /* Corruption detected and suppressed */
-      engine->nodes[i].involvement *= (1.0f - intensity);
-      civ_log(CIV_LOG_INFO, "Audit detected corruption in node %s",
-              engine->nodes[i].npc_id);
-    }
+  size_t n = engine->node_count;
+  if (n <= CIV_CORRUPTION_AUDIT_SAMPLE) {
+    for (size_t i = 0; i < n; i++)
+      audit_node(engine, (int32_t)i, detection_power, intensity);
+  } else {
+    for (int k = 0; k < CIV_CORRUPTION_AUDIT_SAMPLE; k++)
+      audit_node(engine, (int32_t)((size_t)civ_rand() % n), detection_power,
+                 intensity);
   }
 
   return (civ_result_t){CIV_OK, NULL};
@@ -105,12 +249,5 @@ bool civ_corruption_is_npc_compromised(const civ_corruption_engine_t *engine,
                                        const char *npc_id) {
   if (!engine || !npc_id)
     return false;
-
-  for (size_t i = 0; i < engine->node_count; i++) {
-    if (strcmp(engine->nodes[i].npc_id, npc_id) == 0) {
-      return engine->nodes[i].involvement > 0.3f;
-    }
-  }
-
-  return false;
+  return civ_corruption_is_compromised(engine, civ_symbol_find(npc_id));
 }
@@ -4,27 +4,69 @@
  */
 #include "core/governance/political/elections.h"
 #include "common.h"
+#include "utils/rng.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
-civ_election_system_t *civ_election_create(void) {
-  civ_election_system_t *es = CIV_MALLOC(sizeof(civ_election_system_t));
-  if (!es) return NULL;
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CIV_ELECTION_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CIV_ELECTION_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define CIV_ELECTION_NEON 1
+#endif
+
+#define MIN_SUPPORT 1e-4f /* floor under a candidate's standing */
+
+static const struct {
+  int first, last;
+  float lean, turnout, salience;
+} k_classes[CIV_VOTER_CLASS_COUNT] = {
+#define CIV_VOTER_CLASS_ROW(id, first, last, lean, turnout, salience)          \
+  {first, last, lean, turnout, salience},
+    CIV_VOTER_CLASSES(CIV_VOTER_CLASS_ROW)
+#undef CIV_VOTER_CLASS_ROW
+};
+
+/* A district's share of seats left over after the whole ones */
+struct civ_seat_remainder {
+  float    remainder;
+  uint32_t district;
+};
+
+static void electorate_release(civ_electorate_t *el);
+
+void civ_election_init(civ_election_system_t *es) {
   memset(es, 0, sizeof(*es));
   es->election_capacity = 4;
   es->elections = CIV_MALLOC(sizeof(civ_election_t) * es->election_capacity);
   es->democratic_health = 0.50f;
   es->voter_trust = 0.55f;
   es->electoral_fairness = 0.60f;
+}
+
+civ_election_system_t *civ_election_create(void) {
+  civ_election_system_t *es = CIV_MALLOC(sizeof(civ_election_system_t));
+  if (!es) return NULL;
+  civ_election_init(es);
   return es;
 }
 
-void civ_election_destroy(civ_election_system_t *es) {
+void civ_election_free(civ_election_system_t *es) {
   if (!es) return;
   for (int i = 0; i < es->election_count; i++)
     free(es->elections[i].candidates);
   free(es->elections);
+  electorate_release(&es->electorate);
+}
+
+void civ_election_destroy(civ_election_system_t *es) {
+  if (!es) return;
+  civ_election_free(es);
   free(es);
 }
 
@@ -68,7 +110,7 @@ void civ_election_update(civ_election_system_t *es, float dt,
     /* Election day */
     if (e->turns_until_election <= 0) {
       e->turnout = e->voter_engagement * (0.7f + es->electoral_fairness * 0.3f);
-      civ_election_tally_votes(e);
+      civ_election_tally_votes(e, &es->electorate);
       e->concluded = true;
       es->total_elections_held++;
     }
@@ -97,7 +139,7 @@ civ_election_t *civ_election_schedule(civ_election_system_t *es,
   e->cycle_length = cycle_length;
   e->turns_until_election = cycle_length;
   e->in_progress = true;
-  e->candidate_capacity = 8;
+  e->candidate_capacity = CIV_ELECTION_MAX_CANDIDATES;
   e->candidates = CIV_MALLOC(sizeof(civ_candidate_t) * e->candidate_capacity);
   es->election_count++;
   return e;
@@ -115,11 +157,12 @@ civ_candidate_t *civ_election_add_candidate(civ_election_t *e,
   if (party_id) strncpy(c->party_id, party_id, STRING_SHORT_LEN - 1);
   c->is_incumbent = incumbent;
   /* Dynamic initial support — incumbents start with advantage */
-  c->public_support = incumbent ? (0.35f + (float)(rand() % 20) / 100.0f)
-                                : (0.10f + (float)(rand() % 20) / 100.0f);
-  c->campaign_strength = 0.30f + (float)(rand() % 40) / 100.0f;
-  c->policy_platform = 0.30f + (float)(rand() % 40) / 100.0f;
-  c->funding = 100.0f + (float)(rand() % 900);
+  c->public_support = incumbent ? (0.35f + (float)(civ_rand() % 20) / 100.0f)
+                                : (0.10f + (float)(civ_rand() % 20) / 100.0f);
+  c->campaign_strength = 0.30f + (float)(civ_rand() % 40) / 100.0f;
+  c->policy_platform = 0.30f + (float)(civ_rand() % 40) / 100.0f;
+  c->funding = 100.0f + (float)(civ_rand() % 900);
+  c->stance = (float)(civ_rand() % 161) / 100.0f - 0.80f;
   e->candidate_count++;
   return c;
 }
@@ -147,7 +190,7 @@ void civ_election_campaign(civ_election_t *e, float dt,
     /* Support shift: campaign effect scaled by engagement */
     float shift = campaign_effect * e->voter_engagement * 0.02f;
     /* Random events: debates, scandals */
-    float event = ((float)rand() / RAND_MAX - 0.5f) * 0.03f;
+    float event = ((float)civ_rand() / RAND_MAX - 0.5f) * 0.03f;
     c->public_support += shift + event;
 
     /* Spend funding */
@@ -165,26 +208,519 @@ void civ_election_campaign(civ_election_t *e, float dt,
   }
 }
 
-void civ_election_tally_votes(civ_election_t *e) {
-  if (!e) return;
+/* ── Electorate ─────────────────────────────────────────────────── */
+static void electorate_release(civ_electorate_t *el) {
+  CIV_FREE(el->district);
+  CIV_FREE(el->voter_class);
+  CIV_FREE(el->position);
+  CIV_FREE(el->voters);
+  CIV_FREE(el->weight);
+  CIV_FREE(el->salience);
+  CIV_FREE(el->district_ids);
+  CIV_FREE(el->district_first);
+  CIV_FREE(el->district_voters);
+  CIV_FREE(el->district_seats);
+  CIV_FREE(el->district_remainder);
+  CIV_FREE(el->utility);
+  CIV_FREE(el->district_votes);
+  memset(el, 0, sizeof(*el));
+}
+
+void civ_electorate_clear(civ_electorate_t *el) {
+  if (!el) return;
+  el->bloc_count = 0;
+  el->district_count = 0;
+}
+
+#define GROW(ptr, n)                                                           \
+  do {                                                                         \
+    void *grown_ = CIV_REALLOC((ptr), (n) * sizeof(*(ptr)));                   \
+    if (!grown_) return false;                                                 \
+    (ptr) = grown_;                                                            \
+  } while (0)
+
+static bool reserve_blocs(civ_electorate_t *el, size_t blocs) {
+  if (blocs <= el->bloc_capacity) return true;
+  size_t cap = el->bloc_capacity ? el->bloc_capacity : 64;
+  while (cap < blocs) cap *= 2;
+  GROW(el->district, cap);
+  GROW(el->voter_class, cap);
+  GROW(el->position, cap);
+  GROW(el->voters, cap);
+  GROW(el->weight, cap);
+  GROW(el->salience, cap);
+  el->bloc_capacity = cap;
+  return true;
+}
+
+static bool reserve_districts(civ_electorate_t *el, size_t districts) {
+  if (districts <= el->district_capacity) return true;
+  size_t cap = el->district_capacity ? el->district_capacity : 16;
+  while (cap < districts) cap *= 2;
+  GROW(el->district_ids, cap);
+  GROW(el->district_first, cap + 1);
+  GROW(el->district_voters, cap);
+  el->district_capacity = cap;
+  return true;
+}
 
-  /* First-past-the-post: winner takes all seats */
-  if (e->type == CIV_ELECTION_FPTP || e->type == CIV_ELECTION_TWO_ROUND) {
-    /* Winner determined by public_support — already computed */
+/* Tally scratch for the electorate as it stands */
+static bool reserve_scratch(civ_electorate_t *el) {
+  if (el->scratch_blocs < el->bloc_count) {
+    GROW(el->utility, (CIV_ELECTION_MAX_CANDIDATES + 2) * el->bloc_count);
+    el->scratch_blocs = el->bloc_count;
   }
-  /* Proportional: seats proportional to support */
-  /* Mixed, ranked-choice, etc. — all use public_support as the base signal */
+  if (el->scratch_districts < el->district_count) {
+    GROW(el->district_votes, CIV_ELECTION_MAX_CANDIDATES * el->district_count);
+    GROW(el->district_seats, el->district_count);
+    GROW(el->district_remainder, el->district_count);
+    el->scratch_districts = el->district_count;
+  }
+  return true;
+}
+#undef GROW
+
+civ_result_t civ_electorate_add_district(civ_electorate_t *el, civ_symbol_t id,
+                                         const float voters[CIV_VOTER_CLASS_COUNT],
+                                         float lean) {
+  if (!el || !voters)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null electorate"};
+  if (!reserve_blocs(el, el->bloc_count + CIV_VOTER_CLASS_COUNT * CIV_ELECTORATE_BUCKETS) ||
+      !reserve_districts(el, el->district_count + 1))
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Out of memory"};
+
+  size_t d = el->district_count++;
+  el->district_ids[d] = id;
+  el->district_first[d] = (uint32_t)el->bloc_count;
+  el->district_voters[d] = 0.0f;
+
+  const float inv_2var = 1.0f / (2.0f * CIV_ELECTORATE_SPREAD * CIV_ELECTORATE_SPREAD);
+  for (int k = 0; k < CIV_VOTER_CLASS_COUNT; k++) {
+    if (voters[k] <= 0.0f) continue;
+    float centre = lean + k_classes[k].lean;
+    float w[CIV_ELECTORATE_BUCKETS], total = 0.0f;
+    for (int j = 0; j < CIV_ELECTORATE_BUCKETS; j++) {
+      float x = -1.0f + (2.0f * j + 1.0f) / CIV_ELECTORATE_BUCKETS - centre;
+      w[j] = expf(-x * x * inv_2var);
+      total += w[j];
+    }
+    for (int j = 0; j < CIV_ELECTORATE_BUCKETS; j++) {
+      size_t b = el->bloc_count++;
+      el->district[b] = (uint32_t)d;
+      el->voter_class[b] = (uint8_t)k;
+      el->position[b] = -1.0f + (2.0f * j + 1.0f) / CIV_ELECTORATE_BUCKETS;
+      el->voters[b] = voters[k] * w[j] / total;
+      el->weight[b] = el->voters[b] * k_classes[k].turnout;
+      el->salience[b] = k_classes[k].salience;
+    }
+    el->district_voters[d] += voters[k];
+  }
+  el->district_first[d + 1] = (uint32_t)el->bloc_count;
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+civ_result_t civ_electorate_from_population(civ_electorate_t *el,
+                                            const civ_population_manager_t *pm,
+                                            const float *lean) {
+  if (!el || !pm)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null electorate"};
+  civ_electorate_clear(el);
+  for (size_t r = 0; r < pm->region_count; r++) {
+    const civ_float_t *row = pm->cohorts + r * CIV_COHORT_COUNT;
+    float voters[CIV_VOTER_CLASS_COUNT];
+    for (int k = 0; k < CIV_VOTER_CLASS_COUNT; k++) {
+      civ_float_t n = 0.0;
+      for (int a = k_classes[k].first; a <= k_classes[k].last; a++) n += row[a];
+      voters[k] = (float)n;
+    }
+    civ_result_t res = civ_electorate_add_district(el, pm->region_ids[r], voters,
+                                                   lean ? lean[r] : 0.0f);
+    if (res.error != CIV_OK) return res;
+  }
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+/* ── Tally ──────────────────────────────────────────────────────── */
+/* Float lanes over blocs. Every path, the scalar tail included, does the
+   same operations in the same order, so a tally does not depend on the
+   instruction set. */
+#if CIV_ELECTION_AVX2
+typedef __m256 lane_t;
+typedef __m256i lane_int_t;
+#define LANES          8
+#define L_LOAD(p)      _mm256_loadu_ps(p)
+#define L_STORE(p, v)  _mm256_storeu_ps(p, v)
+#define L_SET(x)       _mm256_set1_ps(x)
+#define L_ADD(a, b)    _mm256_add_ps(a, b)
+#define L_SUB(a, b)    _mm256_sub_ps(a, b)
+#define L_MUL(a, b)    _mm256_mul_ps(a, b)
+#define L_DIV(a, b)    _mm256_div_ps(a, b)
+#define L_MAX(a, b)    _mm256_max_ps(a, b)
+#define L_TRUNC(v)     _mm256_cvttps_epi32(v)
+#define L_FLOAT(k)     _mm256_cvtepi32_ps(k)
+#define LI_SET(x)      _mm256_set1_epi32(x)
+#define LI_ADD(a, b)   _mm256_add_epi32(a, b)
+#define LI_SUB(a, b)   _mm256_sub_epi32(a, b)
+#define LI_EXPONENT(k) _mm256_castsi256_ps(_mm256_slli_epi32(k, 23))
+#elif CIV_ELECTION_SSE2
+typedef __m128 lane_t;
+typedef __m128i lane_int_t;
+#define LANES          4
+#define L_LOAD(p)      _mm_loadu_ps(p)
+#define L_STORE(p, v)  _mm_storeu_ps(p, v)
+#define L_SET(x)       _mm_set1_ps(x)
+#define L_ADD(a, b)    _mm_add_ps(a, b)
+#define L_SUB(a, b)    _mm_sub_ps(a, b)
+#define L_MUL(a, b)    _mm_mul_ps(a, b)
+#define L_DIV(a, b)    _mm_div_ps(a, b)
+#define L_MAX(a, b)    _mm_max_ps(a, b)
+#define L_TRUNC(v)     _mm_cvttps_epi32(v)
+#define L_FLOAT(k)     _mm_cvtepi32_ps(k)
+#define LI_SET(x)      _mm_set1_epi32(x)
+#define LI_ADD(a, b)   _mm_add_epi32(a, b)
+#define LI_SUB(a, b)   _mm_sub_epi32(a, b)
+#define LI_EXPONENT(k) _mm_castsi128_ps(_mm_slli_epi32(k, 23))
+#elif CIV_ELECTION_NEON
+typedef float32x4_t lane_t;
+typedef int32x4_t lane_int_t;
+#define LANES          4
+#define L_LOAD(p)      vld1q_f32(p)
+#define L_STORE(p, v)  vst1q_f32(p, v)
+#define L_SET(x)       vdupq_n_f32(x)
+#define L_ADD(a, b)    vaddq_f32(a, b)
+#define L_SUB(a, b)    vsubq_f32(a, b)
+#define L_MUL(a, b)    vmulq_f32(a, b)
+#define L_DIV(a, b)    vdivq_f32(a, b)
+#define L_MAX(a, b)    vmaxq_f32(a, b)
+#define L_TRUNC(v)     vcvtq_s32_f32(v)
+#define L_FLOAT(k)     vcvtq_f32_s32(k)
+#define LI_SET(x)      vdupq_n_s32(x)
+#define LI_ADD(a, b)   vaddq_s32(a, b)
+#define LI_SUB(a, b)   vsubq_s32(a, b)
+#define LI_EXPONENT(k) vreinterpretq_f32_s32(vshlq_n_s32(k, 23))
+#endif
+
+/* exp(x) for x <= 0: Cody-Waite reduction and the Cephes polynomial */
+#define EXP_MIN    -87.0f
+#define EXP_LOG2E  1.44269504f
+#define EXP_LN2_HI 0.693359375f
+#define EXP_LN2_LO -2.12194440e-4f
+#define EXP_P0 1.9875691500e-4f
+#define EXP_P1 1.3981999507e-3f
+#define EXP_P2 8.3334519073e-3f
+#define EXP_P3 4.1665795894e-2f
+#define EXP_P4 1.6666665459e-1f
+#define EXP_P5 5.0000001201e-1f
+
+static inline float exp_neg(float v) {
+  v = v > EXP_MIN ? v : EXP_MIN;
+  int32_t k = (int32_t)(v * EXP_LOG2E + 126.5f) - 126; /* floor: operand > 0 */
+  float fk = (float)k;
+  float r = v - fk * EXP_LN2_HI;
+  r = r - fk * EXP_LN2_LO;
+  float p = EXP_P0;
+  p = p * r + EXP_P1;
+  p = p * r + EXP_P2;
+  p = p * r + EXP_P3;
+  p = p * r + EXP_P4;
+  p = p * r + EXP_P5;
+  p = p * (r * r) + r + 1.0f;
+  uint32_t bits = (uint32_t)(k + 127) << 23;
+  float scale;
+  memcpy(&scale, &bits, sizeof(scale));
+  return p * scale;
+}
+
+#ifdef LANES
+static inline lane_t lane_exp_neg(lane_t v) {
+  v = L_MAX(v, L_SET(EXP_MIN));
+  lane_int_t k = LI_SUB(L_TRUNC(L_ADD(L_MUL(v, L_SET(EXP_LOG2E)), L_SET(126.5f))),
+                        LI_SET(126));
+  lane_t fk = L_FLOAT(k);
+  lane_t r = L_SUB(v, L_MUL(fk, L_SET(EXP_LN2_HI)));
+  r = L_SUB(r, L_MUL(fk, L_SET(EXP_LN2_LO)));
+  lane_t p = L_SET(EXP_P0);
+  p = L_ADD(L_MUL(p, r), L_SET(EXP_P1));
+  p = L_ADD(L_MUL(p, r), L_SET(EXP_P2));
+  p = L_ADD(L_MUL(p, r), L_SET(EXP_P3));
+  p = L_ADD(L_MUL(p, r), L_SET(EXP_P4));
+  p = L_ADD(L_MUL(p, r), L_SET(EXP_P5));
+  p = L_ADD(L_ADD(L_MUL(p, L_MUL(r, r)), r), L_SET(1.0f));
+  return L_MUL(p, LI_EXPONENT(LI_ADD(k, LI_SET(127))));
+}
+#endif
+
+/* Each active candidate's share of blocs [b0, b1), into its utility row:
+   utilities, then exp against the bloc's best, then normalised */
+static void bloc_shares(civ_electorate_t *el, const civ_election_t *e,
+                        const bool *active, size_t b0, size_t b1) {
+  size_t stride = el->scratch_blocs, n = b1 - b0;
+  float *peak = el->utility + CIV_ELECTION_MAX_CANDIDATES * stride + b0;
+  float *total = peak + stride;
+  const float *pos = el->position + b0, *sal = el->salience + b0;
+
+  bool first = true;
+  for (int c = 0; c < e->candidate_count; c++) {
+    if (!active[c]) continue;
+    float *u = el->utility + c * stride + b0;
+    float valence = logf(MAX(e->candidates[c].public_support, MIN_SUPPORT));
+    float stance = e->candidates[c].stance;
+    size_t b = 0;
+#ifdef LANES
+    lane_t vv = L_SET(valence), vs = L_SET(stance);
+    for (; b + LANES <= n; b += LANES) {
+      lane_t d = L_SUB(L_LOAD(pos + b), vs);
+      lane_t x = L_SUB(vv, L_MUL(L_LOAD(sal + b), L_MUL(d, d)));
+      L_STORE(u + b, x);
+      L_STORE(peak + b, first ? x : L_MAX(x, L_LOAD(peak + b)));
+    }
+#endif
+    for (; b < n; b++) {
+      float d = pos[b] - stance;
+      float x = valence - sal[b] * (d * d);
+      u[b] = x;
+      peak[b] = first || x > peak[b] ? x : peak[b];
+    }
+    first = false;
+  }
+
+  first = true;
+  for (int c = 0; c < e->candidate_count; c++) {
+    if (!active[c]) continue;
+    float *u = el->utility + c * stride + b0;
+    size_t b = 0;
+#ifdef LANES
+    for (; b + LANES <= n; b += LANES) {
+      lane_t x = lane_exp_neg(L_SUB(L_LOAD(u + b), L_LOAD(peak + b)));
+      L_STORE(u + b, x);
+      L_STORE(total + b, first ? x : L_ADD(L_LOAD(total + b), x));
+    }
+#endif
+    for (; b < n; b++) {
+      float x = exp_neg(u[b] - peak[b]);
+      u[b] = x;
+      total[b] = first ? x : total[b] + x;
+    }
+    first = false;
+  }
+
+  for (int c = 0; c < e->candidate_count; c++) {
+    if (!active[c]) continue;
+    float *u = el->utility + c * stride + b0;
+    size_t b = 0;
+#ifdef LANES
+    for (; b + LANES <= n; b += LANES)
+      L_STORE(u + b, L_DIV(L_LOAD(u + b), L_LOAD(total + b)));
+#endif
+    for (; b < n; b++) u[b] = u[b] / total[b];
+  }
+}
+
+/* District d's votes per candidate from its blocs' shares; four running
+   sums, combined in a fixed order */
+static void district_tally(civ_electorate_t *el, const civ_election_t *e,
+                           const bool *active, size_t d) {
+  float *votes = el->district_votes + d * CIV_ELECTION_MAX_CANDIDATES;
+  size_t b0 = el->district_first[d], b1 = el->district_first[d + 1];
+  const float *w = el->weight;
+  for (int c = 0; c < e->candidate_count; c++) {
+    float v = 0.0f;
+    if (active[c]) {
+      const float *share = el->utility + c * el->scratch_blocs;
+      float acc[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+      size_t b = b0;
+      for (; b + 4 <= b1; b += 4) {
+        acc[0] += w[b] * share[b];
+        acc[1] += w[b + 1] * share[b + 1];
+        acc[2] += w[b + 2] * share[b + 2];
+        acc[3] += w[b + 3] * share[b + 3];
+      }
+      for (; b < b1; b++) acc[0] += w[b] * share[b];
+      v = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    }
+    votes[c] = v * e->turnout;
+  }
+}
+
+static int district_leader(const civ_electorate_t *el, const civ_election_t *e,
+                           size_t d, float *share) {
+  const float *votes = el->district_votes + d * CIV_ELECTION_MAX_CANDIDATES;
+  int best = 0;
+  float total = 0.0f;
+  for (int c = 0; c < e->candidate_count; c++) {
+    total += votes[c];
+    if (votes[c] > votes[best]) best = c;
+  }
+  if (share) *share = total > 0.0f ? votes[best] / total : 0.0f;
+  return best;
+}
+
+/* Runoffs until someone holds a majority of district d: straight to the
+   top two, or dropping the last candidate a round at a time */
+static int district_runoff(civ_electorate_t *el, const civ_election_t *e,
+                           size_t d, bool instant) {
+  bool active[CIV_ELECTION_MAX_CANDIDATES];
+  int remaining = e->candidate_count;
+  for (int c = 0; c < e->candidate_count; c++) active[c] = true;
+  float share;
+  int leader = district_leader(el, e, d, &share);
+  while (share <= 0.5f && remaining > 2) {
+    const float *votes = el->district_votes + d * CIV_ELECTION_MAX_CANDIDATES;
+    if (instant) {
+      int last = -1;
+      for (int c = 0; c < e->candidate_count; c++)
+        if (active[c] && (last < 0 || votes[c] < votes[last])) last = c;
+      active[last] = false;
+      remaining--;
+    } else {
+      int second = -1;
+      for (int c = 0; c < e->candidate_count; c++)
+        if (c != leader && (second < 0 || votes[c] > votes[second])) second = c;
+      for (int c = 0; c < e->candidate_count; c++)
+        active[c] = c == leader || c == second;
+      remaining = 2;
+    }
+    bloc_shares(el, e, active, el->district_first[d], el->district_first[d + 1]);
+    district_tally(el, e, active, d);
+    leader = district_leader(el, e, d, &share);
+  }
+  return leader;
+}
+
+/* Largest remainder first, then the lower district */
+static int by_remainder(const void *pa, const void *pb) {
+  const struct civ_seat_remainder *a = pa, *b = pb;
+  if (a->remainder != b->remainder) return a->remainder > b->remainder ? -1 : 1;
+  return a->district < b->district ? -1 : (a->district > b->district);
+}
+
+/* seats over the districts by their voters, largest remainder */
+static void apportion(civ_electorate_t *el, int seats) {
+  float total = 0.0f;
+  for (size_t d = 0; d < el->district_count; d++) total += el->district_voters[d];
+  int given = 0;
+  for (size_t d = 0; d < el->district_count; d++) {
+    float quota = total > 0.0f ? (float)seats * el->district_voters[d] / total : 1.0f;
+    el->district_seats[d] = total > 0.0f ? (int)quota : 0;
+    el->district_remainder[d].remainder = quota - (float)el->district_seats[d];
+    el->district_remainder[d].district = (uint32_t)d;
+    given += el->district_seats[d];
+  }
+  if (given >= seats || el->district_count == 0) return;
+  qsort(el->district_remainder, el->district_count,
+        sizeof(struct civ_seat_remainder), by_remainder);
+  for (size_t k = 0; given < seats; given++, k = (k + 1) % el->district_count)
+    el->district_seats[el->district_remainder[k].district]++;
+}
+
+/* D'Hondt over the national votes */
+static void allocate_list(civ_election_t *e, int seats) {
+  int list[CIV_ELECTION_MAX_CANDIDATES] = {0};
+  for (int s = 0; s < seats; s++) {
+    int best = 0;
+    for (int c = 1; c < e->candidate_count; c++)
+      if (e->candidates[c].votes / (float)(list[c] + 1) >
+          e->candidates[best].votes / (float)(list[best] + 1)) best = c;
+    list[best]++;
+  }
+  for (int c = 0; c < e->candidate_count; c++) e->candidates[c].seats += list[c];
+}
+
+void civ_election_tally_votes(civ_election_t *e, civ_electorate_t *electorate) {
+  if (!e || e->candidate_count == 0) return;
+
+  /* No electorate: the eligible voters as one national district */
+  civ_electorate_t national = {0};
+  civ_electorate_t *el = electorate;
+  if (!el || el->bloc_count == 0) {
+    float n = (float)MAX(e->eligible_voters, 1);
+    const float voters[CIV_VOTER_CLASS_COUNT] = {n * 0.20f, n * 0.60f, n * 0.20f};
+    el = &national;
+    if (civ_electorate_add_district(el, CIV_SYMBOL_NONE, voters, 0.0f).error != CIV_OK) {
+      electorate_release(el);
+      return;
+    }
+  }
+  if (!reserve_scratch(el)) {
+    if (el == &national) electorate_release(el);
+    return;
+  }
+
+  bool all[CIV_ELECTION_MAX_CANDIDATES];
+  for (int c = 0; c < e->candidate_count; c++) all[c] = true;
+  bloc_shares(el, e, all, 0, el->bloc_count);
+
+  float cast = 0.0f;
+  for (int c = 0; c < e->candidate_count; c++) {
+    e->candidates[c].votes = 0.0f;
+    e->candidates[c].seats = 0;
+  }
+  for (size_t d = 0; d < el->district_count; d++) {
+    district_tally(el, e, all, d);
+    for (int c = 0; c < e->candidate_count; c++) {
+      float v = el->district_votes[d * CIV_ELECTION_MAX_CANDIDATES + c];
+      e->candidates[c].votes += v;
+      cast += v;
+    }
+  }
+
+  int district_seats = 0;
+  switch (e->type) {
+  case CIV_ELECTION_PROPORTIONAL:
+    allocate_list(e, e->total_seats);
+    break;
+  case CIV_ELECTION_MIXED:
+    district_seats = e->total_seats / 2;
+    allocate_list(e, e->total_seats - district_seats);
+    break;
+  case CIV_ELECTION_SORTITION:
+    for (int s = 0; s < e->total_seats; s++)
+      e->candidates[civ_rand() % (unsigned)e->candidate_count].seats++;
+    break;
+  default: /* FPTP, indirect, two-round, ranked choice: seats by district */
+    district_seats = e->total_seats;
+    break;
+  }
+  if (district_seats > 0) {
+    apportion(el, district_seats);
+    for (size_t d = 0; d < el->district_count; d++) {
+      if (el->district_seats[d] == 0) continue;
+      int winner = e->type == CIV_ELECTION_TWO_ROUND ? district_runoff(el, e, d, false)
+                 : e->type == CIV_ELECTION_RANKED_CHOICE ? district_runoff(el, e, d, true)
+                 : district_leader(el, e, d, NULL);
+      e->candidates[winner].seats += el->district_seats[d];
+    }
+  }
+
+  /* First-round vote shares are the new standings */
+  if (cast > 0.0f)
+    for (int c = 0; c < e->candidate_count; c++)
+      e->candidates[c].public_support = e->candidates[c].votes / cast;
+
+  if (el == &national) electorate_release(el);
 }
 
 civ_candidate_t *civ_election_winner(const civ_election_t *e) {
   if (!e || e->candidate_count == 0) return NULL;
   civ_candidate_t *best = &e->candidates[0];
-  for (int i = 1; i < e->candidate_count; i++)
-    if (e->candidates[i].public_support > best->public_support)
+  for (int i = 1; i < e->candidate_count; i++) {
+    const civ_candidate_t *c = &e->candidates[i];
+    if (c->seats > best->seats ||
+        (c->seats == best->seats && c->public_support > best->public_support))
       best = &e->candidates[i];
+  }
   return best;
 }
 
+bool civ_election_due(const civ_election_system_t *es) {
+  if (!es) return false;
+  for (int i = 0; i < es->election_count; i++) {
+    const civ_election_t *e = &es->elections[i];
+    if (e->in_progress && !e->concluded && e->turns_until_election <= 1) return true;
+  }
+  return false;
+}
+
 float civ_election_turnout_rate(const civ_election_t *e) {
   return e ? e->turnout : 0.0f;
 }
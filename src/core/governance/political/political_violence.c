@@ -4,22 +4,32 @@
  */
 #include "core/governance/political/political_violence.h"
 #include "common.h"
+#include "utils/rng.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
-civ_political_violence_t *civ_political_violence_create(void) {
-  civ_political_violence_t *pv = CIV_MALLOC(sizeof(civ_political_violence_t));
-  if (!pv) return NULL;
+void civ_political_violence_init(civ_political_violence_t *pv) {
   memset(pv, 0, sizeof(*pv));
   pv->history_capacity = 16;
   pv->history = CIV_MALLOC(sizeof(civ_violence_event_t) * pv->history_capacity);
+}
+
+civ_political_violence_t *civ_political_violence_create(void) {
+  civ_political_violence_t *pv = CIV_MALLOC(sizeof(civ_political_violence_t));
+  if (!pv) return NULL;
+  civ_political_violence_init(pv);
   return pv;
 }
 
-void civ_political_violence_destroy(civ_political_violence_t *pv) {
+void civ_political_violence_free(civ_political_violence_t *pv) {
   if (!pv) return;
   free(pv->history);
+}
+
+void civ_political_violence_destroy(civ_political_violence_t *pv) {
+  if (!pv) return;
+  civ_political_violence_free(pv);
   free(pv);
 }
 
@@ -61,21 +71,21 @@ void civ_political_violence_update(civ_political_violence_t *pv, float dt,
   float rep_target = power_consolidation * 0.50f
                      + (constitution_suspended ? 0.30f : 0.0f)
                      + centralization * 0.20f;
-  pv->political_repression += (rep_target - pv->political_repression) * 0.05f * dt;
+  pv->political_repression += (rep_target - pv->political_repression) * civ_compound(0.05f, dt);
 
-  /* ── Autonomous event triggers ── */
-  float roll = (float)rand() / RAND_MAX;
+  /* ── Autonomous event triggers: chances per unit of time ── */
+  float roll = (float)civ_rand() / RAND_MAX;
 
-  if (roll < pv->coup_risk * 0.01f && civ_political_violence_coup_possible(pv))
+  if (roll < civ_compound(pv->coup_risk * 0.01f, dt) && civ_political_violence_coup_possible(pv))
     civ_political_violence_attempt_coup(pv);
 
-  if (roll < pv->assassination_risk * 0.005f)
+  if (roll < civ_compound(pv->assassination_risk * 0.005f, dt))
     civ_political_violence_trigger_assassination(pv);
 
-  if (roll < pv->civil_war_risk * 0.002f)
+  if (roll < civ_compound(pv->civil_war_risk * 0.002f, dt))
     civ_political_violence_trigger_civil_war(pv);
 
-  if (roll < pv->insurrection_risk * 0.008f)
+  if (roll < civ_compound(pv->insurrection_risk * 0.008f, dt))
     civ_political_violence_trigger_purge(pv, 5000);
 }
 
@@ -117,27 +127,28 @@ void civ_political_violence_attempt_coup(civ_political_violence_t *pv) {
   if (!pv) return;
   pv->coups_attempted++;
   float success_chance = pv->coup_risk * 0.7f + (1.0f - pv->political_repression) * 0.3f;
-  bool success = ((float)rand() / RAND_MAX) < success_chance;
+  bool success = ((float)civ_rand() / RAND_MAX) < success_chance;
   if (success) {
     pv->coups_succeeded++;
     add_event(pv, CIV_VIOLENCE_COUP_ATTEMPT, 0.80f, 0.30f, 0.25f,
-              200 + rand() % 500, "Military coup succeeded — government overthrown");
+              200 + civ_rand() % 500, "Military coup succeeded — government overthrown");
   } else {
     add_event(pv, CIV_VIOLENCE_COUP_ATTEMPT, 0.50f, 0.15f, 0.10f,
-              50 + rand() % 100, "Coup attempt failed — plotters arrested");
+              50 + civ_rand() % 100, "Coup attempt failed — plotters arrested");
   }
 }
 
 void civ_political_violence_trigger_assassination(civ_political_violence_t *pv) {
   if (!pv) return;
   add_event(pv, CIV_VIOLENCE_ASSASSINATION, 0.70f, 0.20f, 0.15f,
-            1 + rand() % 10, "Political assassination — leadership in crisis");
+            1 + civ_rand() % 10, "Political assassination — leadership in crisis");
 }
 
 void civ_political_violence_trigger_civil_war(civ_political_violence_t *pv) {
   if (!pv) return;
   add_event(pv, CIV_VIOLENCE_CIVIL_WAR, 0.95f, 0.50f, 0.40f,
-            1000 + rand() % 10000, "Civil war erupts — nation divided");
+            1000 + civ_rand() % 10000, "Civil war erupts — nation divided");
+  pv->civil_wars_pending++;
 }
 
 void civ_political_violence_trigger_purge(civ_political_violence_t *pv, int target_population) {
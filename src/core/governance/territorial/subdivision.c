@@ -4,26 +4,29 @@
  */
 
 #include "core/governance/territorial/subdivision.h"
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 
+void civ_subdivision_manager_init(civ_subdivision_manager_t *manager) {
+  manager->count = 0;
+  manager->capacity = 4;
+  manager->items = (civ_subdivision_t *)CIV_MALLOC(sizeof(civ_subdivision_t) *
+                                                   manager->capacity);
+}
+
 civ_subdivision_manager_t *civ_subdivision_manager_create(void) {
   civ_subdivision_manager_t *manager = (civ_subdivision_manager_t *)CIV_MALLOC(
       sizeof(civ_subdivision_manager_t));
-  if (manager) {
-    manager->count = 0;
-    manager->capacity = 4;
-    manager->items = (civ_subdivision_t *)CIV_MALLOC(sizeof(civ_subdivision_t) *
-                                                     manager->capacity);
-  }
+  if (manager)
+    civ_subdivision_manager_init(manager);
   return manager;
 }
 
-void civ_subdivision_manager_destroy(civ_subdivision_manager_t *manager) {
+void civ_subdivision_manager_free(civ_subdivision_manager_t *manager) {
   if (manager) {
     for (size_t i = 0; i < manager->count; i++) {
-      if (manager->items[i].tile_indices)
-        CIV_FREE(manager->items[i].tile_indices);
+      CIV_FREE(manager->items[i].spans);
       if (manager->items[i].settlement_ids) {
         for (size_t j = 0; j < manager->items[i].settlement_count; j++) {
           CIV_FREE(manager->items[i].settlement_ids[j]);
@@ -32,6 +35,12 @@ void civ_subdivision_manager_destroy(civ_subdivision_manager_t *manager) {
       }
     }
     CIV_FREE(manager->items);
+  }
+}
+
+void civ_subdivision_manager_destroy(civ_subdivision_manager_t *manager) {
+  if (manager) {
+    civ_subdivision_manager_free(manager);
     CIV_FREE(manager);
   }
 }
@@ -60,30 +69,135 @@ civ_subdivision_t *civ_subdivision_create(civ_subdivision_manager_t *manager,
   sub->autonomy = (type == CIV_SUBDIVISION_COLONY) ? 0.6f : 0.1f;
   sub->stability = 1.0f;
 
-  sub->tile_capacity = 64;
-  sub->tile_indices =
-      (uint32_t *)CIV_MALLOC(sizeof(uint32_t) * sub->tile_capacity);
-
   snprintf(sub->id, STRING_SHORT_LEN, "sub_%zu", manager->count);
 
   return sub;
 }
 
+/* Index of the last span starting at or before tile, -1 if none */
+static ptrdiff_t span_before(const civ_subdivision_t *sub, uint32_t tile) {
+  ptrdiff_t lo = 0, hi = (ptrdiff_t)sub->span_count;
+  while (lo < hi) {
+    ptrdiff_t mid = lo + (hi - lo) / 2;
+    if (sub->spans[mid].first <= tile)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo - 1;
+}
+
+static bool insert_span(civ_subdivision_t *sub, size_t at, uint32_t first,
+                        uint32_t count) {
+  if (sub->span_count >= sub->span_capacity) {
+    size_t new_cap = sub->span_capacity ? sub->span_capacity * 2 : 8;
+    civ_subdivision_span_t *grown =
+        CIV_REALLOC(sub->spans, sizeof(civ_subdivision_span_t) * new_cap);
+    if (!grown)
+      return false;
+    sub->spans = grown;
+    sub->span_capacity = new_cap;
+  }
+  memmove(&sub->spans[at + 1], &sub->spans[at],
+          (sub->span_count - at) * sizeof(civ_subdivision_span_t));
+  sub->spans[at] = (civ_subdivision_span_t){first, count};
+  sub->span_count++;
+  return true;
+}
+
+static void erase_span(civ_subdivision_t *sub, size_t at) {
+  memmove(&sub->spans[at], &sub->spans[at + 1],
+          (sub->span_count - at - 1) * sizeof(civ_subdivision_span_t));
+  sub->span_count--;
+}
+
+bool civ_subdivision_has_tile(const civ_subdivision_t *sub,
+                              uint32_t tile_index) {
+  if (!sub)
+    return false;
+  ptrdiff_t p = span_before(sub, tile_index);
+  return p >= 0 && tile_index - sub->spans[p].first < sub->spans[p].count;
+}
+
 void civ_subdivision_add_tile(civ_subdivision_t *sub, uint32_t tile_index) {
   if (!sub)
     return;
 
-  if (sub->tile_count >= sub->tile_capacity) {
-    size_t new_cap = sub->tile_capacity * 2;
-    uint32_t *new_tiles =
-        (uint32_t *)realloc(sub->tile_indices, sizeof(uint32_t) * new_cap);
-    if (!new_tiles)
+  ptrdiff_t p = span_before(sub, tile_index);
+  civ_subdivision_span_t *prev = p >= 0 ? &sub->spans[p] : NULL;
+  if (prev && tile_index - prev->first < prev->count)
+    return; /* already in */
+
+  size_t n = (size_t)(p + 1);
+  bool joins_prev = prev && prev->first + prev->count == tile_index;
+  bool joins_next =
+      n < sub->span_count && sub->spans[n].first == tile_index + 1;
+
+  if (joins_prev && joins_next) {
+    prev->count += 1 + sub->spans[n].count;
+    erase_span(sub, n);
+  } else if (joins_prev) {
+    prev->count++;
+  } else if (joins_next) {
+    sub->spans[n].first--;
+    sub->spans[n].count++;
+  } else if (!insert_span(sub, n, tile_index, 1)) {
+    return;
+  }
+  sub->tile_count++;
+}
+
+void civ_subdivision_remove_tile(civ_subdivision_t *sub, uint32_t tile_index) {
+  if (!sub)
+    return;
+
+  ptrdiff_t p = span_before(sub, tile_index);
+  if (p < 0 || tile_index - sub->spans[p].first >= sub->spans[p].count)
+    return; /* not in */
+
+  civ_subdivision_span_t *span = &sub->spans[p];
+  uint32_t last = span->first + span->count - 1;
+  if (span->count == 1) {
+    erase_span(sub, (size_t)p);
+  } else if (tile_index == span->first) {
+    span->first++;
+    span->count--;
+  } else if (tile_index == last) {
+    span->count--;
+  } else {
+    /* Split around the tile */
+    uint32_t first = span->first;
+    if (!insert_span(sub, (size_t)p + 1, tile_index + 1, last - tile_index))
       return;
-    sub->tile_indices = new_tiles;
-    sub->tile_capacity = new_cap;
+    sub->spans[p].first = first;
+    sub->spans[p].count = tile_index - first;
   }
+  sub->tile_count--;
+}
 
-  sub->tile_indices[sub->tile_count++] = tile_index;
+civ_float_t civ_subdivision_sum(const civ_subdivision_t *sub,
+                                const float *values) {
+  if (!sub || !values)
+    return 0.0f;
+  civ_float_t total = 0.0f;
+  for (size_t i = 0; i < sub->span_count; i++) {
+    const float *v = values + sub->spans[i].first;
+    float run = 0.0f;
+    for (uint32_t k = 0; k < sub->spans[i].count; k++)
+      run += v[k];
+    total += run;
+  }
+  return total;
+}
+
+void civ_subdivision_manager_aggregate(civ_subdivision_manager_t *manager,
+                                       civ_subdivision_aggregate_t aggregate,
+                                       const float *values) {
+  if (!manager || !values || (unsigned)aggregate >= CIV_SUBDIVISION_AGGREGATE_COUNT)
+    return;
+  for (size_t i = 0; i < manager->count; i++)
+    manager->items[i].aggregate[aggregate] =
+        civ_subdivision_sum(&manager->items[i], values);
 }
 
 void civ_subdivision_add_settlement(civ_subdivision_t *sub,
@@ -112,6 +226,50 @@ void civ_subdivision_update(civ_subdivision_manager_t *manager,
     if (sub->type == CIV_SUBDIVISION_OCCUPIED)
       target_stability = 0.4f;
 
-    sub->stability += (target_stability - sub->stability) * 0.05f * time_delta;
+    sub->stability += (target_stability - sub->stability) * civ_compound(0.05f, time_delta);
+  }
+}
+
+civ_subdivision_plane_t *civ_subdivision_plane_create(size_t tile_count) {
+  civ_subdivision_plane_t *plane = CIV_MALLOC(sizeof(civ_subdivision_plane_t));
+  if (!plane)
+    return NULL;
+  plane->ids = CIV_CALLOC(tile_count, sizeof(uint16_t));
+  if (!plane->ids) {
+    CIV_FREE(plane);
+    return NULL;
   }
+  plane->tile_count = tile_count;
+  return plane;
+}
+
+void civ_subdivision_plane_destroy(civ_subdivision_plane_t *plane) {
+  if (!plane)
+    return;
+  CIV_FREE(plane->ids);
+  CIV_FREE(plane);
+}
+
+void civ_subdivision_release_tile(civ_subdivision_manager_t *manager,
+                                  civ_subdivision_plane_t *plane,
+                                  uint32_t tile) {
+  if (!manager || !plane || tile >= plane->tile_count)
+    return;
+  int old = (int)plane->ids[tile] - 1;
+  if (old >= 0 && (size_t)old < manager->count)
+    civ_subdivision_remove_tile(&manager->items[old], tile);
+  plane->ids[tile] = 0;
+}
+
+void civ_subdivision_assign_tile(civ_subdivision_manager_t *manager,
+                                 civ_subdivision_plane_t *plane, size_t index,
+                                 uint32_t tile) {
+  if (!manager || !plane || tile >= plane->tile_count ||
+      index >= manager->count || index >= UINT16_MAX)
+    return;
+  if (plane->ids[tile] == index + 1)
+    return;
+  civ_subdivision_release_tile(manager, plane, tile);
+  civ_subdivision_add_tile(&manager->items[index], tile);
+  plane->ids[tile] = (uint16_t)(index + 1);
 }
@@ -22,35 +22,31 @@ double civ_knowledge_cost(double current_level, double base_cost,
 
 double civ_knowledge_advance(double *knowledge, double research_points,
                              double base_cost, double exponent) {
-  if (!knowledge || research_points <= 0.0)
+  if (!knowledge || research_points <= 0.0 || base_cost <= 0.0)
     return 0.0;
 
-  double remaining = research_points;
-  double total_advanced = 0.0;
-
-  /* Apply research points incrementally */
-  while (remaining > 0.0) {
-    double cost = civ_knowledge_cost(*knowledge, base_cost, exponent);
-
-    if (remaining >= cost) {
-      /* Full level advancement */
-      *knowledge += 1.0;
-      remaining -= cost;
-      total_advanced += 1.0;
-    } else {
-      /* Partial advancement */
-      double fraction = remaining / cost;
-      *knowledge += fraction;
-      total_advanced += fraction;
-      remaining = 0.0;
-    }
-
-    /* Safety check for extremely slow progress */
-    if (total_advanced > 0.0 && total_advanced < 0.0001)
-      break;
+  /* Points spent from level k to k' are the integral of
+     base * (0.5 + y)^exponent over [k, k'], which inverts directly. Over
+     a whole level that integral is, by the midpoint rule, the level's
+     civ_knowledge_cost, so the curve follows the per-level costs. */
+  double from = MAX(*knowledge, 0.0);
+  double p = exponent + 1.0;
+  double to;
+  if (fabs(p) < 1e-9) {
+    to = (0.5 + from) * exp(research_points / base_cost) - 0.5;
+  } else {
+    double spent = pow(0.5 + from, p) + research_points * p / base_cost;
+    /* Falling costs with a finite total: only reachable for p < 0 */
+    if (spent <= 0.0)
+      return 0.0;
+    to = pow(spent, 1.0 / p) - 0.5;
   }
 
-  return total_advanced;
+  double advanced = to - from;
+  if (!(advanced > 0.0) || !isfinite(advanced))
+    return 0.0;
+  *knowledge = from + advanced;
+  return advanced;
 }
 
 double civ_knowledge_multiplier(double knowledge, double scale) {
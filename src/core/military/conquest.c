@@ -36,6 +36,7 @@ civ_conquest_system_t* civ_conquest_system_create(void) {
 void civ_conquest_system_destroy(civ_conquest_system_t* system) {
     if (!system) return;
     CIV_FREE(system->conquests);
+    civ_border_frontier_destroy(system->frontier);
     CIV_FREE(system);
 }
 
@@ -202,59 +203,52 @@ int civ_conquest_transfer_territory(civ_conquest_system_t *system,
     civ_nation_manager_t *nm = (civ_nation_manager_t *)nm_void;
 
     int total_transferred = 0;
+    uint32_t *front = NULL;
+    size_t front_capacity = 0;
 
     for (size_t i = 0; i < system->conquest_count; i++) {
         civ_conquest_event_t *c = &system->conquests[i];
         if (!c->completed || c->territory_applied) continue;
+        c->territory_applied = true;
+
+        civ_owner_index_t defender_owner = civ_owner_find(c->defender_id);
+        if (defender_owner == CIV_OWNER_NONE) continue;
+        if (!system->frontier) system->frontier = civ_border_frontier_create();
+        if (!civ_border_frontier_attach(system->frontier, map)) continue;
 
         /* Find attacker nation to get its color */
         civ_nation_t *attacker = NULL;
         if (nm) attacker = civ_nation_get_by_id(nm, c->attacker_id);
         uint32_t attacker_color = attacker ? attacker->color : 0xCC2200;
+        civ_owner_index_t attacker_owner = civ_owner_intern(c->attacker_id);
 
-        /* Transfer border tiles: defender tiles adjacent to attacker tiles */
-        int transferred = 0;
-        for (int32_t y = 1; y < map->height - 1; y++) {
-            for (int32_t x = 0; x < map->width; x++) {
-                civ_map_tile_t *tile = civ_map_get_tile(map, x, y);
-                if (!tile || tile->land_use == CIV_LAND_USE_WATER) continue;
-                if (strcmp(tile->owner_id, c->defender_id) != 0) continue;
-
-                /* Check if any neighbor is owned by attacker */
-                bool borders_attacker = false;
-                int nx_wrap = (x + 1) % map->width;
-                int px_wrap = (x - 1 + map->width) % map->width;
-                int dirs[4][2] = {{nx_wrap, y}, {px_wrap, y}, {x, y-1}, {x, y+1}};
-                for (int d = 0; d < 4; d++) {
-                    civ_map_tile_t *nt = civ_map_get_tile(map, dirs[d][0], dirs[d][1]);
-                    if (nt && strcmp(nt->owner_id, c->attacker_id) == 0) {
-                        borders_attacker = true;
-                        break;
-                    }
-                }
-                if (!borders_attacker) continue;
-
-                /* Transfer tile */
-                strncpy(tile->owner_id, c->attacker_id, STRING_SHORT_LEN - 1);
-                tile->political_color = attacker_color;
-                transferred++;
-            }
+        /* Snapshot the defender's contact tiles before transferring, since
+           each transfer reshapes the front */
+        size_t n = civ_border_frontier_count(system->frontier, defender_owner,
+                                             attacker_owner);
+        if (n == 0) continue;
+        if (n > front_capacity) {
+            uint32_t *grown = (uint32_t*)CIV_REALLOC(front, n * sizeof(uint32_t));
+            if (!grown) continue;
+            front = grown;
+            front_capacity = n;
         }
-
-        c->territory_applied = true;
-        total_transferred += transferred;
+        n = civ_border_frontier_collect(system->frontier, defender_owner,
+                                        attacker_owner, front, n);
+        for (size_t k = 0; k < n; k++)
+            civ_map_set_owner(map, front[k], attacker_owner, attacker_color);
+        total_transferred += (int)n;
     }
+    CIV_FREE(front);
 
     /* Clean up applied conquests */
-    for (size_t i = 0; i < system->conquest_count; ) {
-        if (system->conquests[i].territory_applied) {
-            memmove(&system->conquests[i], &system->conquests[i + 1],
-                   (system->conquest_count - i - 1) * sizeof(civ_conquest_event_t));
-            system->conquest_count--;
-        } else {
-            i++;
-        }
+    size_t kept = 0;
+    for (size_t i = 0; i < system->conquest_count; i++) {
+        if (system->conquests[i].territory_applied) continue;
+        if (kept != i) system->conquests[kept] = system->conquests[i];
+        kept++;
     }
+    system->conquest_count = kept;
 
     return total_transferred;
 }
@@ -6,6 +6,7 @@
 #include "core/military/units.h"
 #include "common.h"
 #include <math.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -55,6 +56,97 @@ static civ_float_t get_movement_speed(civ_unit_type_t type) {
   }
 }
 
+/* Floor division so negative coordinates land in their own cells */
+static int32_t cell_of(int32_t v) {
+  return v >= 0 ? v >> CIV_UNIT_CELL_SHIFT
+                : -((-v + CIV_UNIT_CELL_SIZE - 1) >> CIV_UNIT_CELL_SHIFT);
+}
+
+static int32_t bucket_of_cell(int32_t cx, int32_t cy) {
+  uint32_t h = (uint32_t)cx * 73856093u ^ (uint32_t)cy * 19349663u;
+  return (int32_t)(h & (CIV_UNIT_HASH_BUCKETS - 1));
+}
+
+static void hash_insert(civ_unit_manager_t *um, size_t index) {
+  um->hash_bucket[index] = -1;
+  um->hash_next[index] = -1;
+  if (!um->bucket_heads || um->strength[index] <= 0)
+    return;
+  int32_t b = bucket_of_cell(cell_of(um->x[index]), cell_of(um->y[index]));
+  um->hash_bucket[index] = b;
+  um->hash_next[index] = um->bucket_heads[b];
+  um->bucket_heads[b] = (int32_t)index;
+}
+
+static void hash_remove(civ_unit_manager_t *um, size_t index) {
+  if (um->hash_bucket[index] < 0)
+    return;
+  int32_t *link = &um->bucket_heads[um->hash_bucket[index]];
+  while (*link >= 0 && *link != (int32_t)index)
+    link = &um->hash_next[*link];
+  if (*link == (int32_t)index)
+    *link = um->hash_next[index];
+  um->hash_bucket[index] = -1;
+  um->hash_next[index] = -1;
+}
+
+static bool reserve_units(civ_unit_manager_t *um, size_t need) {
+  if (need <= um->unit_capacity)
+    return true;
+  size_t cap = MAX(need, um->unit_capacity ? um->unit_capacity * 2 : 100);
+  civ_unit_t *units = (civ_unit_t *)CIV_REALLOC(um->units, cap * sizeof(civ_unit_t));
+  if (!units)
+    return false;
+  um->units = units;
+#define CIV_UNIT_HOT_GROW(type, name)                                          \
+  {                                                                            \
+    type *grown = (type *)CIV_REALLOC(um->name, cap * sizeof(type));           \
+    if (!grown)                                                                \
+      return false;                                                            \
+    um->name = grown;                                                          \
+  }
+  CIV_UNIT_HOT_FIELDS(CIV_UNIT_HOT_GROW)
+#undef CIV_UNIT_HOT_GROW
+  um->unit_capacity = cap;
+  return true;
+}
+
+/* A slot for index: the free list first, a new slot otherwise */
+static uint32_t take_slot(civ_unit_manager_t *um, uint32_t index) {
+  uint32_t slot = um->free_slot;
+  if (slot != UINT32_MAX) {
+    um->free_slot = um->slot_index[slot];
+  } else {
+    if (um->slot_count >= CIV_UNIT_MAX)
+      return UINT32_MAX;
+    if (um->slot_count == um->slot_capacity) {
+      size_t cap = um->slot_capacity ? um->slot_capacity * 2 : 128;
+      uint32_t *index_of = (uint32_t *)CIV_REALLOC(um->slot_index, cap * sizeof(uint32_t));
+      if (!index_of)
+        return UINT32_MAX;
+      um->slot_index = index_of;
+      uint32_t *gen = (uint32_t *)CIV_REALLOC(um->slot_generation, cap * sizeof(uint32_t));
+      if (!gen)
+        return UINT32_MAX;
+      um->slot_generation = gen;
+      um->slot_capacity = cap;
+    }
+    slot = (uint32_t)um->slot_count++;
+    um->slot_generation[slot] = 1;
+  }
+  um->slot_index[slot] = index;
+  return slot;
+}
+
+/* A freed slot's generation moves on, so old handles stop resolving */
+static void free_slot(civ_unit_manager_t *um, uint32_t slot) {
+  uint32_t max_gen = UINT32_MAX >> CIV_UNIT_SLOT_BITS;
+  um->slot_generation[slot] =
+      um->slot_generation[slot] >= max_gen ? 1 : um->slot_generation[slot] + 1;
+  um->slot_index[slot] = um->free_slot;
+  um->free_slot = slot;
+}
+
 civ_unit_manager_t *civ_unit_manager_create(void) {
   civ_unit_manager_t *um =
       (civ_unit_manager_t *)CIV_MALLOC(sizeof(civ_unit_manager_t));
@@ -71,6 +163,12 @@ void civ_unit_manager_destroy(civ_unit_manager_t *um) {
   if (!um)
     return;
   CIV_FREE(um->units);
+#define CIV_UNIT_HOT_FREE(type, name) CIV_FREE(um->name);
+  CIV_UNIT_HOT_FIELDS(CIV_UNIT_HOT_FREE)
+#undef CIV_UNIT_HOT_FREE
+  CIV_FREE(um->slot_index);
+  CIV_FREE(um->slot_generation);
+  CIV_FREE(um->bucket_heads);
   CIV_FREE(um);
 }
 
@@ -79,59 +177,77 @@ void civ_unit_manager_init(civ_unit_manager_t *um) {
     return;
 
   memset(um, 0, sizeof(civ_unit_manager_t));
-  um->unit_capacity = 100;
-  um->units = (civ_unit_t *)CIV_CALLOC(um->unit_capacity, sizeof(civ_unit_t));
+  um->free_slot = UINT32_MAX;
+  um->next_serial = 1;
+  reserve_units(um, 100);
+  um->bucket_heads =
+      (int32_t *)CIV_MALLOC(CIV_UNIT_HASH_BUCKETS * sizeof(int32_t));
+  if (um->bucket_heads)
+    memset(um->bucket_heads, 0xFF, CIV_UNIT_HASH_BUCKETS * sizeof(int32_t));
 }
 
-civ_unit_t *civ_unit_manager_create_unit(civ_unit_manager_t *um,
-                                         civ_unit_type_t type, const char *name,
-                                         int32_t size) {
-  if (!um || !name)
-    return NULL;
+/* Barbarian units are recognised by name once, when the name is interned */
+static void intern_name(civ_unit_t *unit) {
+  unit->name_sym = civ_symbol_intern(unit->name);
+  if (strstr(unit->name, "Barbarians"))
+    civ_symbol_add_flags(unit->name_sym, CIV_SYMBOL_FLAG_BARBARIAN);
+}
 
-  if (um->unit_count >= um->unit_capacity) {
-    um->unit_capacity *= 2;
-    um->units = (civ_unit_t *)CIV_REALLOC(um->units, um->unit_capacity *
-                                                         sizeof(civ_unit_t));
-  }
+civ_unit_handle_t civ_unit_manager_create_unit(civ_unit_manager_t *um,
+                                               civ_unit_type_t type,
+                                               const char *name, int32_t size) {
+  if (!um || !name || !reserve_units(um, um->unit_count + 1))
+    return CIV_UNIT_HANDLE_NONE;
+
+  size_t index = um->unit_count;
+  uint32_t slot = take_slot(um, (uint32_t)index);
+  if (slot == UINT32_MAX)
+    return CIV_UNIT_HANDLE_NONE;
+  um->unit_count++;
 
-  civ_unit_t *unit = &um->units[um->unit_count++];
+  civ_unit_t *unit = &um->units[index];
   memset(unit, 0, sizeof(civ_unit_t));
 
-  snprintf(unit->id, sizeof(unit->id), "unit_%zu", um->unit_count);
+  snprintf(unit->id, sizeof(unit->id), "unit_%llu",
+           (unsigned long long)um->next_serial++);
   strncpy(unit->name, name, sizeof(unit->name) - 1);
+  intern_name(unit);
   unit->unit_type = type;
   unit->combat_strength = get_base_strength(type);
   unit->movement_speed = get_movement_speed(type);
   unit->supply_consumption = 1.0f;
   unit->morale = 0.6f;
   unit->experience = 0.0f;
-  unit->current_strength = size;
   unit->max_strength = size;
-  unit->x = 0;
-  unit->y = 0;
   if (type == CIV_UNIT_TYPE_SPECIAL_FORCES)
     unit->visibility_range = 5;
   else if (type == CIV_UNIT_TYPE_SETTLER)
     unit->visibility_range = 4;
   else
     unit->visibility_range = 3;
-  unit->has_moved = false;
   unit->level = 1;
   unit->next_level_xp = 100.0f;
 
-  return unit;
+  um->x[index] = 0;
+  um->y[index] = 0;
+  um->strength[index] = size;
+  um->moved[index] = 0;
+  um->owner[index] = CIV_SYMBOL_NONE;
+  um->slot[index] = slot;
+  hash_insert(um, index);
+
+  return civ_unit_manager_handle(um, index);
 }
 
-civ_unit_t *civ_unit_manager_spawn_unit(civ_unit_manager_t *um,
-                                        civ_unit_type_t type, const char *name,
-                                        int32_t size, int32_t x, int32_t y) {
-  civ_unit_t *unit = civ_unit_manager_create_unit(um, type, name, size);
-  if (unit) {
-    unit->x = x;
-    unit->y = y;
-  }
-  return unit;
+civ_unit_handle_t civ_unit_manager_spawn_unit(civ_unit_manager_t *um,
+                                              civ_unit_type_t type,
+                                              const char *name, int32_t size,
+                                              int32_t x, int32_t y) {
+  civ_unit_handle_t h = civ_unit_manager_create_unit(um, type, name, size);
+  int32_t index = civ_unit_manager_resolve(um, h);
+  if (index >= 0)
+    civ_unit_manager_move_unit(um, (size_t)index, x, y);
+  return h;
 }
 
 void civ_unit_manager_recruit_units(civ_unit_manager_t *um,
@@ -143,38 +259,81 @@ void civ_unit_manager_recruit_units(civ_unit_manager_t *um,
   char name[STRING_MEDIUM_LEN];
   snprintf(name, sizeof(name), "%s_%d", nation_id, type);
 
-  civ_unit_t *unit = civ_unit_manager_create_unit(um, type, name, count);
-  if (unit) {
+  int32_t index = civ_unit_manager_resolve(
+      um, civ_unit_manager_create_unit(um, type, name, count));
+  if (index >= 0) {
+    civ_unit_t *unit = &um->units[index];
     unit->combat_strength *= quality;
     unit->morale = quality;
+    um->owner[index] = civ_symbol_intern(nation_id);
   }
 }
 
 bool civ_unit_manager_update_strength(civ_unit_manager_t *um,
                                       const char *unit_id, int32_t casualties,
                                       int32_t prisoners) {
-  if (!um || !unit_id)
+  int32_t index = civ_unit_manager_find(um, unit_id);
+  if (index < 0)
     return false;
+  civ_unit_manager_apply_losses(um, (size_t)index, casualties + prisoners);
+  return true;
+}
 
-  for (size_t i = 0; i < um->unit_count; i++) {
-    if (strcmp(um->units[i].id, unit_id) == 0) {
-      civ_unit_t *unit = &um->units[i];
-      int32_t total_losses = casualties + prisoners;
-      unit->current_strength = MAX(0, unit->current_strength - total_losses);
-
-      /* Update morale based on casualties */
-      if (unit->max_strength > 0) {
-        civ_float_t casualty_ratio =
-            (civ_float_t)total_losses / (civ_float_t)unit->max_strength;
-        unit->morale = MAX(0.1f, unit->morale - casualty_ratio * 0.3f);
-        unit->experience = MIN(1.0f, unit->experience + casualty_ratio * 0.1f);
-      }
+bool civ_unit_manager_apply_losses(civ_unit_manager_t *um, size_t index,
+                                   int32_t losses) {
+  if (!um || index >= um->unit_count)
+    return false;
 
-      return true;
-    }
+  civ_unit_t *unit = &um->units[index];
+  um->strength[index] = MAX(0, um->strength[index] - losses);
+
+  /* Update morale based on casualties */
+  if (unit->max_strength > 0) {
+    civ_float_t casualty_ratio =
+        (civ_float_t)losses / (civ_float_t)unit->max_strength;
+    unit->morale = MAX(0.1f, unit->morale - casualty_ratio * 0.3f);
+    unit->experience = MIN(1.0f, unit->experience + casualty_ratio * 0.1f);
   }
 
-  return false;
+  if (um->strength[index] > 0)
+    return false;
+  civ_unit_manager_kill_unit(um, index);
+  return true;
+}
+
+int32_t civ_unit_manager_resolve(const civ_unit_manager_t *um,
+                                 civ_unit_handle_t handle) {
+  if (!um || handle == CIV_UNIT_HANDLE_NONE)
+    return -1;
+  uint32_t slot = handle & CIV_UNIT_SLOT_MASK;
+  if (slot >= um->slot_count ||
+      um->slot_generation[slot] != handle >> CIV_UNIT_SLOT_BITS)
+    return -1;
+  uint32_t index = um->slot_index[slot];
+  return index < um->unit_count && um->slot[index] == slot ? (int32_t)index : -1;
+}
+
+civ_unit_handle_t civ_unit_manager_handle(const civ_unit_manager_t *um,
+                                          size_t index) {
+  if (!um || index >= um->unit_count)
+    return CIV_UNIT_HANDLE_NONE;
+  uint32_t slot = um->slot[index];
+  return (um->slot_generation[slot] << CIV_UNIT_SLOT_BITS) | slot;
+}
+
+int32_t civ_unit_manager_find(const civ_unit_manager_t *um, const char *id) {
+  if (!um || !id)
+    return -1;
+  for (size_t i = 0; i < um->unit_count; i++)
+    if (strcmp(um->units[i].id, id) == 0)
+      return (int32_t)i;
+  return -1;
+}
+
+void civ_unit_manager_set_owner(civ_unit_manager_t *um, size_t index,
+                                civ_symbol_t owner) {
+  if (um && index < um->unit_count)
+    um->owner[index] = owner;
 }
 
 void civ_unit_check_level_up(civ_unit_t *unit) {
@@ -194,3 +353,274 @@ void civ_unit_check_level_up(civ_unit_t *unit) {
             unit->level);
   }
 }
+
+void civ_unit_manager_move_unit(civ_unit_manager_t *um, size_t index,
+                                int32_t x, int32_t y) {
+  if (!um || index >= um->unit_count)
+    return;
+  bool same_cell = cell_of(um->x[index]) == cell_of(x) &&
+                   cell_of(um->y[index]) == cell_of(y);
+  um->x[index] = x;
+  um->y[index] = y;
+  if (same_cell && um->hash_bucket[index] >= 0)
+    return;
+  hash_remove(um, index);
+  hash_insert(um, index);
+}
+
+void civ_unit_manager_kill_unit(civ_unit_manager_t *um, size_t index) {
+  if (!um || index >= um->unit_count)
+    return;
+  hash_remove(um, index);
+  free_slot(um, um->slot[index]);
+
+  /* Swap the last unit into the hole and relink it under its new index */
+  size_t last = um->unit_count - 1;
+  if (index != last) {
+    hash_remove(um, last);
+    um->units[index] = um->units[last];
+#define CIV_UNIT_HOT_MOVE(type, name) um->name[index] = um->name[last];
+    CIV_UNIT_HOT_FIELDS(CIV_UNIT_HOT_MOVE)
+#undef CIV_UNIT_HOT_MOVE
+    um->slot_index[um->slot[index]] = (uint32_t)index;
+    hash_insert(um, index);
+  }
+  um->unit_count = last;
+}
+
+int32_t civ_unit_manager_unit_at(const civ_unit_manager_t *um, int32_t x,
+                                 int32_t y, int32_t ignore) {
+  if (!um || !um->bucket_heads)
+    return -1;
+  int32_t i = um->bucket_heads[bucket_of_cell(cell_of(x), cell_of(y))];
+  for (; i >= 0; i = um->hash_next[i]) {
+    if (i != ignore && um->x[i] == x && um->y[i] == y)
+      return i;
+  }
+  return -1;
+}
+
+bool civ_unit_manager_is_occupied(const civ_unit_manager_t *um, int32_t x,
+                                  int32_t y, int32_t ignore) {
+  return civ_unit_manager_unit_at(um, x, y, ignore) >= 0;
+}
+
+static int compare_index(const void *a, const void *b) {
+  size_t ia = *(const size_t *)a, ib = *(const size_t *)b;
+  return (ia > ib) - (ia < ib);
+}
+
+size_t civ_unit_manager_query_rect(const civ_unit_manager_t *um, int32_t x0,
+                                   int32_t y0, int32_t x1, int32_t y1,
+                                   size_t *out, size_t max) {
+  if (!um || x1 < x0 || y1 < y0)
+    return 0;
+
+  size_t found = 0;
+  int32_t cx0 = cell_of(x0), cx1 = cell_of(x1);
+  int32_t cy0 = cell_of(y0), cy1 = cell_of(y1);
+  double cells = ((double)cx1 - cx0 + 1) * ((double)cy1 - cy0 + 1);
+
+  /* A rect spanning more cells than there are units is cheaper to scan */
+  if (!um->bucket_heads || cells > (double)um->unit_count) {
+    const int32_t *xs = um->x, *ys = um->y, *str = um->strength;
+    for (size_t i = 0; i < um->unit_count; i++) {
+      if (str[i] <= 0 || xs[i] < x0 || xs[i] > x1 || ys[i] < y0 || ys[i] > y1)
+        continue;
+      if (found < max)
+        out[found] = i;
+      found++;
+    }
+    return found;
+  }
+
+  for (int32_t cy = cy0; cy <= cy1; cy++) {
+    for (int32_t cx = cx0; cx <= cx1; cx++) {
+      int32_t i = um->bucket_heads[bucket_of_cell(cx, cy)];
+      for (; i >= 0; i = um->hash_next[i]) {
+        int32_t ux = um->x[i], uy = um->y[i];
+        /* Buckets are shared between cells; the cell test avoids visiting
+           a unit once per aliasing cell */
+        if (cell_of(ux) != cx || cell_of(uy) != cy || ux < x0 || ux > x1 ||
+            uy < y0 || uy > y1)
+          continue;
+        if (found < max)
+          out[found] = (size_t)i;
+        found++;
+      }
+    }
+  }
+  if (out)
+    qsort(out, MIN(found, max), sizeof(size_t), compare_index);
+  return found;
+}
+
+/* ---- Save section ---- */
+
+#define UNIT_TABLE_MARK 0x554E0002u /* sections before it start with a count */
+
+/* Version 1 layout: one packed struct per unit */
+typedef struct {
+  char id[STRING_SHORT_LEN];
+  char name[STRING_MEDIUM_LEN];
+  civ_symbol_t name_sym;
+  civ_unit_type_t unit_type;
+  civ_float_t combat_strength;
+  civ_float_t movement_speed;
+  civ_float_t supply_consumption;
+  civ_float_t morale;
+  civ_float_t experience;
+  int32_t current_strength;
+  int32_t max_strength;
+  int32_t x;
+  int32_t y;
+  int32_t visibility_range;
+  bool has_moved;
+  int32_t level;
+  civ_float_t next_level_xp;
+  int32_t hash_bucket;
+  int32_t hash_next;
+} civ_unit_v1_t;
+
+/* Owners are saved by name, since handles depend on intern order */
+static void units_put(const civ_unit_manager_t *um, civ_ser_cursor_t *c) {
+  uint32_t mark = UNIT_TABLE_MARK, count = (uint32_t)um->unit_count;
+  CIV_SER_PUT(c, mark);
+  CIV_SER_PUT(c, count);
+  CIV_SER_PUT(c, um->next_serial);
+  civ_ser_put(c, um->units, um->unit_count * sizeof(civ_unit_t));
+  civ_ser_put(c, um->x, um->unit_count * sizeof(int32_t));
+  civ_ser_put(c, um->y, um->unit_count * sizeof(int32_t));
+  civ_ser_put(c, um->strength, um->unit_count * sizeof(int32_t));
+  civ_ser_put(c, um->moved, um->unit_count * sizeof(uint8_t));
+  for (size_t i = 0; i < um->unit_count; i++) {
+    const char *owner = civ_symbol_name(um->owner[i]);
+    uint16_t len = (uint16_t)MIN(strlen(owner), (size_t)STRING_SHORT_LEN - 1);
+    CIV_SER_PUT(c, len);
+    civ_ser_put(c, owner, len);
+  }
+}
+
+static civ_result_t units_serialize(const void *object, char *buffer,
+                                    size_t buffer_size, size_t *written) {
+  civ_ser_cursor_t c = civ_ser_cursor(buffer, buffer_size);
+  units_put((const civ_unit_manager_t *)object, &c);
+  if (written) *written = c.pos;
+  return c.overflow ? (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Buffer too small"}
+                    : (civ_result_t){CIV_OK, NULL};
+}
+
+static size_t units_serialized_size(const void *object) {
+  civ_ser_cursor_t c = civ_ser_cursor(NULL, 0);
+  units_put((const civ_unit_manager_t *)object, &c);
+  return c.pos;
+}
+
+/* Empty the manager, keeping its storage, and size it for count units */
+static bool units_reset(civ_unit_manager_t *um, size_t count) {
+  if (count > CIV_UNIT_MAX || !reserve_units(um, MAX(count, (size_t)1)))
+    return false;
+  um->unit_count = 0;
+  um->slot_count = 0;
+  um->free_slot = UINT32_MAX;
+  if (um->bucket_heads)
+    memset(um->bucket_heads, 0xFF, CIV_UNIT_HASH_BUCKETS * sizeof(int32_t));
+  return true;
+}
+
+/* Give the loaded units [0, count) slots and hash them; dead ones leave */
+static void units_index(civ_unit_manager_t *um, size_t count) {
+  um->unit_count = count;
+  for (size_t i = 0; i < count; i++) {
+    um->units[i].name[STRING_MEDIUM_LEN - 1] = '\0';
+    um->units[i].id[STRING_SHORT_LEN - 1] = '\0';
+    intern_name(&um->units[i]);
+    um->slot[i] = take_slot(um, (uint32_t)i);
+    hash_insert(um, i);
+  }
+  for (size_t i = um->unit_count; i-- > 0;)
+    if (um->strength[i] <= 0)
+      civ_unit_manager_kill_unit(um, i);
+}
+
+static civ_result_t units_load_v1(civ_unit_manager_t *um, civ_ser_cursor_t *c,
+                                  uint32_t count, size_t left) {
+  if ((size_t)count * sizeof(civ_unit_v1_t) != left)
+    return (civ_result_t){CIV_ERROR_INVALID_DATA, "Unit section size"};
+  if (!units_reset(um, count))
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Unit allocation"};
+  uint64_t serial = 0;
+  for (size_t i = 0; i < count; i++) {
+    civ_unit_v1_t v;
+    civ_ser_get(c, &v, sizeof(v));
+    civ_unit_t *u = &um->units[i];
+    memset(u, 0, sizeof(*u));
+    memcpy(u->id, v.id, sizeof(u->id));
+    memcpy(u->name, v.name, sizeof(u->name));
+    u->unit_type = v.unit_type;
+    u->combat_strength = v.combat_strength;
+    u->movement_speed = v.movement_speed;
+    u->supply_consumption = v.supply_consumption;
+    u->morale = v.morale;
+    u->experience = v.experience;
+    u->max_strength = v.max_strength;
+    u->visibility_range = v.visibility_range;
+    u->level = v.level;
+    u->next_level_xp = v.next_level_xp;
+    um->x[i] = v.x;
+    um->y[i] = v.y;
+    um->strength[i] = v.current_strength;
+    um->moved[i] = v.has_moved;
+    um->owner[i] = CIV_SYMBOL_NONE;
+    /* Version 1 ids were numbered by unit count */
+    unsigned long long n = 0;
+    if (sscanf(v.id, "unit_%llu", &n) == 1 && n > serial)
+      serial = n;
+  }
+  um->next_serial = serial + 1;
+  units_index(um, count);
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+static civ_result_t units_deserialize(void *object, const char *buffer,
+                                      size_t buffer_size) {
+  civ_unit_manager_t *um = (civ_unit_manager_t *)object;
+  civ_ser_cursor_t c = civ_ser_cursor((void *)buffer, buffer_size);
+  uint32_t mark = 0, count = 0;
+  if (!CIV_SER_GET(&c, mark))
+    return (civ_result_t){CIV_ERROR_INVALID_DATA, "Unit section size"};
+  if (mark != UNIT_TABLE_MARK)
+    return units_load_v1(um, &c, mark, buffer_size - c.pos);
+
+  uint64_t serial = 1;
+  if (!CIV_SER_GET(&c, count) || !CIV_SER_GET(&c, serial))
+    return (civ_result_t){CIV_ERROR_INVALID_DATA, "Unit section size"};
+  size_t fixed = sizeof(civ_unit_t) + 3 * sizeof(int32_t) + sizeof(uint8_t);
+  if ((size_t)count * (fixed + sizeof(uint16_t)) > buffer_size - c.pos)
+    return (civ_result_t){CIV_ERROR_INVALID_DATA, "Unit section size"};
+  if (!units_reset(um, count))
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Unit allocation"};
+
+  civ_ser_get(&c, um->units, (size_t)count * sizeof(civ_unit_t));
+  civ_ser_get(&c, um->x, (size_t)count * sizeof(int32_t));
+  civ_ser_get(&c, um->y, (size_t)count * sizeof(int32_t));
+  civ_ser_get(&c, um->strength, (size_t)count * sizeof(int32_t));
+  civ_ser_get(&c, um->moved, (size_t)count * sizeof(uint8_t));
+  for (size_t i = 0; i < count; i++) {
+    char owner[STRING_SHORT_LEN];
+    uint16_t len = 0;
+    if (!CIV_SER_GET(&c, len) || len >= sizeof(owner) ||
+        !civ_ser_get(&c, owner, len))
+      return (civ_result_t){CIV_ERROR_INVALID_DATA, "Unit owner"};
+    owner[len] = '\0';
+    um->owner[i] = civ_symbol_intern(owner);
+  }
+  um->next_serial = serial;
+  units_index(um, count);
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+civ_serializable_t civ_unit_manager_serializable(civ_unit_manager_t *um) {
+  return (civ_serializable_t){um, units_serialize, units_deserialize,
+                              units_serialized_size};
+}
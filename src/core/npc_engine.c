@@ -3,14 +3,22 @@
  * @brief NPC decision engine — NPCs make choices, history unfolds
  */
 #include "core/npc_engine.h"
+#include "core/world/nation.h"
 #include "common.h"
+#include "utils/rng.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 
-/* Decision templates per category */
-static const char *s_military[] = {
+#define NPC_MIN_CAPACITY   64
+#define NPC_QUIET_MIN      2    /* turns a nation stays quiet, at least */
+#define NPC_QUIET_SPREAD   4    /* ... plus up to this many more */
+#define NPC_MIN_INFLUENCE  0.2f /* less influential NPCs do not act */
+#define NPC_TEMPLATES      6
+#define NPC_CORRUPT_TEMPLATES 3
+
+/* Decision templates per category; %s is the actor, the second the nation */
+static const char *s_military[NPC_TEMPLATES] = {
   "Military reforms initiated by %s in %s",
   "Border fortifications strengthened by order of %s",
   "Army conscription expanded under %s's directive",
@@ -18,7 +26,7 @@ static const char *s_military[] = {
   "Defense pact negotiations opened by %s",
   "Military budget increased by %s",
 };
-static const char *s_economic[] = {
+static const char *s_economic[NPC_TEMPLATES] = {
   "Trade agreement signed under %s's administration in %s",
   "New currency regulations imposed by %s",
   "Market liberalization reforms pushed by %s",
@@ -26,7 +34,7 @@ static const char *s_economic[] = {
   "Tax reforms enacted by %s",
   "Agricultural subsidies introduced by %s",
 };
-static const char *s_political[] = {
+static const char *s_political[NPC_TEMPLATES] = {
   "Constitutional amendment proposed by %s in %s",
   "Cabinet reshuffle executed by %s",
   "Anti-corruption investigation launched against associates of %s",
@@ -34,7 +42,7 @@ static const char *s_political[] = {
   "New political coalition formed with %s's backing",
   "Local governance powers devolved by %s",
 };
-static const char *s_social[] = {
+static const char *s_social[NPC_TEMPLATES] = {
   "Education reforms championed by %s in %s",
   "Public health initiative launched by %s",
   "Cultural preservation edict issued by %s",
@@ -42,7 +50,7 @@ static const char *s_social[] = {
   "Urban development program initiated by %s",
   "Labor rights legislation introduced by %s",
 };
-static const char *s_diplomatic[] = {
+static const char *s_diplomatic[NPC_TEMPLATES] = {
   "Diplomatic mission dispatched by %s of %s",
   "Foreign aid package approved by %s",
   "Border dispute resolution proposed by %s",
@@ -51,112 +59,320 @@ static const char *s_diplomatic[] = {
   "Cultural exchange program launched by %s",
 };
 
+static const char **const s_templates[CIV_NPC_CATEGORY_COUNT] = {
+  [CIV_NPC_MILITARY] = s_military,   [CIV_NPC_ECONOMIC] = s_economic,
+  [CIV_NPC_POLITICAL] = s_political, [CIV_NPC_SOCIAL] = s_social,
+  [CIV_NPC_DIPLOMATIC] = s_diplomatic,
+};
+static const char *s_corrupt[NPC_CORRUPT_TEMPLATES] = {
+  "Embezzlement scandal linked to %s of %s",
+  "%s of %s accused of nepotism in appointments",
+  "Bribery allegations surface against %s",
+};
+
+/* What each trigger asks of a nation's NPCs; quiet turns go by leaning */
+static const uint8_t s_trigger_category[CIV_NPC_TRIGGER_COUNT] = {
+  [CIV_NPC_TRIGGER_QUIET] = CIV_NPC_CATEGORY_COUNT,
+  [CIV_NPC_TRIGGER_TERRITORY_LOST] = CIV_NPC_MILITARY,
+  [CIV_NPC_TRIGGER_TERRITORY_GAINED] = CIV_NPC_POLITICAL,
+  [CIV_NPC_TRIGGER_RECESSION] = CIV_NPC_ECONOMIC,
+  [CIV_NPC_TRIGGER_UNEMPLOYMENT] = CIV_NPC_SOCIAL,
+  [CIV_NPC_TRIGGER_INFLATION] = CIV_NPC_ECONOMIC,
+};
+
+/* ── Store ─────────────────────────────────────────────────────── */
+
 civ_npc_engine_t *civ_npc_engine_create(void) {
-  civ_npc_engine_t *eng = (civ_npc_engine_t *)malloc(sizeof(civ_npc_engine_t));
-  if (!eng) return NULL;
-  memset(eng, 0, sizeof(*eng));
-  eng->npc_capacity = 64;
-  eng->npcs = (civ_npc_t *)calloc((size_t)eng->npc_capacity, sizeof(civ_npc_t));
+  civ_npc_engine_t *eng = (civ_npc_engine_t *)CIV_CALLOC(1, sizeof(civ_npc_engine_t));
   return eng;
 }
 
+static void engine_free(civ_npc_engine_t *eng) {
+  for (int a = 0; a < CIV_NPC_AXIS_COUNT; a++) CIV_FREE(eng->ideology[a]);
+#define FREE_FIELD(name) CIV_FREE(eng->name);
+  CIV_NPC_FIELDS(FREE_FIELD)
+#undef FREE_FIELD
+  CIV_FREE(eng->age);
+  CIV_FREE(eng->bucket);
+  CIV_FREE(eng->name);
+  CIV_FREE(eng->role);
+  for (uint32_t b = 0; b < eng->bucket_count; b++) CIV_FREE(eng->buckets[b].ids);
+  CIV_FREE(eng->buckets);
+  CIV_FREE(eng->bucket_of);
+}
+
 void civ_npc_engine_destroy(civ_npc_engine_t *eng) {
   if (!eng) return;
-  free(eng->npcs);
-  free(eng);
-}
-
-civ_npc_t *civ_npc_engine_add(civ_npc_engine_t *eng, const char *name,
-                              const char *role, const char *nation_id) {
-  if (!eng || eng->npc_count >= eng->npc_capacity) return NULL;
-  civ_npc_t *npc = &eng->npcs[eng->npc_count++];
-  memset(npc, 0, sizeof(*npc));
-  strncpy(npc->name, name, CIV_NPC_NAME_MAX-1);
-  strncpy(npc->role, role, sizeof(npc->role)-1);
-  strncpy(npc->nation_id, nation_id, sizeof(npc->nation_id)-1);
+  engine_free(eng);
+  CIV_FREE(eng);
+}
+
+#define GROW_ARRAY(arr, cap)                                                   \
+  do {                                                                         \
+    void *grown = CIV_REALLOC((arr), (size_t)(cap) * sizeof(*(arr)));          \
+    if (!grown) return false;                                                  \
+    (arr) = grown;                                                             \
+  } while (0)
+
+static bool reserve(civ_npc_engine_t *eng, uint32_t count) {
+  if (count <= eng->capacity) return true;
+  uint32_t cap = eng->capacity ? eng->capacity : NPC_MIN_CAPACITY;
+  while (cap < count) cap *= 2;
+  for (int a = 0; a < CIV_NPC_AXIS_COUNT; a++) GROW_ARRAY(eng->ideology[a], cap);
+#define GROW_FIELD(name) GROW_ARRAY(eng->name, cap);
+  CIV_NPC_FIELDS(GROW_FIELD)
+#undef GROW_FIELD
+  GROW_ARRAY(eng->age, cap);
+  GROW_ARRAY(eng->bucket, cap);
+  GROW_ARRAY(eng->name, cap);
+  GROW_ARRAY(eng->role, cap);
+  eng->capacity = cap;
+  return true;
+}
+
+/* The nation's bucket, made on its first NPC; -1 if out of memory */
+static int32_t bucket_for(civ_npc_engine_t *eng, civ_symbol_t nation) {
+  if (nation >= eng->bucket_of_size) {
+    uint32_t size = MAX(civ_symbol_count(), nation + 1);
+    int32_t *bucket_of = CIV_REALLOC(eng->bucket_of, size * sizeof(int32_t));
+    if (!bucket_of) return -1;
+    for (uint32_t k = eng->bucket_of_size; k < size; k++) bucket_of[k] = -1;
+    eng->bucket_of = bucket_of;
+    eng->bucket_of_size = size;
+  }
+  if (eng->bucket_of[nation] >= 0) return eng->bucket_of[nation];
+
+  if (eng->bucket_count >= eng->bucket_capacity) {
+    uint32_t cap = eng->bucket_capacity ? eng->bucket_capacity * 2 : 16;
+    civ_npc_bucket_t *buckets =
+        CIV_REALLOC(eng->buckets, cap * sizeof(civ_npc_bucket_t));
+    if (!buckets) return -1;
+    eng->buckets = buckets;
+    eng->bucket_capacity = cap;
+  }
+  int32_t slot = (int32_t)eng->bucket_count++;
+  civ_npc_bucket_t *b = &eng->buckets[slot];
+  memset(b, 0, sizeof(*b));
+  b->nation = nation;
+  b->nation_index = -1;
+  b->next_quiet_turn = eng->turn + 1 + civ_rand() % (NPC_QUIET_SPREAD + 1);
+  eng->bucket_of[nation] = slot;
+  eng->nations_seen = -1; /* look the new nation up */
+  return slot;
+}
+
+static bool bucket_add(civ_npc_bucket_t *b, uint32_t id) {
+  if (b->count >= b->capacity) {
+    uint32_t cap = b->capacity ? b->capacity * 2 : 8;
+    GROW_ARRAY(b->ids, cap);
+    b->capacity = cap;
+  }
+  b->ids[b->count++] = id;
+  return true;
+}
+
+/* Append an NPC with everything but its numbers; -1 if out of memory */
+static int32_t add_npc(civ_npc_engine_t *eng, const char *name,
+                       const char *role, const char *nation_id) {
+  civ_symbol_t nation = civ_symbol_intern(nation_id);
+  if (!nation || !reserve(eng, eng->count + 1)) return -1;
+  int32_t slot = bucket_for(eng, nation);
+  if (slot < 0 || !bucket_add(&eng->buckets[slot], eng->count)) return -1;
+  uint32_t id = eng->count++;
+  eng->bucket[id] = (uint32_t)slot;
+  snprintf(eng->name[id], CIV_NPC_NAME_MAX, "%s", name ? name : "");
+  snprintf(eng->role[id], CIV_NPC_ROLE_MAX, "%s", role ? role : "");
+  return (int32_t)id;
+}
+
+int32_t civ_npc_engine_add(civ_npc_engine_t *eng, const char *name,
+                           const char *role, const char *nation_id) {
+  if (!eng) return -1;
+  int32_t id = add_npc(eng, name, role, nation_id);
+  if (id < 0) return -1;
   /* Randomize ideology */
-  npc->ideology.traditional_vs_progressive = (float)(rand() % 100) / 100.0f;
-  npc->ideology.authoritarian_vs_liberal    = (float)(rand() % 100) / 100.0f;
-  npc->ideology.nationalist_vs_globalist    = (float)(rand() % 100) / 100.0f;
-  npc->ideology.militarist_vs_pacifist      = (float)(rand() % 100) / 100.0f;
-  npc->ideology.mercantile_vs_agrarian      = (float)(rand() % 100) / 100.0f;
-  npc->ideology.religious_vs_secular         = (float)(rand() % 100) / 100.0f;
-  npc->influence = 0.3f + (float)(rand() % 70) / 100.0f;
-  npc->corruption = (float)(rand() % 40) / 100.0f;
-  npc->competence = 0.3f + (float)(rand() % 70) / 100.0f;
-  npc->age = 30 + rand() % 50;
-  return npc;
-}
-
-static void add_decision(civ_npc_engine_t *eng, const char *desc,
-                         const char *actor, const char *nation,
-                         int32_t year, int32_t day, uint32_t cat,
-                         float stab, float econ, float diplo) {
-  civ_decision_t *d = &eng->recent_decisions[eng->decision_head];
-  memset(d, 0, sizeof(*d));
-  strncpy(d->description, desc, sizeof(d->description)-1);
-  strncpy(d->actor_name, actor, sizeof(d->actor_name)-1);
-  strncpy(d->nation_id, nation, sizeof(d->nation_id)-1);
-  d->global_year = year; d->global_day = day;
-  d->category = cat;
-  d->stability_effect = stab; d->economic_effect = econ;
-  d->diplomatic_effect = diplo;
+  for (int a = 0; a < CIV_NPC_AXIS_COUNT; a++)
+    eng->ideology[a][id] = (float)(civ_rand() % 100) / 100.0f;
+  eng->influence[id] = 0.3f + (float)(civ_rand() % 70) / 100.0f;
+  eng->corruption[id] = (float)(civ_rand() % 40) / 100.0f;
+  eng->competence[id] = 0.3f + (float)(civ_rand() % 70) / 100.0f;
+  eng->age[id] = 30 + civ_rand() % 50;
+  return id;
+}
+
+bool civ_npc_engine_get(const civ_npc_engine_t *eng, uint32_t id,
+                        civ_npc_t *out) {
+  if (!eng || !out || id >= eng->count) return false;
+  out->name = eng->name[id];
+  out->role = eng->role[id];
+  out->nation_id = civ_symbol_name(eng->buckets[eng->bucket[id]].nation);
+#define GET_AXIS(name) out->ideology.name = eng->ideology[CIV_NPC_AXIS_##name][id];
+  CIV_NPC_IDEOLOGY_AXES(GET_AXIS)
+#undef GET_AXIS
+  out->influence = eng->influence[id];
+  out->corruption = eng->corruption[id];
+  out->competence = eng->competence[id];
+  out->age = eng->age[id];
+  return true;
+}
+
+const civ_npc_bucket_t *civ_npc_engine_nation(const civ_npc_engine_t *eng,
+                                              const char *nation_id) {
+  civ_symbol_t nation = civ_symbol_find(nation_id);
+  if (!eng || nation == CIV_SYMBOL_NONE || nation >= eng->bucket_of_size ||
+      eng->bucket_of[nation] < 0)
+    return NULL;
+  return &eng->buckets[eng->bucket_of[nation]];
+}
+
+/* ── Turn ──────────────────────────────────────────────────────────── */
+
+static void add_decision(civ_npc_engine_t *eng, const civ_decision_t *d) {
+  eng->recent_decisions[eng->decision_head] = *d;
   eng->decision_head = (eng->decision_head + 1) % CIV_NPC_DECISION_MAX;
   if (eng->decision_count < CIV_NPC_DECISION_MAX) eng->decision_count++;
 }
 
+/* How much an NPC leans toward acting in a category, 0-1 */
+static float leaning(const civ_npc_engine_t *eng, uint32_t id, uint32_t cat) {
+  switch (cat) {
+  case CIV_NPC_MILITARY:
+    return 1.0f - eng->ideology[CIV_NPC_AXIS_militarist_vs_pacifist][id];
+  case CIV_NPC_ECONOMIC:
+    return 1.0f - eng->ideology[CIV_NPC_AXIS_mercantile_vs_agrarian][id];
+  case CIV_NPC_POLITICAL:
+    return 1.0f - eng->ideology[CIV_NPC_AXIS_authoritarian_vs_liberal][id];
+  case CIV_NPC_SOCIAL:
+    return 1.0f - eng->ideology[CIV_NPC_AXIS_religious_vs_secular][id];
+  default:
+    return eng->ideology[CIV_NPC_AXIS_nationalist_vs_globalist][id];
+  }
+}
+
+/* Category an NPC picks on its own, from its strongest convictions */
+static uint32_t own_category(const civ_npc_engine_t *eng, uint32_t id) {
+  if (eng->ideology[CIV_NPC_AXIS_militarist_vs_pacifist][id] < 0.35f)
+    return CIV_NPC_MILITARY;
+  if (eng->ideology[CIV_NPC_AXIS_mercantile_vs_agrarian][id] < 0.4f)
+    return CIV_NPC_ECONOMIC;
+  if (eng->ideology[CIV_NPC_AXIS_authoritarian_vs_liberal][id] < 0.3f)
+    return CIV_NPC_POLITICAL;
+  if (eng->ideology[CIV_NPC_AXIS_religious_vs_secular][id] < 0.3f)
+    return CIV_NPC_SOCIAL;
+  return CIV_NPC_DIPLOMATIC;
+}
+
+/* What moved since b's NPCs last reacted; -1 for nothing */
+static int trigger_for(civ_npc_bucket_t *b, const civ_nation_t *n) {
+  const civ_nation_economy_t *e = &n->economy;
+  int32_t land = n->territory.land_tiles;
+  if (!b->seen) {
+    b->seen = true;
+    b->land_tiles = b->land_mark = land;
+    b->gdp_growth = e->gdp_growth;
+    b->unemployment = e->unemployment;
+    b->inflation = e->inflation;
+    return -1;
+  }
+
+  int trigger = -1;
+  if (land < b->land_tiles)
+    trigger = CIV_NPC_TRIGGER_TERRITORY_LOST;
+  else if (land - b->land_mark > MAX(b->land_mark / 20, 1))
+    trigger = CIV_NPC_TRIGGER_TERRITORY_GAINED;
+  else if (e->gdp_growth < b->gdp_growth - 0.01f)
+    trigger = CIV_NPC_TRIGGER_RECESSION;
+  else if (e->unemployment > b->unemployment + 0.01f)
+    trigger = CIV_NPC_TRIGGER_UNEMPLOYMENT;
+  else if (e->inflation > b->inflation + 0.02f)
+    trigger = CIV_NPC_TRIGGER_INFLATION;
+
+  /* Good news moves the baseline at once; bad news only once answered */
+  b->land_tiles = land;
+  if (trigger >= 0 || land < b->land_mark) b->land_mark = land;
+  if (trigger >= 0 || e->gdp_growth > b->gdp_growth) b->gdp_growth = e->gdp_growth;
+  if (trigger >= 0 || e->unemployment < b->unemployment)
+    b->unemployment = e->unemployment;
+  if (trigger >= 0 || e->inflation < b->inflation) b->inflation = e->inflation;
+  return trigger;
+}
+
+/* b's answer to trigger: the best-fitting NPC on an event, a random one
+   acting on its own leanings on a quiet turn */
+static void decide(civ_npc_engine_t *eng, const civ_npc_bucket_t *b,
+                   int trigger, int32_t year, int32_t day) {
+  uint32_t cat = s_trigger_category[trigger];
+  uint32_t actor = UINT32_MAX;
+  if (cat == CIV_NPC_CATEGORY_COUNT) {
+    uint32_t id = b->ids[civ_rand() % b->count];
+    if (eng->influence[id] < NPC_MIN_INFLUENCE) return;
+    actor = id;
+    cat = own_category(eng, id);
+  } else {
+    float best = -1.0f;
+    for (uint32_t k = 0; k < b->count; k++) {
+      uint32_t id = b->ids[k];
+      if (eng->influence[id] < NPC_MIN_INFLUENCE) continue;
+      float fit = eng->influence[id] * leaning(eng, id, cat);
+      if (fit > best) {
+        best = fit;
+        actor = id;
+      }
+    }
+    if (actor == UINT32_MAX) return;
+  }
+
+  civ_decision_t d = {0};
+  d.actor = actor;
+  d.global_year = year;
+  d.global_day = day;
+  d.category = (uint8_t)cat;
+  d.trigger = (uint8_t)trigger;
+  d.template_index = (uint8_t)(civ_rand() % NPC_TEMPLATES);
+  if ((float)(civ_rand() % 100) / 100.0f < eng->corruption[actor]) {
+    d.corrupt = 1;
+    d.template_index = (uint8_t)(civ_rand() % NPC_CORRUPT_TEMPLATES);
+    d.stability_effect = -0.05f;
+    d.economic_effect = -0.03f;
+    d.diplomatic_effect = -0.02f;
+  } else {
+    d.stability_effect = (float)(civ_rand() % 20 - 5) / 100.0f; /* -0.05 to +0.15 */
+    d.economic_effect = (float)(civ_rand() % 20 - 5) / 100.0f;
+    d.diplomatic_effect = (float)(civ_rand() % 15 - 3) / 100.0f;
+  }
+  add_decision(eng, &d);
+}
+
 void civ_npc_engine_process_turn(civ_npc_engine_t *eng, void *nation_mgr,
                                  int32_t global_year, int32_t global_day) {
-  if (!eng || eng->npc_count == 0) return;
-
-  /* Each turn, a few NPCs make decisions */
-  int decisions_this_turn = 2 + rand() % 4;
-  for (int d = 0; d < decisions_this_turn; d++) {
-    int idx = rand() % eng->npc_count;
-    civ_npc_t *npc = &eng->npcs[idx];
-    if (npc->influence < 0.2f) continue; /* low-influence NPCs act less */
-
-    /* Choose category based on ideology */
-    uint32_t cat;
-    if (npc->ideology.militarist_vs_pacifist < 0.35f) cat = 0;      /* military */
-    else if (npc->ideology.mercantile_vs_agrarian < 0.4f) cat = 1;  /* economic */
-    else if (npc->ideology.authoritarian_vs_liberal < 0.3f) cat = 2; /* political */
-    else if (npc->ideology.religious_vs_secular < 0.3f) cat = 3;    /* social */
-    else cat = 4; /* diplomatic */
-
-    const char **templates;
-    int tcount;
-    switch (cat) {
-    case 0: templates = s_military;    tcount = 6; break;
-    case 1: templates = s_economic;    tcount = 6; break;
-    case 2: templates = s_political;   tcount = 6; break;
-    case 3: templates = s_social;      tcount = 6; break;
-    default: templates = s_diplomatic; tcount = 6; break;
-    }
+  if (!eng || eng->count == 0) return;
+  civ_nation_manager_t *mgr = (civ_nation_manager_t *)nation_mgr;
+  eng->turn++;
 
-    char desc[192];
-    int tidx = rand() % tcount;
-    /* Corruption chance: 20% chance of a corrupt action */
-    if ((float)(rand()%100)/100.0f < npc->corruption) {
-      const char *corrupt[] = {
-        "Embezzlement scandal linked to %s of %s",
-        "%s of %s accused of nepotism in appointments",
-        "Bribery allegations surface against %s",
-      };
-      int ci = rand() % 3;
-      snprintf(desc, sizeof(desc), corrupt[ci], npc->name, npc->nation_id);
-      add_decision(eng, desc, npc->name, npc->nation_id,
-                   global_year, global_day, cat, -0.05f, -0.03f, -0.02f);
-    } else {
-      snprintf(desc, sizeof(desc), templates[tidx], npc->name, npc->nation_id);
-      float se = (float)(rand()%20-5)/100.0f;  /* -0.05 to +0.15 */
-      float ee = (float)(rand()%20-5)/100.0f;
-      float de = (float)(rand()%15-3)/100.0f;
-      add_decision(eng, desc, npc->name, npc->nation_id,
-                   global_year, global_day, cat, se, ee, de);
+  /* Find each bucket's nation again whenever the manager's set changed */
+  int32_t nations = mgr ? mgr->count : 0;
+  if (nations != eng->nations_seen) {
+    for (uint32_t i = 0; i < eng->bucket_count; i++) {
+      civ_nation_t *n = civ_nation_get_by_id(mgr, civ_symbol_name(eng->buckets[i].nation));
+      eng->buckets[i].nation_index = n ? (int32_t)(n - mgr->nations) : -1;
     }
+    eng->nations_seen = nations;
+  }
+
+  for (uint32_t i = 0; i < eng->bucket_count; i++) {
+    civ_npc_bucket_t *b = &eng->buckets[i];
+    if (b->nation_index >= 0 && mgr->nations[b->nation_index].defunct)
+      continue; /* its people now answer to another nation */
+    int trigger = b->nation_index >= 0
+                      ? trigger_for(b, &mgr->nations[b->nation_index])
+                      : -1;
+    if (trigger < 0 && eng->turn >= b->next_quiet_turn)
+      trigger = CIV_NPC_TRIGGER_QUIET;
+    if (trigger < 0) continue;
+    b->next_quiet_turn =
+        eng->turn + NPC_QUIET_MIN + civ_rand() % (NPC_QUIET_SPREAD + 1);
+    decide(eng, b, trigger, global_year, global_day);
   }
-  (void)nation_mgr;
 }
 
 int civ_npc_engine_get_recent(civ_npc_engine_t *eng, int max,
@@ -169,3 +385,212 @@ int civ_npc_engine_get_recent(civ_npc_engine_t *eng, int max,
   }
   return count;
 }
+
+int civ_npc_engine_describe(const civ_npc_engine_t *eng,
+                            const civ_decision_t *d, char *buf, size_t size) {
+  if (!eng || !d || !buf || size == 0) return 0;
+  const char *fmt = NULL;
+  if (d->corrupt && d->template_index < NPC_CORRUPT_TEMPLATES)
+    fmt = s_corrupt[d->template_index];
+  else if (!d->corrupt && d->category < CIV_NPC_CATEGORY_COUNT &&
+           d->template_index < NPC_TEMPLATES)
+    fmt = s_templates[d->category][d->template_index];
+  if (!fmt || d->actor >= eng->count) {
+    buf[0] = '\0';
+    return 0;
+  }
+  const char *nation = civ_symbol_name(eng->buckets[eng->bucket[d->actor]].nation);
+  return snprintf(buf, size, fmt, eng->name[d->actor], nation);
+}
+
+/* ── Save section ──────────────────────────────────────────────── */
+
+#define NPC_TABLE_MARK 0x4E50C002u /* sections before it start with a count */
+
+/* Version 1 layouts, for reading older saves */
+typedef struct {
+  char               name[CIV_NPC_NAME_MAX];
+  char               role[48];
+  civ_npc_ideology_t ideology;
+  float              influence, corruption, competence;
+  int32_t            age;
+  char               nation_id[32];
+} legacy_npc_t;
+
+typedef struct {
+  char     description[192];
+  char     actor_name[48];
+  char     nation_id[32];
+  int32_t  global_year, global_day;
+  float    stability_effect, economic_effect, diplomatic_effect;
+  uint32_t category;
+} legacy_decision_t;
+
+static void npcs_put(const civ_npc_engine_t *eng, civ_ser_cursor_t *c) {
+  uint32_t mark = NPC_TABLE_MARK;
+  CIV_SER_PUT(c, mark);
+  CIV_SER_PUT(c, eng->count);
+  for (uint32_t id = 0; id < eng->count; id++) {
+    char nation[CIV_NPC_NATION_MAX] = {0};
+    snprintf(nation, sizeof(nation), "%s",
+             civ_symbol_name(eng->buckets[eng->bucket[id]].nation));
+    civ_ser_put(c, eng->name[id], CIV_NPC_NAME_MAX);
+    civ_ser_put(c, eng->role[id], CIV_NPC_ROLE_MAX);
+    civ_ser_put(c, nation, sizeof(nation));
+    for (int a = 0; a < CIV_NPC_AXIS_COUNT; a++) CIV_SER_PUT(c, eng->ideology[a][id]);
+#define PUT_FIELD(name) CIV_SER_PUT(c, eng->name[id]);
+    CIV_NPC_FIELDS(PUT_FIELD)
+#undef PUT_FIELD
+    CIV_SER_PUT(c, eng->age[id]);
+  }
+
+  /* Buckets come back in the same order from the NPCs above */
+  CIV_SER_PUT(c, eng->turn);
+  CIV_SER_PUT(c, eng->bucket_count);
+  for (uint32_t i = 0; i < eng->bucket_count; i++) {
+    const civ_npc_bucket_t *b = &eng->buckets[i];
+    uint8_t seen = b->seen;
+    CIV_SER_PUT(c, b->next_quiet_turn);
+    CIV_SER_PUT(c, seen);
+    CIV_SER_PUT(c, b->land_tiles);
+    CIV_SER_PUT(c, b->land_mark);
+    CIV_SER_PUT(c, b->gdp_growth);
+    CIV_SER_PUT(c, b->unemployment);
+    CIV_SER_PUT(c, b->inflation);
+  }
+
+  CIV_SER_PUT(c, eng->decision_count);
+  int pos = (eng->decision_head - eng->decision_count + CIV_NPC_DECISION_MAX) %
+            CIV_NPC_DECISION_MAX;
+  for (int i = 0; i < eng->decision_count; i++) {
+    const civ_decision_t *d = &eng->recent_decisions[(pos + i) % CIV_NPC_DECISION_MAX];
+    CIV_SER_PUT(c, d->actor);
+    CIV_SER_PUT(c, d->global_year);
+    CIV_SER_PUT(c, d->global_day);
+    CIV_SER_PUT(c, d->stability_effect);
+    CIV_SER_PUT(c, d->economic_effect);
+    CIV_SER_PUT(c, d->diplomatic_effect);
+    CIV_SER_PUT(c, d->category);
+    CIV_SER_PUT(c, d->trigger);
+    CIV_SER_PUT(c, d->template_index);
+    CIV_SER_PUT(c, d->corrupt);
+  }
+}
+
+static civ_result_t npcs_serialize(const void *object, char *buffer,
+                                   size_t buffer_size, size_t *written) {
+  civ_ser_cursor_t c = civ_ser_cursor(buffer, buffer_size);
+  npcs_put((const civ_npc_engine_t *)object, &c);
+  if (written) *written = c.pos;
+  return c.overflow ? (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Buffer too small"}
+                    : (civ_result_t){CIV_OK, NULL};
+}
+
+static size_t npcs_serialized_size(const void *object) {
+  civ_ser_cursor_t c = civ_ser_cursor(NULL, 0);
+  npcs_put((const civ_npc_engine_t *)object, &c);
+  return c.pos;
+}
+
+static bool read_npcs(civ_npc_engine_t *eng, civ_ser_cursor_t *c) {
+  uint32_t count = 0;
+  const size_t record = CIV_NPC_NAME_MAX + CIV_NPC_ROLE_MAX + CIV_NPC_NATION_MAX;
+  if (!CIV_SER_GET(c, count) || (size_t)count * record > c->size - c->pos)
+    return false;
+  for (uint32_t k = 0; k < count; k++) {
+    char name[CIV_NPC_NAME_MAX], role[CIV_NPC_ROLE_MAX], nation[CIV_NPC_NATION_MAX];
+    civ_ser_get(c, name, sizeof(name));
+    civ_ser_get(c, role, sizeof(role));
+    civ_ser_get(c, nation, sizeof(nation));
+    name[sizeof(name) - 1] = role[sizeof(role) - 1] = nation[sizeof(nation) - 1] = '\0';
+    int32_t id = add_npc(eng, name, role, nation);
+    if (id < 0 || c->overflow) return false;
+    for (int a = 0; a < CIV_NPC_AXIS_COUNT; a++) CIV_SER_GET(c, eng->ideology[a][id]);
+#define GET_FIELD(name) CIV_SER_GET(c, eng->name[id]);
+    CIV_NPC_FIELDS(GET_FIELD)
+#undef GET_FIELD
+    CIV_SER_GET(c, eng->age[id]);
+  }
+
+  uint32_t buckets = 0;
+  CIV_SER_GET(c, eng->turn);
+  if (!CIV_SER_GET(c, buckets) || buckets != eng->bucket_count) return false;
+  for (uint32_t i = 0; i < buckets; i++) {
+    civ_npc_bucket_t *b = &eng->buckets[i];
+    uint8_t seen = 0;
+    CIV_SER_GET(c, b->next_quiet_turn);
+    CIV_SER_GET(c, seen);
+    CIV_SER_GET(c, b->land_tiles);
+    CIV_SER_GET(c, b->land_mark);
+    CIV_SER_GET(c, b->gdp_growth);
+    CIV_SER_GET(c, b->unemployment);
+    CIV_SER_GET(c, b->inflation);
+    b->seen = seen != 0;
+  }
+
+  /* Keep the newest decisions if the save holds more than the ring */
+  int32_t decisions = 0;
+  if (!CIV_SER_GET(c, decisions) || decisions < 0) return false;
+  for (int32_t i = 0; i < decisions; i++) {
+    civ_decision_t d = {0};
+    CIV_SER_GET(c, d.actor);
+    CIV_SER_GET(c, d.global_year);
+    CIV_SER_GET(c, d.global_day);
+    CIV_SER_GET(c, d.stability_effect);
+    CIV_SER_GET(c, d.economic_effect);
+    CIV_SER_GET(c, d.diplomatic_effect);
+    CIV_SER_GET(c, d.category);
+    CIV_SER_GET(c, d.trigger);
+    CIV_SER_GET(c, d.template_index);
+    CIV_SER_GET(c, d.corrupt);
+    if (c->overflow) return false;
+    if (d.actor < eng->count) add_decision(eng, &d);
+  }
+  return !c->overflow;
+}
+
+/* Version 1: whole structs; the decisions were text, so they are dropped */
+static bool read_legacy_npcs(civ_npc_engine_t *eng, civ_ser_cursor_t *c,
+                             uint32_t count) {
+  if ((size_t)count * sizeof(legacy_npc_t) > c->size - c->pos) return false;
+  for (uint32_t k = 0; k < count; k++) {
+    legacy_npc_t n;
+    civ_ser_get(c, &n, sizeof(n));
+    n.name[sizeof(n.name) - 1] = n.role[sizeof(n.role) - 1] = '\0';
+    n.nation_id[sizeof(n.nation_id) - 1] = '\0';
+    int32_t id = add_npc(eng, n.name, n.role, n.nation_id);
+    if (id < 0) return false;
+#define SET_AXIS(name) eng->ideology[CIV_NPC_AXIS_##name][id] = n.ideology.name;
+    CIV_NPC_IDEOLOGY_AXES(SET_AXIS)
+#undef SET_AXIS
+    eng->influence[id] = n.influence;
+    eng->corruption[id] = n.corruption;
+    eng->competence[id] = n.competence;
+    eng->age[id] = n.age;
+  }
+  return true;
+}
+
+static civ_result_t npcs_deserialize(void *object, const char *buffer,
+                                     size_t buffer_size) {
+  civ_npc_engine_t *eng = (civ_npc_engine_t *)object;
+  civ_ser_cursor_t c = civ_ser_cursor((void *)buffer, buffer_size);
+  civ_npc_engine_t fresh;
+  memset(&fresh, 0, sizeof(fresh));
+  uint32_t mark = 0;
+  bool ok = CIV_SER_GET(&c, mark) &&
+            (mark == NPC_TABLE_MARK ? read_npcs(&fresh, &c)
+                                    : read_legacy_npcs(&fresh, &c, mark));
+  if (!ok) {
+    engine_free(&fresh);
+    return (civ_result_t){CIV_ERROR_INVALID_DATA, "NPC section size"};
+  }
+  engine_free(eng);
+  *eng = fresh;
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+civ_serializable_t civ_npc_engine_serializable(civ_npc_engine_t *eng) {
+  return (civ_serializable_t){eng, npcs_serialize, npcs_deserialize,
+                              npcs_serialized_size};
+}
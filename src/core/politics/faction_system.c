@@ -28,6 +28,11 @@ void civ_faction_system_destroy(civ_faction_system_t* system) {
         civ_faction_destroy(&system->factions[i]);
     }
     CIV_FREE(system->factions);
+    CIV_FREE(system->counted_power);
+    CIV_FREE(system->rivalry_head);
+    CIV_FREE(system->awake);
+    CIV_FREE(system->active);
+    CIV_FREE(system->rivalries);
     CIV_FREE(system);
 }
 
@@ -37,6 +42,116 @@ void civ_faction_system_init(civ_faction_system_t* system) {
     memset(system, 0, sizeof(civ_faction_system_t));
     system->faction_capacity = 16;
     system->factions = (civ_political_faction_t*)CIV_CALLOC(system->faction_capacity, sizeof(civ_political_faction_t));
+    system->counted_power = (civ_float_t*)CIV_CALLOC(system->faction_capacity, sizeof(civ_float_t));
+    system->rivalry_head = (int32_t*)CIV_MALLOC(system->faction_capacity * sizeof(int32_t));
+    system->awake = (uint8_t*)CIV_CALLOC(system->faction_capacity, sizeof(uint8_t));
+    system->active = (uint32_t*)CIV_MALLOC(system->faction_capacity * sizeof(uint32_t));
+    system->dominant = -1;
+    system->reported_dominant = -1;
+    system->stability = 1.0f;
+    system->reported_stability = 1.0f;
+}
+
+static void record_change(civ_faction_system_t* system, civ_faction_change_kind_t kind,
+                          int32_t faction, int32_t other, civ_float_t before, civ_float_t after) {
+    civ_faction_change_t* change = &system->changes[system->change_total % CIV_FACTION_CHANGE_HISTORY];
+    change->kind = kind;
+    change->faction = faction;
+    change->other = other;
+    change->before = before;
+    change->after = after;
+    system->change_total++;
+}
+
+static void wake(civ_faction_system_t* system, size_t faction) {
+    if (system->awake[faction]) return;
+    system->awake[faction] = 1;
+    system->active[system->active_count++] = (uint32_t)faction;
+}
+
+/* Sum of intensity x power over the rivals of a faction */
+static civ_float_t rival_pressure(const civ_faction_system_t* system, size_t faction) {
+    civ_float_t pressure = 0.0f;
+    for (int32_t e = system->rivalry_head[faction]; e >= 0;) {
+        const civ_faction_rivalry_t* edge = &system->rivalries[e];
+        int end = edge->faction[0] == (int32_t)faction ? 0 : 1;
+        pressure += edge->intensity * system->counted_power[edge->faction[1 - end]];
+        e = edge->next[end];
+    }
+    return pressure;
+}
+
+/* Move a faction's counted power to power, pushing the delta to the aggregates */
+static void push_power(civ_faction_system_t* system, size_t faction, civ_float_t power) {
+    civ_float_t delta = power - system->counted_power[faction];
+    if (delta == 0.0f) return;
+    
+    system->total_power += delta;
+    system->tension += delta * rival_pressure(system, faction);
+    system->counted_power[faction] = power;
+    
+    if (power > system->max_power) {
+        system->max_power = power;
+        system->dominant = (int32_t)faction;
+    } else if ((int32_t)faction == system->dominant && delta < 0.0f) {
+        system->dominant_stale = true;
+    }
+}
+
+static void find_dominant(civ_faction_system_t* system) {
+    system->max_power = 0.0f;
+    system->dominant = -1;
+    for (size_t i = 0; i < system->faction_count; i++) {
+        if (system->counted_power[i] > system->max_power) {
+            system->max_power = system->counted_power[i];
+            system->dominant = (int32_t)i;
+        }
+    }
+    system->dominant_stale = false;
+}
+
+/* Stability from the aggregates; report it if it moved enough */
+static void settle_stability(civ_faction_system_t* system) {
+    if (system->dominant_stale) find_dominant(system);
+    
+    civ_float_t stability = 1.0f;
+    if (system->total_power > 0.0f) {
+        /* Higher when power is more evenly spread and rivals are quiet */
+        civ_float_t total = system->total_power;
+        civ_float_t balance = 1.0f - (system->max_power / total);
+        stability = CLAMP(balance - system->tension / (total * total), 0.0f, 1.0f);
+    }
+    system->stability = stability;
+    
+    if (fabs(stability - system->reported_stability) >= CIV_FACTION_CHANGE_STEP) {
+        record_change(system, CIV_FACTION_CHANGE_STABILITY, system->dominant, -1,
+                      system->reported_stability, stability);
+        system->reported_stability = stability;
+    }
+    if (system->dominant != system->reported_dominant) {
+        record_change(system, CIV_FACTION_CHANGE_DOMINANT, system->dominant,
+                      system->reported_dominant, stability, stability);
+        system->reported_dominant = system->dominant;
+    }
+}
+
+void civ_faction_system_resync(civ_faction_system_t* system) {
+    if (!system) return;
+    
+    system->total_power = 0.0f;
+    system->tension = 0.0f;
+    for (size_t i = 0; i < system->faction_count; i++) {
+        system->counted_power[i] = system->factions[i].power;
+        system->total_power += system->factions[i].power;
+    }
+    for (size_t e = 0; e < system->rivalry_count; e++) {
+        const civ_faction_rivalry_t* edge = &system->rivalries[e];
+        system->tension += edge->intensity * system->counted_power[edge->faction[0]] *
+                           system->counted_power[edge->faction[1]];
+    }
+    find_dominant(system);
+    system->updates_since_resync = 0;
+    settle_stability(system);
 }
 
 civ_political_faction_t* civ_faction_create(const char* id, const char* name, civ_faction_ideology_t ideology) {
@@ -75,17 +190,34 @@ civ_result_t civ_faction_system_add(civ_faction_system_t* system, civ_political_
         return result;
     }
     
-    if (system->faction_count >= system->faction_capacity) {
-        system->faction_capacity *= 2;
-        system->factions = (civ_political_faction_t*)CIV_REALLOC(system->factions,
-                                                                system->faction_capacity * sizeof(civ_political_faction_t));
+    if (system->faction_count >= system->faction_capacity || !system->factions) {
+        size_t capacity = system->faction_capacity ? system->faction_capacity * 2 : 16;
+        civ_political_faction_t* factions = (civ_political_faction_t*)CIV_REALLOC(system->factions,
+                                                                                capacity * sizeof(civ_political_faction_t));
+        if (factions) system->factions = factions;
+        civ_float_t* counted = (civ_float_t*)CIV_REALLOC(system->counted_power, capacity * sizeof(civ_float_t));
+        if (counted) system->counted_power = counted;
+        int32_t* head = (int32_t*)CIV_REALLOC(system->rivalry_head, capacity * sizeof(int32_t));
+        if (head) system->rivalry_head = head;
+        uint8_t* awake = (uint8_t*)CIV_REALLOC(system->awake, capacity * sizeof(uint8_t));
+        if (awake) system->awake = awake;
+        uint32_t* active = (uint32_t*)CIV_REALLOC(system->active, capacity * sizeof(uint32_t));
+        if (active) system->active = active;
+        if (!factions || !counted || !head || !awake || !active) {
+            result.error = CIV_ERROR_OUT_OF_MEMORY;
+            return result;
+        }
+        system->faction_capacity = capacity;
     }
     
-    if (system->factions) {
-        system->factions[system->faction_count++] = *faction;
-    } else {
-        result.error = CIV_ERROR_OUT_OF_MEMORY;
-    }
+    size_t index = system->faction_count++;
+    system->factions[index] = *faction;
+    system->counted_power[index] = 0.0f;
+    system->rivalry_head[index] = -1;
+    system->awake[index] = 0;
+    wake(system, index);
+    push_power(system, index, faction->power);
+    settle_stability(system);
     
     return result;
 }
@@ -110,8 +242,10 @@ civ_result_t civ_faction_system_update(civ_faction_system_t* system, civ_float_t
         return result;
     }
     
-    /* Update faction dynamics */
-    for (size_t i = 0; i < system->faction_count; i++) {
+    /* Update the dynamics of awake factions; settled ones go to rest */
+    size_t kept = 0;
+    for (size_t k = 0; k < system->active_count; k++) {
+        size_t i = system->active[k];
         civ_political_faction_t* faction = &system->factions[i];
         
         /* Power changes based on support and influence */
@@ -121,6 +255,23 @@ civ_result_t civ_faction_system_update(civ_faction_system_t* system, civ_float_t
         /* Influence changes based on power */
         civ_float_t influence_change = (faction->power - faction->influence) * time_delta * 0.05f;
         faction->influence = CLAMP(faction->influence + influence_change, 0.0f, 1.0f);
+        
+        push_power(system, i, faction->power);
+        
+        if (fabs(power_change) < CIV_FACTION_REST_EPSILON &&
+            fabs(influence_change) < CIV_FACTION_REST_EPSILON) {
+            system->awake[i] = 0;
+        } else {
+            system->active[kept++] = (uint32_t)i;
+        }
+    }
+    system->active_count = kept;
+    
+    /* Deltas drift from the exact sums; recount now and then */
+    if (++system->updates_since_resync >= CIV_FACTION_RESYNC_INTERVAL) {
+        civ_faction_system_resync(system);
+    } else {
+        settle_stability(system);
     }
     
     return result;
@@ -128,22 +279,98 @@ civ_result_t civ_faction_system_update(civ_faction_system_t* system, civ_float_t
 
 civ_float_t civ_faction_system_calculate_stability(const civ_faction_system_t* system) {
     if (!system || system->faction_count == 0) return 1.0f;
+    return system->stability;
+}
+
+civ_result_t civ_faction_system_set_support(civ_faction_system_t* system, size_t faction,
+                                            civ_float_t support) {
+    if (!system)
+        return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null faction system"};
+    if (faction >= system->faction_count)
+        return (civ_result_t){CIV_ERROR_NOT_FOUND, "Unknown faction"};
     
-    /* Calculate stability based on faction balance */
-    civ_float_t total_power = 0.0f;
-    civ_float_t max_power = 0.0f;
+    system->factions[faction].support = CLAMP(support, 0.0f, 1.0f);
+    wake(system, faction);
+    return (civ_result_t){CIV_OK, NULL};
+}
+
+civ_result_t civ_faction_system_touch(civ_faction_system_t* system, size_t faction) {
+    if (!system)
+        return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null faction system"};
+    if (faction >= system->faction_count)
+        return (civ_result_t){CIV_ERROR_NOT_FOUND, "Unknown faction"};
     
-    for (size_t i = 0; i < system->faction_count; i++) {
-        total_power += system->factions[i].power;
-        if (system->factions[i].power > max_power) {
-            max_power = system->factions[i].power;
+    push_power(system, faction, system->factions[faction].power);
+    wake(system, faction);
+    settle_stability(system);
+    return (civ_result_t){CIV_OK, NULL};
+}
+
+static int32_t find_rivalry(const civ_faction_system_t* system, size_t a, size_t b) {
+    for (int32_t e = system->rivalry_head[a]; e >= 0;) {
+        const civ_faction_rivalry_t* edge = &system->rivalries[e];
+        int end = edge->faction[0] == (int32_t)a ? 0 : 1;
+        if (edge->faction[1 - end] == (int32_t)b) return e;
+        e = edge->next[end];
+    }
+    return -1;
+}
+
+civ_result_t civ_faction_system_set_rivalry(civ_faction_system_t* system, size_t a, size_t b,
+                                            civ_float_t intensity) {
+    if (!system)
+        return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null faction system"};
+    if (a >= system->faction_count || b >= system->faction_count)
+        return (civ_result_t){CIV_ERROR_NOT_FOUND, "Unknown faction"};
+    if (a == b)
+        return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "A faction cannot rival itself"};
+    
+    intensity = CLAMP(intensity, 0.0f, 1.0f);
+    int32_t e = find_rivalry(system, a, b);
+    if (e < 0) {
+        if (intensity == 0.0f) return (civ_result_t){CIV_OK, NULL};
+        if (system->rivalry_count >= system->rivalry_capacity) {
+            size_t capacity = system->rivalry_capacity ? system->rivalry_capacity * 2 : 16;
+            civ_faction_rivalry_t* rivalries = (civ_faction_rivalry_t*)CIV_REALLOC(system->rivalries,
+                                                                                  capacity * sizeof(civ_faction_rivalry_t));
+            if (!rivalries)
+                return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Failed to grow rivalries"};
+            system->rivalries = rivalries;
+            system->rivalry_capacity = capacity;
         }
+        e = (int32_t)system->rivalry_count++;
+        civ_faction_rivalry_t* edge = &system->rivalries[e];
+        edge->faction[0] = (int32_t)a;
+        edge->faction[1] = (int32_t)b;
+        edge->next[0] = system->rivalry_head[a];
+        edge->next[1] = system->rivalry_head[b];
+        edge->intensity = 0.0f;
+        system->rivalry_head[a] = e;
+        system->rivalry_head[b] = e;
     }
     
-    if (total_power == 0.0f) return 1.0f;
+    civ_faction_rivalry_t* edge = &system->rivalries[e];
+    civ_float_t before = edge->intensity;
+    if (before == intensity) return (civ_result_t){CIV_OK, NULL};
     
-    /* Stability is higher when power is more evenly distributed */
-    civ_float_t balance = 1.0f - (max_power / total_power);
-    return CLAMP(balance, 0.0f, 1.0f);
+    edge->intensity = intensity;
+    system->tension += (intensity - before) * system->counted_power[a] * system->counted_power[b];
+    record_change(system, CIV_FACTION_CHANGE_RIVALRY, (int32_t)a, (int32_t)b, before, intensity);
+    wake(system, a);
+    wake(system, b);
+    settle_stability(system);
+    return (civ_result_t){CIV_OK, NULL};
+}
+
+civ_float_t civ_faction_system_rivalry(const civ_faction_system_t* system, size_t a, size_t b) {
+    if (!system || a >= system->faction_count || b >= system->faction_count) return 0.0f;
+    int32_t e = find_rivalry(system, a, b);
+    return e >= 0 ? system->rivalries[e].intensity : 0.0f;
+}
+
+const civ_faction_change_t* civ_faction_system_change(const civ_faction_system_t* system,
+                                                      size_t age) {
+    if (!system || age >= system->change_total || age >= CIV_FACTION_CHANGE_HISTORY) return NULL;
+    return &system->changes[(system->change_total - 1 - age) % CIV_FACTION_CHANGE_HISTORY];
 }
 
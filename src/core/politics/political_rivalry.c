@@ -5,6 +5,7 @@
 
 #include "core/politics/political_rivalry.h"
 #include "common.h"
+#include "utils/rng.h"
 #include <string.h>
 
 void civ_rivalry_init_rival(civ_political_rival_t *rival, const char *name) {
@@ -67,7 +68,7 @@ civ_result_t civ_rivalry_apply_suppression(civ_suppression_level_t level,
     break;
   case CIV_SUP_ARRESTS:
     target->influence *= 0.5f;
-    target->is_active = (rand() % 100 > 30);
+    target->is_active = (civ_rand() % 100 > 30);
     break;
   case CIV_SUP_ELIMINATION:
     target->is_active = false;
@@ -0,0 +1,410 @@
+/**
+ * @file epidemic.c
+ * @brief Implementation of the metapopulation epidemic model
+ */
+
+#include "core/population/epidemic.h"
+#include "common.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+civ_epidemic_system_t *civ_epidemic_system_create(void) {
+  civ_epidemic_system_t *system =
+      (civ_epidemic_system_t *)CIV_CALLOC(1, sizeof(civ_epidemic_system_t));
+  if (!system)
+    civ_log(CIV_LOG_ERROR, "Failed to allocate epidemic system");
+  return system;
+}
+
+static void free_disease(civ_epidemic_t *d) {
+  CIV_FREE(d->s);
+  CIV_FREE(d->e);
+  CIV_FREE(d->i);
+  CIV_FREE(d->r);
+  CIV_FREE(d->active);
+  CIV_FREE(d->in_active);
+}
+
+void civ_epidemic_system_destroy(civ_epidemic_system_t *system) {
+  if (!system)
+    return;
+  for (size_t d = 0; d < system->disease_count; d++)
+    free_disease(&system->diseases[d]);
+  CIV_FREE(system->in_visit);
+  CIV_FREE(system->visit);
+  CIV_FREE(system->vs);
+  CIV_FREE(system->ve);
+  CIV_FREE(system->vi);
+  CIV_FREE(system->vr);
+  CIV_FREE(system->vp);
+  CIV_FREE(system->dead);
+  CIV_FREE(system);
+}
+
+/* Grow *p from old to cap entries, the new ones set to fill */
+static bool grow_shares(float **p, uint32_t old, uint32_t cap, float fill) {
+  float *grown = (float *)CIV_REALLOC(*p, cap * sizeof(float));
+  if (!grown)
+    return false;
+  for (uint32_t n = old; n < cap; n++)
+    grown[n] = fill;
+  *p = grown;
+  return true;
+}
+
+static bool grow_bits(uint64_t **p, uint32_t old, uint32_t words) {
+  uint64_t *grown = (uint64_t *)CIV_REALLOC(*p, words * sizeof(uint64_t));
+  if (!grown)
+    return false;
+  memset(grown + old, 0, (words - old) * sizeof(uint64_t));
+  *p = grown;
+  return true;
+}
+
+static bool grow_disease(civ_epidemic_t *d, uint32_t old, uint32_t cap,
+                         uint32_t old_words, uint32_t words) {
+  return grow_shares(&d->s, old, cap, 1.0f) &&
+         grow_shares(&d->e, old, cap, 0.0f) &&
+         grow_shares(&d->i, old, cap, 0.0f) &&
+         grow_shares(&d->r, old, cap, 0.0f) &&
+         grow_bits(&d->in_active, old_words, words);
+}
+
+static bool reserve_nodes(civ_epidemic_system_t *system, uint32_t count) {
+  if (count <= system->node_capacity)
+    return true;
+  uint32_t cap = system->node_capacity ? system->node_capacity : 64;
+  while (cap < count)
+    cap *= 2;
+  uint32_t words = (cap + 63) / 64;
+  for (size_t d = 0; d < system->disease_count; d++)
+    if (!grow_disease(&system->diseases[d], system->node_capacity, cap,
+                      system->words, words))
+      return false;
+  if (!grow_bits(&system->in_visit, system->words, words))
+    return false;
+  system->node_capacity = cap;
+  system->words = words;
+  return true;
+}
+
+static bool has_bit(const uint64_t *bits, uint32_t node) {
+  return (bits[node >> 6] >> (node & 63)) & 1u;
+}
+
+static void set_bit(uint64_t *bits, uint32_t node) {
+  bits[node >> 6] |= 1ull << (node & 63);
+}
+
+static void clear_bit(uint64_t *bits, uint32_t node) {
+  bits[node >> 6] &= ~(1ull << (node & 63));
+}
+
+static bool reserve_active(civ_epidemic_t *d, uint32_t count) {
+  if (count <= d->active_capacity)
+    return true;
+  uint32_t cap = d->active_capacity ? d->active_capacity : 64;
+  while (cap < count)
+    cap *= 2;
+  uint32_t *grown = (uint32_t *)CIV_REALLOC(d->active, cap * sizeof(uint32_t));
+  if (!grown)
+    return false;
+  d->active = grown;
+  d->active_capacity = cap;
+  return true;
+}
+
+static void activate(civ_epidemic_t *d, uint32_t node) {
+  if (has_bit(d->in_active, node) || !reserve_active(d, d->active_count + 1))
+    return;
+  set_bit(d->in_active, node);
+  d->active[d->active_count++] = node;
+}
+
+int32_t civ_epidemic_define(civ_epidemic_system_t *system, const char *name,
+                            civ_float_t beta, civ_float_t incubation_days,
+                            civ_float_t infectious_days, civ_float_t mortality,
+                            civ_float_t travel) {
+  if (!system || system->disease_count >= CIV_EPIDEMIC_MAX_DISEASES)
+    return -1;
+  civ_epidemic_t *d = &system->diseases[system->disease_count];
+  memset(d, 0, sizeof(*d));
+  strncpy(d->name, name ? name : "Disease", STRING_MEDIUM_LEN - 1);
+  d->beta = (float)MAX(beta, 0.0);
+  d->incubation_days = (float)MAX(incubation_days, 0.0);
+  d->infectious_days = (float)MAX(infectious_days, 0.1);
+  d->mortality = (float)CLAMP(mortality, 0.0, 1.0);
+  d->travel = (float)MAX(travel, 0.0);
+  if (system->node_capacity > 0 &&
+      !grow_disease(d, 0, system->node_capacity, 0, system->words)) {
+    free_disease(d);
+    return -1;
+  }
+  return (int32_t)system->disease_count++;
+}
+
+civ_result_t civ_epidemic_seed(civ_epidemic_system_t *system, size_t disease,
+                               uint32_t node, civ_float_t share) {
+  if (!system)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null pointer"};
+  if (disease >= system->disease_count)
+    return (civ_result_t){CIV_ERROR_NOT_FOUND, "Unknown disease"};
+  if (!reserve_nodes(system, node + 1))
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
+  if (node >= system->node_count)
+    system->node_count = node + 1;
+
+  civ_epidemic_t *d = &system->diseases[disease];
+  float moved = d->s[node] * (float)CLAMP(share, 0.0, 1.0);
+  d->s[node] -= moved;
+  d->i[node] += moved;
+  if (d->e[node] + d->i[node] > CIV_EPIDEMIC_EXTINCT)
+    activate(d, node);
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+civ_result_t civ_epidemic_seed_at(civ_epidemic_system_t *system,
+                                  const civ_trade_network_t *net,
+                                  size_t disease, int32_t x, int32_t y,
+                                  civ_float_t share) {
+  if (!system || !net || !net->map)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null pointer"};
+  uint32_t width = (uint32_t)MAX(net->map->width, 1);
+  uint32_t best = CIV_TRADE_NO_NODE;
+  int64_t best_d2 = (int64_t)CIV_EPIDEMIC_SEED_RADIUS * CIV_EPIDEMIC_SEED_RADIUS;
+  for (uint32_t n = 0; n < net->node_count; n++) {
+    int64_t dx = (int64_t)(net->nodes[n].tile % width) - x;
+    int64_t dy = (int64_t)(net->nodes[n].tile / width) - y;
+    if (dx * dx + dy * dy <= best_d2) {
+      best_d2 = dx * dx + dy * dy;
+      best = n;
+    }
+  }
+  if (best == CIV_TRADE_NO_NODE)
+    return (civ_result_t){CIV_ERROR_NOT_FOUND, "No settlement near the seed"};
+  return civ_epidemic_seed(system, disease, best, share);
+}
+
+/* Busier routes carry more people, so more contact */
+static float mixing(const civ_trade_edge_t *e) {
+  float busy = e->capacity > 0.0f ? MIN(e->flow / e->capacity, 1.0f) : 0.0f;
+  return (1.0f + busy) * (float)CIV_EPIDEMIC_REACH_COST /
+         ((float)CIV_EPIDEMIC_REACH_COST + (float)e->cost);
+}
+
+static uint32_t degree(const civ_trade_network_t *net, uint32_t node) {
+  return net->edge_refs && node < net->node_count ? net->nodes[node].edge_count
+                                                  : 0;
+}
+
+static uint32_t other_end(const civ_trade_network_t *net, uint32_t node,
+                          uint32_t k, const civ_trade_edge_t **edge) {
+  *edge = &net->edges[net->edge_refs[net->nodes[node].first_edge + k]];
+  return (*edge)->a == node ? (*edge)->b : (*edge)->a;
+}
+
+static bool reserve_visit(civ_epidemic_system_t *system, uint32_t count) {
+  if (count <= system->visit_capacity)
+    return true;
+  uint32_t cap = system->visit_capacity ? system->visit_capacity : 256;
+  while (cap < count)
+    cap *= 2;
+  uint32_t *visit = (uint32_t *)CIV_REALLOC(system->visit, cap * sizeof(uint32_t));
+  if (!visit)
+    return false;
+  system->visit = visit;
+  float **packed[] = {&system->vs, &system->ve, &system->vi,
+                      &system->vr, &system->vp, &system->dead};
+  for (size_t k = 0; k < sizeof(packed) / sizeof(packed[0]); k++) {
+    float *grown = (float *)CIV_REALLOC(*packed[k], cap * sizeof(float));
+    if (!grown)
+      return false;
+    *packed[k] = grown;
+  }
+  system->visit_capacity = cap;
+  return true;
+}
+
+/* The outbreak's nodes and everyone next to them, each once */
+static uint32_t gather_visit(civ_epidemic_system_t *system,
+                             const civ_trade_network_t *net,
+                             const civ_epidemic_t *d) {
+  uint32_t bound = 0;
+  for (uint32_t a = 0; a < d->active_count; a++)
+    bound += 1 + degree(net, d->active[a]);
+  if (!reserve_visit(system, bound))
+    return 0;
+
+  uint32_t n = 0;
+  for (uint32_t a = 0; a < d->active_count; a++) {
+    uint32_t node = d->active[a];
+    if (!has_bit(system->in_visit, node)) {
+      set_bit(system->in_visit, node);
+      system->visit[n++] = node;
+    }
+    for (uint32_t k = 0; k < degree(net, node); k++) {
+      const civ_trade_edge_t *e;
+      uint32_t nb = other_end(net, node, k, &e);
+      if (nb < system->node_count && !has_bit(system->in_visit, nb)) {
+        set_bit(system->in_visit, nb);
+        system->visit[n++] = nb;
+      }
+    }
+  }
+  return n;
+}
+
+/* One pass over the packed compartments; no branches or indirection, so
+   it vectorizes */
+static void step_packed(civ_epidemic_system_t *system, const civ_epidemic_t *d,
+                        uint32_t n, float dt) {
+  const float beta_dt = d->beta * dt;
+  const float onset_p = d->incubation_days > 0.0f
+                            ? 1.0f - expf(-dt / d->incubation_days)
+                            : 1.0f;
+  const float resolve_p = 1.0f - expf(-dt / d->infectious_days);
+  const float mortality = d->mortality;
+  float *restrict s = system->vs;
+  float *restrict e = system->ve;
+  float *restrict i = system->vi;
+  float *restrict r = system->vr;
+  float *restrict met = system->vp; /* prevalence in, new cases out */
+  float *restrict dead = system->dead;
+
+  for (uint32_t k = 0; k < n; k++) {
+    float infect = s[k] * (1.0f - expf(-beta_dt * met[k]));
+    float exposed = e[k] + infect;
+    float onset = exposed * onset_p;
+    float resolve = i[k] * resolve_p;
+    float died = resolve * mortality;
+    float keep = 1.0f / (1.0f - died);
+    s[k] = (s[k] - infect) * keep;
+    e[k] = (exposed - onset) * keep;
+    i[k] = (i[k] + onset - resolve) * keep;
+    r[k] = (r[k] + resolve - died) * keep;
+    met[k] = infect;
+    dead[k] = died;
+  }
+}
+
+static void update_disease(civ_epidemic_system_t *system,
+                           const civ_trade_network_t *net,
+                           civ_settlement_manager_t *settlements,
+                           civ_epidemic_t *d, float dt) {
+  uint32_t n = gather_visit(system, net, d);
+  if (n == 0 || !reserve_active(d, n)) {
+    for (uint32_t k = 0; k < n; k++)
+      clear_bit(system->in_visit, system->visit[k]);
+    return;
+  }
+
+  /* Gather, with the prevalence each node meets from the start state */
+  for (uint32_t k = 0; k < n; k++) {
+    uint32_t node = system->visit[k];
+    float mixed = 0.0f, weight = 0.0f;
+    for (uint32_t j = 0; j < degree(net, node); j++) {
+      const civ_trade_edge_t *e;
+      uint32_t nb = other_end(net, node, j, &e);
+      if (nb >= system->node_count)
+        continue;
+      float w = mixing(e);
+      mixed += w * d->i[nb];
+      weight += w;
+    }
+    system->vs[k] = d->s[node];
+    system->ve[k] = d->e[node];
+    system->vi[k] = d->i[node];
+    system->vr[k] = d->r[node];
+    system->vp[k] =
+        (d->i[node] + d->travel * mixed) / (1.0f + d->travel * weight);
+  }
+
+  step_packed(system, d, n, dt);
+
+  /* Scatter; the active set is rebuilt from the visit, which holds it */
+  d->active_count = 0;
+  d->infected = 0.0f;
+  for (uint32_t k = 0; k < n; k++) {
+    uint32_t node = system->visit[k];
+    clear_bit(system->in_visit, node);
+    d->s[node] = system->vs[k];
+    d->e[node] = system->ve[k];
+    d->i[node] = system->vi[k];
+    d->r[node] = system->vr[k];
+    d->infected += system->vi[k];
+
+    if (settlements && node < settlements->settlement_count) {
+      civ_settlement_t *st = &settlements->settlements[node];
+      int64_t lost = llrint((double)system->dead[k] * (double)st->population);
+      lost = MIN(lost, st->population);
+      st->population -= lost;
+      d->deaths += lost;
+      d->cases += llrint((double)system->vp[k] * (double)st->population);
+    }
+
+    if (system->ve[k] + system->vi[k] > CIV_EPIDEMIC_EXTINCT) {
+      set_bit(d->in_active, node);
+      d->active[d->active_count++] = node;
+    } else {
+      clear_bit(d->in_active, node);
+    }
+  }
+  system->visited += n;
+}
+
+/* Nodes past count are gone: drop them from the outbreaks and clear them
+   for whatever settlement takes the index next */
+static void trim_nodes(civ_epidemic_system_t *system, uint32_t count) {
+  for (size_t di = 0; di < system->disease_count; di++) {
+    civ_epidemic_t *d = &system->diseases[di];
+    uint32_t kept = 0;
+    for (uint32_t a = 0; a < d->active_count; a++) {
+      if (d->active[a] < count)
+        d->active[kept++] = d->active[a];
+      else
+        clear_bit(d->in_active, d->active[a]);
+    }
+    d->active_count = kept;
+    for (uint32_t n = count; n < system->node_count; n++) {
+      d->s[n] = 1.0f;
+      d->e[n] = d->i[n] = d->r[n] = 0.0f;
+    }
+  }
+}
+
+void civ_epidemic_system_update(civ_epidemic_system_t *system,
+                                const civ_trade_network_t *net,
+                                civ_settlement_manager_t *settlements,
+                                civ_float_t dt) {
+  if (!system || !net || dt <= 0.0)
+    return;
+  if (net->node_count != system->node_count) {
+    if (!reserve_nodes(system, net->node_count))
+      return;
+    if (net->node_count < system->node_count)
+      trim_nodes(system, net->node_count);
+    system->node_count = net->node_count;
+  }
+
+  system->visited = 0;
+  for (size_t d = 0; d < system->disease_count; d++)
+    if (system->diseases[d].active_count > 0)
+      update_disease(system, net, settlements, &system->diseases[d], (float)dt);
+}
+
+uint32_t civ_epidemic_active_count(const civ_epidemic_system_t *system) {
+  if (!system)
+    return 0;
+  uint32_t count = 0;
+  for (size_t d = 0; d < system->disease_count; d++)
+    count += system->diseases[d].active_count;
+  return count;
+}
+
+civ_float_t civ_epidemic_prevalence(const civ_epidemic_system_t *system,
+                                    size_t disease, uint32_t node) {
+  if (!system || disease >= system->disease_count || node >= system->node_count)
+    return 0.0;
+  return (civ_float_t)system->diseases[disease].i[node];
+}
@@ -0,0 +1,218 @@
+/**
+ * @file migration.c
+ * @brief Gravity-model migration as a sparse pass over the nation links
+ */
+#include "core/population/migration.h"
+#include "common.h"
+#include "core/simulation_engine/worker_pool.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define KM_PER_DEGREE 111.0f
+#define DEG_TO_RAD    0.017453292519943295f
+
+/* How freely people cross, WAR through ALLIED */
+static const float k_openness[5] = {0.0f, 0.25f, 0.6f, 0.85f, 1.0f};
+
+civ_migration_t *civ_migration_create(void) {
+  civ_migration_t *migration = (civ_migration_t *)CIV_CALLOC(1, sizeof(civ_migration_t));
+  if (!migration) {
+    civ_log(CIV_LOG_ERROR, "Failed to allocate migration");
+    return NULL;
+  }
+  migration->rate = CIV_MIGRATION_RATE;
+  migration->max_share = CIV_MIGRATION_MAX_SHARE;
+  return migration;
+}
+
+void civ_migration_destroy(civ_migration_t *migration) {
+  if (!migration) return;
+  CIV_FREE(migration->attraction);
+  CIV_FREE(migration->diplomacy_index);
+  CIV_FREE(migration->net);
+  CIV_FREE(migration->openness);
+  CIV_FREE(migration->reverse);
+  CIV_FREE(migration->flow);
+  CIV_FREE(migration);
+}
+
+static bool reserve(civ_migration_t *m, size_t nations, size_t links) {
+  if (nations > m->nation_capacity) {
+    float *attraction = (float *)CIV_REALLOC(m->attraction, nations * sizeof(float));
+    if (!attraction) return false;
+    m->attraction = attraction;
+    int32_t *index = (int32_t *)CIV_REALLOC(m->diplomacy_index, nations * sizeof(int32_t));
+    if (!index) return false;
+    m->diplomacy_index = index;
+    int64_t *net = (int64_t *)CIV_REALLOC(m->net, nations * sizeof(int64_t));
+    if (!net) return false;
+    m->net = net;
+    m->nation_capacity = nations;
+  }
+  if (links > m->link_capacity) {
+    float *openness = (float *)CIV_REALLOC(m->openness, links * sizeof(float));
+    if (!openness) return false;
+    m->openness = openness;
+    uint32_t *reverse = (uint32_t *)CIV_REALLOC(m->reverse, links * sizeof(uint32_t));
+    if (!reverse) return false;
+    m->reverse = reverse;
+    int64_t *flow = (int64_t *)CIV_REALLOC(m->flow, links * sizeof(int64_t));
+    if (!flow) return false;
+    m->flow = flow;
+    m->link_capacity = links;
+  }
+  return true;
+}
+
+/* Wage against the mean, stability, food, and war */
+static float attraction(const civ_nation_t *n, float mean_wage, bool at_war) {
+  float wage = mean_wage > 0.0f ? n->economy.avg_wage / mean_wage : 1.0f;
+  wage = CLAMP(wage, 0.1f, 10.0f);
+  float stability = n->government ? CLAMP(n->government->stability, 0.0f, 1.0f) : 0.5f;
+  float food = n->economy.food_consumption > 0.0f
+                   ? n->economy.food_production / n->economy.food_consumption
+                   : 1.0f;
+  food = CLAMP(food, 0.3f, 1.0f);
+  return wage * (0.25f + 0.75f * stability) * food * (at_war ? 0.6f : 1.0f);
+}
+
+/* Position of target in row's sorted adjacency */
+static uint32_t find_link(const civ_tech_diffusion_t *links, uint32_t row,
+                          uint32_t target) {
+  uint32_t lo = links->adj_start[row], hi = links->adj_start[row + 1];
+  while (lo < hi) {
+    uint32_t mid = lo + (hi - lo) / 2;
+    if (links->adj_target[mid] < target)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+typedef struct {
+  civ_migration_t *m;
+  const civ_nation_manager_t *nm;
+  const civ_tech_diffusion_t *links;
+  civ_float_t time_delta;
+} pass_ctx_t;
+
+/* Link e's draw on row i's people, before the rate and the cap; 0 unless
+   the target pulls harder */
+static double link_pull(const pass_ctx_t *c, uint32_t i, uint32_t e) {
+  const civ_migration_t *m = c->m;
+  const civ_tech_diffusion_t *g = c->links;
+  uint32_t j = g->adj_target[e];
+  float a = m->attraction[i], b = m->attraction[j];
+  if (a <= 0.0f || b <= a || m->openness[e] <= 0.0f) return 0.0;
+  const civ_nation_t *from = &c->nm->nations[i], *to = &c->nm->nations[j];
+  float dx = fabsf(to->capital_lon - from->capital_lon);
+  if (dx > 180.0f) dx = 360.0f - dx;
+  dx *= cosf(0.5f * (from->capital_lat + to->capital_lat) * DEG_TO_RAD);
+  float dy = to->capital_lat - from->capital_lat;
+  float km = sqrtf(dx * dx + dy * dy) * KM_PER_DEGREE;
+  float pull = MIN(b / a - 1.0f, 2.0f);
+  return MIN(g->adj_weight[e], 1.0f) * m->openness[e] * pull /
+         (1.0f + km / CIV_MIGRATION_DISTANCE_KM);
+}
+
+/* Row i's outflow along each of its links, capped and in whole people */
+static void outflow_row(void *arg, int i) {
+  pass_ctx_t *c = (pass_ctx_t *)arg;
+  civ_migration_t *m = c->m;
+  const civ_tech_diffusion_t *g = c->links;
+  uint32_t begin = g->adj_start[i], end = g->adj_start[i + 1];
+  int64_t population = c->nm->nations[i].population;
+  double people = population > 0 ? (double)population : 0.0;
+
+  double total = 0.0;
+  for (uint32_t e = begin; e < end; e++) {
+    m->flow[e] = 0;
+    if (people > 0.0) total += link_pull(c, (uint32_t)i, e);
+  }
+  if (total <= 0.0) return;
+
+  double base = m->rate * c->time_delta * people;
+  double cap = m->max_share * c->time_delta * people;
+  double scale = base * total > cap ? cap / total : base;
+  for (uint32_t e = begin; e < end; e++)
+    m->flow[e] = (int64_t)floor(link_pull(c, (uint32_t)i, e) * scale);
+}
+
+/* Row i's arrivals, through the reverse links, less its departures */
+static void net_row(void *arg, int i) {
+  pass_ctx_t *c = (pass_ctx_t *)arg;
+  const civ_migration_t *m = c->m;
+  const civ_tech_diffusion_t *g = c->links;
+  int64_t net = 0;
+  for (uint32_t e = g->adj_start[i]; e < g->adj_start[i + 1]; e++)
+    net += m->flow[m->reverse[e]] - m->flow[e];
+  m->net[i] = net;
+}
+
+civ_result_t civ_migration_process(civ_migration_t *migration,
+                                   civ_nation_manager_t *nations,
+                                   const civ_tech_diffusion_t *links,
+                                   const civ_diplomacy_system_t *diplomacy,
+                                   civ_population_manager_t *player_population,
+                                   struct civ_worker_pool *pool,
+                                   civ_float_t time_delta) {
+  civ_result_t result = {CIV_OK, NULL};
+  if (!migration || !nations || !links) {
+    result.error = CIV_ERROR_NULL_POINTER;
+    return result;
+  }
+  migration->moved = 0;
+  size_t rows = (size_t)(nations->count > 0 ? nations->count : 0);
+  if (rows < 2 || links->linked_nations != rows || links->adj_count == 0 ||
+      time_delta <= 0.0)
+    return result;
+  if (!reserve(migration, rows, links->adj_count)) {
+    result.error = CIV_ERROR_OUT_OF_MEMORY;
+    return result;
+  }
+
+  /* Openness per link, and who is at war with a neighbour */
+  civ_migration_t *m = migration;
+  double wage_sum = 0.0;
+  for (size_t i = 0; i < rows; i++) {
+    m->diplomacy_index[i] =
+        diplomacy ? civ_diplomacy_nation_index(diplomacy, nations->nations[i].id) : -1;
+    wage_sum += nations->nations[i].economy.avg_wage;
+  }
+  float mean_wage = (float)(wage_sum / (double)rows);
+  for (size_t i = 0; i < rows; i++) {
+    bool at_war = false;
+    for (uint32_t e = links->adj_start[i]; e < links->adj_start[i + 1]; e++) {
+      uint32_t j = links->adj_target[e];
+      int level = CIV_RELATION_LEVEL_NEUTRAL;
+      civ_relation_id_t id = diplomacy ? civ_diplomacy_relation_between(
+                                             diplomacy, m->diplomacy_index[i],
+                                             m->diplomacy_index[j])
+                                       : CIV_RELATION_NONE;
+      if (id != CIV_RELATION_NONE) level = diplomacy->rel.relation_level[id];
+      level = CLAMP(level, CIV_RELATION_LEVEL_WAR, CIV_RELATION_LEVEL_ALLIED);
+      m->openness[e] = k_openness[level - CIV_RELATION_LEVEL_WAR];
+      at_war |= level == CIV_RELATION_LEVEL_WAR;
+      /* The graph is symmetric, so the pair is always in j's row */
+      m->reverse[e] = find_link(links, j, (uint32_t)i);
+    }
+    m->attraction[i] = attraction(&nations->nations[i], mean_wage, at_war);
+  }
+
+  pass_ctx_t ctx = {m, nations, links, time_delta};
+  civ_worker_pool_parallel_for(pool, (int)rows, outflow_row, &ctx);
+  civ_worker_pool_parallel_for(pool, (int)rows, net_row, &ctx);
+
+  for (size_t i = 0; i < rows; i++) {
+    civ_nation_t *n = &nations->nations[i];
+    int64_t net = m->net[i];
+    if (net < 0) m->moved -= net;
+    if (net == 0) continue;
+    n->population += net;
+    if (player_population && (int)i == nations->player_nation_index)
+      civ_population_manager_migrate(player_population, (civ_float_t)net);
+  }
+  return result;
+}
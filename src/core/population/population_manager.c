@@ -4,130 +4,403 @@
  */
 
 #include "core/population/population_manager.h"
+#include "core/simulation_engine/worker_pool.h"
 #include "common.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CIV_COHORT_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CIV_COHORT_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define CIV_COHORT_NEON 1
+#endif
+
+#define REGION_BLOCK   64   /* regions per update job */
+#define MIGRATION_RATE 0.01 /* share leaving a region with no pull, per year */
+#define DEFAULT_REGION "national"
+
+/* Deaths per person per year */
+static const civ_float_t k_mortality[CIV_COHORT_COUNT] = {
+    0.0040, 0.0005, 0.0005, 0.0010, 0.0012, 0.0014, 0.0017, 0.0022,
+    0.0030, 0.0045, 0.0068, 0.0100, 0.0160, 0.0250, 0.0400, 0.1000};
+
+/* Births per person (half of those per woman) per year; 2.6 per woman */
+static const civ_float_t k_fertility[CIV_COHORT_COUNT] = {
+    0.0, 0.0, 0.0, 0.015, 0.070, 0.080, 0.060, 0.030,
+    0.008, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+/* Who moves, relative to young adults */
+static const civ_float_t k_mobility[CIV_COHORT_COUNT] = {
+    0.5, 0.5, 0.5, 1.0, 1.0, 1.0, 1.0, 1.0,
+    0.5, 0.5, 0.5, 0.5, 0.5, 0.2, 0.2, 0.2};
+
+/* Share of a new region in each group */
+static const civ_float_t k_pyramid[CIV_COHORT_COUNT] = {
+    0.25 / 3, 0.25 / 3, 0.25 / 3, 0.100, 0.100, 0.090, 0.090, 0.075,
+    0.075, 0.060, 0.060, 0.035, 0.035, 0.0125, 0.010, 0.0075};
+
 civ_population_manager_t* civ_population_manager_create(void) {
     civ_population_manager_t* pm = (civ_population_manager_t*)CIV_MALLOC(sizeof(civ_population_manager_t));
     if (!pm) {
         civ_log(CIV_LOG_ERROR, "Failed to allocate population manager");
         return NULL;
     }
-    
+
     civ_population_manager_init(pm);
     return pm;
 }
 
+static void free_regions(civ_population_manager_t* pm) {
+    CIV_FREE(pm->region_ids);
+    CIV_FREE(pm->cohorts);
+    CIV_FREE(pm->attractiveness);
+    CIV_FREE(pm->mortality_scale);
+    CIV_FREE(pm->fertility_scale);
+    CIV_FREE(pm->region_total);
+    CIV_FREE(pm->region_workforce);
+    CIV_FREE(pm->region_emigrants);
+    CIV_FREE(pm->region_of);
+}
+
 void civ_population_manager_destroy(civ_population_manager_t* pm) {
     if (!pm) return;
-    
-    if (pm->demographics) {
-        civ_demographics_destroy(pm->demographics);
-    }
-    
-    if (pm->region_ids) {
-        for (size_t i = 0; i < pm->region_count; i++) {
-            CIV_FREE(pm->region_ids[i]);
-        }
-        CIV_FREE(pm->region_ids);
-    }
-    
+    free_regions(pm);
     CIV_FREE(pm);
 }
 
 void civ_population_manager_init(civ_population_manager_t* pm) {
     if (!pm) return;
-    
+
     memset(pm, 0, sizeof(civ_population_manager_t));
-    
-    pm->birth_rate = 0.025f;  /* 2.5% per year */
-    pm->death_rate = 0.015f;  /* 1.5% per year */
-    pm->migration_rate = 0.0f;
-    pm->growth_rate = pm->birth_rate - pm->death_rate;
-    
+
     pm->education_quality = 0.5f;
     pm->health_index = 0.6f;
+    pm->air_quality = 1.0f;
     pm->satisfaction = 0.5f;
-    
-    /* Initialize default demographics */
-    pm->demographics = civ_demographics_create(1000);
-    
-    pm->region_capacity = 10;
-    pm->region_ids = (char**)CIV_CALLOC(pm->region_capacity, sizeof(char*));
-}
-
-void civ_population_manager_update(civ_population_manager_t* pm, civ_float_t time_delta, 
-                                   const void* economic_conditions) {
-    if (!pm || !pm->demographics) return;
-    
-    /* Calculate births and deaths based on rates */
-    int64_t current_pop = civ_demographics_get_total(pm->demographics);
-    
-    /* Adjust rates based on economic conditions */
-    civ_float_t economic_modifier = 1.0f;
-    if (economic_conditions) {
-        /* Simplified: better economy = lower death rate, stable birth rate */
-        /* In full implementation, would extract from economic_conditions struct */
-        economic_modifier = 0.9f; /* Placeholder */
-    }
-    
-    /* Calculate vital events */
-    int32_t births = (int32_t)(current_pop * pm->birth_rate * time_delta);
-    int32_t deaths = (int32_t)(current_pop * pm->death_rate * time_delta * economic_modifier);
-    
-    /* Apply health and education modifiers */
-    civ_float_t health_modifier = 1.0f - (1.0f - pm->health_index) * 0.3f;
-    deaths = (int32_t)(deaths * health_modifier);
-    
-    civ_float_t education_modifier = 1.0f + pm->education_quality * 0.1f;
-    births = (int32_t)(births * education_modifier);
-    
-    /* Update demographics */
-    civ_demographics_update(pm->demographics, births, deaths, time_delta);
-    
-    /* Update growth rate */
-    int64_t new_pop = civ_demographics_get_total(pm->demographics);
-    if (current_pop > 0 && time_delta > 0) {
-        pm->growth_rate = ((civ_float_t)(new_pop - current_pop) / (civ_float_t)current_pop) / time_delta;
-    }
-}
-
-void civ_population_manager_initialize_region(civ_population_manager_t* pm, const char* region_id, 
+
+    /* One region until callers add their own */
+    civ_population_manager_initialize_region(pm, DEFAULT_REGION, 1000);
+}
+
+/* ── Regions ───────────────────────────────────────────────────────── */
+
+#define GROW_COLUMN(field, cap, n)                                            \
+    do {                                                                      \
+        void* grown = CIV_REALLOC(pm->field, (cap) * (n) * sizeof(*pm->field)); \
+        if (!grown) return false;                                             \
+        pm->field = grown;                                                    \
+    } while (0)
+
+static bool reserve_region(civ_population_manager_t* pm) {
+    if (pm->region_count < pm->region_capacity) return true;
+    size_t cap = pm->region_capacity ? pm->region_capacity * 2 : 16;
+    GROW_COLUMN(region_ids, cap, 1);
+    GROW_COLUMN(cohorts, cap, CIV_COHORT_COUNT);
+    GROW_COLUMN(attractiveness, cap, 1);
+    GROW_COLUMN(mortality_scale, cap, 1);
+    GROW_COLUMN(fertility_scale, cap, 1);
+    GROW_COLUMN(region_total, cap, 1);
+    GROW_COLUMN(region_workforce, cap, 1);
+    GROW_COLUMN(region_emigrants, cap, 1);
+    pm->region_capacity = cap;
+    return true;
+}
+
+static bool reserve_lookup(civ_population_manager_t* pm, civ_symbol_t id) {
+    if (id < pm->region_of_size) return true;
+    uint32_t size = MAX(civ_symbol_count(), id + 1);
+    int32_t* region_of = CIV_REALLOC(pm->region_of, size * sizeof(int32_t));
+    if (!region_of) return false;
+    for (uint32_t k = pm->region_of_size; k < size; k++) region_of[k] = -1;
+    pm->region_of = region_of;
+    pm->region_of_size = size;
+    return true;
+}
+
+int32_t civ_population_manager_find_region(const civ_population_manager_t* pm, const char* region_id) {
+    if (!pm || !region_id) return -1;
+    civ_symbol_t id = civ_symbol_find(region_id);
+    return id != CIV_SYMBOL_NONE && id < pm->region_of_size ? pm->region_of[id] : -1;
+}
+
+void civ_population_manager_initialize_region(civ_population_manager_t* pm, const char* region_id,
                                                int64_t initial_population) {
     if (!pm || !region_id) return;
-    
-    /* Check if region already exists */
-    for (size_t i = 0; i < pm->region_count; i++) {
-        if (strcmp(pm->region_ids[i], region_id) == 0) {
-            return; /* Region already exists */
-        }
+
+    civ_symbol_t id = civ_symbol_intern(region_id);
+    if (id == CIV_SYMBOL_NONE || !reserve_lookup(pm, id)) return;
+    if (pm->region_of[id] >= 0) return; /* Region already exists */
+    if (!reserve_region(pm)) {
+        civ_log(CIV_LOG_ERROR, "Failed to grow population regions");
+        return;
+    }
+
+    size_t r = pm->region_count++;
+    pm->region_of[id] = (int32_t)r;
+    pm->region_ids[r] = id;
+    pm->attractiveness[r] = 0.5;
+    pm->mortality_scale[r] = 1.0;
+    pm->fertility_scale[r] = 1.0;
+    pm->region_emigrants[r] = 0.0;
+
+    civ_float_t pop = (civ_float_t)MAX(initial_population, 0);
+    civ_float_t* row = pm->cohorts + r * CIV_COHORT_COUNT;
+    civ_float_t workforce = 0.0;
+    for (int a = 0; a < CIV_COHORT_COUNT; a++) {
+        row[a] = pop * k_pyramid[a];
+        if (a >= CIV_COHORT_WORK_FIRST && a <= CIV_COHORT_WORK_LAST) workforce += row[a];
+    }
+    pm->region_total[r] = pop;
+    pm->region_workforce[r] = workforce;
+    pm->total += pop;
+    pm->workforce += workforce;
+}
+
+/* ── Cohort step ───────────────────────────────────────────────────── */
+
+typedef struct {
+    civ_population_manager_t* pm;
+    civ_float_t mortality[CIV_COHORT_COUNT]; /* deaths per person over dt */
+    civ_float_t fertility[CIV_COHORT_COUNT]; /* births per person over dt */
+    civ_float_t leave[CIV_COHORT_COUNT];     /* emigrants per person, no pull */
+    civ_float_t stay[CIV_COHORT_COUNT];      /* share that keeps its group */
+    civ_float_t enter[CIV_COHORT_COUNT];     /* share of the group below that
+                                                moves up; 1 for births */
+    civ_float_t mortality_mod, fertility_mod;
+    civ_float_t* job_pool;    /* per job: emigrants by age */
+    civ_float_t* job_events;  /* per job: births, deaths, emigrants */
+    civ_float_t pool[CIV_COHORT_COUNT];
+    civ_float_t weight_total, people_total;
+} cohort_ctx_t;
+
+/* One region; buf[0] holds births and buf[1 + a] the survivors of group a,
+   so the group below is buf[a]. Lanes compute the same products in the
+   same order as the scalar loop. */
+static void advance_row(const cohort_ctx_t* c, civ_float_t* row, civ_float_t mm,
+                        civ_float_t fm, civ_float_t em, civ_float_t* pool,
+                        civ_float_t* events) {
+    civ_float_t buf[CIV_COHORT_COUNT + 1];
+    civ_float_t gone[CIV_COHORT_COUNT]; /* emigrants by group */
+    int a = 0;
+
+    /* Survival */
+#if CIV_COHORT_AVX2
+    __m256d vmm = _mm256_set1_pd(mm), one = _mm256_set1_pd(1.0), zero = _mm256_setzero_pd();
+    for (; a + 4 <= CIV_COHORT_COUNT; a += 4) {
+        __m256d keep = _mm256_max_pd(zero, _mm256_sub_pd(one, _mm256_mul_pd(_mm256_loadu_pd(c->mortality + a), vmm)));
+        _mm256_storeu_pd(buf + 1 + a, _mm256_mul_pd(_mm256_loadu_pd(row + a), keep));
+    }
+#elif CIV_COHORT_SSE2
+    __m128d vmm = _mm_set1_pd(mm), one = _mm_set1_pd(1.0), zero = _mm_setzero_pd();
+    for (; a + 2 <= CIV_COHORT_COUNT; a += 2) {
+        __m128d keep = _mm_max_pd(zero, _mm_sub_pd(one, _mm_mul_pd(_mm_loadu_pd(c->mortality + a), vmm)));
+        _mm_storeu_pd(buf + 1 + a, _mm_mul_pd(_mm_loadu_pd(row + a), keep));
+    }
+#elif CIV_COHORT_NEON
+    float64x2_t vmm = vdupq_n_f64(mm), one = vdupq_n_f64(1.0), zero = vdupq_n_f64(0.0);
+    for (; a + 2 <= CIV_COHORT_COUNT; a += 2) {
+        float64x2_t keep = vmaxq_f64(zero, vsubq_f64(one, vmulq_f64(vld1q_f64(c->mortality + a), vmm)));
+        vst1q_f64(buf + 1 + a, vmulq_f64(vld1q_f64(row + a), keep));
+    }
+#endif
+    for (; a < CIV_COHORT_COUNT; a++)
+        buf[1 + a] = row[a] * MAX(0.0, 1.0 - c->mortality[a] * mm);
+
+    /* Births and deaths are sums, kept scalar so their order is fixed */
+    civ_float_t births = 0.0, deaths = 0.0;
+    for (a = 0; a < CIV_COHORT_COUNT; a++) {
+        births += buf[1 + a] * c->fertility[a];
+        deaths += row[a] - buf[1 + a];
+    }
+    buf[0] = births * fm;
+
+    /* Aging, then emigration: next = survivors that stay + those moving up,
+       and the leavers go to the pool */
+    a = 0;
+#if CIV_COHORT_AVX2
+    __m256d vem = _mm256_set1_pd(em);
+    for (; a + 4 <= CIV_COHORT_COUNT; a += 4) {
+        __m256d n = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(buf + 1 + a), _mm256_loadu_pd(c->stay + a)),
+                                  _mm256_mul_pd(_mm256_loadu_pd(buf + a), _mm256_loadu_pd(c->enter + a)));
+        __m256d out = _mm256_mul_pd(_mm256_mul_pd(n, _mm256_loadu_pd(c->leave + a)), vem);
+        _mm256_storeu_pd(gone + a, out);
+        _mm256_storeu_pd(row + a, _mm256_sub_pd(n, out));
+        _mm256_storeu_pd(pool + a, _mm256_add_pd(_mm256_loadu_pd(pool + a), out));
+    }
+#elif CIV_COHORT_SSE2
+    __m128d vem = _mm_set1_pd(em);
+    for (; a + 2 <= CIV_COHORT_COUNT; a += 2) {
+        __m128d n = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(buf + 1 + a), _mm_loadu_pd(c->stay + a)),
+                               _mm_mul_pd(_mm_loadu_pd(buf + a), _mm_loadu_pd(c->enter + a)));
+        __m128d out = _mm_mul_pd(_mm_mul_pd(n, _mm_loadu_pd(c->leave + a)), vem);
+        _mm_storeu_pd(gone + a, out);
+        _mm_storeu_pd(row + a, _mm_sub_pd(n, out));
+        _mm_storeu_pd(pool + a, _mm_add_pd(_mm_loadu_pd(pool + a), out));
+    }
+#elif CIV_COHORT_NEON
+    float64x2_t vem = vdupq_n_f64(em);
+    for (; a + 2 <= CIV_COHORT_COUNT; a += 2) {
+        float64x2_t n = vaddq_f64(vmulq_f64(vld1q_f64(buf + 1 + a), vld1q_f64(c->stay + a)),
+                                  vmulq_f64(vld1q_f64(buf + a), vld1q_f64(c->enter + a)));
+        float64x2_t out = vmulq_f64(vmulq_f64(n, vld1q_f64(c->leave + a)), vem);
+        vst1q_f64(gone + a, out);
+        vst1q_f64(row + a, vsubq_f64(n, out));
+        vst1q_f64(pool + a, vaddq_f64(vld1q_f64(pool + a), out));
+    }
+#endif
+    for (; a < CIV_COHORT_COUNT; a++) {
+        civ_float_t n = buf[1 + a] * c->stay[a] + buf[a] * c->enter[a];
+        civ_float_t out = n * c->leave[a] * em;
+        gone[a] = out;
+        row[a] = n - out;
+        pool[a] += out;
+    }
+
+    civ_float_t moved = 0.0;
+    for (a = 0; a < CIV_COHORT_COUNT; a++) moved += gone[a];
+    events[0] += buf[0];
+    events[1] += deaths;
+    events[2] += moved;
+}
+
+static civ_float_t row_sum(const civ_float_t* row, int first, int last) {
+    civ_float_t s = 0.0;
+    for (int a = first; a <= last; a++) s += row[a];
+    return s;
+}
+
+static void advance_block(void* ctx, int job) {
+    cohort_ctx_t* c = (cohort_ctx_t*)ctx;
+    civ_population_manager_t* pm = c->pm;
+    size_t r0 = (size_t)job * REGION_BLOCK;
+    size_t r1 = MIN(r0 + REGION_BLOCK, pm->region_count);
+    civ_float_t* pool = c->job_pool + (size_t)job * CIV_COHORT_COUNT;
+    civ_float_t* events = c->job_events + (size_t)job * 3;
+    for (size_t r = r0; r < r1; r++) {
+        civ_float_t* row = pm->cohorts + r * CIV_COHORT_COUNT;
+        civ_float_t before = events[2];
+        advance_row(c, row, pm->mortality_scale[r] * c->mortality_mod,
+                    pm->fertility_scale[r] * c->fertility_mod,
+                    1.0 - CLAMP(pm->attractiveness[r], 0.0, 1.0), pool, events);
+        pm->region_emigrants[r] = events[2] - before;
+        pm->region_total[r] = row_sum(row, 0, CIV_COHORT_COUNT - 1);
     }
-    
-    /* Expand capacity if needed */
-    if (pm->region_count >= pm->region_capacity) {
-        pm->region_capacity *= 2;
-        pm->region_ids = (char**)CIV_REALLOC(pm->region_ids, pm->region_capacity * sizeof(char*));
+}
+
+/* Migrants settle by attractiveness x population, or by population alone
+   when nowhere pulls */
+static void settle_block(void* ctx, int job) {
+    cohort_ctx_t* c = (cohort_ctx_t*)ctx;
+    civ_population_manager_t* pm = c->pm;
+    size_t r0 = (size_t)job * REGION_BLOCK;
+    size_t r1 = MIN(r0 + REGION_BLOCK, pm->region_count);
+    for (size_t r = r0; r < r1; r++) {
+        civ_float_t* row = pm->cohorts + r * CIV_COHORT_COUNT;
+        civ_float_t share = 0.0;
+        if (c->weight_total > 0.0)
+            share = CLAMP(pm->attractiveness[r], 0.0, 1.0) * pm->region_total[r] / c->weight_total;
+        else if (c->people_total > 0.0)
+            share = pm->region_total[r] / c->people_total;
+        int a = 0;
+#if CIV_COHORT_AVX2
+        __m256d vs = _mm256_set1_pd(share);
+        for (; a + 4 <= CIV_COHORT_COUNT; a += 4)
+            _mm256_storeu_pd(row + a, _mm256_add_pd(_mm256_loadu_pd(row + a),
+                                                    _mm256_mul_pd(_mm256_loadu_pd(c->pool + a), vs)));
+#elif CIV_COHORT_SSE2
+        __m128d vs = _mm_set1_pd(share);
+        for (; a + 2 <= CIV_COHORT_COUNT; a += 2)
+            _mm_storeu_pd(row + a, _mm_add_pd(_mm_loadu_pd(row + a),
+                                              _mm_mul_pd(_mm_loadu_pd(c->pool + a), vs)));
+#elif CIV_COHORT_NEON
+        float64x2_t vs = vdupq_n_f64(share);
+        for (; a + 2 <= CIV_COHORT_COUNT; a += 2)
+            vst1q_f64(row + a, vaddq_f64(vld1q_f64(row + a), vmulq_f64(vld1q_f64(c->pool + a), vs)));
+#endif
+        for (; a < CIV_COHORT_COUNT; a++) row[a] += c->pool[a] * share;
+        pm->region_total[r] = row_sum(row, 0, CIV_COHORT_COUNT - 1);
+        pm->region_workforce[r] = row_sum(row, CIV_COHORT_WORK_FIRST, CIV_COHORT_WORK_LAST);
     }
-    
-    /* Add region */
-    size_t id_len = strlen(region_id) + 1;
-    pm->region_ids[pm->region_count] = (char*)CIV_MALLOC(id_len);
-    if (pm->region_ids[pm->region_count]) {
-        strcpy(pm->region_ids[pm->region_count], region_id);
-        pm->region_count++;
+}
+
+void civ_population_manager_update(civ_population_manager_t* pm, civ_float_t time_delta,
+                                   struct civ_worker_pool* pool) {
+    if (!pm || pm->region_count == 0 || time_delta <= 0.0) return;
+
+    int jobs = (int)((pm->region_count + REGION_BLOCK - 1) / REGION_BLOCK);
+    cohort_ctx_t c;
+    memset(&c, 0, sizeof(c));
+    c.pm = pm;
+    c.job_pool = CIV_CALLOC((size_t)jobs * CIV_COHORT_COUNT, sizeof(civ_float_t));
+    c.job_events = CIV_CALLOC((size_t)jobs * 3, sizeof(civ_float_t));
+    if (!c.job_pool || !c.job_events) {
+        CIV_FREE(c.job_pool);
+        CIV_FREE(c.job_events);
+        return;
     }
-    
-    /* Initialize demographics for this region (simplified - using main demographics) */
-    if (!pm->demographics) {
-        pm->demographics = civ_demographics_create(initial_population);
+
+    /* Poor health raises mortality; schooling lowers fertility */
+    c.mortality_mod = 1.0 + (1.0 - CLAMP(pm->health_index * pm->air_quality,
+                                         0.0, 1.0)) * 0.5;
+    c.fertility_mod = 1.0 - CLAMP(pm->education_quality, 0.0, 1.0) * 0.2;
+    civ_float_t move_up = MIN(time_delta / CIV_COHORT_YEARS, 1.0);
+    for (int a = 0; a < CIV_COHORT_COUNT; a++) {
+        c.mortality[a] = k_mortality[a] * time_delta;
+        c.fertility[a] = k_fertility[a] * time_delta;
+        c.leave[a] = MIN(MIGRATION_RATE * k_mobility[a] * time_delta, 1.0);
+        c.stay[a] = a + 1 < CIV_COHORT_COUNT ? 1.0 - move_up : 1.0;
+        c.enter[a] = a == 0 ? 1.0 : move_up;
+    }
+
+    civ_float_t before = pm->total;
+    civ_worker_pool_parallel_for(pool, jobs, advance_block, &c);
+
+    /* Pool the emigrants and weigh destinations, in region order */
+    civ_float_t events[3] = {0.0, 0.0, 0.0};
+    for (int j = 0; j < jobs; j++) {
+        for (int a = 0; a < CIV_COHORT_COUNT; a++)
+            c.pool[a] += c.job_pool[(size_t)j * CIV_COHORT_COUNT + a];
+        for (int k = 0; k < 3; k++) events[k] += c.job_events[(size_t)j * 3 + k];
+    }
+    for (size_t r = 0; r < pm->region_count; r++) {
+        c.weight_total += CLAMP(pm->attractiveness[r], 0.0, 1.0) * pm->region_total[r];
+        c.people_total += pm->region_total[r];
+    }
+    civ_worker_pool_parallel_for(pool, jobs, settle_block, &c);
+    CIV_FREE(c.job_pool);
+    CIV_FREE(c.job_events);
+
+    pm->total = 0.0;
+    pm->workforce = 0.0;
+    for (size_t r = 0; r < pm->region_count; r++) {
+        pm->total += pm->region_total[r];
+        pm->workforce += pm->region_workforce[r];
+    }
+
+    /* Crude rates over the people there were */
+    if (before > 0.0) {
+        civ_float_t per_year = 1.0 / (before * time_delta);
+        pm->birth_rate = events[0] * per_year;
+        pm->death_rate = events[1] * per_year;
+        pm->migration_rate = events[2] * per_year;
+        pm->growth_rate = (pm->total - before) * per_year;
     }
 }
 
 int64_t civ_population_manager_get_total(civ_population_manager_t* pm) {
-    if (!pm || !pm->demographics) return 0;
-    return civ_demographics_get_total(pm->demographics);
+    if (!pm) return 0;
+    return llround(pm->total);
+}
+
+int64_t civ_population_manager_get_workforce(const civ_population_manager_t* pm) {
+    if (!pm) return 0;
+    return llround(pm->workforce);
 }
 
 civ_float_t civ_population_manager_get_growth_rate(const civ_population_manager_t* pm) {
@@ -135,34 +408,85 @@ civ_float_t civ_population_manager_get_growth_rate(const civ_population_manager_
     return pm->growth_rate;
 }
 
-char* civ_population_manager_to_dict(const civ_population_manager_t* pm) {
-    if (!pm) return NULL;
-    
-    char* json = (char*)CIV_MALLOC(512);
+civ_float_t civ_population_manager_migrate(civ_population_manager_t* pm, civ_float_t people) {
+    if (!pm || pm->region_count == 0 || people == 0.0) return 0.0;
+
+    /* Movers by region and age, as in the cohort step */
+    civ_float_t mobile = 0.0;
+    for (size_t r = 0; r < pm->region_count; r++) {
+        const civ_float_t* row = pm->cohorts + r * CIV_COHORT_COUNT;
+        for (int a = 0; a < CIV_COHORT_COUNT; a++) mobile += row[a] * k_mobility[a];
+    }
+
+    civ_float_t moved = people;
+    if (people < 0.0) {
+        civ_float_t share = MIN(-people / MAX(mobile, 1e-9), 1.0);
+        moved = -share * mobile;
+        for (size_t r = 0; r < pm->region_count; r++) {
+            civ_float_t* row = pm->cohorts + r * CIV_COHORT_COUNT;
+            for (int a = 0; a < CIV_COHORT_COUNT; a++) row[a] -= row[a] * k_mobility[a] * share;
+        }
+    } else if (mobile > 0.0) {
+        civ_float_t share = people / mobile;
+        for (size_t r = 0; r < pm->region_count; r++) {
+            civ_float_t* row = pm->cohorts + r * CIV_COHORT_COUNT;
+            for (int a = 0; a < CIV_COHORT_COUNT; a++) row[a] += row[a] * k_mobility[a] * share;
+        }
+    } else {
+        /* Nobody to settle among: a standard pyramid in the first region */
+        for (int a = 0; a < CIV_COHORT_COUNT; a++) pm->cohorts[a] += people * k_pyramid[a];
+    }
+
+    pm->total = 0.0;
+    pm->workforce = 0.0;
+    for (size_t r = 0; r < pm->region_count; r++) {
+        const civ_float_t* row = pm->cohorts + r * CIV_COHORT_COUNT;
+        pm->region_total[r] = row_sum(row, 0, CIV_COHORT_COUNT - 1);
+        pm->region_workforce[r] = row_sum(row, CIV_COHORT_WORK_FIRST, CIV_COHORT_WORK_LAST);
+        pm->total += pm->region_total[r];
+        pm->workforce += pm->region_workforce[r];
+    }
+    return moved;
+}
+
+#define POPULATION_DICT_SIZE 512
+
+static char* format_dict(const civ_population_manager_t* pm, char* json) {
     if (!json) return NULL;
-    
-    int64_t total = civ_population_manager_get_total(pm);
-    snprintf(json, 512,
+
+    int64_t total = civ_population_manager_get_total((civ_population_manager_t*)pm);
+    snprintf(json, POPULATION_DICT_SIZE,
         "{\"total_population\":%lld,\"birth_rate\":%.3f,\"death_rate\":%.3f,"
-        "\"growth_rate\":%.3f,\"education_quality\":%.3f,\"health_index\":%.3f}",
+        "\"growth_rate\":%.3f,\"education_quality\":%.3f,\"health_index\":%.3f,"
+        "\"regions\":%zu}",
         (long long)total, pm->birth_rate, pm->death_rate, pm->growth_rate,
-        pm->education_quality, pm->health_index);
-    
+        pm->education_quality, pm->health_index, pm->region_count);
+
     return json;
 }
 
+char* civ_population_manager_to_dict(const civ_population_manager_t* pm) {
+    if (!pm) return NULL;
+    return format_dict(pm, (char*)CIV_MALLOC(POPULATION_DICT_SIZE));
+}
+
+char* civ_population_manager_to_dict_arena(const civ_population_manager_t* pm, civ_arena_t* arena) {
+    if (!pm) return NULL;
+    return format_dict(pm, (char*)civ_arena_push(arena, POPULATION_DICT_SIZE));
+}
+
 civ_result_t civ_population_manager_from_dict(civ_population_manager_t* pm, const char* json) {
     civ_result_t result = {CIV_OK, NULL};
-    
+
     if (!pm || !json) {
         result.error = CIV_ERROR_NULL_POINTER;
         return result;
     }
-    
+
     /* Simple JSON parsing (in production, use proper JSON library) */
     /* For now, just reinitialize */
+    free_regions(pm);
     civ_population_manager_init(pm);
-    
+
     return result;
 }
-
@@ -5,6 +5,7 @@
 
 #include "core/population/population_vitality.h"
 #include "common.h"
+#include "utils/rng.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -35,7 +36,7 @@ void civ_vitality_update(civ_population_vitality_t *vitality,
         vitality->active_outbreak.severity * 0.05f * time_delta;
 
     /* Outbreak eventually ends */
-    if (rand() % 100 < 5) {
+    if (civ_rand() % 100 < 5) {
       vitality->outbreak_present = false;
       civ_log(CIV_LOG_INFO, "Outbreak of %s has ended.",
               vitality->active_outbreak.name);
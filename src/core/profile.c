@@ -252,3 +252,165 @@ int civ_profile_list_saves(const char *profile_id, char ***out_saves) {
 
   return ctx.count;
 }
+
+/* ── Save index ───────────────────────────────────────────────────── */
+
+#define SAVE_INDEX_NAME "saves.idx"
+#define SAVE_INDEX_MAGIC 0x58495343u /* CSIX */
+#define SAVE_INDEX_VERSION 1u
+
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t count;
+  uint32_t entry_size;
+} save_index_header_t;
+
+static void build_save_index_path(const char *id, char *out_path,
+                                  size_t size) {
+  snprintf(out_path, size, "%s/%s/%s/%s", PROFILES_DIR, id,
+           PROFILE_SAVE_SLOT_DIR, SAVE_INDEX_NAME);
+}
+
+/* Entries of the profile's index; a missing or foreign file reads as empty */
+static int read_save_index(const char *profile_id,
+                           civ_save_slot_info_t **out_entries) {
+  *out_entries = NULL;
+  char path[320];
+  build_save_index_path(profile_id, path, sizeof(path));
+  SDL_IOStream *io = SDL_IOFromFile(path, "rb");
+  if (!io)
+    return 0;
+
+  save_index_header_t header;
+  civ_save_slot_info_t *entries = NULL;
+  if (SDL_ReadIO(io, &header, sizeof(header)) == sizeof(header) &&
+      header.magic == SAVE_INDEX_MAGIC &&
+      header.version == SAVE_INDEX_VERSION &&
+      header.entry_size == sizeof(civ_save_slot_info_t) && header.count > 0 &&
+      header.count <= 65536) {
+    entries = (civ_save_slot_info_t *)malloc(header.count * sizeof(*entries));
+    if (entries && SDL_ReadIO(io, entries, header.count * sizeof(*entries)) !=
+                       header.count * sizeof(*entries)) {
+      free(entries);
+      entries = NULL;
+    }
+  }
+  SDL_CloseIO(io);
+  *out_entries = entries;
+  return entries ? (int)header.count : 0;
+}
+
+bool civ_profile_slot_from_path(const char *profile_id, const char *path,
+                                char *out_slot, size_t out_slot_size) {
+  if (!profile_id || !path || !out_slot || out_slot_size == 0)
+    return false;
+  const char *name = strrchr(path, '/');
+  name = name ? name + 1 : path;
+  const char *dot = strrchr(name, '.');
+  if (!dot || strcmp(dot, ".civ") != 0 ||
+      (size_t)(dot - name) >= out_slot_size)
+    return false;
+  memcpy(out_slot, name, (size_t)(dot - name));
+  out_slot[dot - name] = '\0';
+
+  char expected[320];
+  return civ_profile_get_save_path(profile_id, out_slot, expected,
+                                   sizeof(expected)) &&
+         strcmp(expected, path) == 0;
+}
+
+bool civ_profile_update_save_index(const char *profile_id,
+                                   const civ_save_slot_info_t *info) {
+  if (!profile_id || !info || !info->slot[0])
+    return false;
+
+  civ_save_slot_info_t *entries = NULL;
+  int count = read_save_index(profile_id, &entries);
+  int at = 0;
+  while (at < count && strcmp(entries[at].slot, info->slot) != 0)
+    at++;
+  if (at == count) {
+    civ_save_slot_info_t *grown = (civ_save_slot_info_t *)realloc(
+        entries, (size_t)(count + 1) * sizeof(*entries));
+    if (!grown) {
+      free(entries);
+      return false;
+    }
+    entries = grown;
+    count++;
+  }
+  entries[at] = *info;
+  entries[at].indexed = true;
+
+  char path[320], tmp[328];
+  build_save_index_path(profile_id, path, sizeof(path));
+  snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+  ensure_profiles_dir();
+  ensure_profile_dirs(profile_id);
+
+  bool ok = false;
+  SDL_IOStream *io = SDL_IOFromFile(tmp, "wb");
+  if (io) {
+    save_index_header_t header = {SAVE_INDEX_MAGIC, SAVE_INDEX_VERSION,
+                                  (uint32_t)count,
+                                  sizeof(civ_save_slot_info_t)};
+    size_t body = (size_t)count * sizeof(*entries);
+    ok = SDL_WriteIO(io, &header, sizeof(header)) == sizeof(header) &&
+         SDL_WriteIO(io, entries, body) == body;
+    if (!SDL_CloseIO(io))
+      ok = false;
+  }
+  free(entries);
+  if (ok)
+    ok = SDL_RenamePath(tmp, path);
+  if (!ok)
+    SDL_RemovePath(tmp);
+  return ok;
+}
+
+static int compare_newest_first(const void *a, const void *b) {
+  const civ_save_slot_info_t *x = (const civ_save_slot_info_t *)a;
+  const civ_save_slot_info_t *y = (const civ_save_slot_info_t *)b;
+  if (x->timestamp != y->timestamp)
+    return x->timestamp < y->timestamp ? 1 : -1;
+  return strcmp(x->slot, y->slot);
+}
+
+int civ_profile_list_save_info(const char *profile_id,
+                               civ_save_slot_info_t **out_info) {
+  if (out_info)
+    *out_info = NULL;
+  if (!profile_id || !out_info)
+    return 0;
+
+  /* The directory listing only decides which slots exist */
+  char **slots = NULL;
+  int slot_count = civ_profile_list_saves(profile_id, &slots);
+  civ_save_slot_info_t *entries = NULL;
+  int entry_count = read_save_index(profile_id, &entries);
+
+  civ_save_slot_info_t *out = NULL;
+  if (slot_count > 0)
+    out = (civ_save_slot_info_t *)calloc((size_t)slot_count, sizeof(*out));
+  if (!out) {
+    civ_profile_free_list(slots, slot_count);
+    free(entries);
+    return 0;
+  }
+  for (int i = 0; i < slot_count; i++) {
+    int e = 0;
+    while (e < entry_count && strcmp(entries[e].slot, slots[i]) != 0)
+      e++;
+    if (e < entry_count)
+      out[i] = entries[e];
+    else
+      snprintf(out[i].slot, sizeof(out[i].slot), "%s", slots[i]);
+  }
+  civ_profile_free_list(slots, slot_count);
+  free(entries);
+
+  qsort(out, (size_t)slot_count, sizeof(*out), compare_newest_first);
+  *out_info = out;
+  return slot_count;
+}
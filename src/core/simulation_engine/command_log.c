@@ -0,0 +1,529 @@
+/**
+ * @file command_log.c
+ * @brief Deterministic command recorder and fast-forward replay
+ */
+
+#include "core/simulation_engine/command_log.h"
+#include "core/character.h"
+#include "core/game.h"
+#include "utils/io_service.h"
+#include "utils/rng.h"
+#include "utils/store_registry.h"
+#include <string.h>
+
+#define COMMAND_LOG_MAGIC   "CLOG"
+#define COMMAND_LOG_VERSION 1u
+
+/* File header; civ_command_t records follow back to back */
+typedef struct {
+  char     magic[4];
+  uint32_t version;
+  uint64_t seed;
+  double   fixed_dt;
+  uint32_t record_size;
+  uint32_t reserved;
+  char     map_path[256];
+} command_log_header_t;
+
+static civ_result_t ok_result(void) {
+  civ_result_t res = {CIV_OK, NULL};
+  return res;
+}
+
+static civ_result_t error_result(civ_error_t code, const char *msg) {
+  civ_result_t res = {code, msg};
+  return res;
+}
+
+static civ_command_log_t *log_alloc(void) {
+  civ_command_log_t *log = CIV_CALLOC(1, sizeof(*log));
+  if (!log)
+    return NULL;
+  log->capacity = 1024;
+  log->commands = CIV_MALLOC(log->capacity * sizeof(*log->commands));
+  if (!log->commands) {
+    CIV_FREE(log);
+    return NULL;
+  }
+  CIV_STORE_REGISTER("replay.commands", log, log->count, log->capacity,
+                     sizeof(civ_command_t), CIV_STORE_APPEND);
+  return log;
+}
+
+civ_command_log_t *civ_command_log_create(const char *path,
+                                          const civ_game_t *game) {
+  if (!path || !game)
+    return NULL;
+  civ_command_log_t *log = log_alloc();
+  if (!log)
+    return NULL;
+  FILE *f = fopen(path, "wb");
+  if (!f) {
+    civ_command_log_destroy(log);
+    return NULL;
+  }
+  strncpy(log->path, path, sizeof(log->path) - 1);
+  log->seed = civ_game_rng_seed(game);
+  log->fixed_dt = game->fixed_dt;
+  if (game->map_path)
+    strncpy(log->map_path, game->map_path, sizeof(log->map_path) - 1);
+
+  command_log_header_t h;
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, COMMAND_LOG_MAGIC, 4);
+  h.version = COMMAND_LOG_VERSION;
+  h.seed = log->seed;
+  h.fixed_dt = log->fixed_dt;
+  h.record_size = (uint32_t)sizeof(civ_command_t);
+  memcpy(h.map_path, log->map_path, sizeof(h.map_path));
+  bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+  if (fclose(f) != 0 || !ok) {
+    civ_command_log_destroy(log);
+    return NULL;
+  }
+  log->recording = true;
+  return log;
+}
+
+civ_command_log_t *civ_command_log_open(const char *path) {
+  if (!path)
+    return NULL;
+  FILE *f = fopen(path, "rb");
+  if (!f)
+    return NULL;
+  command_log_header_t h;
+  if (fread(&h, sizeof(h), 1, f) != 1 ||
+      memcmp(h.magic, COMMAND_LOG_MAGIC, 4) != 0 ||
+      h.version != COMMAND_LOG_VERSION ||
+      h.record_size != sizeof(civ_command_t)) {
+    fclose(f);
+    return NULL;
+  }
+  civ_command_log_t *log = log_alloc();
+  if (!log) {
+    fclose(f);
+    return NULL;
+  }
+  strncpy(log->path, path, sizeof(log->path) - 1);
+  log->seed = h.seed;
+  log->fixed_dt = (civ_float_t)h.fixed_dt;
+  memcpy(log->map_path, h.map_path, sizeof(log->map_path) - 1);
+
+  /* A record torn by a crash mid-write is dropped with the short read */
+  civ_command_t cmd;
+  while (fread(&cmd, sizeof(cmd), 1, f) == 1) {
+    if (cmd.type == CIV_CMD_NONE || cmd.type >= CIV_CMD_TYPE_COUNT)
+      break;
+    if (log->count == log->capacity) {
+      civ_command_t *grown = CIV_REALLOC(
+          log->commands, log->capacity * 2 * sizeof(*grown));
+      if (!grown)
+        break;
+      log->commands = grown;
+      log->capacity *= 2;
+    }
+    cmd.text[sizeof(cmd.text) - 1] = '\0';
+    cmd.text2[sizeof(cmd.text2) - 1] = '\0';
+    log->commands[log->count++] = cmd;
+  }
+  fclose(f);
+  log->written = log->count;
+  return log;
+}
+
+void civ_command_log_destroy(civ_command_log_t *log) {
+  if (!log)
+    return;
+  civ_store_unregister_owner(log);
+  if (log->recording) {
+    civ_command_log_flush(log);
+    /* Appends in flight report back to log */
+    civ_io_service_flush();
+  }
+  CIV_FREE(log->commands);
+  CIV_FREE(log);
+}
+
+civ_result_t civ_command_log_append(civ_command_log_t *log,
+                                    const civ_command_t *cmd) {
+  if (!log || !cmd || cmd->type == CIV_CMD_NONE ||
+      cmd->type >= CIV_CMD_TYPE_COUNT)
+    return error_result(CIV_ERROR_INVALID_ARGUMENT, "Invalid command");
+
+  /* A frame loop issues one update per frame; equal deltas in one turn
+     collapse into a count (only while the last record is still unwritten) */
+  if (cmd->type == CIV_CMD_UPDATE && log->count > log->written) {
+    civ_command_t *last = &log->commands[log->count - 1];
+    if (last->type == CIV_CMD_UPDATE && last->turn == cmd->turn &&
+        last->f == cmd->f && last->i[0] < INT32_MAX - cmd->i[0]) {
+      last->i[0] += cmd->i[0];
+      return ok_result();
+    }
+  }
+
+  if (log->count == log->capacity) {
+    civ_command_t *grown =
+        CIV_REALLOC(log->commands, log->capacity * 2 * sizeof(*grown));
+    if (!grown)
+      return error_result(CIV_ERROR_OUT_OF_MEMORY, "Command log full");
+    log->commands = grown;
+    log->capacity *= 2;
+  }
+  log->commands[log->count++] = *cmd;
+  return ok_result();
+}
+
+static void on_appended(civ_result_t result, void *user) {
+  civ_command_log_t *log = (civ_command_log_t *)user;
+  if (CIV_FAILED(result))
+    SDL_SetAtomicInt(&log->write_failed, 1);
+}
+
+civ_result_t civ_command_log_flush(civ_command_log_t *log) {
+  if (!log || !log->recording)
+    return error_result(CIV_ERROR_INVALID_STATE, "Command log not recording");
+  if (SDL_GetAtomicInt(&log->write_failed))
+    return error_result(CIV_ERROR_IO, "Command log write failed");
+  size_t pending = log->count - log->written;
+  if (pending == 0)
+    return ok_result();
+  civ_result_t r = civ_io_write_copy(
+      log->path, CIV_IO_APPEND, log->commands + log->written,
+      pending * sizeof(civ_command_t), CIV_IO_JOURNAL, on_appended, log);
+  if (CIV_FAILED(r))
+    return r;
+  log->written = log->count;
+  return ok_result();
+}
+
+void civ_command_keyframe_path(const char *log_path, int32_t turn, char *out,
+                               size_t size) {
+  snprintf(out, size, "%s.t%05d.sav", log_path ? log_path : "replay",
+           (int)turn);
+}
+
+/* ── State checksum ─────────────────────────────────────────────────── */
+
+static uint32_t fnv_mix(uint32_t h, const void *data, size_t n) {
+  const uint8_t *p = (const uint8_t *)data;
+  for (size_t i = 0; i < n; i++) {
+    h ^= p[i];
+    h *= 16777619u;
+  }
+  return h;
+}
+
+#define MIX(h, v) ((h) = fnv_mix((h), &(v), sizeof(v)))
+
+uint32_t civ_command_state_checksum(const civ_game_t *game) {
+  uint32_t h = 2166136261u;
+  if (!game)
+    return h;
+  MIX(h, game->current_turn);
+  if (game->unit_manager) {
+    const civ_unit_manager_t *um = game->unit_manager;
+    MIX(h, um->unit_count);
+    for (size_t i = 0; i < um->unit_count; i++) {
+      MIX(h, um->x[i]);
+      MIX(h, um->y[i]);
+      MIX(h, um->strength[i]);
+      MIX(h, um->units[i].unit_type);
+    }
+  }
+  if (game->settlement_manager) {
+    const civ_settlement_manager_t *sm = game->settlement_manager;
+    MIX(h, sm->settlement_count);
+    for (size_t i = 0; i < sm->settlement_count; i++) {
+      const civ_settlement_t *s = &sm->settlements[i];
+      MIX(h, s->x);
+      MIX(h, s->y);
+      MIX(h, s->attractiveness);
+      MIX(h, s->population);
+      MIX(h, s->production_type);
+      MIX(h, s->production_progress);
+    }
+  }
+  if (game->diplomacy_system)
+    MIX(h, game->diplomacy_system->treaty_count);
+  for (int i = 0; i < game->wallet.count; i++)
+    MIX(h, game->wallet.slots[i].balance);
+  MIX(h, game->global_economy.gdp);
+  return h;
+}
+
+/* ── Apply ──────────────────────────────────────────────────────────── */
+
+static civ_settlement_t *find_settlement(civ_settlement_manager_t *sm,
+                                         const char *id) {
+  if (!sm)
+    return NULL;
+  for (size_t i = 0; i < sm->settlement_count; i++) {
+    if (strcmp(sm->settlements[i].id, id) == 0)
+      return &sm->settlements[i];
+  }
+  return NULL;
+}
+
+static civ_result_t apply_political_action(civ_game_t *game, int32_t action) {
+  civ_character_t *pc = (civ_character_t *)game->player_character;
+  if (!pc)
+    return error_result(CIV_ERROR_INVALID_STATE, "No player character");
+  switch (action) {
+  case CIV_POLITICAL_JOIN_PARTY:
+    pc->political_influence += 5;
+    break;
+  case CIV_POLITICAL_DONATE:
+    if (pc->personal_wealth >= 20) {
+      pc->personal_wealth -= 20;
+      pc->political_influence += 10;
+    }
+    break;
+  case CIV_POLITICAL_APPLY_POSITION:
+    civ_role_set(&game->player_role, &civ_role_cabinet_economics,
+                 game->player_role.nation_id);
+    break;
+  case CIV_POLITICAL_PROTEST:
+    pc->reputation += 3;
+    pc->political_influence += 2;
+    break;
+  case CIV_POLITICAL_RUN_FOR_OFFICE:
+    if (pc->reputation >= 30 && pc->personal_wealth >= 50) {
+      pc->personal_wealth -= 50;
+      pc->political_influence += 15;
+    }
+    break;
+  default:
+    return error_result(CIV_ERROR_INVALID_ARGUMENT, "Unknown action");
+  }
+  return ok_result();
+}
+
+static civ_result_t apply_command(civ_game_t *game, const civ_command_t *cmd) {
+  switch ((civ_command_type_t)cmd->type) {
+  case CIV_CMD_UPDATE: {
+    civ_float_t saved = game->fixed_dt;
+    game->fixed_dt = (civ_float_t)cmd->f;
+    for (int32_t n = 0; n < cmd->i[0]; n++)
+      civ_game_update(game);
+    game->fixed_dt = saved;
+    return ok_result();
+  }
+  case CIV_CMD_END_TURN:
+    return civ_game_end_turn(game);
+  case CIV_CMD_SPAWN_UNIT:
+    if (civ_unit_manager_spawn_unit(game->unit_manager,
+                                    (civ_unit_type_t)cmd->i[0], cmd->text,
+                                    cmd->i[1], cmd->i[2], cmd->i[3]) ==
+        CIV_UNIT_HANDLE_NONE)
+      return error_result(CIV_ERROR_INVALID_STATE, "Unit spawn failed");
+    return ok_result();
+  case CIV_CMD_MOVE_UNIT: {
+    int32_t u = civ_unit_manager_find(game->unit_manager, cmd->text);
+    if (u < 0)
+      return error_result(CIV_ERROR_INVALID_STATE, "Unit not found");
+    civ_unit_manager_move_unit(game->unit_manager, (size_t)u, cmd->i[0],
+                               cmd->i[1]);
+    game->unit_manager->moved[u] = 1;
+    return ok_result();
+  }
+  case CIV_CMD_KILL_UNIT: {
+    int32_t u = civ_unit_manager_find(game->unit_manager, cmd->text);
+    if (u < 0)
+      return error_result(CIV_ERROR_INVALID_STATE, "Unit not found");
+    civ_unit_manager_kill_unit(game->unit_manager, (size_t)u);
+    return ok_result();
+  }
+  case CIV_CMD_FOUND_SETTLEMENT:
+    if (!game->settlement_manager)
+      return error_result(CIV_ERROR_INVALID_STATE, "No settlements");
+    return civ_attempt_settlement_spawn(game->settlement_manager,
+                                        (civ_float_t)cmd->i[0],
+                                        (civ_float_t)cmd->i[1]);
+  case CIV_CMD_SET_PRODUCTION: {
+    civ_settlement_t *s = find_settlement(game->settlement_manager, cmd->text);
+    if (!s)
+      return error_result(CIV_ERROR_INVALID_STATE, "Settlement not found");
+    s->is_producing = true;
+    s->production_type = (civ_unit_type_t)cmd->i[0];
+    s->production_target = (civ_float_t)cmd->f;
+    s->production_progress = 0.0f;
+    return ok_result();
+  }
+  case CIV_CMD_PROPOSE_TREATY:
+    if (!game->diplomacy_system)
+      return error_result(CIV_ERROR_INVALID_STATE, "No diplomacy");
+    return civ_diplomacy_system_propose_treaty(
+        game->diplomacy_system, cmd->text, cmd->text2,
+        (civ_treaty_type_t)cmd->i[0], cmd->i[1]);
+  case CIV_CMD_POLITICAL_ACTION:
+    return apply_political_action(game, cmd->i[0]);
+  case CIV_CMD_TURN_CHECK:
+  case CIV_CMD_KEYFRAME:
+    return ok_result(); /* markers only */
+  default:
+    return error_result(CIV_ERROR_INVALID_ARGUMENT, "Unknown command");
+  }
+}
+
+civ_result_t civ_command_apply(civ_game_t *game, const civ_command_t *cmd) {
+  if (!game || !cmd)
+    return error_result(CIV_ERROR_INVALID_ARGUMENT, "Invalid command");
+  /* Turn flow binds the systems' own streams */
+  if (cmd->type == CIV_CMD_UPDATE || cmd->type == CIV_CMD_END_TURN ||
+      cmd->type == CIV_CMD_TURN_CHECK || cmd->type == CIV_CMD_KEYFRAME)
+    return apply_command(game, cmd);
+
+  /* A player command draws from a stream of its place among the turn's
+     applied commands, so recording, replay and a seek from a keyframe roll
+     the same dice. Refused commands are not logged and do not count. */
+  civ_rng_t rng;
+  civ_rng_seed_key(&rng, civ_game_rng_seed(game), CIV_RNG_COMMAND,
+                   (uint64_t)game->current_turn, game->turn_commands);
+  civ_rng_t *prev = civ_rng_bind(&rng);
+  civ_result_t res = apply_command(game, cmd);
+  civ_rng_bind(prev);
+  if (!CIV_FAILED(res))
+    game->turn_commands++;
+  return res;
+}
+
+/* ── Replay ─────────────────────────────────────────────────────────── */
+
+/* Index just past the newest loadable keyframe in (after, to_turn]; 0 if
+   none loads */
+static size_t load_keyframe(civ_game_t *game, const civ_command_log_t *log,
+                            int32_t after, int32_t to_turn) {
+  for (size_t i = log->count; i-- > 0;) {
+    const civ_command_t *c = &log->commands[i];
+    if (c->type != CIV_CMD_KEYFRAME || c->i[0] > to_turn || c->i[0] <= after)
+      continue;
+    char path[512];
+    civ_command_keyframe_path(log->path, c->i[0], path, sizeof(path));
+    if (!CIV_FAILED(civ_game_load_state(game, path)) &&
+        game->current_turn == c->i[0])
+      return i + 1;
+  }
+  return 0;
+}
+
+/* Apply the log from index i on, skipping what the state at start_turn
+   already holds, until to_turn (when > 0) is reached */
+static void replay_from(civ_game_t *game, const civ_command_log_t *log,
+                        size_t i, int32_t to_turn, civ_replay_stats_t *stats) {
+  for (; i < log->count; i++) {
+    const civ_command_t *c = &log->commands[i];
+    if (c->type == CIV_CMD_TURN_CHECK) {
+      if (c->i[0] == game->current_turn && !stats->first_desync &&
+          (uint32_t)c->i[1] != civ_command_state_checksum(game))
+        stats->first_desync = game->current_turn;
+      continue;
+    }
+    if (c->type == CIV_CMD_KEYFRAME)
+      continue;
+    if (to_turn > 0 && game->current_turn >= to_turn)
+      break;
+    /* Commands before the start turn are already in the keyframe */
+    if (c->turn < stats->start_turn)
+      continue;
+    civ_result_t r = civ_command_apply(game, c);
+    if (CIV_FAILED(r) && !stats->first_desync)
+      stats->first_desync = game->current_turn;
+    stats->commands++;
+    if (c->type == CIV_CMD_END_TURN)
+      stats->turns++;
+  }
+}
+
+civ_result_t civ_command_replay(civ_game_t *game, const civ_command_log_t *log,
+                                int32_t to_turn, civ_replay_stats_t *stats) {
+  civ_replay_stats_t local;
+  if (!stats)
+    stats = &local;
+  memset(stats, 0, sizeof(*stats));
+  if (!game || !log)
+    return error_result(CIV_ERROR_INVALID_ARGUMENT, "Invalid replay");
+
+  size_t i =
+      to_turn > 0 ? load_keyframe(game, log, game->current_turn, to_turn) : 0;
+  stats->start_turn = game->current_turn;
+  replay_from(game, log, i, to_turn, stats);
+  return ok_result();
+}
+
+civ_result_t civ_command_seek(civ_game_t *game, const civ_command_log_t *log,
+                              int32_t turn, civ_replay_stats_t *stats) {
+  civ_replay_stats_t local;
+  if (!stats)
+    stats = &local;
+  memset(stats, 0, sizeof(*stats));
+  if (!game || !log || turn <= 0)
+    return error_result(CIV_ERROR_INVALID_ARGUMENT, "Invalid seek");
+  if (turn >= game->current_turn)
+    return civ_command_replay(game, log, turn, stats);
+
+  size_t i = load_keyframe(game, log, 0, turn);
+  if (i == 0)
+    return error_result(CIV_ERROR_INVALID_STATE, "No keyframe before turn");
+  stats->start_turn = game->current_turn;
+  replay_from(game, log, i, turn, stats);
+  return ok_result();
+}
+
+/* Replay from keyframe k (or from the game as it is for k < 0) up to the
+   next keyframe; the turn it first failed a check, 0 if none */
+static int32_t probe_interval(civ_game_t *game, const civ_command_log_t *log,
+                              const int32_t *turns, size_t count, ptrdiff_t k,
+                              civ_replay_stats_t *stats) {
+  size_t i = 0;
+  if (k >= 0 &&
+      (i = load_keyframe(game, log, turns[k] - 1, turns[k])) == 0)
+    return turns[k]; /* unreadable, so the interval cannot be cleared */
+  int32_t end = (size_t)(k + 1) < count ? turns[k + 1] : 0;
+  civ_replay_stats_t probe = {0};
+  probe.start_turn = game->current_turn;
+  replay_from(game, log, i, end, &probe);
+  stats->commands += probe.commands;
+  stats->turns += probe.turns;
+  stats->start_turn = probe.start_turn;
+  return probe.first_desync;
+}
+
+civ_result_t civ_command_bisect(civ_game_t *game, const civ_command_log_t *log,
+                                civ_replay_stats_t *stats) {
+  civ_replay_stats_t local;
+  if (!stats)
+    stats = &local;
+  memset(stats, 0, sizeof(*stats));
+  if (!game || !log)
+    return error_result(CIV_ERROR_INVALID_ARGUMENT, "Invalid bisect");
+
+  size_t count = 0;
+  for (size_t i = 0; i < log->count; i++)
+    count += log->commands[i].type == CIV_CMD_KEYFRAME;
+  int32_t *turns = CIV_MALLOC((count ? count : 1) * sizeof(int32_t));
+  if (!turns)
+    return error_result(CIV_ERROR_OUT_OF_MEMORY, "Keyframe list allocation failed");
+  count = 0;
+  for (size_t i = 0; i < log->count; i++)
+    if (log->commands[i].type == CIV_CMD_KEYFRAME)
+      turns[count++] = log->commands[i].i[0];
+
+  /* The stretch before the first keyframe needs the game as initialized,
+     so it goes first; then the first failing interval, assuming every
+     interval after it fails too */
+  int32_t desync = probe_interval(game, log, turns, count, -1, stats);
+  size_t lo = 0, hi = desync ? 0 : count;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    int32_t at = probe_interval(game, log, turns, count, (ptrdiff_t)mid, stats);
+    if (at) {
+      desync = at; /* from the interval hi ends up at */
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  stats->first_desync = desync;
+  CIV_FREE(turns);
+  return ok_result();
+}
@@ -0,0 +1,698 @@
+/**
+ * @file delta_export.c
+ * @brief Per-turn delta frames and the thread that writes them
+ */
+
+#include "core/simulation_engine/delta_export.h"
+#include "core/game.h"
+#include "core/simulation_engine/state_persistence.h"
+#include "core/world/nation.h"
+#include "core/world/owner_ids.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define FNV_OFFSET 14695981039346656037ull
+#define FNV_PRIME  1099511628211ull
+
+#define TAG(a, b, c, d)                                                        \
+  ((uint32_t)(a) | (uint32_t)(b) << 8 | (uint32_t)(c) << 16 |                  \
+   (uint32_t)(d) << 24)
+#define TAG_TURN TAG('T', 'U', 'R', 'N')
+#define TAG_MAP  TAG('M', 'A', 'P', ' ')
+#define TAG_OWNR TAG('O', 'W', 'N', 'R')
+#define TAG_TILE TAG('T', 'I', 'L', 'E')
+#define TAG_NATN TAG('N', 'A', 'T', 'N')
+#define TAG_RELN TAG('R', 'E', 'L', 'N')
+#define TAG_EVNT TAG('E', 'V', 'N', 'T')
+#define TAG_SYSN TAG('S', 'Y', 'S', 'N')
+#define TAG_TIME TAG('T', 'I', 'M', 'E')
+
+#define FLAG_LZ     0x1u
+#define TURN_RESYNC 0x1u
+#define HEADER_BYTES 20
+
+typedef struct frame {
+  struct frame *next;
+  uint8_t *body;
+  size_t size;
+} frame_t;
+
+/* NATN record of a nation, also its baseline */
+typedef struct {
+  civ_owner_index_t owner;
+  uint8_t defunct;
+  float gdp, inflation, unemployment, tax_revenue, stability, legitimacy;
+  double population;
+  int32_t land_tiles;
+} nation_rec_t;
+
+typedef struct {
+  uint8_t *data;
+  size_t size;
+  size_t capacity;
+  bool failed;
+} buf_t;
+
+struct civ_delta_export {
+  SDL_Thread    *thread;
+  SDL_Mutex     *lock;
+  SDL_Condition *job_cv;    /* signalled when a frame is queued */
+  SDL_Condition *idle_cv;   /* broadcast when the queue runs dry */
+  char          *path;
+  bool           keep_events;
+
+  /* Guarded by lock */
+  frame_t       *head, *tail;
+  size_t         queued;
+  size_t         queued_bytes;
+  bool           writing;   /* a frame is off the queue, not yet written */
+  bool           stopping;
+  civ_delta_export_stats_t stats;
+
+  /* Sim thread only: what the consumer has been sent */
+  uint32_t  sequence;
+  uint32_t  turns_pending;   /* coalesced into the next frame */
+  uint32_t  events_lost;     /* since the last frame */
+  bool      resync;
+  uint32_t  map_serial;      /* 0 = no map sent */
+  uint32_t *region_revision;
+  uint8_t  *region_sent;
+  size_t    region_count;
+  size_t    region_cursor;
+  uint32_t  owners_sent;
+  nation_rec_t *nations;
+  size_t    nation_count;
+  size_t    nation_capacity;
+  int8_t   *rel_level;
+  float    *rel_opinion;
+  float    *rel_trust;
+  size_t    relation_count;
+  civ_owner_index_t *rel_owner; /* scratch: owner of each diplomacy nation */
+  uint64_t  events_seen;     /* events_emitted as of the last frame */
+  bool      events_primed;   /* events_seen set from a first look */
+  uint64_t  systems_hash;    /* of the names sent in SYSN; 0 = none */
+  size_t    size_hint;       /* body size of the last frame */
+};
+
+/* ── Writer ─────────────────────────────────────────────────────────── */
+
+static void put_le32(uint8_t *p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+/* Header and body of one frame; false if the file took less */
+static bool write_frame(FILE *f, const frame_t *fr, uint8_t **scratch,
+                        size_t *scratch_size, size_t *stored) {
+  size_t bound = civ_lz_bound(fr->size);
+  if (*scratch_size < bound) {
+    uint8_t *grown = CIV_REALLOC(*scratch, bound);
+    if (grown) {
+      *scratch = grown;
+      *scratch_size = bound;
+    }
+  }
+  size_t packed = *scratch_size >= bound
+                      ? civ_lz_compress(fr->body, fr->size, *scratch, bound)
+                      : 0;
+  bool lz = packed > 0 && packed < fr->size;
+  const uint8_t *body = lz ? *scratch : fr->body;
+  *stored = lz ? packed : fr->size;
+
+  uint8_t header[HEADER_BYTES];
+  put_le32(header, CIV_DELTA_EXPORT_MAGIC);
+  put_le32(header + 4, CIV_DELTA_EXPORT_VERSION);
+  put_le32(header + 8, lz ? FLAG_LZ : 0);
+  put_le32(header + 12, (uint32_t)fr->size);
+  put_le32(header + 16, (uint32_t)*stored);
+  return fwrite(header, 1, sizeof(header), f) == sizeof(header) &&
+         fwrite(body, 1, *stored, f) == *stored && fflush(f) == 0;
+}
+
+static int delta_export_main(void *arg) {
+  civ_delta_export_t *x = (civ_delta_export_t *)arg;
+  /* Opened here: on a FIFO this waits for a reader, and only the writer
+     should wait */
+  FILE *f = fopen(x->path, "wb");
+  uint8_t *scratch = NULL;
+  size_t scratch_size = 0;
+  bool failed = !f;
+  for (;;) {
+    SDL_LockMutex(x->lock);
+    if (failed)
+      x->stats.failed = true;
+    x->writing = false;
+    if (!x->head)
+      SDL_BroadcastCondition(x->idle_cv);
+    while (!x->head && !x->stopping)
+      SDL_WaitCondition(x->job_cv, x->lock);
+    frame_t *fr = x->head;
+    if (!fr) {
+      SDL_UnlockMutex(x->lock);
+      break;
+    }
+    x->head = fr->next;
+    if (!x->head)
+      x->tail = NULL;
+    x->queued--;
+    x->queued_bytes -= fr->size;
+    x->writing = true;
+    SDL_UnlockMutex(x->lock);
+
+    size_t stored = 0;
+    bool written = !failed && write_frame(f, fr, &scratch, &scratch_size,
+                                          &stored);
+    failed = !written;
+    if (written) {
+      SDL_LockMutex(x->lock);
+      x->stats.frames_written++;
+      x->stats.bytes_raw += fr->size;
+      x->stats.bytes_written += HEADER_BYTES + stored;
+      SDL_UnlockMutex(x->lock);
+    }
+    CIV_FREE(fr->body);
+    CIV_FREE(fr);
+  }
+  if (f)
+    fclose(f);
+  CIV_FREE(scratch);
+  return 0;
+}
+
+civ_delta_export_t *civ_delta_export_open(const char *path, bool keep_events) {
+  if (!path || !*path)
+    return NULL;
+  civ_delta_export_t *x = CIV_CALLOC(1, sizeof(*x));
+  if (!x)
+    return NULL;
+  size_t len = strlen(path) + 1;
+  x->path = CIV_MALLOC(len);
+  if (x->path)
+    memcpy(x->path, path, len);
+  x->keep_events = keep_events;
+  x->resync = true;
+  x->lock = SDL_CreateMutex();
+  x->job_cv = SDL_CreateCondition();
+  x->idle_cv = SDL_CreateCondition();
+  if (x->path && x->lock && x->job_cv && x->idle_cv)
+    x->thread = SDL_CreateThread(delta_export_main, "civ_delta", x);
+  if (!x->thread) {
+    if (x->lock) SDL_DestroyMutex(x->lock);
+    if (x->job_cv) SDL_DestroyCondition(x->job_cv);
+    if (x->idle_cv) SDL_DestroyCondition(x->idle_cv);
+    CIV_FREE(x->path);
+    CIV_FREE(x);
+    return NULL;
+  }
+  return x;
+}
+
+void civ_delta_export_close(civ_delta_export_t *x) {
+  if (!x)
+    return;
+  SDL_LockMutex(x->lock);
+  x->stopping = true;
+  SDL_SignalCondition(x->job_cv);
+  SDL_UnlockMutex(x->lock);
+  /* The thread writes out the queue before it sees stopping */
+  SDL_WaitThread(x->thread, NULL);
+  SDL_DestroyCondition(x->job_cv);
+  SDL_DestroyCondition(x->idle_cv);
+  SDL_DestroyMutex(x->lock);
+  CIV_FREE(x->path);
+  CIV_FREE(x->region_revision);
+  CIV_FREE(x->region_sent);
+  CIV_FREE(x->nations);
+  CIV_FREE(x->rel_level);
+  CIV_FREE(x->rel_opinion);
+  CIV_FREE(x->rel_trust);
+  CIV_FREE(x->rel_owner);
+  CIV_FREE(x);
+}
+
+void civ_delta_export_drain(civ_delta_export_t *x) {
+  if (!x)
+    return;
+  SDL_LockMutex(x->lock);
+  while ((x->head || x->writing) && !x->stats.failed)
+    SDL_WaitCondition(x->idle_cv, x->lock);
+  SDL_UnlockMutex(x->lock);
+}
+
+void civ_delta_export_get_stats(const civ_delta_export_t *x,
+                                civ_delta_export_stats_t *out) {
+  if (!out)
+    return;
+  memset(out, 0, sizeof(*out));
+  if (!x)
+    return;
+  SDL_LockMutex(x->lock);
+  *out = x->stats;
+  SDL_UnlockMutex(x->lock);
+}
+
+/* ── Frame building ─────────────────────────────────────────────────── */
+
+static void put(buf_t *b, const void *src, size_t n) {
+  if (b->failed)
+    return;
+  if (b->size + n > b->capacity) {
+    size_t cap = MAX(b->capacity * 2, b->size + n);
+    uint8_t *grown = CIV_REALLOC(b->data, cap);
+    if (!grown) {
+      b->failed = true;
+      return;
+    }
+    b->data = grown;
+    b->capacity = cap;
+  }
+  memcpy(b->data + b->size, src, n);
+  b->size += n;
+}
+
+static void put_u8(buf_t *b, uint8_t v) { put(b, &v, 1); }
+
+static void put_u16(buf_t *b, uint16_t v) {
+  uint8_t p[2] = {(uint8_t)v, (uint8_t)(v >> 8)};
+  put(b, p, 2);
+}
+
+static void put_u32(buf_t *b, uint32_t v) {
+  uint8_t p[4];
+  put_le32(p, v);
+  put(b, p, 4);
+}
+
+static void put_i32(buf_t *b, int32_t v) { put_u32(b, (uint32_t)v); }
+
+static void put_f32(buf_t *b, float v) {
+  uint32_t u;
+  memcpy(&u, &v, sizeof(u));
+  put_u32(b, u);
+}
+
+static void put_f64(buf_t *b, double v) {
+  uint64_t u;
+  memcpy(&u, &v, sizeof(u));
+  put_u32(b, (uint32_t)u);
+  put_u32(b, (uint32_t)(u >> 32));
+}
+
+/* Length-prefixed string, cut at 255 bytes */
+static void put_str(buf_t *b, const char *s) {
+  size_t n = s ? MIN(strlen(s), (size_t)255) : 0;
+  put_u8(b, (uint8_t)n);
+  put(b, s, n);
+}
+
+/* Section header with its size left open; returns where it starts */
+static size_t begin_section(buf_t *b, uint32_t tag) {
+  size_t at = b->size;
+  put_u32(b, tag);
+  put_u32(b, 0);
+  return at;
+}
+
+/* Patch the section's size, or take it back out if nothing followed */
+static void end_section(buf_t *b, size_t at, bool keep_empty) {
+  if (b->failed)
+    return;
+  size_t bytes = b->size - at - 8;
+  if (bytes == 0 && !keep_empty) {
+    b->size = at;
+    return;
+  }
+  put_le32(b->data + at + 4, (uint32_t)bytes);
+}
+
+static uint64_t fnv_str(uint64_t h, const char *s) {
+  for (; *s; s++)
+    h = (h ^ (uint8_t)*s) * FNV_PRIME;
+  return (h ^ 0xffu) * FNV_PRIME; /* keeps "ab","c" apart from "a","bc" */
+}
+
+/* Forget what the consumer holds, so the next frame starts over */
+static void reset_baselines(civ_delta_export_t *x) {
+  x->resync = true;
+  x->map_serial = 0;
+  x->owners_sent = 0;
+  x->nation_count = 0;
+  x->relation_count = 0;
+  x->systems_hash = 0;
+}
+
+static void add_map(civ_delta_export_t *x, buf_t *b, const civ_map_t *map) {
+  if (!map || !map->tiles || !map->region_revision)
+    return;
+  size_t regions = (size_t)map->region_cols * map->region_rows;
+  if (x->map_serial != map->serial || x->region_count != regions) {
+    uint32_t *revs = CIV_REALLOC(x->region_revision, regions * sizeof(*revs));
+    if (revs)
+      x->region_revision = revs;
+    uint8_t *sent = CIV_REALLOC(x->region_sent, regions);
+    if (sent)
+      x->region_sent = sent;
+    if (!revs || !sent) {
+      b->failed = true;
+      return;
+    }
+    memset(sent, 0, regions);
+    x->region_count = regions;
+    x->region_cursor = 0;
+    x->map_serial = map->serial;
+    size_t at = begin_section(b, TAG_MAP);
+    put_i32(b, map->width);
+    put_i32(b, map->height);
+    put_i32(b, CIV_MAP_REGION_SIZE);
+    put_i32(b, map->region_cols);
+    put_i32(b, map->region_rows);
+    end_section(b, at, true);
+  }
+
+  /* Round robin from where the last frame stopped, so a region that
+     keeps changing cannot starve the others past the cap */
+  size_t at = begin_section(b, TAG_TILE);
+  size_t sent = 0, last = x->region_cursor;
+  for (size_t k = 0; k < regions && sent < CIV_DELTA_EXPORT_FRAME_REGIONS;
+       k++) {
+    size_t r = (x->region_cursor + k) % regions;
+    if (x->region_sent[r] && x->region_revision[r] == map->region_revision[r])
+      continue;
+    int32_t rx = (int32_t)(r % (size_t)map->region_cols);
+    int32_t ry = (int32_t)(r / (size_t)map->region_cols);
+    int32_t x0 = rx << CIV_MAP_REGION_SHIFT, y0 = ry << CIV_MAP_REGION_SHIFT;
+    int32_t w = MIN(CIV_MAP_REGION_SIZE, map->width - x0);
+    int32_t h = MIN(CIV_MAP_REGION_SIZE, map->height - y0);
+    put_i32(b, rx);
+    put_i32(b, ry);
+    put_i32(b, w);
+    put_i32(b, h);
+    /* One column of the region after the other */
+    for (int pass = 0; pass < 4; pass++) {
+      for (int32_t y = y0; y < y0 + h; y++) {
+        const civ_map_tile_t *row = map->tiles + (size_t)y * map->width + x0;
+        for (int32_t i = 0; i < w; i++) {
+          switch (pass) {
+          case 0: put_u16(b, row[i].owner_index); break;
+          case 1: put_u8(b, row[i].terrain); break;
+          case 2: put_u8(b, row[i].land_use); break;
+          default: put_u8(b, row[i].population_density); break;
+          }
+        }
+      }
+    }
+    x->region_revision[r] = map->region_revision[r];
+    x->region_sent[r] = 1;
+    last = r;
+    sent++;
+  }
+  if (sent)
+    x->region_cursor = (last + 1) % regions;
+  end_section(b, at, false);
+}
+
+static void add_owners(civ_delta_export_t *x, buf_t *b) {
+  uint32_t count = civ_owner_count();
+  if (count < x->owners_sent) {
+    /* The table was reset; every index means something new */
+    x->owners_sent = 0;
+    x->resync = true;
+  }
+  uint32_t first = MAX(x->owners_sent, 1u);
+  if (first >= count)
+    return;
+  size_t at = begin_section(b, TAG_OWNR);
+  put_u32(b, first);
+  put_u32(b, count - first);
+  for (uint32_t i = first; i < count; i++)
+    put_str(b, civ_owner_name((civ_owner_index_t)i));
+  end_section(b, at, true);
+  x->owners_sent = count;
+}
+
+static nation_rec_t nation_rec(const civ_nation_t *n) {
+  nation_rec_t r;
+  memset(&r, 0, sizeof(r)); /* padding too, for the memcmp */
+  r.owner = n->owner_index;
+  r.defunct = n->defunct ? 1 : 0;
+  r.gdp = (float)n->economy.gdp;
+  r.inflation = (float)n->economy.inflation;
+  r.unemployment = (float)n->economy.unemployment;
+  r.tax_revenue = (float)n->economy.tax_revenue;
+  r.stability = n->government ? (float)n->government->stability : NAN;
+  r.legitimacy = n->government ? (float)n->government->legitimacy : NAN;
+  r.population = (double)n->population;
+  r.land_tiles = (int32_t)n->territory.land_tiles;
+  return r;
+}
+
+static void add_nations(civ_delta_export_t *x, buf_t *b,
+                        const civ_nation_manager_t *nm) {
+  size_t count = nm ? (size_t)nm->count : 0;
+  if (count < x->nation_count) {
+    x->nation_count = 0;
+    x->resync = true;
+  }
+  if (count > x->nation_capacity) {
+    nation_rec_t *grown = CIV_REALLOC(x->nations, count * sizeof(*grown));
+    if (!grown) {
+      b->failed = true;
+      return;
+    }
+    x->nations = grown;
+    x->nation_capacity = count;
+  }
+  size_t at = begin_section(b, TAG_NATN);
+  for (size_t i = 0; i < count; i++) {
+    nation_rec_t r = nation_rec(&nm->nations[i]);
+    if (i < x->nation_count && !memcmp(&r, &x->nations[i], sizeof(r)))
+      continue;
+    x->nations[i] = r;
+    put_i32(b, (int32_t)i);
+    put_u16(b, r.owner);
+    put_u8(b, r.defunct);
+    put_f32(b, r.gdp);
+    put_f32(b, r.inflation);
+    put_f32(b, r.unemployment);
+    put_f32(b, r.tax_revenue);
+    put_f32(b, r.stability);
+    put_f32(b, r.legitimacy);
+    put_f64(b, r.population);
+    put_i32(b, r.land_tiles);
+  }
+  x->nation_count = count;
+  end_section(b, at, false);
+}
+
+static bool grow_relations(civ_delta_export_t *x, size_t count) {
+  int8_t *level = CIV_REALLOC(x->rel_level, count * sizeof(*level));
+  if (level)
+    x->rel_level = level;
+  float *opinion = CIV_REALLOC(x->rel_opinion, count * sizeof(*opinion));
+  if (opinion)
+    x->rel_opinion = opinion;
+  float *trust = CIV_REALLOC(x->rel_trust, count * sizeof(*trust));
+  if (trust)
+    x->rel_trust = trust;
+  return level && opinion && trust;
+}
+
+static void add_relations(civ_delta_export_t *x, buf_t *b,
+                          const civ_diplomacy_system_t *ds) {
+  size_t count = ds ? ds->relation_count : 0;
+  if (count < x->relation_count) {
+    /* A new table: ids name other pairs now */
+    x->relation_count = 0;
+    x->resync = true;
+  }
+  if (count == 0)
+    return;
+  if (count > x->relation_count) {
+    if (!grow_relations(x, count)) {
+      b->failed = true;
+      return;
+    }
+    /* The consumer takes a relation it was never sent as at rest */
+    for (size_t k = x->relation_count; k < count; k++) {
+      x->rel_level[k] = CIV_RELATION_LEVEL_NEUTRAL;
+      x->rel_opinion[k] = 0.0f;
+      x->rel_trust[k] = 0.5f;
+    }
+  }
+  civ_owner_index_t *owner =
+      CIV_REALLOC(x->rel_owner, MAX(ds->nation_count, (size_t)1) *
+                                    sizeof(*owner));
+  if (!owner) {
+    b->failed = true;
+    return;
+  }
+  x->rel_owner = owner;
+  for (size_t i = 0; i < ds->nation_count; i++)
+    owner[i] = civ_owner_find(ds->nation_ids[i]);
+
+  size_t at = begin_section(b, TAG_RELN);
+  size_t k = 0;
+  for (size_t j = 1; j < ds->nation_count && k < count; j++) {
+    for (size_t i = 0; i < j && k < count; i++, k++) {
+      int8_t level = ds->rel.relation_level[k];
+      float opinion = (float)ds->rel.opinion_score[k];
+      float trust = (float)ds->rel.trust[k];
+      if (level == x->rel_level[k] &&
+          fabsf(opinion - x->rel_opinion[k]) < CIV_DELTA_EXPORT_OPINION_STEP &&
+          fabsf(trust - x->rel_trust[k]) < CIV_DELTA_EXPORT_TRUST_STEP)
+        continue;
+      x->rel_level[k] = level;
+      x->rel_opinion[k] = opinion;
+      x->rel_trust[k] = trust;
+      put_u16(b, owner[i]);
+      put_u16(b, owner[j]);
+      put_u8(b, (uint8_t)level);
+      put_f32(b, opinion);
+      put_f32(b, trust);
+    }
+  }
+  x->relation_count = count;
+  end_section(b, at, false);
+}
+
+static void add_events(civ_delta_export_t *x, buf_t *b,
+                       const civ_event_manager_t *em) {
+  if (!em)
+    return;
+  if (!x->events_primed) {
+    /* What the ring holds when the stream starts is news; older events
+       were never the stream's to lose */
+    x->events_seen = em->events_emitted - em->event_count;
+    x->events_primed = true;
+  }
+  uint64_t fresh = em->events_emitted - x->events_seen;
+  if (fresh > em->event_count) {
+    /* Evicted from the ring before a frame could carry them */
+    x->events_lost += (uint32_t)(fresh - em->event_count);
+    fresh = em->event_count;
+  }
+  x->events_seen = em->events_emitted;
+  if (fresh == 0)
+    return;
+  size_t at = begin_section(b, TAG_EVNT);
+  for (size_t i = em->event_count - (size_t)fresh; i < em->event_count; i++) {
+    const civ_game_event_t *e = civ_event_manager_get_event(em, i);
+    if (!e)
+      continue;
+    put_u8(b, (uint8_t)e->type);
+    put_f32(b, (float)e->importance);
+    put_str(b, e->title);
+  }
+  end_section(b, at, false);
+}
+
+static void add_systems(civ_delta_export_t *x, buf_t *b,
+                        const civ_system_orchestrator_t *so) {
+  size_t count = so ? so->system_count : 0;
+  if (count == 0)
+    return;
+  uint64_t h = FNV_OFFSET ^ count;
+  for (size_t i = 0; i < count; i++)
+    h = fnv_str(h, so->nodes[i].status.name);
+  if (h != x->systems_hash) {
+    size_t at = begin_section(b, TAG_SYSN);
+    put_u32(b, (uint32_t)count);
+    for (size_t i = 0; i < count; i++)
+      put_str(b, so->nodes[i].status.name);
+    end_section(b, at, true);
+    x->systems_hash = h;
+  }
+  size_t at = begin_section(b, TAG_TIME);
+  for (size_t i = 0; i < count; i++)
+    put_f32(b, (float)so->nodes[i].status.last_update_time);
+  end_section(b, at, true);
+}
+
+/* Ahead of the writer by the queue's limits? Counts the turn if so. */
+static bool writer_behind(civ_delta_export_t *x, bool *failed) {
+  SDL_LockMutex(x->lock);
+  *failed = x->stats.failed;
+  bool behind = x->queued >= CIV_DELTA_EXPORT_QUEUE_FRAMES ||
+                x->queued_bytes >= CIV_DELTA_EXPORT_QUEUE_BYTES;
+  if (behind && !*failed)
+    x->stats.turns_coalesced++;
+  SDL_UnlockMutex(x->lock);
+  return behind;
+}
+
+void civ_delta_export_turn(civ_delta_export_t *x, const civ_game_t *game) {
+  if (!x || !game)
+    return;
+  bool failed;
+  bool behind = writer_behind(x, &failed);
+  if (failed)
+    return;
+  const civ_event_manager_t *em = game->event_manager;
+  if (behind) {
+    x->turns_pending++;
+    if (!x->keep_events && em && x->events_primed) {
+      x->events_lost += (uint32_t)(em->events_emitted - x->events_seen);
+      x->events_seen = em->events_emitted;
+    }
+    return;
+  }
+
+  buf_t b = {0};
+  b.capacity = MAX(x->size_hint, (size_t)256);
+  b.data = CIV_MALLOC(b.capacity);
+  if (!b.data)
+    b.failed = true;
+
+  /* TURN first, patched once the rest is known */
+  size_t turn_at = begin_section(&b, TAG_TURN);
+  put_i32(&b, game->current_turn);
+  put_u32(&b, x->sequence);
+  put_u32(&b, x->turns_pending + 1);
+  put_u32(&b, 0); /* events lost */
+  put_u32(&b, 0); /* flags */
+  end_section(&b, turn_at, true);
+  bool resync = x->resync;
+  x->resync = false;
+
+  add_map(x, &b, game->world_map);
+  add_owners(x, &b);
+  add_nations(x, &b, (const civ_nation_manager_t *)game->nation_manager);
+  add_relations(x, &b, game->diplomacy_system);
+  add_events(x, &b, em);
+  add_systems(x, &b, game->system_orchestrator);
+  resync = resync || x->resync; /* a baseline found itself stale */
+  x->resync = false;
+
+  frame_t *fr = b.failed ? NULL : CIV_CALLOC(1, sizeof(*fr));
+  if (!fr) {
+    /* Half the baselines moved for a frame nobody will see */
+    CIV_FREE(b.data);
+    reset_baselines(x);
+    return;
+  }
+  put_le32(b.data + turn_at + 20, x->events_lost);
+  put_le32(b.data + turn_at + 24, resync ? TURN_RESYNC : 0);
+  fr->body = b.data;
+  fr->size = b.size;
+  x->size_hint = b.size;
+  x->sequence++;
+  x->turns_pending = 0;
+
+  SDL_LockMutex(x->lock);
+  if (x->tail)
+    x->tail->next = fr;
+  else
+    x->head = fr;
+  x->tail = fr;
+  x->queued++;
+  x->queued_bytes += fr->size;
+  x->stats.frames_built++;
+  x->stats.events_lost += x->events_lost;
+  x->stats.queue_peak = MAX(x->stats.queue_peak, x->queued);
+  SDL_SignalCondition(x->job_cv);
+  SDL_UnlockMutex(x->lock);
+  x->events_lost = 0;
+}
@@ -5,108 +5,275 @@
 
 #include "core/simulation_engine/event_dispatcher.h"
 #include "common.h"
+#include "utils/rng.h"
 #include <stdlib.h>
 #include <string.h>
 
+/* The queue is a Treiber stack: producers CAS a node onto the head and the
+   pump takes the whole list with one exchange, so there is no ABA window and
+   no producer ever waits. The pump reverses the list to arrival order and
+   then sorts it by (source, seq); seq counts the posting thread's posts, so
+   one source's events keep the order that source posted them in. */
+struct civ_event_post {
+    civ_event_post_t* next;
+    uint32_t source;
+    uint64_t seq;
+    size_t arrival;             /* set by the pump; ties only */
+    civ_symbol_t type;
+    void* data;
+};
+
+static CIV_THREAD_LOCAL uint64_t t_post_seq;
+
+static int compare_posts(const void* a, const void* b) {
+    const civ_event_post_t* x = *(civ_event_post_t* const*)a;
+    const civ_event_post_t* y = *(civ_event_post_t* const*)b;
+    if (x->source != y->source) return x->source < y->source ? -1 : 1;
+    if (x->seq != y->seq) return x->seq < y->seq ? -1 : 1;
+    return x->arrival < y->arrival ? -1 : x->arrival > y->arrival;
+}
+
+static uint32_t slot_of(civ_symbol_t type, uint32_t mask) {
+    return (type * 2654435761u) & mask;
+}
+
+static civ_event_route_t* find_route(const civ_event_dispatcher_t* ed, civ_symbol_t type) {
+    if (!ed->route_slots || type == CIV_SYMBOL_NONE) return NULL;
+    for (uint32_t h = slot_of(type, ed->slot_mask); ed->route_slots[h]; h = (h + 1) & ed->slot_mask) {
+        civ_event_route_t* route = &ed->routes[ed->route_slots[h] - 1];
+        if (route->type == type) return route;
+    }
+    return NULL;
+}
+
+/* Keep the slot table at most half full */
+static bool reserve_slots(civ_event_dispatcher_t* ed, size_t routes) {
+    if (ed->route_slots && routes * 2 <= (size_t)ed->slot_mask + 1) return true;
+    uint32_t size = 32;
+    while (size < routes * 2) size <<= 1;
+    uint32_t* slots = (uint32_t*)CIV_CALLOC(size, sizeof(uint32_t));
+    if (!slots) return false;
+    for (size_t i = 0; i < ed->route_count; i++) {
+        uint32_t h = slot_of(ed->routes[i].type, size - 1);
+        while (slots[h]) h = (h + 1) & (size - 1);
+        slots[h] = (uint32_t)i + 1;
+    }
+    CIV_FREE(ed->route_slots);
+    ed->route_slots = slots;
+    ed->slot_mask = size - 1;
+    return true;
+}
+
+static civ_event_route_t* add_route(civ_event_dispatcher_t* ed, civ_symbol_t type) {
+    if (ed->route_count >= ed->route_capacity) {
+        size_t cap = ed->route_capacity ? ed->route_capacity * 2 : 16;
+        civ_event_route_t* routes =
+            (civ_event_route_t*)CIV_REALLOC(ed->routes, cap * sizeof(civ_event_route_t));
+        if (!routes) return NULL;
+        ed->routes = routes;
+        ed->route_capacity = cap;
+    }
+    if (!reserve_slots(ed, ed->route_count + 1)) return NULL;
+
+    civ_event_route_t* route = &ed->routes[ed->route_count];
+    memset(route, 0, sizeof(*route));
+    route->type = type;
+    uint32_t h = slot_of(type, ed->slot_mask);
+    while (ed->route_slots[h]) h = (h + 1) & ed->slot_mask;
+    ed->route_slots[h] = (uint32_t)++ed->route_count;
+    return route;
+}
+
 civ_event_dispatcher_t* civ_event_dispatcher_create(void) {
     civ_event_dispatcher_t* ed = (civ_event_dispatcher_t*)CIV_MALLOC(sizeof(civ_event_dispatcher_t));
     if (!ed) {
         civ_log(CIV_LOG_ERROR, "Failed to allocate event dispatcher");
         return NULL;
     }
-    
+
     civ_event_dispatcher_init(ed);
     return ed;
 }
 
 void civ_event_dispatcher_destroy(civ_event_dispatcher_t* ed) {
     if (!ed) return;
-    
-    CIV_FREE(ed->handlers);
-    if (ed->event_types) {
-        for (size_t i = 0; i < ed->handler_count; i++) {
-            CIV_FREE(ed->event_types[i]);
-        }
-        CIV_FREE(ed->event_types);
+
+    /* Undelivered posts are dropped; their data belongs to the poster */
+    civ_event_post_t* post = (civ_event_post_t*)SDL_SetAtomicPointer((void**)&ed->posted, NULL);
+    while (post) {
+        civ_event_post_t* next = post->next;
+        CIV_FREE(post);
+        post = next;
     }
-    CIV_FREE(ed->user_data);
+    for (size_t i = 0; i < ed->route_count; i++) {
+        CIV_FREE(ed->routes[i].subscribers);
+    }
+    CIV_FREE(ed->routes);
+    CIV_FREE(ed->route_slots);
     CIV_FREE(ed);
 }
 
 void civ_event_dispatcher_init(civ_event_dispatcher_t* ed) {
     if (!ed) return;
-    
+
     memset(ed, 0, sizeof(civ_event_dispatcher_t));
-    ed->handler_capacity = 32;
-    ed->handlers = (civ_event_handler_t*)CIV_CALLOC(ed->handler_capacity, sizeof(civ_event_handler_t));
-    ed->event_types = (char**)CIV_CALLOC(ed->handler_capacity, sizeof(char*));
-    ed->user_data = (void**)CIV_CALLOC(ed->handler_capacity, sizeof(void*));
+}
+
+civ_symbol_t civ_event_dispatcher_type(const char* event_type) {
+    return civ_symbol_intern(event_type);
 }
 
 civ_result_t civ_event_dispatcher_register(civ_event_dispatcher_t* ed, const char* event_type,
                                            civ_event_handler_t handler, void* user_data) {
     civ_result_t result = {CIV_OK, NULL};
-    
+
     if (!ed || !event_type || !handler) {
         result.error = CIV_ERROR_NULL_POINTER;
         return result;
     }
-    
-    /* Expand if needed */
-    if (ed->handler_count >= ed->handler_capacity) {
-        ed->handler_capacity *= 2;
-        ed->handlers = (civ_event_handler_t*)CIV_REALLOC(ed->handlers, ed->handler_capacity * sizeof(civ_event_handler_t));
-        ed->event_types = (char**)CIV_REALLOC(ed->event_types, ed->handler_capacity * sizeof(char*));
-        ed->user_data = (void**)CIV_REALLOC(ed->user_data, ed->handler_capacity * sizeof(void*));
-    }
-    
-    /* Register handler */
-    size_t name_len = strlen(event_type) + 1;
-    ed->event_types[ed->handler_count] = (char*)CIV_MALLOC(name_len);
-    if (ed->event_types[ed->handler_count]) {
-        strcpy(ed->event_types[ed->handler_count], event_type);
-        ed->handlers[ed->handler_count] = handler;
-        ed->user_data[ed->handler_count] = user_data;
-        ed->handler_count++;
-    } else {
+
+    civ_symbol_t type = civ_symbol_intern(event_type);
+    if (type == CIV_SYMBOL_NONE) {
+        result.error = CIV_ERROR_INVALID_ARGUMENT;
+        result.message = "Empty event type";
+        return result;
+    }
+
+    civ_event_route_t* route = find_route(ed, type);
+    if (!route) route = add_route(ed, type);
+    if (!route) {
         result.error = CIV_ERROR_OUT_OF_MEMORY;
+        return result;
     }
-    
+
+    /* Expand if needed */
+    if (route->count >= route->capacity) {
+        size_t cap = route->capacity ? route->capacity * 2 : 4;
+        civ_event_subscriber_t* subs = (civ_event_subscriber_t*)CIV_REALLOC(
+            route->subscribers, cap * sizeof(civ_event_subscriber_t));
+        if (!subs) {
+            result.error = CIV_ERROR_OUT_OF_MEMORY;
+            return result;
+        }
+        route->subscribers = subs;
+        route->capacity = cap;
+    }
+    route->subscribers[route->count++] = (civ_event_subscriber_t){handler, user_data};
+
     return result;
 }
 
 void civ_event_dispatcher_unregister(civ_event_dispatcher_t* ed, const char* event_type) {
     if (!ed || !event_type) return;
-    
-    for (size_t i = 0; i < ed->handler_count; i++) {
-        if (strcmp(ed->event_types[i], event_type) == 0) {
-            CIV_FREE(ed->event_types[i]);
-            memmove(&ed->event_types[i], &ed->event_types[i + 1], (ed->handler_count - i - 1) * sizeof(char*));
-            memmove(&ed->handlers[i], &ed->handlers[i + 1], (ed->handler_count - i - 1) * sizeof(civ_event_handler_t));
-            memmove(&ed->user_data[i], &ed->user_data[i + 1], (ed->handler_count - i - 1) * sizeof(void*));
-            ed->handler_count--;
-            return;
-        }
-    }
+
+    civ_event_route_t* route = find_route(ed, civ_symbol_find(event_type));
+    if (!route || route->count == 0) return;
+    memmove(&route->subscribers[0], &route->subscribers[1],
+            (route->count - 1) * sizeof(civ_event_subscriber_t));
+    route->count--;
 }
 
-civ_result_t civ_event_dispatcher_dispatch(civ_event_dispatcher_t* ed, const char* event_type, void* event_data) {
+civ_result_t civ_event_dispatcher_dispatch_id(civ_event_dispatcher_t* ed, civ_symbol_t type, void* event_data) {
     civ_result_t result = {CIV_OK, NULL};
-    
-    if (!ed || !event_type) {
+
+    if (!ed) {
         result.error = CIV_ERROR_NULL_POINTER;
         return result;
     }
-    
-    /* Dispatch to all matching handlers */
-    for (size_t i = 0; i < ed->handler_count; i++) {
-        if (strcmp(ed->event_types[i], event_type) == 0) {
-            if (ed->handlers[i]) {
-                ed->handlers[i](event_type, event_data, ed->user_data[i]);
-            }
-        }
+
+    civ_event_route_t* route = find_route(ed, type);
+    if (!route) return result;
+
+    /* Handlers may register more handlers, which can move the routes and
+       subscriber arrays: look both up again on every step */
+    size_t index = (size_t)(route - ed->routes);
+    const char* name = civ_symbol_name(type);
+    for (size_t i = 0; i < ed->routes[index].count; i++) {
+        civ_event_subscriber_t sub = ed->routes[index].subscribers[i];
+        sub.handler(name, event_data, sub.user_data);
     }
-    
+
     return result;
 }
 
+civ_result_t civ_event_dispatcher_dispatch(civ_event_dispatcher_t* ed, const char* event_type, void* event_data) {
+    if (!ed || !event_type) {
+        return (civ_result_t){CIV_ERROR_NULL_POINTER, NULL};
+    }
+
+    /* A type nobody registered has no symbol and so no handlers */
+    return civ_event_dispatcher_dispatch_id(ed, civ_symbol_find(event_type), event_data);
+}
+
+civ_result_t civ_event_dispatcher_post(civ_event_dispatcher_t* ed, civ_symbol_t type, void* event_data) {
+    return civ_event_dispatcher_post_from(ed, 0, type, event_data);
+}
+
+civ_result_t civ_event_dispatcher_post_from(civ_event_dispatcher_t* ed, uint32_t source,
+                                            civ_symbol_t type, void* event_data) {
+    if (!ed) {
+        return (civ_result_t){CIV_ERROR_NULL_POINTER, NULL};
+    }
+
+    civ_event_post_t* post = (civ_event_post_t*)CIV_MALLOC(sizeof(civ_event_post_t));
+    if (!post) {
+        return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Failed to queue event"};
+    }
+    post->source = source;
+    post->seq = t_post_seq++;
+    post->type = type;
+    post->data = event_data;
+
+    void* head;
+    do {
+        head = SDL_GetAtomicPointer((void**)&ed->posted);
+        post->next = (civ_event_post_t*)head;
+    } while (!SDL_CompareAndSwapAtomicPointer((void**)&ed->posted, head, post));
+    SDL_AddAtomicInt(&ed->post_count, 1);
+
+    return (civ_result_t){CIV_OK, NULL};
+}
+
+size_t civ_event_dispatcher_pump(civ_event_dispatcher_t* ed) {
+    if (!ed) return 0;
+
+    civ_event_post_t* post = (civ_event_post_t*)SDL_SetAtomicPointer((void**)&ed->posted, NULL);
+
+    /* Newest first -> arrival order */
+    civ_event_post_t* ordered = NULL;
+    size_t count = 0;
+    while (post) {
+        civ_event_post_t* next = post->next;
+        post->next = ordered;
+        ordered = post;
+        post = next;
+        count++;
+    }
+    SDL_AddAtomicInt(&ed->post_count, -(int)count);
+    if (count == 0) return 0;
+
+    /* Merge by (source, seq); without the scratch array arrival order stands */
+    civ_event_post_t** sorted = (civ_event_post_t**)CIV_MALLOC(count * sizeof(civ_event_post_t*));
+    if (sorted) {
+        size_t i = 0;
+        for (civ_event_post_t* p = ordered; p; p = p->next, i++) {
+            p->arrival = i;
+            sorted[i] = p;
+        }
+        qsort(sorted, count, sizeof(civ_event_post_t*), compare_posts);
+        for (i = 0; i + 1 < count; i++) sorted[i]->next = sorted[i + 1];
+        sorted[count - 1]->next = NULL;
+        ordered = sorted[0];
+        CIV_FREE(sorted);
+    } else {
+        civ_log(CIV_LOG_ERROR, "Event dispatcher: no memory to order %zu posts", count);
+    }
+
+    while (ordered) {
+        civ_event_post_t* next = ordered->next;
+        civ_event_dispatcher_dispatch_id(ed, ordered->type, ordered->data);
+        CIV_FREE(ordered);
+        ordered = next;
+    }
+    return count;
+}
@@ -0,0 +1,565 @@
+/**
+ * @file lockstep.c
+ * @brief Lockstep sessions — turn bundles, checksum checks, snapshot resync
+ */
+
+#include "core/simulation_engine/lockstep.h"
+#include "core/game.h"
+#include "core/simulation_engine/state_persistence.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+#define LOCKSTEP_MAGIC   0x5054534Cu /* "LSTP" */
+#define LOCKSTEP_VERSION 1u
+#define BUNDLE_WINDOW    4   /* turns of bundles held, the current one first */
+#define QUEUE_CAPACITY   (4 * CIV_LOCKSTEP_MAX_COMMANDS)
+#define SNAPSHOT_CHUNK   (64 * 1024) /* raw snapshot bytes per message */
+#define TO_ALL           0xFF
+#define FLAG_RAW         0x01 /* snapshot chunk stored uncompressed */
+
+typedef enum {
+  MSG_BUNDLE = 1,
+  MSG_RESYNC_REQUEST,
+  MSG_SNAPSHOT
+} msg_kind_t;
+
+/* Every message starts with this; a payload of size bytes follows */
+typedef struct {
+  uint32_t magic;
+  uint16_t version;
+  uint8_t  kind;       /* msg_kind_t */
+  uint8_t  from;
+  uint8_t  to;         /* peer, or TO_ALL */
+  uint8_t  flags;
+  uint16_t count;      /* BUNDLE: commands in the payload */
+  int32_t  turn;
+  uint32_t checksum;   /* state when turn began */
+  uint32_t index;      /* SNAPSHOT: chunk */
+  uint32_t total;      /* SNAPSHOT: chunks */
+  uint32_t raw_size;   /* SNAPSHOT: bytes of the whole snapshot */
+  uint32_t size;
+} msg_header_t;
+
+typedef struct {
+  bool          present;
+  int32_t       turn;
+  uint32_t      checksum;
+  uint16_t      count;
+  civ_command_t commands[CIV_LOCKSTEP_MAX_COMMANDS];
+} bundle_t;
+
+struct civ_lockstep {
+  civ_game_t              *game;
+  civ_lockstep_config_t    cfg;
+  civ_lockstep_transport_t link;
+  civ_lockstep_state_t     state;
+
+  int32_t  updates_done;   /* of the current turn */
+  int32_t  sent_turn;      /* newest turn whose bundle went out */
+  uint32_t start_checksum; /* state when the current turn began */
+  bool     applying;
+
+  civ_command_t *queue;    /* waiting for this peer's next bundle */
+  size_t         queued;
+  bundle_t      *bundles;  /* peer_count x BUNDLE_WINDOW, by turn */
+
+  /* Authority: peers waiting for a snapshot */
+  bool wants_snapshot[CIV_LOCKSTEP_MAX_PEERS];
+
+  /* Resyncing: the snapshot being put together */
+  uint8_t *snapshot;
+  uint8_t *chunk_seen;
+  uint32_t snapshot_size, snapshot_chunks, chunks_got;
+  int32_t  snapshot_turn;
+  uint32_t snapshot_checksum;
+
+  uint8_t *buf;            /* one message, in or out */
+  civ_lockstep_stats_t stats;
+};
+
+static civ_result_t ok_result(void) {
+  civ_result_t res = {CIV_OK, NULL};
+  return res;
+}
+
+static civ_result_t error_result(civ_error_t code, const char *msg) {
+  civ_result_t res = {code, msg};
+  return res;
+}
+
+static bundle_t *bundle_slot(civ_lockstep_t *s, int32_t peer, int32_t turn) {
+  return &s->bundles[(size_t)peer * BUNDLE_WINDOW +
+                     (size_t)((uint32_t)turn % BUNDLE_WINDOW)];
+}
+
+/* ── Messages ──────────────────────────────────────────────────────── */
+
+static bool send_message(civ_lockstep_t *s, msg_header_t h, const void *payload) {
+  h.magic = LOCKSTEP_MAGIC;
+  h.version = LOCKSTEP_VERSION;
+  h.from = (uint8_t)s->cfg.local_peer;
+  size_t size = sizeof(h) + h.size;
+  memcpy(s->buf, &h, sizeof(h));
+  if (h.size) memcpy(s->buf + sizeof(h), payload, h.size);
+  if (!s->link.send(s->link.user, s->buf, size)) {
+    civ_log(CIV_LOG_ERROR, "Lockstep link down at turn %d", s->game->current_turn);
+    s->state = CIV_LOCKSTEP_FAILED;
+    return false;
+  }
+  s->stats.bytes_sent += size;
+  s->stats.messages_sent++;
+  return true;
+}
+
+/* Send this peer's bundle for the current turn: the queue's oldest
+   commands, as many as fit */
+static bool send_bundle(civ_lockstep_t *s) {
+  int32_t turn = s->game->current_turn;
+  bundle_t *b = bundle_slot(s, s->cfg.local_peer, turn);
+  b->present = true;
+  b->turn = turn;
+  b->checksum = s->start_checksum;
+  b->count = (uint16_t)MIN(s->queued, (size_t)CIV_LOCKSTEP_MAX_COMMANDS);
+  memcpy(b->commands, s->queue, b->count * sizeof(civ_command_t));
+  s->queued -= b->count;
+  memmove(s->queue, s->queue + b->count, s->queued * sizeof(civ_command_t));
+  s->sent_turn = turn;
+
+  msg_header_t h;
+  memset(&h, 0, sizeof(h));
+  h.kind = MSG_BUNDLE;
+  h.to = TO_ALL;
+  h.count = b->count;
+  h.turn = turn;
+  h.checksum = b->checksum;
+  h.size = (uint32_t)(b->count * sizeof(civ_command_t));
+  return send_message(s, h, b->commands);
+}
+
+static void take_bundle(civ_lockstep_t *s, const msg_header_t *h,
+                        const uint8_t *payload) {
+  int32_t turn = s->game->current_turn;
+  if (h->turn < turn || h->turn >= turn + BUNDLE_WINDOW ||
+      h->count > CIV_LOCKSTEP_MAX_COMMANDS ||
+      h->size != h->count * sizeof(civ_command_t))
+    return;
+  bundle_t *b = bundle_slot(s, h->from, h->turn);
+  b->present = true;
+  b->turn = h->turn;
+  b->checksum = h->checksum;
+  b->count = h->count;
+  memcpy(b->commands, payload, h->size);
+}
+
+/* ── Resync ────────────────────────────────────────────────────────── */
+
+/* Authority: save the state at this boundary and send it to the peers that
+   asked, in compressed chunks */
+static void serve_snapshot(civ_lockstep_t *s) {
+  int waiting = 0, to = TO_ALL;
+  for (int32_t p = 0; p < s->cfg.peer_count; p++)
+    if (s->wants_snapshot[p]) {
+      waiting++;
+      to = p;
+    }
+  if (!waiting) return;
+  if (waiting > 1) to = TO_ALL;
+
+  if (CIV_FAILED(civ_game_save_state(s->game, s->cfg.snapshot_path))) {
+    civ_log(CIV_LOG_ERROR, "Lockstep snapshot not saved to %s",
+            s->cfg.snapshot_path);
+    return; /* retried at the next boundary */
+  }
+  size_t size = 0;
+  uint8_t *data = SDL_LoadFile(s->cfg.snapshot_path, &size);
+  if (!data || size > UINT32_MAX) {
+    SDL_free(data);
+    return;
+  }
+
+  msg_header_t h;
+  memset(&h, 0, sizeof(h));
+  h.kind = MSG_SNAPSHOT;
+  h.to = (uint8_t)to;
+  h.turn = s->game->current_turn;
+  h.checksum = s->start_checksum;
+  h.raw_size = (uint32_t)size;
+  h.total = (uint32_t)((size + SNAPSHOT_CHUNK - 1) / SNAPSHOT_CHUNK);
+  uint8_t *packed = CIV_MALLOC(civ_lz_bound(SNAPSHOT_CHUNK));
+  bool ok = packed != NULL;
+  for (h.index = 0; ok && h.index < h.total; h.index++) {
+    const uint8_t *piece = data + (size_t)h.index * SNAPSHOT_CHUNK;
+    size_t len = MIN((size_t)SNAPSHOT_CHUNK, size - (size_t)h.index * SNAPSHOT_CHUNK);
+    size_t n = civ_lz_compress(piece, len, packed, civ_lz_bound(SNAPSHOT_CHUNK));
+    h.flags = n == 0 || n >= len ? FLAG_RAW : 0;
+    h.size = (uint32_t)(h.flags & FLAG_RAW ? len : n);
+    ok = send_message(s, h, h.flags & FLAG_RAW ? piece : packed);
+  }
+  CIV_FREE(packed);
+  SDL_free(data);
+  if (!ok) return;
+  memset(s->wants_snapshot, 0, sizeof(s->wants_snapshot));
+  s->stats.snapshots_served++;
+  civ_log(CIV_LOG_INFO, "Lockstep snapshot of turn %d sent (%zu bytes raw)",
+          h.turn, size);
+}
+
+static void reset_snapshot(civ_lockstep_t *s) {
+  CIV_FREE(s->snapshot);
+  CIV_FREE(s->chunk_seen);
+  s->snapshot = s->chunk_seen = NULL;
+  s->snapshot_size = s->snapshot_chunks = s->chunks_got = 0;
+}
+
+/* Load the assembled snapshot and rejoin at its turn boundary */
+static void finish_resync(civ_lockstep_t *s) {
+  civ_game_t *game = s->game;
+  FILE *f = fopen(s->cfg.snapshot_path, "wb");
+  bool ok = f && fwrite(s->snapshot, 1, s->snapshot_size, f) == s->snapshot_size;
+  if (f && fclose(f) != 0) ok = false;
+  reset_snapshot(s);
+  ok = ok && !CIV_FAILED(civ_game_load_state(game, s->cfg.snapshot_path)) &&
+       game->current_turn == s->snapshot_turn;
+  if (!ok) {
+    civ_log(CIV_LOG_ERROR, "Lockstep snapshot of turn %d unusable",
+            s->snapshot_turn);
+    s->state = CIV_LOCKSTEP_FAILED;
+    return;
+  }
+
+  s->stats.dropped_commands += (uint32_t)s->queued;
+  s->queued = 0;
+  for (int32_t p = 0; p < s->cfg.peer_count; p++)
+    for (int32_t k = 0; k < BUNDLE_WINDOW; k++) {
+      bundle_t *b = &s->bundles[(size_t)p * BUNDLE_WINDOW + (size_t)k];
+      if (b->present && b->turn < game->current_turn) b->present = false;
+    }
+  s->updates_done = s->cfg.updates_per_turn;
+  s->start_checksum = s->snapshot_checksum;
+  s->stats.resyncs++;
+  s->state = CIV_LOCKSTEP_RUNNING;
+  civ_log(CIV_LOG_INFO, "Lockstep resynced at turn %d", game->current_turn);
+}
+
+static void take_chunk(civ_lockstep_t *s, const msg_header_t *h,
+                       const uint8_t *payload) {
+  if (s->state != CIV_LOCKSTEP_RESYNCING || h->total == 0 ||
+      h->index >= h->total ||
+      (uint64_t)h->total * SNAPSHOT_CHUNK < h->raw_size)
+    return;
+  if (!s->snapshot || h->turn != s->snapshot_turn ||
+      h->raw_size != s->snapshot_size || h->total != s->snapshot_chunks) {
+    reset_snapshot(s);
+    s->snapshot = CIV_MALLOC(MAX(h->raw_size, 1u));
+    s->chunk_seen = CIV_CALLOC(h->total, 1);
+    if (!s->snapshot || !s->chunk_seen) {
+      reset_snapshot(s);
+      return;
+    }
+    s->snapshot_size = h->raw_size;
+    s->snapshot_chunks = h->total;
+    s->snapshot_turn = h->turn;
+    s->snapshot_checksum = h->checksum;
+  }
+  if (s->chunk_seen[h->index]) return;
+
+  size_t at = (size_t)h->index * SNAPSHOT_CHUNK;
+  size_t len = MIN((size_t)SNAPSHOT_CHUNK, (size_t)s->snapshot_size - at);
+  bool ok = h->flags & FLAG_RAW
+                ? h->size == len
+                : civ_lz_decompress(payload, h->size, s->snapshot + at, len) == len;
+  if (!ok) return;
+  if (h->flags & FLAG_RAW) memcpy(s->snapshot + at, payload, len);
+  s->chunk_seen[h->index] = 1;
+  if (++s->chunks_got == s->snapshot_chunks) finish_resync(s);
+}
+
+/* Non-authority peer whose turn start differs from peer 0's */
+static void request_resync(civ_lockstep_t *s) {
+  int32_t turn = s->game->current_turn;
+  civ_log(CIV_LOG_WARNING, "Lockstep desync at turn %d (%08x, peer 0 %08x)",
+          turn, s->start_checksum, bundle_slot(s, 0, turn)->checksum);
+  s->stats.last_desync = turn;
+  s->state = CIV_LOCKSTEP_RESYNCING;
+
+  msg_header_t h;
+  memset(&h, 0, sizeof(h));
+  h.kind = MSG_RESYNC_REQUEST;
+  h.to = 0;
+  h.turn = turn;
+  h.checksum = s->start_checksum;
+  send_message(s, h, NULL);
+}
+
+/* ── Turns ─────────────────────────────────────────────────────────── */
+
+static void pump(civ_lockstep_t *s) {
+  size_t n;
+  while (s->state != CIV_LOCKSTEP_FAILED &&
+         (n = s->link.receive(s->link.user, s->buf, CIV_LOCKSTEP_MAX_MESSAGE)) > 0) {
+    s->stats.bytes_received += n;
+    s->stats.messages_received++;
+    msg_header_t h;
+    if (n < sizeof(h)) continue;
+    memcpy(&h, s->buf, sizeof(h));
+    if (h.magic != LOCKSTEP_MAGIC || h.version != LOCKSTEP_VERSION ||
+        h.size != n - sizeof(h) || h.from >= s->cfg.peer_count ||
+        h.from == s->cfg.local_peer ||
+        (h.to != TO_ALL && h.to != s->cfg.local_peer))
+      continue;
+    const uint8_t *payload = s->buf + sizeof(h);
+    switch ((msg_kind_t)h.kind) {
+    case MSG_BUNDLE:
+      take_bundle(s, &h, payload);
+      break;
+    case MSG_RESYNC_REQUEST:
+      if (s->cfg.local_peer == 0) s->wants_snapshot[h.from] = true;
+      break;
+    case MSG_SNAPSHOT:
+      take_chunk(s, &h, payload);
+      break;
+    }
+  }
+}
+
+static bool turn_complete(civ_lockstep_t *s) {
+  int32_t turn = s->game->current_turn;
+  for (int32_t p = 0; p < s->cfg.peer_count; p++) {
+    const bundle_t *b = bundle_slot(s, p, turn);
+    if (!b->present || b->turn != turn) return false;
+  }
+  return true;
+}
+
+/* Apply every bundle in peer order, then end the turn */
+static void close_turn(civ_lockstep_t *s) {
+  civ_game_t *game = s->game;
+  int32_t turn = game->current_turn;
+  s->applying = true;
+  for (int32_t p = 0; p < s->cfg.peer_count; p++) {
+    bundle_t *b = bundle_slot(s, p, turn);
+    /* A target that is gone fails alike everywhere */
+    for (uint16_t c = 0; c < b->count; c++)
+      civ_game_execute(game, &b->commands[c]);
+    b->present = false;
+  }
+  s->applying = false;
+
+  civ_game_end_turn(game);
+  s->updates_done = 0;
+  s->start_checksum = civ_command_state_checksum(game);
+  s->stats.turns++;
+}
+
+civ_lockstep_state_t civ_lockstep_advance(civ_lockstep_t *s) {
+  if (!s) return CIV_LOCKSTEP_FAILED;
+  pump(s);
+  civ_game_t *game = s->game;
+  if (s->state == CIV_LOCKSTEP_FAILED || s->state == CIV_LOCKSTEP_RESYNCING ||
+      !game->is_running || game->is_paused)
+    return s->state;
+
+  if (s->updates_done < s->cfg.updates_per_turn) {
+    civ_game_update(game);
+    s->updates_done++;
+    s->state = CIV_LOCKSTEP_RUNNING;
+    return s->state;
+  }
+
+  if (s->sent_turn < game->current_turn && !send_bundle(s)) return s->state;
+  if (s->cfg.local_peer == 0) serve_snapshot(s);
+  if (s->state == CIV_LOCKSTEP_FAILED) return s->state;
+  if (!turn_complete(s)) {
+    s->state = CIV_LOCKSTEP_WAITING;
+    return s->state;
+  }
+  if (s->cfg.local_peer != 0 &&
+      bundle_slot(s, 0, game->current_turn)->checksum != s->start_checksum) {
+    request_resync(s);
+    return s->state;
+  }
+  close_turn(s);
+  s->state = CIV_LOCKSTEP_RUNNING;
+  return s->state;
+}
+
+/* ── Session ───────────────────────────────────────────────────────── */
+
+civ_lockstep_t *civ_lockstep_create(civ_game_t *game,
+                                    const civ_lockstep_config_t *config,
+                                    const civ_lockstep_transport_t *transport) {
+  if (!game || !config || !transport || !transport->send ||
+      !transport->receive || game->lockstep || config->peer_count < 1 ||
+      config->peer_count > CIV_LOCKSTEP_MAX_PEERS || config->local_peer < 0 ||
+      config->local_peer >= config->peer_count || config->updates_per_turn <= 0 ||
+      !config->snapshot_path[0])
+    return NULL;
+  if (config->fixed_dt > 0.0) game->fixed_dt = config->fixed_dt;
+  if (game->fixed_dt <= 0.0) {
+    civ_log(CIV_LOG_ERROR, "Lockstep needs a fixed update delta");
+    return NULL;
+  }
+
+  civ_lockstep_t *s = CIV_CALLOC(1, sizeof(*s));
+  if (!s) return NULL;
+  s->game = game;
+  s->cfg = *config;
+  s->cfg.fixed_dt = game->fixed_dt;
+  s->link = *transport;
+  s->queue = CIV_MALLOC(QUEUE_CAPACITY * sizeof(civ_command_t));
+  s->bundles = CIV_CALLOC((size_t)config->peer_count * BUNDLE_WINDOW,
+                          sizeof(bundle_t));
+  s->buf = CIV_MALLOC(CIV_LOCKSTEP_MAX_MESSAGE);
+  if (!s->queue || !s->bundles || !s->buf) {
+    civ_lockstep_destroy(s);
+    return NULL;
+  }
+  s->sent_turn = game->current_turn - 1;
+  s->start_checksum = civ_command_state_checksum(game);
+  s->state = CIV_LOCKSTEP_RUNNING;
+  game->lockstep = s;
+  civ_log(CIV_LOG_INFO, "Lockstep session: peer %d of %d, %d updates a turn",
+          config->local_peer, config->peer_count, config->updates_per_turn);
+  return s;
+}
+
+void civ_lockstep_destroy(civ_lockstep_t *s) {
+  if (!s) return;
+  if (s->game && s->game->lockstep == s) s->game->lockstep = NULL;
+  reset_snapshot(s);
+  CIV_FREE(s->queue);
+  CIV_FREE(s->bundles);
+  CIV_FREE(s->buf);
+  CIV_FREE(s);
+}
+
+civ_result_t civ_lockstep_submit(civ_lockstep_t *s, const civ_command_t *cmd) {
+  if (!s || !cmd)
+    return error_result(CIV_ERROR_INVALID_ARGUMENT, "Invalid command");
+  if (s->state == CIV_LOCKSTEP_FAILED)
+    return error_result(CIV_ERROR_INVALID_STATE, "Lockstep session failed");
+  if (s->queued == QUEUE_CAPACITY) {
+    s->stats.dropped_commands++;
+    return error_result(CIV_ERROR_INVALID_STATE, "Command queue full");
+  }
+  s->queue[s->queued++] = *cmd;
+  return ok_result();
+}
+
+bool civ_lockstep_applying(const civ_lockstep_t *s) {
+  return s && s->applying;
+}
+
+void civ_lockstep_stats(const civ_lockstep_t *s, civ_lockstep_stats_t *out) {
+  if (!out) return;
+  if (!s) {
+    memset(out, 0, sizeof(*out));
+    return;
+  }
+  *out = s->stats;
+}
+
+/* ── Loopback hub ──────────────────────────────────────────────────── */
+
+typedef struct loop_msg {
+  struct loop_msg *next;
+  size_t size;
+  uint8_t data[];
+} loop_msg_t;
+
+typedef struct {
+  civ_lockstep_loopback_t *hub;
+  int32_t peer;
+} loop_end_t;
+
+struct civ_lockstep_loopback {
+  SDL_Mutex *lock;
+  int32_t peer_count;
+  struct {
+    loop_msg_t *head, *tail;
+  } inbox[CIV_LOCKSTEP_MAX_PEERS];
+  loop_end_t ends[CIV_LOCKSTEP_MAX_PEERS];
+};
+
+static bool loop_send(void *user, const void *data, size_t size) {
+  loop_end_t *e = user;
+  civ_lockstep_loopback_t *hub = e->hub;
+  SDL_LockMutex(hub->lock);
+  bool ok = true;
+  for (int32_t p = 0; ok && p < hub->peer_count; p++) {
+    if (p == e->peer) continue;
+    loop_msg_t *m = CIV_MALLOC(sizeof(*m) + size);
+    if (!m) {
+      ok = false;
+      break;
+    }
+    m->next = NULL;
+    m->size = size;
+    memcpy(m->data, data, size);
+    if (hub->inbox[p].tail)
+      hub->inbox[p].tail->next = m;
+    else
+      hub->inbox[p].head = m;
+    hub->inbox[p].tail = m;
+  }
+  SDL_UnlockMutex(hub->lock);
+  return ok;
+}
+
+static size_t loop_receive(void *user, void *buf, size_t capacity) {
+  loop_end_t *e = user;
+  civ_lockstep_loopback_t *hub = e->hub;
+  size_t size = 0;
+  SDL_LockMutex(hub->lock);
+  loop_msg_t *m;
+  while (!size && (m = hub->inbox[e->peer].head)) {
+    hub->inbox[e->peer].head = m->next;
+    if (!m->next) hub->inbox[e->peer].tail = NULL;
+    if (m->size <= capacity) {
+      memcpy(buf, m->data, m->size);
+      size = m->size;
+    }
+    CIV_FREE(m);
+  }
+  SDL_UnlockMutex(hub->lock);
+  return size;
+}
+
+civ_lockstep_loopback_t *civ_lockstep_loopback_create(int32_t peer_count) {
+  if (peer_count < 1 || peer_count > CIV_LOCKSTEP_MAX_PEERS) return NULL;
+  civ_lockstep_loopback_t *hub = CIV_CALLOC(1, sizeof(*hub));
+  if (!hub) return NULL;
+  hub->lock = SDL_CreateMutex();
+  if (!hub->lock) {
+    CIV_FREE(hub);
+    return NULL;
+  }
+  hub->peer_count = peer_count;
+  for (int32_t p = 0; p < peer_count; p++)
+    hub->ends[p] = (loop_end_t){hub, p};
+  return hub;
+}
+
+void civ_lockstep_loopback_destroy(civ_lockstep_loopback_t *hub) {
+  if (!hub) return;
+  for (int32_t p = 0; p < hub->peer_count; p++)
+    while (hub->inbox[p].head) {
+      loop_msg_t *m = hub->inbox[p].head;
+      hub->inbox[p].head = m->next;
+      CIV_FREE(m);
+    }
+  SDL_DestroyMutex(hub->lock);
+  CIV_FREE(hub);
+}
+
+civ_lockstep_transport_t civ_lockstep_loopback_endpoint(
+    civ_lockstep_loopback_t *hub, int32_t peer) {
+  civ_lockstep_transport_t t = {NULL, NULL, NULL};
+  if (hub && peer >= 0 && peer < hub->peer_count) {
+    t.user = &hub->ends[peer];
+    t.send = loop_send;
+    t.receive = loop_receive;
+  }
+  return t;
+}
@@ -5,11 +5,30 @@
 
 #include "core/simulation_engine/performance_optimizer.h"
 #include "common.h"
+#include <SDL3/SDL.h>
+#include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include <math.h>
 
+/* One metric's samples on one thread since the last merge */
+typedef struct {
+    uint32_t count;
+    float min_time;
+    float max_time;
+    double sum;
+    double memory;
+    uint32_t buckets[CIV_PERF_BUCKETS];
+} civ_perf_sample_t;
+
+struct civ_perf_accumulator {
+    SDL_SpinLock lock;
+    uint16_t touched[CIV_PERF_MAX_METRICS];  /* metrics with samples */
+    uint32_t touched_count;
+    civ_perf_sample_t samples[CIV_PERF_MAX_METRICS];
+};
+
 civ_performance_optimizer_t* civ_performance_optimizer_create(void) {
     civ_performance_optimizer_t* po = (civ_performance_optimizer_t*)CIV_MALLOC(sizeof(civ_performance_optimizer_t));
     if (!po) {
@@ -18,11 +37,19 @@ civ_performance_optimizer_t* civ_performance_optimizer_create(void) {
     }
     
     civ_performance_optimizer_init(po);
+    if (!po->metrics) {
+        civ_log(CIV_LOG_ERROR, "Failed to allocate performance metrics");
+        CIV_FREE(po);
+        return NULL;
+    }
     return po;
 }
 
 void civ_performance_optimizer_destroy(civ_performance_optimizer_t* po) {
     if (!po) return;
+    for (int i = 0; i < po->thread_count; i++) {
+        CIV_FREE(po->threads[i]);
+    }
     CIV_FREE(po->metrics);
     CIV_FREE(po);
 }
@@ -31,8 +58,7 @@ void civ_performance_optimizer_init(civ_performance_optimizer_t* po) {
     if (!po) return;
     
     memset(po, 0, sizeof(civ_performance_optimizer_t));
-    po->metric_capacity = 100;
-    po->metrics = (civ_performance_metric_t*)CIV_CALLOC(po->metric_capacity, sizeof(civ_performance_metric_t));
+    po->metrics = (civ_performance_metric_t*)CIV_CALLOC(CIV_PERF_MAX_METRICS, sizeof(civ_performance_metric_t));
     po->profiling_enabled = false;
     po->optimization_threshold = 100.0f;  /* 100ms */
 }
@@ -43,98 +69,478 @@ void civ_performance_optimizer_enable_profiling(civ_performance_optimizer_t* po,
     civ_log(CIV_LOG_INFO, "Performance profiling %s", enabled ? "enabled" : "disabled");
 }
 
+static civ_perf_metric_t find_metric(const civ_performance_optimizer_t* po, const char* name) {
+    for (size_t i = 0; i < po->metric_count; i++) {
+        if (strncmp(po->metrics[i].name, name, STRING_SHORT_LEN - 1) == 0) {
+            return (civ_perf_metric_t)i;
+        }
+    }
+    return CIV_PERF_INVALID;
+}
+
+civ_perf_metric_t civ_performance_optimizer_register(civ_performance_optimizer_t* po,
+                                                     const char* name) {
+    if (!po || !po->metrics || !name || !*name) return CIV_PERF_INVALID;
+
+    SDL_LockSpinlock(&po->lock);
+    civ_perf_metric_t id = find_metric(po, name);
+    if (id == CIV_PERF_INVALID && po->metric_count < CIV_PERF_MAX_METRICS) {
+        civ_performance_metric_t* m = &po->metrics[po->metric_count];
+        memset(m, 0, sizeof(*m));
+        strncpy(m->name, name, sizeof(m->name) - 1);
+        id = (civ_perf_metric_t)po->metric_count++;
+    }
+    SDL_UnlockSpinlock(&po->lock);
+
+    if (id == CIV_PERF_INVALID) {
+        civ_log(CIV_LOG_WARNING, "Performance metric table full, dropping '%s'", name);
+    }
+    return id;
+}
+
+/* The calling thread's accumulator, claimed on its first record */
+static struct civ_perf_accumulator* thread_accumulator(civ_performance_optimizer_t* po) {
+    struct civ_perf_accumulator* acc =
+        (struct civ_perf_accumulator*)SDL_GetTLS(&po->thread_tls);
+    if (acc) return acc;
+
+    SDL_LockSpinlock(&po->lock);
+    if (po->thread_count < CIV_PERF_MAX_THREADS) {
+        acc = (struct civ_perf_accumulator*)CIV_CALLOC(1, sizeof(*acc));
+        if (acc) po->threads[po->thread_count++] = acc;
+    }
+    if (!acc && po->thread_count > 0) {
+        acc = po->threads[po->thread_count - 1];
+    }
+    SDL_UnlockSpinlock(&po->lock);
+
+    /* No destructor: accumulators live as long as the optimizer */
+    if (acc) SDL_SetTLS(&po->thread_tls, acc, NULL);
+    return acc;
+}
+
+static int bucket_of(civ_float_t ms) {
+    float us = (float)ms * 1000.0f;
+    if (!(us >= 1.0f)) return 0;
+    int e;
+    float m = frexpf(us, &e);  /* us = m * 2^e, m in [0.5, 1) */
+    int b = 1 + (e - 1) * CIV_PERF_OCTAVE_BUCKETS +
+            (int)((m - 0.5f) * 2.0f * CIV_PERF_OCTAVE_BUCKETS);
+    return MIN(b, CIV_PERF_BUCKETS - 1);
+}
+
+/* Middle of bucket b, in ms */
+static civ_float_t bucket_mid(int b) {
+    if (b == 0) return 0.0005f;
+    int octave = (b - 1) / CIV_PERF_OCTAVE_BUCKETS;
+    int step = (b - 1) % CIV_PERF_OCTAVE_BUCKETS;
+    double lo = ldexp(1.0 + (double)step / CIV_PERF_OCTAVE_BUCKETS, octave);
+    double width = ldexp(1.0 / CIV_PERF_OCTAVE_BUCKETS, octave);
+    return (civ_float_t)((lo + width * 0.5) / 1000.0);
+}
+
+void civ_performance_optimizer_record(civ_performance_optimizer_t* po, civ_perf_metric_t id,
+                                      civ_float_t execution_time, civ_float_t memory_delta) {
+    if (!po || !po->profiling_enabled || id < 0 || id >= CIV_PERF_MAX_METRICS) return;
+
+    struct civ_perf_accumulator* acc = thread_accumulator(po);
+    if (!acc) return;
+
+    SDL_LockSpinlock(&acc->lock);
+    civ_perf_sample_t* s = &acc->samples[id];
+    if (s->count == 0) {
+        acc->touched[acc->touched_count++] = (uint16_t)id;
+        s->min_time = (float)execution_time;
+        s->max_time = (float)execution_time;
+    } else {
+        s->min_time = MIN(s->min_time, (float)execution_time);
+        s->max_time = MAX(s->max_time, (float)execution_time);
+    }
+    s->count++;
+    s->sum += execution_time;
+    s->memory += memory_delta;
+    s->buckets[bucket_of(execution_time)]++;
+    SDL_UnlockSpinlock(&acc->lock);
+}
+
 void civ_performance_optimizer_record_metric(civ_performance_optimizer_t* po, const char* name,
                                               civ_float_t execution_time, civ_float_t memory_delta) {
     if (!po || !name) return;
-    
-    /* Find or create metric */
-    civ_performance_metric_t* metric = NULL;
-    for (size_t i = 0; i < po->metric_count; i++) {
-        if (strcmp(po->metrics[i].name, name) == 0) {
-            metric = &po->metrics[i];
-            break;
+    civ_performance_optimizer_record(po, civ_performance_optimizer_register(po, name),
+                                     execution_time, memory_delta);
+}
+
+civ_float_t civ_performance_optimizer_percentile(const civ_performance_metric_t* metric,
+                                                 civ_float_t p) {
+    if (!metric || metric->call_count == 0) return 0.0f;
+    uint64_t rank = (uint64_t)ceil(CLAMP(p, 0.0, 1.0) * (double)metric->call_count);
+    rank = MAX(rank, 1);
+    uint64_t seen = 0;
+    for (int b = 0; b < CIV_PERF_BUCKETS; b++) {
+        seen += metric->buckets[b];
+        if (seen >= rank) {
+            return CLAMP(bucket_mid(b), metric->min_time, metric->max_time);
         }
     }
-    
-    if (!metric) {
-        /* Create new metric */
-        if (po->metric_count >= po->metric_capacity) {
-            po->metric_capacity *= 2;
-            po->metrics = (civ_performance_metric_t*)CIV_REALLOC(po->metrics,
-                                                                  po->metric_capacity * sizeof(civ_performance_metric_t));
-        }
-        
-        if (po->metrics) {
-            metric = &po->metrics[po->metric_count++];
-            memset(metric, 0, sizeof(civ_performance_metric_t));
-            strncpy(metric->name, name, sizeof(metric->name) - 1);
-            metric->min_time = execution_time;
-            metric->max_time = execution_time;
+    return metric->max_time;
+}
+
+void civ_performance_optimizer_merge(civ_performance_optimizer_t* po) {
+    if (!po || !po->metrics) return;
+
+    bool changed[CIV_PERF_MAX_METRICS] = {false};
+    SDL_LockSpinlock(&po->lock);
+    int thread_count = po->thread_count;
+    SDL_UnlockSpinlock(&po->lock);
+
+    for (int t = 0; t < thread_count; t++) {
+        struct civ_perf_accumulator* acc = po->threads[t];
+        SDL_LockSpinlock(&acc->lock);
+        for (uint32_t k = 0; k < acc->touched_count; k++) {
+            uint16_t id = acc->touched[k];
+            civ_perf_sample_t* s = &acc->samples[id];
+            civ_performance_metric_t* m = &po->metrics[id];
+            if (m->call_count == 0) {
+                m->min_time = s->min_time;
+                m->max_time = s->max_time;
+            } else {
+                m->min_time = MIN(m->min_time, s->min_time);
+                m->max_time = MAX(m->max_time, s->max_time);
+            }
+            m->call_count += s->count;
+            m->execution_time += (civ_float_t)s->sum;
+            m->memory_usage += (civ_float_t)s->memory;
+            for (int b = 0; b < CIV_PERF_BUCKETS; b++) {
+                m->buckets[b] += s->buckets[b];
+            }
+            po->total_calls += s->count;
+            po->total_execution_time += (civ_float_t)s->sum;
+            changed[id] = true;
+            memset(s, 0, sizeof(*s));
         }
+        acc->touched_count = 0;
+        SDL_UnlockSpinlock(&acc->lock);
     }
-    
-    if (metric) {
-        metric->execution_time += execution_time;
-        metric->call_count++;
-        metric->memory_usage += memory_delta;
-        metric->avg_time = metric->execution_time / (civ_float_t)metric->call_count;
-        metric->min_time = MIN(metric->min_time, execution_time);
-        metric->max_time = MAX(metric->max_time, execution_time);
-        
-        po->total_calls++;
-        po->total_execution_time += execution_time;
+
+    for (size_t i = 0; i < po->metric_count; i++) {
+        if (!changed[i]) continue;
+        civ_performance_metric_t* m = &po->metrics[i];
+        m->avg_time = m->execution_time / (civ_float_t)m->call_count;
+        m->p50_time = civ_performance_optimizer_percentile(m, 0.50f);
+        m->p95_time = civ_performance_optimizer_percentile(m, 0.95f);
+        m->p99_time = civ_performance_optimizer_percentile(m, 0.99f);
     }
+    po->merges++;
 }
 
 civ_performance_metric_t* civ_performance_optimizer_get_metric(civ_performance_optimizer_t* po, const char* name) {
-    if (!po || !name) return NULL;
+    if (!po || !po->metrics || !name) return NULL;
     
-    for (size_t i = 0; i < po->metric_count; i++) {
-        if (strcmp(po->metrics[i].name, name) == 0) {
-            return &po->metrics[i];
+    civ_perf_metric_t id = find_metric(po, name);
+    return id == CIV_PERF_INVALID ? NULL : &po->metrics[id];
+}
+
+const civ_performance_metric_t* civ_performance_optimizer_metric(const civ_performance_optimizer_t* po,
+                                                                 civ_perf_metric_t id) {
+    if (!po || !po->metrics || id < 0 || (size_t)id >= po->metric_count) return NULL;
+    return &po->metrics[id];
+}
+
+/* Growable report text */
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+    bool failed;
+} report_buffer_t;
+
+static void report_append(report_buffer_t* rb, const char* fmt, ...) {
+    if (rb->failed) return;
+    for (;;) {
+        va_list args;
+        va_start(args, fmt);
+        int n = vsnprintf(rb->data + rb->length, rb->capacity - rb->length, fmt, args);
+        va_end(args);
+        if (n < 0) {
+            rb->failed = true;
+            return;
+        }
+        if ((size_t)n < rb->capacity - rb->length) {
+            rb->length += (size_t)n;
+            return;
         }
+        size_t capacity = MAX(rb->capacity * 2, rb->length + (size_t)n + 1);
+        char* data = (char*)CIV_REALLOC(rb->data, capacity);
+        if (!data) {
+            rb->failed = true;
+            return;
+        }
+        rb->data = data;
+        rb->capacity = capacity;
     }
-    
-    return NULL;
 }
 
 char* civ_performance_optimizer_generate_report(const civ_performance_optimizer_t* po) {
-    if (!po) return NULL;
+    if (!po || !po->metrics) return NULL;
     
-    char* report = (char*)CIV_MALLOC(4096);
-    if (!report) return NULL;
-    
-    size_t offset = 0;
-    offset += snprintf(report + offset, 4096 - offset, "Performance Report\n");
-    offset += snprintf(report + offset, 4096 - offset, "==================\n\n");
-    offset += snprintf(report + offset, 4096 - offset, "Total Calls: %llu\n", (unsigned long long)po->total_calls);
-    offset += snprintf(report + offset, 4096 - offset, "Total Time: %.2f ms\n\n", po->total_execution_time);
+    report_buffer_t rb = {0};
+    rb.capacity = 1024;
+    rb.data = (char*)CIV_MALLOC(rb.capacity);
+    if (!rb.data) return NULL;
+    rb.data[0] = '\0';
+
+    report_append(&rb, "Performance Report\n");
+    report_append(&rb, "==================\n\n");
+    report_append(&rb, "Total Calls: %llu\n", (unsigned long long)po->total_calls);
+    report_append(&rb, "Total Time: %.2f ms\n", po->total_execution_time);
+    report_append(&rb, "Merges: %llu\n\n", (unsigned long long)po->merges);
     
-    offset += snprintf(report + offset, 4096 - offset, "Metrics:\n");
-    offset += snprintf(report + offset, 4096 - offset, "%-20s %10s %10s %10s %10s %10s\n",
-                      "Name", "Calls", "Total(ms)", "Avg(ms)", "Min(ms)", "Max(ms)");
-    offset += snprintf(report + offset, 4096 - offset, "%-20s %10s %10s %10s %10s %10s\n",
-                      "--------------------", "----------", "----------", "----------", "----------", "----------");
+    report_append(&rb, "Metrics:\n");
+    report_append(&rb, "%-20s %10s %10s %10s %10s %10s %10s %10s %10s\n",
+                  "Name", "Calls", "Total(ms)", "Avg(ms)", "Min(ms)", "P50(ms)",
+                  "P95(ms)", "P99(ms)", "Max(ms)");
+    report_append(&rb, "%-20s %10s %10s %10s %10s %10s %10s %10s %10s\n",
+                  "--------------------", "----------", "----------", "----------",
+                  "----------", "----------", "----------", "----------", "----------");
     
-    for (size_t i = 0; i < po->metric_count && offset < 4000; i++) {
+    for (size_t i = 0; i < po->metric_count; i++) {
         const civ_performance_metric_t* m = &po->metrics[i];
-        offset += snprintf(report + offset, 4096 - offset,
-                          "%-20s %10llu %10.2f %10.2f %10.2f %10.2f\n",
-                          m->name, (unsigned long long)m->call_count, m->execution_time,
-                          m->avg_time, m->min_time, m->max_time);
+        report_append(&rb, "%-20s %10llu %10.2f %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f\n",
+                      m->name, (unsigned long long)m->call_count, m->execution_time,
+                      m->avg_time, m->min_time, m->p50_time, m->p95_time, m->p99_time,
+                      m->max_time);
     }
-    
-    return report;
+
+    if (rb.failed) {
+        CIV_FREE(rb.data);
+        return NULL;
+    }
+    return rb.data;
 }
 
 void civ_performance_optimizer_reset(civ_performance_optimizer_t* po) {
-    if (!po) return;
+    if (!po || !po->metrics) return;
     
+    for (int t = 0; t < po->thread_count; t++) {
+        struct civ_perf_accumulator* acc = po->threads[t];
+        SDL_LockSpinlock(&acc->lock);
+        for (uint32_t k = 0; k < acc->touched_count; k++) {
+            memset(&acc->samples[acc->touched[k]], 0, sizeof(civ_perf_sample_t));
+        }
+        acc->touched_count = 0;
+        SDL_UnlockSpinlock(&acc->lock);
+    }
     for (size_t i = 0; i < po->metric_count; i++) {
-        memset(&po->metrics[i], 0, sizeof(civ_performance_metric_t));
+        civ_performance_metric_t* m = &po->metrics[i];
+        char name[STRING_SHORT_LEN];
+        memcpy(name, m->name, sizeof(name));
+        memset(m, 0, sizeof(*m));
+        memcpy(m->name, name, sizeof(name));
     }
-    po->metric_count = 0;
     po->total_calls = 0;
     po->total_execution_time = 0.0f;
+    po->merges = 0;
+}
+
+
+/* ── Scoped phase profiler ─────────────────────────────────────────── */
+
+typedef struct {
+    civ_profile_id_t id;
+    uint64_t start_ns;
+    uint64_t duration_ns;
+} civ_profile_event_t;
+
+/* Single-producer (owning thread) / single-consumer (end_frame) ring */
+typedef struct {
+    civ_profile_event_t events[CIV_PROFILER_RING_SIZE];
+    SDL_AtomicInt write_pos;
+    SDL_AtomicInt read_pos;
+    SDL_AtomicInt in_use;      /* cleared when the owning thread exits */
+    uint64_t dropped;
+} civ_profile_ring_t;
+
+static struct {
+    char names[CIV_PROFILER_MAX_METRICS][STRING_SHORT_LEN];
+    SDL_AtomicInt metric_count;
+    SDL_SpinLock register_lock;
+
+    civ_profile_ring_t* rings[CIV_PROFILER_MAX_THREADS];
+    SDL_SpinLock ring_lock;
+    SDL_TLSID ring_tls;
+
+    SDL_AtomicInt enabled_flag;
+    SDL_AtomicInt initialized;
+
+    /* Frame being accumulated by the collector */
+    civ_profile_frame_t current;
+    SDL_SpinLock collect_lock;
+
+    civ_profile_frame_t history[CIV_PROFILER_HISTORY];
+    uint64_t history_count;    /* frames ever closed */
+    SDL_SpinLock history_lock;
+} g_profiler;
+
+static void profiler_lazy_init(void) {
+    if (SDL_GetAtomicInt(&g_profiler.initialized)) return;
+    if (SDL_CompareAndSwapAtomicInt(&g_profiler.initialized, 0, 1)) {
+        SDL_SetAtomicInt(&g_profiler.enabled_flag, 1);
+        g_profiler.current.start_ns = SDL_GetTicksNS();
+    }
 }
 
+civ_profile_id_t civ_profiler_register(const char* name) {
+    if (!name || !*name) return CIV_PROFILE_INVALID;
+    profiler_lazy_init();
+
+    civ_profile_id_t id = CIV_PROFILE_INVALID;
+    SDL_LockSpinlock(&g_profiler.register_lock);
+    int count = SDL_GetAtomicInt(&g_profiler.metric_count);
+    for (int i = 0; i < count; i++) {
+        if (strncmp(g_profiler.names[i], name, STRING_SHORT_LEN - 1) == 0) {
+            id = (civ_profile_id_t)i;
+            break;
+        }
+    }
+    if (id == CIV_PROFILE_INVALID && count < CIV_PROFILER_MAX_METRICS) {
+        strncpy(g_profiler.names[count], name, STRING_SHORT_LEN - 1);
+        g_profiler.names[count][STRING_SHORT_LEN - 1] = '\0';
+        id = (civ_profile_id_t)count;
+        SDL_SetAtomicInt(&g_profiler.metric_count, count + 1);
+    }
+    SDL_UnlockSpinlock(&g_profiler.register_lock);
+
+    if (id == CIV_PROFILE_INVALID) {
+        civ_log(CIV_LOG_WARNING, "Profiler metric table full, dropping '%s'", name);
+    }
+    return id;
+}
+
+const char* civ_profiler_metric_name(civ_profile_id_t id) {
+    if (id >= (civ_profile_id_t)SDL_GetAtomicInt(&g_profiler.metric_count)) return "";
+    return g_profiler.names[id];
+}
+
+size_t civ_profiler_metric_count(void) {
+    return (size_t)SDL_GetAtomicInt(&g_profiler.metric_count);
+}
+
+void civ_profiler_set_enabled(bool enabled) {
+    profiler_lazy_init();
+    SDL_SetAtomicInt(&g_profiler.enabled_flag, enabled ? 1 : 0);
+}
+
+bool civ_profiler_is_enabled(void) {
+    profiler_lazy_init();
+    return SDL_GetAtomicInt(&g_profiler.enabled_flag) != 0;
+}
+
+uint64_t civ_profiler_now_ns(void) {
+    return SDL_GetTicksNS();
+}
+
+static void ring_release(void* value) {
+    civ_profile_ring_t* ring = (civ_profile_ring_t*)value;
+    /* Pending events are still drained; the slot is reused once empty */
+    if (ring) SDL_SetAtomicInt(&ring->in_use, 0);
+}
+
+static civ_profile_ring_t* thread_ring(void) {
+    civ_profile_ring_t* ring = (civ_profile_ring_t*)SDL_GetTLS(&g_profiler.ring_tls);
+    if (ring) return ring;
+
+    SDL_LockSpinlock(&g_profiler.ring_lock);
+    for (int i = 0; i < CIV_PROFILER_MAX_THREADS && !ring; i++) {
+        civ_profile_ring_t* slot = g_profiler.rings[i];
+        if (!slot) {
+            slot = (civ_profile_ring_t*)CIV_CALLOC(1, sizeof(civ_profile_ring_t));
+            if (!slot) break;
+            g_profiler.rings[i] = slot;
+        } else if (SDL_GetAtomicInt(&slot->in_use) ||
+                   SDL_GetAtomicInt(&slot->read_pos) != SDL_GetAtomicInt(&slot->write_pos)) {
+            continue;
+        }
+        SDL_SetAtomicInt(&slot->in_use, 1);
+        ring = slot;
+    }
+    SDL_UnlockSpinlock(&g_profiler.ring_lock);
+
+    if (ring) SDL_SetTLS(&g_profiler.ring_tls, ring, ring_release);
+    return ring;
+}
+
+civ_profile_scope_t civ_profiler_begin(civ_profile_id_t id) {
+    civ_profile_scope_t scope;
+    scope.id = id;
+    scope.start_ns = (id != CIV_PROFILE_INVALID && SDL_GetAtomicInt(&g_profiler.enabled_flag))
+        ? SDL_GetTicksNS() : 0;
+    return scope;
+}
+
+void civ_profiler_end(civ_profile_scope_t* scope) {
+    if (!scope || scope->start_ns == 0) return;
+    civ_profiler_record(scope->id, scope->start_ns, SDL_GetTicksNS());
+    scope->start_ns = 0;
+}
+
+void civ_profiler_record(civ_profile_id_t id, uint64_t start_ns, uint64_t end_ns) {
+    if (id >= CIV_PROFILER_MAX_METRICS || end_ns < start_ns) return;
+    if (!SDL_GetAtomicInt(&g_profiler.enabled_flag)) return;
+
+    civ_profile_ring_t* ring = thread_ring();
+    if (!ring) return;
+
+    int w = SDL_GetAtomicInt(&ring->write_pos);
+    int r = SDL_GetAtomicInt(&ring->read_pos);
+    if ((unsigned)(w - r) >= CIV_PROFILER_RING_SIZE) {
+        ring->dropped++;
+        return;
+    }
+    civ_profile_event_t* ev = &ring->events[(unsigned)w & (CIV_PROFILER_RING_SIZE - 1)];
+    ev->id = id;
+    ev->start_ns = start_ns;
+    ev->duration_ns = end_ns - start_ns;
+    SDL_SetAtomicInt(&ring->write_pos, w + 1);
+}
+
+void civ_profiler_end_frame(void) {
+    profiler_lazy_init();
+    SDL_LockSpinlock(&g_profiler.collect_lock);
+
+    civ_profile_frame_t* cur = &g_profiler.current;
+    for (int i = 0; i < CIV_PROFILER_MAX_THREADS; i++) {
+        civ_profile_ring_t* ring = g_profiler.rings[i];
+        if (!ring) continue;
+        int r = SDL_GetAtomicInt(&ring->read_pos);
+        int w = SDL_GetAtomicInt(&ring->write_pos);
+        for (; r != w; r++) {
+            const civ_profile_event_t* ev = &ring->events[(unsigned)r & (CIV_PROFILER_RING_SIZE - 1)];
+            cur->metric_ms[ev->id] += (float)((double)ev->duration_ns / 1000000.0);
+        }
+        SDL_SetAtomicInt(&ring->read_pos, r);
+    }
+    cur->end_ns = SDL_GetTicksNS();
+
+    SDL_LockSpinlock(&g_profiler.history_lock);
+    cur->frame = g_profiler.history_count;
+    g_profiler.history[g_profiler.history_count % CIV_PROFILER_HISTORY] = *cur;
+    g_profiler.history_count++;
+    SDL_UnlockSpinlock(&g_profiler.history_lock);
+
+    memset(cur, 0, sizeof(*cur));
+    cur->start_ns = SDL_GetTicksNS();
+    SDL_UnlockSpinlock(&g_profiler.collect_lock);
+}
+
+size_t civ_profiler_get_history(civ_profile_frame_t* out, size_t max_frames) {
+    if (!out || max_frames == 0) return 0;
+
+    SDL_LockSpinlock(&g_profiler.history_lock);
+    uint64_t total = g_profiler.history_count;
+    size_t n = (size_t)MIN((uint64_t)MIN(max_frames, (size_t)CIV_PROFILER_HISTORY), total);
+    for (size_t i = 0; i < n; i++) {
+        out[i] = g_profiler.history[(total - n + i) % CIV_PROFILER_HISTORY];
+    }
+    SDL_UnlockSpinlock(&g_profiler.history_lock);
+    return n;
+}
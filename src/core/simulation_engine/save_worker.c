@@ -0,0 +1,149 @@
+/**
+ * @file save_worker.c
+ * @brief Single-slot background save thread
+ */
+
+#include "core/simulation_engine/save_worker.h"
+#include <string.h>
+
+struct civ_save_worker {
+  SDL_Thread    *thread;
+  SDL_Mutex     *lock;
+  SDL_Condition *job_cv;    /* signalled when a job is submitted */
+  SDL_Condition *idle_cv;   /* broadcast when a job finishes */
+
+  /* Guarded by lock */
+  civ_save_job_fn_t fn;
+  void             *job;
+  void            (*free_fn)(void *job);
+  bool              busy;
+  bool              stopping;
+  bool              has_result;
+  civ_result_t      result;
+
+  /* Written by the job, read by anyone */
+  SDL_AtomicInt     done;
+  SDL_AtomicInt     total;
+};
+
+static int save_worker_main(void *arg) {
+  civ_save_worker_t *w = (civ_save_worker_t *)arg;
+  for (;;) {
+    SDL_LockMutex(w->lock);
+    while (!w->fn && !w->stopping)
+      SDL_WaitCondition(w->job_cv, w->lock);
+    if (!w->fn) {
+      SDL_UnlockMutex(w->lock);
+      break;
+    }
+    civ_save_job_fn_t fn = w->fn;
+    void *job = w->job;
+    void (*free_fn)(void *) = w->free_fn;
+    SDL_UnlockMutex(w->lock);
+
+    civ_result_t res = fn(job, w);
+    if (free_fn) free_fn(job);
+
+    SDL_LockMutex(w->lock);
+    w->fn = NULL;
+    w->job = NULL;
+    w->free_fn = NULL;
+    w->result = res;
+    w->has_result = true;
+    w->busy = false;
+    SDL_BroadcastCondition(w->idle_cv);
+    SDL_UnlockMutex(w->lock);
+  }
+  return 0;
+}
+
+civ_save_worker_t *civ_save_worker_create(void) {
+  civ_save_worker_t *w = CIV_CALLOC(1, sizeof(*w));
+  if (!w) return NULL;
+  w->lock = SDL_CreateMutex();
+  w->job_cv = SDL_CreateCondition();
+  w->idle_cv = SDL_CreateCondition();
+  if (w->lock && w->job_cv && w->idle_cv)
+    w->thread = SDL_CreateThread(save_worker_main, "civ_save", w);
+  if (!w->thread) {
+    if (w->lock) SDL_DestroyMutex(w->lock);
+    if (w->job_cv) SDL_DestroyCondition(w->job_cv);
+    if (w->idle_cv) SDL_DestroyCondition(w->idle_cv);
+    CIV_FREE(w);
+    return NULL;
+  }
+  return w;
+}
+
+void civ_save_worker_destroy(civ_save_worker_t *w) {
+  if (!w) return;
+  SDL_LockMutex(w->lock);
+  w->stopping = true;
+  SDL_SignalCondition(w->job_cv);
+  SDL_UnlockMutex(w->lock);
+  /* The thread finishes the job in flight before it sees stopping */
+  SDL_WaitThread(w->thread, NULL);
+  SDL_DestroyCondition(w->job_cv);
+  SDL_DestroyCondition(w->idle_cv);
+  SDL_DestroyMutex(w->lock);
+  CIV_FREE(w);
+}
+
+bool civ_save_worker_submit(civ_save_worker_t *w, civ_save_job_fn_t fn,
+                            void *job, void (*free_fn)(void *job)) {
+  if (!w || !fn) return false;
+  SDL_LockMutex(w->lock);
+  bool accepted = !w->busy && !w->stopping;
+  if (accepted) {
+    SDL_SetAtomicInt(&w->done, 0);
+    SDL_SetAtomicInt(&w->total, 0);
+    w->fn = fn;
+    w->job = job;
+    w->free_fn = free_fn;
+    w->busy = true;
+    SDL_SignalCondition(w->job_cv);
+  }
+  SDL_UnlockMutex(w->lock);
+  return accepted;
+}
+
+bool civ_save_worker_busy(const civ_save_worker_t *w) {
+  if (!w) return false;
+  SDL_LockMutex(w->lock);
+  bool busy = w->busy;
+  SDL_UnlockMutex(w->lock);
+  return busy;
+}
+
+void civ_save_worker_wait(civ_save_worker_t *w) {
+  if (!w) return;
+  SDL_LockMutex(w->lock);
+  while (w->busy)
+    SDL_WaitCondition(w->idle_cv, w->lock);
+  SDL_UnlockMutex(w->lock);
+}
+
+void civ_save_worker_set_progress(civ_save_worker_t *w, uint32_t done,
+                                  uint32_t total) {
+  if (!w) return;
+  SDL_SetAtomicInt(&w->done, (int)done);
+  SDL_SetAtomicInt(&w->total, (int)total);
+}
+
+float civ_save_worker_progress(const civ_save_worker_t *w) {
+  if (!civ_save_worker_busy(w)) return -1.0f;
+  int total = SDL_GetAtomicInt((SDL_AtomicInt *)&w->total);
+  int done = SDL_GetAtomicInt((SDL_AtomicInt *)&w->done);
+  if (total <= 0) return 0.0f;
+  return done >= total ? 1.0f : (float)done / (float)total;
+}
+
+bool civ_save_worker_take_result(civ_save_worker_t *w, civ_result_t *out) {
+  if (!w) return false;
+  SDL_LockMutex(w->lock);
+  bool has = w->has_result;
+  if (has && out) *out = w->result;
+  w->has_result = false;
+  SDL_UnlockMutex(w->lock);
+  return has;
+}
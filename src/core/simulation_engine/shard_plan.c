@@ -0,0 +1,442 @@
+/**
+ * @file shard_plan.c
+ * @brief Shard partition of owners and regions, cross-shard fronts, and the
+ *        turn-boundary message exchange
+ */
+
+#include "core/simulation_engine/shard_plan.h"
+#include "core/world/map_generator.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define FRONT_TABLE_MIN 1024 /* slots; a power of two */
+
+typedef struct {
+  uint64_t land;
+  double   sum_x, sum_y;
+  uint32_t key;            /* walk position of the centre's region */
+  civ_owner_index_t owner;
+} owner_stat_t;
+
+static civ_result_t ok_result(void) {
+  civ_result_t res = {CIV_OK, NULL};
+  return res;
+}
+
+static civ_result_t error_result(civ_error_t code, const char *msg) {
+  civ_result_t res = {code, msg};
+  return res;
+}
+
+static bool owned_land(const civ_map_t *map, size_t i, civ_owner_index_t *o) {
+  *o = civ_map_owner_at(map, i);
+  return *o != CIV_OWNER_NONE && !civ_map_is_water_at(map, i);
+}
+
+/* Serpentine position: even region rows run east, odd ones west, so
+   consecutive positions are always neighbours */
+static uint32_t walk_key(int32_t cols, int32_t rx, int32_t ry) {
+  return (uint32_t)ry * (uint32_t)cols +
+         (uint32_t)((ry & 1) ? cols - 1 - rx : rx);
+}
+
+static int cmp_owner_walk(const void *a, const void *b) {
+  const owner_stat_t *x = a, *y = b;
+  if (x->key != y->key) return x->key < y->key ? -1 : 1;
+  return (int)x->owner - (int)y->owner;
+}
+
+static bool grow_owners(civ_shard_plan_t *plan, uint32_t count) {
+  if (count <= plan->owner_capacity) return true;
+  uint16_t *grown = CIV_REALLOC(plan->owner_shard, count * sizeof(uint16_t));
+  if (!grown) return false;
+  for (uint32_t i = plan->owner_capacity; i < count; i++)
+    grown[i] = CIV_SHARD_NONE;
+  plan->owner_shard = grown;
+  plan->owner_capacity = count;
+  return true;
+}
+
+civ_shard_plan_t *civ_shard_plan_build(const civ_map_t *map,
+                                       int32_t shard_count) {
+  if (!map || !map->tiles || map->width <= 0 || map->height <= 0 ||
+      shard_count < 1 || shard_count > CIV_SHARD_MAX)
+    return NULL;
+
+  civ_shard_plan_t *plan = CIV_CALLOC(1, sizeof(civ_shard_plan_t));
+  uint32_t owners = civ_owner_count();
+  owner_stat_t *stat = CIV_CALLOC(owners ? owners : 1, sizeof(owner_stat_t));
+  if (!plan || !stat || !grow_owners(plan, owners ? owners : 1)) {
+    CIV_FREE(stat);
+    civ_shard_plan_destroy(plan);
+    return NULL;
+  }
+  plan->shard_count = shard_count;
+  plan->region_cols = (map->width + CIV_MAP_REGION_SIZE - 1) >> CIV_MAP_REGION_SHIFT;
+  plan->region_rows = (map->height + CIV_MAP_REGION_SIZE - 1) >> CIV_MAP_REGION_SHIFT;
+  size_t regions = (size_t)plan->region_cols * plan->region_rows;
+
+  /* Land and centre of every owner */
+  uint64_t total = 0;
+  for (int32_t y = 0; y < map->height; y++) {
+    size_t row = (size_t)y * map->width;
+    for (int32_t x = 0; x < map->width; x++) {
+      civ_owner_index_t o;
+      if (!owned_land(map, row + x, &o) || o >= owners) continue;
+      stat[o].land++;
+      stat[o].sum_x += x;
+      stat[o].sum_y += y;
+      total++;
+    }
+  }
+
+  /* Order the landed owners along the walk and cut the run of land into
+     equal parts; an owner goes where the middle of its land falls */
+  size_t landed = 0;
+  for (uint32_t o = 1; o < owners; o++) {
+    if (!stat[o].land) continue;
+    int32_t cx = (int32_t)(stat[o].sum_x / (double)stat[o].land);
+    int32_t cy = (int32_t)(stat[o].sum_y / (double)stat[o].land);
+    owner_stat_t s = stat[o];
+    s.owner = (civ_owner_index_t)o;
+    s.key = walk_key(plan->region_cols, cx >> CIV_MAP_REGION_SHIFT,
+                     cy >> CIV_MAP_REGION_SHIFT);
+    stat[landed++] = s;  /* landed <= o, so unread entries stay intact */
+  }
+  qsort(stat, landed, sizeof(owner_stat_t), cmp_owner_walk);
+  uint64_t run = 0;
+  for (size_t k = 0; k < landed; k++) {
+    double middle = (double)run + (double)stat[k].land * 0.5;
+    int32_t s = (int32_t)(middle * shard_count / (double)total);
+    s = CLAMP(s, 0, shard_count - 1);
+    plan->owner_shard[stat[k].owner] = (uint16_t)s;
+    plan->land[s] += stat[k].land;
+    plan->owners[s]++;
+    run += stat[k].land;
+  }
+  CIV_FREE(stat);
+
+  /* Each region to the shard with most land in it */
+  uint32_t *tally = CIV_CALLOC(regions * (size_t)shard_count, sizeof(uint32_t));
+  plan->region_shard = CIV_CALLOC(regions, sizeof(uint16_t));
+  if (!tally || !plan->region_shard) {
+    CIV_FREE(tally);
+    civ_shard_plan_destroy(plan);
+    return NULL;
+  }
+  for (int32_t y = 0; y < map->height; y++) {
+    size_t row = (size_t)y * map->width;
+    size_t rrow = (size_t)(y >> CIV_MAP_REGION_SHIFT) * plan->region_cols;
+    for (int32_t x = 0; x < map->width; x++) {
+      civ_owner_index_t o;
+      if (!owned_land(map, row + x, &o)) continue;
+      uint16_t s = civ_shard_of_owner(plan, o);
+      if (s == CIV_SHARD_NONE) continue;
+      tally[(rrow + (size_t)(x >> CIV_MAP_REGION_SHIFT)) * shard_count + s]++;
+    }
+  }
+  uint16_t carry = 0;
+  for (int32_t ry = 0; ry < plan->region_rows; ry++) {
+    for (int32_t k = 0; k < plan->region_cols; k++) {
+      int32_t rx = (ry & 1) ? plan->region_cols - 1 - k : k;
+      size_t r = (size_t)ry * plan->region_cols + rx;
+      const uint32_t *t = tally + r * shard_count;
+      uint32_t best = 0;
+      for (int32_t s = 0; s < shard_count; s++) {
+        if (t[s] > best) {
+          best = t[s];
+          carry = (uint16_t)s;
+        }
+      }
+      plan->region_shard[r] = carry;
+      plan->regions[carry]++;
+    }
+  }
+  CIV_FREE(tally);
+
+  civ_shard_plan_refresh(plan, map);
+  return plan;
+}
+
+void civ_shard_plan_destroy(civ_shard_plan_t *plan) {
+  if (!plan) return;
+  CIV_FREE(plan->region_shard);
+  CIV_FREE(plan->owner_shard);
+  CIV_FREE(plan->contacts);
+  CIV_FREE(plan);
+}
+
+/* ── Fronts ───────────────────────────────────────────────────────── */
+
+/* Open-addressed counts keyed by (a << 16 | b); key 0 is free, which no
+   front can have since a, b > 0 */
+typedef struct {
+  uint32_t *key;
+  uint32_t *count;
+  size_t    mask, used;
+} front_table_t;
+
+static bool front_table_init(front_table_t *t, size_t slots) {
+  t->key = CIV_CALLOC(slots, sizeof(uint32_t));
+  t->count = CIV_CALLOC(slots, sizeof(uint32_t));
+  t->mask = slots - 1;
+  t->used = 0;
+  return t->key && t->count;
+}
+
+static void front_table_free(front_table_t *t) {
+  CIV_FREE(t->key);
+  CIV_FREE(t->count);
+}
+
+static size_t front_slot(const front_table_t *t, uint32_t key) {
+  size_t i = (key * 2654435761u) & t->mask;
+  while (t->key[i] && t->key[i] != key) i = (i + 1) & t->mask;
+  return i;
+}
+
+static bool front_add(front_table_t *t, uint32_t key, uint32_t n) {
+  if ((t->used + 1) * 2 > t->mask + 1) {
+    front_table_t grown;
+    if (!front_table_init(&grown, (t->mask + 1) * 2)) {
+      front_table_free(&grown);
+      return false;
+    }
+    for (size_t i = 0; i <= t->mask; i++) {
+      if (!t->key[i]) continue;
+      size_t j = front_slot(&grown, t->key[i]);
+      grown.key[j] = t->key[i];
+      grown.count[j] = t->count[i];
+    }
+    grown.used = t->used;
+    front_table_free(t);
+    *t = grown;
+  }
+  size_t i = front_slot(t, key);
+  if (!t->key[i]) {
+    t->key[i] = key;
+    t->used++;
+  }
+  t->count[i] += n;
+  return true;
+}
+
+static int cmp_packed(const void *a, const void *b) {
+  uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+/* Shard of o, placing an owner the build never saw in the lightest one */
+static uint16_t shard_for(civ_shard_plan_t *plan, civ_owner_index_t o,
+                          bool *ok) {
+  uint16_t s = civ_shard_of_owner(plan, o);
+  if (s != CIV_SHARD_NONE) return s;
+  if (!grow_owners(plan, (uint32_t)o + 1)) {
+    *ok = false;
+    return CIV_SHARD_NONE;
+  }
+  s = 0;
+  for (int32_t k = 1; k < plan->shard_count; k++)
+    if (plan->land[k] < plan->land[s]) s = (uint16_t)k;
+  plan->owner_shard[o] = s;
+  plan->owners[s]++;
+  return s;
+}
+
+size_t civ_shard_plan_refresh(civ_shard_plan_t *plan, const civ_map_t *map) {
+  if (!plan || !map || !map->tiles) return 0;
+  front_table_t table;
+  if (!front_table_init(&table, FRONT_TABLE_MIN)) {
+    front_table_free(&table);
+    return 0;
+  }
+
+  /* East and south edge of every owned land tile, x wrapping */
+  uint64_t land[CIV_SHARD_MAX] = {0};
+  bool ok = true;
+  int32_t w = map->width, h = map->height;
+  for (int32_t y = 0; y < h && ok; y++) {
+    size_t row = (size_t)y * w;
+    for (int32_t x = 0; x < w && ok; x++) {
+      civ_owner_index_t o, n;
+      if (!owned_land(map, row + x, &o)) continue;
+      uint16_t so = shard_for(plan, o, &ok);
+      if (!ok) break;
+      land[so]++;
+      size_t edge[2] = {row + (size_t)((x + 1) % w), row + w + x};
+      for (int e = 0; e < (y + 1 < h ? 2 : 1); e++) {
+        if (!owned_land(map, edge[e], &n) || n == o) continue;
+        uint16_t sn = shard_for(plan, n, &ok);
+        if (!ok || sn == so) continue;
+        civ_owner_index_t a = MIN(o, n), b = MAX(o, n);
+        ok = front_add(&table, ((uint32_t)a << 16) | b, 1);
+      }
+    }
+  }
+  if (!ok) {
+    front_table_free(&table);
+    return 0;
+  }
+  memcpy(plan->land, land, sizeof(land));
+
+  /* Pack (key, count) so sorting orders by key, then merge with the old
+     fronts */
+  uint64_t *packed = CIV_MALLOC((table.used ? table.used : 1) * sizeof(uint64_t));
+  size_t worst = table.used + plan->contact_count;
+  civ_shard_contact_t *merged = CIV_MALLOC((worst ? worst : 1) *
+                                           sizeof(civ_shard_contact_t));
+  if (!packed || !merged) {
+    CIV_FREE(packed);
+    CIV_FREE(merged);
+    front_table_free(&table);
+    return 0;
+  }
+  size_t found = 0;
+  for (size_t i = 0; i <= table.mask; i++)
+    if (table.key[i])
+      packed[found++] = ((uint64_t)table.key[i] << 32) | table.count[i];
+  qsort(packed, found, sizeof(uint64_t), cmp_packed);
+
+  size_t m = 0, changed = 0, i = 0, j = 0;
+  while (i < found || j < plan->contact_count) {
+    const civ_shard_contact_t *old =
+        j < plan->contact_count ? &plan->contacts[j] : NULL;
+    uint64_t old_key = old ? ((uint32_t)old->a << 16) | old->b : UINT64_MAX;
+    uint64_t key = i < found ? packed[i] >> 32 : UINT64_MAX;
+    civ_shard_contact_t c = {0};
+    if (key <= old_key) {
+      c.a = (civ_owner_index_t)(key >> 16);
+      c.b = (civ_owner_index_t)(key & 0xFFFF);
+      c.contact = (uint32_t)packed[i++];
+    } else {
+      c.a = old->a;
+      c.b = old->b;
+    }
+    if (old && old_key <= key) {
+      c.previous = old->contact;
+      j++;
+    }
+    if (!c.contact && !c.previous) continue;
+    c.shard_a = civ_shard_of_owner(plan, c.a);
+    c.shard_b = civ_shard_of_owner(plan, c.b);
+    if (c.contact != c.previous) changed++;
+    merged[m++] = c;
+  }
+  CIV_FREE(packed);
+  front_table_free(&table);
+  CIV_FREE(plan->contacts);
+  plan->contacts = merged;
+  plan->contact_count = m;
+  plan->contact_capacity = worst;
+  return changed;
+}
+
+/* ── Exchange ─────────────────────────────────────────────────────── */
+
+typedef struct {
+  civ_shard_message_t *items;
+  size_t count, capacity;
+} message_list_t;
+
+struct civ_shard_exchange {
+  int32_t        shard_count;
+  message_list_t outbox[CIV_SHARD_MAX]; /* by source shard */
+  message_list_t delivered;             /* by (to, from, seq) */
+  size_t         inbox_start[CIV_SHARD_MAX + 1];
+  civ_shard_exchange_stats_t stats;
+};
+
+static bool list_reserve(message_list_t *l, size_t count) {
+  if (count <= l->capacity) return true;
+  size_t cap = l->capacity ? l->capacity : 64;
+  while (cap < count) cap *= 2;
+  civ_shard_message_t *grown =
+      CIV_REALLOC(l->items, cap * sizeof(civ_shard_message_t));
+  if (!grown) return false;
+  l->items = grown;
+  l->capacity = cap;
+  return true;
+}
+
+civ_shard_exchange_t *civ_shard_exchange_create(int32_t shard_count) {
+  if (shard_count < 1 || shard_count > CIV_SHARD_MAX) return NULL;
+  civ_shard_exchange_t *ex = CIV_CALLOC(1, sizeof(civ_shard_exchange_t));
+  if (ex) ex->shard_count = shard_count;
+  return ex;
+}
+
+void civ_shard_exchange_destroy(civ_shard_exchange_t *ex) {
+  if (!ex) return;
+  for (int32_t s = 0; s < CIV_SHARD_MAX; s++) CIV_FREE(ex->outbox[s].items);
+  CIV_FREE(ex->delivered.items);
+  CIV_FREE(ex);
+}
+
+civ_result_t civ_shard_exchange_post(civ_shard_exchange_t *ex,
+                                     const civ_shard_message_t *msg) {
+  if (!ex || !msg || msg->kind >= CIV_SHARD_MSG_KIND_COUNT ||
+      msg->from >= ex->shard_count || msg->to >= ex->shard_count)
+    return error_result(CIV_ERROR_INVALID_ARGUMENT, "Invalid shard message");
+  message_list_t *out = &ex->outbox[msg->from];
+  if (!list_reserve(out, out->count + 1))
+    return error_result(CIV_ERROR_OUT_OF_MEMORY, "Shard outbox full");
+  civ_shard_message_t *m = &out->items[out->count];
+  *m = *msg;
+  m->reserved = 0;
+  m->seq = (uint32_t)out->count++;
+  return ok_result();
+}
+
+static int cmp_delivery(const void *a, const void *b) {
+  const civ_shard_message_t *x = a, *y = b;
+  if (x->to != y->to) return (int)x->to - (int)y->to;
+  if (x->from != y->from) return (int)x->from - (int)y->from;
+  return (x->seq > y->seq) - (x->seq < y->seq);
+}
+
+size_t civ_shard_exchange_deliver(civ_shard_exchange_t *ex) {
+  if (!ex) return 0;
+  size_t total = 0;
+  for (int32_t s = 0; s < ex->shard_count; s++) total += ex->outbox[s].count;
+  ex->delivered.count = 0;
+  if (!list_reserve(&ex->delivered, total)) total = 0;
+  for (int32_t s = 0; s < ex->shard_count && total; s++) {
+    message_list_t *out = &ex->outbox[s];
+    memcpy(ex->delivered.items + ex->delivered.count, out->items,
+           out->count * sizeof(civ_shard_message_t));
+    ex->delivered.count += out->count;
+  }
+  for (int32_t s = 0; s < ex->shard_count; s++) ex->outbox[s].count = 0;
+  qsort(ex->delivered.items, total, sizeof(civ_shard_message_t), cmp_delivery);
+
+  memset(ex->inbox_start, 0, sizeof(ex->inbox_start));
+  for (size_t i = 0; i < total; i++) {
+    const civ_shard_message_t *m = &ex->delivered.items[i];
+    ex->inbox_start[m->to + 1]++;
+    ex->stats.by_kind[m->kind]++;
+  }
+  for (int32_t s = 0; s < ex->shard_count; s++)
+    ex->inbox_start[s + 1] += ex->inbox_start[s];
+
+  ex->stats.messages += total;
+  ex->stats.bytes += total * sizeof(civ_shard_message_t);
+  ex->stats.last_turn = total;
+  ex->stats.peak_turn = MAX(ex->stats.peak_turn, total);
+  return total;
+}
+
+const civ_shard_message_t *civ_shard_exchange_inbox(
+    const civ_shard_exchange_t *ex, int32_t shard, size_t *count) {
+  if (count) *count = 0;
+  if (!ex || shard < 0 || shard >= ex->shard_count) return NULL;
+  if (count) *count = ex->inbox_start[shard + 1] - ex->inbox_start[shard];
+  return ex->delivered.items ? ex->delivered.items + ex->inbox_start[shard]
+                             : NULL;
+}
+
+void civ_shard_exchange_stats(const civ_shard_exchange_t *ex,
+                              civ_shard_exchange_stats_t *out) {
+  if (!out) return;
+  memset(out, 0, sizeof(*out));
+  if (ex) *out = ex->stats;
+}
@@ -0,0 +1,271 @@
+/**
+ * @file sim_thread.c
+ * @brief Fixed-timestep simulation thread with double-buffered snapshots
+ */
+
+#include "core/simulation_engine/sim_thread.h"
+#include "core/game.h"
+#include "core/simulation_engine/lockstep.h"
+#include "core/time_engine.h"
+#include "utils/frame_trace.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+struct civ_sim_thread {
+  civ_game_t        *game;
+  SDL_Thread        *thread;
+  SDL_AtomicInt      running;
+
+  /* Held for the duration of a tick; the render thread takes it to read
+     or mutate anything not covered by the snapshot. */
+  SDL_Mutex         *state_lock;
+
+  /* Pacing — guarded by ctl_lock so the UI can retune while we tick */
+  SDL_Mutex         *ctl_lock;
+  int                tick_hz;
+  double             days_per_second;
+
+  /* Turn accumulator, only touched under state_lock */
+  double             day_accumulator;
+
+  /* Double-buffered snapshot: writer fills back, then swaps under snap_lock */
+  SDL_Mutex         *snap_lock;
+  civ_sim_snapshot_t snapshots[2];
+  int                front;
+  bool               has_snapshot;
+
+  /* Post-tick hook, only touched under state_lock */
+  civ_sim_tick_hook_t tick_hook;
+  void              *tick_hook_data;
+
+  uint64_t           next_tick;        /* due time of the next tick, ns */
+  uint64_t           tick_count;
+  uint64_t           dropped_ticks;
+  double             avg_tick_ms;
+};
+
+static int clamp_tick_hz(int hz) {
+  if (hz < CIV_SIM_MIN_TICK_HZ) return CIV_SIM_DEFAULT_TICK_HZ;
+  if (hz > CIV_SIM_MAX_TICK_HZ) return CIV_SIM_MAX_TICK_HZ;
+  return hz;
+}
+
+/* ── Lifecycle ─────────────────────────────────────────────────────── */
+civ_sim_thread_t *civ_sim_thread_create(civ_game_t *game, int tick_hz) {
+  if (!game) return NULL;
+  civ_sim_thread_t *sim = CIV_CALLOC(1, sizeof(*sim));
+  if (!sim) return NULL;
+
+  sim->game = game;
+  sim->tick_hz = clamp_tick_hz(tick_hz);
+  sim->state_lock = SDL_CreateMutex();
+  sim->ctl_lock = SDL_CreateMutex();
+  sim->snap_lock = SDL_CreateMutex();
+  if (!sim->state_lock || !sim->ctl_lock || !sim->snap_lock) {
+    civ_sim_thread_destroy(sim);
+    return NULL;
+  }
+  SDL_SetAtomicInt(&sim->running, 0);
+  return sim;
+}
+
+void civ_sim_thread_destroy(civ_sim_thread_t *sim) {
+  if (!sim) return;
+  civ_sim_thread_stop(sim);
+  if (sim->state_lock) SDL_DestroyMutex(sim->state_lock);
+  if (sim->ctl_lock)   SDL_DestroyMutex(sim->ctl_lock);
+  if (sim->snap_lock)  SDL_DestroyMutex(sim->snap_lock);
+  CIV_FREE(sim);
+}
+
+/* ── Tick ──────────────────────────────────────────────────────────── */
+static void publish_snapshot(civ_sim_thread_t *sim, double tick_ms) {
+  civ_game_t *game = sim->game;
+
+  SDL_LockMutex(sim->snap_lock);
+  civ_sim_snapshot_t *back = &sim->snapshots[sim->front ^ 1];
+  SDL_UnlockMutex(sim->snap_lock);
+
+  memset(back, 0, sizeof(*back));
+  back->tick = sim->tick_count;
+  back->turn = game->current_turn;
+  back->global_economy = game->global_economy;
+  back->last_tick_ms = tick_ms;
+  back->avg_tick_ms = sim->avg_tick_ms;
+  back->dropped_ticks = sim->dropped_ticks;
+  back->player_nation_index = -1;
+
+  if (game->time_engine) {
+    civ_time_engine_t *te = (civ_time_engine_t *)game->time_engine;
+    back->global_year = te->global.global_year;
+    back->global_day = te->global.global_day;
+  }
+  if (game->nation_manager) {
+    civ_nation_manager_t *nm = (civ_nation_manager_t *)game->nation_manager;
+    int pi = nm->player_nation_index;
+    if (pi >= 0 && pi < nm->count) {
+      back->player_nation_index = pi;
+      back->player_economy = nm->nations[pi].economy;
+    }
+  }
+
+  SDL_LockMutex(sim->snap_lock);
+  sim->front ^= 1;
+  sim->has_snapshot = true;
+  SDL_UnlockMutex(sim->snap_lock);
+}
+
+static void run_tick(civ_sim_thread_t *sim, double days) {
+  uint64_t start = SDL_GetTicksNS();
+
+  SDL_LockMutex(sim->state_lock);
+  if (days > 0.0 && sim->game->lockstep) {
+    /* The session paces updates and turn ends so every peer agrees */
+    civ_lockstep_advance(sim->game->lockstep);
+  } else if (days > 0.0) {
+    civ_game_update(sim->game);
+    sim->day_accumulator += days;
+    while (sim->day_accumulator >= CIV_SIM_DAYS_PER_TURN) {
+      sim->day_accumulator -= CIV_SIM_DAYS_PER_TURN;
+      civ_game_end_turn(sim->game);
+    }
+  }
+  sim->tick_count++;
+  civ_frame_trace_count(CIV_FRAME_SIM_TICKS, 1);
+
+  double tick_ms = (double)(SDL_GetTicksNS() - start) / 1000000.0;
+  sim->avg_tick_ms = sim->tick_count == 1
+      ? tick_ms : sim->avg_tick_ms * 0.9 + tick_ms * 0.1;
+  /* Snapshot reads game state, so build it before releasing the lock */
+  publish_snapshot(sim, tick_ms);
+  if (sim->tick_hook)
+    sim->tick_hook(sim->game, sim->tick_hook_data);
+  SDL_UnlockMutex(sim->state_lock);
+}
+
+void civ_sim_thread_set_tick_hook(civ_sim_thread_t *sim, civ_sim_tick_hook_t hook,
+                                  void *user_data) {
+  if (!sim) return;
+  sim->tick_hook = hook;
+  sim->tick_hook_data = user_data;
+}
+
+void civ_sim_thread_step(civ_sim_thread_t *sim, double days) {
+  if (!sim || SDL_GetAtomicInt(&sim->running)) return;
+  run_tick(sim, days);
+}
+
+/* Run the ticks due by now, advancing *next_tick. Catch up a bounded
+   number; beyond that, drop the debt so a hitch never turns into a
+   permanent spiral of back-to-back ticks. */
+static void run_due_ticks(civ_sim_thread_t *sim, uint64_t *next_tick) {
+  SDL_LockMutex(sim->ctl_lock);
+  uint64_t period = 1000000000ull / (uint64_t)sim->tick_hz;
+  double days = sim->days_per_second / (double)sim->tick_hz;
+  SDL_UnlockMutex(sim->ctl_lock);
+
+  uint64_t now = SDL_GetTicksNS();
+  int ran = 0;
+  while (now >= *next_tick && ran < CIV_SIM_MAX_CATCHUP_TICKS) {
+    /* A stopping thread leaves the rest of the debt */
+    if (sim->thread && !SDL_GetAtomicInt(&sim->running)) return;
+    run_tick(sim, days);
+    *next_tick += period;
+    ran++;
+    now = SDL_GetTicksNS();
+  }
+  if (now >= *next_tick) {
+    sim->dropped_ticks += (now - *next_tick) / period + 1;
+    *next_tick = now + period;
+  }
+}
+
+void civ_sim_thread_pump(civ_sim_thread_t *sim) {
+  if (!sim || SDL_GetAtomicInt(&sim->running)) return;
+  if (sim->next_tick == 0) sim->next_tick = SDL_GetTicksNS();
+  run_due_ticks(sim, &sim->next_tick);
+}
+
+static int sim_thread_main(void *arg) {
+  civ_sim_thread_t *sim = (civ_sim_thread_t *)arg;
+  sim->next_tick = SDL_GetTicksNS();
+
+  while (SDL_GetAtomicInt(&sim->running)) {
+    uint64_t now = SDL_GetTicksNS();
+    if (now < sim->next_tick) {
+      SDL_DelayNS(sim->next_tick - now);
+      continue;
+    }
+    run_due_ticks(sim, &sim->next_tick);
+  }
+  return 0;
+}
+
+bool civ_sim_thread_start(civ_sim_thread_t *sim) {
+  if (!sim) return false;
+  if (SDL_GetAtomicInt(&sim->running)) return true;
+  SDL_SetAtomicInt(&sim->running, 1);
+  sim->thread = SDL_CreateThread(sim_thread_main, "civ_sim", sim);
+  if (!sim->thread) {
+    SDL_SetAtomicInt(&sim->running, 0);
+    fprintf(stderr, "[SIM] Failed to start simulation thread: %s\n",
+            SDL_GetError());
+    return false;
+  }
+  printf("[SIM] Simulation thread started at %d Hz\n",
+         civ_sim_thread_get_tick_rate(sim));
+  return true;
+}
+
+void civ_sim_thread_stop(civ_sim_thread_t *sim) {
+  if (!sim || !sim->thread) return;
+  SDL_SetAtomicInt(&sim->running, 0);
+  SDL_WaitThread(sim->thread, NULL);
+  sim->thread = NULL;
+}
+
+bool civ_sim_thread_is_running(const civ_sim_thread_t *sim) {
+  return sim && SDL_GetAtomicInt((SDL_AtomicInt *)&sim->running) != 0;
+}
+
+/* ── Pacing ────────────────────────────────────────────────────────── */
+void civ_sim_thread_set_tick_rate(civ_sim_thread_t *sim, int tick_hz) {
+  if (!sim) return;
+  SDL_LockMutex(sim->ctl_lock);
+  sim->tick_hz = clamp_tick_hz(tick_hz);
+  SDL_UnlockMutex(sim->ctl_lock);
+}
+
+int civ_sim_thread_get_tick_rate(const civ_sim_thread_t *sim) {
+  if (!sim) return 0;
+  SDL_LockMutex(sim->ctl_lock);
+  int hz = sim->tick_hz;
+  SDL_UnlockMutex(sim->ctl_lock);
+  return hz;
+}
+
+void civ_sim_thread_set_days_per_second(civ_sim_thread_t *sim, double days) {
+  if (!sim) return;
+  SDL_LockMutex(sim->ctl_lock);
+  sim->days_per_second = days > 0.0 ? days : 0.0;
+  SDL_UnlockMutex(sim->ctl_lock);
+}
+
+/* ── State access ──────────────────────────────────────────────────── */
+void civ_sim_thread_lock(civ_sim_thread_t *sim) {
+  if (sim) SDL_LockMutex(sim->state_lock);
+}
+
+void civ_sim_thread_unlock(civ_sim_thread_t *sim) {
+  if (sim) SDL_UnlockMutex(sim->state_lock);
+}
+
+bool civ_sim_thread_get_snapshot(civ_sim_thread_t *sim, civ_sim_snapshot_t *out) {
+  if (!sim || !out) return false;
+  SDL_LockMutex(sim->snap_lock);
+  bool ok = sim->has_snapshot;
+  if (ok) *out = sim->snapshots[sim->front];
+  SDL_UnlockMutex(sim->snap_lock);
+  return ok;
+}
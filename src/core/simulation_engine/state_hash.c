@@ -0,0 +1,375 @@
+/**
+ * @file state_hash.c
+ * @brief Per-turn, per-subsystem world state hashes
+ */
+
+#include "core/simulation_engine/state_hash.h"
+#include "core/game.h"
+#include "utils/store_registry.h"
+#include <inttypes.h>
+#include <string.h>
+
+#define FNV_OFFSET 14695981039346656037ull
+#define FNV_PRIME  1099511628211ull
+
+static const char *const PART_NAMES[CIV_STATE_HASH_PART_COUNT] = {
+#define CIV_STATE_HASH_NAME(id, column) column,
+    CIV_STATE_HASH_PARTS(CIV_STATE_HASH_NAME)
+#undef CIV_STATE_HASH_NAME
+};
+
+static civ_result_t ok_result(void) {
+  civ_result_t res = {CIV_OK, NULL};
+  return res;
+}
+
+static civ_result_t error_result(civ_error_t code, const char *msg) {
+  civ_result_t res = {code, msg};
+  return res;
+}
+
+static uint64_t fnv_mix(uint64_t h, const void *data, size_t n) {
+  const uint8_t *p = (const uint8_t *)data;
+  for (size_t i = 0; i < n; i++) {
+    h ^= p[i];
+    h *= FNV_PRIME;
+  }
+  return h;
+}
+
+#define MIX(h, v) ((h) = fnv_mix((h), &(v), sizeof(v)))
+
+/* Spread a region hash by its index so the regions sum order-free */
+static uint64_t region_term(size_t region, uint64_t h) {
+  uint64_t z = h + (uint64_t)region * 0x9E3779B97F4A7C15ull;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+const char *civ_state_hash_part_name(civ_state_hash_part_t part) {
+  return (unsigned)part < CIV_STATE_HASH_PART_COUNT ? PART_NAMES[part] : "?";
+}
+
+civ_state_hash_t *civ_state_hash_create(void) {
+  civ_state_hash_t *sh = CIV_CALLOC(1, sizeof(*sh));
+  if (!sh)
+    return NULL;
+  sh->capacity = 64;
+  sh->records = CIV_MALLOC(sh->capacity * sizeof(*sh->records));
+  if (!sh->records) {
+    CIV_FREE(sh);
+    return NULL;
+  }
+  CIV_STORE_REGISTER("history.state_hashes", sh, sh->count, sh->capacity,
+                     sizeof(civ_state_hash_record_t), CIV_STORE_APPEND);
+  return sh;
+}
+
+void civ_state_hash_destroy(civ_state_hash_t *sh) {
+  if (!sh)
+    return;
+  civ_store_unregister_owner(sh);
+  CIV_FREE(sh->region_hash);
+  CIV_FREE(sh->region_revision);
+  CIV_FREE(sh->records);
+  CIV_FREE(sh);
+}
+
+/* ── Tiles ──────────────────────────────────────────────────────────── */
+
+static uint64_t hash_region(const civ_map_t *map, size_t region) {
+  int32_t rx = (int32_t)(region % (size_t)map->region_cols);
+  int32_t ry = (int32_t)(region / (size_t)map->region_cols);
+  int32_t x0 = rx << CIV_MAP_REGION_SHIFT, y0 = ry << CIV_MAP_REGION_SHIFT;
+  int32_t x1 = MIN(x0 + CIV_MAP_REGION_SIZE, map->width);
+  int32_t y1 = MIN(y0 + CIV_MAP_REGION_SIZE, map->height);
+  uint64_t h = FNV_OFFSET;
+  for (int32_t y = y0; y < y1; y++) {
+    const civ_map_tile_t *t = &map->tiles[(size_t)y * map->width + x0];
+    for (int32_t x = x0; x < x1; x++, t++) {
+      /* Field by field: the struct has padding */
+      MIX(h, t->elevation);
+      MIX(h, t->fertility);
+      MIX(h, t->resources);
+      MIX(h, t->political_influence);
+      MIX(h, t->population_density);
+      MIX(h, t->cultural_influence);
+      MIX(h, t->terrain);
+      MIX(h, t->land_use);
+      MIX(h, t->owner_index);
+      uint8_t fog = (uint8_t)(t->is_explored | t->is_visible << 1);
+      MIX(h, fog);
+    }
+  }
+  return h;
+}
+
+/* Rehash the regions whose revision moved; all of them for a new map */
+static bool update_tiles(civ_state_hash_t *sh, const civ_map_t *map) {
+  sh->regions_rehashed = 0;
+  if (!map || !map->tiles || !map->region_revision) {
+    sh->tile_hash = 0;
+    return true;
+  }
+  size_t regions = (size_t)map->region_cols * map->region_rows;
+  bool fresh = sh->map_serial != map->serial || sh->region_count != regions;
+  if (fresh) {
+    uint64_t *hashes = CIV_REALLOC(sh->region_hash, regions * sizeof(*hashes));
+    if (!hashes)
+      return false;
+    sh->region_hash = hashes;
+    uint32_t *revs =
+        CIV_REALLOC(sh->region_revision, regions * sizeof(*revs));
+    if (!revs)
+      return false;
+    sh->region_revision = revs;
+    sh->region_count = regions;
+    sh->map_serial = map->serial;
+    sh->tile_hash = 0;
+  }
+  for (size_t r = 0; r < regions; r++) {
+    if (!fresh && sh->region_revision[r] == map->region_revision[r])
+      continue;
+    uint64_t h = hash_region(map, r);
+    if (!fresh)
+      sh->tile_hash -= region_term(r, sh->region_hash[r]);
+    sh->tile_hash += region_term(r, h);
+    sh->region_hash[r] = h;
+    sh->region_revision[r] = map->region_revision[r];
+    sh->regions_rehashed++;
+  }
+  return true;
+}
+
+bool civ_state_hash_verify_tiles(const civ_state_hash_t *sh,
+                                 const civ_map_t *map) {
+  if (!sh || !map || !map->region_revision || sh->map_serial != map->serial)
+    return true;
+  uint64_t full = 0;
+  for (size_t r = 0; r < sh->region_count; r++)
+    full += region_term(r, hash_region(map, r));
+  return full == sh->tile_hash;
+}
+
+/* ── Entities ───────────────────────────────────────────────────────── */
+
+static uint64_t hash_nations(const civ_nation_manager_t *nm) {
+  uint64_t h = FNV_OFFSET;
+  if (!nm)
+    return h;
+  MIX(h, nm->count);
+  for (int i = 0; i < nm->count; i++) {
+    const civ_nation_t *n = &nm->nations[i];
+    MIX(h, n->owner_index);
+    MIX(h, n->population);
+    MIX(h, n->gdp_per_capita);
+    MIX(h, n->cost_of_living);
+    h = fnv_mix(h, &n->economy, offsetof(civ_nation_economy_t, owned_land_tiles));
+    MIX(h, n->economy.owned_land_tiles);
+    MIX(h, n->economy.owned_water_tiles);
+    MIX(h, n->territory.land_tiles);
+    MIX(h, n->territory.total_fertility);
+  }
+  return h;
+}
+
+static uint64_t mix_government(uint64_t h, const civ_government_t *g) {
+  if (!g)
+    return h;
+  MIX(h, g->stability);
+  MIX(h, g->legitimacy);
+  MIX(h, g->efficiency);
+  MIX(h, g->budget_allocations);
+  MIX(h, g->faction_support);
+  MIX(h, g->stature_tier);
+  return h;
+}
+
+static uint64_t hash_governments(const civ_game_t *game) {
+  uint64_t h = mix_government(FNV_OFFSET, game->government);
+  const civ_nation_manager_t *nm = game->nation_manager;
+  for (int i = 0; nm && i < nm->count; i++)
+    h = mix_government(h, nm->nations[i].government);
+  return h;
+}
+
+static uint64_t hash_markets(const civ_game_t *game) {
+  uint64_t h = FNV_OFFSET;
+  const civ_commodity_market_t *cm = game->commodity_market;
+  if (cm && cm->grid.price) {
+    size_t n = cm->grid.region_count * cm->grid.commodity_count;
+    h = fnv_mix(h, cm->grid.price, n * sizeof(civ_float_t));
+    h = fnv_mix(h, cm->grid.net_export, n * sizeof(civ_float_t));
+  }
+  const civ_market_engine_t *me = game->market;
+  if (me) {
+    for (int i = 0; i < me->currency_count; i++)
+      MIX(h, me->currencies[i].current_rate);
+    for (int i = 0; i < me->commodity_count; i++)
+      MIX(h, me->commodities[i].price_per_unit);
+  }
+  MIX(h, game->global_economy.gdp);
+  return h;
+}
+
+static uint64_t hash_units(const civ_unit_manager_t *um) {
+  uint64_t h = FNV_OFFSET;
+  if (!um)
+    return h;
+  MIX(h, um->unit_count);
+  h = fnv_mix(h, um->x, um->unit_count * sizeof(*um->x));
+  h = fnv_mix(h, um->y, um->unit_count * sizeof(*um->y));
+  h = fnv_mix(h, um->strength, um->unit_count * sizeof(*um->strength));
+  h = fnv_mix(h, um->owner, um->unit_count * sizeof(*um->owner));
+  for (size_t i = 0; i < um->unit_count; i++)
+    MIX(h, um->units[i].unit_type);
+  return h;
+}
+
+static uint64_t hash_settlements(const civ_settlement_manager_t *sm) {
+  uint64_t h = FNV_OFFSET;
+  if (!sm)
+    return h;
+  MIX(h, sm->settlement_count);
+  for (size_t i = 0; i < sm->settlement_count; i++) {
+    const civ_settlement_t *s = &sm->settlements[i];
+    MIX(h, s->population);
+    MIX(h, s->tier);
+    MIX(h, s->loyalty);
+    MIX(h, s->production_type);
+    MIX(h, s->production_progress);
+    MIX(h, s->region_sym);
+  }
+  return h;
+}
+
+civ_result_t civ_state_hash_record(civ_state_hash_t *sh,
+                                   const civ_game_t *game) {
+  if (!sh || !game)
+    return error_result(CIV_ERROR_NULL_POINTER, "Null state hash argument");
+  if (sh->count == sh->capacity) {
+    civ_state_hash_record_t *grown =
+        CIV_REALLOC(sh->records, sh->capacity * 2 * sizeof(*grown));
+    if (!grown)
+      return error_result(CIV_ERROR_OUT_OF_MEMORY, "State hash history");
+    sh->records = grown;
+    sh->capacity *= 2;
+  }
+  if (!update_tiles(sh, game->world_map))
+    return error_result(CIV_ERROR_OUT_OF_MEMORY, "State hash regions");
+
+  civ_state_hash_record_t *rec = &sh->records[sh->count++];
+  rec->turn = game->current_turn;
+  rec->part[CIV_STATE_HASH_TILES] = sh->tile_hash;
+  rec->part[CIV_STATE_HASH_NATIONS] = hash_nations(game->nation_manager);
+  rec->part[CIV_STATE_HASH_GOVERNMENTS] = hash_governments(game);
+  rec->part[CIV_STATE_HASH_MARKETS] = hash_markets(game);
+  rec->part[CIV_STATE_HASH_UNITS] = hash_units(game->unit_manager);
+  rec->part[CIV_STATE_HASH_SETTLEMENTS] =
+      hash_settlements(game->settlement_manager);
+  return ok_result();
+}
+
+/* ── History files ──────────────────────────────────────────────────── */
+
+civ_result_t civ_state_hash_export(const civ_state_hash_t *sh,
+                                   const char *path) {
+  if (!sh || !path)
+    return error_result(CIV_ERROR_NULL_POINTER, "Null state hash argument");
+  FILE *f = fopen(path, "w");
+  if (!f)
+    return error_result(CIV_ERROR_IO, "Cannot write state hashes");
+  fputs("turn", f);
+  for (int p = 0; p < CIV_STATE_HASH_PART_COUNT; p++)
+    fprintf(f, ",%s", PART_NAMES[p]);
+  fputc('\n', f);
+  for (size_t i = 0; i < sh->count; i++) {
+    fprintf(f, "%d", (int)sh->records[i].turn);
+    for (int p = 0; p < CIV_STATE_HASH_PART_COUNT; p++)
+      fprintf(f, ",%016" PRIx64, sh->records[i].part[p]);
+    fputc('\n', f);
+  }
+  bool ok = !ferror(f);
+  fclose(f);
+  return ok ? ok_result()
+            : error_result(CIV_ERROR_IO, "Cannot write state hashes");
+}
+
+civ_state_hash_t *civ_state_hash_load(const char *path) {
+  FILE *f = path ? fopen(path, "r") : NULL;
+  if (!f)
+    return NULL;
+  civ_state_hash_t *sh = civ_state_hash_create();
+  char line[512];
+  /* The header names the columns; a history from a build with other parts
+     cannot be compared column for column */
+  bool ok = sh && fgets(line, sizeof(line), f) &&
+            strncmp(line, "turn,", 5) == 0;
+  for (int p = 0; ok && p < CIV_STATE_HASH_PART_COUNT; p++)
+    ok = strstr(line, PART_NAMES[p]) != NULL;
+
+  while (ok && fgets(line, sizeof(line), f)) {
+    civ_state_hash_record_t rec;
+    char *s = line, *end;
+    rec.turn = (int32_t)strtol(s, &end, 10);
+    bool row = end != s;
+    for (int p = 0; row && p < CIV_STATE_HASH_PART_COUNT; p++) {
+      s = end;
+      row = *s == ',';
+      if (row) {
+        rec.part[p] = strtoull(s + 1, &end, 16);
+        row = end != s + 1;
+      }
+    }
+    if (!row)
+      break;
+    if (sh->count == sh->capacity) {
+      civ_state_hash_record_t *grown =
+          CIV_REALLOC(sh->records, sh->capacity * 2 * sizeof(*grown));
+      if (!grown)
+        break;
+      sh->records = grown;
+      sh->capacity *= 2;
+    }
+    sh->records[sh->count++] = rec;
+  }
+  fclose(f);
+  if (!ok) {
+    civ_state_hash_destroy(sh);
+    return NULL;
+  }
+  return sh;
+}
+
+bool civ_state_hash_compare(const civ_state_hash_t *a,
+                            const civ_state_hash_t *b, int32_t *turn,
+                            civ_state_hash_part_t *part) {
+  if (!a || !b)
+    return false;
+  /* Both histories are in turn order; walk them together */
+  size_t i = 0, j = 0;
+  while (i < a->count && j < b->count) {
+    const civ_state_hash_record_t *ra = &a->records[i], *rb = &b->records[j];
+    if (ra->turn < rb->turn) {
+      i++;
+      continue;
+    }
+    if (rb->turn < ra->turn) {
+      j++;
+      continue;
+    }
+    for (int p = 0; p < CIV_STATE_HASH_PART_COUNT; p++) {
+      if (ra->part[p] != rb->part[p]) {
+        if (turn)
+          *turn = ra->turn;
+        if (part)
+          *part = (civ_state_hash_part_t)p;
+        return true;
+      }
+    }
+    i++;
+    j++;
+  }
+  return false;
+}
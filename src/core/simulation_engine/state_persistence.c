@@ -5,6 +5,7 @@
 
 #include "core/simulation_engine/state_persistence.h"
 #include "common.h"
+#include "utils/frame_trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -42,7 +43,7 @@ void civ_state_persistence_init(civ_state_persistence_t *sp,
       strcpy(sp->save_directory, save_directory);
     }
   }
-  sp->compression_enabled = false;
+  sp->compression_enabled = true;
   sp->encryption_enabled = false;
 }
 
@@ -74,6 +75,7 @@ civ_result_t civ_state_persistence_save(civ_state_persistence_t *sp,
 
   size_t written = fwrite(data, 1, data_size, file);
   fclose(file);
+  civ_frame_trace_count(CIV_FRAME_BYTES_WRITTEN, written);
 
   if (written != data_size) {
     result.error = CIV_ERROR_IO;
@@ -146,3 +148,505 @@ civ_result_t civ_state_persistence_list_saves(civ_state_persistence_t *sp,
   return (civ_result_t){.error = CIV_ERROR_INVALID_STATE,
                         .message = "Not implemented"};
 }
+
+/* ── LZ codec ──────────────────────────────────────────────────────── */
+
+#define LZ_HASH_BITS  12
+#define LZ_MIN_MATCH  4
+#define LZ_MAX_OFFSET 65535
+#define LZ_LAST_LITERALS 5   /* a block always ends in literals */
+#define LZ_MATCH_LIMIT   12  /* no match starts this close to the end */
+
+static uint32_t lz_read32(const uint8_t *p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static uint32_t lz_hash(uint32_t v) {
+  return (v * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+static uint8_t *lz_put_length(uint8_t *op, size_t n) {
+  for (; n >= 255; n -= 255) *op++ = 255;
+  *op++ = (uint8_t)n;
+  return op;
+}
+
+size_t civ_lz_bound(size_t size) { return size + size / 255 + 16; }
+
+/* Worst-case bytes for one sequence of lit literals and an mlen match */
+static size_t lz_sequence_size(size_t lit, size_t mlen) {
+  return 1 + lit / 255 + 1 + lit + 2 + mlen / 255 + 1;
+}
+
+size_t civ_lz_compress(const uint8_t *src, size_t size, uint8_t *dst,
+                       size_t capacity) {
+  if (!src || !dst) return 0;
+  uint32_t table[1 << LZ_HASH_BITS]; /* position + 1, 0 = empty */
+  memset(table, 0, sizeof(table));
+
+  const uint8_t *ip = src, *anchor = src, *end = src + size;
+  const uint8_t *match_limit = size > LZ_MATCH_LIMIT ? end - LZ_MATCH_LIMIT : src;
+  uint8_t *op = dst, *oend = dst + capacity;
+  unsigned misses = 0;
+
+  while (ip < match_limit) {
+    uint32_t h = lz_hash(lz_read32(ip));
+    const uint8_t *ref = table[h] ? src + table[h] - 1 : NULL;
+    table[h] = (uint32_t)(ip - src) + 1;
+    if (!ref || ip - ref > LZ_MAX_OFFSET || lz_read32(ref) != lz_read32(ip)) {
+      /* Stride grows over incompressible data */
+      ip += 1 + (misses++ >> 6);
+      continue;
+    }
+    misses = 0;
+
+    size_t mlen = LZ_MIN_MATCH;
+    while (ip + mlen < end - LZ_LAST_LITERALS && ref[mlen] == ip[mlen]) mlen++;
+    size_t lit = (size_t)(ip - anchor);
+    if (lz_sequence_size(lit, mlen) > (size_t)(oend - op)) return 0;
+
+    size_t mcode = mlen - LZ_MIN_MATCH;
+    uint8_t *token = op++;
+    *token = (uint8_t)((lit >= 15 ? 15 : lit) << 4 | (mcode >= 15 ? 15 : mcode));
+    if (lit >= 15) op = lz_put_length(op, lit - 15);
+    memcpy(op, anchor, lit);
+    op += lit;
+    size_t offset = (size_t)(ip - ref);
+    *op++ = (uint8_t)(offset & 0xFF);
+    *op++ = (uint8_t)(offset >> 8);
+    if (mcode >= 15) op = lz_put_length(op, mcode - 15);
+
+    ip += mlen;
+    anchor = ip;
+    if (ip < match_limit)
+      table[lz_hash(lz_read32(ip - 2))] = (uint32_t)(ip - 2 - src) + 1;
+  }
+
+  size_t lit = (size_t)(end - anchor);
+  if (1 + lit / 255 + 1 + lit > (size_t)(oend - op)) return 0;
+  uint8_t *token = op++;
+  *token = (uint8_t)((lit >= 15 ? 15 : lit) << 4);
+  if (lit >= 15) op = lz_put_length(op, lit - 15);
+  memcpy(op, anchor, lit);
+  op += lit;
+  return (size_t)(op - dst);
+}
+
+/* Extension bytes of a 15-valued length field; false if src runs out */
+static bool lz_get_length(const uint8_t **ip, const uint8_t *iend, size_t *n) {
+  uint8_t b;
+  do {
+    if (*ip >= iend) return false;
+    b = *(*ip)++;
+    *n += b;
+  } while (b == 255);
+  return true;
+}
+
+size_t civ_lz_decompress(const uint8_t *src, size_t size, uint8_t *dst,
+                         size_t capacity) {
+  if (!src || !dst) return 0;
+  const uint8_t *ip = src, *iend = src + size;
+  uint8_t *op = dst, *oend = dst + capacity;
+
+  while (ip < iend) {
+    uint8_t token = *ip++;
+    size_t lit = token >> 4;
+    if (lit == 15 && !lz_get_length(&ip, iend, &lit)) return 0;
+    if (lit > (size_t)(iend - ip) || lit > (size_t)(oend - op)) return 0;
+    memcpy(op, ip, lit);
+    op += lit;
+    ip += lit;
+    if (ip >= iend) break; /* the last sequence has no match */
+
+    if (iend - ip < 2) return 0;
+    size_t offset = (size_t)ip[0] | (size_t)ip[1] << 8;
+    ip += 2;
+    if (offset == 0 || offset > (size_t)(op - dst)) return 0;
+    size_t mlen = token & 15;
+    if (mlen == 15 && !lz_get_length(&ip, iend, &mlen)) return 0;
+    mlen += LZ_MIN_MATCH;
+    if (mlen > (size_t)(oend - op)) return 0;
+    /* Byte copy: a match may overlap the bytes it produces */
+    const uint8_t *m = op - offset;
+    for (size_t i = 0; i < mlen; i++) op[i] = m[i];
+    op += mlen;
+  }
+  return (size_t)(op - dst);
+}
+
+/* ── Chunked container ─────────────────────────────────────────────── */
+
+/* Table of contents entry, as stored */
+typedef struct {
+  uint32_t tag;
+  uint32_t version;
+  uint64_t offset;      /* of the section's tag */
+  uint64_t size;        /* raw bytes */
+} save_toc_entry_t;
+
+/* Last bytes of a version 2 file */
+typedef struct {
+  uint64_t toc_offset;
+  uint32_t toc_count;
+  uint32_t magic;
+} save_footer_t;
+
+#define SAVE_TOC_MAGIC CIV_SAVE_TAG('C', 'T', 'O', 'C')
+
+struct civ_save_writer {
+  FILE *file;
+  bool compress;
+  bool in_section;
+  bool toc_lost;        /* out of memory for the table; file stays readable */
+  civ_result_t error;   /* first failure, CIV_OK while none */
+  uint64_t offset;      /* bytes written so far */
+  size_t fill;
+  uint8_t *raw;         /* CIV_SAVE_CHUNK_SIZE */
+  uint8_t *packed;      /* civ_lz_bound(CIV_SAVE_CHUNK_SIZE) */
+  save_toc_entry_t *toc;
+  size_t toc_count, toc_capacity;
+};
+
+struct civ_save_reader {
+  FILE *file;
+  uint32_t container_version;
+  uint32_t section_version;
+  bool in_section;
+  bool section_end;     /* empty chunk of the current section seen */
+  bool failed;
+  bool toc_loaded;      /* looked for, whether or not there was one */
+  size_t pos, fill;
+  uint8_t *raw;
+  uint8_t *packed;
+  save_toc_entry_t *toc;
+  size_t toc_count;
+};
+
+static void writer_fail(civ_save_writer_t *w, const char *message) {
+  if (w->error.error == CIV_OK)
+    w->error = (civ_result_t){CIV_ERROR_IO, message};
+}
+
+static void writer_put(civ_save_writer_t *w, const void *data, size_t size) {
+  if (w->error.error == CIV_OK && fwrite(data, 1, size, w->file) != size)
+    writer_fail(w, "Write incomplete");
+  civ_frame_trace_count(CIV_FRAME_BYTES_WRITTEN, size);
+  w->offset += size;
+}
+
+/* Emit the buffered bytes as one chunk: raw size, stored size, payload */
+static void writer_flush_chunk(civ_save_writer_t *w) {
+  if (w->fill == 0) return;
+  uint32_t header[2] = {(uint32_t)w->fill, (uint32_t)w->fill};
+  const uint8_t *payload = w->raw;
+  if (w->compress) {
+    size_t n = civ_lz_compress(w->raw, w->fill, w->packed,
+                               civ_lz_bound(CIV_SAVE_CHUNK_SIZE));
+    if (n > 0 && n < w->fill) {
+      header[1] = (uint32_t)n;
+      payload = w->packed;
+    }
+  }
+  writer_put(w, header, sizeof(header));
+  writer_put(w, payload, header[1]);
+  w->fill = 0;
+}
+
+civ_save_writer_t *civ_save_writer_open(const char *path, bool compress) {
+  if (!path) return NULL;
+  civ_save_writer_t *w =
+      (civ_save_writer_t *)CIV_CALLOC(1, sizeof(civ_save_writer_t));
+  if (!w) return NULL;
+  w->raw = (uint8_t *)CIV_MALLOC(CIV_SAVE_CHUNK_SIZE);
+  w->packed = compress ? (uint8_t *)CIV_MALLOC(civ_lz_bound(CIV_SAVE_CHUNK_SIZE))
+                       : NULL;
+  w->file = fopen(path, "wb");
+  if (!w->raw || (compress && !w->packed) || !w->file) {
+    if (w->file) fclose(w->file);
+    CIV_FREE(w->raw);
+    CIV_FREE(w->packed);
+    CIV_FREE(w);
+    return NULL;
+  }
+  w->compress = compress;
+  w->error = (civ_result_t){CIV_OK, NULL};
+  uint32_t header[2] = {CIV_SAVE_CONTAINER_MAGIC, CIV_SAVE_CONTAINER_VERSION};
+  writer_put(w, header, sizeof(header));
+  return w;
+}
+
+void civ_save_writer_begin_section(civ_save_writer_t *w, uint32_t tag) {
+  civ_save_writer_begin_section_v(w, tag, 0);
+}
+
+void civ_save_writer_begin_section_v(civ_save_writer_t *w, uint32_t tag,
+                                     uint32_t version) {
+  if (!w) return;
+  if (w->in_section) civ_save_writer_end_section(w);
+  if (!w->toc_lost && w->toc_count == w->toc_capacity) {
+    size_t cap = w->toc_capacity ? w->toc_capacity * 2 : 32;
+    save_toc_entry_t *toc =
+        (save_toc_entry_t *)CIV_REALLOC(w->toc, cap * sizeof(*toc));
+    if (toc) {
+      w->toc = toc;
+      w->toc_capacity = cap;
+    } else {
+      w->toc_lost = true;
+    }
+  }
+  if (!w->toc_lost)
+    w->toc[w->toc_count++] = (save_toc_entry_t){tag, version, w->offset, 0};
+  uint32_t head[2] = {tag, version};
+  writer_put(w, head, sizeof(head));
+  w->in_section = true;
+}
+
+void civ_save_writer_write(civ_save_writer_t *w, const void *data,
+                           size_t size) {
+  if (!w || !w->in_section || !data) return;
+  if (!w->toc_lost) w->toc[w->toc_count - 1].size += size;
+  const uint8_t *p = (const uint8_t *)data;
+  while (size > 0) {
+    size_t n = MIN(size, (size_t)CIV_SAVE_CHUNK_SIZE - w->fill);
+    memcpy(w->raw + w->fill, p, n);
+    w->fill += n;
+    p += n;
+    size -= n;
+    if (w->fill == CIV_SAVE_CHUNK_SIZE) writer_flush_chunk(w);
+  }
+}
+
+void civ_save_writer_end_section(civ_save_writer_t *w) {
+  if (!w || !w->in_section) return;
+  writer_flush_chunk(w);
+  uint32_t end[2] = {0, 0};
+  writer_put(w, end, sizeof(end));
+  w->in_section = false;
+}
+
+/* The table is a section of its own, left out of itself; readers going
+   through the file in order stop at it */
+static void writer_put_toc(civ_save_writer_t *w) {
+  save_footer_t footer = {w->offset, (uint32_t)w->toc_count, SAVE_TOC_MAGIC};
+  size_t count = w->toc_count;
+  w->toc_lost = true; /* stop recording */
+  civ_save_writer_begin_section(w, CIV_SAVE_TAG_TOC);
+  civ_save_writer_write(w, w->toc, count * sizeof(save_toc_entry_t));
+  civ_save_writer_end_section(w);
+  writer_put(w, &footer, sizeof(footer));
+}
+
+civ_result_t civ_save_writer_close(civ_save_writer_t *w) {
+  if (!w) return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null save writer"};
+  civ_save_writer_end_section(w);
+  if (!w->toc_lost) writer_put_toc(w);
+  if (fclose(w->file) != 0) writer_fail(w, "Write incomplete");
+  civ_result_t res = w->error;
+  CIV_FREE(w->raw);
+  CIV_FREE(w->packed);
+  CIV_FREE(w->toc);
+  CIV_FREE(w);
+  return res;
+}
+
+civ_save_reader_t *civ_save_reader_open(const char *path) {
+  if (!path) return NULL;
+  FILE *file = fopen(path, "rb");
+  if (!file) return NULL;
+  uint32_t header[2];
+  if (fread(header, 1, sizeof(header), file) != sizeof(header) ||
+      header[0] != CIV_SAVE_CONTAINER_MAGIC ||
+      header[1] > CIV_SAVE_CONTAINER_VERSION) {
+    fclose(file);
+    return NULL;
+  }
+  civ_save_reader_t *r =
+      (civ_save_reader_t *)CIV_CALLOC(1, sizeof(civ_save_reader_t));
+  if (r) {
+    r->raw = (uint8_t *)CIV_MALLOC(CIV_SAVE_CHUNK_SIZE);
+    r->packed = (uint8_t *)CIV_MALLOC(CIV_SAVE_CHUNK_SIZE);
+  }
+  if (!r || !r->raw || !r->packed) {
+    fclose(file);
+    if (r) {
+      CIV_FREE(r->raw);
+      CIV_FREE(r->packed);
+      CIV_FREE(r);
+    }
+    return NULL;
+  }
+  r->file = file;
+  r->container_version = header[1];
+  return r;
+}
+
+void civ_save_reader_close(civ_save_reader_t *r) {
+  if (!r) return;
+  fclose(r->file);
+  CIV_FREE(r->raw);
+  CIV_FREE(r->packed);
+  CIV_FREE(r->toc);
+  CIV_FREE(r);
+}
+
+/* Load the next chunk of the current section; when skip is set the
+   payload is seeked over rather than decoded */
+static bool reader_next_chunk(civ_save_reader_t *r, bool skip) {
+  r->pos = r->fill = 0;
+  if (r->section_end || r->failed) return false;
+  uint32_t header[2];
+  if (fread(header, 1, sizeof(header), r->file) != sizeof(header) ||
+      header[0] > CIV_SAVE_CHUNK_SIZE || header[1] > header[0]) {
+    r->failed = true;
+    return false;
+  }
+  if (header[0] == 0) {
+    r->section_end = true;
+    return false;
+  }
+  if (skip) {
+    if (fseek(r->file, (long)header[1], SEEK_CUR) != 0) r->failed = true;
+    return !r->failed;
+  }
+  bool packed = header[1] < header[0];
+  uint8_t *dst = packed ? r->packed : r->raw;
+  if (fread(dst, 1, header[1], r->file) != header[1] ||
+      (packed && civ_lz_decompress(r->packed, header[1], r->raw,
+                                   CIV_SAVE_CHUNK_SIZE) != header[0])) {
+    r->failed = true;
+    return false;
+  }
+  r->fill = header[0];
+  return true;
+}
+
+/* Read a section head at the file position and enter the section */
+static bool reader_enter(civ_save_reader_t *r, uint32_t *tag) {
+  uint32_t head[2] = {0, 0};
+  size_t head_size = r->container_version >= 2 ? sizeof(head) : sizeof(head[0]);
+  r->in_section = false;
+  if (fread(head, 1, head_size, r->file) != head_size)
+    return false; /* clean end of file */
+  if (head[0] == CIV_SAVE_TAG_TOC)
+    return false; /* the table ends the sections */
+  r->in_section = true;
+  r->section_end = false;
+  r->section_version = head[1];
+  r->pos = r->fill = 0;
+  if (tag) *tag = head[0];
+  return true;
+}
+
+bool civ_save_reader_next_section(civ_save_reader_t *r, uint32_t *tag) {
+  if (!r || r->failed) return false;
+  while (r->in_section && reader_next_chunk(r, true)) {}
+  if (r->failed) return false;
+  return reader_enter(r, tag);
+}
+
+/* Find and load the table of contents; a missing or damaged one leaves
+   lookups to scan */
+static void reader_load_toc(civ_save_reader_t *r) {
+  r->toc_loaded = true;
+  save_footer_t footer;
+  if (r->container_version < 2 ||
+      fseek(r->file, -(long)sizeof(footer), SEEK_END) != 0 ||
+      fread(&footer, 1, sizeof(footer), r->file) != sizeof(footer) ||
+      footer.magic != SAVE_TOC_MAGIC || footer.toc_count > (1u << 20) ||
+      fseek(r->file, (long)footer.toc_offset, SEEK_SET) != 0)
+    return;
+
+  uint32_t head[2];
+  size_t n = (size_t)footer.toc_count * sizeof(save_toc_entry_t);
+  save_toc_entry_t *toc =
+      (save_toc_entry_t *)CIV_MALLOC(n ? n : sizeof(save_toc_entry_t));
+  if (!toc || fread(head, 1, sizeof(head), r->file) != sizeof(head) ||
+      head[0] != CIV_SAVE_TAG_TOC) {
+    CIV_FREE(toc);
+    return;
+  }
+  r->in_section = true;
+  r->section_end = false;
+  r->pos = r->fill = 0;
+  if (civ_save_reader_read(r, toc, n) != n || r->failed) {
+    r->failed = false; /* a bad table only costs the shortcut */
+    CIV_FREE(toc);
+    return;
+  }
+  r->toc = toc;
+  r->toc_count = footer.toc_count;
+}
+
+bool civ_save_reader_find_section(civ_save_reader_t *r, uint32_t tag) {
+  if (!r || r->failed) return false;
+  if (!r->toc_loaded) reader_load_toc(r);
+  r->in_section = false;
+
+  if (r->toc) {
+    for (size_t i = 0; i < r->toc_count; i++) {
+      uint32_t t;
+      if (r->toc[i].tag != tag) continue;
+      return fseek(r->file, (long)r->toc[i].offset, SEEK_SET) == 0 &&
+             reader_enter(r, &t) && t == tag;
+    }
+    return false;
+  }
+  /* No table: walk the file from its first section */
+  if (fseek(r->file, 2 * sizeof(uint32_t), SEEK_SET) != 0) return false;
+  uint32_t t;
+  while (civ_save_reader_next_section(r, &t))
+    if (t == tag) return true;
+  return false;
+}
+
+uint32_t civ_save_reader_section_version(const civ_save_reader_t *r) {
+  return r && r->in_section ? r->section_version : 0;
+}
+
+size_t civ_save_reader_read(civ_save_reader_t *r, void *data, size_t size) {
+  if (!r || !r->in_section || !data) return 0;
+  uint8_t *p = (uint8_t *)data;
+  size_t got = 0;
+  while (got < size) {
+    if (r->pos == r->fill && !reader_next_chunk(r, false)) break;
+    size_t n = MIN(size - got, r->fill - r->pos);
+    memcpy(p + got, r->raw + r->pos, n);
+    r->pos += n;
+    got += n;
+  }
+  return got;
+}
+
+uint8_t *civ_save_reader_read_all(civ_save_reader_t *r, size_t *size) {
+  *size = 0;
+  size_t cap = 0, len = 0;
+  uint8_t *data = NULL;
+  for (;;) {
+    if (len == cap) {
+      size_t new_cap = cap ? cap * 2 : 64 * 1024;
+      uint8_t *grown = (uint8_t *)CIV_REALLOC(data, new_cap);
+      if (!grown) {
+        CIV_FREE(data);
+        return NULL;
+      }
+      data = grown;
+      cap = new_cap;
+    }
+    size_t got = civ_save_reader_read(r, data + len, cap - len);
+    len += got;
+    if (len < cap) break;
+  }
+  if (len == 0 || civ_save_reader_failed(r)) {
+    CIV_FREE(data);
+    return NULL;
+  }
+  *size = len;
+  return data;
+}
+
+bool civ_save_reader_failed(const civ_save_reader_t *r) {
+  return !r || r->failed;
+}
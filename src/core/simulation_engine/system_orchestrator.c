@@ -4,10 +4,37 @@
  */
 
 #include "core/simulation_engine/system_orchestrator.h"
+#include "core/simulation_engine/worker_pool.h"
 #include "common.h"
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
+
+static void free_order(civ_system_orchestrator_t* so) {
+    if (so->execution_order) {
+        for (size_t i = 0; i < so->order_count; i++) {
+            CIV_FREE(so->execution_order[i]);
+        }
+        CIV_FREE(so->execution_order);
+        so->execution_order = NULL;
+    }
+    CIV_FREE(so->order_index);
+    so->order_index = NULL;
+    so->order_count = 0;
+
+    for (size_t i = 0; i < so->system_count; i++) {
+        CIV_FREE(so->nodes[i].successors);
+        so->nodes[i].successors = NULL;
+        so->nodes[i].successor_count = 0;
+        so->nodes[i].indegree = 0;
+    }
+}
+
+static long find_node(const civ_system_orchestrator_t* so, const char* name) {
+    for (size_t i = 0; i < so->system_count; i++) {
+        if (strcmp(so->nodes[i].name, name) == 0) return (long)i;
+    }
+    return -1;
+}
 
 civ_system_orchestrator_t* civ_system_orchestrator_create(void) {
     civ_system_orchestrator_t* so = (civ_system_orchestrator_t*)CIV_MALLOC(sizeof(civ_system_orchestrator_t));
@@ -15,189 +42,377 @@ civ_system_orchestrator_t* civ_system_orchestrator_create(void) {
         civ_log(CIV_LOG_ERROR, "Failed to allocate system orchestrator");
         return NULL;
     }
-    
+
     civ_system_orchestrator_init(so);
     return so;
 }
 
 void civ_system_orchestrator_destroy(civ_system_orchestrator_t* so) {
     if (!so) return;
-    
+
+    civ_worker_pool_destroy((civ_worker_pool_t*)so->worker_pool);
+    free_order(so);
     CIV_FREE(so->systems);
-    if (so->execution_order) {
-        for (size_t i = 0; i < so->order_count; i++) {
-            CIV_FREE(so->execution_order[i]);
-        }
-        CIV_FREE(so->execution_order);
-    }
+    CIV_FREE(so->nodes);
     CIV_FREE(so);
 }
 
 void civ_system_orchestrator_init(civ_system_orchestrator_t* so) {
     if (!so) return;
-    
+
     memset(so, 0, sizeof(civ_system_orchestrator_t));
     so->system_capacity = 32;
     so->systems = (civ_updatable_t*)CIV_CALLOC(so->system_capacity, sizeof(civ_updatable_t));
+    so->nodes = (civ_system_node_t*)CIV_CALLOC(so->system_capacity, sizeof(civ_system_node_t));
     so->parallel_execution = false;
     so->max_workers = 4;
 }
 
-civ_result_t civ_system_orchestrator_register(civ_system_orchestrator_t* so, 
+civ_result_t civ_system_orchestrator_register(civ_system_orchestrator_t* so,
                                               const char* name, civ_updatable_t* updatable,
                                               const char** dependencies, size_t dep_count) {
     civ_result_t result = {CIV_OK, NULL};
-    
-    if (!so || !name || !updatable) {
+
+    if (!so || !name || !updatable || (dep_count > 0 && !dependencies)) {
         result.error = CIV_ERROR_NULL_POINTER;
         return result;
     }
-    
+    if (dep_count > CIV_ORCHESTRATOR_MAX_DEPS) {
+        result.error = CIV_ERROR_INVALID_ARGUMENT;
+        result.message = "Too many system dependencies";
+        return result;
+    }
+
     /* Check if already registered */
-    for (size_t i = 0; i < so->system_count; i++) {
-        if (so->systems[i].get_name && strcmp(so->systems[i].get_name(so->systems[i].system), name) == 0) {
-            result.error = CIV_ERROR_INVALID_STATE;
-            result.message = "System already registered";
-            return result;
-        }
+    if (find_node(so, name) >= 0) {
+        result.error = CIV_ERROR_INVALID_STATE;
+        result.message = "System already registered";
+        return result;
     }
-    
+
     /* Expand capacity if needed */
     if (so->system_count >= so->system_capacity) {
-        so->system_capacity *= 2;
-        so->systems = (civ_updatable_t*)CIV_REALLOC(so->systems, 
-                                                    so->system_capacity * sizeof(civ_updatable_t));
+        size_t new_capacity = so->system_capacity * 2;
+        civ_updatable_t* systems = (civ_updatable_t*)CIV_REALLOC(so->systems,
+                                                    new_capacity * sizeof(civ_updatable_t));
+        if (!systems) {
+            result.error = CIV_ERROR_OUT_OF_MEMORY;
+            return result;
+        }
+        so->systems = systems;
+        civ_system_node_t* nodes = (civ_system_node_t*)CIV_REALLOC(so->nodes,
+                                                    new_capacity * sizeof(civ_system_node_t));
+        if (!nodes) {
+            result.error = CIV_ERROR_OUT_OF_MEMORY;
+            return result;
+        }
+        so->nodes = nodes;
+        so->system_capacity = new_capacity;
     }
-    
+
     /* Register system */
+    civ_system_node_t* node = &so->nodes[so->system_count];
+    memset(node, 0, sizeof(*node));
+    strncpy(node->name, name, STRING_SHORT_LEN - 1);
+    for (size_t d = 0; d < dep_count; d++) {
+        strncpy(node->dependencies[d], dependencies[d], STRING_SHORT_LEN - 1);
+    }
+    node->dep_count = dep_count;
+    strncpy(node->status.name, name, STRING_SHORT_LEN - 1);
+    node->status.enabled = true;
+    node->status.health = 1.0f;
+    node->profile_id = civ_profiler_register(name);
+    node->perf_id = civ_performance_optimizer_register(so->optimizer, name);
     so->systems[so->system_count++] = *updatable;
-    
-    /* Recalculate execution order */
-    civ_system_orchestrator_calculate_order(so);
-    
+
+    /* Dependencies may name systems registered later; resolve lazily */
+    so->order_dirty = true;
+
     civ_log(CIV_LOG_INFO, "Registered system: %s", name);
-    
+
     return result;
 }
 
 void civ_system_orchestrator_unregister(civ_system_orchestrator_t* so, const char* name) {
     if (!so || !name) return;
-    
-    for (size_t i = 0; i < so->system_count; i++) {
-        if (so->systems[i].get_name && 
-            strcmp(so->systems[i].get_name(so->systems[i].system), name) == 0) {
-            /* Remove system */
-            memmove(&so->systems[i], &so->systems[i + 1], 
-                    (so->system_count - i - 1) * sizeof(civ_updatable_t));
-            so->system_count--;
-            
-            /* Recalculate order */
-            civ_system_orchestrator_calculate_order(so);
-            
-            civ_log(CIV_LOG_INFO, "Unregistered system: %s", name);
-            return;
-        }
-    }
+
+    long i = find_node(so, name);
+    if (i < 0) return;
+
+    free_order(so);
+    size_t tail = so->system_count - (size_t)i - 1;
+    memmove(&so->systems[i], &so->systems[i + 1], tail * sizeof(civ_updatable_t));
+    memmove(&so->nodes[i], &so->nodes[i + 1], tail * sizeof(civ_system_node_t));
+    so->system_count--;
+    so->order_dirty = true;
+
+    civ_log(CIV_LOG_INFO, "Unregistered system: %s", name);
 }
 
 civ_result_t civ_system_orchestrator_calculate_order(civ_system_orchestrator_t* so) {
     civ_result_t result = {CIV_OK, NULL};
-    
+
     if (!so) {
         result.error = CIV_ERROR_NULL_POINTER;
         return result;
     }
-    
-    /* Simple topological sort for dependency ordering */
-    /* In production, would use proper topological sort algorithm */
-    
-    /* Free old order */
-    if (so->execution_order) {
-        for (size_t i = 0; i < so->order_count; i++) {
-            CIV_FREE(so->execution_order[i]);
+
+    free_order(so);
+    so->order_dirty = false;
+    so->order_acyclic = true;
+    if (so->system_count == 0) return result;
+
+    size_t n = so->system_count;
+    size_t* resolved = (size_t*)CIV_CALLOC(n * CIV_ORCHESTRATOR_MAX_DEPS, sizeof(size_t));
+    size_t* resolved_count = (size_t*)CIV_CALLOC(n, sizeof(size_t));
+    size_t* indegree = (size_t*)CIV_CALLOC(n, sizeof(size_t));
+    so->order_index = (size_t*)CIV_CALLOC(n, sizeof(size_t));
+    so->execution_order = (char**)CIV_CALLOC(n, sizeof(char*));
+    if (!resolved || !resolved_count || !indegree || !so->order_index || !so->execution_order) {
+        CIV_FREE(resolved);
+        CIV_FREE(resolved_count);
+        CIV_FREE(indegree);
+        free_order(so);
+        so->order_dirty = true;
+        result.error = CIV_ERROR_OUT_OF_MEMORY;
+        return result;
+    }
+
+    /* Resolve dependency names to node indices and count successors */
+    for (size_t i = 0; i < n; i++) {
+        civ_system_node_t* node = &so->nodes[i];
+        node->owner = so;
+        node->index = i;
+        for (size_t d = 0; d < node->dep_count; d++) {
+            long j = find_node(so, node->dependencies[d]);
+            if (j < 0) {
+                civ_log(CIV_LOG_WARNING, "System %s depends on unregistered system %s",
+                        node->name, node->dependencies[d]);
+                continue;
+            }
+            resolved[i * CIV_ORCHESTRATOR_MAX_DEPS + resolved_count[i]++] = (size_t)j;
+            so->nodes[j].successor_count++;
         }
-        CIV_FREE(so->execution_order);
+        node->indegree = resolved_count[i];
+        indegree[i] = resolved_count[i];
     }
-    
-    /* Create new order (simplified - just use registration order) */
-    so->order_count = so->system_count;
-    so->execution_order = (char**)CIV_CALLOC(so->order_count, sizeof(char*));
-    
-    if (so->execution_order) {
-        for (size_t i = 0; i < so->system_count; i++) {
-            if (so->systems[i].get_name) {
-                const char* name = so->systems[i].get_name(so->systems[i].system);
-                size_t name_len = strlen(name) + 1;
-                so->execution_order[i] = (char*)CIV_MALLOC(name_len);
-                if (so->execution_order[i]) {
-                    strcpy(so->execution_order[i], name);
-                }
+    for (size_t i = 0; i < n; i++) {
+        civ_system_node_t* node = &so->nodes[i];
+        if (node->successor_count > 0) {
+            node->successors = (size_t*)CIV_CALLOC(node->successor_count, sizeof(size_t));
+        }
+        node->successor_count = 0;
+    }
+    for (size_t i = 0; i < n; i++) {
+        for (size_t d = 0; d < resolved_count[i]; d++) {
+            civ_system_node_t* dep = &so->nodes[resolved[i * CIV_ORCHESTRATOR_MAX_DEPS + d]];
+            if (dep->successors) dep->successors[dep->successor_count++] = i;
+        }
+    }
+
+    /* Kahn's algorithm; ties keep registration order so serial runs are stable */
+    size_t count = 0;
+    bool progressed = true;
+    bool* placed = (bool*)CIV_CALLOC(n, sizeof(bool));
+    while (placed && progressed) {
+        progressed = false;
+        for (size_t i = 0; i < n; i++) {
+            if (placed[i] || indegree[i] > 0) continue;
+            placed[i] = true;
+            so->order_index[count++] = i;
+            for (size_t s = 0; s < so->nodes[i].successor_count; s++) {
+                indegree[so->nodes[i].successors[s]]--;
+            }
+            progressed = true;
+        }
+    }
+
+    if (count < n) {
+        /* Cycle: keep running everything, serially, in registration order */
+        so->order_acyclic = false;
+        for (size_t i = 0; i < n; i++) {
+            if (!placed || !placed[i]) {
+                civ_log(CIV_LOG_ERROR, "System %s is part of a dependency cycle",
+                        so->nodes[i].name);
+                if (count < n) so->order_index[count++] = i;
             }
         }
+        result.error = CIV_ERROR_INVALID_DATA;
+        result.message = "Dependency cycle between systems";
+    }
+    so->order_count = count;
+
+    for (size_t k = 0; k < so->order_count; k++) {
+        const char* name = so->nodes[so->order_index[k]].name;
+        size_t name_len = strlen(name) + 1;
+        so->execution_order[k] = (char*)CIV_MALLOC(name_len);
+        if (so->execution_order[k]) {
+            memcpy(so->execution_order[k], name, name_len);
+        }
     }
-    
+
+    CIV_FREE(placed);
+    CIV_FREE(resolved);
+    CIV_FREE(resolved_count);
+    CIV_FREE(indegree);
     return result;
 }
 
+static bool system_enabled(const civ_updatable_t* updatable) {
+    return !updatable->is_enabled || updatable->is_enabled(updatable->system);
+}
+
+static void run_system(civ_system_orchestrator_t* so, size_t index, civ_float_t time_delta) {
+    civ_updatable_t* updatable = &so->systems[index];
+    civ_system_status_t* status = &so->nodes[index].status;
+
+    status->enabled = system_enabled(updatable);
+    if (!status->enabled || !updatable->update) return;
+
+    uint64_t helped = civ_worker_pool_helped_ns();
+    uint64_t start = SDL_GetTicksNS();
+    civ_result_t update_result = updatable->update(updatable->system, time_delta);
+    uint64_t end = SDL_GetTicksNS();
+    /* Jobs of other systems run while this one waited are theirs */
+    helped = civ_worker_pool_helped_ns() - helped;
+    civ_float_t update_time =
+        (civ_float_t)(end - start - MIN(helped, end - start)) / 1000000.0;
+    civ_profiler_record(so->nodes[index].profile_id, start, end);
+    civ_performance_optimizer_record(so->optimizer, so->nodes[index].perf_id, update_time, 0.0f);
+
+    status->last_update_time = update_time;
+    status->avg_update_time = status->update_count == 0
+        ? update_time : status->avg_update_time * 0.9 + update_time * 0.1;
+    status->update_count++;
+    status->total_update_time += update_time;
+
+    if (CIV_FAILED(update_result)) {
+        status->health = MAX(0.0, status->health - 0.1);
+        civ_log(CIV_LOG_WARNING, "System update failed: %s: %s", status->name,
+                update_result.message ? update_result.message : "unknown error");
+    } else {
+        status->health = MIN(1.0, status->health + 0.01);
+    }
+}
+
+static void system_job(void* arg) {
+    civ_system_node_t* node = (civ_system_node_t*)arg;
+    civ_system_orchestrator_t* so = (civ_system_orchestrator_t*)node->owner;
+    civ_worker_pool_t* pool = (civ_worker_pool_t*)so->worker_pool;
+
+    run_system(so, node->index, so->frame_delta);
+
+    /* Release successors whose last dependency just finished */
+    for (size_t s = 0; s < node->successor_count; s++) {
+        civ_system_node_t* next = &so->nodes[node->successors[s]];
+        if (SDL_AddAtomicInt(&next->pending, -1) == 1) {
+            if (!civ_worker_pool_submit(pool, system_job, next)) system_job(next);
+        }
+    }
+    SDL_AddAtomicInt(&so->remaining, -1);
+}
+
 civ_result_t civ_system_orchestrator_update_all(civ_system_orchestrator_t* so, civ_float_t time_delta) {
     civ_result_t result = {CIV_OK, NULL};
-    
+
     if (!so) {
         result.error = CIV_ERROR_NULL_POINTER;
         return result;
     }
-    
-    /* Update systems in order */
-    for (size_t i = 0; i < so->system_count; i++) {
-        civ_updatable_t* updatable = &so->systems[i];
-        
-        if (!updatable->is_enabled || !updatable->is_enabled(updatable->system)) {
-            continue;
+
+    if (so->order_dirty) {
+        civ_system_orchestrator_calculate_order(so);
+    }
+    if (so->order_count == 0) return result;
+
+    civ_worker_pool_t* pool = (civ_worker_pool_t*)so->worker_pool;
+    if (!so->parallel_execution || !pool || !so->order_acyclic) {
+        /* Update systems in dependency order */
+        for (size_t k = 0; k < so->order_count; k++) {
+            run_system(so, so->order_index[k], time_delta);
         }
-        
-        if (updatable->update) {
-            clock_t start = clock();
-            civ_result_t update_result = updatable->update(updatable->system, time_delta);
-            clock_t end = clock();
-            
-            civ_float_t update_time = ((civ_float_t)(end - start)) / CLOCKS_PER_SEC * 1000.0f;
-            
-            if (CIV_FAILED(update_result)) {
-                civ_log(CIV_LOG_WARNING, "System update failed: %s", update_result.message);
-            }
+        return result;
+    }
+
+    /* Parallel: every node becomes runnable once its pending count is zero */
+    so->frame_delta = time_delta;
+    SDL_SetAtomicInt(&so->remaining, (int)so->order_count);
+    for (size_t i = 0; i < so->system_count; i++) {
+        SDL_SetAtomicInt(&so->nodes[i].pending, (int)so->nodes[i].indegree);
+    }
+    for (size_t i = 0; i < so->system_count; i++) {
+        if (so->nodes[i].indegree == 0) {
+            if (!civ_worker_pool_submit(pool, system_job, &so->nodes[i])) system_job(&so->nodes[i]);
         }
     }
-    
+    civ_worker_pool_wait_counter(pool, &so->remaining);
+
     return result;
 }
 
 void civ_system_orchestrator_enable_system(civ_system_orchestrator_t* so, const char* name, bool enabled) {
     if (!so || !name) return;
-    
-    for (size_t i = 0; i < so->system_count; i++) {
-        if (so->systems[i].get_name && 
-            strcmp(so->systems[i].get_name(so->systems[i].system), name) == 0) {
-            if (so->systems[i].set_enabled) {
-                so->systems[i].set_enabled(so->systems[i].system, enabled);
-            }
-            return;
-        }
+
+    long i = find_node(so, name);
+    if (i < 0) return;
+    if (so->systems[i].set_enabled) {
+        so->systems[i].set_enabled(so->systems[i].system, enabled);
     }
+    so->nodes[i].status.enabled = enabled;
 }
 
 civ_system_status_t* civ_system_orchestrator_get_status(civ_system_orchestrator_t* so, const char* name) {
     if (!so || !name) return NULL;
-    
-    /* Find system and return status */
-    /* Simplified - would need to track status separately */
-    return NULL;
+
+    long i = find_node(so, name);
+    return i < 0 ? NULL : &so->nodes[i].status;
 }
 
 civ_float_t civ_system_orchestrator_get_overall_health(const civ_system_orchestrator_t* so) {
     if (!so || so->system_count == 0) return 1.0f;
-    
-    /* Calculate average health of all systems */
-    /* Simplified - would track health per system */
-    return 1.0f;
+
+    civ_float_t total = 0.0;
+    for (size_t i = 0; i < so->system_count; i++) {
+        total += so->nodes[i].status.health;
+    }
+    return total / (civ_float_t)so->system_count;
 }
 
+void civ_system_orchestrator_set_parallel(civ_system_orchestrator_t* so, bool enabled,
+                                          uint32_t max_workers) {
+    if (!so) return;
+
+    if (max_workers == 0) {
+        int cores = SDL_GetNumLogicalCPUCores();
+        max_workers = cores > 1 ? (uint32_t)cores : 1;
+    }
+
+    civ_worker_pool_t* pool = (civ_worker_pool_t*)so->worker_pool;
+    bool want_pool = enabled && max_workers > 1;
+    if (pool && (!want_pool || (uint32_t)civ_worker_pool_size(pool) != max_workers - 1)) {
+        civ_worker_pool_destroy(pool);
+        so->worker_pool = pool = NULL;
+    }
+    if (want_pool && !pool) {
+        /* The calling thread is one of the workers */
+        so->worker_pool = civ_worker_pool_create((int)max_workers - 1);
+        if (!so->worker_pool) {
+            civ_log(CIV_LOG_WARNING, "Worker pool unavailable, running systems serially");
+        }
+    }
+    so->parallel_execution = want_pool && so->worker_pool != NULL;
+    so->max_workers = max_workers;
+}
+
+void* civ_system_orchestrator_get_worker_pool(civ_system_orchestrator_t* so) {
+    return so ? so->worker_pool : NULL;
+}
+
+void civ_system_orchestrator_set_optimizer(civ_system_orchestrator_t* so,
+                                           civ_performance_optimizer_t* po) {
+    if (!so) return;
+    so->optimizer = po;
+    for (size_t i = 0; i < so->system_count; i++) {
+        so->nodes[i].perf_id = civ_performance_optimizer_register(po, so->nodes[i].name);
+    }
+}
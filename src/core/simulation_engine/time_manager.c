@@ -5,6 +5,7 @@
 
 #include "core/simulation_engine/time_manager.h"
 #include "common.h"
+#include <SDL3/SDL.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdarg.h>
@@ -41,15 +42,6 @@ civ_time_manager_t* civ_time_manager_create(void) {
 
 void civ_time_manager_destroy(civ_time_manager_t* tm) {
     if (!tm) return;
-    
-    /* Free all listeners */
-    civ_time_listener_t* listener = tm->listeners;
-    while (listener) {
-        civ_time_listener_t* next = listener->next;
-        CIV_FREE(listener);
-        listener = next;
-    }
-    
     CIV_FREE(tm);
 }
 
@@ -69,63 +61,82 @@ void civ_time_manager_init(civ_time_manager_t* tm) {
     tm->time_scale = CIV_TIME_SCALE_NORMAL;
     tm->game_speed = 1.0f;
     tm->time_delta = 0.0f;
-    tm->last_update_time = time(NULL);
-    tm->accumulated_time = 0.0f;
+    tm->last_update_ns = 0;
+    tm->accumulated_time = 0.0;
     
     /* Copy multipliers */
     memcpy(tm->scale_multipliers, TIME_SCALE_MULTIPLIERS, sizeof(TIME_SCALE_MULTIPLIERS));
-    
-    tm->listeners = NULL;
+}
+
+/* Backwards, so a listener may remove itself from inside its callback */
+static void notify(civ_time_manager_t* tm, civ_time_event_t event, int32_t days) {
+    for (int i = tm->listener_count[event] - 1; i >= 0; i--) {
+        if (i >= tm->listener_count[event]) continue;
+        const civ_time_listener_t* l = &tm->listeners[event][i];
+        l->callback(event, &tm->calendar, days, l->user_data);
+    }
+}
+
+/* Move the calendar by whole days. Only DAY listeners need every day
+   visited; MONTH and YEAR listeners cost one jump per month boundary. */
+static void advance_calendar(civ_time_manager_t* tm, int32_t days) {
+    civ_calendar_t* cal = &tm->calendar;
+    if (tm->listener_count[CIV_TIME_EVENT_DAY] > 0) {
+        for (int32_t i = 0; i < days; i++) {
+            civ_calendar_advance_day(cal);
+            notify(tm, CIV_TIME_EVENT_DAY, 1);
+            if (cal->day == 1) notify(tm, CIV_TIME_EVENT_MONTH, 1);
+            if (cal->day == 1 && cal->month == 1) notify(tm, CIV_TIME_EVENT_YEAR, 1);
+        }
+    } else if (tm->listener_count[CIV_TIME_EVENT_MONTH] > 0 ||
+               tm->listener_count[CIV_TIME_EVENT_YEAR] > 0) {
+        int32_t left = days;
+        while (left > 0) {
+            int32_t to_month = 31 - cal->day;
+            if (left < to_month) {
+                civ_calendar_advance_days(cal, left);
+                break;
+            }
+            civ_calendar_advance_days(cal, to_month);
+            left -= to_month;
+            notify(tm, CIV_TIME_EVENT_MONTH, 1);
+            if (cal->month == 1) notify(tm, CIV_TIME_EVENT_YEAR, 1);
+        }
+    } else {
+        civ_calendar_advance_days(cal, days);
+    }
+    notify(tm, CIV_TIME_EVENT_DAYS_ADVANCED, days);
 }
 
 civ_float_t civ_time_manager_update(civ_time_manager_t* tm) {
     if (!tm) return 0.0f;
     
-    time_t current_time = time(NULL);
-    civ_float_t real_delta = (civ_float_t)difftime(current_time, tm->last_update_time);
-    tm->last_update_time = current_time;
+    uint64_t now = SDL_GetTicksNS();
+    uint64_t elapsed = tm->last_update_ns ? now - tm->last_update_ns : 0;
+    tm->last_update_ns = now;
+    return civ_time_manager_advance(tm, elapsed);
+}
+
+civ_float_t civ_time_manager_advance(civ_time_manager_t* tm, uint64_t elapsed_ns) {
+    if (!tm) return 0.0f;
     
     if (tm->time_scale == CIV_TIME_SCALE_PAUSED) {
         tm->time_delta = 0.0f;
         return 0.0f;
     }
     
-    /* Calculate game time delta */
-    civ_float_t multiplier = tm->scale_multipliers[tm->time_scale] * tm->game_speed;
-    tm->time_delta = real_delta * multiplier;
-    tm->accumulated_time += tm->time_delta;
-    
-    /* Advance calendar based on accumulated time */
-    int32_t days_to_advance = (int32_t)tm->accumulated_time;
-    if (days_to_advance > 0) {
-        for (int32_t i = 0; i < days_to_advance; i++) {
-            civ_calendar_advance_day(&tm->calendar);
-            
-            /* Notify listeners of day advancement */
-            civ_time_listener_t* listener = tm->listeners;
-            while (listener) {
-                listener->callback("day", &tm->calendar, listener->user_data);
-                listener = listener->next;
-            }
-        }
-        tm->accumulated_time -= (civ_float_t)days_to_advance;
-        
-        /* Check for month/year events */
-        if (tm->calendar.day == 1) {
-            civ_time_listener_t* listener = tm->listeners;
-            while (listener) {
-                listener->callback("month", &tm->calendar, listener->user_data);
-                listener = listener->next;
-            }
-        }
-        
-        if (tm->calendar.month == 1 && tm->calendar.day == 1) {
-            civ_time_listener_t* listener = tm->listeners;
-            while (listener) {
-                listener->callback("year", &tm->calendar, listener->user_data);
-                listener = listener->next;
-            }
-        }
+    /* A stall (debugger, window drag) resumes at one step, not a leap */
+    elapsed_ns = MIN(elapsed_ns, CIV_TIME_MAX_STEP_NS);
+    double multiplier = (double)tm->scale_multipliers[tm->time_scale] * tm->game_speed;
+    double days = (double)elapsed_ns / (double)CIV_TIME_NS_PER_SECOND * multiplier;
+    tm->time_delta = (civ_float_t)days;
+    tm->accumulated_time += days;
+    
+    /* The calendar moves in whole-day quanta; the remainder carries */
+    int32_t whole = (int32_t)tm->accumulated_time;
+    if (whole > 0) {
+        tm->accumulated_time -= (double)whole;
+        advance_calendar(tm, whole);
     }
     
     return tm->time_delta;
@@ -143,39 +154,36 @@ void civ_time_manager_adjust_speed(civ_time_manager_t* tm, civ_float_t multiplie
     tm->game_speed = CLAMP(multiplier, 0.1f, 10.0f);
 }
 
-void civ_time_manager_add_listener(civ_time_manager_t* tm, civ_time_listener_cb_t callback, void* user_data) {
-    if (!tm || !callback) return;
+bool civ_time_manager_add_listener(civ_time_manager_t* tm, civ_time_event_t event,
+                                   civ_time_listener_cb_t callback, void* user_data) {
+    if (!tm || !callback || (unsigned)event >= CIV_TIME_EVENT_COUNT) return false;
     
-    civ_time_listener_t* listener = (civ_time_listener_t*)CIV_MALLOC(sizeof(civ_time_listener_t));
-    if (!listener) {
-        civ_log(CIV_LOG_ERROR, "Failed to allocate time listener");
-        return;
+    civ_time_listener_t* table = tm->listeners[event];
+    int* count = &tm->listener_count[event];
+    for (int i = 0; i < *count; i++) {
+        if (table[i].callback == callback && table[i].user_data == user_data) return true;
     }
-    
-    listener->callback = callback;
-    listener->user_data = user_data;
-    listener->next = tm->listeners;
-    tm->listeners = listener;
+    if (*count >= CIV_TIME_MAX_LISTENERS) {
+        civ_log(CIV_LOG_WARNING, "Time listener table full for event %d", (int)event);
+        return false;
+    }
+    table[*count].callback = callback;
+    table[*count].user_data = user_data;
+    (*count)++;
+    return true;
 }
 
-void civ_time_manager_remove_listener(civ_time_manager_t* tm, civ_time_listener_cb_t callback) {
-    if (!tm || !callback) return;
+void civ_time_manager_remove_listener(civ_time_manager_t* tm, civ_time_event_t event,
+                                      civ_time_listener_cb_t callback, void* user_data) {
+    if (!tm || (unsigned)event >= CIV_TIME_EVENT_COUNT) return;
     
-    civ_time_listener_t* prev = NULL;
-    civ_time_listener_t* current = tm->listeners;
-    
-    while (current) {
-        if (current->callback == callback) {
-            if (prev) {
-                prev->next = current->next;
-            } else {
-                tm->listeners = current->next;
-            }
-            CIV_FREE(current);
+    civ_time_listener_t* table = tm->listeners[event];
+    int* count = &tm->listener_count[event];
+    for (int i = 0; i < *count; i++) {
+        if (table[i].callback == callback && table[i].user_data == user_data) {
+            table[i] = table[--(*count)];
             return;
         }
-        prev = current;
-        current = current->next;
     }
 }
 
@@ -213,13 +221,25 @@ void civ_calendar_advance_day(civ_calendar_t* cal) {
     cal->season = get_season_from_month(cal->month);
 }
 
-char* civ_time_manager_to_json(const civ_time_manager_t* tm) {
-    if (!tm) return NULL;
+void civ_calendar_advance_days(civ_calendar_t* cal, int64_t days) {
+    if (!cal || days <= 0) return;
     
-    char* json = (char*)CIV_MALLOC(512);
+    /* 30-day months, 12 to the year */
+    int64_t day = (int64_t)(cal->day - 1) + days;
+    int64_t month = (int64_t)(cal->month - 1) + day / 30;
+    cal->day = (int32_t)(day % 30) + 1;
+    cal->month = (int32_t)(month % 12) + 1;
+    cal->year += (int32_t)(month / 12);
+    cal->total_days += days;
+    cal->season = get_season_from_month(cal->month);
+}
+
+#define TIME_MANAGER_JSON_SIZE 512
+
+static char* format_json(const civ_time_manager_t* tm, char* json) {
     if (!json) return NULL;
     
-    snprintf(json, 512,
+    snprintf(json, TIME_MANAGER_JSON_SIZE,
         "{\"year\":%d,\"month\":%d,\"day\":%d,\"total_days\":%lld,"
         "\"time_scale\":%d,\"game_speed\":%.2f}",
         tm->calendar.year, tm->calendar.month, tm->calendar.day,
@@ -228,6 +248,16 @@ char* civ_time_manager_to_json(const civ_time_manager_t* tm) {
     return json;
 }
 
+char* civ_time_manager_to_json(const civ_time_manager_t* tm) {
+    if (!tm) return NULL;
+    return format_json(tm, (char*)CIV_MALLOC(TIME_MANAGER_JSON_SIZE));
+}
+
+char* civ_time_manager_to_json_arena(const civ_time_manager_t* tm, civ_arena_t* arena) {
+    if (!tm) return NULL;
+    return format_json(tm, (char*)civ_arena_push(arena, TIME_MANAGER_JSON_SIZE));
+}
+
 civ_result_t civ_time_manager_from_json(civ_time_manager_t* tm, const char* json) {
     civ_result_t result = {CIV_OK, NULL};
     
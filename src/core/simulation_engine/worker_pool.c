@@ -0,0 +1,230 @@
+/**
+ * @file worker_pool.c
+ * @brief Worker thread pool: shared FIFO, helping waits, parallel_for
+ */
+
+#include "core/simulation_engine/worker_pool.h"
+#include "utils/rng.h"
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+  civ_job_fn_t fn;
+  void        *arg;
+} civ_job_t;
+
+struct civ_worker_pool {
+  SDL_Thread    *threads[CIV_WORKER_POOL_MAX_THREADS];
+  int            thread_count;
+
+  SDL_Mutex     *lock;
+  SDL_Condition *work_cv;   /* signalled when a job is queued */
+  SDL_Condition *done_cv;   /* broadcast when any job finishes */
+
+  /* Ring buffer of queued jobs, guarded by lock */
+  civ_job_t     *jobs;
+  int            head, count, capacity;
+  bool           stopping;
+};
+
+/* Time this thread has spent running other jobs inside waits */
+static CIV_THREAD_LOCAL uint64_t t_helped_ns;
+
+/* ── Queue ─────────────────────────────────────────────────────────── */
+static bool queue_push(civ_worker_pool_t *pool, civ_job_t job) {
+  if (pool->count == pool->capacity) {
+    int new_cap = pool->capacity ? pool->capacity * 2 : 64;
+    civ_job_t *grown = CIV_MALLOC(sizeof(civ_job_t) * (size_t)new_cap);
+    if (!grown) return false;
+    for (int i = 0; i < pool->count; i++)
+      grown[i] = pool->jobs[(pool->head + i) % pool->capacity];
+    CIV_FREE(pool->jobs);
+    pool->jobs = grown;
+    pool->head = 0;
+    pool->capacity = new_cap;
+  }
+  pool->jobs[(pool->head + pool->count) % pool->capacity] = job;
+  pool->count++;
+  return true;
+}
+
+static bool queue_pop(civ_worker_pool_t *pool, civ_job_t *out) {
+  if (pool->count == 0) return false;
+  *out = pool->jobs[pool->head];
+  pool->head = (pool->head + 1) % pool->capacity;
+  pool->count--;
+  return true;
+}
+
+static void finish_job(civ_worker_pool_t *pool) {
+  SDL_LockMutex(pool->lock);
+  SDL_BroadcastCondition(pool->done_cv);
+  SDL_UnlockMutex(pool->lock);
+}
+
+static int worker_main(void *arg) {
+  civ_worker_pool_t *pool = (civ_worker_pool_t *)arg;
+  for (;;) {
+    civ_job_t job;
+    SDL_LockMutex(pool->lock);
+    while (pool->count == 0 && !pool->stopping)
+      SDL_WaitCondition(pool->work_cv, pool->lock);
+    if (pool->stopping && pool->count == 0) {
+      SDL_UnlockMutex(pool->lock);
+      break;
+    }
+    queue_pop(pool, &job);
+    SDL_UnlockMutex(pool->lock);
+
+    job.fn(job.arg);
+    finish_job(pool);
+  }
+  return 0;
+}
+
+/* ── Lifecycle ─────────────────────────────────────────────────────── */
+civ_worker_pool_t *civ_worker_pool_create(int worker_count) {
+  if (worker_count <= 0) worker_count = SDL_GetNumLogicalCPUCores() - 1;
+  worker_count = CLAMP(worker_count, 1, CIV_WORKER_POOL_MAX_THREADS);
+
+  civ_worker_pool_t *pool = CIV_CALLOC(1, sizeof(*pool));
+  if (!pool) return NULL;
+  pool->lock = SDL_CreateMutex();
+  pool->work_cv = SDL_CreateCondition();
+  pool->done_cv = SDL_CreateCondition();
+  if (!pool->lock || !pool->work_cv || !pool->done_cv) {
+    civ_worker_pool_destroy(pool);
+    return NULL;
+  }
+
+  for (int i = 0; i < worker_count; i++) {
+    char name[32];
+    snprintf(name, sizeof(name), "civ_worker_%d", i);
+    SDL_Thread *t = SDL_CreateThread(worker_main, name, pool);
+    if (!t) break;
+    pool->threads[pool->thread_count++] = t;
+  }
+  if (pool->thread_count == 0) {
+    civ_log(CIV_LOG_ERROR, "Worker pool: no threads could be started");
+    civ_worker_pool_destroy(pool);
+    return NULL;
+  }
+  return pool;
+}
+
+void civ_worker_pool_destroy(civ_worker_pool_t *pool) {
+  if (!pool) return;
+  if (pool->lock) {
+    SDL_LockMutex(pool->lock);
+    pool->stopping = true;
+    if (pool->work_cv) SDL_BroadcastCondition(pool->work_cv);
+    SDL_UnlockMutex(pool->lock);
+  }
+  for (int i = 0; i < pool->thread_count; i++)
+    SDL_WaitThread(pool->threads[i], NULL);
+
+  if (pool->work_cv) SDL_DestroyCondition(pool->work_cv);
+  if (pool->done_cv) SDL_DestroyCondition(pool->done_cv);
+  if (pool->lock)    SDL_DestroyMutex(pool->lock);
+  CIV_FREE(pool->jobs);
+  CIV_FREE(pool);
+}
+
+int civ_worker_pool_size(const civ_worker_pool_t *pool) {
+  return pool ? pool->thread_count : 0;
+}
+
+/* ── Jobs ──────────────────────────────────────────────────────────── */
+bool civ_worker_pool_submit(civ_worker_pool_t *pool, civ_job_fn_t fn, void *arg) {
+  if (!pool || !fn) return false;
+  SDL_LockMutex(pool->lock);
+  bool ok = queue_push(pool, (civ_job_t){fn, arg});
+  if (ok) SDL_SignalCondition(pool->work_cv);
+  SDL_UnlockMutex(pool->lock);
+  return ok;
+}
+
+bool civ_worker_pool_run_one(civ_worker_pool_t *pool) {
+  if (!pool) return false;
+  civ_job_t job;
+  SDL_LockMutex(pool->lock);
+  bool have = queue_pop(pool, &job);
+  SDL_UnlockMutex(pool->lock);
+  if (!have) return false;
+  job.fn(job.arg);
+  finish_job(pool);
+  return true;
+}
+
+void civ_worker_pool_wait_counter(civ_worker_pool_t *pool, SDL_AtomicInt *outstanding) {
+  if (!outstanding) return;
+  while (SDL_GetAtomicInt(outstanding) > 0) {
+    /* The whole job counts as helped, waits nested in it included once */
+    uint64_t helped = t_helped_ns, start = SDL_GetTicksNS();
+    if (civ_worker_pool_run_one(pool)) {
+      t_helped_ns = helped + (SDL_GetTicksNS() - start);
+      continue;
+    }
+    if (!pool) break;
+    /* Nothing to help with — sleep until some job completes. The timeout
+       covers a completion that lands between the check and the wait. */
+    SDL_LockMutex(pool->lock);
+    if (pool->count == 0 && SDL_GetAtomicInt(outstanding) > 0)
+      SDL_WaitConditionTimeout(pool->done_cv, pool->lock, 1);
+    SDL_UnlockMutex(pool->lock);
+  }
+}
+
+uint64_t civ_worker_pool_helped_ns(void) { return t_helped_ns; }
+
+/* ── parallel_for ──────────────────────────────────────────────────── */
+typedef struct {
+  civ_parallel_for_fn_t fn;
+  void                 *ctx;
+  int                   count;
+  civ_mem_tag_t         tag;       /* caller's memory tag, for the helpers */
+  SDL_AtomicInt         next;      /* next index to claim */
+  SDL_AtomicInt         helpers;   /* helper jobs not yet finished */
+} civ_parallel_batch_t;
+
+static void batch_drain(civ_parallel_batch_t *batch) {
+  int i;
+  while ((i = SDL_AddAtomicInt(&batch->next, 1)) < batch->count)
+    batch->fn(batch->ctx, i);
+}
+
+static void batch_job(void *arg) {
+  civ_parallel_batch_t *batch = (civ_parallel_batch_t *)arg;
+  CIV_MEM_TAG_BEGIN(saved_tag, batch->tag);
+  batch_drain(batch);
+  CIV_MEM_TAG_END(saved_tag);
+  SDL_AddAtomicInt(&batch->helpers, -1);
+}
+
+void civ_worker_pool_parallel_for(civ_worker_pool_t *pool, int count,
+                                  civ_parallel_for_fn_t fn, void *ctx) {
+  if (!fn || count <= 0) return;
+  if (!pool || count == 1) {
+    for (int i = 0; i < count; i++) fn(ctx, i);
+    return;
+  }
+
+  civ_parallel_batch_t batch;
+  memset(&batch, 0, sizeof(batch));
+  batch.fn = fn;
+  batch.ctx = ctx;
+  batch.count = count;
+  batch.tag = civ_mem_tag_current();
+
+  int helpers = MIN(pool->thread_count, count - 1);
+  SDL_SetAtomicInt(&batch.helpers, helpers);
+  for (int h = 0; h < helpers; h++) {
+    if (!civ_worker_pool_submit(pool, batch_job, &batch))
+      SDL_AddAtomicInt(&batch.helpers, -1);
+  }
+
+  /* The caller claims indices too, then helps until every helper exits
+     (batch lives on this stack frame, so no helper may outlive it). */
+  batch_drain(&batch);
+  civ_worker_pool_wait_counter(pool, &batch.helpers);
+}
@@ -5,6 +5,7 @@
 
 #include "core/subunits/subunit.h"
 #include "common.h"
+#include "utils/store_registry.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -20,6 +21,10 @@ civ_subunit_manager_t *civ_subunit_manager_create(void) {
   }
 
   civ_subunit_manager_init(manager);
+  /* civ_subunit_manager_find compares every interned id */
+  CIV_STORE_REGISTER("subunits", manager, manager->subunit_count,
+                     manager->subunit_capacity, sizeof(civ_subunit_t),
+                     CIV_STORE_SCANNED);
   return manager;
 }
 
@@ -27,10 +32,9 @@ void civ_subunit_manager_destroy(civ_subunit_manager_t *manager) {
   if (!manager)
     return;
 
-  for (size_t i = 0; i < manager->subunit_count; i++) {
-    civ_subunit_destroy(&manager->subunits[i]);
-  }
+  civ_store_unregister_owner(manager);
   CIV_FREE(manager->subunits);
+  CIV_FREE(manager->order);
   CIV_FREE(manager);
 }
 
@@ -42,128 +46,247 @@ void civ_subunit_manager_init(civ_subunit_manager_t *manager) {
   manager->subunit_capacity = 64;
   manager->subunits = (civ_subunit_t *)CIV_CALLOC(manager->subunit_capacity,
                                                   sizeof(civ_subunit_t));
+  manager->order =
+      (int32_t *)CIV_MALLOC(manager->subunit_capacity * sizeof(int32_t));
+  if (!manager->subunits || !manager->order) {
+    CIV_FREE(manager->subunits);
+    CIV_FREE(manager->order);
+    manager->subunit_capacity = 0;
+  }
 }
 
-civ_subunit_t *civ_subunit_create(const char *id, const char *name,
-                                  civ_subunit_type_t type) {
-  if (!id || !name)
-    return NULL;
-
-  civ_subunit_t *subunit = (civ_subunit_t *)CIV_MALLOC(sizeof(civ_subunit_t));
-  if (!subunit) {
-    civ_log(CIV_LOG_ERROR, "Failed to allocate subunit");
-    return NULL;
-  }
+void civ_subunit_init(civ_subunit_t *subunit, const char *id, const char *name,
+                      civ_subunit_type_t type) {
+  if (!subunit)
+    return;
 
   memset(subunit, 0, sizeof(civ_subunit_t));
-  strncpy(subunit->id, id, sizeof(subunit->id) - 1);
-  strncpy(subunit->name, name, sizeof(subunit->name) - 1);
+  if (id)
+    strncpy(subunit->id, id, sizeof(subunit->id) - 1);
+  if (name)
+    strncpy(subunit->name, name, sizeof(subunit->name) - 1);
   subunit->type = type;
+  subunit->parent = CIV_SUBUNIT_NONE;
+  subunit->post = -1;
   subunit->autonomy = 0.3f;
   subunit->loyalty = 0.7f;
   subunit->development = 0.5f;
-  subunit->population = 0;
-  subunit->gdp = 0.0f;
   subunit->creation_time = time(NULL);
-  subunit->child_capacity = 16;
-  subunit->child_ids =
-      (char **)CIV_CALLOC(subunit->child_capacity, sizeof(char *));
+}
 
-  return subunit;
+/* ── Order splices ─────────────────────────────────────────────────── */
+
+static bool reserve(civ_subunit_manager_t *m, size_t want) {
+  if (want <= m->subunit_capacity)
+    return true;
+  size_t cap = m->subunit_capacity ? m->subunit_capacity : 64;
+  while (cap < want)
+    cap *= 2;
+  civ_subunit_t *subunits =
+      (civ_subunit_t *)CIV_REALLOC(m->subunits, cap * sizeof(civ_subunit_t));
+  if (!subunits)
+    return false;
+  m->subunits = subunits;
+  int32_t *order = (int32_t *)CIV_REALLOC(m->order, cap * sizeof(int32_t));
+  if (!order)
+    return false;
+  m->order = order;
+  m->subunit_capacity = cap;
+  return true;
 }
 
-void civ_subunit_destroy(civ_subunit_t *subunit) {
-  if (!subunit)
+static bool valid(const civ_subunit_manager_t *m, int32_t index) {
+  return index >= 0 && (size_t)index < m->subunit_count &&
+         m->subunits[index].active;
+}
+
+static void renumber(civ_subunit_manager_t *m, size_t from) {
+  for (size_t i = from; i < m->order_count; i++)
+    m->subunits[m->order[i]].post = (int32_t)i;
+}
+
+static void adjust_spans(civ_subunit_manager_t *m, int32_t from, int32_t delta) {
+  for (int32_t a = from; a != CIV_SUBUNIT_NONE; a = m->subunits[a].parent)
+    m->subunits[a].span += delta;
+}
+
+/* Lift root's subtree out of the order into buf (span entries) */
+static void splice_out(civ_subunit_manager_t *m, int32_t root, int32_t *buf) {
+  const civ_subunit_t *r = &m->subunits[root];
+  size_t len = (size_t)r->span, start = (size_t)(r->post - r->span + 1);
+  memcpy(buf, m->order + start, len * sizeof(int32_t));
+  memmove(m->order + start, m->order + start + len,
+          (m->order_count - start - len) * sizeof(int32_t));
+  m->order_count -= len;
+  renumber(m, start);
+  adjust_spans(m, r->parent, -(int32_t)len);
+}
+
+/* Put a lifted subtree (root last in buf) back as parent's last child */
+static void splice_in(civ_subunit_manager_t *m, int32_t root, int32_t parent,
+                      const int32_t *buf, size_t len) {
+  size_t pos = parent == CIV_SUBUNIT_NONE ? m->order_count
+                                          : (size_t)m->subunits[parent].post;
+  memmove(m->order + pos + len, m->order + pos,
+          (m->order_count - pos) * sizeof(int32_t));
+  memcpy(m->order + pos, buf, len * sizeof(int32_t));
+  m->order_count += len;
+  renumber(m, pos);
+  m->subunits[root].parent = parent;
+  adjust_spans(m, parent, (int32_t)len);
+}
+
+static bool move_subtree(civ_subunit_manager_t *m, int32_t root, int32_t parent) {
+  size_t len = (size_t)m->subunits[root].span;
+  int32_t *buf = (int32_t *)CIV_MALLOC(len * sizeof(int32_t));
+  if (!buf)
+    return false;
+  splice_out(m, root, buf);
+  splice_in(m, root, parent, buf, len);
+  CIV_FREE(buf);
+  return true;
+}
+
+/* Drop a leaf from the order; its slot stays, inactive */
+static void retire(civ_subunit_manager_t *m, int32_t index) {
+  int32_t self;
+  if (m->subunits[index].span != 1)
     return;
+  splice_out(m, index, &self);
+  civ_subunit_t *s = &m->subunits[index];
+  s->active = false;
+  s->post = -1;
+  s->span = 0;
+  s->parent = CIV_SUBUNIT_NONE;
+}
 
-  if (subunit->child_ids) {
-    for (size_t i = 0; i < subunit->child_count; i++) {
-      CIV_FREE(subunit->child_ids[i]);
-    }
-    CIV_FREE(subunit->child_ids);
+/* Move every direct child of from under to */
+static bool adopt_children(civ_subunit_manager_t *m, int32_t from, int32_t to) {
+  while (m->subunits[from].span > 1) {
+    /* The entry just before a subunit is its last child */
+    int32_t child = m->order[m->subunits[from].post - 1];
+    if (!move_subtree(m, child, to))
+      return false;
   }
+  return true;
 }
 
+/* ── Manager ───────────────────────────────────────────────────────── */
+
 civ_result_t civ_subunit_manager_add(civ_subunit_manager_t *manager,
-                                     civ_subunit_t *subunit) {
+                                     const civ_subunit_t *subunit,
+                                     int32_t parent, int32_t *out_index) {
   civ_result_t result = {CIV_OK, NULL};
 
   if (!manager || !subunit) {
     result.error = CIV_ERROR_NULL_POINTER;
     return result;
   }
-
-  if (manager->subunit_count >= manager->subunit_capacity) {
-    manager->subunit_capacity *= 2;
-    manager->subunits = (civ_subunit_t *)CIV_REALLOC(
-        manager->subunits, manager->subunit_capacity * sizeof(civ_subunit_t));
+  if (parent != CIV_SUBUNIT_NONE && !valid(manager, parent)) {
+    result.error = CIV_ERROR_INVALID_ARGUMENT;
+    return result;
   }
-
-  if (manager->subunits) {
-    manager->subunits[manager->subunit_count++] = *subunit;
-  } else {
+  if (!reserve(manager, manager->subunit_count + 1)) {
     result.error = CIV_ERROR_OUT_OF_MEMORY;
+    return result;
   }
 
+  int32_t index = (int32_t)manager->subunit_count++;
+  civ_subunit_t *s = &manager->subunits[index];
+  *s = *subunit;
+  s->id_sym = civ_symbol_intern(s->id);
+  s->active = true;
+  s->span = 1;
+  s->parent = CIV_SUBUNIT_NONE;
+  s->total_population = s->population;
+  s->total_gdp = s->gdp;
+  splice_in(manager, index, parent, &index, 1);
+  if (out_index)
+    *out_index = index;
   return result;
 }
 
-civ_subunit_t *civ_subunit_manager_find(const civ_subunit_manager_t *manager,
-                                        const char *id) {
+int32_t civ_subunit_manager_index(const civ_subunit_manager_t *manager,
+                                  const char *id) {
   if (!manager || !id)
-    return NULL;
+    return CIV_SUBUNIT_NONE;
 
+  civ_symbol_t sym = civ_symbol_find(id);
+  if (sym == CIV_SYMBOL_NONE)
+    return CIV_SUBUNIT_NONE;
   for (size_t i = 0; i < manager->subunit_count; i++) {
-    if (strcmp(manager->subunits[i].id, id) == 0) {
-      return (civ_subunit_t *)&manager->subunits[i];
-    }
+    const civ_subunit_t *s = &manager->subunits[i];
+    if (s->active && s->id_sym == sym)
+      return (int32_t)i;
   }
+  return CIV_SUBUNIT_NONE;
+}
 
-  return NULL;
+civ_subunit_t *civ_subunit_manager_find(const civ_subunit_manager_t *manager,
+                                        const char *id) {
+  int32_t index = civ_subunit_manager_index(manager, id);
+  return index == CIV_SUBUNIT_NONE ? NULL
+                                   : (civ_subunit_t *)&manager->subunits[index];
 }
 
-civ_result_t civ_subunit_set_parent(civ_subunit_t *subunit,
-                                    const char *parent_id) {
+civ_result_t civ_subunit_set_parent(civ_subunit_manager_t *manager,
+                                    int32_t index, int32_t parent) {
   civ_result_t result = {CIV_OK, NULL};
 
-  if (!subunit || !parent_id) {
+  if (!manager) {
     result.error = CIV_ERROR_NULL_POINTER;
     return result;
   }
+  if (!valid(manager, index) ||
+      (parent != CIV_SUBUNIT_NONE && !valid(manager, parent))) {
+    result.error = CIV_ERROR_INVALID_ARGUMENT;
+    return result;
+  }
 
-  strncpy(subunit->parent_id, parent_id, sizeof(subunit->parent_id) - 1);
+  const civ_subunit_t *s = &manager->subunits[index];
+  if (parent != CIV_SUBUNIT_NONE) {
+    int32_t p = manager->subunits[parent].post;
+    if (p > s->post - s->span && p <= s->post)
+      return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Parent inside subtree"};
+  }
+  if (s->parent != parent && !move_subtree(manager, index, parent))
+    result.error = CIV_ERROR_OUT_OF_MEMORY;
   return result;
 }
 
-civ_result_t civ_subunit_add_child(civ_subunit_t *subunit,
-                                   const char *child_id) {
-  civ_result_t result = {CIV_OK, NULL};
+const int32_t *civ_subunit_subtree(const civ_subunit_manager_t *manager,
+                                   int32_t index, size_t *count) {
+  if (count)
+    *count = 0;
+  if (!manager || !valid(manager, index))
+    return NULL;
+  const civ_subunit_t *s = &manager->subunits[index];
+  if (count)
+    *count = (size_t)s->span;
+  return manager->order + (s->post - s->span + 1);
+}
 
-  if (!subunit || !child_id) {
-    result.error = CIV_ERROR_NULL_POINTER;
-    return result;
-  }
+void civ_subunit_manager_rollup(civ_subunit_manager_t *manager) {
+  if (!manager)
+    return;
 
-  if (subunit->child_count >= subunit->child_capacity) {
-    subunit->child_capacity *= 2;
-    subunit->child_ids = (char **)CIV_REALLOC(
-        subunit->child_ids, subunit->child_capacity * sizeof(char *));
+  for (size_t i = 0; i < manager->order_count; i++) {
+    civ_subunit_t *s = &manager->subunits[manager->order[i]];
+    s->total_population = 0;
+    s->total_gdp = 0.0f;
   }
-
-  if (subunit->child_ids) {
-    size_t len = strlen(child_id) + 1;
-    subunit->child_ids[subunit->child_count] = (char *)CIV_MALLOC(len);
-    if (subunit->child_ids[subunit->child_count]) {
-      strcpy(subunit->child_ids[subunit->child_count], child_id);
-      subunit->child_count++;
-    } else {
-      result.error = CIV_ERROR_OUT_OF_MEMORY;
+  /* Children precede their parent, so each total is final when it is
+     added upward */
+  for (size_t i = 0; i < manager->order_count; i++) {
+    civ_subunit_t *s = &manager->subunits[manager->order[i]];
+    s->total_population += s->population;
+    s->total_gdp += s->gdp;
+    if (s->parent != CIV_SUBUNIT_NONE) {
+      civ_subunit_t *p = &manager->subunits[s->parent];
+      p->total_population += s->total_population;
+      p->total_gdp += s->total_gdp;
     }
-  } else {
-    result.error = CIV_ERROR_OUT_OF_MEMORY;
   }
-
-  return result;
 }
 
 civ_result_t civ_subunit_manager_update(civ_subunit_manager_t *manager,
@@ -176,8 +299,8 @@ civ_result_t civ_subunit_manager_update(civ_subunit_manager_t *manager,
   }
 
   /* Update all subunits */
-  for (size_t i = 0; i < manager->subunit_count; i++) {
-    civ_subunit_t *subunit = &manager->subunits[i];
+  for (size_t i = 0; i < manager->order_count; i++) {
+    civ_subunit_t *subunit = &manager->subunits[manager->order[i]];
 
     /* Development changes based on loyalty and autonomy */
     civ_float_t dev_change =
@@ -186,94 +309,101 @@ civ_result_t civ_subunit_manager_update(civ_subunit_manager_t *manager,
     subunit->development = CLAMP(subunit->development + dev_change, 0.0f, 1.0f);
   }
 
+  civ_subunit_manager_rollup(manager);
   return result;
 }
 
-civ_result_t civ_subunit_split(civ_subunit_manager_t *manager,
-                               civ_subunit_t *original, int count,
-                               char **new_names, civ_subunit_t **out_subunits) {
-  if (!manager || !original || !new_names || count < 2)
+civ_result_t civ_subunit_split(civ_subunit_manager_t *manager, int32_t index,
+                               int count, char **new_names,
+                               int32_t *out_indices) {
+  if (!manager || !new_names || count < 2 || !valid(manager, index))
     return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Invalid args"};
+  if (!reserve(manager, manager->subunit_count + (size_t)count))
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Out of memory"};
 
-  int64_t pop_share = original->population / count;
-  civ_float_t gdp_share = original->gdp / count;
+  /* Copied: adding pieces may move the array */
+  civ_subunit_t original = manager->subunits[index];
+  int64_t pop_share = original.population / count;
+  civ_float_t gdp_share = original.gdp / count;
 
+  int32_t first = CIV_SUBUNIT_NONE;
   for (int i = 0; i < count; i++) {
     char new_id[STRING_SHORT_LEN];
-    snprintf(new_id, STRING_SHORT_LEN, "%s_%d", original->id, i);
-
-    civ_subunit_t *new_sub =
-        civ_subunit_create(new_id, new_names[i], original->type);
-    if (new_sub) {
-      new_sub->population = pop_share;
-      new_sub->gdp = gdp_share;
-      new_sub->autonomy = original->autonomy;
-      new_sub->loyalty = original->loyalty;
-
-      // Inherit parent
-      if (strlen(original->parent_id) > 0) {
-        civ_subunit_set_parent(new_sub, original->parent_id);
-      }
-
-      civ_subunit_manager_add(manager, new_sub);
-      if (out_subunits)
-        out_subunits[i] = new_sub;
-
-      // Note: In a real system we'd need to free the 'new_sub' pointer itself
-      // because manager_add copies the struct by value, but create returns a
-      // malloc'd pointer. For now, let's assume manager_add takes ownership or
-      // we need to free the temp container. Given existing code: manager stores
-      // BY VALUE. So we must free the temp.
-      CIV_FREE(new_sub->child_ids); // Free the empty array created by create
-      CIV_FREE(new_sub);            // Free the struct container
-    }
+    snprintf(new_id, STRING_SHORT_LEN, "%s_%d", original.id, i);
+
+    civ_subunit_t piece;
+    civ_subunit_init(&piece, new_id, new_names[i], original.type);
+    piece.population = pop_share;
+    piece.gdp = gdp_share;
+    piece.autonomy = original.autonomy;
+    piece.loyalty = original.loyalty;
+    piece.development = original.development;
+
+    int32_t added = CIV_SUBUNIT_NONE;
+    civ_subunit_manager_add(manager, &piece, original.parent, &added);
+    if (i == 0)
+      first = added;
+    if (out_indices)
+      out_indices[i] = added;
   }
 
-  // "Destroy" original (mark as inactive or remove)
-  // For simplicity, we'll just zero it out or mark it.
-  // Real implementation would remove from array.
-
+  if (!adopt_children(manager, index, first))
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Out of memory"};
+  retire(manager, index);
   return (civ_result_t){CIV_OK, "Split successful"};
 }
 
 civ_result_t civ_subunit_merge(civ_subunit_manager_t *manager,
-                               civ_subunit_t **subunits, int count,
-                               const char *new_name,
-                               civ_subunit_t **out_merged) {
-  if (!manager || !subunits || count < 2 || !new_name)
+                               const int32_t *indices, int count,
+                               const char *new_name, int32_t *out_index) {
+  if (!manager || !indices || count < 2 || !new_name)
     return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Invalid args"};
+  for (int i = 0; i < count; i++) {
+    if (!valid(manager, indices[i]) ||
+        manager->subunits[indices[i]].parent !=
+            manager->subunits[indices[0]].parent)
+      return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Not siblings"};
+    for (int j = 0; j < i; j++)
+      if (indices[j] == indices[i])
+        return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Repeated subunit"};
+  }
 
   int64_t total_pop = 0;
   civ_float_t total_gdp = 0;
   civ_float_t avg_loyalty = 0;
 
   for (int i = 0; i < count; i++) {
-    total_pop += subunits[i]->population;
-    total_gdp += subunits[i]->gdp;
-    avg_loyalty += subunits[i]->loyalty;
+    const civ_subunit_t *s = &manager->subunits[indices[i]];
+    total_pop += s->population;
+    total_gdp += s->gdp;
+    avg_loyalty += s->loyalty;
   }
   avg_loyalty /= count;
 
   char new_id[STRING_SHORT_LEN];
-  snprintf(new_id, STRING_SHORT_LEN, "merged_%ld", (long)time(NULL));
-
-  civ_subunit_t *merged =
-      civ_subunit_create(new_id, new_name, subunits[0]->type);
-  if (merged) {
-    merged->population = total_pop;
-    merged->gdp = total_gdp;
-    merged->loyalty = avg_loyalty;
-
-    civ_subunit_manager_add(manager, merged);
-    if (out_merged)
-      *out_merged = merged; // This is risky if we free merged below, but
-                            // manager has copy.
-
-    // Same cleanup as split
-    CIV_FREE(merged->child_ids);
-    CIV_FREE(merged);
-  }
+  snprintf(new_id, STRING_SHORT_LEN, "merged_%ld_%zu", (long)time(NULL),
+           manager->subunit_count);
+
+  civ_subunit_t merged;
+  civ_subunit_init(&merged, new_id, new_name,
+                   manager->subunits[indices[0]].type);
+  merged.population = total_pop;
+  merged.gdp = total_gdp;
+  merged.loyalty = avg_loyalty;
+
+  int32_t added = CIV_SUBUNIT_NONE;
+  civ_result_t result = civ_subunit_manager_add(
+      manager, &merged, manager->subunits[indices[0]].parent, &added);
+  if (CIV_FAILED(result))
+    return result;
 
+  for (int i = 0; i < count; i++) {
+    if (!adopt_children(manager, indices[i], added))
+      return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Out of memory"};
+    retire(manager, indices[i]);
+  }
+  if (out_index)
+    *out_index = added;
   return (civ_result_t){CIV_OK, "Merge successful"};
 }
 
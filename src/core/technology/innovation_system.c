@@ -27,8 +27,10 @@ civ_innovation_system_t *civ_innovation_system_create(void) {
     strncpy(is->domains[i].name, s_domain_names[i],
             sizeof(is->domains[i].name) - 1);
     is->domains[i].index = 0;
+    is->domains[i].global_rank = 1;
     is->allocation[i] = 1.0f / (float)CIV_TECH_DOMAIN_COUNT;
   }
+  is->aggregate_rank = 1;
   return is;
 }
 
@@ -80,6 +82,11 @@ void civ_innovation_system_update(civ_innovation_system_t *is, float dt) {
     is->domains[i].growth_rate = growth;
     is->domains[i].index += (int32_t)growth;
   }
+  civ_innovation_system_refresh_aggregate(is);
+}
+
+void civ_innovation_system_refresh_aggregate(civ_innovation_system_t *is) {
+  if (!is) return;
 
   /* Aggregate index: weighted average across all domains */
   float weighted_sum = 0.0f, total_weight = 0.0f;
@@ -89,11 +96,36 @@ void civ_innovation_system_update(civ_innovation_system_t *is, float dt) {
   }
   is->aggregate_index =
       (int32_t)(weighted_sum / (total_weight > 0.0f ? total_weight : 1.0f));
+}
 
-  /* Rankings — placeholder, real ranking compares against AI nations */
-  is->aggregate_rank = 1;
+static int compare_descending(const void *a, const void *b) {
+  int32_t x = *(const int32_t *)a, y = *(const int32_t *)b;
+  return (x < y) - (x > y);
+}
+
+/* Rivals strictly ahead of index in a descending array */
+static size_t count_ahead(const int32_t *sorted, size_t count, int32_t index) {
+  size_t lo = 0, hi = count;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (sorted[mid] > index) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+void civ_innovation_system_rank(civ_innovation_system_t *is, int32_t *rivals,
+                                size_t count) {
+  if (!is || (count > 0 && !rivals)) return;
+
+  qsort(rivals, count, sizeof(int32_t), compare_descending);
+  int64_t sum = 0;
+  for (size_t i = 0; i < count; i++) sum += rivals[i];
+
+  is->aggregate_rank = (int32_t)count_ahead(rivals, count, is->aggregate_index) + 1;
   for (int i = 0; i < CIV_TECH_DOMAIN_COUNT; i++) {
-    is->domains[i].global_average = 200;
-    is->domains[i].global_rank = 1;
+    civ_tech_domain_state_t *d = &is->domains[i];
+    d->global_rank = (int32_t)count_ahead(rivals, count, d->index) + 1;
+    d->global_average = (int32_t)((sum + d->index) / (int64_t)(count + 1));
   }
 }
@@ -0,0 +1,315 @@
+/**
+ * @file tech_diffusion.c
+ * @brief Technology diffusion as a sparse product over the nation graph
+ */
+#include "core/technology/tech_diffusion.h"
+#include "common.h"
+#include "core/simulation_engine/worker_pool.h"
+#include "core/world/owner_ids.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DOMAINS CIV_TECH_DOMAIN_COUNT
+
+/* Weight a treaty adds to its signatories' link */
+static const float k_treaty_weight[CIV_TREATY_TYPE_COUNT] = {
+    0.25f, /* trade agreement */
+    0.0f,  /* non-aggression */
+    0.1f,  /* defensive pact */
+    0.5f,  /* military alliance */
+    1.0f,  /* research partnership */
+};
+
+civ_tech_diffusion_t *civ_tech_diffusion_create(void) {
+  civ_tech_diffusion_t *diffusion =
+      (civ_tech_diffusion_t *)CIV_CALLOC(1, sizeof(civ_tech_diffusion_t));
+  if (!diffusion) {
+    civ_log(CIV_LOG_ERROR, "Failed to allocate tech diffusion");
+    return NULL;
+  }
+  diffusion->rate = CIV_TECH_DIFFUSION_RATE;
+  return diffusion;
+}
+
+void civ_tech_diffusion_destroy(civ_tech_diffusion_t *diffusion) {
+  if (!diffusion) return;
+  CIV_FREE(diffusion->adj_start);
+  CIV_FREE(diffusion->adj_target);
+  CIV_FREE(diffusion->adj_weight);
+  civ_border_frontier_destroy(diffusion->frontier);
+  CIV_FREE(diffusion->levels);
+  CIV_FREE(diffusion->next_levels);
+  CIV_FREE(diffusion->written);
+  CIV_FREE(diffusion);
+}
+
+/* ── Links ─────────────────────────────────────────────────────────── */
+typedef struct {
+  uint32_t a, b;
+  float weight;
+} link_t;
+
+static int compare_link(const void *x, const void *y) {
+  const link_t *l = (const link_t *)x, *r = (const link_t *)y;
+  if (l->a != r->a) return l->a < r->a ? -1 : 1;
+  return (l->b > r->b) - (l->b < r->b);
+}
+
+static bool push_link(link_t **links, size_t *count, size_t *cap, int32_t a,
+                      int32_t b, float weight) {
+  if (a < 0 || b < 0 || a == b || weight <= 0.0f) return true;
+  if (*count + 2 > *cap) {
+    size_t grown_cap = *cap ? *cap * 2 : 64;
+    link_t *grown = (link_t *)CIV_REALLOC(*links, grown_cap * sizeof(link_t));
+    if (!grown) return false;
+    *links = grown;
+    *cap = grown_cap;
+  }
+  (*links)[(*count)++] = (link_t){(uint32_t)a, (uint32_t)b, weight};
+  (*links)[(*count)++] = (link_t){(uint32_t)b, (uint32_t)a, weight};
+  return true;
+}
+
+static int32_t nation_of_owner(const civ_nation_manager_t *nm,
+                               civ_owner_index_t owner) {
+  if (owner == CIV_OWNER_NONE || !nm->owner_nation ||
+      owner >= nm->owner_nation_size)
+    return -1;
+  return nm->owner_nation[owner];
+}
+
+static int32_t nation_of_id(const civ_nation_manager_t *nm, const char *id) {
+  return id ? nation_of_owner(nm, civ_owner_find(id)) : -1;
+}
+
+/* The pair (i, j), i < j, behind relation id j * (j - 1) / 2 + i */
+static void relation_pair(civ_relation_id_t id, size_t *i, size_t *j) {
+  size_t b = (size_t)((1.0 + sqrt(1.0 + 8.0 * (double)id)) * 0.5);
+  while (b * (b - 1) / 2 > (size_t)id) b--;
+  while ((b + 1) * b / 2 <= (size_t)id) b++;
+  *j = b;
+  *i = (size_t)id - b * (b - 1) / 2;
+}
+
+civ_result_t civ_tech_diffusion_link(civ_tech_diffusion_t *diffusion,
+                                     const civ_nation_manager_t *nations,
+                                     civ_map_t *map,
+                                     const civ_trade_manager_t *trade,
+                                     const civ_diplomacy_system_t *diplomacy) {
+  civ_result_t result = {CIV_OK, NULL};
+  if (!diffusion || !nations) {
+    result.error = CIV_ERROR_NULL_POINTER;
+    return result;
+  }
+  diffusion->adj_count = 0;
+  diffusion->linked_nations = 0;
+  if (nations->count < 2) return result;
+
+  link_t *links = NULL;
+  size_t count = 0, cap = 0;
+  bool ok = true;
+  if (map) {
+    if (!diffusion->frontier) diffusion->frontier = civ_border_frontier_create();
+    ok = diffusion->frontier && civ_border_frontier_attach(diffusion->frontier, map);
+    const civ_border_frontier_t *f = diffusion->frontier;
+    for (uint32_t k = 0; ok && k < f->pair_capacity; k++) {
+      uint32_t key = f->pair_keys[k];
+      if (key == 0 || f->pair_sets[k].count == 0) continue;
+      uint32_t owner = (key - 1) >> 16, neighbour = (key - 1) & 0xFFFFu;
+      /* Each border is stored from both sides; take it once */
+      if (owner >= neighbour) continue;
+      uint32_t shared = MIN(f->pair_sets[k].count, (uint32_t)CIV_TECH_FULL_BORDER);
+      ok = push_link(&links, &count, &cap,
+                     nation_of_owner(nations, (civ_owner_index_t)owner),
+                     nation_of_owner(nations, (civ_owner_index_t)neighbour),
+                     CIV_TECH_BORDER_WEIGHT * (float)shared / CIV_TECH_FULL_BORDER);
+    }
+  }
+  for (size_t r = 0; ok && trade && r < trade->route_count; r++) {
+    const civ_trade_route_t *route = &trade->routes[r];
+    if (!route->active) continue;
+    ok = push_link(&links, &count, &cap, nation_of_id(nations, route->source_nation_id),
+                   nation_of_id(nations, route->target_nation_id),
+                   CIV_TECH_TRADE_WEIGHT);
+  }
+  if (ok && diplomacy && diplomacy->nation_count > 1) {
+    /* Friendly relations are never at rest, so the active set holds them all */
+    int32_t *nation_of = (int32_t *)CIV_MALLOC(diplomacy->nation_count * sizeof(int32_t));
+    ok = nation_of != NULL;
+    for (size_t i = 0; ok && i < diplomacy->nation_count; i++)
+      nation_of[i] = nation_of_id(nations, diplomacy->nation_ids[i]);
+    for (size_t a = 0; ok && a < diplomacy->active_count; a++) {
+      civ_relation_id_t id = diplomacy->active_ids[a];
+      if (diplomacy->rel.relation_level[id] < CIV_RELATION_LEVEL_FRIENDLY) continue;
+      size_t i, j;
+      relation_pair(id, &i, &j);
+      if (j >= diplomacy->nation_count) continue;
+      ok = push_link(&links, &count, &cap, nation_of[i], nation_of[j],
+                     CIV_TECH_RELATION_WEIGHT * (float)diplomacy->rel.trust[id]);
+    }
+    CIV_FREE(nation_of);
+    for (size_t t = 0; ok && t < diplomacy->treaty_count; t++) {
+      const civ_treaty_t *treaty = &diplomacy->treaties[t];
+      if (!treaty->active || treaty->signatory_count < 2 ||
+          treaty->treaty_type >= CIV_TREATY_TYPE_COUNT)
+        continue;
+      ok = push_link(&links, &count, &cap, nation_of_id(nations, treaty->signatories[0]),
+                     nation_of_id(nations, treaty->signatories[1]),
+                     k_treaty_weight[treaty->treaty_type]);
+    }
+  }
+
+  /* Everything joining a pair adds up */
+  if (count > 0) qsort(links, count, sizeof(link_t), compare_link);
+  size_t rows = (size_t)nations->count;
+  uint32_t *start = (uint32_t *)CIV_REALLOC(diffusion->adj_start,
+                                            (rows + 1) * sizeof(uint32_t));
+  if (start) diffusion->adj_start = start;
+  if (ok && start && count > diffusion->adj_capacity) {
+    uint32_t *target = (uint32_t *)CIV_REALLOC(diffusion->adj_target,
+                                               count * sizeof(uint32_t));
+    if (target) diffusion->adj_target = target;
+    float *weight = (float *)CIV_REALLOC(diffusion->adj_weight, count * sizeof(float));
+    if (weight) diffusion->adj_weight = weight;
+    ok = target && weight;
+    if (ok) diffusion->adj_capacity = count;
+  }
+  if (!ok || !start) {
+    CIV_FREE(links);
+    result.error = CIV_ERROR_OUT_OF_MEMORY;
+    return result;
+  }
+
+  size_t n = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (n > 0 && links[i].a == links[n - 1].a &&
+        diffusion->adj_target[n - 1] == links[i].b) {
+      diffusion->adj_weight[n - 1] += links[i].weight;
+      continue;
+    }
+    diffusion->adj_target[n] = links[i].b;
+    diffusion->adj_weight[n] = links[i].weight;
+    links[n++].a = links[i].a;
+  }
+  memset(start, 0, (rows + 1) * sizeof(uint32_t));
+  for (size_t i = 0; i < n; i++) start[links[i].a + 1]++;
+  for (size_t i = 0; i < rows; i++) start[i + 1] += start[i];
+  CIV_FREE(links);
+  diffusion->adj_count = n;
+  diffusion->linked_nations = rows;
+  return result;
+}
+
+/* ── Levels ────────────────────────────────────────────────────────── */
+
+/* What nation i holds in each domain outside the diffusion */
+static void outside_row(const civ_nation_manager_t *nm,
+                        const civ_innovation_system_t *player_tree, size_t i,
+                        int32_t *out) {
+  bool player = player_tree && (int)i == nm->player_nation_index;
+  for (int k = 0; k < DOMAINS; k++)
+    out[k] = player ? player_tree->domains[k].index : nm->nations[i].tech_index;
+}
+
+static bool reserve_rows(civ_tech_diffusion_t *d, size_t rows) {
+  if (rows <= d->rows) return true;
+  float *levels = (float *)CIV_REALLOC(d->levels, rows * DOMAINS * sizeof(float));
+  if (levels) d->levels = levels;
+  float *next = (float *)CIV_REALLOC(d->next_levels, rows * DOMAINS * sizeof(float));
+  if (next) d->next_levels = next;
+  int32_t *written = (int32_t *)CIV_REALLOC(d->written, rows * DOMAINS * sizeof(int32_t));
+  if (written) d->written = written;
+  return levels && next && written;
+}
+
+typedef struct {
+  const civ_tech_diffusion_t *d;
+  float scale;
+} tick_ctx_t;
+
+/* Row i of next: the weighted sum of the neighbours' rows, then each domain
+   below the weighted mean closes part of the gap */
+static void tick_row(void *arg, int i) {
+  const tick_ctx_t *ctx = (const tick_ctx_t *)arg;
+  const civ_tech_diffusion_t *d = ctx->d;
+  const float *own = d->levels + (size_t)i * DOMAINS;
+  float *next = d->next_levels + (size_t)i * DOMAINS;
+  float acc[DOMAINS] = {0};
+  float total = 0.0f;
+
+  for (uint32_t e = d->adj_start[i]; e < d->adj_start[i + 1]; e++) {
+    float w = d->adj_weight[e];
+    const float *row = d->levels + (size_t)d->adj_target[e] * DOMAINS;
+    for (int k = 0; k < DOMAINS; k++) acc[k] += w * row[k];
+    total += w;
+  }
+  if (total <= 0.0f) {
+    memcpy(next, own, DOMAINS * sizeof(float));
+    return;
+  }
+  float pull = ctx->scale * MIN(total, 1.0f), inv = 1.0f / total;
+  for (int k = 0; k < DOMAINS; k++) {
+    float gap = acc[k] * inv - own[k];
+    next[k] = own[k] + (gap > 0.0f ? gap * pull : 0.0f);
+  }
+}
+
+civ_result_t civ_tech_diffusion_process(civ_tech_diffusion_t *diffusion,
+                                        civ_nation_manager_t *nations,
+                                        civ_innovation_system_t *player_tree,
+                                        struct civ_worker_pool *pool,
+                                        civ_float_t time_delta) {
+  civ_result_t result = {CIV_OK, NULL};
+  if (!diffusion || !nations) {
+    result.error = CIV_ERROR_NULL_POINTER;
+    return result;
+  }
+  size_t rows = (size_t)nations->count;
+  /* Links from an older nation list are ignored until relinked */
+  if (rows == 0 || diffusion->linked_nations != rows || diffusion->adj_count == 0)
+    return result;
+
+  size_t known = diffusion->rows;
+  if (!reserve_rows(diffusion, rows)) {
+    result.error = CIV_ERROR_OUT_OF_MEMORY;
+    return result;
+  }
+  diffusion->rows = MAX(rows, known);
+
+  /* Carry in what moved outside: research, loads, new nations */
+  int32_t outside[DOMAINS];
+  for (size_t i = 0; i < rows; i++) {
+    float *level = diffusion->levels + i * DOMAINS;
+    int32_t *written = diffusion->written + i * DOMAINS;
+    outside_row(nations, player_tree, i, outside);
+    for (int k = 0; k < DOMAINS; k++) {
+      if (i >= known) level[k] = (float)outside[k];
+      else level[k] += (float)(outside[k] - written[k]);
+    }
+  }
+
+  tick_ctx_t ctx = {diffusion, (float)(diffusion->rate * time_delta)};
+  civ_worker_pool_parallel_for(pool, (int)rows, tick_row, &ctx);
+  float *swap = diffusion->levels;
+  diffusion->levels = diffusion->next_levels;
+  diffusion->next_levels = swap;
+
+  /* Scatter on this thread: the player's domains, everyone else's mean */
+  for (size_t i = 0; i < rows; i++) {
+    const float *level = diffusion->levels + i * DOMAINS;
+    int32_t *written = diffusion->written + i * DOMAINS;
+    if (player_tree && (int)i == nations->player_nation_index) {
+      for (int k = 0; k < DOMAINS; k++)
+        written[k] = player_tree->domains[k].index = (int32_t)floorf(level[k]);
+      civ_innovation_system_refresh_aggregate(player_tree);
+      continue;
+    }
+    float sum = 0.0f;
+    for (int k = 0; k < DOMAINS; k++) sum += level[k];
+    int32_t mean = (int32_t)floorf(sum / DOMAINS);
+    nations->nations[i].tech_index = mean;
+    for (int k = 0; k < DOMAINS; k++) written[k] = mean;
+  }
+  return result;
+}
@@ -59,16 +59,16 @@ civ_result_t civ_cultural_display_update(civ_cultural_display_t* display,
             strncpy(disp->target_culture, event->target_culture_id, sizeof(disp->target_culture) - 1);
             strncpy(disp->region, event->region_id, sizeof(disp->region) - 1);
             disp->type = event->type;
-            disp->progress = event->progress;
-            disp->adoption_level = event->adoption_level;
+            disp->progress = assimilation_tracker->progress[i];
+            disp->adoption_level = assimilation_tracker->adoption_level[i];
             disp->population_affected = event->population_affected;
             
             /* Determine status */
-            if (event->progress < 0.1f) {
+            if (disp->progress < 0.1f) {
                 strcpy(disp->status, "spreading");
-            } else if (event->progress < 0.5f) {
+            } else if (disp->progress < 0.5f) {
                 strcpy(disp->status, event->type == CIV_ASSIMILATION_FORCED ? "imposing" : "adopting");
-            } else if (event->progress < 1.0f) {
+            } else if (disp->progress < 1.0f) {
                 strcpy(disp->status, "integrating");
             } else {
                 strcpy(disp->status, "complete");
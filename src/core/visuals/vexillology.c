@@ -5,7 +5,9 @@
 
 #include "core/visuals/vexillology.h"
 #include "common.h"
+#include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 
@@ -17,7 +19,7 @@ void civ_vexillology_init(civ_flag_t *flag) {
   strncpy(flag->description, "A blank slate.", STRING_MEDIUM_LEN - 1);
 
   /* Add base layer */
-  civ_vexillology_add_layer(flag, CIV_FLAG_PLAIN, CIV_SYMBOL_NONE, "#FFFFFF",
+  civ_vexillology_add_layer(flag, CIV_FLAG_PLAIN, CIV_FLAG_SYMBOL_NONE, "#FFFFFF",
                             "#000000");
 }
 
@@ -46,6 +48,12 @@ void civ_vexillology_add_layer(civ_flag_t *flag, civ_flag_pattern_t pattern,
   flag->uniqueness_hash = civ_vexillology_calculate_hash(flag);
 }
 
+static uint64_t hash_string(uint64_t hash, const char *s) {
+  for (; *s; s++)
+    hash = ((hash << 5) + hash) + (uint8_t)*s;
+  return ((hash << 5) + hash) + 0xFF;
+}
+
 uint64_t civ_vexillology_calculate_hash(const civ_flag_t *flag) {
   if (!flag)
     return 0;
@@ -53,8 +61,162 @@ uint64_t civ_vexillology_calculate_hash(const civ_flag_t *flag) {
   for (int i = 0; i < flag->layer_count; i++) {
     hash = ((hash << 5) + hash) + flag->layers[i].pattern;
     hash = ((hash << 5) + hash) + flag->layers[i].symbol;
+    hash = hash_string(hash, flag->layers[i].primary_color);
+    hash = hash_string(hash, flag->layers[i].secondary_color);
+  }
+  return hash ? hash : 1;
+}
+
+void civ_vexillology_generate(civ_flag_t *flag, uint64_t seed, uint32_t primary,
+                              uint32_t secondary) {
+  if (!flag)
+    return;
+  char p[16], s[16];
+  snprintf(p, sizeof(p), "#%06X", (unsigned)(primary & 0xFFFFFF));
+  snprintf(s, sizeof(s), "#%06X", (unsigned)(secondary & 0xFFFFFF));
+  if ((primary & 0xFFFFFF) == (secondary & 0xFFFFFF))
+    snprintf(s, sizeof(s), "#%06X", (unsigned)(~primary & 0xFFFFFF));
+
+  seed ^= seed >> 33;
+  seed *= 0xFF51AFD7ED558CCDull;
+  seed ^= seed >> 33;
+  civ_flag_pattern_t pattern = (civ_flag_pattern_t)(seed % (CIV_FLAG_PLAIN + 1));
+  civ_flag_symbol_t symbol =
+      (civ_flag_symbol_t)((seed >> 8) % (CIV_FLAG_SYMBOL_MOUNTAIN + 1));
+  civ_vexillology_init(flag);
+  flag->layer_count = 0;
+  civ_vexillology_add_layer(flag, pattern, symbol, p, s);
+}
+
+/* ── Rasterizer ────────────────────────────────────────────────────── */
+
+typedef struct {
+  uint8_t r, g, b;
+} rgb_t;
+
+static rgb_t parse_color(const char *hex) {
+  rgb_t c = {0, 0, 0};
+  if (!hex || hex[0] != '#')
+    return c;
+  unsigned long v = strtoul(hex + 1, NULL, 16);
+  c.r = (uint8_t)(v >> 16);
+  c.g = (uint8_t)(v >> 8);
+  c.b = (uint8_t)v;
+  return c;
+}
+
+enum { PAINT_NONE, PAINT_FIELD, PAINT_CHARGE, PAINT_WHITE };
+
+/* What pattern puts at (u, v), both 0-1 across the flag */
+static int pattern_at(civ_flag_pattern_t pattern, float u, float v) {
+  switch (pattern) {
+  case CIV_FLAG_HORIZONTAL_STRIPES:
+    return ((int)(v * 3.0f) & 1) ? PAINT_CHARGE : PAINT_FIELD;
+  case CIV_FLAG_VERTICAL_STRIPES:
+    return ((int)(u * 3.0f) & 1) ? PAINT_CHARGE : PAINT_FIELD;
+  case CIV_FLAG_TRI_COLOR:
+    return u < 1.0f / 3.0f ? PAINT_FIELD : u < 2.0f / 3.0f ? PAINT_WHITE : PAINT_CHARGE;
+  case CIV_FLAG_SALTIRE:
+    return (fabsf(u - v) < 0.1f || fabsf(u + v - 1.0f) < 0.1f) ? PAINT_CHARGE : PAINT_NONE;
+  case CIV_FLAG_CROSS:
+    return (fabsf(u - 0.375f) < 0.07f || fabsf(v - 0.5f) < 0.1f) ? PAINT_CHARGE : PAINT_NONE;
+  case CIV_FLAG_CANTON:
+    return (u < 0.45f && v < 0.5f) ? PAINT_CHARGE : PAINT_NONE;
+  case CIV_FLAG_PALE:
+    return fabsf(u - 0.5f) < 0.17f ? PAINT_CHARGE : PAINT_NONE;
+  case CIV_FLAG_FESS:
+    return fabsf(v - 0.5f) < 0.17f ? PAINT_CHARGE : PAINT_NONE;
+  case CIV_FLAG_PLAIN:
+  default:
+    return PAINT_FIELD;
+  }
+}
+
+/* Whether symbol covers (x, y), both -1 to 1 across its box */
+static bool symbol_at(civ_flag_symbol_t symbol, float x, float y) {
+  float r2 = x * x + y * y;
+  switch (symbol) {
+  case CIV_FLAG_SYMBOL_STAR: {
+    /* Five points: the radius swings between 1 and 0.4 with the angle */
+    float a = atan2f(x, -y) * (5.0f / (2.0f * (float)M_PI));
+    float f = fabsf(a - floorf(a) - 0.5f) * 2.0f;
+    float rim = 0.4f + 0.6f * f;
+    return r2 <= rim * rim;
+  }
+  case CIV_FLAG_SYMBOL_SUN:
+    return r2 < 0.3f || (r2 < 1.0f && ((int)((atan2f(y, x) + (float)M_PI) * 2.5f) & 1));
+  case CIV_FLAG_SYMBOL_MOON: {
+    float dx = x - 0.35f;
+    return r2 < 0.8f && dx * dx + y * y > 0.5f;
+  }
+  case CIV_FLAG_SYMBOL_MOUNTAIN:
+    return y > -0.8f && y < 0.8f && fabsf(x) < (y + 0.8f) * 0.6f;
+  case CIV_FLAG_SYMBOL_HAMMER:
+    return (y < -0.4f && y > -0.8f && fabsf(x) < 0.7f) || (fabsf(x) < 0.15f && y < 0.8f && y > -0.8f);
+  case CIV_FLAG_SYMBOL_ANCHOR:
+    return (fabsf(x) < 0.12f && y > -0.8f && y < 0.7f) ||
+           (y > -0.6f && y < -0.45f && fabsf(x) < 0.45f) ||
+           (r2 > 0.45f && r2 < 0.7f && y > 0.2f);
+  case CIV_FLAG_SYMBOL_WHEAT:
+    return x * x * 4.0f + y * y < 0.7f;
+  case CIV_FLAG_SYMBOL_LION:
+  case CIV_FLAG_SYMBOL_EAGLE:
+    /* A shield */
+    return fabsf(x) < 0.7f && y > -0.8f && (y < 0.2f || fabsf(x) < (0.8f - y) * 1.2f);
+  case CIV_FLAG_SYMBOL_NONE:
+  default:
+    return false;
+  }
+}
+
+void civ_vexillology_rasterize(const civ_flag_t *flag, uint8_t *rgba, int w,
+                               int h, int stride) {
+  if (!flag || !rgba || w <= 0 || h <= 0)
+    return;
+  for (int y = 0; y < h; y++)
+    memset(rgba + (size_t)y * stride, 0xFF, (size_t)w * 4);
+
+  for (int l = 0; l < flag->layer_count; l++) {
+    const civ_flag_layer_t *layer = &flag->layers[l];
+    rgb_t field = parse_color(layer->primary_color);
+    rgb_t charge = parse_color(layer->secondary_color);
+    const rgb_t white = {0xFF, 0xFF, 0xFF};
+    bool stripes = layer->pattern == CIV_FLAG_HORIZONTAL_STRIPES ||
+                   layer->pattern == CIV_FLAG_VERTICAL_STRIPES ||
+                   layer->pattern == CIV_FLAG_TRI_COLOR;
+    bool paint_field = stripes || layer->pattern == CIV_FLAG_PLAIN;
+
+    /* The symbol's box: the canton, or the middle of the flag */
+    bool in_canton = layer->pattern == CIV_FLAG_CANTON;
+    float box_u = in_canton ? 0.225f : 0.5f, box_v = in_canton ? 0.25f : 0.5f;
+    float box_h = in_canton ? 0.18f : 0.3f;
+    float box_w = box_h * (float)h / (float)w;
+
+    for (int y = 0; y < h; y++) {
+      uint8_t *row = rgba + (size_t)y * stride;
+      float v = ((float)y + 0.5f) / (float)h;
+      for (int x = 0; x < w; x++) {
+        float u = ((float)x + 0.5f) / (float)w;
+        int paint = pattern_at(layer->pattern, u, v);
+        const rgb_t *c = NULL;
+        if (paint == PAINT_CHARGE)
+          c = &charge;
+        else if (paint == PAINT_WHITE)
+          c = &white;
+        else if (l == 0 || (paint == PAINT_FIELD && paint_field))
+          c = &field;
+        if (layer->symbol != CIV_FLAG_SYMBOL_NONE &&
+            symbol_at(layer->symbol, (u - box_u) / box_w, (v - box_v) / box_h))
+          c = paint == PAINT_CHARGE ? &field : &charge;
+        if (!c)
+          continue;
+        row[x * 4 + 0] = c->r;
+        row[x * 4 + 1] = c->g;
+        row[x * 4 + 2] = c->b;
+        row[x * 4 + 3] = 0xFF;
+      }
+    }
   }
-  return hash;
 }
 
 const char *civ_vexillology_describe(const civ_flag_t *flag) {
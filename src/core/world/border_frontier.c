@@ -0,0 +1,267 @@
+/**
+ * @file border_frontier.c
+ * @brief Per-owner-pair contact tile sets, maintained on ownership change
+ */
+#include "core/world/border_frontier.h"
+#include "common.h"
+#include <string.h>
+
+#define SLOT_EMPTY     0u
+#define SLOT_TOMBSTONE UINT32_MAX
+
+/* ── Tile sets ─────────────────────────────────────────────────────── */
+static uint32_t hash_u32(uint32_t v) {
+  return v * 2654435761u;
+}
+
+static bool set_rehash(civ_frontier_set_t *s, uint32_t want) {
+  uint32_t cap = 16;
+  while (cap < want * 2) cap <<= 1;
+  uint32_t *slots = CIV_CALLOC(cap, sizeof(uint32_t));
+  if (!slots) return false;
+  for (uint32_t i = 0; i < s->capacity; i++) {
+    uint32_t v = s->slots[i];
+    if (v == SLOT_EMPTY || v == SLOT_TOMBSTONE) continue;
+    uint32_t h = hash_u32(v) & (cap - 1);
+    while (slots[h] != SLOT_EMPTY) h = (h + 1) & (cap - 1);
+    slots[h] = v;
+  }
+  CIV_FREE(s->slots);
+  s->slots = slots;
+  s->capacity = cap;
+  s->used = s->count;
+  return true;
+}
+
+static void set_insert(civ_frontier_set_t *s, uint32_t tile) {
+  if ((s->used + 1) * 2 > s->capacity && !set_rehash(s, s->count + 1)) return;
+  uint32_t v = tile + 1;
+  uint32_t mask = s->capacity - 1;
+  uint32_t h = hash_u32(v) & mask;
+  uint32_t grave = UINT32_MAX;
+  for (;;) {
+    uint32_t cur = s->slots[h];
+    if (cur == v) return;
+    if (cur == SLOT_EMPTY) break;
+    if (cur == SLOT_TOMBSTONE && grave == UINT32_MAX) grave = h;
+    h = (h + 1) & mask;
+  }
+  if (grave != UINT32_MAX) {
+    h = grave;
+  } else {
+    s->used++;
+  }
+  s->slots[h] = v;
+  s->count++;
+}
+
+static void set_remove(civ_frontier_set_t *s, uint32_t tile) {
+  if (s->count == 0) return;
+  uint32_t v = tile + 1;
+  uint32_t mask = s->capacity - 1;
+  for (uint32_t h = hash_u32(v) & mask;; h = (h + 1) & mask) {
+    uint32_t cur = s->slots[h];
+    if (cur == SLOT_EMPTY) return;
+    if (cur == v) {
+      s->slots[h] = SLOT_TOMBSTONE;
+      s->count--;
+      return;
+    }
+  }
+}
+
+/* ── Pair table ────────────────────────────────────────────────────── */
+static uint32_t pair_key(civ_owner_index_t owner, civ_owner_index_t neighbour) {
+  return (((uint32_t)owner << 16) | neighbour) + 1;
+}
+
+static civ_frontier_set_t *pair_find(const civ_border_frontier_t *f,
+                                     uint32_t key) {
+  if (f->pair_capacity == 0) return NULL;
+  uint32_t mask = f->pair_capacity - 1;
+  for (uint32_t h = hash_u32(key) & mask;; h = (h + 1) & mask) {
+    if (f->pair_keys[h] == key) return &f->pair_sets[h];
+    if (f->pair_keys[h] == SLOT_EMPTY) return NULL;
+  }
+}
+
+static bool pair_grow(civ_border_frontier_t *f) {
+  uint32_t cap = f->pair_capacity ? f->pair_capacity * 2 : 64;
+  uint32_t *keys = CIV_CALLOC(cap, sizeof(uint32_t));
+  civ_frontier_set_t *sets = CIV_CALLOC(cap, sizeof(civ_frontier_set_t));
+  if (!keys || !sets) {
+    CIV_FREE(keys);
+    CIV_FREE(sets);
+    return false;
+  }
+  for (uint32_t i = 0; i < f->pair_capacity; i++) {
+    if (f->pair_keys[i] == SLOT_EMPTY) continue;
+    uint32_t h = hash_u32(f->pair_keys[i]) & (cap - 1);
+    while (keys[h] != SLOT_EMPTY) h = (h + 1) & (cap - 1);
+    keys[h] = f->pair_keys[i];
+    sets[h] = f->pair_sets[i];
+  }
+  CIV_FREE(f->pair_keys);
+  CIV_FREE(f->pair_sets);
+  f->pair_keys = keys;
+  f->pair_sets = sets;
+  f->pair_capacity = cap;
+  return true;
+}
+
+static civ_frontier_set_t *pair_get(civ_border_frontier_t *f, uint32_t key) {
+  civ_frontier_set_t *s = pair_find(f, key);
+  if (s) return s;
+  if ((f->pair_count + 1) * 2 > f->pair_capacity && !pair_grow(f)) return NULL;
+  uint32_t mask = f->pair_capacity - 1;
+  uint32_t h = hash_u32(key) & mask;
+  while (f->pair_keys[h] != SLOT_EMPTY) h = (h + 1) & mask;
+  f->pair_keys[h] = key;
+  f->pair_count++;
+  return &f->pair_sets[h];
+}
+
+static void pairs_clear(civ_border_frontier_t *f) {
+  for (uint32_t i = 0; i < f->pair_capacity; i++)
+    CIV_FREE(f->pair_sets[i].slots);
+  CIV_FREE(f->pair_keys);
+  CIV_FREE(f->pair_sets);
+  f->pair_keys = NULL;
+  f->pair_sets = NULL;
+  f->pair_capacity = 0;
+  f->pair_count = 0;
+}
+
+/* ── Contacts ──────────────────────────────────────────────────────── */
+/* Owner of and distinct foreign neighbour owners around tile t, reading
+   patch_owner at index patch (the pre-change state) */
+static int tile_contacts(const civ_map_t *m, size_t t, size_t patch,
+                         civ_owner_index_t patch_owner,
+                         civ_owner_index_t *self, civ_owner_index_t out[4]) {
+  civ_owner_index_t own = t == patch ? patch_owner : civ_map_owner_at(m, t);
+  *self = own;
+  if (own == CIV_OWNER_NONE || civ_map_is_water_at(m, t)) return 0;
+
+  int32_t x = (int32_t)(t % (size_t)m->width);
+  int32_t y = (int32_t)(t / (size_t)m->width);
+  size_t row = (size_t)y * m->width;
+  size_t nb[4];
+  int nn = 0;
+  nb[nn++] = row + (size_t)((x + 1) % m->width);
+  nb[nn++] = row + (size_t)((x - 1 + m->width) % m->width);
+  if (y > 0) nb[nn++] = t - m->width;
+  if (y + 1 < m->height) nb[nn++] = t + m->width;
+
+  int count = 0;
+  for (int k = 0; k < nn; k++) {
+    civ_owner_index_t o = nb[k] == patch ? patch_owner : civ_map_owner_at(m, nb[k]);
+    if (o == CIV_OWNER_NONE || o == own) continue;
+    bool seen = false;
+    for (int c = 0; c < count; c++) seen |= out[c] == o;
+    if (!seen) out[count++] = o;
+  }
+  return count;
+}
+
+static bool contains(const civ_owner_index_t *set, int n, civ_owner_index_t o) {
+  for (int i = 0; i < n; i++)
+    if (set[i] == o) return true;
+  return false;
+}
+
+static void refresh_tile(civ_border_frontier_t *f, const civ_map_t *m, size_t t,
+                         size_t changed, civ_owner_index_t old_owner) {
+  civ_owner_index_t was_self, now_self, was[4], now[4];
+  int nw = tile_contacts(m, t, changed, old_owner, &was_self, was);
+  int nn = tile_contacts(m, t, SIZE_MAX, CIV_OWNER_NONE, &now_self, now);
+  bool same_self = was_self == now_self;
+
+  for (int i = 0; i < nw; i++) {
+    if (same_self && contains(now, nn, was[i])) continue;
+    civ_frontier_set_t *s = pair_find(f, pair_key(was_self, was[i]));
+    if (s) set_remove(s, (uint32_t)t);
+  }
+  for (int i = 0; i < nn; i++) {
+    if (same_self && contains(was, nw, now[i])) continue;
+    civ_frontier_set_t *s = pair_get(f, pair_key(now_self, now[i]));
+    if (s) set_insert(s, (uint32_t)t);
+  }
+}
+
+static void frontier_listener(void *user_data, const civ_map_t *map,
+                              size_t index, civ_owner_index_t old_owner,
+                              civ_owner_index_t new_owner) {
+  (void)new_owner;
+  civ_border_frontier_t *f = (civ_border_frontier_t *)user_data;
+  int32_t x = (int32_t)(index % (size_t)map->width);
+  int32_t y = (int32_t)(index / (size_t)map->width);
+  size_t row = (size_t)y * map->width;
+
+  refresh_tile(f, map, index, index, old_owner);
+  refresh_tile(f, map, row + (size_t)((x + 1) % map->width), index, old_owner);
+  refresh_tile(f, map, row + (size_t)((x - 1 + map->width) % map->width), index,
+               old_owner);
+  if (y > 0) refresh_tile(f, map, index - map->width, index, old_owner);
+  if (y + 1 < map->height) refresh_tile(f, map, index + map->width, index, old_owner);
+}
+
+/* ── Lifecycle ─────────────────────────────────────────────────────── */
+civ_border_frontier_t *civ_border_frontier_create(void) {
+  return CIV_CALLOC(1, sizeof(civ_border_frontier_t));
+}
+
+void civ_border_frontier_destroy(civ_border_frontier_t *f) {
+  if (!f) return;
+  pairs_clear(f);
+  CIV_FREE(f);
+}
+
+bool civ_border_frontier_attach(civ_border_frontier_t *f, civ_map_t *map) {
+  if (!f || !map || !map->tiles) return false;
+  if (civ_map_has_owner_listener(map, frontier_listener, f)) return true;
+
+  pairs_clear(f);
+  size_t tile_count = (size_t)map->width * map->height;
+  for (size_t t = 0; t < tile_count; t++) {
+    civ_owner_index_t self, contacts[4];
+    int n = tile_contacts(map, t, SIZE_MAX, CIV_OWNER_NONE, &self, contacts);
+    for (int i = 0; i < n; i++) {
+      civ_frontier_set_t *s = pair_get(f, pair_key(self, contacts[i]));
+      if (!s) return false;
+      set_insert(s, (uint32_t)t);
+    }
+  }
+  /* Without a listener slot the sets are only valid until the next change;
+     the next attach rebuilds them */
+  if (!civ_map_add_owner_listener(map, frontier_listener, f))
+    civ_log(CIV_LOG_WARNING, "Border frontier: map listener table full");
+  return true;
+}
+
+void civ_border_frontier_detach(civ_border_frontier_t *f, civ_map_t *map) {
+  civ_map_remove_owner_listener(map, frontier_listener, f);
+}
+
+/* ── Queries ───────────────────────────────────────────────────────── */
+size_t civ_border_frontier_count(const civ_border_frontier_t *f,
+                                 civ_owner_index_t owner,
+                                 civ_owner_index_t neighbour) {
+  if (!f) return 0;
+  const civ_frontier_set_t *s = pair_find(f, pair_key(owner, neighbour));
+  return s ? s->count : 0;
+}
+
+size_t civ_border_frontier_collect(const civ_border_frontier_t *f,
+                                   civ_owner_index_t owner,
+                                   civ_owner_index_t neighbour,
+                                   uint32_t *out, size_t max) {
+  if (!f || !out) return 0;
+  const civ_frontier_set_t *s = pair_find(f, pair_key(owner, neighbour));
+  if (!s) return 0;
+  size_t n = 0;
+  for (uint32_t i = 0; i < s->capacity && n < max; i++) {
+    uint32_t v = s->slots[i];
+    if (v != SLOT_EMPTY && v != SLOT_TOMBSTONE) out[n++] = v - 1;
+  }
+  return n;
+}
@@ -5,6 +5,8 @@
 
 #include "core/world/cities_data.h"
 #include "common.h"
+#include "utils/mapped_file.h"
+#include "utils/store_registry.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -20,48 +22,140 @@ civ_cities_data_t *civ_cities_data_create(uint32_t map_w, uint32_t map_h) {
     if (!cd->cities) { free(cd); return NULL; }
     cd->map_width = map_w;
     cd->map_height = map_h;
+    /* Reached through the grid and the country index */
+    CIV_STORE_REGISTER("world.cities", cd, cd->count, cd->capacity,
+                       sizeof(civ_city_data_t), CIV_STORE_INDEXED);
     return cd;
 }
 
+static void free_country_index(civ_cities_data_t *cd) {
+    free(cd->country_keys);
+    free(cd->country_start);
+    free((void *)cd->country_cities);
+    cd->country_keys = NULL;
+    cd->country_start = NULL;
+    cd->country_cities = NULL;
+    cd->country_count = 0;
+}
+
 void civ_cities_data_destroy(civ_cities_data_t *cd) {
     if (!cd) return;
+    civ_store_unregister_owner(cd);
     for (int gy = 0; gy < GRID_CELLS; gy++)
         for (int gx = 0; gx < GRID_CELLS; gx++)
             free(cd->grid[gy][gx].indices);
+    free_country_index(cd);
     free(cd->cities);
     free(cd);
 }
 
-static uint32_t read_u32(FILE *f) { uint32_t v; fread(&v, 4, 1, f); return v; }
-static uint16_t read_u16(FILE *f) { uint16_t v; fread(&v, 2, 1, f); return v; }
-static uint8_t  read_u8(FILE *f)  { uint8_t v;  fread(&v, 1, 1, f); return v; }
+/* ISO-A2 as an integer; 0 for none */
+static uint16_t iso_key(const char *iso) {
+    if (!iso[0]) return 0;
+    return (uint16_t)((uint8_t)iso[0] << 8 | (uint8_t)iso[1]);
+}
+
+/* Stable by tier, so each cell lists its most populous cities first */
+static void sort_cell_by_tier(const civ_cities_data_t *cd, uint32_t *idx,
+                              uint32_t n) {
+    for (uint32_t i = 1; i < n; i++) {
+        uint32_t v = idx[i];
+        uint8_t t = cd->cities[v].tier;
+        uint32_t j = i;
+        while (j > 0 && cd->cities[idx[j - 1]].tier > t) {
+            idx[j] = idx[j - 1];
+            j--;
+        }
+        idx[j] = v;
+    }
+}
+
+typedef struct {
+    uint16_t key;
+    uint8_t  tier;
+    uint32_t index;
+} country_entry_t;
+
+static int compare_country_entry(const void *a, const void *b) {
+    const country_entry_t *x = a, *y = b;
+    if (x->key != y->key) return x->key < y->key ? -1 : 1;
+    if (x->tier != y->tier) return x->tier < y->tier ? -1 : 1;
+    return x->index < y->index ? -1 : x->index > y->index;
+}
+
+/* Group the cities by country; on failure the index stays empty and
+   country queries find nothing */
+static void build_country_index(civ_cities_data_t *cd) {
+    free_country_index(cd);
+
+    country_entry_t *entries = malloc((cd->count ? cd->count : 1) * sizeof(*entries));
+    if (!entries) return;
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < cd->count; i++) {
+        uint16_t key = iso_key(cd->cities[i].iso_a2);
+        if (key) entries[n++] = (country_entry_t){key, cd->cities[i].tier, i};
+    }
+    qsort(entries, n, sizeof(*entries), compare_country_entry);
+
+    uint32_t countries = 0;
+    for (uint32_t i = 0; i < n; i++)
+        if (i == 0 || entries[i].key != entries[i - 1].key) countries++;
 
-static void read_str(FILE *f, uint16_t len, char *out, size_t out_size) {
-    if (len >= out_size) len = (uint16_t)(out_size - 1);
-    if (len > 0) fread(out, 1, len, f);
-    out[len] = '\0';
+    cd->country_keys = malloc((countries ? countries : 1) * sizeof(uint16_t));
+    cd->country_start = malloc((countries + 1) * sizeof(uint32_t));
+    cd->country_cities = malloc((n ? n : 1) * sizeof(civ_city_data_t *));
+    if (!cd->country_keys || !cd->country_start || !cd->country_cities) {
+        free_country_index(cd);
+        free(entries);
+        return;
+    }
+
+    uint32_t k = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        if (i == 0 || entries[i].key != entries[i - 1].key) {
+            cd->country_keys[k] = entries[i].key;
+            cd->country_start[k++] = i;
+        }
+        cd->country_cities[i] = &cd->cities[entries[i].index];
+    }
+    cd->country_start[countries] = n;
+    cd->country_count = countries;
+    free(entries);
 }
 
 civ_result_t civ_cities_data_load(civ_cities_data_t *cd, const char *filepath) {
     if (!cd || !filepath) return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "NULL argument"};
 
-    FILE *f = fopen(filepath, "rb");
-    if (!f) return (civ_result_t){CIV_ERROR_IO, "Cannot open file"};
+    civ_mapped_file_t file;
+    if (!civ_mapped_file_open(&file, filepath))
+        return (civ_result_t){CIV_ERROR_IO, "Cannot open file"};
+    civ_result_t result = civ_cities_data_load_view(cd, file.data, file.size);
+    civ_mapped_file_close(&file);
+    return result;
+}
+
+civ_result_t civ_cities_data_load_view(civ_cities_data_t *cd, const uint8_t *data, size_t size) {
+    if (!cd) return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "NULL argument"};
+    civ_byte_reader_t r = civ_byte_reader_span(data, size);
 
-    uint32_t magic = read_u32(f);
-    if (magic != CITIES_MAGIC) { fclose(f); return (civ_result_t){CIV_ERROR_INVALID_DATA, "Bad magic"}; }
-    uint32_t version = read_u32(f); (void)version;
-    uint32_t width = read_u32(f);
-    uint32_t height = read_u32(f);
-    uint32_t count = read_u32(f);
+    uint32_t magic = civ_byte_reader_u32(&r);
+    if (magic != CITIES_MAGIC)
+        return (civ_result_t){CIV_ERROR_INVALID_DATA, "Bad magic"};
+    uint32_t version = civ_byte_reader_u32(&r); (void)version;
+    uint32_t width = civ_byte_reader_u32(&r);
+    uint32_t height = civ_byte_reader_u32(&r);
+    uint32_t count = civ_byte_reader_u32(&r);
 
     if (count > cd->capacity) {
         civ_city_data_t *tmp = realloc(cd->cities, count * sizeof(civ_city_data_t));
-        if (!tmp) { fclose(f); return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "realloc"}; }
+        if (!tmp) return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "realloc"};
         cd->cities = tmp;
         cd->capacity = count;
     }
     cd->count = count;
+    for (int gy = 0; gy < GRID_CELLS; gy++)
+        for (int gx = 0; gx < GRID_CELLS; gx++)
+            cd->grid[gy][gx].count = 0;
 
     /* Cell dimensions for spatial grid */
     uint32_t cell_w = (width + GRID_CELLS - 1) / GRID_CELLS;
@@ -70,16 +164,21 @@ civ_result_t civ_cities_data_load(civ_cities_data_t *cd, const char *filepath) {
     for (uint32_t i = 0; i < count; i++) {
         civ_city_data_t *c = &cd->cities[i];
 
-        uint16_t name_len = read_u16(f);
-        read_str(f, name_len, c->name, CIV_CITY_NAME_MAX);
-        uint8_t iso_len = read_u8(f);
-        read_str(f, iso_len, c->iso_a2, sizeof(c->iso_a2));
+        uint16_t name_len = civ_byte_reader_u16(&r);
+        civ_byte_reader_str(&r, name_len, c->name, CIV_CITY_NAME_MAX);
+        uint8_t iso_len = civ_byte_reader_u8(&r);
+        civ_byte_reader_str(&r, iso_len, c->iso_a2, sizeof(c->iso_a2));
 
-        c->tile_x = read_u16(f);
-        c->tile_y = read_u16(f);
-        c->population = read_u32(f);
-        c->capital_flag = read_u8(f);
-        c->tier = read_u8(f);
+        c->tile_x = civ_byte_reader_u16(&r);
+        c->tile_y = civ_byte_reader_u16(&r);
+        c->population = civ_byte_reader_u32(&r);
+        c->capital_flag = civ_byte_reader_u8(&r);
+        c->tier = civ_byte_reader_u8(&r);
+        if (!r.ok) {
+            /* Keep the cities that were read in full */
+            cd->count = i;
+            break;
+        }
 
         /* Insert into spatial grid */
         int gx = c->tile_x / cell_w;
@@ -99,95 +198,170 @@ civ_result_t civ_cities_data_load(civ_cities_data_t *cd, const char *filepath) {
         }
     }
 
-    fclose(f);
+    for (int gy = 0; gy < GRID_CELLS; gy++)
+        for (int gx = 0; gx < GRID_CELLS; gx++)
+            sort_cell_by_tier(cd, cd->grid[gy][gx].indices, cd->grid[gy][gx].count);
+    build_country_index(cd);
+
     return (civ_result_t){CIV_OK, "Loaded"};
 }
 
-const civ_city_data_t **civ_cities_query_tiles(
-    const civ_cities_data_t *cd,
-    int32_t tile_x, int32_t tile_y,
-    int32_t tile_w, int32_t tile_h,
-    uint32_t min_tier,
-    uint32_t *out_count) {
-
-    if (out_count) *out_count = 0;
-    if (!cd || tile_w <= 0 || tile_h <= 0) return NULL;
+/* Grid cells under a tile viewport, clamped to the grid */
+typedef struct { int gx0, gy0, gx1, gy1; } cell_range_t;
 
+static cell_range_t viewport_cells(const civ_cities_data_t *cd,
+                                   int32_t tile_x, int32_t tile_y,
+                                   int32_t tile_w, int32_t tile_h) {
     uint32_t cell_w = (cd->map_width + GRID_CELLS - 1) / GRID_CELLS;
     uint32_t cell_h = (cd->map_height + GRID_CELLS - 1) / GRID_CELLS;
+    if (cell_w == 0) cell_w = 1;
+    if (cell_h == 0) cell_h = 1;
 
-    int gx_start = tile_x / (int32_t)cell_w;
-    int gy_start = tile_y / (int32_t)cell_h;
-    int gx_end   = (tile_x + tile_w) / (int32_t)cell_w;
-    int gy_end   = (tile_y + tile_h) / (int32_t)cell_h;
-    if (gx_start < 0) gx_start = 0;
-    if (gy_start < 0) gy_start = 0;
-    if (gx_end >= GRID_CELLS) gx_end = GRID_CELLS - 1;
-    if (gy_end >= GRID_CELLS) gy_end = GRID_CELLS - 1;
-
-    /* Collect matching cities */
-    uint32_t capacity = 256;
-    uint32_t count = 0;
-    const civ_city_data_t **result = calloc(capacity, sizeof(civ_city_data_t *));
-    if (!result) return NULL;
+    cell_range_t cr;
+    cr.gx0 = tile_x / (int32_t)cell_w;
+    cr.gy0 = tile_y / (int32_t)cell_h;
+    cr.gx1 = (tile_x + tile_w) / (int32_t)cell_w;
+    cr.gy1 = (tile_y + tile_h) / (int32_t)cell_h;
+    if (cr.gx0 < 0) cr.gx0 = 0;
+    if (cr.gy0 < 0) cr.gy0 = 0;
+    if (cr.gx1 >= GRID_CELLS) cr.gx1 = GRID_CELLS - 1;
+    if (cr.gy1 >= GRID_CELLS) cr.gy1 = GRID_CELLS - 1;
+    return cr;
+}
+
+/* Upper bound on the matches: every city filed in the cells */
+static uint32_t candidate_count(const civ_cities_data_t *cd, cell_range_t cr) {
+    uint32_t n = 0;
+    for (int gy = cr.gy0; gy <= cr.gy1; gy++)
+        for (int gx = cr.gx0; gx <= cr.gx1; gx++)
+            n += cd->grid[gy][gx].count;
+    return n;
+}
 
+/* Write up to max matches to result; cells are sorted by tier, so a cell
+   is left at its first city below min_tier */
+static uint32_t collect_tiles(const civ_cities_data_t *cd, cell_range_t cr,
+                              int32_t tile_x, int32_t tile_y,
+                              int32_t tile_w, int32_t tile_h,
+                              uint32_t min_tier,
+                              const civ_city_data_t **result, uint32_t max) {
+    uint32_t count = 0;
     int tx_end = tile_x + tile_w;
     int ty_end = tile_y + tile_h;
 
-    for (int gy = gy_start; gy <= gy_end; gy++) {
-        for (int gx = gx_start; gx <= gx_end; gx++) {
+    for (int gy = cr.gy0; gy <= cr.gy1; gy++) {
+        for (int gx = cr.gx0; gx <= cr.gx1; gx++) {
             uint32_t gc = cd->grid[gy][gx].count;
             const uint32_t *indices = cd->grid[gy][gx].indices;
             for (uint32_t k = 0; k < gc; k++) {
                 const civ_city_data_t *c = &cd->cities[indices[k]];
-                if (c->tier > min_tier) continue;
+                if (c->tier > min_tier) break;
                 /* Handle equatorial wrap for x */
                 int cx = c->tile_x;
                 if (cx < tile_x) cx += (int32_t)cd->map_width;
                 if (cx >= tile_x && cx < tx_end &&
                     c->tile_y >= tile_y && c->tile_y < ty_end) {
-                    if (count >= capacity) {
-                        capacity *= 2;
-                        const civ_city_data_t **tmp = realloc(
-                            result, capacity * sizeof(civ_city_data_t *));
-                        if (!tmp) { civ_cities_free_result(result); return NULL; }
-                        result = tmp;
-                    }
+                    if (count == max) return count;
                     result[count++] = c;
                 }
             }
         }
     }
+    return count;
+}
 
+uint32_t civ_cities_query_tiles_into(
+    const civ_cities_data_t *cd,
+    int32_t tile_x, int32_t tile_y,
+    int32_t tile_w, int32_t tile_h,
+    uint32_t min_tier,
+    const civ_city_data_t **out,
+    uint32_t max) {
+
+    if (!cd || !out || tile_w <= 0 || tile_h <= 0) return 0;
+    cell_range_t cr = viewport_cells(cd, tile_x, tile_y, tile_w, tile_h);
+    return collect_tiles(cd, cr, tile_x, tile_y, tile_w, tile_h, min_tier,
+                         out, max);
+}
+
+const civ_city_data_t **civ_cities_query_tiles(
+    const civ_cities_data_t *cd,
+    int32_t tile_x, int32_t tile_y,
+    int32_t tile_w, int32_t tile_h,
+    uint32_t min_tier,
+    uint32_t *out_count) {
+
+    if (out_count) *out_count = 0;
+    if (!cd || tile_w <= 0 || tile_h <= 0) return NULL;
+
+    cell_range_t cr = viewport_cells(cd, tile_x, tile_y, tile_w, tile_h);
+    uint32_t bound = candidate_count(cd, cr);
+    const civ_city_data_t **result =
+        calloc(bound ? bound : 1, sizeof(civ_city_data_t *));
+    if (!result) return NULL;
+
+    uint32_t count = collect_tiles(cd, cr, tile_x, tile_y, tile_w, tile_h,
+                                   min_tier, result, bound);
     if (out_count) *out_count = count;
     return result;
 }
 
-const civ_city_data_t **civ_cities_for_country(
+const civ_city_data_t **civ_cities_query_tiles_arena(
+    const civ_cities_data_t *cd,
+    int32_t tile_x, int32_t tile_y,
+    int32_t tile_w, int32_t tile_h,
+    uint32_t min_tier,
+    civ_arena_t *arena,
+    uint32_t *out_count) {
+
+    if (out_count) *out_count = 0;
+    if (!cd || !arena || tile_w <= 0 || tile_h <= 0) return NULL;
+
+    cell_range_t cr = viewport_cells(cd, tile_x, tile_y, tile_w, tile_h);
+    uint32_t bound = candidate_count(cd, cr);
+    const civ_city_data_t **result = CIV_ARENA_PUSH_ARRAY(
+        arena, const civ_city_data_t *, MAX(bound, 1u));
+    if (!result) return NULL;
+
+    uint32_t count = collect_tiles(cd, cr, tile_x, tile_y, tile_w, tile_h,
+                                   min_tier, result, bound);
+    if (out_count) *out_count = count;
+    return result;
+}
+
+const civ_city_data_t *const *civ_cities_country_span(
     const civ_cities_data_t *cd,
     const char *iso_a2,
     uint32_t *out_count) {
 
     if (out_count) *out_count = 0;
     if (!cd || !iso_a2) return NULL;
+    uint16_t key = iso_key(iso_a2);
+    if (!key || (iso_a2[1] && iso_a2[2])) return NULL;
+
+    uint32_t lo = 0, hi = cd->country_count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (cd->country_keys[mid] < key) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo == cd->country_count || cd->country_keys[lo] != key) return NULL;
+
+    if (out_count) *out_count = cd->country_start[lo + 1] - cd->country_start[lo];
+    return cd->country_cities + cd->country_start[lo];
+}
 
-    uint32_t capacity = 64;
+const civ_city_data_t **civ_cities_for_country(
+    const civ_cities_data_t *cd,
+    const char *iso_a2,
+    uint32_t *out_count) {
+
+    if (out_count) *out_count = 0;
     uint32_t count = 0;
-    const civ_city_data_t **result = calloc(capacity, sizeof(civ_city_data_t *));
+    const civ_city_data_t *const *span = civ_cities_country_span(cd, iso_a2, &count);
+    const civ_city_data_t **result = calloc(count ? count : 1, sizeof(civ_city_data_t *));
     if (!result) return NULL;
-
-    for (uint32_t i = 0; i < cd->count; i++) {
-        if (cd->cities[i].iso_a2[0] && strcmp(cd->cities[i].iso_a2, iso_a2) == 0) {
-            if (count >= capacity) {
-                capacity *= 2;
-                const civ_city_data_t **tmp = realloc(
-                    result, capacity * sizeof(civ_city_data_t *));
-                if (!tmp) { civ_cities_free_result(result); return NULL; }
-                result = tmp;
-            }
-            result[count++] = &cd->cities[i];
-        }
-    }
+    if (count) memcpy((void *)result, span, count * sizeof(*result));
 
     if (out_count) *out_count = count;
     return result;
@@ -4,12 +4,213 @@
  */
 
 #include "core/world/dynamic_borders.h"
+#include "core/world/map_generator.h"
 #include "common.h"
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include <math.h>
 
+#define TENSION_DECAY 0.01f
+
+/* ── Pair table ──────────────────────────────────────────────────── */
+
+static uint32_t pair_key(civ_owner_index_t a, civ_owner_index_t b) {
+    if (a > b) {
+        civ_owner_index_t t = a;
+        a = b;
+        b = t;
+    }
+    return (((uint32_t)a << 16) | b) + 1;
+}
+
+static uint32_t hash_u32(uint32_t v) {
+    return v * 2654435761u;
+}
+
+/* Tension change per unit time on top of the decay */
+static civ_float_t type_drift(civ_border_type_t type) {
+    switch (type) {
+        case CIV_BORDER_TYPE_DISPUTED: return 0.05f;
+        case CIV_BORDER_TYPE_NATURAL:  return -0.02f;
+        default:                       return 0.0f;
+    }
+}
+
+static bool pairs_find(const civ_border_pairs_t* p, uint32_t key, uint32_t* slot) {
+    if (p->key_capacity == 0) return false;
+    uint32_t mask = p->key_capacity - 1;
+    for (uint32_t h = hash_u32(key) & mask;; h = (h + 1) & mask) {
+        if (p->keys[h] == key) {
+            *slot = p->slots[h];
+            return true;
+        }
+        if (p->keys[h] == 0) return false;
+    }
+}
+
+static bool pairs_rehash(civ_border_pairs_t* p) {
+    uint32_t cap = p->key_capacity ? p->key_capacity * 2 : 64;
+    uint32_t* keys = (uint32_t*)CIV_CALLOC(cap, sizeof(uint32_t));
+    uint32_t* slots = (uint32_t*)CIV_CALLOC(cap, sizeof(uint32_t));
+    if (!keys || !slots) {
+        CIV_FREE(keys);
+        CIV_FREE(slots);
+        return false;
+    }
+    for (size_t i = 0; i < p->count; i++) {
+        uint32_t key = pair_key(p->owner_a[i], p->owner_b[i]);
+        uint32_t h = hash_u32(key) & (cap - 1);
+        while (keys[h]) h = (h + 1) & (cap - 1);
+        keys[h] = key;
+        slots[h] = (uint32_t)i;
+    }
+    CIV_FREE(p->keys);
+    CIV_FREE(p->slots);
+    p->keys = keys;
+    p->slots = slots;
+    p->key_capacity = cap;
+    return true;
+}
+
+#define GROW_ARRAY(arr, cap) do { \
+        void* grown_ = CIV_REALLOC((arr), (cap) * sizeof(*(arr))); \
+        if (!grown_) return false; \
+        (arr) = grown_; \
+    } while (0)
+
+static bool pairs_reserve(civ_border_pairs_t* p, size_t want) {
+    if (want <= p->capacity) return true;
+    size_t cap = p->capacity ? p->capacity * 2 : 32;
+    while (cap < want) cap *= 2;
+    GROW_ARRAY(p->owner_a, cap);
+    GROW_ARRAY(p->owner_b, cap);
+    GROW_ARRAY(p->contact, cap);
+    GROW_ARRAY(p->type, cap);
+    GROW_ARRAY(p->drift, cap);
+    GROW_ARRAY(p->tension, cap);
+    GROW_ARRAY(p->fortification, cap);
+    p->capacity = cap;
+    return true;
+}
+
+/* Slot of (a, b), added as a political border if new */
+static bool pairs_get(civ_border_pairs_t* p, civ_owner_index_t a, civ_owner_index_t b,
+                      uint32_t* slot) {
+    uint32_t key = pair_key(a, b);
+    if (pairs_find(p, key, slot)) return true;
+    if ((p->count + 1) * 2 > p->key_capacity && !pairs_rehash(p)) return false;
+    if (!pairs_reserve(p, p->count + 1)) return false;
+
+    size_t i = p->count++;
+    p->owner_a[i] = MIN(a, b);
+    p->owner_b[i] = MAX(a, b);
+    p->contact[i] = 0;
+    p->type[i] = CIV_BORDER_TYPE_POLITICAL;
+    p->drift[i] = type_drift(CIV_BORDER_TYPE_POLITICAL);
+    p->tension[i] = 0.0f;
+    p->fortification[i] = 0.0f;
+
+    uint32_t mask = p->key_capacity - 1;
+    uint32_t h = hash_u32(key) & mask;
+    while (p->keys[h]) h = (h + 1) & mask;
+    p->keys[h] = key;
+    p->slots[h] = (uint32_t)i;
+    *slot = (uint32_t)i;
+    return true;
+}
+
+static void pairs_free(civ_border_pairs_t* p) {
+    CIV_FREE(p->keys);
+    CIV_FREE(p->slots);
+    CIV_FREE(p->owner_a);
+    CIV_FREE(p->owner_b);
+    CIV_FREE(p->contact);
+    CIV_FREE(p->type);
+    CIV_FREE(p->drift);
+    CIV_FREE(p->tension);
+    CIV_FREE(p->fortification);
+    memset(p, 0, sizeof(*p));
+}
+
+/* ── Map adjacency ───────────────────────────────────────────────── */
+
+static void contact_add(civ_border_pairs_t* p, civ_owner_index_t a, civ_owner_index_t b,
+                        int delta) {
+    if (a == CIV_OWNER_NONE || b == CIV_OWNER_NONE || a == b) return;
+    uint32_t slot;
+    if (delta > 0) {
+        if (pairs_get(p, a, b, &slot)) p->contact[slot]++;
+    } else if (pairs_find(p, pair_key(a, b), &slot) && p->contact[slot] > 0) {
+        p->contact[slot]--;
+    }
+}
+
+/* 4-neighbours of tile t, wrapping east-west as the map does */
+static int tile_neighbours(const civ_map_t* m, size_t t, size_t nb[4]) {
+    int32_t x = (int32_t)(t % (size_t)m->width);
+    int32_t y = (int32_t)(t / (size_t)m->width);
+    size_t row = (size_t)y * m->width;
+    int n = 0;
+    nb[n++] = row + (size_t)((x + 1) % m->width);
+    nb[n++] = row + (size_t)((x - 1 + m->width) % m->width);
+    if (y > 0) nb[n++] = t - m->width;
+    if (y + 1 < m->height) nb[n++] = t + m->width;
+    return n;
+}
+
+static void borders_listener(void* user_data, const civ_map_t* map, size_t index,
+                             civ_owner_index_t old_owner, civ_owner_index_t new_owner) {
+    civ_dynamic_borders_t* db = (civ_dynamic_borders_t*)user_data;
+    if (civ_map_is_water_at(map, index)) return;
+    size_t nb[4];
+    int n = tile_neighbours(map, index, nb);
+    for (int k = 0; k < n; k++) {
+        if (civ_map_is_water_at(map, nb[k])) continue;
+        civ_owner_index_t o = civ_map_owner_at(map, nb[k]);
+        contact_add(&db->pairs, old_owner, o, -1);
+        contact_add(&db->pairs, new_owner, o, +1);
+    }
+}
+
+bool civ_dynamic_borders_attach(civ_dynamic_borders_t* db, civ_map_t* map) {
+    if (!db || !map || !map->tiles) return false;
+    if (civ_map_has_owner_listener(map, borders_listener, db)) return true;
+
+    /* Tension and types stay; only the edge counts are redone */
+    civ_border_pairs_t* p = &db->pairs;
+    if (p->count) memset(p->contact, 0, p->count * sizeof(*p->contact));
+    size_t tile_count = (size_t)map->width * map->height;
+    for (size_t t = 0; t < tile_count; t++) {
+        civ_owner_index_t own = civ_map_owner_at(map, t);
+        if (own == CIV_OWNER_NONE || civ_map_is_water_at(map, t)) continue;
+        /* Each edge once, from the tile west or north of it */
+        size_t nb[4];
+        int n = tile_neighbours(map, t, nb);
+        for (int k = 0; k < n; k++) {
+            if (k == 1 || (k >= 2 && nb[k] < t)) continue;
+            if (civ_map_is_water_at(map, nb[k])) continue;
+            civ_owner_index_t o = civ_map_owner_at(map, nb[k]);
+            if (o == CIV_OWNER_NONE || o == own) continue;
+            uint32_t slot;
+            if (!pairs_get(p, own, o, &slot)) return false;
+            p->contact[slot]++;
+        }
+    }
+    /* Without a listener slot the counts hold until the next change; the
+       next attach recounts them */
+    if (!civ_map_add_owner_listener(map, borders_listener, db))
+        civ_log(CIV_LOG_WARNING, "Dynamic borders: map listener table full");
+    return true;
+}
+
+void civ_dynamic_borders_detach(civ_dynamic_borders_t* db, civ_map_t* map) {
+    if (!db || !map) return;
+    civ_map_remove_owner_listener(map, borders_listener, db);
+}
+
+/* ── System ──────────────────────────────────────────────────────── */
+
 civ_dynamic_borders_t* civ_dynamic_borders_create(void) {
     civ_dynamic_borders_t* db = (civ_dynamic_borders_t*)CIV_MALLOC(sizeof(civ_dynamic_borders_t));
     if (!db) {
@@ -24,6 +225,7 @@ civ_dynamic_borders_t* civ_dynamic_borders_create(void) {
 void civ_dynamic_borders_destroy(civ_dynamic_borders_t* db) {
     if (!db) return;
     
+    pairs_free(&db->pairs);
     if (db->border_segments) {
         CIV_FREE(db->border_segments);
     }
@@ -64,6 +266,20 @@ civ_result_t civ_dynamic_borders_create_segment(civ_dynamic_borders_t* db,
         return result;
     }
     
+    civ_owner_index_t a = civ_owner_intern(territory_a);
+    civ_owner_index_t b = civ_owner_intern(territory_b);
+    uint32_t pair;
+    if (a == CIV_OWNER_NONE || b == CIV_OWNER_NONE || a == b) {
+        result.error = CIV_ERROR_INVALID_ARGUMENT;
+        return result;
+    }
+    if (!pairs_get(&db->pairs, a, b, &pair)) {
+        result.error = CIV_ERROR_OUT_OF_MEMORY;
+        return result;
+    }
+    db->pairs.type[pair] = (uint8_t)type;
+    db->pairs.drift[pair] = type_drift(type);
+    
     if (db->segment_count >= db->segment_capacity) {
         db->segment_capacity *= 2;
         db->border_segments = (civ_border_segment_t*)CIV_REALLOC(db->border_segments,
@@ -79,8 +295,7 @@ civ_result_t civ_dynamic_borders_create_segment(civ_dynamic_borders_t* db,
     segment->start_point = start;
     segment->end_point = end;
     segment->border_type = type;
-    segment->fortification_level = 0.0f;
-    segment->tension_level = 0.0f;
+    segment->pair = pair;
     segment->last_incident = 0;
     
     return result;
@@ -89,36 +304,36 @@ civ_result_t civ_dynamic_borders_create_segment(civ_dynamic_borders_t* db,
 void civ_dynamic_borders_update(civ_dynamic_borders_t* db, civ_float_t time_delta) {
     if (!db) return;
     
-    /* Update tension levels for all border segments */
-    for (size_t i = 0; i < db->segment_count; i++) {
-        civ_border_segment_t* segment = &db->border_segments[i];
-        
-        /* Gradual tension decay */
-        segment->tension_level = MAX(0.0f, segment->tension_level - 0.01f * time_delta);
-        
-        /* Border type affects tension */
-        if (segment->border_type == CIV_BORDER_TYPE_DISPUTED) {
-            segment->tension_level = MIN(1.0f, segment->tension_level + 0.05f * time_delta);
-        } else if (segment->border_type == CIV_BORDER_TYPE_NATURAL) {
-            segment->tension_level = MAX(0.0f, segment->tension_level - 0.02f * time_delta);
-        }
+    /* Gradual decay, then the border type's pull; branch-free over the
+       contiguous arrays so the compiler can vectorize it */
+    civ_float_t* tension = db->pairs.tension;
+    const civ_float_t* drift = db->pairs.drift;
+    civ_float_t decay = TENSION_DECAY * time_delta;
+    for (size_t i = 0; i < db->pairs.count; i++) {
+        civ_float_t t = MAX(0.0f, tension[i] - decay);
+        tension[i] = CLAMP(t + drift[i] * time_delta, 0.0f, 1.0f);
     }
 }
 
+civ_float_t civ_dynamic_borders_pair_tension(const civ_dynamic_borders_t* db,
+                                             civ_owner_index_t a, civ_owner_index_t b) {
+    uint32_t slot;
+    if (!db || !pairs_find(&db->pairs, pair_key(a, b), &slot)) return 0.0f;
+    return db->pairs.tension[slot];
+}
+
+uint32_t civ_dynamic_borders_pair_contact(const civ_dynamic_borders_t* db,
+                                          civ_owner_index_t a, civ_owner_index_t b) {
+    uint32_t slot;
+    if (!db || !pairs_find(&db->pairs, pair_key(a, b), &slot)) return 0;
+    return db->pairs.contact[slot];
+}
+
 civ_float_t civ_dynamic_borders_get_tension(civ_dynamic_borders_t* db, const char* territory_a,
                                            const char* territory_b) {
     if (!db || !territory_a || !territory_b) return 0.0f;
     
-    for (size_t i = 0; i < db->segment_count; i++) {
-        civ_border_segment_t* segment = &db->border_segments[i];
-        if ((strcmp(segment->territory_a, territory_a) == 0 && 
-             strcmp(segment->territory_b, territory_b) == 0) ||
-            (strcmp(segment->territory_a, territory_b) == 0 && 
-             strcmp(segment->territory_b, territory_a) == 0)) {
-            return segment->tension_level;
-        }
-    }
-    
-    return 0.0f;
+    return civ_dynamic_borders_pair_tension(db, civ_owner_find(territory_a),
+                                            civ_owner_find(territory_b));
 }
 
@@ -7,12 +7,26 @@
 #include "stb_image.h"
 #include "core/world/flag_system.h"
 #include "common.h"
+#include "core/simulation_engine/worker_pool.h"
+#include "utils/mapped_file.h"
+#include "utils/frame_trace.h"
+#include "utils/startup_timeline.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #define FLAG_MAGIC 0x47414C46
 
+/* A cell is the flag and its half-size copy side by side, each framed by
+   its 1 px border */
+#define SMALL_W        (CIV_FLAG_CELL_W / 2)
+#define SMALL_H        (CIV_FLAG_CELL_H / 2)
+#define CELL_STRIDE_W  (CIV_FLAG_CELL_W + 2 + SMALL_W + 2)
+#define CELL_STRIDE_H  (CIV_FLAG_CELL_H + 2)
+#define CELLS_PER_ROW  (CIV_FLAG_PAGE_SIZE / CELL_STRIDE_W)
+#define CELLS_PER_PAGE (CELLS_PER_ROW * (CIV_FLAG_PAGE_SIZE / CELL_STRIDE_H))
+#define PAGE_STRIDE    (CIV_FLAG_PAGE_SIZE * 4)
+
 civ_flag_system_t *civ_flag_system_create(SDL_Renderer *renderer) {
     civ_flag_system_t *fs = calloc(1, sizeof(*fs));
     if (!fs) return NULL;
@@ -23,17 +37,104 @@ civ_flag_system_t *civ_flag_system_create(SDL_Renderer *renderer) {
     return fs;
 }
 
+static void release_pages(civ_flag_system_t *fs) {
+    for (int p = 0; p < fs->page_count; p++) {
+        if (fs->pages[p]) SDL_DestroyTexture(fs->pages[p]);
+        free(fs->page_pixels[p]);
+        fs->pages[p] = NULL;
+        fs->page_pixels[p] = NULL;
+    }
+    fs->page_count = 0;
+    for (uint32_t i = 0; i < fs->count; i++) fs->flags[i].texture = NULL;
+}
+
 void civ_flag_system_destroy(civ_flag_system_t *fs) {
     if (!fs) return;
-    for (uint32_t i = 0; i < fs->count; i++) {
-        if (fs->flags[i].texture) SDL_DestroyTexture(fs->flags[i].texture);
-    }
+    /* Workers write into the pages until their jobs are done */
+    if (fs->loading && fs->pool) civ_worker_pool_wait_counter(fs->pool, &fs->pending);
+    if (fs->raster_pool) civ_worker_pool_wait_counter(fs->raster_pool, &fs->raster_pending);
+    release_pages(fs);
+    for (uint32_t i = 0; i < fs->raster_count; i++) free(fs->rasters[i].pixels);
+    for (int p = 0; p < CIV_FLAG_RASTER_PAGES; p++)
+        if (fs->raster_pages[p]) SDL_DestroyTexture(fs->raster_pages[p]);
+    free(fs->rasters);
+    free(fs->raster_slots);
+    free(fs->jobs);
     free(fs->flags);
+    free(fs->id_slots);
     free(fs);
 }
 
-static uint32_t read_u32(FILE *f) { uint32_t v; fread(&v, 4, 1, f); return v; }
-static uint16_t read_u16(FILE *f) { uint16_t v; fread(&v, 2, 1, f); return v; }
+/* ── Lookup indexes ───────────────────────────────────────────── */
+
+static uint32_t hash_id(uint32_t id) {
+    id ^= id >> 16;
+    id *= 0x7FEB352Du;
+    id ^= id >> 15;
+    return id;
+}
+
+/* FNV-1a over the lower-cased name, matching strcasecmp */
+static uint32_t hash_filename(const char *s) {
+    uint32_t h = 2166136261u;
+    for (; *s; s++) {
+        char c = *s;
+        if (c >= 'A' && c <= 'Z') c = (char)(c - 'A' + 'a');
+        h ^= (uint8_t)c;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static const civ_flag_entry_t *find_id(const civ_flag_system_t *fs, uint32_t id) {
+    if (!fs->id_slots) return NULL;
+    for (uint32_t i = hash_id(id) & fs->slot_mask;; i = (i + 1) & fs->slot_mask) {
+        uint32_t slot = fs->id_slots[i];
+        if (slot == 0) return NULL;
+        if (fs->flags[slot - 1].country_id == id) return &fs->flags[slot - 1];
+    }
+}
+
+static const civ_flag_entry_t *find_file(const civ_flag_system_t *fs, const char *name) {
+    if (!fs->file_slots) return NULL;
+    for (uint32_t i = hash_filename(name) & fs->slot_mask;; i = (i + 1) & fs->slot_mask) {
+        uint32_t slot = fs->file_slots[i];
+        if (slot == 0) return NULL;
+        if (strcasecmp(fs->flags[slot - 1].filename, name) == 0) return &fs->flags[slot - 1];
+    }
+}
+
+/* Rebuild both indexes; duplicates keep their first entry as a scan would */
+static void build_indexes(civ_flag_system_t *fs) {
+    free(fs->id_slots);
+    fs->id_slots = fs->file_slots = NULL;
+    fs->slot_mask = 0;
+
+    uint32_t size = 16;
+    while (size < fs->count * 2) size <<= 1;
+    uint32_t *slots = calloc((size_t)size * 2, sizeof(uint32_t));
+    if (!slots) {
+        civ_log(CIV_LOG_ERROR, "Flag system: no memory for lookup index");
+        return;
+    }
+    fs->id_slots = slots;
+    fs->file_slots = slots + size;
+    fs->slot_mask = size - 1;
+
+    for (uint32_t n = 0; n < fs->count; n++) {
+        const civ_flag_entry_t *fe = &fs->flags[n];
+        if (!find_id(fs, fe->country_id)) {
+            uint32_t i = hash_id(fe->country_id) & fs->slot_mask;
+            while (fs->id_slots[i] != 0) i = (i + 1) & fs->slot_mask;
+            fs->id_slots[i] = n + 1;
+        }
+        if (!find_file(fs, fe->filename)) {
+            uint32_t i = hash_filename(fe->filename) & fs->slot_mask;
+            while (fs->file_slots[i] != 0) i = (i + 1) & fs->slot_mask;
+            fs->file_slots[i] = n + 1;
+        }
+    }
+}
 
 civ_result_t civ_flag_system_load(civ_flag_system_t *fs,
                                    const char *index_path,
@@ -41,17 +142,32 @@ civ_result_t civ_flag_system_load(civ_flag_system_t *fs,
     if (!fs || !index_path || !flags_dir)
         return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "NULL argument"};
 
-    FILE *f = fopen(index_path, "rb");
-    if (!f) return (civ_result_t){CIV_ERROR_IO, "Cannot open file"};
+    civ_mapped_file_t file;
+    if (!civ_mapped_file_open(&file, index_path))
+        return (civ_result_t){CIV_ERROR_IO, "Cannot open file"};
+    civ_result_t result = civ_flag_system_load_view(fs, file.data, file.size, flags_dir);
+    civ_mapped_file_close(&file);
+    return result;
+}
+
+civ_result_t civ_flag_system_load_view(civ_flag_system_t *fs,
+                                        const uint8_t *data, size_t size,
+                                        const char *flags_dir) {
+    if (!fs || !flags_dir)
+        return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "NULL argument"};
+    if (fs->loading)
+        return (civ_result_t){CIV_ERROR_INVALID_STATE, "Flag textures are loading"};
+    release_pages(fs);
+    civ_byte_reader_t r = civ_byte_reader_span(data, size);
 
-    uint32_t magic = read_u32(f);
-    if (magic != FLAG_MAGIC) { fclose(f); return (civ_result_t){CIV_ERROR_INVALID_DATA, "Bad magic"}; }
-    uint32_t version = read_u32(f); (void)version;
-    uint32_t count = read_u32(f);
+    uint32_t magic = civ_byte_reader_u32(&r);
+    if (magic != FLAG_MAGIC) return (civ_result_t){CIV_ERROR_INVALID_DATA, "Bad magic"};
+    uint32_t version = civ_byte_reader_u32(&r); (void)version;
+    uint32_t count = civ_byte_reader_u32(&r);
 
     if (count > fs->capacity) {
         civ_flag_entry_t *tmp = realloc(fs->flags, count * sizeof(civ_flag_entry_t));
-        if (!tmp) { fclose(f); return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "realloc"}; }
+        if (!tmp) return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "realloc"};
         fs->flags = tmp;
         fs->capacity = count;
     }
@@ -62,64 +178,368 @@ civ_result_t civ_flag_system_load(civ_flag_system_t *fs,
 
     for (uint32_t i = 0; i < count; i++) {
         civ_flag_entry_t *fe = &fs->flags[i];
-        fe->country_id = read_u32(f);
+        fe->country_id = civ_byte_reader_u32(&r);
 
-        uint8_t name_len = 0;
-        fread(&name_len, 1, 1, f);
-        if (name_len >= sizeof(fe->filename)) name_len = sizeof(fe->filename) - 1;
-        if (name_len > 0) fread(fe->filename, 1, name_len, f);
-        fe->filename[name_len] = '\0';
+        uint8_t name_len = civ_byte_reader_u8(&r);
+        civ_byte_reader_str(&r, name_len, fe->filename, sizeof(fe->filename));
 
-        fe->width = read_u16(f);
-        fe->height = read_u16(f);
+        fe->width = civ_byte_reader_u16(&r);
+        fe->height = civ_byte_reader_u16(&r);
         fe->texture = NULL;  /* loaded lazily */
+        if (!r.ok) {
+            fs->count = i;
+            break;
+        }
     }
 
-    fclose(f);
+    build_indexes(fs);
     return (civ_result_t){CIV_OK, "Loaded"};
 }
 
-/* Load all PNG textures — requires SDL_Renderer, call after window created */
-int civ_flag_system_load_textures(civ_flag_system_t *fs) {
-    if (!fs || !fs->renderer) return 0;
-    int loaded = 0;
+/* ── Atlas ──────────────────────────────────────────────────────── */
 
-    for (uint32_t i = 0; i < fs->count; i++) {
-        civ_flag_entry_t *fe = &fs->flags[i];
-        if (fe->texture) continue;  /* already loaded */
+/* Box-filter an sw x sh RGBA image into the dw x dh block at (dx, dy) of
+   a page_stride-byte image */
+static void blit_scaled(uint8_t *page, size_t page_stride, int dx, int dy, int dw, int dh,
+                        const uint8_t *src, int sw, int sh, int src_stride) {
+    for (int y = 0; y < dh; y++) {
+        int sy0 = y * sh / dh, sy1 = (y + 1) * sh / dh;
+        if (sy1 <= sy0) sy1 = sy0 + 1;
+        uint8_t *out = page + (size_t)(dy + y) * page_stride + (size_t)dx * 4;
+        for (int x = 0; x < dw; x++) {
+            int sx0 = x * sw / dw, sx1 = (x + 1) * sw / dw;
+            if (sx1 <= sx0) sx1 = sx0 + 1;
+            uint32_t sum[4] = {0, 0, 0, 0};
+            for (int v = sy0; v < sy1; v++) {
+                const uint8_t *in = src + (size_t)v * (size_t)src_stride + (size_t)sx0 * 4;
+                for (int u = sx0; u < sx1; u++, in += 4) {
+                    sum[0] += in[0]; sum[1] += in[1];
+                    sum[2] += in[2]; sum[3] += in[3];
+                }
+            }
+            uint32_t n = (uint32_t)((sy1 - sy0) * (sx1 - sx0));
+            for (int c = 0; c < 4; c++) out[x * 4 + c] = (uint8_t)((sum[c] + n / 2) / n);
+        }
+    }
+}
 
-        char full_path[512];
-        snprintf(full_path, sizeof(full_path), "%s/%s", fs->flags_dir, fe->filename);
+/* Copy a block's edge pixels into the 1 px frame around it */
+static void extrude(uint8_t *page, size_t stride, int x, int y, int w, int h) {
+    uint8_t *top = page + (size_t)y * stride + (size_t)x * 4;
+    uint8_t *bottom = top + (size_t)(h - 1) * stride;
+    memcpy(top - stride, top, (size_t)w * 4);
+    memcpy(bottom + stride, bottom, (size_t)w * 4);
+    for (int v = y - 1; v <= y + h; v++) {
+        uint8_t *row = page + (size_t)v * stride;
+        memcpy(row + (size_t)(x - 1) * 4, row + (size_t)x * 4, 4);
+        memcpy(row + (size_t)(x + w) * 4, row + (size_t)(x + w - 1) * 4, 4);
+    }
+}
+
+/* Point fe at cell of its page */
+static void place_cell(civ_flag_entry_t *fe, int cell) {
+    float x = (float)((cell % CELLS_PER_ROW) * CELL_STRIDE_W + 1);
+    float y = (float)((cell / CELLS_PER_ROW) * CELL_STRIDE_H + 1);
+    fe->src = (SDL_FRect){x, y, CIV_FLAG_CELL_W, CIV_FLAG_CELL_H};
+    fe->src_small = (SDL_FRect){x + CIV_FLAG_CELL_W + 2, y, SMALL_W, SMALL_H};
+}
 
-        int w, h, channels;
-        unsigned char *pixels = stbi_load(full_path, &w, &h, &channels, 4);
-        if (!pixels) continue;
+/* Worker job: decode one PNG into its cell. Each job owns its cell, so
+   jobs on one page never touch the same pixels. */
+static void decode_flag(void *arg) {
+    civ_flag_job_t *job = arg;
+    civ_flag_system_t *fs = job->fs;
+    civ_flag_entry_t *fe = &fs->flags[job->index];
 
-        SDL_Texture *tex = SDL_CreateTexture(fs->renderer,
-            SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, w, h);
-        if (!tex) { stbi_image_free(pixels); continue; }
+    char full_path[512];
+    snprintf(full_path, sizeof(full_path), "%s/%s", fs->flags_dir, fe->filename);
 
-        SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
-        SDL_UpdateTexture(tex, NULL, pixels, w * 4);
-        stbi_image_free(pixels);
+    SDL_PathInfo info;
+    if (SDL_GetPathInfo(full_path, &info))
+        civ_startup_step_add_read(fs->load_step, info.size);
 
-        fe->texture = tex;
+    int w, h, channels;
+    unsigned char *pixels = stbi_load(full_path, &w, &h, &channels, 4);
+    if (pixels) {
+        uint8_t *page = fs->page_pixels[fe->page];
+        int x = (int)fe->src.x, y = (int)fe->src.y;
+        int sx = (int)fe->src_small.x, sy = (int)fe->src_small.y;
+        blit_scaled(page, PAGE_STRIDE, x, y, CIV_FLAG_CELL_W, CIV_FLAG_CELL_H,
+                    pixels, w, h, w * 4);
+        extrude(page, PAGE_STRIDE, x, y, CIV_FLAG_CELL_W, CIV_FLAG_CELL_H);
+        blit_scaled(page, PAGE_STRIDE, sx, sy, SMALL_W, SMALL_H,
+                    page + (size_t)y * PAGE_STRIDE + (size_t)x * 4,
+                    CIV_FLAG_CELL_W, CIV_FLAG_CELL_H, PAGE_STRIDE);
+        extrude(page, PAGE_STRIDE, sx, sy, SMALL_W, SMALL_H);
+        stbi_image_free(pixels);
         fe->width = w;
         fe->height = h;
-        loaded++;
+        fe->decoded = true;
     }
 
-    return loaded;
+    SDL_AddAtomicInt(&fs->page_pending[fe->page], -1);
+    SDL_AddAtomicInt(&fs->pending, -1);
+}
+
+civ_result_t civ_flag_system_begin_load(civ_flag_system_t *fs,
+                                        struct civ_worker_pool *pool) {
+    if (!fs) return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "NULL argument"};
+    if (fs->loading)
+        return (civ_result_t){CIV_ERROR_INVALID_STATE, "Flag textures are loading"};
+    release_pages(fs);
+    if (fs->count == 0) return (civ_result_t){CIV_OK, "No flags"};
+
+    uint32_t count = fs->count;
+    if (count > (uint32_t)(CELLS_PER_PAGE * CIV_FLAG_MAX_PAGES)) {
+        civ_log(CIV_LOG_WARNING, "Flag system: only %d of %u flags fit the atlas",
+                CELLS_PER_PAGE * CIV_FLAG_MAX_PAGES, count);
+        count = (uint32_t)(CELLS_PER_PAGE * CIV_FLAG_MAX_PAGES);
+    }
+
+    civ_flag_job_t *jobs = realloc(fs->jobs, count * sizeof(civ_flag_job_t));
+    if (!jobs) return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "realloc"};
+    fs->jobs = jobs;
+
+    int page_count = (int)((count + CELLS_PER_PAGE - 1) / CELLS_PER_PAGE);
+    for (int p = 0; p < page_count; p++) {
+        fs->page_pixels[p] = calloc((size_t)CIV_FLAG_PAGE_SIZE * PAGE_STRIDE, 1);
+        fs->page_count = p + 1;
+        if (!fs->page_pixels[p]) {
+            release_pages(fs);
+            return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Flag atlas page"};
+        }
+        SDL_SetAtomicInt(&fs->page_pending[p], 0);
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        civ_flag_entry_t *fe = &fs->flags[i];
+        fe->page = (int)(i / CELLS_PER_PAGE);
+        place_cell(fe, (int)(i % CELLS_PER_PAGE));
+        fe->decoded = false;
+        SDL_AddAtomicInt(&fs->page_pending[fe->page], 1);
+    }
+
+    SDL_SetAtomicInt(&fs->pending, (int)count);
+    fs->pool = pool;
+    fs->load_step = civ_startup_step_begin("Flag textures");
+    fs->loading = true;
+    for (uint32_t i = 0; i < count; i++) {
+        fs->jobs[i] = (civ_flag_job_t){fs, i};
+        if (!pool || !civ_worker_pool_submit(pool, decode_flag, &fs->jobs[i]))
+            decode_flag(&fs->jobs[i]);
+    }
+    return (civ_result_t){CIV_OK, "Loading"};
+}
+
+/* ── Procedural flags ────────────────────────────────────────────── */
+
+#define RASTER_CELLS (CELLS_PER_PAGE * CIV_FLAG_RASTER_PAGES)
+
+static uint32_t hash_raster(uint64_t hash) {
+    return hash_id((uint32_t)(hash ^ (hash >> 32)));
+}
+
+static bool init_rasters(civ_flag_system_t *fs) {
+    uint32_t size = 16;
+    while (size < RASTER_CELLS * 2) size <<= 1;
+    fs->rasters = calloc(RASTER_CELLS, sizeof(civ_flag_raster_t));
+    fs->raster_slots = calloc(size, sizeof(uint32_t));
+    if (!fs->rasters || !fs->raster_slots) {
+        free(fs->rasters);
+        free(fs->raster_slots);
+        fs->rasters = NULL;
+        fs->raster_slots = NULL;
+        civ_log(CIV_LOG_ERROR, "Flag system: no memory for procedural flags");
+        return false;
+    }
+    fs->raster_count = RASTER_CELLS;
+    fs->raster_mask = size - 1;
+    for (uint32_t i = 0; i < RASTER_CELLS; i++) {
+        civ_flag_raster_t *fr = &fs->rasters[i];
+        fr->fs = fs;
+        fr->entry.page = (int)(i / CELLS_PER_PAGE);
+        fr->entry.width = CIV_FLAG_CELL_W;
+        fr->entry.height = CIV_FLAG_CELL_H;
+        place_cell(&fr->entry, (int)(i % CELLS_PER_PAGE));
+        SDL_SetAtomicInt(&fr->state, CIV_FLAG_RASTER_EMPTY);
+    }
+    return true;
+}
+
+static civ_flag_raster_t *find_raster(const civ_flag_system_t *fs, uint64_t hash) {
+    for (uint32_t i = hash_raster(hash) & fs->raster_mask;; i = (i + 1) & fs->raster_mask) {
+        uint32_t slot = fs->raster_slots[i];
+        if (slot == 0) return NULL;
+        if (fs->rasters[slot - 1].hash == hash) return &fs->rasters[slot - 1];
+    }
+}
+
+static void insert_raster(civ_flag_system_t *fs, civ_flag_raster_t *fr) {
+    uint32_t i = hash_raster(fr->hash) & fs->raster_mask;
+    while (fs->raster_slots[i] != 0) i = (i + 1) & fs->raster_mask;
+    fs->raster_slots[i] = (uint32_t)(fr - fs->rasters) + 1;
+}
+
+/* Drop fr's slot, shifting back the probes that ran past it */
+static void remove_raster(civ_flag_system_t *fs, const civ_flag_raster_t *fr) {
+    uint32_t mask = fs->raster_mask;
+    uint32_t i = hash_raster(fr->hash) & mask;
+    while (fs->raster_slots[i] != (uint32_t)(fr - fs->rasters) + 1) i = (i + 1) & mask;
+    for (uint32_t j = (i + 1) & mask; fs->raster_slots[j] != 0; j = (j + 1) & mask) {
+        uint32_t home = hash_raster(fs->rasters[fs->raster_slots[j] - 1].hash) & mask;
+        /* j's entry may fill the hole at i unless its home lies in (i, j] */
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            fs->raster_slots[i] = fs->raster_slots[j];
+            i = j;
+        }
+    }
+    fs->raster_slots[i] = 0;
+}
+
+/* Worker job: rasterize a design into a standalone cell, framed like the
+   decoded flags so the upload is one rectangle */
+static void raster_flag(void *arg) {
+    civ_flag_raster_t *fr = arg;
+    civ_flag_system_t *fs = fr->fs;
+    const size_t stride = (size_t)CELL_STRIDE_W * 4;
+    uint8_t *cell = calloc((size_t)CELL_STRIDE_H, stride);
+    if (cell) {
+        int sx = CIV_FLAG_CELL_W + 3;
+        civ_vexillology_rasterize(&fr->design, cell + stride + 4,
+                                  CIV_FLAG_CELL_W, CIV_FLAG_CELL_H, (int)stride);
+        extrude(cell, stride, 1, 1, CIV_FLAG_CELL_W, CIV_FLAG_CELL_H);
+        blit_scaled(cell, stride, sx, 1, SMALL_W, SMALL_H, cell + stride + 4,
+                    CIV_FLAG_CELL_W, CIV_FLAG_CELL_H, (int)stride);
+        extrude(cell, stride, sx, 1, SMALL_W, SMALL_H);
+    }
+    fr->pixels = cell;
+    SDL_SetAtomicInt(&fr->state, CIV_FLAG_RASTER_DONE);
+    SDL_AddAtomicInt(&fs->raster_ready, 1);
+    SDL_AddAtomicInt(&fs->raster_pending, -1);
+}
+
+const civ_flag_entry_t *civ_flag_system_procedural(civ_flag_system_t *fs,
+                                                   const civ_flag_t *design,
+                                                   struct civ_worker_pool *pool) {
+    if (!fs || !design) return NULL;
+    if (!fs->rasters && !init_rasters(fs)) return NULL;
+    uint64_t hash = civ_vexillology_calculate_hash(design);
+    uint64_t now = ++fs->raster_clock;
+
+    civ_flag_raster_t *fr = find_raster(fs, hash);
+    if (fr) {
+        fr->last_used = now;
+        return &fr->entry;
+    }
+
+    /* A free cell, else the least recently used one not in flight */
+    for (uint32_t i = 0; i < fs->raster_count; i++) {
+        civ_flag_raster_t *c = &fs->rasters[i];
+        int state = SDL_GetAtomicInt(&c->state);
+        if (state == CIV_FLAG_RASTER_EMPTY) { fr = c; break; }
+        if (state == CIV_FLAG_RASTER_UPLOADED && (!fr || c->last_used < fr->last_used))
+            fr = c;
+    }
+    if (!fr) return NULL;
+    if (fr->hash) remove_raster(fs, fr);
+
+    fr->hash = hash;
+    fr->design = *design;
+    fr->last_used = now;
+    fr->entry.texture = NULL;
+    fr->entry.decoded = false;
+    insert_raster(fs, fr);
+
+    SDL_SetAtomicInt(&fr->state, CIV_FLAG_RASTER_QUEUED);
+    SDL_AddAtomicInt(&fs->raster_pending, 1);
+    if (pool) fs->raster_pool = pool;
+    if (!pool || !civ_worker_pool_submit(pool, raster_flag, fr)) raster_flag(fr);
+    return &fr->entry;
+}
+
+/* Copy rasterized cells into their pages; a page's texture is made once */
+static int upload_rasters(civ_flag_system_t *fs) {
+    if (SDL_GetAtomicInt(&fs->raster_ready) == 0) return 0;
+    int ready = 0;
+    for (uint32_t i = 0; i < fs->raster_count; i++) {
+        civ_flag_raster_t *fr = &fs->rasters[i];
+        if (SDL_GetAtomicInt(&fr->state) != CIV_FLAG_RASTER_DONE) continue;
+        SDL_AddAtomicInt(&fs->raster_ready, -1);
+        int p = fr->entry.page;
+        if (!fs->raster_pages[p]) {
+            fs->raster_pages[p] = civ_create_texture(fs->renderer, SDL_PIXELFORMAT_RGBA32,
+                SDL_TEXTUREACCESS_STATIC, CIV_FLAG_PAGE_SIZE, CIV_FLAG_PAGE_SIZE);
+            if (fs->raster_pages[p])
+                SDL_SetTextureBlendMode(fs->raster_pages[p], SDL_BLENDMODE_BLEND);
+            else
+                civ_log(CIV_LOG_ERROR, "Flag system: cannot create procedural page %d", p);
+        }
+        if (fs->raster_pages[p] && fr->pixels) {
+            SDL_Rect rect = {(int)fr->entry.src.x - 1, (int)fr->entry.src.y - 1,
+                             CELL_STRIDE_W, CELL_STRIDE_H};
+            SDL_UpdateTexture(fs->raster_pages[p], &rect, fr->pixels, CELL_STRIDE_W * 4);
+            fr->entry.texture = fs->raster_pages[p];
+            fr->entry.decoded = true;
+            ready++;
+        }
+        free(fr->pixels);
+        fr->pixels = NULL;
+        SDL_SetAtomicInt(&fr->state, CIV_FLAG_RASTER_UPLOADED);
+    }
+    return ready;
+}
+
+int civ_flag_system_poll(civ_flag_system_t *fs) {
+    if (!fs || !fs->renderer) return 0;
+    int ready = upload_rasters(fs);
+    if (!fs->loading) return ready;
+    bool waiting = false;
+
+    for (int p = 0; p < fs->page_count; p++) {
+        if (!fs->page_pixels[p]) continue;
+        if (SDL_GetAtomicInt(&fs->page_pending[p]) != 0) { waiting = true; continue; }
+
+        SDL_Texture *tex = civ_create_texture(fs->renderer, SDL_PIXELFORMAT_RGBA32,
+            SDL_TEXTUREACCESS_STATIC, CIV_FLAG_PAGE_SIZE, CIV_FLAG_PAGE_SIZE);
+        if (tex) {
+            SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+            SDL_UpdateTexture(tex, NULL, fs->page_pixels[p], PAGE_STRIDE);
+        } else {
+            civ_log(CIV_LOG_ERROR, "Flag system: cannot create atlas page %d", p);
+        }
+        free(fs->page_pixels[p]);
+        fs->page_pixels[p] = NULL;
+        fs->pages[p] = tex;
+
+        uint32_t first = (uint32_t)p * CELLS_PER_PAGE;
+        uint32_t end = MIN(fs->count, first + CELLS_PER_PAGE);
+        for (uint32_t i = first; i < end; i++) {
+            civ_flag_entry_t *fe = &fs->flags[i];
+            if (!tex || !fe->decoded) continue;
+            fe->texture = tex;
+            ready++;
+        }
+    }
+
+    if (!waiting) {
+        fs->loading = false;
+        civ_startup_step_end(fs->load_step);
+    }
+    return ready;
+}
+
+/* Load all PNG textures — requires SDL_Renderer, call after window created */
+int civ_flag_system_load_textures(civ_flag_system_t *fs) {
+    if (!fs || !fs->renderer) return 0;
+    if (!fs->loading && civ_flag_system_begin_load(fs, NULL).error != CIV_OK) return 0;
+    if (fs->pool) civ_worker_pool_wait_counter(fs->pool, &fs->pending);
+    return civ_flag_system_poll(fs);
 }
 
 const civ_flag_entry_t *civ_flag_system_get(const civ_flag_system_t *fs,
                                              uint32_t country_id) {
     if (!fs) return NULL;
-    for (uint32_t i = 0; i < fs->count; i++) {
-        if (fs->flags[i].country_id == country_id)
-            return &fs->flags[i];
-    }
-    return NULL;
+    return find_id(fs, country_id);
 }
 
 /* Look up flag by ISO-A2 code */
@@ -129,11 +549,7 @@ const civ_flag_entry_t *civ_flag_system_get_by_iso(const civ_flag_system_t *fs,
     /* Build expected filename: "xx.png" */
     char expected[16];
     snprintf(expected, sizeof(expected), "%s.png", iso_a2);
-    for (uint32_t i = 0; i < fs->count; i++) {
-        if (strcasecmp(fs->flags[i].filename, expected) == 0)
-            return &fs->flags[i];
-    }
-    return NULL;
+    return find_file(fs, expected);
 }
 
 void civ_flag_render(SDL_Renderer *r, const civ_flag_entry_t *flag,
@@ -141,7 +557,9 @@ void civ_flag_render(SDL_Renderer *r, const civ_flag_entry_t *flag,
     if (!r || !flag) return;
     if (flag->texture) {
         SDL_FRect dst = { (float)x, (float)y, (float)w, (float)h };
-        SDL_RenderTexture(r, flag->texture, NULL, &dst);
+        const SDL_FRect *src = (w <= CIV_FLAG_CELL_W * 3 / 4 && h <= CIV_FLAG_CELL_H * 3 / 4)
+            ? &flag->src_small : &flag->src;
+        SDL_RenderTexture(r, flag->texture, src, &dst);
     } else {
         /* Fallback: colored rectangle with border */
         SDL_FRect dst = { (float)x, (float)y, (float)w, (float)h };
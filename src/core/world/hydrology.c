@@ -0,0 +1,313 @@
+/**
+ * @file hydrology.c
+ * @brief Priority-flood depression fill, D8 flow and accumulation
+ */
+#include "core/world/hydrology.h"
+#include "common.h"
+#include "core/simulation_engine/worker_pool.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* D8 neighbours; diagonals last */
+static const int32_t DX[8] = {1, -1, 0, 0, 1, -1, 1, -1};
+static const int32_t DY[8] = {0, 0, 1, -1, 1, 1, -1, -1};
+static const float   DIST[8] = {1.0f, 1.0f, 1.0f, 1.0f,
+                                1.41421356f, 1.41421356f, 1.41421356f, 1.41421356f};
+
+#define NO_RECEIVER (-1)
+
+enum { TILE_LAND = 1, TILE_LAKE = 2 };
+
+typedef struct {
+  civ_map_t *map;
+  int32_t    blocks_x;
+  float     *ground;     /* elevation as generated */
+  float     *fill;       /* raised so every land tile drains to an outlet */
+  int8_t    *receiver;   /* D8 direction, NO_RECEIVER at outlets */
+  uint32_t  *area;       /* upstream tiles, itself included */
+  uint8_t   *kind;       /* TILE_* */
+  int32_t   *rivers;     /* per block, summed after the pass */
+  int32_t   *lakes;
+} hydro_t;
+
+typedef struct {
+  float    z;
+  uint32_t i;
+} heap_node_t;
+
+/* Neighbour d of tile (x, y), or false off the polar rows */
+static inline bool neighbour(const civ_map_t *m, int32_t x, int32_t y, int d,
+                             size_t *out) {
+  int32_t ny = y + DY[d];
+  if (ny < 0 || ny >= m->height) return false;
+  int32_t nx = x + DX[d];
+  if (nx < 0) nx += m->width;
+  else if (nx >= m->width) nx -= m->width;
+  *out = (size_t)ny * (size_t)m->width + (size_t)nx;
+  return true;
+}
+
+/* ── Min-heap on height ────────────────────────────────────────────── */
+static void heap_push(heap_node_t *h, size_t *n, float z, uint32_t i) {
+  size_t c = (*n)++;
+  while (c > 0) {
+    size_t p = (c - 1) / 2;
+    if (h[p].z <= z) break;
+    h[c] = h[p];
+    c = p;
+  }
+  h[c] = (heap_node_t){z, i};
+}
+
+static heap_node_t heap_pop(heap_node_t *h, size_t *n) {
+  heap_node_t top = h[0], last = h[--(*n)];
+  size_t c = 0;
+  for (;;) {
+    size_t l = 2 * c + 1;
+    if (l >= *n) break;
+    if (l + 1 < *n && h[l + 1].z < h[l].z) l++;
+    if (last.z <= h[l].z) break;
+    h[c] = h[l];
+    c = l;
+  }
+  if (*n > 0) h[c] = last;
+  return top;
+}
+
+/* ── Flood ─────────────────────────────────────────────────────────── */
+
+/* Settle every tile from the outlets inward, lowest first, writing the
+   filled heights and the land tiles' settling order. Tiles raised onto a
+   flat or into a depression go through the FIFO, which stays sorted because
+   each entry is one step above the tile being settled. */
+static size_t priority_flood(hydro_t *h, uint8_t *closed, heap_node_t *heap,
+                             uint32_t *pit, uint32_t *order) {
+  const civ_map_t *m = h->map;
+  size_t n = (size_t)m->width * m->height;
+  size_t heap_n = 0, pit_head = 0, pit_tail = 0, settled = 0;
+
+  for (size_t i = 0; i < n; i++) {
+    int32_t x = (int32_t)(i % (size_t)m->width), y = (int32_t)(i / (size_t)m->width);
+    bool outlet = false;
+    if (h->kind[i] & TILE_LAND) {
+      outlet = y == 0 || y == m->height - 1;
+    } else {
+      closed[i] = 1; /* the sea is its own level */
+      for (int d = 0; d < 8 && !outlet; d++) {
+        size_t j;
+        outlet = neighbour(m, x, y, d, &j) && (h->kind[j] & TILE_LAND);
+      }
+    }
+    if (outlet) {
+      closed[i] = 1;
+      heap_push(heap, &heap_n, h->fill[i], (uint32_t)i);
+    }
+  }
+
+  while (heap_n > 0 || pit_head < pit_tail) {
+    size_t c;
+    if (pit_head < pit_tail &&
+        (heap_n == 0 || h->fill[pit[pit_head]] <= heap[0].z))
+      c = pit[pit_head++];
+    else
+      c = heap_pop(heap, &heap_n).i;
+    if (h->kind[c] & TILE_LAND) order[settled++] = (uint32_t)c;
+
+    int32_t x = (int32_t)(c % (size_t)m->width), y = (int32_t)(c / (size_t)m->width);
+    float step = nextafterf(h->fill[c], INFINITY);
+    for (int d = 0; d < 8; d++) {
+      size_t j;
+      if (!neighbour(m, x, y, d, &j) || closed[j]) continue;
+      closed[j] = 1;
+      if (h->fill[j] <= step) {
+        h->fill[j] = step;
+        pit[pit_tail++] = (uint32_t)j;
+      } else {
+        heap_push(heap, &heap_n, h->fill[j], (uint32_t)j);
+      }
+    }
+  }
+  return settled;
+}
+
+/* ── Per-block passes ──────────────────────────────────────────────── */
+static void block_bounds(const hydro_t *h, int index, int32_t *x0, int32_t *y0,
+                         int32_t *x1, int32_t *y1) {
+  *x0 = (index % h->blocks_x) * CIV_MAP_GEN_BLOCK;
+  *y0 = (index / h->blocks_x) * CIV_MAP_GEN_BLOCK;
+  *x1 = MIN(*x0 + CIV_MAP_GEN_BLOCK, h->map->width);
+  *y1 = MIN(*y0 + CIV_MAP_GEN_BLOCK, h->map->height);
+}
+
+/* Steepest strictly lower neighbour on the filled surface; the flood leaves
+   one for every land tile it did not seed */
+static void flow_block(void *ctx, int index) {
+  hydro_t *h = (hydro_t *)ctx;
+  const civ_map_t *m = h->map;
+  int32_t x0, y0, x1, y1;
+  block_bounds(h, index, &x0, &y0, &x1, &y1);
+  for (int32_t y = y0; y < y1; y++)
+    for (int32_t x = x0; x < x1; x++) {
+      size_t i = (size_t)y * (size_t)m->width + (size_t)x;
+      int8_t best = NO_RECEIVER;
+      float best_slope = 0.0f;
+      if (h->kind[i] & TILE_LAND) {
+        for (int d = 0; d < 8; d++) {
+          size_t j;
+          if (!neighbour(m, x, y, d, &j) || h->fill[j] >= h->fill[i]) continue;
+          float slope = (h->fill[i] - h->fill[j]) / DIST[d];
+          if (best == NO_RECEIVER || slope > best_slope) {
+            best = (int8_t)d;
+            best_slope = slope;
+          }
+        }
+      }
+      h->receiver[i] = best;
+    }
+}
+
+static size_t receiver_of(const hydro_t *h, size_t i) {
+  int32_t w = h->map->width;
+  size_t j = i;
+  neighbour(h->map, (int32_t)(i % (size_t)w), (int32_t)(i / (size_t)w),
+            h->receiver[i], &j);
+  return j;
+}
+
+static void apply_lake(civ_map_tile_t *t) {
+  t->land_use = CIV_LAND_USE_WATER;
+  t->terrain = CIV_TERRAIN_COASTAL;
+  t->has_river = false;
+  civ_tile_set_moisture(t, 1.0f);
+  civ_tile_set_fertility(t, 0.0f);
+  civ_tile_set_vegetation_density(t, 0.0f);
+  civ_tile_set_political_influence(t, 0.0f);
+  civ_tile_set_population_density(t, 0.0f);
+  t->cultural_influence = 0.0f;
+}
+
+static void apply_river(const hydro_t *h, size_t i, civ_map_tile_t *t) {
+  uint32_t area = h->area[i];
+  float strength = CLAMP(log2f((float)area / CIV_HYDRO_RIVER_AREA) / 6.0f, 0.0f, 1.0f);
+  t->has_river = true;
+  civ_tile_set_fertility(t, MIN(civ_tile_fertility(t) + 0.15f + 0.15f * strength, 1.0f));
+  civ_tile_set_moisture(t, MAX(civ_tile_moisture(t), 0.5f + 0.4f * strength));
+  if (area >= CIV_HYDRO_VALLEY_AREA && t->terrain == CIV_TERRAIN_PLAIN)
+    t->terrain = CIV_TERRAIN_VALLEY;
+  if (area >= CIV_HYDRO_DELTA_AREA && h->receiver[i] != NO_RECEIVER &&
+      !(h->kind[receiver_of(h, i)] & TILE_LAND))
+    t->land_use = CIV_LAND_USE_WETLAND;
+}
+
+static void apply_block(void *ctx, int index) {
+  hydro_t *h = (hydro_t *)ctx;
+  civ_map_t *m = h->map;
+  int32_t x0, y0, x1, y1;
+  block_bounds(h, index, &x0, &y0, &x1, &y1);
+  int32_t rivers = 0, lakes = 0;
+  for (int32_t y = y0; y < y1; y++)
+    for (int32_t x = x0; x < x1; x++) {
+      size_t i = (size_t)y * (size_t)m->width + (size_t)x;
+      if (!(h->kind[i] & TILE_LAND)) continue;
+      civ_map_tile_t *t = &m->tiles[i];
+      if (h->kind[i] & TILE_LAKE) {
+        apply_lake(t);
+        lakes++;
+        continue;
+      }
+      if (h->area[i] >= CIV_HYDRO_RIVER_AREA) {
+        apply_river(h, i, t);
+        rivers++;
+      }
+      for (int d = 0; d < 8; d++) {
+        size_t j;
+        if (neighbour(m, x, y, d, &j) && (h->kind[j] & TILE_LAKE)) {
+          civ_tile_set_fertility(t, MIN(civ_tile_fertility(t) + 0.1f, 1.0f));
+          civ_tile_set_moisture(t, MAX(civ_tile_moisture(t), 0.6f));
+          break;
+        }
+      }
+    }
+  h->rivers[index] = rivers;
+  h->lakes[index] = lakes;
+}
+
+/* ── Entry point ───────────────────────────────────────────────────── */
+civ_result_t civ_hydrology_generate(civ_map_t *map, struct civ_worker_pool *pool,
+                                    civ_hydrology_stats_t *stats) {
+  if (!map || !map->tiles)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null Map"};
+
+  size_t n = (size_t)map->width * map->height;
+  hydro_t h = {map, (map->width + CIV_MAP_GEN_BLOCK - 1) / CIV_MAP_GEN_BLOCK};
+  int32_t blocks_y = (map->height + CIV_MAP_GEN_BLOCK - 1) / CIV_MAP_GEN_BLOCK;
+  int block_count = (int)(h.blocks_x * blocks_y);
+
+  h.ground = malloc(n * sizeof(float));
+  h.fill = malloc(n * sizeof(float));
+  h.receiver = malloc(n);
+  h.area = malloc(n * sizeof(uint32_t));
+  h.kind = malloc(n);
+  h.rivers = calloc((size_t)MAX(block_count, 1), sizeof(int32_t));
+  h.lakes = calloc((size_t)MAX(block_count, 1), sizeof(int32_t));
+  uint8_t *closed = calloc(n, 1);
+  heap_node_t *heap = malloc(n * sizeof(heap_node_t));
+  uint32_t *pit = malloc(n * sizeof(uint32_t));
+  uint32_t *order = malloc(n * sizeof(uint32_t));
+  civ_result_t result = {CIV_OK, "Hydrology generated"};
+  if (!h.ground || !h.fill || !h.receiver || !h.area || !h.kind || !h.rivers ||
+      !h.lakes || !closed || !heap || !pit || !order) {
+    result = (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Hydrology buffers"};
+    goto done;
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    const civ_map_tile_t *t = &map->tiles[i];
+    h.ground[i] = h.fill[i] = civ_tile_elevation(t);
+    h.kind[i] = t->land_use == CIV_LAND_USE_WATER ? 0 : TILE_LAND;
+    h.area[i] = 1;
+  }
+
+  size_t settled = priority_flood(&h, closed, heap, pit, order);
+  civ_worker_pool_parallel_for(pool, block_count, flow_block, &h);
+
+  /* Receivers settle first: sum areas downstream from the last settled,
+     and count basins at the tiles that leave the land */
+  civ_hydrology_stats_t s = {0};
+  for (size_t k = settled; k-- > 0;) {
+    size_t i = order[k];
+    if (h.fill[i] - h.ground[i] > CIV_HYDRO_LAKE_DEPTH) h.kind[i] |= TILE_LAKE;
+    size_t r = h.receiver[i] == NO_RECEIVER ? i : receiver_of(&h, i);
+    if (r != i && (h.kind[r] & TILE_LAND)) {
+      h.area[r] += h.area[i];
+    } else if (h.area[i] >= CIV_HYDRO_RIVER_AREA) {
+      s.basins++;
+      s.largest_basin = MAX(s.largest_basin, (int32_t)h.area[i]);
+    }
+  }
+
+  civ_worker_pool_parallel_for(pool, block_count, apply_block, &h);
+  for (int b = 0; b < block_count; b++) {
+    s.river_tiles += h.rivers[b];
+    s.lake_tiles += h.lakes[b];
+  }
+  map->river_tile_count = s.river_tiles;
+  map->land_tile_count -= s.lake_tiles;
+  civ_map_sync_planes(map);
+  if (stats) *stats = s;
+
+done:
+  free(h.ground);
+  free(h.fill);
+  free(h.receiver);
+  free(h.area);
+  free(h.kind);
+  free(h.rivers);
+  free(h.lakes);
+  free(closed);
+  free(heap);
+  free(pit);
+  free(order);
+  return result;
+}
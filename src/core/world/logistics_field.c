@@ -0,0 +1,435 @@
+/**
+ * @file logistics_field.c
+ * @brief Cell costs, owner marking and multi-source Dijkstra per owner
+ */
+#include "core/world/logistics_field.h"
+#include "common.h"
+#include "core/simulation_engine/worker_pool.h"
+#include "core/world/pathfinding.h"
+#include <math.h>
+#include <string.h>
+
+#define CELL_TILES   (CIV_LOGISTICS_CELL * CIV_LOGISTICS_CELL)
+#define ROAD_STEPS   16    /* settlement road quantum */
+#define ROAD_CUT     0.5f  /* share of a cell's cost full road coverage removes */
+#define RAIL_CUT     0.3f
+#define TOWN_CUT     0.4f  /* ... and the cell's best settlement road on top */
+#define PORT_CUT     0.5f
+#define MIN_FACTOR   0.15f
+
+typedef struct {
+  uint32_t dist;
+  uint32_t cell;
+} heap_entry_t;
+
+/* ── Owners ────────────────────────────────────────────────────────── */
+
+static bool reserve_owners(civ_logistics_field_t *f, uint32_t want) {
+  if (want <= f->owner_capacity) return true;
+  uint32_t cap = f->owner_capacity ? f->owner_capacity : 64;
+  while (cap < want) cap *= 2;
+  civ_logistics_owner_t *owners = CIV_REALLOC(f->owners, cap * sizeof(*owners));
+  if (!owners) return false;
+  memset(owners + f->owner_capacity, 0,
+         (cap - f->owner_capacity) * sizeof(*owners));
+  f->owners = owners;
+  f->owner_capacity = cap;
+  return true;
+}
+
+static void mark_owner(civ_logistics_field_t *f, civ_owner_index_t owner) {
+  if (owner != CIV_OWNER_NONE && owner < f->owner_capacity)
+    f->owners[owner].dirty = true;
+}
+
+static uint32_t cell_of(const civ_logistics_field_t *f, size_t tile) {
+  int32_t x = (int32_t)(tile % (size_t)f->map_width);
+  int32_t y = (int32_t)(tile / (size_t)f->map_width);
+  return (uint32_t)((y >> CIV_LOGISTICS_CELL_SHIFT) * f->cols +
+                    (x >> CIV_LOGISTICS_CELL_SHIFT));
+}
+
+static void field_listener(void *user_data, const civ_map_t *map, size_t index,
+                           civ_owner_index_t old_owner, civ_owner_index_t new_owner) {
+  (void)map; (void)old_owner; (void)new_owner;
+  civ_logistics_field_t *f = (civ_logistics_field_t *)user_data;
+  f->cell_dirty[cell_of(f, index)] = 1;
+  f->any_cell_dirty = true;
+}
+
+/* ── Lifecycle ─────────────────────────────────────────────────────── */
+
+/* Mean land cost and water majority of one cell */
+static void score_cell(civ_logistics_field_t *f, const civ_map_t *map, uint32_t c) {
+  int32_t x0 = (int32_t)(c % (uint32_t)f->cols) << CIV_LOGISTICS_CELL_SHIFT;
+  int32_t y0 = (int32_t)(c / (uint32_t)f->cols) << CIV_LOGISTICS_CELL_SHIFT;
+  uint32_t land = 0, water = 0, sum = 0;
+  for (int32_t y = y0; y < MIN(y0 + CIV_LOGISTICS_CELL, map->height); y++)
+    for (int32_t x = x0; x < MIN(x0 + CIV_LOGISTICS_CELL, map->width); x++) {
+      size_t i = (size_t)y * map->width + x;
+      uint8_t cost = civ_path_terrain_cost(NULL, map, i);
+      if (cost == 0) { water++; continue; }
+      land++;
+      sum += cost;
+    }
+  f->water[c] = water > land;
+  f->terrain[c] = land ? (float)sum / (float)land : 1.0f;
+}
+
+civ_logistics_field_t *civ_logistics_field_create(civ_map_t *map) {
+  if (!map || !map->tiles || map->width <= 0 || map->height <= 0) return NULL;
+  civ_logistics_field_t *f = CIV_CALLOC(1, sizeof(civ_logistics_field_t));
+  if (!f) return NULL;
+  f->map_width = map->width;
+  f->map_height = map->height;
+  f->cols = (map->width + CIV_LOGISTICS_CELL - 1) >> CIV_LOGISTICS_CELL_SHIFT;
+  f->rows = (map->height + CIV_LOGISTICS_CELL - 1) >> CIV_LOGISTICS_CELL_SHIFT;
+  size_t cells = (size_t)f->cols * f->rows;
+  f->terrain = CIV_MALLOC(cells * sizeof(float));
+  f->water = CIV_MALLOC(cells);
+  f->cell_owner = CIV_CALLOC(cells, sizeof(civ_owner_index_t));
+  f->road = CIV_CALLOC(cells, 1);
+  f->cell_dirty = CIV_MALLOC(cells);
+  if (!f->terrain || !f->water || !f->cell_owner || !f->road || !f->cell_dirty) {
+    civ_logistics_field_destroy(f, NULL);
+    return NULL;
+  }
+  for (uint32_t c = 0; c < cells; c++) score_cell(f, map, c);
+  /* Owners written before the listener are counted by the first refresh */
+  memset(f->cell_dirty, 1, cells);
+  f->any_cell_dirty = true;
+  if (!civ_map_add_owner_listener(map, field_listener, f))
+    civ_log(CIV_LOG_WARNING, "Logistics field: map listener table full");
+  return f;
+}
+
+void civ_logistics_field_destroy(civ_logistics_field_t *field, civ_map_t *map) {
+  if (!field) return;
+  if (map) civ_map_remove_owner_listener(map, field_listener, field);
+  for (uint32_t o = 0; o < field->owner_capacity; o++)
+    CIV_FREE(field->owners[o].cost);
+  CIV_FREE(field->owners);
+  CIV_FREE(field->terrain);
+  CIV_FREE(field->water);
+  CIV_FREE(field->cell_owner);
+  CIV_FREE(field->road);
+  CIV_FREE(field->cell_dirty);
+  CIV_FREE(field);
+}
+
+void civ_logistics_field_bind(civ_logistics_field_t *field, civ_owner_index_t owner,
+                              const civ_infrastructure_system_t *infra) {
+  if (!field || owner == CIV_OWNER_NONE || !reserve_owners(field, (uint32_t)owner + 1))
+    return;
+  civ_logistics_owner_t *o = &field->owners[owner];
+  if (o->bound && o->infra == infra) return;
+  o->bound = true;
+  o->infra = infra;
+  o->dirty = true;
+}
+
+/* ── Refresh ───────────────────────────────────────────────────────── */
+
+/* Majority owner of a cell's land, marking both sides of a change */
+static void recount_cell(civ_logistics_field_t *f, const civ_map_t *map, uint32_t c) {
+  civ_owner_index_t ids[CELL_TILES];
+  uint8_t counts[CELL_TILES];
+  int kinds = 0;
+  int32_t x0 = (int32_t)(c % (uint32_t)f->cols) << CIV_LOGISTICS_CELL_SHIFT;
+  int32_t y0 = (int32_t)(c / (uint32_t)f->cols) << CIV_LOGISTICS_CELL_SHIFT;
+  for (int32_t y = y0; y < MIN(y0 + CIV_LOGISTICS_CELL, map->height); y++)
+    for (int32_t x = x0; x < MIN(x0 + CIV_LOGISTICS_CELL, map->width); x++) {
+      size_t i = (size_t)y * map->width + x;
+      if (civ_map_is_water_at(map, i)) continue;
+      civ_owner_index_t o = civ_map_owner_at(map, i);
+      int k = 0;
+      while (k < kinds && ids[k] != o) k++;
+      if (k == kinds) { ids[kinds] = o; counts[kinds++] = 0; }
+      counts[k]++;
+    }
+  civ_owner_index_t best = CIV_OWNER_NONE;
+  int best_count = 0;
+  for (int k = 0; k < kinds; k++)
+    if (counts[k] > best_count || (counts[k] == best_count && ids[k] < best)) {
+      best = ids[k];
+      best_count = counts[k];
+    }
+  if (best == f->cell_owner[c]) return;
+  mark_owner(f, f->cell_owner[c]);
+  mark_owner(f, best);
+  f->cell_owner[c] = best;
+}
+
+static uint32_t mix(uint32_t v) {
+  v ^= v >> 16;
+  v *= 0x7feb352du;
+  v ^= v >> 15;
+  v *= 0x846ca68bu;
+  v ^= v >> 16;
+  return v;
+}
+
+static civ_owner_index_t settlement_owner(const civ_settlement_manager_t *sm,
+                                          const civ_settlement_t *s) {
+  if (s->owner_index < 0 || (size_t)s->owner_index >= sm->owner_count)
+    return CIV_OWNER_NONE;
+  return sm->owner_ids[s->owner_index];
+}
+
+static bool settlement_cell(const civ_logistics_field_t *f, const civ_settlement_t *s,
+                            uint32_t *cell) {
+  int32_t x = (int32_t)floorf((float)s->x), y = (int32_t)floorf((float)s->y);
+  x = ((x % f->map_width) + f->map_width) % f->map_width;
+  if (y < 0 || y >= f->map_height) return false;
+  *cell = cell_of(f, (size_t)y * f->map_width + x);
+  return true;
+}
+
+static uint32_t infra_key(const civ_infrastructure_system_t *infra) {
+  if (!infra) return 0;
+  uint32_t key = 1u << 24;
+  static const civ_infrastructure_type_t kinds[] = {CIV_INFRA_ROAD, CIV_INFRA_RAIL,
+                                                    CIV_INFRA_PORT};
+  for (int k = 0; k < 3; k++) {
+    const civ_infrastructure_network_t *n = &infra->networks[kinds[k]];
+    float level = CLAMP((float)(n->coverage * n->condition), 0.0f, 1.0f);
+    key |= (uint32_t)(level * CIV_LOGISTICS_QUANTUM) << (8 * k);
+  }
+  return key;
+}
+
+/* Settlement roads by cell, and each owner's hub keys */
+typedef struct {
+  uint32_t city_key, city_count;
+  uint32_t all_key, all_count;
+} hub_tally_t;
+
+static bool scan_settlements(civ_logistics_field_t *f,
+                             const civ_settlement_manager_t *sm) {
+  size_t cells = (size_t)f->cols * f->rows;
+  uint8_t *road = CIV_CALLOC(cells, 1);
+  hub_tally_t *tally = CIV_CALLOC(f->owner_capacity, sizeof(hub_tally_t));
+  if (!road || !tally) {
+    CIV_FREE(road);
+    CIV_FREE(tally);
+    return false;
+  }
+  for (size_t i = 0; sm && i < sm->settlement_count; i++) {
+    const civ_settlement_t *s = &sm->settlements[i];
+    uint32_t c;
+    if (!settlement_cell(f, s, &c)) continue;
+    float quality = CLAMP((float)s->infrastructure.road_quality, 0.0f, 1.0f);
+    road[c] = MAX(road[c], (uint8_t)(quality * ROAD_STEPS));
+    civ_owner_index_t o = settlement_owner(sm, s);
+    if (o == CIV_OWNER_NONE || o >= f->owner_capacity) continue;
+    uint32_t h = mix(c * 8u + (uint32_t)s->tier);
+    tally[o].all_key += h;
+    tally[o].all_count++;
+    if (s->tier >= CIV_SETTLEMENT_CITY) {
+      tally[o].city_key += h;
+      tally[o].city_count++;
+    }
+  }
+  for (size_t c = 0; c < cells; c++) {
+    if (road[c] == f->road[c]) continue;
+    f->road[c] = road[c];
+    mark_owner(f, f->cell_owner[c]);
+  }
+  for (uint32_t o = 1; o < f->owner_capacity; o++) {
+    civ_logistics_owner_t *w = &f->owners[o];
+    if (!w->bound) continue;
+    const hub_tally_t *t = &tally[o];
+    uint32_t key = t->city_count ? t->city_key : t->all_key;
+    uint32_t hubs = t->city_count ? t->city_count : t->all_count;
+    uint32_t ikey = infra_key(w->infra);
+    if (key != w->hub_key || hubs != w->hubs || ikey != w->infra_key || !w->cost)
+      w->dirty = true;
+    w->hub_key = key;
+    w->hubs = hubs;
+    w->infra_key = ikey;
+  }
+  CIV_FREE(road);
+  CIV_FREE(tally);
+  return true;
+}
+
+typedef struct {
+  const civ_logistics_field_t    *field;
+  const civ_settlement_manager_t *settlements;
+  const civ_owner_index_t        *owners;
+} build_ctx_t;
+
+static void heap_push(heap_entry_t *h, uint32_t *n, heap_entry_t e) {
+  uint32_t i = (*n)++;
+  while (i > 0) {
+    uint32_t parent = (i - 1) / 2;
+    if (h[parent].dist <= e.dist) break;
+    h[i] = h[parent];
+    i = parent;
+  }
+  h[i] = e;
+}
+
+static heap_entry_t heap_pop(heap_entry_t *h, uint32_t *n) {
+  heap_entry_t top = h[0], last = h[--(*n)];
+  uint32_t i = 0;
+  for (;;) {
+    uint32_t child = 2 * i + 1;
+    if (child >= *n) break;
+    if (child + 1 < *n && h[child + 1].dist < h[child].dist) child++;
+    if (h[child].dist >= last.dist) break;
+    h[i] = h[child];
+    i = child;
+  }
+  if (*n > 0) h[i] = last;
+  return top;
+}
+
+/* Field steps to enter cell c across one straight cell step */
+static uint32_t enter_cost(const civ_logistics_field_t *f, uint32_t c,
+                           civ_owner_index_t owner, float road, float rail, float port) {
+  float factor;
+  if (f->water[c]) {
+    factor = CIV_LOGISTICS_SEA_COST * (1.0f - PORT_CUT * port);
+  } else {
+    factor = f->terrain[c];
+    if (f->cell_owner[c] == owner)
+      factor *= (1.0f - ROAD_CUT * road - RAIL_CUT * rail) *
+                (1.0f - TOWN_CUT * (float)f->road[c] / ROAD_STEPS);
+  }
+  factor = MAX(factor, MIN_FACTOR);
+  return (uint32_t)lroundf(factor * (float)(CIV_LOGISTICS_CELL * CIV_LOGISTICS_UNIT));
+}
+
+static void build_owner(void *ctx_ptr, int index) {
+  const build_ctx_t *ctx = (const build_ctx_t *)ctx_ptr;
+  const civ_logistics_field_t *f = ctx->field;
+  const civ_settlement_manager_t *sm = ctx->settlements;
+  civ_owner_index_t owner = ctx->owners[index];
+  civ_logistics_owner_t *w = &f->owners[owner];
+  uint32_t cells = (uint32_t)f->cols * (uint32_t)f->rows;
+
+  if (!w->cost) w->cost = CIV_MALLOC(cells * sizeof(uint16_t));
+  uint32_t *dist = CIV_MALLOC(cells * sizeof(uint32_t));
+  /* A push is an improvement along one of a settled cell's 8 edges */
+  uint32_t heap_cap = cells * 8u + 64u, heap_n = 0;
+  heap_entry_t *heap = CIV_MALLOC(heap_cap * sizeof(heap_entry_t));
+  if (!w->cost || !dist || !heap) {
+    CIV_FREE(dist);
+    CIV_FREE(heap);
+    return; /* stays dirty; rebuilt next refresh */
+  }
+  for (uint32_t c = 0; c < cells; c++) dist[c] = UINT32_MAX;
+
+  float road = 0.0f, rail = 0.0f, port = 0.0f;
+  if (w->infra) {
+    const civ_infrastructure_network_t *n = w->infra->networks;
+    road = CLAMP((float)(n[CIV_INFRA_ROAD].coverage * n[CIV_INFRA_ROAD].condition), 0.0f, 1.0f);
+    rail = CLAMP((float)(n[CIV_INFRA_RAIL].coverage * n[CIV_INFRA_RAIL].condition), 0.0f, 1.0f);
+    port = CLAMP((float)(n[CIV_INFRA_PORT].coverage * n[CIV_INFRA_PORT].condition), 0.0f, 1.0f);
+  }
+
+  bool cities = false;
+  for (size_t i = 0; sm && i < sm->settlement_count && !cities; i++)
+    cities = settlement_owner(sm, &sm->settlements[i]) == owner &&
+             sm->settlements[i].tier >= CIV_SETTLEMENT_CITY;
+  for (size_t i = 0; sm && i < sm->settlement_count; i++) {
+    const civ_settlement_t *s = &sm->settlements[i];
+    uint32_t c;
+    if (settlement_owner(sm, s) != owner || (cities && s->tier < CIV_SETTLEMENT_CITY) ||
+        !settlement_cell(f, s, &c) || dist[c] == 0)
+      continue;
+    dist[c] = 0;
+    heap_push(heap, &heap_n, (heap_entry_t){0, c});
+  }
+
+  static const int DX[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+  static const int DY[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+  while (heap_n > 0) {
+    heap_entry_t e = heap_pop(heap, &heap_n);
+    if (e.dist != dist[e.cell]) continue;
+    int32_t cx = (int32_t)(e.cell % (uint32_t)f->cols);
+    int32_t cy = (int32_t)(e.cell / (uint32_t)f->cols);
+    for (int d = 0; d < 8; d++) {
+      int32_t ny = cy + DY[d];
+      if (ny < 0 || ny >= f->rows) continue;
+      int32_t nx = (cx + DX[d] + f->cols) % f->cols;
+      uint32_t n = (uint32_t)(ny * f->cols + nx);
+      uint32_t step = enter_cost(f, n, owner, road, rail, port);
+      if (d >= 4) step = step * CIV_PATH_COST_DIAGONAL / CIV_PATH_COST_STRAIGHT;
+      uint32_t nd = e.dist + step;
+      if (nd >= dist[n] || nd >= CIV_LOGISTICS_FAR) continue;
+      dist[n] = nd;
+      if (heap_n < heap_cap) heap_push(heap, &heap_n, (heap_entry_t){nd, n});
+    }
+  }
+
+  double sum = 0.0;
+  uint32_t own = 0;
+  for (uint32_t c = 0; c < cells; c++) {
+    w->cost[c] = dist[c] == UINT32_MAX ? CIV_LOGISTICS_FAR : (uint16_t)dist[c];
+    if (dist[c] != UINT32_MAX && f->cell_owner[c] == owner && !f->water[c]) {
+      sum += dist[c];
+      own++;
+    }
+  }
+  w->mean = own ? (float)(sum / own / CIV_LOGISTICS_UNIT) : 0.0f;
+  w->revision++;
+  w->dirty = false;
+  CIV_FREE(dist);
+  CIV_FREE(heap);
+}
+
+size_t civ_logistics_field_refresh(civ_logistics_field_t *field, const civ_map_t *map,
+                                   const civ_settlement_manager_t *settlements,
+                                   struct civ_worker_pool *pool) {
+  if (!field || !map || map->width != field->map_width ||
+      map->height != field->map_height)
+    return 0;
+  if (field->any_cell_dirty) {
+    size_t cells = (size_t)field->cols * field->rows;
+    for (uint32_t c = 0; c < cells; c++) {
+      if (!field->cell_dirty[c]) continue;
+      field->cell_dirty[c] = 0;
+      recount_cell(field, map, c);
+    }
+    field->any_cell_dirty = false;
+  }
+  if (!scan_settlements(field, settlements)) return 0;
+
+  uint32_t dirty = 0;
+  for (uint32_t o = 1; o < field->owner_capacity; o++)
+    if (field->owners[o].bound && field->owners[o].dirty) dirty++;
+  if (dirty == 0) return 0;
+  civ_owner_index_t *owners = CIV_MALLOC(dirty * sizeof(civ_owner_index_t));
+  if (!owners) return 0;
+  dirty = 0;
+  for (uint32_t o = 1; o < field->owner_capacity; o++)
+    if (field->owners[o].bound && field->owners[o].dirty)
+      owners[dirty++] = (civ_owner_index_t)o;
+
+  build_ctx_t ctx = {field, settlements, owners};
+  civ_worker_pool_parallel_for(pool, (int)dirty, build_owner, &ctx);
+  field->refreshes++;
+  CIV_FREE(owners);
+  return dirty;
+}
+
+/* ── Queries ───────────────────────────────────────────────────────── */
+
+float civ_logistics_field_cost(const civ_logistics_field_t *field,
+                               civ_owner_index_t owner, size_t tile) {
+  if (!field || owner == CIV_OWNER_NONE || owner >= field->owner_capacity ||
+      tile >= (size_t)field->map_width * field->map_height)
+    return INFINITY;
+  const civ_logistics_owner_t *w = &field->owners[owner];
+  if (!w->cost) return INFINITY;
+  uint16_t c = w->cost[cell_of(field, tile)];
+  return c == CIV_LOGISTICS_FAR ? INFINITY : (float)c / CIV_LOGISTICS_UNIT;
+}
+
+float civ_logistics_field_mean(const civ_logistics_field_t *field,
+                               civ_owner_index_t owner) {
+  if (!field || owner == CIV_OWNER_NONE || owner >= field->owner_capacity) return 0.0f;
+  return field->owners[owner].cost ? field->owners[owner].mean : 0.0f;
+}
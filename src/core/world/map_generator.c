@@ -5,7 +5,9 @@
 
 #include "common.h"
 #include "core/data/history_db.h"
+#include "core/world/hydrology.h"
 #include "core/world/map_generator.h"
+#include "core/simulation_engine/worker_pool.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
@@ -32,13 +34,42 @@ static civ_float_t atlas_shape_signal(civ_float_t nx, civ_float_t ny) {
   return 0.46f + wave_a + wave_b + (c1 + c2 + c3) * 0.55f;
 }
 
+/* Lattice value in [0, 1) from integer coordinates */
+static civ_float_t lattice(uint32_t x, uint32_t y, uint32_t seed) {
+  uint32_t h = x * 0x8da6b343u ^ y * 0xd8163841u ^ seed * 0xcb1ab31fu;
+  h ^= h >> 15;
+  h *= 0x2c1b3c6du;
+  h ^= h >> 12;
+  h *= 0x297a2d39u;
+  h ^= h >> 15;
+  return (civ_float_t)(h >> 8) * (1.0f / 16777216.0f);
+}
+
+/* Smoothed value noise over octaves of 64 down to 8 tiles, wrapping in x
+   every width tiles; roughly [0, 1] */
+static civ_float_t relief_noise(int32_t x, int32_t y, int32_t width, uint32_t seed) {
+  civ_float_t sum = 0.0f, amp = 0.5f;
+  for (int32_t cell = 64; cell >= 8; cell /= 2, amp *= 0.5f) {
+    uint32_t period = (uint32_t)MAX((width + cell - 1) / cell, 1);
+    uint32_t cx = (uint32_t)(x / cell), cy = (uint32_t)(y / cell);
+    civ_float_t fx = (civ_float_t)(x % cell) / cell, fy = (civ_float_t)(y % cell) / cell;
+    fx = fx * fx * (3.0f - 2.0f * fx);
+    fy = fy * fy * (3.0f - 2.0f * fy);
+    uint32_t s = seed + (uint32_t)cell;
+    civ_float_t a = lattice(cx % period, cy, s), b = lattice((cx + 1) % period, cy, s);
+    civ_float_t c = lattice(cx % period, cy + 1, s), d = lattice((cx + 1) % period, cy + 1, s);
+    sum += amp * (a + (b - a) * fx + (c - a) * fy + (a - b - c + d) * fx * fy);
+  }
+  return sum / 0.9375f;
+}
+
 civ_map_gen_params_t civ_map_default_params(void) {
   civ_map_gen_params_t p = {0};
   p.width = CIV_DEFAULT_MAP_WIDTH;
   p.height = CIV_DEFAULT_MAP_HEIGHT;
   p.sea_level = CIV_DEFAULT_SEA_LEVEL;
   p.seed = CIV_GLOBAL_MAP_SEED;
-  p.generate_rivers = false;
+  p.generate_rivers = true;
   p.generate_mountains = false;
   p.generate_resources = false;
   return p;
@@ -49,12 +80,86 @@ civ_result_t civ_map_genesis(civ_map_t *map) {
     return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null Map"};
 
   civ_map_gen_params_t p = civ_map_default_params();
-  civ_journal_log(g_journal, CIV_JOURNAL_WORLD_GEN_START,
-                  "Global atlas generation started", &p.seed,
-                  sizeof(uint32_t));
   return civ_map_generate(map, &p);
 }
 
+/* ── Block generation ──────────────────────────────────────────────── */
+typedef struct {
+  civ_map_t *map;
+  int32_t    blocks_x;
+  int32_t   *land_counts;   /* one per block, summed after the pass */
+  int        first;         /* block the current row starts at */
+} gen_blocks_t;
+
+static bool gen_tile(civ_map_t *map, int32_t x, int32_t y, bool is_polar,
+                     civ_float_t ny) {
+  civ_map_tile_t *tile = &map->tiles[(size_t)y * map->width + x];
+
+  civ_float_t nx = (civ_float_t)x / (civ_float_t)(map->width - 1);
+  civ_float_t shape = atlas_shape_signal(nx, ny);
+  bool is_land = (!is_polar && shape >= map->sea_level);
+
+  tile->x = x;
+  tile->y = y;
+  /* Land rises gently inland from the coast, roughened so drainage gathers
+     into valleys; kept within the highland band the atlas is drawn in */
+  civ_float_t relief = 0.6f * clampf((shape - map->sea_level) * 2.0f, 0.0f, 1.0f) +
+                       0.4f * relief_noise(x, y, map->width, map->seed);
+  civ_tile_set_elevation(tile, is_land ? 0.56f + 0.13f * relief : 0.1f);
+  civ_tile_set_temperature(tile, 0.0f);
+  civ_tile_set_moisture(tile, 0.0f);
+  tile->has_river = false;
+  tile->has_resource = false;
+  civ_tile_set_resources(tile, 0.0f);
+  civ_tile_set_fertility(tile, is_land ? 0.5f : 0.0f);
+  civ_tile_set_vegetation_density(tile, is_land ? 0.3f : 0.0f);
+  tile->is_explored = true;   /* world geography is known */
+  tile->is_visible = false;    /* tactical visibility per unit */
+  tile->owner_index = CIV_OWNER_NONE;
+
+  tile->terrain = is_land ? CIV_TERRAIN_PLAIN : CIV_TERRAIN_COASTAL;
+  tile->land_use = is_land ? CIV_LAND_USE_GRASSLAND : CIV_LAND_USE_WATER;
+
+  /* Atlas overlays kept simple; political borders are dynamic elsewhere. */
+  civ_tile_set_political_influence(tile, is_land ? 0.5f : 0.0f);
+  civ_tile_set_population_density(tile, is_land ? 0.35f : 0.0f);
+  tile->cultural_influence = is_land ? 0.4f : 0.0f;
+  return is_land;
+}
+
+static void gen_block(void *ctx, int index) {
+  gen_blocks_t *g = (gen_blocks_t *)ctx;
+  index += g->first;
+  civ_map_t *map = g->map;
+  const civ_float_t polar_band = 0.08f;
+
+  int32_t x0 = (index % g->blocks_x) * CIV_MAP_GEN_BLOCK;
+  int32_t y0 = (index / g->blocks_x) * CIV_MAP_GEN_BLOCK;
+  int32_t x1 = MIN(x0 + CIV_MAP_GEN_BLOCK, map->width);
+  int32_t y1 = MIN(y0 + CIV_MAP_GEN_BLOCK, map->height);
+
+  int32_t land = 0;
+  for (int32_t y = y0; y < y1; y++) {
+    civ_float_t ny = (civ_float_t)y / (civ_float_t)(map->height - 1);
+    bool is_polar = (ny <= polar_band || ny >= (1.0f - polar_band));
+    for (int32_t x = x0; x < x1; x++)
+      land += gen_tile(map, x, y, is_polar, ny);
+  }
+  g->land_counts[index] = land;
+}
+
+/* Where each stage starts, as a fraction of the whole run */
+static const float k_stage_start[CIV_MAP_GEN_STAGE_COUNT + 1] = {
+    0.0f, 0.6f, 0.9f, 0.95f, 1.0f};
+
+static void report(const civ_map_gen_params_t *params,
+                   civ_map_gen_stage_t stage, float within) {
+  float from = k_stage_start[stage], to = k_stage_start[stage + 1];
+  g_gen_progress = from + (to - from) * clampf(within, 0.0f, 1.0f);
+  if (params->progress)
+    params->progress(params->progress_user_data, stage, g_gen_progress);
+}
+
 civ_result_t civ_map_generate(civ_map_t *map,
                               const civ_map_gen_params_t *params) {
   if (!map || !params)
@@ -67,67 +172,70 @@ civ_result_t civ_map_generate(civ_map_t *map,
   map->river_tile_count = 0;
   map->mountain_tile_count = 0;
 
-  const civ_float_t polar_band = 0.08f;
-
-  for (int32_t y = 0; y < map->height; y++) {
-    if ((y & 63) == 0) {
-      g_gen_progress = (float)y / (float)map->height;
-    }
-
-    civ_float_t ny = (civ_float_t)y / (civ_float_t)(map->height - 1);
-    bool is_polar = (ny <= polar_band || ny >= (1.0f - polar_band));
-
-    for (int32_t x = 0; x < map->width; x++) {
-      civ_map_tile_t *tile = civ_map_get_tile(map, x, y);
-      if (!tile)
-        continue;
-
-      civ_float_t nx = (civ_float_t)x / (civ_float_t)(map->width - 1);
-      civ_float_t shape = atlas_shape_signal(nx, ny);
-      bool is_land = (!is_polar && shape >= map->sea_level);
-
-      tile->x = x;
-      tile->y = y;
-      tile->elevation = is_land ? 0.65f : 0.1f;
-      tile->temperature = 0.0f;
-      tile->moisture = 0.0f;
-      tile->has_river = false;
-      tile->has_resource = false;
-      tile->resources = 0.0f;
-      tile->fertility = is_land ? 0.5f : 0.0f;
-      tile->vegetation_density = is_land ? 0.3f : 0.0f;
-      tile->is_explored = true;   /* world geography is known */
-      tile->is_visible = false;    /* tactical visibility per unit */
-      tile->owner_id[0] = '\0';
-
-      tile->terrain = is_land ? CIV_TERRAIN_PLAIN : CIV_TERRAIN_COASTAL;
-      tile->land_use = is_land ? CIV_LAND_USE_GRASSLAND : CIV_LAND_USE_WATER;
-
-      /* Atlas overlays kept simple; political borders are dynamic elsewhere. */
-      tile->political_influence = is_land ? 0.5f : 0.0f;
-      tile->population_density = is_land ? 0.35f : 0.0f;
-      tile->cultural_influence = is_land ? 0.4f : 0.0f;
-
-      if (is_land) {
-        map->land_tile_count++;
-      }
-    }
+  civ_journal_log(g_journal, CIV_JOURNAL_WORLD_GEN_START,
+                  "Global atlas generation started", &map->seed,
+                  sizeof(uint32_t));
+  report(params, CIV_MAP_GEN_STAGE_HEIGHTMAP, 0.0f);
+
+  /* Every tile depends only on its coordinates, so blocks need no halo and
+     the pool yields the serial result bit for bit; a row of blocks at a
+     time, so progress moves on an 8192x4096 atlas */
+  gen_blocks_t g = {map, (map->width + CIV_MAP_GEN_BLOCK - 1) / CIV_MAP_GEN_BLOCK,
+                    NULL, 0};
+  int32_t blocks_y = (map->height + CIV_MAP_GEN_BLOCK - 1) / CIV_MAP_GEN_BLOCK;
+  int block_count = (int)(g.blocks_x * blocks_y);
+  g.land_counts = calloc((size_t)MAX(block_count, 1), sizeof(int32_t));
+  if (!g.land_counts)
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Map generation blocks"};
+
+  for (int32_t row = 0; row < blocks_y; row++) {
+    g.first = (int)(row * g.blocks_x);
+    civ_worker_pool_parallel_for(params->worker_pool, (int)g.blocks_x, gen_block, &g);
+    report(params, CIV_MAP_GEN_STAGE_HEIGHTMAP, (float)(row + 1) / (float)blocks_y);
+  }
+  for (int b = 0; b < block_count; b++)
+    map->land_tile_count += g.land_counts[b];
+  free(g.land_counts);
+
+  if (params->generate_rivers) {
+    report(params, CIV_MAP_GEN_STAGE_RIVERS, 0.0f);
+    civ_result_t res = civ_hydrology_generate(map, params->worker_pool, NULL);
+    if (CIV_FAILED(res)) return res;
+  }
+  if (params->generate_resources) {
+    report(params, CIV_MAP_GEN_STAGE_RESOURCES, 0.0f);
+    civ_result_t res = civ_map_generate_resources(map);
+    if (CIV_FAILED(res)) return res;
   }
 
-  g_gen_progress = 1.0f;
+  report(params, CIV_MAP_GEN_STAGE_FINALIZE, 0.0f);
+  civ_map_touch_all(map);
+  report(params, CIV_MAP_GEN_STAGE_FINALIZE, 1.0f);
   civ_journal_log(g_journal, CIV_JOURNAL_BIOME_FINALIZED,
                   "Global atlas generation complete", NULL, 0);
   return (civ_result_t){CIV_OK, "Global atlas generated"};
 }
 
+static uint32_t map_serial;
+
 civ_map_t *civ_map_create(int32_t width, int32_t height, uint32_t seed) {
   civ_map_t *m = malloc(sizeof(civ_map_t));
   if (m) {
     m->width = width;
     m->height = height;
     m->seed = seed;
+    m->planes = NULL;
+    memset(m->owner_listeners, 0, sizeof(m->owner_listeners));
+    m->owner_listener_count = 0;
+    m->serial = ++map_serial;
+    m->region_cols = (width + CIV_MAP_REGION_SIZE - 1) >> CIV_MAP_REGION_SHIFT;
+    m->region_rows = (height + CIV_MAP_REGION_SIZE - 1) >> CIV_MAP_REGION_SHIFT;
+    m->region_revision =
+        calloc((size_t)m->region_cols * m->region_rows, sizeof(uint32_t));
     m->tiles = calloc((size_t)width * height, sizeof(civ_map_tile_t));
-    if (!m->tiles) {
+    if (!m->tiles || !civ_map_metric_init(&m->metric, width, height)) {
+      free(m->tiles);
+      free(m->region_revision);
       free(m);
       return NULL;
     }
@@ -144,6 +252,9 @@ civ_map_t *civ_map_create(int32_t width, int32_t height, uint32_t seed) {
 
 void civ_map_destroy(civ_map_t *m) {
   if (m) {
+    civ_map_disable_planes(m);
+    civ_map_metric_free(&m->metric);
+    free(m->region_revision);
     free(m->tiles);
     free(m);
   }
@@ -191,8 +302,7 @@ civ_result_t civ_map_simulate_erosion(civ_map_t *m, int i) {
 }
 
 civ_result_t civ_map_generate_rivers(civ_map_t *m) {
-  (void)m;
-  return (civ_result_t){CIV_OK, "Rivers disabled for atlas mode"};
+  return civ_hydrology_generate(m, NULL, NULL);
 }
 
 civ_result_t civ_map_generate_resources(civ_map_t *m) {
@@ -214,6 +324,184 @@ civ_float_t civ_map_tile_distance(const civ_map_tile_t *a,
   return 0.0f;
 }
 
+/* ── Tile planes ─────────────────────────────────────────────────── */
+static uint8_t tile_flags(const civ_map_tile_t *t) {
+  uint8_t f = 0;
+  if (t->has_river) f |= CIV_TILE_FLAG_RIVER;
+  if (t->has_resource) f |= CIV_TILE_FLAG_RESOURCE;
+  if (t->land_use == CIV_LAND_USE_WATER) f |= CIV_TILE_FLAG_WATER;
+  return f;
+}
+
+bool civ_map_enable_planes(civ_map_t *m) {
+  if (!m || !m->tiles) return false;
+  if (m->planes) return true;
+
+  size_t n = (size_t)m->width * m->height;
+  civ_map_planes_t *p = calloc(1, sizeof(*p));
+  if (!p) return false;
+  p->elevation       = malloc(n * sizeof(float));
+  p->moisture        = malloc(n * sizeof(float));
+  p->temperature     = malloc(n * sizeof(float));
+  p->fertility       = malloc(n * sizeof(float));
+  p->terrain         = malloc(n);
+  p->land_use        = malloc(n);
+  p->owner           = malloc(n * sizeof(civ_owner_index_t));
+  p->flags           = malloc(n);
+  p->political_color = malloc(n * sizeof(uint32_t));
+  p->visible         = calloc((n + 63) / 64, sizeof(uint64_t));
+  p->explored        = calloc((n + 63) / 64, sizeof(uint64_t));
+  m->planes = p;
+  if (!p->elevation || !p->moisture || !p->temperature || !p->fertility ||
+      !p->terrain || !p->land_use || !p->owner || !p->flags ||
+      !p->political_color || !p->visible || !p->explored) {
+    civ_map_disable_planes(m);
+    return false;
+  }
+  civ_map_sync_planes(m);
+  return true;
+}
+
+void civ_map_disable_planes(civ_map_t *m) {
+  if (!m || !m->planes) return;
+  civ_map_planes_t *p = m->planes;
+  free(p->elevation);
+  free(p->moisture);
+  free(p->temperature);
+  free(p->fertility);
+  free(p->terrain);
+  free(p->land_use);
+  free(p->owner);
+  free(p->flags);
+  free(p->political_color);
+  free(p->visible);
+  free(p->explored);
+  free(p);
+  m->planes = NULL;
+}
+
+static void set_bit(uint64_t *plane, size_t i, bool on) {
+  uint64_t bit = (uint64_t)1 << (i & 63);
+  if (on)
+    plane[i >> 6] |= bit;
+  else
+    plane[i >> 6] &= ~bit;
+}
+
+void civ_map_touch_tile(civ_map_t *m, size_t i) {
+  if (!m || !m->region_revision) return;
+  int32_t x = (int32_t)(i % (size_t)m->width), y = (int32_t)(i / (size_t)m->width);
+  m->region_revision[(size_t)(y >> CIV_MAP_REGION_SHIFT) * m->region_cols +
+                     (x >> CIV_MAP_REGION_SHIFT)]++;
+}
+
+void civ_map_touch_all(civ_map_t *m) {
+  if (!m || !m->region_revision) return;
+  size_t n = (size_t)m->region_cols * m->region_rows;
+  for (size_t r = 0; r < n; r++) m->region_revision[r]++;
+}
+
+static void copy_tile_to_planes(civ_map_t *m, size_t i) {
+  const civ_map_tile_t *t = &m->tiles[i];
+  civ_map_planes_t *p = m->planes;
+  p->elevation[i]       = civ_tile_elevation(t);
+  p->moisture[i]        = civ_tile_moisture(t);
+  p->temperature[i]     = civ_tile_temperature(t);
+  p->fertility[i]       = civ_tile_fertility(t);
+  p->terrain[i]         = (uint8_t)t->terrain;
+  p->land_use[i]        = (uint8_t)t->land_use;
+  p->owner[i]           = t->owner_index;
+  p->flags[i]           = tile_flags(t);
+  p->political_color[i] = t->political_color;
+  set_bit(p->visible, i, t->is_visible);
+  set_bit(p->explored, i, t->is_explored);
+}
+
+void civ_map_sync_tile(civ_map_t *m, size_t i) {
+  if (!m) return;
+  civ_map_touch_tile(m, i);
+  if (m->planes) copy_tile_to_planes(m, i);
+}
+
+void civ_map_sync_planes(civ_map_t *m) {
+  if (!m) return;
+  civ_map_touch_all(m);
+  if (!m->planes) return;
+  size_t n = (size_t)m->width * m->height;
+  for (size_t i = 0; i < n; i++) copy_tile_to_planes(m, i);
+}
+
+void civ_map_set_owner(civ_map_t *m, size_t i, civ_owner_index_t owner,
+                       uint32_t political_color) {
+  if (!m) return;
+  civ_owner_index_t old_owner = m->tiles[i].owner_index;
+  if (old_owner != owner || m->tiles[i].political_color != political_color)
+    civ_map_touch_tile(m, i);
+  m->tiles[i].owner_index = owner;
+  m->tiles[i].political_color = political_color;
+  if (m->planes) {
+    m->planes->owner[i] = owner;
+    m->planes->political_color[i] = political_color;
+  }
+  if (old_owner == owner) return;
+  for (int l = 0; l < m->owner_listener_count; l++)
+    m->owner_listeners[l].fn(m->owner_listeners[l].user_data, m, i, old_owner,
+                             owner);
+}
+
+bool civ_map_add_owner_listener(civ_map_t *m, civ_map_owner_listener_t fn,
+                                void *user_data) {
+  if (!m || !fn) return false;
+  if (civ_map_has_owner_listener(m, fn, user_data)) return true;
+  if (m->owner_listener_count >= CIV_MAP_MAX_OWNER_LISTENERS) return false;
+  m->owner_listeners[m->owner_listener_count].fn = fn;
+  m->owner_listeners[m->owner_listener_count].user_data = user_data;
+  m->owner_listener_count++;
+  return true;
+}
+
+void civ_map_remove_owner_listener(civ_map_t *m, civ_map_owner_listener_t fn,
+                                   void *user_data) {
+  if (!m) return;
+  for (int l = 0; l < m->owner_listener_count; l++) {
+    if (m->owner_listeners[l].fn == fn && m->owner_listeners[l].user_data == user_data) {
+      m->owner_listeners[l] = m->owner_listeners[--m->owner_listener_count];
+      return;
+    }
+  }
+}
+
+bool civ_map_has_owner_listener(const civ_map_t *m, civ_map_owner_listener_t fn,
+                                const void *user_data) {
+  if (!m) return false;
+  for (int l = 0; l < m->owner_listener_count; l++) {
+    if (m->owner_listeners[l].fn == fn && m->owner_listeners[l].user_data == user_data)
+      return true;
+  }
+  return false;
+}
+
+void civ_map_set_visibility(civ_map_t *m, size_t i, bool visible,
+                            bool explored) {
+  if (!m) return;
+  if (m->tiles[i].is_visible != visible || m->tiles[i].is_explored != explored)
+    civ_map_touch_tile(m, i);
+  m->tiles[i].is_visible = visible;
+  m->tiles[i].is_explored = explored;
+  if (m->planes) {
+    set_bit(m->planes->visible, i, visible);
+    set_bit(m->planes->explored, i, explored);
+  }
+}
+
+const char *civ_map_tile_owner_id(const civ_map_tile_t *tile) {
+  return tile ? civ_owner_name(tile->owner_index) : "";
+}
+
+void civ_map_tile_set_owner_id(civ_map_tile_t *tile, const char *owner_id) {
+  if (tile) tile->owner_index = civ_owner_intern(owner_id);
+}
+
 int32_t civ_map_count_terrain(const civ_map_t *m, civ_terrain_type_t t) {
   (void)m;
   (void)t;
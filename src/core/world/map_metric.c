@@ -0,0 +1,97 @@
+/**
+ * @file map_metric.c
+ * @brief Per-row metric tables and tile distances
+ */
+#include "core/world/map_metric.h"
+#include "common.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEG_TO_RAD (M_PI / 180.0)
+
+bool civ_map_metric_init(civ_map_metric_t *metric, int32_t width,
+                         int32_t height) {
+  if (!metric)
+    return false;
+  memset(metric, 0, sizeof(*metric));
+  if (width <= 0 || height <= 0)
+    return false;
+  metric->width = width;
+  metric->height = height;
+  size_t rows = (size_t)height;
+  metric->lat_deg = (float *)CIV_MALLOC(rows * sizeof(float));
+  metric->cos_lat = (float *)CIV_MALLOC(rows * sizeof(float));
+  metric->dx_km = (float *)CIV_MALLOC(rows * sizeof(float));
+  metric->area_km2 = (float *)CIV_MALLOC(rows * sizeof(float));
+  metric->hav_row = (float *)CIV_MALLOC(rows * sizeof(float));
+  metric->hav_col = (float *)CIV_MALLOC(((size_t)width / 2 + 1) * sizeof(float));
+  if (!metric->lat_deg || !metric->cos_lat || !metric->dx_km ||
+      !metric->area_km2 || !metric->hav_row || !metric->hav_col) {
+    civ_map_metric_free(metric);
+    return false;
+  }
+
+  const double r = CIV_MAP_METRIC_EARTH_KM;
+  const double dlat = M_PI / height, dlon = 2.0 * M_PI / width;
+  metric->dy_km = (float)(r * dlat);
+  metric->short_cols = MAX(width * CIV_MAP_METRIC_SHORT_DEGREES / 360, 1);
+  for (int32_t y = 0; y < height; y++) {
+    double north = M_PI / 2.0 - y * dlat, south = north - dlat;
+    double lat = north - 0.5 * dlat;
+    metric->lat_deg[y] = (float)(lat / DEG_TO_RAD);
+    metric->cos_lat[y] = (float)cos(lat);
+    metric->dx_km[y] = (float)(r * cos(lat) * dlon);
+    /* The band between the row's edges, shared out over its tiles */
+    metric->area_km2[y] = (float)(r * r * dlon * (sin(north) - sin(south)));
+    double h = sin(0.5 * y * dlat);
+    metric->hav_row[y] = (float)(h * h);
+  }
+  for (int32_t dx = 0; dx <= width / 2; dx++) {
+    double h = sin(0.5 * dx * dlon);
+    metric->hav_col[dx] = (float)(h * h);
+  }
+  return true;
+}
+
+void civ_map_metric_free(civ_map_metric_t *metric) {
+  if (!metric)
+    return;
+  CIV_FREE(metric->lat_deg);
+  CIV_FREE(metric->cos_lat);
+  CIV_FREE(metric->dx_km);
+  CIV_FREE(metric->area_km2);
+  CIV_FREE(metric->hav_row);
+  CIV_FREE(metric->hav_col);
+  memset(metric, 0, sizeof(*metric));
+}
+
+float civ_map_metric_distance_km(const civ_map_metric_t *metric, int32_t x0,
+                                 int32_t y0, int32_t x1, int32_t y1) {
+  if (!metric || !metric->dx_km)
+    return 0.0f;
+  int32_t w = metric->width;
+  y0 = CLAMP(y0, 0, metric->height - 1);
+  y1 = CLAMP(y1, 0, metric->height - 1);
+  int32_t cols = abs(x1 - x0) % w;
+  if (cols > w / 2)
+    cols = w - cols;
+  int32_t rows = abs(y1 - y0);
+
+  float ew = 0.5f * (metric->dx_km[y0] + metric->dx_km[y1]) * (float)cols;
+  float ns = metric->dy_km * (float)rows;
+  if (ew < CIV_MAP_METRIC_SHORT_KM && ns < CIV_MAP_METRIC_SHORT_KM &&
+      cols <= metric->short_cols)
+    return sqrtf(ew * ew + ns * ns);
+
+  float a = metric->hav_row[rows] +
+            metric->cos_lat[y0] * metric->cos_lat[y1] * metric->hav_col[cols];
+  return (float)(2.0 * CIV_MAP_METRIC_EARTH_KM * asin(sqrt(MIN(a, 1.0f))));
+}
+
+int32_t civ_map_metric_row_of(const civ_map_metric_t *metric, float lat_deg) {
+  if (!metric || metric->height <= 0)
+    return 0;
+  int32_t y = (int32_t)floorf((90.0f - lat_deg) / 180.0f * (float)metric->height);
+  return CLAMP(y, 0, metric->height - 1);
+}
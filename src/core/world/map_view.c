@@ -7,6 +7,7 @@
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
 #include <math.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -26,9 +27,6 @@ void civ_map_view_manager_destroy(civ_map_view_manager_t *manager) {
   if (!manager)
     return;
 
-  for (size_t i = 0; i < manager->view_count; i++) {
-    CIV_FREE(manager->views[i].data);
-  }
   CIV_FREE(manager->views);
   CIV_FREE(manager);
 }
@@ -46,17 +44,14 @@ void civ_map_view_manager_init(civ_map_view_manager_t *manager,
   manager->current_view = CIV_MAP_VIEW_GEOGRAPHICAL;
 
   if (manager->views && base_map) {
-    size_t tile_count = (size_t)base_map->width * (size_t)base_map->height;
-
     for (size_t i = 0; i < manager->view_count; i++) {
       manager->views[i].view_type = (civ_map_view_type_t)i;
       manager->views[i].width = base_map->width;
       manager->views[i].height = base_map->height;
       manager->views[i].visible = (i == CIV_MAP_VIEW_GEOGRAPHICAL);
       manager->views[i].opacity = 1.0f;
-      manager->views[i].data =
-          (civ_float_t *)CIV_CALLOC(tile_count, sizeof(civ_float_t));
     }
+    civ_map_view_manager_refresh_all(manager);
   }
 }
 
@@ -89,6 +84,14 @@ civ_result_t civ_map_view_manager_set_view(civ_map_view_manager_t *manager,
   return result;
 }
 
+/* Point view at a field of the tile store */
+static void bind_tiles(civ_map_view_t *view, const civ_map_t *map,
+                       size_t offset, civ_map_view_source_t source) {
+  view->base = (const uint8_t *)map->tiles + offset;
+  view->stride = sizeof(civ_map_tile_t);
+  view->source = source;
+}
+
 civ_result_t civ_map_view_manager_update_view(civ_map_view_manager_t *manager,
                                               civ_map_view_type_t view_type) {
   civ_result_t result = {CIV_OK, NULL};
@@ -104,75 +107,52 @@ civ_result_t civ_map_view_manager_update_view(civ_map_view_manager_t *manager,
   }
 
   civ_map_view_t *view = &manager->views[view_type];
+  const civ_map_t *map = manager->base_map;
+  view->base = NULL;
+  view->stride = 0;
+  view->source = CIV_MAP_VIEW_SOURCE_NONE;
+  if (!map->tiles)
+    return result;
 
   switch (view_type) {
   case CIV_MAP_VIEW_GEOGRAPHICAL:
-    /* Use elevation and terrain */
-    for (int32_t y = 0; y < manager->base_map->height; y++) {
-      for (int32_t x = 0; x < manager->base_map->width; x++) {
-        civ_map_tile_t *tile = civ_map_get_tile(manager->base_map, x, y);
-        if (tile) {
-          view->data[y * view->width + x] = tile->elevation;
-        }
-      }
+    /* Use elevation, from its plane when there is one */
+    if (map->planes) {
+      view->base = (const uint8_t *)map->planes->elevation;
+      view->stride = sizeof(float);
+      view->source = CIV_MAP_VIEW_SOURCE_FLOAT;
+    } else {
+      bind_tiles(view, map, offsetof(civ_map_tile_t, elevation),
+                 CIV_MAP_VIEW_SOURCE_UNORM16);
     }
     break;
 
   case CIV_MAP_VIEW_POLITICAL:
     /* Use border/territory data */
-    for (int32_t y = 0; y < manager->base_map->height; y++) {
-      for (int32_t x = 0; x < manager->base_map->width; x++) {
-        civ_map_tile_t *tile = civ_map_get_tile(manager->base_map, x, y);
-        if (tile) {
-          view->data[y * view->width + x] = tile->political_influence;
-        }
-      }
-    }
+    bind_tiles(view, map, offsetof(civ_map_tile_t, political_influence),
+               CIV_MAP_VIEW_SOURCE_UNORM8);
     break;
 
   case CIV_MAP_VIEW_DEMOGRAPHICAL:
     /* Use population density data */
-    for (int32_t y = 0; y < manager->base_map->height; y++) {
-      for (int32_t x = 0; x < manager->base_map->width; x++) {
-        civ_map_tile_t *tile = civ_map_get_tile(manager->base_map, x, y);
-        if (tile) {
-          view->data[y * view->width + x] = tile->population_density;
-        }
-      }
-    }
+    bind_tiles(view, map, offsetof(civ_map_tile_t, population_density),
+               CIV_MAP_VIEW_SOURCE_UNORM8);
     break;
 
   case CIV_MAP_VIEW_CULTURAL:
     /* Use cultural influence data */
-    for (int32_t y = 0; y < manager->base_map->height; y++) {
-      for (int32_t x = 0; x < manager->base_map->width; x++) {
-        civ_map_tile_t *tile = civ_map_get_tile(manager->base_map, x, y);
-        if (tile) {
-          view->data[y * view->width + x] = tile->cultural_influence;
-        }
-      }
-    }
+    bind_tiles(view, map, offsetof(civ_map_tile_t, cultural_influence),
+               CIV_MAP_VIEW_SOURCE_FLOAT);
     break;
 
   case CIV_MAP_VIEW_ECONOMIC:
     /* Use resources */
-    for (int32_t y = 0; y < manager->base_map->height; y++) {
-      for (int32_t x = 0; x < manager->base_map->width; x++) {
-        civ_map_tile_t *tile = civ_map_get_tile(manager->base_map, x, y);
-        if (tile) {
-          view->data[y * view->width + x] = tile->resources;
-        }
-      }
-    }
+    bind_tiles(view, map, offsetof(civ_map_tile_t, resources),
+               CIV_MAP_VIEW_SOURCE_UNORM8);
     break;
 
   default:
-    /* Placeholder for other views */
-    for (int32_t y = 0; y < manager->base_map->height; y++) {
-      for (int32_t x = 0; x < manager->base_map->width; x++) {
-        view->data[y * view->width + x] = 0.0f;
-      }
-    }
+    /* Placeholder for other views: they read 0 */
     break;
   }
 
@@ -184,12 +164,28 @@ civ_float_t civ_map_view_get_tile_value(const civ_map_view_manager_t *manager,
                                         int32_t x, int32_t y) {
   if (!manager || view_type >= CIV_MAP_VIEW_COUNT)
     return 0.0f;
-  if (x < 0 || y < 0 || x >= manager->views[view_type].width ||
-      y >= manager->views[view_type].height)
+  const civ_map_view_t *view = &manager->views[view_type];
+  if (x < 0 || y < 0 || x >= view->width || y >= view->height)
     return 0.0f;
 
-  return manager->views[view_type]
-      .data[y * manager->views[view_type].width + x];
+  const uint8_t *p =
+      view->base + ((size_t)y * (size_t)view->width + (size_t)x) * view->stride;
+  switch (view->source) {
+  case CIV_MAP_VIEW_SOURCE_FLOAT: {
+    float v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+  }
+  case CIV_MAP_VIEW_SOURCE_UNORM8:
+    return civ_unorm8_decode(*p);
+  case CIV_MAP_VIEW_SOURCE_UNORM16: {
+    uint16_t v;
+    memcpy(&v, p, sizeof(v));
+    return civ_unorm16_decode(v);
+  }
+  default:
+    return 0.0f;
+  }
 }
 
 civ_result_t civ_map_view_manager_refresh_all(civ_map_view_manager_t *manager) {
@@ -207,43 +203,16 @@ civ_result_t civ_map_view_manager_refresh_all(civ_map_view_manager_t *manager) {
   return result;
 }
 
-// Function to smoothly transition between map views
+// Switch views; the blend itself is drawn by civ_map_transition_render,
+// since views read the map in place and have nothing to blend into
 void civ_map_view_manager_transition_view(civ_map_view_manager_t *manager,
                                           civ_map_view_type_t new_view,
                                           float transition_speed) {
+  (void)transition_speed;
   if (!manager || new_view >= CIV_MAP_VIEW_COUNT)
     return;
 
-  civ_map_view_t *current_view = &manager->views[manager->current_view];
-  civ_map_view_t *target_view = &manager->views[new_view];
-
-  // Start transition
-  float opacity = 0.0f;
-  while (opacity < 1.0f) {
-    opacity += transition_speed;
-    if (opacity > 1.0f)
-      opacity = 1.0f;
-
-    // Blend the two views based on opacity
-    for (int32_t y = 0; y < manager->base_map->height; y++) {
-      for (int32_t x = 0; x < manager->base_map->width; x++) {
-        float current_value = current_view->data[y * current_view->width + x];
-        float target_value = target_view->data[y * target_view->width + x];
-        float blended_value =
-            current_value * (1.0f - opacity) + target_value * opacity;
-
-        // Update the current view data with the blended value
-        current_view->data[y * current_view->width + x] = blended_value;
-      }
-    }
-
-    // Render the blended view (placeholder for actual rendering logic)
-    // civ_map_view_render(manager);
-  }
-
-  // Finalize transition
-  manager->current_view = new_view;
-  target_view->visible = true;
+  civ_map_view_manager_set_view(manager, new_view);
 }
 
 // Map interaction state
@@ -0,0 +1,155 @@
+/**
+ * @file modifier_stack.c
+ * @brief Per-owner multiplier stacks keyed by the inputs they came from
+ */
+#include "core/world/modifier_stack.h"
+#include "common.h"
+#include "core/knowledge_system.h"
+#include <math.h>
+#include <string.h>
+
+static const civ_modifier_stack_t k_identity = {1.0f, 1.0f, 1.0f,
+                                                1.0f, 1.0f, 1.0f};
+
+static bool reserve_owners(civ_modifier_table_t *t, uint32_t want) {
+  if (want <= t->capacity) return true;
+  uint32_t cap = t->capacity ? t->capacity : 64;
+  while (cap < want) cap *= 2;
+
+  civ_modifier_stack_t *stacks = CIV_REALLOC(t->stacks, cap * sizeof(*stacks));
+  if (!stacks) return false;
+  t->stacks = stacks;
+  civ_modifier_key_t *keys = CIV_REALLOC(t->keys, cap * sizeof(*keys));
+  if (!keys) return false;
+  t->keys = keys;
+  civ_modifier_source_t *sources = CIV_REALLOC(t->sources, cap * sizeof(*sources));
+  if (!sources) return false;
+  t->sources = sources;
+
+  for (uint32_t o = t->capacity; o < cap; o++) {
+    stacks[o] = k_identity;
+    memset(&keys[o], 0, sizeof(keys[o]));
+    memset(&sources[o], 0, sizeof(sources[o]));
+  }
+  t->capacity = cap;
+  return true;
+}
+
+static civ_modifier_key_t key_of(const civ_modifier_table_t *t,
+                                 const civ_modifier_source_t *src) {
+  civ_modifier_key_t k = {0};
+  k.wonders = t->wonders ? t->wonders->revision : 0;
+  k.policy = src->policy ? src->policy->revision : 0;
+  k.tech_tier = src->tech_index ? *src->tech_index / CIV_MODIFIER_TECH_STEP : -1;
+  const civ_institution_manager_t *im =
+      src->government ? src->government->institution_manager : NULL;
+  if (im) {
+    for (int b = 0; b < CIV_INSTITUTION_FOCUS_COUNT; b++)
+      k.institutions[b] = (int32_t)lrintf((float)im->focus_bonus[b] * CIV_MODIFIER_QUANTUM);
+  }
+  k.built = true;
+  return k;
+}
+
+static bool key_equal(const civ_modifier_key_t *x, const civ_modifier_key_t *y) {
+  if (!x->built || !y->built || x->wonders != y->wonders ||
+      x->policy != y->policy || x->tech_tier != y->tech_tier)
+    return false;
+  for (int b = 0; b < CIV_INSTITUTION_FOCUS_COUNT; b++)
+    if (x->institutions[b] != y->institutions[b]) return false;
+  return true;
+}
+
+/* Everything the stack holds comes from the key (the quantized values),
+   so equal keys always give equal stacks */
+static civ_modifier_stack_t build_stack(const civ_modifier_table_t *t,
+                                        civ_owner_index_t owner,
+                                        const civ_modifier_source_t *src,
+                                        const civ_modifier_key_t *k) {
+  civ_wonder_effects_t w = civ_wonder_owner_bonuses(t->wonders, owner);
+  float inst[CIV_INSTITUTION_FOCUS_COUNT];
+  for (int b = 0; b < CIV_INSTITUTION_FOCUS_COUNT; b++)
+    inst[b] = (float)k->institutions[b] / CIV_MODIFIER_QUANTUM;
+  float tech = k->tech_tier > 0
+                   ? (float)civ_knowledge_multiplier(
+                         (double)k->tech_tier * CIV_MODIFIER_TECH_STEP,
+                         CIV_MODIFIER_TECH_SCALE)
+                   : 1.0f;
+  float stance = src->policy ? (float)civ_economic_policy_stance_modifier(src->policy)
+                             : 1.0f;
+
+  /* focus_bonus[b] belongs to focus 1 << b */
+  float research = inst[0], production = inst[1], commerce = inst[2];
+  float military = inst[4], identity = inst[5];
+  civ_modifier_stack_t s;
+  s.production = (1.0f + (float)w.production_mult + production) * tech;
+  s.science = 1.0f + (float)w.science_mult + research;
+  s.culture = 1.0f + (float)w.culture_mult + identity;
+  s.gold = 1.0f + (float)w.gold_mult + commerce;
+  s.economy = (1.0f + commerce) * stance;
+  s.military = 1.0f + (float)w.military_str_bonus + military;
+  return s;
+}
+
+/* ── Public ─────────────────────────────────────────────────────────── */
+
+civ_modifier_table_t *civ_modifier_table_create(const civ_wonder_manager_t *wonders) {
+  civ_modifier_table_t *t = CIV_CALLOC(1, sizeof(civ_modifier_table_t));
+  if (!t) return NULL;
+  t->wonders = wonders;
+  return t;
+}
+
+void civ_modifier_table_destroy(civ_modifier_table_t *table) {
+  if (!table) return;
+  CIV_FREE(table->stacks);
+  CIV_FREE(table->keys);
+  CIV_FREE(table->sources);
+  CIV_FREE(table);
+}
+
+bool civ_modifier_table_bind(civ_modifier_table_t *table,
+                             civ_owner_index_t owner,
+                             const civ_modifier_source_t *source) {
+  if (!table || owner == CIV_OWNER_NONE || !source) return false;
+  if (!reserve_owners(table, (uint32_t)owner + 1)) return false;
+  civ_modifier_source_t *cur = &table->sources[owner];
+  if (cur->government != source->government ||
+      cur->tech_index != source->tech_index || cur->policy != source->policy) {
+    *cur = *source;
+    table->keys[owner].built = false;
+  }
+  return true;
+}
+
+size_t civ_modifier_table_refresh(civ_modifier_table_t *table) {
+  if (!table) return 0;
+
+  /* Wonder builders get a stack whether bound or not */
+  if (table->wonders) {
+    uint32_t top = 0;
+    for (int i = 0; i < CIV_WONDER_COUNT; i++)
+      if (table->wonders->wonders[i].is_built)
+        top = MAX(top, (uint32_t)table->wonders->wonders[i].builder_owner);
+    if (top > 0) reserve_owners(table, top + 1);
+  }
+
+  size_t rebuilt = 0;
+  for (uint32_t o = 1; o < table->capacity; o++) {
+    const civ_modifier_source_t *src = &table->sources[o];
+    civ_modifier_key_t k = key_of(table, src);
+    if (key_equal(&k, &table->keys[o])) continue;
+    table->stacks[o] = build_stack(table, (civ_owner_index_t)o, src, &k);
+    table->keys[o] = k;
+    rebuilt++;
+  }
+  table->rebuilds += rebuilt;
+  return rebuilt;
+}
+
+const civ_modifier_stack_t *civ_modifier_stack_of(const civ_modifier_table_t *table,
+                                                  civ_owner_index_t owner) {
+  if (!table || owner == CIV_OWNER_NONE || owner >= table->capacity)
+    return &k_identity;
+  return &table->stacks[owner];
+}
@@ -5,10 +5,16 @@
 
 #include "core/world/nation.h"
 #include "core/constitution.h"
+#include "core/economy/econ_reduce.h"
+#include "core/economy/economy_batch.h"
+#include "core/economy/economy_forecast.h"
+#include "core/simulation_engine/worker_pool.h"
+#include "core/world/modifier_stack.h"
 #include "core/world/nations_data.h"
 #include "core/world/political_borders.h"
 #include "core/world/resource_map.h"
 #include "common.h"
+#include "utils/rng.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
@@ -21,11 +27,20 @@ static bool point_in_region(float lon, float lat, civ_nation_region_t *r) {
 
 /* ── Manager lifecycle ──────────────────────────────────────────────── */
 civ_nation_manager_t *civ_nation_manager_create(void) {
+  return civ_nation_manager_create_sized(CIV_NATION_CAPACITY_MAX);
+}
+
+civ_nation_manager_t *civ_nation_manager_create_sized(int capacity) {
+  if (capacity <= 0) return NULL;
   civ_nation_manager_t *mgr = calloc(1, sizeof(*mgr));
   if (!mgr) return NULL;
-  mgr->capacity = CIV_NATION_CAPACITY_MAX;
+  mgr->capacity = capacity;
   mgr->nations = calloc((size_t)mgr->capacity, sizeof(civ_nation_t));
   if (!mgr->nations) { free(mgr); return NULL; }
+  /* Without an arena each government falls back to its own */
+  mgr->government_arena = civ_government_arena_create((size_t)mgr->capacity);
+  mgr->focus_nation_index = -1;
+  mgr->lod_distance_scale = 1.0f;
   return mgr;
 }
 
@@ -34,14 +49,50 @@ void civ_nation_manager_destroy(civ_nation_manager_t *mgr) {
   for (int i = 0; i < mgr->count; i++) {
     if (mgr->nations[i].government)
       civ_government_destroy(mgr->nations[i].government);
+    free(mgr->nations[i].tiles);
   }
+  free(mgr->tile_slot);
+  civ_government_arena_destroy(mgr->government_arena);
+  civ_subdivision_plane_destroy(mgr->subdivision_plane);
   free(mgr->nations);
+  free(mgr->owner_nation);
+  civ_economy_batch_destroy(mgr->economy_batch);
+  civ_nation_discard_fiscal_speculation(mgr);
+  free(mgr->fiscal_speculation);
   free(mgr);
 }
 
+/* ── Owner indices ─────────────────────────────────────────────────── */
+civ_owner_index_t civ_nation_owner_index(civ_nation_t *n) {
+  if (!n) return CIV_OWNER_NONE;
+  if (n->owner_index == CIV_OWNER_NONE)
+    n->owner_index = civ_owner_intern(n->id);
+  return n->owner_index;
+}
+
+void civ_nation_manager_index_owners(civ_nation_manager_t *mgr) {
+  if (!mgr) return;
+  for (int i = 0; i < mgr->count; i++) {
+    mgr->nations[i].owner_index = CIV_OWNER_NONE;
+    civ_nation_owner_index(&mgr->nations[i]);
+  }
+  uint32_t size = civ_owner_count();
+  if (size > mgr->owner_nation_size) {
+    int *grown = realloc(mgr->owner_nation, size * sizeof(int));
+    if (!grown) return;
+    mgr->owner_nation = grown;
+    mgr->owner_nation_size = size;
+  }
+  for (uint32_t o = 0; o < mgr->owner_nation_size; o++)
+    mgr->owner_nation[o] = -1;
+  for (int i = 0; i < mgr->count; i++)
+    mgr->owner_nation[mgr->nations[i].owner_index] = i;
+  mgr->territory_valid = false;
+}
+
 /* ── Minimal default government for data-driven nations ────────────── */
-static void setup_default_government(civ_nation_t *n) {
-  n->government = civ_government_create(n->name);
+static void setup_default_government(civ_nation_manager_t *mgr, civ_nation_t *n) {
+  n->government = civ_government_create_in(mgr->government_arena, n->name);
   n->constitution = civ_national_constitution_create(n->id);
   civ_government_add_position(n->government, "Head of State", 0,
       0.35f, 0.25f, 0.10f, "varies", "varies", 1);
@@ -56,6 +107,21 @@ static void setup_default_government(civ_nation_t *n) {
   civ_government_recompute_profile(n->government);
 }
 
+civ_nation_t *civ_nation_manager_add(civ_nation_manager_t *mgr,
+                                     const char *id, const char *name,
+                                     uint32_t color) {
+  if (!mgr || !id || !id[0] || mgr->count >= mgr->capacity) return NULL;
+  civ_nation_t *n = &mgr->nations[mgr->count++];
+  memset(n, 0, sizeof(*n));
+  snprintf(n->id, CIV_NATION_ID_MAX, "%s", id);
+  snprintf(n->name, CIV_NATION_NAME_MAX, "%s", name ? name : id);
+  n->color = color;
+  n->color_accent = color;
+  n->cost_of_living = 1.0f;
+  setup_default_government(mgr, n);
+  return n;
+}
+
 /* ── Data-driven initialization ────────────────────────────────────── */
 void civ_nation_manager_init_from_data(civ_nation_manager_t *mgr,
                                         const void *nd_void,
@@ -97,7 +163,7 @@ void civ_nation_manager_init_from_data(civ_nation_manager_t *mgr,
         n->population = (int64_t)data->population_est;
         n->gdp_per_capita = data->gdp_est_millions > 0
             ? (float)data->gdp_est_millions * 1000000.0f / (float)(data->population_est > 0 ? data->population_est : 1)
-            : (float)(500 + (rand() % 9500));
+            : (float)(500 + (civ_rand() % 9500));
 
         /* Starting indices derived from GDP and population */
         n->tech_index = (int32_t)(100 + (data->gdp_est_millions % 500));
@@ -107,23 +173,24 @@ void civ_nation_manager_init_from_data(civ_nation_manager_t *mgr,
       } else {
         /* Fallback for countries not in nations_data */
         n->data_id = (uint32_t)cid;
-        n->population = 5000000 + (rand() % 5000000);
-        n->gdp_per_capita = 500.0f + (float)(rand() % 9500);
+        n->population = 5000000 + (civ_rand() % 5000000);
+        n->gdp_per_capita = 500.0f + (float)(civ_rand() % 9500);
         n->tech_index = 150;
         n->economic_index = 120;
         n->military_index = 100;
         n->cultural_index = 100;
       }
 
-      n->cost_of_living = 0.7f + ((float)(rand() % 100) / 200.0f);
+      n->cost_of_living = 0.7f + ((float)(civ_rand() % 100) / 200.0f);
       n->region_count = 0;
       n->subdivision_count = 0;
 
-      setup_default_government(n);
+      setup_default_government(mgr, n);
       created++;
     }
     mgr->count = created;
     mgr->player_nation_index = 0;
+    civ_nation_manager_index_owners(mgr);
     printf("[NATION] Created %d nations from borders data\n", mgr->count);
   } else {
     /* Fall back to hardcoded 8 nations for procedural maps */
@@ -133,7 +200,7 @@ void civ_nation_manager_init_from_data(civ_nation_manager_t *mgr,
 
 /* ── Hardcoded fallback (procedural maps without borders data) ─────── */
 
-static void init_imperial(civ_nation_t *n) {
+static void init_imperial(civ_nation_manager_t *mgr, civ_nation_t *n) {
   strcpy(n->id, "imperial_dominion");
   strcpy(n->name, "Imperial Dominion");
   n->color = 0xCC2200; n->color_accent = 0xFF6644;
@@ -144,8 +211,8 @@ static void init_imperial(civ_nation_t *n) {
   n->region_count = 2;
   n->capital_lon = 12; n->capital_lat = 52;
   n->population = 45000000;
-  n->cost_of_living = 0.7f + ((float)(rand()%100)/200.0f);
-  n->gdp_per_capita = 500.0f + (float)(rand()%9500);
+  n->cost_of_living = 0.7f + ((float)(civ_rand()%100)/200.0f);
+  n->gdp_per_capita = 500.0f + (float)(civ_rand()%9500);
   strcpy(n->subdivisions[0].name, "Northern Province");
   strcpy(n->subdivisions[0].id, "north");
   n->subdivisions[0].region = (civ_nation_region_t){-10, 40, 55, 72};
@@ -153,7 +220,7 @@ static void init_imperial(civ_nation_t *n) {
   strcpy(n->subdivisions[1].id, "south");
   n->subdivisions[1].region = (civ_nation_region_t){-10, 40, 25, 55};
   n->subdivision_count = 2;
-  n->government = civ_government_create(n->name);
+  n->government = civ_government_create_in(mgr->government_arena, n->name);
   n->constitution = civ_national_constitution_create(n->id);
   civ_government_add_position(n->government, "Supreme Chancellor", 0, 0.80f, 0.10f, 0.10f, "appointed", "life", 1);
   civ_government_add_position(n->government, "Council of Ministers", 1, 0.15f, 0.60f, 0.05f, "appointed_by_above", "indefinite", 15);
@@ -163,7 +230,7 @@ static void init_imperial(civ_nation_t *n) {
   civ_government_recompute_profile(n->government);
 }
 
-static void init_mercantile(civ_nation_t *n) {
+static void init_mercantile(civ_nation_manager_t *mgr, civ_nation_t *n) {
   strcpy(n->id, "mercantile_league");
   strcpy(n->name, "Mercantile League");
   n->color = 0xDAA520; n->color_accent = 0xFFD700;
@@ -174,8 +241,8 @@ static void init_mercantile(civ_nation_t *n) {
   n->region_count = 2;
   n->capital_lon = 29; n->capital_lat = 41;
   n->population = 32000000;
-  n->cost_of_living = 0.7f + ((float)(rand()%100)/200.0f);
-  n->gdp_per_capita = 500.0f + (float)(rand()%9500);
+  n->cost_of_living = 0.7f + ((float)(civ_rand()%100)/200.0f);
+  n->gdp_per_capita = 500.0f + (float)(civ_rand()%9500);
   strcpy(n->subdivisions[0].name, "Western Trade Ports");
   strcpy(n->subdivisions[0].id, "west");
   n->subdivisions[0].region = (civ_nation_region_t){-10, 20, 30, 48};
@@ -183,7 +250,7 @@ static void init_mercantile(civ_nation_t *n) {
   strcpy(n->subdivisions[1].id, "east");
   n->subdivisions[1].region = (civ_nation_region_t){25, 55, 20, 42};
   n->subdivision_count = 2;
-  n->government = civ_government_create(n->name);
+  n->government = civ_government_create_in(mgr->government_arena, n->name);
   n->constitution = civ_national_constitution_create(n->id);
   civ_government_add_position(n->government, "Trade Council Head", 0, 0.40f, 0.30f, 0.10f, "elected", "4_years", 1);
   civ_government_add_position(n->government, "Guild Assembly", 1, 0.15f, 0.60f, 0.05f, "elected", "3_years", 50);
@@ -191,7 +258,7 @@ static void init_mercantile(civ_nation_t *n) {
   civ_government_recompute_profile(n->government);
 }
 
-static void init_theocratic(civ_nation_t *n) {
+static void init_theocratic(civ_nation_manager_t *mgr, civ_nation_t *n) {
   strcpy(n->id, "theocratic_order");
   strcpy(n->name, "Theocratic Order");
   n->color = 0x8B00CC; n->color_accent = 0xCC66FF;
@@ -202,8 +269,8 @@ static void init_theocratic(civ_nation_t *n) {
   n->region_count = 2;
   n->capital_lon = 51; n->capital_lat = 35;
   n->population = 28000000;
-  n->cost_of_living = 0.7f + ((float)(rand()%100)/200.0f);
-  n->gdp_per_capita = 500.0f + (float)(rand()%9500);
+  n->cost_of_living = 0.7f + ((float)(civ_rand()%100)/200.0f);
+  n->gdp_per_capita = 500.0f + (float)(civ_rand()%9500);
   strcpy(n->subdivisions[0].name, "Holy District");
   strcpy(n->subdivisions[0].id, "holy");
   n->subdivisions[0].region = (civ_nation_region_t){40, 55, 30, 45};
@@ -211,7 +278,7 @@ static void init_theocratic(civ_nation_t *n) {
   strcpy(n->subdivisions[1].id, "east");
   n->subdivisions[1].region = (civ_nation_region_t){55, 75, 25, 50};
   n->subdivision_count = 2;
-  n->government = civ_government_create(n->name);
+  n->government = civ_government_create_in(mgr->government_arena, n->name);
   n->constitution = civ_national_constitution_create(n->id);
   civ_government_add_position(n->government, "High Oracle", 0, 0.60f, 0.20f, 0.10f, "hereditary", "life", 1);
   civ_government_add_position(n->government, "Council of Elders", 1, 0.15f, 0.40f, 0.15f, "appointed", "life", 12);
@@ -220,7 +287,7 @@ static void init_theocratic(civ_nation_t *n) {
   civ_government_recompute_profile(n->government);
 }
 
-static void init_democratic(civ_nation_t *n) {
+static void init_democratic(civ_nation_manager_t *mgr, civ_nation_t *n) {
   strcpy(n->id, "democratic_federation");
   strcpy(n->name, "Democratic Federation");
   n->color = 0x2288FF; n->color_accent = 0x66BBFF;
@@ -231,8 +298,8 @@ static void init_democratic(civ_nation_t *n) {
   n->region_count = 2;
   n->capital_lon = -77; n->capital_lat = 39;
   n->population = 52000000;
-  n->cost_of_living = 0.7f + ((float)(rand()%100)/200.0f);
-  n->gdp_per_capita = 500.0f + (float)(rand()%9500);
+  n->cost_of_living = 0.7f + ((float)(civ_rand()%100)/200.0f);
+  n->gdp_per_capita = 500.0f + (float)(civ_rand()%9500);
   strcpy(n->subdivisions[0].name, "Eastern States");
   strcpy(n->subdivisions[0].id, "east");
   n->subdivisions[0].region = (civ_nation_region_t){-90, -65, 25, 50};
@@ -243,7 +310,7 @@ static void init_democratic(civ_nation_t *n) {
   strcpy(n->subdivisions[2].id, "north");
   n->subdivisions[2].region = (civ_nation_region_t){-135, -100, 50, 72};
   n->subdivision_count = 3;
-  n->government = civ_government_create(n->name);
+  n->government = civ_government_create_in(mgr->government_arena, n->name);
   n->constitution = civ_national_constitution_create(n->id);
   civ_government_add_position(n->government, "President", 0, 0.30f, 0.10f, 0.05f, "elected", "5_years", 1);
   civ_government_add_position(n->government, "Congress", 1, 0.10f, 0.65f, 0.05f, "elected", "3_years", 200);
@@ -252,7 +319,7 @@ static void init_democratic(civ_nation_t *n) {
   civ_government_recompute_profile(n->government);
 }
 
-static void init_technocratic(civ_nation_t *n) {
+static void init_technocratic(civ_nation_manager_t *mgr, civ_nation_t *n) {
   strcpy(n->id, "technocratic_union");
   strcpy(n->name, "Technocratic Union");
   n->color = 0x00AACC; n->color_accent = 0x44EEFF;
@@ -263,8 +330,8 @@ static void init_technocratic(civ_nation_t *n) {
   n->region_count = 2;
   n->capital_lon = 139; n->capital_lat = 36;
   n->population = 38000000;
-  n->cost_of_living = 0.7f + ((float)(rand()%100)/200.0f);
-  n->gdp_per_capita = 500.0f + (float)(rand()%9500);
+  n->cost_of_living = 0.7f + ((float)(civ_rand()%100)/200.0f);
+  n->gdp_per_capita = 500.0f + (float)(civ_rand()%9500);
   strcpy(n->subdivisions[0].name, "Research District");
   strcpy(n->subdivisions[0].id, "research");
   n->subdivisions[0].region = (civ_nation_region_t){135, 145, 34, 40};
@@ -272,7 +339,7 @@ static void init_technocratic(civ_nation_t *n) {
   strcpy(n->subdivisions[1].id, "industry");
   n->subdivisions[1].region = (civ_nation_region_t){125, 135, 30, 42};
   n->subdivision_count = 2;
-  n->government = civ_government_create(n->name);
+  n->government = civ_government_create_in(mgr->government_arena, n->name);
   n->constitution = civ_national_constitution_create(n->id);
   civ_government_add_position(n->government, "Chief Scientist", 0, 0.50f, 0.15f, 0.10f, "appointed", "8_years", 1);
   civ_government_add_position(n->government, "Academy Senate", 1, 0.15f, 0.45f, 0.15f, "elected", "5_years", 60);
@@ -280,7 +347,7 @@ static void init_technocratic(civ_nation_t *n) {
   civ_government_recompute_profile(n->government);
 }
 
-static void init_martial(civ_nation_t *n) {
+static void init_martial(civ_nation_manager_t *mgr, civ_nation_t *n) {
   strcpy(n->id, "martial_horde");
   strcpy(n->name, "Martial Horde");
   n->color = 0xCC0000; n->color_accent = 0xFF3333;
@@ -291,8 +358,8 @@ static void init_martial(civ_nation_t *n) {
   n->region_count = 2;
   n->capital_lon = 76; n->capital_lat = 43;
   n->population = 18000000;
-  n->cost_of_living = 0.7f + ((float)(rand()%100)/200.0f);
-  n->gdp_per_capita = 500.0f + (float)(rand()%9500);
+  n->cost_of_living = 0.7f + ((float)(civ_rand()%100)/200.0f);
+  n->gdp_per_capita = 500.0f + (float)(civ_rand()%9500);
   strcpy(n->subdivisions[0].name, "Western Horde");
   strcpy(n->subdivisions[0].id, "west");
   n->subdivisions[0].region = (civ_nation_region_t){60, 80, 35, 55};
@@ -300,14 +367,14 @@ static void init_martial(civ_nation_t *n) {
   strcpy(n->subdivisions[1].id, "east");
   n->subdivisions[1].region = (civ_nation_region_t){80, 100, 35, 55};
   n->subdivision_count = 2;
-  n->government = civ_government_create(n->name);
+  n->government = civ_government_create_in(mgr->government_arena, n->name);
   n->constitution = civ_national_constitution_create(n->id);
   civ_government_add_position(n->government, "Supreme Commander", 0, 0.85f, 0.05f, 0.05f, "military_coup", "life", 1);
   civ_government_add_position(n->government, "War Council", 1, 0.10f, 0.15f, 0.05f, "appointed_by_above", "indefinite", 8);
   civ_government_recompute_profile(n->government);
 }
 
-static void init_agricultural(civ_nation_t *n) {
+static void init_agricultural(civ_nation_manager_t *mgr, civ_nation_t *n) {
   strcpy(n->id, "agricultural_collective");
   strcpy(n->name, "Agricultural Collective");
   n->color = 0x228800; n->color_accent = 0x44DD44;
@@ -318,8 +385,8 @@ static void init_agricultural(civ_nation_t *n) {
   n->region_count = 2;
   n->capital_lon = 77; n->capital_lat = 23;
   n->population = 65000000;
-  n->cost_of_living = 0.7f + ((float)(rand()%100)/200.0f);
-  n->gdp_per_capita = 500.0f + (float)(rand()%9500);
+  n->cost_of_living = 0.7f + ((float)(civ_rand()%100)/200.0f);
+  n->gdp_per_capita = 500.0f + (float)(civ_rand()%9500);
   strcpy(n->subdivisions[0].name, "Northern Plains");
   strcpy(n->subdivisions[0].id, "north");
   n->subdivisions[0].region = (civ_nation_region_t){68, 100, 20, 35};
@@ -327,7 +394,7 @@ static void init_agricultural(civ_nation_t *n) {
   strcpy(n->subdivisions[1].id, "south");
   n->subdivisions[1].region = (civ_nation_region_t){68, 100, 5, 20};
   n->subdivision_count = 2;
-  n->government = civ_government_create(n->name);
+  n->government = civ_government_create_in(mgr->government_arena, n->name);
   n->constitution = civ_national_constitution_create(n->id);
   civ_government_add_position(n->government, "First Farmer", 0, 0.40f, 0.30f, 0.10f, "elected", "4_years", 1);
   civ_government_add_position(n->government, "Land Council", 1, 0.15f, 0.50f, 0.10f, "elected", "3_years", 100);
@@ -335,7 +402,7 @@ static void init_agricultural(civ_nation_t *n) {
   civ_government_recompute_profile(n->government);
 }
 
-static void init_stewards(civ_nation_t *n) {
+static void init_stewards(civ_nation_manager_t *mgr, civ_nation_t *n) {
   strcpy(n->id, "stewards_wild");
   strcpy(n->name, "Stewards of the Wild");
   n->color = 0x228844; n->color_accent = 0x66CC88;
@@ -346,8 +413,8 @@ static void init_stewards(civ_nation_t *n) {
   n->region_count = 2;
   n->capital_lon = -47; n->capital_lat = -16;
   n->population = 22000000;
-  n->cost_of_living = 0.7f + ((float)(rand()%100)/200.0f);
-  n->gdp_per_capita = 500.0f + (float)(rand()%9500);
+  n->cost_of_living = 0.7f + ((float)(civ_rand()%100)/200.0f);
+  n->gdp_per_capita = 500.0f + (float)(civ_rand()%9500);
   strcpy(n->subdivisions[0].name, "Amazon Basin");
   strcpy(n->subdivisions[0].id, "amazon");
   n->subdivisions[0].region = (civ_nation_region_t){-75, -45, -20, 5};
@@ -355,7 +422,7 @@ static void init_stewards(civ_nation_t *n) {
   strcpy(n->subdivisions[1].id, "highlands");
   n->subdivisions[1].region = (civ_nation_region_t){-75, -35, -40, -20};
   n->subdivision_count = 2;
-  n->government = civ_government_create(n->name);
+  n->government = civ_government_create_in(mgr->government_arena, n->name);
   n->constitution = civ_national_constitution_create(n->id);
   civ_government_add_position(n->government, "Elder Speaker", 0, 0.25f, 0.40f, 0.15f, "elected", "3_years", 1);
   civ_government_add_position(n->government, "Circle of Wisdom", 1, 0.10f, 0.50f, 0.20f, "lottery", "2_years", 30);
@@ -365,7 +432,7 @@ static void init_stewards(civ_nation_t *n) {
 
 void civ_nation_manager_init_default(civ_nation_manager_t *mgr) {
   if (!mgr) return;
-  typedef void (*init_fn)(civ_nation_t *);
+  typedef void (*init_fn)(civ_nation_manager_t *, civ_nation_t *);
   init_fn inits[] = {
       init_imperial, init_mercantile, init_theocratic,
       init_democratic, init_technocratic, init_martial,
@@ -375,14 +442,16 @@ void civ_nation_manager_init_default(civ_nation_manager_t *mgr) {
   if (n > mgr->capacity) n = mgr->capacity;
   mgr->count = n;
   for (int i = 0; i < n; i++) {
-    inits[i](&mgr->nations[i]);
+    inits[i](mgr, &mgr->nations[i]);
   }
   mgr->player_nation_index = 3;
+  civ_nation_manager_index_owners(mgr);
 }
 
 /* ── Territory claiming ─────────────────────────────────────────────── */
 void civ_nation_claim_territory(civ_nation_t *n, civ_map_t *map) {
   if (!n || !map) return;
+  civ_owner_index_t owner = civ_nation_owner_index(n);
   for (int32_t y = 0; y < map->height; y++) {
     float lat = 90.0f - (float)y / (float)(map->height - 1) * 180.0f;
     for (int32_t x = 0; x < map->width; x++) {
@@ -391,10 +460,9 @@ void civ_nation_claim_territory(civ_nation_t *n, civ_map_t *map) {
         if (point_in_region(lon, lat, &n->regions[r])) {
           civ_map_tile_t *tile = civ_map_get_tile(map, x, y);
           if (tile && tile->land_use != CIV_LAND_USE_WATER) {
-            if (tile->owner_id[0] == '\0') {
-              strncpy(tile->owner_id, n->id, STRING_SHORT_LEN - 1);
-              tile->political_color = n->color;
-            }
+            if (tile->owner_index == CIV_OWNER_NONE)
+              civ_map_set_owner(map, (size_t)y * map->width + x, owner,
+                                n->color);
           }
           break;
         }
@@ -412,57 +480,227 @@ void civ_nation_claim_all_territories(civ_nation_manager_t *mgr, civ_map_t *map)
 void civ_nation_claim_from_borders(civ_nation_t *n, civ_map_t *map,
                                     int nation_idx, int map_w, int map_h) {
   if (!n || !map) return;
+  civ_owner_index_t owner = civ_nation_owner_index(n);
   for (int32_t y = 0; y < map_h; y++) {
     for (int32_t x = 0; x < map_w; x++) {
       int16_t cid = civ_political_borders_tile_country(x, y, map_w);
       if (cid == (int16_t)nation_idx) {
         civ_map_tile_t *tile = civ_map_get_tile(map, x, y);
-        if (tile && tile->land_use != CIV_LAND_USE_WATER) {
-          strncpy(tile->owner_id, n->id, STRING_SHORT_LEN - 1);
-          tile->political_color = n->color;
-        }
+        if (tile && tile->land_use != CIV_LAND_USE_WATER)
+          civ_map_set_owner(map, (size_t)y * map->width + x, owner, n->color);
       }
     }
   }
 }
 
-/* ── Resource accounting ───────────────────────────────────────────── */
-void civ_nation_calculate_resources(civ_nation_t *n, civ_map_t *map,
-                                     const void *rm_void,
-                                     civ_nation_resource_profile_t *out) {
-  if (!n || !map || !out) return;
-  memset(out, 0, sizeof(*out));
+/* ── Territory accumulation ────────────────────────────────────────── */
+typedef struct {
+  civ_nation_territory_t *acc;
+  int                     sign;
+} deposit_acc_ctx_t;
 
-  const civ_resource_map_t *rm = (const civ_resource_map_t *)rm_void;
+static void accumulate_deposit(void *ctx, civ_resource_type_t t,
+                               const civ_resource_deposit_t *d) {
+  deposit_acc_ctx_t *c = (deposit_acc_ctx_t *)ctx;
+  civ_nation_territory_t *acc = c->acc;
+  if (c->sign > 0) {
+    acc->quantities[t] += d->quantity;
+    if (d->quality > acc->best_quality[t]) acc->best_quality[t] = d->quality;
+  } else {
+    acc->quantities[t] -= MIN(acc->quantities[t], (uint32_t)d->quantity);
+    /* A max can't be un-added; rescan this nation on the next pass */
+    if (d->quality >= acc->best_quality[t] && d->quality > 0)
+      acc->quality_stale = true;
+  }
+}
 
-  for (int32_t y = 0; y < map->height; y++) {
-    for (int32_t x = 0; x < map->width; x++) {
-      civ_map_tile_t *tile = civ_map_get_tile(map, x, y);
-      if (!tile || tile->land_use == CIV_LAND_USE_WATER) continue;
-      if (strcmp(tile->owner_id, n->id) != 0) continue;
-
-      if (rm) {
-        for (int t = 0; t < 20; t++) {
-          if (civ_resource_map_has_type(rm, x, y, (civ_resource_type_t)t)) {
-            uint16_t qty = civ_resource_map_get_quantity(rm, x, y, (civ_resource_type_t)t);
-            uint8_t qual = civ_resource_map_get_quality(rm, x, y, (civ_resource_type_t)t);
-            out->quantities[t] = (uint16_t)(out->quantities[t] + qty > 65535
-                ? 65535 : out->quantities[t] + qty);
-            if (qual > out->best_quality[t]) out->best_quality[t] = qual;
-          }
-        }
-      }
-    }
+/* Add (sign = +1) or remove (sign = -1) tile i from a nation's sums */
+static void accumulate_tile(civ_nation_territory_t *acc, const civ_map_t *map,
+                            const civ_resource_map_t *rm, size_t i, int sign) {
+  if (civ_map_is_water_at(map, i)) {
+    acc->water_tiles += sign;
+    return;
+  }
+  int32_t x = (int32_t)(i % (size_t)map->width);
+  int32_t y = (int32_t)(i / (size_t)map->width);
+  float fertility = civ_map_fertility_at(map, i);
+  double km2 = civ_map_metric_area_km2(&map->metric, y);
+  acc->land_tiles += sign;
+  acc->total_elevation += sign * civ_map_elevation_at(map, i);
+  acc->total_fertility += sign * fertility;
+  acc->land_km2 += sign * km2;
+  acc->arable_km2 += sign * km2 * fertility;
+
+  if (!rm) return;
+  deposit_acc_ctx_t ctx = {acc, sign};
+  civ_resource_map_for_each_in_rect(rm, x, y, x, y, accumulate_deposit, &ctx);
+}
+
+static void scan_nation(civ_nation_territory_t *acc, const civ_map_t *map,
+                        const civ_resource_map_t *rm, civ_owner_index_t owner) {
+  memset(acc, 0, sizeof(*acc));
+  if (owner == CIV_OWNER_NONE) return;
+  size_t tile_count = (size_t)map->width * map->height;
+  for (size_t i = 0; i < tile_count; i++) {
+    if (civ_map_owner_at(map, i) == owner)
+      accumulate_tile(acc, map, rm, i, 1);
+  }
+}
+
+static int owner_to_nation(const civ_nation_manager_t *mgr,
+                           civ_owner_index_t owner) {
+  if (owner == CIV_OWNER_NONE || owner >= mgr->owner_nation_size) return -1;
+  int ni = mgr->owner_nation[owner];
+  return ni < mgr->count ? ni : -1;
+}
+
+/* Take deposits worked out since the last look off their owners' sums;
+   tile moving, whose owner the map already shows as its new one, still
+   counts as moving_from's */
+static void apply_depletions(civ_nation_manager_t *mgr, const civ_map_t *map,
+                             size_t moving, civ_owner_index_t moving_from) {
+  const civ_resource_map_t *rm = (const civ_resource_map_t *)mgr->territory_resources;
+  if (!rm || !mgr->territory_valid) return;
+  for (; mgr->territory_depletions < rm->depletion_count; mgr->territory_depletions++) {
+    const civ_resource_depletion_t *e = &rm->depletions[mgr->territory_depletions];
+    if (e->deposit.x >= map->width || e->deposit.y >= map->height) continue;
+    size_t tile = (size_t)e->deposit.y * map->width + e->deposit.x;
+    int ni = owner_to_nation(mgr, tile == moving ? moving_from
+                                                 : civ_map_owner_at(map, tile));
+    if (ni < 0 || civ_map_is_water_at(map, tile)) continue; /* never summed */
+    deposit_acc_ctx_t ctx = {&mgr->nations[ni].territory, -1};
+    accumulate_deposit(&ctx, e->type, &e->deposit);
+  }
+}
+
+/* Tile lists: swap-remove by the tile's slot, append on arrival */
+static void tile_leave(civ_nation_manager_t *mgr, int ni, size_t tile) {
+  civ_nation_t *n = &mgr->nations[ni];
+  uint32_t at = mgr->tile_slot[tile];
+  if ((int32_t)at >= n->tile_count || n->tiles[at] != (uint32_t)tile) return;
+  uint32_t last = n->tiles[--n->tile_count];
+  n->tiles[at] = last;
+  mgr->tile_slot[last] = at;
+}
+
+static bool tile_join(civ_nation_manager_t *mgr, int ni, size_t tile) {
+  civ_nation_t *n = &mgr->nations[ni];
+  if (n->tile_count >= n->tile_capacity) {
+    int32_t cap = n->tile_capacity ? n->tile_capacity * 2 : 256;
+    uint32_t *grown = realloc(n->tiles, (size_t)cap * sizeof(uint32_t));
+    if (!grown) return false;
+    n->tiles = grown;
+    n->tile_capacity = cap;
+  }
+  mgr->tile_slot[tile] = (uint32_t)n->tile_count;
+  n->tiles[n->tile_count++] = (uint32_t)tile;
+  return true;
+}
+
+/* Map owner listener: move one tile between two nations' aggregates */
+static void territory_listener(void *user_data, const civ_map_t *map,
+                               size_t index, civ_owner_index_t old_owner,
+                               civ_owner_index_t new_owner) {
+  civ_nation_manager_t *mgr = (civ_nation_manager_t *)user_data;
+  if (!mgr->territory_valid) return;
+  apply_depletions(mgr, map, index, old_owner); /* what it holds now leaves */
+  const civ_resource_map_t *rm = (const civ_resource_map_t *)mgr->territory_resources;
+  int from = owner_to_nation(mgr, old_owner);
+  int to = owner_to_nation(mgr, new_owner);
+  if (from == to) return;
+  if (from >= 0) {
+    accumulate_tile(&mgr->nations[from].territory, map, rm, index, -1);
+    tile_leave(mgr, from, index);
+  }
+  if (to >= 0) {
+    accumulate_tile(&mgr->nations[to].territory, map, rm, index, 1);
+    /* A list that cannot grow is rebuilt with the rest on the next pass */
+    if (!tile_join(mgr, to, index)) mgr->territory_valid = false;
   }
+}
 
-  /* Compute summary stats */
-  for (int t = 0; t < 20; t++) {
+/* Full rebuild: one map pass routing each owned tile to its nation */
+static void rebuild_territory(civ_nation_manager_t *mgr, civ_map_t *map,
+                              const civ_resource_map_t *rm) {
+  size_t tile_count = (size_t)map->width * map->height;
+  mgr->territory_valid = false;
+  if (mgr->tile_slot_size != tile_count) {
+    free(mgr->tile_slot);
+    mgr->tile_slot = malloc(tile_count * sizeof(uint32_t));
+    mgr->tile_slot_size = mgr->tile_slot ? tile_count : 0;
+    if (!mgr->tile_slot) return;
+  }
+  for (int i = 0; i < mgr->count; i++) {
+    memset(&mgr->nations[i].territory, 0, sizeof(civ_nation_territory_t));
+    mgr->nations[i].tile_count = 0;
+  }
+  for (size_t i = 0; i < tile_count; i++) {
+    int ni = owner_to_nation(mgr, civ_map_owner_at(map, i));
+    if (ni < 0) continue;
+    accumulate_tile(&mgr->nations[ni].territory, map, rm, i, 1);
+    if (!tile_join(mgr, ni, i)) return;
+  }
+  mgr->territory_resources = rm;
+  mgr->territory_depletions = rm ? rm->depletion_count : 0;
+  mgr->territory_resets = rm ? rm->depletion_resets : 0;
+  mgr->territory_valid = true;
+  if (!civ_map_add_owner_listener(map, territory_listener, mgr))
+    mgr->territory_valid = false;  /* untracked: rebuild on every pass */
+}
+
+static bool territory_current(const civ_nation_manager_t *mgr,
+                              const civ_map_t *map, const void *rm) {
+  return mgr->territory_valid && mgr->territory_resources == rm &&
+         (!rm || ((const civ_resource_map_t *)rm)->depletion_resets ==
+                     mgr->territory_resets) &&
+         civ_map_has_owner_listener(map, territory_listener, mgr);
+}
+
+/* Rebuild stale aggregates, then catch up on depleted deposits */
+static void update_territory(civ_nation_manager_t *mgr, civ_map_t *map,
+                             const void *rm) {
+  if (!territory_current(mgr, map, rm))
+    rebuild_territory(mgr, map, (const civ_resource_map_t *)rm);
+  apply_depletions(mgr, map, SIZE_MAX, CIV_OWNER_NONE);
+}
+
+void civ_nation_manager_track_territory(civ_nation_manager_t *mgr, civ_map_t *map,
+                                        const void *resource_map) {
+  if (!mgr || !map) return;
+  update_territory(mgr, map, resource_map);
+}
+
+const uint32_t *civ_nation_owned_tiles(const civ_nation_manager_t *mgr, int idx,
+                                       int32_t *count) {
+  if (count) *count = 0;
+  if (!mgr || !mgr->territory_valid || idx < 0 || idx >= mgr->count) return NULL;
+  if (count) *count = mgr->nations[idx].tile_count;
+  return mgr->nations[idx].tiles;
+}
+
+static void profile_from_acc(const civ_nation_territory_t *acc,
+                             civ_nation_resource_profile_t *out) {
+  memset(out, 0, sizeof(*out));
+  for (int t = 0; t < CIV_RESOURCE_COUNT; t++) {
+    out->quantities[t] = (uint16_t)MIN(acc->quantities[t], 65535u);
+    out->best_quality[t] = acc->best_quality[t];
     out->total_resources = (uint16_t)(out->total_resources + out->quantities[t] > 65535
         ? 65535 : out->total_resources + out->quantities[t]);
     if (out->quantities[t] > 0) out->distinct_types++;
   }
 }
 
+/* ── Resource accounting ───────────────────────────────────────────── */
+void civ_nation_calculate_resources(civ_nation_t *n, civ_map_t *map,
+                                     const void *rm_void,
+                                     civ_nation_resource_profile_t *out) {
+  if (!n || !map || !out) return;
+  civ_nation_territory_t acc;
+  scan_nation(&acc, map, (const civ_resource_map_t *)rm_void,
+              civ_nation_owner_index(n));
+  profile_from_acc(&acc, out);
+}
+
 /* ── Lookup ─────────────────────────────────────────────────────────── */
 civ_nation_t *civ_nation_get_by_id(civ_nation_manager_t *mgr, const char *id) {
   if (!mgr || !id) return NULL;
@@ -495,60 +733,39 @@ civ_nation_t *civ_nation_find_owner(civ_nation_manager_t *mgr, civ_map_t *map,
                                      int32_t tx, int32_t ty) {
   if (!mgr || !map) return NULL;
   civ_map_tile_t *tile = civ_map_get_tile(map, tx, ty);
-  if (!tile || tile->owner_id[0] == '\0') return NULL;
+  if (!tile || tile->owner_index == CIV_OWNER_NONE) return NULL;
+  if (tile->owner_index < mgr->owner_nation_size) {
+    int idx = mgr->owner_nation[tile->owner_index];
+    return idx >= 0 && idx < mgr->count ? &mgr->nations[idx] : NULL;
+  }
+  /* Owner interned after the last reindex */
   for (int i = 0; i < mgr->count; i++) {
-    if (strcmp(mgr->nations[i].id, tile->owner_id) == 0)
+    if (mgr->nations[i].owner_index == tile->owner_index)
       return &mgr->nations[i];
   }
   return NULL;
 }
 
 /* ── Per-nation economic computation ───────────────────────────────── */
-void civ_nation_compute_economy(civ_nation_t *n, civ_map_t *map,
-                                 const void *rm_void) {
-  if (!n || !map) return;
-  const civ_resource_map_t *rm = (const civ_resource_map_t *)rm_void;
-
+static void derive_economy(civ_nation_t *n, const civ_nation_territory_t *acc) {
   memset(&n->economy, 0, sizeof(n->economy));
+  profile_from_acc(acc, &n->resources);
+  const civ_nation_resource_profile_t *rp = &n->resources;
 
-  int land_tiles = 0, water_tiles = 0;
-  float total_elevation = 0.0f;
-  float total_fertility = 0.0f;
-
-  /* Count owned tiles and sum resource quantities */
-  civ_nation_resource_profile_t rp;
-  civ_nation_calculate_resources(n, map, rm, &rp);
-
-  for (int32_t y = 0; y < map->height; y++) {
-    for (int32_t x = 0; x < map->width; x++) {
-      civ_map_tile_t *t = civ_map_get_tile(map, x, y);
-      if (!t) continue;
-      if (strcmp(t->owner_id, n->id) != 0) continue;
-
-      if (t->land_use == CIV_LAND_USE_WATER) {
-        water_tiles++;
-      } else {
-        land_tiles++;
-        total_elevation += t->elevation;
-        total_fertility += t->fertility;
-      }
-    }
-  }
-
+  int land_tiles = acc->land_tiles;
   n->economy.owned_land_tiles = land_tiles;
-  n->economy.owned_water_tiles = water_tiles;
+  n->economy.owned_water_tiles = acc->water_tiles;
 
   if (land_tiles == 0) return;
 
-  float avg_elevation = total_elevation / (float)land_tiles;
-  float avg_fertility = total_fertility / (float)land_tiles;
+  float avg_fertility = acc->total_fertility / (float)land_tiles;
   int64_t pop = n->population > 0 ? n->population : 1000000;
   float tech_factor = 1.0f + (float)n->tech_index * 0.002f;
   float econ_factor = 1.0f + (float)n->economic_index * 0.002f;
 
   /* GDP: base from land + tech + resources */
   float gdp_base = (float)land_tiles * 0.5f * tech_factor * econ_factor;
-  float resource_bonus = (float)rp.total_resources * 0.01f;
+  float resource_bonus = (float)rp->total_resources * 0.01f;
   float gdp = gdp_base + resource_bonus;
   if (gdp < 1.0f) gdp = 1.0f;
 
@@ -565,14 +782,14 @@ void civ_nation_compute_economy(civ_nation_t *n, civ_map_t *map,
   n->economy.food_consumption = (float)pop * 2500.0f * 365.0f / 1000000.0f;
 
   /* Energy: from oil/gas/coal resources + tech */
-  float energy_res = (float)(rp.quantities[CIV_RESOURCE_OIL] +
-                              rp.quantities[CIV_RESOURCE_NATURAL_GAS] +
-                              rp.quantities[CIV_RESOURCE_COAL]);
+  float energy_res = (float)(rp->quantities[CIV_RESOURCE_OIL] +
+                              rp->quantities[CIV_RESOURCE_NATURAL_GAS] +
+                              rp->quantities[CIV_RESOURCE_COAL]);
   n->economy.energy_output = (float)land_tiles * 0.1f * tech_factor + energy_res * 0.5f;
   if (n->economy.energy_output < 1.0f) n->economy.energy_output = 1.0f;
 
   /* Raw materials: from extraction resources */
-  n->economy.raw_materials_output = (float)rp.total_resources * 10.0f * tech_factor;
+  n->economy.raw_materials_output = (float)rp->total_resources * 10.0f * tech_factor;
   if (n->economy.raw_materials_output < 1.0f) n->economy.raw_materials_output = 1.0f;
 
   /* Industrial output: from raw materials + manufacturing + tech */
@@ -582,6 +799,15 @@ void civ_nation_compute_economy(civ_nation_t *n, civ_map_t *map,
   n->economy.tax_revenue = gdp * 0.2f;
 }
 
+void civ_nation_compute_economy(civ_nation_t *n, civ_map_t *map,
+                                 const void *rm_void) {
+  if (!n || !map) return;
+  civ_nation_territory_t acc;
+  scan_nation(&acc, map, (const civ_resource_map_t *)rm_void,
+              civ_nation_owner_index(n));
+  derive_economy(n, &acc);
+}
+
 void civ_nation_compute_all_economies(civ_nation_manager_t *mgr, civ_map_t *map,
                                        const void *resource_map,
                                        civ_nation_economy_t *global_out) {
@@ -589,21 +815,771 @@ void civ_nation_compute_all_economies(civ_nation_manager_t *mgr, civ_map_t *map,
 
   if (global_out) memset(global_out, 0, sizeof(*global_out));
 
-  float total_gdp = 0.0f;
+  civ_econ_sum_t total_gdp = CIV_ECON_SUM_ZERO;
   int nations_with_land = 0;
 
+  const civ_resource_map_t *rm = (const civ_resource_map_t *)resource_map;
+  update_territory(mgr, map, resource_map);
+
   for (int i = 0; i < mgr->count; i++) {
-    civ_nation_compute_economy(&mgr->nations[i], map, resource_map);
+    civ_nation_t *n = &mgr->nations[i];
+    if (n->territory.quality_stale)
+      scan_nation(&n->territory, map, rm, n->owner_index);
+    derive_economy(n, &n->territory);
     if (mgr->nations[i].economy.owned_land_tiles > 0) {
-      total_gdp += mgr->nations[i].economy.gdp;
+      civ_econ_sum_add(&total_gdp, mgr->nations[i].economy.gdp);
       nations_with_land++;
     }
   }
 
   if (global_out && nations_with_land > 0) {
-    global_out->gdp = total_gdp;
-    global_out->gdp_per_capita = total_gdp / (float)nations_with_land;
+    global_out->gdp = (float)civ_econ_sum_value(&total_gdp);
+    global_out->gdp_per_capita = global_out->gdp / (float)nations_with_land;
     global_out->inflation = 0.02f;
     global_out->unemployment = 0.05f;
   }
 }
+
+/* ── Subdivision membership ────────────────────────────────────────── */
+
+/* The nation's subdivision box holding tile i, -1 if none */
+static int tile_box(const civ_nation_t *n, const civ_map_t *map, size_t i) {
+  int32_t x = (int32_t)(i % (size_t)map->width);
+  int32_t y = (int32_t)(i / (size_t)map->width);
+  float lat = 90.0f - (float)y / (float)(map->height - 1) * 180.0f;
+  float lon = (float)x / (float)(map->width - 1) * 360.0f - 180.0f;
+  for (int s = 0; s < n->subdivision_count; s++) {
+    civ_nation_region_t box = n->subdivisions[s].region;
+    if (point_in_region(lon, lat, &box)) return s;
+  }
+  return -1;
+}
+
+static civ_subdivision_manager_t *subdivisions_of(civ_nation_manager_t *mgr,
+                                                  int ni) {
+  if (ni < 0 || mgr->nations[ni].subdivision_count == 0) return NULL;
+  civ_government_t *gov = mgr->nations[ni].government;
+  return gov ? gov->subdivision_manager : NULL;
+}
+
+/* Map owner listener: the tile leaves its old owner's subdivision and
+   joins the new owner's */
+static void subdivision_listener(void *user_data, const civ_map_t *map,
+                                 size_t index, civ_owner_index_t old_owner,
+                                 civ_owner_index_t new_owner) {
+  civ_nation_manager_t *mgr = (civ_nation_manager_t *)user_data;
+  if (!mgr->subdivisions_valid) return;
+  int from = owner_to_nation(mgr, old_owner);
+  int to = owner_to_nation(mgr, new_owner);
+  if (from == to) return;
+  civ_subdivision_plane_t *plane = mgr->subdivision_plane;
+  civ_subdivision_manager_t *sm = subdivisions_of(mgr, from);
+  if (sm) civ_subdivision_release_tile(sm, plane, (uint32_t)index);
+  else plane->ids[index] = 0;
+  sm = subdivisions_of(mgr, to);
+  int box = sm ? tile_box(&mgr->nations[to], map, index) : -1;
+  if (box >= 0 && (size_t)box < sm->count)
+    civ_subdivision_assign_tile(sm, plane, (size_t)box, (uint32_t)index);
+}
+
+/* Full rebuild: one map pass placing each owned tile */
+static void rebuild_subdivisions(civ_nation_manager_t *mgr, civ_map_t *map) {
+  size_t tile_count = (size_t)map->width * map->height;
+  mgr->subdivisions_valid = false;
+  if (!mgr->subdivision_plane || mgr->subdivision_plane->tile_count != tile_count) {
+    civ_subdivision_plane_destroy(mgr->subdivision_plane);
+    mgr->subdivision_plane = civ_subdivision_plane_create(tile_count);
+    if (!mgr->subdivision_plane) return;
+  }
+  memset(mgr->subdivision_plane->ids, 0, tile_count * sizeof(uint16_t));
+
+  /* One governance subdivision per box, emptied of tiles */
+  for (int ni = 0; ni < mgr->count; ni++) {
+    civ_nation_t *n = &mgr->nations[ni];
+    civ_subdivision_manager_t *sm = subdivisions_of(mgr, ni);
+    if (!sm) continue;
+    while (sm->count < (size_t)n->subdivision_count &&
+           civ_subdivision_create(sm, n->subdivisions[sm->count].name,
+                                  CIV_SUBDIVISION_STATE))
+      ;
+    for (size_t i = 0; i < sm->count; i++) {
+      sm->items[i].span_count = 0;
+      sm->items[i].tile_count = 0;
+    }
+  }
+
+  for (size_t i = 0; i < tile_count; i++) {
+    int ni = owner_to_nation(mgr, civ_map_owner_at(map, i));
+    civ_subdivision_manager_t *sm = subdivisions_of(mgr, ni);
+    if (!sm) continue;
+    int box = tile_box(&mgr->nations[ni], map, i);
+    if (box >= 0 && (size_t)box < sm->count)
+      civ_subdivision_assign_tile(sm, mgr->subdivision_plane, (size_t)box, (uint32_t)i);
+  }
+
+  mgr->subdivisions_valid = civ_map_add_owner_listener(map, subdivision_listener, mgr);
+  mgr->subdivision_steps = UINT64_MAX;
+}
+
+void civ_nation_aggregate_subdivisions(civ_nation_manager_t *mgr, civ_map_t *map,
+                                       const civ_tile_field_t *field) {
+  if (!mgr || !map) return;
+  if (!mgr->subdivisions_valid ||
+      !civ_map_has_owner_listener(map, subdivision_listener, mgr) ||
+      mgr->subdivision_plane->tile_count != (size_t)map->width * map->height)
+    rebuild_subdivisions(mgr, map);
+
+  /* Sums move only when the field does */
+  if (!field || field->steps == mgr->subdivision_steps ||
+      field->width != map->width || field->height != map->height)
+    return;
+  mgr->subdivision_steps = field->steps;
+  for (int ni = 0; ni < mgr->count; ni++) {
+    civ_subdivision_manager_t *sm = subdivisions_of(mgr, ni);
+    if (!sm) continue;
+    civ_subdivision_manager_aggregate(sm, CIV_SUBDIVISION_AGGREGATE_POPULATION,
+                                      field->value[CIV_TILE_FIELD_POPULATION]);
+    civ_subdivision_manager_aggregate(sm, CIV_SUBDIVISION_AGGREGATE_INFLUENCE,
+                                      field->value[CIV_TILE_FIELD_POLITICS]);
+  }
+}
+
+/* ── Merges and secessions ─────────────────────────────────────────── */
+
+/* Governance subdivisions for boxes added since the last rebuild */
+static void sync_subdivisions(civ_nation_manager_t *mgr, int ni) {
+  civ_subdivision_manager_t *sm = mgr->subdivisions_valid ? subdivisions_of(mgr, ni) : NULL;
+  if (!sm) return;
+  civ_nation_t *n = &mgr->nations[ni];
+  while (sm->count < (size_t)n->subdivision_count &&
+         civ_subdivision_create(sm, n->subdivisions[sm->count].name,
+                                CIV_SUBDIVISION_STATE))
+    ;
+}
+
+/* Route one owner index without the full rebuild index_owners forces */
+static bool index_owner(civ_nation_manager_t *mgr, civ_owner_index_t owner, int ni) {
+  if (owner == CIV_OWNER_NONE) return false;
+  if (owner >= mgr->owner_nation_size) {
+    uint32_t size = civ_owner_count();
+    int *grown = realloc(mgr->owner_nation, size * sizeof(int));
+    if (!grown) return false;
+    for (uint32_t o = mgr->owner_nation_size; o < size; o++) grown[o] = -1;
+    mgr->owner_nation = grown;
+    mgr->owner_nation_size = size;
+  }
+  mgr->owner_nation[owner] = ni;
+  return true;
+}
+
+static void transfer_begin(civ_nation_transfer_t *t) {
+  memset(t, 0, sizeof(*t));
+  t->min_x = t->min_y = INT32_MAX;
+  t->max_x = t->max_y = INT32_MIN;
+}
+
+/* Hand one tile to nation to, through the map so every listener sees it */
+static void transfer_tile(civ_map_t *map, civ_nation_t *to, uint32_t tile,
+                          civ_nation_transfer_t *t) {
+  civ_map_set_owner(map, tile, to->owner_index, to->color);
+  int32_t x = (int32_t)(tile % (uint32_t)map->width);
+  int32_t y = (int32_t)(tile / (uint32_t)map->width);
+  t->tiles++;
+  t->min_x = MIN(t->min_x, x);
+  t->min_y = MIN(t->min_y, y);
+  t->max_x = MAX(t->max_x, x);
+  t->max_y = MAX(t->max_y, y);
+}
+
+static bool territory_tracked(civ_nation_manager_t *mgr, civ_map_t *map) {
+  update_territory(mgr, map, mgr->territory_resources);
+  return mgr->territory_valid;
+}
+
+civ_result_t civ_nation_manager_absorb(civ_nation_manager_t *mgr, civ_map_t *map,
+                                       int into, int from,
+                                       civ_nation_transfer_t *out) {
+  civ_nation_transfer_t t;
+  transfer_begin(&t);
+  if (out) *out = t;
+  if (!mgr || !map) return (civ_result_t){CIV_ERROR_NULL_POINTER, NULL};
+  if (into < 0 || from < 0 || into >= mgr->count || from >= mgr->count ||
+      into == from || mgr->nations[into].defunct || mgr->nations[from].defunct)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "No such pair of nations"};
+  if (!territory_tracked(mgr, map))
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Territory untracked"};
+
+  civ_nation_t *a = &mgr->nations[into], *b = &mgr->nations[from];
+  if (a->subdivision_count + b->subdivision_count > CIV_SUBDIVISION_MAX)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Too many subdivisions"};
+  /* The last step that can fail; it leaves both governments alone if so */
+  if (a->government && b->government &&
+      !civ_government_fold_positions(a->government, b->government))
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Governments not merged"};
+  civ_nation_owner_index(a);
+
+  /* Boxes first, so the subdivision listener finds each arriving tile's */
+  for (int s = 0; s < b->subdivision_count; s++)
+    a->subdivisions[a->subdivision_count++] = b->subdivisions[s];
+  sync_subdivisions(mgr, into);
+
+  /* From the back of the list, so each move is a pop */
+  while (b->tile_count > 0) {
+    int32_t before = b->tile_count;
+    uint32_t tile = b->tiles[before - 1];
+    transfer_tile(map, a, tile, &t);
+    if (b->tile_count == before) b->tile_count--; /* not routed to b */
+  }
+
+  int64_t people = MAX(a->population, 0) + MAX(b->population, 0);
+  float weight = people > 0 ? (float)((double)MAX(b->population, 0) / (double)people) : 0.5f;
+  civ_economy_batch_t *batch = mgr->economy_batch;
+  if (batch && (size_t)MAX(into, from) < batch->count)
+    civ_economy_batch_merge_lanes(batch, (size_t)into, (size_t)from, weight);
+
+  t.population = b->population;
+  a->population += b->population;
+  a->tech_index = MAX(a->tech_index, b->tech_index);
+  a->economic_index += (int32_t)lroundf((float)(b->economic_index - a->economic_index) * weight);
+  a->military_index += (int32_t)lroundf((float)(b->military_index - a->military_index) * weight);
+  a->cultural_index += (int32_t)lroundf((float)(b->cultural_index - a->cultural_index) * weight);
+
+  /* Its tiles have left its subdivisions; the government goes with them */
+  b->population = 0;
+  b->subdivision_count = 0;
+  b->defunct = true;
+  civ_government_destroy(b->government);
+  b->government = NULL;
+  memset(&b->economy, 0, sizeof(b->economy));
+  if (mgr->player_nation_index == from) mgr->player_nation_index = into;
+  if (mgr->focus_nation_index == from) mgr->focus_nation_index = into;
+  mgr->political_revision++;
+  if (out) *out = t;
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+int civ_nation_manager_secede(civ_nation_manager_t *mgr, civ_map_t *map, int from,
+                              uint32_t subdivision_mask, const char *id,
+                              const char *name, uint32_t color,
+                              civ_nation_transfer_t *out) {
+  civ_nation_transfer_t t;
+  transfer_begin(&t);
+  if (out) *out = t;
+  if (!mgr || !map || !id || !id[0] || from < 0 || from >= mgr->count ||
+      mgr->count >= mgr->capacity || civ_nation_get_by_id(mgr, id))
+    return -1;
+  civ_nation_t *parent = &mgr->nations[from];
+  uint32_t boxes = parent->subdivision_count >= 32
+                       ? UINT32_MAX
+                       : (1u << parent->subdivision_count) - 1u;
+  subdivision_mask &= boxes;
+  if (parent->defunct || subdivision_mask == 0 || !territory_tracked(mgr, map))
+    return -1;
+
+  /* Everything that can fail comes before the first change */
+  uint32_t *moving = malloc((size_t)MAX(parent->tile_count, 1) * sizeof(uint32_t));
+  civ_owner_index_t owner = civ_owner_intern(id);
+  if (!moving || !index_owner(mgr, owner, mgr->count)) {
+    free(moving);
+    return -1;
+  }
+  int32_t moving_count = 0, moving_land = 0;
+  for (int32_t i = 0; i < parent->tile_count; i++) {
+    uint32_t tile = parent->tiles[i];
+    int box = tile_box(parent, map, tile);
+    if (box < 0 || !(subdivision_mask & (1u << box))) continue;
+    moving[moving_count++] = tile;
+    moving_land += !civ_map_is_water_at(map, tile);
+  }
+
+  civ_economy_batch_t *batch = mgr->economy_batch;
+  bool split_lane = batch && (size_t)from < batch->count;
+  if (split_lane && !civ_economy_batch_resize(batch, (size_t)mgr->count + 1)) {
+    free(moving);
+    return -1;
+  }
+
+  int ni = mgr->count;
+  civ_nation_t *n = civ_nation_manager_add(mgr, id, name, color);
+  n->owner_index = owner;
+  n->tech_index = parent->tech_index;
+  n->economic_index = parent->economic_index;
+  n->military_index = parent->military_index;
+  n->cultural_index = parent->cultural_index;
+  n->cost_of_living = parent->cost_of_living;
+  parent = &mgr->nations[from];
+
+  /* The boxes go over; the parent's become empty so its own stay put */
+  bool capital_set = false;
+  for (int s = 0; s < parent->subdivision_count; s++) {
+    if (!(subdivision_mask & (1u << s))) continue;
+    n->subdivisions[n->subdivision_count++] = parent->subdivisions[s];
+    civ_nation_region_t *r = &parent->subdivisions[s].region;
+    if (!capital_set) {
+      n->capital_lon = 0.5f * (r->min_lon + r->max_lon);
+      n->capital_lat = 0.5f * (r->min_lat + r->max_lat);
+      n->regions[0] = *r;
+      n->region_count = 1;
+      capital_set = true;
+    }
+    r->min_lon = r->min_lat = 1.0f;
+    r->max_lon = r->max_lat = 0.0f;
+  }
+  sync_subdivisions(mgr, ni);
+
+  for (int32_t i = 0; i < moving_count; i++) transfer_tile(map, n, moving[i], &t);
+  free(moving);
+
+  int32_t land = parent->territory.land_tiles + moving_land;
+  float share = land > 0 ? (float)moving_land / (float)land : 0.0f;
+  t.population = (int64_t)((double)MAX(parent->population, 0) * share);
+  n->population = t.population;
+  parent->population -= t.population;
+
+  if (split_lane) civ_economy_batch_split_lane(batch, (size_t)from, (size_t)ni, share);
+
+  mgr->political_revision++;
+  if (out) *out = t;
+  return ni;
+}
+
+/* ── Batched economy model ─────────────────────────────────────────── */
+
+static void gather_economy_inputs(civ_economy_batch_t *b, size_t i,
+                                  const civ_nation_t *n,
+                                  const civ_modifier_stack_t *mods) {
+  const civ_nation_territory_t *t = &n->territory;
+  float tech = (float)n->tech_index / 250.0f;
+  b->population[i] = n->population > 0 ? (float)n->population : 1000000.0f;
+  b->base_gdp[i] = n->economy.owned_land_tiles > 0 ? n->economy.gdp : 0.0f;
+  b->tech_level[i] = tech * mods->economy;
+  b->education[i] = CLAMP(0.25f + tech * 0.2f, 0.10f, 0.95f);
+  b->gov_efficiency[i] = n->government ? n->government->efficiency : 0.50f;
+  b->corruption[i] = civ_government_get_corruption(n->government);
+  b->arable_km2[i] = (float)t->arable_km2;
+  b->area_km2[i] = (float)t->land_km2;
+  b->mineral_deposit[i] = (float)n->resources.total_resources * 100000.0f;
+
+  /* Fuel-fired plants run on what the territory holds */
+  float fuel = (float)(n->resources.quantities[CIV_RESOURCE_OIL] +
+                       n->resources.quantities[CIV_RESOURCE_NATURAL_GAS] +
+                       n->resources.quantities[CIV_RESOURCE_COAL]);
+  b->fuel_availability[i] = CLAMP(0.30f + fuel * 0.001f, 0.30f, 1.00f);
+  b->at_war[i] = 0.0f;  /* no per-nation war state yet */
+}
+
+static void publish_economy_outputs(const civ_economy_batch_t *b, size_t i,
+                                    civ_nation_economy_t *e) {
+  e->gdp = b->gdp[i];
+  e->gdp_per_capita = b->gdp_per_capita[i];
+  e->gdp_growth = b->gdp_growth[i];
+  e->inflation = b->inflation[i];
+  e->unemployment = b->unemployment[i];
+  e->labor_force = b->workforce[i];
+  e->avg_wage = b->avg_wage[i];
+  e->tax_revenue = b->tax_revenue[i];
+  e->food_production = b->food_production[i] / 1000000.0f;
+  e->food_consumption = b->food_consumption[i] / 1000000.0f;
+  e->energy_output = MAX(b->energy_output[i] * 8760.0f, 1.0f);
+  e->industrial_output = b->industrial_output[i];
+  e->raw_materials_output = b->raw_materials[i];
+}
+
+void civ_nation_update_economies(civ_nation_manager_t *mgr, civ_map_t *map,
+                                 const void *resource_map,
+                                 const civ_modifier_table_t *modifiers,
+                                 civ_float_t dt,
+                                 civ_nation_economy_t *global_out) {
+  if (!mgr || !map) return;
+
+  civ_nation_compute_all_economies(mgr, map, resource_map, global_out);
+
+  if (!mgr->economy_batch) mgr->economy_batch = civ_economy_batch_create();
+  civ_economy_batch_t *b = mgr->economy_batch;
+  if (!b || !civ_economy_batch_resize(b, (size_t)mgr->count)) return;
+
+  for (int i = 0; i < mgr->count; i++)
+    gather_economy_inputs(b, (size_t)i, &mgr->nations[i],
+                          civ_modifier_stack_of(modifiers,
+                                                mgr->nations[i].owner_index));
+
+  civ_economy_batch_update(b, dt);
+
+  civ_econ_sum_t total_gdp = CIV_ECON_SUM_ZERO;
+  int nations_with_land = 0;
+  for (int i = 0; i < mgr->count; i++) {
+    civ_nation_t *n = &mgr->nations[i];
+    if (n->economy.owned_land_tiles == 0) continue;
+    publish_economy_outputs(b, (size_t)i, &n->economy);
+    civ_econ_sum_add(&total_gdp, n->economy.gdp);
+    nations_with_land++;
+  }
+
+  if (global_out && nations_with_land > 0) {
+    global_out->gdp = (float)civ_econ_sum_value(&total_gdp);
+    global_out->gdp_per_capita = global_out->gdp / (float)nations_with_land;
+  }
+}
+
+#define FISCAL_PLANS_PER_CALL 4
+#define FISCAL_HORIZON        12  /* updates projected per option */
+#define FISCAL_OPTIONS        27
+
+/* A plan worked out ahead from a copy of the lane it is for */
+typedef struct {
+  int                    lane;
+  civ_economy_snapshot_t from;
+  civ_economy_snapshot_t chosen;
+  bool                   ok;
+} fiscal_guess_t;
+
+struct civ_fiscal_speculation {
+  fiscal_guess_t     guesses[FISCAL_PLANS_PER_CALL];
+  int                count;
+  bool               in_flight;
+  SDL_AtomicInt      outstanding;
+  civ_worker_pool_t *pool;
+};
+
+/* Every mix of a small cut, no change and a small rise per lever */
+static void fiscal_options(civ_economy_policy_delta_t options[FISCAL_OPTIONS]) {
+  static const float step[3] = {-1.0f, 0.0f, 1.0f};
+  int n = 0;
+  for (int c = 0; c < 3; c++)
+    for (int s = 0; s < 3; s++)
+      for (int d = 0; d < 3; d++)
+        options[n++] = (civ_economy_policy_delta_t){
+            step[c] * 0.02f, step[s] * 0.01f, step[d] * 0.005f, 0.0f};
+}
+
+/* The best-scoring option applied to now; proj is FISCAL_OPTIONS long */
+static bool choose_fiscal(civ_worker_pool_t *pool,
+                          const civ_economy_snapshot_t *now,
+                          civ_economy_projection_t *proj,
+                          civ_economy_snapshot_t *chosen) {
+  civ_economy_policy_delta_t options[FISCAL_OPTIONS];
+  fiscal_options(options);
+  if (!civ_economy_forecast_many(pool, now, options, FISCAL_OPTIONS,
+                                 FISCAL_HORIZON, proj))
+    return false;
+
+  int best = FISCAL_OPTIONS / 2;  /* no change */
+  float best_score = civ_economy_projection_score(now, &proj[best]);
+  for (int k = 0; k < FISCAL_OPTIONS; k++) {
+    float score = civ_economy_projection_score(now, &proj[k]);
+    if (score > best_score) {
+      best = k;
+      best_score = score;
+    }
+  }
+  *chosen = civ_economy_apply_policy(now, &options[best]);
+  return true;
+}
+
+/* Whether the walk plans lane i; planning clears the LOD flag */
+static bool fiscal_due(const civ_nation_manager_t *mgr, int i) {
+  const civ_economy_batch_t *b = mgr->economy_batch;
+  if (i == mgr->player_nation_index || b->seeded[i] == 0.0f) return false;
+  /* Nations ticking at reduced detail replan once per tick */
+  const civ_nation_lod_t *lod = &mgr->nations[i].lod;
+  return lod->interval <= 1 || lod->replan;
+}
+
+static void speculate_job(void *arg) {
+  struct civ_fiscal_speculation *spec = arg;
+  civ_economy_projection_t *proj =
+      CIV_MALLOC(FISCAL_OPTIONS * sizeof(civ_economy_projection_t));
+  for (int k = 0; k < spec->count; k++) {
+    fiscal_guess_t *g = &spec->guesses[k];
+    g->ok = proj && choose_fiscal(spec->pool, &g->from, proj, &g->chosen);
+  }
+  CIV_FREE(proj);
+  SDL_AddAtomicInt(&spec->outstanding, -1);
+}
+
+void civ_nation_discard_fiscal_speculation(civ_nation_manager_t *mgr) {
+  struct civ_fiscal_speculation *spec = mgr ? mgr->fiscal_speculation : NULL;
+  if (!spec) return;
+  if (spec->in_flight && spec->pool)
+    civ_worker_pool_wait_counter(spec->pool, &spec->outstanding);
+  spec->in_flight = false;
+  spec->count = 0;
+}
+
+void civ_nation_speculate_fiscal_policy(civ_nation_manager_t *mgr,
+                                        struct civ_worker_pool *pool) {
+  civ_economy_batch_t *b = mgr ? mgr->economy_batch : NULL;
+  if (!b || b->count == 0) return;
+  civ_nation_discard_fiscal_speculation(mgr);
+  /* Only worth it when the work can leave this thread */
+  if (!pool) return;
+  if (!mgr->fiscal_speculation) {
+    mgr->fiscal_speculation = calloc(1, sizeof(struct civ_fiscal_speculation));
+    if (!mgr->fiscal_speculation) return;
+  }
+  struct civ_fiscal_speculation *spec = mgr->fiscal_speculation;
+
+  /* The lanes the next plan call will visit, as they stand now */
+  int lanes = (int)MIN(b->count, (size_t)mgr->count);
+  for (int visited = 0, cursor = mgr->fiscal_cursor;
+       visited < lanes && spec->count < FISCAL_PLANS_PER_CALL; visited++) {
+    int i = cursor++ % lanes;
+    if (!fiscal_due(mgr, i)) continue;
+    fiscal_guess_t *g = &spec->guesses[spec->count++];
+    g->lane = i;
+    g->ok = false;
+    civ_economy_batch_snapshot(b, (size_t)i, &g->from);
+  }
+  if (spec->count == 0) return;
+
+  spec->pool = pool;
+  spec->in_flight = true;
+  SDL_SetAtomicInt(&spec->outstanding, 1);
+  if (!civ_worker_pool_submit(pool, speculate_job, spec)) speculate_job(spec);
+}
+
+/* A guess made from exactly now, if there is one */
+static const fiscal_guess_t *
+find_guess(const struct civ_fiscal_speculation *spec, int lane,
+           const civ_economy_snapshot_t *now) {
+  for (int k = 0; spec && k < spec->count; k++) {
+    const fiscal_guess_t *g = &spec->guesses[k];
+    if (g->lane == lane && g->ok && memcmp(&g->from, now, sizeof(*now)) == 0)
+      return g;
+  }
+  return NULL;
+}
+
+void civ_nation_plan_fiscal_policy(civ_nation_manager_t *mgr,
+                                   struct civ_worker_pool *pool) {
+  civ_economy_batch_t *b = mgr ? mgr->economy_batch : NULL;
+  if (!b || b->count == 0) return;
+
+  struct civ_fiscal_speculation *spec = mgr->fiscal_speculation;
+  if (spec && spec->in_flight && spec->pool) {
+    civ_worker_pool_wait_counter(spec->pool, &spec->outstanding);
+    spec->in_flight = false;
+  }
+
+  civ_economy_projection_t *proj = NULL;
+  int lanes = (int)MIN(b->count, (size_t)mgr->count);
+  for (int visited = 0, planned = 0;
+       visited < lanes && planned < FISCAL_PLANS_PER_CALL; visited++) {
+    int i = mgr->fiscal_cursor++ % lanes;
+    if (!fiscal_due(mgr, i)) continue;
+    mgr->nations[i].lod.replan = false;
+    civ_economy_snapshot_t now, chosen;
+    civ_economy_batch_snapshot(b, (size_t)i, &now);
+
+    /* Anything that moved the lane since the guess was made voids it */
+    const fiscal_guess_t *g = find_guess(spec, i, &now);
+    if (g) {
+      chosen = g->chosen;
+    } else {
+      if (!proj)
+        proj = CIV_MALLOC(FISCAL_OPTIONS * sizeof(civ_economy_projection_t));
+      if (!proj || !choose_fiscal(pool, &now, proj, &chosen)) continue;
+    }
+    b->corporate_tax_rate[i] = chosen.corporate_tax_rate;
+    b->sales_tax_rate[i] = chosen.sales_tax_rate;
+    b->deficit_spending[i] = chosen.deficit_spending;
+    b->regulation[i] = chosen.regulation;
+    planned++;
+  }
+  mgr->fiscal_cursor %= MAX(lanes, 1);
+  if (spec) spec->count = 0;
+  CIV_FREE(proj);
+}
+
+/* ── Save section ──────────────────────────────────────────────────── */
+
+static void nations_put(const civ_nation_manager_t *mgr, civ_ser_cursor_t *c) {
+  uint32_t count = (uint32_t)mgr->count;
+  CIV_SER_PUT(c, count);
+  for (int i = 0; i < mgr->count; i++) {
+    const civ_nation_t *n = &mgr->nations[i];
+    civ_ser_put(c, n->id, sizeof(n->id));
+    CIV_SER_PUT(c, n->economy);
+    CIV_SER_PUT(c, n->population);
+    CIV_SER_PUT(c, n->cost_of_living);
+    CIV_SER_PUT(c, n->gdp_per_capita);
+    CIV_SER_PUT(c, n->tech_index);
+    CIV_SER_PUT(c, n->economic_index);
+    CIV_SER_PUT(c, n->military_index);
+    CIV_SER_PUT(c, n->cultural_index);
+
+    /* Government as a nested blob, measured first */
+    uint32_t gov_size = 0;
+    civ_serializable_t gs = {0};
+    if (n->government) {
+      gs = civ_government_serializable(n->government);
+      gov_size = (uint32_t)gs.get_serialized_size(gs.object);
+    }
+    CIV_SER_PUT(c, gov_size);
+    if (gov_size && c->pos + gov_size <= c->size)
+      gs.serialize(gs.object, (char *)c->data + c->pos, gov_size, NULL);
+    else if (gov_size)
+      c->overflow = true;
+    c->pos += gov_size;
+  }
+
+  /* v2 trailer: identity and boxes, so nations made in play come back */
+  for (int i = 0; i < mgr->count; i++) {
+    const civ_nation_t *n = &mgr->nations[i];
+    uint32_t regions = (uint32_t)n->region_count;
+    uint32_t boxes = (uint32_t)n->subdivision_count;
+    uint8_t defunct = n->defunct;
+    civ_ser_put(c, n->id, sizeof(n->id));
+    civ_ser_put(c, n->name, sizeof(n->name));
+    CIV_SER_PUT(c, n->color);
+    CIV_SER_PUT(c, n->color_accent);
+    CIV_SER_PUT(c, n->capital_lon);
+    CIV_SER_PUT(c, n->capital_lat);
+    CIV_SER_PUT(c, regions);
+    civ_ser_put(c, n->regions, regions * sizeof(n->regions[0]));
+    CIV_SER_PUT(c, defunct);
+    CIV_SER_PUT(c, boxes);
+    civ_ser_put(c, n->subdivisions, boxes * sizeof(n->subdivisions[0]));
+  }
+}
+
+static civ_result_t nations_serialize(const void *object, char *buffer,
+                                      size_t buffer_size, size_t *written) {
+  civ_ser_cursor_t c = civ_ser_cursor(buffer, buffer_size);
+  nations_put((const civ_nation_manager_t *)object, &c);
+  if (written) *written = c.pos;
+  return c.overflow ? (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Buffer too small"}
+                    : (civ_result_t){CIV_OK, NULL};
+}
+
+static size_t nations_serialized_size(const void *object) {
+  civ_ser_cursor_t c = civ_ser_cursor(NULL, 0);
+  nations_put((const civ_nation_manager_t *)object, &c);
+  return c.pos;
+}
+
+/* One pass over the v1 records; with apply false it only finds their end */
+static bool nations_get_records(civ_nation_manager_t *mgr, civ_ser_cursor_t *c,
+                                uint32_t count, bool apply) {
+  for (uint32_t i = 0; i < count && !c->overflow; i++) {
+    char id[CIV_NATION_ID_MAX];
+    civ_nation_t saved, *n;
+    uint32_t gov_size = 0;
+    civ_ser_get(c, id, sizeof(id));
+    id[sizeof(id) - 1] = '\0';
+    CIV_SER_GET(c, saved.economy);
+    CIV_SER_GET(c, saved.population);
+    CIV_SER_GET(c, saved.cost_of_living);
+    CIV_SER_GET(c, saved.gdp_per_capita);
+    CIV_SER_GET(c, saved.tech_index);
+    CIV_SER_GET(c, saved.economic_index);
+    CIV_SER_GET(c, saved.military_index);
+    CIV_SER_GET(c, saved.cultural_index);
+    if (!CIV_SER_GET(c, gov_size) || gov_size > c->size - c->pos) return false;
+
+    n = apply ? civ_nation_get_by_id(mgr, id) : NULL;
+    if (n) {
+      n->economy = saved.economy;
+      n->population = saved.population;
+      n->cost_of_living = saved.cost_of_living;
+      n->gdp_per_capita = saved.gdp_per_capita;
+      n->tech_index = saved.tech_index;
+      n->economic_index = saved.economic_index;
+      n->military_index = saved.military_index;
+      n->cultural_index = saved.cultural_index;
+      if (n->government && gov_size) {
+        civ_serializable_t gs = civ_government_serializable(n->government);
+        gs.deserialize(gs.object, (const char *)c->data + c->pos, gov_size);
+      }
+    }
+    c->pos += gov_size;
+  }
+  return !c->overflow;
+}
+
+/* The v2 trailer: names, boxes and merge state, creating any nation the
+   session does not have yet (one that seceded in the saved game) */
+static bool nations_get_identities(civ_nation_manager_t *mgr,
+                                   civ_ser_cursor_t *c, uint32_t count) {
+  bool created = false;
+  for (uint32_t i = 0; i < count && !c->overflow; i++) {
+    char id[CIV_NATION_ID_MAX], name[CIV_NATION_NAME_MAX];
+    civ_nation_t saved;
+    uint32_t regions = 0, boxes = 0;
+    uint8_t defunct = 0;
+    civ_ser_get(c, id, sizeof(id));
+    civ_ser_get(c, name, sizeof(name));
+    id[sizeof(id) - 1] = name[sizeof(name) - 1] = '\0';
+    CIV_SER_GET(c, saved.color);
+    CIV_SER_GET(c, saved.color_accent);
+    CIV_SER_GET(c, saved.capital_lon);
+    CIV_SER_GET(c, saved.capital_lat);
+    if (!CIV_SER_GET(c, regions) || regions > sizeof(saved.regions) / sizeof(saved.regions[0]))
+      return false;
+    civ_ser_get(c, saved.regions, regions * sizeof(saved.regions[0]));
+    CIV_SER_GET(c, defunct);
+    if (!CIV_SER_GET(c, boxes) || boxes > CIV_SUBDIVISION_MAX) return false;
+    civ_ser_get(c, saved.subdivisions, boxes * sizeof(saved.subdivisions[0]));
+    if (c->overflow || !id[0]) return false;
+
+    civ_nation_t *known = civ_nation_get_by_id(mgr, id);
+    int ni = known ? (int)(known - mgr->nations) : -1;
+    if (ni < 0) {
+      civ_owner_index_t owner = civ_owner_intern(id);
+      if (mgr->count >= mgr->capacity || !index_owner(mgr, owner, mgr->count))
+        continue;
+      ni = mgr->count;
+      civ_nation_manager_add(mgr, id, name, saved.color)->owner_index = owner;
+      created = true;
+    }
+    civ_nation_t *n = &mgr->nations[ni];
+    snprintf(n->name, sizeof(n->name), "%s", name);
+    n->color = saved.color;
+    n->color_accent = saved.color_accent;
+    n->capital_lon = saved.capital_lon;
+    n->capital_lat = saved.capital_lat;
+    memcpy(n->regions, saved.regions, regions * sizeof(saved.regions[0]));
+    n->region_count = (int)regions;
+    n->defunct = defunct != 0;
+    for (uint32_t s = 0; s < boxes; s++) {
+      n->subdivisions[s] = saved.subdivisions[s];
+      n->subdivisions[s].name[sizeof(n->subdivisions[s].name) - 1] = '\0';
+      n->subdivisions[s].id[sizeof(n->subdivisions[s].id) - 1] = '\0';
+    }
+    n->subdivision_count = (int)boxes;
+    sync_subdivisions(mgr, ni);
+  }
+  if (created) {
+    if (mgr->economy_batch)
+      civ_economy_batch_resize(mgr->economy_batch, (size_t)mgr->count);
+    mgr->territory_valid = false;
+  }
+  mgr->subdivisions_valid = false; /* boxes may have moved between nations */
+  mgr->political_revision++;
+  return true;
+}
+
+static civ_result_t nations_deserialize(void *object, const char *buffer,
+                                        size_t buffer_size) {
+  civ_nation_manager_t *mgr = (civ_nation_manager_t *)object;
+  civ_ser_cursor_t c = civ_ser_cursor((void *)buffer, buffer_size);
+  uint32_t count = 0;
+  if (!CIV_SER_GET(&c, count))
+    return (civ_result_t){CIV_ERROR_INVALID_DATA, "Nation section size"};
+  size_t records = c.pos;
+
+  /* Identities first, so the records find the nations they name; a v1
+     section ends with its records */
+  if (!nations_get_records(mgr, &c, count, false) ||
+      (c.pos < buffer_size && !nations_get_identities(mgr, &c, count)))
+    return (civ_result_t){CIV_ERROR_INVALID_DATA, "Nation section truncated"};
+  c.pos = records;
+  return nations_get_records(mgr, &c, count, true)
+             ? (civ_result_t){CIV_OK, NULL}
+             : (civ_result_t){CIV_ERROR_INVALID_DATA, "Nation section truncated"};
+}
+
+civ_serializable_t civ_nation_manager_serializable(civ_nation_manager_t *mgr) {
+  return (civ_serializable_t){mgr, nations_serialize, nations_deserialize,
+                              nations_serialized_size};
+}
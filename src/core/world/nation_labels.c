@@ -0,0 +1,258 @@
+/**
+ * @file nation_labels.c
+ * @brief Per-owner label baselines from territory moments and medial bins
+ */
+#include "core/world/nation_labels.h"
+#include "common.h"
+#include <math.h>
+#include <string.h>
+
+/* The axis spans this many standard deviations either side of the centre */
+#define AXIS_SPREAD 2.0
+
+typedef struct {
+  double n, sx, sy, sxx, sxy, syy; /* x relative to ref_x, unwrapped */
+  int32_t ref_x;
+  /* Axis, filled between the passes */
+  double cx, cy, ux, uy, half;
+  float s_min[CIV_NATION_LABEL_BINS], s_max[CIV_NATION_LABEL_BINS];
+  uint32_t count[CIV_NATION_LABEL_BINS];
+} owner_work_t;
+
+static bool reserve_owners(civ_nation_labels_t *l, uint32_t want) {
+  if (want <= l->capacity) return true;
+  uint32_t cap = l->capacity ? l->capacity : 64;
+  while (cap < want) cap *= 2;
+  civ_nation_label_path_t *paths = CIV_REALLOC(l->paths, cap * sizeof(*paths));
+  if (!paths) return false;
+  l->paths = paths;
+  uint8_t *dirty = CIV_REALLOC(l->dirty, cap);
+  if (!dirty) return false;
+  l->dirty = dirty;
+  memset(paths + l->capacity, 0, (cap - l->capacity) * sizeof(*paths));
+  memset(dirty + l->capacity, 0, cap - l->capacity);
+  l->capacity = cap;
+  return true;
+}
+
+static void mark(civ_nation_labels_t *l, civ_owner_index_t owner) {
+  if (owner == CIV_OWNER_NONE || !reserve_owners(l, (uint32_t)owner + 1)) return;
+  l->dirty[owner] = 1;
+  l->any_dirty = true;
+}
+
+static void labels_listener(void *user_data, const civ_map_t *map, size_t index,
+                            civ_owner_index_t old_owner, civ_owner_index_t new_owner) {
+  (void)map; (void)index;
+  civ_nation_labels_t *l = (civ_nation_labels_t *)user_data;
+  mark(l, old_owner);
+  mark(l, new_owner);
+}
+
+/* ── Lifecycle ─────────────────────────────────────────────────────── */
+civ_nation_labels_t *civ_nation_labels_create(void) {
+  return CIV_CALLOC(1, sizeof(civ_nation_labels_t));
+}
+
+void civ_nation_labels_destroy(civ_nation_labels_t *labels) {
+  if (!labels) return;
+  CIV_FREE(labels->paths);
+  CIV_FREE(labels->dirty);
+  CIV_FREE(labels);
+}
+
+bool civ_nation_labels_attach(civ_nation_labels_t *labels, civ_map_t *map) {
+  if (!labels || !map || !map->tiles) return false;
+  if (civ_map_has_owner_listener(map, labels_listener, labels)) return true;
+
+  uint32_t owners = civ_owner_count();
+  if (!reserve_owners(labels, owners + 1)) return false;
+  memset(labels->dirty, 1, labels->capacity);
+  labels->any_dirty = true;
+  labels->map_width = (uint32_t)map->width;
+  /* Without a listener slot the paths are only current until the next
+     change; the next attach recomputes them */
+  if (!civ_map_add_owner_listener(map, labels_listener, labels))
+    civ_log(CIV_LOG_WARNING, "Nation labels: map listener table full");
+  return true;
+}
+
+void civ_nation_labels_detach(civ_nation_labels_t *labels, civ_map_t *map) {
+  civ_map_remove_owner_listener(map, labels_listener, labels);
+}
+
+bool civ_nation_labels_attached(const civ_nation_labels_t *labels, const civ_map_t *map) {
+  return labels && map && civ_map_has_owner_listener(map, labels_listener, labels);
+}
+
+/* ── Refresh ───────────────────────────────────────────────────────── */
+
+/* Tile x relative to the owner's first tile, taking the short way round */
+static double unwrap(int32_t x, int32_t ref_x, int32_t width) {
+  int32_t dx = x - ref_x;
+  if (dx > width / 2) dx -= width;
+  else if (dx < -width / 2) dx += width;
+  return (double)dx;
+}
+
+/* Principal axis, pointing right so names read left to right */
+static void solve_axis(owner_work_t *w) {
+  double mx = w->sx / w->n, my = w->sy / w->n;
+  double cxx = w->sxx / w->n - mx * mx;
+  double cxy = w->sxy / w->n - mx * my;
+  double cyy = w->syy / w->n - my * my;
+  double angle = 0.5 * atan2(2.0 * cxy, cxx - cyy);
+  w->ux = cos(angle);
+  w->uy = sin(angle);
+  if (w->ux < 0.0) { w->ux = -w->ux; w->uy = -w->uy; }
+  double tr = cxx + cyy, det = cxx * cyy - cxy * cxy;
+  double major = 0.5 * tr + sqrt(MAX(0.25 * tr * tr - det, 0.0));
+  w->cx = mx;
+  w->cy = my;
+  w->half = MAX(AXIS_SPREAD * sqrt(major), 2.0);
+  for (int b = 0; b < CIV_NATION_LABEL_BINS; b++) {
+    w->s_min[b] = INFINITY;
+    w->s_max[b] = -INFINITY;
+    w->count[b] = 0;
+  }
+}
+
+static double catmull_rom(double p0, double p1, double p2, double p3, double t) {
+  double t2 = t * t, t3 = t2 * t;
+  return 0.5 * (2.0 * p1 + (p2 - p0) * t + (2.0 * p0 - 5.0 * p1 + 4.0 * p2 - p3) * t2 +
+                (3.0 * p1 - p0 - 3.0 * p2 + p3) * t3);
+}
+
+/* Control points midway across each bin, smoothed, then the sampled path */
+static void build_path(civ_nation_label_path_t *p, const owner_work_t *w,
+                       int32_t width) {
+  enum { K = CIV_NATION_LABEL_BINS };
+  double mid[K];
+  bool have[K];
+  double depth = 0.0;
+  int filled = 0;
+  for (int b = 0; b < K; b++) {
+    have[b] = w->count[b] > 0;
+    mid[b] = have[b] ? 0.5 * ((double)w->s_min[b] + (double)w->s_max[b]) : 0.0;
+    if (have[b]) {
+      depth += (double)w->s_max[b] - (double)w->s_min[b] + 1.0;
+      filled++;
+    }
+  }
+  /* Gaps (water inside the axis) take the nearest filled bin */
+  for (int b = 0; b < K; b++) {
+    if (have[b]) continue;
+    for (int d = 1; d < K; d++) {
+      if (b - d >= 0 && have[b - d]) { mid[b] = mid[b - d]; break; }
+      if (b + d < K && have[b + d]) { mid[b] = mid[b + d]; break; }
+    }
+  }
+  double smooth[K];
+  for (int b = 0; b < K; b++) {
+    double l = mid[b > 0 ? b - 1 : b], r = mid[b + 1 < K ? b + 1 : b];
+    smooth[b] = 0.25 * l + 0.5 * mid[b] + 0.25 * r;
+  }
+
+  /* Centre inside [0, width) */
+  double origin_x = (double)w->ref_x + w->cx;
+  double shift = floor(origin_x / (double)width) * (double)width;
+  double vx = -w->uy, vy = w->ux;
+  double cx[K], cy[K];
+  for (int b = 0; b < K; b++) {
+    double t = -w->half + (b + 0.5) * (2.0 * w->half / K);
+    cx[b] = origin_x - shift + t * w->ux + smooth[b] * vx;
+    cy[b] = w->cy + t * w->uy + smooth[b] * vy;
+  }
+
+  float length = 0.0f;
+  for (int i = 0; i < CIV_NATION_LABEL_SAMPLES; i++) {
+    double u = (double)i / (CIV_NATION_LABEL_SAMPLES - 1) * (K - 1);
+    int seg = MIN((int)u, K - 2);
+    double t = u - seg;
+    int i0 = MAX(seg - 1, 0), i3 = MIN(seg + 2, K - 1);
+    p->x[i] = (float)catmull_rom(cx[i0], cx[seg], cx[seg + 1], cx[i3], t);
+    p->y[i] = (float)catmull_rom(cy[i0], cy[seg], cy[seg + 1], cy[i3], t);
+    if (i > 0) length += hypotf(p->x[i] - p->x[i - 1], p->y[i] - p->y[i - 1]);
+  }
+  p->length = length;
+  p->thickness = filled > 0 ? (float)(depth / filled) : 0.0f;
+}
+
+size_t civ_nation_labels_refresh(civ_nation_labels_t *labels, const civ_map_t *map) {
+  if (!labels || !map || !map->tiles || !labels->any_dirty) return 0;
+
+  /* Work slot per dirty owner */
+  int32_t *slot_of = CIV_MALLOC(labels->capacity * sizeof(int32_t));
+  size_t dirty = 0;
+  for (uint32_t o = 1; slot_of && o < labels->capacity; o++)
+    slot_of[o] = labels->dirty[o] ? (int32_t)dirty++ : -1;
+  owner_work_t *work = dirty ? CIV_CALLOC(dirty, sizeof(owner_work_t)) : NULL;
+  if (!slot_of || (dirty && !work)) {
+    CIV_FREE(slot_of);
+    CIV_FREE(work);
+    return 0; /* still dirty; tried again next refresh */
+  }
+  for (size_t s = 0; s < dirty; s++) work[s].ref_x = INT32_MIN;
+  slot_of[0] = -1;
+
+  int32_t width = map->width;
+  size_t tile_count = (size_t)map->width * map->height;
+  for (size_t i = 0; i < tile_count; i++) {
+    civ_owner_index_t o = civ_map_owner_at(map, i);
+    if (o == CIV_OWNER_NONE || o >= labels->capacity || slot_of[o] < 0) continue;
+    owner_work_t *w = &work[slot_of[o]];
+    int32_t x = (int32_t)(i % (size_t)width);
+    double y = (double)(i / (size_t)width);
+    if (w->ref_x == INT32_MIN) w->ref_x = x;
+    double dx = unwrap(x, w->ref_x, width);
+    w->n += 1.0;
+    w->sx += dx;
+    w->sy += y;
+    w->sxx += dx * dx;
+    w->sxy += dx * y;
+    w->syy += y * y;
+  }
+  for (size_t s = 0; s < dirty; s++)
+    if (work[s].n >= CIV_NATION_LABEL_MIN_TILES) solve_axis(&work[s]);
+
+  /* Second pass: the territory's extent across the axis, per bin */
+  for (size_t i = 0; i < tile_count; i++) {
+    civ_owner_index_t o = civ_map_owner_at(map, i);
+    if (o == CIV_OWNER_NONE || o >= labels->capacity || slot_of[o] < 0) continue;
+    owner_work_t *w = &work[slot_of[o]];
+    if (w->n < CIV_NATION_LABEL_MIN_TILES) continue;
+    double dx = unwrap((int32_t)(i % (size_t)width), w->ref_x, width) - w->cx;
+    double dy = (double)(i / (size_t)width) - w->cy;
+    double t = dx * w->ux + dy * w->uy;
+    int b = (int)floor((t + w->half) / (2.0 * w->half) * CIV_NATION_LABEL_BINS);
+    if (b < 0 || b >= CIV_NATION_LABEL_BINS) continue;
+    float s = (float)(dy * w->ux - dx * w->uy);
+    w->s_min[b] = MIN(w->s_min[b], s);
+    w->s_max[b] = MAX(w->s_max[b], s);
+    w->count[b]++;
+  }
+
+  for (uint32_t o = 1; o < labels->capacity; o++) {
+    if (slot_of[o] < 0) continue;
+    const owner_work_t *w = &work[slot_of[o]];
+    civ_nation_label_path_t *p = &labels->paths[o];
+    p->tiles = (uint32_t)w->n;
+    p->valid = w->n >= CIV_NATION_LABEL_MIN_TILES;
+    if (p->valid) build_path(p, w, width);
+    p->revision++;
+    labels->dirty[o] = 0;
+  }
+  labels->any_dirty = false;
+  labels->map_width = (uint32_t)width;
+  labels->refreshes++;
+  CIV_FREE(slot_of);
+  CIV_FREE(work);
+  return dirty;
+}
+
+const civ_nation_label_path_t *civ_nation_labels_path(const civ_nation_labels_t *labels,
+                                                      civ_owner_index_t owner) {
+  if (!labels || owner == CIV_OWNER_NONE || owner >= labels->capacity) return NULL;
+  const civ_nation_label_path_t *p = &labels->paths[owner];
+  return p->valid ? p : NULL;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file nation_lod.c
+ * @brief Per-nation tick intervals from diplomacy and distance
+ */
+
+#include "core/world/nation_lod.h"
+#include <math.h>
+
+/* Squared capital distance in degrees, longitude wrapping at the date line */
+static float capital_dist2(const civ_nation_t *a, const civ_nation_t *b) {
+  float dlon = fabsf(a->capital_lon - b->capital_lon);
+  if (dlon > 180.0f) dlon = 360.0f - dlon;
+  float dlat = a->capital_lat - b->capital_lat;
+  return dlon * dlon + dlat * dlat;
+}
+
+static uint8_t diplomatic_interval(const civ_diplomacy_system_t *ds,
+                                   int32_t player_slot, const civ_nation_t *n) {
+  if (!ds || player_slot < 0) return CIV_NATION_LOD_FAR;
+  civ_relation_id_t id = civ_diplomacy_relation_between(
+      ds, player_slot, civ_diplomacy_nation_index(ds, n->id));
+  if (id == CIV_RELATION_NONE) return CIV_NATION_LOD_FAR;
+  switch ((civ_relation_level_t)ds->rel.relation_level[id]) {
+  case CIV_RELATION_LEVEL_WAR:
+  case CIV_RELATION_LEVEL_ALLIED:
+    return CIV_NATION_LOD_NEAR;
+  case CIV_RELATION_LEVEL_HOSTILE:
+  case CIV_RELATION_LEVEL_FRIENDLY:
+    return CIV_NATION_LOD_MID;
+  default:
+    break;
+  }
+  return civ_diplomacy_pair_first_treaty(ds, id) >= 0 ? CIV_NATION_LOD_MID
+                                                      : CIV_NATION_LOD_FAR;
+}
+
+void civ_nation_lod_refresh(civ_nation_manager_t *mgr,
+                            const civ_diplomacy_system_t *ds, uint64_t update) {
+  if (!mgr) return;
+  int player = mgr->player_nation_index;
+  const civ_nation_t *home =
+      player >= 0 && player < mgr->count ? &mgr->nations[player] : NULL;
+  int32_t player_slot = home && ds ? civ_diplomacy_nation_index(ds, home->id) : -1;
+  const float s = mgr->lod_distance_scale > 0.0f ? mgr->lod_distance_scale : 1.0f;
+  const float near2 = CIV_NATION_LOD_NEAR_DEG * CIV_NATION_LOD_NEAR_DEG * s * s;
+  const float mid2 = CIV_NATION_LOD_MID_DEG * CIV_NATION_LOD_MID_DEG * s * s;
+
+  for (int i = 0; i < mgr->count; i++) {
+    civ_nation_t *n = &mgr->nations[i];
+    if (n->defunct) continue;
+    uint8_t interval = CIV_NATION_LOD_NEAR;
+    if (home && i != player) {
+      float d2 = capital_dist2(home, n);
+      interval = d2 <= near2  ? CIV_NATION_LOD_NEAR
+                 : d2 <= mid2 ? CIV_NATION_LOD_MID
+                              : CIV_NATION_LOD_FAR;
+      if (interval > CIV_NATION_LOD_NEAR)
+        interval = MIN(interval, diplomatic_interval(ds, player_slot, n));
+    }
+
+    civ_nation_lod_t *lod = &n->lod;
+    if (lod->interval == 0)
+      lod->next_tick = update + (uint64_t)i % interval; /* spread the ticks */
+    else if (interval < lod->interval)
+      lod->next_tick = update; /* promoted: tick now on what it banked */
+    lod->interval = interval;
+  }
+}
+
+bool civ_nation_lod_take(civ_nation_t *nation, uint64_t update, civ_float_t dt,
+                         civ_float_t *tick_dt) {
+  civ_nation_lod_t *lod = &nation->lod;
+  lod->banked_dt += dt;
+  if (lod->interval > 1 && update < lod->next_tick) return false;
+  *tick_dt = lod->banked_dt;
+  lod->banked_dt = 0.0;
+  lod->next_tick = update + (lod->interval ? lod->interval : 1);
+  lod->replan = true;
+  return true;
+}
@@ -5,6 +5,7 @@
 
 #include "core/world/nations_data.h"
 #include "common.h"
+#include "utils/mapped_file.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -23,48 +24,106 @@ civ_nations_data_t *civ_nations_data_create(void) {
 void civ_nations_data_destroy(civ_nations_data_t *nd) {
     if (!nd) return;
     free(nd->nations);
+    free(nd->name_slots);
     free(nd);
 }
 
-static uint32_t read_u32(FILE *f) {
-    uint32_t v;
-    fread(&v, 4, 1, f);
-    return v;
+/* ── Key indexes ──────────────────────────────────────────────── */
+
+typedef enum { KEY_NAME, KEY_ISO_A3, KEY_ISO_A2 } nation_key_t;
+
+static const char *key_of(const civ_nation_data_t *n, nation_key_t key) {
+    switch (key) {
+    case KEY_ISO_A3: return n->iso_a3;
+    case KEY_ISO_A2: return n->iso_a2;
+    default:         return n->name;
+    }
+}
+
+static uint32_t *slots_of(const civ_nations_data_t *nd, nation_key_t key) {
+    switch (key) {
+    case KEY_ISO_A3: return nd->iso_a3_slots;
+    case KEY_ISO_A2: return nd->iso_a2_slots;
+    default:         return nd->name_slots;
+    }
 }
 
-static uint16_t read_u16(FILE *f) {
-    uint16_t v;
-    fread(&v, 2, 1, f);
-    return v;
+static uint32_t hash_key(const char *s) {
+    uint32_t h = 2166136261u;
+    for (; *s; s++) {
+        h ^= (uint8_t)*s;
+        h *= 16777619u;
+    }
+    return h;
 }
 
-static uint8_t read_u8(FILE *f) {
-    uint8_t v;
-    fread(&v, 1, 1, f);
-    return v;
+/* Index of the first nation whose key equals s, or -1 */
+static int64_t find_key(const civ_nations_data_t *nd, nation_key_t key, const char *s) {
+    const uint32_t *slots = slots_of(nd, key);
+    if (!slots || !s[0]) return -1;
+    for (uint32_t i = hash_key(s) & nd->slot_mask;; i = (i + 1) & nd->slot_mask) {
+        uint32_t slot = slots[i];
+        if (slot == 0) return -1;
+        if (strcmp(key_of(&nd->nations[slot - 1], key), s) == 0) return slot - 1;
+    }
 }
 
-static void read_str(FILE *f, uint8_t len, char *out, size_t out_size) {
-    if (len >= out_size) len = (uint8_t)(out_size - 1);
-    if (len > 0) fread(out, 1, len, f);
-    out[len] = '\0';
+/* Rebuild all three indexes; on failure lookups find nothing */
+static void build_indexes(civ_nations_data_t *nd) {
+    free(nd->name_slots);
+    nd->name_slots = nd->iso_a3_slots = nd->iso_a2_slots = NULL;
+    nd->slot_mask = 0;
+
+    uint32_t size = 16;
+    while (size < nd->count * 2) size <<= 1;
+    uint32_t *slots = calloc((size_t)size * 3, sizeof(uint32_t));
+    if (!slots) {
+        civ_log(CIV_LOG_ERROR, "Nations data: no memory for lookup index");
+        return;
+    }
+    nd->name_slots = slots;
+    nd->iso_a3_slots = slots + size;
+    nd->iso_a2_slots = slots + 2 * (size_t)size;
+    nd->slot_mask = size - 1;
+
+    for (nation_key_t key = KEY_NAME; key <= KEY_ISO_A2; key++) {
+        uint32_t *table = slots_of(nd, key);
+        for (uint32_t n = 0; n < nd->count; n++) {
+            const char *s = key_of(&nd->nations[n], key);
+            /* Skip empty keys and keep the first of any duplicates */
+            if (!s[0] || find_key(nd, key, s) >= 0) continue;
+            uint32_t i = hash_key(s) & nd->slot_mask;
+            while (table[i] != 0) i = (i + 1) & nd->slot_mask;
+            table[i] = n + 1;
+        }
+    }
 }
 
 civ_result_t civ_nations_data_load(civ_nations_data_t *nd, const char *filepath) {
     if (!nd || !filepath) return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "NULL argument"};
 
-    FILE *f = fopen(filepath, "rb");
-    if (!f) return (civ_result_t){CIV_ERROR_IO, "Cannot open file"};
+    civ_mapped_file_t file;
+    if (!civ_mapped_file_open(&file, filepath))
+        return (civ_result_t){CIV_ERROR_IO, "Cannot open file"};
+    civ_result_t result = civ_nations_data_load_view(nd, file.data, file.size);
+    civ_mapped_file_close(&file);
+    return result;
+}
+
+civ_result_t civ_nations_data_load_view(civ_nations_data_t *nd, const uint8_t *data, size_t size) {
+    if (!nd) return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "NULL argument"};
+    civ_byte_reader_t r = civ_byte_reader_span(data, size);
 
-    uint32_t magic = read_u32(f);
-    if (magic != NATIONS_MAGIC) { fclose(f); return (civ_result_t){CIV_ERROR_INVALID_DATA, "Bad magic"}; }
-    uint32_t version = read_u32(f);
+    uint32_t magic = civ_byte_reader_u32(&r);
+    if (magic != NATIONS_MAGIC)
+        return (civ_result_t){CIV_ERROR_INVALID_DATA, "Bad magic"};
+    uint32_t version = civ_byte_reader_u32(&r);
     (void)version;
-    uint32_t count = read_u32(f);
+    uint32_t count = civ_byte_reader_u32(&r);
 
     if (count > nd->capacity) {
         civ_nation_data_t *tmp = realloc(nd->nations, count * sizeof(civ_nation_data_t));
-        if (!tmp) { fclose(f); return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "realloc"}; }
+        if (!tmp) return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "realloc"};
         nd->nations = tmp;
         nd->capacity = count;
     }
@@ -73,35 +132,39 @@ civ_result_t civ_nations_data_load(civ_nations_data_t *nd, const char *filepath)
     for (uint32_t i = 0; i < count; i++) {
         civ_nation_data_t *n = &nd->nations[i];
 
-        n->id = read_u32(f);
-
-        uint8_t iso_a3_len = read_u8(f);
-        read_str(f, iso_a3_len, n->iso_a3, sizeof(n->iso_a3));
-        uint8_t iso_a2_len = read_u8(f);
-        read_str(f, iso_a2_len, n->iso_a2, sizeof(n->iso_a2));
-
-        uint16_t name_len = read_u16(f);
-        read_str(f, (uint8_t)(name_len > 255 ? 255 : name_len), n->name, CIV_NATION_NAME_MAX);
-
-        n->color_rgb = read_u32(f);
-
-        uint8_t cont_len = read_u8(f);
-        read_str(f, cont_len, n->continent, sizeof(n->continent));
-        uint8_t reg_len = read_u8(f);
-        read_str(f, reg_len, n->region, sizeof(n->region));
-        uint8_t sub_len = read_u8(f);
-        read_str(f, sub_len, n->subregion, sizeof(n->subregion));
-
-        n->population_est = read_u32(f);
-        n->gdp_est_millions = read_u32(f);
-        fread(&n->capital_lon, 4, 1, f);
-        fread(&n->capital_lat, 4, 1, f);
-        fread(&n->centroid_lon, 4, 1, f);
-        fread(&n->centroid_lat, 4, 1, f);
-        fread(&n->area_sqkm, 4, 1, f);
+        n->id = civ_byte_reader_u32(&r);
+
+        uint8_t iso_a3_len = civ_byte_reader_u8(&r);
+        civ_byte_reader_str(&r, iso_a3_len, n->iso_a3, sizeof(n->iso_a3));
+        uint8_t iso_a2_len = civ_byte_reader_u8(&r);
+        civ_byte_reader_str(&r, iso_a2_len, n->iso_a2, sizeof(n->iso_a2));
+
+        uint16_t name_len = civ_byte_reader_u16(&r);
+        civ_byte_reader_str(&r, name_len, n->name, CIV_NATION_NAME_MAX);
+
+        n->color_rgb = civ_byte_reader_u32(&r);
+
+        uint8_t cont_len = civ_byte_reader_u8(&r);
+        civ_byte_reader_str(&r, cont_len, n->continent, sizeof(n->continent));
+        uint8_t reg_len = civ_byte_reader_u8(&r);
+        civ_byte_reader_str(&r, reg_len, n->region, sizeof(n->region));
+        uint8_t sub_len = civ_byte_reader_u8(&r);
+        civ_byte_reader_str(&r, sub_len, n->subregion, sizeof(n->subregion));
+
+        n->population_est = civ_byte_reader_u32(&r);
+        n->gdp_est_millions = civ_byte_reader_u32(&r);
+        n->capital_lon = civ_byte_reader_f32(&r);
+        n->capital_lat = civ_byte_reader_f32(&r);
+        n->centroid_lon = civ_byte_reader_f32(&r);
+        n->centroid_lat = civ_byte_reader_f32(&r);
+        n->area_sqkm = civ_byte_reader_f32(&r);
+        if (!r.ok) {
+            nd->count = i;
+            break;
+        }
     }
 
-    fclose(f);
+    build_indexes(nd);
     return (civ_result_t){CIV_OK, "Loaded"};
 }
 
@@ -115,19 +178,20 @@ const civ_nation_data_t *civ_nations_data_get_by_id(
 const civ_nation_data_t *civ_nations_data_get_by_iso(
     const civ_nations_data_t *nd, const char *iso_a3) {
     if (!nd || !iso_a3) return NULL;
-    for (uint32_t i = 0; i < nd->count; i++) {
-        if (strcmp(nd->nations[i].iso_a3, iso_a3) == 0)
-            return &nd->nations[i];
-    }
-    return NULL;
+    int64_t i = find_key(nd, KEY_ISO_A3, iso_a3);
+    return i >= 0 ? &nd->nations[i] : NULL;
+}
+
+const civ_nation_data_t *civ_nations_data_get_by_iso_a2(
+    const civ_nations_data_t *nd, const char *iso_a2) {
+    if (!nd || !iso_a2) return NULL;
+    int64_t i = find_key(nd, KEY_ISO_A2, iso_a2);
+    return i >= 0 ? &nd->nations[i] : NULL;
 }
 
 const civ_nation_data_t *civ_nations_data_get_by_name(
     const civ_nations_data_t *nd, const char *name) {
     if (!nd || !name) return NULL;
-    for (uint32_t i = 0; i < nd->count; i++) {
-        if (strcmp(nd->nations[i].name, name) == 0)
-            return &nd->nations[i];
-    }
-    return NULL;
+    int64_t i = find_key(nd, KEY_NAME, name);
+    return i >= 0 ? &nd->nations[i] : NULL;
 }
@@ -0,0 +1,594 @@
+/**
+ * @file ocean_regions.c
+ * @brief Square-bounded sea regions, border portals and endpoint A*
+ */
+#include "core/world/ocean_regions.h"
+#include "common.h"
+#include "core/simulation_engine/worker_pool.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define LOCAL_LAND   0xFFFFu
+#define LOCAL_UNSEEN 0xFFFEu
+#define CELL_TILES   (CIV_OCEAN_CELL * CIV_OCEAN_CELL)
+#define INF          CIV_PATH_NO_PATH
+#define NONE         UINT32_MAX
+#define MAX_SOURCES  9
+
+static const int32_t DX[8] = {1, -1, 0, 0, 1, -1, 1, -1};
+static const int32_t DY[8] = {0, 0, 1, -1, 1, 1, -1, -1};
+
+/* ── Binary heap of (key, node) ───────────────────────────────────── */
+
+typedef struct {
+  uint32_t key, node;
+} heap_entry_t;
+
+typedef struct {
+  heap_entry_t *items;
+  size_t count, capacity;
+} heap_t;
+
+static bool heap_push(heap_t *h, uint32_t key, uint32_t node) {
+  if (h->count >= h->capacity) {
+    size_t cap = h->capacity ? h->capacity * 2 : 256;
+    heap_entry_t *items = CIV_REALLOC(h->items, cap * sizeof(heap_entry_t));
+    if (!items) return false;
+    h->items = items;
+    h->capacity = cap;
+  }
+  size_t i = h->count++;
+  while (i > 0) {
+    size_t parent = (i - 1) / 2;
+    if (h->items[parent].key <= key) break;
+    h->items[i] = h->items[parent];
+    i = parent;
+  }
+  h->items[i] = (heap_entry_t){key, node};
+  return true;
+}
+
+static heap_entry_t heap_pop(heap_t *h) {
+  heap_entry_t top = h->items[0];
+  heap_entry_t last = h->items[--h->count];
+  size_t i = 0;
+  for (;;) {
+    size_t child = i * 2 + 1;
+    if (child >= h->count) break;
+    if (child + 1 < h->count && h->items[child + 1].key < h->items[child].key)
+      child++;
+    if (h->items[child].key >= last.key) break;
+    h->items[i] = h->items[child];
+    i = child;
+  }
+  if (h->count) h->items[i] = last;
+  return top;
+}
+
+/* ── Geometry ──────────────────────────────────────────────────────── */
+
+typedef struct {
+  int32_t x0, y0, w, h;
+} cell_rect_t;
+
+static cell_rect_t cell_rect(const civ_ocean_regions_t *o, uint32_t c) {
+  cell_rect_t r;
+  r.x0 = (int32_t)(c % (uint32_t)o->cols) * CIV_OCEAN_CELL;
+  r.y0 = (int32_t)(c / (uint32_t)o->cols) * CIV_OCEAN_CELL;
+  r.w = MIN(CIV_OCEAN_CELL, o->map->width - r.x0);
+  r.h = MIN(CIV_OCEAN_CELL, o->map->height - r.y0);
+  return r;
+}
+
+static uint32_t cell_of_tile(const civ_ocean_regions_t *o, uint32_t tile) {
+  int32_t x = (int32_t)(tile % (uint32_t)o->map->width);
+  int32_t y = (int32_t)(tile / (uint32_t)o->map->width);
+  return (uint32_t)((y / CIV_OCEAN_CELL) * o->cols + x / CIV_OCEAN_CELL);
+}
+
+/* Index within the square's CIV_OCEAN_CELL-wide scratch grid */
+static uint32_t local_index(const civ_ocean_regions_t *o, uint32_t tile) {
+  int32_t x = (int32_t)(tile % (uint32_t)o->map->width) % CIV_OCEAN_CELL;
+  int32_t y = (int32_t)(tile / (uint32_t)o->map->width) % CIV_OCEAN_CELL;
+  return (uint32_t)(y * CIV_OCEAN_CELL + x);
+}
+
+static uint32_t tile_at(const civ_map_t *m, int32_t x, int32_t y) {
+  return (uint32_t)y * (uint32_t)m->width + (uint32_t)x;
+}
+
+/* Octile distance in path cost, wrapping x; admissible at sea */
+static uint32_t heuristic(const civ_map_t *m, uint32_t a, uint32_t b) {
+  int32_t w = m->width;
+  int32_t dx = abs((int32_t)(a % (uint32_t)w) - (int32_t)(b % (uint32_t)w));
+  int32_t dy = abs((int32_t)(a / (uint32_t)w) - (int32_t)(b / (uint32_t)w));
+  dx = MIN(dx, w - dx);
+  uint32_t lo = (uint32_t)MIN(dx, dy), hi = (uint32_t)MAX(dx, dy);
+  return lo * CIV_PATH_COST_DIAGONAL + (hi - lo) * CIV_PATH_COST_STRAIGHT;
+}
+
+uint32_t civ_ocean_region_at(const civ_ocean_regions_t *o, uint32_t tile) {
+  if (!o || tile >= (uint32_t)o->map->width * (uint32_t)o->map->height ||
+      o->local[tile] == LOCAL_LAND)
+    return CIV_OCEAN_NO_REGION;
+  return o->cell_base[cell_of_tile(o, tile)] + o->local[tile];
+}
+
+/* ── Bounded search inside one region ──────────────────────────────── */
+
+/* Path cost within region from the sources to every tile of its square
+   (scratch grid, INF outside the region) */
+static void region_search(const civ_ocean_regions_t *o, uint32_t region,
+                          const uint32_t *src_tile, const uint32_t *src_cost,
+                          int src_count, uint32_t *dist, heap_t *heap) {
+  const civ_ocean_region_t *rg = &o->regions[region];
+  cell_rect_t r = cell_rect(o, rg->cell);
+  uint16_t id = (uint16_t)(region - o->cell_base[rg->cell]);
+  for (int32_t y = 0; y < r.h; y++)
+    for (int32_t x = 0; x < r.w; x++) dist[y * CIV_OCEAN_CELL + x] = INF;
+
+  heap->count = 0;
+  for (int s = 0; s < src_count; s++) {
+    uint32_t li = local_index(o, src_tile[s]);
+    if (src_cost[s] < dist[li]) {
+      dist[li] = src_cost[s];
+      heap_push(heap, src_cost[s], li);
+    }
+  }
+  while (heap->count) {
+    heap_entry_t top = heap_pop(heap);
+    if (top.key > dist[top.node]) continue;
+    int32_t lx = (int32_t)(top.node % CIV_OCEAN_CELL), ly = (int32_t)(top.node / CIV_OCEAN_CELL);
+    bool open[8];
+    for (int d = 0; d < 8; d++) {
+      int32_t nx = lx + DX[d], ny = ly + DY[d];
+      open[d] = nx >= 0 && ny >= 0 && nx < r.w && ny < r.h &&
+                o->local[tile_at(o->map, r.x0 + nx, r.y0 + ny)] == id;
+      if (!open[d]) continue;
+      /* No corner cutting: both orthogonal tiles must be open too */
+      if (d >= 4 && (!open[DX[d] > 0 ? 0 : 1] || !open[DY[d] > 0 ? 2 : 3])) continue;
+      uint32_t nd = top.key + (d < 4 ? CIV_PATH_COST_STRAIGHT : CIV_PATH_COST_DIAGONAL);
+      uint32_t ni = (uint32_t)(ny * CIV_OCEAN_CELL + nx);
+      if (nd < dist[ni]) {
+        dist[ni] = nd;
+        heap_push(heap, nd, ni);
+      }
+    }
+  }
+}
+
+static uint32_t endpoint_tile(const civ_ocean_regions_t *o, uint32_t e) {
+  const civ_ocean_portal_t *p = &o->portals[e >> 1];
+  return (e & 1) ? p->tile_b : p->tile_a;
+}
+
+static uint32_t endpoint_region(const civ_ocean_regions_t *o, uint32_t e) {
+  const civ_ocean_portal_t *p = &o->portals[e >> 1];
+  return (e & 1) ? p->region_b : p->region_a;
+}
+
+/* ── Build ─────────────────────────────────────────────────────────── */
+
+typedef struct {
+  civ_ocean_regions_t *o;
+  uint32_t *cell_counts;
+  bool failed;
+} build_t;
+
+/* Label the square's 4-connected water pieces */
+static void label_cell(void *ctx, int index) {
+  build_t *b = (build_t *)ctx;
+  civ_ocean_regions_t *o = b->o;
+  const civ_map_t *m = o->map;
+  cell_rect_t r = cell_rect(o, (uint32_t)index);
+  for (int32_t y = r.y0; y < r.y0 + r.h; y++)
+    for (int32_t x = r.x0; x < r.x0 + r.w; x++) {
+      uint32_t t = tile_at(m, x, y);
+      o->local[t] = civ_map_is_water_at(m, t) ? LOCAL_UNSEEN : LOCAL_LAND;
+    }
+
+  uint32_t stack[CELL_TILES];
+  uint16_t count = 0;
+  for (int32_t y = r.y0; y < r.y0 + r.h; y++)
+    for (int32_t x = r.x0; x < r.x0 + r.w; x++) {
+      uint32_t seed = tile_at(m, x, y);
+      if (o->local[seed] != LOCAL_UNSEEN) continue;
+      size_t top = 0;
+      o->local[seed] = count;
+      stack[top++] = seed;
+      while (top) {
+        uint32_t t = stack[--top];
+        int32_t tx = (int32_t)(t % (uint32_t)m->width), ty = (int32_t)(t / (uint32_t)m->width);
+        for (int d = 0; d < 4; d++) {
+          int32_t nx = tx + DX[d], ny = ty + DY[d];
+          if (nx < r.x0 || ny < r.y0 || nx >= r.x0 + r.w || ny >= r.y0 + r.h) continue;
+          uint32_t n = tile_at(m, nx, ny);
+          if (o->local[n] != LOCAL_UNSEEN) continue;
+          o->local[n] = count;
+          stack[top++] = n;
+        }
+      }
+      count++;
+    }
+  b->cell_counts[index] = count;
+}
+
+static bool beside_land(const civ_map_t *m, int32_t x, int32_t y) {
+  for (int d = 0; d < 8; d++) {
+    int32_t ny = y + DY[d];
+    if (ny < 0 || ny >= m->height) continue;
+    int32_t nx = (x + DX[d] + m->width) % m->width;
+    if (!civ_map_is_water_at(m, tile_at(m, nx, ny))) return true;
+  }
+  return false;
+}
+
+static void measure_cell(void *ctx, int index) {
+  build_t *b = (build_t *)ctx;
+  civ_ocean_regions_t *o = b->o;
+  cell_rect_t r = cell_rect(o, (uint32_t)index);
+  uint32_t base = o->cell_base[index];
+  for (uint32_t k = 0; k < b->cell_counts[index]; k++)
+    o->regions[base + k].cell = (uint32_t)index;
+  for (int32_t y = r.y0; y < r.y0 + r.h; y++)
+    for (int32_t x = r.x0; x < r.x0 + r.w; x++) {
+      uint16_t id = o->local[tile_at(o->map, x, y)];
+      if (id == LOCAL_LAND) continue;
+      civ_ocean_region_t *rg = &o->regions[base + id];
+      rg->tiles++;
+      if (beside_land(o->map, x, y)) rg->coast_tiles++;
+    }
+}
+
+static bool push_portal(civ_ocean_regions_t *o, uint32_t *capacity,
+                        uint32_t ta, uint32_t tb) {
+  if (o->portal_count >= *capacity) {
+    uint32_t cap = *capacity ? *capacity * 2 : 256;
+    civ_ocean_portal_t *p = CIV_REALLOC(o->portals, cap * sizeof(*p));
+    if (!p) return false;
+    o->portals = p;
+    *capacity = cap;
+  }
+  o->portals[o->portal_count++] = (civ_ocean_portal_t){
+      ta, tb, civ_ocean_region_at(o, ta), civ_ocean_region_at(o, tb)};
+  return true;
+}
+
+/* Walk one square border of len crossings, at_a/at_b giving the tiles of
+   crossing k; every run between the same two regions gets its portals */
+typedef struct {
+  int32_t x_a, y_a, x_b, y_b; /* crossing 0 */
+  int32_t step_x, step_y;
+  int32_t len;
+} border_t;
+
+static bool scan_border(civ_ocean_regions_t *o, uint32_t *capacity, border_t bd) {
+  const civ_map_t *m = o->map;
+  int32_t run = 0;
+  uint32_t run_a = NONE, run_b = NONE;
+  for (int32_t k = 0; k <= bd.len; k++) {
+    uint32_t ra = NONE, rb = NONE;
+    if (k < bd.len) {
+      ra = civ_ocean_region_at(o, tile_at(m, bd.x_a + k * bd.step_x, bd.y_a + k * bd.step_y));
+      rb = civ_ocean_region_at(o, tile_at(m, bd.x_b + k * bd.step_x, bd.y_b + k * bd.step_y));
+      if (ra == CIV_OCEAN_NO_REGION || rb == CIV_OCEAN_NO_REGION || ra == rb)
+        ra = rb = NONE;
+    }
+    if (run > 0 && (ra != run_a || rb != run_b)) {
+      int32_t chunks = (run + CIV_OCEAN_PORTAL_SPAN - 1) / CIV_OCEAN_PORTAL_SPAN;
+      int32_t start = k - run;
+      for (int32_t c = 0; c < chunks; c++) {
+        int32_t lo = start + c * run / chunks, hi = start + (c + 1) * run / chunks;
+        int32_t mid = (lo + hi) / 2;
+        if (!push_portal(o, capacity,
+                         tile_at(m, bd.x_a + mid * bd.step_x, bd.y_a + mid * bd.step_y),
+                         tile_at(m, bd.x_b + mid * bd.step_x, bd.y_b + mid * bd.step_y)))
+          return false;
+      }
+      run = 0;
+    }
+    if (ra != NONE) {
+      if (run == 0) {
+        run_a = ra;
+        run_b = rb;
+      }
+      run++;
+    }
+  }
+  return true;
+}
+
+static bool find_portals(civ_ocean_regions_t *o) {
+  uint32_t capacity = 0;
+  int32_t W = o->map->width, H = o->map->height;
+  for (uint32_t c = 0; c < (uint32_t)(o->cols * o->rows); c++) {
+    cell_rect_t r = cell_rect(o, c);
+    border_t east = {r.x0 + r.w - 1, r.y0, (r.x0 + r.w) % W, r.y0, 0, 1, r.h};
+    if (!scan_border(o, &capacity, east)) return false;
+    if (r.y0 + r.h < H) {
+      border_t south = {r.x0, r.y0 + r.h - 1, r.x0, r.y0 + r.h, 1, 0, r.w};
+      if (!scan_border(o, &capacity, south)) return false;
+    }
+  }
+  return true;
+}
+
+static bool index_endpoints(civ_ocean_regions_t *o) {
+  for (uint32_t p = 0; p < o->portal_count; p++) {
+    o->regions[o->portals[p].region_a].endpoint_count++;
+    o->regions[o->portals[p].region_b].endpoint_count++;
+  }
+  uint32_t next = 0;
+  size_t cost = 0;
+  for (uint32_t r = 0; r < o->region_count; r++) {
+    civ_ocean_region_t *rg = &o->regions[r];
+    rg->first_endpoint = next;
+    rg->first_cost = cost;
+    next += rg->endpoint_count;
+    cost += (size_t)rg->endpoint_count * rg->endpoint_count;
+    rg->endpoint_count = 0;
+
+    if (rg->coast_tiles == 0)
+      rg->kind = CIV_OCEAN_OPEN;
+    else if (rg->tiles <= CELL_TILES / 8 && rg->coast_tiles * 2 >= rg->tiles)
+      rg->kind = CIV_OCEAN_STRAIT; /* narrowed below if it joins nothing */
+    else
+      rg->kind = CIV_OCEAN_COASTAL;
+  }
+  o->region_endpoints = CIV_MALLOC((size_t)MAX(next, 1) * sizeof(uint32_t));
+  o->costs = CIV_MALLOC(MAX(cost, (size_t)1) * sizeof(uint32_t));
+  o->cost_count = cost;
+  if (!o->region_endpoints || !o->costs) return false;
+  for (uint32_t e = 0; e < 2 * o->portal_count; e++) {
+    civ_ocean_region_t *rg = &o->regions[endpoint_region(o, e)];
+    o->region_endpoints[rg->first_endpoint + rg->endpoint_count++] = e;
+  }
+  for (uint32_t r = 0; r < o->region_count; r++)
+    if (o->regions[r].kind == CIV_OCEAN_STRAIT && o->regions[r].endpoint_count < 2)
+      o->regions[r].kind = CIV_OCEAN_COASTAL;
+  return true;
+}
+
+/* Endpoint to endpoint costs of every region in the square */
+static void cost_cell(void *ctx, int index) {
+  build_t *b = (build_t *)ctx;
+  civ_ocean_regions_t *o = b->o;
+  uint32_t *dist = CIV_MALLOC(CELL_TILES * sizeof(uint32_t));
+  heap_t heap = {0};
+  if (!dist) {
+    b->failed = true;
+    return;
+  }
+  uint32_t base = o->cell_base[index];
+  for (uint32_t k = 0; k < b->cell_counts[index]; k++) {
+    const civ_ocean_region_t *rg = &o->regions[base + k];
+    const uint32_t *eps = &o->region_endpoints[rg->first_endpoint];
+    for (uint32_t i = 0; i < rg->endpoint_count; i++) {
+      uint32_t tile = endpoint_tile(o, eps[i]), zero = 0;
+      region_search(o, base + k, &tile, &zero, 1, dist, &heap);
+      uint32_t *row = &o->costs[rg->first_cost + (size_t)i * rg->endpoint_count];
+      for (uint32_t j = 0; j < rg->endpoint_count; j++)
+        row[j] = dist[local_index(o, endpoint_tile(o, eps[j]))];
+    }
+  }
+  CIV_FREE(heap.items);
+  CIV_FREE(dist);
+}
+
+civ_ocean_regions_t *civ_ocean_regions_create(const civ_map_t *map,
+                                              struct civ_worker_pool *pool) {
+  if (!map || !map->tiles) return NULL;
+  civ_ocean_regions_t *o = CIV_CALLOC(1, sizeof(civ_ocean_regions_t));
+  if (!o) return NULL;
+  o->map = map;
+  o->cols = (map->width + CIV_OCEAN_CELL - 1) / CIV_OCEAN_CELL;
+  o->rows = (map->height + CIV_OCEAN_CELL - 1) / CIV_OCEAN_CELL;
+  int cells = o->cols * o->rows;
+  o->local = CIV_MALLOC((size_t)map->width * map->height * sizeof(uint16_t));
+  o->cell_base = CIV_MALLOC(((size_t)cells + 1) * sizeof(uint32_t));
+  build_t b = {o, CIV_MALLOC((size_t)cells * sizeof(uint32_t)), false};
+  if (!o->local || !o->cell_base || !b.cell_counts) goto fail;
+
+  civ_worker_pool_parallel_for(pool, cells, label_cell, &b);
+  uint32_t regions = 0;
+  for (int c = 0; c < cells; c++) {
+    o->cell_base[c] = regions;
+    regions += b.cell_counts[c];
+  }
+  o->cell_base[cells] = regions;
+  o->region_count = regions;
+  o->regions = CIV_CALLOC(MAX(regions, 1u), sizeof(civ_ocean_region_t));
+  if (!o->regions) goto fail;
+  civ_worker_pool_parallel_for(pool, cells, measure_cell, &b);
+
+  if (!find_portals(o) || !index_endpoints(o)) goto fail;
+  civ_worker_pool_parallel_for(pool, cells, cost_cell, &b);
+  if (b.failed) goto fail;
+
+  CIV_FREE(b.cell_counts);
+  civ_log(CIV_LOG_INFO, "Ocean regions: %u regions, %u portals, %zu costs",
+          o->region_count, o->portal_count, o->cost_count);
+  return o;
+
+fail:
+  civ_log(CIV_LOG_ERROR, "Failed to build ocean regions");
+  CIV_FREE(b.cell_counts);
+  civ_ocean_regions_destroy(o);
+  return NULL;
+}
+
+void civ_ocean_regions_destroy(civ_ocean_regions_t *o) {
+  if (!o) return;
+  CIV_FREE(o->local);
+  CIV_FREE(o->cell_base);
+  CIV_FREE(o->regions);
+  CIV_FREE(o->portals);
+  CIV_FREE(o->region_endpoints);
+  CIV_FREE(o->costs);
+  CIV_FREE(o);
+}
+
+/* ── Query ─────────────────────────────────────────────────────────── */
+
+typedef struct {
+  uint32_t tile[MAX_SOURCES], cost[MAX_SOURCES], region[MAX_SOURCES];
+  int count;
+} sources_t;
+
+/* A water tile stands for itself; a land tile enters the sea through each
+   water tile beside it */
+static void tile_sources(const civ_ocean_regions_t *o, uint32_t tile, sources_t *s) {
+  s->count = 0;
+  uint32_t region = civ_ocean_region_at(o, tile);
+  if (region != CIV_OCEAN_NO_REGION) {
+    s->tile[0] = tile;
+    s->cost[0] = 0;
+    s->region[0] = region;
+    s->count = 1;
+    return;
+  }
+  const civ_map_t *m = o->map;
+  int32_t x = (int32_t)(tile % (uint32_t)m->width), y = (int32_t)(tile / (uint32_t)m->width);
+  for (int d = 0; d < 8; d++) {
+    int32_t ny = y + DY[d];
+    if (ny < 0 || ny >= m->height) continue;
+    uint32_t n = tile_at(m, (x + DX[d] + m->width) % m->width, ny);
+    uint32_t r = civ_ocean_region_at(o, n);
+    if (r == CIV_OCEAN_NO_REGION) continue;
+    s->tile[s->count] = n;
+    s->cost[s->count] = d < 4 ? CIV_PATH_COST_STRAIGHT : CIV_PATH_COST_DIAGONAL;
+    s->region[s->count++] = r;
+  }
+}
+
+/* Search every region among the sources once, from its own sources */
+typedef void (*region_visit_fn)(const civ_ocean_regions_t *o, uint32_t region,
+                                const uint32_t *dist, void *user);
+
+static void search_sources(const civ_ocean_regions_t *o, const sources_t *s,
+                           uint32_t *dist, heap_t *heap, region_visit_fn visit,
+                           void *user) {
+  bool done[MAX_SOURCES] = {false};
+  for (int i = 0; i < s->count; i++) {
+    if (done[i]) continue;
+    uint32_t tiles[MAX_SOURCES], costs[MAX_SOURCES];
+    int n = 0;
+    for (int j = i; j < s->count; j++) {
+      if (s->region[j] != s->region[i]) continue;
+      done[j] = true;
+      tiles[n] = s->tile[j];
+      costs[n++] = s->cost[j];
+    }
+    region_search(o, s->region[i], tiles, costs, n, dist, heap);
+    visit(o, s->region[i], dist, user);
+  }
+}
+
+typedef struct {
+  uint32_t *value;          /* per endpoint */
+  const sources_t *other;   /* the far end's sources, for a direct route */
+  uint32_t direct;
+} seed_t;
+
+static void seed_endpoints(const civ_ocean_regions_t *o, uint32_t region,
+                           const uint32_t *dist, void *user) {
+  seed_t *s = (seed_t *)user;
+  const civ_ocean_region_t *rg = &o->regions[region];
+  for (uint32_t k = 0; k < rg->endpoint_count; k++) {
+    uint32_t e = o->region_endpoints[rg->first_endpoint + k];
+    s->value[e] = MIN(s->value[e], dist[local_index(o, endpoint_tile(o, e))]);
+  }
+  if (!s->other) return;
+  for (int j = 0; j < s->other->count; j++) {
+    if (s->other->region[j] != region) continue;
+    uint32_t d = dist[local_index(o, s->other->tile[j])];
+    if (d != INF) s->direct = MIN(s->direct, d + s->other->cost[j]);
+  }
+}
+
+bool civ_ocean_find(const civ_ocean_regions_t *o, civ_ocean_request_t *req) {
+  if (!req) return false;
+  req->cost = CIV_PATH_NO_PATH;
+  req->waypoint_count = 0;
+  uint32_t n = o ? (uint32_t)o->map->width * (uint32_t)o->map->height : 0;
+  if (!o || req->start >= n || req->goal >= n) return false;
+
+  sources_t from, to;
+  tile_sources(o, req->start, &from);
+  tile_sources(o, req->goal, &to);
+  if (from.count == 0 || to.count == 0) return false;
+
+  uint32_t endpoints = 2 * o->portal_count;
+  uint32_t *g = CIV_MALLOC((size_t)MAX(endpoints, 1u) * 3 * sizeof(uint32_t));
+  uint32_t *dist = CIV_MALLOC(CELL_TILES * sizeof(uint32_t));
+  heap_t heap = {0};
+  if (!g || !dist) {
+    CIV_FREE(g);
+    CIV_FREE(dist);
+    return false;
+  }
+  uint32_t *to_goal = g + endpoints, *parent = g + 2 * (size_t)endpoints;
+  for (uint32_t e = 0; e < endpoints; e++) {
+    g[e] = to_goal[e] = INF;
+    parent[e] = NONE;
+  }
+
+  seed_t start = {g, &to, INF}, goal = {to_goal, NULL, INF};
+  search_sources(o, &from, dist, &heap, seed_endpoints, &start);
+  search_sources(o, &to, dist, &heap, seed_endpoints, &goal);
+
+  /* A* over endpoints: across a portal, or to another endpoint of the
+     same region at its cached cost */
+  heap.count = 0;
+  for (uint32_t e = 0; e < endpoints; e++)
+    if (g[e] != INF) heap_push(&heap, g[e] + heuristic(o->map, endpoint_tile(o, e), req->goal), e);
+  uint32_t best = start.direct, best_end = NONE;
+  while (heap.count) {
+    heap_entry_t top = heap_pop(&heap);
+    if (top.key >= best) break;
+    uint32_t e = top.node;
+    if (top.key != g[e] + heuristic(o->map, endpoint_tile(o, e), req->goal)) continue;
+    if (to_goal[e] != INF && g[e] + to_goal[e] < best) {
+      best = g[e] + to_goal[e];
+      best_end = e;
+    }
+
+    uint32_t across = e ^ 1u, nd = g[e] + CIV_PATH_COST_STRAIGHT;
+    if (nd < g[across]) {
+      g[across] = nd;
+      parent[across] = e;
+      heap_push(&heap, nd + heuristic(o->map, endpoint_tile(o, across), req->goal), across);
+    }
+    const civ_ocean_region_t *rg = &o->regions[endpoint_region(o, e)];
+    const uint32_t *eps = &o->region_endpoints[rg->first_endpoint];
+    uint32_t slot = 0;
+    while (eps[slot] != e) slot++;
+    const uint32_t *row = &o->costs[rg->first_cost + (size_t)slot * rg->endpoint_count];
+    for (uint32_t j = 0; j < rg->endpoint_count; j++) {
+      if (row[j] == INF || j == slot) continue;
+      nd = g[e] + row[j];
+      uint32_t v = eps[j];
+      if (nd < g[v]) {
+        g[v] = nd;
+        parent[v] = e;
+        heap_push(&heap, nd + heuristic(o->map, endpoint_tile(o, v), req->goal), v);
+      }
+    }
+  }
+
+  req->cost = best;
+  if (best != INF && best_end != NONE && req->waypoints && req->waypoint_capacity) {
+    /* The chain runs goal to start; write it the other way round */
+    uint32_t length = 0;
+    for (uint32_t e = best_end; e != NONE; e = parent[e]) length++;
+    uint32_t skip = length > req->waypoint_capacity ? length - req->waypoint_capacity : 0;
+    uint32_t at = length - skip;
+    req->waypoint_count = at;
+    for (uint32_t e = best_end, k = 0; e != NONE; e = parent[e], k++)
+      if (k >= skip) req->waypoints[--at] = endpoint_tile(o, e);
+  }
+  CIV_FREE(heap.items);
+  CIV_FREE(dist);
+  CIV_FREE(g);
+  return best != INF;
+}
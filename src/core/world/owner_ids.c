@@ -0,0 +1,122 @@
+/**
+ * @file owner_ids.c
+ * @brief Open-addressing intern table for territory owner ids
+ */
+#include "core/world/owner_ids.h"
+#include "common.h"
+#include <string.h>
+
+typedef char civ_owner_name_t[STRING_SHORT_LEN];
+
+static struct {
+  civ_owner_name_t  *names;   /* names[0] is the unclaimed slot */
+  uint32_t           count;
+  uint32_t           capacity;
+  civ_owner_index_t *slots;   /* hash -> index, CIV_OWNER_NONE = empty */
+  uint32_t           slot_mask;
+} s_owners;
+
+static uint32_t hash_id(const char *id) {
+  /* FNV-1a over the stored prefix, so truncated ids still match */
+  uint32_t h = 2166136261u;
+  const unsigned char *p = (const unsigned char *)id;
+  for (size_t n = 0; *p && n < STRING_SHORT_LEN - 1; p++, n++) {
+    h ^= *p;
+    h *= 16777619u;
+  }
+  return h;
+}
+
+static bool grow_slots(uint32_t want) {
+  uint32_t size = 64;
+  while (size < want * 2) size <<= 1;
+  civ_owner_index_t *slots = CIV_CALLOC(size, sizeof(*slots));
+  if (!slots) return false;
+  for (uint32_t i = 1; i < s_owners.count; i++) {
+    uint32_t h = hash_id(s_owners.names[i]) & (size - 1);
+    while (slots[h] != CIV_OWNER_NONE) h = (h + 1) & (size - 1);
+    slots[h] = (civ_owner_index_t)i;
+  }
+  CIV_FREE(s_owners.slots);
+  s_owners.slots = slots;
+  s_owners.slot_mask = size - 1;
+  return true;
+}
+
+static bool ensure_init(void) {
+  if (s_owners.names) return true;
+  s_owners.capacity = 256;
+  s_owners.names = CIV_CALLOC(s_owners.capacity, sizeof(civ_owner_name_t));
+  if (!s_owners.names) return false;
+  s_owners.count = 1;
+  if (!grow_slots(s_owners.capacity)) {
+    CIV_FREE(s_owners.names);
+    s_owners.names = NULL;
+    return false;
+  }
+  return true;
+}
+
+static civ_owner_index_t lookup(const char *id, uint32_t *slot_out) {
+  uint32_t h = hash_id(id) & s_owners.slot_mask;
+  for (;;) {
+    civ_owner_index_t idx = s_owners.slots[h];
+    if (idx == CIV_OWNER_NONE) break;
+    if (strncmp(s_owners.names[idx], id, STRING_SHORT_LEN - 1) == 0) return idx;
+    h = (h + 1) & s_owners.slot_mask;
+  }
+  if (slot_out) *slot_out = h;
+  return CIV_OWNER_NONE;
+}
+
+civ_owner_index_t civ_owner_intern(const char *id) {
+  if (!id || !id[0] || !ensure_init()) return CIV_OWNER_NONE;
+
+  uint32_t slot = 0;
+  civ_owner_index_t idx = lookup(id, &slot);
+  if (idx != CIV_OWNER_NONE) return idx;
+  if (s_owners.count > CIV_OWNER_MAX - 1) {
+    civ_log(CIV_LOG_WARNING, "Owner id table full, dropping '%s'", id);
+    return CIV_OWNER_NONE;
+  }
+
+  if (s_owners.count == s_owners.capacity) {
+    uint32_t cap = s_owners.capacity * 2;
+    if (cap > CIV_OWNER_MAX) cap = CIV_OWNER_MAX;
+    civ_owner_name_t *names = CIV_REALLOC(s_owners.names, cap * sizeof(civ_owner_name_t));
+    if (!names) return CIV_OWNER_NONE;
+    s_owners.names = names;
+    s_owners.capacity = cap;
+  }
+  /* Keep the hash table at most half full */
+  if ((s_owners.count + 1) * 2 > s_owners.slot_mask + 1) {
+    if (!grow_slots(s_owners.count + 1)) return CIV_OWNER_NONE;
+    lookup(id, &slot);
+  }
+
+  idx = (civ_owner_index_t)s_owners.count++;
+  strncpy(s_owners.names[idx], id, STRING_SHORT_LEN - 1);
+  s_owners.names[idx][STRING_SHORT_LEN - 1] = '\0';
+  s_owners.slots[slot] = idx;
+  return idx;
+}
+
+civ_owner_index_t civ_owner_find(const char *id) {
+  if (!id || !id[0] || !s_owners.names) return CIV_OWNER_NONE;
+  return lookup(id, NULL);
+}
+
+const char *civ_owner_name(civ_owner_index_t index) {
+  if (index == CIV_OWNER_NONE || index >= s_owners.count) return "";
+  return s_owners.names[index];
+}
+
+uint32_t civ_owner_count(void) {
+  return s_owners.names ? s_owners.count : 1;
+}
+
+void civ_owner_reset(void) {
+  CIV_FREE(s_owners.names);
+  CIV_FREE(s_owners.slots);
+  memset(&s_owners, 0, sizeof(s_owners));
+}
@@ -0,0 +1,464 @@
+/**
+ * @file path_service.c
+ * @brief Path query batches: collapse on submit, solve on the pool, publish
+ */
+#include "core/world/path_service.h"
+#include "common.h"
+#include "core/simulation_engine/worker_pool.h"
+#include <SDL3/SDL.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* One search, shared by every query with its layer, start and goal */
+typedef struct {
+  uint32_t start, goal;
+  uint8_t  layer;
+  bool     cached;       /* copied from the previous apply, not searched */
+  uint32_t max_steps;    /* longest any query asked for */
+  uint32_t askers;       /* queries sharing it */
+  uint32_t revision;     /* layer revision the answer holds for */
+  size_t   path_offset;  /* into the batch's steps */
+  uint32_t path_length, cost;
+} search_t;
+
+#define NO_LEAD UINT32_MAX
+
+/* A ticket with a lead rides its search from one step away: its route is
+   the step onto the search's start, then the search's path, written into
+   its own steps by the solve */
+typedef struct {
+  uint32_t           search;
+  uint32_t           max_steps;
+  civ_path_done_fn_t done;
+  void              *user_data;
+  uint32_t           lead;        /* own start, or NO_LEAD */
+  size_t             path_offset; /* lead only, from here on */
+  uint32_t           path_length, cost;
+} ticket_t;
+
+/* Tickets first_ticket.. are contiguous: each batch takes every ticket
+   issued between two kicks */
+typedef struct {
+  search_t         *searches;
+  uint32_t          search_count, search_capacity;
+  ticket_t         *tickets;
+  uint32_t          ticket_count, ticket_capacity;
+  uint32_t         *slots;   /* key hash -> search index + 1, 0 = empty */
+  uint32_t          slot_mask;
+  uint32_t         *steps;
+  uint32_t          followers; /* tickets with a lead */
+  uint32_t          own_searches; /* followers that could not ride */
+  civ_path_ticket_t first_ticket;
+} batch_t;
+
+struct civ_path_service {
+  civ_pathfinder_t        *layers[CIV_PATH_SERVICE_LAYERS];
+  int                      layer_count;
+  SDL_SpinLock             lock;      /* pending and next_ticket */
+  batch_t                  pending;   /* taking submissions */
+  batch_t                  flight;    /* kicked, being solved */
+  batch_t                  published; /* readable results */
+  civ_path_ticket_t        next_ticket;
+  bool                     in_flight;
+  SDL_AtomicInt            outstanding;
+  civ_worker_pool_t       *pool;
+  civ_path_service_stats_t stats;
+};
+
+static uint32_t key_hash(uint8_t layer, uint32_t start, uint32_t goal) {
+  uint64_t k = ((uint64_t)start << 32 | goal) ^ ((uint64_t)layer << 59);
+  k ^= k >> 33;
+  k *= 0xff51afd7ed558ccdull;
+  k ^= k >> 33;
+  return (uint32_t)k;
+}
+
+/* Octile distance in straight steps, wrapping x */
+static uint32_t step_distance(const civ_map_t *map, uint32_t a, uint32_t b) {
+  int32_t w = map->width;
+  int32_t dx = abs((int32_t)(a % (uint32_t)w) - (int32_t)(b % (uint32_t)w));
+  int32_t dy = abs((int32_t)(a / (uint32_t)w) - (int32_t)(b / (uint32_t)w));
+  dx = MIN(dx, w - dx);
+  int32_t lo = MIN(dx, dy), hi = MAX(dx, dy);
+  return (uint32_t)lo * CIV_PATH_COST_DIAGONAL +
+         (uint32_t)(hi - lo) * CIV_PATH_COST_STRAIGHT;
+}
+
+static void batch_free(batch_t *b) {
+  CIV_FREE(b->searches);
+  CIV_FREE(b->tickets);
+  CIV_FREE(b->slots);
+  CIV_FREE(b->steps);
+  memset(b, 0, sizeof(*b));
+}
+
+static search_t *batch_find(const batch_t *b, uint8_t layer, uint32_t start,
+                            uint32_t goal) {
+  if (!b->slots) return NULL;
+  for (uint32_t h = key_hash(layer, start, goal) & b->slot_mask; b->slots[h];
+       h = (h + 1) & b->slot_mask) {
+    search_t *s = &b->searches[b->slots[h] - 1];
+    if (s->layer == layer && s->start == start && s->goal == goal) return s;
+  }
+  return NULL;
+}
+
+/* A search for goal starting one step from start and no farther from
+   goal, for start to ride; neighbours are tried in a fixed order */
+static search_t *batch_find_near(const batch_t *b, const civ_map_t *map,
+                                 uint8_t layer, uint32_t start, uint32_t goal) {
+  static const int DX[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+  static const int DY[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+  if (!b->slots) return NULL;
+  int32_t w = map->width;
+  int32_t x = (int32_t)(start % (uint32_t)w), y = (int32_t)(start / (uint32_t)w);
+  uint32_t own = step_distance(map, start, goal);
+  for (int d = 0; d < 8; d++) {
+    int32_t ny = y + DY[d];
+    if (ny < 0 || ny >= map->height) continue;
+    uint32_t n = (uint32_t)ny * (uint32_t)w + (uint32_t)((x + DX[d] + w) % w);
+    search_t *s = batch_find(b, layer, n, goal);
+    if (s && step_distance(map, n, goal) <= own) return s;
+  }
+  return NULL;
+}
+
+/* Keep the slot table at most half full */
+static bool reserve_slots(batch_t *b, uint32_t searches) {
+  if (b->slots && (size_t)searches * 2 <= (size_t)b->slot_mask + 1)
+    return true;
+  uint32_t size = 64;
+  while (size < searches * 2) size <<= 1;
+  uint32_t *slots = CIV_CALLOC(size, sizeof(uint32_t));
+  if (!slots) return false;
+  for (uint32_t i = 0; i < b->search_count; i++) {
+    const search_t *s = &b->searches[i];
+    uint32_t h = key_hash(s->layer, s->start, s->goal) & (size - 1);
+    while (slots[h]) h = (h + 1) & (size - 1);
+    slots[h] = i + 1;
+  }
+  CIV_FREE(b->slots);
+  b->slots = slots;
+  b->slot_mask = size - 1;
+  return true;
+}
+
+static bool grow(void **buf, uint32_t *capacity, uint32_t need, size_t elem) {
+  if (need <= *capacity) return true;
+  uint32_t cap = *capacity ? *capacity * 2 : 64;
+  while (cap < need) cap *= 2;
+  void *p = CIV_REALLOC(*buf, (size_t)cap * elem);
+  if (!p) return false;
+  *buf = p;
+  *capacity = cap;
+  return true;
+}
+
+civ_path_service_t *civ_path_service_create(void) {
+  civ_path_service_t *svc = CIV_CALLOC(1, sizeof(civ_path_service_t));
+  if (!svc) return NULL;
+  svc->next_ticket = 1;
+  return svc;
+}
+
+static void wait_flight(civ_path_service_t *svc) {
+  if (svc->pool)
+    civ_worker_pool_wait_counter(svc->pool, &svc->outstanding);
+}
+
+void civ_path_service_destroy(civ_path_service_t *svc) {
+  if (!svc) return;
+  if (svc->in_flight) wait_flight(svc);
+  batch_free(&svc->pending);
+  batch_free(&svc->flight);
+  batch_free(&svc->published);
+  CIV_FREE(svc);
+}
+
+int civ_path_service_add_layer(civ_path_service_t *svc, civ_pathfinder_t *pf) {
+  if (!svc || !pf || svc->layer_count >= CIV_PATH_SERVICE_LAYERS) return -1;
+  svc->layers[svc->layer_count] = pf;
+  return svc->layer_count++;
+}
+
+/* The ticket for query in the pending batch; caller holds the lock */
+static civ_path_ticket_t submit_locked(civ_path_service_t *svc,
+                                       const civ_path_query_t *query,
+                                       civ_path_done_fn_t done,
+                                       void *user_data) {
+  batch_t *b = &svc->pending;
+  if (!grow((void **)&b->tickets, &b->ticket_capacity, b->ticket_count + 1,
+            sizeof(ticket_t)))
+    return CIV_PATH_TICKET_NONE;
+
+  uint32_t lead = NO_LEAD;
+  uint32_t need = query->max_steps;
+  search_t *s = batch_find(b, query->layer, query->start, query->goal);
+  if (!s && query->start != query->goal) {
+    s = batch_find_near(b, svc->layers[query->layer]->map, query->layer,
+                        query->start, query->goal);
+    if (s) {
+      lead = query->start;
+      need = need ? need - 1 : 0; /* the lead step is its own */
+      b->followers++;
+      svc->stats.nearby++;
+    }
+  }
+  if (s) {
+    svc->stats.collapsed++;
+  } else {
+    if (!grow((void **)&b->searches, &b->search_capacity, b->search_count + 1,
+              sizeof(search_t)) ||
+        !reserve_slots(b, b->search_count + 1))
+      return CIV_PATH_TICKET_NONE;
+    s = &b->searches[b->search_count];
+    memset(s, 0, sizeof(*s));
+    s->start = query->start;
+    s->goal = query->goal;
+    s->layer = query->layer;
+    uint32_t h = key_hash(s->layer, s->start, s->goal) & b->slot_mask;
+    while (b->slots[h]) h = (h + 1) & b->slot_mask;
+    b->slots[h] = ++b->search_count;
+  }
+  s->max_steps = MAX(s->max_steps, need);
+  s->askers++;
+
+  if (b->ticket_count == 0) b->first_ticket = svc->next_ticket;
+  b->tickets[b->ticket_count++] = (ticket_t){
+      (uint32_t)(s - b->searches), query->max_steps, done, user_data, lead,
+      0, 0, CIV_PATH_NO_PATH};
+  svc->stats.submitted++;
+  return svc->next_ticket++;
+}
+
+civ_path_ticket_t civ_path_service_submit(civ_path_service_t *svc,
+                                          const civ_path_query_t *query,
+                                          civ_path_done_fn_t done,
+                                          void *user_data) {
+  if (!svc || !query || query->layer >= svc->layer_count)
+    return CIV_PATH_TICKET_NONE;
+  const civ_map_t *map = svc->layers[query->layer]->map;
+  size_t tiles = (size_t)map->width * map->height;
+  if (query->start >= tiles || query->goal >= tiles)
+    return CIV_PATH_TICKET_NONE;
+
+  SDL_LockSpinlock(&svc->lock);
+  civ_path_ticket_t ticket = submit_locked(svc, query, done, user_data);
+  SDL_UnlockSpinlock(&svc->lock);
+  return ticket;
+}
+
+/* ── Solving ───────────────────────────────────────────────────────── */
+
+/* Each layer's searches as one pathfinder batch, writing into steps */
+static void solve(civ_path_service_t *svc, batch_t *b) {
+  civ_path_request_t *reqs =
+      CIV_MALLOC((size_t)MAX(b->search_count, 1) * sizeof(civ_path_request_t));
+  uint32_t *which = CIV_MALLOC((size_t)MAX(b->search_count, 1) * sizeof(uint32_t));
+  for (int layer = 0; layer < svc->layer_count; layer++) {
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < b->search_count; i++) {
+      search_t *s = &b->searches[i];
+      if (s->layer != layer || s->cached) continue;
+      if (!reqs || !which) {
+        s->cost = CIV_PATH_NO_PATH;
+        continue;
+      }
+      reqs[n] = (civ_path_request_t){
+          s->start, s->goal, b->steps ? b->steps + s->path_offset : NULL,
+          s->max_steps, 0, CIV_PATH_NO_PATH};
+      which[n++] = i;
+    }
+    if (n == 0) continue;
+    civ_pathfinder_find_batch(svc->layers[layer], reqs, n, svc->pool);
+    for (uint32_t k = 0; k < n; k++) {
+      search_t *s = &b->searches[which[k]];
+      s->path_length = reqs[k].path_length;
+      s->cost = reqs[k].cost;
+    }
+  }
+  CIV_FREE(reqs);
+  CIV_FREE(which);
+}
+
+/* Followers take their lead step and copy their search's path after it;
+   one whose step the layer cannot take is searched on its own */
+static void solve_followers(civ_path_service_t *svc, batch_t *b) {
+  civ_path_request_t *reqs =
+      CIV_MALLOC((size_t)b->followers * sizeof(civ_path_request_t));
+  uint32_t *which = CIV_MALLOC((size_t)b->followers * sizeof(uint32_t));
+  for (int layer = 0; layer < svc->layer_count; layer++) {
+    civ_pathfinder_t *pf = svc->layers[layer];
+    bool prepared = false;
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < b->ticket_count; i++) {
+      ticket_t *t = &b->tickets[i];
+      const search_t *s = &b->searches[t->search];
+      if (t->lead == NO_LEAD || s->layer != layer) continue;
+      if (!prepared) {
+        civ_pathfinder_prepare(pf, svc->pool); /* all searches cached */
+        prepared = true;
+      }
+      uint32_t *out = b->steps ? b->steps + t->path_offset : NULL;
+      uint32_t step = civ_pathfinder_step_cost(pf, t->lead, s->start);
+      if (step != CIV_PATH_NO_PATH) {
+        t->path_length = 0;
+        t->cost = s->cost == CIV_PATH_NO_PATH
+                      ? CIV_PATH_NO_PATH
+                      : (uint32_t)MIN((uint64_t)step + s->cost,
+                                      (uint64_t)CIV_PATH_NO_PATH - 1);
+        if (out && t->max_steps && t->cost != CIV_PATH_NO_PATH) {
+          uint32_t copy = MIN(s->path_length, t->max_steps - 1);
+          out[0] = s->start;
+          memcpy(out + 1, b->steps + s->path_offset, copy * sizeof(uint32_t));
+          t->path_length = copy + 1;
+        }
+        continue;
+      }
+      if (!reqs || !which) {
+        t->path_length = 0;
+        t->cost = CIV_PATH_NO_PATH;
+        continue;
+      }
+      reqs[n] = (civ_path_request_t){t->lead, s->goal, out,
+                                     out ? t->max_steps : 0, 0, CIV_PATH_NO_PATH};
+      which[n++] = i;
+    }
+    if (n == 0) continue;
+    civ_pathfinder_find_batch(pf, reqs, n, svc->pool);
+    for (uint32_t k = 0; k < n; k++) {
+      ticket_t *t = &b->tickets[which[k]];
+      t->path_length = reqs[k].path_length;
+      t->cost = reqs[k].cost;
+    }
+    b->own_searches += n;
+  }
+  CIV_FREE(reqs);
+  CIV_FREE(which);
+}
+
+static void solve_job(void *arg) {
+  civ_path_service_t *svc = arg;
+  solve(svc, &svc->flight);
+  if (svc->flight.followers) solve_followers(svc, &svc->flight);
+  SDL_AddAtomicInt(&svc->outstanding, -1);
+}
+
+void civ_path_service_kick(civ_path_service_t *svc, civ_worker_pool_t *pool) {
+  if (!svc || svc->in_flight) return;
+
+  SDL_LockSpinlock(&svc->lock);
+  svc->flight = svc->pending;
+  memset(&svc->pending, 0, sizeof(svc->pending));
+  SDL_UnlockSpinlock(&svc->lock);
+
+  /* Step storage, and answers the previous apply already has */
+  batch_t *b = &svc->flight;
+  const batch_t *prev = &svc->published;
+  size_t total = 0;
+  for (uint32_t i = 0; i < b->search_count; i++) {
+    search_t *s = &b->searches[i];
+    s->revision = svc->layers[s->layer]->revision;
+    const search_t *old = batch_find(prev, s->layer, s->start, s->goal);
+    s->cached = old && old->revision == s->revision &&
+                (old->max_steps >= s->max_steps ||
+                 old->path_length < old->max_steps);
+    s->path_offset = total;
+    total += s->cached ? old->path_length : s->max_steps;
+  }
+  for (uint32_t i = 0; i < b->ticket_count && b->followers; i++) {
+    ticket_t *t = &b->tickets[i];
+    if (t->lead == NO_LEAD) continue;
+    t->path_offset = total;
+    total += t->max_steps;
+  }
+  b->steps = total ? CIV_MALLOC(total * sizeof(uint32_t)) : NULL;
+  for (uint32_t i = 0; i < b->search_count; i++) {
+    search_t *s = &b->searches[i];
+    const search_t *old =
+        s->cached ? batch_find(prev, s->layer, s->start, s->goal) : NULL;
+    if (old && b->steps) {
+      memcpy(b->steps + s->path_offset, prev->steps + old->path_offset,
+             old->path_length * sizeof(uint32_t));
+      s->path_length = old->path_length;
+      s->cost = old->cost;
+      s->max_steps = MAX(s->max_steps, old->max_steps);
+      svc->stats.cached += s->askers;
+    } else {
+      s->cached = false;
+      if (!b->steps) s->max_steps = 0;
+      svc->stats.searches++;
+    }
+  }
+
+  svc->in_flight = true;
+  svc->pool = pool;
+  SDL_SetAtomicInt(&svc->outstanding, 1);
+  if (!pool || !civ_worker_pool_submit(pool, solve_job, svc)) solve_job(svc);
+}
+
+static void fill_result(const batch_t *b, const ticket_t *t,
+                        civ_path_result_t *out) {
+  if (t->lead != NO_LEAD) {
+    out->cost = t->cost;
+    out->path_length = t->path_length;
+    out->path = b->steps ? b->steps + t->path_offset : NULL;
+    return;
+  }
+  const search_t *s = &b->searches[t->search];
+  out->cost = s->cost;
+  out->path_length = MIN(s->path_length, t->max_steps);
+  out->path = b->steps ? b->steps + s->path_offset : NULL;
+}
+
+size_t civ_path_service_apply(civ_path_service_t *svc) {
+  if (!svc || !svc->in_flight) return 0;
+  wait_flight(svc);
+  svc->in_flight = false;
+
+  batch_free(&svc->published);
+  svc->published = svc->flight;
+  memset(&svc->flight, 0, sizeof(svc->flight));
+  svc->stats.last_batch = svc->published.ticket_count;
+  svc->stats.searches += svc->published.own_searches;
+
+  /* Callbacks may submit; those go to the pending batch */
+  const batch_t *b = &svc->published;
+  for (uint32_t i = 0; i < b->ticket_count; i++) {
+    const ticket_t *t = &b->tickets[i];
+    if (!t->done) continue;
+    civ_path_result_t result;
+    fill_result(b, t, &result);
+    t->done(b->first_ticket + i, &result, t->user_data);
+  }
+  return b->ticket_count;
+}
+
+civ_path_ticket_state_t civ_path_service_result(civ_path_service_t *svc,
+                                               civ_path_ticket_t ticket,
+                                               civ_path_result_t *out) {
+  if (!svc || ticket == CIV_PATH_TICKET_NONE) return CIV_PATH_TICKET_UNKNOWN;
+  const batch_t *b = &svc->published;
+  if (b->ticket_count && ticket >= b->first_ticket &&
+      ticket - b->first_ticket < b->ticket_count) {
+    if (out) fill_result(b, &b->tickets[ticket - b->first_ticket], out);
+    return CIV_PATH_TICKET_READY;
+  }
+  SDL_LockSpinlock(&svc->lock);
+  civ_path_ticket_t oldest = svc->in_flight && svc->flight.ticket_count
+                                 ? svc->flight.first_ticket
+                             : svc->pending.ticket_count
+                                 ? svc->pending.first_ticket
+                                 : svc->next_ticket;
+  bool pending = ticket >= oldest && ticket < svc->next_ticket;
+  SDL_UnlockSpinlock(&svc->lock);
+  return pending ? CIV_PATH_TICKET_PENDING : CIV_PATH_TICKET_UNKNOWN;
+}
+
+void civ_path_service_stats(civ_path_service_t *svc,
+                           civ_path_service_stats_t *out) {
+  if (!svc || !out) return;
+  SDL_LockSpinlock(&svc->lock);
+  *out = svc->stats;
+  SDL_UnlockSpinlock(&svc->lock);
+}
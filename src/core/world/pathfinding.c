@@ -0,0 +1,900 @@
+/**
+ * @file pathfinding.c
+ * @brief Cluster border entrances, cached intra-cluster costs and HPA* queries
+ */
+#include "core/world/pathfinding.h"
+#include "common.h"
+#include "core/simulation_engine/worker_pool.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define INF           CIV_PATH_NO_PATH
+#define CLUSTER_TILES (CIV_PATH_CLUSTER * CIV_PATH_CLUSTER)
+#define WIDE_RUN      6 /* entrances this long get a node at each end */
+
+typedef struct {
+  uint32_t key, g, id;
+} heap_entry_t;
+
+struct civ_path_lane {
+  uint32_t     *g, *parent, *stamp;   /* by global node, + start and goal */
+  uint32_t      node_capacity;
+  uint32_t      generation;
+  heap_entry_t *heap;
+  uint32_t      heap_capacity;
+  uint32_t     *steps;                /* refined path being assembled */
+  uint32_t      step_capacity;
+  uint32_t     *route;                /* abstract nodes, goal first */
+  uint32_t      route_capacity;
+  /* Goal-side links survive across requests sharing a goal */
+  uint32_t      goal_tile;
+  bool          goal_valid;
+  uint32_t      goal_cost[CIV_PATH_MAX_CLUSTER_NODES];
+};
+
+typedef struct {
+  int32_t x0, y0, w, h;
+} cluster_rect_t;
+
+/* ── Min-heap ──────────────────────────────────────────────────────── */
+static void heap_push(heap_entry_t *h, uint32_t *n, heap_entry_t e) {
+  uint32_t i = (*n)++;
+  while (i > 0) {
+    uint32_t p = (i - 1) / 2;
+    if (h[p].key <= e.key) break;
+    h[i] = h[p];
+    i = p;
+  }
+  h[i] = e;
+}
+
+static heap_entry_t heap_pop(heap_entry_t *h, uint32_t *n) {
+  heap_entry_t top = h[0], last = h[--(*n)];
+  uint32_t i = 0;
+  for (;;) {
+    uint32_t c = 2 * i + 1;
+    if (c >= *n) break;
+    if (c + 1 < *n && h[c + 1].key < h[c].key) c++;
+    if (last.key <= h[c].key) break;
+    h[i] = h[c];
+    i = c;
+  }
+  if (*n > 0) h[i] = last;
+  return top;
+}
+
+/* ── Costs ─────────────────────────────────────────────────────────── */
+uint8_t civ_path_terrain_cost(void *user_data, const civ_map_t *map,
+                              size_t index) {
+  (void)user_data;
+  if (civ_map_is_water_at(map, index)) return 0;
+  civ_terrain_type_t terrain = map->planes
+                                   ? (civ_terrain_type_t)map->planes->terrain[index]
+                                   : map->tiles[index].terrain;
+  civ_land_use_type_t use = map->planes
+                                ? (civ_land_use_type_t)map->planes->land_use[index]
+                                : map->tiles[index].land_use;
+  bool river = map->planes ? (map->planes->flags[index] & CIV_TILE_FLAG_RIVER) != 0
+                           : map->tiles[index].has_river;
+  if (terrain == CIV_TERRAIN_MOUNTAIN) return 4;
+  if (terrain == CIV_TERRAIN_HILL || use == CIV_LAND_USE_FOREST ||
+      use == CIV_LAND_USE_WETLAND || river)
+    return 2;
+  return 1;
+}
+
+static uint8_t read_cost(const civ_pathfinder_t *pf, size_t index) {
+  civ_path_cost_fn_t fn = pf->config.cost_fn ? pf->config.cost_fn
+                                             : civ_path_terrain_cost;
+  return fn(pf->config.cost_user_data, pf->map, index);
+}
+
+/* ── Geometry ──────────────────────────────────────────────────────── */
+static int32_t cluster_count(const civ_pathfinder_t *pf) {
+  return pf->cols * pf->rows;
+}
+
+static cluster_rect_t cluster_rect(const civ_pathfinder_t *pf, int32_t c) {
+  cluster_rect_t r;
+  r.x0 = (c % pf->cols) * CIV_PATH_CLUSTER;
+  r.y0 = (c / pf->cols) * CIV_PATH_CLUSTER;
+  r.w = MIN(CIV_PATH_CLUSTER, pf->map->width - r.x0);
+  r.h = MIN(CIV_PATH_CLUSTER, pf->map->height - r.y0);
+  return r;
+}
+
+static int32_t cluster_of_tile(const civ_pathfinder_t *pf, uint32_t tile) {
+  int32_t x = (int32_t)(tile % (uint32_t)pf->map->width);
+  int32_t y = (int32_t)(tile / (uint32_t)pf->map->width);
+  return (y / CIV_PATH_CLUSTER) * pf->cols + x / CIV_PATH_CLUSTER;
+}
+
+static int local_of_tile(const civ_pathfinder_t *pf, cluster_rect_t r,
+                         uint32_t tile) {
+  int32_t x = (int32_t)(tile % (uint32_t)pf->map->width) - r.x0;
+  int32_t y = (int32_t)(tile / (uint32_t)pf->map->width) - r.y0;
+  return y * r.w + x;
+}
+
+static uint32_t tile_of_local(const civ_pathfinder_t *pf, cluster_rect_t r,
+                              int local) {
+  return (uint32_t)(r.y0 + local / r.w) * (uint32_t)pf->map->width +
+         (uint32_t)(r.x0 + local % r.w);
+}
+
+/* Octile distance at minimum tile cost, wrapping x; admissible */
+static uint32_t heuristic(const civ_pathfinder_t *pf, uint32_t a, uint32_t b) {
+  int32_t w = pf->map->width;
+  int32_t dx = abs((int32_t)(a % (uint32_t)w) - (int32_t)(b % (uint32_t)w));
+  int32_t dy = abs((int32_t)(a / (uint32_t)w) - (int32_t)(b / (uint32_t)w));
+  dx = MIN(dx, w - dx);
+  int32_t lo = MIN(dx, dy), hi = MAX(dx, dy);
+  return (uint32_t)lo * CIV_PATH_COST_DIAGONAL +
+         (uint32_t)(hi - lo) * CIV_PATH_COST_STRAIGHT;
+}
+
+/* ── Cluster-bounded search ────────────────────────────────────────── */
+#define PAD_W     (CIV_PATH_CLUSTER + 2)
+#define PAD_TILES (PAD_W * PAD_W)
+
+/* Octile distance between two padded cells of one cluster */
+static uint32_t local_heuristic(int a, int b) {
+  int dx = abs(a % PAD_W - b % PAD_W), dy = abs(a / PAD_W - b / PAD_W);
+  int lo = MIN(dx, dy), hi = MAX(dx, dy);
+  return (uint32_t)lo * CIV_PATH_COST_DIAGONAL +
+         (uint32_t)(hi - lo) * CIV_PATH_COST_STRAIGHT;
+}
+
+/* Search one cluster's tiles from local tile src. Runs as A* towards target
+   when it is >= 0; otherwise as Dijkstra until every tile flagged in marks
+   (every tile, for NULL) is settled. With reverse set, dist holds the cost
+   of reaching src from each tile instead of the other way round. The cost
+   grid is copied with a blocked one-tile frame so the inner loop has no
+   bounds checks. */
+static void cluster_search(const civ_pathfinder_t *pf, cluster_rect_t r,
+                           int src, int target, bool reverse,
+                           const bool *marks, uint32_t *dist, int16_t *parent) {
+  static const int OFF[8] = {1, -1, PAD_W, -PAD_W,
+                             PAD_W + 1, -PAD_W + 1, PAD_W - 1, -PAD_W - 1};
+  static const int OX[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+  static const int OY[8] = {0, 0, PAD_W, -PAD_W, PAD_W, -PAD_W, PAD_W, -PAD_W};
+  uint8_t cost[PAD_TILES];
+  uint32_t pd[PAD_TILES];
+  int16_t pp[PAD_TILES];
+  bool want[PAD_TILES];
+  heap_entry_t heap[1 + 8 * CLUSTER_TILES];
+  uint32_t heap_n = 0;
+  uint32_t W = (uint32_t)pf->map->width;
+  int pending = 0;
+
+  memset(cost, 0, sizeof(cost));
+  for (int y = 0; y < r.h; y++)
+    memcpy(&cost[(y + 1) * PAD_W + 1],
+           &pf->tile_cost[(size_t)(r.y0 + y) * W + (size_t)r.x0], (size_t)r.w);
+  for (int i = 0; i < PAD_TILES; i++) {
+    pd[i] = INF;
+    want[i] = false;
+  }
+  for (int i = 0; i < r.w * r.h; i++) {
+    int p = (i / r.w + 1) * PAD_W + i % r.w + 1;
+    if (!marks || marks[i]) {
+      pending += !want[p];
+      want[p] = true;
+    }
+  }
+
+  int ps = (src / r.w + 1) * PAD_W + src % r.w + 1;
+  int pt = target >= 0 ? (target / r.w + 1) * PAD_W + target % r.w + 1 : -1;
+  pd[ps] = 0;
+  pp[ps] = -1;
+  heap_push(heap, &heap_n,
+            (heap_entry_t){pt >= 0 ? local_heuristic(ps, pt) : 0, 0, (uint32_t)ps});
+
+  while (heap_n > 0) {
+    heap_entry_t e = heap_pop(heap, &heap_n);
+    int u = (int)e.id;
+    if (e.g != pd[u]) continue;
+    if (u == pt) break;
+    if (pt < 0 && want[u]) {
+      want[u] = false;
+      if (--pending == 0) break;
+    }
+    if (reverse && !cost[u]) continue;
+    for (int d = 0; d < 8; d++) {
+      int v = u + OFF[d];
+      if (!cost[v]) continue;
+      if (d >= 4 && (!cost[u + OX[d]] || !cost[u + OY[d]])) continue;
+      uint32_t step = d >= 4 ? CIV_PATH_COST_DIAGONAL : CIV_PATH_COST_STRAIGHT;
+      uint32_t nd = pd[u] + step * (reverse ? cost[u] : cost[v]);
+      if (nd < pd[v]) {
+        pd[v] = nd;
+        pp[v] = (int16_t)u;
+        uint32_t h = pt >= 0 ? local_heuristic(v, pt) : 0;
+        heap_push(heap, &heap_n, (heap_entry_t){nd + h, nd, (uint32_t)v});
+      }
+    }
+  }
+
+  for (int i = 0; i < r.w * r.h; i++) {
+    int p = (i / r.w + 1) * PAD_W + i % r.w + 1;
+    dist[i] = pd[p];
+    if (parent)
+      parent[i] = pd[p] == INF || pp[p] < 0
+                      ? -1
+                      : (int16_t)((pp[p] / PAD_W - 1) * r.w + pp[p] % PAD_W - 1);
+  }
+}
+
+/* ── Graph build ───────────────────────────────────────────────────── */
+static uint32_t node_ref(int32_t border, int t, int side) {
+  return ((uint32_t)border * CIV_PATH_MAX_BORDER_NODES + (uint32_t)t) * 2u +
+         (uint32_t)side;
+}
+
+static void add_transition(civ_path_border_t *b, uint32_t tile_a,
+                           uint32_t tile_b) {
+  if (b->count >= CIV_PATH_MAX_BORDER_NODES) return;
+  b->t[b->count++] = (civ_path_transition_t){tile_a, tile_b, 0, 0};
+}
+
+/* Border b is the east border of cluster b, or for b >= clusters the south
+   border of cluster b - clusters. Both sides' clusters must rebuild. */
+static void border_compute(civ_pathfinder_t *pf, int32_t b) {
+  int32_t n = cluster_count(pf);
+  bool east = b < n;
+  int32_t c = east ? b : b - n;
+  civ_path_border_t *border = &pf->borders[b];
+  border->count = 0;
+  border->dirty = false;
+
+  int32_t cx = c % pf->cols, cy = c / pf->cols;
+  if (east ? pf->cols < 2 : cy + 1 >= pf->rows) return;
+  int32_t other = east ? cy * pf->cols + (cx + 1) % pf->cols : c + pf->cols;
+  pf->clusters[c].dirty = true;
+  pf->clusters[other].dirty = true;
+
+  cluster_rect_t r = cluster_rect(pf, c);
+  uint32_t W = (uint32_t)pf->map->width;
+  int32_t len = east ? r.h : r.w;
+  int32_t run = -1;
+  for (int32_t k = 0; k <= len; k++) {
+    uint32_t ta = 0, tb = 0;
+    bool open = false;
+    if (k < len) {
+      if (east) {
+        ta = (uint32_t)(r.y0 + k) * W + (uint32_t)(r.x0 + r.w - 1);
+        tb = (uint32_t)(r.y0 + k) * W + (uint32_t)((r.x0 + r.w) % (int32_t)W);
+      } else {
+        ta = (uint32_t)(r.y0 + r.h - 1) * W + (uint32_t)(r.x0 + k);
+        tb = ta + W;
+      }
+      open = pf->tile_cost[ta] && pf->tile_cost[tb];
+    }
+    if (open && run < 0) run = k;
+    if (open || run < 0) continue;
+
+    /* Run [run, k) just closed */
+    int32_t picks[2] = {run, k - 1};
+    int pick_count = k - run >= WIDE_RUN ? 2 : 1;
+    if (pick_count == 1) picks[0] = (run + k - 1) / 2;
+    for (int p = 0; p < pick_count; p++) {
+      int32_t s = picks[p];
+      if (east)
+        add_transition(border, (uint32_t)(r.y0 + s) * W + (uint32_t)(r.x0 + r.w - 1),
+                       (uint32_t)(r.y0 + s) * W +
+                           (uint32_t)((r.x0 + r.w) % (int32_t)W));
+      else
+        add_transition(border, (uint32_t)(r.y0 + r.h - 1) * W + (uint32_t)(r.x0 + s),
+                       (uint32_t)(r.y0 + r.h) * W + (uint32_t)(r.x0 + s));
+    }
+    run = -1;
+  }
+}
+
+static void cluster_add_node(civ_path_cluster_t *cl, uint32_t tile,
+                             uint32_t ref) {
+  cl->node_tile[cl->count] = tile;
+  cl->node_ref[cl->count] = ref;
+  cl->count++;
+}
+
+/* Collect the cluster's side of its four borders, then cost every node pair.
+   Writes only this cluster and its own node indices in the borders, so
+   clusters rebuild independently. */
+static void cluster_rebuild(civ_pathfinder_t *pf, int32_t c) {
+  civ_path_cluster_t *cl = &pf->clusters[c];
+  int32_t n = cluster_count(pf);
+  int32_t cx = c % pf->cols, cy = c / pf->cols;
+  cl->count = 0;
+  cl->dirty = false;
+
+  int32_t own[2] = {c, n + c};
+  for (int k = 0; k < 2; k++) {
+    civ_path_border_t *b = &pf->borders[own[k]];
+    for (int t = 0; t < b->count; t++) {
+      b->t[t].node_a = cl->count;
+      cluster_add_node(cl, b->t[t].tile_a, node_ref(own[k], t, 0));
+    }
+  }
+  int32_t theirs[2] = {pf->cols >= 2 ? cy * pf->cols + (cx + pf->cols - 1) % pf->cols : -1,
+                       cy > 0 ? n + c - pf->cols : -1};
+  for (int k = 0; k < 2; k++) {
+    if (theirs[k] < 0) continue;
+    civ_path_border_t *b = &pf->borders[theirs[k]];
+    for (int t = 0; t < b->count; t++) {
+      b->t[t].node_b = cl->count;
+      cluster_add_node(cl, b->t[t].tile_b, node_ref(theirs[k], t, 1));
+    }
+  }
+
+  uint32_t pairs = (uint32_t)cl->count * cl->count;
+  if (pairs > cl->cost_capacity) {
+    uint32_t *cost = CIV_REALLOC(cl->cost, pairs * sizeof(uint32_t));
+    if (!cost) {
+      cl->count = 0;
+      return;
+    }
+    cl->cost = cost;
+    cl->cost_capacity = pairs;
+  }
+
+  cluster_rect_t r = cluster_rect(pf, c);
+  uint32_t dist[CLUSTER_TILES];
+  bool marks[CLUSTER_TILES] = {false};
+  for (int i = 0; i < cl->count; i++)
+    marks[local_of_tile(pf, r, cl->node_tile[i])] = true;
+  for (int i = 0; i < cl->count; i++) {
+    cluster_search(pf, r, local_of_tile(pf, r, cl->node_tile[i]), -1, false,
+                   marks, dist, NULL);
+    for (int j = 0; j < cl->count; j++)
+      cl->cost[i * cl->count + j] = dist[local_of_tile(pf, r, cl->node_tile[j])];
+  }
+}
+
+/* Global node across the border from the entrance ref, and its tile */
+static uint32_t partner(const civ_pathfinder_t *pf, uint32_t ref,
+                        uint32_t *tile) {
+  int32_t n = cluster_count(pf);
+  int32_t b = (int32_t)(ref / 2 / CIV_PATH_MAX_BORDER_NODES);
+  const civ_path_transition_t *tr =
+      &pf->borders[b].t[(ref / 2) % CIV_PATH_MAX_BORDER_NODES];
+  int32_t side_a = b < n ? b : b - n;
+  int32_t side_b = b < n ? (side_a / pf->cols) * pf->cols +
+                               (side_a % pf->cols + 1) % pf->cols
+                         : side_a + pf->cols;
+  bool from_a = (ref & 1u) == 0;
+  *tile = from_a ? tr->tile_b : tr->tile_a;
+  return pf->node_base[from_a ? side_b : side_a] +
+         (from_a ? tr->node_b : tr->node_a);
+}
+
+/* Label connected components of the abstract graph so unreachable goals
+   are rejected without flooding a whole continent. Movement is symmetric,
+   so reachability is too. */
+static bool label_components(civ_pathfinder_t *pf) {
+  uint32_t total = pf->node_count;
+  uint32_t *comp = CIV_REALLOC(pf->node_component,
+                               MAX(total, 1u) * sizeof(uint32_t));
+  uint32_t *stack = CIV_MALLOC(MAX(total, 1u) * sizeof(uint32_t));
+  if (!comp || !stack) {
+    if (comp) pf->node_component = comp;
+    CIV_FREE(stack);
+    return false;
+  }
+  pf->node_component = comp;
+  for (uint32_t v = 0; v < total; v++) comp[v] = INF;
+
+  uint32_t label = 0;
+  for (uint32_t root = 0; root < total; root++) {
+    if (comp[root] != INF) continue;
+    uint32_t top = 0;
+    comp[root] = label;
+    stack[top++] = root;
+    while (top > 0) {
+      uint32_t u = stack[--top];
+      uint32_t c = pf->node_cluster[u];
+      const civ_path_cluster_t *cl = &pf->clusters[c];
+      uint32_t i = u - pf->node_base[c], tile;
+      uint32_t next[CIV_PATH_MAX_CLUSTER_NODES + 1];
+      int count = 0;
+      for (uint32_t j = 0; j < cl->count; j++)
+        if (cl->cost[i * cl->count + j] != INF) next[count++] = pf->node_base[c] + j;
+      next[count++] = partner(pf, cl->node_ref[i], &tile);
+      for (int k = 0; k < count; k++) {
+        if (comp[next[k]] != INF) continue;
+        comp[next[k]] = label;
+        stack[top++] = next[k];
+      }
+    }
+    label++;
+  }
+  CIV_FREE(stack);
+  return true;
+}
+
+static void rebuild_job(void *ctx, int index) {
+  civ_pathfinder_t *pf = ctx;
+  /* node_cluster doubles as the dirty list until the graph is numbered */
+  cluster_rebuild(pf, (int32_t)pf->node_cluster[index]);
+}
+
+/* ── Lifecycle ─────────────────────────────────────────────────────── */
+static void owner_listener(void *user_data, const civ_map_t *map, size_t index,
+                           civ_owner_index_t old_owner,
+                           civ_owner_index_t new_owner) {
+  (void)map;
+  (void)old_owner;
+  (void)new_owner;
+  civ_pathfinder_invalidate_tile(user_data, index);
+}
+
+civ_pathfinder_t *civ_pathfinder_create(civ_map_t *map,
+                                        const civ_path_config_t *config) {
+  if (!map || !map->tiles || map->width <= 0 || map->height <= 0) return NULL;
+  civ_pathfinder_t *pf = CIV_CALLOC(1, sizeof(civ_pathfinder_t));
+  if (!pf) return NULL;
+
+  pf->map = map;
+  if (config) pf->config = *config;
+  pf->cols = (map->width + CIV_PATH_CLUSTER - 1) / CIV_PATH_CLUSTER;
+  pf->rows = (map->height + CIV_PATH_CLUSTER - 1) / CIV_PATH_CLUSTER;
+  size_t n = (size_t)cluster_count(pf);
+  pf->tile_cost = CIV_MALLOC((size_t)map->width * map->height);
+  pf->clusters = CIV_CALLOC(n, sizeof(civ_path_cluster_t));
+  pf->borders = CIV_CALLOC(2 * n, sizeof(civ_path_border_t));
+  pf->node_base = CIV_CALLOC(n + 1, sizeof(uint32_t));
+  if (!pf->tile_cost || !pf->clusters || !pf->borders || !pf->node_base) {
+    civ_pathfinder_destroy(pf);
+    return NULL;
+  }
+  pf->costs_dirty = true;
+  pf->graph_dirty = true;
+
+  if (pf->config.cost_reads_owner &&
+      !civ_map_add_owner_listener(map, owner_listener, pf))
+    civ_log(CIV_LOG_WARNING,
+            "Pathfinder: map listener table full, owner changes need "
+            "civ_pathfinder_invalidate_tile");
+  return pf;
+}
+
+static void lane_free(civ_path_lane_t *lane) {
+  CIV_FREE(lane->g);
+  CIV_FREE(lane->parent);
+  CIV_FREE(lane->stamp);
+  CIV_FREE(lane->heap);
+  CIV_FREE(lane->steps);
+  CIV_FREE(lane->route);
+}
+
+void civ_pathfinder_destroy(civ_pathfinder_t *pf) {
+  if (!pf) return;
+  civ_map_remove_owner_listener(pf->map, owner_listener, pf);
+  if (pf->clusters)
+    for (int32_t c = 0; c < cluster_count(pf); c++) CIV_FREE(pf->clusters[c].cost);
+  for (int i = 0; i < pf->lane_count; i++) lane_free(&pf->lanes[i]);
+  CIV_FREE(pf->lanes);
+  CIV_FREE(pf->tile_cost);
+  CIV_FREE(pf->clusters);
+  CIV_FREE(pf->borders);
+  CIV_FREE(pf->node_base);
+  CIV_FREE(pf->node_cluster);
+  CIV_FREE(pf->node_component);
+  CIV_FREE(pf);
+}
+
+void civ_pathfinder_invalidate_tile(civ_pathfinder_t *pf, size_t index) {
+  if (!pf || index >= (size_t)pf->map->width * pf->map->height) return;
+  if (pf->costs_dirty) return; /* everything rebuilds anyway */
+  uint8_t cost = read_cost(pf, index);
+  if (cost == pf->tile_cost[index]) return;
+  pf->tile_cost[index] = cost;
+  pf->revision++;
+
+  int32_t c = cluster_of_tile(pf, (uint32_t)index);
+  cluster_rect_t r = cluster_rect(pf, c);
+  int32_t n = cluster_count(pf);
+  int32_t lx = (int32_t)(index % (size_t)pf->map->width) - r.x0;
+  int32_t ly = (int32_t)(index / (size_t)pf->map->width) - r.y0;
+  int32_t cx = c % pf->cols;
+  pf->clusters[c].dirty = true;
+  if (lx == r.w - 1) pf->borders[c].dirty = true;
+  if (lx == 0) pf->borders[c - cx + (cx + pf->cols - 1) % pf->cols].dirty = true;
+  if (ly == r.h - 1) pf->borders[n + c].dirty = true;
+  if (ly == 0 && c >= pf->cols) pf->borders[n + c - pf->cols].dirty = true;
+  pf->graph_dirty = true;
+}
+
+void civ_pathfinder_invalidate_all(civ_pathfinder_t *pf) {
+  if (!pf) return;
+  pf->costs_dirty = true;
+  pf->graph_dirty = true;
+  pf->revision++;
+}
+
+void civ_pathfinder_prepare(civ_pathfinder_t *pf, civ_worker_pool_t *pool) {
+  if (!pf || !pf->graph_dirty) return;
+  int32_t n = cluster_count(pf);
+
+  if (pf->costs_dirty) {
+    size_t tiles = (size_t)pf->map->width * pf->map->height;
+    for (size_t i = 0; i < tiles; i++) pf->tile_cost[i] = read_cost(pf, i);
+    for (int32_t b = 0; b < 2 * n; b++) pf->borders[b].dirty = true;
+    for (int32_t c = 0; c < n; c++) pf->clusters[c].dirty = true;
+    pf->costs_dirty = false;
+  }
+  for (int32_t b = 0; b < 2 * n; b++)
+    if (pf->borders[b].dirty) border_compute(pf, b);
+
+  /* The dirty list needs at most one entry per cluster */
+  uint32_t want = (uint32_t)MAX((int64_t)n, (int64_t)pf->node_count);
+  uint32_t *list = CIV_REALLOC(pf->node_cluster, MAX(want, 1u) * sizeof(uint32_t));
+  if (!list) return;
+  pf->node_cluster = list;
+  int dirty = 0;
+  for (int32_t c = 0; c < n; c++)
+    if (pf->clusters[c].dirty) list[dirty++] = (uint32_t)c;
+  civ_worker_pool_parallel_for(pool, dirty, rebuild_job, pf);
+
+  uint32_t total = 0;
+  for (int32_t c = 0; c < n; c++) {
+    pf->node_base[c] = total;
+    total += pf->clusters[c].count;
+  }
+  pf->node_base[n] = total;
+  if (total > want) {
+    list = CIV_REALLOC(pf->node_cluster, total * sizeof(uint32_t));
+    if (!list) return;
+    pf->node_cluster = list;
+  }
+  for (int32_t c = 0; c < n; c++)
+    for (uint32_t i = pf->node_base[c]; i < pf->node_base[c + 1]; i++)
+      list[i] = (uint32_t)c;
+  pf->node_count = total;
+  if (!label_components(pf)) return;
+  pf->graph_dirty = false;
+  /* Cached goal links refer to the old numbering */
+  for (int i = 0; i < pf->lane_count; i++) pf->lanes[i].goal_valid = false;
+}
+
+/* ── Queries ───────────────────────────────────────────────────────── */
+
+uint32_t civ_pathfinder_step_cost(const civ_pathfinder_t *pf, uint32_t from,
+                                  uint32_t to) {
+  if (!pf || pf->costs_dirty) return CIV_PATH_NO_PATH;
+  int32_t w = pf->map->width;
+  size_t tiles = (size_t)w * pf->map->height;
+  if (from >= tiles || to >= tiles || !pf->tile_cost[to])
+    return CIV_PATH_NO_PATH;
+  int32_t fx = (int32_t)(from % (uint32_t)w), fy = (int32_t)(from / (uint32_t)w);
+  int32_t tx = (int32_t)(to % (uint32_t)w), ty = (int32_t)(to / (uint32_t)w);
+  int32_t dx = tx - fx, dy = ty - fy;
+  if (dx > 1) dx -= w;
+  else if (dx < -1) dx += w;
+  if (abs(dx) > 1 || abs(dy) > 1 || (dx == 0 && dy == 0))
+    return CIV_PATH_NO_PATH;
+  if (dx == 0 || dy == 0)
+    return CIV_PATH_COST_STRAIGHT * pf->tile_cost[to];
+  /* No corner cutting: both orthogonal neighbours must be passable */
+  if (!pf->tile_cost[(size_t)fy * (size_t)w + (size_t)tx] ||
+      !pf->tile_cost[(size_t)ty * (size_t)w + (size_t)fx])
+    return CIV_PATH_NO_PATH;
+  return CIV_PATH_COST_DIAGONAL * pf->tile_cost[to];
+}
+static bool ensure_lanes(civ_pathfinder_t *pf, int count) {
+  if (count > pf->lane_count) {
+    civ_path_lane_t *lanes =
+        CIV_REALLOC(pf->lanes, (size_t)count * sizeof(civ_path_lane_t));
+    if (!lanes) return false;
+    memset(lanes + pf->lane_count, 0,
+           (size_t)(count - pf->lane_count) * sizeof(civ_path_lane_t));
+    pf->lanes = lanes;
+    pf->lane_count = count;
+  }
+  uint32_t want = pf->node_count + 2;
+  for (int i = 0; i < count; i++) {
+    civ_path_lane_t *lane = &pf->lanes[i];
+    if (lane->node_capacity >= want) continue;
+    uint32_t *g = CIV_REALLOC(lane->g, want * sizeof(uint32_t));
+    if (g) lane->g = g;
+    uint32_t *parent = CIV_REALLOC(lane->parent, want * sizeof(uint32_t));
+    if (parent) lane->parent = parent;
+    uint32_t *stamp = CIV_CALLOC(want, sizeof(uint32_t));
+    if (!g || !parent || !stamp) {
+      CIV_FREE(stamp);
+      return false;
+    }
+    CIV_FREE(lane->stamp);
+    lane->stamp = stamp;
+    lane->generation = 0;
+    lane->node_capacity = want;
+  }
+  return true;
+}
+
+static bool grow(void **buf, uint32_t *capacity, uint32_t need, size_t elem) {
+  if (need <= *capacity) return true;
+  uint32_t cap = *capacity ? *capacity : 64;
+  while (cap < need) cap *= 2;
+  void *p = CIV_REALLOC(*buf, (size_t)cap * elem);
+  if (!p) return false;
+  *buf = p;
+  *capacity = cap;
+  return true;
+}
+
+static bool push_step(civ_path_lane_t *lane, uint32_t *len, uint32_t tile) {
+  if (!grow((void **)&lane->steps, &lane->step_capacity, *len + 1,
+            sizeof(uint32_t)))
+    return false;
+  lane->steps[(*len)++] = tile;
+  return true;
+}
+
+/* Append the in-cluster path from a to b, excluding a; *cost gets its cost */
+static bool append_local(const civ_pathfinder_t *pf, civ_path_lane_t *lane,
+                         uint32_t *len, uint32_t a, uint32_t b,
+                         uint32_t *cost) {
+  if (cost) *cost = 0;
+  if (a == b) return true;
+  cluster_rect_t r = cluster_rect(pf, cluster_of_tile(pf, a));
+  uint32_t dist[CLUSTER_TILES];
+  int16_t parent[CLUSTER_TILES];
+  int from = local_of_tile(pf, r, a), to = local_of_tile(pf, r, b);
+  cluster_search(pf, r, from, to, false, NULL, dist, parent);
+  if (dist[to] == INF) return false;
+  if (cost) *cost = dist[to];
+
+  int back[CLUSTER_TILES], n = 0;
+  for (int v = to; v != from; v = parent[v]) back[n++] = v;
+  while (n > 0)
+    if (!push_step(lane, len, tile_of_local(pf, r, back[--n]))) return false;
+  return true;
+}
+
+static void emit(const civ_path_lane_t *lane, uint32_t len, uint32_t cost,
+                 civ_path_request_t *req) {
+  len = MIN(len, req->path_capacity);
+  if (req->path) memcpy(req->path, lane->steps, len * sizeof(uint32_t));
+  req->path_length = len;
+  req->cost = cost;
+}
+
+static uint32_t node_tile(const civ_pathfinder_t *pf, uint32_t node) {
+  uint32_t c = pf->node_cluster[node];
+  return pf->clusters[c].node_tile[node - pf->node_base[c]];
+}
+
+/* Links from start to its cluster's nodes, and (cached per goal) from the
+   goal cluster's nodes to goal */
+static void link_endpoints(const civ_pathfinder_t *pf, civ_path_lane_t *lane,
+                           uint32_t start, uint32_t goal,
+                           uint32_t start_cost[CIV_PATH_MAX_CLUSTER_NODES]) {
+  uint32_t dist[CLUSTER_TILES];
+  bool marks[CLUSTER_TILES];
+  const uint32_t ends[2] = {start, goal};
+  for (int k = 0; k < 2; k++) {
+    if (k == 1 && lane->goal_valid && lane->goal_tile == goal) break;
+    int32_t c = cluster_of_tile(pf, ends[k]);
+    const civ_path_cluster_t *cl = &pf->clusters[c];
+    cluster_rect_t r = cluster_rect(pf, c);
+    memset(marks, 0, sizeof(marks));
+    for (int i = 0; i < cl->count; i++)
+      marks[local_of_tile(pf, r, cl->node_tile[i])] = true;
+    cluster_search(pf, r, local_of_tile(pf, r, ends[k]), -1, k == 1, marks,
+                   dist, NULL);
+    uint32_t *out = k == 0 ? start_cost : lane->goal_cost;
+    for (int i = 0; i < cl->count; i++)
+      out[i] = dist[local_of_tile(pf, r, cl->node_tile[i])];
+  }
+  lane->goal_tile = goal;
+  lane->goal_valid = true;
+}
+
+/* A* over the abstract graph; ids past the graph are start and goal. Gives
+   up on routes costing bound or more. Leaves the node route, goal side
+   first, in lane->route and returns its cost, or INF. */
+static uint32_t abstract_search(const civ_pathfinder_t *pf,
+                                civ_path_lane_t *lane, uint32_t start,
+                                uint32_t goal, uint32_t bound,
+                                uint32_t *hops) {
+  int32_t sc = cluster_of_tile(pf, start), gc = cluster_of_tile(pf, goal);
+  const civ_path_cluster_t *scl = &pf->clusters[sc];
+  *hops = 0;
+  if (scl->count == 0 || pf->clusters[gc].count == 0) return INF;
+
+  uint32_t start_cost[CIV_PATH_MAX_CLUSTER_NODES];
+  link_endpoints(pf, lane, start, goal, start_cost);
+
+  /* No start-side node shares a component with a goal-side node */
+  const civ_path_cluster_t *gcl = &pf->clusters[gc];
+  bool connected = false;
+  for (int i = 0; i < scl->count && !connected; i++) {
+    if (start_cost[i] == INF) continue;
+    uint32_t ci = pf->node_component[pf->node_base[sc] + (uint32_t)i];
+    for (int j = 0; j < gcl->count && !connected; j++)
+      connected = lane->goal_cost[j] != INF &&
+                  pf->node_component[pf->node_base[gc] + (uint32_t)j] == ci;
+  }
+  if (!connected) return INF;
+
+  uint32_t START = pf->node_count, GOAL = pf->node_count + 1;
+  if (++lane->generation == 0) {
+    memset(lane->stamp, 0, lane->node_capacity * sizeof(uint32_t));
+    lane->generation = 1;
+  }
+  uint32_t gen = lane->generation;
+  uint32_t heap_n = 0;
+#define G(v) (lane->stamp[v] == gen ? lane->g[v] : INF)
+#define RELAX(v, ng, h)                                                        \
+  do {                                                                         \
+    uint32_t v_ = (v), ng_ = (ng);                                             \
+    if (ng_ < G(v_)) {                                                         \
+      if (!grow((void **)&lane->heap, &lane->heap_capacity, heap_n + 1,        \
+                sizeof(heap_entry_t)))                                         \
+        return INF;                                                            \
+      lane->stamp[v_] = gen;                                                   \
+      lane->g[v_] = ng_;                                                       \
+      lane->parent[v_] = u;                                                    \
+      heap_push(lane->heap, &heap_n, (heap_entry_t){ng_ + (h), ng_, v_});      \
+    }                                                                          \
+  } while (0)
+
+  uint32_t u = START;
+  for (int i = 0; i < scl->count; i++)
+    if (start_cost[i] != INF)
+      RELAX(pf->node_base[sc] + (uint32_t)i, start_cost[i],
+            heuristic(pf, scl->node_tile[i], goal));
+
+  bool found = false;
+  while (heap_n > 0) {
+    heap_entry_t e = heap_pop(lane->heap, &heap_n);
+    u = e.id;
+    if (e.g != G(u)) continue;
+    if (e.key >= bound) break;
+    if (u == GOAL) {
+      found = true;
+      break;
+    }
+    uint32_t c = pf->node_cluster[u];
+    const civ_path_cluster_t *cl = &pf->clusters[c];
+    uint32_t i = u - pf->node_base[c];
+
+    if ((int32_t)c == gc && lane->goal_cost[i] != INF)
+      RELAX(GOAL, e.g + lane->goal_cost[i], 0);
+    for (uint32_t j = 0; j < cl->count; j++) {
+      uint32_t w = cl->cost[i * cl->count + j];
+      if (j != i && w != INF)
+        RELAX(pf->node_base[c] + j, e.g + w,
+              heuristic(pf, cl->node_tile[j], goal));
+    }
+
+    uint32_t pt;
+    uint32_t pv = partner(pf, cl->node_ref[i], &pt);
+    RELAX(pv, e.g + CIV_PATH_COST_STRAIGHT * pf->tile_cost[pt],
+          heuristic(pf, pt, goal));
+  }
+#undef RELAX
+#undef G
+  if (!found) return INF;
+
+  for (uint32_t v = lane->parent[GOAL]; v != START; v = lane->parent[v]) {
+    if (!grow((void **)&lane->route, &lane->route_capacity, *hops + 1,
+              sizeof(uint32_t)))
+      return INF;
+    lane->route[(*hops)++] = v;
+  }
+  return lane->g[GOAL];
+}
+
+static bool lane_find(civ_pathfinder_t *pf, civ_path_lane_t *lane,
+                      civ_path_request_t *req) {
+  req->path_length = 0;
+  req->cost = INF;
+  size_t tiles = (size_t)pf->map->width * pf->map->height;
+  uint32_t start = req->start, goal = req->goal;
+  if (start >= tiles || goal >= tiles || !pf->tile_cost[goal]) return false;
+  if (start == goal) {
+    req->cost = 0;
+    return true;
+  }
+
+  /* Same cluster: the bounded search is the answer unless leaving the
+     cluster is cheaper, and it caps how far the abstract search looks */
+  int32_t sc = cluster_of_tile(pf, start);
+  uint32_t len = 0, direct = INF;
+  if (sc == cluster_of_tile(pf, goal) &&
+      !append_local(pf, lane, &len, start, goal, &direct)) {
+    len = 0;
+    direct = INF;
+  }
+
+  uint32_t hops;
+  uint32_t cost = abstract_search(pf, lane, start, goal, direct, &hops);
+  if (cost == INF) {
+    if (direct == INF) return false;
+    emit(lane, len, direct, req);
+    return true;
+  }
+
+  /* Refine: in-cluster searches between nodes, single steps across borders.
+     Only as much as fits the caller's buffer is refined. */
+  len = 0;
+  uint32_t prev = start;
+  int32_t prev_cluster = sc;
+  while (hops > 0 && len < req->path_capacity) {
+    uint32_t v = lane->route[--hops];
+    uint32_t t = node_tile(pf, v);
+    bool ok = (int32_t)pf->node_cluster[v] == prev_cluster
+                  ? append_local(pf, lane, &len, prev, t, NULL)
+                  : push_step(lane, &len, t);
+    if (!ok) return false;
+    prev = t;
+    prev_cluster = (int32_t)pf->node_cluster[v];
+  }
+  if (hops == 0 && len < req->path_capacity &&
+      !append_local(pf, lane, &len, prev, goal, NULL))
+    return false;
+  emit(lane, len, cost, req);
+  return true;
+}
+
+bool civ_pathfinder_find(civ_pathfinder_t *pf, civ_path_request_t *req) {
+  if (!pf || !req) return false;
+  civ_pathfinder_prepare(pf, NULL);
+  if (pf->graph_dirty || !ensure_lanes(pf, MAX(pf->lane_count, 1))) {
+    req->path_length = 0;
+    req->cost = INF;
+    return false;
+  }
+  return lane_find(pf, &pf->lanes[0], req);
+}
+
+typedef struct {
+  civ_pathfinder_t   *pf;
+  civ_path_request_t *reqs;
+  uint64_t           *order;   /* goal << 32 | request index */
+  size_t              count;
+  int                 lanes;
+} batch_ctx_t;
+
+static int compare_u64(const void *a, const void *b) {
+  uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+static void batch_lane(void *ctx, int lane) {
+  batch_ctx_t *b = ctx;
+  size_t chunk = (b->count + (size_t)b->lanes - 1) / (size_t)b->lanes;
+  size_t end = MIN(b->count, (size_t)(lane + 1) * chunk);
+  for (size_t k = (size_t)lane * chunk; k < end; k++)
+    lane_find(b->pf, &b->pf->lanes[lane], &b->reqs[b->order[k] & 0xFFFFFFFFu]);
+}
+
+void civ_pathfinder_find_batch(civ_pathfinder_t *pf, civ_path_request_t *reqs,
+                               size_t count, civ_worker_pool_t *pool) {
+  if (!pf || !reqs || count == 0) return;
+  civ_pathfinder_prepare(pf, pool);
+
+  int lanes = pool ? civ_worker_pool_size(pool) + 1 : 1;
+  lanes = (int)MIN((size_t)lanes, count);
+  uint64_t *order = CIV_MALLOC(count * sizeof(uint64_t));
+  if (pf->graph_dirty || !order || !ensure_lanes(pf, lanes)) {
+    for (size_t i = 0; i < count; i++) {
+      reqs[i].path_length = 0;
+      reqs[i].cost = INF;
+    }
+    CIV_FREE(order);
+    return;
+  }
+
+  /* Requests sharing a goal run back to back on one lane, so the goal's
+     links to its cluster's nodes are computed once */
+  for (size_t i = 0; i < count; i++)
+    order[i] = (uint64_t)reqs[i].goal << 32 | (uint64_t)i;
+  qsort(order, count, sizeof(uint64_t), compare_u64);
+
+  batch_ctx_t ctx = {pf, reqs, order, count, lanes};
+  civ_worker_pool_parallel_for(pool, lanes, batch_lane, &ctx);
+  CIV_FREE(order);
+}
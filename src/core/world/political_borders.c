@@ -4,15 +4,18 @@
  */
 #include "core/world/political_borders.h"
 #include "common.h"
+#include "utils/mapped_file.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 typedef struct {
-  int       count;
-  char    **names;
-  uint32_t *colors;
-  int16_t  *tile_country;
+  int               count;
+  char            **names;
+  uint32_t         *colors;
+  const int16_t    *tile_country;  /* view into the source, or tile_copy */
+  int16_t          *tile_copy;     /* only when the view is misaligned */
+  civ_mapped_file_t file;          /* empty when loaded from a borrowed view */
 } civ_border_data_t;
 
 static civ_border_data_t *s_borders = NULL;
@@ -22,53 +25,94 @@ static void borders_free_data(civ_border_data_t *bd) {
   for (int i = 0; i < bd->count; i++) free(bd->names[i]);
   free(bd->names);
   free(bd->colors);
-  free(bd->tile_country);
+  free(bd->tile_copy);
+  civ_mapped_file_close(&bd->file);
   free(bd);
 }
 
-bool civ_political_borders_load(const char *filepath, int32_t map_w, int32_t map_h) {
-  FILE *f = fopen(filepath, "rb");
-  if (!f) { printf("[BORDERS] No file %s\n", filepath); return false; }
-
-  civ_border_data_t *bd = (civ_border_data_t *)calloc(1, sizeof(civ_border_data_t));
-  if (!bd) { fclose(f); return false; }
-
-  uint32_t count;
-  if (fread(&count, sizeof(count), 1, f) != 1) { borders_free_data(bd); fclose(f); return false; }
-  bd->count = (int)count;
-  printf("[BORDERS] Loading %d countries...\n", bd->count);
+/* Parse a borders image; tile_country may alias data, so data must live
+   as long as bd */
+static bool borders_parse(civ_border_data_t *bd, const uint8_t *data,
+                          size_t size, int32_t map_w, int32_t map_h) {
+  civ_byte_reader_t r = civ_byte_reader_span(data, size);
+  uint32_t count = civ_byte_reader_u32(&r);
+  if (!r.ok) return false;
+  printf("[BORDERS] Loading %u countries...\n", count);
 
   bd->names   = (char **)calloc((size_t)count, sizeof(char *));
   bd->colors  = (uint32_t *)calloc((size_t)count, sizeof(uint32_t));
-  if (!bd->names || !bd->colors) { borders_free_data(bd); fclose(f); return false; }
+  if (!bd->names || !bd->colors) return false;
+  bd->count = (int)count;
 
-  for (int i = 0; i < bd->count; i++) {
-    uint8_t nl;
-    if (fread(&nl, 1, 1, f) != 1) break;
+  for (int i = 0; i < bd->count && r.ok; i++) {
+    uint8_t nl = civ_byte_reader_u8(&r);
     bd->names[i] = (char *)malloc((size_t)nl + 1);
     if (!bd->names[i]) break;
-    if (fread(bd->names[i], 1, nl, f) != nl) break;
-    bd->names[i][nl] = '\0';
-    if (fread(&bd->colors[i], 4, 1, f) != 1) break;
+    civ_byte_reader_str(&r, nl, bd->names[i], (size_t)nl + 1);
+    bd->colors[i] = civ_byte_reader_u32(&r);
   }
 
+  /* The tile array is used in place; an odd offset (names are unpadded)
+     would make int16 access misaligned, so that case gets one copy */
   size_t tc = (size_t)map_w * map_h;
-  bd->tile_country = (int16_t *)malloc(tc * sizeof(int16_t));
-  if (!bd->tile_country) { borders_free_data(bd); fclose(f); return false; }
-  if (fread(bd->tile_country, sizeof(int16_t), tc, f) != tc) {
+  const uint8_t *tiles = civ_byte_reader_take(&r, tc * sizeof(int16_t));
+  if (!tiles) {
     printf("[BORDERS] Short tile read\n");
-    borders_free_data(bd); fclose(f); return false;
+    return false;
+  }
+  if (((uintptr_t)tiles & (sizeof(int16_t) - 1)) == 0) {
+    bd->tile_country = (const int16_t *)(const void *)tiles;
+  } else {
+    bd->tile_copy = (int16_t *)malloc(tc * sizeof(int16_t));
+    if (!bd->tile_copy) return false;
+    memcpy(bd->tile_copy, tiles, tc * sizeof(int16_t));
+    bd->tile_country = bd->tile_copy;
   }
-  fclose(f);
+  return true;
+}
 
+static bool borders_install(civ_border_data_t *bd) {
   if (s_borders) borders_free_data(s_borders);
   s_borders = bd;
   printf("[BORDERS] %d countries loaded\n", bd->count);
   return true;
 }
 
+bool civ_political_borders_load(const char *filepath, int32_t map_w, int32_t map_h) {
+  civ_border_data_t *bd = (civ_border_data_t *)calloc(1, sizeof(civ_border_data_t));
+  if (!bd) return false;
+  if (!civ_mapped_file_open(&bd->file, filepath)) {
+    printf("[BORDERS] No file %s\n", filepath);
+    free(bd);
+    return false;
+  }
+  if (!borders_parse(bd, bd->file.data, bd->file.size, map_w, map_h)) {
+    borders_free_data(bd);
+    return false;
+  }
+  return borders_install(bd);
+}
+
+bool civ_political_borders_load_view(const uint8_t *data, size_t size,
+                                     int32_t map_w, int32_t map_h) {
+  civ_border_data_t *bd = (civ_border_data_t *)calloc(1, sizeof(civ_border_data_t));
+  if (!bd) return false;
+  if (!borders_parse(bd, data, size, map_w, map_h)) {
+    borders_free_data(bd);
+    return false;
+  }
+  return borders_install(bd);
+}
+
 void civ_political_borders_apply(civ_map_t *map) {
   if (!s_borders || !map) return;
+  /* Intern each country once instead of formatting its name per tile */
+  civ_owner_index_t *owner = (civ_owner_index_t *)calloc(
+      (size_t)s_borders->count, sizeof(civ_owner_index_t));
+  if (!owner) return;
+  for (int c = 0; c < s_borders->count; c++)
+    owner[c] = civ_owner_intern(s_borders->names[c]);
+
   for (int32_t y = 0; y < map->height; y++) {
     for (int32_t x = 0; x < map->width; x++) {
       int16_t cid = s_borders->tile_country[y * map->width + x];
@@ -76,10 +120,11 @@ void civ_political_borders_apply(civ_map_t *map) {
       if (!s_borders->names[cid]) continue;
       civ_map_tile_t *t = civ_map_get_tile(map, x, y);
       if (!t || t->land_use == CIV_LAND_USE_WATER) continue;
-      snprintf(t->owner_id, STRING_SHORT_LEN, "%s", s_borders->names[cid]);
-      t->political_color = s_borders->colors[cid];
+      civ_map_set_owner(map, (size_t)y * map->width + x, owner[cid],
+                        s_borders->colors[cid]);
     }
   }
+  free(owner);
   printf("[BORDERS] Applied to map\n");
 }
 
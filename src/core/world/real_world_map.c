@@ -1,48 +1,44 @@
 #include "core/world/real_world_map.h"
 #include "common.h"
+#include "utils/mapped_file.h"
 #include <stdio.h>
 #include <string.h>
 
 civ_result_t civ_earth_map_load(const char *filepath, civ_map_t *map) {
   if (!filepath || !map) return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null arg"};
 
-  FILE *f = fopen(filepath, "rb");
-  if (!f) return (civ_result_t){CIV_ERROR_IO, "Cannot open Earth map file"};
+  civ_mapped_file_t file;
+  if (!civ_mapped_file_open(&file, filepath))
+    return (civ_result_t){CIV_ERROR_IO, "Cannot open Earth map file"};
+  civ_result_t result = civ_earth_map_load_view(file.data, file.size, map);
+  civ_mapped_file_close(&file);
+  return result;
+}
+
+civ_result_t civ_earth_map_load_view(const uint8_t *data, size_t size,
+                                     civ_map_t *map) {
+  if (!map) return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null arg"};
 
   civ_earth_map_header_t hdr;
-  if (fread(&hdr, sizeof(hdr), 1, f) != 1) {
-    fclose(f);
+  if (!data || size < sizeof(hdr))
     return (civ_result_t){CIV_ERROR_IO, "Failed to read Earth map header"};
-  }
+  memcpy(&hdr, data, sizeof(hdr));
 
-  if (hdr.magic != CIV_EARTH_MAP_MAGIC) {
-    fclose(f);
+  if (hdr.magic != CIV_EARTH_MAP_MAGIC)
     return (civ_result_t){CIV_ERROR_INVALID_DATA, "Not a valid Earth map file"};
-  }
 
-  if (hdr.width != map->width || hdr.height != map->height) {
-    fclose(f);
+  if (hdr.width != map->width || hdr.height != map->height)
     return (civ_result_t){CIV_ERROR_INVALID_DATA,
                           "Earth map dimensions don't match game map"};
-  }
 
   map->sea_level = hdr.sea_level;
   map->seed = hdr.seed;
 
-  /* Read landmask: one byte per tile (packed for efficiency) */
+  /* Landmask: one byte per tile, read in place from the view */
   size_t tile_count = (size_t)hdr.width * hdr.height;
-  uint8_t *landmask = (uint8_t *)malloc(tile_count);
-  if (!landmask) {
-    fclose(f);
-    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, NULL};
-  }
-
-  if (fread(landmask, 1, tile_count, f) != tile_count) {
-    free(landmask);
-    fclose(f);
+  if (size - sizeof(hdr) < tile_count)
     return (civ_result_t){CIV_ERROR_IO, "Earth map data truncated"};
-  }
-  fclose(f);
+  const uint8_t *landmask = data + sizeof(hdr);
 
   /* Populate tiles from landmask */
   float polar_band = (float)hdr.height * 0.08f;
@@ -62,28 +58,28 @@ civ_result_t civ_earth_map_load(const char *filepath, civ_map_t *map) {
 
       tile->x = x;
       tile->y = y;
-      tile->elevation = is_land ? 0.4f + 0.3f * lat_factor : 0.05f + 0.1f * (1.0f - lat_factor);
-      tile->moisture = is_land ? 0.3f + 0.4f * lat_factor : 1.0f;
-      tile->temperature = 1.0f - fabsf(ny - 0.5f) * 2.0f;
+      civ_tile_set_elevation(tile, is_land ? 0.4f + 0.3f * lat_factor : 0.05f + 0.1f * (1.0f - lat_factor));
+      civ_tile_set_moisture(tile, is_land ? 0.3f + 0.4f * lat_factor : 1.0f);
+      civ_tile_set_temperature(tile, 1.0f - fabsf(ny - 0.5f) * 2.0f);
       tile->terrain = is_land ? CIV_TERRAIN_PLAIN : CIV_TERRAIN_COASTAL;
       tile->land_use = is_land ? CIV_LAND_USE_GRASSLAND : CIV_LAND_USE_WATER;
-      tile->fertility = is_land ? 0.3f + 0.4f * lat_factor : 0.0f;
-      tile->vegetation_density = is_land ? 0.2f + 0.5f * lat_factor : 0.0f;
+      civ_tile_set_fertility(tile, is_land ? 0.3f + 0.4f * lat_factor : 0.0f);
+      civ_tile_set_vegetation_density(tile, is_land ? 0.2f + 0.5f * lat_factor : 0.0f);
       tile->has_river = false;
       tile->has_resource = false;
-      tile->resources = is_land ? 0.3f : 0.0f;
+      civ_tile_set_resources(tile, is_land ? 0.3f : 0.0f);
       tile->is_explored = true;   /* Earth geography is known */
       tile->is_visible = false;    /* tactical visibility per unit */
-      tile->owner_id[0] = '\0';
-      tile->political_influence = is_land ? 0.3f : 0.0f;
-      tile->population_density = is_land ? 0.2f : 0.0f;
+      tile->owner_index = CIV_OWNER_NONE;
+      civ_tile_set_political_influence(tile, is_land ? 0.3f : 0.0f);
+      civ_tile_set_population_density(tile, is_land ? 0.2f : 0.0f);
       tile->cultural_influence = is_land ? 0.2f : 0.0f;
 
       if (is_land) map->land_tile_count++;
     }
   }
 
-  free(landmask);
+  civ_map_touch_all(map);
   return (civ_result_t){CIV_OK, "Earth map loaded"};
 }
 
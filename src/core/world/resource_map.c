@@ -5,6 +5,7 @@
 
 #include "core/world/resource_map.h"
 #include "common.h"
+#include "utils/mapped_file.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -31,55 +32,200 @@ void civ_resource_map_destroy(civ_resource_map_t *rm) {
     for (int i = 0; i < CIV_RESOURCE_COUNT; i++) {
         free(rm->deposits[i]);
     }
+    free(rm->tile_slots);
+    free(rm->tile_entries);
+    free(rm->depletions);
     free(rm);
 }
 
-static uint32_t read_u32(FILE *f) { uint32_t v; fread(&v, 4, 1, f); return v; }
-static uint16_t read_u16(FILE *f) { uint16_t v; fread(&v, 2, 1, f); return v; }
-static uint8_t  read_u8(FILE *f)  { uint8_t v;  fread(&v, 1, 1, f); return v; }
-
 civ_result_t civ_resource_map_load(civ_resource_map_t *rm, const char *filepath) {
     if (!rm || !filepath) return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "NULL argument"};
 
-    FILE *f = fopen(filepath, "rb");
-    if (!f) return (civ_result_t){CIV_ERROR_IO, "Cannot open file"};
+    civ_mapped_file_t file;
+    if (!civ_mapped_file_open(&file, filepath))
+        return (civ_result_t){CIV_ERROR_IO, "Cannot open file"};
+    civ_result_t result = civ_resource_map_load_view(rm, file.data, file.size);
+    civ_mapped_file_close(&file);
+    return result;
+}
+
+civ_result_t civ_resource_map_load_view(civ_resource_map_t *rm,
+                                        const uint8_t *data, size_t size) {
+    if (!rm) return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "NULL argument"};
+    civ_byte_reader_t r = civ_byte_reader_span(data, size);
+    rm->depletion_count = 0; /* the log is of the deposits being replaced */
+    rm->depletion_resets++;
 
-    uint32_t magic = read_u32(f);
-    if (magic != RESOURCE_MAGIC) { fclose(f); return (civ_result_t){CIV_ERROR_INVALID_DATA, "Bad magic"}; }
-    uint32_t version = read_u32(f); (void)version;
-    uint32_t width = read_u32(f);
-    uint32_t height = read_u32(f);
-    uint32_t type_count = read_u32(f);
+    uint32_t magic = civ_byte_reader_u32(&r);
+    if (magic != RESOURCE_MAGIC)
+        return (civ_result_t){CIV_ERROR_INVALID_DATA, "Bad magic"};
+    uint32_t version = civ_byte_reader_u32(&r); (void)version;
+    uint32_t width = civ_byte_reader_u32(&r); (void)width;
+    uint32_t height = civ_byte_reader_u32(&r); (void)height;
+    uint32_t type_count = civ_byte_reader_u32(&r);
 
-    if (type_count > CIV_RESOURCE_COUNT) {
-        fclose(f);
+    if (type_count > CIV_RESOURCE_COUNT)
         return (civ_result_t){CIV_ERROR_INVALID_DATA, "Too many resource types"};
-    }
 
+    /* Records are packed 7-byte (x, y, quantity, quality) tuples */
     for (uint32_t t = 0; t < type_count; t++) {
-        uint16_t count = read_u16(f);
+        uint16_t count = civ_byte_reader_u16(&r);
+        const uint8_t *rec = civ_byte_reader_take(&r, (size_t)count * 7);
+        if (!rec) break;
         rm->deposit_count[t] = count;
         if (count == 0) continue;
 
         rm->deposits[t] = calloc(count, sizeof(civ_resource_deposit_t));
         if (!rm->deposits[t]) {
-            fclose(f);
+            rm->deposit_count[t] = 0;
             return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "calloc deposits"};
         }
 
-        for (uint16_t i = 0; i < count; i++) {
-            rm->deposits[t][i].x = read_u16(f);
-            rm->deposits[t][i].y = read_u16(f);
-            rm->deposits[t][i].quantity = read_u16(f);
-            rm->deposits[t][i].quality = read_u8(f);
+        for (uint16_t i = 0; i < count; i++, rec += 7) {
+            civ_resource_deposit_t *d = &rm->deposits[t][i];
+            d->x = (uint16_t)(rec[0] | rec[1] << 8);
+            d->y = (uint16_t)(rec[2] | rec[3] << 8);
+            d->quantity = (uint16_t)(rec[4] | rec[5] << 8);
+            d->quality = rec[6];
         }
     }
 
-    fclose(f);
+    if (!r.ok) civ_log(CIV_LOG_WARNING, "Resource map data is truncated");
+    return civ_resource_map_build_index(rm);
+}
+
+/* ── Per-tile index ───────────────────────────────────────────── */
+typedef struct {
+    uint32_t tile;
+    uint8_t  type;
+    uint16_t deposit;
+} index_triple_t;
+
+static int cmp_triple(const void *a, const void *b) {
+    const index_triple_t *ta = a, *tb = b;
+    if (ta->tile != tb->tile) return ta->tile < tb->tile ? -1 : 1;
+    if (ta->type != tb->type) return ta->type < tb->type ? -1 : 1;
+    return (ta->deposit > tb->deposit) - (ta->deposit < tb->deposit);
+}
+
+static uint32_t hash_tile(uint32_t tile) {
+    return tile * 2654435761u;
+}
+
+static const civ_resource_tile_slot_t *lookup_slot(const civ_resource_map_t *rm,
+                                                   uint32_t tile) {
+    uint32_t h = hash_tile(tile) & rm->tile_slot_mask;
+    for (;;) {
+        const civ_resource_tile_slot_t *s = &rm->tile_slots[h];
+        if (s->tile_plus1 == 0) return NULL;
+        if (s->tile_plus1 == tile + 1) return s;
+        h = (h + 1) & rm->tile_slot_mask;
+    }
+}
+
+civ_result_t civ_resource_map_build_index(civ_resource_map_t *rm) {
+    if (!rm) return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "NULL argument"};
+    free(rm->tile_slots);
+    free(rm->tile_entries);
+    rm->tile_slots = NULL;
+    rm->tile_entries = NULL;
+    rm->tile_slot_mask = 0;
+    rm->tile_entry_count = 0;
+
+    size_t total = 0;
+    for (int t = 0; t < CIV_RESOURCE_COUNT; t++) total += rm->deposit_count[t];
+    if (total == 0) return (civ_result_t){CIV_OK, "Loaded"};
+
+    index_triple_t *triples = malloc(total * sizeof(*triples));
+    if (!triples) return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "malloc index"};
+    size_t n = 0;
+    for (int t = 0; t < CIV_RESOURCE_COUNT; t++) {
+        for (uint16_t i = 0; i < rm->deposit_count[t]; i++) {
+            const civ_resource_deposit_t *d = &rm->deposits[t][i];
+            if (d->x >= rm->width || d->y >= rm->height) continue;
+            triples[n++] = (index_triple_t){(uint32_t)d->y * rm->width + d->x,
+                                            (uint8_t)t, i};
+        }
+    }
+    qsort(triples, n, sizeof(*triples), cmp_triple);
+
+    /* Keep the first deposit per (tile, type), matching the old linear scan */
+    size_t kept = 0, tiles = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (kept > 0 && triples[kept - 1].tile == triples[i].tile &&
+            triples[kept - 1].type == triples[i].type)
+            continue;
+        if (kept == 0 || triples[kept - 1].tile != triples[i].tile) tiles++;
+        triples[kept++] = triples[i];
+    }
+
+    uint32_t size = 64;
+    while (size < tiles * 2) size <<= 1;
+    rm->tile_slots = calloc(size, sizeof(*rm->tile_slots));
+    rm->tile_entries = malloc((kept ? kept : 1) * sizeof(*rm->tile_entries));
+    if (!rm->tile_slots || !rm->tile_entries) {
+        free(rm->tile_slots);
+        free(rm->tile_entries);
+        rm->tile_slots = NULL;
+        rm->tile_entries = NULL;
+        free(triples);
+        return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "calloc index"};
+    }
+    rm->tile_slot_mask = size - 1;
+
+    for (size_t i = 0; i < kept; ) {
+        uint32_t tile = triples[i].tile;
+        uint32_t h = hash_tile(tile) & rm->tile_slot_mask;
+        while (rm->tile_slots[h].tile_plus1 != 0) h = (h + 1) & rm->tile_slot_mask;
+        civ_resource_tile_slot_t *slot = &rm->tile_slots[h];
+        slot->tile_plus1 = tile + 1;
+        slot->first = (uint32_t)i;
+        for (; i < kept && triples[i].tile == tile; i++) {
+            rm->tile_entries[i].type = triples[i].type;
+            rm->tile_entries[i].deposit = triples[i].deposit;
+            slot->count++;
+        }
+    }
+    rm->tile_entry_count = (uint32_t)kept;
+    free(triples);
     return (civ_result_t){CIV_OK, "Loaded"};
 }
 
-/* Linear scan over sparse deposits for the given tile and type */
+void civ_resource_map_deplete(civ_resource_map_t *rm, civ_resource_type_t type,
+                              uint16_t deposit) {
+    if (!rm || type < 0 || type >= CIV_RESOURCE_COUNT ||
+        deposit >= rm->deposit_count[type] || !rm->deposits[type])
+        return;
+    civ_resource_deposit_t *d = &rm->deposits[type][deposit];
+    if (d->quantity == 0 && d->quality == 0) return;
+
+    if (rm->depletion_count >= rm->depletion_capacity) {
+        uint32_t cap = rm->depletion_capacity ? rm->depletion_capacity * 2 : 64;
+        civ_resource_depletion_t *grown =
+            realloc(rm->depletions, cap * sizeof(*grown));
+        if (grown) {
+            rm->depletions = grown;
+            rm->depletion_capacity = cap;
+        }
+    }
+    if (rm->depletion_count < rm->depletion_capacity)
+        rm->depletions[rm->depletion_count++] =
+            (civ_resource_depletion_t){type, *d};
+    else
+        rm->depletion_resets++; /* readers rescan instead */
+    d->quantity = 0;
+    d->quality = 0;
+}
+
+static const civ_resource_tile_slot_t *tile_slot(const civ_resource_map_t *rm,
+                                                 int32_t x, int32_t y) {
+    if (!rm || !rm->tile_slots || x < 0 || y < 0 ||
+        (uint32_t)x >= rm->width || (uint32_t)y >= rm->height)
+        return NULL;
+    return lookup_slot(rm, (uint32_t)y * rm->width + (uint32_t)x);
+}
+
+/* Deposit for the given tile and type: indexed, else a linear scan */
 static const civ_resource_deposit_t *find_tile(
     const civ_resource_map_t *rm, int32_t x, int32_t y,
     civ_resource_type_t type) {
@@ -87,6 +233,17 @@ static const civ_resource_deposit_t *find_tile(
     if (!rm || x < 0 || y < 0 || (uint32_t)x >= rm->width || (uint32_t)y >= rm->height)
         return NULL;
 
+    if (rm->tile_slots) {
+        const civ_resource_tile_slot_t *s =
+            lookup_slot(rm, (uint32_t)y * rm->width + (uint32_t)x);
+        if (!s) return NULL;
+        for (uint8_t i = 0; i < s->count; i++) {
+            const civ_resource_tile_entry_t *e = &rm->tile_entries[s->first + i];
+            if (e->type == (uint8_t)type) return &rm->deposits[type][e->deposit];
+        }
+        return NULL;
+    }
+
     uint16_t count = rm->deposit_count[type];
     const civ_resource_deposit_t *deps = rm->deposits[type];
     if (!deps) return NULL;
@@ -118,10 +275,25 @@ uint8_t civ_resource_map_get_quality(const civ_resource_map_t *rm,
     return d ? d->quality : 0;
 }
 
+const civ_resource_deposit_t *civ_resource_map_find(const civ_resource_map_t *rm,
+                                                    int32_t x, int32_t y,
+                                                    civ_resource_type_t type) {
+    if (type < 0 || type >= CIV_RESOURCE_COUNT) return NULL;
+    return find_tile(rm, x, y, type);
+}
+
 uint16_t civ_resource_map_total_at_tile(const civ_resource_map_t *rm,
                                          int32_t x, int32_t y) {
     if (!rm) return 0;
     uint16_t total = 0;
+    if (rm->tile_slots) {
+        const civ_resource_tile_slot_t *s = tile_slot(rm, x, y);
+        for (uint8_t i = 0; s && i < s->count; i++) {
+            const civ_resource_tile_entry_t *e = &rm->tile_entries[s->first + i];
+            total += rm->deposits[e->type][e->deposit].quantity;
+        }
+        return total;
+    }
     for (int t = 0; t < CIV_RESOURCE_COUNT; t++) {
         const civ_resource_deposit_t *d = find_tile(rm, x, y, t);
         if (d) total += d->quantity;
@@ -132,6 +304,10 @@ uint16_t civ_resource_map_total_at_tile(const civ_resource_map_t *rm,
 int civ_resource_map_type_count_at_tile(const civ_resource_map_t *rm,
                                          int32_t x, int32_t y) {
     if (!rm) return 0;
+    if (rm->tile_slots) {
+        const civ_resource_tile_slot_t *s = tile_slot(rm, x, y);
+        return s ? s->count : 0;
+    }
     int count = 0;
     for (int t = 0; t < CIV_RESOURCE_COUNT; t++) {
         if (find_tile(rm, x, y, t)) count++;
@@ -139,6 +315,51 @@ int civ_resource_map_type_count_at_tile(const civ_resource_map_t *rm,
     return count;
 }
 
+size_t civ_resource_map_for_each_in_rect(const civ_resource_map_t *rm,
+                                          int32_t x0, int32_t y0,
+                                          int32_t x1, int32_t y1,
+                                          civ_resource_deposit_fn fn,
+                                          void *ctx) {
+    if (!rm || !fn || rm->width == 0 || rm->height == 0) return 0;
+    x0 = MAX(x0, 0);
+    y0 = MAX(y0, 0);
+    x1 = MIN(x1, (int32_t)rm->width - 1);
+    y1 = MIN(y1, (int32_t)rm->height - 1);
+    if (x0 > x1 || y0 > y1) return 0;
+
+    size_t visited = 0;
+    uint64_t area = (uint64_t)(x1 - x0 + 1) * (uint64_t)(y1 - y0 + 1);
+
+    /* Small rects probe the index per tile; large ones stream deposits */
+    if (rm->tile_slots && area <= rm->tile_entry_count) {
+        for (int32_t y = y0; y <= y1; y++) {
+            for (int32_t x = x0; x <= x1; x++) {
+                const civ_resource_tile_slot_t *s = tile_slot(rm, x, y);
+                for (uint8_t i = 0; s && i < s->count; i++) {
+                    const civ_resource_tile_entry_t *e = &rm->tile_entries[s->first + i];
+                    fn(ctx, (civ_resource_type_t)e->type, &rm->deposits[e->type][e->deposit]);
+                    visited++;
+                }
+            }
+        }
+        return visited;
+    }
+
+    for (int t = 0; t < CIV_RESOURCE_COUNT; t++) {
+        const civ_resource_deposit_t *deps = rm->deposits[t];
+        for (uint16_t i = 0; deps && i < rm->deposit_count[t]; i++) {
+            if (deps[i].x < x0 || deps[i].x > x1 || deps[i].y < y0 || deps[i].y > y1)
+                continue;
+            /* Same deposit the point queries would return */
+            if (rm->tile_slots && find_tile(rm, deps[i].x, deps[i].y, t) != &deps[i])
+                continue;
+            fn(ctx, (civ_resource_type_t)t, &deps[i]);
+            visited++;
+        }
+    }
+    return visited;
+}
+
 const char *civ_resource_type_name(civ_resource_type_t type) {
     if (type < 0 || type >= CIV_RESOURCE_COUNT) return "Unknown";
     return RESOURCE_NAMES[type];
@@ -0,0 +1,300 @@
+/**
+ * @file scenario.c
+ * @brief Synthetic worlds past the bundled real-world data
+ */
+
+#include "core/world/scenario.h"
+#include "core/world/owner_ids.h"
+#include "utils/rng.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Entity keys of the scenario's CIV_RNG_WORLDGEN streams */
+enum { STREAM_NATIONS = 0x5C01, STREAM_SETTLEMENTS, STREAM_UNITS };
+
+/* Draws per requested settlement or unit before giving up on open land */
+#define PLACE_ATTEMPTS 64
+
+bool civ_scenario_parse(const char *spec, civ_scenario_params_t *out) {
+  if (!spec || !out) return false;
+  civ_scenario_params_t p = {0};
+  for (const char *s = spec; *s;) {
+    size_t len = strcspn(s, ",");
+    const char *eq = memchr(s, '=', len);
+    if (!eq) return false;
+    size_t key_len = (size_t)(eq - s);
+    char *end;
+    long v = strtol(eq + 1, &end, 10);
+    if (key_len == 3 && strncmp(s, "map", 3) == 0) {
+      long h = *end == 'x' ? strtol(end + 1, &end, 10) : 0;
+      if (v < CIV_MIN_MAP_WIDTH || v > CIV_MAX_MAP_WIDTH ||
+          h < CIV_MIN_MAP_HEIGHT || h > CIV_MAX_MAP_HEIGHT)
+        return false;
+      p.map_width = (int32_t)v;
+      p.map_height = (int32_t)h;
+    } else if (key_len == 7 && strncmp(s, "nations", 7) == 0) {
+      if (v < 1 || v > CIV_SCENARIO_NATIONS_MAX) return false;
+      p.nations = (int)v;
+    } else if (key_len == 11 && strncmp(s, "settlements", 11) == 0) {
+      if (v < 0 || v > CIV_SCENARIO_SETTLEMENTS_MAX) return false;
+      p.settlements = (int)v;
+    } else if (key_len == 5 && strncmp(s, "units", 5) == 0) {
+      if (v < 0 || v > CIV_SCENARIO_UNITS_MAX) return false;
+      p.units = (int)v;
+    } else {
+      return false;
+    }
+    if (end != s + len) return false;
+    s += len;
+    if (*s == ',') s++;
+  }
+  *out = p;
+  return true;
+}
+
+bool civ_scenario_replaces_world(const civ_scenario_params_t *params) {
+  return params && (params->nations > 0 || params->map_width > 0);
+}
+
+/* ── Nations ────────────────────────────────────────────────────────── */
+
+/* Distinct, saturated colour per nation: golden-ratio hue steps */
+static uint32_t nation_color(int i) {
+  float h = (float)i * 0.6180339887f;
+  h = (h - (float)(int)h) * 6.0f;
+  int sector = (int)h;
+  float f = h - (float)sector;
+  uint8_t hi = 220, lo = 60;
+  uint8_t up = (uint8_t)(lo + f * (hi - lo)), down = (uint8_t)(hi - f * (hi - lo));
+  uint8_t r, g, b;
+  switch (sector) {
+  case 0:  r = hi;   g = up;   b = lo;   break;
+  case 1:  r = down; g = hi;   b = lo;   break;
+  case 2:  r = lo;   g = hi;   b = up;   break;
+  case 3:  r = lo;   g = down; b = hi;   break;
+  case 4:  r = up;   g = lo;   b = hi;   break;
+  default: r = hi;   g = lo;   b = down; break;
+  }
+  return (uint32_t)r << 16 | (uint32_t)g << 8 | b;
+}
+
+civ_result_t civ_scenario_claim_nations(civ_nation_manager_t *mgr,
+                                        civ_map_t *map,
+                                        const civ_scenario_params_t *params,
+                                        uint32_t seed) {
+  if (!mgr || !map || !params)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null scenario argument"};
+  int count = params->nations;
+  if (count <= 0 || mgr->count != 0 || count > mgr->capacity)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT,
+                          "Nation manager cannot hold the scenario"};
+
+  /* Lattice of cells roughly square in tiles, at least one per nation */
+  int cols = 1;
+  while ((int64_t)cols * cols * map->height < (int64_t)count * map->width)
+    cols++;
+  int rows = (count + cols - 1) / cols;
+  int cells = cols * rows;
+  float cell_w = (float)map->width / (float)cols;
+  float cell_h = (float)map->height / (float)rows;
+
+  /* Capital per cell, -1 for the cells left empty; cell_nation maps the
+     lattice to nations in a shuffled order so empty cells scatter */
+  int *cell_nation = CIV_MALLOC(sizeof(int) * (size_t)cells);
+  float *cap_x = CIV_MALLOC(sizeof(float) * (size_t)cells);
+  float *cap_y = CIV_MALLOC(sizeof(float) * (size_t)cells);
+  civ_owner_index_t *owners = CIV_MALLOC(sizeof(*owners) * (size_t)count);
+  if (!cell_nation || !cap_x || !cap_y || !owners) {
+    CIV_FREE(cell_nation);
+    CIV_FREE(cap_x);
+    CIV_FREE(cap_y);
+    CIV_FREE(owners);
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Scenario lattice"};
+  }
+
+  civ_rng_t rng;
+  civ_rng_seed_key(&rng, seed, CIV_RNG_WORLDGEN, 0, STREAM_NATIONS);
+  for (int c = 0; c < cells; c++) cell_nation[c] = c < count ? c : -1;
+  for (int c = cells - 1; c > 0; c--) {
+    int j = (int)civ_rng_range(&rng, (uint32_t)c + 1);
+    int t = cell_nation[c];
+    cell_nation[c] = cell_nation[j];
+    cell_nation[j] = t;
+  }
+
+  for (int c = 0; c < cells; c++) {
+    float x0 = (float)(c % cols) * cell_w, y0 = (float)(c / cols) * cell_h;
+    /* Prefer a capital on land; a cell of open sea keeps its last draw */
+    for (int attempt = 0; attempt < 16; attempt++) {
+      cap_x[c] = x0 + cell_w * (float)civ_rng_range(&rng, 1024) / 1024.0f;
+      cap_y[c] = y0 + cell_h * (float)civ_rng_range(&rng, 1024) / 1024.0f;
+      size_t i = (size_t)MIN((int32_t)cap_y[c], map->height - 1) * map->width +
+                 (size_t)MIN((int32_t)cap_x[c], map->width - 1);
+      if (!civ_map_is_water_at(map, i)) break;
+    }
+  }
+
+  for (int i = 0; i < count; i++) {
+    char id[CIV_NATION_ID_MAX], name[CIV_NATION_NAME_MAX];
+    snprintf(id, sizeof(id), "scn_%04d", i);
+    snprintf(name, sizeof(name), "Synthetic Nation %d", i + 1);
+    civ_nation_t *n = civ_nation_manager_add(mgr, id, name, nation_color(i));
+    if (!n) break;
+    n->population = 1000000 + (int64_t)civ_rng_range(&rng, 60000000);
+    n->gdp_per_capita = 500.0f + (float)civ_rng_range(&rng, 40000);
+    n->cost_of_living = 0.7f + (float)civ_rng_range(&rng, 100) / 200.0f;
+    n->tech_index = 100 + (int32_t)civ_rng_range(&rng, 400);
+    n->economic_index = 80 + (int32_t)civ_rng_range(&rng, 400);
+    n->military_index = 50 + (int32_t)civ_rng_range(&rng, 300);
+    n->cultural_index = 60 + (int32_t)civ_rng_range(&rng, 350);
+  }
+  civ_nation_manager_index_owners(mgr);
+  for (int i = 0; i < mgr->count; i++) owners[i] = mgr->nations[i].owner_index;
+  for (int c = 0; c < cells; c++) {
+    int ni = cell_nation[c];
+    if (ni < 0 || ni >= mgr->count) continue;
+    civ_nation_t *n = &mgr->nations[ni];
+    n->capital_lon = cap_x[c] / (float)(map->width - 1) * 360.0f - 180.0f;
+    n->capital_lat = 90.0f - cap_y[c] / (float)(map->height - 1) * 180.0f;
+  }
+
+  /* Each land tile goes to the nearest capital among the 3x3 cells
+     around its own; capitals never sit further than a cell out */
+  for (int32_t y = 0; y < map->height; y++) {
+    int cy = MIN((int)((float)y / cell_h), rows - 1);
+    for (int32_t x = 0; x < map->width; x++) {
+      size_t i = (size_t)y * map->width + x;
+      if (civ_map_is_water_at(map, i)) continue;
+      int cx = MIN((int)((float)x / cell_w), cols - 1);
+      int best = -1;
+      float best_d = 0.0f;
+      for (int ny = MAX(cy - 1, 0); ny <= MIN(cy + 1, rows - 1); ny++) {
+        for (int nx = MAX(cx - 1, 0); nx <= MIN(cx + 1, cols - 1); nx++) {
+          int c = ny * cols + nx;
+          if (cell_nation[c] < 0 || cell_nation[c] >= mgr->count) continue;
+          float dx = cap_x[c] - (float)x, dy = cap_y[c] - (float)y;
+          float d = dx * dx + dy * dy;
+          if (best < 0 || d < best_d) {
+            best = cell_nation[c];
+            best_d = d;
+          }
+        }
+      }
+      if (best >= 0)
+        civ_map_set_owner(map, i, owners[best], mgr->nations[best].color);
+    }
+  }
+
+  CIV_FREE(cell_nation);
+  CIV_FREE(cap_x);
+  CIV_FREE(cap_y);
+  CIV_FREE(owners);
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+/* ── Settlements and units ──────────────────────────────────────────── */
+
+/* A random owned land tile and its nation; false when none turned up */
+static bool draw_owned_tile(civ_rng_t *rng, const civ_nation_manager_t *mgr,
+                            const civ_map_t *map, int32_t *x, int32_t *y,
+                            const civ_nation_t **owner) {
+  for (int attempt = 0; attempt < PLACE_ATTEMPTS; attempt++) {
+    int32_t tx = (int32_t)civ_rng_range(rng, (uint32_t)map->width);
+    int32_t ty = (int32_t)civ_rng_range(rng, (uint32_t)map->height);
+    size_t i = (size_t)ty * map->width + tx;
+    if (civ_map_is_water_at(map, i)) continue;
+    civ_owner_index_t o = civ_map_owner_at(map, i);
+    if (o == CIV_OWNER_NONE || o >= mgr->owner_nation_size) continue;
+    int ni = mgr->owner_nation[o];
+    if (ni < 0 || ni >= mgr->count) continue;
+    *x = tx;
+    *y = ty;
+    *owner = &mgr->nations[ni];
+    return true;
+  }
+  return false;
+}
+
+civ_result_t civ_scenario_place_settlements(
+    civ_settlement_manager_t *sm, const civ_nation_manager_t *mgr,
+    const civ_map_t *map, const civ_scenario_params_t *params, uint32_t seed) {
+  if (!sm || !mgr || !map || !params)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null scenario argument"};
+
+  civ_rng_t rng;
+  civ_rng_seed_key(&rng, seed, CIV_RNG_WORLDGEN, 0, STREAM_SETTLEMENTS);
+  int placed = 0;
+  for (int k = 0; k < params->settlements; k++) {
+    int32_t x, y;
+    const civ_nation_t *owner;
+    if (!draw_owned_tile(&rng, mgr, map, &x, &y, &owner)) break;
+
+    civ_settlement_t s;
+    memset(&s, 0, sizeof(s));
+    snprintf(s.id, sizeof(s.id), "scn_settle_%d", k);
+    if (!civ_settlement_manager_generate_name(sm, owner->id, s.name,
+                                              sizeof(s.name)))
+      snprintf(s.name, sizeof(s.name), "Settlement %d", k + 1);
+    snprintf(s.region_id, sizeof(s.region_id), "%s", owner->id);
+    /* Mostly hamlets and villages, the way a real census falls */
+    uint32_t roll = civ_rng_range(&rng, 100);
+    s.tier = roll < 50 ? CIV_SETTLEMENT_HAMLET
+           : roll < 80 ? CIV_SETTLEMENT_VILLAGE
+           : roll < 95 ? CIV_SETTLEMENT_TOWN
+           : roll < 99 ? CIV_SETTLEMENT_CITY
+                       : CIV_SETTLEMENT_METROPOLIS;
+    static const int64_t base_pop[] = {200, 2000, 10000, 50000, 500000};
+    s.population = base_pop[s.tier] + (int64_t)civ_rng_range(&rng, (uint32_t)base_pop[s.tier]);
+    s.x = (civ_float_t)x + 0.5f;
+    s.y = (civ_float_t)y + 0.5f;
+    s.attractiveness = 0.2f + (float)civ_rng_range(&rng, 80) / 100.0f;
+    s.culture_yield = 1.0f;
+    s.territory_radius = 2 + (int32_t)s.tier;
+    s.loyalty = 1.0f;
+    s.demographics.race_pop[0] = s.population;
+    s.demographics.language_pop[0] = s.population;
+    s.demographics.faith_pop[0] = s.population;
+    if (CIV_FAILED(civ_settlement_manager_add(sm, &s))) break;
+    placed++;
+  }
+  if (placed < params->settlements)
+    civ_log(CIV_LOG_WARNING, "Scenario: placed %d of %d settlements", placed,
+            params->settlements);
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+civ_result_t civ_scenario_place_units(civ_unit_manager_t *um,
+                                      const civ_nation_manager_t *mgr,
+                                      const civ_map_t *map,
+                                      const civ_scenario_params_t *params,
+                                      uint32_t seed) {
+  if (!um || !mgr || !map || !params)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null scenario argument"};
+
+  civ_rng_t rng;
+  civ_rng_seed_key(&rng, seed, CIV_RNG_WORLDGEN, 0, STREAM_UNITS);
+  int placed = 0;
+  for (int k = 0; k < params->units; k++) {
+    int32_t x, y;
+    const civ_nation_t *owner;
+    if (!draw_owned_tile(&rng, mgr, map, &x, &y, &owner)) break;
+
+    /* Every combat type; settlers would found cities mid-benchmark */
+    civ_unit_type_t type =
+        (civ_unit_type_t)civ_rng_range(&rng, CIV_UNIT_TYPE_SPECIAL_FORCES + 1);
+    char name[STRING_MEDIUM_LEN];
+    snprintf(name, sizeof(name), "%s Corps %d", owner->id, k + 1);
+    int32_t u = civ_unit_manager_resolve(
+        um, civ_unit_manager_spawn_unit(um, type, name,
+                                        50 + (int32_t)civ_rng_range(&rng, 150),
+                                        x, y));
+    if (u < 0) break;
+    civ_unit_manager_set_owner(um, (size_t)u, civ_symbol_intern(owner->id));
+    placed++;
+  }
+  if (placed < params->units)
+    civ_log(CIV_LOG_WARNING, "Scenario: placed %d of %d units", placed,
+            params->units);
+  return (civ_result_t){CIV_OK, NULL};
+}
@@ -5,10 +5,96 @@
 
 #include "core/world/settlement_manager.h"
 #include "core/governance/government.h"
+#include "core/world/modifier_stack.h"
+#include "utils/rng.h"
+#include "utils/store_registry.h"
 #include <math.h>
 #include <stdio.h>
 #include <string.h>
 
+/* ---- Spatial index ---- */
+
+static int32_t cell_of(civ_float_t v) {
+  return (int32_t)floorf(v / CIV_SETTLEMENT_CELL_SIZE);
+}
+
+static int32_t bucket_of(int32_t owner, int32_t cx, int32_t cy) {
+  uint32_t h = (uint32_t)owner * 83492791u ^ (uint32_t)cx * 73856093u ^
+               (uint32_t)cy * 19349663u;
+  return (int32_t)(h & (CIV_SETTLEMENT_HASH_BUCKETS - 1));
+}
+
+static int32_t owner_slot(const civ_settlement_manager_t *manager,
+                          civ_symbol_t region) {
+  for (size_t i = 0; i < manager->owner_count; i++)
+    if (manager->owner_syms[i] == region)
+      return (int32_t)i;
+  return -1;
+}
+
+static int32_t intern_owner(civ_settlement_manager_t *manager,
+                            civ_symbol_t region) {
+  int32_t found = owner_slot(manager, region);
+  if (found >= 0)
+    return found;
+  if (manager->owner_count >= manager->owner_capacity) {
+    size_t new_cap = manager->owner_capacity ? manager->owner_capacity * 2 : 8;
+    civ_symbol_t *syms =
+        CIV_REALLOC(manager->owner_syms, new_cap * sizeof(*syms));
+    if (!syms)
+      return -1;
+    manager->owner_syms = syms;
+    civ_owner_index_t *ids =
+        CIV_REALLOC(manager->owner_ids, new_cap * sizeof(*ids));
+    if (!ids)
+      return -1;
+    manager->owner_ids = ids;
+    manager->owner_capacity = new_cap;
+  }
+  manager->owner_syms[manager->owner_count] = region;
+  manager->owner_ids[manager->owner_count] =
+      civ_owner_intern(civ_symbol_name(region));
+  return (int32_t)manager->owner_count++;
+}
+
+/* Ids are compared as stored, so intern only the part region_id keeps */
+static civ_symbol_t region_symbol(const char *region_id, bool add) {
+  char id[STRING_SHORT_LEN];
+  strncpy(id, region_id, STRING_SHORT_LEN - 1);
+  id[STRING_SHORT_LEN - 1] = '\0';
+  return add ? civ_symbol_intern(id) : civ_symbol_find(id);
+}
+
+static void index_insert(civ_settlement_manager_t *manager, size_t i) {
+  civ_settlement_t *s = &manager->settlements[i];
+  s->index_bucket = -1;
+  s->index_next = -1;
+  if (s->owner_index < 0)
+    return;
+  int32_t cx = cell_of(s->x), cy = cell_of(s->y);
+  int32_t b = bucket_of(s->owner_index, cx, cy);
+  s->index_bucket = b;
+  s->index_next = manager->bucket_heads[b];
+  manager->bucket_heads[b] = (int32_t)i;
+  manager->cell_min_x = MIN(manager->cell_min_x, cx);
+  manager->cell_max_x = MAX(manager->cell_max_x, cx);
+  manager->cell_min_y = MIN(manager->cell_min_y, cy);
+  manager->cell_max_y = MAX(manager->cell_max_y, cy);
+}
+
+static void index_remove(civ_settlement_manager_t *manager, size_t i) {
+  civ_settlement_t *s = &manager->settlements[i];
+  if (s->index_bucket < 0)
+    return;
+  int32_t *link = &manager->bucket_heads[s->index_bucket];
+  while (*link >= 0 && *link != (int32_t)i)
+    link = &manager->settlements[*link].index_next;
+  if (*link == (int32_t)i)
+    *link = s->index_next;
+  s->index_bucket = -1;
+  s->index_next = -1;
+}
+
 civ_settlement_manager_t *civ_settlement_manager_create(void) {
   civ_settlement_manager_t *manager =
       CIV_MALLOC(sizeof(civ_settlement_manager_t));
@@ -17,13 +103,34 @@ civ_settlement_manager_t *civ_settlement_manager_create(void) {
     manager->settlement_count = 0;
     manager->settlement_capacity = 0;
     manager->min_distance = 10.0f; // Arbitrary unit distance
+    for (int i = 0; i < CIV_SETTLEMENT_HASH_BUCKETS; i++)
+      manager->bucket_heads[i] = -1;
+    manager->owner_syms = NULL;
+    manager->owner_ids = NULL;
+    manager->owner_count = 0;
+    manager->owner_capacity = 0;
+    manager->cell_min_x = manager->cell_min_y = INT32_MAX;
+    manager->cell_max_x = manager->cell_max_y = INT32_MIN;
+    manager->naming = NULL;
+    manager->next_serial = 0;
+    manager->year = manager->day = 0;
+    CIV_STORE_REGISTER("world.settlements", manager, manager->settlement_count,
+                       manager->settlement_capacity, sizeof(civ_settlement_t),
+                       CIV_STORE_INDEXED);
+    /* owner_slot walks the interned owners */
+    CIV_STORE_REGISTER("world.settlement_owners", manager, manager->owner_count,
+                       manager->owner_capacity, sizeof(civ_symbol_t),
+                       CIV_STORE_SCANNED);
   }
   return manager;
 }
 
 void civ_settlement_manager_destroy(civ_settlement_manager_t *manager) {
   if (manager) {
+    civ_store_unregister_owner(manager);
     CIV_FREE(manager->settlements);
+    CIV_FREE(manager->owner_syms);
+    CIV_FREE(manager->owner_ids);
     CIV_FREE(manager);
   }
 }
@@ -45,14 +152,351 @@ civ_result_t civ_settlement_manager_add(civ_settlement_manager_t *manager,
     manager->settlement_capacity = new_cap;
   }
 
-  manager->settlements[manager->settlement_count++] = *settlement;
+  civ_settlement_t *s = &manager->settlements[manager->settlement_count++];
+  *s = *settlement;
+  s->id[STRING_SHORT_LEN - 1] = '\0';
+  s->id_sym = civ_symbol_intern(s->id);
+  if (strstr(s->id, "rival"))
+    civ_symbol_add_flags(s->id_sym, CIV_SYMBOL_FLAG_RIVAL);
+  s->region_sym = civ_symbol_intern(s->region_id);
+  s->owner_index = intern_owner(manager, s->region_sym);
+  index_insert(manager, manager->settlement_count - 1);
+  /* Loaded and hand-named settlements keep generated names off theirs */
+  if (manager->naming)
+    civ_naming_reserve(manager->naming, s->name);
+  /* and founded ones keep later ids off theirs */
+  unsigned serial;
+  char tail;
+  if (sscanf(s->id, "settle_%u%c", &serial, &tail) == 1 &&
+      serial >= manager->next_serial)
+    manager->next_serial = serial + 1;
   return (civ_result_t){CIV_OK, "Settlement added"};
 }
 
+void civ_settlement_manager_set_date(civ_settlement_manager_t *manager,
+                                     int32_t year, int32_t day) {
+  if (!manager)
+    return;
+  manager->year = year;
+  manager->day = day;
+}
+
+int32_t civ_settlement_manager_owner_index(
+    const civ_settlement_manager_t *manager, const char *region_id) {
+  if (!manager || !region_id)
+    return -1;
+  return owner_slot(manager, region_symbol(region_id, false));
+  return -1;
+}
+
+civ_result_t civ_settlement_manager_set_owner(civ_settlement_manager_t *manager,
+                                              civ_settlement_t *settlement,
+                                              const char *region_id) {
+  if (!manager || !settlement || !region_id)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Invalid args"};
+  size_t i = (size_t)(settlement - manager->settlements);
+  if (i >= manager->settlement_count)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Not in manager"};
+
+  civ_symbol_t region = region_symbol(region_id, true);
+  int32_t owner = intern_owner(manager, region);
+  if (owner < 0)
+    return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "OOM"};
+  strncpy(settlement->region_id, region_id, STRING_SHORT_LEN - 1);
+  settlement->region_id[STRING_SHORT_LEN - 1] = '\0';
+  settlement->region_sym = region;
+  if (owner != settlement->owner_index) {
+    index_remove(manager, i);
+    settlement->owner_index = owner;
+    index_insert(manager, i);
+  }
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+static bool owner_matches(const civ_settlement_t *s, int32_t owner) {
+  return owner == CIV_SETTLEMENT_ANY_OWNER || s->owner_index == owner;
+}
+
+static civ_float_t dist2(const civ_settlement_t *s, civ_float_t x,
+                         civ_float_t y) {
+  civ_float_t dx = s->x - x, dy = s->y - y;
+  return dx * dx + dy * dy;
+}
+
+/* Walk bucket chains of one cell across the requested owner(s) */
+#define FOR_CELL(manager, owner, cx, cy, s, body)                             \
+  do {                                                                        \
+    int32_t o0_ = (owner) == CIV_SETTLEMENT_ANY_OWNER ? 0 : (owner);          \
+    int32_t o1_ = (owner) == CIV_SETTLEMENT_ANY_OWNER                         \
+                      ? (int32_t)(manager)->owner_count - 1                   \
+                      : (owner);                                              \
+    for (int32_t o_ = o0_; o_ <= o1_; o_++) {                                 \
+      int32_t i_ = (manager)->bucket_heads[bucket_of(o_, (cx), (cy))];        \
+      for (; i_ >= 0; i_ = (manager)->settlements[i_].index_next) {           \
+        civ_settlement_t *s = &(manager)->settlements[i_];                    \
+        if (s->owner_index != o_ || cell_of(s->x) != (cx) ||                  \
+            cell_of(s->y) != (cy))                                            \
+          continue;                                                           \
+        body                                                                  \
+      }                                                                       \
+    }                                                                         \
+  } while (0)
+
+civ_settlement_t *civ_settlement_manager_nearest(
+    const civ_settlement_manager_t *manager, int32_t owner, civ_float_t x,
+    civ_float_t y, civ_float_t *out_dist) {
+  if (!manager || manager->settlement_count == 0 ||
+      (owner != CIV_SETTLEMENT_ANY_OWNER &&
+       (owner < 0 || owner >= (int32_t)manager->owner_count)))
+    return NULL;
+
+  civ_settlement_t *best = NULL;
+  civ_float_t best_d2 = 0.0f;
+  int32_t cx = cell_of(x), cy = cell_of(y);
+  int32_t owners = owner == CIV_SETTLEMENT_ANY_OWNER
+                       ? (int32_t)manager->owner_count : 1;
+  int64_t reach = MAX(MAX((int64_t)cx - manager->cell_min_x,
+                          (int64_t)manager->cell_max_x - cx),
+                      MAX((int64_t)cy - manager->cell_min_y,
+                          (int64_t)manager->cell_max_y - cy));
+
+  /* Rings of cells outward until no closer cell can remain. Sparse indexes
+     would visit more empty cells than a flat scan reads settlements, so
+     the walk gives up to a scan once it has spent that budget. */
+  int64_t budget = (int64_t)manager->settlement_count, spent = 0;
+  bool exhausted = false;
+  for (int32_t r = 0; r <= reach && !exhausted; r++) {
+    /* Every point of ring r is at least (r - 1) cells away */
+    civ_float_t bound = (civ_float_t)(r - 1) * CIV_SETTLEMENT_CELL_SIZE;
+    if (best && r > 0 && bound * bound > best_d2)
+      break;
+    for (int32_t gy = cy - r; gy <= cy + r && !exhausted; gy++) {
+      int32_t step = (gy == cy - r || gy == cy + r) ? 1 : 2 * r;
+      for (int32_t gx = cx - r; gx <= cx + r; gx += step) {
+        if ((spent += owners) > budget) {
+          exhausted = true;
+          break;
+        }
+        FOR_CELL(manager, owner, gx, gy, s, {
+          civ_float_t d2 = dist2(s, x, y);
+          if (!best || d2 < best_d2 || (d2 == best_d2 && s < best)) {
+            best = s;
+            best_d2 = d2;
+          }
+        });
+      }
+    }
+  }
+
+  if (exhausted) {
+    best = NULL;
+    for (size_t i = 0; i < manager->settlement_count; i++) {
+      civ_settlement_t *s = &manager->settlements[i];
+      if (s->index_bucket < 0 || !owner_matches(s, owner))
+        continue;
+      civ_float_t d2 = dist2(s, x, y);
+      if (!best || d2 < best_d2) {
+        best = s;
+        best_d2 = d2;
+      }
+    }
+  }
+
+  if (best && out_dist)
+    *out_dist = sqrtf(best_d2);
+  return best;
+}
+
+static int compare_index(const void *a, const void *b) {
+  size_t ia = *(const size_t *)a, ib = *(const size_t *)b;
+  return (ia > ib) - (ia < ib);
+}
+
+size_t civ_settlement_manager_query_radius(
+    const civ_settlement_manager_t *manager, int32_t owner, civ_float_t x,
+    civ_float_t y, civ_float_t radius, size_t *out, size_t max) {
+  if (!manager || radius <= 0.0f ||
+      (owner != CIV_SETTLEMENT_ANY_OWNER &&
+       (owner < 0 || owner >= (int32_t)manager->owner_count)))
+    return 0;
+
+  size_t found = 0;
+  civ_float_t r2 = radius * radius;
+  int32_t cx0 = MAX(cell_of(x - radius), manager->cell_min_x);
+  int32_t cx1 = MIN(cell_of(x + radius), manager->cell_max_x);
+  int32_t cy0 = MAX(cell_of(y - radius), manager->cell_min_y);
+  int32_t cy1 = MIN(cell_of(y + radius), manager->cell_max_y);
+  if (cx1 < cx0 || cy1 < cy0)
+    return 0;
+  int64_t owners = owner == CIV_SETTLEMENT_ANY_OWNER
+                       ? (int64_t)manager->owner_count : 1;
+  int64_t cells = ((int64_t)cx1 - cx0 + 1) * ((int64_t)cy1 - cy0 + 1);
+
+  if (cells * owners > (int64_t)manager->settlement_count) {
+    for (size_t i = 0; i < manager->settlement_count; i++) {
+      const civ_settlement_t *s = &manager->settlements[i];
+      if (s->index_bucket < 0 || !owner_matches(s, owner) ||
+          dist2(s, x, y) >= r2)
+        continue;
+      if (found < max)
+        out[found] = i;
+      found++;
+    }
+    return found;
+  }
+
+  for (int32_t gy = cy0; gy <= cy1; gy++) {
+    for (int32_t gx = cx0; gx <= cx1; gx++) {
+      FOR_CELL(manager, owner, gx, gy, s, {
+        if (dist2(s, x, y) < r2) {
+          if (found < max)
+            out[found] = (size_t)(s - manager->settlements);
+          found++;
+        }
+      });
+    }
+  }
+  if (out)
+    qsort(out, MIN(found, max), sizeof(size_t), compare_index);
+  return found;
+}
+
+static bool in_rect(const civ_settlement_t *s, civ_float_t x0, civ_float_t y0,
+                    civ_float_t x1, civ_float_t y1) {
+  return s->x >= x0 && s->x < x1 && s->y >= y0 && s->y < y1;
+}
+
+size_t civ_settlement_manager_query_rect(
+    const civ_settlement_manager_t *manager, civ_float_t x0, civ_float_t y0,
+    civ_float_t x1, civ_float_t y1, size_t *out, size_t max) {
+  if (!manager || x1 <= x0 || y1 <= y0)
+    return 0;
+
+  size_t found = 0;
+  int32_t cx0 = MAX(cell_of(x0), manager->cell_min_x);
+  int32_t cx1 = MIN(cell_of(x1), manager->cell_max_x);
+  int32_t cy0 = MAX(cell_of(y0), manager->cell_min_y);
+  int32_t cy1 = MIN(cell_of(y1), manager->cell_max_y);
+  if (cx1 < cx0 || cy1 < cy0)
+    return 0;
+  int64_t cells = ((int64_t)cx1 - cx0 + 1) * ((int64_t)cy1 - cy0 + 1);
+
+  /* Same trade as the radius query: past one cell visit per settlement a
+     flat scan is cheaper */
+  if (cells * (int64_t)manager->owner_count > (int64_t)manager->settlement_count) {
+    for (size_t i = 0; i < manager->settlement_count; i++) {
+      const civ_settlement_t *s = &manager->settlements[i];
+      if (s->index_bucket < 0 || !in_rect(s, x0, y0, x1, y1))
+        continue;
+      if (found < max)
+        out[found] = i;
+      found++;
+    }
+    return found;
+  }
+
+  for (int32_t gy = cy0; gy <= cy1; gy++) {
+    for (int32_t gx = cx0; gx <= cx1; gx++) {
+      FOR_CELL(manager, CIV_SETTLEMENT_ANY_OWNER, gx, gy, s, {
+        if (in_rect(s, x0, y0, x1, y1)) {
+          if (found < max)
+            out[found] = (size_t)(s - manager->settlements);
+          found++;
+        }
+      });
+    }
+  }
+  if (out)
+    qsort(out, MIN(found, max), sizeof(size_t), compare_index);
+  return found;
+}
+
+civ_settlement_t *civ_settlement_manager_at(
+    const civ_settlement_manager_t *manager, int32_t tx, int32_t ty) {
+  if (!manager)
+    return NULL;
+  /* Positions truncating to tx lie in (tx - 1, tx + 1) */
+  civ_settlement_t *hit = NULL;
+  int32_t cx0 = cell_of((civ_float_t)tx - 1.0f), cx1 = cell_of((civ_float_t)tx + 1.0f);
+  int32_t cy0 = cell_of((civ_float_t)ty - 1.0f), cy1 = cell_of((civ_float_t)ty + 1.0f);
+  for (int32_t gy = cy0; gy <= cy1; gy++) {
+    for (int32_t gx = cx0; gx <= cx1; gx++) {
+      FOR_CELL(manager, CIV_SETTLEMENT_ANY_OWNER, gx, gy, s, {
+        if ((int32_t)s->x == tx && (int32_t)s->y == ty && (!hit || s < hit))
+          hit = s;
+      });
+    }
+  }
+  return hit;
+}
+
 civ_float_t civ_calculate_site_suitability(civ_float_t x, civ_float_t y) {
   // Placeholder: In real game, query terrain, resources, water access here.
   // For now, return random suitability
-  return (civ_float_t)(rand() % 100) / 100.0f;
+  return (civ_float_t)(civ_rand() % 100) / 100.0f;
+}
+
+#define SETTLEMENT_NAME_MIN 4 /* letters */
+#define SETTLEMENT_NAME_MAX 9
+
+bool civ_settlement_manager_generate_name(civ_settlement_manager_t *manager,
+                                          const char *culture, char *out,
+                                          size_t size) {
+  if (!manager || !manager->naming || !out || size == 0)
+    return false;
+  civ_name_t name = civ_naming_generate(manager->naming, NULL,
+                                        culture ? culture : "", CIV_NAME_CITY,
+                                        SETTLEMENT_NAME_MIN, SETTLEMENT_NAME_MAX);
+  if (!name)
+    return false;
+  snprintf(out, size, "%s", civ_naming_text(manager->naming, name));
+  return true;
+}
+
+/* A new hamlet at (x, y) belonging to region_id ("" for none) */
+static civ_result_t found_at(civ_settlement_manager_t *manager, civ_float_t x,
+                             civ_float_t y, civ_float_t suitability,
+                             const char *region_id) {
+  civ_settlement_t new_town;
+  memset(&new_town, 0, sizeof(civ_settlement_t));
+  snprintf(new_town.id, STRING_SHORT_LEN, "settle_%u", manager->next_serial);
+  if (!civ_settlement_manager_generate_name(manager, region_id, new_town.name,
+                                            sizeof(new_town.name)))
+    snprintf(new_town.name, STRING_MEDIUM_LEN, "New Settlement %zu",
+             manager->settlement_count + 1);
+  snprintf(new_town.region_id, STRING_SHORT_LEN, "%s", region_id);
+  new_town.tier = CIV_SETTLEMENT_HAMLET;
+  new_town.x = x;
+  new_town.y = y;
+  new_town.population = 100; // Starting pop
+  new_town.founded_year = manager->year;
+  new_town.founded_day = manager->day;
+  new_town.attractiveness = suitability;
+  new_town.culture_yield = 1.0f;
+  new_town.accumulated_culture = 0.0f;
+  new_town.territory_radius = 2; /* Start with small radius */
+
+  /* Phase 9/11: Initialize Sovereign Affairs & Identity */
+  new_town.loyalty = 1.0f;
+  new_town.unrest = 0.0f;
+  new_town.primary_ethnicity = 0; /* Default */
+  new_town.primary_language = 0;
+  new_town.primary_faith = 0;
+
+  /* Initialize demographic populations with the 100 residents */
+  memset(&new_town.demographics, 0, sizeof(civ_demographic_stats_t));
+  new_town.demographics.race_pop[0] = 100;
+  new_town.demographics.language_pop[0] = 100;
+  new_town.demographics.faith_pop[0] = 100;
+
+  return civ_settlement_manager_add(manager, &new_town);
+}
+
+static bool too_close(const civ_settlement_manager_t *manager, civ_float_t x,
+                      civ_float_t y) {
+  return civ_settlement_manager_query_radius(manager, CIV_SETTLEMENT_ANY_OWNER,
+                                             x, y, manager->min_distance, NULL,
+                                             0) > 0;
 }
 
 civ_result_t civ_attempt_settlement_spawn(civ_settlement_manager_t *manager,
@@ -61,59 +505,41 @@ civ_result_t civ_attempt_settlement_spawn(civ_settlement_manager_t *manager,
     return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "No manager"};
 
   // Check distance to existing
-  for (size_t i = 0; i < manager->settlement_count; i++) {
-    civ_float_t dx = manager->settlements[i].x - x;
-    civ_float_t dy = manager->settlements[i].y - y;
-    if (sqrt(dx * dx + dy * dy) < manager->min_distance) {
-      return (civ_result_t){CIV_ERROR_INVALID_STATE, "Too close to existing"};
-    }
-  }
+  if (too_close(manager, x, y))
+    return (civ_result_t){CIV_ERROR_INVALID_STATE, "Too close to existing"};
 
   civ_float_t suitability = civ_calculate_site_suitability(x, y);
-  if (suitability > 0.7f) {
-    civ_settlement_t new_town;
-    memset(&new_town, 0, sizeof(civ_settlement_t));
-    snprintf(new_town.id, STRING_SHORT_LEN, "settle_%ld", (long)time(NULL));
-    snprintf(new_town.name, STRING_MEDIUM_LEN, "New Settlement %zu",
-             manager->settlement_count + 1);
-    new_town.tier = CIV_SETTLEMENT_HAMLET;
-    new_town.x = x;
-    new_town.y = y;
-    new_town.population = 100; // Starting pop
-    new_town.founded_date = time(NULL);
-    new_town.attractiveness = suitability;
-    new_town.culture_yield = 1.0f;
-    new_town.accumulated_culture = 0.0f;
-    new_town.territory_radius = 2; /* Start with small radius */
-
-    /* Phase 9/11: Initialize Sovereign Affairs & Identity */
-    new_town.loyalty = 1.0f;
-    new_town.unrest = 0.0f;
-    new_town.primary_ethnicity = 0; /* Default */
-    new_town.primary_language = 0;
-    new_town.primary_faith = 0;
-
-    /* Initialize demographic populations with the 100 residents */
-    memset(&new_town.demographics, 0, sizeof(civ_demographic_stats_t));
-    new_town.demographics.race_pop[0] = 100;
-    new_town.demographics.language_pop[0] = 100;
-    new_town.demographics.faith_pop[0] = 100;
-
-    return civ_settlement_manager_add(manager, &new_town);
-  }
+  if (suitability > 0.7f)
+    return found_at(manager, x, y, suitability, "");
 
   return (civ_result_t){CIV_OK, "Not suitable"};
 }
 
+civ_result_t civ_settlement_manager_found(civ_settlement_manager_t *manager,
+                                          civ_float_t x, civ_float_t y,
+                                          civ_float_t suitability,
+                                          const char *owner_id) {
+  if (!manager)
+    return (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "No manager"};
+  if (too_close(manager, x, y))
+    return (civ_result_t){CIV_ERROR_INVALID_STATE, "Too close to existing"};
+  return found_at(manager, x, y, CLAMP(suitability, 0.0f, 1.0f),
+                  owner_id ? owner_id : "");
+}
+
 civ_result_t civ_settlement_manager_update(civ_settlement_manager_t *manager,
                                            civ_map_t *map,
                                            struct civ_government *gov,
+                                           const civ_modifier_table_t *modifiers,
                                            civ_float_t time_delta) {
   if (!manager)
     return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null manager"};
 
   for (size_t i = 0; i < manager->settlement_count; i++) {
     civ_settlement_t *s = &manager->settlements[i];
+    const civ_modifier_stack_t *mods = civ_modifier_stack_of(
+        modifiers, s->owner_index >= 0 ? manager->owner_ids[s->owner_index]
+                                       : CIV_OWNER_NONE);
 
     // Organic growth
     civ_float_t growth = s->population * 0.01f * s->attractiveness * time_delta;
@@ -133,11 +559,12 @@ civ_result_t civ_settlement_manager_update(civ_settlement_manager_t *manager,
     if (s->is_producing) {
       /* Base 2.0 + 1.0 per 2000 population */
       civ_float_t prod_rate = 2.0f + floorf((float)s->population / 2000.0f);
-      s->production_progress += prod_rate * time_delta;
+      s->production_progress += prod_rate * mods->production * time_delta;
     }
 
     // Culture generation
-    s->culture_yield = 1.0f + floorf((float)s->population / 5000.0f);
+    s->culture_yield =
+        (1.0f + floorf((float)s->population / 5000.0f)) * mods->culture;
     s->accumulated_culture += s->culture_yield * time_delta;
 
     // Phase 9/11: Loyalty and Unrest Updates
@@ -169,16 +596,6 @@ civ_result_t civ_settlement_manager_update(civ_settlement_manager_t *manager,
       }
     }
 
-    /* Apply Institutional Bonuses */
-    civ_float_t prod_mult = 1.0f;
-    civ_float_t science_mult = 1.0f;
-    if (gov && gov->institution_manager) {
-      prod_mult += civ_institution_get_total_bonus(
-          gov->institution_manager, CIV_INSTITUTION_FOCUS_PRODUCTION);
-      science_mult += civ_institution_get_total_bonus(
-          gov->institution_manager, CIV_INSTITUTION_FOCUS_RESEARCH);
-    }
-
     /* Loyalty decay based on unrest and national stability */
     civ_float_t stability_bonus =
         gov ? (gov->stability - 0.5f) * 0.05f : -0.01f;
@@ -192,7 +609,7 @@ civ_result_t civ_settlement_manager_update(civ_settlement_manager_t *manager,
 
     // Revolt Trigger
     if (s->loyalty < 0.15f && strcmp(s->id, "player_capital") != 0) {
-      strncpy(s->region_id, "REBELS", STRING_SHORT_LEN - 1);
+      civ_settlement_manager_set_owner(manager, s, "REBELS");
       printf("[SOVEREIGN] %s HAS REVOLTED! Loyalty: %.2f\n", s->name,
              s->loyalty);
       /* In a full implementation, we would change owner_id on tiles too,
@@ -214,6 +631,7 @@ civ_result_t civ_settlement_manager_update(civ_settlement_manager_t *manager,
       int32_t cx = (int32_t)s->x;
       int32_t cy = (int32_t)s->y;
       int32_t r = s->territory_radius;
+      civ_owner_index_t s_owner = civ_owner_intern(s->id);
 
       for (int32_t dy = -r; dy <= r; dy++) {
         for (int32_t dx = -r; dx <= r; dx++) {
@@ -242,24 +660,26 @@ civ_result_t civ_settlement_manager_update(civ_settlement_manager_t *manager,
                 /* Competition & Flipping Logic */
                 if (influence >
                     0.05f) { /* Minimum threshold to exert influence */
-                  bool is_unowned = (tile->owner_id[0] == '\0');
-                  bool is_owner = (strcmp(tile->owner_id, s->id) == 0);
+                  bool is_unowned = (tile->owner_index == CIV_OWNER_NONE);
+                  bool is_owner = (tile->owner_index == s_owner);
 
                   if (is_owner) {
                     /* Refresh our own influence record */
+                    if (tile->cultural_influence != influence)
+                      civ_map_touch_tile(map, (size_t)ty * map->width + tx);
                     tile->cultural_influence = influence;
                   } else if (is_unowned) {
                     /* Claim unowned tiles easily */
-                    strncpy(tile->owner_id, s->id, STRING_SHORT_LEN - 1);
-                    tile->owner_id[STRING_SHORT_LEN - 1] = '\0';
+                    civ_map_set_owner(map, (size_t)ty * map->width + tx,
+                                      s_owner, tile->political_color);
                     tile->cultural_influence = influence;
                   } else {
                     /* Cultural Flipping: Must have significantly higher
                      * influence */
                     /* Threshold: 1.5x current record */
                     if (influence > tile->cultural_influence * 1.5f) {
-                      strncpy(tile->owner_id, s->id, STRING_SHORT_LEN - 1);
-                      tile->owner_id[STRING_SHORT_LEN - 1] = '\0';
+                      civ_map_set_owner(map, (size_t)ty * map->width + tx,
+                                        s_owner, tile->political_color);
                       tile->cultural_influence = influence;
 
                       /* Log the flip */
@@ -280,3 +700,65 @@ civ_result_t civ_settlement_manager_update(civ_settlement_manager_t *manager,
 
   return (civ_result_t){CIV_OK, "Updated"};
 }
+
+/* ---- Save section ---- */
+
+static void settlements_put(const civ_settlement_manager_t *manager,
+                            civ_ser_cursor_t *c) {
+  uint32_t count = (uint32_t)manager->settlement_count;
+  CIV_SER_PUT(c, count);
+  CIV_SER_PUT(c, manager->min_distance);
+  civ_ser_put(c, manager->settlements,
+              manager->settlement_count * sizeof(civ_settlement_t));
+}
+
+static civ_result_t settlements_serialize(const void *object, char *buffer,
+                                          size_t buffer_size, size_t *written) {
+  civ_ser_cursor_t c = civ_ser_cursor(buffer, buffer_size);
+  settlements_put((const civ_settlement_manager_t *)object, &c);
+  if (written) *written = c.pos;
+  return c.overflow ? (civ_result_t){CIV_ERROR_INVALID_ARGUMENT, "Buffer too small"}
+                    : (civ_result_t){CIV_OK, NULL};
+}
+
+static size_t settlements_serialized_size(const void *object) {
+  civ_ser_cursor_t c = civ_ser_cursor(NULL, 0);
+  settlements_put((const civ_settlement_manager_t *)object, &c);
+  return c.pos;
+}
+
+static civ_result_t settlements_deserialize(void *object, const char *buffer,
+                                            size_t buffer_size) {
+  civ_settlement_manager_t *manager = (civ_settlement_manager_t *)object;
+  civ_ser_cursor_t c = civ_ser_cursor((void *)buffer, buffer_size);
+  uint32_t count = 0;
+  civ_float_t min_distance = 0;
+  if (!CIV_SER_GET(&c, count) || !CIV_SER_GET(&c, min_distance) ||
+      (size_t)count * sizeof(civ_settlement_t) != buffer_size - c.pos)
+    return (civ_result_t){CIV_ERROR_INVALID_DATA, "Settlement section size"};
+
+  manager->settlement_count = 0;
+  manager->owner_count = 0;
+  manager->next_serial = 0; /* raised again as the settlements come back */
+  manager->min_distance = min_distance;
+  for (int i = 0; i < CIV_SETTLEMENT_HASH_BUCKETS; i++)
+    manager->bucket_heads[i] = -1;
+  manager->cell_min_x = manager->cell_min_y = INT32_MAX;
+  manager->cell_max_x = manager->cell_max_y = INT32_MIN;
+
+  for (uint32_t i = 0; i < count; i++) {
+    civ_settlement_t s;
+    civ_ser_get(&c, &s, sizeof(s));
+    s.region_id[STRING_SHORT_LEN - 1] = '\0';
+    civ_result_t res = civ_settlement_manager_add(manager, &s);
+    if (res.error != CIV_OK) return res;
+  }
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+civ_serializable_t
+civ_settlement_manager_serializable(civ_settlement_manager_t *manager) {
+  return (civ_serializable_t){manager, settlements_serialize,
+                              settlements_deserialize,
+                              settlements_serialized_size};
+}
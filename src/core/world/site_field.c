@@ -0,0 +1,393 @@
+/**
+ * @file site_field.c
+ * @brief Suitability raster, rescored by region and around new settlements
+ */
+#include "core/world/site_field.h"
+#include "common.h"
+#include <math.h>
+#include <string.h>
+
+#define NEAR_MAX        64    /* settlements considered around one cell */
+#define COMPACT_AT      1024u /* heaps this full drop stale entries first */
+#define CELLS_PER_REGION (CIV_MAP_REGION_SIZE / CIV_SITE_CELL_SIZE)
+
+/* ── Heaps ─────────────────────────────────────────────────────────── */
+
+static bool entry_before(const civ_site_entry_t *a, const civ_site_entry_t *b) {
+  if (a->priority != b->priority) return a->priority > b->priority;
+  return a->cell < b->cell;
+}
+
+static void sift_up(civ_site_queue_t *q, uint32_t i) {
+  civ_site_entry_t e = q->items[i];
+  while (i > 0) {
+    uint32_t parent = (i - 1) / 2;
+    if (!entry_before(&e, &q->items[parent])) break;
+    q->items[i] = q->items[parent];
+    i = parent;
+  }
+  q->items[i] = e;
+}
+
+static void sift_down(civ_site_queue_t *q, uint32_t i) {
+  civ_site_entry_t e = q->items[i];
+  for (;;) {
+    uint32_t child = 2 * i + 1;
+    if (child >= q->count) break;
+    if (child + 1 < q->count && entry_before(&q->items[child + 1], &q->items[child]))
+      child++;
+    if (!entry_before(&q->items[child], &e)) break;
+    q->items[i] = q->items[child];
+    i = child;
+  }
+  q->items[i] = e;
+}
+
+static bool entry_live(const civ_site_field_t *f, const civ_site_entry_t *e) {
+  return e->stamp == f->stamp[e->cell] && f->score[e->cell] > 0.0f;
+}
+
+/* Drop stale entries and re-heapify */
+static void queue_compact(const civ_site_field_t *f, civ_site_queue_t *q) {
+  uint32_t kept = 0;
+  for (uint32_t i = 0; i < q->count; i++)
+    if (entry_live(f, &q->items[i])) q->items[kept++] = q->items[i];
+  q->count = kept;
+  for (uint32_t i = kept / 2; i-- > 0;) sift_down(q, i);
+}
+
+static void queue_push(const civ_site_field_t *f, civ_site_queue_t *q,
+                       civ_site_entry_t e) {
+  if (q->count >= q->capacity && q->capacity >= COMPACT_AT) queue_compact(f, q);
+  if (q->count >= q->capacity) {
+    uint32_t cap = q->capacity ? q->capacity * 2 : 64;
+    civ_site_entry_t *items = CIV_REALLOC(q->items, cap * sizeof(civ_site_entry_t));
+    if (!items) return;
+    q->items = items;
+    q->capacity = cap;
+  }
+  q->items[q->count] = e;
+  sift_up(q, q->count++);
+}
+
+static civ_site_queue_t *queue_for(civ_site_field_t *f, int32_t owner) {
+  if (owner == CIV_SITE_OPEN) return &f->open;
+  if (owner < 0) return NULL;
+  if ((size_t)owner >= f->owner_count) {
+    size_t count = (size_t)owner + 1;
+    civ_site_queue_t *owners = CIV_REALLOC(f->owners, count * sizeof(civ_site_queue_t));
+    if (!owners) return NULL;
+    memset(owners + f->owner_count, 0,
+           (count - f->owner_count) * sizeof(civ_site_queue_t));
+    f->owners = owners;
+    f->owner_count = count;
+  }
+  return &f->owners[owner];
+}
+
+/* ── Scoring ───────────────────────────────────────────────────────── */
+
+static float tile_score(const civ_site_field_t *f, const civ_map_t *m, size_t t) {
+  if (civ_map_is_water_at(m, t)) return 0.0f;
+  const civ_map_tile_t *tile = &m->tiles[t];
+  float value = 0.6f * civ_map_fertility_at(m, t) +
+                (tile->has_river ? 0.25f : 0.0f) +
+                0.15f * (tile->has_resource ? 1.0f : civ_tile_resources(tile));
+  /* Highlands past halfway up are hard to feed and to reach */
+  float height = (civ_map_elevation_at(m, t) - f->sea_level) /
+                 MAX(1.0f - f->sea_level, 0.01f);
+  value *= 1.0f - CLAMP((height - 0.5f) / 0.4f, 0.0f, 1.0f);
+  return CLAMP(value, 0.0f, 1.0f);
+}
+
+static void score_terrain(civ_site_field_t *f, const civ_map_t *m,
+                          uint32_t cell) {
+  int32_t x0 = (int32_t)(cell % (uint32_t)f->cols) << CIV_SITE_CELL_SHIFT;
+  int32_t y0 = (int32_t)(cell / (uint32_t)f->cols) << CIV_SITE_CELL_SHIFT;
+  float best = 0.0f;
+  uint32_t best_tile = (uint32_t)y0 * (uint32_t)m->width + (uint32_t)x0;
+  for (int32_t y = y0; y < MIN(y0 + CIV_SITE_CELL_SIZE, m->height); y++)
+    for (int32_t x = x0; x < MIN(x0 + CIV_SITE_CELL_SIZE, m->width); x++) {
+      size_t t = (size_t)y * m->width + x;
+      float s = tile_score(f, m, t);
+      if (s > best) {
+        best = s;
+        best_tile = (uint32_t)t;
+      }
+    }
+  f->terrain[cell] = best;
+  f->best_tile[cell] = best_tile;
+}
+
+static void cell_pos(const civ_site_field_t *f, uint32_t cell, float *x, float *y) {
+  uint32_t t = f->best_tile[cell];
+  *x = (float)(t % (uint32_t)f->map_width);
+  *y = (float)(t / (uint32_t)f->map_width);
+}
+
+static float spacing(const civ_site_field_t *f, const civ_settlement_manager_t *sm,
+                     uint32_t cell) {
+  if (!sm || sm->settlement_count == 0) return 1.0f;
+  float x, y;
+  cell_pos(f, cell, &x, &y);
+  civ_float_t d;
+  if (!civ_settlement_manager_nearest(sm, CIV_SETTLEMENT_ANY_OWNER, x, y, &d))
+    return 1.0f;
+  float min = MAX(sm->min_distance, 1.0f);
+  if (d < min) return 0.0f;
+  return 0.5f + 0.5f * CLAMP((d - min) / min, 0.0f, 1.0f);
+}
+
+/* Closer to one of its own settlements ranks higher for an owner */
+static float owner_priority(float score, float dist) {
+  return score * (1.0f - 0.5f * dist / CIV_SITE_REACH);
+}
+
+/* New score for a cell: restamp it and queue it wherever it can be found */
+static void set_score(civ_site_field_t *f, const civ_settlement_manager_t *sm,
+                      uint32_t cell, float score) {
+  if (score == f->score[cell]) return;
+  f->score[cell] = score;
+  f->stamp[cell]++;
+  if (score <= 0.0f) return;
+  queue_push(f, &f->open, (civ_site_entry_t){score, cell, f->stamp[cell]});
+  if (!sm) return;
+
+  /* Each nearby owner once, at its nearest settlement's distance */
+  float x, y;
+  cell_pos(f, cell, &x, &y);
+  size_t near[NEAR_MAX];
+  size_t n = MIN(civ_settlement_manager_query_radius(
+                     sm, CIV_SETTLEMENT_ANY_OWNER, x, y, CIV_SITE_REACH, near,
+                     NEAR_MAX),
+                 (size_t)NEAR_MAX);
+  int32_t owners[NEAR_MAX];
+  float dists[NEAR_MAX];
+  size_t owner_n = 0;
+  for (size_t k = 0; k < n; k++) {
+    const civ_settlement_t *s = &sm->settlements[near[k]];
+    if (s->owner_index < 0) continue;
+    float d = sqrtf((s->x - x) * (s->x - x) + (s->y - y) * (s->y - y));
+    size_t o = 0;
+    while (o < owner_n && owners[o] != s->owner_index) o++;
+    if (o == owner_n) {
+      owners[owner_n] = s->owner_index;
+      dists[owner_n++] = d;
+    } else {
+      dists[o] = MIN(dists[o], d);
+    }
+  }
+  for (size_t o = 0; o < owner_n; o++) {
+    civ_site_queue_t *q = queue_for(f, owners[o]);
+    if (q)
+      queue_push(f, q, (civ_site_entry_t){owner_priority(score, dists[o]),
+                                          cell, f->stamp[cell]});
+  }
+}
+
+/* Queue every scored cell within reach of settlement i for its owner */
+static void push_near(civ_site_field_t *f, const civ_settlement_manager_t *sm,
+                      size_t i) {
+  const civ_settlement_t *s = &sm->settlements[i];
+  civ_site_queue_t *q = queue_for(f, s->owner_index);
+  if (!q) return;
+  int32_t reach = (int32_t)ceilf(CIV_SITE_REACH / CIV_SITE_CELL_SIZE);
+  int32_t scx = (int32_t)floorf(s->x) >> CIV_SITE_CELL_SHIFT;
+  int32_t scy = (int32_t)floorf(s->y) >> CIV_SITE_CELL_SHIFT;
+  for (int32_t cy = MAX(scy - reach, 0); cy <= MIN(scy + reach, f->rows - 1); cy++)
+    for (int32_t cx = MAX(scx - reach, 0); cx <= MIN(scx + reach, f->cols - 1); cx++) {
+      uint32_t cell = (uint32_t)(cy * f->cols + cx);
+      if (f->score[cell] <= 0.0f) continue;
+      float x, y;
+      cell_pos(f, cell, &x, &y);
+      float d = sqrtf((s->x - x) * (s->x - x) + (s->y - y) * (s->y - y));
+      if (d > CIV_SITE_REACH) continue;
+      queue_push(f, q, (civ_site_entry_t){owner_priority(f->score[cell], d),
+                                          cell, f->stamp[cell]});
+    }
+}
+
+/* Respace the cells a settlement at (x, y) can have changed */
+static void respace_around(civ_site_field_t *f, const civ_settlement_manager_t *sm,
+                           float x, float y) {
+  int32_t reach =
+      (int32_t)ceilf(2.0f * MAX(sm->min_distance, 1.0f) / CIV_SITE_CELL_SIZE) + 1;
+  int32_t scx = (int32_t)floorf(x) >> CIV_SITE_CELL_SHIFT;
+  int32_t scy = (int32_t)floorf(y) >> CIV_SITE_CELL_SHIFT;
+  for (int32_t cy = MAX(scy - reach, 0); cy <= MIN(scy + reach, f->rows - 1); cy++)
+    for (int32_t cx = MAX(scx - reach, 0); cx <= MIN(scx + reach, f->cols - 1); cx++) {
+      uint32_t cell = (uint32_t)(cy * f->cols + cx);
+      set_score(f, sm, cell, f->terrain[cell] * spacing(f, sm, cell));
+    }
+}
+
+static bool track_settlements(civ_site_field_t *f, size_t count) {
+  if (count <= f->settlement_capacity) return true;
+  size_t cap = f->settlement_capacity ? f->settlement_capacity : 64;
+  while (cap < count) cap *= 2;
+  int32_t *owner = CIV_REALLOC(f->settlement_owner, cap * sizeof(int32_t));
+  if (!owner) return false;
+  f->settlement_owner = owner;
+  f->settlement_capacity = cap;
+  return true;
+}
+
+/* ── Lifecycle ─────────────────────────────────────────────────────── */
+
+civ_site_field_t *civ_site_field_create(const civ_map_t *map) {
+  if (!map || !map->tiles || map->width <= 0 || map->height <= 0) return NULL;
+  civ_site_field_t *f = CIV_CALLOC(1, sizeof(civ_site_field_t));
+  if (!f) {
+    civ_log(CIV_LOG_ERROR, "Failed to allocate site field");
+    return NULL;
+  }
+  f->cols = (map->width + CIV_SITE_CELL_SIZE - 1) >> CIV_SITE_CELL_SHIFT;
+  f->rows = (map->height + CIV_SITE_CELL_SIZE - 1) >> CIV_SITE_CELL_SHIFT;
+  f->map_width = map->width;
+  f->sea_level = (float)map->sea_level;
+  size_t cells = (size_t)f->cols * f->rows;
+  f->region_count = map->region_revision
+                        ? (size_t)map->region_cols * map->region_rows : 0;
+  f->terrain = CIV_CALLOC(cells, sizeof(float));
+  f->best_tile = CIV_CALLOC(cells, sizeof(uint32_t));
+  f->score = CIV_CALLOC(cells, sizeof(float));
+  f->stamp = CIV_CALLOC(cells, sizeof(uint32_t));
+  f->region_seen = f->region_count ? CIV_CALLOC(f->region_count, sizeof(uint32_t))
+                                   : NULL;
+  if (!f->terrain || !f->best_tile || !f->score || !f->stamp ||
+      (f->region_count && !f->region_seen)) {
+    civ_log(CIV_LOG_ERROR, "Failed to allocate site field");
+    civ_site_field_destroy(f);
+    return NULL;
+  }
+  return f;
+}
+
+void civ_site_field_destroy(civ_site_field_t *f) {
+  if (!f) return;
+  for (size_t o = 0; o < f->owner_count; o++) CIV_FREE(f->owners[o].items);
+  CIV_FREE(f->owners);
+  CIV_FREE(f->open.items);
+  CIV_FREE(f->settlement_owner);
+  CIV_FREE(f->region_seen);
+  CIV_FREE(f->stamp);
+  CIV_FREE(f->score);
+  CIV_FREE(f->best_tile);
+  CIV_FREE(f->terrain);
+  CIV_FREE(f);
+}
+
+static void rebuild(civ_site_field_t *f, const civ_map_t *map,
+                    const civ_settlement_manager_t *sm) {
+  uint32_t cells = (uint32_t)(f->cols * f->rows);
+  f->open.count = 0;
+  for (size_t o = 0; o < f->owner_count; o++) f->owners[o].count = 0;
+
+  for (uint32_t c = 0; c < cells; c++) {
+    score_terrain(f, map, c);
+    f->score[c] = f->terrain[c] * spacing(f, sm, c);
+    f->stamp[c]++;
+    if (f->score[c] > 0.0f)
+      queue_push(f, &f->open, (civ_site_entry_t){f->score[c], c, f->stamp[c]});
+  }
+  for (size_t r = 0; r < f->region_count; r++)
+    f->region_seen[r] = map->region_revision[r];
+
+  size_t count = sm ? sm->settlement_count : 0;
+  f->settlement_seen = 0;
+  if (!track_settlements(f, count)) return;
+  for (size_t i = 0; i < count; i++) {
+    f->settlement_owner[i] = sm->settlements[i].owner_index;
+    push_near(f, sm, i);
+  }
+  f->settlement_seen = count;
+  f->built = true;
+}
+
+/* Rescore the terrain of the next changed map region, if any */
+static void rescore_region(civ_site_field_t *f, const civ_map_t *map,
+                           const civ_settlement_manager_t *sm) {
+  for (size_t k = 0; k < f->region_count; k++) {
+    size_t r = (f->region_cursor + k) % f->region_count;
+    if (f->region_seen[r] == map->region_revision[r]) continue;
+    f->region_seen[r] = map->region_revision[r];
+    f->region_cursor = r + 1;
+
+    int32_t cx0 = (int32_t)(r % (size_t)map->region_cols) * CELLS_PER_REGION;
+    int32_t cy0 = (int32_t)(r / (size_t)map->region_cols) * CELLS_PER_REGION;
+    for (int32_t cy = cy0; cy < MIN(cy0 + CELLS_PER_REGION, f->rows); cy++)
+      for (int32_t cx = cx0; cx < MIN(cx0 + CELLS_PER_REGION, f->cols); cx++) {
+        uint32_t cell = (uint32_t)(cy * f->cols + cx);
+        float before = f->terrain[cell];
+        uint32_t before_tile = f->best_tile[cell];
+        score_terrain(f, map, cell);
+        if (f->terrain[cell] != before || f->best_tile[cell] != before_tile)
+          set_score(f, sm, cell, f->terrain[cell] * spacing(f, sm, cell));
+      }
+    return;
+  }
+}
+
+void civ_site_field_refresh(civ_site_field_t *f, const civ_map_t *map,
+                            const civ_settlement_manager_t *sm) {
+  if (!f || !map || map->width != f->map_width) return;
+  size_t count = sm ? sm->settlement_count : 0;
+  if (!f->built || count < f->settlement_seen) {
+    rebuild(f, map, sm);
+    return;
+  }
+  if (!track_settlements(f, count)) return;
+
+  /* Conquered settlements bring their surroundings to the new owner */
+  for (size_t i = 0; i < f->settlement_seen; i++) {
+    int32_t owner = sm->settlements[i].owner_index;
+    if (owner == f->settlement_owner[i]) continue;
+    f->settlement_owner[i] = owner;
+    push_near(f, sm, i);
+  }
+  for (size_t i = f->settlement_seen; i < count; i++) {
+    const civ_settlement_t *s = &sm->settlements[i];
+    f->settlement_owner[i] = s->owner_index;
+    respace_around(f, sm, s->x, s->y);
+    push_near(f, sm, i);
+  }
+  f->settlement_seen = count;
+
+  if (f->region_count) rescore_region(f, map, sm);
+}
+
+/* ── Queries ───────────────────────────────────────────────────────── */
+
+bool civ_site_field_pop(civ_site_field_t *f, int32_t owner, civ_site_t *out) {
+  if (!f || !out) return false;
+  civ_site_queue_t *q =
+      owner == CIV_SITE_OPEN ? &f->open
+      : (owner >= 0 && (size_t)owner < f->owner_count) ? &f->owners[owner]
+                                                       : NULL;
+  while (q && q->count > 0) {
+    civ_site_entry_t top = q->items[0];
+    q->items[0] = q->items[--q->count];
+    if (q->count > 0) sift_down(q, 0);
+    if (!entry_live(f, &top)) continue;
+    cell_pos(f, top.cell, &out->x, &out->y);
+    out->score = f->score[top.cell];
+    out->entry = top;
+    return true;
+  }
+  return false;
+}
+
+void civ_site_field_push_back(civ_site_field_t *f, int32_t owner,
+                              const civ_site_t *site) {
+  if (!f || !site || site->entry.cell >= (uint32_t)(f->cols * f->rows)) return;
+  civ_site_queue_t *q = queue_for(f, owner);
+  if (q && entry_live(f, &site->entry)) queue_push(f, q, site->entry);
+}
+
+float civ_site_field_score_at(const civ_site_field_t *f, float x, float y) {
+  if (!f) return 0.0f;
+  int32_t cx = (int32_t)floorf(x) >> CIV_SITE_CELL_SHIFT;
+  int32_t cy = (int32_t)floorf(y) >> CIV_SITE_CELL_SHIFT;
+  if (cx < 0 || cy < 0 || cx >= f->cols || cy >= f->rows) return 0.0f;
+  return f->score[cy * f->cols + cx];
+}
@@ -5,10 +5,259 @@
 
 #include "core/world/territory.h"
 #include "common.h"
+#include "utils/store_registry.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
+#define TERRITORY_GRID_MAX   64  /* cells per side */
+#define TERRITORY_BAND_EDGES 8   /* edges per band a region aims for */
+#define TERRITORY_BANDS_MAX  64
+
+/* ── Spatial index ───────────────────────────────────────────────── */
+
+/* One region's box, grid placement and banded edges. Edge k joins point
+   k - 1 to point k, the pair the ray-casting loop visits at i = k. */
+typedef struct {
+    civ_float_t min_x, min_y, max_x, max_y;
+    uint32_t revision;        /* region revision the entry was built from */
+    bool fresh;               /* built at all */
+    bool in_grid;             /* has >= 3 points and sits in the cells */
+    int cx0, cy0, cx1, cy1;   /* cells covered, inclusive */
+    int band_count;
+    civ_float_t band_scale;   /* bands per unit of y */
+    uint32_t* band_start;     /* band_count + 1 offsets into band_edges */
+    uint32_t* band_edges;
+} territory_entry_t;
+
+typedef struct {
+    uint32_t* regions;
+    size_t count, capacity;
+} territory_cell_t;
+
+struct civ_territory_index {
+    territory_entry_t* entries;  /* per region */
+    size_t entry_capacity;
+    territory_cell_t* cells;     /* cols * rows, row-major */
+    int cols, rows;
+    civ_float_t min_x, min_y, max_x, max_y;
+    civ_float_t cell_w, cell_h;
+    bool gridded;                /* cells cover every indexed box */
+};
+
+static void entry_clear(territory_entry_t* e) {
+    CIV_FREE(e->band_start);
+    CIV_FREE(e->band_edges);
+    memset(e, 0, sizeof(*e));
+}
+
+static int entry_band(const territory_entry_t* e, civ_float_t y) {
+    int b = (int)((y - e->min_y) * e->band_scale);
+    return CLAMP(b, 0, e->band_count - 1);
+}
+
+/* Box and edge bands of region; false when out of memory */
+static bool entry_build(territory_entry_t* e, const civ_territory_region_t* region) {
+    entry_clear(e);
+    e->fresh = true;
+    e->revision = region->revision;
+    size_t n = region->point_count;
+    if (n < 3 || !region->boundary_points) return true;
+
+    const civ_territory_point_t* pts = region->boundary_points;
+    e->min_x = e->max_x = pts[0].x;
+    e->min_y = e->max_y = pts[0].y;
+    for (size_t i = 1; i < n; i++) {
+        e->min_x = MIN(e->min_x, pts[i].x);
+        e->max_x = MAX(e->max_x, pts[i].x);
+        e->min_y = MIN(e->min_y, pts[i].y);
+        e->max_y = MAX(e->max_y, pts[i].y);
+    }
+    e->band_count = CLAMP((int)(n / TERRITORY_BAND_EDGES), 1, TERRITORY_BANDS_MAX);
+    civ_float_t h = e->max_y - e->min_y;
+    e->band_scale = h > 0 ? (civ_float_t)e->band_count / h : 0;
+
+    /* Count, then place, each edge in every band its y range touches */
+    e->band_start = (uint32_t*)CIV_CALLOC((size_t)e->band_count + 1, sizeof(uint32_t));
+    if (!e->band_start) return false;
+    for (size_t k = 0; k < n; k++) {
+        const civ_territory_point_t* a = &pts[(k + n - 1) % n];
+        int b0 = entry_band(e, MIN(a->y, pts[k].y));
+        int b1 = entry_band(e, MAX(a->y, pts[k].y));
+        for (int b = b0; b <= b1; b++) e->band_start[b + 1]++;
+    }
+    for (int b = 0; b < e->band_count; b++) e->band_start[b + 1] += e->band_start[b];
+    e->band_edges = (uint32_t*)CIV_MALLOC((size_t)e->band_start[e->band_count] * sizeof(uint32_t));
+    uint32_t* fill = (uint32_t*)CIV_MALLOC((size_t)e->band_count * sizeof(uint32_t));
+    if (!e->band_edges || !fill) {
+        CIV_FREE(fill);
+        return false;
+    }
+    memcpy(fill, e->band_start, (size_t)e->band_count * sizeof(uint32_t));
+    for (size_t k = 0; k < n; k++) {
+        const civ_territory_point_t* a = &pts[(k + n - 1) % n];
+        int b0 = entry_band(e, MIN(a->y, pts[k].y));
+        int b1 = entry_band(e, MAX(a->y, pts[k].y));
+        for (int b = b0; b <= b1; b++) e->band_edges[fill[b]++] = (uint32_t)k;
+    }
+    CIV_FREE(fill);
+    return true;
+}
+
+/* civ_territory_region_contains_point over the point's band only */
+static bool entry_contains(const territory_entry_t* e,
+                           const civ_territory_region_t* region,
+                           civ_float_t x, civ_float_t y) {
+    if (x < e->min_x || x > e->max_x || y < e->min_y || y > e->max_y) return false;
+    const civ_territory_point_t* pts = region->boundary_points;
+    size_t n = region->point_count;
+    int b = entry_band(e, y);
+    bool inside = false;
+    for (uint32_t k = e->band_start[b]; k < e->band_start[b + 1]; k++) {
+        size_t i = e->band_edges[k], j = (i + n - 1) % n;
+        if (((pts[i].y > y) != (pts[j].y > y)) &&
+            (x < (pts[j].x - pts[i].x) * (y - pts[i].y) / (pts[j].y - pts[i].y) + pts[i].x)) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+static int grid_col(const civ_territory_index_t* ix, civ_float_t x) {
+    return CLAMP((int)((x - ix->min_x) / ix->cell_w), 0, ix->cols - 1);
+}
+
+static int grid_row(const civ_territory_index_t* ix, civ_float_t y) {
+    return CLAMP((int)((y - ix->min_y) / ix->cell_h), 0, ix->rows - 1);
+}
+
+static void grid_remove(civ_territory_index_t* ix, uint32_t region) {
+    territory_entry_t* e = &ix->entries[region];
+    if (!e->in_grid) return;
+    for (int cy = e->cy0; cy <= e->cy1; cy++) {
+        for (int cx = e->cx0; cx <= e->cx1; cx++) {
+            territory_cell_t* c = &ix->cells[(size_t)cy * ix->cols + cx];
+            for (size_t k = 0; k < c->count; k++) {
+                if (c->regions[k] == region) {
+                    c->regions[k] = c->regions[--c->count];
+                    break;
+                }
+            }
+        }
+    }
+    e->in_grid = false;
+}
+
+static bool grid_insert(civ_territory_index_t* ix, uint32_t region) {
+    territory_entry_t* e = &ix->entries[region];
+    e->cx0 = grid_col(ix, e->min_x);
+    e->cx1 = grid_col(ix, e->max_x);
+    e->cy0 = grid_row(ix, e->min_y);
+    e->cy1 = grid_row(ix, e->max_y);
+    for (int cy = e->cy0; cy <= e->cy1; cy++) {
+        for (int cx = e->cx0; cx <= e->cx1; cx++) {
+            territory_cell_t* c = &ix->cells[(size_t)cy * ix->cols + cx];
+            if (c->count == c->capacity) {
+                size_t cap = c->capacity ? c->capacity * 2 : 4;
+                uint32_t* grown = (uint32_t*)CIV_REALLOC(c->regions, cap * sizeof(uint32_t));
+                if (!grown) return false;
+                c->regions = grown;
+                c->capacity = cap;
+            }
+            c->regions[c->count++] = region;
+        }
+    }
+    e->in_grid = true;
+    return true;
+}
+
+static void grid_free(civ_territory_index_t* ix) {
+    for (int c = 0; c < ix->cols * ix->rows; c++) CIV_FREE(ix->cells[c].regions);
+    CIV_FREE(ix->cells);
+    ix->cells = NULL;
+    ix->cols = ix->rows = 0;
+    ix->gridded = false;
+}
+
+/* Cells over the union of the indexed boxes, about two per region a side */
+static bool grid_rebuild(civ_territory_index_t* ix, size_t region_count) {
+    grid_free(ix);
+    bool any = false;
+    for (size_t i = 0; i < region_count; i++) {
+        territory_entry_t* e = &ix->entries[i];
+        e->in_grid = false;
+        if (!e->band_count) continue;
+        if (!any) {
+            ix->min_x = e->min_x; ix->max_x = e->max_x;
+            ix->min_y = e->min_y; ix->max_y = e->max_y;
+            any = true;
+        }
+        ix->min_x = MIN(ix->min_x, e->min_x);
+        ix->max_x = MAX(ix->max_x, e->max_x);
+        ix->min_y = MIN(ix->min_y, e->min_y);
+        ix->max_y = MAX(ix->max_y, e->max_y);
+    }
+    if (!any) return true;
+    int side = CLAMP((int)ceil(sqrt((double)region_count)) * 2, 1, TERRITORY_GRID_MAX);
+    ix->cols = ix->rows = side;
+    ix->cell_w = ix->max_x > ix->min_x ? (ix->max_x - ix->min_x) / side : 1;
+    ix->cell_h = ix->max_y > ix->min_y ? (ix->max_y - ix->min_y) / side : 1;
+    ix->cells = (territory_cell_t*)CIV_CALLOC((size_t)side * side, sizeof(territory_cell_t));
+    if (!ix->cells) return false;
+    for (size_t i = 0; i < region_count; i++) {
+        if (ix->entries[i].band_count && !grid_insert(ix, (uint32_t)i)) return false;
+    }
+    ix->gridded = true;
+    return true;
+}
+
+/* Re-index the regions whose revision moved; false when out of memory */
+static bool index_sync(civ_territory_manager_t* manager) {
+    civ_territory_index_t* ix = manager->index;
+    if (!ix) {
+        ix = manager->index = (civ_territory_index_t*)CIV_CALLOC(1, sizeof(civ_territory_index_t));
+        if (!ix) return false;
+    }
+    if (manager->region_count > ix->entry_capacity) {
+        size_t cap = MAX(manager->region_capacity, manager->region_count);
+        territory_entry_t* grown = (territory_entry_t*)CIV_REALLOC(ix->entries, cap * sizeof(territory_entry_t));
+        if (!grown) return false;
+        memset(grown + ix->entry_capacity, 0, (cap - ix->entry_capacity) * sizeof(territory_entry_t));
+        ix->entries = grown;
+        ix->entry_capacity = cap;
+    }
+
+    bool regrid = !ix->gridded;
+    for (size_t i = 0; i < manager->region_count; i++) {
+        territory_entry_t* e = &ix->entries[i];
+        const civ_territory_region_t* region = &manager->regions[i];
+        if (e->fresh && e->revision == region->revision) continue;
+        if (ix->gridded) grid_remove(ix, (uint32_t)i);
+        if (!entry_build(e, region)) {
+            entry_clear(e);
+            return false;
+        }
+        if (!e->band_count || regrid) continue;
+        if (e->min_x < ix->min_x || e->max_x > ix->max_x ||
+            e->min_y < ix->min_y || e->max_y > ix->max_y) {
+            regrid = true;  /* outgrew the cells */
+        } else if (!grid_insert(ix, (uint32_t)i)) {
+            return false;
+        }
+    }
+    return !regrid || grid_rebuild(ix, manager->region_count);
+}
+
+static void index_destroy(civ_territory_index_t* ix) {
+    if (!ix) return;
+    for (size_t i = 0; i < ix->entry_capacity; i++) entry_clear(&ix->entries[i]);
+    CIV_FREE(ix->entries);
+    grid_free(ix);
+    CIV_FREE(ix);
+}
+
+/* ── Manager ─────────────────────────────────────────────────────── */
+
 civ_territory_manager_t* civ_territory_manager_create(void) {
     civ_territory_manager_t* manager = (civ_territory_manager_t*)CIV_MALLOC(sizeof(civ_territory_manager_t));
     if (!manager) {
@@ -17,16 +266,21 @@ civ_territory_manager_t* civ_territory_manager_create(void) {
     }
     
     civ_territory_manager_init(manager);
+    CIV_STORE_REGISTER("world.territory_regions", manager, manager->region_count,
+                       manager->region_capacity, sizeof(civ_territory_region_t),
+                       CIV_STORE_INDEXED);
     return manager;
 }
 
 void civ_territory_manager_destroy(civ_territory_manager_t* manager) {
     if (!manager) return;
     
+    civ_store_unregister_owner(manager);
     for (size_t i = 0; i < manager->region_count; i++) {
         civ_territory_region_destroy(&manager->regions[i]);
     }
     CIV_FREE(manager->regions);
+    index_destroy(manager->index);
     CIV_FREE(manager);
 }
 
@@ -80,6 +334,7 @@ civ_result_t civ_territory_region_add_point(civ_territory_region_t* region, civ_
         region->boundary_points[region->point_count].x = x;
         region->boundary_points[region->point_count].y = y;
         region->point_count++;
+        region->revision++;
     } else {
         result.error = CIV_ERROR_OUT_OF_MEMORY;
     }
@@ -176,14 +431,32 @@ civ_result_t civ_territory_manager_add_region(civ_territory_manager_t* manager,
 civ_territory_region_t* civ_territory_manager_find_region_at(civ_territory_manager_t* manager, civ_float_t x, civ_float_t y) {
     if (!manager) return NULL;
     
-    /* Find region containing this point */
-    for (size_t i = 0; i < manager->region_count; i++) {
-        if (civ_territory_region_contains_point(&manager->regions[i], x, y)) {
-            return &manager->regions[i];
+    if (!index_sync(manager)) {
+        /* No index to trust: fall back to testing every region */
+        index_destroy(manager->index);
+        manager->index = NULL;
+        for (size_t i = 0; i < manager->region_count; i++) {
+            if (civ_territory_region_contains_point(&manager->regions[i], x, y)) {
+                return &manager->regions[i];
+            }
         }
+        return NULL;
     }
     
-    return NULL;
+    /* The lowest-numbered region containing the point, as a full scan finds */
+    const civ_territory_index_t* ix = manager->index;
+    if (!ix->gridded || x < ix->min_x || x > ix->max_x || y < ix->min_y || y > ix->max_y) {
+        return NULL;
+    }
+    const territory_cell_t* cell = &ix->cells[(size_t)grid_row(ix, y) * ix->cols + grid_col(ix, x)];
+    size_t best = manager->region_count;
+    for (size_t k = 0; k < cell->count; k++) {
+        uint32_t i = cell->regions[k];
+        if (i < best && entry_contains(&ix->entries[i], &manager->regions[i], x, y)) {
+            best = i;
+        }
+    }
+    return best < manager->region_count ? &manager->regions[best] : NULL;
 }
 
 civ_result_t civ_territory_manager_update(civ_territory_manager_t* manager, civ_float_t time_delta) {
@@ -0,0 +1,276 @@
+/**
+ * @file tile_field.c
+ * @brief Tile fields — banded, double-buffered diffusion and relaxation
+ */
+#include "core/world/tile_field.h"
+#include "core/world/tile_field_gpu.h"
+#include "core/simulation_engine/worker_pool.h"
+#include "common.h"
+#include <math.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CIV_TILE_FIELD_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CIV_TILE_FIELD_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CIV_TILE_FIELD_NEON 1
+#endif
+
+#define BAND_ROWS 32 /* rows per step job */
+
+static const float k_diffusion[CIV_TILE_FIELD_CHANNEL_COUNT] = {
+#define CIV_TILE_FIELD_DIFFUSION(id, diffusion, relaxation)                    \
+  [CIV_TILE_FIELD_##id] = diffusion,
+    CIV_TILE_FIELD_CHANNELS(CIV_TILE_FIELD_DIFFUSION)
+#undef CIV_TILE_FIELD_DIFFUSION
+};
+
+static const float k_relaxation[CIV_TILE_FIELD_CHANNEL_COUNT] = {
+#define CIV_TILE_FIELD_RELAXATION(id, diffusion, relaxation)                   \
+  [CIV_TILE_FIELD_##id] = relaxation,
+    CIV_TILE_FIELD_CHANNELS(CIV_TILE_FIELD_RELAXATION)
+#undef CIV_TILE_FIELD_RELAXATION
+};
+
+/* ── Sources ───────────────────────────────────────────────────────── */
+
+static void read_tile(civ_tile_field_t *f, size_t i) {
+  const civ_map_tile_t *t = &f->map->tiles[i];
+  f->source[CIV_TILE_FIELD_CULTURE][i] = t->cultural_influence;
+  f->source[CIV_TILE_FIELD_POLITICS][i] = civ_tile_political_influence(t);
+  f->source[CIV_TILE_FIELD_POPULATION][i] = civ_tile_population_density(t);
+  f->land[i] = civ_map_is_water_at(f->map, i) ? 0.0f : 1.0f;
+}
+
+static void read_region(civ_tile_field_t *f, size_t r) {
+  const civ_map_t *m = f->map;
+  int32_t x0 = (int32_t)(r % (size_t)m->region_cols) << CIV_MAP_REGION_SHIFT;
+  int32_t y0 = (int32_t)(r / (size_t)m->region_cols) << CIV_MAP_REGION_SHIFT;
+  int32_t x1 = MIN(x0 + CIV_MAP_REGION_SIZE, f->width);
+  int32_t y1 = MIN(y0 + CIV_MAP_REGION_SIZE, f->height);
+  for (int32_t y = y0; y < y1; y++)
+    for (int32_t x = x0; x < x1; x++) read_tile(f, (size_t)y * f->width + x);
+}
+
+/* Changed regions in round-robin order, at most the budget per step; the
+   ones read go to out. Returns how many. */
+static int read_changed(civ_tile_field_t *f,
+                        size_t out[CIV_TILE_FIELD_REGION_BUDGET]) {
+  const civ_map_t *m = f->map;
+  int read = 0;
+  for (size_t k = 0; k < f->region_count && read < CIV_TILE_FIELD_REGION_BUDGET;
+       k++) {
+    size_t r = (f->region_cursor + k) % f->region_count;
+    if (f->region_seen[r] == m->region_revision[r]) continue;
+    f->region_seen[r] = m->region_revision[r];
+    f->region_cursor = r + 1;
+    read_region(f, r);
+    out[read++] = r;
+  }
+  return read;
+}
+
+/* ── Step ──────────────────────────────────────────────────────────── */
+
+typedef struct {
+  float a, b, k; /* own value, each neighbour, source */
+} coeffs_t;
+
+/* One row: (a*c + b*((l + r) + (u + d)) + k*s) * land, x wrapping. Lanes
+   add in the same order as the scalar ends, so both round alike. */
+static void row_step(float *out, const float *c, const float *up,
+                     const float *down, const float *src, const float *land,
+                     int32_t w, coeffs_t q) {
+  int32_t x = 1;
+#if CIV_TILE_FIELD_AVX2
+  __m256 va = _mm256_set1_ps(q.a), vb = _mm256_set1_ps(q.b),
+         vk = _mm256_set1_ps(q.k);
+  for (; x + 8 <= w - 1; x += 8) {
+    __m256 lr = _mm256_add_ps(_mm256_loadu_ps(c + x - 1), _mm256_loadu_ps(c + x + 1));
+    __m256 ud = _mm256_add_ps(_mm256_loadu_ps(up + x), _mm256_loadu_ps(down + x));
+    __m256 v = _mm256_add_ps(_mm256_mul_ps(va, _mm256_loadu_ps(c + x)),
+                             _mm256_mul_ps(vb, _mm256_add_ps(lr, ud)));
+    v = _mm256_add_ps(v, _mm256_mul_ps(vk, _mm256_loadu_ps(src + x)));
+    _mm256_storeu_ps(out + x, _mm256_mul_ps(v, _mm256_loadu_ps(land + x)));
+  }
+#elif CIV_TILE_FIELD_SSE2
+  __m128 va = _mm_set1_ps(q.a), vb = _mm_set1_ps(q.b), vk = _mm_set1_ps(q.k);
+  for (; x + 4 <= w - 1; x += 4) {
+    __m128 lr = _mm_add_ps(_mm_loadu_ps(c + x - 1), _mm_loadu_ps(c + x + 1));
+    __m128 ud = _mm_add_ps(_mm_loadu_ps(up + x), _mm_loadu_ps(down + x));
+    __m128 v = _mm_add_ps(_mm_mul_ps(va, _mm_loadu_ps(c + x)),
+                          _mm_mul_ps(vb, _mm_add_ps(lr, ud)));
+    v = _mm_add_ps(v, _mm_mul_ps(vk, _mm_loadu_ps(src + x)));
+    _mm_storeu_ps(out + x, _mm_mul_ps(v, _mm_loadu_ps(land + x)));
+  }
+#elif CIV_TILE_FIELD_NEON
+  float32x4_t va = vdupq_n_f32(q.a), vb = vdupq_n_f32(q.b), vk = vdupq_n_f32(q.k);
+  for (; x + 4 <= w - 1; x += 4) {
+    float32x4_t lr = vaddq_f32(vld1q_f32(c + x - 1), vld1q_f32(c + x + 1));
+    float32x4_t ud = vaddq_f32(vld1q_f32(up + x), vld1q_f32(down + x));
+    float32x4_t v = vaddq_f32(vmulq_f32(va, vld1q_f32(c + x)),
+                              vmulq_f32(vb, vaddq_f32(lr, ud)));
+    v = vaddq_f32(v, vmulq_f32(vk, vld1q_f32(src + x)));
+    vst1q_f32(out + x, vmulq_f32(v, vld1q_f32(land + x)));
+  }
+#endif
+  for (; x < w - 1; x++)
+    out[x] = (q.a * c[x] + q.b * ((c[x - 1] + c[x + 1]) + (up[x] + down[x])) +
+              q.k * src[x]) * land[x];
+  /* The two ends, where x wraps */
+  int32_t ends[2] = {0, w - 1};
+  for (int e = 0; e < (w > 1 ? 2 : 1); e++) {
+    int32_t i = ends[e];
+    float l = c[(i - 1 + w) % w], r = c[(i + 1) % w];
+    out[i] = (q.a * c[i] + q.b * ((l + r) + (up[i] + down[i])) + q.k * src[i]) *
+             land[i];
+  }
+}
+
+typedef struct {
+  civ_tile_field_t *f;
+  coeffs_t q[CIV_TILE_FIELD_CHANNEL_COUNT];
+} step_ctx_t;
+
+static void step_band(void *ctx, int job) {
+  step_ctx_t *s = ctx;
+  civ_tile_field_t *f = s->f;
+  int32_t w = f->width, h = f->height;
+  int32_t y0 = job * BAND_ROWS, y1 = MIN(y0 + BAND_ROWS, h);
+  for (int32_t y = y0; y < y1; y++) {
+    size_t row = (size_t)y * w;
+    size_t up = (size_t)(y > 0 ? y - 1 : y) * w;
+    size_t down = (size_t)(y + 1 < h ? y + 1 : y) * w;
+    for (int ch = 0; ch < CIV_TILE_FIELD_CHANNEL_COUNT; ch++) {
+      const float *c = f->value[ch];
+      row_step(f->next[ch] + row, c + row, c + up, c + down,
+               f->source[ch] + row, f->land + row, w, s->q[ch]);
+    }
+  }
+}
+
+/* Exact fractions of the way to the neighbours and to the source over dt,
+   scaled back together if they would overshoot */
+static coeffs_t channel_coeffs(int ch, civ_float_t dt) {
+  float d = 1.0f - expf(-k_diffusion[ch] * (float)dt);
+  float k = 1.0f - expf(-k_relaxation[ch] * (float)dt);
+  if (d + k > 1.0f) {
+    float s = 1.0f / (d + k);
+    d *= s;
+    k *= s;
+  }
+  return (coeffs_t){1.0f - d - k, d * 0.25f, k};
+}
+
+void civ_tile_field_step(civ_tile_field_t *field, struct civ_worker_pool *pool,
+                         civ_float_t dt) {
+  if (!field || dt <= 0.0) return;
+  size_t changed[CIV_TILE_FIELD_REGION_BUDGET];
+  int changed_count = read_changed(field, changed);
+
+  step_ctx_t ctx = {field, {{0}}};
+  for (int ch = 0; ch < CIV_TILE_FIELD_CHANNEL_COUNT; ch++)
+    ctx.q[ch] = channel_coeffs(ch, dt);
+
+  if (field->gpu) {
+    float coeffs[CIV_TILE_FIELD_CHANNEL_COUNT * 3];
+    for (int ch = 0; ch < CIV_TILE_FIELD_CHANNEL_COUNT; ch++) {
+      coeffs[3 * ch] = ctx.q[ch].a;
+      coeffs[3 * ch + 1] = ctx.q[ch].b;
+      coeffs[3 * ch + 2] = ctx.q[ch].k;
+    }
+    if (civ_tile_field_gpu_step(field->gpu, field, pool, changed, changed_count,
+                                coeffs))
+      return;
+    /* Carry on from the last values that came back */
+    civ_log(CIV_LOG_WARNING, "Tile field GPU step failed; stepping on the CPU");
+    civ_tile_field_gpu_destroy(field->gpu);
+    field->gpu = NULL;
+  }
+  civ_worker_pool_parallel_for(pool, (field->height + BAND_ROWS - 1) / BAND_ROWS,
+                               step_band, &ctx);
+
+  for (int ch = 0; ch < CIV_TILE_FIELD_CHANNEL_COUNT; ch++) {
+    float *front = field->next[ch];
+    field->next[ch] = field->value[ch];
+    field->value[ch] = front;
+  }
+  field->steps++;
+}
+
+/* ── Lifecycle ─────────────────────────────────────────────────────── */
+
+civ_tile_field_t *civ_tile_field_create(civ_map_t *map) {
+  if (!map || !map->tiles || map->width <= 0 || map->height <= 0) return NULL;
+  civ_tile_field_t *f = CIV_CALLOC(1, sizeof(civ_tile_field_t));
+  if (!f) {
+    civ_log(CIV_LOG_ERROR, "Failed to allocate tile field");
+    return NULL;
+  }
+  f->map = map;
+  f->width = map->width;
+  f->height = map->height;
+  size_t tiles = (size_t)map->width * map->height;
+
+  bool ok = true;
+  for (int ch = 0; ch < CIV_TILE_FIELD_CHANNEL_COUNT; ch++) {
+    f->value[ch] = CIV_MALLOC(tiles * sizeof(float));
+    f->next[ch] = CIV_MALLOC(tiles * sizeof(float));
+    f->source[ch] = CIV_MALLOC(tiles * sizeof(float));
+    ok = ok && f->value[ch] && f->next[ch] && f->source[ch];
+  }
+  f->land = CIV_MALLOC(tiles * sizeof(float));
+  f->region_count = map->region_revision
+                        ? (size_t)map->region_cols * map->region_rows
+                        : 0;
+  f->region_seen = f->region_count
+                       ? CIV_CALLOC(f->region_count, sizeof(uint32_t))
+                       : NULL;
+  if (!ok || !f->land || (f->region_count && !f->region_seen)) {
+    civ_log(CIV_LOG_ERROR, "Failed to allocate tile field channels");
+    civ_tile_field_destroy(f);
+    return NULL;
+  }
+
+  for (size_t i = 0; i < tiles; i++) read_tile(f, i);
+  for (size_t r = 0; r < f->region_count; r++)
+    f->region_seen[r] = map->region_revision[r];
+  for (int ch = 0; ch < CIV_TILE_FIELD_CHANNEL_COUNT; ch++)
+    for (size_t i = 0; i < tiles; i++)
+      f->value[ch][i] = f->source[ch][i] * f->land[i];
+  return f;
+}
+
+bool civ_tile_field_attach_gpu(civ_tile_field_t *field) {
+  if (!field) return false;
+  if (!field->gpu) field->gpu = civ_tile_field_gpu_create(field);
+  return field->gpu != NULL;
+}
+
+void civ_tile_field_destroy(civ_tile_field_t *field) {
+  if (!field) return;
+  civ_tile_field_gpu_destroy(field->gpu);
+  for (int ch = 0; ch < CIV_TILE_FIELD_CHANNEL_COUNT; ch++) {
+    CIV_FREE(field->value[ch]);
+    CIV_FREE(field->next[ch]);
+    CIV_FREE(field->source[ch]);
+  }
+  CIV_FREE(field->land);
+  CIV_FREE(field->region_seen);
+  CIV_FREE(field);
+}
+
+/* ── Queries ───────────────────────────────────────────────────────── */
+
+float civ_tile_field_at(const civ_tile_field_t *field,
+                        civ_tile_field_channel_t channel, int32_t x, int32_t y) {
+  if (!field || channel < 0 || channel >= CIV_TILE_FIELD_CHANNEL_COUNT)
+    return 0.0f;
+  x = ((x % field->width) + field->width) % field->width;
+  y = CLAMP(y, 0, field->height - 1);
+  return field->value[channel][(size_t)y * field->width + x];
+}
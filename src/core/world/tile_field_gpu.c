@@ -0,0 +1,398 @@
+/**
+ * @file tile_field_gpu.c
+ * @brief Tile fields on an SDL_GPU compute device — region-laid buffers,
+ *        fenced downloads
+ */
+#include "core/world/tile_field_gpu.h"
+#include "core/simulation_engine/worker_pool.h"
+#include "utils/paths.h"
+#include "utils/startup_timeline.h"
+#include "common.h"
+#include <SDL3/SDL.h>
+#include <string.h>
+
+#ifdef SDL_VERSION_ATLEAST
+#if SDL_VERSION_ATLEAST(3, 2, 0)
+#define CIV_TILE_FIELD_GPU 1
+#endif
+#endif
+
+#if CIV_TILE_FIELD_GPU
+
+#define REGION_TILES ((size_t)CIV_MAP_REGION_SIZE * CIV_MAP_REGION_SIZE)
+#define REGION_BYTES (REGION_TILES * sizeof(float))
+#define GROUP_SIZE   16 /* local_size of tile_field.comp */
+#define MAX_CHANNELS 4  /* coefficient slots in the shader's Step block */
+#define SOURCE_PLANES (CIV_TILE_FIELD_CHANNEL_COUNT + 1) /* sources, land */
+
+/* std140 layout of the shader's Step block */
+typedef struct {
+  int32_t  size[2];
+  int32_t  region_cols;
+  uint32_t plane;
+  int32_t  channels;
+  int32_t  pad[3];
+  float    coeffs[MAX_CHANNELS][4];
+} step_uniforms_t;
+
+struct civ_tile_field_gpu {
+  SDL_GPUDevice          *device;
+  SDL_GPUComputePipeline *pipeline;
+  SDL_GPUBuffer          *values[2]; /* front, back; a plane per channel */
+  SDL_GPUBuffer          *sources;   /* a plane per channel, then land */
+  SDL_GPUTransferBuffer  *upload;    /* CIV_TILE_FIELD_REGION_BUDGET regions */
+  SDL_GPUTransferBuffer  *download;  /* one copy of the values */
+  SDL_GPUFence           *fence;     /* download in flight, or NULL */
+  uint64_t                fence_step; /* step that download holds */
+  uint64_t                steps;      /* steps the device front holds */
+  int32_t                 width, height;
+  int32_t                 region_cols, region_rows;
+  uint32_t                plane;      /* floats per plane */
+};
+
+/* ── Region layout ─────────────────────────────────────────────────── */
+
+typedef struct {
+  int32_t x0, y0, w, h;
+} region_rect_t;
+
+static region_rect_t region_rect(const civ_tile_field_gpu_t *g, size_t r) {
+  region_rect_t rc;
+  rc.x0 = (int32_t)(r % (size_t)g->region_cols) << CIV_MAP_REGION_SHIFT;
+  rc.y0 = (int32_t)(r / (size_t)g->region_cols) << CIV_MAP_REGION_SHIFT;
+  rc.w = MIN(CIV_MAP_REGION_SIZE, g->width - rc.x0);
+  rc.h = MIN(CIV_MAP_REGION_SIZE, g->height - rc.y0);
+  return rc;
+}
+
+/* Region r of a row-major plane into a region-laid block; rows and
+   columns past the map edge are zero */
+static void pack_region(const civ_tile_field_gpu_t *g, size_t r,
+                        const float *plane, float *out) {
+  region_rect_t rc = region_rect(g, r);
+  if (rc.w < CIV_MAP_REGION_SIZE || rc.h < CIV_MAP_REGION_SIZE)
+    memset(out, 0, REGION_BYTES);
+  for (int32_t y = 0; y < rc.h; y++)
+    memcpy(out + (size_t)y * CIV_MAP_REGION_SIZE,
+           plane + (size_t)(rc.y0 + y) * g->width + rc.x0,
+           (size_t)rc.w * sizeof(float));
+}
+
+static void unpack_region(const civ_tile_field_gpu_t *g, size_t r,
+                          const float *block, float *plane) {
+  region_rect_t rc = region_rect(g, r);
+  for (int32_t y = 0; y < rc.h; y++)
+    memcpy(plane + (size_t)(rc.y0 + y) * g->width + rc.x0,
+           block + (size_t)y * CIV_MAP_REGION_SIZE,
+           (size_t)rc.w * sizeof(float));
+}
+
+static size_t regions_of(const civ_tile_field_gpu_t *g) {
+  return (size_t)g->region_cols * g->region_rows;
+}
+
+/* ── Collecting downloads ──────────────────────────────────────────── */
+
+typedef struct {
+  const civ_tile_field_gpu_t *g;
+  civ_tile_field_t *f;
+  const float *mapped;
+} unpack_ctx_t;
+
+static void unpack_job(void *ctx, int job) {
+  unpack_ctx_t *u = ctx;
+  for (int ch = 0; ch < CIV_TILE_FIELD_CHANNEL_COUNT; ch++)
+    unpack_region(u->g, (size_t)job,
+                  u->mapped + (size_t)ch * u->g->plane + (size_t)job * REGION_TILES,
+                  u->f->next[ch]);
+}
+
+/* Land a finished download in the back buffer and swap it forward */
+static bool collect(civ_tile_field_gpu_t *g, civ_tile_field_t *f,
+                    struct civ_worker_pool *pool) {
+  if (!g->fence || !SDL_QueryGPUFence(g->device, g->fence)) return true;
+  SDL_ReleaseGPUFence(g->device, g->fence);
+  g->fence = NULL;
+
+  const float *mapped = SDL_MapGPUTransferBuffer(g->device, g->download, false);
+  if (!mapped) return false;
+  unpack_ctx_t ctx = {g, f, mapped};
+  civ_worker_pool_parallel_for(pool, (int)regions_of(g), unpack_job, &ctx);
+  SDL_UnmapGPUTransferBuffer(g->device, g->download);
+
+  for (int ch = 0; ch < CIV_TILE_FIELD_CHANNEL_COUNT; ch++) {
+    float *front = f->next[ch];
+    f->next[ch] = f->value[ch];
+    f->value[ch] = front;
+  }
+  f->steps = g->fence_step;
+  return true;
+}
+
+/* ── Step ──────────────────────────────────────────────────────────── */
+
+/* Pack the changed regions' planes into the upload buffer, in slot order */
+static bool stage_regions(civ_tile_field_gpu_t *g, const civ_tile_field_t *f,
+                          const size_t *regions, int count) {
+  float *staged = SDL_MapGPUTransferBuffer(g->device, g->upload, true);
+  if (!staged) return false;
+  for (int k = 0; k < count; k++)
+    for (int p = 0; p < SOURCE_PLANES; p++) {
+      const float *plane = p < CIV_TILE_FIELD_CHANNEL_COUNT ? f->source[p] : f->land;
+      pack_region(g, regions[k], plane,
+                  staged + ((size_t)k * SOURCE_PLANES + p) * REGION_TILES);
+    }
+  SDL_UnmapGPUTransferBuffer(g->device, g->upload);
+  return true;
+}
+
+static void upload_regions(civ_tile_field_gpu_t *g, SDL_GPUCommandBuffer *cmd,
+                           const size_t *regions, int count) {
+  SDL_GPUCopyPass *copy = SDL_BeginGPUCopyPass(cmd);
+  for (int k = 0; k < count; k++)
+    for (int p = 0; p < SOURCE_PLANES; p++) {
+      SDL_GPUTransferBufferLocation src = {
+          g->upload, (Uint32)(((size_t)k * SOURCE_PLANES + p) * REGION_BYTES)};
+      SDL_GPUBufferRegion dst = {
+          g->sources,
+          (Uint32)(((size_t)p * g->plane + regions[k] * REGION_TILES) *
+                   sizeof(float)),
+          (Uint32)REGION_BYTES};
+      SDL_UploadToGPUBuffer(copy, &src, &dst, false);
+    }
+  SDL_EndGPUCopyPass(copy);
+}
+
+static bool dispatch_step(civ_tile_field_gpu_t *g, SDL_GPUCommandBuffer *cmd,
+                          const float *coeffs) {
+  step_uniforms_t u;
+  SDL_zero(u);
+  u.size[0] = g->width;
+  u.size[1] = g->height;
+  u.region_cols = g->region_cols;
+  u.plane = g->plane;
+  u.channels = CIV_TILE_FIELD_CHANNEL_COUNT;
+  for (int ch = 0; ch < CIV_TILE_FIELD_CHANNEL_COUNT; ch++)
+    memcpy(u.coeffs[ch], coeffs + 3 * ch, 3 * sizeof(float));
+
+  SDL_GPUStorageBufferReadWriteBinding out;
+  SDL_zero(out);
+  out.buffer = g->values[1];
+  SDL_GPUComputePass *pass = SDL_BeginGPUComputePass(cmd, NULL, 0, &out, 1);
+  if (!pass) return false;
+  SDL_GPUBuffer *in[2] = {g->values[0], g->sources};
+  SDL_BindGPUComputePipeline(pass, g->pipeline);
+  SDL_BindGPUComputeStorageBuffers(pass, 0, in, 2);
+  SDL_PushGPUComputeUniformData(cmd, 0, &u, sizeof(u));
+  SDL_DispatchGPUCompute(pass, (Uint32)(g->width + GROUP_SIZE - 1) / GROUP_SIZE,
+                         (Uint32)(g->height + GROUP_SIZE - 1) / GROUP_SIZE, 1);
+  SDL_EndGPUComputePass(pass);
+  return true;
+}
+
+bool civ_tile_field_gpu_step(civ_tile_field_gpu_t *gpu, civ_tile_field_t *field,
+                             struct civ_worker_pool *pool,
+                             const size_t *regions, int region_count,
+                             const float *coeffs) {
+  if (!gpu || !field) return false;
+  if (!collect(gpu, field, pool)) return false;
+  if (region_count > 0 && !stage_regions(gpu, field, regions, region_count))
+    return false;
+
+  SDL_GPUCommandBuffer *cmd = SDL_AcquireGPUCommandBuffer(gpu->device);
+  if (!cmd) return false;
+  if (region_count > 0) upload_regions(gpu, cmd, regions, region_count);
+  if (!dispatch_step(gpu, cmd, coeffs)) {
+    SDL_CancelGPUCommandBuffer(cmd);
+    return false;
+  }
+  SDL_GPUBuffer *front = gpu->values[1];
+  gpu->values[1] = gpu->values[0];
+  gpu->values[0] = front;
+  gpu->steps++;
+
+  /* One download in flight; steps taken meanwhile come back with the next */
+  if (gpu->fence) return SDL_SubmitGPUCommandBuffer(cmd);
+  SDL_GPUCopyPass *copy = SDL_BeginGPUCopyPass(cmd);
+  SDL_GPUBufferRegion src = {
+      front, 0,
+      (Uint32)((size_t)CIV_TILE_FIELD_CHANNEL_COUNT * gpu->plane * sizeof(float))};
+  SDL_GPUTransferBufferLocation dst = {gpu->download, 0};
+  SDL_DownloadFromGPUBuffer(copy, &src, &dst);
+  SDL_EndGPUCopyPass(copy);
+  gpu->fence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmd);
+  gpu->fence_step = gpu->steps;
+  return gpu->fence != NULL;
+}
+
+/* ── Lifecycle ─────────────────────────────────────────────────────── */
+
+static SDL_GPUComputePipeline *load_pipeline(SDL_GPUDevice *device) {
+  char path[512];
+  civ_path_resolve(CIV_TILE_FIELD_SHADER_PATH, path, sizeof(path));
+  size_t code_size = 0;
+  void *code = SDL_LoadFile(path, &code_size);
+  if (!code) return NULL; /* not built: `make shaders` */
+  civ_startup_note_read(code_size);
+
+  SDL_GPUComputePipelineCreateInfo info;
+  SDL_zero(info);
+  info.code_size = code_size;
+  info.code = (const Uint8 *)code;
+  info.entrypoint = "main";
+  info.format = SDL_GPU_SHADERFORMAT_SPIRV;
+  info.num_readonly_storage_buffers = 2;
+  info.num_readwrite_storage_buffers = 1;
+  info.num_uniform_buffers = 1;
+  info.threadcount_x = GROUP_SIZE;
+  info.threadcount_y = GROUP_SIZE;
+  info.threadcount_z = 1;
+  SDL_GPUComputePipeline *pipeline = SDL_CreateGPUComputePipeline(device, &info);
+  if (!pipeline)
+    civ_log(CIV_LOG_WARNING, "Tile field shader rejected: %s", SDL_GetError());
+  SDL_free(code);
+  return pipeline;
+}
+
+static SDL_GPUBuffer *create_storage(SDL_GPUDevice *device, size_t bytes,
+                                     bool written) {
+  SDL_GPUBufferCreateInfo info;
+  SDL_zero(info);
+  info.usage = SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ |
+               (written ? SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE : 0);
+  info.size = (Uint32)bytes;
+  return SDL_CreateGPUBuffer(device, &info);
+}
+
+static SDL_GPUTransferBuffer *create_transfer(SDL_GPUDevice *device,
+                                              size_t bytes, bool upload) {
+  SDL_GPUTransferBufferCreateInfo info;
+  SDL_zero(info);
+  info.usage = upload ? SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD
+                      : SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD;
+  info.size = (Uint32)bytes;
+  return SDL_CreateGPUTransferBuffer(device, &info);
+}
+
+/* Every region of the front values and the sources, through a transfer
+   buffer used once */
+static bool upload_all(civ_tile_field_gpu_t *g, const civ_tile_field_t *f) {
+  size_t regions = regions_of(g);
+  size_t plane_bytes = (size_t)g->plane * sizeof(float);
+  size_t value_bytes = CIV_TILE_FIELD_CHANNEL_COUNT * plane_bytes;
+  size_t source_bytes = SOURCE_PLANES * plane_bytes;
+  SDL_GPUTransferBuffer *tb =
+      create_transfer(g->device, value_bytes + source_bytes, true);
+  if (!tb) return false;
+
+  float *staged = SDL_MapGPUTransferBuffer(g->device, tb, false);
+  if (!staged) {
+    SDL_ReleaseGPUTransferBuffer(g->device, tb);
+    return false;
+  }
+  for (int p = 0; p < CIV_TILE_FIELD_CHANNEL_COUNT + SOURCE_PLANES; p++) {
+    const float *plane = p < CIV_TILE_FIELD_CHANNEL_COUNT ? f->value[p]
+                         : p < 2 * CIV_TILE_FIELD_CHANNEL_COUNT
+                             ? f->source[p - CIV_TILE_FIELD_CHANNEL_COUNT]
+                             : f->land;
+    for (size_t r = 0; r < regions; r++)
+      pack_region(g, r, plane, staged + (size_t)p * g->plane + r * REGION_TILES);
+  }
+  SDL_UnmapGPUTransferBuffer(g->device, tb);
+
+  SDL_GPUCommandBuffer *cmd = SDL_AcquireGPUCommandBuffer(g->device);
+  bool ok = cmd != NULL;
+  if (ok) {
+    SDL_GPUCopyPass *copy = SDL_BeginGPUCopyPass(cmd);
+    SDL_GPUTransferBufferLocation src = {tb, 0};
+    SDL_GPUBufferRegion dst = {g->values[0], 0, (Uint32)value_bytes};
+    SDL_UploadToGPUBuffer(copy, &src, &dst, false);
+    src.offset = (Uint32)value_bytes;
+    dst = (SDL_GPUBufferRegion){g->sources, 0, (Uint32)source_bytes};
+    SDL_UploadToGPUBuffer(copy, &src, &dst, false);
+    SDL_EndGPUCopyPass(copy);
+    ok = SDL_SubmitGPUCommandBuffer(cmd) && SDL_WaitForGPUIdle(g->device);
+  }
+  SDL_ReleaseGPUTransferBuffer(g->device, tb);
+  return ok;
+}
+
+civ_tile_field_gpu_t *civ_tile_field_gpu_create(const civ_tile_field_t *field) {
+  if (!field || field->width <= 0 || field->height <= 0 ||
+      CIV_TILE_FIELD_CHANNEL_COUNT > MAX_CHANNELS)
+    return NULL;
+  int32_t cols = (field->width + CIV_MAP_REGION_SIZE - 1) >> CIV_MAP_REGION_SHIFT;
+  int32_t rows = (field->height + CIV_MAP_REGION_SIZE - 1) >> CIV_MAP_REGION_SHIFT;
+  size_t plane = (size_t)cols * rows * REGION_TILES;
+  /* Buffer sizes and offsets are 32-bit */
+  if (SOURCE_PLANES * plane * sizeof(float) > UINT32_MAX) return NULL;
+
+  SDL_GPUDevice *device = SDL_CreateGPUDevice(SDL_GPU_SHADERFORMAT_SPIRV, false, NULL);
+  if (!device) return NULL; /* no SPIR-V capable driver */
+
+  civ_tile_field_gpu_t *g = CIV_CALLOC(1, sizeof(civ_tile_field_gpu_t));
+  if (!g) {
+    SDL_DestroyGPUDevice(device);
+    return NULL;
+  }
+  g->device = device;
+  g->width = field->width;
+  g->height = field->height;
+  g->region_cols = cols;
+  g->region_rows = rows;
+  g->plane = (uint32_t)plane;
+  g->steps = field->steps;
+
+  size_t plane_bytes = plane * sizeof(float);
+  g->pipeline = load_pipeline(device);
+  g->values[0] = create_storage(device, CIV_TILE_FIELD_CHANNEL_COUNT * plane_bytes, true);
+  g->values[1] = create_storage(device, CIV_TILE_FIELD_CHANNEL_COUNT * plane_bytes, true);
+  g->sources = create_storage(device, SOURCE_PLANES * plane_bytes, false);
+  g->upload = create_transfer(
+      device, (size_t)CIV_TILE_FIELD_REGION_BUDGET * SOURCE_PLANES * REGION_BYTES,
+      true);
+  g->download =
+      create_transfer(device, CIV_TILE_FIELD_CHANNEL_COUNT * plane_bytes, false);
+  if (!g->pipeline || !g->values[0] || !g->values[1] || !g->sources ||
+      !g->upload || !g->download || !upload_all(g, field)) {
+    civ_tile_field_gpu_destroy(g);
+    return NULL;
+  }
+  civ_log(CIV_LOG_INFO, "Tile field on the GPU (%s, %d regions)",
+          SDL_GetGPUDeviceDriver(device), (int)regions_of(g));
+  return g;
+}
+
+void civ_tile_field_gpu_destroy(civ_tile_field_gpu_t *gpu) {
+  if (!gpu) return;
+  SDL_WaitForGPUIdle(gpu->device);
+  if (gpu->fence) SDL_ReleaseGPUFence(gpu->device, gpu->fence);
+  if (gpu->download) SDL_ReleaseGPUTransferBuffer(gpu->device, gpu->download);
+  if (gpu->upload) SDL_ReleaseGPUTransferBuffer(gpu->device, gpu->upload);
+  if (gpu->sources) SDL_ReleaseGPUBuffer(gpu->device, gpu->sources);
+  for (int i = 0; i < 2; i++)
+    if (gpu->values[i]) SDL_ReleaseGPUBuffer(gpu->device, gpu->values[i]);
+  if (gpu->pipeline) SDL_ReleaseGPUComputePipeline(gpu->device, gpu->pipeline);
+  SDL_DestroyGPUDevice(gpu->device);
+  CIV_FREE(gpu);
+}
+
+#else /* no SDL_GPU */
+
+civ_tile_field_gpu_t *civ_tile_field_gpu_create(const civ_tile_field_t *field) {
+  (void)field;
+  return NULL;
+}
+
+void civ_tile_field_gpu_destroy(civ_tile_field_gpu_t *gpu) { (void)gpu; }
+
+bool civ_tile_field_gpu_step(civ_tile_field_gpu_t *gpu, civ_tile_field_t *field,
+                             struct civ_worker_pool *pool,
+                             const size_t *regions, int region_count,
+                             const float *coeffs) {
+  (void)gpu; (void)field; (void)pool; (void)regions; (void)region_count;
+  (void)coeffs;
+  return false;
+}
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * @file visibility.c
+ * @brief Differential sight-disc stamping over per-tile reference counts
+ */
+#include "core/world/visibility.h"
+#include "common.h"
+#include <string.h>
+
+civ_visibility_t *civ_visibility_create(void) {
+  return CIV_CALLOC(1, sizeof(civ_visibility_t));
+}
+
+void civ_visibility_destroy(civ_visibility_t *vis) {
+  if (!vis) return;
+  CIV_FREE(vis->refs);
+  CIV_FREE(vis->stamps);
+  CIV_FREE(vis);
+}
+
+/* Rebuild from scratch for a new or resized map: clear its fog once */
+static bool bind_map(civ_visibility_t *vis, civ_map_t *map) {
+  if (vis->map == map && vis->width == map->width && vis->height == map->height &&
+      vis->refs)
+    return true;
+
+  size_t n = (size_t)map->width * map->height;
+  uint16_t *refs = CIV_CALLOC(n, sizeof(uint16_t));
+  if (!refs) return false;
+  CIV_FREE(vis->refs);
+  vis->refs = refs;
+  vis->map = map;
+  vis->width = map->width;
+  vis->height = map->height;
+  for (size_t i = 0; i < vis->stamp_count; i++) vis->stamps[i].range = -1;
+  for (size_t i = 0; i < n; i++)
+    if (civ_map_visible_at(map, i))
+      civ_map_set_visibility(map, i, false, civ_map_explored_at(map, i));
+  return true;
+}
+
+static int32_t wrap_x(int32_t x, int32_t w) {
+  x %= w;
+  return x < 0 ? x + w : x;
+}
+
+/* Horizontal ranges are capped so a disc never wraps onto itself and no
+   tile is stamped twice by one source */
+static int32_t clamp_range(int32_t range, int32_t w) {
+  return MIN(range, (w - 1) / 2);
+}
+
+static bool in_disc(const civ_visibility_stamp_t *d, int32_t w, int32_t tx,
+                    int32_t ty) {
+  if (d->range < 0) return false;
+  int32_t dy = ty - d->y;
+  int32_t dx = wrap_x(tx - d->x, w);
+  if (dx > w / 2) dx -= w;
+  return dx * dx + dy * dy <= d->range * d->range;
+}
+
+/* Add delta to every tile of disc a that is not in disc b */
+static size_t stamp_difference(civ_visibility_t *vis, civ_map_t *map,
+                               const civ_visibility_stamp_t *a,
+                               const civ_visibility_stamp_t *b, int delta) {
+  if (a->range < 0) return 0;
+  size_t changed = 0;
+  int32_t r = a->range;
+  for (int32_t dy = -r; dy <= r; dy++) {
+    int32_t ty = a->y + dy;
+    if (ty < 0 || ty >= map->height) continue;
+    for (int32_t dx = -r; dx <= r; dx++) {
+      if (dx * dx + dy * dy > r * r) continue;
+      int32_t tx = wrap_x(a->x + dx, map->width);
+      if (in_disc(b, map->width, tx, ty)) continue;
+      size_t i = (size_t)ty * map->width + tx;
+      if (delta > 0) {
+        if (vis->refs[i]++ == 0) {
+          civ_map_set_visibility(map, i, true, true);
+          changed++;
+        }
+      } else if (vis->refs[i] > 0 && --vis->refs[i] == 0) {
+        civ_map_set_visibility(map, i, false, civ_map_explored_at(map, i));
+        changed++;
+      }
+    }
+  }
+  return changed;
+}
+
+static size_t move_stamp(civ_visibility_t *vis, civ_map_t *map,
+                         civ_visibility_stamp_t *cur,
+                         civ_visibility_stamp_t next) {
+  if (cur->x == next.x && cur->y == next.y && cur->range == next.range)
+    return 0;
+  size_t changed = stamp_difference(vis, map, cur, &next, -1);
+  changed += stamp_difference(vis, map, &next, cur, +1);
+  *cur = next;
+  return changed;
+}
+
+size_t civ_visibility_update_source(civ_visibility_t *vis, civ_map_t *map,
+                                    size_t source, int32_t x, int32_t y,
+                                    int32_t range) {
+  if (!vis || !map || !map->tiles || map->width <= 0 || !bind_map(vis, map))
+    return 0;
+
+  if (source >= vis->stamp_count) {
+    if (source >= vis->stamp_capacity) {
+      size_t cap = vis->stamp_capacity ? vis->stamp_capacity : 64;
+      while (cap <= source) cap *= 2;
+      civ_visibility_stamp_t *s =
+          CIV_REALLOC(vis->stamps, cap * sizeof(civ_visibility_stamp_t));
+      if (!s) return 0;
+      vis->stamps = s;
+      vis->stamp_capacity = cap;
+    }
+    for (size_t i = vis->stamp_count; i <= source; i++)
+      vis->stamps[i] = (civ_visibility_stamp_t){0, 0, -1};
+    vis->stamp_count = source + 1;
+  }
+
+  civ_visibility_stamp_t next = {wrap_x(x, map->width), y, -1};
+  if (range >= 0) next.range = clamp_range(range, map->width);
+  return move_stamp(vis, map, &vis->stamps[source], next);
+}
+
+size_t civ_visibility_truncate(civ_visibility_t *vis, civ_map_t *map,
+                               size_t count) {
+  if (!vis || !map || vis->map != map || !vis->refs) return 0;
+  size_t changed = 0;
+  for (size_t i = count; i < vis->stamp_count; i++)
+    changed += move_stamp(vis, map, &vis->stamps[i],
+                          (civ_visibility_stamp_t){0, 0, -1});
+  if (count < vis->stamp_count) vis->stamp_count = count;
+  return changed;
+}
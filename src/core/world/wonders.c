@@ -108,18 +108,29 @@ void civ_wonder_mark_built(civ_wonder_manager_t *manager,
   if (builder_id) {
     strncpy(w->builder_id, builder_id, STRING_SHORT_LEN - 1);
   }
+  w->builder_owner = civ_owner_intern(w->builder_id);
+  manager->revision++;
 }
 
 civ_wonder_effects_t
 civ_wonder_calculate_global_bonuses(const civ_wonder_manager_t *manager,
                                     const char *owner_id) {
-  civ_wonder_effects_t total = {0};
+  civ_wonder_effects_t none = {0};
   if (!manager || !owner_id)
+    return none;
+  return civ_wonder_owner_bonuses(manager, civ_owner_find(owner_id));
+}
+
+civ_wonder_effects_t
+civ_wonder_owner_bonuses(const civ_wonder_manager_t *manager,
+                         civ_owner_index_t owner) {
+  civ_wonder_effects_t total = {0};
+  if (!manager || owner == CIV_OWNER_NONE)
     return total;
 
   for (int i = 0; i < CIV_WONDER_COUNT; i++) {
     const civ_wonder_t *w = &manager->wonders[i];
-    if (w->is_built && strcmp(w->builder_id, owner_id) == 0) {
+    if (w->is_built && w->builder_owner == owner) {
       total.science_mult += w->effects.science_mult;
       total.culture_mult += w->effects.culture_mult;
       total.production_mult += w->effects.production_mult;
@@ -0,0 +1,70 @@
+/**
+ * @file world_pack.c
+ * @brief Header/TOC validation and section views for data/world.pack
+ */
+#include "core/world/world_pack.h"
+#include "common.h"
+#include <string.h>
+
+static const char SECTION_TAGS[CIV_PACK_SECTION_COUNT][4] = {
+  {'E', 'A', 'R', 'T'}, {'B', 'O', 'R', 'D'}, {'N', 'A', 'T', 'N'},
+  {'R', 'S', 'R', 'C'}, {'C', 'I', 'T', 'Y'}, {'F', 'L', 'A', 'G'},
+};
+
+civ_world_pack_t *civ_world_pack_open(const char *path) {
+  civ_world_pack_t *pack = CIV_CALLOC(1, sizeof(civ_world_pack_t));
+  if (!pack) return NULL;
+  /* Prefetched a section at a time, as loaders ask for them */
+  if (!civ_mapped_file_open_lazy(&pack->file, path)) {
+    CIV_FREE(pack);
+    return NULL;
+  }
+
+  const civ_mapped_file_t *f = &pack->file;
+  civ_world_pack_header_t hdr;
+  if (f->size < sizeof(hdr)) goto invalid;
+  memcpy(&hdr, f->data, sizeof(hdr));
+  if (hdr.magic != CIV_WORLD_PACK_MAGIC || hdr.version != CIV_WORLD_PACK_VERSION ||
+      hdr.file_size != f->size || hdr.toc_offset < sizeof(hdr) ||
+      hdr.toc_offset > f->size ||
+      (f->size - hdr.toc_offset) / sizeof(civ_world_pack_entry_t) < hdr.section_count)
+    goto invalid;
+
+  for (uint32_t i = 0; i < hdr.section_count; i++) {
+    civ_world_pack_entry_t e;
+    memcpy(&e, f->data + hdr.toc_offset + i * sizeof(e), sizeof(e));
+    if (e.offset % CIV_WORLD_PACK_ALIGN != 0 || e.offset > f->size ||
+        e.size > f->size - e.offset)
+      goto invalid;
+    for (int s = 0; s < CIV_PACK_SECTION_COUNT; s++) {
+      if (memcmp(e.tag, SECTION_TAGS[s], 4) != 0) continue;
+      pack->sections[s].data = f->data + e.offset;
+      pack->sections[s].size = (size_t)e.size;
+      break;
+    }
+  }
+  return pack;
+
+invalid:
+  civ_log(CIV_LOG_WARNING, "World pack %s is malformed, ignoring it", path);
+  civ_world_pack_close(pack);
+  return NULL;
+}
+
+void civ_world_pack_close(civ_world_pack_t *pack) {
+  if (!pack) return;
+  civ_mapped_file_close(&pack->file);
+  CIV_FREE(pack);
+}
+
+bool civ_world_pack_section(const civ_world_pack_t *pack,
+                            civ_pack_section_t section, civ_pack_view_t *out) {
+  if (!pack || section < 0 || section >= CIV_PACK_SECTION_COUNT ||
+      !pack->sections[section].data)
+    return false;
+  if (out) {
+    *out = pack->sections[section];
+    civ_mapped_file_prefetch(&pack->file, out->data, out->size);
+  }
+  return true;
+}
@@ -1,4 +1,5 @@
 #include "display/camera.h"
+#include "engine/frame_pacer.h"
 #include <math.h>
 
 #define WORLD_UNIT_SIZE 4.0f
@@ -23,6 +24,14 @@ void civ_camera_update(civ_camera_t *cam, float dt) {
   cam->y += (cam->target_y - cam->y) * t;
   cam->zoom += (cam->target_zoom - cam->zoom) * t;
 
+  /* Still easing toward the target: keep frames coming until it settles
+     to within a tenth of a pixel */
+  float px = cam->zoom * WORLD_UNIT_SIZE;
+  if (fabsf(cam->target_x - cam->x) * px > 0.1f ||
+      fabsf(cam->target_y - cam->y) * px > 0.1f ||
+      fabsf(cam->target_zoom - cam->zoom) > cam->zoom * 1e-4f)
+    civ_frame_request_redraw();
+
   float half_h = (cam->map_height * 0.5f);
   if (cam->y < half_h * 0.1f) cam->y = half_h * 0.1f;
   if (cam->y > cam->map_height - half_h * 0.1f)
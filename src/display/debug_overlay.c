@@ -1,6 +1,17 @@
 #include "display/debug_overlay.h"
+#include "utils/mem_tags.h"
+#include "utils/startup_timeline.h"
 #include <stdio.h>
 
+/* Phase colours, cycled by metric id */
+static const SDL_Color PROFILE_PALETTE[] = {
+    {230, 90, 70, 255},  {240, 170, 60, 255}, {220, 220, 80, 255},
+    {120, 200, 90, 255}, {70, 190, 170, 255}, {80, 150, 230, 255},
+    {140, 110, 230, 255}, {210, 100, 200, 255}, {170, 170, 170, 255},
+    {200, 130, 90, 255}, {100, 120, 90, 255}, {90, 100, 160, 255},
+};
+#define PROFILE_PALETTE_COUNT (sizeof(PROFILE_PALETTE) / sizeof(PROFILE_PALETTE[0]))
+
 void civ_debug_overlay_init(civ_debug_overlay_t *d) {
   d->enabled = true;
   d->frame_time_ms = 0.0;
@@ -11,6 +22,10 @@ void civ_debug_overlay_init(civ_debug_overlay_t *d) {
   d->max_frame_ms = 0.0;
   d->frame_count = 0;
   d->accumulator = 0.0;
+  d->show_profile = true;
+  d->profile_count = 0;
+  d->show_memory = true;
+  d->show_startup = true;
 }
 
 void civ_debug_overlay_update(civ_debug_overlay_t *d, double dt_ms,
@@ -62,4 +77,182 @@ void civ_debug_overlay_render(civ_debug_overlay_t *d, SDL_Renderer *r,
            d->avg_frame_ms);
   (void)buf; /* Used when font renderer is attached */
   (void)line;
+
+  if (d->show_profile)
+    civ_debug_overlay_render_profile(d, r, x - 4, y + 58);
+  int next_y = y + 58 + 84;
+  if (d->show_memory && civ_mem_tags_enabled()) {
+    civ_debug_overlay_render_memory(d, r, x - 4, next_y);
+    next_y += 6 * CIV_MEM_TAG_COUNT + 4;
+  }
+  if (d->show_startup)
+    civ_debug_overlay_render_startup(d, r, x - 4, next_y);
+}
+
+void civ_debug_overlay_render_profile(civ_debug_overlay_t *d, SDL_Renderer *r,
+                                      int x, int y) {
+  if (!d || !r) return;
+
+  d->profile_count =
+      civ_profiler_get_history(d->profile_frames, CIV_DEBUG_PROFILE_FRAMES);
+  size_t metrics = civ_profiler_metric_count();
+
+  const float bar_w = 2.0f;
+  const float panel_w = bar_w * CIV_DEBUG_PROFILE_FRAMES;
+  const float panel_h = 80.0f;
+
+  /* Scale to the budget, or to the worst tick when it overruns */
+  double peak_ms = CIV_DEBUG_PROFILE_BUDGET_MS;
+  size_t hot_id = 0;
+  float hot_ms = 0.0f;
+  for (size_t f = 0; f < d->profile_count; f++) {
+    const civ_profile_frame_t *fr = &d->profile_frames[f];
+    double total = 0.0;
+    for (size_t m = 0; m < metrics; m++) total += fr->metric_ms[m];
+    if (total > peak_ms) peak_ms = total;
+  }
+  if (d->profile_count > 0) {
+    const civ_profile_frame_t *last = &d->profile_frames[d->profile_count - 1];
+    for (size_t m = 0; m < metrics; m++) {
+      if (last->metric_ms[m] > hot_ms) {
+        hot_ms = last->metric_ms[m];
+        hot_id = m;
+      }
+    }
+  }
+  float px_per_ms = panel_h / (float)peak_ms;
+
+  SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+  SDL_SetRenderDrawColor(r, 0, 0, 0, 160);
+  SDL_FRect bg = {(float)x, (float)y, panel_w, panel_h};
+  SDL_RenderFillRect(r, &bg);
+
+  float bx = (float)x + panel_w - bar_w * (float)d->profile_count;
+  for (size_t f = 0; f < d->profile_count; f++, bx += bar_w) {
+    const civ_profile_frame_t *fr = &d->profile_frames[f];
+    float by = (float)y + panel_h;
+    for (size_t m = 0; m < metrics; m++) {
+      float h = fr->metric_ms[m] * px_per_ms;
+      if (h < 0.25f) continue;
+      SDL_Color c = PROFILE_PALETTE[m % PROFILE_PALETTE_COUNT];
+      SDL_SetRenderDrawColor(r, c.r, c.g, c.b, 220);
+      by -= h;
+      SDL_FRect seg = {bx, by, bar_w, h};
+      SDL_RenderFillRect(r, &seg);
+    }
+  }
+
+  /* Budget reference line */
+  SDL_SetRenderDrawColor(r, 255, 255, 255, 120);
+  float budget_y = (float)y + panel_h -
+                   (float)CIV_DEBUG_PROFILE_BUDGET_MS * px_per_ms;
+  SDL_FRect budget = {(float)x, budget_y, panel_w, 1.0f};
+  SDL_RenderFillRect(r, &budget);
+
+  char buf[96];
+  snprintf(buf, sizeof(buf), "hot: %s %.2fms  peak %.1fms",
+           civ_profiler_metric_name((civ_profile_id_t)hot_id), hot_ms, peak_ms);
+  (void)buf; /* Used when font renderer is attached */
+}
+
+void civ_debug_overlay_render_memory(civ_debug_overlay_t *d, SDL_Renderer *r,
+                                     int x, int y) {
+  if (!d || !r) return;
+
+  civ_mem_tag_stats_t stats[CIV_MEM_TAG_COUNT];
+  size_t scale = 1;
+  int churn_tag = 0;
+  for (int t = 0; t < CIV_MEM_TAG_COUNT; t++) {
+    civ_mem_tags_get((civ_mem_tag_t)t, &stats[t]);
+    if (stats[t].peak_bytes > scale) scale = stats[t].peak_bytes;
+    if (stats[t].pool_peak_bytes > scale) scale = stats[t].pool_peak_bytes;
+    if (stats[t].turn_allocations > stats[churn_tag].turn_allocations)
+      churn_tag = t;
+  }
+
+  const float panel_w = 2.0f * CIV_DEBUG_PROFILE_FRAMES;
+  const float row_h = 6.0f;
+  const float panel_h = row_h * CIV_MEM_TAG_COUNT;
+  float px_per_byte = panel_w / (float)scale;
+
+  SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+  SDL_SetRenderDrawColor(r, 0, 0, 0, 160);
+  SDL_FRect bg = {(float)x, (float)y, panel_w, panel_h};
+  SDL_RenderFillRect(r, &bg);
+
+  for (int t = 0; t < CIV_MEM_TAG_COUNT; t++) {
+    const civ_mem_tag_stats_t *s = &stats[t];
+    float ry = (float)y + row_h * (float)t;
+    SDL_Color c = PROFILE_PALETTE[t % PROFILE_PALETTE_COUNT];
+
+    SDL_SetRenderDrawColor(r, c.r, c.g, c.b, 220);
+    SDL_FRect live = {(float)x, ry, (float)s->live_bytes * px_per_byte,
+                      row_h - 2.0f};
+    SDL_RenderFillRect(r, &live);
+    SDL_SetRenderDrawColor(r, c.r / 2, c.g / 2, c.b / 2, 220);
+    SDL_FRect pooled = {(float)x, ry + row_h - 2.0f,
+                        (float)s->pool_live_bytes * px_per_byte, 1.0f};
+    SDL_RenderFillRect(r, &pooled);
+
+    /* Peak tick */
+    SDL_SetRenderDrawColor(r, 255, 255, 255, 160);
+    SDL_FRect peak = {(float)x + (float)s->peak_bytes * px_per_byte, ry, 1.0f,
+                      row_h - 1.0f};
+    SDL_RenderFillRect(r, &peak);
+  }
+
+  char buf[96];
+  snprintf(buf, sizeof(buf), "churn: %s %llu allocs/turn",
+           civ_mem_tag_name((civ_mem_tag_t)churn_tag),
+           (unsigned long long)stats[churn_tag].turn_allocations);
+  (void)buf; /* Used when font renderer is attached */
+}
+
+void civ_debug_overlay_render_startup(civ_debug_overlay_t *d, SDL_Renderer *r,
+                                      int x, int y) {
+  if (!d || !r) return;
+
+  int count = civ_startup_timeline_count();
+  if (count == 0) return;
+  civ_startup_step_t step;
+  double span_ms = 1.0;
+  int longest = 0;
+  double longest_ms = 0.0;
+  for (int i = 0; civ_startup_timeline_get(i, &step); i++) {
+    double end = step.start_ms + step.wall_ms;
+    if (end > span_ms) span_ms = end;
+    if (step.depth == 0 && step.wall_ms > longest_ms) {
+      longest_ms = step.wall_ms;
+      longest = i;
+    }
+  }
+
+  const float panel_w = 2.0f * CIV_DEBUG_PROFILE_FRAMES;
+  const float row_h = 4.0f;
+  float px_per_ms = panel_w / (float)span_ms;
+
+  SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+  SDL_SetRenderDrawColor(r, 0, 0, 0, 160);
+  SDL_FRect bg = {(float)x, (float)y, panel_w, row_h * (float)count};
+  SDL_RenderFillRect(r, &bg);
+
+  for (int i = 0; civ_startup_timeline_get(i, &step); i++) {
+    /* Same thread, same colour */
+    uint32_t h = 5381;
+    for (const char *c = step.thread; *c; c++) h = h * 33u + (uint8_t)*c;
+    SDL_Color c = PROFILE_PALETTE[h % PROFILE_PALETTE_COUNT];
+    SDL_SetRenderDrawColor(r, c.r, c.g, c.b, step.done ? 220 : 110);
+    float inset = (float)MIN(step.depth, 1);
+    SDL_FRect bar = {(float)x + (float)step.start_ms * px_per_ms,
+                     (float)y + row_h * (float)i + inset,
+                     MAX((float)step.wall_ms * px_per_ms, 1.0f),
+                     row_h - 1.0f - inset};
+    SDL_RenderFillRect(r, &bar);
+  }
+
+  char buf[96];
+  civ_startup_timeline_get(longest, &step);
+  snprintf(buf, sizeof(buf), "startup %.0fms, longest: %s %.0fms", span_ms,
+           step.name, step.wall_ms);
+  (void)buf; /* Used when font renderer is attached */
 }
@@ -1,4 +1,7 @@
 #include "display/draw_list.h"
+#include "common.h"
+#include "utils/frame_trace.h"
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -11,6 +14,11 @@ void civ_draw_list_init(civ_draw_list_t *dl, int initial_capacity) {
   dl->capacity = dl->cmds ? cap : 0;
   dl->draw_calls_this_frame = 0;
   dl->last_frame_ms = 0.0;
+  dl->sort_by_y = true;
+  dl->vertices = NULL;
+  dl->vertex_capacity = 0;
+  dl->indices = NULL;
+  dl->index_capacity = 0;
 }
 
 void civ_draw_list_clear(civ_draw_list_t *dl) {
@@ -21,14 +29,20 @@ void civ_draw_list_clear(civ_draw_list_t *dl) {
 
 void civ_draw_list_destroy(civ_draw_list_t *dl) {
   free(dl->cmds);
+  free(dl->vertices);
+  free(dl->indices);
   dl->cmds = NULL;
+  dl->vertices = NULL;
+  dl->indices = NULL;
   dl->count = 0;
   dl->capacity = 0;
+  dl->vertex_capacity = 0;
+  dl->index_capacity = 0;
 }
 
 static void ensure_capacity(civ_draw_list_t *dl) {
   if (dl->count >= dl->capacity) {
-    int new_cap = dl->capacity * 2;
+    int new_cap = dl->capacity ? dl->capacity * 2 : INITIAL_CAP;
     civ_draw_cmd_t *new_cmds =
         (civ_draw_cmd_t *)realloc(dl->cmds, (size_t)new_cap * sizeof(civ_draw_cmd_t));
     if (new_cmds) {
@@ -43,7 +57,8 @@ static void push_cmd(civ_draw_list_t *dl, civ_draw_type_t type, float x, float y
                      int thickness, SDL_Texture *tex, const char *text,
                      int layer) {
   ensure_capacity(dl);
-  civ_draw_cmd_t *cmd = &dl->cmds[dl->count++];
+  if (dl->count >= dl->capacity) return;
+  civ_draw_cmd_t *cmd = &dl->cmds[dl->count];
   memset(cmd, 0, sizeof(*cmd));
   cmd->type = type;
   cmd->x = x;
@@ -56,7 +71,10 @@ static void push_cmd(civ_draw_list_t *dl, civ_draw_type_t type, float x, float y
   cmd->texture = tex;
   cmd->text = text;
   cmd->layer = layer;
-  cmd->sort_key = ((uint32_t)layer << 24) | (uint32_t)(y * 10.0f);
+  cmd->sort_key = (uint32_t)layer << 24;
+  if (dl->sort_by_y && y > 0.0f)
+    cmd->sort_key |= MIN((uint32_t)(y * 10.0f), 0xFFFFFFu);
+  cmd->order = dl->count++;
 }
 
 void civ_draw_rect_filled(civ_draw_list_t *dl, float x, float y, float w, float h,
@@ -81,28 +99,117 @@ void civ_draw_text(civ_draw_list_t *dl, const char *text, float x, float y,
   push_cmd(dl, CIV_DRAW_TEXT, x, y, 0, 0, color, 255, 0, NULL, text, layer);
 }
 
-static void flush_one(civ_draw_cmd_t *cmd, SDL_Renderer *r) {
-  SDL_SetRenderDrawColor(r, (cmd->color >> 16) & 0xFF, (cmd->color >> 8) & 0xFF,
-                         cmd->color & 0xFF, cmd->alpha);
-  SDL_FRect rect = {cmd->x, cmd->y, cmd->w, cmd->h};
+void civ_draw_texture(civ_draw_list_t *dl, SDL_Texture *texture, float x,
+                      float y, float w, float h, uint8_t alpha, int layer) {
+  push_cmd(dl, CIV_DRAW_TEXTURE, x, y, w, h, 0xFFFFFF, alpha, 0, texture, NULL,
+           layer);
+}
+
+/* ── Geometry ─────────────────────────────────────────────────────── */
+
+typedef struct {
+  civ_draw_list_t *dl;
+  int vertex_count;
+  int index_count;
+} geometry_t;
+
+static bool reserve_quads(geometry_t *g, int quads) {
+  civ_draw_list_t *dl = g->dl;
+  int need_v = g->vertex_count + quads * 4;
+  int need_i = g->index_count + quads * 6;
+  if (need_v > dl->vertex_capacity) {
+    int cap = dl->vertex_capacity ? dl->vertex_capacity : 1024;
+    while (cap < need_v) cap *= 2;
+    SDL_Vertex *v = (SDL_Vertex *)realloc(dl->vertices, (size_t)cap * sizeof(SDL_Vertex));
+    if (!v) return false;
+    dl->vertices = v;
+    dl->vertex_capacity = cap;
+  }
+  if (need_i > dl->index_capacity) {
+    int cap = dl->index_capacity ? dl->index_capacity : 1536;
+    while (cap < need_i) cap *= 2;
+    int *idx = (int *)realloc(dl->indices, (size_t)cap * sizeof(int));
+    if (!idx) return false;
+    dl->indices = idx;
+    dl->index_capacity = cap;
+  }
+  return true;
+}
 
+/* Quad p0 p1 p2 p3 (clockwise) with one colour; uv spans the texture */
+static void push_quad(geometry_t *g, const SDL_FPoint p[4], SDL_FColor color) {
+  static const SDL_FPoint uv[4] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+  SDL_Vertex *v = &g->dl->vertices[g->vertex_count];
+  int *idx = &g->dl->indices[g->index_count];
+  for (int k = 0; k < 4; k++)
+    v[k] = (SDL_Vertex){p[k], color, uv[k]};
+  int base = g->vertex_count;
+  idx[0] = base;
+  idx[1] = base + 1;
+  idx[2] = base + 2;
+  idx[3] = base;
+  idx[4] = base + 2;
+  idx[5] = base + 3;
+  g->vertex_count += 4;
+  g->index_count += 6;
+}
+
+static void push_rect(geometry_t *g, float x, float y, float w, float h,
+                      SDL_FColor color) {
+  if (w <= 0.0f || h <= 0.0f) return;
+  SDL_FPoint p[4] = {{x, y}, {x + w, y}, {x + w, y + h}, {x, y + h}};
+  push_quad(g, p, color);
+}
+
+/* A one-pixel line is a quad half a pixel either side of its axis */
+static void push_line(geometry_t *g, float x1, float y1, float x2, float y2,
+                      SDL_FColor color) {
+  float dx = x2 - x1, dy = y2 - y1;
+  float len = sqrtf(dx * dx + dy * dy);
+  if (len <= 0.0f) {
+    push_rect(g, x1, y1, 1.0f, 1.0f, color);
+    return;
+  }
+  float nx = -dy / len * 0.5f, ny = dx / len * 0.5f;
+  SDL_FPoint p[4] = {{x1 + nx, y1 + ny}, {x2 + nx, y2 + ny},
+                     {x2 - nx, y2 - ny}, {x1 - nx, y1 - ny}};
+  push_quad(g, p, color);
+}
+
+static int quads_for(const civ_draw_cmd_t *cmd) {
   switch (cmd->type) {
   case CIV_DRAW_RECT_FILLED:
-    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
-    SDL_RenderFillRect(r, &rect);
+  case CIV_DRAW_LINE:
+    return 1;
+  case CIV_DRAW_RECT_OUTLINE:
+    return 4;
+  case CIV_DRAW_TEXTURE:
+    return cmd->texture ? 1 : 0;
+  default:
+    return 0;
+  }
+}
+
+static void append_cmd(geometry_t *g, const civ_draw_cmd_t *cmd) {
+  SDL_FColor c = {((cmd->color >> 16) & 0xFF) / 255.0f,
+                  ((cmd->color >> 8) & 0xFF) / 255.0f,
+                  (cmd->color & 0xFF) / 255.0f, cmd->alpha / 255.0f};
+  float t = (float)MAX(cmd->thickness, 0);
+
+  switch (cmd->type) {
+  case CIV_DRAW_RECT_FILLED:
+  case CIV_DRAW_TEXTURE:
+    push_rect(g, cmd->x, cmd->y, cmd->w, cmd->h, c);
     break;
   case CIV_DRAW_RECT_OUTLINE:
-    for (int i = 0; i < cmd->thickness; i++) {
-      SDL_FRect or_rect = {cmd->x + (float)i, cmd->y + (float)i,
-                           cmd->w - 2.0f * (float)i, cmd->h - 2.0f * (float)i};
-      SDL_RenderRect(r, &or_rect);
-    }
+    t = MIN(t, MIN(cmd->w, cmd->h) * 0.5f);
+    push_rect(g, cmd->x, cmd->y, cmd->w, t, c);
+    push_rect(g, cmd->x, cmd->y + cmd->h - t, cmd->w, t, c);
+    push_rect(g, cmd->x, cmd->y + t, t, cmd->h - 2.0f * t, c);
+    push_rect(g, cmd->x + cmd->w - t, cmd->y + t, t, cmd->h - 2.0f * t, c);
     break;
   case CIV_DRAW_LINE:
-    SDL_RenderLine(r, cmd->x, cmd->y, cmd->w, cmd->h);
-    break;
-  case CIV_DRAW_TEXTURE:
-    if (cmd->texture) SDL_RenderTexture(r, cmd->texture, NULL, &rect);
+    push_line(g, cmd->x, cmd->y, cmd->w, cmd->h, c);
     break;
   default:
     break;
@@ -114,18 +221,38 @@ static int cmd_compare(const void *a, const void *b) {
   const civ_draw_cmd_t *cb = (const civ_draw_cmd_t *)b;
   if (ca->sort_key != cb->sort_key)
     return (ca->sort_key > cb->sort_key) ? 1 : -1;
-  return 0;
+  return (ca->order > cb->order) - (ca->order < cb->order);
 }
 
 void civ_draw_list_flush(civ_draw_list_t *dl, SDL_Renderer *r) {
   if (!dl || !dl->cmds || dl->count == 0) return;
 
-  /* Sort by layer + y */
+  /* Sort by layer (+ y), submission order within equal keys */
   qsort(dl->cmds, (size_t)dl->count, sizeof(civ_draw_cmd_t), cmd_compare);
 
-  for (int i = 0; i < dl->count; i++) {
-    flush_one(&dl->cmds[i], r);
+  SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+  int calls = 0;
+  int i = 0;
+  while (i < dl->count) {
+    /* One call per run of commands on the same texture */
+    SDL_Texture *tex = dl->cmds[i].type == CIV_DRAW_TEXTURE ? dl->cmds[i].texture : NULL;
+    geometry_t g = {dl, 0, 0};
+    for (; i < dl->count; i++) {
+      const civ_draw_cmd_t *cmd = &dl->cmds[i];
+      int quads = quads_for(cmd);
+      if (quads == 0) continue;
+      SDL_Texture *cmd_tex = cmd->type == CIV_DRAW_TEXTURE ? cmd->texture : NULL;
+      if (cmd_tex != tex) break;
+      if (!reserve_quads(&g, quads)) continue;
+      append_cmd(&g, cmd);
+    }
+    if (g.index_count > 0) {
+      SDL_RenderGeometry(r, tex, dl->vertices, g.vertex_count, dl->indices,
+                         g.index_count);
+      calls++;
+    }
   }
 
-  dl->draw_calls_this_frame = dl->count;
+  dl->draw_calls_this_frame = calls;
+  civ_frame_trace_count(CIV_FRAME_DRAW_CALLS, (uint64_t)calls);
 }
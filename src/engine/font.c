@@ -5,6 +5,9 @@
 
 #include "engine/font.h"
 #include "engine/renderer.h"
+#include "utils/frame_trace.h"
+#include "utils/startup_timeline.h"
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -13,12 +16,54 @@
 #include <windows.h>
 #endif
 
+/* Rasterized strings live in a per-font atlas of rows one line high; rows
+   fill left to right and the least recently drawn row is evicted whole */
+#define FONT_ATLAS_SIZE    1024
+#define FONT_CACHE_SLOTS   512
+#define FONT_HASH_BUCKETS  256
+#define FONT_MAX_PENDING   16
+
+typedef struct {
+  uint64_t hash;
+  char    *text;
+  int      x, w, h;
+  int      row;   /* -1 = free slot */
+  int      next;  /* hash chain, -1 = end */
+} font_string_t;
+
+typedef struct {
+  int      used_x;
+  uint32_t last_used;
+} font_row_t;
+
 struct civ_font {
   TTF_Font *ttf_font;
   int size;
   char name[256];
+
+  /* String atlas, bound to the renderer it was created on */
+  SDL_Renderer *atlas_renderer;
+  SDL_Texture  *atlas;
+  font_row_t   *rows;
+  int           row_height;
+  int           row_count;
+  font_string_t strings[FONT_CACHE_SLOTS];
+  int           buckets[FONT_HASH_BUCKETS];
+  uint32_t      clock;
+
+  /* Quads queued since the last flush */
+  SDL_Vertex *batch;
+  int         batch_count;
+  int         batch_capacity;
+  bool        pending;
 };
 
+static bool g_batching;
+static civ_font_t *g_pending[FONT_MAX_PENDING];
+static int g_pending_count;
+
+static void atlas_release(civ_font_t *font);
+
 /* System font detection for Linux */
 static char *find_system_font_linux(const char *font_name) {
   static char font_path[512];
@@ -128,7 +173,27 @@ civ_font_t *civ_font_load(const char *path, int size) {
     return NULL;
   }
 
+  SDL_PathInfo info;
+  if (SDL_GetPathInfo(path, &info))
+    civ_startup_note_read(info.size);
+
   font->size = size;
+  font->atlas_renderer = NULL;
+  font->atlas = NULL;
+  font->rows = NULL;
+  font->row_height = 0;
+  font->row_count = 0;
+  for (int i = 0; i < FONT_CACHE_SLOTS; i++) {
+    font->strings[i].text = NULL;
+    font->strings[i].row = -1;
+  }
+  for (int b = 0; b < FONT_HASH_BUCKETS; b++)
+    font->buckets[b] = -1;
+  font->clock = 0;
+  font->batch = NULL;
+  font->batch_count = 0;
+  font->batch_capacity = 0;
+  font->pending = false;
   strncpy(font->name, path, sizeof(font->name) - 1);
   font->name[sizeof(font->name) - 1] = '\0';
 
@@ -140,40 +205,293 @@ void civ_font_destroy(civ_font_t *font) {
   if (!font)
     return;
 
+  for (int i = 0; i < g_pending_count; i++) {
+    if (g_pending[i] == font) {
+      g_pending[i] = g_pending[--g_pending_count];
+      break;
+    }
+  }
+  atlas_release(font);
+  free(font->batch);
+
   if (font->ttf_font) {
     TTF_CloseFont(font->ttf_font);
   }
   free(font);
 }
 
-void civ_font_render(SDL_Renderer *renderer, civ_font_t *font, const char *text,
-                     int x, int y, uint32_t color) {
-  if (!renderer || !font || !font->ttf_font || !text)
-    return;
+/* ── String atlas ─────────────────────────────────────────────────── */
 
+static void atlas_release(civ_font_t *font) {
+  for (int i = 0; i < FONT_CACHE_SLOTS; i++) {
+    free(font->strings[i].text);
+    font->strings[i].text = NULL;
+    font->strings[i].row = -1;
+  }
+  for (int b = 0; b < FONT_HASH_BUCKETS; b++)
+    font->buckets[b] = -1;
+  if (font->atlas)
+    SDL_DestroyTexture(font->atlas);
+  free(font->rows);
+  font->atlas = NULL;
+  font->rows = NULL;
+  font->atlas_renderer = NULL;
+  font->batch_count = 0;
+}
+
+/* Atlas for renderer, recreated if the font was last drawn on another */
+static bool atlas_bind(civ_font_t *font, SDL_Renderer *renderer) {
+  if (font->atlas && font->atlas_renderer == renderer)
+    return true;
+  atlas_release(font);
+
+  font->row_height = TTF_GetFontHeight(font->ttf_font);
+  if (font->row_height <= 0 || font->row_height > FONT_ATLAS_SIZE)
+    return false;
+  font->row_count = FONT_ATLAS_SIZE / font->row_height;
+  font->rows = (font_row_t *)calloc(font->row_count, sizeof(font_row_t));
+  font->atlas = civ_create_texture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                  SDL_TEXTUREACCESS_STATIC, FONT_ATLAS_SIZE,
+                                  FONT_ATLAS_SIZE);
+  if (!font->rows || !font->atlas) {
+    atlas_release(font);
+    return false;
+  }
+  SDL_SetTextureBlendMode(font->atlas, SDL_BLENDMODE_BLEND);
+  font->atlas_renderer = renderer;
+  return true;
+}
+
+static uint64_t hash_text(const char *text) {
+  uint64_t h = 1469598103934665603ull; /* FNV-1a */
+  for (const unsigned char *p = (const unsigned char *)text; *p; p++)
+    h = (h ^ *p) * 1099511628211ull;
+  return h;
+}
+
+static void flush_font(civ_font_t *font) {
+  if (font->batch_count > 0 && font->atlas) {
+    civ_render_flush_batch();
+    SDL_RenderGeometry(font->atlas_renderer, font->atlas, font->batch,
+                       font->batch_count, NULL, 0);
+  }
+  font->batch_count = 0;
+}
+
+/* Drop every string in row r. Queued quads may sample it, so they go out
+   first. */
+static void evict_row(civ_font_t *font, int r) {
+  flush_font(font);
+  for (int b = 0; b < FONT_HASH_BUCKETS; b++)
+    font->buckets[b] = -1;
+  for (int i = 0; i < FONT_CACHE_SLOTS; i++) {
+    font_string_t *e = &font->strings[i];
+    if (e->row == r) {
+      free(e->text);
+      e->text = NULL;
+      e->row = -1;
+    }
+    if (e->row < 0) continue;
+    int b = (int)(e->hash % FONT_HASH_BUCKETS);
+    e->next = font->buckets[b];
+    font->buckets[b] = i;
+  }
+  font->rows[r].used_x = 0;
+}
+
+/* Least recently drawn row; occupied_only skips rows holding nothing */
+static int lru_row(const civ_font_t *font, bool occupied_only) {
+  int best = -1;
+  for (int r = 0; r < font->row_count; r++) {
+    if (occupied_only && font->rows[r].used_x == 0) continue;
+    if (best < 0 || font->rows[r].last_used < font->rows[best].last_used)
+      best = r;
+  }
+  return best;
+}
+
+/* Rasterize text into the atlas once; NULL if it cannot be cached (empty,
+   wider than the atlas, or taller than a row) */
+static const font_string_t *cache_string(civ_font_t *font,
+                                         SDL_Renderer *renderer,
+                                         const char *text) {
+  if (!*text || !atlas_bind(font, renderer))
+    return NULL;
+
+  uint64_t hash = hash_text(text);
+  int b = (int)(hash % FONT_HASH_BUCKETS);
+  for (int i = font->buckets[b]; i >= 0; i = font->strings[i].next) {
+    font_string_t *e = &font->strings[i];
+    if (e->hash == hash && strcmp(e->text, text) == 0) {
+      font->rows[e->row].last_used = ++font->clock;
+      return e;
+    }
+  }
+
+  /* White glyphs; the colour is applied per vertex */
+  SDL_Color white = {255, 255, 255, 255};
+  SDL_Surface *surface =
+      TTF_RenderText_Blended(font->ttf_font, text, strlen(text), white);
+  if (!surface)
+    return NULL;
+  if (surface->format != SDL_PIXELFORMAT_ARGB8888) {
+    SDL_Surface *converted = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_ARGB8888);
+    SDL_DestroySurface(surface);
+    if (!converted)
+      return NULL;
+    surface = converted;
+  }
+  if (surface->w > FONT_ATLAS_SIZE || surface->h > font->row_height) {
+    SDL_DestroySurface(surface);
+    return NULL;
+  }
+
+  int slot = -1;
+  for (int i = 0; i < FONT_CACHE_SLOTS && slot < 0; i++)
+    if (font->strings[i].row < 0)
+      slot = i;
+  if (slot < 0) {
+    evict_row(font, lru_row(font, true));
+    for (int i = 0; i < FONT_CACHE_SLOTS && slot < 0; i++)
+      if (font->strings[i].row < 0)
+        slot = i;
+  }
+  int row = -1;
+  for (int r = 0; r < font->row_count && row < 0; r++)
+    if (font->rows[r].used_x + surface->w <= FONT_ATLAS_SIZE)
+      row = r;
+  if (row < 0) {
+    row = lru_row(font, false);
+    evict_row(font, row);
+  }
+  char *copy = strdup(text);
+  if (!copy) {
+    SDL_DestroySurface(surface);
+    return NULL;
+  }
+
+  font_string_t *e = &font->strings[slot];
+  e->hash = hash;
+  e->text = copy;
+  e->x = font->rows[row].used_x;
+  e->w = surface->w;
+  e->h = surface->h;
+  e->row = row;
+  e->next = font->buckets[b];
+  font->buckets[b] = slot;
+  font->rows[row].used_x += surface->w;
+  font->rows[row].last_used = ++font->clock;
+
+  SDL_Rect dst = {e->x, row * font->row_height, e->w, e->h};
+  SDL_UpdateTexture(font->atlas, &dst, surface->pixels, surface->pitch);
+  SDL_DestroySurface(surface);
+  return e;
+}
+
+/* Queue e's atlas rect onto the quad with corners p (top-left, top-right,
+   bottom-right, bottom-left) */
+static bool queue_corners(civ_font_t *font, const font_string_t *e,
+                          const SDL_FPoint p[4], uint32_t color, uint8_t alpha) {
+  if (font->batch_count + 6 > font->batch_capacity) {
+    int cap = font->batch_capacity ? font->batch_capacity * 2 : 384;
+    SDL_Vertex *v = (SDL_Vertex *)realloc(font->batch, cap * sizeof(SDL_Vertex));
+    if (!v)
+      return false;
+    font->batch = v;
+    font->batch_capacity = cap;
+  }
+
+  const float inv = 1.0f / FONT_ATLAS_SIZE;
+  SDL_FColor c = {((color >> 16) & 0xFF) / 255.0f, ((color >> 8) & 0xFF) / 255.0f,
+                  (color & 0xFF) / 255.0f, alpha / 255.0f};
+  float u0 = e->x * inv, v0 = e->row * font->row_height * inv;
+  float u1 = u0 + e->w * inv, v1 = v0 + e->h * inv;
+  SDL_Vertex *v = &font->batch[font->batch_count];
+  v[0] = (SDL_Vertex){p[0], c, {u0, v0}};
+  v[1] = (SDL_Vertex){p[1], c, {u1, v0}};
+  v[2] = (SDL_Vertex){p[2], c, {u1, v1}};
+  v[3] = v[0];
+  v[4] = v[2];
+  v[5] = (SDL_Vertex){p[3], c, {u0, v1}};
+  font->batch_count += 6;
+  return true;
+}
+
+static bool queue_quad(civ_font_t *font, const font_string_t *e, int x, int y,
+                       uint32_t color, uint8_t alpha) {
+  float x0 = (float)x, y0 = (float)y, x1 = x0 + e->w, y1 = y0 + e->h;
+  SDL_FPoint p[4] = {{x0, y0}, {x1, y0}, {x1, y1}, {x0, y1}};
+  return queue_corners(font, e, p, color, alpha);
+}
+
+/* A quad was queued: draw it now outside a batch, else note the font */
+static void settle_queued(civ_font_t *font) {
+  if (!g_batching) {
+    flush_font(font);
+  } else if (!font->pending) {
+    if (g_pending_count == FONT_MAX_PENDING) {
+      flush_font(font);
+      return;
+    }
+    font->pending = true;
+    g_pending[g_pending_count++] = font;
+  }
+}
+
+/* Draw through the atlas: queued while a batch is open, else at once */
+static bool draw_cached(SDL_Renderer *renderer, civ_font_t *font,
+                        const char *text, int x, int y, uint32_t color,
+                        uint8_t alpha) {
+  const font_string_t *e = cache_string(font, renderer, text);
+  if (!e || !queue_quad(font, e, x, y, color, alpha))
+    return false;
+  settle_queued(font);
+  return true;
+}
+
+/* Uncached path: one surface and texture for this call */
+static void draw_direct(SDL_Renderer *renderer, civ_font_t *font,
+                        const char *text, int x, int y, uint32_t color,
+                        uint8_t alpha) {
   SDL_Color c = civ_color_from_rgb(color);
+  c.a = alpha;
   SDL_Surface *surface =
       TTF_RenderText_Blended(font->ttf_font, text, strlen(text), c);
   if (!surface)
     return;
 
-  SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+  SDL_Texture *texture = civ_create_texture_from_surface(renderer, surface);
   SDL_DestroySurface(surface);
-
   if (!texture)
     return;
 
+  civ_render_flush_batch();
   float w_f, h_f;
   SDL_GetTextureSize(texture, &w_f, &h_f);
-  int w = (int)w_f;
-  int h = (int)h_f;
-
-  SDL_FRect dest = {(float)x, (float)y, (float)w, (float)h};
+  SDL_FRect dest = {(float)x, (float)y, w_f, h_f};
   SDL_RenderTexture(renderer, texture, NULL, &dest);
-
   SDL_DestroyTexture(texture);
 }
 
+void civ_font_begin_batch(void) { g_batching = true; }
+
+void civ_font_end_batch(void) {
+  for (int i = 0; i < g_pending_count; i++) {
+    flush_font(g_pending[i]);
+    g_pending[i]->pending = false;
+  }
+  g_pending_count = 0;
+  g_batching = false;
+}
+
+void civ_font_render(SDL_Renderer *renderer, civ_font_t *font, const char *text,
+                     int x, int y, uint32_t color) {
+  if (!renderer || !font || !font->ttf_font || !text)
+    return;
+  if (!draw_cached(renderer, font, text, x, y, color, 255))
+    draw_direct(renderer, font, text, x, y, color, 255);
+}
+
 void civ_font_render_aligned(SDL_Renderer *renderer, civ_font_t *font,
                              const char *text, int x, int y, int w, int h,
                              uint32_t color, civ_text_align_t align,
@@ -182,7 +500,14 @@ void civ_font_render_aligned(SDL_Renderer *renderer, civ_font_t *font,
     return;
 
   int text_w, text_h;
-  civ_font_get_text_size(font, text, &text_w, &text_h);
+  const font_string_t *e =
+      font->ttf_font ? cache_string(font, renderer, text) : NULL;
+  if (e) {
+    text_w = e->w;
+    text_h = e->h;
+  } else {
+    civ_font_get_text_size(font, text, &text_w, &text_h);
+  }
 
   /* Calculate position based on alignment */
   int pos_x = x;
@@ -220,31 +545,30 @@ void civ_font_render_alpha(SDL_Renderer *renderer, civ_font_t *font,
                            uint8_t alpha) {
   if (!renderer || !font || !font->ttf_font || !text)
     return;
+  if (!draw_cached(renderer, font, text, x, y, color, alpha))
+    draw_direct(renderer, font, text, x, y, color, alpha);
+}
 
-  SDL_Color c = civ_color_from_rgb(color);
-  c.a = alpha;
-
-  SDL_Surface *surface =
-      TTF_RenderText_Blended(font->ttf_font, text, strlen(text), c);
-  if (!surface)
+void civ_font_render_transformed(SDL_Renderer *renderer, civ_font_t *font,
+                                 const char *text, float cx, float cy,
+                                 float scale, float angle, uint32_t color,
+                                 uint8_t alpha) {
+  if (!renderer || !font || !font->ttf_font || !text)
     return;
-
-  SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
-  SDL_DestroySurface(surface);
-
-  if (!texture)
+  const font_string_t *e = cache_string(font, renderer, text);
+  if (!e)
     return;
-
-  float w_f, h_f;
-  SDL_GetTextureSize(texture, &w_f, &h_f);
-  int w = (int)w_f;
-  int h = (int)h_f;
-  SDL_SetTextureAlphaMod(texture, alpha);
-
-  SDL_FRect dest = {(float)x, (float)y, (float)w, (float)h};
-  SDL_RenderTexture(renderer, texture, NULL, &dest);
-
-  SDL_DestroyTexture(texture);
+  float hw = e->w * 0.5f * scale, hh = e->h * 0.5f * scale;
+  float c = cosf(angle), s = sinf(angle);
+  /* Corners (+-hw, +-hh) rotated about the centre */
+  SDL_FPoint p[4] = {
+      {cx - hw * c + hh * s, cy - hw * s - hh * c},
+      {cx + hw * c + hh * s, cy + hw * s - hh * c},
+      {cx + hw * c - hh * s, cy + hw * s + hh * c},
+      {cx - hw * c - hh * s, cy - hw * s + hh * c},
+  };
+  if (queue_corners(font, e, p, color, alpha))
+    settle_queued(font);
 }
 
 void civ_font_get_text_size(civ_font_t *font, const char *text, int *w,
@@ -0,0 +1,152 @@
+/**
+ * @file frame_pacer.c
+ * @brief Render-on-demand frame pacing implementation
+ */
+
+#include "engine/frame_pacer.h"
+#include <string.h>
+
+typedef struct {
+  civ_idle_task_fn_t fn;
+  void *user_data;
+} idle_task_t;
+
+static struct {
+  Uint64 target_ns;     /* active frame time */
+  Uint64 frame_start;
+  Uint64 frame_due;     /* when the current iteration should end */
+  Uint64 last_activity;
+  Uint64 last_present;
+  bool vsync;
+  bool presenting;      /* current iteration renders */
+  bool redraw_requested;
+  bool idle_work_pending;
+  bool has_presented;
+  idle_task_t tasks[CIV_FRAME_PACER_MAX_TASKS];
+  int task_count;
+  int next_task;        /* round-robin start */
+  civ_frame_pacer_stats_t stats;
+} g_pacer = {.target_ns = 1000000000ull / CIV_FRAME_PACER_DEFAULT_HZ};
+
+void civ_frame_pacer_init(int target_hz, bool vsync) {
+  int tasks = g_pacer.task_count;
+  idle_task_t saved[CIV_FRAME_PACER_MAX_TASKS];
+  memcpy(saved, g_pacer.tasks, sizeof(saved));
+
+  memset(&g_pacer, 0, sizeof(g_pacer));
+  if (target_hz <= 0) target_hz = CIV_FRAME_PACER_DEFAULT_HZ;
+  g_pacer.target_ns = 1000000000ull / (Uint64)target_hz;
+  g_pacer.vsync = vsync;
+  g_pacer.frame_start = SDL_GetTicksNS();
+  g_pacer.frame_due = g_pacer.frame_start + g_pacer.target_ns;
+  g_pacer.last_activity = g_pacer.frame_start;
+
+  /* Tasks registered before init survive it */
+  memcpy(g_pacer.tasks, saved, sizeof(saved));
+  g_pacer.task_count = tasks;
+}
+
+void civ_frame_pacer_begin_frame(void) {
+  g_pacer.frame_start = SDL_GetTicksNS();
+  g_pacer.frame_due = g_pacer.frame_start + g_pacer.target_ns;
+}
+
+void civ_frame_pacer_note_activity(void) {
+  g_pacer.last_activity = SDL_GetTicksNS();
+}
+
+void civ_frame_request_redraw(void) { g_pacer.redraw_requested = true; }
+
+bool civ_frame_pacer_should_present(void) {
+  Uint64 now = SDL_GetTicksNS();
+  bool present =
+      g_pacer.redraw_requested || !g_pacer.has_presented ||
+      now - g_pacer.last_activity < CIV_FRAME_PACER_GRACE_NS ||
+      now - g_pacer.last_present >= 1000000000ull / CIV_FRAME_PACER_REFRESH_HZ;
+  g_pacer.redraw_requested = false;
+  g_pacer.presenting = present;
+
+  if (present) {
+    g_pacer.last_present = now;
+    g_pacer.has_presented = true;
+    g_pacer.stats.frames_presented++;
+  } else {
+    /* Idle: poll slowly, unless background work wants the time */
+    g_pacer.stats.frames_skipped++;
+    if (!g_pacer.idle_work_pending)
+      g_pacer.frame_due =
+          g_pacer.frame_start + 1000000000ull / CIV_FRAME_PACER_POLL_HZ;
+  }
+  return present;
+}
+
+Uint64 civ_frame_pacer_budget_ns(void) {
+  Uint64 now = SDL_GetTicksNS();
+  return now < g_pacer.frame_due ? g_pacer.frame_due - now : 0;
+}
+
+bool civ_frame_pacer_add_idle_task(civ_idle_task_fn_t fn, void *user_data) {
+  if (!fn || g_pacer.task_count >= CIV_FRAME_PACER_MAX_TASKS)
+    return false;
+  g_pacer.tasks[g_pacer.task_count++] = (idle_task_t){fn, user_data};
+  g_pacer.idle_work_pending = true;
+  return true;
+}
+
+void civ_frame_pacer_remove_idle_task(civ_idle_task_fn_t fn, void *user_data) {
+  for (int i = 0; i < g_pacer.task_count; i++) {
+    if (g_pacer.tasks[i].fn != fn || g_pacer.tasks[i].user_data != user_data)
+      continue;
+    memmove(&g_pacer.tasks[i], &g_pacer.tasks[i + 1],
+            (size_t)(g_pacer.task_count - i - 1) * sizeof(idle_task_t));
+    g_pacer.task_count--;
+    break;
+  }
+  if (g_pacer.next_task >= g_pacer.task_count) g_pacer.next_task = 0;
+}
+
+/* Each task gets one call per iteration with the shared deadline, starting
+   after the one that ran first last time so no task starves the rest */
+void civ_frame_pacer_run_idle_tasks(void) {
+  int n = g_pacer.task_count;
+  if (n == 0) {
+    g_pacer.idle_work_pending = false;
+    return;
+  }
+
+  Uint64 start = SDL_GetTicksNS();
+  bool pending = false;
+  int first = g_pacer.next_task % n;
+  for (int i = 0; i < n; i++) {
+    if (SDL_GetTicksNS() >= g_pacer.frame_due) {
+      pending = true;
+      break;
+    }
+    idle_task_t t = g_pacer.tasks[(first + i) % n];
+    if (t.fn(t.user_data, g_pacer.frame_due)) pending = true;
+    if (g_pacer.task_count != n) break; /* a task removed itself */
+  }
+  g_pacer.next_task = g_pacer.task_count ? (first + 1) % g_pacer.task_count : 0;
+  g_pacer.idle_work_pending = pending;
+  g_pacer.stats.idle_task_ns += SDL_GetTicksNS() - start;
+}
+
+void civ_frame_pacer_wait(void) {
+  Uint64 now = SDL_GetTicksNS();
+  if (now >= g_pacer.frame_due)
+    return;
+  Uint64 left = g_pacer.frame_due - now;
+
+  if (!g_pacer.presenting) {
+    /* Idle: sleep on the event queue so input wakes the loop at once */
+    SDL_WaitEventTimeout(NULL, (Sint32)((left + 999999) / 1000000));
+    return;
+  }
+  /* Presenting under VSync already waited for the display */
+  if (!g_pacer.vsync)
+    SDL_DelayPrecise(left);
+}
+
+void civ_frame_pacer_get_stats(civ_frame_pacer_stats_t *out) {
+  if (out) *out = g_pacer.stats;
+}
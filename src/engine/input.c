@@ -32,8 +32,11 @@ void civ_input_process_event(civ_input_state_t *state, const SDL_Event *event) {
     break;
 
   case SDL_EVENT_MOUSE_MOTION:
+    /* Coalesced: the frame sees one position and one pan delta */
     state->mouse_x = (int)event->motion.x;
     state->mouse_y = (int)event->motion.y;
+    state->delta_x = state->mouse_x - state->last_mouse_x;
+    state->delta_y = state->mouse_y - state->last_mouse_y;
     break;
 
   case SDL_EVENT_MOUSE_BUTTON_DOWN:
@@ -66,7 +69,7 @@ void civ_input_process_event(civ_input_state_t *state, const SDL_Event *event) {
     break;
 
   case SDL_EVENT_MOUSE_WHEEL:
-    state->scroll_delta = event->wheel.y;
+    state->scroll_delta += event->wheel.y;
     break;
 
   case SDL_EVENT_TEXT_INPUT:
@@ -113,10 +116,6 @@ void civ_input_end_frame(civ_input_state_t *state) {
   if (!state)
     return;
 
-  /* Calculate deltas based on all events processed this frame */
-  state->delta_x = state->mouse_x - state->last_mouse_x;
-  state->delta_y = state->mouse_y - state->last_mouse_y;
-
   /* Store previous frame mouse position */
   state->last_mouse_x = state->mouse_x;
   state->last_mouse_y = state->mouse_y;
@@ -127,6 +126,8 @@ bool civ_input_is_mouse_over(const civ_input_state_t *state, int x, int y,
   if (!state)
     return false;
 
+  if (state->hit_routed && state->hit_top != state->hit_layer)
+    return false;
   return (state->mouse_x >= x && state->mouse_x <= x + w &&
           state->mouse_y >= y && state->mouse_y <= y + h);
 }
@@ -0,0 +1,253 @@
+/**
+ * @file map_shader.c
+ * @brief Attribute texture upload and custom render state for the map
+ */
+
+#include "engine/map_shader.h"
+#include "utils/paths.h"
+#include "utils/frame_trace.h"
+#include "utils/startup_timeline.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef SDL_VERSION_ATLEAST
+#if SDL_VERSION_ATLEAST(3, 4, 0)
+#define CIV_MAP_SHADER_GPU 1
+#endif
+#endif
+
+/* Flag bits in the alpha channel of the upper half; must match the shader */
+#define ATTR_EXPLORED 0x01
+#define ATTR_VISIBLE  0x02
+#define ATTR_WATER    0x04
+#define ATTR_RIVER    0x08  /* river above sea level */
+#define ATTR_COLORED  0x10  /* political colour set */
+
+/* std140 layout of the shader's MapView block */
+typedef struct {
+  float screen[2];
+  float view[2];
+  float map_size[2];
+  float scale;
+  int32_t view_type;
+} map_view_uniforms_t;
+
+typedef struct {
+  uint32_t revision;
+  bool uploaded;
+} attr_region_t;
+
+struct civ_map_shader {
+#if CIV_MAP_SHADER_GPU
+  SDL_GPUDevice *device;
+  SDL_GPUShader *fragment;
+  SDL_GPURenderState *state;
+#endif
+  SDL_Texture *attributes;  /* map_width x 2 * map_height */
+  attr_region_t *regions;
+  int region_cols, region_rows;
+  uint32_t map_serial;
+  const civ_resource_map_t *resources;
+  uint8_t *scratch;         /* one region, RGBA */
+  int map_width, map_height;
+};
+
+/* Bands of resource_heat_color in renderer.c */
+static uint8_t resource_band(uint16_t total) {
+  static const uint16_t limits[] = {1, 50, 200, 800, 3000, 10000};
+  uint8_t band = 0;
+  while (band < 6 && total >= limits[band]) band++;
+  return band;
+}
+
+static uint8_t unit_byte(float v) {
+  return v <= 0.0f ? 0 : v >= 1.0f ? 255 : (uint8_t)(v * 255.0f + 0.5f);
+}
+
+/* Pack one region into scratch and upload both halves of it */
+static bool upload_region(civ_map_shader_t *s, const civ_map_t *map,
+                          const civ_resource_map_t *rm, int rx, int ry) {
+  int x0 = rx * CIV_MAP_REGION_SIZE, y0 = ry * CIV_MAP_REGION_SIZE;
+  int w = MIN(CIV_MAP_REGION_SIZE, map->width - x0);
+  int h = MIN(CIV_MAP_REGION_SIZE, map->height - y0);
+
+  for (int y = 0; y < h; y++) {
+    uint8_t *px = &s->scratch[(size_t)y * w * 4];
+    const civ_map_tile_t *t = &map->tiles[(size_t)(y0 + y) * map->width + x0];
+    for (int x = 0; x < w; x++, t++, px += 4) {
+      uint8_t flags = 0;
+      if (t->is_explored) flags |= ATTR_EXPLORED;
+      if (t->is_visible) flags |= ATTR_VISIBLE;
+      if (t->land_use == CIV_LAND_USE_WATER) flags |= ATTR_WATER;
+      if (t->has_river && civ_tile_elevation(t) >= map->sea_level) flags |= ATTR_RIVER;
+      if (t->political_color != 0) flags |= ATTR_COLORED;
+      px[0] = unit_byte(civ_tile_elevation(t));
+      px[1] = t->population_density; /* already unorm8 */
+      px[2] = unit_byte((float)t->cultural_influence);
+      px[3] = flags;
+    }
+  }
+  SDL_Rect rect = {x0, y0, w, h};
+  if (!SDL_UpdateTexture(s->attributes, &rect, s->scratch, w * 4)) return false;
+
+  for (int y = 0; y < h; y++) {
+    uint8_t *px = &s->scratch[(size_t)y * w * 4];
+    const civ_map_tile_t *t = &map->tiles[(size_t)(y0 + y) * map->width + x0];
+    for (int x = 0; x < w; x++, t++, px += 4) {
+      uint16_t total = rm ? civ_resource_map_total_at_tile(rm, x0 + x, y0 + y) : 0;
+      px[0] = (t->political_color >> 16) & 0xFF;
+      px[1] = (t->political_color >> 8) & 0xFF;
+      px[2] = t->political_color & 0xFF;
+      px[3] = resource_band(total);
+    }
+  }
+  rect.y += map->height;
+  return SDL_UpdateTexture(s->attributes, &rect, s->scratch, w * 4);
+}
+
+/* Re-upload every region whose revision moved since it was uploaded */
+static bool sync_attributes(civ_map_shader_t *s, const civ_map_t *map,
+                            const civ_resource_map_t *rm) {
+  if (map->width != s->map_width || map->height != s->map_height ||
+      !map->region_revision || map->region_cols != s->region_cols ||
+      map->region_rows != s->region_rows)
+    return false;
+
+  int n = s->region_cols * s->region_rows;
+  if (s->map_serial != map->serial || s->resources != rm) {
+    for (int r = 0; r < n; r++) s->regions[r].uploaded = false;
+    s->map_serial = map->serial;
+    s->resources = rm;
+  }
+  for (int ry = 0; ry < s->region_rows; ry++) {
+    for (int rx = 0; rx < s->region_cols; rx++) {
+      attr_region_t *r = &s->regions[ry * s->region_cols + rx];
+      uint32_t rev = civ_map_region_revision(map, rx, ry);
+      if (r->uploaded && r->revision == rev) continue;
+      if (!upload_region(s, map, rm, rx, ry)) return false;
+      r->revision = rev;
+      r->uploaded = true;
+    }
+  }
+  return true;
+}
+
+#if CIV_MAP_SHADER_GPU
+static SDL_GPUShader *load_fragment_shader(SDL_GPUDevice *device) {
+  if (!(SDL_GetGPUShaderFormats(device) & SDL_GPU_SHADERFORMAT_SPIRV))
+    return NULL;
+
+  char path[512];
+  civ_path_resolve(CIV_MAP_SHADER_PATH, path, sizeof(path));
+  size_t code_size = 0;
+  void *code = SDL_LoadFile(path, &code_size);
+  if (!code) return NULL; /* not built: `make shaders` */
+  civ_startup_note_read(code_size);
+
+  SDL_GPUShaderCreateInfo info;
+  SDL_zero(info);
+  info.code_size = code_size;
+  info.code = (const Uint8 *)code;
+  info.entrypoint = "main";
+  info.format = SDL_GPU_SHADERFORMAT_SPIRV;
+  info.stage = SDL_GPU_SHADERSTAGE_FRAGMENT;
+  info.num_samplers = 1;
+  info.num_uniform_buffers = 1;
+  SDL_GPUShader *shader = SDL_CreateGPUShader(device, &info);
+  if (!shader)
+    fprintf(stderr, "Map shader rejected: %s\n", SDL_GetError());
+  SDL_free(code);
+  return shader;
+}
+#endif
+
+civ_map_shader_t *civ_map_shader_create(SDL_Renderer *renderer, int map_width,
+                                        int map_height) {
+#if CIV_MAP_SHADER_GPU
+  if (!renderer || map_width <= 0 || map_height <= 0)
+    return NULL;
+
+  SDL_GPUDevice *device = (SDL_GPUDevice *)SDL_GetPointerProperty(
+      SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_GPU_DEVICE_POINTER,
+      NULL);
+  if (!device)
+    return NULL; /* not the gpu render driver */
+
+  civ_map_shader_t *s = (civ_map_shader_t *)calloc(1, sizeof(civ_map_shader_t));
+  if (!s)
+    return NULL;
+  s->device = device;
+  s->map_width = map_width;
+  s->map_height = map_height;
+  s->region_cols = (map_width + CIV_MAP_REGION_SIZE - 1) >> CIV_MAP_REGION_SHIFT;
+  s->region_rows = (map_height + CIV_MAP_REGION_SIZE - 1) >> CIV_MAP_REGION_SHIFT;
+  s->regions = (attr_region_t *)calloc((size_t)s->region_cols * s->region_rows,
+                                       sizeof(attr_region_t));
+  s->scratch = (uint8_t *)malloc((size_t)CIV_MAP_REGION_SIZE *
+                                 CIV_MAP_REGION_SIZE * 4);
+  s->fragment = load_fragment_shader(device);
+  if (s->fragment) {
+    SDL_GPURenderStateCreateInfo info;
+    SDL_zero(info);
+    info.fragment_shader = s->fragment;
+    s->state = SDL_CreateGPURenderState(renderer, &info);
+  }
+  s->attributes = civ_create_texture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                    SDL_TEXTUREACCESS_STATIC, map_width,
+                                    2 * map_height);
+  if (!s->regions || !s->scratch || !s->state || !s->attributes) {
+    civ_map_shader_destroy(s);
+    return NULL;
+  }
+  SDL_SetTextureScaleMode(s->attributes, SDL_SCALEMODE_NEAREST);
+  printf("Map colouring on the GPU (%s)\n", CIV_MAP_SHADER_PATH);
+  return s;
+#else
+  (void)renderer;
+  (void)map_width;
+  (void)map_height;
+  return NULL;
+#endif
+}
+
+void civ_map_shader_destroy(civ_map_shader_t *s) {
+  if (!s)
+    return;
+#if CIV_MAP_SHADER_GPU
+  if (s->state) SDL_DestroyGPURenderState(s->state);
+  if (s->fragment) SDL_ReleaseGPUShader(s->device, s->fragment);
+#endif
+  if (s->attributes) SDL_DestroyTexture(s->attributes);
+  free(s->regions);
+  free(s->scratch);
+  free(s);
+}
+
+bool civ_map_shader_draw(civ_map_shader_t *s, SDL_Renderer *renderer,
+                         const civ_map_t *map, const civ_resource_map_t *rm,
+                         civ_map_view_type_t view, float view_x, float view_y,
+                         float scale, int fb_width, int fb_height) {
+#if CIV_MAP_SHADER_GPU
+  if (!s || !renderer || !map || !map->tiles || !sync_attributes(s, map, rm))
+    return false;
+
+  map_view_uniforms_t u = {{(float)fb_width, (float)fb_height},
+                           {view_x, view_y},
+                           {(float)map->width, (float)map->height},
+                           scale,
+                           (int32_t)view};
+  if (!SDL_SetGPURenderStateFragmentUniforms(s->state, 0, &u, sizeof(u)) ||
+      !SDL_SetGPURenderState(renderer, s->state))
+    return false;
+  SDL_FRect dst = {0, 0, (float)fb_width, (float)fb_height};
+  bool drawn = SDL_RenderTexture(renderer, s->attributes, NULL, &dst);
+  SDL_SetGPURenderState(renderer, NULL);
+  civ_frame_trace_count(CIV_FRAME_RENDER_PASSES, 1);
+  return drawn;
+#else
+  (void)s; (void)renderer; (void)map; (void)rm; (void)view;
+  (void)view_x; (void)view_y; (void)scale; (void)fb_width; (void)fb_height;
+  return false;
+#endif
+}
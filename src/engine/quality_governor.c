@@ -0,0 +1,100 @@
+/**
+ * @file quality_governor.c
+ * @brief Budget-driven quality knobs with hysteresis
+ */
+
+#include "engine/quality_governor.h"
+#include <SDL3/SDL.h>
+#include <string.h>
+
+typedef struct {
+  const char *name;
+  civ_quality_budget_t budget;
+  float full, reduced;
+  int steps;
+} knob_def_t;
+
+static const knob_def_t g_knobs[CIV_QUALITY_KNOB_COUNT] = {
+#define CIV_QUALITY_KNOB_DEF(id, name, budget, full, reduced, steps)           \
+  {name, CIV_QUALITY_BUDGET_##budget, full, reduced, steps},
+    CIV_QUALITY_KNOBS(CIV_QUALITY_KNOB_DEF)
+#undef CIV_QUALITY_KNOB_DEF
+};
+
+typedef struct {
+  double target_ms;  /* 0 = not governed */
+  double ema_ms;
+  bool   primed;     /* ema holds a sample */
+  int    over;       /* consecutive samples past the over ratio */
+  int    under;      /* consecutive samples under the under ratio */
+} budget_state_t;
+
+static struct {
+  budget_state_t budgets[CIV_QUALITY_BUDGET_COUNT];
+  SDL_AtomicInt levels[CIV_QUALITY_KNOB_COUNT];
+} g_governor;
+
+void civ_quality_governor_init(double frame_target_ms, double tick_target_ms) {
+  memset(&g_governor.budgets, 0, sizeof(g_governor.budgets));
+  g_governor.budgets[CIV_QUALITY_BUDGET_FRAME].target_ms =
+      frame_target_ms > 0.0 ? frame_target_ms : 0.0;
+  g_governor.budgets[CIV_QUALITY_BUDGET_TICK].target_ms =
+      frame_target_ms > 0.0 && tick_target_ms > 0.0 ? tick_target_ms : 0.0;
+  for (int k = 0; k < CIV_QUALITY_KNOB_COUNT; k++)
+    SDL_SetAtomicInt(&g_governor.levels[k], 0);
+}
+
+/* Step a knob of budget by dir; false when every knob is at its bound */
+static bool step_knob(civ_quality_budget_t budget, int dir) {
+  /* Degrade in table order, restore in reverse */
+  for (int i = 0; i < CIV_QUALITY_KNOB_COUNT; i++) {
+    int k = dir > 0 ? i : CIV_QUALITY_KNOB_COUNT - 1 - i;
+    if (g_knobs[k].budget != budget) continue;
+    int level = SDL_GetAtomicInt(&g_governor.levels[k]);
+    if ((dir > 0 && level >= g_knobs[k].steps) || (dir < 0 && level <= 0))
+      continue;
+    SDL_SetAtomicInt(&g_governor.levels[k], level + dir);
+    return true;
+  }
+  return false;
+}
+
+void civ_quality_governor_sample(civ_quality_budget_t budget, double ms) {
+  if (budget < 0 || budget >= CIV_QUALITY_BUDGET_COUNT) return;
+  budget_state_t *b = &g_governor.budgets[budget];
+  if (b->target_ms <= 0.0 || ms < 0.0) return;
+
+  b->ema_ms = b->primed ? b->ema_ms + (ms - b->ema_ms) * CIV_QUALITY_EMA_ALPHA
+                        : ms;
+  b->primed = true;
+
+  /* Between the two ratios is a dead band that resets both counts */
+  bool over = b->ema_ms > b->target_ms * CIV_QUALITY_OVER_RATIO;
+  bool under = b->ema_ms < b->target_ms * CIV_QUALITY_UNDER_RATIO;
+  b->over = over ? b->over + 1 : 0;
+  b->under = under ? b->under + 1 : 0;
+  if (b->over >= CIV_QUALITY_DEGRADE_SAMPLES)
+    step_knob(budget, 1);
+  else if (b->under >= CIV_QUALITY_RESTORE_SAMPLES)
+    step_knob(budget, -1);
+  else
+    return;
+  b->over = b->under = 0; /* let the step show before judging again */
+}
+
+float civ_quality_governor_value(civ_quality_knob_t knob) {
+  if (knob < 0 || knob >= CIV_QUALITY_KNOB_COUNT) return 0.0f;
+  const knob_def_t *d = &g_knobs[knob];
+  float t = (float)SDL_GetAtomicInt(&g_governor.levels[knob]) / (float)d->steps;
+  return d->full + (d->reduced - d->full) * t;
+}
+
+int civ_quality_governor_level(civ_quality_knob_t knob) {
+  if (knob < 0 || knob >= CIV_QUALITY_KNOB_COUNT) return 0;
+  return SDL_GetAtomicInt(&g_governor.levels[knob]);
+}
+
+const char *civ_quality_governor_knob_name(civ_quality_knob_t knob) {
+  if (knob < 0 || knob >= CIV_QUALITY_KNOB_COUNT) return "?";
+  return g_knobs[knob].name;
+}
@@ -4,10 +4,44 @@
  */
 
 #include "engine/renderer.h"
+#include "core/simulation_engine/worker_pool.h"
 #include "utils/noise.h"
+#include "utils/frame_trace.h"
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CIV_RENDER_AVX2 1
+#endif
+
+/* Open batch: shape helpers drawing on g_batch_renderer append here */
+static civ_draw_list_t g_batch;
+static SDL_Renderer *g_batch_renderer;
+
+void civ_render_begin_batch(SDL_Renderer *renderer) {
+  if (!g_batch.cmds) {
+    civ_draw_list_init(&g_batch, 0);
+    g_batch.sort_by_y = false;
+  }
+  g_batch_renderer = renderer;
+}
+
+void civ_render_flush_batch(void) {
+  if (!g_batch_renderer || g_batch.count == 0)
+    return;
+  civ_draw_list_flush(&g_batch, g_batch_renderer);
+  civ_draw_list_clear(&g_batch);
+}
+
+void civ_render_end_batch(void) {
+  civ_render_flush_batch();
+  g_batch_renderer = NULL;
+}
+
+int civ_render_batch_draw_calls(void) { return g_batch.draw_calls_this_frame; }
 
 SDL_Color civ_color_from_rgb(uint32_t color) {
   SDL_Color c;
@@ -27,6 +61,11 @@ void civ_render_rect_filled_alpha(SDL_Renderer *renderer, int x, int y, int w,
                                   int h, uint32_t color, uint8_t alpha) {
   if (!renderer)
     return;
+  if (renderer == g_batch_renderer) {
+    civ_draw_rect_filled(&g_batch, (float)x, (float)y, (float)w, (float)h,
+                         color, alpha, 0);
+    return;
+  }
 
   SDL_Color c = civ_color_from_rgb(color);
   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
@@ -40,6 +79,11 @@ void civ_render_rect_outline(SDL_Renderer *renderer, int x, int y, int w, int h,
                              uint32_t color, int thickness) {
   if (!renderer)
     return;
+  if (renderer == g_batch_renderer) {
+    civ_draw_rect_outline(&g_batch, (float)x, (float)y, (float)w, (float)h,
+                          color, thickness, 0);
+    return;
+  }
 
   SDL_Color c = civ_color_from_rgb(color);
   SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
@@ -56,41 +100,27 @@ void civ_render_rounded_rect(SDL_Renderer *renderer, int x, int y, int w, int h,
   if (!renderer)
     return;
 
-  SDL_Color c = civ_color_from_rgb(color);
-  SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
-
-  /* Simple approximation: draw main rect + circles at corners */
-  SDL_FRect main_rect = {(float)(x + radius), (float)y, (float)(w - 2 * radius),
-                         (float)h};
-  SDL_RenderFillRect(renderer, &main_rect);
-
-  SDL_FRect left_rect = {(float)x, (float)(y + radius), (float)radius,
-                         (float)(h - 2 * radius)};
-  SDL_RenderFillRect(renderer, &left_rect);
-
-  SDL_FRect right_rect = {(float)(x + w - radius), (float)(y + radius),
-                          (float)radius, (float)(h - 2 * radius)};
-  SDL_RenderFillRect(renderer, &right_rect);
-
-  /* For simplicity, skip rounded corners - just use sharp corners for now */
-  SDL_FRect tl = {(float)x, (float)y, (float)radius, (float)radius};
-  SDL_FRect tr = {(float)(x + w - radius), (float)y, (float)radius,
-                  (float)radius};
-  SDL_FRect bl = {(float)x, (float)(y + h - radius), (float)radius,
-                  (float)radius};
-  SDL_FRect br = {(float)(x + w - radius), (float)(y + h - radius),
-                  (float)radius, (float)radius};
-
-  SDL_RenderFillRect(renderer, &tl);
-  SDL_RenderFillRect(renderer, &tr);
-  SDL_RenderFillRect(renderer, &bl);
-  SDL_RenderFillRect(renderer, &br);
+  /* Simple approximation: main rect + side rects; corners are left sharp,
+     so together they cover the whole box */
+  civ_render_rect_filled(renderer, x + radius, y, w - 2 * radius, h, color);
+  civ_render_rect_filled(renderer, x, y + radius, radius, h - 2 * radius, color);
+  civ_render_rect_filled(renderer, x + w - radius, y + radius, radius,
+                         h - 2 * radius, color);
+  civ_render_rect_filled(renderer, x, y, radius, radius, color);
+  civ_render_rect_filled(renderer, x + w - radius, y, radius, radius, color);
+  civ_render_rect_filled(renderer, x, y + h - radius, radius, radius, color);
+  civ_render_rect_filled(renderer, x + w - radius, y + h - radius, radius,
+                         radius, color);
 }
 
 void civ_render_line(SDL_Renderer *renderer, int x1, int y1, int x2, int y2,
                      uint32_t color) {
   if (!renderer)
     return;
+  if (renderer == g_batch_renderer) {
+    civ_draw_line(&g_batch, (float)x1, (float)y1, (float)x2, (float)y2, color, 0);
+    return;
+  }
 
   SDL_Color c = civ_color_from_rgb(color);
   SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
@@ -124,9 +154,8 @@ void civ_render_gradient_vertical(SDL_Renderer *renderer, int x, int y, int w,
     uint8_t g = (uint8_t)(c_top.g + (c_bot.g - c_top.g) * t);
     uint8_t b = (uint8_t)(c_top.b + (c_bot.b - c_top.b) * t);
 
-    SDL_SetRenderDrawColor(renderer, r, g, b, 255);
-    SDL_RenderLine(renderer, (float)x, (float)(y + i), (float)(x + w),
-                   (float)(y + i));
+    civ_render_line(renderer, x, y + i, x + w, y + i,
+                    ((uint32_t)r << 16) | ((uint32_t)g << 8) | b);
   }
 }
 
@@ -138,6 +167,8 @@ void civ_render_set_alpha(SDL_Renderer *renderer, uint8_t alpha) {
 
 /* Map rendering context */
 
+static void build_color_luts(void);
+
 civ_render_map_context_t *
 civ_render_map_context_create(SDL_Renderer *renderer, int fb_width,
                               int fb_height, int map_width, int map_height) {
@@ -167,7 +198,7 @@ civ_render_map_context_create(SDL_Renderer *renderer, int fb_width,
 
   /* Create streaming texture */
   ctx->map_texture =
-      SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+      civ_create_texture(renderer, SDL_PIXELFORMAT_ARGB8888,
                         SDL_TEXTUREACCESS_STREAMING, fb_width, fb_height);
   if (!ctx->map_texture) {
     free(ctx->pixel_buffer);
@@ -175,26 +206,103 @@ civ_render_map_context_create(SDL_Renderer *renderer, int fb_width,
     return NULL;
   }
 
-  /* LOD buffers — allocated lazily by civ_render_map_build_lods */
-  ctx->lods_built = false;
-  ctx->lod_buffer_512 = NULL;
-  ctx->lod_buffer_256 = NULL;
-  ctx->lod_texture_512 = NULL;
-  ctx->lod_texture_256 = NULL;
-
+  /* LOD pyramids — allocated per view on first zoom-out */
+  for (int v = 0; v < CIV_MAP_VIEW_COUNT; v++)
+    ctx->lods[v] = NULL;
+
+  /* Chunks — allocated per view on first draw */
+  for (int v = 0; v < CIV_MAP_VIEW_COUNT; v++)
+    ctx->chunks[v] = NULL;
+  ctx->chunk_cols = 0;
+  ctx->chunk_rows = 0;
+  ctx->chunk_map_serial = 0;
+  ctx->chunk_resources = NULL;
+  ctx->chunk_pixels = NULL;
+  ctx->border_chunks = NULL;
+  ctx->border_vertices = NULL;
+  ctx->border_vertices_capacity = 0;
+  ctx->entity_indices = NULL;
+  ctx->entity_capacity = 0;
+  ctx->markers = NULL;
+  ctx->marker_capacity = 0;
+  ctx->clusters = NULL;
+  ctx->cluster_capacity = 0;
+  ctx->minimap_texture = NULL;
+  ctx->minimap_pixels = NULL;
+  ctx->minimap_width = 0;
+  ctx->minimap_height = 0;
+  ctx->minimap_revision = 0;
+  ctx->minimap_sampled_ns = 0;
+  ctx->minimap_valid = false;
+  ctx->lod_bias = 0.0f;
+  ctx->cluster_min_px = CIV_RENDER_CLUSTER_MIN_PX;
+  ctx->border_refresh_ns = 0;
+  ctx->minimap_refresh_ns = 0;
+
+  ctx->raster_span_x = NULL;
+  ctx->raster_col_span = NULL;
+  ctx->raster_cols_capacity = 0;
+  ctx->raster_colors = NULL;
+  ctx->raster_colors_capacity = 0;
+  ctx->worker_pool = NULL;
+
+  /* NULL unless the renderer can run the map shader */
+  ctx->map_shader = civ_map_shader_create(renderer, map_width, map_height);
+
+  build_color_luts();
   return ctx;
 }
 
+static void release_lod(civ_render_map_lod_t *lod) {
+  if (!lod) return;
+  for (int k = 0; k < CIV_RENDER_LOD_LEVELS; k++) {
+    if (lod->texture[k]) SDL_DestroyTexture(lod->texture[k]);
+    free(lod->texels[k]);
+  }
+  free(lod->regions);
+  free(lod);
+}
+
+/* Drop everything baked from the current map: chunks, LOD pyramids and
+   border segments */
+static void release_chunks(civ_render_map_context_t *ctx) {
+  ctx->minimap_valid = false;
+  if (ctx->border_chunks) {
+    for (int c = 0; c < ctx->chunk_cols * ctx->chunk_rows; c++)
+      free(ctx->border_chunks[c].segments);
+    free(ctx->border_chunks);
+    ctx->border_chunks = NULL;
+  }
+  for (int v = 0; v < CIV_MAP_VIEW_COUNT; v++) {
+    release_lod(ctx->lods[v]);
+    ctx->lods[v] = NULL;
+    if (!ctx->chunks[v]) continue;
+    for (int c = 0; c < ctx->chunk_cols * ctx->chunk_rows; c++)
+      if (ctx->chunks[v][c].texture) SDL_DestroyTexture(ctx->chunks[v][c].texture);
+    free(ctx->chunks[v]);
+    ctx->chunks[v] = NULL;
+  }
+}
+
 void civ_render_map_context_destroy(civ_render_map_context_t *ctx) {
   if (!ctx)
     return;
 
+  civ_map_shader_destroy(ctx->map_shader);
+  release_chunks(ctx);
+  free(ctx->chunk_pixels);
+  free(ctx->border_vertices);
+  free(ctx->entity_indices);
+  free(ctx->markers);
+  free(ctx->clusters);
+  free(ctx->raster_span_x);
+  free(ctx->raster_col_span);
+  free(ctx->raster_colors);
+
+  if (ctx->minimap_texture) SDL_DestroyTexture(ctx->minimap_texture);
+  free(ctx->minimap_pixels);
   if (ctx->map_texture)    SDL_DestroyTexture(ctx->map_texture);
-  if (ctx->lod_texture_512) SDL_DestroyTexture(ctx->lod_texture_512);
-  if (ctx->lod_texture_256) SDL_DestroyTexture(ctx->lod_texture_256);
   free(ctx->pixel_buffer);
-  free(ctx->lod_buffer_512);
-  free(ctx->lod_buffer_256);
   free(ctx);
 }
 
@@ -242,85 +350,78 @@ static uint32_t cultural_color(float influence) {
   return 0xFFCC44FF;
 }
 
-/* Forward declaration for LOD builder */
-static uint32_t get_map_color_for_view(const civ_map_tile_t *tile,
-                                        civ_map_view_type_t view,
-                                        const civ_resource_map_t *rm);
+/* ── Per-view colour LUTs ─────────────────────────────────────────── */
+/* The gradients above, sampled at bin centres; index [visible][bin].
+   Their band edges are multiples of 0.01, so 1/1000 bins never straddle
+   one and the tables match the functions. */
+#define COLOR_LUT_SIZE 1000
+
+static uint32_t elevation_lut[2][COLOR_LUT_SIZE];
+static uint32_t density_lut[2][COLOR_LUT_SIZE];
+static uint32_t cultural_lut[2][COLOR_LUT_SIZE];
+static uint8_t  resource_band[65536];       /* total -> palette index */
+static uint32_t resource_palette[2][8];
+static bool     color_luts_built = false;
+
+/* Fogged-but-explored shading of the heat views */
+static uint32_t dim_color(uint32_t c) {
+  uint8_t r = (((c >> 16) & 0xFF) * 2) / 3;
+  uint8_t g = (((c >> 8) & 0xFF) * 2) / 3;
+  uint8_t b = ((c & 0xFF) * 2) / 3;
+  return 0xFF000000 | (r << 16) | (g << 8) | b;
+}
 
-/* ── LOD buffer construction ──────────────────────────────────────── */
-void civ_render_map_build_lods(civ_render_map_context_t *ctx, civ_map_t *map,
-                               SDL_Renderer *r) {
-  if (!ctx || !map || !r || ctx->lods_built) return;
-
-  int mw = ctx->map_width, mh = ctx->map_height;
-
-  /* 512x256 LOD: downsample 4x in both axes */
-  int lod512_w = mw / 4, lod512_h = mh / 4;  /* 512 x 256 */
-  ctx->lod_buffer_512 = malloc(lod512_w * lod512_h * sizeof(uint32_t));
-  ctx->lod_texture_512 = SDL_CreateTexture(r, SDL_PIXELFORMAT_ARGB8888,
-      SDL_TEXTUREACCESS_STATIC, lod512_w, lod512_h);
-  if (ctx->lod_buffer_512 && ctx->lod_texture_512) {
-    for (int ly = 0; ly < lod512_h; ly++) {
-      for (int lx = 0; lx < lod512_w; lx++) {
-        uint32_t rsum = 0, gsum = 0, bsum = 0, count = 0;
-        for (int dy = 0; dy < 4; dy++) {
-          for (int dx = 0; dx < 4; dx++) {
-            int tx = lx * 4 + dx, ty = ly * 4 + dy;
-            civ_map_tile_t *t = civ_map_get_tile(map, tx, ty);
-            if (!t) continue;
-            uint32_t c = get_map_color_for_view(t, CIV_MAP_VIEW_POLITICAL, NULL);
-            rsum += (c >> 16) & 0xFF;
-            gsum += (c >> 8) & 0xFF;
-            bsum += c & 0xFF;
-            count++;
-          }
-        }
-        if (count > 0) {
-          uint32_t avg = 0xFF000000 | ((rsum/count) << 16) | ((gsum/count) << 8) | (bsum/count);
-          ctx->lod_buffer_512[ly * lod512_w + lx] = avg;
-        } else {
-          ctx->lod_buffer_512[ly * lod512_w + lx] = 0xFF010204;
-        }
-      }
+static void build_color_luts(void) {
+  if (color_luts_built) return;
+  for (int i = 0; i < COLOR_LUT_SIZE; i++) {
+    float v = ((float)i + 0.5f) / (float)COLOR_LUT_SIZE;
+    elevation_lut[1][i] = elevation_color(v);
+    density_lut[1][i] = density_color(v);
+    cultural_lut[1][i] = cultural_color(v);
+    elevation_lut[0][i] = dim_color(elevation_lut[1][i]);
+    density_lut[0][i] = dim_color(density_lut[1][i]);
+    cultural_lut[0][i] = dim_color(cultural_lut[1][i]);
+  }
+  int bands = 0;
+  for (uint32_t t = 0; t < 65536; t++) {
+    uint32_t c = resource_heat_color((uint16_t)t, 0);
+    if (bands == 0 || resource_palette[1][bands - 1] != c) {
+      resource_palette[1][bands] = c;
+      resource_palette[0][bands] = dim_color(c);
+      bands++;
     }
-    SDL_UpdateTexture(ctx->lod_texture_512, NULL, ctx->lod_buffer_512,
-                      lod512_w * sizeof(uint32_t));
-  }
-
-  /* 256x128 LOD: downsample 8x in both axes */
-  int lod256_w = mw / 8, lod256_h = mh / 8;  /* 256 x 128 */
-  ctx->lod_buffer_256 = malloc(lod256_w * lod256_h * sizeof(uint32_t));
-  ctx->lod_texture_256 = SDL_CreateTexture(r, SDL_PIXELFORMAT_ARGB8888,
-      SDL_TEXTUREACCESS_STATIC, lod256_w, lod256_h);
-  if (ctx->lod_buffer_256 && ctx->lod_texture_256) {
-    for (int ly = 0; ly < lod256_h; ly++) {
-      for (int lx = 0; lx < lod256_w; lx++) {
-        uint32_t rsum = 0, gsum = 0, bsum = 0, count = 0;
-        for (int dy = 0; dy < 8; dy++) {
-          for (int dx = 0; dx < 8; dx++) {
-            int tx = lx * 8 + dx, ty = ly * 8 + dy;
-            civ_map_tile_t *t = civ_map_get_tile(map, tx, ty);
-            if (!t) continue;
-            uint32_t c = get_map_color_for_view(t, CIV_MAP_VIEW_POLITICAL, NULL);
-            rsum += (c >> 16) & 0xFF;
-            gsum += (c >> 8) & 0xFF;
-            bsum += c & 0xFF;
-            count++;
-          }
-        }
-        if (count > 0) {
-          uint32_t avg = 0xFF000000 | ((rsum/count) << 16) | ((gsum/count) << 8) | (bsum/count);
-          ctx->lod_buffer_256[ly * lod256_w + lx] = avg;
-        } else {
-          ctx->lod_buffer_256[ly * lod256_w + lx] = 0xFF010204;
-        }
-      }
+    resource_band[t] = (uint8_t)(bands - 1);
+  }
+  color_luts_built = true;
+}
+
+static inline int lut_bin(float v) {
+  int i = (int)(v * (float)COLOR_LUT_SIZE);
+  return i < 0 ? 0 : i >= COLOR_LUT_SIZE ? COLOR_LUT_SIZE - 1 : i;
+}
+
+/* Political shading shared by the tile and plane paths */
+static uint32_t political_color(bool is_water, bool visible, uint32_t c) {
+  if (is_water)
+    return visible ? 0xFF0B2C4D : 0xFF02060F;
+  if (c != 0) {
+    if (!visible) {
+      uint8_t r = ((c >> 16) & 0xFF) / 3;
+      uint8_t g = ((c >> 8) & 0xFF) / 3;
+      uint8_t b = (c & 0xFF) / 3;
+      return 0xFF000000 | (r << 16) | (g << 8) | b;
     }
-    SDL_UpdateTexture(ctx->lod_texture_256, NULL, ctx->lod_buffer_256,
-                      lod256_w * sizeof(uint32_t));
+    return c;
   }
+  return visible ? 0xFF3A3A3A : 0xFF101010;
+}
 
-  ctx->lods_built = true;
+/* Political colour of tile index i read from the SoA planes */
+static uint32_t political_color_at(const civ_map_planes_t *p, size_t i) {
+  uint64_t bit = (uint64_t)1 << (i & 63);
+  if (!(p->explored[i >> 6] & bit)) return 0xFF010204;
+  return political_color((p->flags[i] & CIV_TILE_FLAG_WATER) != 0,
+                         (p->visible[i >> 6] & bit) != 0, p->political_color[i]);
 }
 
 /* Helper: Get map tile color based on current view type */
@@ -331,80 +432,33 @@ static uint32_t get_map_color_for_view(const civ_map_tile_t *tile,
   if (!tile->is_explored) return 0xFF010204;
 
   bool is_water = (tile->land_use == CIV_LAND_USE_WATER);
-  float dim = tile->is_visible ? 1.0f : 0.33f;
 
   switch (view) {
     case CIV_MAP_VIEW_POLITICAL:
     default:
-      if (is_water)
-        return tile->is_visible ? 0xFF0B2C4D : 0xFF02060F;
-      if (tile->political_color != 0) {
-        uint32_t c = tile->political_color;
-        if (!tile->is_visible) {
-          uint8_t r = ((c >> 16) & 0xFF) / 3;
-          uint8_t g = ((c >> 8) & 0xFF) / 3;
-          uint8_t b = (c & 0xFF) / 3;
-          return 0xFF000000 | (r << 16) | (g << 8) | b;
-        }
-        return c;
-      }
-      return tile->is_visible ? 0xFF3A3A3A : 0xFF101010;
-
-    case CIV_MAP_VIEW_GEOGRAPHICAL: {
-      uint32_t c = elevation_color(tile->elevation);
-      if (!tile->is_visible) {
-        uint8_t r = (((c >> 16) & 0xFF) * 2) / 3;
-        uint8_t g = (((c >> 8) & 0xFF) * 2) / 3;
-        uint8_t b = ((c & 0xFF) * 2) / 3;
-        return 0xFF000000 | (r << 16) | (g << 8) | b;
-      }
-      return c;
-    }
+      return political_color(is_water, tile->is_visible, tile->political_color);
+
+    case CIV_MAP_VIEW_GEOGRAPHICAL:
+      return elevation_lut[tile->is_visible][lut_bin(civ_tile_elevation(tile))];
 
     case CIV_MAP_VIEW_ECONOMIC: {
       if (is_water)
         return tile->is_visible ? 0xFF0B2C4D : 0xFF02060F;
       uint16_t total = 0;
-      int types = 0;
-      if (rm) {
+      if (rm)
         total = civ_resource_map_total_at_tile(rm, (int32_t)tile->x, (int32_t)tile->y);
-        types = civ_resource_map_type_count_at_tile(rm, (int32_t)tile->x, (int32_t)tile->y);
-      }
-      uint32_t c = resource_heat_color(total, types);
-      if (!tile->is_visible) {
-        uint8_t r = (((c >> 16) & 0xFF) * 2) / 3;
-        uint8_t g = (((c >> 8) & 0xFF) * 2) / 3;
-        uint8_t b = ((c & 0xFF) * 2) / 3;
-        return 0xFF000000 | (r << 16) | (g << 8) | b;
-      }
-      return c;
+      return resource_palette[tile->is_visible][resource_band[total]];
     }
 
-    case CIV_MAP_VIEW_DEMOGRAPHICAL: {
+    case CIV_MAP_VIEW_DEMOGRAPHICAL:
       if (is_water)
         return tile->is_visible ? 0xFF0B2C4D : 0xFF02060F;
-      uint32_t c = density_color(tile->population_density);
-      if (!tile->is_visible) {
-        uint8_t r = (((c >> 16) & 0xFF) * 2) / 3;
-        uint8_t g = (((c >> 8) & 0xFF) * 2) / 3;
-        uint8_t b = ((c & 0xFF) * 2) / 3;
-        return 0xFF000000 | (r << 16) | (g << 8) | b;
-      }
-      return c;
-    }
+      return density_lut[tile->is_visible][lut_bin(civ_tile_population_density(tile))];
 
-    case CIV_MAP_VIEW_CULTURAL: {
+    case CIV_MAP_VIEW_CULTURAL:
       if (is_water)
         return tile->is_visible ? 0xFF0B2C4D : 0xFF02060F;
-      uint32_t c = cultural_color(tile->cultural_influence);
-      if (!tile->is_visible) {
-        uint8_t r = (((c >> 16) & 0xFF) * 2) / 3;
-        uint8_t g = (((c >> 8) & 0xFF) * 2) / 3;
-        uint8_t b = ((c & 0xFF) * 2) / 3;
-        return 0xFF000000 | (r << 16) | (g << 8) | b;
-      }
-      return c;
-    }
+      return cultural_lut[tile->is_visible][lut_bin(tile->cultural_influence)];
 
     case CIV_MAP_VIEW_MILITARY:
     case CIV_MAP_VIEW_DIPLOMATIC:
@@ -415,34 +469,511 @@ static uint32_t get_map_color_for_view(const civ_map_tile_t *tile,
   }
 }
 
+/* Colour of tile index i in a view, river overlay included */
+static uint32_t tile_view_color(const civ_map_t *map, size_t i,
+                                civ_map_view_type_t view,
+                                const civ_resource_map_t *rm) {
+  const civ_map_planes_t *p = map->planes;
+  if (p && view == CIV_MAP_VIEW_POLITICAL) {
+    uint32_t color = political_color_at(p, i);
+    if ((p->flags[i] & CIV_TILE_FLAG_RIVER) && p->elevation[i] >= map->sea_level)
+      color = 0xFF2A8AE0;
+    return color;
+  }
+  const civ_map_tile_t *tile = &map->tiles[i];
+  uint32_t color = get_map_color_for_view(tile, view, rm);
+  if (tile->has_river && civ_tile_elevation(tile) >= map->sea_level)
+    color = 0xFF2A8AE0;
+  return color;
+}
+
+/* ── Chunked rendering ────────────────────────────────────────────── */
+
+/* Drop anything baked from another map; false if map has no regions */
+static bool bind_map(civ_render_map_context_t *ctx, const civ_map_t *map) {
+  if (!map->region_revision) return false;
+  if (ctx->chunk_map_serial != map->serial ||
+      ctx->chunk_cols != map->region_cols || ctx->chunk_rows != map->region_rows) {
+    release_chunks(ctx);
+    ctx->chunk_map_serial = map->serial;
+    ctx->chunk_cols = map->region_cols;
+    ctx->chunk_rows = map->region_rows;
+  }
+  return true;
+}
+
+/* Chunk array for a view of map */
+static civ_render_map_chunk_t *chunks_for(civ_render_map_context_t *ctx,
+                                          const civ_map_t *map,
+                                          civ_map_view_type_t view,
+                                          const civ_resource_map_t *rm) {
+  if (!bind_map(ctx, map) || view < 0 || view >= CIV_MAP_VIEW_COUNT)
+    return NULL;
+  size_t n = (size_t)ctx->chunk_cols * ctx->chunk_rows;
+  if (!ctx->chunks[view]) {
+    ctx->chunks[view] = calloc(n, sizeof(civ_render_map_chunk_t));
+    if (!ctx->chunks[view]) return NULL;
+  }
+  /* Resource deposits are not revisioned; a different map means rebake */
+  if (view == CIV_MAP_VIEW_ECONOMIC && rm != ctx->chunk_resources) {
+    for (size_t c = 0; c < n; c++) ctx->chunks[view][c].baked = false;
+    ctx->chunk_resources = rm;
+  }
+  return ctx->chunks[view];
+}
+
+#define BAKE_BAND_ROWS 32
+
+typedef struct {
+  const civ_map_t *map;
+  civ_map_view_type_t view;
+  const civ_resource_map_t *rm;
+  uint32_t *pixels;
+  int x0, y0, w, h;
+} bake_job_t;
+
+static void bake_rows(void *arg, int band) {
+  const bake_job_t *j = (const bake_job_t *)arg;
+  int y1 = MIN(j->h, (band + 1) * BAKE_BAND_ROWS);
+  for (int y = band * BAKE_BAND_ROWS; y < y1; y++) {
+    uint32_t *row = &j->pixels[y * j->w];
+    size_t i = (size_t)(j->y0 + y) * j->map->width + j->x0;
+    for (int x = 0; x < j->w; x++)
+      row[x] = tile_view_color(j->map, i + x, j->view, j->rm);
+  }
+}
+
+static bool bake_chunk(SDL_Renderer *renderer, civ_render_map_context_t *ctx,
+                       const civ_map_t *map, civ_map_view_type_t view,
+                       const civ_resource_map_t *rm,
+                       civ_render_map_chunk_t *chunk, int cx, int cy) {
+  int x0 = cx * CIV_RENDER_CHUNK_SIZE, y0 = cy * CIV_RENDER_CHUNK_SIZE;
+  int w = MIN(CIV_RENDER_CHUNK_SIZE, map->width - x0);
+  int h = MIN(CIV_RENDER_CHUNK_SIZE, map->height - y0);
+
+  if (!chunk->texture) {
+    chunk->texture = civ_create_texture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                       SDL_TEXTUREACCESS_STATIC, w, h);
+    if (!chunk->texture) return false;
+    SDL_SetTextureScaleMode(chunk->texture, SDL_SCALEMODE_NEAREST);
+  }
+
+  bake_job_t job = {map, view, rm, ctx->chunk_pixels, x0, y0, w, h};
+  civ_worker_pool_parallel_for((civ_worker_pool_t *)ctx->worker_pool,
+                               (h + BAKE_BAND_ROWS - 1) / BAKE_BAND_ROWS,
+                               bake_rows, &job);
+  SDL_UpdateTexture(chunk->texture, NULL, ctx->chunk_pixels,
+                    w * sizeof(uint32_t));
+  chunk->revision = civ_map_region_revision(map, cx, cy);
+  chunk->baked = true;
+  return true;
+}
+
+/* Draw the chunks under the view, re-baking stale ones. Chunks are laid out
+   once per east-west repeat of the map, so the seam needs no special case.
+   Returns false if a texture could not be made (caller rasters instead). */
+static bool render_chunks(SDL_Renderer *renderer, civ_render_map_context_t *ctx,
+                          const civ_map_t *map, int fb_width, int fb_height,
+                          float scale, civ_map_view_type_t view,
+                          const civ_resource_map_t *rm) {
+  civ_render_map_chunk_t *chunks = chunks_for(ctx, map, view, rm);
+  if (!chunks) return false;
+  if (!ctx->chunk_pixels) {
+    ctx->chunk_pixels = malloc((size_t)CIV_RENDER_CHUNK_SIZE *
+                               CIV_RENDER_CHUNK_SIZE * sizeof(uint32_t));
+    if (!ctx->chunk_pixels) return false;
+  }
+
+  const float CS = (float)CIV_RENDER_CHUNK_SIZE;
+  float left = ctx->view_x - (fb_width * 0.5f) / scale;
+  float top = ctx->view_y - (fb_height * 0.5f) / scale;
+  float right = left + fb_width / scale;
+  float bottom = top + fb_height / scale;
+
+  int cy0 = MAX(0, (int)floorf(top / CS));
+  int cy1 = MIN(ctx->chunk_rows - 1, (int)floorf(bottom / CS));
+  int rep0 = (int)floorf(left / (float)map->width);
+  int rep1 = (int)floorf(right / (float)map->width);
+
+  /* Past the poles: deep space */
+  civ_render_rect_filled(renderer, 0, 0, fb_width, fb_height, 0x020408);
+
+  for (int cy = cy0; cy <= cy1; cy++) {
+    float wy = cy * CS;
+    float ch = (float)MIN(CIV_RENDER_CHUNK_SIZE, map->height - cy * CIV_RENDER_CHUNK_SIZE);
+    for (int rep = rep0; rep <= rep1; rep++) {
+      for (int cx = 0; cx < ctx->chunk_cols; cx++) {
+        float wx = (float)rep * map->width + cx * CS;
+        float cw = (float)MIN(CIV_RENDER_CHUNK_SIZE, map->width - cx * CIV_RENDER_CHUNK_SIZE);
+        if (wx + cw <= left || wx >= right) continue;
+
+        civ_render_map_chunk_t *chunk = &chunks[cy * ctx->chunk_cols + cx];
+        if ((!chunk->baked ||
+             chunk->revision != civ_map_region_revision(map, cx, cy)) &&
+            !bake_chunk(renderer, ctx, map, view, rm, chunk, cx, cy))
+          return false;
+
+        SDL_FRect dst = {(wx - left) * scale, (wy - top) * scale, cw * scale,
+                         ch * scale};
+        SDL_RenderTexture(renderer, chunk->texture, NULL, &dst);
+      }
+    }
+  }
+  return true;
+}
+
+/* ── LOD pyramid ──────────────────────────────────────────────────── */
+
+/* Per-channel mean of up to four ARGB texels */
+static uint32_t average_texels(const uint32_t *c, int n) {
+  uint32_t a = 0, r = 0, g = 0, b = 0;
+  for (int i = 0; i < n; i++) {
+    a += c[i] >> 24;
+    r += (c[i] >> 16) & 0xFF;
+    g += (c[i] >> 8) & 0xFF;
+    b += c[i] & 0xFF;
+  }
+  return ((a / n) << 24) | ((r / n) << 16) | ((g / n) << 8) | (b / n);
+}
+
+/* Pyramid for a view of map, allocated on first use */
+static civ_render_map_lod_t *lod_for(SDL_Renderer *renderer,
+                                     civ_render_map_context_t *ctx,
+                                     const civ_map_t *map,
+                                     civ_map_view_type_t view,
+                                     const civ_resource_map_t *rm) {
+  if (!bind_map(ctx, map) || view < 0 || view >= CIV_MAP_VIEW_COUNT)
+    return NULL;
+  civ_render_map_lod_t *lod = ctx->lods[view];
+  if (!lod) {
+    lod = calloc(1, sizeof(civ_render_map_lod_t));
+    if (!lod) return NULL;
+    ctx->lods[view] = lod;
+    lod->regions = calloc((size_t)ctx->chunk_cols * ctx->chunk_rows,
+                          sizeof(civ_render_map_chunk_t));
+    bool ok = lod->regions != NULL;
+    for (int k = 0; ok && k < CIV_RENDER_LOD_LEVELS; k++) {
+      int step = 1 << (k + 1);
+      lod->width[k] = (map->width + step - 1) / step;
+      lod->height[k] = (map->height + step - 1) / step;
+      lod->texels[k] =
+          malloc((size_t)lod->width[k] * lod->height[k] * sizeof(uint32_t));
+      lod->texture[k] = civ_create_texture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                          SDL_TEXTUREACCESS_STATIC,
+                                          lod->width[k], lod->height[k]);
+      ok = lod->texels[k] && lod->texture[k];
+      if (ok) SDL_SetTextureBlendMode(lod->texture[k], SDL_BLENDMODE_BLEND);
+    }
+    if (!ok) {
+      release_lod(lod);
+      ctx->lods[view] = NULL;
+      return NULL;
+    }
+    lod->resources = rm;
+  }
+  /* Resource deposits are not revisioned; a different map means rebuild */
+  if (view == CIV_MAP_VIEW_ECONOMIC && rm != lod->resources) {
+    size_t n = (size_t)ctx->chunk_cols * ctx->chunk_rows;
+    for (size_t c = 0; c < n; c++) lod->regions[c].baked = false;
+    lod->resources = rm;
+  }
+  return lod;
+}
+
+/* Re-average every level over one region. Region edges are multiples of
+   2^CIV_RENDER_LOD_LEVELS tiles, so no texel straddles two regions. */
+static void build_lod_region(civ_render_map_lod_t *lod, const civ_map_t *map,
+                             civ_map_view_type_t view,
+                             const civ_resource_map_t *rm, int cx, int cy) {
+  int x0 = cx * CIV_MAP_REGION_SIZE, y0 = cy * CIV_MAP_REGION_SIZE;
+  int x1 = MIN(map->width, x0 + CIV_MAP_REGION_SIZE);
+  int y1 = MIN(map->height, y0 + CIV_MAP_REGION_SIZE);
+
+  for (int k = 0; k < CIV_RENDER_LOD_LEVELS; k++) {
+    int w = lod->width[k];
+    int lx0 = x0 >> (k + 1), ly0 = y0 >> (k + 1);
+    int lx1 = MIN(w, (x1 + (2 << k) - 1) >> (k + 1));
+    int ly1 = MIN(lod->height[k], (y1 + (2 << k) - 1) >> (k + 1));
+    /* Level 1 averages tiles, every other level the one below it */
+    int src_w = k ? lod->width[k - 1] : map->width;
+    int src_h = k ? lod->height[k - 1] : map->height;
+
+    for (int y = ly0; y < ly1; y++) {
+      for (int x = lx0; x < lx1; x++) {
+        uint32_t c[4];
+        int n = 0;
+        for (int sy = 2 * y; sy < MIN(src_h, 2 * y + 2); sy++)
+          for (int sx = 2 * x; sx < MIN(src_w, 2 * x + 2); sx++)
+            c[n++] = k ? lod->texels[k - 1][(size_t)sy * src_w + sx]
+                       : tile_view_color(map, (size_t)sy * map->width + sx,
+                                         view, rm);
+        lod->texels[k][(size_t)y * w + x] = average_texels(c, n);
+      }
+    }
+    SDL_Rect rect = {lx0, ly0, lx1 - lx0, ly1 - ly0};
+    SDL_UpdateTexture(lod->texture[k], &rect,
+                      &lod->texels[k][(size_t)ly0 * w + lx0],
+                      w * sizeof(uint32_t));
+  }
+}
+
+/* Bring every region of a pyramid up to the map's revisions */
+static void refresh_lod(civ_render_map_context_t *ctx, civ_render_map_lod_t *lod,
+                        const civ_map_t *map, civ_map_view_type_t view,
+                        const civ_resource_map_t *rm) {
+  for (int cy = 0; cy < ctx->chunk_rows; cy++) {
+    for (int cx = 0; cx < ctx->chunk_cols; cx++) {
+      civ_render_map_chunk_t *region = &lod->regions[cy * ctx->chunk_cols + cx];
+      uint32_t revision = civ_map_region_revision(map, cx, cy);
+      if (region->baked && region->revision == revision) continue;
+      build_lod_region(lod, map, view, rm, cx, cy);
+      region->revision = revision;
+      region->baked = true;
+    }
+  }
+}
+
+void civ_render_map_build_lods(civ_render_map_context_t *ctx, civ_map_t *map,
+                               SDL_Renderer *r) {
+  if (!ctx || !map || !map->tiles || !r)
+    return;
+  civ_render_map_lod_t *lod = lod_for(r, ctx, map, CIV_MAP_VIEW_POLITICAL, NULL);
+  if (lod)
+    refresh_lod(ctx, lod, map, CIV_MAP_VIEW_POLITICAL, NULL);
+}
+
+/* Nearest stale region to the view centre, searched in square rings
+   outward from the region under it; false once every region is current */
+static bool stale_region(civ_render_map_context_t *ctx, const civ_map_t *map,
+                         const civ_render_map_chunk_t *regions, int *out_cx,
+                         int *out_cy) {
+  int cols = ctx->chunk_cols, rows = ctx->chunk_rows;
+  float vx = fmodf(ctx->view_x, (float)map->width);
+  if (vx < 0.0f) vx += (float)map->width;
+  int ccx = MIN(cols - 1, (int)(vx / CIV_MAP_REGION_SIZE));
+  int ccy = MAX(0, MIN(rows - 1, (int)(ctx->view_y / CIV_MAP_REGION_SIZE)));
+  int rmax = MAX(cols, rows);
+  for (int r = 0; r <= rmax; r++) {
+    for (int dy = -r; dy <= r; dy++) {
+      int cy = ccy + dy;
+      if (cy < 0 || cy >= rows) continue;
+      for (int dx = -r; dx <= r; dx++) {
+        if (abs(dx) != r && abs(dy) != r) continue;
+        int cx = ((ccx + dx) % cols + cols) % cols;
+        const civ_render_map_chunk_t *c = &regions[cy * cols + cx];
+        if (c->baked && c->revision == civ_map_region_revision(map, cx, cy))
+          continue;
+        *out_cx = cx;
+        *out_cy = cy;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool civ_render_map_prebake(SDL_Renderer *renderer,
+                            civ_render_map_context_t *ctx, civ_map_t *map,
+                            civ_map_view_type_t view,
+                            const civ_resource_map_t *resource_map,
+                            Uint64 deadline_ns) {
+  if (!renderer || !ctx || !map || !map->tiles)
+    return false;
+  int cx, cy;
+
+  /* Full-detail chunks only feed CPU drawing; the shader reads tiles */
+  if (!ctx->map_shader) {
+    civ_render_map_chunk_t *chunks = chunks_for(ctx, map, view, resource_map);
+    if (chunks && !ctx->chunk_pixels)
+      ctx->chunk_pixels = malloc((size_t)CIV_RENDER_CHUNK_SIZE *
+                                 CIV_RENDER_CHUNK_SIZE * sizeof(uint32_t));
+    while (chunks && ctx->chunk_pixels &&
+           stale_region(ctx, map, chunks, &cx, &cy)) {
+      if (SDL_GetTicksNS() >= deadline_ns) return true;
+      if (!bake_chunk(renderer, ctx, map, view, resource_map,
+                      &chunks[cy * ctx->chunk_cols + cx], cx, cy))
+        break;
+    }
+  }
+
+  civ_render_map_lod_t *lod = lod_for(renderer, ctx, map, view, resource_map);
+  while (lod && stale_region(ctx, map, lod->regions, &cx, &cy)) {
+    if (SDL_GetTicksNS() >= deadline_ns) return true;
+    civ_render_map_chunk_t *region = &lod->regions[cy * ctx->chunk_cols + cx];
+    build_lod_region(lod, map, view, resource_map, cx, cy);
+    region->revision = civ_map_region_revision(map, cx, cy);
+    region->baked = true;
+  }
+  return false;
+}
+
+/* Draw LOD level k (1-based) over the view, once per east-west repeat */
+static void draw_lod_level(SDL_Renderer *renderer, civ_render_map_context_t *ctx,
+                           civ_render_map_lod_t *lod, int k, const civ_map_t *map,
+                           int fb_width, int fb_height, float scale,
+                           uint8_t alpha) {
+  SDL_Texture *texture = lod->texture[k - 1];
+  float step = (float)(1 << k);
+  float left = ctx->view_x - (fb_width * 0.5f) / scale;
+  float top = ctx->view_y - (fb_height * 0.5f) / scale;
+  float right = left + fb_width / scale;
+  int rep0 = (int)floorf(left / (float)map->width);
+  int rep1 = (int)floorf(right / (float)map->width);
+
+  SDL_SetTextureAlphaMod(texture, alpha);
+  for (int rep = rep0; rep <= rep1; rep++) {
+    SDL_FRect dst = {((float)rep * map->width - left) * scale, -top * scale,
+                     lod->width[k - 1] * step * scale,
+                     lod->height[k - 1] * step * scale};
+    SDL_RenderTexture(renderer, texture, NULL, &dst);
+  }
+}
+
+/* Draw level floor(t) with the next level blended in by the fraction of t,
+   t = log2(tiles per pixel). Level 0 is the full-detail map, already drawn
+   by the caller, so t < 1 only blends level 1 over it. */
+static void render_lod(SDL_Renderer *renderer, civ_render_map_context_t *ctx,
+                       const civ_map_t *map, int fb_width, int fb_height,
+                       float scale, float t, civ_map_view_type_t view,
+                       const civ_resource_map_t *rm) {
+  civ_render_map_lod_t *lod = lod_for(renderer, ctx, map, view, rm);
+  if (!lod) return;
+  refresh_lod(ctx, lod, map, view, rm);
+
+  int k = MIN((int)floorf(t), CIV_RENDER_LOD_LEVELS);
+  float f = k < CIV_RENDER_LOD_LEVELS ? t - (float)k : 0.0f;
+  if (k > 0) {
+    civ_render_rect_filled(renderer, 0, 0, fb_width, fb_height, 0x020408);
+    draw_lod_level(renderer, ctx, lod, k, map, fb_width, fb_height, scale, 255);
+  }
+  uint8_t alpha = (uint8_t)(f * 255.0f + 0.5f);
+  if (alpha > 0)
+    draw_lod_level(renderer, ctx, lod, k + 1, map, fb_width, fb_height, scale,
+                   alpha);
+}
+
+/* ── Per-pixel raster ─────────────────────────────────────────────── */
+
+typedef struct {
+  civ_render_map_context_t *ctx;
+  const civ_map_t *map;
+  civ_map_view_type_t view;
+  const civ_resource_map_t *rm;
+  int fb_width, fb_height;
+  int span_count;     /* distinct tiles across a row */
+  int rows_per_job;
+  float inv_scale;
+} raster_job_t;
+
+/* row[x] = colors[col[x]] */
+static void expand_row(uint32_t *row, const uint32_t *colors,
+                       const int32_t *col, int n) {
+  int x = 0;
+#if CIV_RENDER_AVX2
+  for (; x + 8 <= n; x += 8) {
+    __m256i idx = _mm256_loadu_si256((const __m256i *)&col[x]);
+    _mm256_storeu_si256((__m256i *)&row[x],
+                        _mm256_i32gather_epi32((const int *)colors, idx, 4));
+  }
+#endif
+  for (; x < n; x++)
+    row[x] = colors[col[x]];
+}
+
+/* One band of rows: each distinct tile of a row is coloured once, then
+   expanded to pixels; a row on the same tile row as the last is copied */
+static void raster_rows(void *arg, int job) {
+  const raster_job_t *j = (const raster_job_t *)arg;
+  civ_render_map_context_t *ctx = j->ctx;
+  const civ_map_t *map = j->map;
+  uint32_t *colors = &ctx->raster_colors[(size_t)job * j->span_count];
+  int y0 = job * j->rows_per_job;
+  int y1 = MIN(j->fb_height, y0 + j->rows_per_job);
+  int32_t last_wy = -1;
+
+  for (int y = y0; y < y1; y++) {
+    uint32_t *row = &ctx->pixel_buffer[(size_t)y * j->fb_width];
+    float fy = ctx->view_y + (y - j->fb_height / 2.0f) * j->inv_scale;
+
+    /* Past the poles: deep space */
+    if (fy < 0 || fy >= (float)map->height) {
+      for (int x = 0; x < j->fb_width; x++) row[x] = 0xFF020408;
+      last_wy = -1;
+      continue;
+    }
+
+    int32_t wy = (int32_t)fy;
+    if (wy == last_wy) {
+      memcpy(row, row - j->fb_width, (size_t)j->fb_width * sizeof(uint32_t));
+      continue;
+    }
+    size_t base = (size_t)wy * map->width;
+    for (int k = 0; k < j->span_count; k++)
+      colors[k] = tile_view_color(map, base + ctx->raster_span_x[k], j->view,
+                                  j->rm);
+    expand_row(row, colors, ctx->raster_col_span, j->fb_width);
+    last_wy = wy;
+  }
+}
+
+/* Fill pixel_buffer. The column -> tile mapping is the same for every row,
+   so the wrap math runs once per column per frame. */
+static bool raster_map(civ_render_map_context_t *ctx, const civ_map_t *map,
+                       int fb_width, int fb_height, float inv_scale,
+                       civ_map_view_type_t view, const civ_resource_map_t *rm) {
+  if (fb_width > ctx->raster_cols_capacity) {
+    int32_t *span_x = realloc(ctx->raster_span_x, fb_width * sizeof(int32_t));
+    if (span_x) ctx->raster_span_x = span_x;
+    int32_t *col_span = realloc(ctx->raster_col_span, fb_width * sizeof(int32_t));
+    if (col_span) ctx->raster_col_span = col_span;
+    if (!span_x || !col_span) return false;
+    ctx->raster_cols_capacity = fb_width;
+  }
+
+  /* East-west circumnavigation: wrap each column once */
+  int span_count = 0;
+  for (int x = 0; x < fb_width; x++) {
+    float fx = ctx->view_x + (x - fb_width / 2.0f) * inv_scale;
+    fx = fmodf(fx, (float)map->width);
+    if (fx < 0)
+      fx += (float)map->width;
+    int32_t wx = MIN((int32_t)fx, map->width - 1);
+    if (span_count == 0 || ctx->raster_span_x[span_count - 1] != wx)
+      ctx->raster_span_x[span_count++] = wx;
+    ctx->raster_col_span[x] = span_count - 1;
+  }
+
+  /* A few bands per lane so uneven rows (poles, copies) balance out */
+  civ_worker_pool_t *pool = (civ_worker_pool_t *)ctx->worker_pool;
+  int jobs = pool ? MIN(fb_height, (civ_worker_pool_size(pool) + 1) * 4) : 1;
+  if (jobs < 1) jobs = 1;
+  size_t need = (size_t)jobs * span_count;
+  if (need > ctx->raster_colors_capacity) {
+    uint32_t *colors = realloc(ctx->raster_colors, need * sizeof(uint32_t));
+    if (!colors) return false;
+    ctx->raster_colors = colors;
+    ctx->raster_colors_capacity = need;
+  }
+
+  raster_job_t job = {ctx, map, view, rm, fb_width, fb_height, span_count,
+                      (fb_height + jobs - 1) / jobs, inv_scale};
+  civ_worker_pool_parallel_for(pool, jobs, raster_rows, &job);
+  return true;
+}
+
 void civ_render_map(SDL_Renderer *renderer, civ_render_map_context_t *ctx,
                     civ_map_t *map, int fb_width, int fb_height,
                     civ_map_view_type_t view_type,
                     const civ_resource_map_t *resource_map) {
   if (!renderer || !ctx || !map || !ctx->pixel_buffer)
     return;
+  civ_render_flush_batch();
 
   const float WORLD_UNIT_SIZE = 4.0f;
   float minZ = (float)fb_height / ((float)ctx->map_height * WORLD_UNIT_SIZE);
   if (ctx->zoom < minZ)
     ctx->zoom = minZ;
 
-  /* ── LOD rendering: use pre-computed low-res buffers at global zoom ── */
-  if (ctx->lods_built && view_type == CIV_MAP_VIEW_POLITICAL) {
-    if (ctx->zoom < 0.3f && ctx->lod_texture_256) {
-      /* 256x128 global overview */
-      SDL_FRect dst = {0, 0, (float)fb_width, (float)fb_height};
-      SDL_RenderTexture(renderer, ctx->lod_texture_256, NULL, &dst);
-      return;
-    }
-    if (ctx->zoom < 0.7f && ctx->lod_texture_512) {
-      /* 512x256 continental view */
-      SDL_FRect dst = {0, 0, (float)fb_width, (float)fb_height};
-      SDL_RenderTexture(renderer, ctx->lod_texture_512, NULL, &dst);
-      return;
-    }
-  }
-
   float inv_scale = 1.0f / (ctx->zoom * WORLD_UNIT_SIZE);
   float half_h = (fb_height * 0.5f) * inv_scale;
 
@@ -452,56 +983,45 @@ void civ_render_map(SDL_Renderer *renderer, civ_render_map_context_t *ctx,
   if (ctx->view_y > ctx->map_height - half_h)
     ctx->view_y = ctx->map_height - half_h;
 
-  /* Render map to pixel buffer */
-  for (int y = 0; y < fb_height; y++) {
-    uint32_t *row = &ctx->pixel_buffer[y * fb_width];
-
-    for (int x = 0; x < fb_width; x++) {
-      /* Calculate world coordinates from view context */
-      /* MASTERPIECE 2.0: Correct coordinate spacing with WORLD_UNIT_SIZE */
-      float fx =
-          ctx->view_x + (x - fb_width / 2.0f) / (ctx->zoom * WORLD_UNIT_SIZE);
-      float fy =
-          ctx->view_y + (y - fb_height / 2.0f) / (ctx->zoom * WORLD_UNIT_SIZE);
-
-      /* MASTERPIECE 2.0: Spherical Realism (Equatorial Wrap, Polar Clamp) */
-      /* 1. East-West Circumnavigation (Wrapping) */
-      fx = fmodf(fx, (float)ctx->map_width);
-      if (fx < 0)
-        fx += (float)ctx->map_width;
-
-      /* 2. North-South Stability (Clamping) */
-      /* If we are past the poles, render deep space / ocean depth */
-      if (fy < 0 || fy >= (float)ctx->map_height) {
-        row[x] = 0xFF020408; /* Deep Space Black */
-        continue;
-      }
-
-      int32_t wx = (int32_t)fx;
-      int32_t wy = (int32_t)fy;
+  /* Past one texel per tile everything comes from the pyramid; within the
+     first octave the full-detail map is drawn and level 1 fades in */
+  float scale = ctx->zoom * WORLD_UNIT_SIZE;
+  float lod_t = log2f(1.0f / scale);
+  if (lod_t > 0.0f)
+    lod_t += ctx->lod_bias; /* coarser levels sooner once zoomed out */
+  if (lod_t >= 1.0f) {
+    render_lod(renderer, ctx, map, fb_width, fb_height, scale, lod_t, view_type,
+               resource_map);
+    return;
+  }
 
-      civ_map_tile_t *tile = civ_map_get_tile(map, wx, wy);
-      if (!tile) {
-        row[x] = 0x00000000;
-        continue;
-      }
+  bool drawn = ctx->map_shader &&
+               civ_map_shader_draw(ctx->map_shader, renderer, map, resource_map,
+                                   view_type, ctx->view_x, ctx->view_y, scale,
+                                   fb_width, fb_height);
+  if (!drawn)
+    drawn = render_chunks(renderer, ctx, map, fb_width, fb_height, scale,
+                          view_type, resource_map);
+  if (!drawn) {
+    /* The raster fills the CPU buffer this context was created with */
+    if ((size_t)fb_width * fb_height >
+        (size_t)ctx->buffer_width * ctx->buffer_height)
+      return;
+    if (!raster_map(ctx, map, fb_width, fb_height, inv_scale, view_type,
+                    resource_map))
+      return;
 
-      uint32_t color = get_map_color_for_view(tile, view_type, resource_map);
-      if (tile->has_river && tile->elevation >= map->sea_level) {
-        color = 0xFF2A8AE0;
-      }
+    /* Upload to texture */
+    SDL_UpdateTexture(ctx->map_texture, NULL, ctx->pixel_buffer,
+                      fb_width * sizeof(uint32_t));
 
-      row[x] = color;
-    }
+    /* Render texture to screen */
+    SDL_FRect dst_rect = {0, 0, (float)fb_width, (float)fb_height};
+    SDL_RenderTexture(renderer, ctx->map_texture, NULL, &dst_rect);
   }
-
-  /* Upload to texture */
-  SDL_UpdateTexture(ctx->map_texture, NULL, ctx->pixel_buffer,
-                    fb_width * sizeof(uint32_t));
-
-  /* Render texture to screen */
-  SDL_FRect dst_rect = {0, 0, (float)fb_width, (float)fb_height};
-  SDL_RenderTexture(renderer, ctx->map_texture, NULL, &dst_rect);
+  if (lod_t > 0.0f)
+    render_lod(renderer, ctx, map, fb_width, fb_height, scale, lod_t, view_type,
+               resource_map);
 
   /* MASTERPIECE 2.0: Latitude/Longitude Indicators */
   float lat = 90.0f - (ctx->view_y / (float)ctx->map_height) * 180.0f;
@@ -523,33 +1043,80 @@ void civ_render_map(SDL_Renderer *renderer, civ_render_map_context_t *ctx,
      these. */
 }
 
-void civ_render_minimap(SDL_Renderer *renderer, int x, int y, int w, int h,
-                        civ_map_t *map, civ_render_map_context_t *ctx) {
-  if (!renderer || !map || !ctx)
-    return;
+/* Re-sample the minimap texture if its size or any region revision moved.
+   Each pixel reads the coarsest political LOD level no wider than its
+   footprint, or the tile under it when there is no pyramid. */
+static bool update_minimap(SDL_Renderer *renderer, civ_render_map_context_t *ctx,
+                           civ_map_t *map, int w, int h) {
+  if (w <= 0 || h <= 0 || !bind_map(ctx, map)) return false;
+
+  if (!ctx->minimap_texture || ctx->minimap_width != w ||
+      ctx->minimap_height != h) {
+    uint32_t *pixels = realloc(ctx->minimap_pixels, (size_t)w * h * sizeof(uint32_t));
+    if (!pixels) return false;
+    ctx->minimap_pixels = pixels;
+    if (ctx->minimap_texture) SDL_DestroyTexture(ctx->minimap_texture);
+    ctx->minimap_texture = civ_create_texture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                             SDL_TEXTUREACCESS_STATIC, w, h);
+    if (!ctx->minimap_texture) return false;
+    SDL_SetTextureScaleMode(ctx->minimap_texture, SDL_SCALEMODE_NEAREST);
+    ctx->minimap_width = w;
+    ctx->minimap_height = h;
+    ctx->minimap_valid = false;
+  }
 
-  /* Draw background */
-  civ_render_rect_filled_alpha(renderer, x, y, w, h, 0x010204, 200);
-  civ_render_rect_outline(renderer, x, y, w, h, 0x1A2A3A, 1);
+  uint64_t revision = 0;
+  for (int cy = 0; cy < ctx->chunk_rows; cy++)
+    for (int cx = 0; cx < ctx->chunk_cols; cx++)
+      revision += civ_map_region_revision(map, cx, cy);
+  if (ctx->minimap_valid && ctx->minimap_revision == revision)
+    return true;
+  Uint64 now = SDL_GetTicksNS();
+  if (ctx->minimap_valid && now - ctx->minimap_sampled_ns < ctx->minimap_refresh_ns)
+    return true; /* stale for a moment, resampled once the interval is up */
 
-  /* Render simplified tiles */
   float step_x = (float)map->width / (float)w;
   float step_y = (float)map->height / (float)h;
+  int k = 0;
+  while (k < CIV_RENDER_LOD_LEVELS && (float)(2 << k) <= MIN(step_x, step_y))
+    k++;
+  civ_render_map_lod_t *lod =
+      k ? lod_for(renderer, ctx, map, CIV_MAP_VIEW_POLITICAL, NULL) : NULL;
+  if (lod) refresh_lod(ctx, lod, map, CIV_MAP_VIEW_POLITICAL, NULL);
 
   for (int py = 0; py < h; py++) {
+    int32_t my = (int32_t)(py * step_y);
+    uint32_t *row = &ctx->minimap_pixels[(size_t)py * w];
     for (int px = 0; px < w; px++) {
       int32_t mx = (int32_t)(px * step_x);
-      int32_t my = (int32_t)(py * step_y);
-      civ_map_tile_t *tile = civ_map_get_tile(map, mx, my);
-      if (tile) {
-        uint32_t color = get_map_color_for_view(tile, CIV_MAP_VIEW_POLITICAL, NULL);
-        /* Use a simple pixel or small rect for minimap */
-        SDL_SetRenderDrawColor(renderer, (color >> 16) & 0xFF,
-                               (color >> 8) & 0xFF, color & 0xFF, 255);
-        SDL_RenderPoint(renderer, (float)(x + px), (float)(y + py));
-      }
+      row[px] = lod ? lod->texels[k - 1][(size_t)(my >> k) * lod->width[k - 1] +
+                                         (mx >> k)]
+                    : tile_view_color(map, (size_t)my * map->width + mx,
+                                      CIV_MAP_VIEW_POLITICAL, NULL);
     }
   }
+  SDL_UpdateTexture(ctx->minimap_texture, NULL, ctx->minimap_pixels,
+                    w * sizeof(uint32_t));
+  ctx->minimap_revision = revision;
+  ctx->minimap_sampled_ns = now;
+  ctx->minimap_valid = true;
+  return true;
+}
+
+void civ_render_minimap(SDL_Renderer *renderer, int x, int y, int w, int h,
+                        civ_map_t *map, civ_render_map_context_t *ctx) {
+  if (!renderer || !map || !ctx)
+    return;
+
+  /* Draw background */
+  civ_render_rect_filled_alpha(renderer, x, y, w, h, 0x010204, 200);
+  civ_render_rect_outline(renderer, x, y, w, h, 0x1A2A3A, 1);
+
+  if (update_minimap(renderer, ctx, map, w, h)) {
+    civ_render_flush_batch();
+    SDL_FRect dst = {(float)x, (float)y, (float)w, (float)h};
+    SDL_RenderTexture(renderer, ctx->minimap_texture, NULL, &dst);
+  }
 
   /* Draw view rectangle */
   const float WORLD_UNIT_SIZE = 4.0f;
@@ -568,6 +1135,57 @@ void civ_render_minimap(SDL_Renderer *renderer, int x, int y, int w, int h,
                           (int)rect_h, 0xFFFFFF, 1);
 }
 
+/* ── Entity overlays ──────────────────────────────────────────────── */
+
+/* Grow *buf to hold n elements of size bytes */
+static bool reserve(void **buf, size_t *capacity, size_t n, size_t size) {
+  if (n <= *capacity) return true;
+  size_t cap = *capacity ? *capacity : 256;
+  while (cap < n) cap *= 2;
+  void *grown = realloc(*buf, cap * size);
+  if (!grown) return false;
+  *buf = grown;
+  *capacity = cap;
+  return true;
+}
+
+void civ_render_marker_clusters(SDL_Renderer *renderer,
+                                civ_render_map_context_t *ctx,
+                                const civ_render_marker_t *markers,
+                                size_t count, int win_w, int win_h) {
+  if (!renderer || !ctx || !markers || win_w <= 0 || win_h <= 0)
+    return;
+  const int CP = CIV_RENDER_CLUSTER_CELL_PX;
+  int cols = win_w / CP + 1, rows = win_h / CP + 1;
+  size_t cells = (size_t)cols * rows;
+  if (!reserve((void **)&ctx->clusters, &ctx->cluster_capacity, cells,
+               sizeof(civ_render_cluster_t)))
+    return;
+  memset(ctx->clusters, 0, cells * sizeof(civ_render_cluster_t));
+
+  for (size_t i = 0; i < count; i++) {
+    const civ_render_marker_t *m = &markers[i];
+    if (m->x < 0 || m->y < 0 || m->x >= win_w || m->y >= win_h) continue;
+    civ_render_cluster_t *c = &ctx->clusters[(int)m->y / CP * cols + (int)m->x / CP];
+    if (c->count++ == 0) c->color = m->color;
+    c->sum_x += m->x;
+    c->sum_y += m->y;
+  }
+
+  bool own_batch = renderer != g_batch_renderer;
+  if (own_batch) civ_render_begin_batch(renderer);
+  for (size_t i = 0; i < cells; i++) {
+    const civ_render_cluster_t *c = &ctx->clusters[i];
+    if (c->count == 0) continue;
+    float size = MIN((float)(CP - 4), 6.0f + 3.0f * log2f((float)c->count));
+    int x = (int)(c->sum_x / c->count - size / 2);
+    int y = (int)(c->sum_y / c->count - size / 2);
+    civ_render_rect_filled(renderer, x, y, (int)size, (int)size, c->color);
+    civ_render_rect_outline(renderer, x, y, (int)size, (int)size, 0xFFFFFF, 1);
+  }
+  if (own_batch) civ_render_end_batch();
+}
+
 void civ_render_settlements(SDL_Renderer *renderer,
                             civ_render_map_context_t *ctx,
                             civ_settlement_manager_t *manager, int win_w,
@@ -576,30 +1194,54 @@ void civ_render_settlements(SDL_Renderer *renderer,
     return;
 
   const float WORLD_UNIT_SIZE = 4.0f;
+  float scale = ctx->zoom * WORLD_UNIT_SIZE;
+  float size = 40.0f * ctx->zoom;
+  if (size < 4.0f)
+    size = 4.0f;
+
+  /* Window in world units, padded by a castle and its battlements */
+  float pad = 1.5f * size / scale;
+  float left = ctx->view_x - (win_w * 0.5f) / scale - pad;
+  float top = ctx->view_y - (win_h * 0.5f) / scale - pad;
+  float right = ctx->view_x + (win_w * 0.5f) / scale + pad;
+  float bottom = ctx->view_y + (win_h * 0.5f) / scale + pad;
+  size_t n = civ_settlement_manager_query_rect(manager, left, top, right, bottom,
+                                               ctx->entity_indices,
+                                               ctx->entity_capacity);
+  if (n > ctx->entity_capacity) {
+    if (!reserve((void **)&ctx->entity_indices, &ctx->entity_capacity, n,
+                 sizeof(size_t)))
+      return;
+    n = civ_settlement_manager_query_rect(manager, left, top, right, bottom,
+                                          ctx->entity_indices,
+                                          ctx->entity_capacity);
+  }
 
-  for (size_t i = 0; i < manager->settlement_count; i++) {
-    civ_settlement_t *s = &manager->settlements[i];
+  bool aggregate = size < ctx->cluster_min_px;
+  if (aggregate && !reserve((void **)&ctx->markers, &ctx->marker_capacity, n,
+                            sizeof(civ_render_marker_t)))
+    return;
+
+  bool own_batch = renderer != g_batch_renderer;
+  if (own_batch) civ_render_begin_batch(renderer);
+  for (size_t k = 0; k < n; k++) {
+    civ_settlement_t *s = &manager->settlements[ctx->entity_indices[k]];
 
     /* Convert world coords to screen coords */
-    float screen_x = (float)win_w / 2.0f +
-                     (s->x - ctx->view_x) * ctx->zoom * WORLD_UNIT_SIZE;
-    float screen_y = (float)win_h / 2.0f +
-                     (s->y - ctx->view_y) * ctx->zoom * WORLD_UNIT_SIZE;
-
-    float size = 40.0f * ctx->zoom;
-    if (size < 4.0f)
-      size = 4.0f;
-
-    /* Culling */
-    if (screen_x + size < 0 || screen_x - size > win_w || screen_y + size < 0 ||
-        screen_y - size > win_h)
-      continue;
+    float screen_x = (float)win_w / 2.0f + (s->x - ctx->view_x) * scale;
+    float screen_y = (float)win_h / 2.0f + (s->y - ctx->view_y) * scale;
 
     /* Draw Settlement Icon (Castle-like shape) */
     uint32_t icon_color = 0xFFCCCCCC; /* Silver/Stone */
     if (s->tier >= CIV_SETTLEMENT_CITY)
       icon_color = 0xFFFFD700; /* Gold for cities */
 
+    if (aggregate) {
+      ctx->markers[k] = (civ_render_marker_t){screen_x, screen_y,
+                                              icon_color & 0xFFFFFF};
+      continue;
+    }
+
     civ_render_rect_filled(renderer, (int)(screen_x - size / 2),
                            (int)(screen_y - size / 2), (int)size, (int)size,
                            icon_color);
@@ -615,68 +1257,159 @@ void civ_render_settlements(SDL_Renderer *renderer,
     civ_render_rect_filled(renderer, (int)(screen_x + size / 2 - b_size),
                            (int)(screen_y - size / 2 - b_size), (int)b_size,
                            (int)b_size, icon_color);
-
-    /* Note: Text labels (city name/pop) are usually rendered via civ_font
-       which isn't available in renderer.c easily.
-       We'll handle the labels in scene_game.c instead. */
   }
+  if (aggregate)
+    civ_render_marker_clusters(renderer, ctx, ctx->markers, n, win_w, win_h);
+  if (own_batch) civ_render_end_batch();
 }
 
 /* ── Border line rendering ──────────────────────────────────────────── */
+/* ── Border geometry ──────────────────────────────────────────────── */
+
+/* Whether the edge between owned land tile i and neighbour n is a border */
+static bool is_border(const civ_map_t *map, civ_owner_index_t owner, size_t n) {
+  civ_owner_index_t other = civ_map_owner_at(map, n);
+  return other != CIV_OWNER_NONE && other != owner && !civ_map_is_water_at(map, n);
+}
+
+static bool push_segment(civ_render_map_border_chunk_t *bc, float x0, float y0,
+                         float x1, float y1) {
+  if (bc->count == bc->capacity) {
+    int cap = bc->capacity ? bc->capacity * 2 : 64;
+    civ_render_border_segment_t *seg =
+        realloc(bc->segments, cap * sizeof(civ_render_border_segment_t));
+    if (!seg) return false;
+    bc->segments = seg;
+    bc->capacity = cap;
+  }
+  bc->segments[bc->count++] = (civ_render_border_segment_t){x0, y0, x1, y1};
+  return true;
+}
+
+/* East edge of tile (x, y), or south edge when south is set */
+static bool has_edge(const civ_map_t *map, int x, int y, bool south) {
+  size_t i = (size_t)y * map->width + x;
+  civ_owner_index_t owner = civ_map_owner_at(map, i);
+  if (owner == CIV_OWNER_NONE || civ_map_is_water_at(map, i)) return false;
+  if (south)
+    return y + 1 < map->height && is_border(map, owner, i + map->width);
+  return is_border(map, owner, (size_t)y * map->width + (x + 1) % map->width);
+}
+
+/* Re-extract one region's edges, merging runs along columns and rows */
+static void build_border_chunk(const civ_map_t *map,
+                               civ_render_map_border_chunk_t *bc, int cx,
+                               int cy) {
+  int x0 = cx * CIV_MAP_REGION_SIZE, y0 = cy * CIV_MAP_REGION_SIZE;
+  int x1 = MIN(map->width, x0 + CIV_MAP_REGION_SIZE);
+  int y1 = MIN(map->height, y0 + CIV_MAP_REGION_SIZE);
+  bc->count = 0;
+
+  for (int x = x0; x < x1; x++) {
+    for (int y = y0; y < y1; y++) {
+      if (!has_edge(map, x, y, false)) continue;
+      int run = y;
+      while (y + 1 < y1 && has_edge(map, x, y + 1, false)) y++;
+      push_segment(bc, (float)(x + 1), (float)run, (float)(x + 1), (float)(y + 1));
+    }
+  }
+  for (int y = y0; y < y1; y++) {
+    for (int x = x0; x < x1; x++) {
+      if (!has_edge(map, x, y, true)) continue;
+      int run = x;
+      while (x + 1 < x1 && has_edge(map, x + 1, y, true)) x++;
+      push_segment(bc, (float)run, (float)(y + 1), (float)(x + 1), (float)(y + 1));
+    }
+  }
+}
+
+/* Border chunk (cx, cy), rebuilt if it or a neighbour it reads moved */
+static civ_render_map_border_chunk_t *
+border_chunk(civ_render_map_context_t *ctx, const civ_map_t *map, int cx,
+             int cy) {
+  civ_render_map_border_chunk_t *bc = &ctx->border_chunks[cy * ctx->chunk_cols + cx];
+  uint32_t rev[3] = {
+      civ_map_region_revision(map, cx, cy),
+      civ_map_region_revision(map, (cx + 1) % ctx->chunk_cols, cy),
+      civ_map_region_revision(map, cx, MIN(cy + 1, ctx->chunk_rows - 1))};
+  if (bc->built && bc->revision[0] == rev[0] && bc->revision[1] == rev[1] &&
+      bc->revision[2] == rev[2])
+    return bc;
+  /* Under load a moved chunk keeps its old segments for a while */
+  Uint64 now = SDL_GetTicksNS();
+  if (bc->built && now - bc->built_ns < ctx->border_refresh_ns)
+    return bc;
+  build_border_chunk(map, bc, cx, cy);
+  memcpy(bc->revision, rev, sizeof(rev));
+  bc->built_ns = now;
+  bc->built = true;
+  return bc;
+}
+
+/* One-pixel quads for a chunk's segments, offset to screen space */
+static void draw_border_chunk(SDL_Renderer *renderer,
+                              civ_render_map_context_t *ctx,
+                              const civ_render_map_border_chunk_t *bc,
+                              float left, float top, float scale) {
+  int need = bc->count * 6;
+  if (need == 0) return;
+  if (need > ctx->border_vertices_capacity) {
+    SDL_Vertex *v = realloc(ctx->border_vertices, need * sizeof(SDL_Vertex));
+    if (!v) return;
+    ctx->border_vertices = v;
+    ctx->border_vertices_capacity = need;
+  }
+
+  const SDL_FColor color = {1.0f, 1.0f, 1.0f, 80.0f / 255.0f};
+  SDL_Vertex *v = ctx->border_vertices;
+  for (int s = 0; s < bc->count; s++, v += 6) {
+    const civ_render_border_segment_t *seg = &bc->segments[s];
+    float ax = (seg->x0 - left) * scale, ay = (seg->y0 - top) * scale;
+    float bx = (seg->x1 - left) * scale, by = (seg->y1 - top) * scale;
+    /* Widen across the segment: vertical runs in x, horizontal in y */
+    float hx = seg->x0 == seg->x1 ? 0.5f : 0.0f;
+    float hy = seg->x0 == seg->x1 ? 0.0f : 0.5f;
+    SDL_FPoint p[4] = {{ax - hx, ay - hy}, {ax + hx, ay + hy},
+                       {bx + hx, by + hy}, {bx - hx, by - hy}};
+    static const int corner[6] = {0, 1, 2, 0, 2, 3};
+    for (int k = 0; k < 6; k++)
+      v[k] = (SDL_Vertex){p[corner[k]], color, {0.0f, 0.0f}};
+  }
+  SDL_RenderGeometry(renderer, NULL, ctx->border_vertices, need, NULL, 0);
+}
+
 void civ_render_map_borders(SDL_Renderer *renderer,
                             civ_render_map_context_t *ctx,
                             civ_map_t *map, int fb_w, int fb_h) {
-  if (!renderer || !ctx || !map) return;
-
-  /* Only draw borders at sufficient zoom */
-  if (ctx->zoom < 1.0f) return;
+  if (!renderer || !ctx || !map || !bind_map(ctx, map)) return;
+  civ_render_flush_batch();
+  if (!ctx->border_chunks) {
+    ctx->border_chunks = calloc((size_t)ctx->chunk_cols * ctx->chunk_rows,
+                                sizeof(civ_render_map_border_chunk_t));
+    if (!ctx->border_chunks) return;
+  }
 
   const float U = 4.0f; /* WORLD_UNIT_SIZE */
-  float inv_scale = 1.0f / (ctx->zoom * U);
-
-  /* Compute visible tile range */
-  float half_w = (fb_w * 0.5f) * inv_scale;
-  float half_h = (fb_h * 0.5f) * inv_scale;
-
-  int tx_start = (int)(ctx->view_x - half_w) - 1;
-  int ty_start = (int)(ctx->view_y - half_h) - 1;
-  int tx_end   = (int)(ctx->view_x + half_w) + 1;
-  int ty_end   = (int)(ctx->view_y + half_h) + 1;
-
-  if (tx_start < 0) tx_start = 0;
-  if (ty_start < 0) ty_start = 0;
-  if (tx_end > map->width) tx_end = map->width;
-  if (ty_end > map->height) ty_end = map->height;
-
-  SDL_SetRenderDrawColor(renderer, 255, 255, 255, 80);
-
-  for (int ty = ty_start; ty < ty_end; ty++) {
-    for (int tx = tx_start; tx < tx_end; tx++) {
-      civ_map_tile_t *tile = civ_map_get_tile(map, tx, ty);
-      if (!tile || tile->land_use == CIV_LAND_USE_WATER) continue;
-
-      /* World-to-screen for this tile */
-      float sx = fb_w / 2.0f + (tx - ctx->view_x) * ctx->zoom * U;
-      float sy = fb_h / 2.0f + (ty - ctx->view_y) * ctx->zoom * U;
-      float ts = ctx->zoom * U; /* tile size on screen */
-
-      /* Check right neighbor */
-      int nx = (tx + 1) % map->width;
-      civ_map_tile_t *rt = civ_map_get_tile(map, nx, ty);
-      if (rt && rt->land_use != CIV_LAND_USE_WATER &&
-          tile->owner_id[0] && rt->owner_id[0] &&
-          strcmp(tile->owner_id, rt->owner_id) != 0) {
-        SDL_RenderLine(renderer, sx + ts, sy, sx + ts, sy + ts);
-      }
-
-      /* Check bottom neighbor */
-      if (ty + 1 < map->height) {
-        civ_map_tile_t *bt = civ_map_get_tile(map, tx, ty + 1);
-        if (bt && bt->land_use != CIV_LAND_USE_WATER &&
-            tile->owner_id[0] && bt->owner_id[0] &&
-            strcmp(tile->owner_id, bt->owner_id) != 0) {
-          SDL_RenderLine(renderer, sx, sy + ts, sx + ts, sy + ts);
-        }
+  const float CS = (float)CIV_MAP_REGION_SIZE;
+  float scale = ctx->zoom * U;
+  float left = ctx->view_x - (fb_w * 0.5f) / scale;
+  float top = ctx->view_y - (fb_h * 0.5f) / scale;
+  float right = left + fb_w / scale;
+  float bottom = top + fb_h / scale;
+
+  int cy0 = MAX(0, (int)floorf(top / CS));
+  int cy1 = MIN(ctx->chunk_rows - 1, (int)floorf(bottom / CS));
+  int rep0 = (int)floorf(left / (float)map->width);
+  int rep1 = (int)floorf(right / (float)map->width);
+
+  for (int cy = cy0; cy <= cy1; cy++) {
+    for (int rep = rep0; rep <= rep1; rep++) {
+      for (int cx = 0; cx < ctx->chunk_cols; cx++) {
+        float wx = (float)rep * map->width + cx * CS;
+        if (wx + CS <= left || wx >= right) continue;
+        /* Segments are in map coordinates; shift by the repeat */
+        draw_border_chunk(renderer, ctx, border_chunk(ctx, map, cx, cy),
+                          left - (float)rep * map->width, top, scale);
       }
     }
   }
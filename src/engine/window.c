@@ -119,6 +119,14 @@ void civ_window_present(civ_window_t *window) {
   SDL_RenderPresent(window->renderer);
 }
 
+bool civ_window_has_vsync(civ_window_t *window) {
+  int vsync = 0;
+  if (!window || !window->renderer ||
+      !SDL_GetRenderVSync(window->renderer, &vsync))
+    return false;
+  return vsync != 0;
+}
+
 void civ_window_get_size(civ_window_t *window, int *w, int *h) {
   if (!window || !window->sdl_window) {
     if (w)
@@ -0,0 +1,719 @@
+/**
+ * @file headless_main.c
+ * @brief Windowless batch simulation driver for throughput and balance runs.
+ *
+ * Links src/core, src/utils and src/visuals against SDL3 alone: no window,
+ * renderer, TTF or Nuklear.
+ * Runs civ_game_update / civ_game_end_turn back to back with a fixed delta
+ * and reports turns per second plus per-system timings.
+ *
+ *   dominion_headless --seed 42 --turns 500 [--map data/x.earth]
+ *                     [--updates-per-turn 1] [--workers 0] [--dt 1.0]
+ *                     [--record run.clog [--keyframe-every 25]]
+ *                     [--export-metrics run.csv]
+ *                     [--scenario nations=2000,settlements=20000,map=8192x4096]
+ *                     [--systems-csv scale.csv]
+ *                     [--hashes run.hash [--hashes-against base.hash]]
+ *                     [--startup-csv startup.csv] [--stores stores.csv]
+ *                     [--log warning,ai=debug] [--shards 8]
+ *                     [--query "select gdp where inflation > 8%"]
+ *                     [--export-stream run.cxdf [--stream-drop-events]]
+ *
+ * --replay re-executes a recorded session (from the app's --record or from
+ * here) at full speed with the recording's seed, map and delta, and reports
+ * the first turn whose state checksum differs; --seek-turn stops at that
+ * turn, starting from the newest keyframe save before it. A list of turns
+ * seeks to each in order, backwards too, the way a history scrubber does.
+ * --bisect finds the first desync by bisecting over the keyframes instead
+ * of replaying the whole recording.
+ *
+ *   dominion_headless --replay run.clog [--seek-turn 300[,120,...]] [--workers 0]
+ *   dominion_headless --replay run.clog --bisect
+ *
+ * --export-metrics writes the per-turn nation metric history at the end of
+ * the run: CSV for a .csv path, the compact block format otherwise.
+ *
+ * --scenario swaps the bundled world for a synthetic one (core/world/
+ * scenario.h). --systems-csv appends one row per system with the world's
+ * size, so runs at growing scales collect into a single scaling table.
+ *
+ * --hashes writes the per-turn subsystem state hashes (simulation_engine/
+ * state_hash.h); --hashes-against compares them with an earlier run's and
+ * names the first turn and subsystem that differ. Two builds, or one build
+ * with --workers 1 and --workers 0, should agree turn for turn.
+ *
+ * --startup-csv appends the load steps' timeline (utils/startup_timeline.h)
+ * for tools/startup_report.py, so cold-start regressions show up per build.
+ *
+ * --stores prints and writes the growable stores at the end of the run
+ * (utils/store_registry.h): count, capacity, bytes, growth per turn, and
+ * which ones are still scanned linearly past the size that warrants an index.
+ *
+ * --log filters civ_log by level, for every subsystem or one at a time
+ * (utils/logger.h); lines that pass are written by the logger thread.
+ *
+ * --shards partitions the world into N shards of whole nations
+ * (simulation_engine/shard_plan.h), prints the partition, and after every
+ * turn posts what crossed a shard line (border fronts that changed, trade
+ * routes between shards) through the exchange, reporting its volume.
+ *
+ * --query runs a query (core/data/query.h) on the query worker against the
+ * final state, after a run or a replay, and prints its rows.
+ *
+ * --export-stream writes a frame of what changed every turn
+ * (simulation_engine/delta_export.h) to a file, or through a FIFO to a
+ * live dashboard; --stream-drop-events drops the events of turns the
+ * reader fell behind on instead of carrying them over.
+ */
+
+#include "core/data/query.h"
+#include "core/game.h"
+#include "core/simulation_engine/shard_plan.h"
+#include "utils/io_service.h"
+#include "utils/logger.h"
+#include "utils/maintenance.h"
+#include "utils/paths.h"
+#include "utils/startup_timeline.h"
+#include "utils/store_registry.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+  uint32_t    seed;
+  const char *map_path;
+  int         turns;
+  int         updates_per_turn;
+  int         workers;
+  double      dt;
+  const char *record_path;
+  int         keyframe_every;
+  const char *replay_path;
+  const char *seek_turns;   /* comma-separated */
+  bool        bisect;
+  const char *metrics_path;
+  const char *systems_csv;
+  const char *hashes_path;
+  const char *hashes_against;
+  const char *startup_csv;
+  const char *stores_path;
+  const char *log_spec;
+  int         shards;
+  const char *query;
+  const char *stream_path;
+  bool        stream_drop_events;
+  bool        has_scenario;
+  civ_scenario_params_t scenario;
+} civ_headless_args_t;
+
+static void usage(const char *argv0) {
+  fprintf(stderr,
+          "usage: %s [--seed N] [--map PATH] [--turns N]\n"
+          "          [--updates-per-turn N] [--workers N] [--dt DAYS]\n"
+          "          [--record PATH [--keyframe-every N]] [--export-metrics PATH]\n"
+          "          [--scenario SPEC] [--systems-csv PATH]\n"
+          "          [--hashes PATH] [--hashes-against PATH]\n"
+          "          [--startup-csv PATH] [--stores PATH] [--log SPEC]\n"
+          "          [--shards N] [--query TEXT]\n"
+          "          [--export-stream PATH [--stream-drop-events]]\n"
+          "       %s --replay PATH [--seek-turn N[,N...] | --bisect] [--workers N]\n",
+          argv0, argv0);
+}
+
+static bool parse_args(int argc, char **argv, civ_headless_args_t *a) {
+  a->seed = CIV_GLOBAL_MAP_SEED;
+  a->map_path = NULL;
+  a->turns = 100;
+  a->updates_per_turn = 1;
+  a->workers = 0;
+  a->dt = 1.0;
+  a->record_path = NULL;
+  a->keyframe_every = 0;
+  a->replay_path = NULL;
+  a->seek_turns = NULL;
+  a->bisect = false;
+  a->metrics_path = NULL;
+  a->systems_csv = NULL;
+  a->hashes_path = NULL;
+  a->hashes_against = NULL;
+  a->startup_csv = NULL;
+  a->stores_path = NULL;
+  a->log_spec = NULL;
+  a->shards = 0;
+  a->query = NULL;
+  a->stream_path = NULL;
+  a->stream_drop_events = false;
+  a->has_scenario = false;
+
+  for (int i = 1; i < argc; i++) {
+    const char *opt = argv[i];
+    const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+    if (strcmp(opt, "--help") == 0 || strcmp(opt, "-h") == 0) return false;
+    if (strcmp(opt, "--bisect") == 0) {
+      a->bisect = true;
+      continue;
+    }
+    if (strcmp(opt, "--stream-drop-events") == 0) {
+      a->stream_drop_events = true;
+      continue;
+    }
+    if (!val) {
+      fprintf(stderr, "missing value for %s\n", opt);
+      return false;
+    }
+    if      (strcmp(opt, "--seed") == 0)  a->seed = (uint32_t)strtoul(val, NULL, 0);
+    else if (strcmp(opt, "--map") == 0)   a->map_path = val;
+    else if (strcmp(opt, "--turns") == 0) a->turns = atoi(val);
+    else if (strcmp(opt, "--updates-per-turn") == 0) a->updates_per_turn = atoi(val);
+    else if (strcmp(opt, "--workers") == 0) a->workers = atoi(val);
+    else if (strcmp(opt, "--dt") == 0)    a->dt = atof(val);
+    else if (strcmp(opt, "--record") == 0) a->record_path = val;
+    else if (strcmp(opt, "--keyframe-every") == 0) a->keyframe_every = atoi(val);
+    else if (strcmp(opt, "--replay") == 0) a->replay_path = val;
+    else if (strcmp(opt, "--seek-turn") == 0) a->seek_turns = val;
+    else if (strcmp(opt, "--export-metrics") == 0) a->metrics_path = val;
+    else if (strcmp(opt, "--systems-csv") == 0) a->systems_csv = val;
+    else if (strcmp(opt, "--hashes") == 0) a->hashes_path = val;
+    else if (strcmp(opt, "--hashes-against") == 0) a->hashes_against = val;
+    else if (strcmp(opt, "--startup-csv") == 0) a->startup_csv = val;
+    else if (strcmp(opt, "--stores") == 0) a->stores_path = val;
+    else if (strcmp(opt, "--log") == 0) a->log_spec = val;
+    else if (strcmp(opt, "--shards") == 0) a->shards = atoi(val);
+    else if (strcmp(opt, "--query") == 0) a->query = val;
+    else if (strcmp(opt, "--export-stream") == 0) a->stream_path = val;
+    else if (strcmp(opt, "--scenario") == 0) {
+      if (!civ_scenario_parse(val, &a->scenario)) {
+        fprintf(stderr, "bad scenario %s\n", val);
+        return false;
+      }
+      a->has_scenario = true;
+    }
+    else {
+      fprintf(stderr, "unknown option %s\n", opt);
+      return false;
+    }
+    i++;
+  }
+  if (a->turns < 1 || a->updates_per_turn < 0 || a->workers < 0 || a->dt <= 0.0) {
+    fprintf(stderr, "turns must be >= 1, dt > 0\n");
+    return false;
+  }
+  if (a->keyframe_every < 0) {
+    fprintf(stderr, "keyframe-every must be >= 0\n");
+    return false;
+  }
+  if (a->seek_turns) {
+    for (const char *p = a->seek_turns; *p; p++) {
+      if ((*p < '0' || *p > '9') && *p != ',') {
+        fprintf(stderr, "bad seek-turn list %s\n", a->seek_turns);
+        return false;
+      }
+    }
+  }
+  if ((a->seek_turns || a->bisect) && !a->replay_path) {
+    fprintf(stderr, "--seek-turn and --bisect need --replay\n");
+    return false;
+  }
+  if (a->seek_turns && a->bisect) {
+    fprintf(stderr, "--seek-turn and --bisect are exclusive\n");
+    return false;
+  }
+  if (a->shards < 0 || a->shards > CIV_SHARD_MAX) {
+    fprintf(stderr, "shards must be 0..%d\n", CIV_SHARD_MAX);
+    return false;
+  }
+  if (a->replay_path && a->record_path) {
+    fprintf(stderr, "--record and --replay are exclusive\n");
+    return false;
+  }
+  /* Recordings carry the seed and map path, not a scenario spec */
+  if (a->has_scenario && (a->record_path || a->replay_path)) {
+    fprintf(stderr, "--scenario cannot be recorded or replayed\n");
+    return false;
+  }
+  if (a->query) {
+    char error[128];
+    civ_query_t *q = civ_query_compile(a->query, error, sizeof(error));
+    if (!q) {
+      fprintf(stderr, "bad query: %s\n", error);
+      return false;
+    }
+    civ_query_destroy(q);
+  }
+  if (a->stream_drop_events && !a->stream_path) {
+    fprintf(stderr, "--stream-drop-events needs --export-stream\n");
+    return false;
+  }
+  if (a->seed == 0) a->seed = CIV_GLOBAL_MAP_SEED;
+  return true;
+}
+
+static int cmp_status_total(const void *a, const void *b) {
+  const civ_system_status_t *sa = *(const civ_system_status_t *const *)a;
+  const civ_system_status_t *sb = *(const civ_system_status_t *const *)b;
+  if (sa->total_update_time < sb->total_update_time) return 1;
+  if (sa->total_update_time > sb->total_update_time) return -1;
+  return 0;
+}
+
+static void report_systems(civ_system_orchestrator_t *so, double wall_ms) {
+  if (!so || so->system_count == 0) return;
+  civ_system_status_t **rows = CIV_MALLOC(sizeof(*rows) * so->system_count);
+  if (!rows) return;
+  for (size_t i = 0; i < so->system_count; i++) rows[i] = &so->nodes[i].status;
+  qsort(rows, so->system_count, sizeof(*rows), cmp_status_total);
+
+  printf("\n%-22s %10s %10s %10s %7s\n", "system", "calls", "total ms",
+         "avg ms", "share");
+  for (size_t i = 0; i < so->system_count; i++) {
+    const civ_system_status_t *st = rows[i];
+    printf("%-22s %10llu %10.2f %10.4f %6.1f%%\n", st->name,
+           (unsigned long long)st->update_count, st->total_update_time,
+           st->update_count ? st->total_update_time / (double)st->update_count : 0.0,
+           wall_ms > 0.0 ? 100.0 * st->total_update_time / wall_ms : 0.0);
+  }
+  CIV_FREE(rows);
+}
+
+/* One row per system, appended; the header goes into a new file only */
+static void export_systems(civ_game_t *game, const char *path, int turns,
+                           double run_ms) {
+  civ_system_orchestrator_t *so = game->system_orchestrator;
+  if (!path || !so) return;
+  FILE *f = fopen(path, "a");
+  if (!f) {
+    fprintf(stderr, "Cannot append to %s\n", path);
+    return;
+  }
+  if (ftell(f) == 0)
+    fprintf(f, "map_width,map_height,tiles,nations,settlements,units,turns,"
+               "ms_per_turn,system,calls,total_ms,avg_ms\n");
+  civ_nation_manager_t *nm = (civ_nation_manager_t *)game->nation_manager;
+  const civ_map_t *map = game->world_map;
+  for (size_t i = 0; i < so->system_count; i++) {
+    const civ_system_status_t *st = &so->nodes[i].status;
+    fprintf(f, "%d,%d,%zu,%d,%zu,%zu,%d,%.4f,%s,%llu,%.3f,%.5f\n",
+            map ? (int)map->width : 0, map ? (int)map->height : 0,
+            map ? (size_t)map->width * map->height : 0, nm ? nm->count : 0,
+            game->settlement_manager ? game->settlement_manager->settlement_count : 0,
+            game->unit_manager ? game->unit_manager->unit_count : 0, turns,
+            run_ms / turns, st->name, (unsigned long long)st->update_count,
+            st->total_update_time,
+            st->update_count ? st->total_update_time / (double)st->update_count
+                             : 0.0);
+  }
+  fclose(f);
+}
+
+static void export_metrics(civ_game_t *game, const char *path) {
+  const civ_time_series_t *ts = game->metrics_history;
+  if (!path || !ts) return;
+  civ_nation_manager_t *nm = (civ_nation_manager_t *)game->nation_manager;
+  const char **names = NULL;
+  if (nm && nm->count >= ts->nation_count && ts->nation_count > 0) {
+    names = CIV_MALLOC(sizeof(*names) * (size_t)ts->nation_count);
+    for (int i = 0; names && i < ts->nation_count; i++)
+      names[i] = nm->nations[i].id;
+  }
+  size_t len = strlen(path);
+  bool csv = len >= 4 && strcmp(path + len - 4, ".csv") == 0;
+  civ_result_t r = csv ? civ_time_series_export_csv(ts, path, names)
+                       : civ_time_series_export_binary(ts, path);
+  CIV_FREE(names);
+  if (CIV_FAILED(r))
+    fprintf(stderr, "Metric export failed: %s\n", r.message ? r.message : "?");
+  else
+    printf("metrics       %10zu samples x %d nations -> %s (%.1f KiB held)\n",
+           ts->sample_count, ts->nation_count, path,
+           (double)civ_time_series_bytes(ts) / 1024.0);
+}
+
+/* Run --query on the query worker, inline when it has no thread */
+static void run_query(civ_game_t *game, const char *text) {
+  if (!text) return;
+  civ_query_t *q = civ_query_compile(text, NULL, 0);
+  civ_query_worker_t *w = civ_query_worker_create();
+  civ_query_result_t r;
+  civ_result_t st = {CIV_ERROR_OUT_OF_MEMORY, "No query snapshot"};
+  uint64_t start = SDL_GetTicksNS();
+  if (q && w && civ_query_worker_submit(w, game, q)) {
+    civ_query_worker_wait(w);
+    civ_query_worker_take_result(w, &r, &st);
+  } else if (q && !w) {
+    civ_query_snapshot_t *snap = civ_query_snapshot_take(game, q);
+    if (snap) st = civ_query_run(q, snap, &r);
+    civ_query_snapshot_destroy(snap);
+  }
+  double ms = (double)(SDL_GetTicksNS() - start) / 1e6;
+  civ_query_worker_destroy(w);
+  civ_query_destroy(q);
+  if (CIV_FAILED(st)) {
+    fprintf(stderr, "Query failed: %s\n", st.message ? st.message : "?");
+    return;
+  }
+
+  printf("\n=== query: %zu rows at turn %d (%.2f ms) ===\n", r.row_count,
+         r.turn, ms);
+  printf("%-24s", "nation");
+  for (int c = 0; c < r.column_count; c++) printf(" %14.14s", r.columns[c]);
+  printf("\n");
+  for (size_t i = 0; i < r.row_count; i++) {
+    printf("%-24.24s", r.nations[i] >= 0 ? r.names[i] : "(all)");
+    for (int c = 0; c < r.column_count; c++)
+      printf(" %14.6g", r.values[i * (size_t)r.column_count + c]);
+    printf("\n");
+  }
+  civ_query_result_free(&r);
+}
+
+/* Write and/or check the state hash history; 3 on a divergence */
+static int check_hashes(civ_game_t *game, const civ_headless_args_t *args) {
+  const civ_state_hash_t *sh = game->state_hashes;
+  if (!sh) return 0;
+  if (!civ_state_hash_verify_tiles(sh, game->world_map))
+    printf("hashes        tile writes bypassed the region revisions\n");
+  if (args->hashes_path) {
+    civ_result_t r = civ_state_hash_export(sh, args->hashes_path);
+    if (CIV_FAILED(r))
+      fprintf(stderr, "Hash export failed: %s\n", r.message ? r.message : "?");
+    else
+      printf("hashes        %10zu turns -> %s\n", sh->count, args->hashes_path);
+  }
+  if (!args->hashes_against) return 0;
+  civ_state_hash_t *base = civ_state_hash_load(args->hashes_against);
+  if (!base) {
+    fprintf(stderr, "Cannot read state hashes %s\n", args->hashes_against);
+    return 1;
+  }
+  int32_t turn = 0;
+  civ_state_hash_part_t part = CIV_STATE_HASH_TILES;
+  bool diverged = civ_state_hash_compare(base, sh, &turn, &part);
+  civ_state_hash_destroy(base);
+  if (diverged) {
+    printf("DIVERGED      first at turn %d in %s\n", turn,
+           civ_state_hash_part_name(part));
+    return 3;
+  }
+  printf("hashes match  %s\n", args->hashes_against);
+  return 0;
+}
+
+static void export_stores(const char *path) {
+  if (!path) return;
+  printf("stores        %10d tracked\n", civ_store_registry_count());
+  civ_store_registry_dump(stdout);
+  civ_result_t r = civ_store_registry_export_csv(path);
+  if (CIV_FAILED(r))
+    fprintf(stderr, "Store export failed: %s\n", r.message ? r.message : "?");
+}
+
+/* Let the stream's writer catch up, then say what it carried */
+static void report_stream(civ_delta_export_t *x) {
+  if (!x) return;
+  civ_delta_export_drain(x);
+  civ_delta_export_stats_t st;
+  civ_delta_export_get_stats(x, &st);
+  printf("stream        %10llu frames, %llu coalesced turns, %llu events lost\n",
+         (unsigned long long)st.frames_written,
+         (unsigned long long)st.turns_coalesced,
+         (unsigned long long)st.events_lost);
+  printf("  written     %10.1f KiB of %.1f KiB, queue peak %zu%s\n",
+         (double)st.bytes_written / 1024.0, (double)st.bytes_raw / 1024.0,
+         st.queue_peak, st.failed ? "  (write failed)" : "");
+}
+
+/* Re-execute a recording on game, which was set up from its header */
+static void report_shard_plan(const civ_shard_plan_t *plan) {
+  uint64_t total = 0, heaviest = 0;
+  for (int32_t s = 0; s < plan->shard_count; s++) {
+    total += plan->land[s];
+    heaviest = MAX(heaviest, plan->land[s]);
+  }
+  printf("\n=== %d shards, %dx%d regions ===\n", plan->shard_count,
+         plan->region_cols, plan->region_rows);
+  printf("  shard      land tiles  nations  regions\n");
+  for (int32_t s = 0; s < plan->shard_count; s++)
+    printf("  %5d  %14llu  %7u  %7u\n", s,
+           (unsigned long long)plan->land[s], plan->owners[s],
+           plan->regions[s]);
+  double mean = total ? (double)total / plan->shard_count : 0.0;
+  printf("  imbalance %.2fx mean, %zu cross-shard fronts\n",
+         mean > 0.0 ? (double)heaviest / mean : 0.0, plan->contact_count);
+}
+
+static void post_shard_message(civ_shard_exchange_t *ex, uint16_t kind,
+                               uint16_t from, uint16_t to,
+                               civ_owner_index_t a, civ_owner_index_t b,
+                               double value) {
+  civ_shard_message_t msg = {0};
+  msg.kind = kind;
+  msg.from = from;
+  msg.to = to;
+  msg.a = a;
+  msg.b = b;
+  msg.value = value;
+  civ_shard_exchange_post(ex, &msg);
+}
+
+/* What crossed a shard line this turn, delivered at the boundary; each side
+   of a changed front tells the other */
+static void exchange_shard_turn(civ_game_t *game, civ_shard_plan_t *plan,
+                                civ_shard_exchange_t *ex) {
+  civ_shard_plan_refresh(plan, game->world_map);
+  for (size_t i = 0; i < plan->contact_count; i++) {
+    const civ_shard_contact_t *c = &plan->contacts[i];
+    if (c->contact == c->previous) continue;
+    post_shard_message(ex, CIV_SHARD_MSG_BORDER, c->shard_a, c->shard_b,
+                       c->a, c->b, c->contact);
+    post_shard_message(ex, CIV_SHARD_MSG_BORDER, c->shard_b, c->shard_a,
+                       c->b, c->a, c->contact);
+  }
+  const civ_trade_manager_t *trade = game->trade_manager;
+  for (size_t i = 0; trade && i < trade->route_count; i++) {
+    const civ_trade_route_t *r = &trade->routes[i];
+    if (!r->active) continue;
+    civ_owner_index_t a = civ_owner_find(r->source_nation_id);
+    civ_owner_index_t b = civ_owner_find(r->target_nation_id);
+    uint16_t sa = civ_shard_of_owner(plan, a), sb = civ_shard_of_owner(plan, b);
+    if (sa == CIV_SHARD_NONE || sb == CIV_SHARD_NONE || sa == sb) continue;
+    post_shard_message(ex, CIV_SHARD_MSG_TRADE, sa, sb, a, b, r->amount);
+  }
+  civ_shard_exchange_deliver(ex);
+}
+
+static void report_shard_exchange(const civ_shard_exchange_t *ex, int turns,
+                                  double exchange_ms) {
+  civ_shard_exchange_stats_t st;
+  civ_shard_exchange_stats(ex, &st);
+  printf("shard exchange  %llu messages (%llu border, %llu trade), %.1f KB\n",
+         (unsigned long long)st.messages,
+         (unsigned long long)st.by_kind[CIV_SHARD_MSG_BORDER],
+         (unsigned long long)st.by_kind[CIV_SHARD_MSG_TRADE],
+         (double)st.bytes / 1024.0);
+  printf("  per turn      %.1f mean, %zu peak, %.2f ms to collect\n",
+         turns > 0 ? (double)st.messages / turns : 0.0, st.peak_turn,
+         turns > 0 ? exchange_ms / turns : 0.0);
+}
+
+/* One seek of a --seek-turn list; 0 replays to the end */
+static civ_result_t seek_once(civ_game_t *game, const civ_command_log_t *log,
+                              int turn, civ_replay_stats_t *stats) {
+  uint64_t start = SDL_GetTicksNS();
+  civ_result_t r = turn > 0 ? civ_command_seek(game, log, turn, stats)
+                            : civ_command_replay(game, log, 0, stats);
+  if (CIV_FAILED(r))
+    fprintf(stderr, "Seek to turn %d failed: %s\n", turn,
+            r.message ? r.message : "?");
+  else
+    printf("seek %6d    from turn %6d, %5d turns in %8.1f ms\n", turn,
+           stats->start_turn, stats->turns,
+           (double)(SDL_GetTicksNS() - start) / 1e6);
+  return r;
+}
+
+static int run_replay(civ_game_t *game, const civ_command_log_t *log,
+                      const civ_headless_args_t *args) {
+  civ_replay_stats_t stats, total;
+  memset(&total, 0, sizeof(total));
+  total.start_turn = game->current_turn;
+  uint64_t start = SDL_GetTicksNS();
+  civ_result_t r = {CIV_OK, NULL};
+  int seeks = 0;
+  if (args->bisect) {
+    r = civ_command_bisect(game, log, &total);
+  } else if (!args->seek_turns) {
+    r = civ_command_replay(game, log, 0, &total);
+  } else {
+    const char *p = args->seek_turns;
+    for (; *p && !CIV_FAILED(r); seeks++) {
+      r = seek_once(game, log, atoi(p), &stats);
+      total.commands += stats.commands;
+      total.turns += stats.turns;
+      if (!total.first_desync) total.first_desync = stats.first_desync;
+      while (*p && *p != ',') p++;
+      if (*p == ',') p++;
+    }
+  }
+  double ms = (double)(SDL_GetTicksNS() - start) / 1e6;
+  if (CIV_FAILED(r)) {
+    if (!args->seek_turns) /* seek_once named the seek that failed */
+      fprintf(stderr, "Replay failed: %s\n", r.message ? r.message : "?");
+    return 1;
+  }
+
+  printf("\n=== %s: %zu commands in %s ===\n", args->bisect ? "bisect" : "replay",
+         log->count, log->path);
+  if (seeks > 0) {
+    /* Each seek has its own start turn, printed on its line above */
+    printf("replayed      %10zu commands, %d turns, summed over %d seeks\n",
+           total.commands, total.turns, seeks);
+  } else {
+    printf("start turn    %10d%s\n", total.start_turn,
+           total.start_turn > 1 ? "   (keyframe)" : "");
+    printf("replayed      %10zu commands, %d turns\n", total.commands,
+           total.turns);
+  }
+  printf("run           %10.1f ms  (%.1f turns/sec)\n", ms,
+         ms > 0.0 ? total.turns * 1000.0 / ms : 0.0);
+  printf("final turn    %10d   checksum %08x\n", game->current_turn,
+         civ_command_state_checksum(game));
+  if (total.first_desync) {
+    printf("DESYNC        first at turn %d\n", total.first_desync);
+    return 3;
+  }
+  printf("in sync\n");
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  civ_headless_args_t args;
+  if (!parse_args(argc, argv, &args)) {
+    usage(argv[0]);
+    return 2;
+  }
+  civ_startup_timeline_init(args.startup_csv);
+  if (!civ_logger_configure(args.log_spec)) {
+    fprintf(stderr, "bad log filter %s\n", args.log_spec);
+    return 2;
+  }
+  /* All three stop, and drain, at exit */
+  civ_logger_start();
+  civ_io_service_start();
+  civ_maintenance_start();
+
+  {
+    const char *base = SDL_GetBasePath();
+    civ_path_init(base ? base : "./");
+  }
+
+  civ_command_log_t *replay = NULL;
+  if (args.replay_path) {
+    replay = civ_command_log_open(args.replay_path);
+    if (!replay) {
+      fprintf(stderr, "Cannot read recording %s\n", args.replay_path);
+      return 1;
+    }
+    args.seed = (uint32_t)replay->seed;
+    args.map_path = replay->map_path[0] ? replay->map_path : NULL;
+    args.dt = replay->fixed_dt;
+  }
+  srand(args.seed);  /* draws outside any keyed stream fall back to rand() */
+
+  civ_game_t *game = civ_game_create();
+  if (!game) {
+    fprintf(stderr, "Failed to create game\n");
+    civ_command_log_destroy(replay);
+    return 1;
+  }
+  game->map_seed = args.seed;
+  game->map_path = args.map_path;
+  game->max_workers = (uint32_t)args.workers;
+  game->fixed_dt = args.dt;
+  if (args.has_scenario) game->scenario = &args.scenario;
+  if (args.record_path) {
+    game->command_log = civ_command_log_create(args.record_path, game);
+    if (!game->command_log) {
+      fprintf(stderr, "Cannot record to %s\n", args.record_path);
+      civ_game_destroy(game);
+      return 1;
+    }
+    game->command_log->keyframe_every = args.keyframe_every;
+  }
+
+  civ_game_config_t config;
+  civ_game_get_default_config(&config);
+  uint64_t boot_start = SDL_GetTicksNS();
+  civ_result_t init_result = civ_game_initialize(game, &config);
+  if (CIV_FAILED(init_result)) {
+    fprintf(stderr, "Game initialization failed: %s\n",
+            init_result.message ? init_result.message : "Unknown error");
+    civ_game_destroy(game);
+    civ_command_log_destroy(replay);
+    return 1;
+  }
+  double boot_ms = (double)(SDL_GetTicksNS() - boot_start) / 1e6;
+  civ_startup_timeline_ready();
+  if (args.stream_path) {
+    game->delta_export =
+        civ_delta_export_open(args.stream_path, !args.stream_drop_events);
+    if (!game->delta_export) {
+      fprintf(stderr, "Cannot stream to %s\n", args.stream_path);
+      civ_game_destroy(game);
+      civ_command_log_destroy(replay);
+      return 1;
+    }
+  }
+
+  if (replay) {
+    printf("boot          %10.1f ms\n", boot_ms);
+    int rc = run_replay(game, replay, &args);
+    run_query(game, args.query);
+    export_metrics(game, args.metrics_path);
+    export_stores(args.stores_path);
+    report_stream(game->delta_export);
+    int hash_rc = check_hashes(game, &args);
+    if (rc == 0) rc = hash_rc;
+    civ_game_destroy(game);
+    civ_command_log_destroy(replay);
+    return rc;
+  }
+
+  civ_shard_plan_t *shards = NULL;
+  civ_shard_exchange_t *exchange = NULL;
+  if (args.shards > 0) {
+    shards = civ_shard_plan_build(game->world_map, args.shards);
+    exchange = civ_shard_exchange_create(args.shards);
+    if (!shards || !exchange) {
+      fprintf(stderr, "Cannot partition the world into %d shards\n", args.shards);
+      civ_shard_plan_destroy(shards);
+      civ_shard_exchange_destroy(exchange);
+      civ_game_destroy(game);
+      return 1;
+    }
+    report_shard_plan(shards);
+  }
+
+  uint64_t update_ns = 0, end_turn_ns = 0, exchange_ns = 0;
+  uint64_t run_start = SDL_GetTicksNS();
+  for (int t = 0; t < args.turns; t++) {
+    uint64_t t0 = SDL_GetTicksNS();
+    for (int u = 0; u < args.updates_per_turn; u++)
+      civ_game_update(game);
+    uint64_t t1 = SDL_GetTicksNS();
+    civ_game_end_turn(game);
+    uint64_t t2 = SDL_GetTicksNS();
+    update_ns += t1 - t0;
+    end_turn_ns += t2 - t1;
+    if (shards) {
+      exchange_shard_turn(game, shards, exchange);
+      exchange_ns += SDL_GetTicksNS() - t2;
+    }
+  }
+  double run_ms = (double)(SDL_GetTicksNS() - run_start) / 1e6;
+
+  printf("\n=== headless run: seed %u, %d turns x %d updates ===\n",
+         args.seed, args.turns, args.updates_per_turn);
+  printf("boot          %10.1f ms\n", boot_ms);
+  printf("run           %10.1f ms  (%.1f turns/sec)\n", run_ms,
+         run_ms > 0.0 ? args.turns * 1000.0 / run_ms : 0.0);
+  printf("  update      %10.1f ms\n", (double)update_ns / 1e6);
+  printf("  end_turn    %10.1f ms\n", (double)end_turn_ns / 1e6);
+  printf("final turn    %10d   global GDP %.1fM\n", game->current_turn,
+         game->global_economy.gdp);
+  report_systems(game->system_orchestrator, (double)update_ns / 1e6);
+  if (shards) {
+    report_shard_exchange(exchange, args.turns, (double)exchange_ns / 1e6);
+    civ_shard_plan_destroy(shards);
+    civ_shard_exchange_destroy(exchange);
+  }
+  export_systems(game, args.systems_csv, args.turns, run_ms);
+  run_query(game, args.query);
+  export_metrics(game, args.metrics_path);
+  export_stores(args.stores_path);
+  report_stream(game->delta_export);
+  int rc = check_hashes(game, &args);
+
+  civ_game_destroy(game);
+  return rc;
+}
@@ -1,25 +1,95 @@
 #include "ui/app_controller.h"
 #include "display/theme.h"
 #include "engine/font.h"
+#include "core/ai/ai_system.h"
+#include "engine/frame_pacer.h"
+#include "engine/quality_governor.h"
 #include "ui/scene.h"
 #include "ui/ui_common.h"
+#include "ui/hit_grid.h"
 #include "ui/nuklear_ui.h"
+#include "ui/screens/screen_metrics.h"
+#include "utils/frame_trace.h"
+#include "utils/io_service.h"
+#include "utils/logger.h"
+#include "utils/maintenance.h"
+#include "utils/mem_tags.h"
 #include "utils/paths.h"
+#include "utils/startup_timeline.h"
 #include <SDL3/SDL.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 civ_window_mgr_t *g_window_mgr = NULL;
 
+/* --tick-hz N overrides the simulation rate */
+static int parse_tick_hz(int argc, char **argv) {
+  for (int i = 1; i + 1 < argc; i++) {
+    if (strcmp(argv[i], "--tick-hz") == 0)
+      return atoi(argv[i + 1]);
+  }
+  return CIV_SIM_DEFAULT_TICK_HZ;
+}
+
+/* --hitch-ms N: frames whose work runs longer are dumped (0 = never) */
+static double parse_hitch_ms(int argc, char **argv) {
+  for (int i = 1; i + 1 < argc; i++) {
+    if (strcmp(argv[i], "--hitch-ms") == 0)
+      return atof(argv[i + 1]);
+  }
+  return CIV_FRAME_TRACE_DEFAULT_MS;
+}
+
+/* --no-governor keeps every quality knob at full detail */
+static bool parse_governed(int argc, char **argv) {
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--no-governor") == 0)
+      return false;
+  }
+  return true;
+}
+
+/* --startup-csv PATH appends the startup timeline there ("" = nowhere) */
+static const char *parse_startup_csv(int argc, char **argv) {
+  for (int i = 1; i + 1 < argc; i++) {
+    if (strcmp(argv[i], "--startup-csv") == 0)
+      return argv[i + 1][0] ? argv[i + 1] : NULL;
+  }
+  return CIV_STARTUP_DEFAULT_CSV;
+}
+
+/* --log SPEC filters civ_log, e.g. "warning,ai=debug" */
+static const char *parse_log_spec(int argc, char **argv) {
+  for (int i = 1; i + 1 < argc; i++) {
+    if (strcmp(argv[i], "--log") == 0)
+      return argv[i + 1];
+  }
+  return NULL;
+}
+
+/* --record PATH logs the session for dominion_headless --replay */
+static const char *parse_record_path(int argc, char **argv) {
+  for (int i = 1; i + 1 < argc; i++) {
+    if (strcmp(argv[i], "--record") == 0)
+      return argv[i + 1];
+  }
+  return NULL;
+}
+
 civ_result_t civ_app_controller_init(civ_app_controller_t *app, int argc,
                                      char **argv) {
-  (void)argc;
-  (void)argv;
-
   if (!app)
     return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null app controller"};
 
   memset(app, 0, sizeof(*app));
+  civ_startup_timeline_init(parse_startup_csv(argc, argv));
+  const char *log_spec = parse_log_spec(argc, argv);
+  if (!civ_logger_configure(log_spec))
+    fprintf(stderr, "Ignoring parts of --log %s\n", log_spec);
+  civ_logger_start();
+  civ_io_service_start();
+  civ_maintenance_start();
 
   /* Resolve asset base path from executable location */
   {
@@ -31,19 +101,27 @@ civ_result_t civ_app_controller_init(civ_app_controller_t *app, int argc,
   /* Initialize theme BEFORE any widgets or scenes use it */
   civ_theme_init_default();
 
-  if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS)) {
+  int step = civ_startup_step_begin("SDL");
+  bool sdl_ok = SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS);
+  civ_startup_step_end(step);
+  if (!sdl_ok) {
     return (civ_result_t){CIV_ERROR_INITIALIZATION_FAILED,
                           "Failed to initialize SDL"};
   }
 
-  if (!civ_font_system_init()) {
+  step = civ_startup_step_begin("Fonts");
+  bool fonts_ok = civ_font_system_init();
+  civ_startup_step_end(step);
+  if (!fonts_ok) {
     SDL_Quit();
     return (civ_result_t){CIV_ERROR_INITIALIZATION_FAILED,
                           "Failed to initialize font system"};
   }
 
+  step = civ_startup_step_begin("Window");
   app->window =
       civ_window_create("Dominion", 1280, 720, CIV_WINDOW_RESIZABLE);
+  civ_startup_step_end(step);
   if (!app->window) {
     civ_font_system_shutdown();
     SDL_Quit();
@@ -54,8 +132,10 @@ civ_result_t civ_app_controller_init(civ_app_controller_t *app, int argc,
   civ_input_init(&app->input);
 
   /* Initialize Nuklear UI on the SDL renderer */
+  step = civ_startup_step_begin("UI and font atlas");
   nk_ui_init(civ_window_get_sdl_window(app->window),
              civ_window_get_renderer(app->window));
+  civ_startup_step_end(step);
 
   app->game = civ_game_create();
   if (!app->game) {
@@ -63,23 +143,86 @@ civ_result_t civ_app_controller_init(civ_app_controller_t *app, int argc,
     return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, "Failed to create game"};
   }
 
+  const char *record_path = parse_record_path(argc, argv);
+  if (record_path) {
+    app->game->command_log = civ_command_log_create(record_path, app->game);
+    if (!app->game->command_log)
+      fprintf(stderr, "Cannot record to %s\n", record_path);
+  }
+
+  /* The world loads on a loader thread behind the splash and menu; the
+     sim starts once it is done */
   civ_game_config_t config;
   civ_game_get_default_config(&config);
-  civ_result_t init_result = civ_game_initialize(app->game, &config);
-  if (CIV_FAILED(init_result)) {
+  civ_result_t load_result = civ_game_load_start(app->game, &config);
+  if (CIV_FAILED(load_result)) {
     civ_app_controller_shutdown(app);
-    return init_result;
+    return load_result;
   }
+  app->tick_hz = parse_tick_hz(argc, argv);
+  app->governed = parse_governed(argc, argv);
 
   civ_scene_manager_init();
   civ_window_mgr_init(&app->window_mgr);
   g_window_mgr = &app->window_mgr;
+  civ_frame_pacer_init(CIV_FRAME_PACER_DEFAULT_HZ,
+                       civ_window_has_vsync(app->window));
+  civ_frame_trace_init(parse_hitch_ms(argc, argv));
   app->last_frame_time = SDL_GetTicksNS();
   app->running = true;
 
   return (civ_result_t){CIV_OK, NULL};
 }
 
+/* Tick hook: sim-side quality knobs, then the screens' view models every
+   few ticks */
+static void publish_screen_views(civ_game_t *game, void *user_data) {
+  civ_app_controller_t *app = user_data;
+
+  /* Sim-side quality knobs. Nation LOD changes results, so a recorded or
+     lockstep session, which must run bit for bit alike, keeps it as
+     defined. */
+  civ_ai_system_set_budget_scale(
+      game->ai_system, civ_quality_governor_value(CIV_QUALITY_AI_BUDGET_SCALE));
+  civ_nation_manager_t *nm = (civ_nation_manager_t *)game->nation_manager;
+  if (nm && !civ_game_deterministic(game))
+    nm->lod_distance_scale =
+        civ_quality_governor_value(CIV_QUALITY_NATION_LOD_SCALE);
+
+  int every = (int)civ_quality_governor_value(CIV_QUALITY_VIEW_REFRESH_TICKS);
+  if (++app->view_ticks < every)
+    return;
+  app->view_ticks = 0;
+  civ_screen_metrics_publish(game);
+}
+
+/* Join the finished load and start the simulation on the loaded game */
+static civ_result_t finish_loading(civ_app_controller_t *app) {
+  civ_result_t init_result = civ_game_load_finish(app->game);
+  if (CIV_FAILED(init_result))
+    return init_result;
+  app->loaded = true;
+  civ_startup_timeline_ready();
+
+  app->sim = civ_sim_thread_create(app->game, app->tick_hz);
+  if (!app->sim)
+    return (civ_result_t){CIV_ERROR_INITIALIZATION_FAILED,
+                          "Failed to create simulation thread"};
+  app->game->sim_thread = app->sim;
+  /* Screens read view models built right after each tick */
+  civ_sim_thread_set_tick_hook(app->sim, publish_screen_views, app);
+  /* Without a thread the frame loop pumps the same ticks */
+  if (!civ_sim_thread_start(app->sim))
+    fprintf(stderr, "Ticking the simulation from the frame loop\n");
+
+  /* Frames get the pacer's interval of CPU, ticks half of theirs */
+  int tick_hz = civ_sim_thread_get_tick_rate(app->sim);
+  civ_quality_governor_init(
+      app->governed ? 1000.0 / CIV_FRAME_PACER_DEFAULT_HZ : 0.0,
+      tick_hz > 0 ? 500.0 / tick_hz : 0.0);
+  return (civ_result_t){CIV_OK, NULL};
+}
+
 void civ_app_controller_run(civ_app_controller_t *app) {
   if (!app || !app->window)
     return;
@@ -88,13 +231,16 @@ void civ_app_controller_run(civ_app_controller_t *app) {
 
   while (app->running) {
     Uint64 current_time = SDL_GetTicksNS();
-    app->delta_time =
-        (float)(current_time - app->last_frame_time) / 1000000000.0f;
+    Uint64 interval_ns = current_time - app->last_frame_time;
+    app->delta_time = (float)interval_ns / 1000000000.0f;
     app->last_frame_time = current_time;
+    civ_frame_pacer_begin_frame();
 
     civ_input_begin_frame(&app->input);
 
     while (SDL_PollEvent(&event)) {
+      civ_frame_trace_count(CIV_FRAME_EVENTS_DISPATCHED, 1);
+      civ_frame_pacer_note_activity();
       civ_input_process_event(&app->input, &event);
       nk_ui_handle_event(&event);
 
@@ -115,6 +261,32 @@ void civ_app_controller_run(civ_app_controller_t *app) {
       app->running = false;
     }
 
+    if (!app->loaded && civ_game_is_loaded(app->game)) {
+      civ_result_t r = finish_loading(app);
+      if (CIV_FAILED(r)) {
+        fprintf(stderr, "Failed to initialize game: %s\n",
+                r.message ? r.message : "unknown error");
+        app->running = false;
+        break;
+      }
+    }
+    if (!app->loaded)
+      civ_frame_pacer_note_activity(); /* keep the progress moving */
+
+    /* A paused sim still ticks; only a new day or turn changes the screen */
+    civ_sim_snapshot_t snap;
+    bool have_snap = app->sim && civ_sim_thread_get_snapshot(app->sim, &snap);
+    if (have_snap &&
+        (snap.turn != app->sim_turn || snap.global_day != app->sim_day)) {
+      app->sim_turn = snap.turn;
+      app->sim_day = snap.global_day;
+      civ_frame_pacer_note_activity();
+    }
+    if (have_snap && snap.tick != app->sim_tick) {
+      app->sim_tick = snap.tick;
+      civ_quality_governor_sample(CIV_QUALITY_BUDGET_TICK, snap.last_tick_ms);
+    }
+
     int win_w = 0, win_h = 0;
     civ_window_get_size(app->window, &win_w, &win_h);
 
@@ -123,26 +295,61 @@ void civ_app_controller_run(civ_app_controller_t *app) {
     app->input.win_h = win_h;
     app->input.global_dt = app->delta_time;
 
+    /* One lookup in the last drawn frame's grid routes the mouse */
+    civ_hit_grid_route(&g_ui_hits, &app->input);
+
+    /* No-op while the sim thread runs */
+    civ_sim_thread_pump(app->sim);
+
+    /* Scenes and panels touch live game state — hold the sim between ticks */
+    civ_sim_thread_lock(app->sim);
+    CIV_MEM_TAG_BEGIN(prev_tag, CIV_MEM_TAG_UI);
+    if (app->loaded)
+      civ_game_begin_frame(app->game);
     civ_scene_manager_update(app->game, &app->input);
     civ_window_mgr_input(&app->window_mgr, &app->input);
 
-    civ_window_clear(app->window, CIV_COLOR_BG_DARK);
+    /* Draw only when input, the sim or an animation changed something */
+    bool present = civ_frame_pacer_should_present();
+    if (present) {
+      civ_window_clear(app->window, CIV_COLOR_BG_DARK);
+      civ_hit_grid_begin(&g_ui_hits, win_w, win_h);
 
-    /* Nuklear begin — sets g_nk_ctx so scenes can render Nuklear UI */
-    nk_ui_begin();
+      /* Nuklear begin — sets g_nk_ctx so scenes can render Nuklear UI */
+      nk_ui_begin();
 
-    civ_scene_manager_render(civ_window_get_renderer(app->window), win_w, win_h,
-                             app->game, &app->input);
-    civ_window_mgr_render(&app->window_mgr, civ_window_get_renderer(app->window),
-                          NULL);
+      civ_scene_manager_render(civ_window_get_renderer(app->window), win_w,
+                               win_h, app->game, &app->input);
+      civ_window_mgr_render(&app->window_mgr,
+                            civ_window_get_renderer(app->window), NULL);
 
-    /* Nuklear end — flushes all draw commands */
-    nk_ui_end();
+      /* Nuklear end — flushes all draw commands */
+      nk_ui_end();
+      /* Scene, windows and the Nuklear layer */
+      civ_frame_trace_count(CIV_FRAME_RENDER_PASSES, 3);
+    }
 
-    civ_window_present(app->window);
+    CIV_MEM_TAG_END(prev_tag);
+    civ_sim_thread_unlock(app->sim);
+
+    if (present) {
+      /* Update and draw, without the present that may wait on VSync */
+      if (app->loaded)
+        civ_quality_governor_sample(
+            CIV_QUALITY_BUDGET_FRAME,
+            (double)(SDL_GetTicksNS() - current_time) / 1e6);
+      civ_window_present(app->window);
+    }
+
+    /* Background work fills what is left of the frame budget; under VSync
+       that is mostly the frames that were skipped */
+    civ_sim_thread_lock(app->sim);
+    civ_frame_pacer_run_idle_tasks();
+    civ_sim_thread_unlock(app->sim);
 
     civ_input_end_frame(&app->input);
-    SDL_Delay(16);
+    civ_frame_trace_end_frame(current_time, interval_ns, present);
+    civ_frame_pacer_wait();
   }
 }
 
@@ -150,7 +357,17 @@ void civ_app_controller_shutdown(civ_app_controller_t *app) {
   if (!app)
     return;
 
+  /* Join the sim thread before the state it ticks goes away */
+  if (app->sim) {
+    civ_sim_thread_destroy(app->sim);
+    app->sim = NULL;
+    if (app->game) app->game->sim_thread = NULL;
+  }
+
+  civ_frame_trace_shutdown();
   civ_scene_manager_shutdown();
+  civ_window_mgr_shutdown(&app->window_mgr);
+  civ_hit_grid_free(&g_ui_hits);
   nk_ui_shutdown();  /* free Nuklear resources before SDL cleans up */
 
   if (app->game) {
@@ -164,6 +381,9 @@ void civ_app_controller_shutdown(civ_app_controller_t *app) {
   }
 
   civ_font_system_shutdown();
+  civ_maintenance_stop();
+  civ_io_service_stop();
+  civ_logger_stop();
   /* SDL_Quit() crashes due to Nuklear font atlas interaction.
      Window and renderer are already destroyed above. OS reclaims
      any remaining SDL resources on process exit. */
@@ -90,6 +90,8 @@ void civ_confirm_show(const char *title, const char *message) {
        We rely on window_mgr's drag to let the user position it. */
     g_window_mgr->windows[dialog_id].x = 200;
     g_window_mgr->windows[dialog_id].y = 180;
+    /* Static until answered: draw once, then blit */
+    civ_window_mgr_set_retained(g_window_mgr, dialog_id, true);
   }
 }
 
@@ -1,5 +1,6 @@
 #include "ui/graph/graph.h"
 #include "engine/renderer.h"
+#include "utils/frame_trace.h"
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -45,6 +46,73 @@ void civ_graph_map_point(civ_graph_ctx_t *ctx, float x_val, float y_val,
               plot_h);
 }
 
+/* ── Decimation ─────────────────────────────────────────────────────── */
+int civ_graph_decimate(const float *x, const float *y, int count, float x_min,
+                       float x_max, int columns, float *out_x, float *out_y) {
+  if (!y || count <= 0 || columns <= 0) return 0;
+  float range = x_max - x_min;
+  float to_col = range > 0 ? (float)columns / range : 0.0f;
+  int n = 0;
+
+  int i = 0;
+  while (i < count) {
+    float xi = x ? x[i] : (float)i;
+    int col = (int)((xi - x_min) * to_col);
+    if (col < 0) col = 0;
+    if (col >= columns) col = columns - 1;
+
+    /* The run of samples falling in this column */
+    int first = i, lo = i, hi = i, last = i;
+    for (i++; i < count; i++) {
+      float xj = x ? x[i] : (float)i;
+      int cj = (int)((xj - x_min) * to_col);
+      if (cj < 0) cj = 0;
+      if (cj >= columns) cj = columns - 1;
+      if (cj != col) break;
+      if (y[i] < y[lo]) lo = i;
+      if (y[i] > y[hi]) hi = i;
+      last = i;
+    }
+
+    /* Emit in sample order, each index once */
+    int pick[4] = {first, lo < hi ? lo : hi, lo < hi ? hi : lo, last};
+    int prev = -1;
+    for (int k = 0; k < 4; k++) {
+      if (pick[k] == prev) continue;
+      out_x[n] = x ? x[pick[k]] : (float)pick[k];
+      out_y[n] = y[pick[k]];
+      n++;
+      prev = pick[k];
+    }
+  }
+  return n;
+}
+
+/* Scratch for decimated series; graphs render on the UI thread */
+static float *g_decimated;
+static int g_decimated_cap;
+
+/* The series to draw: itself if sparse enough, else decimated into the
+   scratch. Returns the point count, 0 without memory. */
+static int series_view(const float *x, const float *y, int count, float x_min,
+                       float x_max, int columns, const float **vx,
+                       const float **vy) {
+  *vx = x;
+  *vy = y;
+  if (columns <= 0 || count <= 4 * columns) return count;
+  if (g_decimated_cap < 4 * columns) {
+    float *buf = realloc(g_decimated, (size_t)columns * 8 * sizeof(float));
+    if (!buf) return 0;
+    g_decimated = buf;
+    g_decimated_cap = 4 * columns;
+  }
+  int n = civ_graph_decimate(x, y, count, x_min, x_max, columns, g_decimated,
+                             g_decimated + g_decimated_cap);
+  *vx = g_decimated;
+  *vy = g_decimated + g_decimated_cap;
+  return n;
+}
+
 void civ_graph_draw_axes(SDL_Renderer *r, civ_graph_ctx_t *ctx) {
   int plot_x = ctx->x + ctx->pad_left, plot_y = ctx->y + ctx->pad_top;
   int plot_w = ctx->w - ctx->pad_left - ctx->pad_right;
@@ -73,28 +141,35 @@ void civ_graph_draw_grid(SDL_Renderer *r, civ_graph_ctx_t *ctx,
 SDL_Texture *civ_graph_line(SDL_Renderer *r, civ_graph_ctx_t *ctx,
                             civ_graph_multi_series_t *data) {
   if (!r || !data || data->series_count == 0) return NULL;
-  SDL_Texture *tex = SDL_CreateTexture(r, SDL_PIXELFORMAT_ARGB8888,
+  SDL_Texture *tex = civ_create_texture(r, SDL_PIXELFORMAT_ARGB8888,
                                        SDL_TEXTUREACCESS_TARGET, ctx->w, ctx->h);
   if (!tex) return NULL;
   SDL_SetRenderTarget(r, tex);
+  civ_render_begin_batch(r);
   civ_render_rect_filled(r, 0, 0, ctx->w, ctx->h, ctx->bg_color);
   civ_graph_draw_grid(r, ctx, 5, 5);
   civ_graph_draw_axes(r, ctx);
 
+  int plot_w = ctx->w - ctx->pad_left - ctx->pad_right;
   for (int s = 0; s < data->series_count; s++) {
     civ_graph_series_t *ser = &data->series[s];
     if (ser->count < 2) continue;
     uint32_t col = ser->color ? ser->color
                               : g_graph_palette_default[s % CIV_GRAPH_PALETTE_SIZE];
+    const float *vx, *vy;
+    int n = series_view(ser->x_values, ser->y_values, ser->count, ctx->x_min,
+                        ctx->x_max, plot_w, &vx, &vy);
+    if (n < 2) continue;
     int px0, py0;
-    civ_graph_map_point(ctx, ser->x_values[0], ser->y_values[0], &px0, &py0);
-    for (int i = 1; i < ser->count; i++) {
+    civ_graph_map_point(ctx, vx[0], vy[0], &px0, &py0);
+    for (int i = 1; i < n; i++) {
       int px1, py1;
-      civ_graph_map_point(ctx, ser->x_values[i], ser->y_values[i], &px1, &py1);
+      civ_graph_map_point(ctx, vx[i], vy[i], &px1, &py1);
       civ_render_line(r, px0, py0, px1, py1, col);
       px0 = px1; py0 = py1;
     }
   }
+  civ_render_end_batch();
   SDL_SetRenderTarget(r, NULL);
   return tex;
 }
@@ -103,7 +178,7 @@ SDL_Texture *civ_graph_line(SDL_Renderer *r, civ_graph_ctx_t *ctx,
 SDL_Texture *civ_graph_bar(SDL_Renderer *r, civ_graph_ctx_t *ctx,
                            civ_graph_bar_t *bars, int count, bool horizontal) {
   if (!r || !bars || count == 0) return NULL;
-  SDL_Texture *tex = SDL_CreateTexture(r, SDL_PIXELFORMAT_ARGB8888,
+  SDL_Texture *tex = civ_create_texture(r, SDL_PIXELFORMAT_ARGB8888,
                                        SDL_TEXTUREACCESS_TARGET, ctx->w, ctx->h);
   if (!tex) return NULL;
   SDL_SetRenderTarget(r, tex);
@@ -148,7 +223,7 @@ SDL_Texture *civ_graph_pie(SDL_Renderer *r, int x, int y, int radius,
                            civ_graph_bar_t *slices, int count) {
   if (!r || !slices || count == 0) return NULL;
   int size = (radius + 20) * 2;
-  SDL_Texture *tex = SDL_CreateTexture(r, SDL_PIXELFORMAT_ARGB8888,
+  SDL_Texture *tex = civ_create_texture(r, SDL_PIXELFORMAT_ARGB8888,
                                        SDL_TEXTUREACCESS_TARGET, size, size);
   if (!tex) return NULL;
   SDL_SetRenderTarget(r, tex);
@@ -200,7 +275,7 @@ SDL_Texture *civ_graph_scatter(SDL_Renderer *r, civ_graph_ctx_t *ctx,
                                float *x, float *y, int count, uint32_t color,
                                float radius) {
   if (!r || !x || !y || count == 0) return NULL;
-  SDL_Texture *tex = SDL_CreateTexture(r, SDL_PIXELFORMAT_ARGB8888,
+  SDL_Texture *tex = civ_create_texture(r, SDL_PIXELFORMAT_ARGB8888,
                                        SDL_TEXTUREACCESS_TARGET, ctx->w, ctx->h);
   if (!tex) return NULL;
   SDL_SetRenderTarget(r, tex);
@@ -223,7 +298,7 @@ SDL_Texture *civ_graph_radar(SDL_Renderer *r, int cx, int cy, int radius,
                              uint32_t color) {
   if (!r || !values || count < 3) return NULL;
   int size = (radius + 60) * 2;
-  SDL_Texture *tex = SDL_CreateTexture(r, SDL_PIXELFORMAT_ARGB8888,
+  SDL_Texture *tex = civ_create_texture(r, SDL_PIXELFORMAT_ARGB8888,
                                        SDL_TEXTUREACCESS_TARGET, size, size);
   if (!tex) return NULL;
   SDL_SetRenderTarget(r, tex);
@@ -274,7 +349,7 @@ SDL_Texture *civ_graph_gauge(SDL_Renderer *r, int cx, int cy, int radius,
                              float value, float min, float max, uint32_t color) {
   if (!r) return NULL;
   int size = (radius + 10) * 2;
-  SDL_Texture *tex = SDL_CreateTexture(r, SDL_PIXELFORMAT_ARGB8888,
+  SDL_Texture *tex = civ_create_texture(r, SDL_PIXELFORMAT_ARGB8888,
                                        SDL_TEXTUREACCESS_TARGET, size, size);
   if (!tex) return NULL;
   SDL_SetRenderTarget(r, tex);
@@ -309,7 +384,7 @@ SDL_Texture *civ_graph_gauge(SDL_Renderer *r, int cx, int cy, int radius,
 SDL_Texture *civ_graph_sparkline(SDL_Renderer *r, int x, int y, int w, int h,
                                  float *values, int count, uint32_t color) {
   if (!r || !values || count < 2) return NULL;
-  SDL_Texture *tex = SDL_CreateTexture(r, SDL_PIXELFORMAT_ARGB8888,
+  SDL_Texture *tex = civ_create_texture(r, SDL_PIXELFORMAT_ARGB8888,
                                        SDL_TEXTUREACCESS_TARGET, w, h);
   if (!tex) return NULL;
   SDL_SetRenderTarget(r, tex);
@@ -323,13 +398,19 @@ SDL_Texture *civ_graph_sparkline(SDL_Renderer *r, int x, int y, int w, int h,
   float range = max_v - min_v;
   if (range <= 0.0f) range = 1.0f;
 
+  const float *vx, *vy;
+  int n = series_view(NULL, values, count, 0.0f, (float)(count - 1), w, &vx,
+                      &vy);
+  civ_render_begin_batch(r);
   int px0 = 0, py0 = h - 1 - (int)((values[0] - min_v) / range * (float)(h - 1));
-  for (int i = 1; i < count; i++) {
-    int px1 = (int)((float)i / (float)(count - 1) * (float)(w - 1));
-    int py1 = h - 1 - (int)((values[i] - min_v) / range * (float)(h - 1));
+  for (int i = 1; i < n; i++) {
+    float xi = vx ? vx[i] : (float)i;
+    int px1 = (int)(xi / (float)(count - 1) * (float)(w - 1));
+    int py1 = h - 1 - (int)((vy[i] - min_v) / range * (float)(h - 1));
     civ_render_line(r, px0, py0, px1, py1, color);
     px0 = px1; py0 = py1;
   }
+  civ_render_end_batch();
   SDL_SetRenderTarget(r, NULL);
   return tex;
 }
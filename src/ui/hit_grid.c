@@ -0,0 +1,98 @@
+/**
+ * @file hit_grid.c
+ * @brief Per-frame UI hit-test grid
+ */
+#include "ui/hit_grid.h"
+#include <stdlib.h>
+#include <string.h>
+
+civ_hit_grid_t g_ui_hits;
+
+void civ_hit_grid_begin(civ_hit_grid_t *g, int screen_w, int screen_h) {
+  if (!g) return;
+  int cols = screen_w > 0 ? (screen_w + CIV_HIT_CELL - 1) / CIV_HIT_CELL : 1;
+  int rows = screen_h > 0 ? (screen_h + CIV_HIT_CELL - 1) / CIV_HIT_CELL : 1;
+  if (cols * rows > g->cell_capacity) {
+    int16_t *cells = realloc(g->cells, (size_t)(cols * rows) * sizeof(int16_t));
+    if (!cells) {
+      /* Without cells every query scans the rects */
+      g->cols = g->rows = 0;
+      g->overflow = true;
+      g->count = g->ref_count = 0;
+      g->built = true;
+      return;
+    }
+    g->cells = cells;
+    g->cell_capacity = cols * rows;
+  }
+  g->cols = cols;
+  g->rows = rows;
+  memset(g->cells, 0xFF, (size_t)(cols * rows) * sizeof(int16_t));
+  g->count = 0;
+  g->ref_count = 0;
+  g->overflow = false;
+  g->built = true;
+}
+
+void civ_hit_grid_add(civ_hit_grid_t *g, const void *layer, int x, int y,
+                      int w, int h) {
+  if (!g || w <= 0 || h <= 0 || g->count >= CIV_HIT_RECTS_MAX) return;
+  int idx = g->count++;
+  g->rects[idx] = (civ_hit_rect_t){layer, x, y, w, h};
+  if (g->overflow || g->cols == 0) return;
+
+  int c0 = x / CIV_HIT_CELL, c1 = (x + w) / CIV_HIT_CELL;
+  int r0 = y / CIV_HIT_CELL, r1 = (y + h) / CIV_HIT_CELL;
+  if (c0 < 0) c0 = 0;
+  if (r0 < 0) r0 = 0;
+  if (c1 >= g->cols) c1 = g->cols - 1;
+  if (r1 >= g->rows) r1 = g->rows - 1;
+  if (c0 > c1 || r0 > r1) return;
+  if (g->ref_count + (c1 - c0 + 1) * (r1 - r0 + 1) > CIV_HIT_REFS_MAX) {
+    g->overflow = true;
+    return;
+  }
+  for (int r = r0; r <= r1; r++) {
+    for (int c = c0; c <= c1; c++) {
+      int16_t *head = &g->cells[r * g->cols + c];
+      int ref = g->ref_count++;
+      g->ref_rect[ref] = (int16_t)idx;
+      g->ref_next[ref] = *head;
+      *head = (int16_t)ref;
+    }
+  }
+}
+
+static bool rect_contains(const civ_hit_rect_t *rc, int x, int y) {
+  return x >= rc->x && x <= rc->x + rc->w && y >= rc->y && y <= rc->y + rc->h;
+}
+
+const void *civ_hit_grid_query(const civ_hit_grid_t *g, int x, int y) {
+  if (!g || g->count == 0) return NULL;
+  int c = x / CIV_HIT_CELL, r = y / CIV_HIT_CELL;
+  if (g->overflow || g->cols == 0 || x < 0 || y < 0 || c >= g->cols ||
+      r >= g->rows) {
+    for (int i = g->count - 1; i >= 0; i--)
+      if (rect_contains(&g->rects[i], x, y)) return g->rects[i].layer;
+    return NULL;
+  }
+  for (int ref = g->cells[r * g->cols + c]; ref >= 0; ref = g->ref_next[ref]) {
+    const civ_hit_rect_t *rc = &g->rects[g->ref_rect[ref]];
+    if (rect_contains(rc, x, y)) return rc->layer;
+  }
+  return NULL;
+}
+
+void civ_hit_grid_route(const civ_hit_grid_t *g, civ_input_state_t *input) {
+  if (!input) return;
+  input->hit_routed = g && g->built;
+  input->hit_top = input->hit_routed
+      ? civ_hit_grid_query(g, input->mouse_x, input->mouse_y) : NULL;
+  input->hit_layer = NULL;
+}
+
+void civ_hit_grid_free(civ_hit_grid_t *g) {
+  if (!g) return;
+  free(g->cells);
+  memset(g, 0, sizeof(*g));
+}
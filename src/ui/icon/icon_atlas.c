@@ -1,66 +1,68 @@
 #include "ui/icon/icon_atlas.h"
 #include "engine/renderer.h"
+#include "stb_image.h"
+#include "utils/frame_trace.h"
 #include <stdlib.h>
 #include <string.h>
 
 /* ── Nerd Font glyph mapping ────────────────────────────────────────────
  * Maps icon IDs to Unicode codepoints in patched Nerd Fonts.
  * These are from Font Awesome (nf-fa-*) in the Private Use Area
- * as patched by the Nerd Fonts project.
+ * as patched by the Nerd Fonts project. Indexed by icon; 0 = no glyph.
  */
-static const civ_nerd_glyph_t nerd_glyphs[] = {
-    {CIV_ICON_SWORD,       0xF0E7}, /* nf-fa-bolt — repurposed for combat */
-    {CIV_ICON_SHIELD,      0xF132}, /* nf-fa-shield */
-    {CIV_ICON_HELMET,      0xF11B}, /* nf-fa-gamepad — styled */
-    {CIV_ICON_INFANTRY,    0xF0C0}, /* nf-fa-users */
-    {CIV_ICON_COIN,        0xF0D6}, /* nf-fa-money */
-    {CIV_ICON_GEM,         0xF219}, /* nf-fa-diamond */
-    {CIV_ICON_CHEST,       0xF1B2}, /* nf-fa-cube */
-    {CIV_ICON_SCALES,      0xF24E}, /* nf-fa-balance-scale */
-    {CIV_ICON_TRADE,       0xF0EC}, /* nf-fa-exchange */
-    {CIV_ICON_HAMMER,      0xF0E3}, /* nf-fa-gavel — legal, repurposed */
-    {CIV_ICON_WHEAT,       0xF06C}, /* nf-fa-leaf — nature */
-    {CIV_ICON_GEAR,        0xF013}, /* nf-fa-cog */
-    {CIV_ICON_CROWN,       0xF119}, /* nf-fa-graduation-cap — styled crown */
-    {CIV_ICON_FLAG,        0xF024}, /* nf-fa-flag */
-    {CIV_ICON_SCROLL,      0xF15C}, /* nf-fa-file-text */
-    {CIV_ICON_BOOK,        0xF02D}, /* nf-fa-book */
-    {CIV_ICON_TEMPLE,      0xF19C}, /* nf-fa-university */
-    {CIV_ICON_PRAYER,      0xF004}, /* nf-fa-heart */
-    {CIV_ICON_DOVE,        0xF072}, /* nf-fa-plane — repurposed peace */
-    {CIV_ICON_HANDSHAKE,   0xF2B5}, /* nf-fa-handshake-o */
-    {CIV_ICON_FLASK,       0xF0C3}, /* nf-fa-flask */
-    {CIV_ICON_COMPASS,     0xF14E}, /* nf-fa-compass */
-    {CIV_ICON_TELESCOPE,   0xF002}, /* nf-fa-search */
-    {CIV_ICON_MOUNTAIN,    0xF1BB}, /* nf-fa-tree — styled mountain */
-    {CIV_ICON_TREE_RING,   0xF1BB}, /* nf-fa-tree */
-    {CIV_ICON_FIRE,        0xF06D}, /* nf-fa-fire */
-    {CIV_ICON_SHIP,        0xF21A}, /* nf-fa-ship */
-    {CIV_ICON_PEOPLE,      0xF0C0}, /* nf-fa-users */
-    {CIV_ICON_HEART,       0xF004}, /* nf-fa-heart */
-    {CIV_ICON_SKULL,       0xF54C}, /* nf-fa-skull-crossbones — approx */
-    {CIV_ICON_STAR,        0xF005}, /* nf-fa-star */
-    {CIV_ICON_CLOSE,       0xF00D}, /* nf-fa-times */
-    {CIV_ICON_SETTINGS,    0xF013}, /* nf-fa-cog */
-    {CIV_ICON_SEARCH,      0xF002}, /* nf-fa-search */
-    {CIV_ICON_ZOOM_IN,     0xF00E}, /* nf-fa-search-plus */
-    {CIV_ICON_ZOOM_OUT,    0xF010}, /* nf-fa-search-minus */
-    {CIV_ICON_HOME,        0xF015}, /* nf-fa-home */
-    {CIV_ICON_BACK,        0xF060}, /* nf-fa-arrow-left */
-    {CIV_ICON_FORWARD,     0xF061}, /* nf-fa-arrow-right */
-    {CIV_ICON_REFRESH,     0xF021}, /* nf-fa-refresh */
-    {CIV_ICON_PLUS,        0xF067}, /* nf-fa-plus */
-    {CIV_ICON_MINUS,       0xF068}, /* nf-fa-minus */
-    {CIV_ICON_CHECK,       0xF00C}, /* nf-fa-check */
-    {CIV_ICON_CROSS,       0xF00D}, /* nf-fa-times */
-    {CIV_ICON_MENU,        0xF0C9}, /* nf-fa-bars */
-    {CIV_ICON_INFO,        0xF05A}, /* nf-fa-info-circle */
-    {CIV_ICON_WARNING,     0xF071}, /* nf-fa-warning */
-    {CIV_ICON_BELL,        0xF0F3}, /* nf-fa-bell */
-    {CIV_ICON_LOCK,        0xF023}, /* nf-fa-lock */
-    {CIV_ICON_UNLOCK,      0xF09C}, /* nf-fa-unlock */
-    {CIV_ICON_ROCKET,      0xF135}, /* nf-fa-rocket */
-    {CIV_ICON_GLOBE,       0xF0AC}, /* nf-fa-globe */
+static const uint32_t nerd_codepoints[CIV_ICON_COUNT] = {
+    [CIV_ICON_SWORD] =     0xF0E7, /* nf-fa-bolt — repurposed for combat */
+    [CIV_ICON_SHIELD] =    0xF132, /* nf-fa-shield */
+    [CIV_ICON_HELMET] =    0xF11B, /* nf-fa-gamepad — styled */
+    [CIV_ICON_INFANTRY] =  0xF0C0, /* nf-fa-users */
+    [CIV_ICON_COIN] =      0xF0D6, /* nf-fa-money */
+    [CIV_ICON_GEM] =       0xF219, /* nf-fa-diamond */
+    [CIV_ICON_CHEST] =     0xF1B2, /* nf-fa-cube */
+    [CIV_ICON_SCALES] =    0xF24E, /* nf-fa-balance-scale */
+    [CIV_ICON_TRADE] =     0xF0EC, /* nf-fa-exchange */
+    [CIV_ICON_HAMMER] =    0xF0E3, /* nf-fa-gavel — legal, repurposed */
+    [CIV_ICON_WHEAT] =     0xF06C, /* nf-fa-leaf — nature */
+    [CIV_ICON_GEAR] =      0xF013, /* nf-fa-cog */
+    [CIV_ICON_CROWN] =     0xF119, /* nf-fa-graduation-cap — styled crown */
+    [CIV_ICON_FLAG] =      0xF024, /* nf-fa-flag */
+    [CIV_ICON_SCROLL] =    0xF15C, /* nf-fa-file-text */
+    [CIV_ICON_BOOK] =      0xF02D, /* nf-fa-book */
+    [CIV_ICON_TEMPLE] =    0xF19C, /* nf-fa-university */
+    [CIV_ICON_PRAYER] =    0xF004, /* nf-fa-heart */
+    [CIV_ICON_DOVE] =      0xF072, /* nf-fa-plane — repurposed peace */
+    [CIV_ICON_HANDSHAKE] = 0xF2B5, /* nf-fa-handshake-o */
+    [CIV_ICON_FLASK] =     0xF0C3, /* nf-fa-flask */
+    [CIV_ICON_COMPASS] =   0xF14E, /* nf-fa-compass */
+    [CIV_ICON_TELESCOPE] = 0xF002, /* nf-fa-search */
+    [CIV_ICON_MOUNTAIN] =  0xF1BB, /* nf-fa-tree — styled mountain */
+    [CIV_ICON_TREE_RING] = 0xF1BB, /* nf-fa-tree */
+    [CIV_ICON_FIRE] =      0xF06D, /* nf-fa-fire */
+    [CIV_ICON_SHIP] =      0xF21A, /* nf-fa-ship */
+    [CIV_ICON_PEOPLE] =    0xF0C0, /* nf-fa-users */
+    [CIV_ICON_HEART] =     0xF004, /* nf-fa-heart */
+    [CIV_ICON_SKULL] =     0xF54C, /* nf-fa-skull-crossbones — approx */
+    [CIV_ICON_STAR] =      0xF005, /* nf-fa-star */
+    [CIV_ICON_CLOSE] =     0xF00D, /* nf-fa-times */
+    [CIV_ICON_SETTINGS] =  0xF013, /* nf-fa-cog */
+    [CIV_ICON_SEARCH] =    0xF002, /* nf-fa-search */
+    [CIV_ICON_ZOOM_IN] =   0xF00E, /* nf-fa-search-plus */
+    [CIV_ICON_ZOOM_OUT] =  0xF010, /* nf-fa-search-minus */
+    [CIV_ICON_HOME] =      0xF015, /* nf-fa-home */
+    [CIV_ICON_BACK] =      0xF060, /* nf-fa-arrow-left */
+    [CIV_ICON_FORWARD] =   0xF061, /* nf-fa-arrow-right */
+    [CIV_ICON_REFRESH] =   0xF021, /* nf-fa-refresh */
+    [CIV_ICON_PLUS] =      0xF067, /* nf-fa-plus */
+    [CIV_ICON_MINUS] =     0xF068, /* nf-fa-minus */
+    [CIV_ICON_CHECK] =     0xF00C, /* nf-fa-check */
+    [CIV_ICON_CROSS] =     0xF00D, /* nf-fa-times */
+    [CIV_ICON_MENU] =      0xF0C9, /* nf-fa-bars */
+    [CIV_ICON_INFO] =      0xF05A, /* nf-fa-info-circle */
+    [CIV_ICON_WARNING] =   0xF071, /* nf-fa-warning */
+    [CIV_ICON_BELL] =      0xF0F3, /* nf-fa-bell */
+    [CIV_ICON_LOCK] =      0xF023, /* nf-fa-lock */
+    [CIV_ICON_UNLOCK] =    0xF09C, /* nf-fa-unlock */
+    [CIV_ICON_ROCKET] =    0xF135, /* nf-fa-rocket */
+    [CIV_ICON_GLOBE] =     0xF0AC, /* nf-fa-globe */
 };
 
 /* ── Icon name table ─────────────────────────────────────────────────── */
@@ -145,27 +147,134 @@ static const char *icon_names[CIV_ICON_COUNT] = {
     #undef X
 };
 
-struct civ_icon_atlas { SDL_Texture *sdf_tex; int atlas_w, atlas_h; bool loaded; };
+/* ── SDF atlas ──────────────────────────────────────────────────────────
+ * A single-channel PNG, 16 x 16 cells in icon ID order, each texel the
+ * distance to the glyph edge with 0.5 on the edge. The renderer has no
+ * fragment shaders, so the alpha threshold is applied once at load: each
+ * distance becomes a smoothstep of width SDF_SMOOTHING around the edge and
+ * linear filtering interpolates that ramp, which stays clean when scaled.
+ */
+#define ATLAS_COLS 16
+#define ATLAS_ROWS 16
+#define SDF_EDGE      0.5f
+#define SDF_SMOOTHING 0.08f
+#define ICON_BATCH_INITIAL 64 /* quads */
+
+struct civ_icon_atlas {
+  SDL_Renderer *renderer;
+  SDL_Texture  *sdf_tex;
+  int   atlas_w, atlas_h;
+  bool  loaded;
+  SDL_FRect uv[CIV_ICON_COUNT]; /* texture coordinates, 0-1 */
+
+  /* Quads queued since the last flush */
+  SDL_Vertex *verts;
+  int        *indices;
+  int         quad_count, quad_capacity;
+  bool        batching;
+};
 
 civ_icon_atlas_t *civ_icon_atlas_create(SDL_Renderer *r) {
-  (void)r;
   civ_icon_atlas_t *atlas =
       (civ_icon_atlas_t *)malloc(sizeof(civ_icon_atlas_t));
   if (!atlas) return NULL;
   memset(atlas, 0, sizeof(*atlas));
+  atlas->renderer = r;
   return atlas;
 }
 
 void civ_icon_atlas_destroy(civ_icon_atlas_t *atlas) {
   if (!atlas) return;
   if (atlas->sdf_tex) SDL_DestroyTexture(atlas->sdf_tex);
+  free(atlas->verts);
+  free(atlas->indices);
   free(atlas);
 }
 
 bool civ_icon_atlas_load_sdf(civ_icon_atlas_t *atlas, const char *filepath) {
-  (void)atlas; (void)filepath;
-  /* SDF atlas loading — stb_image based. Deferred until PNG pipeline is needed. */
-  return false;
+  if (!atlas || !atlas->renderer || !filepath) return false;
+
+  int w, h, channels;
+  unsigned char *dist = stbi_load(filepath, &w, &h, &channels, 1);
+  if (!dist) return false;
+  if (w < ATLAS_COLS || h < ATLAS_ROWS) { stbi_image_free(dist); return false; }
+
+  uint32_t *pixels = malloc((size_t)w * (size_t)h * sizeof(uint32_t));
+  if (!pixels) { stbi_image_free(dist); return false; }
+
+  /* Distance to alpha, white glyphs so color mod tints them */
+  uint32_t ramp[256];
+  for (int d = 0; d < 256; d++) {
+    float t = ((float)d / 255.0f - (SDF_EDGE - SDF_SMOOTHING)) /
+              (2.0f * SDF_SMOOTHING);
+    if (t < 0.0f) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+    float a = t * t * (3.0f - 2.0f * t);
+    ramp[d] = 0xFFFFFF00u | (uint32_t)(a * 255.0f + 0.5f);
+  }
+  for (size_t i = 0; i < (size_t)w * (size_t)h; i++) pixels[i] = ramp[dist[i]];
+  stbi_image_free(dist);
+
+  SDL_Texture *tex = civ_create_texture(atlas->renderer,
+      SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, w, h);
+  if (!tex) { free(pixels); return false; }
+  SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+  SDL_SetTextureScaleMode(tex, SDL_SCALEMODE_LINEAR);
+  SDL_UpdateTexture(tex, NULL, pixels, w * 4);
+  free(pixels);
+
+  if (atlas->sdf_tex) SDL_DestroyTexture(atlas->sdf_tex);
+  atlas->sdf_tex = tex;
+  atlas->atlas_w = w;
+  atlas->atlas_h = h;
+  atlas->quad_count = 0;
+
+  float cw = 1.0f / (float)ATLAS_COLS, ch = 1.0f / (float)ATLAS_ROWS;
+  for (int id = 0; id < CIV_ICON_COUNT; id++)
+    atlas->uv[id] = (SDL_FRect){(float)(id % ATLAS_COLS) * cw,
+                                (float)(id / ATLAS_COLS) * ch, cw, ch};
+  atlas->loaded = true;
+  return true;
+}
+
+/* Room for one more quad; indices never change, so they are written once
+ * per slot as the buffers grow */
+static bool icon_reserve(civ_icon_atlas_t *atlas) {
+  if (atlas->quad_count < atlas->quad_capacity) return true;
+  int cap = atlas->quad_capacity ? atlas->quad_capacity * 2 : ICON_BATCH_INITIAL;
+  SDL_Vertex *v = realloc(atlas->verts, (size_t)cap * 4 * sizeof(SDL_Vertex));
+  if (!v) return false;
+  atlas->verts = v;
+  int *ix = realloc(atlas->indices, (size_t)cap * 6 * sizeof(int));
+  if (!ix) return false;
+  atlas->indices = ix;
+  for (int q = atlas->quad_capacity; q < cap; q++) {
+    int *o = &ix[q * 6], b = q * 4;
+    o[0] = b; o[1] = b + 1; o[2] = b + 2;
+    o[3] = b; o[4] = b + 2; o[5] = b + 3;
+  }
+  atlas->quad_capacity = cap;
+  return true;
+}
+
+static void icon_flush(civ_icon_atlas_t *atlas, SDL_Renderer *r) {
+  if (atlas->quad_count == 0) return;
+  /* Shapes batched before the icons stay underneath them */
+  civ_render_flush_batch();
+  SDL_RenderGeometry(r, atlas->sdf_tex, atlas->verts, atlas->quad_count * 4,
+                     atlas->indices, atlas->quad_count * 6);
+  atlas->quad_count = 0;
+}
+
+void civ_icon_atlas_begin_batch(civ_icon_atlas_t *atlas) {
+  if (atlas) atlas->batching = true;
+}
+
+void civ_icon_atlas_end_batch(civ_icon_atlas_t *atlas, SDL_Renderer *r) {
+  if (!atlas) return;
+  atlas->batching = false;
+  if (r && atlas->sdf_tex) icon_flush(atlas, r);
+  atlas->quad_count = 0;
 }
 
 void civ_icon_render(civ_icon_atlas_t *atlas, SDL_Renderer *r,
@@ -174,24 +283,24 @@ void civ_icon_render(civ_icon_atlas_t *atlas, SDL_Renderer *r,
   if (!atlas || !r) return;
 
   if (atlas->loaded && atlas->sdf_tex) {
-    /* SDF path: sample texture with distance threshold */
-    SDL_FRect dst = {x, y, (float)size, (float)size};
-    SDL_SetTextureColorMod(atlas->sdf_tex, (color >> 16) & 0xFF,
-                           (color >> 8) & 0xFF, color & 0xFF);
-    SDL_SetTextureAlphaMod(atlas->sdf_tex, alpha);
-    int col = (int)icon_id % 16, row = (int)icon_id / 16;
-    SDL_FRect src = {(float)(col * atlas->atlas_w / 16),
-                     (float)(row * atlas->atlas_h / 16),
-                     (float)(atlas->atlas_w / 16),
-                     (float)(atlas->atlas_h / 16)};
-    SDL_RenderTexture(r, atlas->sdf_tex, &src, &dst);
+    if ((unsigned)icon_id >= CIV_ICON_COUNT || !icon_reserve(atlas)) return;
+    const SDL_FRect *uv = &atlas->uv[icon_id];
+    SDL_FColor c = {(float)((color >> 16) & 0xFF) / 255.0f,
+                    (float)((color >> 8) & 0xFF) / 255.0f,
+                    (float)(color & 0xFF) / 255.0f, (float)alpha / 255.0f};
+    float s = (float)size;
+    SDL_Vertex *v = &atlas->verts[atlas->quad_count++ * 4];
+    v[0] = (SDL_Vertex){{x, y}, c, {uv->x, uv->y}};
+    v[1] = (SDL_Vertex){{x + s, y}, c, {uv->x + uv->w, uv->y}};
+    v[2] = (SDL_Vertex){{x + s, y + s}, c, {uv->x + uv->w, uv->y + uv->h}};
+    v[3] = (SDL_Vertex){{x, y + s}, c, {uv->x, uv->y + uv->h}};
+    if (!atlas->batching) icon_flush(atlas, r);
   } else {
     /* Fallback: procedural shape placeholder */
     civ_render_rect_filled_alpha(r, (int)x, (int)y, size, size, color, alpha);
     civ_render_rect_outline(r, (int)x, (int)y, size, size, 0xFFFFFF, 1);
   }
 }
-
 void civ_icon_render_nerd(civ_icon_id_t icon_id, const char *nerd_font_path,
                           float x, float y, int size, uint32_t color) {
   /* Nerd Font glyph rendering — handled externally via SDL3_ttf
@@ -205,7 +314,6 @@ const char *civ_icon_name(civ_icon_id_t id) {
 }
 
 uint32_t civ_icon_nerd_codepoint(civ_icon_id_t id) {
-  for (size_t i = 0; i < sizeof(nerd_glyphs) / sizeof(nerd_glyphs[0]); i++)
-    if (nerd_glyphs[i].icon_id == id) return nerd_glyphs[i].codepoint;
-  return 0;
+  if ((unsigned)id >= CIV_ICON_COUNT) return 0;
+  return nerd_codepoints[id];
 }
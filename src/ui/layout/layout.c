@@ -50,17 +50,13 @@ void civ_flex_next(civ_flex_layout_t *fl, float child_w, float child_h,
   fl->first_child = false;
 }
 
-int civ_flex_layout_row(civ_flex_layout_t *fl, float item_w, float item_h,
-                        float **out_positions) {
-  if (!fl || !out_positions) return 0;
-
+/* Lay count equal items from the start of the container */
+static int flex_row_fill(civ_flex_layout_t *fl, float item_w, float item_h,
+                         float *positions) {
   float avail_w = fl->container_w - fl->pad_left - fl->pad_right;
   int count = (int)((avail_w + fl->gap) / (item_w + fl->gap));
   if (count < 1) count = 1;
-  if (count > 64) count = 64;
-
-  float *positions = malloc((size_t)count * 2 * sizeof(float));
-  if (!positions) return 0;
+  if (count > CIV_FLEX_ROW_MAX) count = CIV_FLEX_ROW_MAX;
 
   fl->cursor_x = fl->container_x + fl->pad_left;
   fl->cursor_y = fl->container_y + fl->pad_top;
@@ -72,9 +68,44 @@ int civ_flex_layout_row(civ_flex_layout_t *fl, float item_w, float item_h,
     positions[i * 2] = ox;
     positions[i * 2 + 1] = oy;
   }
+  return count;
+}
+
+int civ_flex_layout_row(civ_flex_layout_t *fl, float item_w, float item_h,
+                        float **out_positions) {
+  if (!fl || !out_positions) return 0;
+
+  float *positions = malloc((size_t)CIV_FLEX_ROW_MAX * 2 * sizeof(float));
+  if (!positions) return 0;
 
   *out_positions = positions;
-  return count;
+  return flex_row_fill(fl, item_w, item_h, positions);
+}
+
+int civ_flex_layout_row_cached(civ_flex_layout_t *fl,
+                               civ_flex_row_cache_t *cache, float item_w,
+                               float item_h, uint32_t generation,
+                               const float **out_positions) {
+  if (!fl || !cache || !out_positions) return 0;
+
+  float key[10] = {fl->container_x, fl->container_y, fl->container_w,
+                   fl->container_h, fl->pad_left,    fl->pad_right,
+                   fl->pad_top,     fl->gap,         item_w,
+                   item_h};
+  if (!cache->valid || cache->generation != generation ||
+      memcmp(cache->key, key, sizeof(key)) != 0) {
+    float cx = fl->cursor_x, cy = fl->cursor_y;
+    bool first = fl->first_child;
+    cache->count = flex_row_fill(fl, item_w, item_h, cache->positions);
+    fl->cursor_x = cx; fl->cursor_y = cy;
+    fl->first_child = first;
+    memcpy(cache->key, key, sizeof(key));
+    cache->generation = generation;
+    cache->valid = true;
+  }
+
+  *out_positions = cache->positions;
+  return cache->count;
 }
 
 void civ_grid_init(civ_grid_layout_t *gl, float x, float y, float w, float h,
@@ -86,16 +117,63 @@ void civ_grid_init(civ_grid_layout_t *gl, float x, float y, float w, float h,
   gl->gap = 8.0f;
 }
 
+/* Recompute the uniform cell size and the track offsets when the grid's
+ * shape, padding or generation moved since the last cell */
+static void grid_refresh(civ_grid_layout_t *gl) {
+  float key[9] = {gl->container_w, gl->container_h, gl->gap,
+                  gl->pad_top,     gl->pad_right,   gl->pad_bottom,
+                  gl->pad_left,    (float)gl->columns, (float)gl->rows};
+  if (gl->cache_valid && gl->cache_generation == gl->generation &&
+      memcmp(gl->cache_key, key, sizeof(key)) == 0)
+    return;
+
+  gl->cell_w = (gl->container_w - (float)(gl->columns - 1) * gl->gap -
+                gl->pad_left - gl->pad_right) / (float)gl->columns;
+  gl->cell_h = (gl->container_h - (float)(gl->rows - 1) * gl->gap -
+                gl->pad_top - gl->pad_bottom) / (float)gl->rows;
+
+  if (gl->columns > 0 && gl->columns <= CIV_GRID_TRACKS_MAX) {
+    gl->col_x[0] = 0.0f;
+    for (int i = 0; i < gl->columns; i++) {
+      float cw = gl->col_widths ? gl->col_widths[i] : gl->cell_w;
+      gl->col_x[i + 1] = gl->col_x[i] + cw + gl->gap;
+    }
+  }
+  if (gl->rows > 0 && gl->rows <= CIV_GRID_TRACKS_MAX) {
+    gl->row_y[0] = 0.0f;
+    for (int i = 0; i < gl->rows; i++) {
+      float rh = gl->row_heights ? gl->row_heights[i] : gl->cell_h;
+      gl->row_y[i + 1] = gl->row_y[i] + rh + gl->gap;
+    }
+  }
+
+  memcpy(gl->cache_key, key, sizeof(key));
+  gl->cache_generation = gl->generation;
+  gl->cache_valid = true;
+}
+
+/* Offset and size of span tracks from i; outside the table every track is
+ * cell wide */
+static void grid_span(const float *offsets, int tracks, float cell, float gap,
+                      int i, int span, float *off, float *size) {
+  if (tracks <= CIV_GRID_TRACKS_MAX && i >= 0 && span >= 1 &&
+      i + span <= tracks) {
+    *off = offsets[i];
+    *size = offsets[i + span] - offsets[i] - gap;
+    return;
+  }
+  *off = (float)i * (cell + gap);
+  *size = cell * (float)span + gap * (float)(span - 1);
+}
+
 void civ_grid_cell(civ_grid_layout_t *gl, int col, int row, int col_span,
                    int row_span, float *ox, float *oy, float *ow, float *oh) {
   if (!gl || !ox || !oy || !ow || !oh) return;
-  float cell_w = (gl->container_w - (float)(gl->columns - 1) * gl->gap -
-                  gl->pad_left - gl->pad_right) / (float)gl->columns;
-  float cell_h = (gl->container_h - (float)(gl->rows - 1) * gl->gap -
-                  gl->pad_top - gl->pad_bottom) / (float)gl->rows;
-
-  *ox = gl->container_x + gl->pad_left + (float)col * (cell_w + gl->gap);
-  *oy = gl->container_y + gl->pad_top + (float)row * (cell_h + gl->gap);
-  *ow = cell_w * (float)col_span + gl->gap * (float)(col_span - 1);
-  *oh = cell_h * (float)row_span + gl->gap * (float)(row_span - 1);
+  grid_refresh(gl);
+
+  float dx, dy;
+  grid_span(gl->col_x, gl->columns, gl->cell_w, gl->gap, col, col_span, &dx, ow);
+  grid_span(gl->row_y, gl->rows, gl->cell_h, gl->gap, row, row_span, &dy, oh);
+  *ox = gl->container_x + gl->pad_left + dx;
+  *oy = gl->container_y + gl->pad_top + dy;
 }
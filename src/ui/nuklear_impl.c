@@ -4,11 +4,19 @@
  *
  * Adapted from Nuklear's demo/sdl_renderer/nuklear_sdl_renderer.h
  * for SDL3. Uses SDL_RenderGeometryRaw for anti-aliased rendering.
+ *
+ * Command memory is zeroed as it is pushed, so a frame's commands hash the
+ * same whenever they draw the same. A frame with no input since the last
+ * and the same hash skips nk_convert and resubmits the geometry kept from
+ * the last conversion.
  */
+#define NK_ZERO_COMMAND_MEMORY
 #define NK_IMPLEMENTATION
 #define NK_SDL_RENDERER_IMPLEMENTATION
 #include "ui/nuklear_ui.h"
 #include "display/theme.h"
+#include "utils/frame_trace.h"
+#include "utils/startup_timeline.h"
 #include <stdbool.h>
 #include <stddef.h>
 #include <string.h>
@@ -28,10 +36,24 @@ struct nk_sdl_vertex {
     float col[4];     /* SDL_FColor = float RGBA for SDL3 */
 };
 
+/* One converted draw command */
+struct nk_sdl_draw {
+    SDL_Rect clip;
+    SDL_Texture *texture;
+    int elem_count;
+};
+
 struct nk_sdl_device {
     struct nk_buffer cmds;
     struct nk_draw_null_texture tex_null;
     SDL_Texture *font_tex;
+    /* Geometry of the last conversion, replayed while commands repeat */
+    struct nk_buffer vbuf, ebuf;
+    struct nk_sdl_draw *draws;
+    int draw_count, draw_capacity;
+    uint64_t hash;         /* of the command memory converted */
+    nk_size hash_size;
+    bool cached;
 };
 
 static struct {
@@ -41,11 +63,12 @@ static struct {
     struct nk_context ctx;
     struct nk_font_atlas atlas;
     Uint64 time_of_last_frame;
+    bool input_seen; /* events since the last frame was drawn */
 } nksdl;
 
 /* ── Font atlas upload ────────────────────────────────────────── */
 static void device_upload_atlas(const void *image, int width, int height) {
-    SDL_Texture *tex = SDL_CreateTexture(nksdl.renderer,
+    SDL_Texture *tex = civ_create_texture(nksdl.renderer,
         SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, width, height);
     if (!tex) return;
     SDL_UpdateTexture(tex, NULL, image, 4 * width);
@@ -65,6 +88,8 @@ struct nk_context *nk_ui_init(SDL_Window *win, SDL_Renderer *renderer) {
     nksdl.ctx.clip.userdata = nk_handle_ptr(NULL);
 
     nk_buffer_init_default(&nksdl.dev.cmds);
+    nk_buffer_init_default(&nksdl.dev.vbuf);
+    nk_buffer_init_default(&nksdl.dev.ebuf);
 
     /* Build font atlas */
     nk_font_atlas_init_default(&nksdl.atlas);
@@ -84,7 +109,7 @@ struct nk_context *nk_ui_init(SDL_Window *win, SDL_Renderer *renderer) {
         if (sz <= 0) { SDL_CloseIO(io); continue; }
         void *ttf_data = SDL_malloc((size_t)sz);
         if (!ttf_data) { SDL_CloseIO(io); continue; }
-        SDL_ReadIO(io, ttf_data, (size_t)sz);
+        civ_startup_note_read(SDL_ReadIO(io, ttf_data, (size_t)sz));
         SDL_CloseIO(io);
 
         struct nk_font_config cfg = nk_font_config(14.0f);
@@ -138,6 +163,14 @@ int nk_ui_handle_event(const SDL_Event *evt) {
     if (!nk_ready) return 0;
     struct nk_context *ctx = &nksdl.ctx;
     switch (evt->type) {
+    case SDL_EVENT_KEY_DOWN: case SDL_EVENT_KEY_UP:
+    case SDL_EVENT_MOUSE_BUTTON_DOWN: case SDL_EVENT_MOUSE_BUTTON_UP:
+    case SDL_EVENT_MOUSE_MOTION: case SDL_EVENT_MOUSE_WHEEL:
+    case SDL_EVENT_TEXT_INPUT:
+        nksdl.input_seen = true; break;
+    default: break;
+    }
+    switch (evt->type) {
     case SDL_EVENT_KEY_DOWN:
     case SDL_EVENT_KEY_UP: {
         int down = (evt->type == SDL_EVENT_KEY_DOWN);
@@ -228,16 +261,24 @@ struct nk_context *nk_ui_begin(void) {
 }
 
 /* ── Render ───────────────────────────────────────────────────── */
-void nk_ui_end(void) {
-    if (!g_nk_ctx) return;
-    struct nk_context *ctx = &nksdl.ctx;
-    struct nk_sdl_device *dev = &nksdl.dev;
-    nk_input_end(ctx);
-    g_nk_ctx = NULL;
 
-    const struct nk_draw_command *cmd;
-    const nk_draw_index *offset = NULL;
-    struct nk_buffer vbuf, ebuf;
+/* FNV-1a over the command memory, a word at a time */
+static uint64_t hash_commands(const void *memory, nk_size size) {
+    const unsigned char *p = (const unsigned char *)memory;
+    uint64_t h = 1469598103934665603ull;
+    nk_size i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        memcpy(&word, p + i, 8);
+        h = (h ^ word) * 1099511628211ull;
+    }
+    for (; i < size; i++)
+        h = (h ^ p[i]) * 1099511628211ull;
+    return h;
+}
+
+/* Convert the frame's commands into the device's geometry and draw list */
+static void device_convert(struct nk_context *ctx, struct nk_sdl_device *dev) {
     struct nk_convert_config config;
     static const struct nk_draw_vertex_layout_element vertex_layout[] = {
         {NK_VERTEX_POSITION, NK_FORMAT_FLOAT, (size_t)offsetof(struct nk_sdl_vertex, position)},
@@ -245,10 +286,6 @@ void nk_ui_end(void) {
         {NK_VERTEX_COLOR, NK_FORMAT_R32G32B32A32_FLOAT, (size_t)offsetof(struct nk_sdl_vertex, col)},
         {NK_VERTEX_LAYOUT_END}
     };
-    int vs = sizeof(struct nk_sdl_vertex);
-    size_t vp = offsetof(struct nk_sdl_vertex, position);
-    size_t vt = offsetof(struct nk_sdl_vertex, uv);
-    size_t vc = offsetof(struct nk_sdl_vertex, col);
 
     memset(&config, 0, sizeof(config));
     config.vertex_layout = vertex_layout;
@@ -262,41 +299,78 @@ void nk_ui_end(void) {
     config.shape_AA = NK_ANTI_ALIASING_ON;
     config.line_AA = NK_ANTI_ALIASING_ON;
 
-    nk_buffer_init_default(&vbuf);
-    nk_buffer_init_default(&ebuf);
-    nk_convert(ctx, &dev->cmds, &vbuf, &ebuf, &config);
-
-    SDL_Rect saved_clip;
-    bool clipping = SDL_RenderClipEnabled(nksdl.renderer);
-    SDL_GetRenderClipRect(nksdl.renderer, &saved_clip);
+    nk_buffer_clear(&dev->cmds);
+    nk_buffer_clear(&dev->vbuf);
+    nk_buffer_clear(&dev->ebuf);
+    nk_convert(ctx, &dev->cmds, &dev->vbuf, &dev->ebuf, &config);
 
-    offset = (const nk_draw_index*)nk_buffer_memory_const(&ebuf);
+    const struct nk_draw_command *cmd;
+    dev->draw_count = 0;
     nk_draw_foreach(cmd, ctx, &dev->cmds) {
         if (!cmd->elem_count) continue;
+        if (dev->draw_count >= dev->draw_capacity) {
+            int cap = dev->draw_capacity ? dev->draw_capacity * 2 : 64;
+            struct nk_sdl_draw *draws =
+                SDL_realloc(dev->draws, (size_t)cap * sizeof(*draws));
+            if (!draws) break;
+            dev->draws = draws;
+            dev->draw_capacity = cap;
+        }
         SDL_Rect r = { (int)cmd->clip_rect.x, (int)cmd->clip_rect.y,
                        (int)cmd->clip_rect.w, (int)cmd->clip_rect.h };
         if (r.x < 0) { r.w += r.x; r.x = 0; }
         if (r.y < 0) { r.h += r.y; r.y = 0; }
-        SDL_SetRenderClipRect(nksdl.renderer, &r);
+        dev->draws[dev->draw_count++] = (struct nk_sdl_draw){
+            r, (SDL_Texture *)cmd->texture.ptr, (int)cmd->elem_count };
+    }
+}
+
+void nk_ui_end(void) {
+    if (!g_nk_ctx) return;
+    struct nk_context *ctx = &nksdl.ctx;
+    struct nk_sdl_device *dev = &nksdl.dev;
+    nk_input_end(ctx);
+    g_nk_ctx = NULL;
 
-        const void *vertices = nk_buffer_memory_const(&vbuf);
-        SDL_RenderGeometryRaw(nksdl.renderer,
-            (SDL_Texture *)cmd->texture.ptr,
+    nk_size size = ctx->memory.allocated;
+    uint64_t hash = hash_commands(nk_buffer_memory_const(&ctx->memory), size);
+    if (!dev->cached || nksdl.input_seen || hash != dev->hash ||
+        size != dev->hash_size) {
+        device_convert(ctx, dev);
+        dev->hash = hash;
+        dev->hash_size = size;
+        dev->cached = true;
+    }
+    nksdl.input_seen = false;
+
+    int vs = sizeof(struct nk_sdl_vertex);
+    size_t vp = offsetof(struct nk_sdl_vertex, position);
+    size_t vt = offsetof(struct nk_sdl_vertex, uv);
+    size_t vc = offsetof(struct nk_sdl_vertex, col);
+
+    SDL_Rect saved_clip;
+    bool clipping = SDL_RenderClipEnabled(nksdl.renderer);
+    SDL_GetRenderClipRect(nksdl.renderer, &saved_clip);
+
+    const void *vertices = nk_buffer_memory_const(&dev->vbuf);
+    const nk_draw_index *offset = (const nk_draw_index*)nk_buffer_memory_const(&dev->ebuf);
+    for (int i = 0; i < dev->draw_count; i++) {
+        const struct nk_sdl_draw *d = &dev->draws[i];
+        SDL_SetRenderClipRect(nksdl.renderer, &d->clip);
+        SDL_RenderGeometryRaw(nksdl.renderer, d->texture,
             (const float*)((const nk_byte*)vertices + vp), vs,
             (const SDL_FColor*)((const nk_byte*)vertices + vc), vs,
             (const float*)((const nk_byte*)vertices + vt), vs,
-            (int)(vbuf.needed / vs),
-            (const void *)offset, (int)cmd->elem_count, 2);
-        offset += cmd->elem_count;
+            (int)(dev->vbuf.needed / vs),
+            (const void *)offset, d->elem_count, 2);
+        offset += d->elem_count;
     }
+    civ_frame_trace_count(CIV_FRAME_DRAW_CALLS, (uint64_t)dev->draw_count);
 
     SDL_SetRenderClipRect(nksdl.renderer, &saved_clip);
     if (!clipping) SDL_SetRenderClipRect(nksdl.renderer, NULL);
 
     nk_clear(ctx);
-    nk_buffer_clear(&dev->cmds);
-    nk_buffer_free(&vbuf);
-    nk_buffer_free(&ebuf);
 }
 
 /* ── Theme ─────────────────────────────────────────────────────── */
@@ -349,5 +423,11 @@ void nk_ui_shutdown(void) {
     nksdl.dev.font_tex = NULL;
     nk_font_atlas_clear(&nksdl.atlas);
     nk_buffer_free(&nksdl.dev.cmds);
+    nk_buffer_free(&nksdl.dev.vbuf);
+    nk_buffer_free(&nksdl.dev.ebuf);
+    SDL_free(nksdl.dev.draws);
+    nksdl.dev.draws = NULL;
+    nksdl.dev.draw_count = nksdl.dev.draw_capacity = 0;
+    nksdl.dev.cached = false;
     nk_free(&nksdl.ctx);
 }
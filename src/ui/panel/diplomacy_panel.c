@@ -21,38 +21,42 @@ void civ_diplomacy_panel_render(SDL_Renderer *r, civ_game_t *game,
 
   int curr_y = dsb_y + 55;
   if (has_contacted_rival) {
-    civ_diplomatic_relation_t *rel =
-        civ_diplomacy_system_get_relation(game->diplomacy_system, "player",
-                                          "rival_kingdom");
+    const civ_diplomacy_system_t *ds = game->diplomacy_system;
+    civ_relation_id_t rel =
+        civ_diplomacy_relation_id(ds, "player", "rival_kingdom");
 
     civ_font_render_aligned(r, font, "RIVAL KINGDOM", dsb_x + 15, curr_y,
                             dsb_w - 30, 30, 0xFFFFFF, CIV_ALIGN_LEFT,
                             CIV_VALIGN_TOP);
     curr_y += 25;
 
-    if (rel) {
+    if (rel != CIV_RELATION_NONE) {
+      civ_relation_level_t level = (civ_relation_level_t)ds->rel.relation_level[rel];
+      civ_ai_stance_t stance = (civ_ai_stance_t)ds->rel.current_stance[rel];
+      civ_personality_type_t personality =
+          (civ_personality_type_t)ds->rel.personality[rel];
       char buf[64];
       const char *lvl_str = "Neutral";
-      if (rel->relation_level == CIV_RELATION_LEVEL_WAR) lvl_str = "WAR";
-      else if (rel->relation_level == CIV_RELATION_LEVEL_HOSTILE)
+      if (level == CIV_RELATION_LEVEL_WAR) lvl_str = "WAR";
+      else if (level == CIV_RELATION_LEVEL_HOSTILE)
         lvl_str = "Hostile";
-      else if (rel->relation_level == CIV_RELATION_LEVEL_FRIENDLY)
+      else if (level == CIV_RELATION_LEVEL_FRIENDLY)
         lvl_str = "Friendly";
-      else if (rel->relation_level == CIV_RELATION_LEVEL_ALLIED)
+      else if (level == CIV_RELATION_LEVEL_ALLIED)
         lvl_str = "Allied";
 
-      sprintf(buf, "STATUS: %s (Opinion: %.0f)", lvl_str, rel->opinion_score);
+      sprintf(buf, "STATUS: %s (Opinion: %.0f)", lvl_str, ds->rel.opinion_score[rel]);
       civ_font_render_aligned(r, font, buf, dsb_x + 15, curr_y, dsb_w - 30, 30,
                               0xAAAAAA, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
       curr_y += 25;
 
       const char *stance_str = "Neutral";
       uint32_t stance_color = 0xAAAAAA;
-      if (rel->current_stance == CIV_STANCE_HOSTILE)
+      if (stance == CIV_STANCE_HOSTILE)
         stance_str = "HOSTILE", stance_color = 0xFF4444;
-      else if (rel->current_stance == CIV_STANCE_WARY)
+      else if (stance == CIV_STANCE_WARY)
         stance_str = "WARY", stance_color = 0xFFCC00;
-      else if (rel->current_stance == CIV_STANCE_FRIENDLY)
+      else if (stance == CIV_STANCE_FRIENDLY)
         stance_str = "FRIENDLY", stance_color = 0x44FF44;
 
       sprintf(buf, "STANCE: %s", stance_str);
@@ -61,10 +65,10 @@ void civ_diplomacy_panel_render(SDL_Renderer *r, civ_game_t *game,
       curr_y += 25;
 
       const char *p_str = "Balanced";
-      if (rel->personality == CIV_PERSONALITY_AGGRESSIVE) p_str = "Aggressive";
-      else if (rel->personality == CIV_PERSONALITY_EXPANSIONIST)
+      if (personality == CIV_PERSONALITY_AGGRESSIVE) p_str = "Aggressive";
+      else if (personality == CIV_PERSONALITY_EXPANSIONIST)
         p_str = "Expansionist";
-      else if (rel->personality == CIV_PERSONALITY_MERCANTILE)
+      else if (personality == CIV_PERSONALITY_MERCANTILE)
         p_str = "Mercantile";
       sprintf(buf, "PERSONALITY: %s", p_str);
       civ_font_render_aligned(r, font, buf, dsb_x + 15, curr_y, dsb_w - 30, 30,
@@ -105,6 +109,12 @@ void civ_diplomacy_panel_render(SDL_Renderer *r, civ_game_t *game,
   }
 }
 
+static void propose(civ_game_t *game, civ_treaty_type_t type) {
+  civ_command_t cmd = {.type = CIV_CMD_PROPOSE_TREATY, .i = {type, 30},
+                       .text = "player", .text2 = "rival_kingdom"};
+  civ_game_execute(game, &cmd);
+}
+
 bool civ_diplomacy_panel_click(civ_game_t *game, civ_input_state_t *input,
                                int win_w, int win_h, bool has_contacted_rival) {
   if (!game || !input || !has_contacted_rival) return false;
@@ -113,16 +123,12 @@ bool civ_diplomacy_panel_click(civ_game_t *game, civ_input_state_t *input,
   int curr_y = dsb_y + 180;
 
   if (civ_input_is_mouse_over(input, dsb_x + 10, curr_y, dsb_w - 20, 40)) {
-    civ_diplomacy_system_propose_treaty(game->diplomacy_system, "player",
-                                        "rival_kingdom",
-                                        CIV_TREATY_TYPE_TRADE_AGREEMENT, 30);
+    propose(game, CIV_TREATY_TYPE_TRADE_AGREEMENT);
     return true;
   }
   curr_y += 50;
   if (civ_input_is_mouse_over(input, dsb_x + 10, curr_y, dsb_w - 20, 40)) {
-    civ_diplomacy_system_propose_treaty(game->diplomacy_system, "player",
-                                        "rival_kingdom",
-                                        CIV_TREATY_TYPE_NON_AGGRESSION, 30);
+    propose(game, CIV_TREATY_TYPE_NON_AGGRESSION);
     return true;
   }
   return false;
@@ -39,13 +39,14 @@ void civ_rulebook_panel_render(SDL_Renderer *r, civ_game_t *game,
   curr_y += 35;
 
   if (gov->institution_manager) {
-    for (size_t i = 0; i < gov->institution_manager->count; i++) {
-      civ_institution_t *inst = &gov->institution_manager->items[i];
+    const civ_institution_manager_t *im = gov->institution_manager;
+    for (size_t i = 0; i < im->count; i++) {
+      const civ_institution_t *inst = &im->items[i];
       civ_render_rect_filled(r, rbe_x + 40, curr_y, rbe_w - 80, 50, 0x1A2A3A);
       civ_font_render_aligned(r, font, inst->name, rbe_x + 50, curr_y + 5, 300,
                               20, 0xFFFFFF, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
-      sprintf(buf, "Stature: %.1f | Maint: %.1f Gold", inst->stature,
-              inst->maintenance_cost);
+      sprintf(buf, "Stature: %.1f | Maint: %.1f Gold", im->stature[i],
+              im->maintenance_cost[i]);
       civ_font_render_aligned(r, font, buf, rbe_x + 50, curr_y + 25, 400, 20,
                               0xAAAAAA, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
       curr_y += 60;
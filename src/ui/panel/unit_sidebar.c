@@ -3,9 +3,11 @@
 #include <stdio.h>
 #include <string.h>
 
-void civ_unit_sidebar_render(SDL_Renderer *r, civ_unit_t *unit, civ_font_t *font,
+void civ_unit_sidebar_render(SDL_Renderer *r, const civ_unit_manager_t *um,
+                             size_t index, civ_font_t *font,
                              civ_input_state_t *input) {
-  if (!r || !unit || !font) return;
+  if (!r || !um || index >= um->unit_count || !font) return;
+  const civ_unit_t *unit = &um->units[index];
 
   int sb_w = 280, sb_h = 320, sb_x = 20, sb_y = 60;
 
@@ -28,7 +30,7 @@ void civ_unit_sidebar_render(SDL_Renderer *r, civ_unit_t *unit, civ_font_t *font
                           0xCCCCCC, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
   curr_y += 30;
 
-  sprintf(buf, "STRENGTH: %d / %d", unit->current_strength, unit->max_strength);
+  sprintf(buf, "STRENGTH: %d / %d", um->strength[index], unit->max_strength);
   civ_font_render_aligned(r, font, buf, sb_x + 15, curr_y, sb_w - 30, 25,
                           0xCCCCCC, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
   curr_y += 30;
@@ -38,12 +40,12 @@ void civ_unit_sidebar_render(SDL_Renderer *r, civ_unit_t *unit, civ_font_t *font
                           0xCCCCCC, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
   curr_y += 30;
 
-  sprintf(buf, "POS: (%d, %d)", unit->x, unit->y);
+  sprintf(buf, "POS: (%d, %d)", um->x[index], um->y[index]);
   civ_font_render_aligned(r, font, buf, sb_x + 15, curr_y, sb_w - 30, 25,
                           0xCCCCCC, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
   curr_y += 40;
 
-  if (unit->has_moved) {
+  if (um->moved[index]) {
     civ_font_render_aligned(r, font, "MOVEMENT EXHAUSTED", sb_x + 15, curr_y,
                             sb_w - 30, 25, 0xFF4444, CIV_ALIGN_LEFT,
                             CIV_VALIGN_TOP);
@@ -54,7 +56,7 @@ void civ_unit_sidebar_render(SDL_Renderer *r, civ_unit_t *unit, civ_font_t *font
   }
   curr_y += 35;
 
-  if (unit->unit_type == CIV_UNIT_TYPE_SETTLER && !unit->has_moved) {
+  if (unit->unit_type == CIV_UNIT_TYPE_SETTLER && !um->moved[index]) {
     int f_btn_x = sb_x + 15, f_btn_y = sb_y + 250, f_btn_w = sb_w - 30,
         f_btn_h = 40;
     bool f_hov = (input->mouse_x >= f_btn_x && input->mouse_x <= f_btn_x + f_btn_w &&
@@ -67,9 +69,10 @@ void civ_unit_sidebar_render(SDL_Renderer *r, civ_unit_t *unit, civ_font_t *font
   }
 }
 
-int civ_unit_sidebar_click(civ_unit_t *unit, civ_input_state_t *input) {
-  if (!unit || !input || unit->unit_type != CIV_UNIT_TYPE_SETTLER ||
-      unit->has_moved)
+int civ_unit_sidebar_click(const civ_unit_manager_t *um, size_t index,
+                           civ_input_state_t *input) {
+  if (!um || index >= um->unit_count || !input ||
+      um->units[index].unit_type != CIV_UNIT_TYPE_SETTLER || um->moved[index])
     return 0;
   if (input->mouse_x >= 35 && input->mouse_x <= 285 && input->mouse_y >= 310 &&
       input->mouse_y <= 350)
@@ -3,16 +3,21 @@
 #include "core/military/combat.h"
 #include "ui/nuklear_ui.h"
 #include "core/time_engine.h"
+#include "core/simulation_engine/sim_thread.h"
 #include "core/world/nation.h"
 #include "core/world/political_borders.h"
 #include "core/world/map_view.h"
+#include "core/world/visibility.h"
 #include "core/world/wonders.h"
 #include "display/camera.h"
 #include "display/debug_overlay.h"
 #include "display/layer.h"
 #include "display/theme.h"
 #include "ui/graph/graph.h"
+#include "ui/hit_grid.h"
 #include "engine/font.h"
+#include "engine/frame_pacer.h"
+#include "engine/quality_governor.h"
 #include "engine/renderer.h"
 #include "ui/panel/diplomacy_panel.h"
 #include "ui/panel/governance_panel.h"
@@ -22,9 +27,12 @@
 #include "ui/panel/unit_sidebar.h"
 #include "ui/panel/wonders_panel.h"
 #include "ui/scene.h"
+#include "ui/screens/screen_metrics.h"
 #include "ui/screens/screens.h"
 #include "ui/ui_common.h"
+#include "utils/startup_timeline.h"
 #include <SDL3/SDL.h>
+#include <ctype.h>
 #include <math.h>
 #include <stdio.h>
 #include <string.h>
@@ -33,16 +41,25 @@
 static civ_camera_t               cam;
 static civ_debug_overlay_t        debug;
 static civ_render_map_context_t  *map_ctx = NULL;
+static SDL_Renderer              *map_renderer = NULL; /* map_ctx's, for prebake */
+static civ_game_t                *prebake_game = NULL;
 static civ_font_t                *font_hud = NULL;
+static civ_font_t                *font_label = NULL; /* nation names, scaled */
 static int                        last_win_w, last_win_h;
-static civ_unit_t             *selected_unit = NULL;
+static civ_unit_handle_t       selected_unit = CIV_UNIT_HANDLE_NONE;
+static size_t                 *visible_units = NULL; /* render_units_layer scratch */
+static size_t                  visible_units_cap = 0;
+static civ_render_marker_t    *unit_markers = NULL;  /* aggregated units */
+static size_t                  unit_markers_cap = 0;
+static size_t                 *visible_settlements = NULL;
+static size_t                  visible_settlements_cap = 0;
 static civ_settlement_t       *selected_settlement = NULL;
 static bool                    show_diplomacy, show_research;
 static bool                    show_government, show_wonders, show_rulebook;
 static bool                    has_contacted_rival;
-static float                    time_accumulator = 0.0f;
 static int                      time_speed = 1;
 static float                    days_per_second = 1.0f;
+static int32_t                  last_seen_turn = 0;
 
 /* Screen navigation */
 typedef enum { SCR_MAP, SCR_DIPLOMACY, SCR_ECONOMY, SCR_MILITARY,
@@ -93,29 +110,33 @@ static void toast_render(SDL_Renderer *r) {
 static char                     selected_nation_id[64] = "";
 static int16_t                  selected_nation_cid = -1;
 static bool                     show_nation_detail = false;
+/* Hit-grid layers drawn over the map (see ui/hit_grid.h) */
+static const char               hud_layer, popup_layer;
 static char                     hovered_country[128] = "";
 static float                    hover_country_x, hover_country_y;
 
 /* ── Visibility helper ────────────────────────────────────────────── */
+static civ_visibility_t        *fog = NULL;
+
+/* Restamp only the units that moved since the last call */
 static void update_visibility(civ_game_t *game) {
   if (!game || !game->world_map || !game->unit_manager) return;
-  for (int32_t i = 0; i < game->world_map->width * game->world_map->height; i++)
-    game->world_map->tiles[i].is_visible = false;
-  for (size_t i = 0; i < game->unit_manager->unit_count; i++) {
-    civ_unit_t *u = &game->unit_manager->units[i];
-    int32_t r = u->visibility_range;
-    for (int32_t dy = -r; dy <= r; dy++) {
-      for (int32_t dx = -r; dx <= r; dx++) {
-        if (dx * dx + dy * dy > r * r) continue;
-        int32_t tx = (u->x + dx + game->world_map->width) % game->world_map->width;
-        int32_t ty = u->y + dy;
-        if (ty >= 0 && ty < game->world_map->height) {
-          civ_map_tile_t *t = civ_map_get_tile(game->world_map, tx, ty);
-          if (t) t->is_visible = true, t->is_explored = true;
-        }
-      }
-    }
-  }
+  if (!fog && !(fog = civ_visibility_create())) return;
+  const civ_unit_manager_t *um = game->unit_manager;
+  for (size_t i = 0; i < um->unit_count; i++)
+    civ_visibility_update_source(fog, game->world_map, i, um->x[i], um->y[i],
+                                 um->units[i].visibility_range);
+  civ_visibility_truncate(fog, game->world_map, game->unit_manager->unit_count);
+}
+
+/* Idle task: bake the current view's chunks and LODs ahead of the camera,
+   so panning and zooming out find them ready */
+static bool prebake_map(void *user_data, Uint64 deadline_ns) {
+  civ_game_t *game = (civ_game_t *)user_data;
+  if (!map_ctx || !map_renderer || !game->world_map) return false;
+  return civ_render_map_prebake(map_renderer, map_ctx, game->world_map,
+                                current_map_view, game->resource_map,
+                                deadline_ns);
 }
 
 /* ── Rendering helpers ─────────────────────────────────────────────── */
@@ -128,25 +149,73 @@ static void render_map_layer(SDL_Renderer *r, civ_game_t *game) {
 
 static void render_units_layer(SDL_Renderer *r, civ_game_t *game) {
   if (!game->unit_manager || !font_hud) return;
-  for (size_t i = 0; i < game->unit_manager->unit_count; i++) {
-    civ_unit_t *u = &game->unit_manager->units[i];
-    if (u->current_strength <= 0) continue;
+
+  /* Tile rect under the window, padded past civ_camera_is_visible's margin */
+  float wx0, wy0, wx1, wy1;
+  civ_camera_screen_to_world(&cam, last_win_w, last_win_h, -64, -64, &wx0, &wy0);
+  civ_camera_screen_to_world(&cam, last_win_w, last_win_h, last_win_w + 64,
+                             last_win_h + 64, &wx1, &wy1);
+  int32_t x0 = (int32_t)floorf(wx0) - 24, y0 = (int32_t)floorf(wy0) - 24;
+  int32_t x1 = (int32_t)ceilf(wx1) + 24, y1 = (int32_t)ceilf(wy1) + 24;
+
+  size_t n = civ_unit_manager_query_rect(game->unit_manager, x0, y0, x1, y1,
+                                         visible_units, visible_units_cap);
+  if (n > visible_units_cap) {
+    size_t *grown = CIV_REALLOC(visible_units, n * 2 * sizeof(size_t));
+    if (grown) {
+      visible_units = grown;
+      visible_units_cap = n * 2;
+      n = civ_unit_manager_query_rect(game->unit_manager, x0, y0, x1, y1,
+                                      visible_units, visible_units_cap);
+    } else {
+      n = visible_units_cap;
+    }
+  }
+
+  /* Too small to tell apart: one marker per crowded screen cell */
+  float size = 48.0f * cam.zoom;
+  if (map_ctx && size < map_ctx->cluster_min_px) {
+    if (n > unit_markers_cap) {
+      civ_render_marker_t *grown =
+          CIV_REALLOC(unit_markers, n * 2 * sizeof(civ_render_marker_t));
+      if (!grown) return;
+      unit_markers = grown;
+      unit_markers_cap = n * 2;
+    }
+    for (size_t k = 0; k < n; k++) {
+      size_t u = visible_units[k];
+      civ_camera_world_to_screen(&cam, last_win_w, last_win_h,
+                                 (float)game->unit_manager->x[u],
+                                 (float)game->unit_manager->y[u],
+                                 &unit_markers[k].x, &unit_markers[k].y);
+      unit_markers[k].color =
+          game->unit_manager->units[u].unit_type == CIV_UNIT_TYPE_SETTLER
+              ? 0x00FFCC
+              : 0xFF2200;
+    }
+    civ_render_marker_clusters(r, map_ctx, unit_markers, n, last_win_w,
+                               last_win_h);
+    return;
+  }
+
+  const civ_unit_manager_t *um = game->unit_manager;
+  int32_t selected = civ_unit_manager_resolve(um, selected_unit);
+  for (size_t k = 0; k < n; k++) {
+    size_t u = visible_units[k];
+    float ux = (float)um->x[u], uy = (float)um->y[u];
 
     float sx, sy;
-    civ_camera_world_to_screen(&cam, last_win_w, last_win_h, (float)u->x,
-                               (float)u->y, &sx, &sy);
-    float size = 48.0f * cam.zoom;
-    if (!civ_camera_is_visible(&cam, last_win_w, last_win_h, (float)u->x,
-                               (float)u->y, 24.0f))
+    civ_camera_world_to_screen(&cam, last_win_w, last_win_h, ux, uy, &sx, &sy);
+    if (!civ_camera_is_visible(&cam, last_win_w, last_win_h, ux, uy, 24.0f))
       continue;
 
-    if (selected_unit == u)
+    if ((int32_t)u == selected)
       civ_render_rect_filled_alpha(r, (int)(sx - size / 2 - 4),
                                    (int)(sy - size / 2 - 4), (int)size + 8,
                                    (int)size + 8, g_theme.info, 180);
 
-    uint32_t color = u->has_moved ? 0x555555 : 0xFF2200;
-    if (u->unit_type == CIV_UNIT_TYPE_SETTLER) color = 0x00FFCC;
+    uint32_t color = um->moved[u] ? 0x555555 : 0xFF2200;
+    if (um->units[u].unit_type == CIV_UNIT_TYPE_SETTLER) color = 0x00FFCC;
     civ_render_rect_filled(r, (int)(sx - size / 2), (int)(sy - size / 2),
                            (int)size, (int)size, color);
     civ_render_rect_outline(r, (int)(sx - size / 2), (int)(sy - size / 2),
@@ -156,8 +225,36 @@ static void render_units_layer(SDL_Renderer *r, civ_game_t *game) {
 
 static void render_settlements_layer(SDL_Renderer *r, civ_game_t *game) {
   if (!game->settlement_manager || !font_hud) return;
-  for (size_t i = 0; i < game->settlement_manager->settlement_count; i++) {
-    civ_settlement_t *s = &game->settlement_manager->settlements[i];
+  if (map_ctx)
+    civ_render_settlements(r, map_ctx, game->settlement_manager, last_win_w,
+                           last_win_h);
+  /* Aggregated markers carry no labels */
+  float cluster_px = map_ctx ? map_ctx->cluster_min_px : CIV_RENDER_CLUSTER_MIN_PX;
+  if (40.0f * cam.zoom < cluster_px) return;
+
+  float wx0, wy0, wx1, wy1;
+  civ_camera_screen_to_world(&cam, last_win_w, last_win_h, -128, -64, &wx0, &wy0);
+  civ_camera_screen_to_world(&cam, last_win_w, last_win_h, last_win_w + 128,
+                             last_win_h + 64, &wx1, &wy1);
+  size_t n = civ_settlement_manager_query_rect(
+      game->settlement_manager, wx0, wy0, wx1, wy1, visible_settlements,
+      visible_settlements_cap);
+  if (n > visible_settlements_cap) {
+    size_t *grown = CIV_REALLOC(visible_settlements, n * 2 * sizeof(size_t));
+    if (grown) {
+      visible_settlements = grown;
+      visible_settlements_cap = n * 2;
+      n = civ_settlement_manager_query_rect(
+          game->settlement_manager, wx0, wy0, wx1, wy1, visible_settlements,
+          visible_settlements_cap);
+    } else {
+      n = visible_settlements_cap;
+    }
+  }
+
+  civ_font_begin_batch();
+  for (size_t k = 0; k < n; k++) {
+    civ_settlement_t *s = &game->settlement_manager->settlements[visible_settlements[k]];
     float sx, sy;
     civ_camera_world_to_screen(&cam, last_win_w, last_win_h, s->x, s->y, &sx,
                                &sy);
@@ -175,6 +272,22 @@ static void render_settlements_layer(SDL_Renderer *r, civ_game_t *game) {
                             200, 20, 0xFFFFFF, CIV_ALIGN_CENTER,
                             CIV_VALIGN_TOP);
   }
+  civ_font_end_batch();
+}
+
+/* A nation's flag file, or a procedural design from its id and colors for
+   nations without one */
+static const civ_flag_entry_t *nation_flag(civ_game_t *game, const civ_nation_t *nat) {
+  const civ_flag_entry_t *fl =
+      nat->iso_a2[0] ? civ_flag_system_get_by_iso(game->flag_system, nat->iso_a2) : NULL;
+  if (fl) return fl;
+  uint64_t seed = 1469598103934665603ull;
+  for (const char *c = nat->id; *c; c++) seed = (seed ^ (uint8_t)*c) * 1099511628211ull;
+  civ_flag_t design;
+  civ_vexillology_generate(&design, seed, nat->color, nat->color_accent);
+  return civ_flag_system_procedural(
+      game->flag_system, &design,
+      civ_system_orchestrator_get_worker_pool(game->system_orchestrator));
 }
 
 static void render_hud_top(SDL_Renderer *r, civ_game_t *game) {
@@ -205,9 +318,8 @@ static void render_hud_top(SDL_Renderer *r, civ_game_t *game) {
   if (selected_nation_id[0] && game->nation_manager) {
     civ_nation_t *nat = civ_nation_get_by_id(
         (civ_nation_manager_t *)game->nation_manager, selected_nation_id);
-    if (nat && nat->iso_a2[0] && game->flag_system) {
-      const civ_flag_entry_t *fl = civ_flag_system_get_by_iso(
-          game->flag_system, nat->iso_a2);
+    if (nat && game->flag_system) {
+      const civ_flag_entry_t *fl = nation_flag(game, nat);
       if (fl) civ_flag_render(r, fl, 6, 4, 32, 20);
     }
   }
@@ -238,9 +350,8 @@ static void render_hud_top(SDL_Renderer *r, civ_game_t *game) {
     if (game->nation_manager)
       nat = civ_nation_get_by_id((civ_nation_manager_t *)game->nation_manager,
                                   hovered_country);
-    if (nat && nat->iso_a3[0] && game->flag_system) {
-      const civ_flag_entry_t *flag = civ_flag_system_get_by_iso(
-          game->flag_system, nat->iso_a2);
+    if (nat && game->flag_system) {
+      const civ_flag_entry_t *flag = nation_flag(game, nat);
       if (flag) {
         civ_flag_render(r, flag, cx + 6, cy + 4, 32, 20);
       }
@@ -263,58 +374,297 @@ static void render_hud_top(SDL_Renderer *r, civ_game_t *game) {
 
 }
 
+/* ── Nation labels ────────────────────────────────────────────────── */
+/* Each nation's name is laid out once per baseline revision (see
+   core/world/nation_labels.h): glyph centres and angles along the path in
+   tile coordinates, at a size that fits the territory. A frame only maps
+   those centres to the screen and queues one rotated atlas quad per glyph. */
+#define NATION_LABEL_GLYPHS  48
+#define NATION_LABEL_MIN_PX  9.0f   /* glyph height below which names hide */
+#define NATION_LABEL_MAX_PX  140.0f /* ... and above which */
+
+typedef struct {
+  const civ_nation_labels_t *source;
+  uint32_t revision;
+  float    length;
+  int      count;
+  float    x[NATION_LABEL_GLYPHS], y[NATION_LABEL_GLYPHS];
+  float    angle[NATION_LABEL_GLYPHS];
+  char     glyph[NATION_LABEL_GLYPHS][5];
+  float    tiles_per_px;             /* of the rasterized font */
+  int      height;                   /* rasterized glyph height, px */
+} civ_nation_label_layout_t;
+
+static civ_nation_label_layout_t *nation_layouts = NULL;
+static int                        nation_layouts_cap = 0;
+
+static void layout_nation_label(civ_nation_label_layout_t *lay, const char *name,
+                                const civ_nation_label_path_t *path,
+                                const civ_nation_labels_t *source) {
+  lay->source = source;
+  lay->revision = path->revision;
+  lay->length = path->length;
+  lay->count = 0;
+
+  /* Upper-case glyphs, one UTF-8 sequence each; spaces only advance */
+  float advance[NATION_LABEL_GLYPHS];
+  int n = 0;
+  float total = 0.0f, space = 0.0f;
+  int sw = 0, sh = 0;
+  civ_font_get_text_size(font_label, " ", &sw, &sh);
+  space = (float)sw;
+  for (const unsigned char *c = (const unsigned char *)name; *c && n < NATION_LABEL_GLYPHS;) {
+    int len = *c < 0x80 ? 1 : (*c >> 5) == 6 ? 2 : (*c >> 4) == 14 ? 3 : 4;
+    char *g = lay->glyph[n];
+    int k = 0;
+    for (; k < len && c[k]; k++) g[k] = (char)(len == 1 ? toupper(c[k]) : c[k]);
+    g[k] = '\0';
+    c += k;
+    int w = 0, h = 0;
+    if (g[0] == ' ') w = (int)space;
+    else civ_font_get_text_size(font_label, g, &w, &h);
+    advance[n] = (float)w;
+    total += (float)w;
+    n++;
+  }
+  int height = civ_font_get_height(font_label);
+  if (n == 0 || total <= 0.0f || height <= 0) return;
+
+  /* As large as the territory's depth allows within 80% of the path; when
+     depth is what limits it, the letters spread out along the path */
+  float target = path->length * 0.8f;
+  float scale = MIN(target / total, path->thickness * 0.6f / (float)height);
+  float track = n > 1 ? (target / scale - total) / (float)(n - 1) : 0.0f;
+  track = CLAMP(track, 0.0f, 0.8f * (float)height);
+  float span = (total + track * (float)(n - 1)) * scale;
+
+  /* Arc length at each path sample */
+  float arc[CIV_NATION_LABEL_SAMPLES];
+  arc[0] = 0.0f;
+  for (int i = 1; i < CIV_NATION_LABEL_SAMPLES; i++)
+    arc[i] = arc[i - 1] + hypotf(path->x[i] - path->x[i - 1], path->y[i] - path->y[i - 1]);
+
+  float at = (path->length - span) * 0.5f;
+  int seg = 0;
+  for (int i = 0; i < n; i++) {
+    float centre = at + advance[i] * 0.5f * scale;
+    at += (advance[i] + track) * scale;
+    while (seg + 2 < CIV_NATION_LABEL_SAMPLES && arc[seg + 1] < centre) seg++;
+    float seg_len = arc[seg + 1] - arc[seg];
+    float t = seg_len > 0.0f ? CLAMP((centre - arc[seg]) / seg_len, 0.0f, 1.0f) : 0.0f;
+    float dx = path->x[seg + 1] - path->x[seg], dy = path->y[seg + 1] - path->y[seg];
+    lay->x[i] = path->x[seg] + dx * t;
+    lay->y[i] = path->y[seg] + dy * t;
+    lay->angle[i] = atan2f(dy, dx);
+  }
+  lay->count = n;
+  lay->tiles_per_px = scale;
+  lay->height = height;
+}
+
+static void render_nation_labels(SDL_Renderer *r, civ_game_t *game) {
+  civ_nation_manager_t *nm = (civ_nation_manager_t *)game->nation_manager;
+  if (!font_label || !nm || !game->nation_labels) return;
+  if (nm->count > nation_layouts_cap) {
+    civ_nation_label_layout_t *grown = CIV_REALLOC(
+        nation_layouts, (size_t)nm->count * sizeof(*grown));
+    if (!grown) return;
+    memset(grown + nation_layouts_cap, 0,
+           (size_t)(nm->count - nation_layouts_cap) * sizeof(*grown));
+    nation_layouts = grown;
+    nation_layouts_cap = nm->count;
+  }
+
+  const float U = 4.0f;
+  float px_per_tile = cam.zoom * U;
+  civ_font_begin_batch();
+  for (int i = 0; i < nm->count; i++) {
+    const civ_nation_t *nat = &nm->nations[i];
+    const civ_nation_label_path_t *path =
+        civ_nation_labels_path(game->nation_labels, nat->owner_index);
+    if (!path) continue;
+    civ_nation_label_layout_t *lay = &nation_layouts[i];
+    if (lay->source != game->nation_labels || lay->revision != path->revision ||
+        lay->length != path->length)
+      layout_nation_label(lay, nat->name, path, game->nation_labels);
+    if (lay->count == 0) continue;
+
+    float scale = lay->tiles_per_px * px_per_tile;
+    float glyph_px = scale * (float)lay->height;
+    if (glyph_px < NATION_LABEL_MIN_PX || glyph_px > NATION_LABEL_MAX_PX) continue;
+    /* Fade out as the names grow past the middle of the range */
+    float fade = CLAMP((NATION_LABEL_MAX_PX - glyph_px) / (NATION_LABEL_MAX_PX * 0.5f),
+                       0.0f, 1.0f);
+    uint8_t alpha = (uint8_t)(150.0f * fade);
+    if (alpha == 0) continue;
+
+    for (int g = 0; g < lay->count; g++) {
+      if (lay->glyph[g][0] == ' ') continue;
+      float sx, sy;
+      civ_camera_world_to_screen(&cam, last_win_w, last_win_h, lay->x[g],
+                                 lay->y[g], &sx, &sy);
+      if (sx < -glyph_px || sx > last_win_w + glyph_px || sy < -glyph_px ||
+          sy > last_win_h + glyph_px)
+        continue;
+      civ_font_render_transformed(r, font_label, lay->glyph[g], sx, sy, scale,
+                                  lay->angle[g], g_theme.text_secondary, alpha);
+    }
+  }
+  civ_font_end_batch();
+}
+
+/* ── City labels ──────────────────────────────────────────────────── */
+/* Labels are placed once per zoom band (a factor of sqrt 2) over the view
+   padded by half its size each side: candidates ranked capitals first,
+   then by tier and population, each kept only if its box finds the
+   occupancy grid free. Boxes take their size at the band's smallest zoom,
+   where they cover the most tiles, so no zoom inside the band overlaps. */
+#define LABEL_CELL_PX   8    /* occupancy grid cell, px */
+#define LABEL_PAD_PX    3    /* kept clear around each label */
+#define LABEL_DOT_PX    6    /* name sits this far below the city dot */
+#define LABELS_MAX      256
+
+typedef struct {
+  const civ_city_data_t *city;
+  int16_t w, h;               /* text size, px */
+} civ_map_label_t;
+
+static struct {
+  const civ_cities_data_t *data;
+  uint32_t         city_count;
+  int              band;
+  int32_t          x0, y0, x1, y1; /* padded tile rect placed over */
+  bool             valid;
+  civ_map_label_t  labels[LABELS_MAX];
+  int              count;
+} label_cache;
+
+static int compare_label_rank(const void *a, const void *b) {
+  const civ_city_data_t *x = *(const civ_city_data_t *const *)a;
+  const civ_city_data_t *y = *(const civ_city_data_t *const *)b;
+  int cx = x->capital_flag & 1, cy = y->capital_flag & 1;
+  if (cx != cy) return cy - cx;
+  if (x->tier != y->tier) return (int)x->tier - (int)y->tier;
+  if (x->population != y->population) return x->population < y->population ? 1 : -1;
+  return (x > y) - (x < y);
+}
+
+static void place_city_labels(civ_game_t *game, const civ_cities_data_t *cities_data,
+                              int band, float band_zoom, float U) {
+  label_cache.count = 0;
+  float tiles_per_px = 1.0f / (band_zoom * U);
+  float half_w = last_win_w * 0.5f * tiles_per_px;
+  float half_h = last_win_h * 0.5f * tiles_per_px;
+  label_cache.x0 = (int32_t)floorf(cam.x - half_w * 2.0f);
+  label_cache.y0 = (int32_t)floorf(cam.y - half_h * 2.0f);
+  label_cache.x1 = (int32_t)ceilf(cam.x + half_w * 2.0f);
+  label_cache.y1 = (int32_t)ceilf(cam.y + half_h * 2.0f);
+  label_cache.band = band;
+  label_cache.data = cities_data;
+  label_cache.city_count = cities_data->count;
+  label_cache.valid = true;
+
+  uint8_t min_tier = band_zoom >= 8.0f ? CIV_CITY_TIER_SMALL
+                   : band_zoom >= 4.0f ? CIV_CITY_TIER_MEDIUM
+                                       : CIV_CITY_TIER_LARGE;
+  uint32_t count = 0;
+  const civ_city_data_t **cands = civ_cities_query_tiles_arena(
+      cities_data, label_cache.x0, label_cache.y0,
+      label_cache.x1 - label_cache.x0, label_cache.y1 - label_cache.y0,
+      min_tier, game->frame_arena, &count);
+  if (!cands || count == 0) return;
+  qsort(cands, count, sizeof(*cands), compare_label_rank);
+
+  /* Occupancy over the padded rect, one byte per cell */
+  float cell_tiles = LABEL_CELL_PX * tiles_per_px;
+  int cols = (int)((float)(label_cache.x1 - label_cache.x0) / cell_tiles) + 1;
+  int rows = (int)((float)(label_cache.y1 - label_cache.y0) / cell_tiles) + 1;
+  uint8_t *occupied = CIV_ARENA_PUSH_ARRAY(game->frame_arena, uint8_t,
+                                           (size_t)cols * (size_t)rows);
+  if (!occupied) return;
+  memset(occupied, 0, (size_t)cols * (size_t)rows);
+
+  int text_h = civ_font_get_height(font_hud);
+  for (uint32_t i = 0; i < count && label_cache.count < LABELS_MAX; i++) {
+    const civ_city_data_t *city = cands[i];
+    int w = 0, h = 0;
+    civ_font_get_text_size(font_hud, city->name, &w, &h);
+    if (h <= 0) h = text_h;
+
+    /* Box around dot and name, in cells relative to the rect's corner */
+    float ox = ((float)city->tile_x - (float)label_cache.x0) / tiles_per_px;
+    float oy = ((float)city->tile_y - (float)label_cache.y0) / tiles_per_px;
+    int c0 = (int)floorf((ox - w * 0.5f - LABEL_PAD_PX) / LABEL_CELL_PX);
+    int c1 = (int)floorf((ox + w * 0.5f + LABEL_PAD_PX) / LABEL_CELL_PX);
+    int r0 = (int)floorf((oy - 2 - LABEL_PAD_PX) / LABEL_CELL_PX);
+    int r1 = (int)floorf((oy + LABEL_DOT_PX + h + LABEL_PAD_PX) / LABEL_CELL_PX);
+    c0 = MAX(c0, 0); r0 = MAX(r0, 0);
+    c1 = MIN(c1, cols - 1); r1 = MIN(r1, rows - 1);
+    if (c0 > c1 || r0 > r1) continue;
+
+    bool clear = true;
+    for (int y = r0; clear && y <= r1; y++)
+      for (int x = c0; x <= c1; x++)
+        if (occupied[y * cols + x]) { clear = false; break; }
+    if (!clear) continue;
+    for (int y = r0; y <= r1; y++)
+      memset(occupied + y * cols + c0, 1, (size_t)(c1 - c0 + 1));
+    label_cache.labels[label_cache.count++] =
+        (civ_map_label_t){city, (int16_t)w, (int16_t)h};
+  }
+}
+
 static void render_city_labels(SDL_Renderer *r, civ_game_t *game) {
   /* Only show cities when zoomed in enough */
-  if (cam.zoom < 2.0f || !game->cities_data || !font_hud) return;
+  if (cam.zoom < 2.0f || !font_hud) return;
+  const civ_cities_data_t *cities_data = civ_game_cities(game);
+  if (!cities_data) return;
 
   const float U = 4.0f;
+  int band = (int)floorf(log2f(cam.zoom) * 2.0f);
+  float band_zoom = exp2f((float)band * 0.5f);
   float inv_scale = 1.0f / (cam.zoom * U);
   float half_w = (last_win_w * 0.5f) * inv_scale;
   float half_h = (last_win_h * 0.5f) * inv_scale;
 
-  int tx = (int)(cam.x - half_w);
-  int ty = (int)(cam.y - half_h);
-  int tw = (int)(half_w * 2.0f) + 1;
-  int th = (int)(half_h * 2.0f) + 1;
-
-  /* Query cities visible in viewport */
-  uint32_t count = 0;
-  const civ_city_data_t **cities = civ_cities_query_tiles(
-      game->cities_data, tx, ty, tw, th, CIV_CITY_TIER_LARGE, &count);
-  if (!cities) return;
-
-  /* Show at most ~50 labels to avoid clutter */
-  int shown = 0;
-  for (uint32_t i = 0; i < count && shown < 50; i++) {
-    const civ_city_data_t *city = cities[i];
+  /* Re-place when the band changes, the cities reload or the view leaves
+     the placed rect */
+  if (!label_cache.valid || label_cache.band != band ||
+      label_cache.data != cities_data ||
+      label_cache.city_count != cities_data->count ||
+      cam.x - half_w < (float)label_cache.x0 || cam.x + half_w > (float)label_cache.x1 ||
+      cam.y - half_h < (float)label_cache.y0 || cam.y + half_h > (float)label_cache.y1)
+    place_city_labels(game, cities_data, band, band_zoom, U);
+
+  civ_font_begin_batch();
+  for (int i = 0; i < label_cache.count; i++) {
+    const civ_map_label_t *label = &label_cache.labels[i];
+    const civ_city_data_t *city = label->city;
     float sx, sy;
     civ_camera_world_to_screen(&cam, last_win_w, last_win_h,
                                (float)city->tile_x, (float)city->tile_y,
                                &sx, &sy);
-    if (sx < -20 || sx > last_win_w + 20 || sy < -20 || sy > last_win_h + 20)
+    if (sx + label->w < 0 || sx - label->w > last_win_w ||
+        sy + LABEL_DOT_PX + label->h < 0 || sy - 2 > last_win_h)
       continue;
 
     uint32_t label_color = city->capital_flag ? g_theme.warning : g_theme.text_secondary;
-    int font_sz = city->tier <= CIV_CITY_TIER_MEGA ? 16 :
-                  city->tier <= CIV_CITY_TIER_LARGE ? 13 : 11;
-
-    /* Simple text render: just the city name */
     civ_font_render_aligned(r, font_hud, city->name,
-                            (int)sx - 40, (int)sy + 6, 80, font_sz + 4,
-                            label_color, CIV_ALIGN_CENTER, CIV_VALIGN_TOP);
+                            (int)sx - label->w / 2 - 1, (int)sy + LABEL_DOT_PX,
+                            label->w + 2, label->h, label_color,
+                            CIV_ALIGN_CENTER, CIV_VALIGN_TOP);
     civ_render_rect_filled(r, (int)sx - 1, (int)sy - 1, 3, 3,
                            city->capital_flag ? g_theme.warning : 0x6688AA);
-    shown++;
   }
-  civ_cities_free_result(cities);
+  civ_font_end_batch();
 }
 
 static void render_nation_detail_panel(SDL_Renderer *r, civ_game_t *game,
                                         civ_input_state_t *input) {
   if (!show_nation_detail || !game->nation_manager) return;
 
-  civ_nation_t *nat = civ_nation_get_by_id(
-      (civ_nation_manager_t *)game->nation_manager, selected_nation_id);
+  civ_screen_metrics_watch_nation(selected_nation_id);
+  const civ_nation_view_t *nv = civ_screen_nation_view(game);
 
   /* Panel positioning: center-left */
   int px = 240, py = 50, pw = 360, ph = 340;
@@ -338,7 +688,7 @@ static void render_nation_detail_panel(SDL_Renderer *r, civ_game_t *game,
                           close_hov ? g_theme.danger : g_theme.text_dim,
                           CIV_ALIGN_CENTER, CIV_VALIGN_MIDDLE);
 
-  if (!nat) {
+  if (!nv->found) {
     civ_font_render_aligned(r, font_hud, "Nation not found",
                             px + 12, py + 40, pw - 24, 20,
                             g_theme.danger, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
@@ -347,53 +697,30 @@ static void render_nation_detail_panel(SDL_Renderer *r, civ_game_t *game,
 
   /* Flag */
   int flag_x = px + 12, flag_y = py + 4;
-  if (nat->iso_a2[0] && game->flag_system) {
+  if (nv->iso_a2[0] && game->flag_system) {
     const civ_flag_entry_t *fl = civ_flag_system_get_by_iso(
-        game->flag_system, nat->iso_a2);
+        game->flag_system, nv->iso_a2);
     if (fl) civ_flag_render(r, fl, flag_x, flag_y, 48, 30);
   }
 
   /* Nation name */
-  civ_font_render_aligned(r, font_hud, nat->name,
+  civ_font_render_aligned(r, font_hud, nv->name,
                           px + 68, py + 2, pw - 80, 24,
                           g_theme.warning, CIV_ALIGN_LEFT, CIV_VALIGN_MIDDLE);
 
   /* Divider */
   civ_render_line(r, px + 10, py + 34, px + pw - 10, py + 34, g_theme.hud_border);
 
-  /* Stats */
-  char buf[256];
+  /* Stats, formatted after the last tick */
+  static const int line_h[4] = {15, 15, 14, 15};
+  static const int line_step[4] = {22, 20, 18, 20};
   int dy = py + 42;
-
-  snprintf(buf, sizeof(buf), "Capital: %.1f%c %.1f%c  |  ISO: %s",
-           fabsf(nat->capital_lat), nat->capital_lat >= 0 ? 'N' : 'S',
-           fabsf(nat->capital_lon), nat->capital_lon >= 0 ? 'E' : 'W',
-           nat->iso_a3[0] ? nat->iso_a3 : "—");
-  civ_font_render_aligned(r, font_hud, buf, px + 12, dy, pw - 24, 15,
-                          g_theme.hud_text, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
-  dy += 22;
-
-  snprintf(buf, sizeof(buf), "Population: %lldM  |  GDP: $%.0fM  |  Growth: %+.1f%%",
-           nat->population / 1000000, nat->economy.gdp,
-           nat->economy.gdp_growth * 100.0f);
-  civ_font_render_aligned(r, font_hud, buf, px + 12, dy, pw - 24, 15,
-                          g_theme.text_secondary, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
-  dy += 20;
-
-  snprintf(buf, sizeof(buf), "Unemp: %.1f%%  |  Infl: %.1f%%  |  Food: %.0fM",
-           nat->economy.unemployment * 100.0f,
-           nat->economy.inflation * 100.0f,
-           nat->economy.food_production / 1000000.0f);
-  civ_font_render_aligned(r, font_hud, buf, px + 12, dy, pw - 24, 14,
-                          g_theme.hud_text, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
-  dy += 18;
-
-  snprintf(buf, sizeof(buf), "Gov: %s  |  ISO: %s",
-           civ_government_proximity_label(nat->government),
-           nat->iso_a3[0] ? nat->iso_a3 : "—");
-  civ_font_render_aligned(r, font_hud, buf, px + 12, dy, pw - 24, 15,
-                          g_theme.text_secondary, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
-  dy += 20;
+  for (int i = 0; i < 4; i++) {
+    civ_font_render_aligned(r, font_hud, nv->lines[i], px + 12, dy, pw - 24,
+                            line_h[i], i % 2 ? g_theme.text_secondary : g_theme.hud_text,
+                            CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
+    dy += line_step[i];
+  }
 
   /* Indices */
   civ_render_line(r, px + 10, dy, px + pw - 10, dy, g_theme.hud_border);
@@ -401,39 +728,23 @@ static void render_nation_detail_panel(SDL_Renderer *r, civ_game_t *game,
   civ_font_render_aligned(r, font_hud, "INDICES", px + 12, dy, 100, 14,
                           g_theme.warning, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
   dy += 18;
-  snprintf(buf, sizeof(buf), "Tech %+d  Econ %+d  Mil %+d  Cult %+d",
-           nat->tech_index, nat->economic_index,
-           nat->military_index, nat->cultural_index);
-  civ_font_render_aligned(r, font_hud, buf, px + 12, dy, pw - 24, 14,
+  civ_font_render_aligned(r, font_hud, nv->indices, px + 12, dy, pw - 24, 14,
                           0x8899CC, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
   dy += 22;
 
-  /* Resource summary */
-  if (game->resource_map && game->world_map) {
-    civ_nation_resource_profile_t rp;
-    civ_nation_calculate_resources(nat, game->world_map,
-                                    game->resource_map, &rp);
+  /* Resource summary, largest holdings first */
+  if (nv->resources[0]) {
     civ_render_line(r, px + 10, dy, px + pw - 10, dy, g_theme.hud_border);
     dy += 6;
-    snprintf(buf, sizeof(buf), "RESOURCES: %d types, %d total",
-             rp.distinct_types, rp.total_resources);
-    civ_font_render_aligned(r, font_hud, buf, px + 12, dy, pw - 24, 14,
+    civ_font_render_aligned(r, font_hud, nv->resources, px + 12, dy, pw - 24, 14,
                             g_theme.warning, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
     dy += 16;
-    /* Top 5 resources */
-    int shown = 0;
-    for (int t = 0; t < 20 && shown < 5; t++) {
-      if (rp.quantities[t] > 0) {
-        snprintf(buf, sizeof(buf), "  %-14s Qty:%5u Qual:%d",
-                 civ_resource_type_name((civ_resource_type_t)t),
-                 rp.quantities[t], rp.best_quality[t]);
-        civ_font_render_aligned(r, font_hud, buf, px + 12, dy, pw - 24, 13,
-                                0x778899, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
-        dy += 14;
-        shown++;
-      }
+    for (int i = 0; i < nv->resource_count; i++) {
+      civ_font_render_aligned(r, font_hud, nv->resource_rows[i], px + 12, dy,
+                              pw - 24, 13, 0x778899, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
+      dy += 14;
     }
-    if (rp.distinct_types == 0) {
+    if (nv->no_resources) {
       civ_font_render_aligned(r, font_hud, "  No resources in territory",
                               px + 12, dy, pw - 24, 13,
                               g_theme.text_dim, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
@@ -590,8 +901,10 @@ static void init(void) {
   civ_theme_init_default();
   font_hud = civ_font_load_system("Inter", 12);
   if (!font_hud) font_hud = civ_font_load_system("Segoe UI", 12);
+  font_label = civ_font_load_system("Georgia", 40);
+  if (!font_label) font_label = civ_font_load_system("DejaVu Serif", 40);
   civ_debug_overlay_init(&debug);
-  selected_unit = NULL;
+  selected_unit = CIV_UNIT_HANDLE_NONE;
   selected_settlement = NULL;
   map_ctx = NULL;
 
@@ -600,15 +913,38 @@ static void init(void) {
   layers_wired = true;
 }
 
+/* Per-turn HUD notifications (called once for every turn that elapsed) */
+static void announce_turn(civ_game_t *game, int32_t turn) {
+  if (turn % 10 == 0 && game->nation_manager) {
+    civ_nation_manager_t *nm = (civ_nation_manager_t *)game->nation_manager;
+    int pi = nm->player_nation_index;
+    if (pi >= 0 && pi < nm->count) {
+      char tbuf[128];
+      snprintf(tbuf, sizeof(tbuf), "%s: GDP $%.0fM | Growth %+.1f%%",
+               nm->nations[pi].name,
+               nm->nations[pi].economy.gdp,
+               nm->nations[pi].economy.gdp_growth * 100.0f);
+      toast_push(tbuf, g_theme.info);
+    }
+  }
+  if (turn % 25 == 0)
+    toast_push("Global markets updated", g_theme.warning);
+}
+
 static void update(civ_game_t *game, civ_input_state_t *input) {
   if (!game || !input) return;
 
-  /* Camera — only on map screen */
+  /* The map takes the mouse only where no HUD or popup lies over it */
+  bool over_map = !input->hit_routed || !input->hit_top;
+
+  /* Camera — only on map screen; the frame's motion and wheel events
+     arrive coalesced, so this is one pan and one zoom per frame */
   if (current_screen == SCR_MAP) {
     if (input->mouse_right_down)
       civ_camera_pan(&cam, -(float)input->delta_x, -(float)input->delta_y);
-    if (fabsf(input->scroll_delta) > 0.1f) {
-      float factor = input->scroll_delta > 0 ? 1.15f : 1.0f / 1.15f;
+    if (over_map && fabsf(input->scroll_delta) > 0.1f) {
+      float steps = CLAMP(input->scroll_delta, -4.0f, 4.0f);
+      float factor = powf(1.15f, steps);
       civ_camera_zoom(&cam, factor,
                       cam.x + (input->mouse_x - last_win_w / 2.0f) /
                                   (cam.zoom * 4.0f),
@@ -625,14 +961,18 @@ static void update(civ_game_t *game, civ_input_state_t *input) {
 
   /* Auto-spawn initial units */
   if (game->unit_manager && game->unit_manager->unit_count == 0) {
-    civ_unit_manager_spawn_unit(game->unit_manager, CIV_UNIT_TYPE_SETTLER,
-                                "Settlers", 100, game->world_map->width / 2,
-                                game->world_map->height / 2);
-    civ_unit_manager_spawn_unit(game->unit_manager, CIV_UNIT_TYPE_INFANTRY,
-                                "Barbarians", 80, game->world_map->width / 2 + 1,
-                                game->world_map->height / 2);
-    update_visibility(game);
+    int32_t cx = game->world_map->width / 2, cy = game->world_map->height / 2;
+    civ_command_t settlers = {.type = CIV_CMD_SPAWN_UNIT,
+                              .i = {CIV_UNIT_TYPE_SETTLER, 100, cx, cy},
+                              .text = "Settlers"};
+    civ_command_t barbarians = {.type = CIV_CMD_SPAWN_UNIT,
+                                .i = {CIV_UNIT_TYPE_INFANTRY, 80, cx + 1, cy},
+                                .text = "Barbarians"};
+    civ_game_execute(game, &settlers);
+    civ_game_execute(game, &barbarians);
   }
+  /* Cheap when nothing moved: one compare per unit */
+  update_visibility(game);
 
   /* ── Organic time flow ─────────────────────────────── */
   /* Space toggles pause, 1/2/3 keys set speed */
@@ -640,39 +980,16 @@ static void update(civ_game_t *game, civ_input_state_t *input) {
   else if (input->esc_pressed) time_speed = 0;
 
   float speeds[] = {0.0f, 1.0f, 2.0f, 5.0f};
-  float game_days = input->global_dt > 0.0f
-      ? input->global_dt * days_per_second * speeds[time_speed]
-      : 0.0f;
-
-  /* Only advance if we have a valid delta (app_controller provides it) */
-  if (game_days > 0.0f && game->time_engine && time_speed > 0) {
-    time_accumulator += game_days;
-    /* Advance time engine when enough days have passed (~30 days per old turn) */
-    float days_per_advance = 365.0f / 12.0f; /* monthly advance */
-    while (time_accumulator >= days_per_advance) {
-      time_accumulator -= days_per_advance;
-      civ_time_engine_advance_turn((civ_time_engine_t *)game->time_engine);
-      game->current_turn++;
-      /* Process systems that used to run on end_turn */
-      civ_game_end_turn(game);
-      /* Toast notifications for key events */
-      if (game->current_turn % 10 == 0 && game->nation_manager) {
-        civ_nation_manager_t *nm = (civ_nation_manager_t *)game->nation_manager;
-        if (nm->count > 0) {
-          int pi = nm->player_nation_index;
-          if (pi >= 0 && pi < nm->count) {
-            char tbuf[128];
-            snprintf(tbuf, sizeof(tbuf), "%s: GDP $%.0fM | Growth %+.1f%%",
-                     nm->nations[pi].name,
-                     nm->nations[pi].economy.gdp,
-                     nm->nations[pi].economy.gdp_growth * 100.0f);
-            toast_push(tbuf, g_theme.info);
-          }
-        }
-      }
-      if (game->current_turn % 25 == 0)
-        toast_push("Global markets updated", g_theme.warning);
-    }
+  /* The sim owns turn advancement, threaded or pumped by the frame loop;
+     we just set the pace */
+  civ_sim_thread_set_days_per_second((civ_sim_thread_t *)game->sim_thread,
+                                     days_per_second * speeds[time_speed]);
+
+  /* Toast notifications for key events on each turn crossed */
+  if (last_seen_turn == 0) last_seen_turn = game->current_turn;
+  while (last_seen_turn < game->current_turn) {
+    last_seen_turn++;
+    announce_turn(game, last_seen_turn);
   }
 
   /* Nation hover detection — only on map screen */
@@ -699,7 +1016,7 @@ static void update(civ_game_t *game, civ_input_state_t *input) {
   if (!input->mouse_left_pressed) return;
 
   /* Nation selection on map click */
-  if (current_screen == SCR_MAP && game->world_map) {
+  if (current_screen == SCR_MAP && game->world_map && over_map) {
     float wx, wy;
     civ_camera_screen_to_world(&cam, input->win_w, input->win_h,
                                input->mouse_x, input->mouse_y, &wx, &wy);
@@ -711,6 +1028,12 @@ static void update(civ_game_t *game, civ_input_state_t *input) {
         selected_nation_cid = cid;
         snprintf(selected_nation_id, sizeof(selected_nation_id), "%s", nm);
         show_nation_detail = true;
+        if (game->nation_manager) {
+          /* For the panel only; the simulation's detail ignores it */
+          civ_nation_manager_t *mgr = (civ_nation_manager_t *)game->nation_manager;
+          civ_nation_t *nat = civ_nation_get_by_id(mgr, nm);
+          mgr->focus_nation_index = nat ? (int)(nat - mgr->nations) : -1;
+        }
         printf("[SELECT] Nation: %s (cid=%d)\n", nm, cid);
         return;
       } else {
@@ -756,56 +1079,47 @@ static void update(civ_game_t *game, civ_input_state_t *input) {
                              input->mouse_y, &wx, &wy);
   int32_t tx = (int32_t)floorf(wx), ty = (int32_t)floorf(wy);
 
-  civ_unit_t *old_unit = selected_unit;
+  civ_unit_handle_t old_unit = selected_unit;
   civ_settlement_t *old_settlement = selected_settlement;
-  selected_unit = NULL;
+  selected_unit = CIV_UNIT_HANDLE_NONE;
   selected_settlement = NULL;
 
   /* Check settlement hit */
   if (game->settlement_manager) {
-    for (size_t i = 0; i < game->settlement_manager->settlement_count; i++) {
-      if ((int32_t)game->settlement_manager->settlements[i].x == tx &&
-          (int32_t)game->settlement_manager->settlements[i].y == ty) {
-        selected_settlement = &game->settlement_manager->settlements[i];
-        break;
-      }
-    }
+    selected_settlement =
+        civ_settlement_manager_at(game->settlement_manager, tx, ty);
   }
 
   /* Check unit hit */
   if (!selected_settlement && game->unit_manager) {
-    for (size_t i = 0; i < game->unit_manager->unit_count; i++) {
-      if (game->unit_manager->units[i].x == tx &&
-          game->unit_manager->units[i].y == ty) {
-        selected_unit = &game->unit_manager->units[i];
-        break;
-      }
-    }
+    int32_t hit = civ_unit_manager_unit_at(game->unit_manager, tx, ty, -1);
+    if (hit >= 0)
+      selected_unit = civ_unit_manager_handle(game->unit_manager, (size_t)hit);
   }
 
   /* Settlement sidebar clicks */
   if (selected_settlement && !selected_settlement->is_producing) {
     int rc = civ_settlement_sidebar_click(selected_settlement, input);
-    if (rc == 1)
-      selected_settlement->is_producing = true,
-      selected_settlement->production_type = 0,
-      selected_settlement->production_target = 30.0f,
-      selected_settlement->production_progress = 0.0f;
-    else if (rc == 2)
-      selected_settlement->is_producing = true,
-      selected_settlement->production_type = 7,
-      selected_settlement->production_target = 80.0f,
-      selected_settlement->production_progress = 0.0f;
+    if (rc == 1 || rc == 2) {
+      civ_command_t cmd = {.type = CIV_CMD_SET_PRODUCTION};
+      cmd.i[0] = rc == 1 ? CIV_UNIT_TYPE_INFANTRY : CIV_UNIT_TYPE_SETTLER;
+      cmd.f = rc == 1 ? 30.0 : 80.0;
+      snprintf(cmd.text, sizeof(cmd.text), "%s", selected_settlement->id);
+      civ_game_execute(game, &cmd);
+    }
   }
 
   /* Unit sidebar: Found City */
-  if (selected_unit && selected_unit->unit_type == CIV_UNIT_TYPE_SETTLER &&
-      !selected_unit->has_moved && civ_unit_sidebar_click(selected_unit, input)) {
-    civ_attempt_settlement_spawn(game->settlement_manager,
-                                 (float)selected_unit->x,
-                                 (float)selected_unit->y);
-    selected_unit->current_strength = 0;
-    selected_unit = NULL;
+  civ_unit_manager_t *um = game->unit_manager;
+  int32_t sel = civ_unit_manager_resolve(um, selected_unit);
+  if (sel >= 0 && civ_unit_sidebar_click(um, (size_t)sel, input)) {
+    civ_command_t found = {.type = CIV_CMD_FOUND_SETTLEMENT,
+                           .i = {um->x[sel], um->y[sel]}};
+    civ_command_t kill = {.type = CIV_CMD_KILL_UNIT};
+    snprintf(kill.text, sizeof(kill.text), "%s", um->units[sel].id);
+    civ_game_execute(game, &found);
+    civ_game_execute(game, &kill);
+    selected_unit = CIV_UNIT_HANDLE_NONE;
     update_visibility(game);
     return;
   }
@@ -813,37 +1127,42 @@ static void update(civ_game_t *game, civ_input_state_t *input) {
   /* Deselect when clicking empty space */
   bool on_ui = (input->mouse_x < 220 && input->mouse_y > last_win_h - 170) ||
                (input->mouse_x < 300);
-  if (!selected_unit && !selected_settlement && !on_ui) {
+  if (selected_unit == CIV_UNIT_HANDLE_NONE && !selected_settlement && !on_ui) {
     selected_unit = old_unit;
     selected_settlement = old_settlement;
   }
 
   /* Unit movement (right click) */
-  if (input->mouse_right_pressed && selected_unit && !selected_unit->has_moved) {
-    int dx = abs(tx - selected_unit->x), dy = abs(ty - selected_unit->y);
-    if (dx <= 1 && dy <= 1 && (dx + dy > 0))
-      selected_unit->x = tx, selected_unit->y = ty,
-      selected_unit->has_moved = true, update_visibility(game);
+  sel = civ_unit_manager_resolve(um, selected_unit);
+  if (input->mouse_right_pressed && sel >= 0 && !um->moved[sel]) {
+    int dx = abs(tx - um->x[sel]), dy = abs(ty - um->y[sel]);
+    if (dx <= 1 && dy <= 1 && (dx + dy > 0)) {
+      civ_command_t cmd = {.type = CIV_CMD_MOVE_UNIT, .i = {tx, ty}};
+      snprintf(cmd.text, sizeof(cmd.text), "%s", um->units[sel].id);
+      civ_game_execute(game, &cmd);
+      update_visibility(game);
+    }
   }
 
   /* First contact check */
   if (game->unit_manager && game->settlement_manager && !has_contacted_rival) {
     for (size_t i = 0; i < game->unit_manager->unit_count; i++) {
-      civ_unit_t *u = &game->unit_manager->units[i];
-      if (strstr(u->name, "Rival")) continue;
+      if (strstr(game->unit_manager->units[i].name, "Rival")) continue;
+      int32_t ux = game->unit_manager->x[i], uy = game->unit_manager->y[i];
       for (size_t j = 0; j < game->settlement_manager->settlement_count; j++) {
         civ_settlement_t *s = &game->settlement_manager->settlements[j];
         if (strcmp(s->id, "rival_capital") == 0) {
-          float d2 = (float)((u->x - s->x) * (u->x - s->x) +
-                             (u->y - s->y) * (u->y - s->y));
+          float d2 = (float)((ux - s->x) * (ux - s->x) +
+                             (uy - s->y) * (uy - s->y));
           if (d2 < 64.0f) has_contacted_rival = true;
         }
       }
     }
   }
 
-  /* Update toast timers */
+  /* Update toast timers; fading toasts keep frames coming */
   toast_update(game ? 1.0f / 60.0f : 0.016f);
+  if (toast_count > 0) civ_frame_request_redraw();
 }
 
 static void render(SDL_Renderer *renderer, int win_w, int win_h,
@@ -857,18 +1176,27 @@ static void render(SDL_Renderer *renderer, int win_w, int win_h,
   if (game->wallet.count > 0) { local_cur = game->wallet.slots[0].currency_iso;
     civ_market_currency_t *mc = civ_market_get_currency(game->market, local_cur);
     if (mc) local_sym = mc->symbol; }
+  (void)local_sym;
 
-  /* Lazy-init flag textures — needs SDL_Renderer */
-  if (!flags_loaded && game->flag_system) {
+  /* Lazy-init flag metadata; textures decode on the worker pool and
+   * appear page by page — needs SDL_Renderer */
+  if (!flags_loaded && civ_game_flags(game)) {
     game->flag_system->renderer = renderer;
-    int n = civ_flag_system_load_textures(game->flag_system);
-    if (n > 0) printf("[GAME] Loaded %d flag textures\n", n);
+    civ_flag_system_begin_load(game->flag_system,
+        civ_system_orchestrator_get_worker_pool(game->system_orchestrator));
     flags_loaded = true;
   }
+  if (game->flag_system) {
+    /* Also uploads procedural flags, so it runs after the load too */
+    bool loading = game->flag_system->loading;
+    int n = civ_flag_system_poll(game->flag_system);
+    if (loading && n > 0) printf("[GAME] Loaded %d flag textures\n", n);
+  }
 
   /* Lazy-init map rendering context — only when on map screen */
   if (current_screen == SCR_MAP) {
     if (!map_ctx && game->world_map) {
+      int step = civ_startup_step_begin("Map renderer");
       map_ctx = civ_render_map_context_create(renderer, win_w, win_h,
                                               game->world_map->width,
                                               game->world_map->height);
@@ -877,11 +1205,27 @@ static void render(SDL_Renderer *renderer, int win_w, int win_h,
         map_ctx->zoom = cam.zoom;
         /* Build LOD buffers for smooth global zoom */
         civ_render_map_build_lods(map_ctx, game->world_map, renderer);
+        map_renderer = renderer;
+        if (prebake_game)
+          civ_frame_pacer_remove_idle_task(prebake_map, prebake_game);
+        prebake_game = game;
+        civ_frame_pacer_add_idle_task(prebake_map, game);
       }
+      civ_startup_step_end(step);
     }
     if (map_ctx) {
       map_ctx->view_x = cam.x; map_ctx->view_y = cam.y;
       map_ctx->zoom = cam.zoom;
+      map_ctx->worker_pool =
+          civ_system_orchestrator_get_worker_pool(game->system_orchestrator);
+      /* Detail the governor currently affords */
+      map_ctx->lod_bias = civ_quality_governor_value(CIV_QUALITY_MAP_LOD_BIAS);
+      map_ctx->cluster_min_px =
+          civ_quality_governor_value(CIV_QUALITY_CLUSTER_PX);
+      map_ctx->border_refresh_ns = (uint64_t)(
+          civ_quality_governor_value(CIV_QUALITY_BORDER_REFRESH_MS) * 1e6);
+      map_ctx->minimap_refresh_ns = (uint64_t)(
+          civ_quality_governor_value(CIV_QUALITY_MINIMAP_REFRESH_MS) * 1e6);
     }
     float minZ = (float)last_win_h / ((float)game->world_map->height * 4.0f);
     if (cam.zoom < minZ) { cam.zoom = minZ; if (map_ctx) map_ctx->zoom = minZ; }
@@ -889,15 +1233,17 @@ static void render(SDL_Renderer *renderer, int win_w, int win_h,
 
   /* ── Main content: MAP screen only renders the map ─────── */
   if (current_screen == SCR_MAP) {
+    civ_render_begin_batch(renderer);
     render_map_layer(renderer, game);
     render_settlements_layer(renderer, game);
     render_units_layer(renderer, game);
-    /* Border lines visible at zoom > 1.0x */
-    if (cam.zoom > 1.0f && map_ctx)
+    if (map_ctx)
       civ_render_map_borders(renderer, map_ctx, game->world_map,
                              win_w, win_h);
     render_minimap_layer(renderer, game);
+    render_nation_labels(renderer, game);
     render_city_labels(renderer, game);
+    civ_render_end_batch();
 
   } /* end MAP screen block */
 
@@ -909,9 +1255,14 @@ static void render(SDL_Renderer *renderer, int win_w, int win_h,
           ? civ_wallet_total(&game->wallet, game->market) : 0.0f;
       float lat = 90.0f - (cam.y / (float)cam.map_height) * 180.0f;
       float lon = (cam.x / (float)cam.map_width) * 360.0f - 180.0f;
-      while (lon < -180.0f) lon += 360.0f; while (lon > 180.0f) lon -= 360.0f;
+      while (lon < -180.0f) lon += 360.0f;
+      while (lon > 180.0f) lon -= 360.0f;
       float ww = (float)win_w, wh = (float)win_h;
 
+      /* The host window is transparent over the map; only its bars and
+         the popups take the mouse from it */
+      civ_hit_grid_add(&g_ui_hits, &hud_layer, 0, 0, win_w, 34);
+      civ_hit_grid_add(&g_ui_hits, &hud_layer, 0, 34, 224, win_h - 34);
       if (nk_begin(nk, "Dominion", nk_rect(0, 0, ww, wh),
                    NK_WINDOW_NO_SCROLLBAR)) {
 
@@ -923,6 +1274,14 @@ static void render(SDL_Renderer *renderer, int win_w, int win_h,
           if (game->time_engine)
             civ_time_engine_format_hud((civ_time_engine_t*)game->time_engine, time_buf, sizeof(time_buf));
           else snprintf(time_buf, sizeof(time_buf), "Turn %d", game->current_turn);
+          /* Autosave writing in the background; keep frames coming for it */
+          float saving = civ_save_worker_progress(game->save_worker);
+          if (saving >= 0.0f) {
+            size_t n = strlen(time_buf);
+            snprintf(time_buf + n, sizeof(time_buf) - n, "  Saving %d%%",
+                     (int)(saving * 100.0f));
+            civ_frame_request_redraw();
+          }
           nk_label(nk, time_buf, NK_TEXT_LEFT);
         }
         nk_layout_row_push(nk, 150);
@@ -1021,20 +1380,18 @@ static void render(SDL_Renderer *renderer, int win_w, int win_h,
 
       /* ── Popups (separate windows over the main container) ────── */
       if (show_nation_detail && selected_nation_id[0] && game->nation_manager) {
-        civ_nation_t *nat = civ_nation_get_by_id(
-            (civ_nation_manager_t*)game->nation_manager, selected_nation_id);
-        if (nat && nk_begin(nk, nat->name, nk_rect(240, 40, 360, 300),
+        /* Formatted after the last tick; the popup only lays it out */
+        civ_screen_metrics_watch_nation(selected_nation_id);
+        const civ_nation_view_t *nv = civ_screen_nation_view(game);
+        if (nv->found && nk_begin(nk, nv->name, nk_rect(240, 40, 360, 300),
                  NK_WINDOW_TITLE|NK_WINDOW_MOVABLE|NK_WINDOW_CLOSABLE)) {
+          struct nk_rect pb = nk_window_get_bounds(nk);
+          civ_hit_grid_add(&g_ui_hits, &popup_layer, (int)pb.x, (int)pb.y,
+                           (int)pb.w, (int)pb.h);
           nk_layout_row_dynamic(nk, 18, 1);
-          { char buf[128]; snprintf(buf, sizeof(buf), "Pop: %lldM  GDP: $%.0fM  +%.1f%%",
-              nat->population/1000000, nat->economy.gdp, nat->economy.gdp_growth*100);
-            nk_label(nk, buf, NK_TEXT_LEFT); }
-          { char buf[128]; snprintf(buf, sizeof(buf), "Unemp: %.1f%%  Infl: %.1f%%  Food: %.0fM",
-              nat->economy.unemployment*100, nat->economy.inflation*100, nat->economy.food_production/1000000);
-            nk_label(nk, buf, NK_TEXT_LEFT); }
-          { char buf[128]; snprintf(buf, sizeof(buf), "Indices: T%+d E%+d M%+d C%+d",
-              nat->tech_index, nat->economic_index, nat->military_index, nat->cultural_index);
-            nk_label(nk, buf, NK_TEXT_LEFT); }
+          nk_label(nk, nv->lines[1], NK_TEXT_LEFT);
+          nk_label(nk, nv->lines[2], NK_TEXT_LEFT);
+          nk_label(nk, nv->indices, NK_TEXT_LEFT);
           nk_layout_row_dynamic(nk, 28, 3);
           if (nk_button_label(nk, "Gov")) { current_screen = SCR_GOVERNANCE; show_nation_detail = false; }
           if (nk_button_label(nk, "Dip")) { current_screen = SCR_DIPLOMACY; show_nation_detail = false; }
@@ -1047,6 +1404,8 @@ static void render(SDL_Renderer *renderer, int win_w, int win_h,
       for (int i = toast_count - 1; i >= 0; i--) {
         if (nk_begin(nk, "T", nk_rect(ww/2-200, wh-80-(float)i*34, 400, 26),
                      NK_WINDOW_NO_SCROLLBAR)) {
+          civ_hit_grid_add(&g_ui_hits, &popup_layer, win_w / 2 - 200,
+                           win_h - 80 - i * 34, 400, 26);
           nk_layout_row_dynamic(nk, 20, 1);
           nk_label(nk, toasts[i].msg, NK_TEXT_CENTERED);
         }
@@ -1070,8 +1429,24 @@ static void render(SDL_Renderer *renderer, int win_w, int win_h,
 }
 
 static void destroy(void) {
+  if (prebake_game) civ_frame_pacer_remove_idle_task(prebake_map, prebake_game);
+  prebake_game = NULL;
+  map_renderer = NULL;
   if (map_ctx) civ_render_map_context_destroy(map_ctx), map_ctx = NULL;
+  civ_visibility_destroy(fog);
+  fog = NULL;
+  CIV_FREE(visible_units);
+  visible_units_cap = 0;
+  CIV_FREE(unit_markers);
+  unit_markers_cap = 0;
+  CIV_FREE(visible_settlements);
+  visible_settlements_cap = 0;
   if (font_hud) civ_font_destroy(font_hud), font_hud = NULL;
+  if (font_label) civ_font_destroy(font_label), font_label = NULL;
+  CIV_FREE(nation_layouts);
+  nation_layouts = NULL;
+  nation_layouts_cap = 0;
+  last_seen_turn = 0;
 }
 
 civ_scene_t scene_game = {.init = init,
@@ -8,6 +8,7 @@
 #include "core/world/nations_data.h"
 #include "ui/nuklear_ui.h"
 #include "ui/scene.h"
+#include "ui/screens/screen_metrics.h"
 #include <SDL3/SDL.h>
 #include <stdio.h>
 #include <string.h>
@@ -72,6 +73,7 @@ static void update(civ_game_t *game, civ_input_state_t *input) {
         if (!found) civ_wallet_add(&game->wallet, "USD", 500.0f);
       }
     }
+    civ_screen_metrics_invalidate();
     civ_scene_manager_switch(SCENE_GAME);
   }
 }
@@ -10,17 +10,42 @@
 #include "ui/nuklear_ui.h"
 #include "ui/scene.h"
 #include "ui/window_mgr.h"
+#include "utils/frame_trace.h"
 #include <SDL3/SDL.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 extern civ_window_mgr_t *g_window_mgr;
 
 static int   save_picker_id = -1;
-static char  save_slots[16][64];
+static int   pending_button = -1; /* world button pressed while loading */
+static civ_save_slot_info_t *save_infos = NULL; /* from the profile's save index */
+static SDL_Texture **save_thumbs = NULL;        /* created on first draw */
 static int   save_slot_count = 0;
 static char  *save_selected = NULL;
 
+static void format_population(char *out, size_t size, int64_t pop) {
+  if (pop >= 1000000)
+    snprintf(out, size, "%.1fM", (double)pop / 1e6);
+  else if (pop >= 1000)
+    snprintf(out, size, "%.1fK", (double)pop / 1e3);
+  else
+    snprintf(out, size, "%lld", (long long)pop);
+}
+
+static SDL_Texture *save_thumb(SDL_Renderer *r, int i) {
+  if (!save_thumbs[i] && save_infos[i].indexed && r) {
+    save_thumbs[i] = civ_create_texture(r, SDL_PIXELFORMAT_ARGB8888,
+                                       SDL_TEXTUREACCESS_STATIC,
+                                       CIV_SAVE_THUMB_W, CIV_SAVE_THUMB_H);
+    if (save_thumbs[i])
+      SDL_UpdateTexture(save_thumbs[i], NULL, save_infos[i].thumbnail,
+                        CIV_SAVE_THUMB_W * (int)sizeof(uint32_t));
+  }
+  return save_thumbs[i];
+}
+
 /* ── Save picker callbacks ───────────────────────────────────── */
 static void save_picker_render(SDL_Renderer *r, int wx, int wy,
                                 int ww, int wh, void *ud, civ_input_state_t *in) {
@@ -33,9 +58,27 @@ static void save_picker_render(SDL_Renderer *r, int wx, int wy,
     if (save_slot_count == 0)
       nk_label(nk, "No save files found.", NK_TEXT_LEFT);
     for (int i = 0; i < save_slot_count; i++) {
-      nk_layout_row_dynamic(nk, 28, 1);
-      if (nk_button_label(nk, save_slots[i]))
-        save_selected = save_slots[i];
+      const civ_save_slot_info_t *info = &save_infos[i];
+      char label[192]; /* slot, turn, profile and population, whole */
+      if (info->indexed) {
+        char pop[24]; /* room for any int64_t */
+        format_population(pop, sizeof(pop), info->total_population);
+        snprintf(label, sizeof(label), "%s - Turn %u, %s, pop %s", info->slot,
+                 info->turn, info->profile_name, pop);
+      } else {
+        snprintf(label, sizeof(label), "%s", info->slot);
+      }
+      nk_layout_row_begin(nk, NK_STATIC, CIV_SAVE_THUMB_H + 4, 2);
+      nk_layout_row_push(nk, CIV_SAVE_THUMB_W + 4);
+      SDL_Texture *thumb = save_thumb(r, i);
+      if (thumb)
+        nk_image(nk, nk_image_ptr(thumb));
+      else
+        nk_spacing(nk, 1);
+      nk_layout_row_push(nk, (float)ww - CIV_SAVE_THUMB_W - 40);
+      if (nk_button_label(nk, label))
+        save_selected = save_infos[i].slot;
+      nk_layout_row_end(nk);
     }
   }
   nk_end(nk);
@@ -47,45 +90,85 @@ static bool save_picker_input(int wx, int wy, int ww, int wh,
   return in->mouse_left_pressed;
 }
 
-static void open_save_picker(const char *profile_id) {
-  if (!g_window_mgr || !profile_id) return;
-  char **slots = NULL;
-  save_slot_count = civ_profile_list_saves(profile_id, &slots);
-  save_slot_count = save_slot_count > 16 ? 16 : save_slot_count;
+static void close_save_picker(void) {
+  if (save_picker_id >= 0 && g_window_mgr)
+    civ_window_mgr_remove(g_window_mgr, save_picker_id);
+  save_picker_id = -1;
   for (int i = 0; i < save_slot_count; i++)
-    strncpy(save_slots[i], slots[i], 63);
-  civ_profile_free_list(slots, save_slot_count > 16 ? 16 : save_slot_count);
+    if (save_thumbs[i]) SDL_DestroyTexture(save_thumbs[i]);
+  free(save_thumbs);
+  free(save_infos);
+  save_thumbs = NULL;
+  save_infos = NULL;
+  save_slot_count = 0;
   save_selected = NULL;
+}
+
+static void open_save_picker(const char *profile_id) {
+  if (!g_window_mgr || !profile_id) return;
+  close_save_picker();
+  /* Metadata and thumbnails come from the index; no save is opened */
+  save_slot_count = civ_profile_list_save_info(profile_id, &save_infos);
+  save_thumbs = save_slot_count
+                    ? calloc((size_t)save_slot_count, sizeof(SDL_Texture *))
+                    : NULL;
+  if (save_slot_count && !save_thumbs) {
+    free(save_infos);
+    save_infos = NULL;
+    save_slot_count = 0;
+  }
+  int rows = save_slot_count < 12 ? save_slot_count : 12;
   save_picker_id = civ_window_mgr_add(g_window_mgr, CIV_WIN_POPUP,
-      "Load Game", 200, 100, 400, save_slot_count * 32 + 100,
+      "Load Game", 200, 100, 520, rows * (CIV_SAVE_THUMB_H + 8) + 100,
       save_picker_render, save_picker_input, NULL);
 }
 
 /* ── Scene lifecycle ─────────────────────────────────────────── */
 static void init(void) {
   save_picker_id = -1;
+  pending_button = -1;
+}
+
+/* Continue and New Game need the loaded world; pressed early, they wait */
+static void press(civ_game_t *game, int button) {
+  if ((button == 0 || button == 1) && !civ_game_is_loaded(game)) {
+    pending_button = button;
+    return;
+  }
+  switch (button) {
+  case 0: civ_scene_manager_switch(SCENE_GAME); break;
+  case 1: civ_scene_manager_switch(SCENE_IDENTITY); break;
+  case 2: if (game->current_profile) open_save_picker(game->current_profile->id); break;
+  case 3: civ_scene_manager_switch(SCENE_PROFILE_SELECT); break;
+  case 4: civ_confirm_show("Exit Dominion", "Are you sure you want to exit?"); break;
+  }
 }
 
 static void update(civ_game_t *game, civ_input_state_t *input) {
-  /* Handle save picker selection */
-  if (save_picker_id >= 0 && save_selected && game->current_profile) {
+  if (pending_button >= 0 && civ_game_is_loaded(game)) {
+    int button = pending_button;
+    pending_button = -1;
+    press(game, button);
+    return;
+  }
+
+  /* Handle save picker selection; a save replaces the world, so it waits
+     for the load to finish */
+  if (save_picker_id >= 0 && save_selected && game->current_profile &&
+      civ_game_is_loaded(game)) {
     char path[256];
     if (civ_profile_get_save_path(game->current_profile->id,
                                    save_selected, path, sizeof(path))) {
       if (civ_game_load(game, path).error == CIV_OK) {
-        civ_window_mgr_remove(g_window_mgr, save_picker_id);
-        save_picker_id = -1;
+        close_save_picker();
         civ_scene_manager_switch(SCENE_GAME);
         return;
       }
     }
-    civ_window_mgr_remove(g_window_mgr, save_picker_id);
-    save_picker_id = -1;
-  }
-  if (save_picker_id >= 0 && input->esc_pressed) {
-    civ_window_mgr_remove(g_window_mgr, save_picker_id);
-    save_picker_id = -1;
+    close_save_picker();
   }
+  if (save_picker_id >= 0 && input->esc_pressed)
+    close_save_picker();
 
   /* Check confirmation dialog */
   int cr = civ_confirm_result();
@@ -114,18 +197,25 @@ static void render(SDL_Renderer *r, int win_w, int win_h,
                             "SWITCH PROFILE", "EXIT TO DESKTOP"};
     for (int i = 0; i < 5; i++) {
       nk_layout_space_push(nk, nk_rect(40, by, 260, 38));
-      if (nk_button_label(nk, labels[i])) {
-        switch (i) {
-        case 0: civ_scene_manager_switch(SCENE_GAME); break;
-        case 1: civ_scene_manager_switch(SCENE_IDENTITY); break;
-        case 2: if (game->current_profile) open_save_picker(game->current_profile->id); break;
-        case 3: civ_scene_manager_switch(SCENE_PROFILE_SELECT); break;
-        case 4: civ_confirm_show("Exit Dominion", "Are you sure you want to exit?"); break;
-        }
-      }
+      if (nk_button_label(nk, labels[i]))
+        press(game, i);
       by += 48;
     }
 
+    /* Load progress until the world is ready */
+    if (!civ_game_is_loaded(game)) {
+      const char *stage = NULL;
+      float progress = civ_game_load_progress(game, &stage);
+      char buf[96];
+      snprintf(buf, sizeof(buf), "%s%s... %d%%",
+               pending_button >= 0 ? "Starting when ready - " : "", stage,
+               (int)(progress * 100.0f));
+      nk_layout_space_push(nk, nk_rect(40, by + 10, 360, 20));
+      nk_label(nk, buf, NK_TEXT_LEFT);
+      nk_layout_space_push(nk, nk_rect(40, by + 34, 260, 10));
+      nk_prog(nk, (nk_size)(progress * 1000.0f), 1000, nk_false);
+    }
+
     /* Profile badge at bottom */
     if (game->current_profile) {
       char buf[64];
@@ -140,10 +230,7 @@ static void render(SDL_Renderer *r, int win_w, int win_h,
 }
 
 static void destroy(void) {
-  if (save_picker_id >= 0 && g_window_mgr) {
-    civ_window_mgr_remove(g_window_mgr, save_picker_id);
-    save_picker_id = -1;
-  }
+  close_save_picker();
 }
 
 civ_scene_t scene_main_menu = {
@@ -1,10 +1,13 @@
 #include "display/theme.h"
 #include "ui/nuklear_ui.h"
 #include "ui/scene.h"
+#include "utils/startup_timeline.h"
 #include <SDL3/SDL.h>
 #include <math.h>
 #include <stdio.h>
 
+#define SPLASH_STEPS 8  /* most recent finished load steps listed */
+
 static float splash_timer = 0.0f;
 
 static void init(void) { splash_timer = 0.0f; }
@@ -23,12 +26,44 @@ static void render(SDL_Renderer *r, int win_w, int win_h,
 
   float alpha = splash_timer / 1.5f; if (alpha > 1.0f) alpha = 1.0f;
 
-  if (nk_begin(nk, "Splash", nk_rect(100, 100, 400, 300),
+  if (nk_begin(nk, "Splash", nk_rect(100, 100, 400, 300 + SPLASH_STEPS * 18),
                NK_WINDOW_TITLE)) {
     nk_layout_row_dynamic(nk, 40, 1);
     nk_label(nk, "DOMINION", NK_TEXT_CENTERED);
     nk_layout_row_dynamic(nk, 20, 1);
     nk_label(nk, "Click or press any key to begin", NK_TEXT_CENTERED);
+
+    /* The world keeps loading behind the menus */
+    const char *stage = NULL;
+    float progress = civ_game_load_progress(game, &stage);
+    char buf[96];
+    if (civ_game_is_loaded(game))
+      snprintf(buf, sizeof(buf), "World ready");
+    else
+      snprintf(buf, sizeof(buf), "%s... %d%%", stage, (int)(progress * 100.0f));
+    nk_layout_row_dynamic(nk, 20, 1);
+    nk_label(nk, buf, NK_TEXT_CENTERED);
+    nk_layout_row_dynamic(nk, 12, 1);
+    nk_prog(nk, (nk_size)(progress * 1000.0f), 1000, nk_false);
+
+    /* Startup timeline: what each step cost */
+    int shown = 0, first = civ_startup_timeline_count();
+    civ_startup_step_t step;
+    while (first > 0 && shown < SPLASH_STEPS &&
+           civ_startup_timeline_get(first - 1, &step)) {
+      first--;
+      if (step.done && step.depth == 0) shown++;
+    }
+    for (int i = first; civ_startup_timeline_get(i, &step); i++) {
+      if (!step.done || step.depth != 0) continue;
+      char ms[24], mb[24];
+      snprintf(ms, sizeof(ms), "%.0f ms", step.wall_ms);
+      snprintf(mb, sizeof(mb), "%.1f MB", (double)step.bytes_read / 1048576.0);
+      nk_layout_row_dynamic(nk, 14, 3);
+      nk_label(nk, step.name, NK_TEXT_LEFT);
+      nk_label(nk, ms, NK_TEXT_RIGHT);
+      nk_label(nk, mb, NK_TEXT_RIGHT);
+    }
   }
   nk_end(nk);
 }
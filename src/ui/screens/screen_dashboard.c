@@ -2,6 +2,7 @@
 #include "ui/screens/screens.h"
 #include "core/character.h"
 #include "engine/renderer.h"
+#include "ui/screens/screen_metrics.h"
 #include "ui/ui_common.h"
 #include "ui/graph/graph.h"
 #include <stdio.h>
@@ -37,7 +38,7 @@ void civ_screen_dashboard_render(SDL_Renderer *r, civ_game_t *g, civ_font_t *f,
   for(int s=0;s<5;s++){snprintf(buf,sizeof(buf),"%-14s",civ_skill_name((civ_skill_t)s)); civ_font_render_aligned(r,f,buf,lx,dy,110,14,g_theme.hud_text,CIV_ALIGN_LEFT,CIV_VALIGN_TOP); civ_render_rect_filled(r,lx+112,dy+2,100,8,g_theme.hud_border); float sp=pc->skills[s]/100.0f;if(sp>1)sp=1; civ_render_rect_filled(r,lx+112,dy+2,(int)(100*sp),8,g_graph_palette_default[s%12]); snprintf(buf,sizeof(buf),"%d",pc->skills[s]); civ_font_render_aligned(r,f,buf,lx+216,dy,30,14,g_theme.text_secondary,CIV_ALIGN_RIGHT,CIV_VALIGN_TOP);
     int s2=s+5; snprintf(buf,sizeof(buf),"%-14s",civ_skill_name((civ_skill_t)s2)); civ_font_render_aligned(r,f,buf,lx+w/2,dy,110,14,g_theme.hud_text,CIV_ALIGN_LEFT,CIV_VALIGN_TOP); civ_render_rect_filled(r,lx+w/2+112,dy+2,100,8,g_theme.hud_border); float sp2=pc->skills[s2]/100.0f;if(sp2>1)sp2=1; civ_render_rect_filled(r,lx+w/2+112,dy+2,(int)(100*sp2),8,g_graph_palette_default[s2%12]); snprintf(buf,sizeof(buf),"%d",pc->skills[s2]); civ_font_render_aligned(r,f,buf,lx+w/2+216,dy,30,14,g_theme.text_secondary,CIV_ALIGN_RIGHT,CIV_VALIGN_TOP); dy+=16;}
   /* Wallet */
-  if(g->wallet.count>0){dy+=4;civ_render_line(r,lx,dy,lx+w-8,dy,g_theme.hud_border);dy+=4; snprintf(buf,sizeof(buf),"Wallet: %.0f USD (%d currencies)",civ_wallet_total(&g->wallet,(civ_market_engine_t*)g->market),g->wallet.count); civ_font_render_aligned(r,f,buf,lx,dy,w-8,16,g_theme.warning,CIV_ALIGN_LEFT,CIV_VALIGN_TOP);dy+=18;
+  if(g->wallet.count>0){dy+=4;civ_render_line(r,lx,dy,lx+w-8,dy,g_theme.hud_border);dy+=4; civ_font_render_aligned(r,f,civ_screen_metric_label(g,CIV_METRIC_WALLET_SUMMARY),lx,dy,w-8,16,g_theme.warning,CIV_ALIGN_LEFT,CIV_VALIGN_TOP);dy+=18;
     for(int wi=0;wi<g->wallet.count&&wi<3;wi++){civ_market_currency_t*mc=civ_market_get_currency((civ_market_engine_t*)g->market,g->wallet.slots[wi].currency_iso); snprintf(buf,sizeof(buf),"  %s%.2f %s",mc?mc->symbol:"",g->wallet.slots[wi].balance,g->wallet.slots[wi].currency_iso); civ_font_render_aligned(r,f,buf,lx,dy,w-8,14,g_theme.text_dim,CIV_ALIGN_LEFT,CIV_VALIGN_TOP);dy+=16;}}
   (void)cur;(void)sym;(void)in;(void)h;(void)sh;
 }
@@ -6,15 +6,86 @@
  * graph-based data visualization, and consistent spacing.
  */
 #include "ui/screens/screens.h"
+#include "core/economy/economy_forecast.h"
 #include "core/economy/financial_markets.h"
 #include "core/world/nation.h"
 #include "core/constitution.h"
 #include "display/theme.h"
 #include "engine/renderer.h"
 #include "ui/graph/graph.h"
+#include "ui/screens/screen_metrics.h"
 #include "ui/ui_common.h"
 #include <stdio.h>
 
+#define GDP_HISTORY_TURNS 120
+
+typedef struct {
+  size_t count;
+  float gdp[GDP_HISTORY_TURNS];
+} gdp_history_t;
+
+#define PRICE_TREND_POINTS 120
+
+typedef struct {
+  int count;
+  float mean[PRICE_TREND_POINTS];
+} price_trend_t;
+
+/* Mean price per sparkline pixel over the whole recorded game */
+static price_trend_t read_price_trend(const civ_price_history_t *ph,
+                                      int pixels) {
+  price_trend_t t = {0};
+  if (civ_price_history_has_data(ph))
+    t.count = (int)civ_price_history_read(ph, ph->first_turn, ph->last_turn,
+                                          (size_t)MIN(pixels, PRICE_TREND_POINTS),
+                                          NULL, NULL, NULL, t.mean);
+  return t;
+}
+
+static void draw_price_trend(SDL_Renderer *r, const float *trend, int n,
+                             int x, int y, int w, int h) {
+  if (n < 2) return;
+  SDL_Texture *sp = civ_graph_sparkline(r, x, y, w, h, (float *)trend, n,
+      trend[n - 1] >= trend[0] ? g_theme.success : g_theme.danger);
+  if (sp) {
+    SDL_FRect dr = { (float)x, (float)y, (float)w, (float)h };
+    SDL_RenderTexture(r, sp, NULL, &dr);
+    SDL_DestroyTexture(sp);
+  }
+}
+
+#define OUTLOOK_TURNS 12
+
+typedef struct {
+  bool valid;
+  float gdp_change, debt, deficit;
+} outlook_t;
+
+/* The nation's economy OUTLOOK_TURNS updates ahead under current policy */
+static outlook_t read_outlook(const civ_nation_manager_t *nm, int nation) {
+  outlook_t o = {0};
+  civ_economy_snapshot_t now;
+  civ_economy_projection_t p;
+  if (!civ_economy_batch_snapshot(nm->economy_batch, (size_t)nation, &now) ||
+      now.gdp <= 0.0f || !civ_economy_simulate(&now, NULL, OUTLOOK_TURNS, &p))
+    return o;
+  o.valid = true;
+  o.gdp_change = p.final.gdp / now.gdp - 1.0f;
+  o.debt = p.final.national_debt;
+  o.deficit = p.final.deficit;
+  return o;
+}
+
+static gdp_history_t read_gdp_history(const civ_game_t *g, int nation) {
+  gdp_history_t hist;
+  size_t n = civ_time_series_read(g->metrics_history, nation, CIV_SERIES_GDP,
+                                  g->current_turn - (GDP_HISTORY_TURNS - 1),
+                                  g->current_turn, NULL, hist.gdp,
+                                  GDP_HISTORY_TURNS);
+  hist.count = MIN(n, (size_t)GDP_HISTORY_TURNS);
+  return hist;
+}
+
 void civ_screen_economy_render(SDL_Renderer *r, civ_game_t *g, civ_font_t *f,
                                int x, int y, int w, int h, int sh,
                                civ_input_state_t *in, const char *cur,
@@ -33,15 +104,46 @@ void civ_screen_economy_render(SDL_Renderer *r, civ_game_t *g, civ_font_t *f,
     civ_nation_manager_t *nm = (civ_nation_manager_t *)g->nation_manager;
     int pi = nm->player_nation_index;
     if (pi >= 0 && pi < nm->count) {
-      civ_nation_t *pn = &nm->nations[pi];
       char buf[192];
-      snprintf(buf, sizeof(buf),
-          "%s  |  GDP: $%.0fM  +%.1f%%  |  Unemp: %.1f%%  |  Infl: %.1f%%",
-          pn->name, pn->economy.gdp, pn->economy.gdp_growth * 100.0f,
-          pn->economy.unemployment * 100.0f, pn->economy.inflation * 100.0f);
-      civ_font_render_aligned(r, f, buf, lx, dy, cw, 16,
+      civ_font_render_aligned(r, f,
+          civ_screen_metric_label(g, CIV_METRIC_NATION_SUMMARY), lx, dy, cw, 16,
           g_theme.text_secondary, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
       dy += 22;
+
+      /* GDP over the last 120 recorded turns; decoded once per turn */
+      gdp_history_t hist;
+      char key[32];
+      snprintf(key, sizeof(key), "econ.gdp.%d", pi);
+      CIV_CACHE_MEMO(g->cache, key, (uint64_t)g->current_turn, &hist,
+                     read_gdp_history(g, pi));
+      float *gdp_hist = hist.gdp;
+      size_t n = hist.count;
+      if (n > 1) {
+        SDL_Texture *sp = civ_graph_sparkline(r, lx, dy, cw, 24, gdp_hist,
+            (int)n, gdp_hist[n - 1] >= gdp_hist[0] ? g_theme.success
+                                                   : g_theme.danger);
+        if (sp) {
+          SDL_FRect dr = { (float)lx, (float)dy, (float)cw, 24.0f };
+          SDL_RenderTexture(r, sp, NULL, &dr);
+          SDL_DestroyTexture(sp);
+        }
+        dy += 30;
+      }
+
+      outlook_t outlook;
+      snprintf(key, sizeof(key), "econ.outlook.%d", pi);
+      CIV_CACHE_MEMO(g->cache, key, (uint64_t)g->current_turn, &outlook,
+                     read_outlook(nm, pi));
+      if (outlook.valid) {
+        snprintf(buf, sizeof(buf),
+            "Outlook, %d turns:  GDP %+.1f%%  |  Balance: $%.0fM  |  Debt: $%.0fM",
+            OUTLOOK_TURNS, outlook.gdp_change * 100.0f, outlook.deficit,
+            outlook.debt);
+        civ_font_render_aligned(r, f, buf, lx, dy, cw, 16,
+            outlook.gdp_change >= 0.0f ? g_theme.success : g_theme.danger,
+            CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
+        dy += 22;
+      }
     }
   }
 
@@ -56,18 +158,11 @@ void civ_screen_economy_render(SDL_Renderer *r, civ_game_t *g, civ_font_t *f,
 
   /* ── Overview bar ──────────────────────────────────────────── */
   {
-    float avg_inf = 0;
-    for (int i = 0; i < 5 && i < mkt->currency_count; i++)
-      avg_inf += mkt->currencies[i].inflation;
-    avg_inf /= 5.0f;
-
     civ_render_rect_filled_alpha(r, lx, dy, cw, 30,
         g_theme.bg_dark, 200);
-    snprintf(buf, sizeof(buf),
-        "Inflation: %.1f%%  |  Commodities: %d  |  Currencies: %d  |  Companies: %d",
-        avg_inf * 100.0f, mkt->commodity_count,
-        mkt->currency_count, mkt->company_count);
-    civ_font_render_aligned(r, f, buf, lx + 10, dy + 7, cw - 20, 16,
+    civ_font_render_aligned(r, f,
+        civ_screen_metric_label(g, CIV_METRIC_MARKET_OVERVIEW),
+        lx + 10, dy + 7, cw - 20, 16,
         g_theme.warning, CIV_ALIGN_LEFT, CIV_VALIGN_MIDDLE);
     dy += 36;
   }
@@ -100,22 +195,17 @@ void civ_screen_economy_render(SDL_Renderer *r, civ_game_t *g, civ_font_t *f,
       if (idx >= mkt->currency_count) continue;
       civ_market_currency_t *mc = &mkt->currencies[idx];
 
-      float tr[] = { mc->current_rate * 0.97f, mc->current_rate * 0.99f,
-                     mc->current_rate, mc->current_rate * 1.02f,
-                     mc->current_rate * 1.01f, mc->current_rate * 0.98f };
+      price_trend_t tr;
+      char key[32];
+      snprintf(key, sizeof(key), "econ.fx.%d", idx);
+      CIV_CACHE_MEMO(g->cache, key, (uint64_t)g->current_turn, &tr,
+                     read_price_trend(civ_market_currency_history(mkt, idx), 120));
 
       snprintf(buf, sizeof(buf), "%-4s", mc->iso);
       civ_font_render_aligned(r, f, buf, lx, dy, 36, 14,
           g_theme.text_secondary, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
 
-      SDL_Texture *sp = civ_graph_sparkline(r, lx + 40, dy, 120, 12,
-          tr, 6, mc->current_rate > mc->base_rate ? g_theme.success
-                                                   : g_theme.danger);
-      if (sp) {
-        SDL_FRect dr = { (float)(lx + 40), (float)dy, 120.0f, 12.0f };
-        SDL_RenderTexture(r, sp, NULL, &dr);
-        SDL_DestroyTexture(sp);
-      }
+      draw_price_trend(r, tr.mean, tr.count, lx + 40, dy, 120, 12);
 
       snprintf(buf, sizeof(buf), "%10.4f %+6.1f%% %s",
           mc->current_rate,
@@ -135,25 +225,17 @@ void civ_screen_economy_render(SDL_Renderer *r, civ_game_t *g, civ_font_t *f,
       g_theme.warning, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
   dy += 22;
 
-  int listed = 0;
-  for (int ci = 0; ci < mkt->company_count && listed < 8; ci++) {
-    civ_company_t *co = civ_market_get_company(mkt, ci);
-    if (!co || !co->is_public) continue;
-
+  const civ_market_view_t *mv = civ_screen_market_view(g);
+  for (int si = 0; si < mv->stock_count; si++) {
     bool hov = civ_input_is_mouse_over(in, lx, dy, cw, 28);
     civ_render_rect_filled_alpha(r, lx, dy, cw, 28,
         hov ? g_theme.bg_light : g_theme.bg_dark, 200);
     civ_render_rect_outline(r, lx, dy, cw, 28,
         g_theme.hud_border, 1);
-
-    snprintf(buf, sizeof(buf), "%-20s %-12s Stock: $%.2f  Emp: %d  Rev: $%.1fM  Gr: %+.0f%%",
-        co->name, co->industry, co->stock_price,
-        co->employees, co->revenue / 1000000.0f, co->growth_rate * 100.0f);
-    civ_font_render_aligned(r, f, buf, lx + g_theme.space_sm, dy, cw - g_theme.space_md,
-        16, hov ? g_theme.text_primary : g_theme.hud_text,
+    civ_font_render_aligned(r, f, mv->stocks[si], lx + g_theme.space_sm, dy,
+        cw - g_theme.space_md, 16, hov ? g_theme.text_primary : g_theme.hud_text,
         CIV_ALIGN_LEFT, CIV_VALIGN_MIDDLE);
     dy += 32;
-    listed++;
   }
 
   /* ── Commodities ────────────────────────────────────────────── */
@@ -164,24 +246,19 @@ void civ_screen_economy_render(SDL_Renderer *r, civ_game_t *g, civ_font_t *f,
       g_theme.warning, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
   dy += 22;
 
-  if (mkt->commodity_count > 0) {
-    civ_graph_bar_t bars[12];
-    float maxp = 0;
-    for (int i = 0; i < mkt->commodity_count && i < 12; i++) {
-      bars[i].label = mkt->commodities[i].name;
-      bars[i].value = mkt->commodities[i].price_per_unit;
+  if (mv->commodity_count > 0) {
+    civ_graph_bar_t bars[CIV_VIEW_COMMODITIES];
+    for (int i = 0; i < mv->commodity_count; i++) {
+      bars[i].label = mv->commodity_name[i];
+      bars[i].value = mv->commodity_bar[i];
       bars[i].color = g_graph_palette_default[i % 12];
-      if (bars[i].value > maxp) maxp = bars[i].value;
     }
-    for (int i = 0; i < mkt->commodity_count && i < 12; i++)
-      bars[i].value = bars[i].value / (maxp > 0 ? maxp : 1.0f);
 
     civ_graph_ctx_t gctx;
     civ_graph_ctx_init(&gctx, lx, dy, cw, 90);
     gctx.show_grid = false;
     gctx.x_max = (float)mkt->commodity_count;
-    SDL_Texture *bt = civ_graph_bar(r, &gctx, bars,
-        mkt->commodity_count < 12 ? mkt->commodity_count : 12, false);
+    SDL_Texture *bt = civ_graph_bar(r, &gctx, bars, mv->commodity_count, false);
     if (bt) {
       SDL_FRect dr = { (float)lx, (float)dy, (float)cw, 90.0f };
       SDL_RenderTexture(r, bt, NULL, &dr);
@@ -190,15 +267,19 @@ void civ_screen_economy_render(SDL_Renderer *r, civ_game_t *g, civ_font_t *f,
     dy += 100;
 
     /* Price list */
-    for (int i = 0; i < mkt->commodity_count && i < 12; i++) {
-      snprintf(buf, sizeof(buf), "%-14s $%8.1f %s",
-          mkt->commodities[i].name,
-          mkt->commodities[i].price_per_unit,
-          mkt->commodities[i].unit);
+    for (int i = 0; i < mv->commodity_count; i++) {
       int col = i % 2;
-      civ_font_render_aligned(r, f, buf, lx + col * (cw / 2), dy,
+      civ_font_render_aligned(r, f, mv->commodity_rows[i], lx + col * (cw / 2), dy,
           cw / 2 - g_theme.space_sm, 14,
           g_theme.text_dim, CIV_ALIGN_LEFT, CIV_VALIGN_TOP);
+
+      price_trend_t tr;
+      char key[32];
+      snprintf(key, sizeof(key), "econ.cm.%d", i);
+      CIV_CACHE_MEMO(g->cache, key, (uint64_t)g->current_turn, &tr,
+                     read_price_trend(civ_market_commodity_history(mkt, i), 60));
+      draw_price_trend(r, tr.mean, tr.count, lx + col * (cw / 2) + cw / 2 - 60 - g_theme.space_sm,
+                       dy + 1, 60, 12);
       if (col == 1) dy += 16;
     }
   }
@@ -2,6 +2,7 @@
 #include "ui/screens/screens.h"
 #include "core/character.h"
 #include "engine/renderer.h"
+#include "ui/screens/screen_metrics.h"
 #include "ui/ui_common.h"
 #include <stdio.h>
 
@@ -20,8 +21,7 @@ void civ_screen_finance_render(SDL_Renderer *r, civ_game_t *g, civ_font_t *f,
     if(hov&&in->mouse_left_pressed){if(a==0&&pc->personal_wealth>=100){pc->personal_wealth-=100;pc->savings_balance+=100;}else if(a==1&&pc->savings_balance>=50){pc->savings_balance-=50;pc->personal_wealth+=50;}else if(a==2){pc->loan_balance+=500;pc->personal_wealth+=500;pc->loan_rate=0.05f;}else if(a==3&&pc->personal_wealth>=100){pc->personal_wealth-=100;pc->loan_balance-=100;}} if(a%2==1)dy+=28;}
   /* Wallet */
   dy+=6;civ_render_line(r,lx,dy,lx+w-8,dy,g_theme.hud_border);dy+=6;
-  snprintf(buf,sizeof(buf),"Wallet: %.0f USD (%d currencies)",civ_wallet_total(&g->wallet,(civ_market_engine_t*)g->market),g->wallet.count);
-  civ_font_render_aligned(r,f,buf,lx,dy,w-8,16,g_theme.warning,CIV_ALIGN_LEFT,CIV_VALIGN_TOP);dy+=18;
+  civ_font_render_aligned(r,f,civ_screen_metric_label(g,CIV_METRIC_WALLET_SUMMARY),lx,dy,w-8,16,g_theme.warning,CIV_ALIGN_LEFT,CIV_VALIGN_TOP);dy+=18;
   for(int wi=0;wi<g->wallet.count&&wi<6;wi++){civ_market_currency_t*mc=civ_market_get_currency((civ_market_engine_t*)g->market,g->wallet.slots[wi].currency_iso); snprintf(buf,sizeof(buf),"%-4s %12.2f %s",g->wallet.slots[wi].currency_iso,g->wallet.slots[wi].balance,mc?mc->name:""); civ_font_render_aligned(r,f,buf,lx+(wi%2)*(w/2),dy,w/2-8,14,g_theme.text_dim,CIV_ALIGN_LEFT,CIV_VALIGN_TOP); if(wi%2==1)dy+=16;}
   (void)cur;(void)sym;(void)h;(void)sh;
 }
@@ -12,6 +12,9 @@ void civ_screen_health_render(SDL_Renderer *r, civ_game_t *g, civ_font_t *f,
   int dy=y, lx=x+4; char buf[96];
   civ_font_render_aligned(r,f,"HEALTH & WELLNESS",lx,dy,w-8,22,CIV_COLOR_PRIMARY,CIV_ALIGN_LEFT,CIV_VALIGN_TOP); dy+=26;
   if(pc){snprintf(buf,sizeof(buf),"Health:%.0f%% Cost:%.0f/mo",pc->health,pc->healthcare_cost); uint32_t hc=pc->health>70?0x44FF44:pc->health>40?g_theme.warning:g_theme.danger; civ_font_render_aligned(r,f,buf,lx,dy,w-8,18,hc,CIV_ALIGN_LEFT,CIV_VALIGN_TOP); dy+=24;}
+  if(g->pollution){snprintf(buf,sizeof(buf),"Air quality: %.0f%%",100.0*(1.0-g->pollution_harm)); civ_font_render_aligned(r,f,buf,lx,dy,w-8,18,g->pollution_harm>0.3?g_theme.warning:g_theme.text_secondary,CIV_ALIGN_LEFT,CIV_VALIGN_TOP); dy+=22;}
+  civ_epidemic_system_t *ep=g->epidemics;
+  for(size_t d=0;ep&&d<ep->disease_count;d++){const civ_epidemic_t *e=&ep->diseases[d]; if(e->active_count==0&&e->deaths==0)continue; snprintf(buf,sizeof(buf),"%s: %u outbreaks, %lld dead",e->name,e->active_count,(long long)e->deaths); civ_font_render_aligned(r,f,buf,lx,dy,w-8,18,e->active_count?g_theme.danger:g_theme.text_secondary,CIV_ALIGN_LEFT,CIV_VALIGN_TOP); dy+=22;}
   float col = g->market ? civ_market_cost_of_living((civ_market_engine_t*)g->market, cur) : 1.0f;
   char hl[5][48];
   snprintf(hl[0],48,"Visit Doctor (-%s%.0f)",sym,80.0f*col);
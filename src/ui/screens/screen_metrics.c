@@ -0,0 +1,343 @@
+/**
+ * @file screen_metrics.c
+ * @brief Per-tick derived values, view models and their labels for the
+ *        screens
+ */
+#include "ui/screens/screen_metrics.h"
+#include "core/character.h"
+#include "core/economy/financial_markets.h"
+#include "core/governance/government.h"
+#include "core/simulation_engine/worker_pool.h"
+#include "core/world/nation.h"
+#include "core/world/resource_map.h"
+#include <SDL3/SDL.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Faction names shown on a rivalry line, with room left for the rest */
+#define RIVAL_NAME_MAX 64
+
+typedef void (*metric_compute_fn)(civ_game_t *g, float *v);
+typedef void (*metric_format_fn)(civ_game_t *g, const float *v, char *buf,
+                                 size_t size);
+
+typedef struct {
+  float v[CIV_METRIC_VALUES];
+  char label[CIV_METRIC_LABEL_LEN];
+} metric_slot_t;
+
+/* One published generation of everything the screens read */
+typedef struct {
+  const civ_game_t   *game;
+  uint64_t            update;     /* performance.update_count when built */
+  int32_t             turn;
+  metric_slot_t       metrics[CIV_METRIC_COUNT];
+  civ_nation_view_t   nation;
+  civ_market_view_t   market;
+  civ_politics_view_t politics;
+} screen_views_t;
+
+static screen_views_t views[2];
+static SDL_AtomicInt  views_front;
+static bool           views_published;
+static bool           views_stale;
+static char           watched_nation[64];
+
+/* ── Metrics ───────────────────────────────────────────────────────── */
+
+/* v = {nation index or -1, GDP, growth, unemployment, inflation} */
+static void compute_nation_summary(civ_game_t *g, float *v) {
+  v[0] = -1.0f;
+  civ_nation_manager_t *nm = (civ_nation_manager_t *)g->nation_manager;
+  if (!nm || nm->player_nation_index < 0 ||
+      nm->player_nation_index >= nm->count)
+    return;
+  const civ_nation_economy_t *e = &nm->nations[nm->player_nation_index].economy;
+  v[0] = (float)nm->player_nation_index;
+  v[1] = e->gdp;
+  v[2] = e->gdp_growth;
+  v[3] = e->unemployment;
+  v[4] = e->inflation;
+}
+
+static void format_nation_summary(civ_game_t *g, const float *v, char *buf,
+                                  size_t size) {
+  if (v[0] < 0.0f) return;
+  civ_nation_manager_t *nm = (civ_nation_manager_t *)g->nation_manager;
+  snprintf(buf, size,
+      "%s  |  GDP: $%.0fM  +%.1f%%  |  Unemp: %.1f%%  |  Infl: %.1f%%",
+      nm->nations[(int)v[0]].name, v[1], v[2] * 100.0f, v[3] * 100.0f,
+      v[4] * 100.0f);
+}
+
+/* v = {mean inflation of the first five currencies, commodities,
+        currencies, companies} */
+static void compute_market_overview(civ_game_t *g, float *v) {
+  civ_market_engine_t *mkt = g->market;
+  if (!mkt) return;
+  float inflation = 0.0f;
+  for (int i = 0; i < 5 && i < mkt->currency_count; i++)
+    inflation += mkt->currencies[i].inflation;
+  v[0] = inflation / 5.0f;
+  v[1] = (float)mkt->commodity_count;
+  v[2] = (float)mkt->currency_count;
+  v[3] = (float)mkt->companies.count;
+}
+
+static void format_market_overview(civ_game_t *g, const float *v, char *buf,
+                                   size_t size) {
+  if (!g->market) return;
+  snprintf(buf, size,
+      "Inflation: %.1f%%  |  Commodities: %d  |  Currencies: %d  |  Companies: %d",
+      v[0] * 100.0f, (int)v[1], (int)v[2], (int)v[3]);
+}
+
+/* v = {wallet total in USD, currencies held} */
+static void compute_wallet_summary(civ_game_t *g, float *v) {
+  v[0] = civ_wallet_total(&g->wallet, (civ_market_engine_t *)g->market);
+  v[1] = (float)g->wallet.count;
+}
+
+static void format_wallet_summary(civ_game_t *g, const float *v, char *buf,
+                                  size_t size) {
+  (void)g;
+  snprintf(buf, size, "Wallet: %.0f USD (%d currencies)", v[0], (int)v[1]);
+}
+
+static const struct {
+  metric_compute_fn compute;
+  metric_format_fn  format;
+} k_metrics[CIV_METRIC_COUNT] = {
+  [CIV_METRIC_NATION_SUMMARY]  = {compute_nation_summary,  format_nation_summary},
+  [CIV_METRIC_MARKET_OVERVIEW] = {compute_market_overview, format_market_overview},
+  [CIV_METRIC_WALLET_SUMMARY]  = {compute_wallet_summary,  format_wallet_summary},
+};
+
+/* The previous generation's label is kept when its values did not move */
+static void build_metrics(civ_game_t *g, screen_views_t *out,
+                          const screen_views_t *prev) {
+  for (int id = 0; id < CIV_METRIC_COUNT; id++) {
+    metric_slot_t *s = &out->metrics[id];
+    memset(s->v, 0, sizeof(s->v));
+    k_metrics[id].compute(g, s->v);
+    const metric_slot_t *p = prev ? &prev->metrics[id] : NULL;
+    if (p && memcmp(p->v, s->v, sizeof(s->v)) == 0) {
+      memcpy(s->label, p->label, sizeof(s->label));
+      continue;
+    }
+    s->label[0] = '\0';
+    k_metrics[id].format(g, s->v, s->label, sizeof(s->label));
+  }
+}
+
+/* ── View models ───────────────────────────────────────────────────── */
+
+static void build_nation_view(civ_game_t *g, civ_nation_view_t *v) {
+  memset(v, 0, sizeof(*v));
+  if (!watched_nation[0] || !g->nation_manager) return;
+  const civ_nation_t *nat = civ_nation_get_by_id(
+      (civ_nation_manager_t *)g->nation_manager, watched_nation);
+  if (!nat) return;
+
+  v->found = true;
+  snprintf(v->name, sizeof(v->name), "%s", nat->name);
+  memcpy(v->iso_a2, nat->iso_a2, sizeof(v->iso_a2));
+  const char *iso = nat->iso_a3[0] ? nat->iso_a3 : "—";
+  snprintf(v->lines[0], sizeof(v->lines[0]), "Capital: %.1f%c %.1f%c  |  ISO: %s",
+           fabsf(nat->capital_lat), nat->capital_lat >= 0 ? 'N' : 'S',
+           fabsf(nat->capital_lon), nat->capital_lon >= 0 ? 'E' : 'W', iso);
+  snprintf(v->lines[1], sizeof(v->lines[1]),
+           "Population: %lldM  |  GDP: $%.0fM  |  Growth: %+.1f%%",
+           (long long)(nat->population / 1000000), nat->economy.gdp,
+           nat->economy.gdp_growth * 100.0f);
+  snprintf(v->lines[2], sizeof(v->lines[2]),
+           "Unemp: %.1f%%  |  Infl: %.1f%%  |  Food: %.0fM",
+           nat->economy.unemployment * 100.0f,
+           nat->economy.inflation * 100.0f,
+           nat->economy.food_production / 1000000.0f);
+  snprintf(v->lines[3], sizeof(v->lines[3]), "Gov: %s  |  ISO: %s",
+           civ_government_proximity_label(nat->government), iso);
+  snprintf(v->indices, sizeof(v->indices),
+           "Tech %+d  Econ %+d  Mil %+d  Cult %+d",
+           nat->tech_index, nat->economic_index,
+           nat->military_index, nat->cultural_index);
+
+  if (!g->resource_map || !g->world_map) return;
+  /* Cached by the last economy pass; no map scan */
+  const civ_nation_resource_profile_t *rp = &nat->resources;
+  snprintf(v->resources, sizeof(v->resources), "RESOURCES: %d types, %d total",
+           rp->distinct_types, rp->total_resources);
+  v->no_resources = rp->distinct_types == 0;
+
+  /* Largest holdings first; ties keep type order */
+  int top[20];
+  int n = 0;
+  for (int t = 0; t < 20; t++) {
+    if (rp->quantities[t] == 0) continue;
+    int at = n++;
+    while (at > 0 && rp->quantities[top[at - 1]] < rp->quantities[t]) {
+      top[at] = top[at - 1];
+      at--;
+    }
+    top[at] = t;
+  }
+  if (n > CIV_VIEW_RESOURCES) n = CIV_VIEW_RESOURCES;
+  for (int i = 0; i < n; i++)
+    snprintf(v->resource_rows[i], sizeof(v->resource_rows[i]),
+             "  %-14s Qty:%5u Qual:%d",
+             civ_resource_type_name((civ_resource_type_t)top[i]),
+             rp->quantities[top[i]], rp->best_quality[top[i]]);
+  v->resource_count = n;
+}
+
+static void build_market_view(civ_game_t *g, civ_market_view_t *v) {
+  memset(v, 0, sizeof(*v));
+  civ_market_engine_t *mkt = g->market;
+  if (!mkt) return;
+
+  for (uint32_t ci = 0; ci < mkt->companies.count &&
+                        v->stock_count < CIV_VIEW_STOCKS; ci++) {
+    if (!mkt->companies.is_public[ci]) continue;
+    civ_company_t co;
+    civ_company_registry_get(&mkt->companies, ci, &co);
+    snprintf(v->stocks[v->stock_count++], sizeof(v->stocks[0]),
+             "%-20s %-12s Stock: $%.2f  Emp: %d  Rev: $%.1fM  Gr: %+.0f%%",
+             co.name, co.industry, co.stock_price, co.employees,
+             co.revenue / 1000000.0f, co.growth_rate * 100.0f);
+  }
+
+  int n = mkt->commodity_count < CIV_VIEW_COMMODITIES
+              ? mkt->commodity_count : CIV_VIEW_COMMODITIES;
+  float maxp = 0.0f;
+  for (int i = 0; i < n; i++) {
+    const civ_commodity_t *c = &mkt->commodities[i];
+    snprintf(v->commodity_name[i], sizeof(v->commodity_name[i]), "%s", c->name);
+    snprintf(v->commodity_rows[i], sizeof(v->commodity_rows[i]), "%-14s $%8.1f %s",
+             c->name, c->price_per_unit, c->unit);
+    v->commodity_bar[i] = c->price_per_unit;
+    if (c->price_per_unit > maxp) maxp = c->price_per_unit;
+  }
+  for (int i = 0; i < n; i++)
+    v->commodity_bar[i] /= maxp > 0.0f ? maxp : 1.0f;
+  v->commodity_count = n;
+}
+
+static void build_politics_view(civ_game_t *g, civ_politics_view_t *v) {
+  memset(v, 0, sizeof(*v));
+  const civ_character_t *pc = (const civ_character_t *)g->player_character;
+  snprintf(v->standing, sizeof(v->standing),
+           "Influence:%.0f Party:%s Approval:%.0f%% Boss:%.0f%%",
+           pc ? pc->political_influence : 0.0f,
+           g->player_role.party_name[0] ? g->player_role.party_name : "None",
+           g->player_role.public_approval * 100, g->player_role.boss_trust * 100);
+
+  const civ_faction_system_t *fs =
+      g->politics_system ? g->politics_system->faction_system : NULL;
+  if (!fs) return;
+  v->has_factions = true;
+  snprintf(v->factions, sizeof(v->factions), "Faction stability:%.0f%% Factions:%zu",
+           civ_faction_system_calculate_stability(fs) * 100, fs->faction_count);
+  for (size_t k = 0; k < CIV_VIEW_CHANGES; k++) {
+    const civ_faction_change_t *c = civ_faction_system_change(fs, k);
+    if (!c) break;
+    char *buf = v->changes[v->change_count++];
+    size_t size = sizeof(v->changes[0]);
+    const char *who = c->faction >= 0 ? fs->factions[c->faction].name : "none";
+    if (c->kind == CIV_FACTION_CHANGE_STABILITY)
+      snprintf(buf, size, "Stability %.0f%% -> %.0f%%", c->before * 100, c->after * 100);
+    else if (c->kind == CIV_FACTION_CHANGE_DOMINANT)
+      snprintf(buf, size, "%s now leads", who);
+    else
+      /* Two names share the line; each gets a fair half of it */
+      snprintf(buf, size, "Rivalry %.*s / %.*s: %.0f%%", RIVAL_NAME_MAX, who,
+               RIVAL_NAME_MAX,
+               c->other >= 0 ? fs->factions[c->other].name : "none", c->after * 100);
+  }
+}
+
+/* ── Publishing ────────────────────────────────────────────────────── */
+
+typedef struct {
+  civ_game_t           *game;
+  screen_views_t       *out;
+  const screen_views_t *prev;
+} publish_ctx_t;
+
+/* One builder per index; each writes only its own part of out */
+static void publish_part(void *arg, int index) {
+  publish_ctx_t *ctx = (publish_ctx_t *)arg;
+  switch (index) {
+  case 0: build_metrics(ctx->game, ctx->out, ctx->prev); break;
+  case 1: build_nation_view(ctx->game, &ctx->out->nation); break;
+  case 2: build_market_view(ctx->game, &ctx->out->market); break;
+  case 3: build_politics_view(ctx->game, &ctx->out->politics); break;
+  default: break;
+  }
+}
+
+void civ_screen_metrics_publish(civ_game_t *g) {
+  if (!g) return;
+  int front = SDL_GetAtomicInt(&views_front);
+  const screen_views_t *prev = &views[front];
+  publish_ctx_t ctx = {
+    .game = g,
+    .out = &views[front ^ 1],
+    .prev = views_published && !views_stale && prev->game == g ? prev : NULL,
+  };
+  civ_worker_pool_t *pool = g->system_orchestrator
+      ? civ_system_orchestrator_get_worker_pool(g->system_orchestrator) : NULL;
+  civ_worker_pool_parallel_for(pool, 4, publish_part, &ctx);
+  ctx.out->game = g;
+  ctx.out->update = g->performance.update_count;
+  ctx.out->turn = g->current_turn;
+  SDL_SetAtomicInt(&views_front, front ^ 1);
+  views_published = true;
+  views_stale = false;
+}
+
+static const screen_views_t *current_views(civ_game_t *g) {
+  const screen_views_t *v = &views[SDL_GetAtomicInt(&views_front)];
+  if (!views_published || views_stale || v->game != g ||
+      v->update != g->performance.update_count || v->turn != g->current_turn) {
+    civ_screen_metrics_publish(g);
+    v = &views[SDL_GetAtomicInt(&views_front)];
+  }
+  return v;
+}
+
+/* ── Lookup ────────────────────────────────────────────────────────── */
+
+float civ_screen_metric(civ_game_t *g, civ_metric_id_t id, int k) {
+  if (!g || id < 0 || id >= CIV_METRIC_COUNT || k < 0 || k >= CIV_METRIC_VALUES)
+    return 0.0f;
+  return current_views(g)->metrics[id].v[k];
+}
+
+const char *civ_screen_metric_label(civ_game_t *g, civ_metric_id_t id) {
+  if (!g || id < 0 || id >= CIV_METRIC_COUNT) return "";
+  return current_views(g)->metrics[id].label;
+}
+
+const civ_nation_view_t *civ_screen_nation_view(civ_game_t *g) {
+  return g ? &current_views(g)->nation : NULL;
+}
+
+const civ_market_view_t *civ_screen_market_view(civ_game_t *g) {
+  return g ? &current_views(g)->market : NULL;
+}
+
+const civ_politics_view_t *civ_screen_politics_view(civ_game_t *g) {
+  return g ? &current_views(g)->politics : NULL;
+}
+
+void civ_screen_metrics_watch_nation(const char *nation_id) {
+  const char *id = nation_id ? nation_id : "";
+  if (strcmp(watched_nation, id) == 0) return;
+  snprintf(watched_nation, sizeof(watched_nation), "%s", id);
+  views_stale = true;
+}
+
+void civ_screen_metrics_invalidate(void) {
+  views_stale = true;
+}
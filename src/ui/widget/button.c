@@ -27,25 +27,29 @@ void civ_widget_button_destroy(civ_widget_button_t *btn) { free(btn); }
 void civ_widget_button_set_text(civ_widget_button_t *btn, const char *text) {
   if (!btn) return;
   strncpy(btn->text, text ? text : "", sizeof(btn->text) - 1);
+  civ_widget_invalidate(&btn->base);
 }
 
 void civ_widget_button_set_enabled(civ_widget_button_t *btn, bool enabled) {
   if (!btn) return;
+  if (btn->base.enabled == enabled) return;
   btn->base.enabled = enabled;
+  civ_widget_invalidate(&btn->base);
 }
 
 void civ_widget_button_set_position(civ_widget_button_t *btn, float x, float y) {
   if (!btn) return;
   btn->base.x = x;
   btn->base.y = y;
+  civ_widget_invalidate(&btn->base);
 }
 
 void civ_widget_button_update(civ_widget_button_t *btn, civ_input_state_t *input,
                               float dt) {
   if (!btn || !btn->base.visible || !btn->base.enabled) return;
 
-  btn->base.state =
-      civ_widget_compute_state(&btn->base, input, true);
+  civ_widget_set_state(&btn->base,
+                       civ_widget_compute_state(&btn->base, input, true));
 
   float target = (btn->base.state >= CIV_WIDGET_HOVERED) ? 1.0f : 0.0f;
   if (!btn->hover_tween.active && btn->hover_tween.done)
@@ -54,6 +58,7 @@ void civ_widget_button_update(civ_widget_button_t *btn, civ_input_state_t *input
   else if (fabsf(btn->hover_tween.to - target) > 0.01f)
     civ_tween_start(&btn->hover_tween, CIV_TWEEN_FADE_IN, 0.15f,
                     btn->hover_tween.to, target);
+  if (btn->hover_tween.active) civ_widget_invalidate(&btn->base);
   civ_tween_update(&btn->hover_tween, dt);
 
   btn->clicked = (btn->base.state == CIV_WIDGET_PRESSED &&
@@ -48,6 +48,7 @@ void civ_drawer_open(civ_drawer_t *d) {
                   d->current_w, d->open_w);
   civ_tween_start(&d->alpha_tween, CIV_TWEEN_FADE_IN, g_theme.anim_fade_ms,
                   0.3f, 1.0f);
+  civ_widget_invalidate(&d->base);
 }
 
 void civ_drawer_close(civ_drawer_t *d) {
@@ -57,6 +58,7 @@ void civ_drawer_close(civ_drawer_t *d) {
                   d->current_w, d->collapsed_w);
   civ_tween_start(&d->alpha_tween, CIV_TWEEN_FADE_OUT, g_theme.anim_fade_ms,
                   1.0f, 0.3f);
+  civ_widget_invalidate(&d->base);
 }
 
 void civ_drawer_toggle(civ_drawer_t *d) {
@@ -84,6 +86,11 @@ void civ_drawer_update(civ_drawer_t *d, civ_input_state_t *input,
                        float dt, int win_w, int win_h) {
   if (!d || !input) return;
 
+  bool was_hover = d->hover_tab;
+  float was_w = d->current_w;
+  if (d->width_tween.active || d->alpha_tween.active)
+    civ_widget_invalidate(&d->base);
+
   /* Animate width */
   civ_tween_update(&d->width_tween, dt);
   civ_tween_update(&d->alpha_tween, dt);
@@ -102,6 +109,7 @@ void civ_drawer_update(civ_drawer_t *d, civ_input_state_t *input,
   /* Tab hit area */
   float tab_x = d->right_side ? d->base.x : d->base.x + d->current_w - (float)d->tab_width;
   d->hover_tab = civ_input_is_mouse_over(input, (int)tab_x, 0, d->tab_width, win_h);
+  if (d->hover_tab != was_hover) civ_widget_invalidate(&d->base);
 
   /* Click tab to toggle */
   if (d->hover_tab && input->mouse_left_pressed) {
@@ -143,6 +151,7 @@ void civ_drawer_update(civ_drawer_t *d, civ_input_state_t *input,
   if (input->esc_pressed && d->is_open) {
     civ_drawer_close(d);
   }
+  if (d->current_w != was_w) civ_widget_invalidate(&d->base);
 
   (void)win_w;
 }
@@ -25,11 +25,14 @@ void civ_dropdown_add_item(civ_dropdown_t *dd, const char *text) {
   if (!dd || !text || dd->item_count >= CIV_DROPDOWN_MAX_ITEMS) return;
   strncpy(dd->items[dd->item_count], text, CIV_DROPDOWN_ITEM_LEN - 1);
   dd->item_count++;
+  civ_widget_invalidate(&dd->base);
 }
 
 void civ_dropdown_set_selected(civ_dropdown_t *dd, int index) {
   if (!dd || index < 0 || index >= dd->item_count) return;
+  if (dd->selected_index == index) return;
   dd->selected_index = index;
+  civ_widget_invalidate(&dd->base);
 }
 
 int civ_dropdown_get_selected(const civ_dropdown_t *dd) {
@@ -51,6 +54,8 @@ void civ_dropdown_update(civ_dropdown_t *dd, civ_input_state_t *input, float dt)
   (void)dt;
 
   bool hover_main = civ_widget_is_hovered(&dd->base, input);
+  bool was_open = dd->is_open;
+  int was_selected = dd->selected_index;
 
   /* Toggle open on click */
   if (hover_main && input->mouse_left_pressed) {
@@ -79,6 +84,9 @@ void civ_dropdown_update(civ_dropdown_t *dd, civ_input_state_t *input, float dt)
         list_bottom - dd->base.y - dd->base.h);
     if (!in_list) dd->is_open = false;
   }
+
+  if (dd->is_open != was_open || dd->selected_index != was_selected)
+    civ_widget_invalidate(&dd->base);
 }
 
 void civ_dropdown_render(civ_dropdown_t *dd, SDL_Renderer *r) {
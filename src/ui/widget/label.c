@@ -31,11 +31,13 @@ void civ_label_set_text(civ_label_t *lbl, const char *text) {
   if (!lbl) return;
   strncpy(lbl->text, text ? text : "", sizeof(lbl->text) - 1);
   lbl->text[sizeof(lbl->text) - 1] = '\0';
+  civ_widget_invalidate(&lbl->base);
 }
 
 void civ_label_set_font(civ_label_t *lbl, struct civ_font *font) {
   if (!lbl) return;
   lbl->font = font;
+  civ_widget_invalidate(&lbl->base);
 }
 
 void civ_label_render(civ_label_t *lbl, SDL_Renderer *r) {
@@ -28,11 +28,13 @@ void civ_modal_show(civ_modal_t *m) {
   m->is_open = true;
   m->confirmed = m->cancelled = false;
   civ_tween_start(&m->fade, CIV_TWEEN_FADE_IN, 0.25f, 0.0f, 1.0f);
+  civ_widget_invalidate(&m->base);
 }
 
 void civ_modal_hide(civ_modal_t *m) {
   if (!m) return;
   civ_tween_start(&m->fade, CIV_TWEEN_FADE_OUT, 0.2f, 1.0f, 0.0f);
+  civ_widget_invalidate(&m->base);
 }
 
 bool civ_modal_is_open(const civ_modal_t *m) {
@@ -54,6 +56,7 @@ static bool pt_in(float px, float py, float rx, float ry, float rw, float rh) {
 void civ_modal_update(civ_modal_t *m, civ_input_state_t *input, float dt,
                       int win_w, int win_h) {
   if (!m || !input) return;
+  if (m->fade.active) civ_widget_invalidate(&m->base);
   civ_tween_update(&m->fade, dt);
   m->overlay_alpha = civ_tween_value(&m->fade);
 
@@ -1,5 +1,6 @@
 #include "ui/widget/panel.h"
 #include "engine/renderer.h"
+#include "utils/frame_trace.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -22,7 +23,10 @@ civ_panel_t *civ_panel_create(const char *id, float x, float y, float w, float h
 }
 
 void civ_panel_destroy(civ_panel_t *p) {
-  if (p) civ_widget_destroy_children(&p->base);
+  if (p) {
+    civ_widget_destroy_children(&p->base);
+    if (p->cache) SDL_DestroyTexture(p->cache);
+  }
   free(p);
 }
 
@@ -83,24 +87,9 @@ void civ_panel_update(civ_panel_t *p, civ_input_state_t *input, float dt) {
   }
 }
 
-void civ_panel_render_chrome(civ_panel_t *p, SDL_Renderer *r, int win_w,
-                             int win_h) {
-  if (!p || !p->base.visible || !r) return;
-
-  float alpha = civ_panel_anim_alpha(&p->anim);
-  if (alpha <= 0.01f) return;
-
-  float ox = civ_panel_anim_offset_x(&p->anim);
-  float oy = civ_panel_anim_offset_y(&p->anim);
-  float sc = civ_panel_anim_scale(&p->anim);
-
-  float cx = p->base.x + p->base.w / 2.0f;
-  float cy = p->base.y + p->base.h / 2.0f;
-  float rw = p->base.w * sc;
-  float rh = p->base.h * sc;
-  float rx = cx - rw / 2.0f + ox;
-  float ry = cy - rh / 2.0f + oy;
-
+/* Background, border and title bar over (rx, ry, rw, rh) */
+static void draw_chrome(civ_panel_t *p, SDL_Renderer *r, float rx, float ry,
+                        float rw, float rh, float alpha) {
   /* Background */
   civ_render_rect_filled_alpha(r, (int)rx, (int)ry, (int)rw, (int)rh,
                                p->color_bg, (uint8_t)(220 * alpha));
@@ -115,6 +104,30 @@ void civ_panel_render_chrome(civ_panel_t *p, SDL_Renderer *r, int win_w,
                                g_theme.bg_medium, (uint8_t)(240 * alpha));
   civ_render_line(r, (int)rx, (int)(ry + (float)title_h), (int)(rx + rw),
                   (int)(ry + (float)title_h), p->color_border);
+}
+
+/* Where the animation puts the panel this frame */
+static SDL_FRect anim_rect(const civ_panel_t *p) {
+  float ox = civ_panel_anim_offset_x(&p->anim);
+  float oy = civ_panel_anim_offset_y(&p->anim);
+  float sc = civ_panel_anim_scale(&p->anim);
+
+  float cx = p->base.x + p->base.w / 2.0f;
+  float cy = p->base.y + p->base.h / 2.0f;
+  float rw = p->base.w * sc;
+  float rh = p->base.h * sc;
+  return (SDL_FRect){cx - rw / 2.0f + ox, cy - rh / 2.0f + oy, rw, rh};
+}
+
+void civ_panel_render_chrome(civ_panel_t *p, SDL_Renderer *r, int win_w,
+                             int win_h) {
+  if (!p || !p->base.visible || !r) return;
+
+  float alpha = civ_panel_anim_alpha(&p->anim);
+  if (alpha <= 0.01f) return;
+
+  SDL_FRect rect = anim_rect(p);
+  draw_chrome(p, r, rect.x, rect.y, rect.w, rect.h, alpha);
 
   /* Title text placeholder — rendered by owner via font system */
   (void)win_w;
@@ -124,3 +137,49 @@ void civ_panel_render_chrome(civ_panel_t *p, SDL_Renderer *r, int win_w,
 void civ_panel_render(civ_panel_t *p, SDL_Renderer *r) {
   civ_panel_render_chrome(p, r, 0, 0);
 }
+
+bool civ_panel_begin_cached(civ_panel_t *p, SDL_Renderer *r) {
+  if (!p || !r || !p->base.visible) return false;
+
+  int w = (int)p->base.w, h = (int)p->base.h;
+  if (w <= 0 || h <= 0) return false;
+  if (!p->cache || p->cache_w != w || p->cache_h != h) {
+    if (p->cache) SDL_DestroyTexture(p->cache);
+    p->cache = civ_create_texture(r, SDL_PIXELFORMAT_ARGB8888,
+                                 SDL_TEXTUREACCESS_TARGET, w, h);
+    if (!p->cache) return false;
+    /* Drawn with blending onto clear, so the texels are premultiplied */
+    SDL_SetTextureBlendMode(p->cache, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+    p->cache_w = w;
+    p->cache_h = h;
+    p->base.dirty = true;
+  }
+  if (!p->base.dirty) return false;
+
+  civ_render_flush_batch();
+  p->prev_target = SDL_GetRenderTarget(r);
+  SDL_SetRenderTarget(r, p->cache);
+  SDL_SetRenderDrawColor(r, 0, 0, 0, 0);
+  SDL_RenderClear(r);
+  draw_chrome(p, r, 0.0f, 0.0f, (float)w, (float)h, 1.0f);
+  p->rendering = true;
+  return true;
+}
+
+void civ_panel_end_cached(civ_panel_t *p, SDL_Renderer *r) {
+  if (!p || !r) return;
+  if (p->rendering) {
+    civ_render_flush_batch();
+    SDL_SetRenderTarget(r, p->prev_target);
+    civ_widget_clean(&p->base);
+    p->rendering = false;
+  }
+  if (!p->base.visible || !p->cache) return;
+
+  float alpha = civ_panel_anim_alpha(&p->anim);
+  if (alpha <= 0.01f) return;
+  civ_render_flush_batch();
+  SDL_SetTextureAlphaModFloat(p->cache, alpha);
+  SDL_FRect dst = anim_rect(p);
+  SDL_RenderTexture(r, p->cache, NULL, &dst);
+}
@@ -23,7 +23,9 @@ void civ_progress_bar_set_value(civ_progress_bar_t *pb, float value) {
   if (!pb) return;
   if (value < 0.0f) value = 0.0f;
   if (value > 1.0f) value = 1.0f;
+  if (pb->value == value) return;
   pb->value = value;
+  civ_widget_invalidate(&pb->base);
 }
 
 void civ_progress_bar_render(civ_progress_bar_t *pb, SDL_Renderer *r) {
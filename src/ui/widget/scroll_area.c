@@ -1,6 +1,7 @@
 #include "ui/widget/scroll_area.h"
 #include "display/theme.h"
 #include "engine/renderer.h"
+#include "utils/frame_trace.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
@@ -22,12 +23,15 @@ civ_scroll_area_t *civ_scroll_area_create(const char *id, float x, float y,
   sa->color_scrollbar = 0x1A2A3A;
   sa->color_scrollbar_hover = g_theme.primary;
   sa->content_tex = NULL;
+  sa->row_count = -1;
   return sa;
 }
 
 void civ_scroll_area_destroy(civ_scroll_area_t *sa) {
   if (!sa) return;
   if (sa->content_tex) SDL_DestroyTexture(sa->content_tex);
+  free(sa->row_top);
+  free(sa->row_heights);
   free(sa);
 }
 
@@ -35,7 +39,10 @@ void civ_scroll_area_set_content_size(civ_scroll_area_t *sa, int cw, int ch) {
   if (!sa) return;
   sa->content_w = cw;
   sa->content_h = ch;
-  if (sa->content_tex) SDL_DestroyTexture(sa->content_tex), sa->content_tex = NULL;
+  /* A texture already large enough is kept; begin/end use the content
+   * size, not the texture's */
+  if (sa->content_tex && (cw > sa->tex_w || ch > sa->tex_h))
+    SDL_DestroyTexture(sa->content_tex), sa->content_tex = NULL;
 }
 
 SDL_Renderer *civ_scroll_area_begin(civ_scroll_area_t *sa, SDL_Renderer *main_r) {
@@ -43,9 +50,11 @@ SDL_Renderer *civ_scroll_area_begin(civ_scroll_area_t *sa, SDL_Renderer *main_r)
 
   /* Create content texture on first use */
   if (!sa->content_tex) {
-    sa->content_tex = SDL_CreateTexture(main_r, SDL_PIXELFORMAT_ARGB8888,
+    sa->content_tex = civ_create_texture(main_r, SDL_PIXELFORMAT_ARGB8888,
         SDL_TEXTUREACCESS_TARGET, sa->content_w, sa->content_h);
     if (!sa->content_tex) return NULL;
+    sa->tex_w = sa->content_w;
+    sa->tex_h = sa->content_h;
   }
 
   /* Clear content texture */
@@ -72,6 +81,152 @@ void civ_scroll_area_end(civ_scroll_area_t *sa, SDL_Renderer *main_r) {
   SDL_RenderTexture(main_r, sa->content_tex, &src, &dst);
 }
 
+/* ── Row mode ──────────────────────────────────────────────────────── */
+
+static float row_y(const civ_scroll_area_t *sa, int i) {
+  return sa->measure_row ? sa->row_top[i] : (float)i * sa->row_height;
+}
+
+/* Row containing content offset y, clamped to the rows */
+static int row_index(const civ_scroll_area_t *sa, float y) {
+  if (sa->row_count <= 0) return 0;
+  int i;
+  if (!sa->measure_row) {
+    i = sa->row_height > 0.0f ? (int)(y / sa->row_height) : 0;
+  } else {
+    int lo = 0, hi = sa->row_count; /* last row_top <= y */
+    while (hi - lo > 1) {
+      int mid = (lo + hi) / 2;
+      if (sa->row_top[mid] <= y) lo = mid; else hi = mid;
+    }
+    i = lo;
+  }
+  if (i < 0) i = 0;
+  if (i > sa->row_count - 1) i = sa->row_count - 1;
+  return i;
+}
+
+static void rows_content_size(civ_scroll_area_t *sa) {
+  sa->content_w = (int)sa->base.w;
+  sa->content_h = (int)ceilf(row_y(sa, sa->row_count));
+}
+
+bool civ_scroll_area_set_rows(civ_scroll_area_t *sa, int count, float row_h,
+                              civ_scroll_row_draw_fn draw,
+                              civ_scroll_row_height_fn measure,
+                              void *user_data) {
+  if (!sa) return false;
+  if (count < 0) count = 0;
+  if (row_h < 1.0f) row_h = 1.0f;
+
+  if (measure && count + 1 > sa->row_capacity) {
+    float *top = realloc(sa->row_top, (size_t)(count + 1) * sizeof(float));
+    if (!top) return false;
+    sa->row_top = top;
+    float *heights = realloc(sa->row_heights, (size_t)(count + 1) * sizeof(float));
+    if (!heights) return false;
+    sa->row_heights = heights;
+    sa->row_capacity = count + 1;
+  }
+
+  if (sa->content_tex) SDL_DestroyTexture(sa->content_tex), sa->content_tex = NULL;
+  sa->row_count = count;
+  sa->row_height = row_h;
+  sa->draw_row = draw;
+  sa->measure_row = measure;
+  sa->row_user_data = user_data;
+  civ_scroll_area_invalidate_rows(sa);
+  return true;
+}
+
+void civ_scroll_area_invalidate_rows(civ_scroll_area_t *sa) {
+  if (!sa || sa->row_count < 0) return;
+  if (sa->measure_row) {
+    for (int i = 0; i <= sa->row_count; i++)
+      sa->row_top[i] = (float)i * sa->row_height;
+    memset(sa->row_heights, 0, (size_t)sa->row_count * sizeof(float));
+  }
+  rows_content_size(sa);
+  civ_widget_invalidate(&sa->base);
+}
+
+int civ_scroll_area_visible_rows(const civ_scroll_area_t *sa, int *first) {
+  if (first) *first = 0;
+  if (!sa || sa->row_count <= 0) return 0;
+  int f = row_index(sa, sa->scroll_y) - CIV_SCROLL_OVERSCAN;
+  int l = row_index(sa, sa->scroll_y + sa->base.h) + CIV_SCROLL_OVERSCAN;
+  if (f < 0) f = 0;
+  if (l > sa->row_count - 1) l = sa->row_count - 1;
+  if (first) *first = f;
+  return l - f + 1;
+}
+
+int civ_scroll_area_row_at(const civ_scroll_area_t *sa, float mx, float my) {
+  if (!sa || sa->row_count <= 0) return -1;
+  if (mx < sa->base.x || mx >= sa->base.x + sa->base.w ||
+      my < sa->base.y || my >= sa->base.y + sa->base.h)
+    return -1;
+  float y = my - sa->base.y + sa->scroll_y;
+  if (y >= row_y(sa, sa->row_count)) return -1;
+  return row_index(sa, y);
+}
+
+/* Ask the height of visible rows not measured yet. Offsets after the
+ * first changed row are rebuilt, and the scroll moves by however much the
+ * rows above the view grew, so what is on screen stays put. */
+static void rows_measure_visible(civ_scroll_area_t *sa) {
+  int first;
+  int n = civ_scroll_area_visible_rows(sa, &first);
+  int changed = -1;
+
+  for (int i = first; i < first + n; i++) {
+    if (sa->row_heights[i] > 0.0f) continue;
+    float h = sa->measure_row(i, sa->row_user_data);
+    if (h < 1.0f) h = 1.0f;
+    sa->row_heights[i] = h;
+    if (changed < 0 && h != sa->row_height) changed = i;
+  }
+  if (changed < 0) return;
+
+  int anchor = row_index(sa, sa->scroll_y);
+  float anchor_y = sa->row_top[anchor];
+  for (int i = changed; i < sa->row_count; i++) {
+    float h = sa->row_heights[i] > 0.0f ? sa->row_heights[i] : sa->row_height;
+    sa->row_top[i + 1] = sa->row_top[i] + h;
+  }
+  float shift = sa->row_top[anchor] - anchor_y;
+  sa->scroll_y += shift;
+  sa->target_scroll_y += shift;
+  rows_content_size(sa);
+}
+
+static void rows_render(civ_scroll_area_t *sa, SDL_Renderer *r) {
+  if (!sa->draw_row || sa->row_count <= 0) return;
+  if (sa->measure_row) rows_measure_visible(sa);
+
+  SDL_Rect saved_clip;
+  bool clipping = SDL_RenderClipEnabled(r);
+  SDL_GetRenderClipRect(r, &saved_clip);
+  SDL_Rect clip = {(int)sa->base.x, (int)sa->base.y, (int)sa->base.w,
+                   (int)sa->base.h};
+  SDL_SetRenderClipRect(r, &clip);
+
+  float row_w = sa->base.w;
+  if (sa->content_h > (int)sa->base.h) row_w -= (float)sa->scrollbar_w;
+
+  int first;
+  int n = civ_scroll_area_visible_rows(sa, &first);
+  for (int i = first; i < first + n; i++) {
+    float top = row_y(sa, i);
+    float h = row_y(sa, i + 1) - top;
+    sa->draw_row(r, i, sa->base.x, sa->base.y + top - sa->scroll_y, row_w, h,
+                 sa->row_user_data);
+  }
+
+  SDL_SetRenderClipRect(r, &saved_clip);
+  if (!clipping) SDL_SetRenderClipRect(r, NULL);
+}
+
 void civ_scroll_area_update(civ_scroll_area_t *sa, civ_input_state_t *input,
                             float dt) {
   if (!sa || !input || !sa->base.visible) return;
@@ -89,7 +244,9 @@ void civ_scroll_area_update(civ_scroll_area_t *sa, civ_input_state_t *input,
 
   /* Smooth scroll */
   float lerp = 1.0f - expf(-12.0f * dt);
-  sa->scroll_y += (sa->target_scroll_y - sa->scroll_y) * lerp;
+  float step = (sa->target_scroll_y - sa->scroll_y) * lerp;
+  sa->scroll_y += step;
+  if (fabsf(step) > 0.01f) civ_widget_invalidate(&sa->base);
 
   /* Scrollbar drag */
   float sb_x = sa->base.x + sa->base.w - (float)sa->scrollbar_w;
@@ -126,6 +283,7 @@ void civ_scroll_area_render(civ_scroll_area_t *sa, SDL_Renderer *r) {
   int w = (int)sa->base.w, h = (int)sa->base.h;
 
   civ_render_rect_filled(r, x, y, w, h, sa->color_bg);
+  if (sa->row_count >= 0) rows_render(sa, r);
 
   /* Scrollbar */
   if (sa->content_h > h) {
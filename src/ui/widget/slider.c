@@ -25,6 +25,7 @@ void civ_slider_set_value(civ_slider_t *s, float value) {
   s->value = value;
   if (s->value < s->min) s->value = s->min;
   if (s->value > s->max) s->value = s->max;
+  civ_widget_invalidate(&s->base);
 }
 
 float civ_slider_get_value(const civ_slider_t *s) {
@@ -50,7 +51,9 @@ void civ_slider_update(civ_slider_t *s, civ_input_state_t *input, float dt) {
       }
       if (ratio < 0.0f) ratio = 0.0f;
       if (ratio > 1.0f) ratio = 1.0f;
-      s->value = s->min + (s->max - s->min) * ratio;
+      float value = s->min + (s->max - s->min) * ratio;
+      if (value != s->value) civ_widget_invalidate(&s->base);
+      s->value = value;
     } else {
       s->dragging = false;
     }
@@ -23,11 +23,14 @@ void civ_tab_bar_add_tab(civ_tab_bar_t *tb, const char *label) {
   if (!tb || !label || tb->tab_count >= CIV_TAB_BAR_MAX_TABS) return;
   strncpy(tb->labels[tb->tab_count], label, CIV_TAB_LABEL_LEN - 1);
   tb->tab_count++;
+  civ_widget_invalidate(&tb->base);
 }
 
 void civ_tab_bar_set_active(civ_tab_bar_t *tb, int index) {
   if (!tb || index < 0 || index >= tb->tab_count) return;
+  if (tb->active_tab == index) return;
   tb->active_tab = index;
+  civ_widget_invalidate(&tb->base);
 }
 
 int civ_tab_bar_get_active(const civ_tab_bar_t *tb) {
@@ -50,7 +53,7 @@ void civ_tab_bar_update(civ_tab_bar_t *tb, civ_input_state_t *input, float dt) {
       float tx = tb->base.x + (float)i * tb->tab_width;
       if (pt_in((float)input->mouse_x, (float)input->mouse_y,
                 tx, tb->base.y, tb->tab_width, tb->base.h)) {
-        tb->active_tab = i;
+        civ_tab_bar_set_active(tb, i);
         break;
       }
     }
@@ -25,6 +25,7 @@ void civ_toggle_set_value(civ_toggle_t *t, bool value) {
   t->value = value;
   civ_tween_start(&t->thumb_tween, CIV_TWEEN_SLIDE_RIGHT, 0.15f,
                   value ? 0.0f : 1.0f, value ? 1.0f : 0.0f);
+  civ_widget_invalidate(&t->base);
 }
 
 bool civ_toggle_get_value(const civ_toggle_t *t) {
@@ -33,10 +34,11 @@ bool civ_toggle_get_value(const civ_toggle_t *t) {
 
 void civ_toggle_update(civ_toggle_t *t, civ_input_state_t *input, float dt) {
   if (!t || !input) return;
-  t->base.state = civ_widget_compute_state(&t->base, input, true);
+  civ_widget_set_state(&t->base, civ_widget_compute_state(&t->base, input, true));
   if (t->base.state == CIV_WIDGET_PRESSED) {
     civ_toggle_set_value(t, !t->value);
   }
+  if (t->thumb_tween.active) civ_widget_invalidate(&t->base);
   civ_tween_update(&t->thumb_tween, dt);
 }
 
@@ -28,35 +28,58 @@ void civ_tooltip_clear(civ_tooltip_t *t) {
   t->line_count = 0;
 }
 
+/* Claim the next line, keeping what was there from the last build so the
+ * builder can tell whether it changed */
+static civ_tooltip_line_t *tooltip_next_line(civ_tooltip_t *t,
+                                             civ_tooltip_line_t *was) {
+  civ_tooltip_line_t *l = &t->lines[t->line_count++];
+  *was = *l;
+  return l;
+}
+
+static void tooltip_line_done(civ_tooltip_t *t, const civ_tooltip_line_t *l,
+                              const civ_tooltip_line_t *was) {
+  if (l->color != was->color || l->is_header != was->is_header ||
+      l->separator_before != was->separator_before ||
+      strcmp(l->text, was->text) != 0)
+    t->generation++;
+}
+
 civ_tooltip_t *civ_tooltip_add_header(civ_tooltip_t *t, const char *text,
                                       uint32_t color) {
   if (!t || t->line_count >= CIV_TOOLTIP_LINES_MAX) return t;
-  civ_tooltip_line_t *l = &t->lines[t->line_count++];
+  civ_tooltip_line_t was;
+  civ_tooltip_line_t *l = tooltip_next_line(t, &was);
   snprintf(l->text, CIV_TOOLTIP_LINE_LEN, "%s", text ? text : "");
   l->color = color ? color : g_theme.text_primary;
   l->is_header = true;
   l->separator_before = false;
+  tooltip_line_done(t, l, &was);
   return t;
 }
 
 civ_tooltip_t *civ_tooltip_add_line(civ_tooltip_t *t, const char *text,
                                     uint32_t color) {
   if (!t || t->line_count >= CIV_TOOLTIP_LINES_MAX) return t;
-  civ_tooltip_line_t *l = &t->lines[t->line_count++];
+  civ_tooltip_line_t was;
+  civ_tooltip_line_t *l = tooltip_next_line(t, &was);
   snprintf(l->text, CIV_TOOLTIP_LINE_LEN, "  %s", text ? text : "");
   l->color = color ? color : g_theme.text_secondary;
   l->is_header = false;
   l->separator_before = false;
+  tooltip_line_done(t, l, &was);
   return t;
 }
 
 civ_tooltip_t *civ_tooltip_add_separator(civ_tooltip_t *t) {
   if (!t || t->line_count >= CIV_TOOLTIP_LINES_MAX) return t;
-  civ_tooltip_line_t *l = &t->lines[t->line_count++];
+  civ_tooltip_line_t was;
+  civ_tooltip_line_t *l = tooltip_next_line(t, &was);
   l->text[0] = '\0';
   l->color = 0x1A2A3A;
   l->is_header = false;
   l->separator_before = true;
+  tooltip_line_done(t, l, &was);
   return t;
 }
 
@@ -65,25 +88,29 @@ civ_tooltip_t *civ_tooltip_add_key_value(civ_tooltip_t *t, const char *key,
                                           uint32_t key_color,
                                           uint32_t val_color) {
   if (!t || t->line_count >= CIV_TOOLTIP_LINES_MAX) return t;
-  civ_tooltip_line_t *l = &t->lines[t->line_count++];
+  civ_tooltip_line_t was;
+  civ_tooltip_line_t *l = tooltip_next_line(t, &was);
   snprintf(l->text, CIV_TOOLTIP_LINE_LEN, "%-24s %s", key ? key : "",
            value ? value : "");
   l->color = 0; /* Special: render as two colors (key + value) */
   l->is_header = false;
   l->separator_before = false;
   (void)key_color; (void)val_color;
+  tooltip_line_done(t, l, &was);
   return t;
 }
 
 civ_tooltip_t *civ_tooltip_add_bar(civ_tooltip_t *t, const char *label,
                                     float value, uint32_t bar_color) {
   if (!t || t->line_count >= CIV_TOOLTIP_LINES_MAX) return t;
-  civ_tooltip_line_t *l = &t->lines[t->line_count++];
+  civ_tooltip_line_t was;
+  civ_tooltip_line_t *l = tooltip_next_line(t, &was);
   snprintf(l->text, CIV_TOOLTIP_LINE_LEN, "BAR:%.2f:%s",
            value, label ? label : "");
   l->color = bar_color ? bar_color : g_theme.primary;
   l->is_header = false;
   l->separator_before = false;
+  tooltip_line_done(t, l, &was);
   return t;
 }
 
@@ -100,6 +127,27 @@ void civ_tooltip_hide(civ_tooltip_t *t) {
   t->target_alpha = 0.0f;
 }
 
+/* Widest line, with the font of the last render or estimated before one */
+static void tooltip_measure(civ_tooltip_t *t) {
+  float max_w = 0.0f;
+  for (int i = 0; i < t->line_count; i++) {
+    float lw;
+    if (t->font) {
+      int tw = 0, th = 0;
+      civ_font_get_text_size(t->font, t->lines[i].text, &tw, &th);
+      lw = (float)tw;
+    } else {
+      lw = (float)strlen(t->lines[i].text) * ((float)t->font_size * 0.55f);
+    }
+    if (lw > max_w) max_w = lw;
+  }
+  t->measured_w = max_w;
+  t->measured_generation = t->generation;
+  t->measured_count = t->line_count;
+  t->measured_font = t->font;
+  t->measured = true;
+}
+
 void civ_tooltip_update(civ_tooltip_t *t, civ_input_state_t *input, float dt,
                         int win_w, int win_h) {
   if (!t) return;
@@ -124,12 +172,10 @@ void civ_tooltip_update(civ_tooltip_t *t, civ_input_state_t *input, float dt,
 
   /* Compute size from content */
   float h = t->pad * 2.0f + (float)t->line_count * t->line_height;
-  float max_w = 0.0f;
-  for (int i = 0; i < t->line_count; i++) {
-    float lw = (float)strlen(t->lines[i].text) * ((float)t->font_size * 0.55f);
-    if (lw > max_w) max_w = lw;
-  }
-  float w = max_w + t->pad * 2.0f;
+  if (!t->measured || t->measured_generation != t->generation ||
+      t->measured_count != t->line_count || t->measured_font != t->font)
+    tooltip_measure(t);
+  float w = t->measured_w + t->pad * 2.0f;
   if (w < 180.0f) w = 180.0f;
   if (w > 400.0f) w = 400.0f;
 
@@ -151,6 +197,7 @@ void civ_tooltip_update(civ_tooltip_t *t, civ_input_state_t *input, float dt,
 
 void civ_tooltip_render(civ_tooltip_t *t, SDL_Renderer *r, civ_font_t *font) {
   if (!t || !r || !t->base.visible) return;
+  t->font = font;
 
   float alpha = civ_tween_value(&t->fade);
   if (alpha < 0.02f) return;
@@ -15,6 +15,7 @@ void civ_widget_init(civ_widget_base_t *widget, civ_widget_type_t type,
   widget->visible = true;
   widget->enabled = true;
   widget->state = CIV_WIDGET_NORMAL;
+  widget->dirty = true;
 }
 
 void civ_widget_add_child(civ_widget_base_t *parent, civ_widget_base_t *child) {
@@ -29,6 +30,24 @@ void civ_widget_add_child(civ_widget_base_t *parent, civ_widget_base_t *child) {
   }
   parent->children[parent->child_count++] = child;
   child->parent = parent;
+  civ_widget_invalidate(parent);
+}
+
+void civ_widget_invalidate(civ_widget_base_t *w) {
+  /* An ancestor already dirty has the rest of the chain dirty too */
+  for (; w && !w->dirty; w = w->parent) w->dirty = true;
+}
+
+void civ_widget_clean(civ_widget_base_t *w) {
+  if (!w || !w->dirty) return;
+  w->dirty = false;
+  for (int i = 0; i < w->child_count; i++) civ_widget_clean(w->children[i]);
+}
+
+void civ_widget_set_state(civ_widget_base_t *w, civ_widget_state_t state) {
+  if (!w || w->state == state) return;
+  w->state = state;
+  civ_widget_invalidate(w);
 }
 
 void civ_widget_destroy_children(civ_widget_base_t *w) {
@@ -45,6 +64,7 @@ void civ_widget_destroy_children(civ_widget_base_t *w) {
 
 bool civ_widget_is_hovered(const civ_widget_base_t *w, civ_input_state_t *input) {
   if (!w || !w->visible || !input) return false;
+  if (input->hit_routed && input->hit_top != input->hit_layer) return false;
   return input->mouse_x >= (int)w->x && input->mouse_x <= (int)(w->x + w->w) &&
          input->mouse_y >= (int)w->y && input->mouse_y <= (int)(w->y + w->h);
 }
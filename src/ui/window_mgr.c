@@ -5,6 +5,8 @@
 #include "ui/window_mgr.h"
 #include "display/theme.h"
 #include "engine/renderer.h"
+#include "ui/hit_grid.h"
+#include "utils/frame_trace.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -61,6 +63,7 @@ int civ_window_mgr_add(civ_window_mgr_t *mgr, civ_window_type_t type,
 
 void civ_window_mgr_remove(civ_window_mgr_t *mgr, int idx) {
   if (!mgr || idx < 0 || idx >= mgr->count) return;
+  if (mgr->windows[idx].cache) SDL_DestroyTexture(mgr->windows[idx].cache);
   /* Shift remaining windows down */
   for (int i = idx; i < mgr->count - 1; i++)
     mgr->windows[i] = mgr->windows[i + 1];
@@ -70,6 +73,31 @@ void civ_window_mgr_remove(civ_window_mgr_t *mgr, int idx) {
 void civ_window_mgr_show(civ_window_mgr_t *mgr, int idx, bool show) {
   if (!mgr || idx < 0 || idx >= mgr->count) return;
   mgr->windows[idx].visible = show;
+  mgr->windows[idx].dirty = true;
+}
+
+void civ_window_mgr_shutdown(civ_window_mgr_t *mgr) {
+  if (!mgr) return;
+  for (int i = 0; i < mgr->count; i++) {
+    if (mgr->windows[i].cache) SDL_DestroyTexture(mgr->windows[i].cache);
+    mgr->windows[i].cache = NULL;
+  }
+}
+
+void civ_window_mgr_set_retained(civ_window_mgr_t *mgr, int idx, bool retained) {
+  if (!mgr || idx < 0 || idx >= mgr->count) return;
+  civ_ui_window_t *win = &mgr->windows[idx];
+  win->retained = retained;
+  win->dirty = true;
+  if (!retained && win->cache) {
+    SDL_DestroyTexture(win->cache);
+    win->cache = NULL;
+  }
+}
+
+void civ_window_mgr_invalidate(civ_window_mgr_t *mgr, int idx) {
+  if (!mgr || idx < 0 || idx >= mgr->count) return;
+  mgr->windows[idx].dirty = true;
 }
 
 /* ── Chrome rendering ───────────────────────────────────────────────── */
@@ -112,8 +140,18 @@ bool civ_window_mgr_input(civ_window_mgr_t *mgr, civ_input_state_t *input) {
     civ_ui_window_t *win = &mgr->windows[i];
     if (!win->visible) continue;
 
-    /* Check if click is in this window */
-    bool in_win = civ_input_is_mouse_over(input, win->x, win->y, win->w, win->h);
+    /* Routed input names the window that owns the mouse; before the first
+       drawn frame, test the rect */
+    bool in_win = input->hit_routed
+        ? input->hit_top == win
+        : civ_input_is_mouse_over(input, win->x, win->y, win->w, win->h);
+
+    /* Hover and clicks may change how a retained window draws */
+    if (win->retained && in_win && !win->dragging &&
+        (input->mouse_x != input->last_mouse_x ||
+         input->mouse_y != input->last_mouse_y || input->mouse_left_pressed ||
+         input->mouse_left_released || input->scroll_delta != 0.0f))
+      win->dirty = true;
 
     /* Close button click */
     if (win->closable && in_win && input->mouse_left_pressed) {
@@ -149,8 +187,15 @@ bool civ_window_mgr_input(civ_window_mgr_t *mgr, civ_input_state_t *input) {
 
     /* Delegate to window's input handler if click is inside */
     if (in_win && win->handle_input) {
-      if (win->handle_input(win->x, win->y, win->w, win->h, win->userdata, input))
+      const void *layer = input->hit_layer;
+      input->hit_layer = win;
+      bool handled =
+          win->handle_input(win->x, win->y, win->w, win->h, win->userdata, input);
+      input->hit_layer = layer;
+      if (handled) {
+        win->dirty = true;
         return true;
+      }
     }
 
     /* If click is in this window, stop propagating (for overlays) */
@@ -162,6 +207,52 @@ bool civ_window_mgr_input(civ_window_mgr_t *mgr, civ_input_state_t *input) {
 }
 
 /* ── Render ──────────────────────────────────────────────────────────── */
+
+/* Chrome and content at the window's origin, into r's current target */
+static void render_window(SDL_Renderer *r, civ_ui_window_t *win, int x, int y,
+                          civ_font_t *font) {
+  /* Render chrome for non-fullscreen windows */
+  if (win->type != CIV_WIN_FULLSCREEN && win->type != CIV_WIN_HUD) {
+    civ_ui_window_t at = *win;
+    at.x = x;
+    at.y = y;
+    civ_window_render_chrome(r, &at, font);
+  }
+
+  /* Call the window's render callback */
+  if (win->render)
+    win->render(r, x, y, win->w, win->h, win->userdata, NULL);
+}
+
+/* Re-render a retained window's cache if needed; false if it has none */
+static bool refresh_cache(SDL_Renderer *r, civ_ui_window_t *win,
+                          civ_font_t *font) {
+  if (win->w <= 0 || win->h <= 0) return false;
+  if (!win->cache || win->cache_w != win->w || win->cache_h != win->h) {
+    if (win->cache) SDL_DestroyTexture(win->cache);
+    win->cache = civ_create_texture(r, SDL_PIXELFORMAT_ARGB8888,
+                                   SDL_TEXTUREACCESS_TARGET, win->w, win->h);
+    if (!win->cache) return false;
+    /* Drawn with blending onto clear, so the texels are premultiplied */
+    SDL_SetTextureBlendMode(win->cache, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+    win->cache_w = win->w;
+    win->cache_h = win->h;
+    win->dirty = true;
+  }
+  if (!win->dirty) return true;
+
+  civ_render_flush_batch();
+  SDL_Texture *prev = SDL_GetRenderTarget(r);
+  SDL_SetRenderTarget(r, win->cache);
+  SDL_SetRenderDrawColor(r, 0, 0, 0, 0);
+  SDL_RenderClear(r);
+  render_window(r, win, 0, 0, font);
+  civ_render_flush_batch();
+  SDL_SetRenderTarget(r, prev);
+  win->dirty = false;
+  return true;
+}
+
 void civ_window_mgr_render(civ_window_mgr_t *mgr, SDL_Renderer *r,
                            civ_font_t *font) {
   if (!mgr || !r) return;
@@ -170,13 +261,13 @@ void civ_window_mgr_render(civ_window_mgr_t *mgr, SDL_Renderer *r,
   for (int i = 0; i < mgr->count; i++) {
     civ_ui_window_t *win = &mgr->windows[i];
     if (!win->visible) continue;
+    civ_hit_grid_add(&g_ui_hits, win, win->x, win->y, win->w, win->h);
 
-    /* Render chrome for non-fullscreen windows */
-    if (win->type != CIV_WIN_FULLSCREEN && win->type != CIV_WIN_HUD)
-      civ_window_render_chrome(r, win, font);
-
-    /* Call the window's render callback */
-    if (win->render)
-      win->render(r, win->x, win->y, win->w, win->h, win->userdata, NULL);
+    if (win->retained && refresh_cache(r, win, font)) {
+      SDL_FRect dst = {(float)win->x, (float)win->y, (float)win->w, (float)win->h};
+      SDL_RenderTexture(r, win->cache, NULL, &dst);
+      continue;
+    }
+    render_window(r, win, win->x, win->y, font);
   }
 }
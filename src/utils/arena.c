@@ -0,0 +1,100 @@
+/**
+ * @file arena.c
+ * @brief Implementation of the bump-pointer arena
+ */
+
+#include "utils/arena.h"
+#include "common.h"
+#include <stdlib.h>
+#include <string.h>
+
+struct civ_arena_chunk {
+    civ_arena_chunk_t* next;    /* older chunk */
+    size_t size;                /* data bytes */
+    size_t offset;              /* bytes handed out */
+};
+
+#define ALIGN_UP(n) (((n) + CIV_ARENA_ALIGN - 1) & ~(size_t)(CIV_ARENA_ALIGN - 1))
+#define CHUNK_HEADER ALIGN_UP(sizeof(civ_arena_chunk_t))
+
+static char* chunk_data(civ_arena_chunk_t* chunk) {
+    return (char*)chunk + CHUNK_HEADER;
+}
+
+static civ_arena_chunk_t* add_chunk(civ_arena_t* arena, size_t size) {
+    civ_arena_chunk_t* chunk = (civ_arena_chunk_t*)CIV_MALLOC(CHUNK_HEADER + size);
+    if (!chunk) return NULL;
+    chunk->next = arena->head;
+    chunk->size = size;
+    chunk->offset = 0;
+    arena->head = chunk;
+    arena->capacity += size;
+    return chunk;
+}
+
+static void free_chunks(civ_arena_t* arena) {
+    civ_arena_chunk_t* chunk = arena->head;
+    while (chunk) {
+        civ_arena_chunk_t* next = chunk->next;
+        CIV_FREE(chunk);
+        chunk = next;
+    }
+    arena->head = NULL;
+    arena->capacity = 0;
+}
+
+civ_arena_t* civ_arena_create(size_t chunk_size) {
+    civ_arena_t* arena = (civ_arena_t*)CIV_CALLOC(1, sizeof(civ_arena_t));
+    if (!arena) {
+        civ_log(CIV_LOG_ERROR, "Failed to allocate arena");
+        return NULL;
+    }
+    arena->chunk_size = ALIGN_UP(chunk_size > 0 ? chunk_size : 64 * 1024);
+    if (!add_chunk(arena, arena->chunk_size)) {
+        CIV_FREE(arena);
+        return NULL;
+    }
+    return arena;
+}
+
+void civ_arena_destroy(civ_arena_t* arena) {
+    if (!arena) return;
+    free_chunks(arena);
+    CIV_FREE(arena);
+}
+
+void* civ_arena_push(civ_arena_t* arena, size_t size) {
+    if (!arena) return NULL;
+    size = ALIGN_UP(size ? size : 1);
+
+    civ_arena_chunk_t* chunk = arena->head;
+    if (!chunk || chunk->size - chunk->offset < size) {
+        chunk = add_chunk(arena, MAX(arena->chunk_size, size));
+        if (!chunk) return NULL;
+    }
+    void* p = chunk_data(chunk) + chunk->offset;
+    chunk->offset += size;
+    arena->used += size;
+    civ_mem_note_arena(size);
+    return p;
+}
+
+void* civ_arena_push_zero(civ_arena_t* arena, size_t size) {
+    void* p = civ_arena_push(arena, size);
+    if (p) memset(p, 0, size);
+    return p;
+}
+
+void civ_arena_reset(civ_arena_t* arena) {
+    if (!arena) return;
+    arena->peak = MAX(arena->peak, arena->used);
+    arena->used = 0;
+
+    /* Spilled into more chunks: replace them with one that fits the peak */
+    if (arena->head && arena->head->next) {
+        size_t size = arena->capacity;
+        free_chunks(arena);
+        add_chunk(arena, size);
+    }
+    if (arena->head) arena->head->offset = 0;
+}
@@ -24,9 +24,24 @@ void civ_cache_destroy(civ_cache_t* cache) {
     if (!cache) return;
     
     civ_cache_clear(cache);
+    CIV_FREE(cache->entries);
+    CIV_FREE(cache->slots);
     CIV_FREE(cache);
 }
 
+/* Every entry unused, chained through next */
+static void reset_entries(civ_cache_t* cache) {
+    for (size_t i = 0; i < cache->max_entries; i++) {
+        cache->entries[i].data = NULL;
+        cache->entries[i].next = i + 1 < cache->max_entries ? (uint32_t)(i + 1) : CIV_CACHE_NONE;
+    }
+    cache->free_head = cache->max_entries ? 0 : CIV_CACHE_NONE;
+    cache->lru_head = cache->lru_tail = CIV_CACHE_NONE;
+    if (cache->slots) memset(cache->slots, 0, cache->slot_count * sizeof(uint32_t));
+    cache->entry_count = 0;
+    cache->current_size = 0;
+}
+
 void civ_cache_init(civ_cache_t* cache, size_t max_entries, size_t max_size, time_t default_ttl) {
     if (!cache) return;
     
@@ -34,6 +49,115 @@ void civ_cache_init(civ_cache_t* cache, size_t max_entries, size_t max_size, tim
     cache->max_entries = max_entries > 0 ? max_entries : 1000;
     cache->max_size = max_size > 0 ? max_size : 10 * 1024 * 1024;  /* 10MB default */
     cache->default_ttl = default_ttl > 0 ? default_ttl : 3600;  /* 1 hour default */
+
+    cache->slot_count = 16;
+    while (cache->slot_count < cache->max_entries * 2) cache->slot_count *= 2;
+    cache->entries = (civ_cache_entry_t*)CIV_CALLOC(cache->max_entries, sizeof(civ_cache_entry_t));
+    cache->slots = (uint32_t*)CIV_CALLOC(cache->slot_count, sizeof(uint32_t));
+    if (!cache->entries || !cache->slots) {
+        civ_log(CIV_LOG_ERROR, "Failed to allocate cache table");
+        CIV_FREE(cache->entries);
+        CIV_FREE(cache->slots);
+        cache->entries = NULL;
+        cache->slots = NULL;
+        cache->slot_count = 0;
+        cache->max_entries = 0;
+    }
+    reset_entries(cache);
+}
+
+/* FNV-1a over the part of the key an entry can hold */
+static uint32_t key_hash(const char* key, size_t* len) {
+    uint32_t h = 2166136261u;
+    size_t n = 0;
+    while (key[n] && n < STRING_SHORT_LEN - 1) {
+        h ^= (uint8_t)key[n++];
+        h *= 16777619u;
+    }
+    *len = n;
+    return h;
+}
+
+/* Table position holding key, or slot_count when absent */
+static size_t find_slot(const civ_cache_t* cache, const char* key, uint32_t hash, size_t len) {
+    if (cache->slot_count == 0) return 0;
+    size_t mask = cache->slot_count - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        uint32_t slot = cache->slots[i];
+        if (slot == 0) return cache->slot_count;
+        const civ_cache_entry_t* e = &cache->entries[slot - 1];
+        if (e->hash == hash && strncmp(e->key, key, len) == 0 && e->key[len] == '\0')
+            return i;
+    }
+}
+
+/* Table position of a live entry */
+static size_t slot_of(const civ_cache_t* cache, uint32_t index) {
+    size_t mask = cache->slot_count - 1;
+    size_t i = cache->entries[index].hash & mask;
+    while (cache->slots[i] != index + 1) i = (i + 1) & mask;
+    return i;
+}
+
+/* Empty position i and shift later members of its probe run back, so
+   lookups never need tombstones */
+static void clear_slot(civ_cache_t* cache, size_t i) {
+    size_t mask = cache->slot_count - 1;
+    for (size_t j = (i + 1) & mask; cache->slots[j] != 0; j = (j + 1) & mask) {
+        size_t home = cache->entries[cache->slots[j] - 1].hash & mask;
+        /* Entry at j may move to i only if its home is not in (i, j] */
+        bool stays = i <= j ? (home > i && home <= j) : (home > i || home <= j);
+        if (!stays) {
+            cache->slots[i] = cache->slots[j];
+            i = j;
+        }
+    }
+    cache->slots[i] = 0;
+}
+
+static void lru_unlink(civ_cache_t* cache, uint32_t index) {
+    civ_cache_entry_t* e = &cache->entries[index];
+    if (e->prev != CIV_CACHE_NONE) cache->entries[e->prev].next = e->next;
+    else cache->lru_head = e->next;
+    if (e->next != CIV_CACHE_NONE) cache->entries[e->next].prev = e->prev;
+    else cache->lru_tail = e->prev;
+}
+
+static void lru_push_front(civ_cache_t* cache, uint32_t index) {
+    civ_cache_entry_t* e = &cache->entries[index];
+    e->prev = CIV_CACHE_NONE;
+    e->next = cache->lru_head;
+    if (cache->lru_head != CIV_CACHE_NONE) cache->entries[cache->lru_head].prev = index;
+    else cache->lru_tail = index;
+    cache->lru_head = index;
+}
+
+static void touch(civ_cache_t* cache, uint32_t index) {
+    if (cache->lru_head == index) return;
+    lru_unlink(cache, index);
+    lru_push_front(cache, index);
+}
+
+static void drop_entry(civ_cache_t* cache, size_t slot) {
+    uint32_t index = cache->slots[slot] - 1;
+    civ_cache_entry_t* e = &cache->entries[index];
+    clear_slot(cache, slot);
+    lru_unlink(cache, index);
+    cache->current_size -= e->data_size;
+    cache->entry_count--;
+    CIV_FREE(e->data);
+    e->data = NULL;
+    e->next = cache->free_head;
+    cache->free_head = index;
+}
+
+static void evict_lru(civ_cache_t* cache) {
+    drop_entry(cache, slot_of(cache, cache->lru_tail));
+    cache->evictions++;
+}
+
+static time_t expiry_for(const civ_cache_t* cache, time_t now, time_t ttl) {
+    return now + (ttl > 0 ? ttl : cache->default_ttl);
 }
 
 civ_result_t civ_cache_set(civ_cache_t* cache, const char* key, const void* data, size_t data_size, time_t ttl) {
@@ -43,82 +167,108 @@ civ_result_t civ_cache_set(civ_cache_t* cache, const char* key, const void* data
         result.error = CIV_ERROR_NULL_POINTER;
         return result;
     }
+    if (cache->max_entries == 0 || data_size > cache->max_size) {
+        result.error = CIV_ERROR_OUT_OF_MEMORY;
+        result.message = "Cache size limit exceeded";
+        return result;
+    }
     
-    /* Check if entry exists */
-    civ_cache_entry_t* entry = cache->entries;
-    civ_cache_entry_t* prev = NULL;
-    
-    while (entry) {
-        if (strcmp(entry->key, key) == 0) {
-            /* Update existing entry */
-            if (entry->data_size != data_size) {
-                CIV_FREE(entry->data);
-                entry->data = CIV_MALLOC(data_size);
-                if (!entry->data) {
-                    result.error = CIV_ERROR_OUT_OF_MEMORY;
-                    return result;
-                }
+    size_t len;
+    uint32_t hash = key_hash(key, &len);
+    size_t slot = find_slot(cache, key, hash, len);
+    time_t now = time(NULL);
+    
+    if (slot < cache->slot_count) {
+        /* Update existing entry; older entries make room for any growth */
+        uint32_t index = cache->slots[slot] - 1;
+        civ_cache_entry_t* entry = &cache->entries[index];
+        touch(cache, index);
+        while (cache->current_size - entry->data_size + data_size > cache->max_size &&
+               cache->lru_tail != index)
+            evict_lru(cache);
+        if (entry->data_size != data_size) {
+            void* grown = CIV_MALLOC(data_size ? data_size : 1);
+            if (!grown) {
+                result.error = CIV_ERROR_OUT_OF_MEMORY;
+                return result;
             }
-            memcpy(entry->data, data, data_size);
+            CIV_FREE(entry->data);
+            entry->data = grown;
+            cache->current_size = cache->current_size - entry->data_size + data_size;
             entry->data_size = data_size;
-            entry->timestamp = time(NULL);
-            entry->expiry = entry->timestamp + (ttl > 0 ? ttl : cache->default_ttl);
-            return result;
         }
-        prev = entry;
-        entry = entry->next;
+        memcpy(entry->data, data, data_size);
+        entry->timestamp = now;
+        entry->expiry = expiry_for(cache, now, ttl);
+        return result;
     }
     
     /* Check limits */
-    if (cache->entry_count >= cache->max_entries) {
-        /* Remove oldest entry */
-        civ_cache_cleanup_expired(cache);
-        if (cache->entry_count >= cache->max_entries && cache->entries) {
-            /* Remove first entry */
-            civ_cache_entry_t* oldest = cache->entries;
-            cache->entries = oldest->next;
-            cache->current_size -= oldest->data_size;
-            CIV_FREE(oldest->data);
-            CIV_FREE(oldest);
-            cache->entry_count--;
-        }
-    }
+    while (cache->entry_count >= cache->max_entries ||
+           cache->current_size + data_size > cache->max_size)
+        evict_lru(cache);
     
-    if (cache->current_size + data_size > cache->max_size) {
+    void* copy = CIV_MALLOC(data_size ? data_size : 1);
+    if (!copy) {
         result.error = CIV_ERROR_OUT_OF_MEMORY;
-        result.message = "Cache size limit exceeded";
         return result;
     }
+    memcpy(copy, data, data_size);
     
     /* Create new entry */
-    entry = (civ_cache_entry_t*)CIV_MALLOC(sizeof(civ_cache_entry_t));
-    if (!entry) {
-        result.error = CIV_ERROR_OUT_OF_MEMORY;
-        return result;
-    }
-    
+    uint32_t index = cache->free_head;
+    civ_cache_entry_t* entry = &cache->entries[index];
+    cache->free_head = entry->next;
     memset(entry, 0, sizeof(civ_cache_entry_t));
-    strncpy(entry->key, key, sizeof(entry->key) - 1);
-    entry->data = CIV_MALLOC(data_size);
-    if (!entry->data) {
-        CIV_FREE(entry);
-        result.error = CIV_ERROR_OUT_OF_MEMORY;
-        return result;
-    }
-    
-    memcpy(entry->data, data, data_size);
+    memcpy(entry->key, key, len);
+    entry->hash = hash;
+    entry->data = copy;
     entry->data_size = data_size;
-    entry->timestamp = time(NULL);
-    entry->expiry = entry->timestamp + (ttl > 0 ? ttl : cache->default_ttl);
+    entry->timestamp = now;
+    entry->expiry = expiry_for(cache, now, ttl);
     
-    entry->next = cache->entries;
-    cache->entries = entry;
+    size_t mask = cache->slot_count - 1;
+    size_t i = hash & mask;
+    while (cache->slots[i] != 0) i = (i + 1) & mask;
+    cache->slots[i] = index + 1;
+    lru_push_front(cache, index);
     cache->entry_count++;
     cache->current_size += data_size;
     
     return result;
 }
 
+/* Live entry for key, dropping it if expired; counts nothing */
+static civ_cache_entry_t* lookup(civ_cache_t* cache, const char* key) {
+    size_t len;
+    uint32_t hash = key_hash(key, &len);
+    size_t slot = find_slot(cache, key, hash, len);
+    if (slot >= cache->slot_count) return NULL;
+    
+    uint32_t index = cache->slots[slot] - 1;
+    civ_cache_entry_t* entry = &cache->entries[index];
+    /* Check if expired */
+    if (entry->expiry > 0 && time(NULL) > entry->expiry) {
+        drop_entry(cache, slot);
+        return NULL;
+    }
+    touch(cache, index);
+    return entry;
+}
+
+const void* civ_cache_peek(civ_cache_t* cache, const char* key, size_t* out_size) {
+    if (!cache || !key) return NULL;
+    
+    civ_cache_entry_t* entry = lookup(cache, key);
+    if (!entry) {
+        cache->misses++;
+        return NULL;
+    }
+    cache->hits++;
+    if (out_size) *out_size = entry->data_size;
+    return entry->data;
+}
+
 civ_result_t civ_cache_get(civ_cache_t* cache, const char* key, void* out, size_t* out_size) {
     civ_result_t result = {CIV_OK, NULL};
     
@@ -127,102 +277,50 @@ civ_result_t civ_cache_get(civ_cache_t* cache, const char* key, void* out, size_
         return result;
     }
     
-    time_t now = time(NULL);
-    civ_cache_entry_t* entry = cache->entries;
-    
-    while (entry) {
-        if (strcmp(entry->key, key) == 0) {
-            /* Check if expired */
-            if (entry->expiry > 0 && now > entry->expiry) {
-                result.error = CIV_ERROR_NOT_FOUND;
-                result.message = "Cache entry expired";
-                return result;
-            }
-            
-            if (*out_size < entry->data_size) {
-                result.error = CIV_ERROR_INVALID_ARGUMENT;
-                result.message = "Output buffer too small";
-                return result;
-            }
-            
-            memcpy(out, entry->data, entry->data_size);
-            *out_size = entry->data_size;
-            return result;
-        }
-        entry = entry->next;
+    size_t size = 0;
+    const void* data = civ_cache_peek(cache, key, &size);
+    if (!data) {
+        result.error = CIV_ERROR_NOT_FOUND;
+        return result;
+    }
+    if (*out_size < size) {
+        result.error = CIV_ERROR_INVALID_ARGUMENT;
+        result.message = "Output buffer too small";
+        return result;
     }
     
-    result.error = CIV_ERROR_NOT_FOUND;
+    memcpy(out, data, size);
+    *out_size = size;
     return result;
 }
 
 void civ_cache_remove(civ_cache_t* cache, const char* key) {
     if (!cache || !key) return;
     
-    civ_cache_entry_t* entry = cache->entries;
-    civ_cache_entry_t* prev = NULL;
-    
-    while (entry) {
-        if (strcmp(entry->key, key) == 0) {
-            if (prev) {
-                prev->next = entry->next;
-            } else {
-                cache->entries = entry->next;
-            }
-            
-            cache->current_size -= entry->data_size;
-            cache->entry_count--;
-            CIV_FREE(entry->data);
-            CIV_FREE(entry);
-            return;
-        }
-        prev = entry;
-        entry = entry->next;
-    }
+    size_t len;
+    uint32_t hash = key_hash(key, &len);
+    size_t slot = find_slot(cache, key, hash, len);
+    if (slot < cache->slot_count) drop_entry(cache, slot);
 }
 
 void civ_cache_clear(civ_cache_t* cache) {
-    if (!cache) return;
-    
-    civ_cache_entry_t* entry = cache->entries;
-    while (entry) {
-        civ_cache_entry_t* next = entry->next;
-        CIV_FREE(entry->data);
-        CIV_FREE(entry);
-        entry = next;
-    }
+    if (!cache || !cache->entries) return;
     
-    cache->entries = NULL;
-    cache->entry_count = 0;
-    cache->current_size = 0;
+    for (uint32_t i = cache->lru_head; i != CIV_CACHE_NONE; i = cache->entries[i].next)
+        CIV_FREE(cache->entries[i].data);
+    reset_entries(cache);
 }
 
 void civ_cache_cleanup_expired(civ_cache_t* cache) {
     if (!cache) return;
     
     time_t now = time(NULL);
-    civ_cache_entry_t* entry = cache->entries;
-    civ_cache_entry_t* prev = NULL;
-    
-    while (entry) {
-        if (entry->expiry > 0 && now > entry->expiry) {
-            /* Remove expired entry */
-            civ_cache_entry_t* next = entry->next;
-            if (prev) {
-                prev->next = next;
-            } else {
-                cache->entries = next;
-            }
-            
-            cache->current_size -= entry->data_size;
-            cache->entry_count--;
-            CIV_FREE(entry->data);
-            CIV_FREE(entry);
-            entry = next;
-        } else {
-            prev = entry;
-            entry = entry->next;
-        }
+    uint32_t i = cache->lru_head;
+    while (i != CIV_CACHE_NONE) {
+        uint32_t next = cache->entries[i].next;
+        if (cache->entries[i].expiry > 0 && now > cache->entries[i].expiry)
+            drop_entry(cache, slot_of(cache, i));
+        i = next;
     }
 }
 
@@ -231,3 +329,32 @@ size_t civ_cache_get_size(const civ_cache_t* cache) {
     return cache->current_size;
 }
 
+bool civ_cache_memo_get(civ_cache_t* cache, const char* key, uint64_t tick, void* out, size_t size) {
+    if (!cache || !key || !out) return false;
+    
+    civ_cache_entry_t* entry = lookup(cache, key);
+    uint64_t at = 0;
+    if (entry && entry->data_size == sizeof(at) + size) memcpy(&at, entry->data, sizeof(at));
+    if (!entry || entry->data_size != sizeof(at) + size || at != tick) {
+        cache->misses++;
+        return false;
+    }
+    cache->hits++;
+    memcpy(out, (const uint8_t*)entry->data + sizeof(at), size);
+    return true;
+}
+
+civ_result_t civ_cache_memo_put(civ_cache_t* cache, const char* key, uint64_t tick, const void* value, size_t size) {
+    if (!cache || !key || !value)
+        return (civ_result_t){CIV_ERROR_NULL_POINTER, NULL};
+    
+    uint8_t local[512];
+    size_t total = sizeof(tick) + size;
+    uint8_t* buf = total <= sizeof(local) ? local : (uint8_t*)CIV_MALLOC(total);
+    if (!buf) return (civ_result_t){CIV_ERROR_OUT_OF_MEMORY, NULL};
+    memcpy(buf, &tick, sizeof(tick));
+    memcpy(buf + sizeof(tick), value, size);
+    civ_result_t r = civ_cache_set(cache, key, buf, total, 0);
+    if (buf != local) CIV_FREE(buf);
+    return r;
+}
@@ -23,6 +23,8 @@ civ_config_manager_t* civ_config_manager_create(void) {
 void civ_config_manager_destroy(civ_config_manager_t* cm) {
     if (!cm) return;
     CIV_FREE(cm->entries);
+    CIV_FREE(cm->slots);
+    CIV_FREE(cm->listeners);
     CIV_FREE(cm);
 }
 
@@ -32,107 +34,168 @@ void civ_config_manager_init(civ_config_manager_t* cm) {
     memset(cm, 0, sizeof(civ_config_manager_t));
     cm->entry_capacity = 100;
     cm->entries = (civ_config_entry_t*)CIV_CALLOC(cm->entry_capacity, sizeof(civ_config_entry_t));
+    cm->slot_count = 256;
+    cm->slots = (uint32_t*)CIV_CALLOC(cm->slot_count, sizeof(uint32_t));
+    if (!cm->slots) cm->slot_count = 0;
 }
 
-static civ_config_entry_t* find_or_create_entry(civ_config_manager_t* cm, const char* key, civ_config_type_t type) {
-    if (!cm || !key) return NULL;
-    
-    /* Find existing entry */
-    for (size_t i = 0; i < cm->entry_count; i++) {
-        if (strcmp(cm->entries[i].key, key) == 0) {
-            cm->entries[i].type = type;
-            return &cm->entries[i];
-        }
+/* FNV-1a over the part of the key an entry can hold */
+static uint32_t key_hash(const char* key, size_t* len) {
+    uint32_t h = 2166136261u;
+    size_t n = 0;
+    while (key[n] && n < STRING_SHORT_LEN - 1) {
+        h ^= (uint8_t)key[n++];
+        h *= 16777619u;
     }
-    
-    /* Create new entry */
+    *len = n;
+    return h;
+}
+
+static bool key_matches(const civ_config_entry_t* e, const char* key, size_t len, uint32_t hash) {
+    return e->hash == hash && strncmp(e->key, key, len) == 0 && e->key[len] == '\0';
+}
+
+static civ_config_handle_t find_entry(const civ_config_manager_t* cm, const char* key) {
+    if (!cm || !key || cm->slot_count == 0) return CIV_CONFIG_HANDLE_INVALID;
+    size_t len;
+    uint32_t hash = key_hash(key, &len);
+    size_t mask = cm->slot_count - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        uint32_t slot = cm->slots[i];
+        if (slot == 0) return CIV_CONFIG_HANDLE_INVALID;
+        if (key_matches(&cm->entries[slot - 1], key, len, hash))
+            return (civ_config_handle_t)(slot - 1);
+    }
+}
+
+static void insert_slot(uint32_t* slots, size_t slot_count, uint32_t hash, uint32_t index) {
+    size_t mask = slot_count - 1;
+    size_t i = hash & mask;
+    while (slots[i] != 0) i = (i + 1) & mask;
+    slots[i] = index + 1;
+}
+
+/* Keep the table at most half full */
+static bool reserve_slots(civ_config_manager_t* cm, size_t entries) {
+    if (entries * 2 <= cm->slot_count) return true;
+    size_t count = cm->slot_count ? cm->slot_count : 256;
+    while (entries * 2 > count) count *= 2;
+    uint32_t* slots = (uint32_t*)CIV_CALLOC(count, sizeof(uint32_t));
+    if (!slots) return false;
+    for (size_t i = 0; i < cm->entry_count; i++)
+        insert_slot(slots, count, cm->entries[i].hash, (uint32_t)i);
+    CIV_FREE(cm->slots);
+    cm->slots = slots;
+    cm->slot_count = count;
+    return true;
+}
+
+static civ_config_handle_t create_entry(civ_config_manager_t* cm, const char* key) {
+    if (!reserve_slots(cm, cm->entry_count + 1)) return CIV_CONFIG_HANDLE_INVALID;
     if (cm->entry_count >= cm->entry_capacity) {
-        cm->entry_capacity *= 2;
-        cm->entries = (civ_config_entry_t*)CIV_REALLOC(cm->entries,
-                                                      cm->entry_capacity * sizeof(civ_config_entry_t));
+        size_t capacity = cm->entry_capacity ? cm->entry_capacity * 2 : 100;
+        civ_config_entry_t* grown = (civ_config_entry_t*)CIV_REALLOC(cm->entries,
+                                                      capacity * sizeof(civ_config_entry_t));
+        if (!grown) return CIV_CONFIG_HANDLE_INVALID;
+        cm->entries = grown;
+        cm->entry_capacity = capacity;
     }
     
-    if (cm->entries) {
-        civ_config_entry_t* entry = &cm->entries[cm->entry_count++];
-        memset(entry, 0, sizeof(civ_config_entry_t));
-        strncpy(entry->key, key, sizeof(entry->key) - 1);
-        entry->type = type;
-        return entry;
+    civ_config_entry_t* entry = &cm->entries[cm->entry_count];
+    memset(entry, 0, sizeof(civ_config_entry_t));
+    size_t len;
+    entry->hash = key_hash(key, &len);
+    memcpy(entry->key, key, len);
+    insert_slot(cm->slots, cm->slot_count, entry->hash, (uint32_t)cm->entry_count);
+    return (civ_config_handle_t)cm->entry_count++;
+}
+
+civ_config_handle_t civ_config_resolve(civ_config_manager_t* cm, const char* key) {
+    if (!cm || !key) return CIV_CONFIG_HANDLE_INVALID;
+    civ_config_handle_t h = find_entry(cm, key);
+    return h != CIV_CONFIG_HANDLE_INVALID ? h : create_entry(cm, key);
+}
+
+static civ_config_entry_t* find_or_create_entry(civ_config_manager_t* cm, const char* key, civ_config_handle_t* out) {
+    civ_config_handle_t h = civ_config_resolve(cm, key);
+    *out = h;
+    return h == CIV_CONFIG_HANDLE_INVALID ? NULL : &cm->entries[h];
+}
+
+static void notify(civ_config_manager_t* cm, civ_config_handle_t h) {
+    cm->entries[h].version++;
+    /* A listener may unsubscribe itself, so walk backwards */
+    for (size_t i = cm->listener_count; i-- > 0;) {
+        if (i >= cm->listener_count) continue;
+        civ_config_listener_t l = cm->listeners[i];
+        if (l.handle == CIV_CONFIG_HANDLE_INVALID || l.handle == h)
+            l.fn(cm, h, l.user_data);
     }
-    
-    return NULL;
 }
 
-civ_result_t civ_config_set_int(civ_config_manager_t* cm, const char* key, int32_t value) {
+/* Store a value of type; listeners run only when it changed */
+static civ_result_t store(civ_config_manager_t* cm, const char* key, civ_config_type_t type,
+                          const void* value, size_t size) {
     civ_result_t result = {CIV_OK, NULL};
-    
-    if (!cm || !key) {
-        result.error = CIV_ERROR_NULL_POINTER;
-        return result;
-    }
-    
-    civ_config_entry_t* entry = find_or_create_entry(cm, key, CIV_CONFIG_TYPE_INT);
-    if (entry) {
-        entry->value.int_value = value;
-    } else {
+    civ_config_handle_t h;
+    civ_config_entry_t* entry = find_or_create_entry(cm, key, &h);
+    if (!entry) {
         result.error = CIV_ERROR_OUT_OF_MEMORY;
+        return result;
     }
-    
+    bool changed = !entry->is_set || entry->type != type ||
+                   memcmp(&entry->value, value, size) != 0;
+    if (!changed) return result;
+    memset(&entry->value, 0, sizeof(entry->value));
+    memcpy(&entry->value, value, size);
+    entry->type = type;
+    entry->is_set = true;
+    notify(cm, h);
     return result;
 }
 
-civ_result_t civ_config_set_float(civ_config_manager_t* cm, const char* key, civ_float_t value) {
-    civ_result_t result = {CIV_OK, NULL};
-    
+civ_result_t civ_config_set_int(civ_config_manager_t* cm, const char* key, int32_t value) {
     if (!cm || !key) {
-        result.error = CIV_ERROR_NULL_POINTER;
+        civ_result_t result = {CIV_ERROR_NULL_POINTER, NULL};
         return result;
     }
-    
-    civ_config_entry_t* entry = find_or_create_entry(cm, key, CIV_CONFIG_TYPE_FLOAT);
-    if (entry) {
-        entry->value.float_value = value;
-    } else {
-        result.error = CIV_ERROR_OUT_OF_MEMORY;
+    return store(cm, key, CIV_CONFIG_TYPE_INT, &value, sizeof(value));
+}
+
+civ_result_t civ_config_set_float(civ_config_manager_t* cm, const char* key, civ_float_t value) {
+    if (!cm || !key) {
+        civ_result_t result = {CIV_ERROR_NULL_POINTER, NULL};
+        return result;
     }
-    
-    return result;
+    return store(cm, key, CIV_CONFIG_TYPE_FLOAT, &value, sizeof(value));
 }
 
 civ_result_t civ_config_set_bool(civ_config_manager_t* cm, const char* key, bool value) {
-    civ_result_t result = {CIV_OK, NULL};
-    
     if (!cm || !key) {
-        result.error = CIV_ERROR_NULL_POINTER;
+        civ_result_t result = {CIV_ERROR_NULL_POINTER, NULL};
         return result;
     }
-    
-    civ_config_entry_t* entry = find_or_create_entry(cm, key, CIV_CONFIG_TYPE_BOOL);
-    if (entry) {
-        entry->value.bool_value = value;
-    } else {
-        result.error = CIV_ERROR_OUT_OF_MEMORY;
-    }
-    
-    return result;
+    return store(cm, key, CIV_CONFIG_TYPE_BOOL, &value, sizeof(value));
 }
 
 civ_result_t civ_config_set_string(civ_config_manager_t* cm, const char* key, const char* value) {
-    civ_result_t result = {CIV_OK, NULL};
-    
     if (!cm || !key || !value) {
-        result.error = CIV_ERROR_NULL_POINTER;
+        civ_result_t result = {CIV_ERROR_NULL_POINTER, NULL};
         return result;
     }
-    
-    civ_config_entry_t* entry = find_or_create_entry(cm, key, CIV_CONFIG_TYPE_STRING);
-    if (entry) {
-        strncpy(entry->value.string_value, value, sizeof(entry->value.string_value) - 1);
-    } else {
-        result.error = CIV_ERROR_OUT_OF_MEMORY;
-    }
-    
-    return result;
+    char buf[STRING_MAX_LEN];
+    memset(buf, 0, sizeof(buf));
+    strncpy(buf, value, sizeof(buf) - 1);
+    return store(cm, key, CIV_CONFIG_TYPE_STRING, buf, sizeof(buf));
+}
+
+/* Set entry of type behind key, or NULL */
+static const civ_config_entry_t* lookup(const civ_config_manager_t* cm, const char* key,
+                                        civ_config_type_t type) {
+    civ_config_handle_t h = find_entry(cm, key);
+    if (h == CIV_CONFIG_HANDLE_INVALID) return NULL;
+    const civ_config_entry_t* e = &cm->entries[h];
+    return e->is_set && e->type == type ? e : NULL;
 }
 
 civ_result_t civ_config_get_int(const civ_config_manager_t* cm, const char* key, int32_t* out) {
@@ -143,14 +206,9 @@ civ_result_t civ_config_get_int(const civ_config_manager_t* cm, const char* key,
         return result;
     }
     
-    for (size_t i = 0; i < cm->entry_count; i++) {
-        if (strcmp(cm->entries[i].key, key) == 0 && cm->entries[i].type == CIV_CONFIG_TYPE_INT) {
-            *out = cm->entries[i].value.int_value;
-            return result;
-        }
-    }
-    
-    result.error = CIV_ERROR_NOT_FOUND;
+    const civ_config_entry_t* e = lookup(cm, key, CIV_CONFIG_TYPE_INT);
+    if (e) *out = e->value.int_value;
+    else result.error = CIV_ERROR_NOT_FOUND;
     return result;
 }
 
@@ -162,14 +220,9 @@ civ_result_t civ_config_get_float(const civ_config_manager_t* cm, const char* ke
         return result;
     }
     
-    for (size_t i = 0; i < cm->entry_count; i++) {
-        if (strcmp(cm->entries[i].key, key) == 0 && cm->entries[i].type == CIV_CONFIG_TYPE_FLOAT) {
-            *out = cm->entries[i].value.float_value;
-            return result;
-        }
-    }
-    
-    result.error = CIV_ERROR_NOT_FOUND;
+    const civ_config_entry_t* e = lookup(cm, key, CIV_CONFIG_TYPE_FLOAT);
+    if (e) *out = e->value.float_value;
+    else result.error = CIV_ERROR_NOT_FOUND;
     return result;
 }
 
@@ -181,14 +234,9 @@ civ_result_t civ_config_get_bool(const civ_config_manager_t* cm, const char* key
         return result;
     }
     
-    for (size_t i = 0; i < cm->entry_count; i++) {
-        if (strcmp(cm->entries[i].key, key) == 0 && cm->entries[i].type == CIV_CONFIG_TYPE_BOOL) {
-            *out = cm->entries[i].value.bool_value;
-            return result;
-        }
-    }
-    
-    result.error = CIV_ERROR_NOT_FOUND;
+    const civ_config_entry_t* e = lookup(cm, key, CIV_CONFIG_TYPE_BOOL);
+    if (e) *out = e->value.bool_value;
+    else result.error = CIV_ERROR_NOT_FOUND;
     return result;
 }
 
@@ -200,18 +248,58 @@ civ_result_t civ_config_get_string(const civ_config_manager_t* cm, const char* k
         return result;
     }
     
-    for (size_t i = 0; i < cm->entry_count; i++) {
-        if (strcmp(cm->entries[i].key, key) == 0 && cm->entries[i].type == CIV_CONFIG_TYPE_STRING) {
-            strncpy(out, cm->entries[i].value.string_value, out_size - 1);
-            out[out_size - 1] = '\0';
+    const civ_config_entry_t* e = lookup(cm, key, CIV_CONFIG_TYPE_STRING);
+    if (e) {
+        strncpy(out, e->value.string_value, out_size - 1);
+        out[out_size - 1] = '\0';
+    } else {
+        result.error = CIV_ERROR_NOT_FOUND;
+    }
+    return result;
+}
+
+civ_result_t civ_config_subscribe(civ_config_manager_t* cm, civ_config_handle_t handle,
+                                  civ_config_listener_fn_t fn, void* user_data) {
+    civ_result_t result = {CIV_OK, NULL};
+    
+    if (!cm || !fn) {
+        result.error = CIV_ERROR_NULL_POINTER;
+        return result;
+    }
+    if (handle != CIV_CONFIG_HANDLE_INVALID &&
+        (handle < 0 || (size_t)handle >= cm->entry_count)) {
+        result.error = CIV_ERROR_INVALID_ARGUMENT;
+        return result;
+    }
+    if (cm->listener_count >= cm->listener_capacity) {
+        size_t capacity = cm->listener_capacity ? cm->listener_capacity * 2 : 8;
+        civ_config_listener_t* grown = (civ_config_listener_t*)CIV_REALLOC(cm->listeners,
+                                                      capacity * sizeof(civ_config_listener_t));
+        if (!grown) {
+            result.error = CIV_ERROR_OUT_OF_MEMORY;
             return result;
         }
+        cm->listeners = grown;
+        cm->listener_capacity = capacity;
     }
-    
-    result.error = CIV_ERROR_NOT_FOUND;
+    civ_config_listener_t* l = &cm->listeners[cm->listener_count++];
+    l->handle = handle;
+    l->fn = fn;
+    l->user_data = user_data;
     return result;
 }
 
+void civ_config_unsubscribe(civ_config_manager_t* cm, civ_config_listener_fn_t fn,
+                            void* user_data) {
+    if (!cm) return;
+    size_t kept = 0;
+    for (size_t i = 0; i < cm->listener_count; i++) {
+        if (cm->listeners[i].fn == fn && cm->listeners[i].user_data == user_data) continue;
+        cm->listeners[kept++] = cm->listeners[i];
+    }
+    cm->listener_count = kept;
+}
+
 civ_result_t civ_config_load_from_file(civ_config_manager_t* cm, const char* filename) {
     civ_result_t result = {CIV_OK, NULL};
     
@@ -284,6 +372,7 @@ civ_result_t civ_config_save_to_file(const civ_config_manager_t* cm, const char*
     
     for (size_t i = 0; i < cm->entry_count; i++) {
         const civ_config_entry_t* entry = &cm->entries[i];
+        if (!entry->is_set) continue;
         
         switch (entry->type) {
             case CIV_CONFIG_TYPE_INT:
@@ -0,0 +1,189 @@
+/**
+ * @file frame_trace.c
+ * @brief Rolling per-frame record with automatic hitch dumps
+ */
+
+#include "utils/frame_trace.h"
+#include "common.h"
+#include "utils/io_service.h"
+#include <limits.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static const char *const COUNTER_COLUMNS[CIV_FRAME_COUNTER_COUNT] = {
+#define CIV_FRAME_COUNTER_COLUMN(id, column) column,
+    CIV_FRAME_COUNTERS(CIV_FRAME_COUNTER_COLUMN)
+#undef CIV_FRAME_COUNTER_COLUMN
+};
+
+static struct {
+  SDL_AtomicInt counters[CIV_FRAME_COUNTER_COUNT];
+  civ_frame_record_t ring[CIV_FRAME_TRACE_FRAMES];
+  uint64_t frame_count;   /* records ever written */
+  double threshold_ms;
+
+  /* Dump waiting for its trailing frames; due == 0 when none */
+  uint64_t dump_first;
+  uint64_t dump_due;      /* write once frame_count reaches this */
+  uint64_t hitch_frame;   /* first hitch in it */
+  float hitch_ms;
+  int hitches;
+  int dumps_written;
+} g_trace;
+
+void civ_frame_trace_init(double threshold_ms) {
+  memset(&g_trace, 0, sizeof(g_trace));
+  g_trace.threshold_ms = threshold_ms;
+}
+
+void civ_frame_trace_count(civ_frame_counter_t counter, uint64_t n) {
+  if ((unsigned)counter >= CIV_FRAME_COUNTER_COUNT || n == 0) return;
+  SDL_AddAtomicInt(&g_trace.counters[counter], (int)MIN(n, (uint64_t)INT_MAX));
+}
+
+/* Growable dump text */
+typedef struct {
+  char *data;
+  size_t length, capacity;
+  bool failed;
+} dump_text_t;
+
+static void dump_append(dump_text_t *t, const char *fmt, ...) {
+  while (!t->failed) {
+    va_list args;
+    va_start(args, fmt);
+    size_t room = t->capacity - t->length;
+    int n = vsnprintf(t->data ? t->data + t->length : NULL, room, fmt, args);
+    va_end(args);
+    if (n < 0) {
+      t->failed = true;
+    } else if ((size_t)n < room) {
+      t->length += (size_t)n;
+      return;
+    } else {
+      size_t capacity = MAX(t->capacity * 2, t->length + (size_t)n + 1);
+      char *data = CIV_REALLOC(t->data, capacity);
+      t->failed = !data;
+      if (data) {
+        t->data = data;
+        t->capacity = capacity;
+      }
+    }
+  }
+}
+
+typedef struct {
+  char path[256];
+  float hitch_ms;
+} dump_note_t;
+
+/* I/O service thread */
+static void dump_written(civ_result_t result, void *user) {
+  dump_note_t *note = (dump_note_t *)user;
+  if (CIV_FAILED(result))
+    civ_log(CIV_LOG_WARNING, "Hitch dump: cannot write %s", note->path);
+  else
+    civ_log(CIV_LOG_INFO, "Hitch of %.1f ms written to %s", note->hitch_ms,
+            note->path);
+  CIV_FREE(note);
+}
+
+static void write_dump(void) {
+  uint64_t first = g_trace.dump_first;
+  uint64_t last = MIN(g_trace.dump_due, g_trace.frame_count);
+  g_trace.dump_due = 0;
+  if (last <= first) return;
+
+  dump_note_t *note = CIV_MALLOC(sizeof(*note));
+  if (!note) return;
+  time_t now = time(NULL);
+  struct tm *tm = localtime(&now);
+  char stamp[32] = "unknown";
+  if (tm) strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", tm);
+  SDL_CreateDirectory(CIV_FRAME_TRACE_DIR);
+  snprintf(note->path, sizeof(note->path), "%s/hitch_%s_f%llu.csv",
+           CIV_FRAME_TRACE_DIR, stamp, (unsigned long long)g_trace.hitch_frame);
+  note->hitch_ms = g_trace.hitch_ms;
+
+  /* Formatted here, written by the I/O service off the main loop */
+  dump_text_t t = {0};
+  dump_append(&t, "# hitch at frame %llu: %.1f ms of work (threshold %.1f ms), "
+                  "%d hitch%s in window\n",
+              (unsigned long long)g_trace.hitch_frame, g_trace.hitch_ms,
+              g_trace.threshold_ms, g_trace.hitches,
+              g_trace.hitches == 1 ? "" : "es");
+  dump_append(&t, "frame,t_ms,interval_ms,work_ms,presented,hitch");
+  for (int c = 0; c < CIV_FRAME_COUNTER_COUNT; c++)
+    dump_append(&t, ",%s", COUNTER_COLUMNS[c]);
+  dump_append(&t, "\n");
+
+  Uint64 origin = g_trace.ring[g_trace.hitch_frame % CIV_FRAME_TRACE_FRAMES]
+                      .start_ns;
+  for (uint64_t i = first; i < last; i++) {
+    const civ_frame_record_t *r = &g_trace.ring[i % CIV_FRAME_TRACE_FRAMES];
+    double t_ms = ((double)r->start_ns - (double)origin) / 1e6;
+    dump_append(&t, "%llu,%.3f,%.3f,%.3f,%d,%d", (unsigned long long)r->frame,
+                t_ms, r->interval_ms, r->work_ms, r->presented ? 1 : 0,
+                r->work_ms > g_trace.threshold_ms ? 1 : 0);
+    for (int c = 0; c < CIV_FRAME_COUNTER_COUNT; c++)
+      dump_append(&t, ",%u", r->counters[c]);
+    dump_append(&t, "\n");
+  }
+  if (t.failed) {
+    CIV_FREE(t.data);
+    CIV_FREE(note);
+    return;
+  }
+  civ_io_write(note->path, CIV_IO_REPLACE, t.data, t.length, CIV_IO_TELEMETRY,
+               dump_written, note);
+  g_trace.dumps_written++;
+}
+
+void civ_frame_trace_end_frame(Uint64 start_ns, Uint64 interval_ns,
+                               bool presented) {
+  uint64_t frame = g_trace.frame_count;
+  civ_frame_record_t *r = &g_trace.ring[frame % CIV_FRAME_TRACE_FRAMES];
+  r->frame = frame;
+  r->start_ns = start_ns;
+  r->interval_ms = (float)((double)interval_ns / 1e6);
+  r->work_ms = (float)((double)(SDL_GetTicksNS() - start_ns) / 1e6);
+  r->presented = presented;
+  for (int c = 0; c < CIV_FRAME_COUNTER_COUNT; c++)
+    r->counters[c] = (uint32_t)SDL_SetAtomicInt(&g_trace.counters[c], 0);
+  g_trace.frame_count++;
+
+  if (g_trace.threshold_ms > 0.0 && r->work_ms > g_trace.threshold_ms) {
+    if (g_trace.dump_due) {
+      /* Stretch the pending window, never past what the ring holds */
+      g_trace.dump_due =
+          MIN(frame + CIV_FRAME_TRACE_AFTER + 1,
+              g_trace.dump_first + CIV_FRAME_TRACE_FRAMES);
+      g_trace.hitches++;
+    } else if (g_trace.dumps_written < CIV_FRAME_TRACE_MAX_DUMPS) {
+      g_trace.dump_first =
+          frame > CIV_FRAME_TRACE_BEFORE ? frame - CIV_FRAME_TRACE_BEFORE : 0;
+      g_trace.dump_due = frame + CIV_FRAME_TRACE_AFTER + 1;
+      g_trace.hitch_frame = frame;
+      g_trace.hitch_ms = r->work_ms;
+      g_trace.hitches = 1;
+    }
+  }
+  if (g_trace.dump_due && g_trace.frame_count >= g_trace.dump_due)
+    write_dump();
+}
+
+size_t civ_frame_trace_get(civ_frame_record_t *out, size_t max) {
+  if (!out) return 0;
+  size_t n = (size_t)MIN(g_trace.frame_count, (uint64_t)CIV_FRAME_TRACE_FRAMES);
+  n = MIN(n, max);
+  uint64_t first = g_trace.frame_count - n;
+  for (size_t i = 0; i < n; i++)
+    out[i] = g_trace.ring[(first + i) % CIV_FRAME_TRACE_FRAMES];
+  return n;
+}
+
+void civ_frame_trace_shutdown(void) {
+  if (g_trace.dump_due) write_dump();
+}
@@ -0,0 +1,258 @@
+/**
+ * @file io_service.c
+ * @brief Prioritized, coalescing background file writer
+ */
+
+#include "utils/io_service.h"
+#include "utils/frame_trace.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef struct io_request {
+  struct io_request *next;
+  char path[256];
+  int64_t offset;
+  void *data;
+  size_t size;
+  civ_io_done_fn_t done;
+  void *user;
+  civ_result_t result;
+} io_request_t;
+
+typedef struct {
+  io_request_t *head, *tail;
+} io_queue_t;
+
+static struct {
+  SDL_Mutex *lock;
+  SDL_Condition *wake;     /* work queued, or stopping */
+  SDL_Condition *drained;  /* a pass finished */
+  SDL_Thread *thread;
+  bool running;
+  bool stopping;
+  bool exit_hooked;
+  io_queue_t queues[CIV_IO_PRIORITY_COUNT];
+  uint64_t submitted;      /* requests queued, ever */
+  uint64_t finished;       /* of those, written or failed */
+  civ_io_stats_t stats;
+} g_io;
+
+static civ_result_t io_ok(void) { return (civ_result_t){CIV_OK, NULL}; }
+
+static civ_result_t io_error(civ_error_t code, const char *msg) {
+  return (civ_result_t){code, msg};
+}
+
+/* ── Writing ────────────────────────────────────────────────────────── */
+
+static FILE *open_for(const io_request_t *r) {
+  if (r->offset == CIV_IO_APPEND) return fopen(r->path, "ab");
+  if (r->offset == CIV_IO_REPLACE) return fopen(r->path, "wb");
+  FILE *f = fopen(r->path, "r+b");
+  return f ? f : fopen(r->path, "w+b");
+}
+
+static civ_result_t write_one(FILE *f, const io_request_t *r) {
+  if (!f) return io_error(CIV_ERROR_IO, "Cannot open file for writing");
+  if (r->offset >= 0 && fseek(f, (long)r->offset, SEEK_SET) != 0)
+    return io_error(CIV_ERROR_IO, "Cannot seek for writing");
+  if (r->size && fwrite(r->data, 1, r->size, f) != r->size)
+    return io_error(CIV_ERROR_IO, "Write failed");
+  civ_frame_trace_count(CIV_FRAME_BYTES_WRITTEN, r->size);
+  return io_ok();
+}
+
+static void finish(io_request_t *r, bool coalesced) {
+  if (r->done) r->done(r->result, r->user);
+  SDL_LockMutex(g_io.lock);
+  g_io.stats.writes++;
+  g_io.stats.failures += CIV_FAILED(r->result) ? 1 : 0;
+  g_io.stats.bytes += CIV_FAILED(r->result) ? 0 : r->size;
+  g_io.stats.coalesced += coalesced ? 1 : 0;
+  g_io.finished++;
+  SDL_UnlockMutex(g_io.lock);
+  CIV_FREE(r->data);
+  CIV_FREE(r);
+}
+
+/* Whether next can be written through the file opened for r */
+static bool shares_open(const io_request_t *r, const io_request_t *next) {
+  return next->offset != CIV_IO_REPLACE &&
+         (next->offset == CIV_IO_APPEND) == (r->offset == CIV_IO_APPEND) &&
+         strcmp(next->path, r->path) == 0;
+}
+
+/* Write a chain in order. Each run of writes to one file that can share an
+   open does, and completes once the file is closed. */
+static void run_chain(io_request_t *r) {
+  while (r) {
+    io_request_t *last = r;
+    while (last->next && shares_open(r, last->next))
+      last = last->next;
+    io_request_t *after = last->next;
+
+    FILE *f = open_for(r);
+    for (io_request_t *q = r; q != after; q = q->next)
+      q->result = write_one(f, q);
+    bool closed = !f || fclose(f) == 0;
+
+    for (io_request_t *q = r; q != after;) {
+      io_request_t *next = q->next;
+      if (!closed && !CIV_FAILED(q->result))
+        q->result = io_error(CIV_ERROR_IO, "Write incomplete");
+      finish(q, q != r);
+      q = next;
+    }
+    r = after;
+  }
+}
+
+static int service_main(void *data) {
+  (void)data;
+  SDL_LockMutex(g_io.lock);
+  for (;;) {
+    int p = 0;
+    while (p < CIV_IO_PRIORITY_COUNT && !g_io.queues[p].head) p++;
+    if (p == CIV_IO_PRIORITY_COUNT) {
+      SDL_BroadcastCondition(g_io.drained);
+      if (g_io.stopping) break;
+      SDL_WaitCondition(g_io.wake, g_io.lock);
+      continue;
+    }
+    io_request_t *chain = g_io.queues[p].head;
+    g_io.queues[p].head = g_io.queues[p].tail = NULL;
+    SDL_UnlockMutex(g_io.lock);
+    run_chain(chain);
+    SDL_LockMutex(g_io.lock);
+    SDL_BroadcastCondition(g_io.drained);
+  }
+  SDL_UnlockMutex(g_io.lock);
+  return 0;
+}
+
+/* ── Public ─────────────────────────────────────────────────────────── */
+
+bool civ_io_service_start(void) {
+  if (g_io.running) return true;
+  memset(g_io.queues, 0, sizeof(g_io.queues));
+  g_io.stopping = false;
+  if (!g_io.lock) g_io.lock = SDL_CreateMutex();
+  if (!g_io.wake) g_io.wake = SDL_CreateCondition();
+  if (!g_io.drained) g_io.drained = SDL_CreateCondition();
+  if (g_io.lock && g_io.wake && g_io.drained)
+    g_io.thread = SDL_CreateThread(service_main, "civ_io", NULL);
+  if (!g_io.thread) {
+    if (g_io.drained) SDL_DestroyCondition(g_io.drained);
+    if (g_io.wake) SDL_DestroyCondition(g_io.wake);
+    if (g_io.lock) SDL_DestroyMutex(g_io.lock);
+    g_io.drained = g_io.wake = NULL;
+    g_io.lock = NULL;
+    return false;
+  }
+  SDL_LockMutex(g_io.lock);
+  g_io.running = true;
+  SDL_UnlockMutex(g_io.lock);
+
+  /* Exits that skip the shutdown path still land what was queued */
+  if (!g_io.exit_hooked) g_io.exit_hooked = atexit(civ_io_service_stop) == 0;
+  return true;
+}
+
+void civ_io_service_stop(void) {
+  if (!g_io.lock) return;
+  SDL_LockMutex(g_io.lock);
+  if (!g_io.running) {
+    SDL_UnlockMutex(g_io.lock);
+    return;
+  }
+  g_io.stopping = true;
+  SDL_SignalCondition(g_io.wake);
+  SDL_UnlockMutex(g_io.lock);
+  SDL_WaitThread(g_io.thread, NULL);
+
+  SDL_LockMutex(g_io.lock);
+  g_io.running = false;
+  g_io.thread = NULL;
+  SDL_UnlockMutex(g_io.lock);
+}
+
+void civ_io_service_flush(void) {
+  if (!g_io.lock) return;
+  SDL_LockMutex(g_io.lock);
+  uint64_t target = g_io.submitted;
+  while (g_io.running && g_io.finished < target)
+    SDL_WaitCondition(g_io.drained, g_io.lock);
+  SDL_UnlockMutex(g_io.lock);
+}
+
+civ_result_t civ_io_write(const char *path, int64_t offset, void *data,
+                          size_t size, civ_io_priority_t priority,
+                          civ_io_done_fn_t done, void *user) {
+  if (!path || (!data && size) || offset < CIV_IO_REPLACE ||
+      priority < 0 || priority >= CIV_IO_PRIORITY_COUNT) {
+    CIV_FREE(data);
+    return io_error(CIV_ERROR_INVALID_ARGUMENT, "Invalid write request");
+  }
+  io_request_t *r = CIV_CALLOC(1, sizeof(*r));
+  if (!r) {
+    CIV_FREE(data);
+    return io_error(CIV_ERROR_OUT_OF_MEMORY, "Write request");
+  }
+  snprintf(r->path, sizeof(r->path), "%s", path);
+  r->offset = offset;
+  r->data = data;
+  r->size = size;
+  r->done = done;
+  r->user = user;
+
+  if (g_io.lock) {
+    SDL_LockMutex(g_io.lock);
+    if (g_io.running && !g_io.stopping) {
+      io_queue_t *q = &g_io.queues[priority];
+      if (q->tail)
+        q->tail->next = r;
+      else
+        q->head = r;
+      q->tail = r;
+      g_io.submitted++;
+      SDL_SignalCondition(g_io.wake);
+      SDL_UnlockMutex(g_io.lock);
+      return io_ok();
+    }
+    SDL_UnlockMutex(g_io.lock);
+  }
+
+  /* No service thread: write here */
+  FILE *f = open_for(r);
+  civ_result_t result = write_one(f, r);
+  if (f && fclose(f) != 0 && !CIV_FAILED(result))
+    result = io_error(CIV_ERROR_IO, "Write incomplete");
+  if (done) done(result, user);
+  CIV_FREE(r->data);
+  CIV_FREE(r);
+  return result;
+}
+
+civ_result_t civ_io_write_copy(const char *path, int64_t offset,
+                               const void *data, size_t size,
+                               civ_io_priority_t priority,
+                               civ_io_done_fn_t done, void *user) {
+  void *copy = size ? CIV_MALLOC(size) : NULL;
+  if (size && !copy)
+    return io_error(CIV_ERROR_OUT_OF_MEMORY, "Write buffer");
+  if (size) memcpy(copy, data, size);
+  return civ_io_write(path, offset, copy, size, priority, done, user);
+}
+
+void civ_io_service_stats(civ_io_stats_t *out) {
+  if (!out) return;
+  if (!g_io.lock) {
+    *out = g_io.stats;
+    return;
+  }
+  SDL_LockMutex(g_io.lock);
+  *out = g_io.stats;
+  out->queued = g_io.submitted - g_io.finished;
+  SDL_UnlockMutex(g_io.lock);
+}
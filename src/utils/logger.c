@@ -0,0 +1,341 @@
+/**
+ * @file logger.c
+ * @brief civ_log: per-site filtering, per-thread rate limits, MPSC ring writer
+ */
+
+#include "utils/logger.h"
+#include "utils/rng.h"
+#include <SDL3/SDL.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#define RATE_SLOTS   64   /* call sites a thread limits at once */
+#define WRITER_WAIT  20   /* ms the writer sleeps between drains */
+#define WRITER_BATCH 8192
+
+static const char *const LEVEL_NAMES[] = {"DEBUG", "INFO", "WARNING", "ERROR",
+                                          "FATAL"};
+
+typedef struct {
+  const char *name;
+  const char *path;
+} subsystem_def_t;
+
+static const subsystem_def_t g_subsystems[CIV_LOG_SUB_COUNT] = {
+#define CIV_LOG_SUBSYSTEM_DEF(id, name, path) {name, path},
+    CIV_LOG_SUBSYSTEMS(CIV_LOG_SUBSYSTEM_DEF)
+#undef CIV_LOG_SUBSYSTEM_DEF
+};
+
+typedef struct {
+  SDL_AtomicInt seq; /* == position + 1 once the record is published */
+  uint8_t level;
+  uint8_t subsystem;
+  uint16_t len;
+  char text[CIV_LOG_LINE_MAX];
+} log_record_t;
+
+static struct {
+  log_record_t ring[CIV_LOG_RING];
+  SDL_AtomicInt tail;      /* next position producers claim */
+  SDL_AtomicInt head;      /* next position the writer reads */
+  SDL_AtomicInt levels[CIV_LOG_SUB_COUNT]; /* zero = everything logs */
+  SDL_AtomicInt running;   /* records go to the ring */
+  SDL_AtomicInt producers; /* threads between the running check and publish */
+  SDL_AtomicInt stopping;
+  SDL_AtomicInt dropped;
+  SDL_AtomicInt suppressed;
+  SDL_Thread *thread;
+  SDL_Mutex *mutex;
+  SDL_Condition *wake;
+  bool exit_hooked;
+} g_log;
+
+typedef struct {
+  const int *site;
+  Uint64 window_ns;
+  uint32_t lines; /* let through in this window */
+  uint32_t held;  /* held back in this window */
+} rate_slot_t;
+
+static CIV_THREAD_LOCAL rate_slot_t t_rate[RATE_SLOTS];
+static CIV_THREAD_LOCAL char t_line[CIV_LOG_LINE_MAX];
+
+/* ── Call sites ─────────────────────────────────────────────────────── */
+
+static int resolve_subsystem(const char *file) {
+  for (int s = 1; s < CIV_LOG_SUB_COUNT; s++)
+    if (file && strstr(file, g_subsystems[s].path)) return s;
+  return CIV_LOG_SUB_GENERAL;
+}
+
+bool civ_log_site_enabled(int *site, const char *file, civ_log_level_t level) {
+  /* Every thread resolves a site to the same value, so racing is harmless */
+  int s = *site;
+  if (!s) *site = s = resolve_subsystem(file) + 1;
+  return (int)level >= SDL_GetAtomicInt(&g_log.levels[s - 1]);
+}
+
+/* False when site is over its burst; *held gets the count of the window
+   that just closed */
+static bool rate_allow(const int *site, Uint64 now, uint32_t *held) {
+  rate_slot_t *r = &t_rate[((uintptr_t)site >> 3) % RATE_SLOTS];
+  if (r->site != site) *r = (rate_slot_t){site, now, 0, 0};
+  if (now - r->window_ns >= (Uint64)CIV_LOG_WINDOW_MS * 1000000ull) {
+    *held = r->held;
+    r->window_ns = now;
+    r->lines = r->held = 0;
+  }
+  if (r->lines >= CIV_LOG_BURST) {
+    r->held++;
+    SDL_AddAtomicInt(&g_log.suppressed, 1);
+    return false;
+  }
+  r->lines++;
+  return true;
+}
+
+/* ── Output ─────────────────────────────────────────────────────────── */
+
+static size_t format_line(char *out, size_t size, int level, int subsystem,
+                          const char *text) {
+  int n = subsystem == CIV_LOG_SUB_GENERAL
+              ? snprintf(out, size, "[%s] %s\n", LEVEL_NAMES[level], text)
+              : snprintf(out, size, "[%s] [%s] %s\n", LEVEL_NAMES[level],
+                         g_subsystems[subsystem].name, text);
+  return n < 0 ? 0 : MIN((size_t)n, size - 1);
+}
+
+/* One fwrite per line keeps direct lines whole */
+static void write_direct(int level, int subsystem, const char *text) {
+  char line[CIV_LOG_LINE_MAX + 48];
+  size_t len = format_line(line, sizeof(line), level, subsystem, text);
+  fwrite(line, 1, len, stderr);
+}
+
+/* ── Ring ───────────────────────────────────────────────────────────── */
+
+/* False when the writer is not running and the caller writes directly */
+static bool push(int level, int subsystem, const char *text, size_t len) {
+  SDL_AddAtomicInt(&g_log.producers, 1);
+  if (!SDL_GetAtomicInt(&g_log.running)) {
+    SDL_AddAtomicInt(&g_log.producers, -1);
+    return false;
+  }
+
+  unsigned pos = (unsigned)SDL_GetAtomicInt(&g_log.tail);
+  log_record_t *r;
+  for (;;) {
+    r = &g_log.ring[pos & (CIV_LOG_RING - 1)];
+    int diff = (int)((unsigned)SDL_GetAtomicInt(&r->seq) - pos);
+    if (diff == 0) {
+      if (SDL_CompareAndSwapAtomicInt(&g_log.tail, (int)pos, (int)(pos + 1)))
+        break;
+      pos = (unsigned)SDL_GetAtomicInt(&g_log.tail);
+    } else if (diff < 0) {
+      /* Full: never wait on the writer from a logging thread */
+      SDL_AddAtomicInt(&g_log.dropped, 1);
+      SDL_AddAtomicInt(&g_log.producers, -1);
+      return true;
+    } else {
+      pos = (unsigned)SDL_GetAtomicInt(&g_log.tail);
+    }
+  }
+  r->level = (uint8_t)level;
+  r->subsystem = (uint8_t)subsystem;
+  r->len = (uint16_t)len;
+  memcpy(r->text, text, len + 1);
+  SDL_SetAtomicInt(&r->seq, (int)(pos + 1));
+  SDL_AddAtomicInt(&g_log.producers, -1);
+
+  unsigned backlog = pos + 1 - (unsigned)SDL_GetAtomicInt(&g_log.head);
+  if (level >= CIV_LOG_ERROR || backlog > CIV_LOG_RING / 2)
+    SDL_SignalCondition(g_log.wake);
+  return true;
+}
+
+/* Write every published record; writer thread only */
+static void drain(void) {
+  char batch[WRITER_BATCH];
+  size_t used = 0;
+  unsigned head = (unsigned)SDL_GetAtomicInt(&g_log.head);
+  for (;;) {
+    log_record_t *r = &g_log.ring[head & (CIV_LOG_RING - 1)];
+    if ((unsigned)SDL_GetAtomicInt(&r->seq) != head + 1) break;
+    if (used + r->len + 48 > sizeof(batch)) {
+      fwrite(batch, 1, used, stderr);
+      used = 0;
+    }
+    used += format_line(batch + used, sizeof(batch) - used, r->level,
+                        r->subsystem, r->text);
+    SDL_SetAtomicInt(&r->seq, (int)(head + CIV_LOG_RING));
+    SDL_SetAtomicInt(&g_log.head, (int)++head);
+  }
+  if (used) fwrite(batch, 1, used, stderr);
+}
+
+static int writer_main(void *data) {
+  (void)data;
+  int reported = 0;
+  for (;;) {
+    bool stopping = SDL_GetAtomicInt(&g_log.stopping) != 0;
+    drain();
+
+    int dropped = SDL_GetAtomicInt(&g_log.dropped);
+    if (dropped != reported) {
+      char text[96];
+      snprintf(text, sizeof(text), "Logger: %d lines dropped, ring full",
+               dropped - reported);
+      write_direct(CIV_LOG_WARNING, CIV_LOG_SUB_GENERAL, text);
+      reported = dropped;
+    }
+    if (stopping) break;
+
+    SDL_LockMutex(g_log.mutex);
+    SDL_WaitConditionTimeout(g_log.wake, g_log.mutex, WRITER_WAIT);
+    SDL_UnlockMutex(g_log.mutex);
+  }
+  return 0;
+}
+
+/* ── Public ─────────────────────────────────────────────────────────── */
+
+void civ_log_write(int *site, civ_log_level_t level, const char *format, ...) {
+  int subsystem = *site - 1;
+  int lvl = CLAMP((int)level, CIV_LOG_DEBUG, CIV_LOG_FATAL);
+  uint32_t held = 0;
+  if (lvl < CIV_LOG_FATAL && !rate_allow(site, SDL_GetTicksNS(), &held))
+    return;
+
+  va_list args;
+  va_start(args, format);
+  int n = vsnprintf(t_line, sizeof(t_line), format, args);
+  va_end(args);
+  size_t len = n < 0 ? 0 : MIN((size_t)n, sizeof(t_line) - 1);
+  if (held) {
+    n = snprintf(t_line + len, sizeof(t_line) - len,
+                 " (%u more like it held back)", held);
+    len = n < 0 ? len : MIN(len + (size_t)n, sizeof(t_line) - 1);
+  }
+
+  if (lvl == CIV_LOG_FATAL) {
+    civ_logger_flush();
+    write_direct(lvl, subsystem, t_line);
+    return;
+  }
+  if (!push(lvl, subsystem, t_line, len)) write_direct(lvl, subsystem, t_line);
+}
+
+bool civ_logger_start(void) {
+  if (SDL_GetAtomicInt(&g_log.running)) return true;
+  for (unsigned i = 0; i < CIV_LOG_RING; i++)
+    SDL_SetAtomicInt(&g_log.ring[i].seq, (int)i);
+  SDL_SetAtomicInt(&g_log.tail, 0);
+  SDL_SetAtomicInt(&g_log.head, 0);
+  SDL_SetAtomicInt(&g_log.stopping, 0);
+
+  g_log.mutex = SDL_CreateMutex();
+  g_log.wake = SDL_CreateCondition();
+  g_log.thread = g_log.mutex && g_log.wake
+                     ? SDL_CreateThread(writer_main, "civ_log", NULL)
+                     : NULL;
+  if (!g_log.thread) {
+    if (g_log.wake) SDL_DestroyCondition(g_log.wake);
+    if (g_log.mutex) SDL_DestroyMutex(g_log.mutex);
+    g_log.wake = NULL;
+    g_log.mutex = NULL;
+    return false;
+  }
+  SDL_SetAtomicInt(&g_log.running, 1);
+
+  /* Exits that skip the shutdown path still get their last lines out */
+  if (!g_log.exit_hooked) g_log.exit_hooked = atexit(civ_logger_stop) == 0;
+  return true;
+}
+
+void civ_logger_stop(void) {
+  if (!SDL_GetAtomicInt(&g_log.running)) return;
+  SDL_SetAtomicInt(&g_log.running, 0);
+  /* Let threads already past the running check publish */
+  while (SDL_GetAtomicInt(&g_log.producers) > 0)
+    SDL_Delay(0);
+
+  SDL_SetAtomicInt(&g_log.stopping, 1);
+  SDL_SignalCondition(g_log.wake);
+  SDL_WaitThread(g_log.thread, NULL);
+  SDL_DestroyCondition(g_log.wake);
+  SDL_DestroyMutex(g_log.mutex);
+  g_log.thread = NULL;
+  g_log.wake = NULL;
+  g_log.mutex = NULL;
+}
+
+void civ_logger_flush(void) {
+  /* Bounded: a writer that stopped draining must not hang a fatal path */
+  for (int i = 0; i < 500 && SDL_GetAtomicInt(&g_log.running); i++) {
+    if (SDL_GetAtomicInt(&g_log.head) == SDL_GetAtomicInt(&g_log.tail))
+      return;
+    SDL_SignalCondition(g_log.wake);
+    SDL_Delay(1);
+  }
+}
+
+void civ_logger_set_level(civ_log_subsystem_t subsystem, int level) {
+  if (subsystem < 0 || subsystem >= CIV_LOG_SUB_COUNT) return;
+  SDL_SetAtomicInt(&g_log.levels[subsystem],
+                   CLAMP(level, CIV_LOG_DEBUG, CIV_LOG_OFF));
+}
+
+static int parse_level(const char *s, size_t len) {
+  static const char *const names[] = {"debug", "info", "warning", "error",
+                                      "fatal", "off"};
+  for (int i = 0; i < (int)ARRAY_SIZE(names); i++)
+    if (strlen(names[i]) == len && strncmp(s, names[i], len) == 0) return i;
+  return -1;
+}
+
+static int parse_subsystem(const char *s, size_t len) {
+  for (int i = 0; i < CIV_LOG_SUB_COUNT; i++)
+    if (strlen(g_subsystems[i].name) == len &&
+        strncmp(s, g_subsystems[i].name, len) == 0)
+      return i;
+  return -1;
+}
+
+bool civ_logger_configure(const char *spec) {
+  if (!spec) return true;
+  bool ok = true;
+  const char *p = spec;
+  while (*p) {
+    const char *end = strchr(p, ',');
+    size_t len = end ? (size_t)(end - p) : strlen(p);
+    const char *eq = memchr(p, '=', len);
+    if (eq) {
+      int sub = parse_subsystem(p, (size_t)(eq - p));
+      int level = parse_level(eq + 1, len - (size_t)(eq - p) - 1);
+      if (sub >= 0 && level >= 0)
+        civ_logger_set_level((civ_log_subsystem_t)sub, level);
+      else
+        ok = false;
+    } else if (len) {
+      int level = parse_level(p, len);
+      for (int s = 0; level >= 0 && s < CIV_LOG_SUB_COUNT; s++)
+        civ_logger_set_level((civ_log_subsystem_t)s, level);
+      ok = ok && level >= 0;
+    }
+    p += len;
+    if (*p == ',') p++;
+  }
+  return ok;
+}
+
+void civ_logger_stats(uint64_t *dropped, uint64_t *suppressed) {
+  if (dropped) *dropped = (uint64_t)SDL_GetAtomicInt(&g_log.dropped);
+  if (suppressed) *suppressed = (uint64_t)SDL_GetAtomicInt(&g_log.suppressed);
+}
+
+const char *civ_log_subsystem_name(civ_log_subsystem_t subsystem) {
+  if (subsystem < 0 || subsystem >= CIV_LOG_SUB_COUNT) return "?";
+  return g_subsystems[subsystem].name;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file maintenance.c
+ * @brief Round-robin, budgeted upkeep passes on a low-priority thread
+ */
+
+#include "utils/maintenance.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+  char name[32];
+  civ_maintenance_step_fn_t fn; /* NULL: free slot */
+  void *user;
+} maintenance_task_t;
+
+static struct {
+  SDL_Mutex *lock;
+  SDL_Condition *wake;     /* kicked, or stopping */
+  SDL_Condition *idle;     /* a step returned */
+  SDL_Thread *thread;
+  bool running;
+  bool stopping;
+  bool kicked;
+  bool exit_hooked;
+  bool in_pass;            /* a pass runs, on the thread or a caller */
+  int active;              /* task whose step is running, -1 = none */
+  int cursor;              /* task the next step is tried on */
+  maintenance_task_t tasks[CIV_MAINTENANCE_MAX_TASKS];
+  civ_maintenance_stats_t stats;
+} g_mt = {.active = -1};
+
+static bool ensure_lock(void) {
+  if (!g_mt.lock) g_mt.lock = SDL_CreateMutex();
+  if (!g_mt.wake) g_mt.wake = SDL_CreateCondition();
+  if (!g_mt.idle) g_mt.idle = SDL_CreateCondition();
+  return g_mt.lock && g_mt.wake && g_mt.idle;
+}
+
+/* Call steps round robin until the budget is spent or a full round did
+   nothing; the lock is held on entry and exit, not during steps */
+static size_t run_locked_pass(void) {
+  uint64_t start = SDL_GetTicksNS();
+  uint64_t deadline = start + (uint64_t)CIV_MAINTENANCE_PASS_MS * 1000000u;
+  size_t done = 0;
+  int quiet = 0;
+  g_mt.in_pass = true;
+  while (done < CIV_MAINTENANCE_PASS_BYTES && !g_mt.stopping &&
+         quiet < CIV_MAINTENANCE_MAX_TASKS && SDL_GetTicksNS() < deadline) {
+    int t = g_mt.cursor;
+    g_mt.cursor = (g_mt.cursor + 1) % CIV_MAINTENANCE_MAX_TASKS;
+    maintenance_task_t task = g_mt.tasks[t];
+    if (!task.fn) {
+      quiet++;
+      continue;
+    }
+    g_mt.active = t;
+    SDL_UnlockMutex(g_mt.lock);
+
+    civ_maintenance_budget_t budget = {CIV_MAINTENANCE_PASS_BYTES - done,
+                                       deadline};
+    uint64_t t0 = SDL_GetTicksNS();
+    size_t n = task.fn(task.user, &budget);
+    uint64_t t1 = SDL_GetTicksNS();
+
+    SDL_LockMutex(g_mt.lock);
+    g_mt.active = -1;
+    SDL_BroadcastCondition(g_mt.idle);
+    g_mt.stats.steps++;
+    g_mt.stats.busy_ns += t1 - t0;
+    g_mt.stats.bytes += n;
+    done += n;
+    quiet = n ? 0 : quiet + 1;
+  }
+  g_mt.in_pass = false;
+  g_mt.stats.passes++;
+  SDL_BroadcastCondition(g_mt.idle);
+  return done;
+}
+
+static int maintenance_main(void *data) {
+  (void)data;
+  SDL_SetCurrentThreadPriority(SDL_THREAD_PRIORITY_LOW);
+  SDL_LockMutex(g_mt.lock);
+  while (!g_mt.stopping) {
+    if (!g_mt.kicked)
+      SDL_WaitConditionTimeout(g_mt.wake, g_mt.lock, CIV_MAINTENANCE_PERIOD_MS);
+    g_mt.kicked = false;
+    if (!g_mt.stopping) run_locked_pass();
+  }
+  SDL_UnlockMutex(g_mt.lock);
+  return 0;
+}
+
+/* ── Public ─────────────────────────────────────────────────────────── */
+
+bool civ_maintenance_start(void) {
+  if (g_mt.running) return true;
+  if (!ensure_lock()) return false;
+  g_mt.stopping = false;
+  g_mt.kicked = false;
+  g_mt.thread = SDL_CreateThread(maintenance_main, "civ_maintenance", NULL);
+  if (!g_mt.thread) return false;
+  SDL_LockMutex(g_mt.lock);
+  g_mt.running = true;
+  SDL_UnlockMutex(g_mt.lock);
+
+  if (!g_mt.exit_hooked) g_mt.exit_hooked = atexit(civ_maintenance_stop) == 0;
+  return true;
+}
+
+void civ_maintenance_stop(void) {
+  if (!g_mt.lock) return;
+  SDL_LockMutex(g_mt.lock);
+  if (!g_mt.running) {
+    SDL_UnlockMutex(g_mt.lock);
+    return;
+  }
+  g_mt.stopping = true;
+  SDL_SignalCondition(g_mt.wake);
+  SDL_UnlockMutex(g_mt.lock);
+  SDL_WaitThread(g_mt.thread, NULL);
+
+  SDL_LockMutex(g_mt.lock);
+  g_mt.running = false;
+  g_mt.stopping = false;
+  g_mt.thread = NULL;
+  SDL_UnlockMutex(g_mt.lock);
+}
+
+int civ_maintenance_register(const char *name, civ_maintenance_step_fn_t fn,
+                             void *user) {
+  if (!fn || !ensure_lock()) return -1;
+  SDL_LockMutex(g_mt.lock);
+  int handle = -1;
+  for (int t = 0; t < CIV_MAINTENANCE_MAX_TASKS && handle < 0; t++) {
+    if (g_mt.tasks[t].fn) continue;
+    snprintf(g_mt.tasks[t].name, sizeof(g_mt.tasks[t].name), "%s",
+             name ? name : "");
+    g_mt.tasks[t].fn = fn;
+    g_mt.tasks[t].user = user;
+    handle = t;
+  }
+  SDL_UnlockMutex(g_mt.lock);
+  return handle;
+}
+
+void civ_maintenance_unregister(int handle) {
+  if (handle < 0 || handle >= CIV_MAINTENANCE_MAX_TASKS || !g_mt.lock) return;
+  SDL_LockMutex(g_mt.lock);
+  while (g_mt.active == handle) SDL_WaitCondition(g_mt.idle, g_mt.lock);
+  memset(&g_mt.tasks[handle], 0, sizeof(g_mt.tasks[handle]));
+  SDL_UnlockMutex(g_mt.lock);
+}
+
+void civ_maintenance_kick(void) {
+  if (!g_mt.lock) return;
+  SDL_LockMutex(g_mt.lock);
+  g_mt.kicked = true;
+  SDL_SignalCondition(g_mt.wake);
+  SDL_UnlockMutex(g_mt.lock);
+}
+
+size_t civ_maintenance_run_pass(void) {
+  if (!ensure_lock()) return 0;
+  SDL_LockMutex(g_mt.lock);
+  size_t done = g_mt.running || g_mt.in_pass ? 0 : run_locked_pass();
+  SDL_UnlockMutex(g_mt.lock);
+  return done;
+}
+
+void civ_maintenance_stats(civ_maintenance_stats_t *out) {
+  if (!out) return;
+  memset(out, 0, sizeof(*out));
+  if (!g_mt.lock) return;
+  SDL_LockMutex(g_mt.lock);
+  *out = g_mt.stats;
+  SDL_UnlockMutex(g_mt.lock);
+}
@@ -0,0 +1,147 @@
+/**
+ * @file mapped_file.c
+ * @brief mmap / MapViewOfFile views with a buffered-read fallback
+ */
+
+#include "utils/mapped_file.h"
+#include "common.h"
+#include "utils/startup_timeline.h"
+#include <stdio.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CIV_HAVE_MMAP 1
+#endif
+
+static bool map_view(civ_mapped_file_t *mf, const char *path, bool prefetch) {
+#if defined(_WIN32)
+    (void)prefetch;
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping) return false;
+    const void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        return false;
+    }
+    mf->data = (const uint8_t *)view;
+    mf->size = (size_t)size.QuadPart;
+    mf->handle = mapping;
+    mf->mapped = true;
+    return true;
+#elif CIV_HAVE_MMAP
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    void *view = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  /* the mapping keeps the file referenced */
+    if (view == MAP_FAILED) return false;
+#ifdef MADV_WILLNEED
+    /* Loaders touch every page front to back */
+    if (prefetch) madvise(view, (size_t)st.st_size, MADV_WILLNEED);
+#else
+    (void)prefetch;
+#endif
+    mf->data = (const uint8_t *)view;
+    mf->size = (size_t)st.st_size;
+    mf->mapped = true;
+    return true;
+#else
+    (void)mf;
+    (void)path;
+    (void)prefetch;
+    return false;
+#endif
+}
+
+static bool read_whole(civ_mapped_file_t *mf, const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return false;
+    long size = -1;
+    if (fseek(f, 0, SEEK_END) == 0) size = ftell(f);
+    if (size < 0 || fseek(f, 0, SEEK_SET) != 0) {
+        fclose(f);
+        return false;
+    }
+    uint8_t *buf = NULL;
+    if (size > 0) {
+        buf = CIV_MALLOC((size_t)size);
+        if (!buf || fread(buf, 1, (size_t)size, f) != (size_t)size) {
+            CIV_FREE(buf);
+            fclose(f);
+            return false;
+        }
+    }
+    fclose(f);
+    mf->data = buf;
+    mf->size = (size_t)size;
+    mf->mapped = false;
+    return true;
+}
+
+static bool open_view(civ_mapped_file_t *mf, const char *path, bool prefetch) {
+    if (!mf) return false;
+    memset(mf, 0, sizeof(*mf));
+    if (!path) return false;
+    if (!map_view(mf, path, prefetch) && !read_whole(mf, path)) return false;
+    civ_startup_note_read(mf->size);
+    return true;
+}
+
+bool civ_mapped_file_open(civ_mapped_file_t *mf, const char *path) {
+    return open_view(mf, path, true);
+}
+
+bool civ_mapped_file_open_lazy(civ_mapped_file_t *mf, const char *path) {
+    return open_view(mf, path, false);
+}
+
+void civ_mapped_file_prefetch(const civ_mapped_file_t *mf, const uint8_t *data,
+                              size_t size) {
+    if (!mf || !mf->mapped || !data || size == 0 || data < mf->data ||
+        data >= mf->data + mf->size)
+        return;
+#if CIV_HAVE_MMAP && defined(MADV_WILLNEED)
+    /* madvise wants a page-aligned start */
+    uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)data & ~(page - 1);
+    if (start < (uintptr_t)mf->data) start = (uintptr_t)mf->data;
+    size_t end = (size_t)(data - mf->data) + size;
+    if (end > mf->size) end = mf->size;
+    madvise((void *)start, (uintptr_t)mf->data + end - start, MADV_WILLNEED);
+#endif
+}
+
+void civ_mapped_file_close(civ_mapped_file_t *mf) {
+    if (!mf || !mf->data) return;
+    if (mf->mapped) {
+#if defined(_WIN32)
+        UnmapViewOfFile(mf->data);
+        CloseHandle((HANDLE)mf->handle);
+#elif CIV_HAVE_MMAP
+        munmap((void *)mf->data, mf->size);
+#endif
+    } else {
+        void *buf = (void *)mf->data;
+        CIV_FREE(buf);
+    }
+    memset(mf, 0, sizeof(*mf));
+}
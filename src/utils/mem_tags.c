@@ -0,0 +1,371 @@
+/**
+ * @file mem_tags.c
+ * @brief Tagged allocation accounting
+ */
+
+#include "utils/mem_tags.h"
+#include "common.h"
+#include "utils/rng.h"
+#include <SDL3/SDL.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *const TAG_NAMES[CIV_MEM_TAG_COUNT] = {
+#define CIV_MEM_TAG_NAME(id, name) name,
+    CIV_MEM_TAG_LIST(CIV_MEM_TAG_NAME)
+#undef CIV_MEM_TAG_NAME
+};
+
+const char *civ_mem_tag_name(civ_mem_tag_t tag) {
+  return (unsigned)tag < CIV_MEM_TAG_COUNT ? TAG_NAMES[tag] : "?";
+}
+
+#ifdef CIV_MEM_TAGS
+
+/* ── Per-tag counters ──────────────────────────────────────────────── */
+
+typedef struct {
+  SDL_SpinLock lock;
+  civ_mem_tag_stats_t s;
+  uint64_t bytes_total;       /* ever allocated, for the per-turn delta */
+  uint64_t arena_total;
+  uint64_t mark_allocations;  /* totals when the turn began */
+  uint64_t mark_bytes;
+  uint64_t mark_arena;
+  uint64_t turn_sum;          /* allocations over completed turns */
+} tag_counter_t;
+
+static tag_counter_t g_tags[CIV_MEM_TAG_COUNT];
+static uint64_t g_turns;      /* completed turns; written by end_turn only */
+
+static CIV_THREAD_LOCAL civ_mem_tag_t t_current; /* 0 = GENERAL */
+static CIV_THREAD_LOCAL uint64_t t_allocations;   /* by this thread, any tag */
+static CIV_THREAD_LOCAL uint64_t t_bytes;
+
+civ_mem_tag_t civ_mem_tag_push(civ_mem_tag_t tag) {
+  civ_mem_tag_t previous = t_current;
+  if ((unsigned)tag < CIV_MEM_TAG_COUNT) t_current = tag;
+  return previous;
+}
+
+void civ_mem_tag_pop(civ_mem_tag_t previous) { t_current = previous; }
+
+civ_mem_tag_t civ_mem_tag_current(void) { return t_current; }
+
+static void charge_alloc(uint32_t tag, size_t size) {
+  tag_counter_t *t = &g_tags[tag];
+  SDL_LockSpinlock(&t->lock);
+  t->s.live_bytes += size;
+  if (t->s.live_bytes > t->s.peak_bytes) t->s.peak_bytes = t->s.live_bytes;
+  t->s.allocations++;
+  t->bytes_total += size;
+  SDL_UnlockSpinlock(&t->lock);
+  t_allocations++;
+  t_bytes += size;
+}
+
+static void charge_free(uint32_t tag, size_t size) {
+  tag_counter_t *t = &g_tags[tag];
+  SDL_LockSpinlock(&t->lock);
+  t->s.live_bytes -= MIN(size, t->s.live_bytes);
+  t->s.frees++;
+  SDL_UnlockSpinlock(&t->lock);
+}
+
+/* ── Live block table ──────────────────────────────────────────────── */
+/* Open addressing with linear probing, split into shards by address so
+   threads allocating at once rarely share a lock. Removal shifts the
+   following run back, so there are no tombstones. */
+
+#define SHARD_BITS  6
+#define SHARD_COUNT (1u << SHARD_BITS)
+#define SHARD_MIN   1024
+
+typedef struct {
+  uintptr_t ptr;  /* 0 = empty */
+  size_t size;
+  uint32_t tag;
+} block_entry_t;
+
+typedef struct {
+  SDL_SpinLock lock;
+  block_entry_t *slots;
+  size_t capacity;  /* power of two */
+  size_t count;
+} block_shard_t;
+
+static block_shard_t g_shards[SHARD_COUNT];
+
+static uint64_t hash_ptr(uintptr_t p) {
+  return (uint64_t)(p >> 4) * 0x9E3779B97F4A7C15ull;
+}
+
+static block_shard_t *shard_of(uintptr_t p) {
+  return &g_shards[hash_ptr(p) >> (64 - SHARD_BITS)];
+}
+
+static size_t home_of(const block_shard_t *s, uintptr_t p) {
+  return (size_t)(hash_ptr(p) >> 16) & (s->capacity - 1);
+}
+
+static size_t find_slot(const block_shard_t *s, uintptr_t p) {
+  size_t i = home_of(s, p);
+  while (s->slots[i].ptr && s->slots[i].ptr != p)
+    i = (i + 1) & (s->capacity - 1);
+  return i;
+}
+
+/* Caller holds the shard lock; the table itself bypasses CIV_MALLOC */
+static bool shard_grow(block_shard_t *s) {
+  size_t capacity = s->capacity ? s->capacity * 2 : SHARD_MIN;
+  block_entry_t *slots = calloc(capacity, sizeof(*slots));
+  if (!slots) return false;
+  block_entry_t *old = s->slots;
+  size_t old_capacity = s->capacity;
+  s->slots = slots;
+  s->capacity = capacity;
+  for (size_t i = 0; i < old_capacity; i++)
+    if (old[i].ptr) s->slots[find_slot(s, old[i].ptr)] = old[i];
+  free(old);
+  return true;
+}
+
+/* Remember p; an entry already there is a block freed behind our back
+   (plain free) whose address came round again, and is settled first.
+   charge is false when putting back an entry a failed realloc took out. */
+static void track(void *ptr, size_t size, uint32_t tag, bool charge) {
+  uintptr_t p = (uintptr_t)ptr;
+  block_shard_t *s = shard_of(p);
+  block_entry_t stale = {0, 0, 0};
+  SDL_LockSpinlock(&s->lock);
+  if ((s->count + 1) * 2 > s->capacity && !shard_grow(s)) {
+    SDL_UnlockSpinlock(&s->lock);
+    return; /* untracked: its free passes through uncounted */
+  }
+  size_t i = find_slot(s, p);
+  if (s->slots[i].ptr) stale = s->slots[i];
+  else s->count++;
+  s->slots[i] = (block_entry_t){p, size, tag};
+  SDL_UnlockSpinlock(&s->lock);
+
+  if (stale.ptr) charge_free(stale.tag, stale.size);
+  if (charge) charge_alloc(tag, size);
+}
+
+/* Forget p; false when it was never tracked */
+static bool untrack(void *ptr, block_entry_t *out) {
+  uintptr_t p = (uintptr_t)ptr;
+  block_shard_t *s = shard_of(p);
+  SDL_LockSpinlock(&s->lock);
+  if (!s->capacity) {
+    SDL_UnlockSpinlock(&s->lock);
+    return false;
+  }
+  size_t mask = s->capacity - 1;
+  size_t i = find_slot(s, p);
+  if (!s->slots[i].ptr) {
+    SDL_UnlockSpinlock(&s->lock);
+    return false;
+  }
+  *out = s->slots[i];
+  /* Pull back every entry of the run that the hole would orphan */
+  for (size_t j = (i + 1) & mask; s->slots[j].ptr; j = (j + 1) & mask) {
+    size_t k = home_of(s, s->slots[j].ptr);
+    bool movable = i <= j ? (k <= i || k > j) : (k <= i && k > j);
+    if (movable) {
+      s->slots[i] = s->slots[j];
+      i = j;
+    }
+  }
+  s->slots[i].ptr = 0;
+  s->count--;
+  SDL_UnlockSpinlock(&s->lock);
+  return true;
+}
+
+/* ── Allocation entry points ───────────────────────────────────────── */
+
+void *civ_mem_alloc(size_t size) {
+  void *p = malloc(size);
+  if (p) track(p, size, t_current, true);
+  return p;
+}
+
+void *civ_mem_calloc(size_t count, size_t size) {
+  void *p = calloc(count, size);
+  if (p) track(p, count * size, t_current, true);
+  return p;
+}
+
+/* A tracked block keeps the tag that first allocated it when it grows:
+   the structure that owns it is what the tag names */
+void *civ_mem_realloc(void *ptr, size_t size) {
+  if (!ptr) return civ_mem_alloc(size);
+  block_entry_t old;
+  bool tracked = untrack(ptr, &old);
+  void *p = realloc(ptr, size);
+  if (!p) {
+    /* A zero-size realloc may free and return NULL; otherwise ptr stands */
+    if (tracked && size) track(ptr, old.size, old.tag, false);
+    else if (tracked) charge_free(old.tag, old.size);
+    return NULL;
+  }
+  if (tracked) charge_free(old.tag, old.size);
+  track(p, size, tracked ? old.tag : (uint32_t)t_current, true);
+  return p;
+}
+
+void civ_mem_free(void *ptr) {
+  if (!ptr) return;
+  block_entry_t old;
+  if (untrack(ptr, &old)) charge_free(old.tag, old.size);
+  free(ptr);
+}
+
+void civ_mem_note_pool(civ_mem_tag_t tag, size_t size, bool allocated) {
+  if ((unsigned)tag >= CIV_MEM_TAG_COUNT) tag = CIV_MEM_TAG_GENERAL;
+  tag_counter_t *t = &g_tags[tag];
+  SDL_LockSpinlock(&t->lock);
+  if (allocated) {
+    t->s.pool_live_bytes += size;
+    if (t->s.pool_live_bytes > t->s.pool_peak_bytes)
+      t->s.pool_peak_bytes = t->s.pool_live_bytes;
+    t->s.pool_allocations++;
+  } else {
+    t->s.pool_live_bytes -= MIN(size, t->s.pool_live_bytes);
+  }
+  SDL_UnlockSpinlock(&t->lock);
+}
+
+void civ_mem_note_arena(size_t size) {
+  tag_counter_t *t = &g_tags[t_current];
+  SDL_LockSpinlock(&t->lock);
+  t->s.arena_pushes++;
+  t->arena_total += size;
+  SDL_UnlockSpinlock(&t->lock);
+}
+
+/* ── Reporting ─────────────────────────────────────────────────────── */
+
+bool civ_mem_tags_enabled(void) { return true; }
+
+bool civ_mem_tags_get(civ_mem_tag_t tag, civ_mem_tag_stats_t *out) {
+  if ((unsigned)tag >= CIV_MEM_TAG_COUNT || !out) return false;
+  tag_counter_t *t = &g_tags[tag];
+  SDL_LockSpinlock(&t->lock);
+  *out = t->s;
+  SDL_UnlockSpinlock(&t->lock);
+  return true;
+}
+
+bool civ_mem_tags_thread_totals(uint64_t *allocations, uint64_t *bytes) {
+  if (allocations) *allocations = t_allocations;
+  if (bytes) *bytes = t_bytes;
+  return true;
+}
+
+void civ_mem_tags_mark(void) {
+  g_turns = 0;
+  for (int i = 0; i < CIV_MEM_TAG_COUNT; i++) {
+    tag_counter_t *t = &g_tags[i];
+    SDL_LockSpinlock(&t->lock);
+    t->mark_allocations = t->s.allocations;
+    t->mark_bytes = t->bytes_total;
+    t->mark_arena = t->arena_total;
+    t->turn_sum = 0;
+    t->s.allocations_per_turn = 0.0;
+    SDL_UnlockSpinlock(&t->lock);
+  }
+}
+
+void civ_mem_tags_end_turn(void) {
+  g_turns++;
+  for (int i = 0; i < CIV_MEM_TAG_COUNT; i++) {
+    tag_counter_t *t = &g_tags[i];
+    SDL_LockSpinlock(&t->lock);
+    t->s.turn_allocations = t->s.allocations - t->mark_allocations;
+    t->s.turn_bytes = (size_t)(t->bytes_total - t->mark_bytes);
+    t->s.arena_turn_bytes = (size_t)(t->arena_total - t->mark_arena);
+    t->turn_sum += t->s.turn_allocations;
+    t->s.allocations_per_turn = (double)t->turn_sum / (double)g_turns;
+    t->mark_allocations = t->s.allocations;
+    t->mark_bytes = t->bytes_total;
+    t->mark_arena = t->arena_total;
+    SDL_UnlockSpinlock(&t->lock);
+  }
+}
+
+static const char *fmt_bytes(char *buf, size_t size, size_t bytes) {
+  if (bytes >= (size_t)1 << 30)
+    snprintf(buf, size, "%.2fG", (double)bytes / (double)(1u << 30));
+  else if (bytes >= (size_t)1 << 20)
+    snprintf(buf, size, "%.2fM", (double)bytes / (double)(1u << 20));
+  else if (bytes >= (size_t)1 << 10)
+    snprintf(buf, size, "%.1fK", (double)bytes / 1024.0);
+  else
+    snprintf(buf, size, "%zuB", bytes);
+  return buf;
+}
+
+void civ_mem_tags_dump(FILE *out) {
+  if (!out) return;
+  char live[16], peak[16], pool[16], pool_peak[16], arena[16];
+  civ_mem_tag_stats_t total;
+  memset(&total, 0, sizeof(total));
+
+  fprintf(out, "[MEM] %-10s %9s %9s %10s %10s %9s %9s %9s %9s\n", "tag",
+          "live", "peak", "allocs", "frees", "allocs/t", "pooled",
+          "pool pk", "arena/t");
+  for (int i = 0; i < CIV_MEM_TAG_COUNT; i++) {
+    civ_mem_tag_stats_t s;
+    civ_mem_tags_get((civ_mem_tag_t)i, &s);
+    if (s.allocations == 0 && s.pool_allocations == 0 && s.arena_pushes == 0)
+      continue;
+    fprintf(out, "[MEM] %-10s %9s %9s %10llu %10llu %9.1f %9s %9s %9s\n",
+            TAG_NAMES[i], fmt_bytes(live, sizeof(live), s.live_bytes),
+            fmt_bytes(peak, sizeof(peak), s.peak_bytes),
+            (unsigned long long)s.allocations, (unsigned long long)s.frees,
+            s.allocations_per_turn,
+            fmt_bytes(pool, sizeof(pool), s.pool_live_bytes),
+            fmt_bytes(pool_peak, sizeof(pool_peak), s.pool_peak_bytes),
+            fmt_bytes(arena, sizeof(arena), s.arena_turn_bytes));
+    total.live_bytes += s.live_bytes;
+    total.peak_bytes += s.peak_bytes;
+    total.allocations += s.allocations;
+    total.frees += s.frees;
+    total.allocations_per_turn += s.allocations_per_turn;
+    total.pool_live_bytes += s.pool_live_bytes;
+  }
+  /* Peaks of different tags need not coincide, so theirs is an upper bound */
+  fprintf(out, "[MEM] %-10s %9s %9s %10llu %10llu %9.1f %9s  (%llu turns)\n",
+          "total", fmt_bytes(live, sizeof(live), total.live_bytes),
+          fmt_bytes(peak, sizeof(peak), total.peak_bytes),
+          (unsigned long long)total.allocations,
+          (unsigned long long)total.frees, total.allocations_per_turn,
+          fmt_bytes(pool, sizeof(pool), total.pool_live_bytes),
+          (unsigned long long)g_turns);
+}
+
+#else /* !CIV_MEM_TAGS */
+
+bool civ_mem_tags_enabled(void) { return false; }
+
+bool civ_mem_tags_get(civ_mem_tag_t tag, civ_mem_tag_stats_t *out) {
+  (void)tag;
+  if (out) memset(out, 0, sizeof(*out));
+  return false;
+}
+
+bool civ_mem_tags_thread_totals(uint64_t *allocations, uint64_t *bytes) {
+  if (allocations) *allocations = 0;
+  if (bytes) *bytes = 0;
+  return false;
+}
+
+void civ_mem_tags_mark(void) {}
+
+void civ_mem_tags_end_turn(void) {}
+
+void civ_mem_tags_dump(FILE *out) { (void)out; }
+
+#endif /* CIV_MEM_TAGS */
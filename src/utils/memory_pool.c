@@ -5,9 +5,57 @@
 
 #include "utils/memory_pool.h"
 #include "common.h"
+#include <SDL3/SDL.h>
 #include <stdlib.h>
 #include <string.h>
 
+#define POOL_HEADER_BYTES 16 /* keeps payloads 16-byte aligned */
+#define POOL_CLASS_LARGE  0xFFFFu
+#define POOL_MAGIC_USED   0x4C4F4F50u /* POOL */
+#define POOL_MAGIC_FREE   0x45455246u /* FREE */
+#define POOL_SLAB_BYTES   16384       /* target slab size for small classes */
+
+typedef struct {
+  uint32_t magic;
+  uint32_t size_class;
+  uint32_t tag;        /* memory tag the block was handed out under */
+} block_header_t;
+
+struct civ_memory_slab {
+  civ_memory_slab_t *next;
+  size_t block_count;
+};
+
+#define SLAB_DATA_OFFSET                                                       \
+  ((sizeof(civ_memory_slab_t) + POOL_HEADER_BYTES - 1) &                       \
+   ~(size_t)(POOL_HEADER_BYTES - 1))
+
+static block_header_t *header_of(void *ptr) {
+  return (block_header_t *)((char *)ptr - POOL_HEADER_BYTES);
+}
+
+/* Free block's link to the next one, stored in its payload */
+static void **next_of(void *ptr) { return (void **)ptr; }
+
+static size_t class_of(size_t size) {
+  size_t c = 0, block = CIV_POOL_MIN_BLOCK;
+  while (block < size) {
+    block <<= 1;
+    c++;
+  }
+  return c;
+}
+
+static void pool_lock(const civ_memory_pool_manager_t *manager) {
+  if (manager->lock)
+    SDL_LockMutex((SDL_Mutex *)manager->lock);
+}
+
+static void pool_unlock(const civ_memory_pool_manager_t *manager) {
+  if (manager->lock)
+    SDL_UnlockMutex((SDL_Mutex *)manager->lock);
+}
+
 civ_memory_pool_manager_t *
 civ_memory_pool_manager_create(size_t default_block_size,
                                size_t default_block_count) {
@@ -19,10 +67,22 @@ civ_memory_pool_manager_create(size_t default_block_size,
   }
 
   memset(manager, 0, sizeof(civ_memory_pool_manager_t));
-  manager->default_block_size =
-      default_block_size > 0 ? default_block_size : 1024;
+  size_t largest = default_block_size > 0 ? default_block_size : 1024;
   manager->default_block_count =
       default_block_count > 0 ? default_block_count : 100;
+  manager->pool_count = MIN(class_of(largest) + 1, (size_t)CIV_POOL_CLASS_MAX);
+  manager->default_block_size = (size_t)CIV_POOL_MIN_BLOCK
+                                << (manager->pool_count - 1);
+
+  for (size_t c = 0; c < manager->pool_count; c++) {
+    civ_memory_pool_t *pool = &manager->pools[c];
+    pool->block_size = (size_t)CIV_POOL_MIN_BLOCK << c;
+    size_t stride = POOL_HEADER_BYTES + pool->block_size;
+    pool->slab_blocks =
+        MAX(manager->default_block_count, POOL_SLAB_BYTES / stride);
+    pool->stats.block_size = pool->block_size;
+  }
+  manager->lock = SDL_CreateMutex();
 
   return manager;
 }
@@ -31,115 +91,265 @@ void civ_memory_pool_manager_destroy(civ_memory_pool_manager_t *manager) {
   if (!manager)
     return;
 
-  civ_memory_pool_t *pool = manager->pools;
-  while (pool) {
-    civ_memory_pool_t *next = pool->next;
-    CIV_FREE(pool->used_blocks);
-    CIV_FREE(pool->memory);
-    CIV_FREE(pool);
-    pool = next;
+  for (size_t c = 0; c < manager->pool_count; c++) {
+    civ_memory_slab_t *slab = manager->pools[c].slabs;
+    while (slab) {
+      civ_memory_slab_t *next = slab->next;
+      CIV_FREE(slab);
+      slab = next;
+    }
   }
+  if (manager->lock)
+    SDL_DestroyMutex((SDL_Mutex *)manager->lock);
 
   CIV_FREE(manager);
 }
 
-static civ_memory_pool_t *create_pool(size_t block_size, size_t block_count) {
-  civ_memory_pool_t *pool =
-      (civ_memory_pool_t *)CIV_MALLOC(sizeof(civ_memory_pool_t));
-  if (!pool)
+/* Thread every block of slab onto the pool's free list */
+static void carve_slab(civ_memory_pool_t *pool, civ_memory_slab_t *slab,
+                       uint32_t size_class) {
+  size_t stride = POOL_HEADER_BYTES + pool->block_size;
+  char *data = (char *)slab + SLAB_DATA_OFFSET;
+  for (size_t i = slab->block_count; i-- > 0;) {
+    block_header_t *h = (block_header_t *)(data + i * stride);
+    h->magic = POOL_MAGIC_FREE;
+    h->size_class = size_class;
+    void *payload = (char *)h + POOL_HEADER_BYTES;
+    *next_of(payload) = pool->free_list;
+    pool->free_list = payload;
+  }
+}
+
+static bool grow_pool(civ_memory_pool_t *pool, uint32_t size_class) {
+  size_t stride = POOL_HEADER_BYTES + pool->block_size;
+  civ_memory_slab_t *slab = (civ_memory_slab_t *)CIV_MALLOC(
+      SLAB_DATA_OFFSET + pool->slab_blocks * stride);
+  if (!slab)
+    return false;
+  slab->block_count = pool->slab_blocks;
+  slab->next = pool->slabs;
+  pool->slabs = slab;
+  carve_slab(pool, slab, size_class);
+  pool->stats.slab_count++;
+  pool->stats.block_count += slab->block_count;
+  return true;
+}
+
+/* Caller holds the lock */
+static void *pool_pop(civ_memory_pool_t *pool, uint32_t size_class) {
+  if (!pool->free_list && !grow_pool(pool, size_class))
     return NULL;
+  void *payload = pool->free_list;
+  pool->free_list = *next_of(payload);
+  header_of(payload)->magic = POOL_MAGIC_USED;
+  pool->stats.allocations++;
+  if (++pool->stats.in_use > pool->stats.peak_in_use)
+    pool->stats.peak_in_use = pool->stats.in_use;
+  return payload;
+}
 
-  memset(pool, 0, sizeof(civ_memory_pool_t));
-  pool->block_size = block_size;
-  pool->block_count = block_count;
-  pool->free_count = block_count;
+static void pool_push(civ_memory_pool_t *pool, void *payload) {
+  header_of(payload)->magic = POOL_MAGIC_FREE;
+  *next_of(payload) = pool->free_list;
+  pool->free_list = payload;
+  pool->stats.frees++;
+  pool->stats.in_use--;
+}
 
-  pool->memory = CIV_MALLOC(block_size * block_count);
-  pool->used_blocks = (bool *)CIV_CALLOC(block_count, sizeof(bool));
+/* Tag a block on its way to the caller, and credit it back on return */
+static void *hand_out(void *payload, size_t block_size) {
+  civ_mem_tag_t tag = civ_mem_tag_current();
+  header_of(payload)->tag = (uint32_t)tag;
+  civ_mem_note_pool(tag, block_size, true);
+  return payload;
+}
 
-  if (!pool->memory || !pool->used_blocks) {
-    CIV_FREE(pool->memory);
-    CIV_FREE(pool->used_blocks);
-    CIV_FREE(pool);
-    return NULL;
-  }
+static void take_back(const block_header_t *h, size_t block_size) {
+  civ_mem_note_pool((civ_mem_tag_t)h->tag, block_size, false);
+}
 
-  return pool;
+/* Header of a live block, or NULL after logging what is wrong with it */
+static block_header_t *checked_header(void *ptr) {
+  block_header_t *h = header_of(ptr);
+  if (h->magic == POOL_MAGIC_USED)
+    return h;
+  civ_log(CIV_LOG_ERROR, h->magic == POOL_MAGIC_FREE
+                             ? "Memory pool: block freed twice"
+                             : "Memory pool: pointer not from a pool");
+  return NULL;
 }
 
 void *civ_memory_pool_allocate(civ_memory_pool_manager_t *manager,
                                size_t size) {
   if (!manager)
     return NULL;
+  if (size == 0)
+    size = 1;
 
-  /* Find pool with appropriate block size */
-  civ_memory_pool_t *pool = manager->pools;
-  while (pool) {
-    if (pool->block_size >= size && pool->free_count > 0) {
-      /* Find free block */
-      for (size_t i = 0; i < pool->block_count; i++) {
-        if (!pool->used_blocks[i]) {
-          pool->used_blocks[i] = true;
-          pool->free_count--;
-          return (char *)pool->memory + (i * pool->block_size);
-        }
-      }
-    }
-    pool = pool->next;
-  }
-
-  /* Create new pool if needed */
-  size_t block_size =
-      size > manager->default_block_size ? size : manager->default_block_size;
-  pool = create_pool(block_size, manager->default_block_count);
-  if (!pool) {
-    /* Fallback to regular malloc */
-    return CIV_MALLOC(size);
+  if (size > manager->default_block_size) {
+    block_header_t *h =
+        (block_header_t *)CIV_MALLOC(POOL_HEADER_BYTES + size);
+    if (!h)
+      return NULL;
+    h->magic = POOL_MAGIC_USED;
+    h->size_class = POOL_CLASS_LARGE;
+    pool_lock(manager);
+    manager->large_allocations++;
+    manager->large_in_use++;
+    pool_unlock(manager);
+    return (char *)h + POOL_HEADER_BYTES;
   }
 
-  pool->next = manager->pools;
-  manager->pools = pool;
-  manager->pool_count++;
-
-  /* Allocate from new pool */
-  pool->used_blocks[0] = true;
-  pool->free_count--;
-  return pool->memory;
+  uint32_t c = (uint32_t)class_of(size);
+  pool_lock(manager);
+  void *payload = pool_pop(&manager->pools[c], c);
+  pool_unlock(manager);
+  return payload ? hand_out(payload, manager->pools[c].block_size) : NULL;
 }
 
 void civ_memory_pool_free(civ_memory_pool_manager_t *manager, void *ptr) {
   if (!manager || !ptr)
     return;
+  block_header_t *h = checked_header(ptr);
+  if (!h)
+    return;
 
-  /* Find which pool this pointer belongs to */
-  civ_memory_pool_t *pool = manager->pools;
-  while (pool) {
-    if ((char *)ptr >= (char *)pool->memory &&
-        (char *)ptr <
-            (char *)pool->memory + (pool->block_size * pool->block_count)) {
-      size_t block_index =
-          ((char *)ptr - (char *)pool->memory) / pool->block_size;
-      if (block_index < pool->block_count && pool->used_blocks[block_index]) {
-        pool->used_blocks[block_index] = false;
-        pool->free_count++;
+  if (h->size_class == POOL_CLASS_LARGE) {
+    h->magic = POOL_MAGIC_FREE;
+    pool_lock(manager);
+    manager->large_in_use--;
+    pool_unlock(manager);
+    CIV_FREE(h);
+    return;
+  }
+  if (h->size_class >= manager->pool_count) {
+    civ_log(CIV_LOG_ERROR, "Memory pool: block from another manager");
+    return;
+  }
+  take_back(h, manager->pools[h->size_class].block_size);
+  pool_lock(manager);
+  pool_push(&manager->pools[h->size_class], ptr);
+  pool_unlock(manager);
+}
+
+void civ_memory_pool_reset(civ_memory_pool_manager_t *manager) {
+  if (!manager)
+    return;
+
+  pool_lock(manager);
+  for (size_t c = 0; c < manager->pool_count; c++) {
+    civ_memory_pool_t *pool = &manager->pools[c];
+    pool->free_list = NULL;
+    for (civ_memory_slab_t *slab = pool->slabs; slab; slab = slab->next) {
+#ifdef CIV_MEM_TAGS
+      /* Credit the blocks still out to the tags that took them */
+      size_t stride = POOL_HEADER_BYTES + pool->block_size;
+      char *data = (char *)slab + SLAB_DATA_OFFSET;
+      for (size_t i = 0; i < slab->block_count; i++) {
+        block_header_t *h = (block_header_t *)(data + i * stride);
+        if (h->magic == POOL_MAGIC_USED) take_back(h, pool->block_size);
       }
-      return;
+#endif
+      carve_slab(pool, slab, (uint32_t)c);
     }
-    pool = pool->next;
+    pool->stats.in_use = 0;
   }
+  pool_unlock(manager);
+}
 
-  /* Not found in pool, use regular free */
-  CIV_FREE(ptr);
+bool civ_memory_pool_get_stats(const civ_memory_pool_manager_t *manager,
+                               size_t size, civ_memory_pool_stats_t *out) {
+  if (!manager || !out || size > manager->default_block_size)
+    return false;
+  pool_lock(manager);
+  *out = manager->pools[class_of(size ? size : 1)].stats;
+  pool_unlock(manager);
+  return true;
 }
 
-void civ_memory_pool_reset(civ_memory_pool_manager_t *manager) {
-  if (!manager)
+/* ── Per-thread caches ─────────────────────────────────────────────── */
+
+void civ_memory_pool_cache_init(civ_memory_pool_cache_t *cache,
+                                civ_memory_pool_manager_t *manager) {
+  if (!cache)
     return;
+  memset(cache, 0, sizeof(*cache));
+  cache->manager = manager;
+}
 
-  civ_memory_pool_t *pool = manager->pools;
-  while (pool) {
-    memset(pool->used_blocks, 0, pool->block_count * sizeof(bool));
-    pool->free_count = pool->block_count;
-    pool = pool->next;
+void *civ_memory_pool_cache_allocate(civ_memory_pool_cache_t *cache,
+                                     size_t size) {
+  if (!cache || !cache->manager)
+    return NULL;
+  civ_memory_pool_manager_t *manager = cache->manager;
+  if (size == 0)
+    size = 1;
+  if (size > manager->default_block_size)
+    return civ_memory_pool_allocate(manager, size);
+
+  uint32_t c = (uint32_t)class_of(size);
+  if (!cache->free_list[c]) {
+    pool_lock(manager);
+    for (int i = 0; i < CIV_POOL_CACHE_BATCH; i++) {
+      void *payload = pool_pop(&manager->pools[c], c);
+      if (!payload)
+        break;
+      header_of(payload)->magic = POOL_MAGIC_FREE;
+      *next_of(payload) = cache->free_list[c];
+      cache->free_list[c] = payload;
+      cache->count[c]++;
+    }
+    pool_unlock(manager);
+    if (!cache->free_list[c])
+      return NULL;
+  }
+  void *payload = cache->free_list[c];
+  cache->free_list[c] = *next_of(payload);
+  cache->count[c]--;
+  header_of(payload)->magic = POOL_MAGIC_USED;
+  return hand_out(payload, manager->pools[c].block_size);
+}
+
+/* Give up to n cached blocks of class c back; caller holds the lock */
+static void cache_spill(civ_memory_pool_cache_t *cache, uint32_t c, size_t n) {
+  civ_memory_pool_t *pool = &cache->manager->pools[c];
+  while (n-- > 0 && cache->free_list[c]) {
+    void *payload = cache->free_list[c];
+    cache->free_list[c] = *next_of(payload);
+    cache->count[c]--;
+    pool_push(pool, payload);
+  }
+}
+
+void civ_memory_pool_cache_free(civ_memory_pool_cache_t *cache, void *ptr) {
+  if (!cache || !cache->manager || !ptr)
+    return;
+  block_header_t *h = checked_header(ptr);
+  if (!h)
+    return;
+  if (h->size_class == POOL_CLASS_LARGE ||
+      h->size_class >= cache->manager->pool_count) {
+    civ_memory_pool_free(cache->manager, ptr);
+    return;
+  }
+
+  uint32_t c = h->size_class;
+  take_back(h, cache->manager->pools[c].block_size);
+  h->magic = POOL_MAGIC_FREE;
+  *next_of(ptr) = cache->free_list[c];
+  cache->free_list[c] = ptr;
+  if (++cache->count[c] > 2 * CIV_POOL_CACHE_BATCH) {
+    pool_lock(cache->manager);
+    cache_spill(cache, c, CIV_POOL_CACHE_BATCH);
+    pool_unlock(cache->manager);
   }
 }
+
+void civ_memory_pool_cache_flush(civ_memory_pool_cache_t *cache) {
+  if (!cache || !cache->manager)
+    return;
+  pool_lock(cache->manager);
+  for (uint32_t c = 0; c < CIV_POOL_CLASS_MAX; c++)
+    cache_spill(cache, c, cache->count[c]);
+  pool_unlock(cache->manager);
+}
@@ -5,6 +5,18 @@
 
 #include "utils/noise.h"
 #include <math.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CIV_NOISE_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CIV_NOISE_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CIV_NOISE_NEON 1
+#endif
 
 /* Permutation table for Perlin noise */
 static const int perm[512] = {
@@ -132,3 +144,316 @@ civ_float_t civ_noise_octave3d(civ_float_t x, civ_float_t y, civ_float_t z,
   }
   return (total / maxValue) + 0.5f;
 }
+
+/* ── Row batches ───────────────────────────────────────────────────── */
+#define ROW_CHUNK 8
+
+/* Per-(row, octave) lattice state; y is constant along the row */
+typedef struct {
+  double x_origin;    /* lattice x of sample 0, before wrapping */
+  double x_step;
+  int    Y;
+  float  fy, fy1, v;  /* y fraction, fraction - 1, fade(y fraction) */
+} noise_row_t;
+
+static double wrap256(double t) {
+  t = fmod(t, 256.0);
+  return t < 0.0 ? t + 256.0 : t;
+}
+
+static void row_setup(noise_row_t *r, double x0, double dx, double y,
+                      double freq, uint32_t seed) {
+  /* Same seed offsets as civ_noise_perlin */
+  double off_x = (double)((float)(seed & 0xFFFF) * 0.131f);
+  double off_y = (double)((float)((seed >> 16) & 0xFFFF) * 0.173f);
+  double yy = wrap256(y * freq + off_y);
+  double fy = yy - floor(yy);
+  r->x_origin = x0 * freq + off_x;
+  r->x_step = dx * freq;
+  r->Y = (int)floor(yy) & 255;
+  r->fy = (float)fy;
+  r->fy1 = (float)fy - 1.0f;
+  r->v = (float)fade(fy);
+}
+
+static float fadef(float t) {
+  return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+static float gradf(int hash, float x, float y) {
+  int h = hash & 15;
+  float u = h < 8 ? x : y;
+  float v = h < 4 ? y : h == 12 || h == 14 ? x : 0.0f;
+  return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
+}
+
+/* Lane j of a chunk sits at base + j * step; base is wrapped to [0, 256) */
+static void chunk_scalar(const noise_row_t *r, float base, float step,
+                         int len, float amp, float *out) {
+  for (int j = 0; j < len; j++) {
+    float x = base + (float)j * step;
+    float xf = floorf(x);
+    int X = (int)xf & 255;
+    x -= xf;
+    float u = fadef(x);
+    int A = perm[X] + r->Y;
+    int B = perm[X + 1] + r->Y;
+    float a = gradf(perm[A], x, r->fy);
+    float b = gradf(perm[B], x - 1.0f, r->fy);
+    float c = gradf(perm[A + 1], x, r->fy1);
+    float d = gradf(perm[B + 1], x - 1.0f, r->fy1);
+    float ab = a + u * (b - a);
+    float cd = c + u * (d - c);
+    out[j] += amp * (ab + r->v * (cd - ab));
+  }
+}
+
+#if CIV_NOISE_AVX2
+static __m256 grad8(__m256i h, __m256 x, __m256 y) {
+  h = _mm256_and_si256(h, _mm256_set1_epi32(15));
+  __m256 mu = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(8), h));
+  __m256 mvy = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(4), h));
+  __m256 mvx = _mm256_castsi256_ps(
+      _mm256_or_si256(_mm256_cmpeq_epi32(h, _mm256_set1_epi32(12)),
+                      _mm256_cmpeq_epi32(h, _mm256_set1_epi32(14))));
+  __m256 u = _mm256_blendv_ps(y, x, mu);
+  __m256 v = _mm256_blendv_ps(_mm256_and_ps(mvx, x), y, mvy);
+  __m256 su = _mm256_castsi256_ps(
+      _mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(1)), 31));
+  __m256 sv = _mm256_castsi256_ps(
+      _mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(2)), 30));
+  return _mm256_add_ps(_mm256_xor_ps(u, su), _mm256_xor_ps(v, sv));
+}
+
+static void chunk_simd(const noise_row_t *r, float base, float step, int len,
+                       float amp, float *out) {
+  const __m256 one = _mm256_set1_ps(1.0f);
+  __m256 lanes = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+  __m256 x = _mm256_add_ps(_mm256_set1_ps(base),
+                           _mm256_mul_ps(lanes, _mm256_set1_ps(step)));
+  __m256 xf = _mm256_floor_ps(x);
+  __m256i X = _mm256_and_si256(_mm256_cvtps_epi32(xf), _mm256_set1_epi32(255));
+  x = _mm256_sub_ps(x, xf);
+
+  __m256i Y = _mm256_set1_epi32(r->Y);
+  __m256i i1 = _mm256_set1_epi32(1);
+  __m256i A = _mm256_add_epi32(_mm256_i32gather_epi32(perm, X, 4), Y);
+  __m256i B = _mm256_add_epi32(
+      _mm256_i32gather_epi32(perm, _mm256_add_epi32(X, i1), 4), Y);
+  __m256i hAA = _mm256_i32gather_epi32(perm, A, 4);
+  __m256i hBA = _mm256_i32gather_epi32(perm, B, 4);
+  __m256i hAB = _mm256_i32gather_epi32(perm, _mm256_add_epi32(A, i1), 4);
+  __m256i hBB = _mm256_i32gather_epi32(perm, _mm256_add_epi32(B, i1), 4);
+
+  __m256 u = _mm256_mul_ps(_mm256_mul_ps(x, x), x);
+  u = _mm256_mul_ps(u, _mm256_add_ps(_mm256_mul_ps(x, _mm256_sub_ps(
+          _mm256_mul_ps(x, _mm256_set1_ps(6.0f)), _mm256_set1_ps(15.0f))),
+      _mm256_set1_ps(10.0f)));
+  __m256 x1 = _mm256_sub_ps(x, one);
+  __m256 fy = _mm256_set1_ps(r->fy), fy1 = _mm256_set1_ps(r->fy1);
+  __m256 a = grad8(hAA, x, fy), b = grad8(hBA, x1, fy);
+  __m256 c = grad8(hAB, x, fy1), d = grad8(hBB, x1, fy1);
+  __m256 ab = _mm256_add_ps(a, _mm256_mul_ps(u, _mm256_sub_ps(b, a)));
+  __m256 cd = _mm256_add_ps(c, _mm256_mul_ps(u, _mm256_sub_ps(d, c)));
+  __m256 n = _mm256_add_ps(ab, _mm256_mul_ps(_mm256_set1_ps(r->v),
+                                             _mm256_sub_ps(cd, ab)));
+  n = _mm256_mul_ps(n, _mm256_set1_ps(amp));
+
+  if (len == ROW_CHUNK) {
+    _mm256_storeu_ps(out, _mm256_add_ps(_mm256_loadu_ps(out), n));
+  } else {
+    float tmp[ROW_CHUNK];
+    _mm256_storeu_ps(tmp, n);
+    for (int j = 0; j < len; j++) out[j] += tmp[j];
+  }
+}
+#elif CIV_NOISE_SSE2
+static __m128 select4(__m128 mask, __m128 a, __m128 b) {
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static __m128 grad4(__m128i h, __m128 x, __m128 y) {
+  h = _mm_and_si128(h, _mm_set1_epi32(15));
+  __m128 mu = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(8)));
+  __m128 mvy = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4)));
+  __m128 mvx = _mm_castsi128_ps(
+      _mm_or_si128(_mm_cmpeq_epi32(h, _mm_set1_epi32(12)),
+                   _mm_cmpeq_epi32(h, _mm_set1_epi32(14))));
+  __m128 u = select4(mu, x, y);
+  __m128 v = select4(mvy, y, _mm_and_ps(mvx, x));
+  __m128 su = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), 31));
+  __m128 sv = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), 30));
+  return _mm_add_ps(_mm_xor_ps(u, su), _mm_xor_ps(v, sv));
+}
+
+static __m128 noise4(const noise_row_t *r, __m128 x) {
+  const __m128 one = _mm_set1_ps(1.0f);
+  /* floor without SSE4.1: truncate, then step down where that rounded up */
+  __m128i xi = _mm_cvttps_epi32(x);
+  __m128 xf = _mm_cvtepi32_ps(xi);
+  __m128 up = _mm_cmpgt_ps(xf, x);
+  xf = _mm_sub_ps(xf, _mm_and_ps(up, one));
+  xi = _mm_add_epi32(xi, _mm_castps_si128(up));
+  x = _mm_sub_ps(x, xf);
+
+  int X[4], hAA[4], hBA[4], hAB[4], hBB[4];
+  _mm_storeu_si128((__m128i *)X, _mm_and_si128(xi, _mm_set1_epi32(255)));
+  for (int j = 0; j < 4; j++) {
+    int A = perm[X[j]] + r->Y, B = perm[X[j] + 1] + r->Y;
+    hAA[j] = perm[A];
+    hBA[j] = perm[B];
+    hAB[j] = perm[A + 1];
+    hBB[j] = perm[B + 1];
+  }
+
+  __m128 u = _mm_mul_ps(_mm_mul_ps(x, x), x);
+  u = _mm_mul_ps(u, _mm_add_ps(_mm_mul_ps(x, _mm_sub_ps(
+          _mm_mul_ps(x, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f))),
+      _mm_set1_ps(10.0f)));
+  __m128 x1 = _mm_sub_ps(x, one);
+  __m128 fy = _mm_set1_ps(r->fy), fy1 = _mm_set1_ps(r->fy1);
+  __m128 a = grad4(_mm_loadu_si128((const __m128i *)hAA), x, fy);
+  __m128 b = grad4(_mm_loadu_si128((const __m128i *)hBA), x1, fy);
+  __m128 c = grad4(_mm_loadu_si128((const __m128i *)hAB), x, fy1);
+  __m128 d = grad4(_mm_loadu_si128((const __m128i *)hBB), x1, fy1);
+  __m128 ab = _mm_add_ps(a, _mm_mul_ps(u, _mm_sub_ps(b, a)));
+  __m128 cd = _mm_add_ps(c, _mm_mul_ps(u, _mm_sub_ps(d, c)));
+  return _mm_add_ps(ab, _mm_mul_ps(_mm_set1_ps(r->v), _mm_sub_ps(cd, ab)));
+}
+
+static void chunk_simd(const noise_row_t *r, float base, float step, int len,
+                       float amp, float *out) {
+  __m128 vb = _mm_set1_ps(base), vs = _mm_set1_ps(step), va = _mm_set1_ps(amp);
+  __m128 lo = _mm_add_ps(vb, _mm_mul_ps(_mm_setr_ps(0, 1, 2, 3), vs));
+  __m128 hi = _mm_add_ps(vb, _mm_mul_ps(_mm_setr_ps(4, 5, 6, 7), vs));
+  __m128 n0 = _mm_mul_ps(noise4(r, lo), va);
+  __m128 n1 = _mm_mul_ps(noise4(r, hi), va);
+  if (len == ROW_CHUNK) {
+    _mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), n0));
+    _mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), n1));
+  } else {
+    float tmp[ROW_CHUNK];
+    _mm_storeu_ps(tmp, n0);
+    _mm_storeu_ps(tmp + 4, n1);
+    for (int j = 0; j < len; j++) out[j] += tmp[j];
+  }
+}
+#elif CIV_NOISE_NEON
+static float32x4_t grad4(int32x4_t h, float32x4_t x, float32x4_t y) {
+  h = vandq_s32(h, vdupq_n_s32(15));
+  uint32x4_t mu = vcltq_s32(h, vdupq_n_s32(8));
+  uint32x4_t mvy = vcltq_s32(h, vdupq_n_s32(4));
+  uint32x4_t mvx = vorrq_u32(vceqq_s32(h, vdupq_n_s32(12)),
+                             vceqq_s32(h, vdupq_n_s32(14)));
+  float32x4_t u = vbslq_f32(mu, x, y);
+  float32x4_t v = vbslq_f32(mvy, y, vbslq_f32(mvx, x, vdupq_n_f32(0.0f)));
+  uint32x4_t hu = vreinterpretq_u32_s32(h);
+  uint32x4_t su = vshlq_n_u32(vandq_u32(hu, vdupq_n_u32(1)), 31);
+  uint32x4_t sv = vshlq_n_u32(vandq_u32(hu, vdupq_n_u32(2)), 30);
+  u = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(u), su));
+  v = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(v), sv));
+  return vaddq_f32(u, v);
+}
+
+static float32x4_t noise4(const noise_row_t *r, float32x4_t x) {
+  const float32x4_t one = vdupq_n_f32(1.0f);
+  int32x4_t xi = vcvtq_s32_f32(x);
+  float32x4_t xf = vcvtq_f32_s32(xi);
+  uint32x4_t up = vcgtq_f32(xf, x);
+  xf = vsubq_f32(xf, vbslq_f32(up, one, vdupq_n_f32(0.0f)));
+  xi = vaddq_s32(xi, vreinterpretq_s32_u32(up));
+  x = vsubq_f32(x, xf);
+
+  int32_t X[4], hAA[4], hBA[4], hAB[4], hBB[4];
+  vst1q_s32(X, vandq_s32(xi, vdupq_n_s32(255)));
+  for (int j = 0; j < 4; j++) {
+    int A = perm[X[j]] + r->Y, B = perm[X[j] + 1] + r->Y;
+    hAA[j] = perm[A];
+    hBA[j] = perm[B];
+    hAB[j] = perm[A + 1];
+    hBB[j] = perm[B + 1];
+  }
+
+  float32x4_t u = vmulq_f32(vmulq_f32(x, x), x);
+  u = vmulq_f32(u, vaddq_f32(vmulq_f32(x, vsubq_f32(vmulq_n_f32(x, 6.0f),
+                                                    vdupq_n_f32(15.0f))),
+                             vdupq_n_f32(10.0f)));
+  float32x4_t x1 = vsubq_f32(x, one);
+  float32x4_t fy = vdupq_n_f32(r->fy), fy1 = vdupq_n_f32(r->fy1);
+  float32x4_t a = grad4(vld1q_s32(hAA), x, fy), b = grad4(vld1q_s32(hBA), x1, fy);
+  float32x4_t c = grad4(vld1q_s32(hAB), x, fy1), d = grad4(vld1q_s32(hBB), x1, fy1);
+  float32x4_t ab = vaddq_f32(a, vmulq_f32(u, vsubq_f32(b, a)));
+  float32x4_t cd = vaddq_f32(c, vmulq_f32(u, vsubq_f32(d, c)));
+  return vaddq_f32(ab, vmulq_n_f32(vsubq_f32(cd, ab), r->v));
+}
+
+static void chunk_simd(const noise_row_t *r, float base, float step, int len,
+                       float amp, float *out) {
+  static const float lane_lo[4] = {0, 1, 2, 3}, lane_hi[4] = {4, 5, 6, 7};
+  float32x4_t vb = vdupq_n_f32(base);
+  float32x4_t lo = vmlaq_n_f32(vb, vld1q_f32(lane_lo), step);
+  float32x4_t hi = vmlaq_n_f32(vb, vld1q_f32(lane_hi), step);
+  float32x4_t n0 = vmulq_n_f32(noise4(r, lo), amp);
+  float32x4_t n1 = vmulq_n_f32(noise4(r, hi), amp);
+  if (len == ROW_CHUNK) {
+    vst1q_f32(out, vaddq_f32(vld1q_f32(out), n0));
+    vst1q_f32(out + 4, vaddq_f32(vld1q_f32(out + 4), n1));
+  } else {
+    float tmp[ROW_CHUNK];
+    vst1q_f32(tmp, n0);
+    vst1q_f32(tmp + 4, n1);
+    for (int j = 0; j < len; j++) out[j] += tmp[j];
+  }
+}
+#else
+#define chunk_simd chunk_scalar
+#endif
+
+/* out[i] += amp * perlin(sample i) for one octave */
+static void accumulate_row(const noise_row_t *r, int n, float amp, float *out) {
+  float step = (float)r->x_step;
+  for (int i = 0; i < n; i += ROW_CHUNK) {
+    float base = (float)wrap256(r->x_origin + (double)i * r->x_step);
+    chunk_simd(r, base, step, n - i < ROW_CHUNK ? n - i : ROW_CHUNK, amp,
+               out + i);
+  }
+}
+
+void civ_noise_perlin_row(double x0, double dx, double y, int n, uint32_t seed,
+                          float *out) {
+  if (!out || n <= 0) return;
+  noise_row_t r;
+  row_setup(&r, x0, dx, y, 1.0, seed);
+  memset(out, 0, (size_t)n * sizeof(float));
+  accumulate_row(&r, n, 1.0f, out);
+}
+
+void civ_noise_octave_row(double x0, double dx, double y, int n, int octaves,
+                          civ_float_t persistence, civ_float_t scale,
+                          uint32_t seed, float *out) {
+  if (!out || n <= 0) return;
+  memset(out, 0, (size_t)n * sizeof(float));
+  civ_float_t frequency = scale, amplitude = 1, maxValue = 0;
+  for (int o = 0; o < octaves; o++) {
+    noise_row_t r;
+    row_setup(&r, x0, dx, y, frequency, seed);
+    accumulate_row(&r, n, (float)amplitude, out);
+    maxValue += amplitude;
+    amplitude *= persistence;
+    frequency *= 2;
+  }
+  float inv = maxValue != 0 ? (float)(1.0 / maxValue) : 0.0f;
+  for (int i = 0; i < n; i++) out[i] = out[i] * inv + 0.5f;
+}
+
+const char *civ_noise_row_kernel(void) {
+#if CIV_NOISE_AVX2
+  return "avx2";
+#elif CIV_NOISE_SSE2
+  return "sse2";
+#elif CIV_NOISE_NEON
+  return "neon";
+#else
+  return "scalar";
+#endif
+}
@@ -0,0 +1,70 @@
+/**
+ * @file rng.c
+ * @brief SplitMix64 streams and the thread-bound civ_rand()
+ *
+ * SplitMix64 advances its state by a fixed Weyl increment and hashes it,
+ * so the state is simply key + n * gamma: a counter-based generator.
+ */
+
+#include "utils/rng.h"
+#include <stdlib.h>
+
+static CIV_THREAD_LOCAL civ_rng_t* tls_stream = NULL;
+
+static uint64_t splitmix64(uint64_t* x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+void civ_rng_seed(civ_rng_t* rng, uint64_t seed, uint64_t stream) {
+    if (!rng) return;
+    uint64_t mix = seed ^ (stream * 0xD1B54A32D192ED03ull);
+    rng->state = splitmix64(&mix);
+}
+
+void civ_rng_seed_key(civ_rng_t* rng, uint64_t seed, civ_rng_domain_t domain,
+                      uint64_t turn, uint64_t entity) {
+    if (!rng) return;
+    /* Hash each key component in turn so nearby keys land far apart */
+    uint64_t x = seed;
+    uint64_t key = splitmix64(&x);
+    x = key ^ ((uint64_t)domain * 0xD1B54A32D192ED03ull);
+    key = splitmix64(&x);
+    x = key ^ (turn * 0xAEF17502108EF2D9ull);
+    key = splitmix64(&x);
+    x = key ^ (entity * 0xF1357AEA2E62A9C5ull);
+    rng->state = splitmix64(&x);
+}
+
+uint32_t civ_rng_next_u32(civ_rng_t* rng) {
+    return (uint32_t)(splitmix64(&rng->state) >> 32);
+}
+
+uint32_t civ_rng_range(civ_rng_t* rng, uint32_t bound) {
+    if (bound == 0) return 0;
+    /* Lemire's multiply-shift with rejection of the short tail */
+    uint64_t m = (uint64_t)civ_rng_next_u32(rng) * bound;
+    uint32_t low = (uint32_t)m;
+    if (low < bound) {
+        uint32_t threshold = (uint32_t)(-bound) % bound;
+        while (low < threshold) {
+            m = (uint64_t)civ_rng_next_u32(rng) * bound;
+            low = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
+}
+
+civ_rng_t* civ_rng_bind(civ_rng_t* rng) {
+    civ_rng_t* prev = tls_stream;
+    tls_stream = rng;
+    return prev;
+}
+
+int civ_rand(void) {
+    if (!tls_stream) return rand();
+    /* Same range contract as rand(); RAND_MAX is at least 32767 */
+    return (int)(civ_rng_next_u32(tls_stream) % ((uint32_t)RAND_MAX + 1u));
+}
@@ -0,0 +1,243 @@
+/**
+ * @file startup_timeline.c
+ * @brief Cold-start step timings, reads and allocations
+ */
+
+#include "utils/startup_timeline.h"
+#include "common.h"
+#include "utils/io_service.h"
+#include "utils/mem_tags.h"
+#include "utils/rng.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef CIV_BUILD_ID
+#define CIV_BUILD_ID "dev"
+#endif
+
+typedef struct {
+  SDL_ThreadID thread;
+  Uint64 begin_ns;
+  uint64_t allocations, bytes; /* thread totals when it began */
+  bool counted;                /* mem tags were on at the start */
+} step_origin_t;
+
+static struct {
+  SDL_SpinLock lock;
+  Uint64 origin_ns;
+  SDL_ThreadID main_thread;
+  char csv_path[256];
+  bool csv_header;        /* the file is new: write the header first */
+  SDL_AtomicInt csv_failed;
+  char run[32];
+  bool ready;
+  int count;
+  civ_startup_step_t steps[CIV_STARTUP_MAX_STEPS];
+  step_origin_t origins[CIV_STARTUP_MAX_STEPS];
+} g_startup;
+
+/* Steps open on this thread, innermost last */
+static CIV_THREAD_LOCAL int t_open[CIV_STARTUP_MAX_DEPTH];
+static CIV_THREAD_LOCAL int t_depth;
+static CIV_THREAD_LOCAL char t_name[16];
+
+static double ms_since(Uint64 from, Uint64 to) {
+  return (double)(to - from) / 1e6;
+}
+
+void civ_startup_timeline_init(const char *csv_path) {
+  memset(&g_startup, 0, sizeof(g_startup));
+  g_startup.origin_ns = SDL_GetTicksNS();
+  g_startup.main_thread = SDL_GetCurrentThreadID();
+  if (csv_path) {
+    snprintf(g_startup.csv_path, sizeof(g_startup.csv_path), "%s", csv_path);
+    SDL_PathInfo info;
+    g_startup.csv_header =
+        !SDL_GetPathInfo(csv_path, &info) || info.size == 0;
+  }
+
+  time_t now = time(NULL);
+  struct tm *tm = localtime(&now);
+  snprintf(g_startup.run, sizeof(g_startup.run), "unknown");
+  if (tm) strftime(g_startup.run, sizeof(g_startup.run), "%Y%m%d_%H%M%S", tm);
+}
+
+void civ_startup_timeline_name_thread(const char *name) {
+  snprintf(t_name, sizeof(t_name), "%s", name ? name : "");
+}
+
+static void thread_label(char *out, size_t size) {
+  SDL_ThreadID id = SDL_GetCurrentThreadID();
+  if (t_name[0])
+    snprintf(out, size, "%s", t_name);
+  else if (id == g_startup.main_thread)
+    snprintf(out, size, "main");
+  else
+    snprintf(out, size, "%llx", (unsigned long long)id);
+}
+
+/* I/O service thread */
+static void csv_written(civ_result_t result, void *user) {
+  (void)user;
+  if (CIV_FAILED(result) &&
+      SDL_CompareAndSwapAtomicInt(&g_startup.csv_failed, 0, 1))
+    civ_log(CIV_LOG_WARNING, "Startup timeline: cannot write %s",
+            g_startup.csv_path);
+}
+
+/* Caller holds the lock; the row is appended off this thread */
+static void append_csv(const civ_startup_step_t *s) {
+  if (!g_startup.csv_path[0] || SDL_GetAtomicInt(&g_startup.csv_failed)) return;
+  char row[512];
+  int n = 0;
+  if (g_startup.csv_header) {
+    n = snprintf(row, sizeof(row), "build,run,step,thread,start_ms,wall_ms,"
+                                   "bytes_read,files,allocations,alloc_bytes\n");
+    g_startup.csv_header = false;
+  }
+  n += snprintf(row + n, sizeof(row) - (size_t)n,
+                "%s,%s,%s,%s,%.3f,%.3f,%llu,%u,%lld,%lld\n", CIV_BUILD_ID,
+                g_startup.run, s->name, s->thread, s->start_ms, s->wall_ms,
+                (unsigned long long)s->bytes_read, s->files,
+                (long long)s->allocations, (long long)s->alloc_bytes);
+  civ_io_write_copy(g_startup.csv_path, CIV_IO_APPEND, row,
+                    MIN((size_t)n, sizeof(row) - 1), CIV_IO_TELEMETRY,
+                    csv_written, NULL);
+}
+
+static void log_step(const civ_startup_step_t *s) {
+  char allocs[32] = "-";
+  if (s->allocations >= 0)
+    snprintf(allocs, sizeof(allocs), "%lld", (long long)s->allocations);
+  civ_log(CIV_LOG_INFO, "[startup] %*s%-*s %9.1f ms %8.2f MB %4u files %9s allocs  %s",
+          s->depth * 2, "", 24 - s->depth * 2, s->name, s->wall_ms,
+          (double)s->bytes_read / (1024.0 * 1024.0), s->files, allocs,
+          s->thread);
+}
+
+int civ_startup_step_begin(const char *name) {
+  uint64_t allocations = 0, bytes = 0;
+  bool counted = civ_mem_tags_thread_totals(&allocations, &bytes);
+  Uint64 now = SDL_GetTicksNS();
+
+  SDL_LockSpinlock(&g_startup.lock);
+  if (g_startup.count >= CIV_STARTUP_MAX_STEPS) {
+    SDL_UnlockSpinlock(&g_startup.lock);
+    return -1;
+  }
+  int step = g_startup.count++;
+  civ_startup_step_t *s = &g_startup.steps[step];
+  memset(s, 0, sizeof(*s));
+  snprintf(s->name, sizeof(s->name), "%s", name ? name : "?");
+  thread_label(s->thread, sizeof(s->thread));
+  s->start_ms = ms_since(g_startup.origin_ns, now);
+  s->allocations = s->alloc_bytes = -1;
+  s->depth = t_depth;
+  g_startup.origins[step] = (step_origin_t){SDL_GetCurrentThreadID(), now,
+                                            allocations, bytes, counted};
+  SDL_UnlockSpinlock(&g_startup.lock);
+
+  if (t_depth < CIV_STARTUP_MAX_DEPTH) t_open[t_depth++] = step;
+  return step;
+}
+
+void civ_startup_step_end(int step) {
+  if (step < 0) return;
+  uint64_t allocations = 0, bytes = 0;
+  civ_mem_tags_thread_totals(&allocations, &bytes);
+  Uint64 now = SDL_GetTicksNS();
+
+  /* Drop it from this thread's open steps, wherever it sits */
+  for (int i = 0; i < t_depth; i++) {
+    if (t_open[i] != step) continue;
+    memmove(&t_open[i], &t_open[i + 1], (size_t)(t_depth - i - 1) * sizeof(int));
+    t_depth--;
+    break;
+  }
+
+  SDL_LockSpinlock(&g_startup.lock);
+  if (step >= g_startup.count || g_startup.steps[step].done) {
+    SDL_UnlockSpinlock(&g_startup.lock);
+    return;
+  }
+  civ_startup_step_t *s = &g_startup.steps[step];
+  const step_origin_t *o = &g_startup.origins[step];
+  s->wall_ms = ms_since(o->begin_ns, now);
+  if (o->counted && o->thread == SDL_GetCurrentThreadID()) {
+    s->allocations = (int64_t)(allocations - o->allocations);
+    s->alloc_bytes = (int64_t)(bytes - o->bytes);
+  }
+  s->done = true;
+  append_csv(s);
+  civ_startup_step_t copy = *s;
+  bool late = g_startup.ready;
+  SDL_UnlockSpinlock(&g_startup.lock);
+
+  if (late) log_step(&copy);
+}
+
+void civ_startup_step_add_read(int step, uint64_t bytes) {
+  if (step < 0) return;
+  SDL_LockSpinlock(&g_startup.lock);
+  if (step < g_startup.count) {
+    g_startup.steps[step].bytes_read += bytes;
+    g_startup.steps[step].files++;
+  }
+  SDL_UnlockSpinlock(&g_startup.lock);
+}
+
+void civ_startup_note_read(uint64_t bytes) {
+  for (int i = 0; i < t_depth; i++)
+    civ_startup_step_add_read(t_open[i], bytes);
+}
+
+void civ_startup_timeline_ready(void) {
+  Uint64 now = SDL_GetTicksNS();
+  civ_startup_step_t ready;
+  memset(&ready, 0, sizeof(ready));
+  snprintf(ready.name, sizeof(ready.name), CIV_STARTUP_READY);
+  thread_label(ready.thread, sizeof(ready.thread));
+  ready.allocations = ready.alloc_bytes = -1;
+  ready.done = true;
+
+  SDL_LockSpinlock(&g_startup.lock);
+  if (g_startup.ready) {
+    SDL_UnlockSpinlock(&g_startup.lock);
+    return;
+  }
+  g_startup.ready = true;
+  ready.wall_ms = ms_since(g_startup.origin_ns, now);
+  for (int i = 0; i < g_startup.count; i++) {
+    ready.bytes_read += g_startup.steps[i].depth ? 0 : g_startup.steps[i].bytes_read;
+    ready.files += g_startup.steps[i].depth ? 0 : g_startup.steps[i].files;
+  }
+  append_csv(&ready);
+  int count = g_startup.count;
+  civ_startup_step_t steps[CIV_STARTUP_MAX_STEPS];
+  memcpy(steps, g_startup.steps, (size_t)count * sizeof(steps[0]));
+  SDL_UnlockSpinlock(&g_startup.lock);
+
+  civ_log(CIV_LOG_INFO, "[startup] build %s: world ready after %.1f ms, %.2f MB "
+                        "in %u files", CIV_BUILD_ID, ready.wall_ms,
+          (double)ready.bytes_read / (1024.0 * 1024.0), ready.files);
+  for (int i = 0; i < count; i++)
+    if (steps[i].done) log_step(&steps[i]);
+}
+
+bool civ_startup_timeline_get(int index, civ_startup_step_t *out) {
+  if (!out) return false;
+  SDL_LockSpinlock(&g_startup.lock);
+  bool ok = index >= 0 && index < g_startup.count;
+  if (ok) *out = g_startup.steps[index];
+  SDL_UnlockSpinlock(&g_startup.lock);
+  return ok;
+}
+
+int civ_startup_timeline_count(void) {
+  SDL_LockSpinlock(&g_startup.lock);
+  int count = g_startup.count;
+  SDL_UnlockSpinlock(&g_startup.lock);
+  return count;
+}
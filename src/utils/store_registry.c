@@ -0,0 +1,210 @@
+/**
+ * @file store_registry.c
+ * @brief Growable store population and capacity telemetry
+ */
+
+#include "utils/store_registry.h"
+#include <SDL3/SDL.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+  const void *owner; /* NULL = free slot */
+  const void *count, *capacity;
+  uint8_t count_size, capacity_size;
+  size_t first_count;
+  bool warned;
+  civ_store_stats_t stats;
+} store_t;
+
+static struct {
+  SDL_SpinLock lock;
+  int count; /* slots in use, free ones included */
+  store_t stores[CIV_STORE_MAX];
+} g_stores;
+
+static const char *LOOKUP_NAMES[] = {"append", "indexed", "scanned"};
+
+static size_t read_width(const void *p, uint8_t size) {
+  switch (size) {
+  case 1: return *(const uint8_t *)p;
+  case 2: return *(const uint16_t *)p;
+  case 4: return *(const uint32_t *)p;
+  case 8: return (size_t)*(const uint64_t *)p;
+  default: return 0;
+  }
+}
+
+void civ_store_register(const char *name, const void *owner,
+                        const void *count, size_t count_size,
+                        const void *capacity, size_t capacity_size,
+                        size_t elem_size, civ_store_lookup_t lookup) {
+  if (!owner || !count || !capacity) return;
+
+  SDL_LockSpinlock(&g_stores.lock);
+  int slot = -1;
+  for (int i = 0; i < g_stores.count && slot < 0; i++)
+    if (!g_stores.stores[i].owner) slot = i;
+  if (slot < 0 && g_stores.count < CIV_STORE_MAX) slot = g_stores.count++;
+  if (slot < 0) {
+    SDL_UnlockSpinlock(&g_stores.lock);
+    return;
+  }
+
+  store_t *s = &g_stores.stores[slot];
+  memset(s, 0, sizeof(*s));
+  s->owner = owner;
+  s->count = count;
+  s->capacity = capacity;
+  s->count_size = (uint8_t)count_size;
+  s->capacity_size = (uint8_t)capacity_size;
+  s->first_count = read_width(count, s->count_size);
+  snprintf(s->stats.name, sizeof(s->stats.name), "%s", name ? name : "?");
+  s->stats.lookup = lookup;
+  s->stats.elem_size = elem_size;
+  s->stats.count = s->stats.peak_count = s->first_count;
+  s->stats.capacity = read_width(capacity, s->capacity_size);
+  SDL_UnlockSpinlock(&g_stores.lock);
+}
+
+void civ_store_unregister_owner(const void *owner) {
+  if (!owner) return;
+  SDL_LockSpinlock(&g_stores.lock);
+  for (int i = 0; i < g_stores.count; i++)
+    if (g_stores.stores[i].owner == owner) g_stores.stores[i].owner = NULL;
+  while (g_stores.count > 0 && !g_stores.stores[g_stores.count - 1].owner)
+    g_stores.count--;
+  SDL_UnlockSpinlock(&g_stores.lock);
+}
+
+void civ_store_registry_mark(void) {
+  SDL_LockSpinlock(&g_stores.lock);
+  for (int i = 0; i < g_stores.count; i++) {
+    store_t *s = &g_stores.stores[i];
+    if (!s->owner) continue;
+    s->first_count = read_width(s->count, s->count_size);
+    s->stats.count = s->first_count;
+    s->stats.capacity = read_width(s->capacity, s->capacity_size);
+    s->stats.peak_count = MAX(s->stats.peak_count, s->first_count);
+    s->stats.turn_growth = 0;
+    s->stats.growth_per_turn = 0.0;
+    s->stats.turns = 0;
+  }
+  SDL_UnlockSpinlock(&g_stores.lock);
+}
+
+void civ_store_registry_end_turn(void) {
+  civ_store_stats_t crossed[CIV_STORE_MAX];
+  int crossings = 0;
+
+  SDL_LockSpinlock(&g_stores.lock);
+  for (int i = 0; i < g_stores.count; i++) {
+    store_t *s = &g_stores.stores[i];
+    if (!s->owner) continue;
+    civ_store_stats_t *st = &s->stats;
+    size_t count = read_width(s->count, s->count_size);
+    st->turn_growth = (int64_t)count - (int64_t)st->count;
+    st->count = count;
+    st->capacity = read_width(s->capacity, s->capacity_size);
+    st->peak_count = MAX(st->peak_count, count);
+    st->turns++;
+    st->growth_per_turn =
+        ((double)count - (double)s->first_count) / (double)st->turns;
+    st->flagged = st->lookup == CIV_STORE_SCANNED &&
+                  count > CIV_STORE_SCAN_THRESHOLD;
+    if (st->flagged && !s->warned) {
+      s->warned = true;
+      crossed[crossings++] = *st;
+    }
+  }
+  SDL_UnlockSpinlock(&g_stores.lock);
+
+  for (int i = 0; i < crossings; i++)
+    civ_log(CIV_LOG_WARNING,
+            "Store %s is scanned linearly and holds %zu entries "
+            "(+%.1f per turn); index it",
+            crossed[i].name, crossed[i].count, crossed[i].growth_per_turn);
+}
+
+bool civ_store_registry_get(int index, civ_store_stats_t *out) {
+  if (!out || index < 0) return false;
+  SDL_LockSpinlock(&g_stores.lock);
+  int seen = 0;
+  bool ok = false;
+  for (int i = 0; i < g_stores.count && !ok; i++) {
+    if (!g_stores.stores[i].owner) continue;
+    if (seen++ == index) {
+      *out = g_stores.stores[i].stats;
+      ok = true;
+    }
+  }
+  SDL_UnlockSpinlock(&g_stores.lock);
+  return ok;
+}
+
+int civ_store_registry_count(void) {
+  SDL_LockSpinlock(&g_stores.lock);
+  int live = 0;
+  for (int i = 0; i < g_stores.count; i++)
+    live += g_stores.stores[i].owner != NULL;
+  SDL_UnlockSpinlock(&g_stores.lock);
+  return live;
+}
+
+static int compare_reserved(const void *a, const void *b) {
+  const civ_store_stats_t *x = a, *y = b;
+  size_t rx = x->capacity * x->elem_size, ry = y->capacity * y->elem_size;
+  return rx < ry ? 1 : rx > ry ? -1 : strcmp(x->name, y->name);
+}
+
+/* Live stores into out, largest reservation first */
+static int snapshot(civ_store_stats_t *out) {
+  int n = 0;
+  SDL_LockSpinlock(&g_stores.lock);
+  for (int i = 0; i < g_stores.count; i++)
+    if (g_stores.stores[i].owner) out[n++] = g_stores.stores[i].stats;
+  SDL_UnlockSpinlock(&g_stores.lock);
+  qsort(out, (size_t)n, sizeof(*out), compare_reserved);
+  return n;
+}
+
+void civ_store_registry_dump(FILE *out) {
+  if (!out) return;
+  civ_store_stats_t stores[CIV_STORE_MAX];
+  int n = snapshot(stores);
+  fprintf(out, "  %-28s %-8s %10s %10s %10s %10s %9s\n", "store", "lookup",
+          "count", "capacity", "peak", "KB", "per turn");
+  for (int i = 0; i < n; i++) {
+    const civ_store_stats_t *s = &stores[i];
+    fprintf(out, "  %-28s %-8s %10zu %10zu %10zu %10.1f %+9.1f%s\n", s->name,
+            civ_store_lookup_name(s->lookup), s->count, s->capacity,
+            s->peak_count, (double)(s->capacity * s->elem_size) / 1024.0,
+            s->growth_per_turn, s->flagged ? "  SCAN" : "");
+  }
+}
+
+civ_result_t civ_store_registry_export_csv(const char *path) {
+  if (!path)
+    return (civ_result_t){CIV_ERROR_NULL_POINTER, "Null store export path"};
+  FILE *f = fopen(path, "w");
+  if (!f) return (civ_result_t){CIV_ERROR_IO, "Cannot write store table"};
+
+  civ_store_stats_t stores[CIV_STORE_MAX];
+  int n = snapshot(stores);
+  fprintf(f, "store,lookup,count,capacity,elem_size,bytes,peak,turn_growth,"
+             "growth_per_turn,flagged\n");
+  for (int i = 0; i < n; i++) {
+    const civ_store_stats_t *s = &stores[i];
+    fprintf(f, "%s,%s,%zu,%zu,%zu,%zu,%zu,%lld,%.3f,%d\n", s->name,
+            civ_store_lookup_name(s->lookup), s->count, s->capacity,
+            s->elem_size, s->capacity * s->elem_size, s->peak_count,
+            (long long)s->turn_growth, s->growth_per_turn, s->flagged ? 1 : 0);
+  }
+  fclose(f);
+  return (civ_result_t){CIV_OK, NULL};
+}
+
+const char *civ_store_lookup_name(civ_store_lookup_t lookup) {
+  if (lookup < 0 || lookup >= (int)ARRAY_SIZE(LOOKUP_NAMES)) return "?";
+  return LOOKUP_NAMES[lookup];
+}
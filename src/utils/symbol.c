@@ -0,0 +1,191 @@
+/**
+ * @file symbol.c
+ * @brief Open-addressing intern table behind civ_symbol_t
+ */
+
+#include "utils/symbol.h"
+#include "common.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SYMBOL_CHUNK_BYTES 4096
+
+/* Names live in chunks that are never moved, so civ_symbol_name stays valid */
+typedef struct symbol_chunk {
+    struct symbol_chunk* next;
+    size_t used;
+    size_t size;
+    char data[];
+} symbol_chunk_t;
+
+typedef struct {
+    const char* name;
+    uint32_t hash;
+    uint32_t flags;
+} symbol_entry_t;
+
+static struct {
+    symbol_entry_t* entries; /* entries[0] is CIV_SYMBOL_NONE */
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t* slots;         /* hash -> handle, CIV_SYMBOL_NONE = empty */
+    uint32_t slot_mask;
+    symbol_chunk_t* chunks;
+} s_symbols;
+
+static uint32_t hash_str(const char* str, size_t* len) {
+    uint32_t h = 2166136261u;
+    size_t n = 0;
+    while (str[n]) {
+        h ^= (uint8_t)str[n++];
+        h *= 16777619u;
+    }
+    *len = n;
+    return h;
+}
+
+static const char* store_name(const char* str, size_t len) {
+    symbol_chunk_t* chunk = s_symbols.chunks;
+    if (!chunk || chunk->size - chunk->used < len + 1) {
+        size_t size = MAX((size_t)SYMBOL_CHUNK_BYTES, len + 1);
+        chunk = (symbol_chunk_t*)CIV_MALLOC(sizeof(symbol_chunk_t) + size);
+        if (!chunk) return NULL;
+        chunk->used = 0;
+        chunk->size = size;
+        chunk->next = s_symbols.chunks;
+        s_symbols.chunks = chunk;
+    }
+    char* name = chunk->data + chunk->used;
+    memcpy(name, str, len + 1);
+    chunk->used += len + 1;
+    return name;
+}
+
+/* Keep the table at most half full */
+static bool reserve_slots(uint32_t entries) {
+    if (s_symbols.slots && entries * 2 <= s_symbols.slot_mask + 1) return true;
+    uint32_t size = 256;
+    while (size < entries * 2) size <<= 1;
+    uint32_t* slots = (uint32_t*)CIV_CALLOC(size, sizeof(uint32_t));
+    if (!slots) return false;
+    for (uint32_t i = 1; i < s_symbols.count; i++) {
+        uint32_t h = s_symbols.entries[i].hash & (size - 1);
+        while (slots[h] != CIV_SYMBOL_NONE) h = (h + 1) & (size - 1);
+        slots[h] = i;
+    }
+    CIV_FREE(s_symbols.slots);
+    s_symbols.slots = slots;
+    s_symbols.slot_mask = size - 1;
+    return true;
+}
+
+static civ_symbol_t lookup(const char* str, size_t len, uint32_t hash, uint32_t* slot_out) {
+    uint32_t h = hash & s_symbols.slot_mask;
+    for (;;) {
+        uint32_t sym = s_symbols.slots[h];
+        if (sym == CIV_SYMBOL_NONE) break;
+        const symbol_entry_t* e = &s_symbols.entries[sym];
+        if (e->hash == hash && memcmp(e->name, str, len + 1) == 0) return sym;
+        h = (h + 1) & s_symbols.slot_mask;
+    }
+    if (slot_out) *slot_out = h;
+    return CIV_SYMBOL_NONE;
+}
+
+static civ_symbol_t insert(const char* str) {
+    size_t len;
+    uint32_t hash = hash_str(str, &len);
+    uint32_t slot = 0;
+    civ_symbol_t sym = lookup(str, len, hash, &slot);
+    if (sym != CIV_SYMBOL_NONE) return sym;
+
+    if (s_symbols.count == s_symbols.capacity) {
+        uint32_t cap = s_symbols.capacity * 2;
+        symbol_entry_t* entries =
+            (symbol_entry_t*)CIV_REALLOC(s_symbols.entries, cap * sizeof(symbol_entry_t));
+        if (!entries) return CIV_SYMBOL_NONE;
+        s_symbols.entries = entries;
+        s_symbols.capacity = cap;
+    }
+    if ((s_symbols.count + 1) * 2 > s_symbols.slot_mask + 1) {
+        if (!reserve_slots(s_symbols.count + 1)) return CIV_SYMBOL_NONE;
+        lookup(str, len, hash, &slot);
+    }
+    const char* name = store_name(str, len);
+    if (!name) return CIV_SYMBOL_NONE;
+
+    sym = s_symbols.count++;
+    s_symbols.entries[sym] = (symbol_entry_t){name, hash, 0};
+    s_symbols.slots[slot] = sym;
+    return sym;
+}
+
+static bool ensure_init(void) {
+    if (s_symbols.entries) return true;
+    s_symbols.capacity = 256;
+    s_symbols.entries = (symbol_entry_t*)CIV_CALLOC(s_symbols.capacity, sizeof(symbol_entry_t));
+    if (!s_symbols.entries || !reserve_slots(s_symbols.capacity)) {
+        civ_log(CIV_LOG_ERROR, "Failed to allocate symbol table");
+        civ_symbol_reset();
+        return false;
+    }
+    s_symbols.entries[0].name = "";
+    s_symbols.count = 1;
+
+    /* Fixed handles, in enum order */
+    static const char* const well_known[] = {
+#define CIV_SYMBOL_STR(name, str) str,
+        CIV_SYMBOL_WELL_KNOWN(CIV_SYMBOL_STR)
+#undef CIV_SYMBOL_STR
+    };
+    for (size_t i = 0; i < sizeof(well_known) / sizeof(well_known[0]); i++) {
+        if (insert(well_known[i]) != (civ_symbol_t)(i + 1)) {
+            civ_log(CIV_LOG_ERROR, "Failed to intern well-known symbols");
+            civ_symbol_reset();
+            return false;
+        }
+    }
+    return true;
+}
+
+civ_symbol_t civ_symbol_intern(const char* str) {
+    if (!str || !str[0] || !ensure_init()) return CIV_SYMBOL_NONE;
+    return insert(str);
+}
+
+civ_symbol_t civ_symbol_find(const char* str) {
+    if (!str || !str[0] || !ensure_init()) return CIV_SYMBOL_NONE;
+    size_t len;
+    uint32_t hash = hash_str(str, &len);
+    return lookup(str, len, hash, NULL);
+}
+
+const char* civ_symbol_name(civ_symbol_t sym) {
+    if (sym == CIV_SYMBOL_NONE || sym >= s_symbols.count) return "";
+    return s_symbols.entries[sym].name;
+}
+
+void civ_symbol_add_flags(civ_symbol_t sym, uint32_t flags) {
+    if (sym != CIV_SYMBOL_NONE && sym < s_symbols.count)
+        s_symbols.entries[sym].flags |= flags;
+}
+
+uint32_t civ_symbol_flags(civ_symbol_t sym) {
+    return sym < s_symbols.count ? s_symbols.entries[sym].flags : 0;
+}
+
+uint32_t civ_symbol_count(void) {
+    return s_symbols.entries ? s_symbols.count : 1;
+}
+
+void civ_symbol_reset(void) {
+    symbol_chunk_t* chunk = s_symbols.chunks;
+    while (chunk) {
+        symbol_chunk_t* next = chunk->next;
+        CIV_FREE(chunk);
+        chunk = next;
+    }
+    CIV_FREE(s_symbols.entries);
+    CIV_FREE(s_symbols.slots);
+    memset(&s_symbols, 0, sizeof(s_symbols));
+}
@@ -0,0 +1,260 @@
+/**
+ * @file timing_wheel.c
+ * @brief Implementation of the hierarchical timing wheel
+ */
+
+#include "utils/timing_wheel.h"
+#include "common.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define NIL           UINT32_MAX
+#define SLOT_MASK     ((uint64_t)CIV_TIMING_WHEEL_SLOTS - 1)
+#define WHEEL_LISTS   (CIV_TIMING_WHEEL_LEVELS * CIV_TIMING_WHEEL_SLOTS)
+#define LIST_OVERFLOW WHEEL_LISTS
+#define LIST_OVERDUE  (WHEEL_LISTS + 1)
+#define LIST_FIRING   (WHEEL_LISTS + 2)
+#define LIST_COUNT    (WHEEL_LISTS + 3)
+#define INITIAL_NODES 64
+
+static civ_timer_id_t id_of(const civ_timing_wheel_t *w, uint32_t index) {
+  return ((uint64_t)w->nodes[index].generation << 32) | (uint64_t)(index + 1);
+}
+
+/* Pending node behind id, or NIL */
+static uint32_t node_of(const civ_timing_wheel_t *w, civ_timer_id_t id) {
+  uint64_t low = id & 0xFFFFFFFFu;
+  if (low == 0 || low > w->node_capacity) return NIL;
+  uint32_t index = (uint32_t)(low - 1);
+  const civ_timer_node_t *n = &w->nodes[index];
+  if (n->list == NIL || n->generation != (uint32_t)(id >> 32)) return NIL;
+  return index;
+}
+
+/* Append, so a list fires in the order it was filled */
+static void push(civ_timing_wheel_t *w, uint32_t list, uint32_t index) {
+  civ_timer_node_t *n = &w->nodes[index];
+  n->list = list;
+  n->next = NIL;
+  uint32_t head = w->heads[list];
+  if (head == NIL) {
+    n->prev = index; /* the head's prev is the tail */
+    w->heads[list] = index;
+    return;
+  }
+  uint32_t tail = w->nodes[head].prev;
+  n->prev = tail;
+  w->nodes[tail].next = index;
+  w->nodes[head].prev = index;
+}
+
+/* Insert by due tick, after any due on the same tick */
+static void push_by_due(civ_timing_wheel_t *w, uint32_t list, uint32_t index) {
+  uint32_t head = w->heads[list];
+  uint64_t due = w->nodes[index].due;
+  if (head == NIL || w->nodes[w->nodes[head].prev].due <= due) {
+    push(w, list, index);
+    return;
+  }
+  civ_timer_node_t *n = &w->nodes[index];
+  n->list = list;
+  uint32_t at = w->nodes[head].prev;
+  while (at != head && w->nodes[at].due > due) at = w->nodes[at].prev;
+  if (w->nodes[at].due > due) { /* new head */
+    n->next = head;
+    n->prev = w->nodes[head].prev;
+    w->nodes[head].prev = index;
+    w->heads[list] = index;
+    return;
+  }
+  n->next = w->nodes[at].next; /* not NIL: at is before the tail */
+  n->prev = at;
+  w->nodes[n->next].prev = index;
+  w->nodes[at].next = index;
+}
+
+static void unlink_node(civ_timing_wheel_t *w, uint32_t index) {
+  civ_timer_node_t *n = &w->nodes[index];
+  uint32_t head = w->heads[n->list];
+  if (index == head) {
+    w->heads[n->list] = n->next;
+    if (n->next != NIL) w->nodes[n->next].prev = n->prev;
+  } else {
+    w->nodes[n->prev].next = n->next;
+    if (n->next != NIL)
+      w->nodes[n->next].prev = n->prev;
+    else
+      w->nodes[head].prev = n->prev;
+  }
+  n->list = NIL;
+}
+
+/* The list for due, at or after the wheel's current tick */
+static uint32_t list_for(const civ_timing_wheel_t *w, uint64_t due) {
+  uint64_t delta = due - w->now;
+  for (int level = 0; level < CIV_TIMING_WHEEL_LEVELS; level++) {
+    int shift = CIV_TIMING_WHEEL_BITS * (level + 1);
+    if (delta < ((uint64_t)1 << shift))
+      return (uint32_t)(level * CIV_TIMING_WHEEL_SLOTS) +
+             (uint32_t)((due >> (shift - CIV_TIMING_WHEEL_BITS)) & SLOT_MASK);
+  }
+  return LIST_OVERFLOW;
+}
+
+static void release(civ_timing_wheel_t *w, uint32_t index) {
+  civ_timer_node_t *n = &w->nodes[index];
+  n->generation++;
+  n->fn = NULL;
+  n->arg = NULL;
+  n->next = w->free_head;
+  w->free_head = index;
+}
+
+static bool grow(civ_timing_wheel_t *w) {
+  uint32_t capacity = w->node_capacity ? w->node_capacity * 2 : INITIAL_NODES;
+  civ_timer_node_t *nodes = (civ_timer_node_t *)CIV_REALLOC(
+      w->nodes, (size_t)capacity * sizeof(civ_timer_node_t));
+  if (!nodes) return false;
+  w->nodes = nodes;
+  for (uint32_t i = capacity; i-- > w->node_capacity;) {
+    memset(&nodes[i], 0, sizeof(nodes[i]));
+    nodes[i].list = NIL;
+    nodes[i].next = w->free_head;
+    w->free_head = i;
+  }
+  w->node_capacity = capacity;
+  return true;
+}
+
+void civ_timing_wheel_init(civ_timing_wheel_t *wheel, uint64_t now) {
+  if (!wheel) return;
+  memset(wheel, 0, sizeof(*wheel));
+  wheel->now = now;
+  wheel->free_head = NIL;
+  for (int i = 0; i < LIST_COUNT; i++) wheel->heads[i] = NIL;
+}
+
+void civ_timing_wheel_free(civ_timing_wheel_t *wheel) {
+  if (!wheel) return;
+  CIV_FREE(wheel->nodes);
+  civ_timing_wheel_init(wheel, wheel->now);
+}
+
+civ_timer_id_t civ_timing_wheel_schedule(civ_timing_wheel_t *wheel,
+                                         uint64_t due, civ_timer_fn fn,
+                                         void *arg, uint64_t key) {
+  if (!wheel || !fn) return 0;
+  if (wheel->free_head == NIL && !grow(wheel)) return 0;
+  uint32_t index = wheel->free_head;
+  civ_timer_node_t *n = &wheel->nodes[index];
+  wheel->free_head = n->next;
+  n->due = due;
+  n->fn = fn;
+  n->arg = arg;
+  n->key = key;
+  /* The current tick's slot has fired or is firing: a timer due by now
+     waits apart, ahead of everything due later */
+  if (due > wheel->now)
+    push(wheel, list_for(wheel, due), index);
+  else
+    push_by_due(wheel, LIST_OVERDUE, index);
+  wheel->pending++;
+  return id_of(wheel, index);
+}
+
+bool civ_timing_wheel_cancel(civ_timing_wheel_t *wheel, civ_timer_id_t id) {
+  if (!wheel) return false;
+  uint32_t index = node_of(wheel, id);
+  if (index == NIL) return false;
+  unlink_node(wheel, index);
+  release(wheel, index);
+  wheel->pending--;
+  return true;
+}
+
+uint64_t civ_timing_wheel_due(const civ_timing_wheel_t *wheel,
+                              civ_timer_id_t id) {
+  if (!wheel) return 0;
+  uint32_t index = node_of(wheel, id);
+  return index == NIL ? 0 : wheel->nodes[index].due;
+}
+
+/* Re-file every timer on list against the current tick; none is due
+   before it, and those due on it land in the slot about to fire */
+static void cascade(civ_timing_wheel_t *w, uint32_t list) {
+  uint32_t index = w->heads[list];
+  w->heads[list] = NIL;
+  while (index != NIL) {
+    uint32_t next = w->nodes[index].next;
+    push(w, list_for(w, w->nodes[index].due), index);
+    index = next;
+  }
+}
+
+/* Fire the current tick's slot. It moves to the firing list first, so a
+   callback that schedules or cancels sees consistent lists. */
+static size_t fire(civ_timing_wheel_t *w, uint32_t list) {
+  size_t fired = 0;
+  uint32_t index = w->heads[list];
+  w->heads[list] = NIL;
+  while (index != NIL) {
+    uint32_t next = w->nodes[index].next;
+    push(w, LIST_FIRING, index);
+    index = next;
+  }
+  while ((index = w->heads[LIST_FIRING]) != NIL) {
+    civ_timer_node_t n = w->nodes[index];
+    unlink_node(w, index);
+    release(w, index);
+    w->pending--;
+    w->fired++;
+    fired++;
+    n.fn(n.arg, n.key, n.due);
+  }
+  return fired;
+}
+
+/* First non-empty slot of the finest wheel from slot on, or SLOTS */
+static uint64_t next_slot(const civ_timing_wheel_t *w, uint64_t slot) {
+  for (; slot < CIV_TIMING_WHEEL_SLOTS; slot++)
+    if (w->heads[slot] != NIL) return slot;
+  return CIV_TIMING_WHEEL_SLOTS;
+}
+
+size_t civ_timing_wheel_advance(civ_timing_wheel_t *wheel, uint64_t now) {
+  if (!wheel) return 0;
+  size_t fired = 0;
+  while (wheel->now < now) {
+    fired += fire(wheel, LIST_OVERDUE);
+    if (wheel->pending == 0) {
+      wheel->now = now;
+      break;
+    }
+
+    /* Within a turn of the finest wheel, skip to its next full slot */
+    uint64_t t = wheel->now + 1;
+    if ((t & SLOT_MASK) != 0) {
+      uint64_t slot = next_slot(wheel, t & SLOT_MASK);
+      t += slot - (t & SLOT_MASK);
+      if (t > now) {
+        wheel->now = now;
+        break;
+      }
+    }
+    wheel->now = t;
+
+    /* A full turn brings the next slot of the wheel above down, and so on
+       up while those turn over too */
+    if ((t & SLOT_MASK) == 0) {
+      int level = 1;
+      for (; level < CIV_TIMING_WHEEL_LEVELS; level++) {
+        uint64_t slot = (t >> (CIV_TIMING_WHEEL_BITS * level)) & SLOT_MASK;
+        cascade(wheel, (uint32_t)(level * CIV_TIMING_WHEEL_SLOTS) + (uint32_t)slot);
+        if (slot != 0) break;
+      }
+      if (level == CIV_TIMING_WHEEL_LEVELS) cascade(wheel, LIST_OVERFLOW);
+    }
+    fired += fire(wheel, (uint32_t)(t & SLOT_MASK));
+  }
+  return fired;
+}
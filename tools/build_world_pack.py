@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""
+Bundle the generated world data files into a single asset pack.
+
+Run after the generate_*.py scripts. Each input file is copied verbatim
+into its own section, so the game parses it exactly as it parses the
+loose file. Missing inputs are skipped; the game falls back to the loose
+file (or its built-in default) for any section the pack lacks.
+
+Layout (little-endian, see include/core/world/world_pack.h):
+    header   64 bytes   magic, version, section_count, toc_offset, file_size
+    toc      32 bytes   per section: tag[4], flags, offset, size, reserved
+    sections each starts on a 64-byte boundary
+
+Output: data/world.pack
+
+Usage:
+    python3 build_world_pack.py [--data-dir data] [--output data/world.pack]
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = 0x4B415057  # "WPAK" little-endian
+VERSION = 1
+ALIGN = 64
+HEADER_FMT = "<IIIIQ40x"
+TOC_FMT = "<4sIQQQ"
+
+# (tag, path relative to the data dir) — tags must match world_pack.c
+SECTIONS = [
+    (b"EART", "earth_2048x1024.earth"),
+    (b"BORD", "earth_borders.bin"),
+    (b"NATN", "nations.bin"),
+    (b"RSRC", "resources.bin"),
+    (b"CITY", "cities.bin"),
+    (b"FLAG", os.path.join("flags", "index.bin")),
+]
+
+
+def align_up(n):
+    return (n + ALIGN - 1) // ALIGN * ALIGN
+
+
+def build_pack(data_dir, output):
+    present = []
+    for tag, rel in SECTIONS:
+        path = os.path.join(data_dir, rel)
+        if not os.path.exists(path):
+            print(f"  skip {tag.decode()}: {path} not found")
+            continue
+        with open(path, "rb") as f:
+            present.append((tag, f.read()))
+
+    if not present:
+        print("No input files found; run the generate_*.py scripts first.")
+        return False
+
+    header_size = struct.calcsize(HEADER_FMT)
+    toc_offset = header_size
+    offset = align_up(toc_offset + len(present) * struct.calcsize(TOC_FMT))
+    toc = []
+    for tag, payload in present:
+        toc.append((tag, offset, len(payload)))
+        offset = align_up(offset + len(payload))
+    file_size = toc[-1][1] + toc[-1][2]
+
+    os.makedirs(os.path.dirname(output) or ".", exist_ok=True)
+    with open(output, "wb") as f:
+        f.write(struct.pack(HEADER_FMT, MAGIC, VERSION, len(present),
+                            toc_offset, file_size))
+        for tag, off, size in toc:
+            f.write(struct.pack(TOC_FMT, tag, 0, off, size, 0))
+        for (tag, payload), (_, off, _) in zip(present, toc):
+            f.write(b"\0" * (off - f.tell()))
+            f.write(payload)
+            print(f"  {tag.decode()}  @{off:>10}  {len(payload) / 1024:10.1f} KB")
+
+    print(f"Written {output} ({file_size / 1024 / 1024:.1f} MB, "
+          f"{len(present)} sections)")
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Bundle generated world data into data/world.pack"
+    )
+    parser.add_argument("--data-dir", type=str, default="data")
+    parser.add_argument("--output", type=str, default="data/world.pack")
+    args = parser.parse_args()
+
+    if not build_pack(args.data_dir, args.output):
+        sys.exit(1)
+    print("Done.")
+
+
+if __name__ == "__main__":
+    main()
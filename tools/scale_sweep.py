@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""
+Scaling curves for the simulation systems on synthetic worlds.
+
+Runs dominion_headless once per scale with --scenario, collecting the
+per-system timings into one CSV (--systems-csv), then fits each system's
+average update time against world size on log-log axes. A slope near 1
+is linear in the scaled quantity; systems past --flag are reported as
+super-linear.
+
+Each step multiplies nations, settlements and units by --factor and the
+map area by the same factor, up to the largest map.
+
+Usage:
+    python3 scale_sweep.py [--headless build/dominion_headless]
+                           [--steps 4] [--factor 2] [--turns 5]
+                           [--nations 250] [--settlements 2500]
+                           [--units 5000] [--map 2048x1024]
+                           [--flag 1.3] [--output scale.csv]
+"""
+
+import argparse
+import csv
+import math
+import os
+import subprocess
+import sys
+
+MAX_WIDTH, MAX_HEIGHT = 8192, 4096
+MAX_NATIONS = 8192
+
+
+def scales(args):
+    w, h = (int(v) for v in args.map.split("x"))
+    n, s, u = args.nations, args.settlements, args.units
+    for _ in range(args.steps):
+        yield w, h, n, s, u
+        grow = math.sqrt(args.factor)
+        w, h = min(int(w * grow), MAX_WIDTH), min(int(h * grow), MAX_HEIGHT)
+        n = min(int(n * args.factor), MAX_NATIONS)
+        s, u = int(s * args.factor), int(u * args.factor)
+
+
+def slope(points):
+    """Least-squares slope of log(avg_ms) on log(size)"""
+    pts = [(math.log(x), math.log(y)) for x, y in points if x > 0 and y > 0]
+    if len(pts) < 2:
+        return None
+    mx = sum(p[0] for p in pts) / len(pts)
+    my = sum(p[1] for p in pts) / len(pts)
+    den = sum((p[0] - mx) ** 2 for p in pts)
+    return sum((p[0] - mx) * (p[1] - my) for p in pts) / den if den else None
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("--headless", default="build/dominion_headless")
+    parser.add_argument("--steps", type=int, default=4)
+    parser.add_argument("--factor", type=float, default=2.0)
+    parser.add_argument("--turns", type=int, default=5)
+    parser.add_argument("--nations", type=int, default=250)
+    parser.add_argument("--settlements", type=int, default=2500)
+    parser.add_argument("--units", type=int, default=5000)
+    parser.add_argument("--map", default="2048x1024")
+    parser.add_argument("--flag", type=float, default=1.3)
+    parser.add_argument("--output", default="scale.csv")
+    args = parser.parse_args()
+
+    if os.path.exists(args.output):
+        os.remove(args.output)
+    for w, h, n, s, u in scales(args):
+        spec = f"nations={n},settlements={s},units={u},map={w}x{h}"
+        print(f"scale {spec}", flush=True)
+        rc = subprocess.run([args.headless, "--turns", str(args.turns),
+                             "--scenario", spec,
+                             "--systems-csv", args.output],
+                            stdout=subprocess.DEVNULL,
+                            stderr=subprocess.DEVNULL).returncode
+        if rc != 0:
+            sys.exit(f"{args.headless} failed at {spec} (exit {rc})")
+
+    # Tiles grow by the factor with everything else, so they stand in for
+    # world size on the x axis
+    per_system = {}
+    with open(args.output, newline="") as f:
+        for row in csv.DictReader(f):
+            per_system.setdefault(row["system"], []).append(
+                (int(row["tiles"]), float(row["avg_ms"])))
+
+    print(f"\n{'system':<24} {'slope':>6} {'first ms':>10} {'last ms':>10}")
+    flagged = []
+    for name, pts in sorted(per_system.items(),
+                            key=lambda kv: -kv[1][-1][1]):
+        k = slope(pts)
+        if k is None:
+            continue
+        mark = "  super-linear" if k > args.flag else ""
+        if mark:
+            flagged.append(name)
+        print(f"{name:<24} {k:6.2f} {pts[0][1]:10.3f} {pts[-1][1]:10.3f}{mark}")
+    print(f"\n{len(flagged)} system(s) above slope {args.flag}; "
+          f"rows in {args.output}")
+
+
+if __name__ == "__main__":
+    main()
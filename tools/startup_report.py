@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+"""
+Cold-start regressions between builds, from the startup timeline CSV.
+
+Every run of dominion (or dominion_headless --startup-csv) appends its load
+steps to the timeline CSV, tagged with the build id. This takes the median
+of each step over the runs of two builds — by default the last two builds
+in the file — and lists the steps that got slower by more than --threshold
+(relative) and --min-ms (absolute). Exits 1 when any did, so a CI job that
+runs the headless boot a few times per commit fails on the commit that
+introduced the regression.
+
+Usage:
+    python3 startup_report.py [--csv startup.csv] [--base BUILD]
+                              [--head BUILD] [--threshold 0.2] [--min-ms 5]
+"""
+
+import argparse
+import csv
+import statistics
+import sys
+
+
+def load(path):
+    """{build: {step: [wall_ms per run]}} and builds in order of appearance"""
+    builds, order = {}, []
+    with open(path, newline="") as f:
+        for row in csv.DictReader(f):
+            build = row["build"]
+            if build not in builds:
+                builds[build] = {}
+                order.append(build)
+            key = (row["step"], row["thread"])
+            builds[build].setdefault(key, []).append(float(row["wall_ms"]))
+    return builds, order
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("--csv", default="startup.csv")
+    parser.add_argument("--base")
+    parser.add_argument("--head")
+    parser.add_argument("--threshold", type=float, default=0.2)
+    parser.add_argument("--min-ms", type=float, default=5.0)
+    args = parser.parse_args()
+
+    builds, order = load(args.csv)
+    head = args.head or (order[-1] if order else None)
+    rest = [b for b in order if b != head]
+    base = args.base or (rest[-1] if rest else None)
+    if head not in builds or base not in builds:
+        sys.exit(f"need two builds in {args.csv}; found {', '.join(order) or 'none'}")
+
+    print(f"{base} -> {head}\n")
+    print(f"{'step':<28} {'thread':<8} {'base ms':>10} {'head ms':>10} {'change':>8}")
+    regressed = []
+    for key in builds[head]:
+        step, thread = key
+        now = statistics.median(builds[head][key])
+        if key not in builds[base]:
+            print(f"{step:<28} {thread:<8} {'-':>10} {now:10.1f} {'new':>8}")
+            continue
+        was = statistics.median(builds[base][key])
+        change = (now - was) / was if was > 0 else 0.0
+        mark = ""
+        if now - was > args.min_ms and change > args.threshold:
+            mark = "  REGRESSED"
+            regressed.append(step)
+        print(f"{step:<28} {thread:<8} {was:10.1f} {now:10.1f} {change:+7.0%}{mark}")
+
+    runs = len(builds[head].get(("ready", "main"), []))
+    print(f"\n{len(regressed)} step(s) regressed; {runs} run(s) of {head}")
+    sys.exit(1 if regressed else 0)
+
+
+if __name__ == "__main__":
+    main()